@@ -41,7 +41,7 @@ import { input } from '../input';
 import { game, Game } from './game';
 import { v2, Vec2 } from './math';
 import { Root } from './root';
-import { Node, Scene } from './scene-graph';
+import { Node, Scene, SceneStreamer, SceneStreamTask, ISceneStreamOptions } from './scene-graph';
 import { ComponentScheduler } from './scene-graph/component-scheduler';
 import NodeActivator from './scene-graph/node-activator';
 import { Scheduler } from './scheduler';
@@ -475,6 +475,25 @@ export class Director extends EventTarget {
         }
     }
 
+    /**
+     * @en
+     * Streams a scene into the running scene without replacing it, see [[SceneStreamer]].<br>
+     * The scene asset and its dependencies are loaded asynchronously, then the nodes are attached to parent
+     * within a time slice per frame, and onCompleted is called once all of them are attached.
+     * @zh
+     * 将场景流式加载到当前运行的场景中而不替换它，参见 [[SceneStreamer]]。<br>
+     * 场景资源及其依赖会被异步加载，随后节点会在每帧的时间片内挂载到 parent 下，全部挂载后调用 onCompleted。
+     * @param sceneName - The name of the scene to stream.
+     * @param parent - The node to attach the nodes of the scene to.
+     * @param options - Some optional parameters.
+     * @param onCompleted - callback, will be called after all nodes are attached, or when the loading fails.
+     * @return the streaming task, null if the scene is not in the build settings.
+     */
+    public streamScene (sceneName: string, parent: Node | Scene, options?: ISceneStreamOptions | null,
+        onCompleted?: SceneStreamer.OnCompleted | null): SceneStreamTask | null {
+        return SceneStreamer.instance.stream(sceneName, parent, options, onCompleted);
+    }
+
     /**
      * @en
      * Pre-loads the scene asset to reduces loading time. You can call this method at any time you want.<br>
@@ -396,9 +396,10 @@ export enum TextureUsageBit {
 }
 
 export enum TextureFlagBit {
-    NONE           = 0,
-    GEN_MIPMAP     = 0x1, // Generate mipmaps using bilinear filter
-    GENERAL_LAYOUT = 0x2, // For inout framebuffer attachments
+    NONE             = 0,
+    GEN_MIPMAP       = 0x1, // Generate mipmaps using bilinear filter
+    GENERAL_LAYOUT   = 0x2, // For inout framebuffer attachments
+    LAZILY_ALLOCATED = 0x4, // Contents never leave the render pass, backends may keep them in tile memory only
 }
 
 export enum FormatFeatureBit {
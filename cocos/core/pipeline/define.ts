@@ -218,7 +218,13 @@ export class UBOCamera {
     public static readonly GLOBAL_FOG_ADD_OFFSET = UBOCamera.GLOBAL_FOG_BASE_OFFSET + 4;
     public static readonly NEAR_FAR_OFFSET = UBOCamera.GLOBAL_FOG_ADD_OFFSET + 4;
     public static readonly VIEW_PORT_OFFSET = UBOCamera.NEAR_FAR_OFFSET + 4;
-    public static readonly COUNT = UBOCamera.VIEW_PORT_OFFSET + 4;
+    // per-view data of multiview cameras, filled by the native pipeline
+    public static readonly MAX_VIEW_COUNT = 2;
+    public static readonly MAT_VIEWS_OFFSET = UBOCamera.VIEW_PORT_OFFSET + 4;
+    public static readonly MAT_PROJS_OFFSET = UBOCamera.MAT_VIEWS_OFFSET + 16 * UBOCamera.MAX_VIEW_COUNT;
+    public static readonly MAT_VIEW_PROJS_OFFSET = UBOCamera.MAT_PROJS_OFFSET + 16 * UBOCamera.MAX_VIEW_COUNT;
+    public static readonly CAMERA_POSITIONS_OFFSET = UBOCamera.MAT_VIEW_PROJS_OFFSET + 16 * UBOCamera.MAX_VIEW_COUNT;
+    public static readonly COUNT = UBOCamera.CAMERA_POSITIONS_OFFSET + 4 * UBOCamera.MAX_VIEW_COUNT;
     public static readonly SIZE = UBOCamera.COUNT * 4;
 
     public static readonly NAME = 'CCCamera';
@@ -244,6 +250,10 @@ export class UBOCamera {
         new Uniform('cc_fogAdd', Type.FLOAT4, 1),
         new Uniform('cc_nearFar', Type.FLOAT4, 1),
         new Uniform('cc_viewPort', Type.FLOAT4, 1),
+        new Uniform('cc_matViews', Type.MAT4, UBOCamera.MAX_VIEW_COUNT),
+        new Uniform('cc_matProjs', Type.MAT4, UBOCamera.MAX_VIEW_COUNT),
+        new Uniform('cc_matViewProjs', Type.MAT4, UBOCamera.MAX_VIEW_COUNT),
+        new Uniform('cc_cameraPositions', Type.FLOAT4, UBOCamera.MAX_VIEW_COUNT),
     ], 1);
 }
 globalDescriptorSetLayout.layouts[UBOCamera.NAME] = UBOCamera.LAYOUT;
@@ -265,7 +275,8 @@ export class UBOShadow {
     public static readonly SHADOW_LIGHT_PACKING_NBIAS_NULL_INFO_OFFSET = UBOShadow.SHADOW_WIDTH_HEIGHT_PCF_BIAS_INFO_OFFSET + 4;
     public static readonly SHADOW_COLOR_OFFSET = UBOShadow.SHADOW_LIGHT_PACKING_NBIAS_NULL_INFO_OFFSET + 4;
     public static readonly PLANAR_NORMAL_DISTANCE_INFO_OFFSET = UBOShadow.SHADOW_COLOR_OFFSET + 4;
-    public static readonly COUNT: number = UBOShadow.PLANAR_NORMAL_DISTANCE_INFO_OFFSET + 4;
+    public static readonly SHADOW_ATLAS_TILE_INFO_OFFSET = UBOShadow.PLANAR_NORMAL_DISTANCE_INFO_OFFSET + 4;
+    public static readonly COUNT: number = UBOShadow.SHADOW_ATLAS_TILE_INFO_OFFSET + 4;
     public static readonly SIZE = UBOShadow.COUNT * 4;
     public static readonly NAME = 'CCShadow';
     public static readonly BINDING = PipelineGlobalBindings.UBO_SHADOW;
@@ -282,6 +293,7 @@ export class UBOShadow {
         new Uniform('cc_shadowLPNNInfo', Type.FLOAT4, 1),
         new Uniform('cc_shadowColor', Type.FLOAT4, 1),
         new Uniform('cc_planarNDInfo', Type.FLOAT4, 1),
+        new Uniform('cc_shadowAtlasTileInfo', Type.FLOAT4, 1),
     ], 1);
 }
 globalDescriptorSetLayout.layouts[UBOShadow.NAME] = UBOShadow.LAYOUT;
@@ -6,3 +6,5 @@ export * from './deprecated';
 export * from './scene-globals';
 export * from './find';
 export { default as NodeActivator } from './node-activator';
+export { SceneStreamer, SceneStreamTask, SceneStreamState } from './scene-streamer';
+export type { ISceneStreamOptions } from './scene-streamer';
@@ -38,3 +38,5 @@ export { Layers } from './layers';
 export { find } from './find';
 export * from './deprecated';
 export { default as NodeActivator } from './node-activator';
+export { SceneStreamer, SceneStreamTask, SceneStreamState } from './scene-streamer';
+export type { ISceneStreamOptions } from './scene-streamer';
@@ -156,6 +156,10 @@ function _onLoadInEditor (comp) {
 export default class NodeActivator {
     public resetComp: any;
     protected _activatingStack!: any[];
+    // the nodes being activated, the index of the next child of each one and its number of children when it was activated
+    protected _traversalNodes: any[] = [];
+    protected _traversalIndices: number[] = [];
+    protected _traversalCounts: number[] = [];
 
     constructor () {
         this.reset();
@@ -266,6 +270,42 @@ export default class NodeActivator {
     }
 
     protected _activateNodeRecursively (node, preloadInvoker, onLoadInvoker, onEnableInvoker) {
+        // depth first with an explicit stack, deep hierarchies would overflow the call stack,
+        // components activated on the way may activate other nodes, their traversal runs above `base`
+        const nodes = this._traversalNodes;
+        const indices = this._traversalIndices;
+        const counts = this._traversalCounts;
+        const base = nodes.length;
+        if (!this._activateNodeSelf(node, preloadInvoker, onLoadInvoker, onEnableInvoker)) {
+            return;
+        }
+        nodes.push(node);
+        indices.push(0);
+        counts.push(node._children.length);
+
+        while (nodes.length > base) {
+            const top = nodes.length - 1;
+            const curr = nodes[top];
+            const index = indices[top];
+            if (index < counts[top]) {
+                indices[top] = index + 1;
+                const child = curr._children[index];
+                if (child && child._active && this._activateNodeSelf(child, preloadInvoker, onLoadInvoker, onEnableInvoker)) {
+                    nodes.push(child);
+                    indices.push(0);
+                    counts.push(child._children.length);
+                }
+            } else {
+                nodes.length = top;
+                indices.length = top;
+                counts.length = top;
+                curr._onPostActivated(true);
+            }
+        }
+    }
+
+    // activate the node and its components, false if the node can not be activated
+    protected _activateNodeSelf (node, preloadInvoker, onLoadInvoker, onEnableInvoker) {
         if (node._objFlags & Deactivating) {
             // en:
             // Forbid reactive the same node during its deactivating procedure
@@ -274,7 +314,7 @@ export default class NodeActivator {
             // 对相同节点而言，无法撤销反激活，防止反激活 - 激活 - 反激活的死循环发生。
             // 这样设计简化了一些引擎的实现，而且对调用者来说能保证反激活操作都能成功。
             errorID(3816, node.name);
-            return;
+            return false;
         }
 
         node._activeInHierarchy = true;
@@ -293,15 +333,7 @@ export default class NodeActivator {
                 --originCount;
             }
         }
-
-        // activate children recursively
-        for (let i = 0, len = node._children.length; i < len; ++i) {
-            const child = node._children[i];
-            if (child._active) {
-                this._activateNodeRecursively(child, preloadInvoker, onLoadInvoker, onEnableInvoker);
-            }
-        }
-        node._onPostActivated(true);
+        return true;
     }
 
     protected _deactivateNodeRecursively (node) {
@@ -0,0 +1,314 @@
+/*
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+  worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+  not use Cocos Creator software for developing other software or tools that's
+  used for developing games. You are not granted to publish, distribute,
+  sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+*/
+
+/**
+ * @packageDocumentation
+ * @module scene-graph
+ */
+
+import type { SceneAsset } from '../assets/scene-asset';
+import System from '../components/system';
+import { isValid } from '../data/object';
+import { legacyCC } from '../global-exports';
+import { error, errorID } from '../platform/debug';
+import type { Node } from './node';
+import type { Scene } from './scene';
+
+/**
+ * @en Options of [[SceneStreamer.stream]].
+ * @zh [[SceneStreamer.stream]] 的选项。
+ */
+export interface ISceneStreamOptions {
+    /**
+     * @en The time in milliseconds spent on attaching nodes per frame, 4 by default.
+     * At least one node is attached per frame.
+     * @zh 每帧用于挂载节点的时间（毫秒），默认为 4。每帧至少挂载一个节点。
+     */
+    timeSlice?: number;
+
+    /**
+     * @en Called when the loading progress of the scene asset and its dependencies changes.
+     * @zh 场景资源及其依赖的加载进度变化时调用。
+     */
+    onLoadProgress?: (finished: number, total: number) => void;
+
+    /**
+     * @en Called every frame after nodes are attached, with the number of the attached nodes and the total number of nodes.
+     * @zh 每帧挂载节点后调用，参数为已挂载的节点数与节点总数。
+     */
+    onAttachProgress?: (attached: number, total: number) => void;
+}
+
+/**
+ * @en The state of a streaming task.
+ * @zh 流式加载任务的状态。
+ */
+export enum SceneStreamState {
+    LOADING,
+    ATTACHING,
+    COMPLETED,
+    CANCELED,
+    FAILED,
+}
+
+/**
+ * @en A scene being streamed into a parent node, created by [[SceneStreamer.stream]].
+ * @zh 正在流式加载到父节点中的场景，由 [[SceneStreamer.stream]] 创建。
+ */
+export class SceneStreamTask {
+    /**
+     * @en The scene asset, it is referenced by the task once loaded. Release it by `assetManager.releaseAsset`
+     * after the streamed nodes are destroyed.
+     * @zh 场景资源，加载后会被任务引用。在流式加载的节点销毁后可通过 `assetManager.releaseAsset` 释放。
+     */
+    public asset: SceneAsset | null = null;
+
+    public readonly sceneName: string;
+    public readonly parent: Node;
+
+    /**
+     * @en Nodes of the scene which are attached to the parent directly, filled as the task proceeds.
+     * @zh 直接挂载到父节点下的场景节点，随任务推进而填充。
+     */
+    public readonly roots: Node[] = [];
+
+    get state () {
+        return this._state;
+    }
+
+    get attachedCount () {
+        return this._attached;
+    }
+
+    get totalCount () {
+        return this._total;
+    }
+
+    /**
+     * @en Stop the task. Attached nodes are kept, the nodes not yet attached are destroyed.
+     * @zh 停止任务。已挂载的节点会保留，尚未挂载的节点会被销毁。
+     */
+    public cancel () {
+        if (this._state === SceneStreamState.LOADING || this._state === SceneStreamState.ATTACHING) {
+            this._state = SceneStreamState.CANCELED;
+            for (let i = this._next; i < this._queue.length; ++i) {
+                // the children of pending nodes are still attached to them
+                this._queue[i].destroy();
+            }
+            this._queue.length = 0;
+            this._parents.length = 0;
+        }
+    }
+
+    /**
+     * @legacyPublic
+     */
+    public _state = SceneStreamState.LOADING;
+    /**
+     * @legacyPublic
+     */
+    public _options: ISceneStreamOptions;
+    /**
+     * @legacyPublic
+     */
+    public _onCompleted: SceneStreamer.OnCompleted | null;
+
+    // nodes in breadth first order, a node is attached by the time its children are
+    private _queue: Node[] = [];
+    private _parents: Node[] = [];
+    private _next = 0;
+    private _attached = 0;
+    private _total = 0;
+
+    constructor (sceneName: string, parent: Node, options: ISceneStreamOptions, onCompleted: SceneStreamer.OnCompleted | null) {
+        this.sceneName = sceneName;
+        this.parent = parent;
+        this._options = options;
+        this._onCompleted = onCompleted;
+    }
+
+    /**
+     * @legacyPublic
+     */
+    public _start (asset: SceneAsset) {
+        this.asset = asset;
+        asset.addRef();
+        const scene = asset.scene!;
+        // @ts-expect-error run private method, expands nested prefabs and assigns sibling indices
+        scene._load();
+        const children = scene.children.slice();
+        for (let i = 0; i < children.length; ++i) {
+            this._queue.push(children[i]);
+            this._parents.push(this.parent);
+            this._total += countSubtree(children[i]);
+        }
+        this._state = SceneStreamState.ATTACHING;
+    }
+
+    /**
+     * @legacyPublic
+     */
+    public _attach (deadline: number) {
+        const queue = this._queue;
+        const parents = this._parents;
+        do {
+            const node = queue[this._next];
+            const parent = parents[this._next];
+            ++this._next;
+            if (!isValid(parent, true)) {
+                // the parent was destroyed during streaming
+                this._total -= countSubtree(node);
+                node.destroy();
+                continue;
+            }
+            // detach the children first so only the components of this node are activated now
+            const children = node.children.slice();
+            node.removeAllChildren();
+            node.setParent(parent);
+            ++this._attached;
+            if (parent === this.parent) {
+                this.roots.push(node);
+            }
+            for (let i = 0; i < children.length; ++i) {
+                queue.push(children[i]);
+                parents.push(node);
+            }
+        } while (this._next < queue.length && performance.now() < deadline);
+
+        if (this._options.onAttachProgress) {
+            this._options.onAttachProgress(this._attached, this._total);
+        }
+        if (this._next >= queue.length) {
+            this._queue.length = 0;
+            this._parents.length = 0;
+            this._state = SceneStreamState.COMPLETED;
+        }
+    }
+}
+
+function countSubtree (node: Node) {
+    let count = 0;
+    node.walk(() => { ++count; });
+    return count;
+}
+
+/**
+ * @en
+ * Streams the node trees of scene assets into the running scene. The scene asset and its dependencies
+ * are loaded asynchronously by the asset manager, then the nodes are attached a few at a time within
+ * a time slice per frame, parents before children, so that large areas can be added without a hitch.
+ * The scene globals of the streamed scene, such as the skybox and fog, are not applied.
+ * @zh
+ * 将场景资源的节点树流式加载到当前运行的场景中。场景资源及其依赖由资源管理器异步加载，
+ * 随后在每帧的时间片内逐个挂载节点，父节点先于子节点，从而可以无卡顿地加入大型区域。
+ * 被加载场景的全局设置（例如天空盒和雾）不会被应用。
+ */
+export class SceneStreamer extends System {
+    static readonly ID = 'SCENE_STREAMER';
+
+    private static _instance: SceneStreamer | null = null;
+
+    /**
+     * @en Gets the streamer, it is registered to the director on first use.
+     * @zh 获取流式加载器，首次使用时会注册到 director。
+     */
+    static get instance () {
+        if (!SceneStreamer._instance) {
+            SceneStreamer._instance = new SceneStreamer();
+            legacyCC.director.registerSystem(SceneStreamer.ID, SceneStreamer._instance, System.Priority.LOW);
+        }
+        return SceneStreamer._instance;
+    }
+
+    private _tasks: SceneStreamTask[] = [];
+
+    /**
+     * @en
+     * Stream the scene of a bundle into parent. The node tree of the loaded scene asset is moved into parent,
+     * in the same way `director.runScene` takes the scene of the asset.
+     * @zh
+     * 将分包中的场景流式加载到 parent 下。加载得到的场景资源的节点树会被移动到 parent 下，与 `director.runScene` 使用场景资源中场景的方式相同。
+     * @param sceneName - The name of the scene to stream.
+     * @param parent - The node to attach the nodes of the scene to.
+     * @param options - Some optional parameters.
+     * @param onCompleted - Called after all nodes are attached, or when the loading fails.
+     */
+    public stream (sceneName: string, parent: Node | Scene, options?: ISceneStreamOptions | null,
+        onCompleted?: SceneStreamer.OnCompleted | null): SceneStreamTask | null {
+        const bundle = legacyCC.assetManager.bundles.find((bundle) => !!bundle.getSceneInfo(sceneName));
+        if (!bundle) {
+            errorID(1209, sceneName);
+            return null;
+        }
+        const opts = options || {};
+        const task = new SceneStreamTask(sceneName, parent as Node, opts, onCompleted || null);
+        bundle.loadScene(sceneName, (finished: number, total: number) => {
+            if (opts.onLoadProgress) {
+                opts.onLoadProgress(finished, total);
+            }
+        }, (err: Error | null, asset: SceneAsset) => {
+            if (task.state === SceneStreamState.CANCELED) {
+                return;
+            }
+            if (err) {
+                error(err);
+                task._state = SceneStreamState.FAILED;
+                if (task._onCompleted) {
+                    task._onCompleted(err, task);
+                }
+                return;
+            }
+            task._start(asset);
+            this._tasks.push(task);
+        });
+        return task;
+    }
+
+    public update (dt: number) {
+        const tasks = this._tasks;
+        // tasks share the frame, the ones started earlier are attached first
+        const now = performance.now();
+        let count = 0;
+        for (let i = 0; i < tasks.length; ++i) {
+            const task = tasks[i];
+            if (task.state === SceneStreamState.ATTACHING) {
+                const timeSlice = task._options.timeSlice !== undefined ? task._options.timeSlice : 4;
+                task._attach(now + timeSlice);
+            }
+            if (task.state === SceneStreamState.ATTACHING) {
+                tasks[count++] = task;
+            } else if (task.state === SceneStreamState.COMPLETED && task._onCompleted) {
+                task._onCompleted(null, task);
+            }
+        }
+        tasks.length = count;
+    }
+}
+
+export declare namespace SceneStreamer {
+    export type OnCompleted = (error: Error | null, task: SceneStreamTask) => void;
+}
+
+legacyCC.SceneStreamer = SceneStreamer;
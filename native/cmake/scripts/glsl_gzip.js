@@ -25,21 +25,60 @@ if(VERBOSE) {
 
 const shaders = require(inputFile)[exportVar];
 
-let newShaders = shaders.map((eff)=> '{' + eff.map(s => {
-    let o = {...s};
-    let arr = ['{\n'];
-    let shaders = [];
-    for(let i in o) {
-        let gziped = zlib.gzipSync(o[i]).toString("base64");
-        shaders.push(`  {"${i}", GzipedString("${gziped}")}`);
+// Sources of builtin shaders share most of their text: the same chunks are inlined
+// into every effect. Store each distinct line once and describe every source as a
+// list of line indices, then compress the whole table as a single gzip stream.
+//
+// layout, little endian:
+//   u32 lineCount, lineCount NUL terminated lines
+//   u32 effectCount
+//   per effect: u32 shaderCount
+//     per shader: u32 stageCount
+//       per stage: NUL terminated stage name, u32 count, count u32 line indices
+const lineIndices = new Map();
+const lines = [];
+const layout = [];
+
+const u32 = (v) => {
+    const buf = Buffer.alloc(4);
+    buf.writeUInt32LE(v);
+    return buf;
+};
+
+const indexOfLine = (line) => {
+    let index = lineIndices.get(line);
+    if (index === undefined) {
+        index = lines.length;
+        lineIndices.set(line, index);
+        lines.push(Buffer.from(`${line}\0`, 'utf8'));
     }
-    arr.push(shaders.join(",\n"));
-    arr.push('\n}');
-    return arr.join("");
-}).join("\n,") + '}');
+    return index;
+};
 
-let encoded = newShaders.join(',\n');
+layout.push(u32(shaders.length));
+for (const eff of shaders) {
+    layout.push(u32(eff.length));
+    for (const s of eff) {
+        const stages = Object.keys(s);
+        layout.push(u32(stages.length));
+        for (const stage of stages) {
+            const indices = s[stage].split('\n').map(indexOfLine);
+            layout.push(Buffer.from(`${stage}\0`, 'utf8'));
+            layout.push(u32(indices.length));
+            indices.forEach((i) => layout.push(u32(i)));
+        }
+    }
+}
 
+let encoded = zlib.gzipSync(Buffer.concat([u32(lines.length), ...lines, ...layout]), { level: 9 }).toString('base64');
+let array = [];
+let start = 0, last = encoded.length;
+const charPerRow = 118;
+while (start < last) {
+    array.push(`"${encoded.substr(start, charPerRow)}"`);
+    start += charPerRow;
+}
+encoded = array.join("\n");
 
 if(VERBOSE) {
     console.log(`--gen ${outputFile} : ${exportVar}`);
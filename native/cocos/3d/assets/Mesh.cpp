@@ -27,10 +27,14 @@
 #include "3d/assets/Morph.h"
 #include "3d/assets/Skeleton.h"
 #include "3d/misc/BufferBlob.h"
+#include "3d/misc/MeshCodec.h"
+#include "base/job-system/JobSystem.h"
+#include "base/memory/MemoryAccounting.h"
 #include "boost/container_hash/hash.hpp"
 #include "core/DataView.h"
 #include "core/assets/RenderingSubMesh.h"
 #include "core/platform/Debug.h"
+#include "math/MathUtil.h"
 #include "math/Quaternion.h"
 #include "renderer/gfx-base/GFXDevice.h"
 
@@ -101,6 +105,9 @@ DataReaderCallback getReader(const DataView &dataView, gfx::Format format) {
             break;
         }
         case gfx::FormatType::FLOAT: {
+            if (stride == 2) {
+                return [&](uint32_t offset) -> TypedArrayElementType { return meshcodec::halfToFloat(dataView.getUint16(offset)); };
+            }
             return [&](uint32_t offset) -> TypedArrayElementType { return dataView.getFloat32(offset); };
         }
         default:
@@ -130,8 +137,8 @@ DataWritterCallback getWriter(DataView &dataView, gfx::Format format) {
         case gfx::FormatType::SNORM: {
             switch (stride) {
                 case 1: return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setInt8(offset, cc::get<int8_t>(value)); };
-                case 2: return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setInt16(offset, cc::get<int8_t>(value)); };
-                case 4: return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setInt32(offset, cc::get<int8_t>(value)); };
+                case 2: return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setInt16(offset, cc::get<int16_t>(value)); };
+                case 4: return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setInt32(offset, cc::get<int32_t>(value)); };
                 default:
                     break;
             }
@@ -158,6 +165,9 @@ DataWritterCallback getWriter(DataView &dataView, gfx::Format format) {
             break;
         }
         case gfx::FormatType::FLOAT: {
+            if (stride == 2) {
+                return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setUint16(offset, meshcodec::floatToHalf(cc::get<float>(value))); };
+            }
             return [&](uint32_t offset, const TypedArrayElementType &value) { dataView.setFloat32(offset, cc::get<float>(value)); };
         }
         default:
@@ -167,9 +177,42 @@ DataWritterCallback getWriter(DataView &dataView, gfx::Format format) {
     return nullptr;
 }
 
+uint32_t readIndex(const uint8_t *src, uint32_t stride) {
+    switch (stride) {
+        case 1: return *src;
+        case 2: return *reinterpret_cast<const uint16_t *>(src);
+        default: return *reinterpret_cast<const uint32_t *>(src);
+    }
+}
+
+void writeIndex(uint8_t *dst, uint32_t stride, uint32_t value) {
+    switch (stride) {
+        case 1: *dst = static_cast<uint8_t>(value); break;
+        case 2: *reinterpret_cast<uint16_t *>(dst) = static_cast<uint16_t>(value); break;
+        default: *reinterpret_cast<uint32_t *>(dst) = value; break;
+    }
+}
+
+bool isSameLayout(const gfx::AttributeList &lhs, const gfx::AttributeList &rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i].name != rhs[i].name || lhs[i].format != rhs[i].format) return false;
+    }
+    return true;
+}
+
+// positions and normals stored as float32 vectors are transformed when merging
+bool isTransformedAttribute(const gfx::Attribute &attribute) {
+    if (attribute.name != gfx::ATTR_NAME_POSITION && attribute.name != gfx::ATTR_NAME_NORMAL) return false;
+    const auto &info = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)];
+    return info.type == gfx::FormatType::FLOAT && info.count >= 3 && info.size == info.count * sizeof(float);
+}
+
 } // namespace
 
-Mesh::~Mesh() = default;
+Mesh::~Mesh() {
+    CC_MEMORY_ACCOUNT_FREE(MESH, _accountedDataSize);
+}
 
 cc::any Mesh::getNativeAsset() const {
     return _data; //cjh FIXME: need copy? could be _data pointer?
@@ -224,6 +267,17 @@ void Mesh::initialize() {
 
     _initialized = true;
 
+    if (_struct.encoded) {
+        auto decoded = meshcodec::decode({_struct, _data});
+        if (decoded.structInfo.encoded) {
+            CC_LOG_ERROR("Mesh: failed to decode the compressed vertex data.");
+            return;
+        }
+        _struct = std::move(decoded.structInfo);
+        _data   = std::move(decoded.data);
+        _hash   = 0;
+    }
+
     if (_struct.dynamic.has_value()) {
         auto *          device = gfx::Device::getInstance();
         gfx::BufferList vertexBuffers;
@@ -347,6 +401,10 @@ void Mesh::initialize() {
 
         _renderingSubMeshes = subMeshes;
 
+        // the CPU copy of the data stays alive as long as the rendering mesh
+        _accountedDataSize = _data.byteLength();
+        CC_MEMORY_ACCOUNT_ALLOC(MESH, _accountedDataSize);
+
         if (_struct.morph.has_value()) {
             morphRendering = createMorphRendering(this, gfxDevice);
         }
@@ -354,6 +412,9 @@ void Mesh::initialize() {
 }
 
 void Mesh::destroyRenderingMesh() {
+    CC_MEMORY_ACCOUNT_FREE(MESH, _accountedDataSize);
+    _accountedDataSize = 0;
+    _triangleBVHs.clear();
     if (!_renderingSubMeshes.empty()) {
         for (auto &submesh : _renderingSubMeshes) {
             submesh->destroy();
@@ -372,9 +433,32 @@ void Mesh::reset(ICreateInfo &&info) {
     _struct = std::move(info.structInfo);
     _data   = std::move(info.data);
     _hash   = 0;
+    _boneSpaceBounds.clear();
 }
 
-Mesh::BoneSpaceBounds Mesh::getBoneSpaceBounds(Skeleton *skeleton) {
+const geometry::TriangleBVH *Mesh::getTriangleBVH(index_t subMeshIndex) {
+    // never initializes the rendering mesh, the sub meshes must already exist
+    const auto &subMeshes = _renderingSubMeshes;
+    if (subMeshIndex >= subMeshes.size()) {
+        return nullptr;
+    }
+    if (_triangleBVHs.size() < subMeshes.size()) {
+        _triangleBVHs.resize(subMeshes.size());
+    }
+
+    auto *      subMesh = subMeshes[subMeshIndex].get();
+    const auto &info    = subMesh->getGeometricInfo();
+    auto &      bvh     = _triangleBVHs[subMeshIndex];
+    // the geometric info gets new positions whenever it is regenerated
+    if (!bvh || bvh->getSource() != info.positions.buffer()) {
+        bvh = new geometry::TriangleBVH();
+        bvh->build(info.positions, info.indices.has_value() ? &info.indices.value() : nullptr, subMesh->getPrimitiveMode());
+        bvh->setSource(info.positions.buffer());
+    }
+    return bvh.get();
+}
+
+const Mesh::BoneSpaceBounds &Mesh::getBoneSpaceBounds(Skeleton *skeleton) {
     auto iter = _boneSpaceBounds.find(skeleton->getHash());
     if (iter != _boneSpaceBounds.end()) {
         return iter->second;
@@ -752,6 +836,216 @@ bool Mesh::merge(Mesh *mesh, const Mat4 *worldMatrix /* = nullptr */, bool valid
     return true;
 }
 
+bool Mesh::mergeMeshes(const ccstd::vector<Mesh *> &meshes, const ccstd::vector<Mat4> &worldMatrices, bool validate /* = false*/) {
+    CC_ASSERT(worldMatrices.empty() || worldMatrices.size() == meshes.size());
+
+    // the current content stays first and untransformed, as with merge()
+    ccstd::vector<Mesh *>       sources;
+    ccstd::vector<const Mat4 *> matrices;
+    if (_initialized) {
+        sources.emplace_back(this);
+        matrices.emplace_back(nullptr);
+    }
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        sources.emplace_back(meshes[i]);
+        matrices.emplace_back(worldMatrices.empty() ? nullptr : &worldMatrices[i]);
+    }
+    if (sources.empty()) {
+        return true;
+    }
+
+    const IStruct &layout = sources[0]->_struct;
+    for (auto *source : sources) {
+        const auto &structInfo = source->_struct;
+        if (structInfo.encoded || !source->_data.buffer()) {
+            return false;
+        }
+        if (validate && source != sources[0] && !sources[0]->validateMergingMesh(source)) {
+            return false;
+        }
+        if (structInfo.vertexBundles.size() != layout.vertexBundles.size() || structInfo.primitives.size() != layout.primitives.size()) {
+            return false;
+        }
+    }
+
+    const size_t sourceCount    = sources.size();
+    const size_t bundleCount    = layout.vertexBundles.size();
+    const size_t primitiveCount = layout.primitives.size();
+
+    // first vertex and first index of every source, sourceCount + 1 entries per bundle or primitive
+    ccstd::vector<uint32_t> vertexBases(bundleCount * (sourceCount + 1), 0);
+    ccstd::vector<uint32_t> indexBases(primitiveCount * (sourceCount + 1), 0);
+    for (size_t b = 0; b < bundleCount; ++b) {
+        uint32_t *bases = vertexBases.data() + b * (sourceCount + 1);
+        for (size_t k = 0; k < sourceCount; ++k) {
+            bases[k + 1] = bases[k] + sources[k]->_struct.vertexBundles[b].view.count;
+        }
+    }
+    for (size_t i = 0; i < primitiveCount; ++i) {
+        uint32_t *bases = indexBases.data() + i * (sourceCount + 1);
+        for (size_t k = 0; k < sourceCount; ++k) {
+            const auto &indexView = sources[k]->_struct.primitives[i].indexView;
+            bases[k + 1]          = bases[k] + (indexView.has_value() ? indexView->count : 0);
+        }
+    }
+    auto getVertexBase = [&](const ISubMesh &primitive, size_t k) {
+        uint32_t base = 0;
+        for (const uint32_t bundleIdx : primitive.vertexBundelIndices) {
+            base = std::max(base, vertexBases[bundleIdx * (sourceCount + 1) + k]);
+        }
+        return base;
+    };
+
+    IStruct  meshStruct;
+    uint32_t size = 0;
+    meshStruct.vertexBundles.resize(bundleCount);
+    for (size_t b = 0; b < bundleCount; ++b) {
+        auto &bundle       = meshStruct.vertexBundles[b];
+        bundle.attributes  = layout.vertexBundles[b].attributes;
+        bundle.view.stride = layout.vertexBundles[b].view.stride;
+        bundle.view.count  = vertexBases[b * (sourceCount + 1) + sourceCount];
+        bundle.view.length = bundle.view.count * bundle.view.stride;
+        bundle.view.offset = size;
+        size += (bundle.view.length + 3U) & ~3U;
+    }
+    meshStruct.primitives.resize(primitiveCount);
+    for (size_t i = 0; i < primitiveCount; ++i) {
+        auto &primitive               = meshStruct.primitives[i];
+        primitive.primitiveMode       = layout.primitives[i].primitiveMode;
+        primitive.vertexBundelIndices = layout.primitives[i].vertexBundelIndices;
+        if (!layout.primitives[i].indexView.has_value()) {
+            continue;
+        }
+
+        // the stride follows the largest index value, not the index count
+        IBufferView indexView;
+        indexView.count  = indexBases[i * (sourceCount + 1) + sourceCount];
+        indexView.stride = getVertexBase(primitive, sourceCount) <= 65536 ? 2 : 4;
+        indexView.length = indexView.count * indexView.stride;
+        indexView.offset = size;
+        size += (indexView.length + 3U) & ~3U;
+        primitive.indexView = indexView;
+    }
+
+    Uint8Array data(size);
+    uint8_t *  dst = data.buffer()->getData();
+
+    auto mergeSource = [&](uint32_t k) {
+        const auto &   structInfo = sources[k]->_struct;
+        const uint8_t *srcData    = sources[k]->_data.buffer()->getData();
+        const Mat4 *   matrix     = matrices[k];
+        Mat4           rotation;
+        if (matrix != nullptr) {
+            Quaternion rotate;
+            matrix->getRotation(&rotate);
+            Mat4::createRotation(rotate, &rotation);
+        }
+
+        for (size_t b = 0; b < bundleCount; ++b) {
+            const auto &   srcBundle   = structInfo.vertexBundles[b];
+            const auto &   dstBundle   = meshStruct.vertexBundles[b];
+            const uint32_t count       = srcBundle.view.count;
+            const uint32_t dstStride   = dstBundle.view.stride;
+            const uint8_t *srcVertices = srcData + srcBundle.view.offset;
+            uint8_t *      dstVertices = dst + dstBundle.view.offset + vertexBases[b * (sourceCount + 1) + k] * dstStride;
+
+            if (srcBundle.view.stride == dstStride && isSameLayout(srcBundle.attributes, dstBundle.attributes)) {
+                memcpy(dstVertices, srcVertices, count * dstStride);
+            } else {
+                uint32_t dstAttrOffset = 0;
+                for (const auto &attr : dstBundle.attributes) {
+                    const uint32_t attrSize      = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+                    uint32_t       srcAttrOffset = 0;
+                    for (const auto &srcAttr : srcBundle.attributes) {
+                        if (attr.name == srcAttr.name && attr.format == srcAttr.format) {
+                            for (uint32_t v = 0; v < count; ++v) {
+                                memcpy(dstVertices + v * dstStride + dstAttrOffset, srcVertices + v * srcBundle.view.stride + srcAttrOffset, attrSize);
+                            }
+                            break;
+                        }
+                        srcAttrOffset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(srcAttr.format)].size;
+                    }
+                    dstAttrOffset += attrSize;
+                }
+            }
+
+            if (matrix != nullptr) {
+                uint32_t attrOffset = 0;
+                for (const auto &attr : dstBundle.attributes) {
+                    if (isTransformedAttribute(attr)) {
+                        const bool     isPosition = attr.name == gfx::ATTR_NAME_POSITION;
+                        const float *  m          = isPosition ? matrix->m : rotation.m;
+                        uint8_t *const vectors    = dstVertices + attrOffset;
+                        MathUtil::transformVec3Batch(m, vectors, dstStride, vectors, dstStride, count, isPosition ? 1.F : 0.F);
+                    }
+                    attrOffset += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < primitiveCount; ++i) {
+            const auto &srcView = structInfo.primitives[i].indexView;
+            const auto &dstView = meshStruct.primitives[i].indexView;
+            if (!srcView.has_value() || !dstView.has_value()) {
+                continue;
+            }
+            const uint32_t base       = getVertexBase(meshStruct.primitives[i], k);
+            const uint8_t *srcIndices = srcData + srcView->offset;
+            uint8_t *      dstIndices = dst + dstView->offset + indexBases[i * (sourceCount + 1) + k] * dstView->stride;
+            for (uint32_t n = 0; n < srcView->count; ++n) {
+                writeIndex(dstIndices + n * dstView->stride, dstView->stride, base + readIndex(srcIndices + n * srcView->stride, srcView->stride));
+            }
+        }
+    };
+
+    if (sourceCount > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(sourceCount), 1U, mergeSource);
+        g.run();
+        g.waitForAll();
+    } else {
+        mergeSource(0);
+    }
+
+    if (layout.minPosition.has_value() && layout.maxPosition.has_value()) {
+        Vec3 minPosition{layout.minPosition.value()};
+        Vec3 maxPosition{layout.maxPosition.value()};
+        bool first = true;
+        for (size_t k = 0; k < sourceCount; ++k) {
+            const auto &structInfo = sources[k]->_struct;
+            if (!structInfo.minPosition.has_value() || !structInfo.maxPosition.has_value()) {
+                continue;
+            }
+            Vec3 sourceMin{structInfo.minPosition.value()};
+            Vec3 sourceMax{structInfo.maxPosition.value()};
+            if (matrices[k] != nullptr) {
+                geometry::AABB boundingBox;
+                Vec3::add(sourceMax, sourceMin, &boundingBox.center);
+                boundingBox.center.scale(0.5F);
+                Vec3::subtract(sourceMax, sourceMin, &boundingBox.halfExtents);
+                boundingBox.halfExtents.scale(0.5F);
+                boundingBox.transform(*matrices[k], &boundingBox);
+                Vec3::add(boundingBox.center, boundingBox.halfExtents, &sourceMax);
+                Vec3::subtract(boundingBox.center, boundingBox.halfExtents, &sourceMin);
+            }
+            if (first) {
+                minPosition = sourceMin;
+                maxPosition = sourceMax;
+                first       = false;
+            } else {
+                Vec3::min(minPosition, sourceMin, &minPosition);
+                Vec3::max(maxPosition, sourceMax, &maxPosition);
+            }
+        }
+        meshStruct.minPosition = minPosition;
+        meshStruct.maxPosition = maxPosition;
+    }
+
+    reset({std::move(meshStruct), std::move(data)});
+    initialize();
+    return true;
+}
+
 bool Mesh::validateMergingMesh(Mesh *mesh) {
     // dynamic mesh is not allowed to merge.
     if (_struct.dynamic.has_value() || mesh->_struct.dynamic.has_value()) {
@@ -826,12 +1120,13 @@ TypedArray Mesh::readAttribute(index_t primitiveIndex, const char *attributeName
             return;
         }
 
-        const uint32_t componentCount = formatInfo.count;
-        result                        = createTypedArrayWithGFXFormat(format, vertexCount * componentCount);
-        const uint32_t inputStride    = vertexBundle.view.stride;
+        const uint32_t componentCount      = formatInfo.count;
+        result                             = createTypedArrayWithGFXFormat(format, vertexCount * componentCount);
+        const uint32_t inputStride         = vertexBundle.view.stride;
+        const uint32_t componentByteLength = getComponentByteLength(format);
         for (uint32_t iVertex = 0; iVertex < vertexCount; ++iVertex) {
             for (uint32_t iComponent = 0; iComponent < componentCount; ++iComponent) {
-                TypedArrayElementType element = reader(inputStride * iVertex + getTypedArrayBytesPerElement(result) * iComponent);
+                TypedArrayElementType element = reader(inputStride * iVertex + componentByteLength * iComponent);
                 setTypedArrayValue(result, componentCount * iVertex + iComponent, element);
             }
         }
@@ -1035,6 +1330,10 @@ void Mesh::updateSubMesh(index_t primitiveIndex, const IDynamicGeometry &geometr
     }
 
     subMesh->invalidateGeometricInfo();
+    _boneSpaceBounds.clear();
+    if (primitiveIndex < _triangleBVHs.size()) {
+        _triangleBVHs[primitiveIndex] = nullptr;
+    }
 }
 
 void Mesh::accessAttribute(index_t primitiveIndex, const char *attributeName, const AccessorType &accessor) {
@@ -30,6 +30,7 @@
 #include "cocos/base/Optional.h"
 #include "core/assets/Asset.h"
 #include "core/geometry/AABB.h"
+#include "core/geometry/BVH.h"
 #include "math/Mat4.h"
 #include "math/Vec3.h"
 #include "primitive/PrimitiveDefine.h"
@@ -185,6 +186,13 @@ public:
          * @zh 动态网格特有数据
          */
         cc::optional<IDynamicStruct> dynamic;
+
+        /**
+         * @en Whether the vertex bundles and index views are compressed by meshcodec::encode,
+         * their view lengths are then the compressed byte lengths. The mesh decodes them on initialize.
+         * @zh 顶点块与索引数据是否经 meshcodec::encode 压缩，此时视图长度为压缩后的字节长度。网格在初始化时解压。
+         */
+        bool encoded{false};
     };
 
     struct ICreateInfo {
@@ -324,13 +332,22 @@ public:
      */
     void reset(ICreateInfo &&info);
 
+    /**
+     * @en Get the triangle BVH of a sub mesh in model space, it is built on first use and rebuilt when the geometry changes.
+     * Returns nullptr if the rendering sub meshes are not created.
+     * @zh 获取子网格在模型空间下的三角形层次包围体，首次使用时构建，几何数据变化后重新构建。渲染子网格未创建时返回 nullptr。
+     * @param subMeshIndex sub mesh index
+     */
+    const geometry::TriangleBVH *getTriangleBVH(index_t subMeshIndex);
+
     using BoneSpaceBounds = ccstd::vector<IntrusivePtr<geometry::AABB>>;
     /**
      * @en Get [[AABB]] bounds in the skeleton's bone space
      * @zh 获取骨骼变换空间内下的 [[AABB]] 包围盒
      * @param skeleton
+     * @note The bounds are computed once per skeleton and kept until the mesh data changes.
      */
-    BoneSpaceBounds getBoneSpaceBounds(Skeleton *skeleton);
+    const BoneSpaceBounds &getBoneSpaceBounds(Skeleton *skeleton);
 
     /**
      * @en Merge the given mesh into the current mesh
@@ -342,6 +359,18 @@ public:
      */
     bool merge(Mesh *mesh, const Mat4 *worldMatrix = nullptr, bool validate = false);
 
+    /**
+     * @en Merge several meshes into the current mesh at once, the result is the same as merging them one by one.
+     * The output layout is computed up front and every mesh is written straight into the final buffer on the job system.
+     * @zh 一次性合并多个网格到此网格中，结果与逐个合并相同。
+     * 合并前先计算输出布局，每个网格在任务系统上直接写入最终缓冲区。
+     * @param meshes The meshes to be merged
+     * @param worldMatrices The world matrix of each mesh, or empty to keep the meshes untransformed
+     * @param [validate=false] Whether to validate the meshes
+     * @returns Whether all the meshes are merged.
+     */
+    bool mergeMeshes(const ccstd::vector<Mesh *> &meshes, const ccstd::vector<Mat4> &worldMatrices, bool validate = false);
+
     /**
      * @en Validation for whether the given mesh can be merged into the current mesh.
      * To pass the validation, it must satisfy either of these two requirements:
@@ -434,6 +463,7 @@ private:
     IStruct    _struct;
     uint64_t   _hash{0};
     Uint8Array _data;
+    uint32_t   _accountedDataSize{0}; // bytes of _data reported to MemoryAccounting
 
     bool _initialized{false};
 
@@ -441,6 +471,8 @@ private:
 
     ccstd::unordered_map<uint64_t, BoneSpaceBounds> _boneSpaceBounds;
 
+    ccstd::vector<IntrusivePtr<geometry::TriangleBVH>> _triangleBVHs;
+
     JointBufferIndicesType _jointBufferIndices;
 
     friend class MeshDeserializer;
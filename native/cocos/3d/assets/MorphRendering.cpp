@@ -25,6 +25,7 @@
 
 #include "3d/assets/MorphRendering.h"
 
+#include <cstring>
 #include <memory>
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Morph.h"
@@ -36,6 +37,7 @@
 #include "core/assets/Texture2D.h"
 #include "platform/Image.h"
 #include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/RenderPipeline.h"
 #include "scene/Pass.h"
 
 namespace cc {
@@ -164,11 +166,15 @@ struct GpuMorphAttribute {
     IntrusivePtr<MorphTexture> morphTexture;
 };
 
-struct CpuMorphAttributeTarget {
-    Float32Array displacements;
+/**
+ * Displacements of the vertices moved by a morph target, the other vertices are not stored.
+ */
+struct SparseMorphTarget {
+    ccstd::vector<uint32_t> vertices;
+    ccstd::vector<float>    displacements; // 3 per vertex
 };
 
-using CpuMorphAttributeTargetList = ccstd::vector<CpuMorphAttributeTarget>;
+using CpuMorphAttributeTargetList = ccstd::vector<SparseMorphTarget>;
 
 struct CpuMorphAttribute {
     ccstd::string               name;
@@ -181,6 +187,26 @@ struct Vec4TextureFactory {
     std::function<MorphTexture *()> create{nullptr};
 };
 
+pipeline::ComputeMorphing *getComputeMorphing() {
+    auto *pipeline = pipeline::RenderPipeline::getInstance();
+    return pipeline ? &pipeline->getComputeMorphing() : nullptr;
+}
+
+Float32Array getDisplacements(Mesh *mesh, const MorphTarget &morphTarget, size_t attributeIndex) {
+    const auto &displacementsView = morphTarget.displacements[attributeIndex];
+    return Float32Array(mesh->getData().buffer(), mesh->getData().byteOffset() + displacementsView.offset, displacementsView.count);
+}
+
+bool isZeroDisplacement(const Float32Array &displacements, uint32_t iVertex) {
+    return displacements[3 * iVertex + 0] == 0.F && displacements[3 * iVertex + 1] == 0.F && displacements[3 * iVertex + 2] == 0.F;
+}
+
+uint32_t floatBits(float value) {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
 /**
  * Decides a best texture size to have the specified pixel capacity at least.
  * The decided width and height has the following characteristics:
@@ -330,10 +356,12 @@ public:
 
     SubMeshMorphRenderingInstance *         createInstance() override;
     const ccstd::vector<CpuMorphAttribute> &getData() const;
+    inline uint32_t                         getVerticesCount() const { return _verticesCount; }
 
 private:
     ccstd::vector<CpuMorphAttribute> _attributes;
     gfx::Device *                    _gfxDevice{nullptr};
+    uint32_t                         _verticesCount{0};
 };
 
 class GpuComputing final : public SubMeshMorphRendering {
@@ -354,6 +382,32 @@ private:
     friend class GpuComputingRenderingInstance;
 };
 
+/**
+ * Accumulates the sparse displacements of the targets of non-zero weights with compute shaders into one texture per attribute.
+ */
+class ComputeShaderComputing final : public SubMeshMorphRendering {
+public:
+    explicit ComputeShaderComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph, gfx::Device *gfxDevice);
+    ~ComputeShaderComputing() override;
+    SubMeshMorphRenderingInstance *createInstance() override;
+
+private:
+    struct SparseAttribute {
+        ccstd::string             attributeName;
+        IntrusivePtr<gfx::Buffer> rangeBuffer; // first delta of each vertex, plus the end
+        IntrusivePtr<gfx::Buffer> deltaBuffer; // displacement bits and target index, sorted by vertex
+    };
+
+    gfx::Device *                  _gfxDevice{nullptr};
+    uint32_t                       _targetCount{0};
+    uint32_t                       _verticesCount{0};
+    uint32_t                       _textureWidth{0};
+    uint32_t                       _textureHeight{0};
+    ccstd::vector<SparseAttribute> _attributes;
+
+    friend class ComputeShaderComputingRenderingInstance;
+};
+
 class CpuComputingRenderingInstance final : public SubMeshMorphRenderingInstance {
 public:
     explicit CpuComputingRenderingInstance(CpuComputing *owner, uint32_t nVertices, gfx::Device *gfxDevice) {
@@ -370,27 +424,33 @@ public:
     }
 
     void setWeights(const ccstd::vector<float> &weights) override {
+        if (weights == _weights) {
+            return;
+        }
+        _weights = weights;
+
+        const uint32_t nVertices = _owner->getVerticesCount();
         for (size_t iAttribute = 0; iAttribute < _attributes.size(); ++iAttribute) {
             const auto &  myAttribute    = _attributes[iAttribute];
             Float32Array &valueView      = myAttribute.morphTexture->getValueView();
             const auto &  attributeMorph = _owner->getData()[iAttribute];
             CC_ASSERT(weights.size() == attributeMorph.targets.size());
+            for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+                valueView[4 * iVertex + 0] = 0.F;
+                valueView[4 * iVertex + 1] = 0.F;
+                valueView[4 * iVertex + 2] = 0.F;
+            }
             for (size_t iTarget = 0; iTarget < attributeMorph.targets.size(); ++iTarget) {
-                const auto &   targetDisplacements = attributeMorph.targets[iTarget].displacements;
-                const float    weight              = weights[iTarget];
-                const uint32_t nVertices           = targetDisplacements.length() / 3;
-                if (iTarget == 0) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] = targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] = targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] = targetDisplacements[3 * iVertex + 2] * weight;
-                    }
-                } else if (std::fabs(weight) >= std::numeric_limits<float>::epsilon()) {
-                    for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
-                        valueView[4 * iVertex + 0] += targetDisplacements[3 * iVertex + 0] * weight;
-                        valueView[4 * iVertex + 1] += targetDisplacements[3 * iVertex + 1] * weight;
-                        valueView[4 * iVertex + 2] += targetDisplacements[3 * iVertex + 2] * weight;
-                    }
+                const float weight = weights[iTarget];
+                if (std::fabs(weight) < std::numeric_limits<float>::epsilon()) {
+                    continue;
+                }
+                const auto &target = attributeMorph.targets[iTarget];
+                for (size_t i = 0; i < target.vertices.size(); ++i) {
+                    const uint32_t pixel = 4 * target.vertices[i];
+                    valueView[pixel + 0] += target.displacements[3 * i + 0] * weight;
+                    valueView[pixel + 1] += target.displacements[3 * i + 1] * weight;
+                    valueView[pixel + 2] += target.displacements[3 * i + 2] * weight;
                 }
             }
 
@@ -439,6 +499,7 @@ private:
     ccstd::vector<GpuMorphAttribute> _attributes;
     IntrusivePtr<CpuComputing>       _owner;
     IntrusivePtr<MorphUniforms>      _morphUniforms;
+    ccstd::vector<float>             _weights;
 };
 
 class GpuComputingRenderingInstance final : public SubMeshMorphRenderingInstance {
@@ -495,36 +556,162 @@ private:
     IntrusivePtr<MorphUniforms>       _morphUniforms;
 };
 
+class ComputeShaderComputingRenderingInstance final : public SubMeshMorphRenderingInstance {
+public:
+    explicit ComputeShaderComputingRenderingInstance(ComputeShaderComputing *owner, pipeline::ComputeMorphing *computeMorphing, gfx::Device *gfxDevice) {
+        _owner         = owner;
+        _morphUniforms = new MorphUniforms(gfxDevice, 0);
+        _morphUniforms->setMorphTextureInfo(static_cast<float>(_owner->_textureWidth), static_cast<float>(_owner->_textureHeight));
+        _morphUniforms->commit();
+
+        const uint32_t weightsSize = std::max(_owner->_targetCount, 1U) * sizeof(float);
+        _weightBuffer              = gfxDevice->createBuffer({
+            gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            weightsSize,
+            sizeof(float),
+        });
+        _weights.assign(_owner->_targetCount, 0.F);
+        if (!_weights.empty()) {
+            _weightBuffer->update(_weights.data(), weightsSize);
+        }
+
+        gfx::SamplerInfo samplerInfo;
+        samplerInfo.minFilter = gfx::Filter::POINT;
+        samplerInfo.magFilter = gfx::Filter::POINT;
+        samplerInfo.addressU  = gfx::Address::CLAMP;
+        samplerInfo.addressV  = gfx::Address::CLAMP;
+        samplerInfo.addressW  = gfx::Address::CLAMP;
+        _sampler              = gfxDevice->getSampler(samplerInfo);
+
+        for (const auto &attribute : _owner->_attributes) {
+            if (computeMorphing == nullptr) {
+                _targets.emplace_back(attribute.attributeName, nullptr);
+                continue;
+            }
+            auto *target = computeMorphing->createTarget(attribute.rangeBuffer, attribute.deltaBuffer, _weightBuffer,
+                                                         _owner->_verticesCount, _owner->_textureWidth, _owner->_textureHeight);
+            if (target != nullptr) {
+                // the displacements are undefined until the first dispatch
+                computeMorphing->enqueue(target);
+            }
+            _targets.emplace_back(attribute.attributeName, target);
+        }
+    }
+
+    ~ComputeShaderComputingRenderingInstance() override {
+        destroyTargets();
+    }
+
+    void setWeights(const ccstd::vector<float> &weights) override {
+        CC_ASSERT(weights.size() == _weights.size());
+        if (weights == _weights || weights.empty()) {
+            return;
+        }
+        _weights = weights;
+        _weightBuffer->update(_weights.data(), static_cast<uint32_t>(_weights.size() * sizeof(float)));
+
+        auto *computeMorphing = getComputeMorphing();
+        if (computeMorphing == nullptr) {
+            return;
+        }
+        for (const auto &target : _targets) {
+            if (target.second != nullptr) {
+                computeMorphing->enqueue(target.second);
+            }
+        }
+    }
+
+    ccstd::vector<scene::IMacroPatch> requiredPatches() override {
+        return {
+            {"CC_MORPH_TARGET_USE_TEXTURE", true},
+            {"CC_MORPH_PRECOMPUTED", true},
+        };
+    }
+
+    void adaptPipelineState(gfx::DescriptorSet *descriptorSet) override {
+        for (const auto &target : _targets) {
+            const auto &           attributeName = target.first;
+            cc::optional<uint32_t> binding;
+            if (attributeName == gfx::ATTR_NAME_POSITION) {
+                binding = uint32_t{pipeline::POSITIONMORPH::BINDING};
+            } else if (attributeName == gfx::ATTR_NAME_NORMAL) {
+                binding = uint32_t{pipeline::NORMALMORPH::BINDING};
+            } else if (attributeName == gfx::ATTR_NAME_TANGENT) {
+                binding = uint32_t{pipeline::TANGENTMORPH::BINDING};
+            } else {
+                CC_LOG_WARNING("Unexpected attribute!");
+            }
+
+            if (binding.has_value() && target.second != nullptr) {
+                descriptorSet->bindSampler(binding.value(), _sampler);
+                descriptorSet->bindTexture(binding.value(), target.second->getOutputTexture());
+            }
+        }
+        descriptorSet->bindBuffer(pipeline::UBOMorph::BINDING, _morphUniforms->getBuffer());
+        descriptorSet->update();
+    }
+
+    void destroy() override {
+        destroyTargets();
+        CC_SAFE_DESTROY(_morphUniforms);
+        CC_SAFE_DESTROY(_weightBuffer);
+    }
+
+private:
+    void destroyTargets() {
+        auto *computeMorphing = getComputeMorphing();
+        for (auto &target : _targets) {
+            if (target.second != nullptr && computeMorphing != nullptr) {
+                computeMorphing->cancel(target.second);
+            }
+            CC_SAFE_DELETE(target.second);
+        }
+        _targets.clear();
+    }
+
+    IntrusivePtr<ComputeShaderComputing>                                       _owner;
+    IntrusivePtr<MorphUniforms>                                                _morphUniforms;
+    IntrusivePtr<gfx::Buffer>                                                  _weightBuffer;
+    gfx::Sampler *                                                             _sampler{nullptr};
+    ccstd::vector<std::pair<ccstd::string, pipeline::ComputeMorphingTarget *>> _targets;
+    ccstd::vector<float>                                                       _weights;
+};
+
 CpuComputing::CpuComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph, gfx::Device *gfxDevice) {
     _gfxDevice               = gfxDevice;
     const auto &subMeshMorph = morph->subMeshMorphs[subMeshIndex].value();
     enableVertexId(mesh, subMeshIndex, gfxDevice);
 
     for (size_t attributeIndex = 0, len = subMeshMorph.attributes.size(); attributeIndex < len; ++attributeIndex) {
-        const auto &attributeName = subMeshMorph.attributes[attributeIndex];
-
         CpuMorphAttribute attr;
-        attr.name = attributeName;
+        attr.name = subMeshMorph.attributes[attributeIndex];
         attr.targets.resize(subMeshMorph.targets.size());
 
-        uint32_t i = 0;
-        for (const auto &attributeDisplacement : subMeshMorph.targets) {
-            const Mesh::IBufferView &displacementsView = attributeDisplacement.displacements[attributeIndex];
-            attr.targets[i].displacements              = Float32Array(mesh->getData().buffer(),
-                                                         mesh->getData().byteOffset() + displacementsView.offset,
-                                                         attributeDisplacement.displacements[attributeIndex].count);
-
-            ++i;
+        for (size_t iTarget = 0; iTarget < subMeshMorph.targets.size(); ++iTarget) {
+            const Float32Array displacements = getDisplacements(mesh, subMeshMorph.targets[iTarget], attributeIndex);
+            const uint32_t     nVertices     = displacements.length() / 3;
+            auto &             target        = attr.targets[iTarget];
+            _verticesCount                   = std::max(_verticesCount, nVertices);
+            for (uint32_t iVertex = 0; iVertex < nVertices; ++iVertex) {
+                if (isZeroDisplacement(displacements, iVertex)) {
+                    continue;
+                }
+                target.vertices.emplace_back(iVertex);
+                target.displacements.emplace_back(displacements[3 * iVertex + 0]);
+                target.displacements.emplace_back(displacements[3 * iVertex + 1]);
+                target.displacements.emplace_back(displacements[3 * iVertex + 2]);
+            }
         }
 
-        _attributes.emplace_back(attr);
+        _attributes.emplace_back(std::move(attr));
     }
 }
 
 SubMeshMorphRenderingInstance *CpuComputing::createInstance() {
     return new CpuComputingRenderingInstance(
         this,
-        _attributes[0].targets[0].displacements.length() / 3,
+        _verticesCount,
         _gfxDevice);
 }
 
@@ -596,6 +783,76 @@ void GpuComputing::destroy() {
     }
 }
 
+ComputeShaderComputing::ComputeShaderComputing(Mesh *mesh, uint32_t subMeshIndex, const Morph *morph, gfx::Device *gfxDevice) {
+    _gfxDevice               = gfxDevice;
+    const auto &subMeshMorph = morph->subMeshMorphs[subMeshIndex].value();
+    enableVertexId(mesh, subMeshIndex, gfxDevice);
+
+    _verticesCount = mesh->getStruct().vertexBundles[mesh->getStruct().primitives[subMeshIndex].vertexBundelIndices[0]].view.count;
+    _targetCount   = static_cast<uint32_t>(subMeshMorph.targets.size());
+    bestSizeToHavePixels(_verticesCount, &_textureWidth, &_textureHeight);
+
+    _attributes.reserve(subMeshMorph.attributes.size());
+    for (size_t attributeIndex = 0; attributeIndex < subMeshMorph.attributes.size(); ++attributeIndex) {
+        ccstd::vector<Float32Array> displacements;
+        displacements.reserve(_targetCount);
+        for (const auto &morphTarget : subMeshMorph.targets) {
+            displacements.emplace_back(getDisplacements(mesh, morphTarget, attributeIndex));
+        }
+
+        // transposed to vertex major, so that each invocation only reads the deltas of its own vertex
+        ccstd::vector<uint32_t> ranges;
+        ccstd::vector<uint32_t> deltas;
+        ranges.reserve(_verticesCount + 1);
+        ranges.emplace_back(0);
+        for (uint32_t iVertex = 0; iVertex < _verticesCount; ++iVertex) {
+            for (uint32_t iTarget = 0; iTarget < _targetCount; ++iTarget) {
+                const auto &targetDisplacements = displacements[iTarget];
+                if (3 * iVertex + 2 >= targetDisplacements.length() || isZeroDisplacement(targetDisplacements, iVertex)) {
+                    continue;
+                }
+                deltas.emplace_back(floatBits(targetDisplacements[3 * iVertex + 0]));
+                deltas.emplace_back(floatBits(targetDisplacements[3 * iVertex + 1]));
+                deltas.emplace_back(floatBits(targetDisplacements[3 * iVertex + 2]));
+                deltas.emplace_back(iTarget);
+            }
+            ranges.emplace_back(static_cast<uint32_t>(deltas.size() / 4));
+        }
+        if (deltas.empty()) {
+            deltas.resize(4, 0); // storage buffers can't be empty
+        }
+
+        SparseAttribute attribute;
+        attribute.attributeName = subMeshMorph.attributes[attributeIndex];
+        attribute.rangeBuffer   = gfxDevice->createBuffer({
+            gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            static_cast<uint32_t>(ranges.size() * sizeof(uint32_t)),
+            sizeof(uint32_t),
+        });
+        attribute.rangeBuffer->update(ranges.data(), static_cast<uint32_t>(ranges.size() * sizeof(uint32_t)));
+        attribute.deltaBuffer = gfxDevice->createBuffer({
+            gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            static_cast<uint32_t>(deltas.size() * sizeof(uint32_t)),
+            4 * sizeof(uint32_t),
+        });
+        attribute.deltaBuffer->update(deltas.data(), static_cast<uint32_t>(deltas.size() * sizeof(uint32_t)));
+        _attributes.emplace_back(std::move(attribute));
+    }
+}
+
+ComputeShaderComputing::~ComputeShaderComputing() {
+    for (auto &attribute : _attributes) {
+        CC_SAFE_DESTROY(attribute.rangeBuffer);
+        CC_SAFE_DESTROY(attribute.deltaBuffer);
+    }
+}
+
+SubMeshMorphRenderingInstance *ComputeShaderComputing::createInstance() {
+    return new ComputeShaderComputingRenderingInstance(this, getComputeMorphing(), _gfxDevice);
+}
+
 } // namespace
 
 class StdMorphRenderingInstance : public MorphRenderingInstance {
@@ -693,7 +950,9 @@ StdMorphRendering::StdMorphRendering(Mesh *mesh, gfx::Device *gfxDevice) {
 
     const size_t nSubMeshes = structInfo.primitives.size();
     _subMeshRenderings.resize(nSubMeshes, nullptr);
-    const auto &morph = structInfo.morph.value();
+    const auto &morph           = structInfo.morph.value();
+    auto *      computeMorphing = getComputeMorphing();
+    const bool  useCompute      = !PREFER_CPU_COMPUTING && computeMorphing != nullptr && computeMorphing->isAvailable();
     for (size_t iSubMesh = 0; iSubMesh < nSubMeshes; ++iSubMesh) {
         const auto &subMeshMorphHolder = morph.subMeshMorphs[iSubMesh];
         if (!subMeshMorphHolder.has_value()) {
@@ -702,7 +961,13 @@ StdMorphRendering::StdMorphRendering(Mesh *mesh, gfx::Device *gfxDevice) {
 
         const auto &subMeshMorph = subMeshMorphHolder.value();
 
-        if (PREFER_CPU_COMPUTING || subMeshMorph.targets.size() > pipeline::UBOMorph::MAX_MORPH_TARGET_COUNT) {
+        if (useCompute) {
+            _subMeshRenderings[iSubMesh] = new ComputeShaderComputing(
+                _mesh,
+                static_cast<uint32_t>(iSubMesh),
+                &morph,
+                gfxDevice);
+        } else if (PREFER_CPU_COMPUTING || subMeshMorph.targets.size() > pipeline::UBOMorph::MAX_MORPH_TARGET_COUNT) {
             _subMeshRenderings[iSubMesh] = new CpuComputing(
                 _mesh,
                 static_cast<uint32_t>(iSubMesh),
@@ -0,0 +1,541 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "3d/misc/MeshCodec.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
+
+namespace cc {
+namespace meshcodec {
+
+namespace {
+
+constexpr uint8_t  VERTEX_CODEC_HEADER{0xa0};
+constexpr uint8_t  INDEX_CODEC_HEADER{0xb0};
+constexpr uint32_t VERTEX_BLOCK_SIZE{256};
+constexpr uint32_t VERTEX_GROUP_SIZE{16};
+
+// bits per delta of a vertex group, indexed by the 2 bit group header
+constexpr uint32_t GROUP_BITS[]{0, 2, 4, 8};
+
+inline uint8_t zigzag8(uint8_t delta) {
+    return static_cast<uint8_t>((delta << 1U) ^ static_cast<uint8_t>(static_cast<int8_t>(delta) >> 7));
+}
+
+inline uint8_t unzigzag8(uint8_t value) {
+    return static_cast<uint8_t>((value >> 1U) ^ static_cast<uint8_t>(-(value & 1U)));
+}
+
+inline uint64_t zigzag64(int64_t delta) {
+    return (static_cast<uint64_t>(delta) << 1U) ^ static_cast<uint64_t>(delta >> 63);
+}
+
+inline int64_t unzigzag64(uint64_t value) {
+    return static_cast<int64_t>((value >> 1U) ^ (~(value & 1U) + 1U));
+}
+
+uint32_t getGroupHeader(const uint8_t *deltas) {
+    uint8_t maxDelta = 0;
+    for (uint32_t i = 0; i < VERTEX_GROUP_SIZE; ++i) {
+        maxDelta = std::max(maxDelta, deltas[i]);
+    }
+    if (maxDelta == 0) return 0;
+    if (maxDelta < 4) return 1;
+    if (maxDelta < 16) return 2;
+    return 3;
+}
+
+void encodeGroup(ccstd::vector<uint8_t> &out, const uint8_t *deltas, uint32_t bits) {
+    if (bits == 8) {
+        out.insert(out.end(), deltas, deltas + VERTEX_GROUP_SIZE);
+        return;
+    }
+    const uint32_t perByte = 8 / bits;
+    for (uint32_t i = 0; i < VERTEX_GROUP_SIZE; i += perByte) {
+        uint8_t packed = 0;
+        for (uint32_t j = 0; j < perByte; ++j) {
+            packed |= static_cast<uint8_t>(deltas[i + j] << (j * bits));
+        }
+        out.push_back(packed);
+    }
+}
+
+void decodeGroup(uint8_t *deltas, const uint8_t *src, uint32_t bits) {
+    if (bits == 0) {
+        memset(deltas, 0, VERTEX_GROUP_SIZE);
+        return;
+    }
+    if (bits == 8) {
+        memcpy(deltas, src, VERTEX_GROUP_SIZE);
+        return;
+    }
+    const uint32_t perByte = 8 / bits;
+    const uint32_t mask    = (1U << bits) - 1U;
+    for (uint32_t i = 0; i < VERTEX_GROUP_SIZE; ++i) {
+        deltas[i] = static_cast<uint8_t>((src[i / perByte] >> ((i % perByte) * bits)) & mask);
+    }
+}
+
+uint32_t readIndex(const uint8_t *src, uint32_t stride) {
+    switch (stride) {
+        case 1: return *src;
+        case 2: {
+            uint16_t value;
+            memcpy(&value, src, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value;
+            memcpy(&value, src, sizeof(value));
+            return value;
+        }
+    }
+}
+
+void writeIndex(uint8_t *dst, uint32_t stride, uint32_t value) {
+    switch (stride) {
+        case 1: *dst = static_cast<uint8_t>(value); break;
+        case 2: {
+            const auto narrowed = static_cast<uint16_t>(value);
+            memcpy(dst, &narrowed, sizeof(narrowed));
+            break;
+        }
+        default: memcpy(dst, &value, sizeof(value)); break;
+    }
+}
+
+// views are placed 4 bytes aligned in the rebuilt buffer
+uint32_t allocate(uint32_t &size, std::size_t length) {
+    const uint32_t offset = (size + 3U) & ~3U;
+    size                  = offset + static_cast<uint32_t>(length);
+    return offset;
+}
+
+template <typename Struct, typename Func>
+void forEachMorphView(Struct &structInfo, Func &&func) {
+    if (!structInfo.morph.has_value()) return;
+    for (auto &subMeshMorph : structInfo.morph->subMeshMorphs) {
+        if (!subMeshMorph.has_value()) continue;
+        for (auto &target : subMeshMorph->targets) {
+            for (auto &view : target.displacements) {
+                func(view);
+            }
+        }
+    }
+}
+
+gfx::Format getQuantizedFormat(const gfx::Attribute &attribute, const QuantizeOptions &options) {
+    if (options.normals && attribute.name == gfx::ATTR_NAME_NORMAL && attribute.format == gfx::Format::RGB32F) {
+        return gfx::Format::RGBA16F;
+    }
+    if (options.tangents && attribute.name == gfx::ATTR_NAME_TANGENT && attribute.format == gfx::Format::RGBA32F) {
+        return gfx::Format::RGBA16F;
+    }
+    if (options.uvs && attribute.name == gfx::ATTR_NAME_TEX_COORD && attribute.format == gfx::Format::RG32F) {
+        return gfx::Format::RG16F;
+    }
+    return attribute.format;
+}
+
+// float32 to half, missing components are zero filled
+void quantizeAttribute(uint8_t *dst, gfx::Format dstFormat, const uint8_t *src, gfx::Format srcFormat) {
+    const uint32_t srcCount = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(srcFormat)].count;
+    const uint32_t dstCount = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(dstFormat)].count;
+    for (uint32_t i = 0; i < dstCount; ++i) {
+        float value = 0.F;
+        if (i < srcCount) memcpy(&value, src + i * sizeof(float), sizeof(float));
+        const uint16_t bits = floatToHalf(value);
+        memcpy(dst + i * sizeof(uint16_t), &bits, sizeof(uint16_t));
+    }
+}
+
+struct DecodeTask {
+    uint8_t *      dst{nullptr};
+    const uint8_t *src{nullptr};
+    std::size_t    size{0};
+    uint32_t       count{0};
+    uint32_t       stride{0};
+    bool           index{false};
+};
+
+} // namespace
+
+Mesh::ICreateInfo quantize(const Mesh::ICreateInfo &info, const QuantizeOptions &options) {
+    if (info.structInfo.dynamic.has_value() || info.structInfo.encoded || !info.data.buffer()) {
+        return info;
+    }
+
+    const uint8_t *   src = info.data.buffer()->getData();
+    Mesh::ICreateInfo result{info.structInfo, {}};
+    auto &            structInfo = result.structInfo;
+
+    uint32_t size = 0;
+    for (auto &bundle : structInfo.vertexBundles) {
+        uint32_t stride = 0;
+        for (auto &attribute : bundle.attributes) {
+            attribute.format = getQuantizedFormat(attribute, options);
+            stride += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)].size;
+        }
+        stride             = (stride + 3U) & ~3U;
+        bundle.view.stride = stride;
+        bundle.view.length = stride * bundle.view.count;
+        bundle.view.offset = allocate(size, bundle.view.length);
+    }
+    for (auto &primitive : structInfo.primitives) {
+        if (primitive.indexView.has_value()) {
+            primitive.indexView->offset = allocate(size, primitive.indexView->length);
+        }
+    }
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        view.offset = allocate(size, view.length);
+    });
+
+    result.data  = Uint8Array(size);
+    uint8_t *dst = result.data.buffer()->getData();
+
+    for (size_t i = 0; i < structInfo.vertexBundles.size(); ++i) {
+        const auto &srcBundle = info.structInfo.vertexBundles[i];
+        const auto &dstBundle = structInfo.vertexBundles[i];
+        for (uint32_t iVertex = 0; iVertex < srcBundle.view.count; ++iVertex) {
+            const uint8_t *srcVertex = src + srcBundle.view.offset + iVertex * srcBundle.view.stride;
+            uint8_t *      dstVertex = dst + dstBundle.view.offset + iVertex * dstBundle.view.stride;
+            for (size_t iAttribute = 0; iAttribute < srcBundle.attributes.size(); ++iAttribute) {
+                const gfx::Format srcFormat = srcBundle.attributes[iAttribute].format;
+                const gfx::Format dstFormat = dstBundle.attributes[iAttribute].format;
+                if (srcFormat == dstFormat) {
+                    memcpy(dstVertex, srcVertex, gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(srcFormat)].size);
+                } else {
+                    quantizeAttribute(dstVertex, dstFormat, srcVertex, srcFormat);
+                }
+                srcVertex += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(srcFormat)].size;
+                dstVertex += gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(dstFormat)].size;
+            }
+        }
+    }
+    for (size_t i = 0; i < structInfo.primitives.size(); ++i) {
+        const auto &srcView = info.structInfo.primitives[i].indexView;
+        if (srcView.has_value()) {
+            memcpy(dst + structInfo.primitives[i].indexView->offset, src + srcView->offset, srcView->length);
+        }
+    }
+    // morph views are visited in the same order for both structs
+    ccstd::vector<uint32_t> srcMorphOffsets;
+    forEachMorphView(info.structInfo, [&](const IMeshBufferView &view) { srcMorphOffsets.emplace_back(view.offset); });
+    size_t iMorphView = 0;
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        memcpy(dst + view.offset, src + srcMorphOffsets[iMorphView++], view.length);
+    });
+
+    return result;
+}
+
+Mesh::ICreateInfo encode(const Mesh::ICreateInfo &info) {
+    if (info.structInfo.dynamic.has_value() || info.structInfo.encoded || !info.data.buffer()) {
+        return info;
+    }
+
+    const uint8_t *   src = info.data.buffer()->getData();
+    Mesh::ICreateInfo result{info.structInfo, {}};
+    auto &            structInfo = result.structInfo;
+
+    ccstd::vector<ccstd::vector<uint8_t>> streams;
+    uint32_t                              size = 0;
+    for (auto &bundle : structInfo.vertexBundles) {
+        auto &view = bundle.view;
+        streams.emplace_back(encodeVertexBuffer(src + view.offset, view.count, view.stride));
+        view.length = static_cast<uint32_t>(streams.back().size());
+        view.offset = allocate(size, view.length);
+    }
+    for (auto &primitive : structInfo.primitives) {
+        if (!primitive.indexView.has_value()) continue;
+        auto &view = primitive.indexView.value();
+        streams.emplace_back(encodeIndexBuffer(src + view.offset, view.count, view.stride));
+        view.length = static_cast<uint32_t>(streams.back().size());
+        view.offset = allocate(size, view.length);
+    }
+    ccstd::vector<uint32_t> morphOffsets;
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        morphOffsets.emplace_back(view.offset);
+        view.offset = allocate(size, view.length);
+    });
+
+    result.data  = Uint8Array(size);
+    uint8_t *dst = result.data.buffer()->getData();
+
+    size_t iStream = 0;
+    for (const auto &bundle : structInfo.vertexBundles) {
+        memcpy(dst + bundle.view.offset, streams[iStream++].data(), bundle.view.length);
+    }
+    for (const auto &primitive : structInfo.primitives) {
+        if (!primitive.indexView.has_value()) continue;
+        memcpy(dst + primitive.indexView->offset, streams[iStream++].data(), primitive.indexView->length);
+    }
+    size_t iMorphView = 0;
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        memcpy(dst + view.offset, src + morphOffsets[iMorphView++], view.length);
+    });
+
+    structInfo.encoded = true;
+    return result;
+}
+
+Mesh::ICreateInfo decode(const Mesh::ICreateInfo &info) {
+    if (!info.structInfo.encoded || !info.data.buffer()) {
+        return info;
+    }
+
+    const uint8_t *   src = info.data.buffer()->getData();
+    Mesh::ICreateInfo result{info.structInfo, {}};
+    auto &            structInfo = result.structInfo;
+
+    // lay out the decoded buffer first so that every stream decodes into its own region
+    ccstd::vector<DecodeTask> tasks;
+    uint32_t                  size = 0;
+    for (auto &bundle : structInfo.vertexBundles) {
+        auto &view = bundle.view;
+        tasks.push_back({nullptr, src + view.offset, view.length, view.count, view.stride, false});
+        view.length = view.count * view.stride;
+        view.offset = allocate(size, view.length);
+    }
+    for (auto &primitive : structInfo.primitives) {
+        if (!primitive.indexView.has_value()) continue;
+        auto &view = primitive.indexView.value();
+        tasks.push_back({nullptr, src + view.offset, view.length, view.count, view.stride, true});
+        view.length = view.count * view.stride;
+        view.offset = allocate(size, view.length);
+    }
+    ccstd::vector<uint32_t> morphOffsets;
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        morphOffsets.emplace_back(view.offset);
+        view.offset = allocate(size, view.length);
+    });
+
+    result.data  = Uint8Array(size);
+    uint8_t *dst = result.data.buffer()->getData();
+
+    size_t iTask = 0;
+    for (const auto &bundle : structInfo.vertexBundles) {
+        tasks[iTask++].dst = dst + bundle.view.offset;
+    }
+    for (const auto &primitive : structInfo.primitives) {
+        if (!primitive.indexView.has_value()) continue;
+        tasks[iTask++].dst = dst + primitive.indexView->offset;
+    }
+    size_t iMorphView = 0;
+    forEachMorphView(structInfo, [&](IMeshBufferView &view) {
+        memcpy(dst + view.offset, src + morphOffsets[iMorphView++], view.length);
+    });
+
+    ccstd::vector<uint8_t> succeeded(tasks.size(), 0);
+    auto                   job = [&](uint32_t i) {
+        const auto &task = tasks[i];
+        succeeded[i]     = task.index
+                               ? decodeIndexBuffer(task.dst, task.count, task.stride, task.src, task.size)
+                               : decodeVertexBuffer(task.dst, task.count, task.stride, task.src, task.size);
+    };
+    if (tasks.size() > 1) {
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(0U, static_cast<uint32_t>(tasks.size()), 1U, job);
+        g.run();
+        g.waitForAll();
+    } else if (!tasks.empty()) {
+        job(0);
+    }
+
+    if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end()) {
+        CC_LOG_ERROR("meshcodec: malformed vertex or index stream.");
+        return info;
+    }
+
+    structInfo.encoded = false;
+    return result;
+}
+
+ccstd::vector<uint8_t> encodeVertexBuffer(const uint8_t *vertices, uint32_t count, uint32_t stride) {
+    ccstd::vector<uint8_t> out;
+    out.reserve(1 + count * stride / 2);
+    out.push_back(VERTEX_CODEC_HEADER);
+
+    ccstd::vector<uint8_t> last(stride, 0);
+    uint8_t                deltas[VERTEX_BLOCK_SIZE];
+    for (uint32_t begin = 0; begin < count; begin += VERTEX_BLOCK_SIZE) {
+        const uint32_t blockCount = std::min(VERTEX_BLOCK_SIZE, count - begin);
+        const uint32_t groupCount = (blockCount + VERTEX_GROUP_SIZE - 1) / VERTEX_GROUP_SIZE;
+        for (uint32_t lane = 0; lane < stride; ++lane) {
+            memset(deltas, 0, sizeof(deltas));
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                const uint8_t value = vertices[(begin + i) * stride + lane];
+                deltas[i]           = zigzag8(static_cast<uint8_t>(value - last[lane]));
+                last[lane]          = value;
+            }
+
+            const size_t headerPos = out.size();
+            out.resize(headerPos + (groupCount + 3) / 4, 0);
+            for (uint32_t group = 0; group < groupCount; ++group) {
+                const uint8_t *groupDeltas = deltas + group * VERTEX_GROUP_SIZE;
+                const uint32_t header      = getGroupHeader(groupDeltas);
+                out[headerPos + group / 4] |= static_cast<uint8_t>(header << ((group % 4) * 2));
+                if (header) encodeGroup(out, groupDeltas, GROUP_BITS[header]);
+            }
+        }
+    }
+    return out;
+}
+
+bool decodeVertexBuffer(uint8_t *dst, uint32_t count, uint32_t stride, const uint8_t *src, std::size_t size) {
+    if (size < 1 || src[0] != VERTEX_CODEC_HEADER) return false;
+
+    std::size_t            pos = 1;
+    ccstd::vector<uint8_t> last(stride, 0);
+    uint8_t                deltas[VERTEX_GROUP_SIZE];
+    for (uint32_t begin = 0; begin < count; begin += VERTEX_BLOCK_SIZE) {
+        const uint32_t blockCount = std::min(VERTEX_BLOCK_SIZE, count - begin);
+        const uint32_t groupCount = (blockCount + VERTEX_GROUP_SIZE - 1) / VERTEX_GROUP_SIZE;
+        for (uint32_t lane = 0; lane < stride; ++lane) {
+            const std::size_t headerPos = pos;
+            pos += (groupCount + 3) / 4;
+            if (pos > size) return false;
+            for (uint32_t group = 0; group < groupCount; ++group) {
+                const uint32_t bits   = GROUP_BITS[(src[headerPos + group / 4] >> ((group % 4) * 2)) & 3U];
+                const uint32_t length = bits * VERTEX_GROUP_SIZE / 8;
+                if (pos + length > size) return false;
+                decodeGroup(deltas, src + pos, bits);
+                pos += length;
+
+                const uint32_t first = group * VERTEX_GROUP_SIZE;
+                const uint32_t end   = std::min(first + VERTEX_GROUP_SIZE, blockCount);
+                for (uint32_t i = first; i < end; ++i) {
+                    last[lane]                       = static_cast<uint8_t>(last[lane] + unzigzag8(deltas[i - first]));
+                    dst[(begin + i) * stride + lane] = last[lane];
+                }
+            }
+        }
+    }
+    return pos == size;
+}
+
+ccstd::vector<uint8_t> encodeIndexBuffer(const uint8_t *indices, uint32_t count, uint32_t stride) {
+    ccstd::vector<uint8_t> out;
+    out.reserve(1 + count * 2);
+    out.push_back(INDEX_CODEC_HEADER);
+
+    int64_t last = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const int64_t value = readIndex(indices + i * stride, stride);
+        uint64_t      delta = zigzag64(value - last);
+        last                = value;
+        while (delta >= 0x80U) {
+            out.push_back(static_cast<uint8_t>(delta | 0x80U));
+            delta >>= 7U;
+        }
+        out.push_back(static_cast<uint8_t>(delta));
+    }
+    return out;
+}
+
+bool decodeIndexBuffer(uint8_t *dst, uint32_t count, uint32_t stride, const uint8_t *src, std::size_t size) {
+    if (size < 1 || src[0] != INDEX_CODEC_HEADER) return false;
+    if (stride != 1 && stride != 2 && stride != 4) return false;
+
+    const int64_t maxIndex = stride == 4 ? 0xffffffffLL : (1LL << (stride * 8)) - 1;
+    std::size_t   pos      = 1;
+    int64_t       last     = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t delta = 0;
+        uint32_t shift = 0;
+        uint8_t  byte  = 0;
+        do {
+            if (pos >= size || shift > 63) return false;
+            byte = src[pos++];
+            delta |= static_cast<uint64_t>(byte & 0x7fU) << shift;
+            shift += 7;
+        } while (byte & 0x80U);
+
+        last += unzigzag64(delta);
+        if (last < 0 || last > maxIndex) return false;
+        writeIndex(dst + i * stride, stride, static_cast<uint32_t>(last));
+    }
+    return pos == size;
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const auto     sign    = static_cast<uint16_t>((bits >> 16U) & 0x8000U);
+    const uint32_t absBits = bits & 0x7fffffffU;
+
+    if (absBits >= 0x7f800000U) { // inf, nan keeps a quiet payload
+        return static_cast<uint16_t>(sign | 0x7c00U | (absBits > 0x7f800000U ? 0x200U : 0U));
+    }
+    if (absBits >= 0x47800000U) { // 65536 and above overflow
+        return static_cast<uint16_t>(sign | 0x7c00U);
+    }
+    if (absBits < 0x38800000U) { // subnormal half
+        if (absBits < 0x33000000U) return sign;
+        const uint32_t exponent = absBits >> 23U;
+        const uint32_t mantissa = (absBits & 0x7fffffU) | 0x800000U;
+        const uint32_t shift    = 126U - exponent;
+        uint32_t       half     = mantissa >> shift;
+        const uint32_t rest     = mantissa & ((1U << shift) - 1U);
+        const uint32_t halfway  = 1U << (shift - 1U);
+        if (rest > halfway || (rest == halfway && (half & 1U))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // rebias the exponent and round to nearest even, a carry into the exponent is intended
+    uint32_t       half = (absBits - 0x38000000U) >> 13U;
+    const uint32_t rest = absBits & 0x1fffU;
+    if (rest > 0x1000U || (rest == 0x1000U && (half & 1U))) ++half;
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value) {
+    const uint32_t sign     = static_cast<uint32_t>(value & 0x8000U) << 16U;
+    uint32_t       exponent = (value >> 10U) & 0x1fU;
+    uint32_t       mantissa = value & 0x3ffU;
+    uint32_t       bits     = sign;
+
+    if (exponent == 0x1fU) {
+        bits |= 0x7f800000U | (mantissa << 13U);
+    } else if (exponent != 0) {
+        bits |= ((exponent + 112U) << 23U) | (mantissa << 13U);
+    } else if (mantissa != 0) {
+        exponent = 113U;
+        while (!(mantissa & 0x400U)) {
+            mantissa <<= 1U;
+            --exponent;
+        }
+        bits |= (exponent << 23U) | ((mantissa & 0x3ffU) << 13U);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace meshcodec
+} // namespace cc
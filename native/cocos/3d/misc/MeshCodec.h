@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "3d/assets/Mesh.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace meshcodec {
+
+struct QuantizeOptions {
+    // normals and tangents as RGBA16F, the w of normals is zero filled
+    bool normals{true};
+    bool tangents{true};
+    // the first uv set as RG16F, the others usually hold lightmap uvs which need the full precision
+    bool uvs{true};
+};
+
+/**
+ * @en Returns a copy of the mesh with its float normals, tangents and uvs stored in the smaller formats
+ * selected by the options. Positions are kept as is, they are read back on the CPU for bounds, raycasts and skinning.
+ * @zh 返回网格的副本，其中浮点格式的法线、切线与 UV 按选项转为更小的格式存储。
+ * 位置保持原样，因为包围盒、射线检测与蒙皮都会在 CPU 上读取它们。
+ */
+Mesh::ICreateInfo quantize(const Mesh::ICreateInfo &info, const QuantizeOptions &options = {});
+
+/**
+ * @en Compresses the vertex bundles and index views of the mesh, Mesh::initialize decodes them before uploading.
+ * @zh 压缩网格的顶点块与索引数据，Mesh::initialize 会在上传前解码。
+ */
+Mesh::ICreateInfo encode(const Mesh::ICreateInfo &info);
+
+// decodes the streams of an encoded mesh in parallel on the job system
+Mesh::ICreateInfo decode(const Mesh::ICreateInfo &info);
+
+// vertices are delta coded per byte against the previous vertex, the deltas are bit packed in groups of 16
+ccstd::vector<uint8_t> encodeVertexBuffer(const uint8_t *vertices, uint32_t count, uint32_t stride);
+bool                   decodeVertexBuffer(uint8_t *dst, uint32_t count, uint32_t stride, const uint8_t *src, std::size_t size);
+
+// indices are delta coded against the previous index and stored as zigzag varints
+ccstd::vector<uint8_t> encodeIndexBuffer(const uint8_t *indices, uint32_t count, uint32_t stride);
+bool                   decodeIndexBuffer(uint8_t *dst, uint32_t count, uint32_t stride, const uint8_t *src, std::size_t size);
+
+uint16_t floatToHalf(float value);
+float    halfToFloat(uint16_t value);
+
+} // namespace meshcodec
+} // namespace cc
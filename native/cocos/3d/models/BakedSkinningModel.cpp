@@ -47,6 +47,8 @@ const ccstd::string INST_JOINT_ANIM_INFO = "a_jointAnimInfo";
 } // namespace
 namespace cc {
 
+CC_SLAB_ALLOCATED_IMPL(BakedSkinningModel)
+
 BakedSkinningModel::BakedSkinningModel()
 //, _dataPoolManager(Root::getInstance()->getDataPoolManager())
 {
@@ -106,6 +108,7 @@ void BakedSkinningModel::updateTransform(uint32_t stamp) {
     if (_worldBounds && skelBound != nullptr) {
         Node *node = getTransform();
         skelBound->transform(node->getWorldMatrix(), _worldBounds);
+        syncSceneBounds();
     }
 }
 
@@ -30,6 +30,7 @@
 #include "3d/assets/Skeleton.h"
 #include "3d/models/MorphModel.h"
 #include "3d/skeletal-animation/SkeletalAnimationUtils.h"
+#include "core/memop/SlabAllocator.h"
 #include "gfx-base/GFXDef-common.h"
 
 namespace cc {
@@ -61,6 +62,7 @@ public:
     void                               updateTransform(uint32_t stamp) override;
     void                               updateUBOs(uint32_t stamp) override;
     void                               updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, scene::Pass *pass) override;
+    // per-instance a_jointAnimInfo: current frame, joint count and pixel offset of the animation in the shared joint texture
     void                               updateInstancedJointTextureInfo();
     // void                             uploadAnimation(AnimationClip *anim); // TODO(xwx): AnimationClip not define
 
@@ -99,6 +101,7 @@ private:
     bool _isUploadedAnim{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(BakedSkinningModel);
+    CC_SLAB_ALLOCATED(BakedSkinningModel);
 };
 
 } // namespace cc
@@ -47,6 +47,8 @@ public:
     inline void setMorphRendering(MorphRenderingInstance *morphRendering) { _morphRenderingInstance = morphRendering; }
 
 protected:
+    inline bool hasMorphRendering() const { return _morphRenderingInstance != nullptr; }
+
     void updateLocalDescriptors(index_t subModelIndex, gfx::DescriptorSet *descriptorSet) override;
 
 private:
@@ -24,13 +24,20 @@
  ****************************************************************************/
 #include "3d/models/SkinningModel.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "3d/assets/Mesh.h"
 #include "3d/assets/Skeleton.h"
+#include "core/geometry/Intersect.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
+#include "math/MathUtil.h"
 #include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/pipeline/ComputeSkinning.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "scene/Camera.h"
+#include "scene/LODGroup.h"
 #include "scene/Pass.h"
 #include "scene/RenderScene.h"
 
@@ -53,13 +60,24 @@ void getRelevantBuffers(ccstd::vector<index_t> &outIndices, ccstd::vector<int32_
 
 ccstd::vector<cc::scene::IMacroPatch> myPatches{{"CC_USE_SKINNING", true}};
 
+uint32_t animationLODPhaseCounter{0};
+
+cc::pipeline::ComputeSkinning *getComputeSkinning() {
+    auto *pipeline = cc::pipeline::RenderPipeline::getInstance();
+    return pipeline ? &pipeline->getComputeSkinning() : nullptr;
+}
+
 } // namespace
 namespace cc {
 
+CC_SLAB_ALLOCATED_IMPL(SkinningModel)
+
 SkinningModel::SkinningModel() {
-    _type = Model::Type::SKINNING;
+    _type              = Model::Type::SKINNING;
+    _animationLODPhase = animationLODPhaseCounter++;
 }
 SkinningModel::~SkinningModel() {
+    destroyComputeTargets();
     for (auto *curr : _dataArray) {
         delete curr;
     }
@@ -74,6 +92,19 @@ void SkinningModel::destroy() {
         _buffers.clear();
     }
     Super::destroy();
+    // after the sub models drawing from them are gone
+    destroyComputeTargets();
+}
+
+void SkinningModel::destroyComputeTargets() {
+    auto *computeSkinning = getComputeSkinning();
+    for (auto *target : _computeTargets) {
+        if (target && computeSkinning) {
+            computeSkinning->cancel(target);
+        }
+        CC_SAFE_DELETE(target);
+    }
+    _computeTargets.clear();
 }
 
 void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh) {
@@ -82,10 +113,16 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
     }
     _bufferIndices.clear();
     _joints.clear();
+    _jointWorlds.clear();
+    _jointBindposes.clear();
+    _jointPalette.clear();
+    _jointBoundCenters.clear();
+    _jointBoundExtents.clear();
+    _jointsValid = false;
 
     if (!skeleton || !skinningRoot || !mesh) return;
     setTransform(skinningRoot);
-    auto        boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
+    const auto &boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
     const auto &jointMaps       = mesh->getStruct().jointMaps;
     ensureEnoughBuffers((jointMaps.has_value() && !jointMaps->empty()) ? static_cast<int32_t>(jointMaps->size()) : 1);
     _bufferIndices = mesh->getJointBufferIndices();
@@ -114,76 +151,195 @@ void SkinningModel::bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *m
         jointInfo.buffers   = std::move(buffers);
         jointInfo.indices   = std::move(indices);
         _joints.emplace_back(std::move(jointInfo));
+
+        _jointWorlds.emplace_back(transform->world.m);
+        _jointBindposes.insert(_jointBindposes.end(), bindPose.m, bindPose.m + 16);
+        _jointBoundCenters.insert(_jointBoundCenters.end(), &bound->center.x, &bound->center.x + 3);
+        _jointBoundExtents.insert(_jointBoundExtents.end(), &bound->halfExtents.x, &bound->halfExtents.x + 3);
+    }
+    _jointPalette.resize(_joints.size() * 12);
+    _jointWorldCenters.resize(_jointBoundCenters.size());
+    _jointWorldExtents.resize(_jointBoundExtents.size());
+}
+
+uint32_t SkinningModel::getAnimationLODInterval() const {
+    if (!_scene || !_worldBounds) {
+        return 1;
+    }
+
+    bool  visible     = false;
+    float screenUsage = 0.F;
+    for (const auto &camera : _scene->getCameras()) {
+        if (!camera->isEnabled()) {
+            continue;
+        }
+        // frustums and bounds are from the last frame, so this follows the visibility of the last frame
+        if (geometry::aabbFrustum(*_worldBounds, camera->getFrustum())) {
+            visible = true;
+            const float diameter = _worldBounds->getHalfExtents().length() * 2.F;
+            screenUsage          = std::max(screenUsage, scene::computeScreenUsagePercentage(_worldBounds->getCenter(), diameter, camera));
+        }
+    }
+    if (!visible) {
+        return _animationLOD.skipWhenCulled ? 0 : _animationLOD.maxInterval;
     }
+
+    uint32_t interval = 1;
+    for (float usage = screenUsage; usage < _animationLOD.fullRateScreenUsage && interval < _animationLOD.maxInterval; usage *= 2.F) {
+        interval *= 2;
+    }
+    return std::min(interval, std::max(_animationLOD.maxInterval, 1U));
+}
+
+bool SkinningModel::needUpdateJoints(uint32_t stamp) const {
+    if (!_animationLOD.enabled || !_jointsValid) {
+        return true;
+    }
+
+    const uint32_t interval = getAnimationLODInterval();
+    if (interval == 0) {
+        return false;
+    }
+    // the phase keeps crowds from updating on the same frame, the elapsed check bounds the delay when the interval changes
+    const uint32_t elapsed = stamp - _jointsStamp;
+    return (stamp + _animationLODPhase) % interval == 0 || elapsed >= interval * 2;
 }
 
 void SkinningModel::updateTransform(uint32_t stamp) {
-    auto *root = getTransform();
+    auto *root        = getTransform();
+    bool  rootChanged = false;
     if (root->getChangedFlags() || root->getDirtyFlag()) {
         root->updateWorldTransform();
         _localDataUpdated = true;
+        rootChanged       = true;
+    }
+
+    _jointsUpdated = needUpdateJoints(stamp);
+    if (!_jointsUpdated) {
+        // hold the pose, the bone space bounds only follow the skinning root
+        if (rootChanged && _modelBounds->isValid() && _worldBounds) {
+            _modelBounds->transform(root->getWorldMatrix(), _worldBounds);
+            syncSceneBounds();
+        }
+        return;
     }
-    Vec3           v3Min{INFINITY, INFINITY, INFINITY};
-    Vec3           v3Max{-INFINITY, -INFINITY, -INFINITY};
-    geometry::AABB ab1;
-    Vec3           v31;
-    Vec3           v32;
+    _jointsStamp       = stamp;
+    _jointsValid       = true;
+    _jointPaletteReady = false;
+
+    // resolves transform->world of every joint, which _jointWorlds points to
     for (JointInfo &jointInfo : _joints) {
-        const auto *bound       = jointInfo.bound;
-        auto *      transform   = jointInfo.transform;
-        Mat4        worldMatrix = cc::getWorldMatrix(transform, static_cast<int32_t>(stamp));
-        jointInfo.bound->transform(worldMatrix, &ab1);
-        ab1.getBoundary(&v31, &v32);
-        Vec3::min(v3Min, v31, &v3Min);
-        Vec3::max(v3Max, v32, &v3Max);
+        cc::getWorldMatrix(jointInfo.transform, static_cast<int32_t>(stamp));
+    }
+
+    const auto jointCount = static_cast<uint32_t>(_joints.size());
+    MathUtil::transformAABBBatch(_jointWorlds.data(), _jointBoundCenters.data(), _jointBoundExtents.data(), jointCount,
+                                 _jointWorldCenters.data(), _jointWorldExtents.data());
+
+    Vec3 v3Min{INFINITY, INFINITY, INFINITY};
+    Vec3 v3Max{-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < jointCount * 3; i += 3) {
+        const float *c = _jointWorldCenters.data() + i;
+        const float *e = _jointWorldExtents.data() + i;
+        Vec3::min(v3Min, Vec3{c[0] - e[0], c[1] - e[1], c[2] - e[2]}, &v3Min);
+        Vec3::max(v3Max, Vec3{c[0] + e[0], c[1] + e[1], c[2] + e[2]}, &v3Max);
     }
     if (_modelBounds->isValid() && _worldBounds) {
         geometry::AABB::fromPoints(v3Min, v3Max, _modelBounds);
         _modelBounds->transform(root->getWorldMatrix(), _worldBounds);
+        syncSceneBounds();
     }
 }
 
 void SkinningModel::updateUBOs(uint32_t stamp) {
     Super::updateUBOs(stamp);
-    uint32_t bIdx = 0;
-    Mat4     mat4;
-    for (const JointInfo &jointInfo : _joints) {
-        Mat4::multiply(jointInfo.transform->world, jointInfo.bindpose, &mat4);
-        for (uint32_t buffer : jointInfo.buffers) {
-            uploadJointData(jointInfo.indices[bIdx] * 12, mat4, _dataArray[buffer]->data());
+    if (_jointsUpdated) {
+        if (!_jointPaletteReady) {
+            updateJointPalette();
+        }
+
+        uint32_t bIdx = 0;
+        for (const auto &buffer : _buffers) {
+            buffer->update(_dataArray[bIdx]->data(), buffer->getSize());
             bIdx++;
         }
-        bIdx = 0;
+        _computeSkinningPending = true;
+    }
+
+    // the joint buffers hold no pose before the first joint update
+    if (_computeSkinningPending && _jointsValid) {
+        enqueueComputeSkinning();
+    }
+}
+
+void SkinningModel::enqueueComputeSkinning() {
+    _computeSkinningPending = false;
+    auto *computeSkinning   = getComputeSkinning();
+    if (!computeSkinning) {
+        return;
+    }
+    for (index_t i = 0; i < _computeTargets.size() && i < _bufferIndices.size(); ++i) {
+        if (_computeTargets[i]) {
+            computeSkinning->enqueue(_computeTargets[i], _buffers[_bufferIndices[i]]);
+        }
     }
-    bIdx = 0;
-    for (const auto &buffer : _buffers) {
-        buffer->update(_dataArray[bIdx]->data(), buffer->getSize());
-        bIdx++;
+}
+
+void SkinningModel::updateJointPalette() {
+    const auto jointCount = static_cast<uint32_t>(_joints.size());
+    MathUtil::multiplyJointMatrices(_jointWorlds.data(), _jointBindposes.data(), jointCount, _jointPalette.data());
+
+    // a joint shows up in every buffer whose joint map references it
+    for (uint32_t i = 0; i < jointCount; ++i) {
+        const JointInfo &jointInfo = _joints[i];
+        const float *    joint     = _jointPalette.data() + i * 12;
+        for (uint32_t j = 0; j < jointInfo.buffers.size(); ++j) {
+            memcpy(_dataArray[jointInfo.buffers[j]]->data() + jointInfo.indices[j] * 12, joint, sizeof(float) * 12);
+        }
     }
+    _jointPaletteReady = true;
 }
 
 void SkinningModel::initSubModel(index_t idx, RenderingSubMesh *subMeshData, Material *mat) {
+    if (idx >= _computeTargets.size()) {
+        _computeTargets.resize(idx + 1, nullptr);
+    }
+    // the sub model being replaced draws from the old target until it is destroyed
+    pipeline::ComputeSkinningTarget *oldTarget       = _computeTargets[idx];
+    auto *                           computeSkinning = getComputeSkinning();
+    // morph targets are applied in the vertex shader before skinning
+    auto *target         = (computeSkinning && !hasMorphRendering()) ? computeSkinning->createTarget(subMeshData) : nullptr;
+    _computeTargets[idx] = target;
+
     const auto &original = subMeshData->getVertexBuffers();
     auto &      iaInfo   = subMeshData->getIaInfo();
-    iaInfo.vertexBuffers = subMeshData->getJointMappedBuffers();
+    if (target) {
+        // the skinned vertices are drawn as a static mesh by every pass
+        iaInfo.vertexBuffers                      = original;
+        iaInfo.vertexBuffers[target->getStream()] = target->getOutputBuffer();
+        _computeSkinningPending                   = true;
+    } else {
+        iaInfo.vertexBuffers = subMeshData->getJointMappedBuffers();
+    }
     Super::initSubModel(idx, subMeshData, mat);
     iaInfo.vertexBuffers = original;
+
+    if (oldTarget && computeSkinning) {
+        computeSkinning->cancel(oldTarget);
+    }
+    delete oldTarget;
 }
 
 ccstd::vector<scene::IMacroPatch> &SkinningModel::getMacroPatches(index_t subModelIndex) {
     auto &patches = Super::getMacroPatches(subModelIndex);
+    if (subModelIndex < _computeTargets.size() && _computeTargets[subModelIndex]) {
+        return patches;
+    }
     patches.reserve(myPatches.size() + patches.size());
     patches.insert(std::begin(patches), std::begin(myPatches), std::end(myPatches));
     return patches;
 }
 
-void SkinningModel::uploadJointData(uint32_t base, const Mat4 &mat, float *dst) {
-    memcpy(reinterpret_cast<void *>(dst + base), mat.m, sizeof(float) * 12);
-    dst[base + 3]  = mat.m[12];
-    dst[base + 7]  = mat.m[13];
-    dst[base + 11] = mat.m[14];
-}
-
 void SkinningModel::updateLocalDescriptors(index_t submodelIdx, gfx::DescriptorSet *descriptorset) {
     Super::updateLocalDescriptors(submodelIdx, descriptorset);
     gfx::Buffer *buffer = _buffers[_bufferIndices[submodelIdx]];
@@ -29,6 +29,7 @@
 #include "3d/models/MorphModel.h"
 #include "base/std/container/array.h"
 #include "core/animation/SkeletalAnimationUtils.h"
+#include "core/memop/SlabAllocator.h"
 #include "math/Mat4.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/pipeline/Define.h"
@@ -38,6 +39,9 @@ class Skeleton;
 namespace geometry {
 class AABB;
 }
+namespace pipeline {
+class ComputeSkinningTarget;
+}
 
 struct JointInfo {
     geometry::AABB *       bound{nullptr};
@@ -48,6 +52,21 @@ struct JointInfo {
     ccstd::vector<index_t> indices;
 };
 
+/**
+ * @en Animation LOD policy of a skinning model, the joints are updated less often when the model is small on screen,
+ * and the last pose is held in between.
+ * @zh 蒙皮模型的动画 LOD 策略，模型在屏幕上较小时降低骨骼的更新频率，其间保持上一次的姿势。
+ */
+struct AnimationLODInfo {
+    bool enabled{false};
+    // joints are updated every frame at or above this screen usage percentage
+    float fullRateScreenUsage{0.2F};
+    // the update interval doubles each time the screen usage halves, up to this number of frames
+    uint32_t maxInterval{8};
+    // hold the pose while the model is outside the frustum of every camera of the scene
+    bool skipWhenCulled{true};
+};
+
 class SkinningModel final : public MorphModel {
 public:
     using Super = MorphModel;
@@ -65,16 +84,48 @@ public:
 
     void bindSkeleton(Skeleton *skeleton, Node *skinningRoot, Mesh *mesh);
 
+    inline const AnimationLODInfo &getAnimationLOD() const { return _animationLOD; }
+    inline void                    setAnimationLOD(const AnimationLODInfo &info) { _animationLOD = info; }
+
+    // Joint matrices of the pose resolved by updateTransform() still need to be computed.
+    inline bool hasPendingJointPalette() const { return _jointsUpdated && !_jointPaletteReady; }
+    // Computes the joint matrices into the uniform data, only touches data owned by this model and may run on any job thread.
+    void updateJointPalette();
+
 private:
-    static void uploadJointData(uint32_t base, const Mat4 &mat, float *dst);
-    void        ensureEnoughBuffers(index_t count);
+    void ensureEnoughBuffers(index_t count);
+    // number of frames between two joint updates, 0 to hold the pose until the model is visible again
+    uint32_t getAnimationLODInterval() const;
+    bool     needUpdateJoints(uint32_t stamp) const;
+    void     enqueueComputeSkinning();
+    void     destroyComputeTargets();
 
     ccstd::vector<index_t>                                             _bufferIndices;
     ccstd::vector<IntrusivePtr<gfx::Buffer>>                           _buffers;
     ccstd::vector<JointInfo>                                           _joints;
     ccstd::vector<ccstd::array<float, pipeline::UBOSkinning::COUNT> *> _dataArray;
+    // joints in batch layout, see MathUtil::multiplyJointMatrices
+    ccstd::vector<const float *>                                       _jointWorlds;
+    ccstd::vector<float>                                               _jointBindposes;
+    ccstd::vector<float>                                               _jointPalette;
+    // bone space bounds of the joints, then their world bounds, laid out for MathUtil::transformAABBBatch
+    ccstd::vector<float>                                               _jointBoundCenters;
+    ccstd::vector<float>                                               _jointBoundExtents;
+    ccstd::vector<float>                                               _jointWorldCenters;
+    ccstd::vector<float>                                               _jointWorldExtents;
+    // per sub model, nullptr for the sub models skinned in the vertex shader
+    ccstd::vector<pipeline::ComputeSkinningTarget *>                   _computeTargets;
+
+    AnimationLODInfo _animationLOD;
+    uint32_t         _animationLODPhase{0}; // spreads the joint updates of models sharing an interval across frames
+    uint32_t         _jointsStamp{0};
+    bool             _jointsValid{false};
+    bool             _jointsUpdated{false};
+    bool             _jointPaletteReady{false};
+    bool             _computeSkinningPending{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(SkinningModel);
+    CC_SLAB_ALLOCATED(SkinningModel);
 };
 
 } // namespace cc
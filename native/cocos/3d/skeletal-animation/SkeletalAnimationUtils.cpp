@@ -25,15 +25,21 @@
 
 #include "3d/skeletal-animation/SkeletalAnimationUtils.h"
 #include "3d/assets/Mesh.h"
+#include "3d/misc/MeshCodec.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/pipeline/Define.h"
 
 namespace {
 const float INF = std::numeric_limits<float>::infinity();
 
-cc::gfx::Format selectJointsMediumFormat(cc::gfx::Device *device) {
-    if (static_cast<uint32_t>(device->getFormatFeatures(cc::gfx::Format::RGBA32F) & cc::gfx::FormatFeature::SAMPLED_TEXTURE)) {
-        return cc::gfx::Format::RGBA32F;
+bool supportsSampling(cc::gfx::Device *device, cc::gfx::Format format) {
+    return static_cast<uint32_t>(device->getFormatFeatures(format) & cc::gfx::FormatFeature::SAMPLED_TEXTURE);
+}
+
+// the shaders read float textures whenever 32 bit floats can be sampled, half floats go through the same path
+cc::gfx::Format selectJointsMediumFormat(cc::gfx::Device *device, bool halfFloat) {
+    if (supportsSampling(device, cc::gfx::Format::RGBA32F)) {
+        return halfFloat && supportsSampling(device, cc::gfx::Format::RGBA16F) ? cc::gfx::Format::RGBA16F : cc::gfx::Format::RGBA32F;
     }
     return cc::gfx::Format::RGBA8;
 }
@@ -135,19 +141,23 @@ cc::Mat4 *getWorldTransformUntilRoot(cc::Node *target, cc::Node *root, cc::Mat4
 
 } // namespace
 namespace cc {
-JointTexturePool::JointTexturePool(gfx::Device *device) {
-    _device            = device;
-    const auto &format = selectJointsMediumFormat(_device);
-    _formatSize        = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(format)].size;
-    _pixelsPerJoint    = 48 / _formatSize;
-    _pool              = new TextureBufferPool(device);
+JointTexturePool::JointTexturePool(gfx::Device *device, bool halfFloat) {
+    _device = device;
+    _format = selectJointsMediumFormat(_device, halfFloat);
+    // RGBA8 packs the 4 bytes of a float into one pixel
+    const auto &formatInfo = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(_format)];
+    const auto  floatsPerPixel = _format == gfx::Format::RGBA8 ? 1 : formatInfo.count;
+    _formatSize                = formatInfo.size;
+    _bytesPerFloat             = _formatSize / floatsPerPixel;
+    _pixelsPerJoint            = 12 / floatsPerPixel;
+    _pool                      = new TextureBufferPool(device);
     ITextureBufferPoolInfo poolInfo;
-    poolInfo.format    = format;
+    poolInfo.format    = _format;
     poolInfo.roundUpFn = roundUpType{roundUpTextureSize};
     _pool->initialize(poolInfo);
     _customPool = new TextureBufferPool(device);
     ITextureBufferPoolInfo customPoolInfo;
-    customPoolInfo.format    = format;
+    customPoolInfo.format    = _format;
     customPoolInfo.roundUpFn = roundUpType{roundUpTextureSize};
     _customPool->initialize(customPoolInfo);
 }
@@ -170,11 +180,53 @@ void JointTexturePool::registerCustomTextureLayouts(const ccstd::vector<ICustomJ
     }
 }
 
+TextureBufferPool *JointTexturePool::getPool(uint64_t hash) const {
+    return _chunkIdxMap.find(hash) != _chunkIdxMap.end() ? _customPool.get() : _pool.get();
+}
+
+IJointTextureHandle *JointTexturePool::createHandle(uint64_t hash, uint32_t floatCount) {
+    const uint32_t       size = floatCount * _bytesPerFloat;
+    ITextureBufferHandle handle;
+    auto                 iter = _chunkIdxMap.find(hash);
+    if (iter != _chunkIdxMap.end()) {
+        handle = _customPool->alloc(size, iter->second);
+    } else {
+        handle = _pool->alloc(size);
+    }
+
+    IJointTextureHandle *texture = IJointTextureHandle::createJoinTextureHandle();
+    texture->pixelOffset         = handle.start / _formatSize;
+    texture->refCount            = 1;
+    texture->readyToBeDeleted    = false;
+    texture->handle              = handle;
+    return texture;
+}
+
+void JointTexturePool::uploadTexture(const IJointTextureHandle *texture, const Float32Array &data) {
+    auto *pool = getPool(texture->skeletonHash ^ texture->clipHash);
+    if (_format != gfx::Format::RGBA16F) {
+        pool->update(texture->handle, data.buffer());
+        return;
+    }
+
+    Uint16Array halfData(data.length());
+    for (uint32_t i = 0; i < data.length(); ++i) {
+        halfData[i] = meshcodec::floatToHalf(data[i]);
+    }
+    pool->update(texture->handle, halfData.buffer());
+}
+
 cc::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(Skeleton *skeleton, Mesh *mesh, Node *skinningRoot) {
-    uint64_t                            hash = skeleton->getHash() ^ 0; // may not equal to skeleton.hash
+    uint64_t                            hash     = skeleton->getHash() ^ 0; // may not equal to skeleton.hash
+    const auto                          meshHash = static_cast<uint32_t>(mesh->getHash());
     cc::optional<IJointTextureHandle *> texture;
-    if (_textureBuffers.find(hash) != _textureBuffers.end()) {
-        texture = _textureBuffers[hash];
+    auto                                iter = _textureBuffers.find(hash);
+    if (iter != _textureBuffers.end()) {
+        texture = iter->second;
+        texture.value()->refCount++;
+        if (texture.value()->bounds.count(meshHash) != 0) {
+            return texture;
+        }
     }
 
     const ccstd::vector<ccstd::string> &joints    = skeleton->getJoints();
@@ -183,39 +235,25 @@ cc::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(Skel
     bool                                buildTexture = false;
     auto                                jointCount   = static_cast<uint32_t>(joints.size());
     if (!texture.has_value()) {
-        uint32_t             bufSize = jointCount * 12;
-        ITextureBufferHandle handle;
-        if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
-            handle = _customPool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT, _chunkIdxMap[hash]);
-        } else {
-            handle = _pool->alloc(bufSize * Float32Array::BYTES_PER_ELEMENT);
-            return texture;
-        }
-        IJointTextureHandle *textureHandle = IJointTextureHandle::createJoinTextureHandle();
-        textureHandle->pixelOffset         = handle.start / _formatSize;
-        textureHandle->refCount            = 1;
-        textureHandle->clipHash            = 0;
-        textureHandle->skeletonHash        = skeleton->getHash();
-        textureHandle->readyToBeDeleted    = false;
-        textureHandle->handle              = handle;
-        texture                            = textureHandle;
-        textureBuffer                      = Float32Array(bufSize);
-        buildTexture                       = true;
-    } else {
-        texture.value()->refCount++;
+        uint32_t bufSize              = jointCount * 12;
+        texture                       = createHandle(hash, bufSize);
+        texture.value()->clipHash     = 0;
+        texture.value()->skeletonHash = skeleton->getHash();
+        textureBuffer                 = Float32Array(bufSize);
+        buildTexture                  = true;
     }
 
     geometry::AABB ab1;
     Mat4           mat4;
     Vec3           v34;
     Vec3           v33;
-    Vec3           v3Min(-INF, -INF, -INF);
+    Vec3           v3Min(INF, INF, INF);
     Vec3           v3Max(-INF, -INF, -INF);
-    auto           boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
+    const auto &   boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
     for (uint32_t j = 0, offset = 0; j < jointCount; ++j, offset += 12) {
         auto *node = skinningRoot->getChildByPath(joints[j]);
         Mat4  mat  = node ? *getWorldTransformUntilRoot(node, skinningRoot, &mat4) : skeleton->getInverseBindposes()[j];
-        if (j < boneSpaceBounds.size()) {
+        if (j < boneSpaceBounds.size() && boneSpaceBounds[j]) {
             auto *bound = boneSpaceBounds[j].get();
             bound->transform(mat, &ab1);
             ab1.getBoundary(&v33, &v34);
@@ -231,114 +269,103 @@ cc::optional<IJointTextureHandle *> JointTexturePool::getDefaultPoseTexture(Skel
         }
     }
 
-    ccstd::vector<geometry::AABB> bounds;
-    texture.value()->bounds[static_cast<uint32_t>(mesh->getHash())] = bounds;
+    auto &bounds = texture.value()->bounds[meshHash];
+    bounds.resize(1);
     geometry::AABB::fromPoints(v3Min, v3Max, &bounds[0]);
     if (buildTexture) {
-        _pool->update(texture.value()->handle, textureBuffer.buffer());
+        uploadTexture(texture.value(), textureBuffer);
         _textureBuffers[hash] = texture.value();
     }
 
     return texture;
 }
 
-// TODO(xwx): need to implement this function after define AnimationClip
-// cc::optional<IJointTextureHandle> JointTexturePool::getSequencePoseTexture(Skeleton *skeleton,AnimationClip *clip, Mesh *mesh, Node *skinningRoot) {
-//     uint64_t                           hash = skeleton->getHash() ^ clip->getHash();
-//     cc::optional<IJointTextureHandle> texture;
-//     if (_textureBuffers.find(hash) != _textureBuffers.end()) {
-//         texture = _textureBuffers[hash];
-//         if (texture->bounds.find(mesh->getHash()) != texture->bounds.end()) {
-//             texture->refCount++;
-//             return texture;
-//         }
-//     }
-//     const ccstd::vector<ccstd::string> &joints    = skeleton->getJoints();
-//     const ccstd::vector<Mat4> &       bindPoses = skeleton->getBindposes();
-//     // const clipData = SkelAnimDataHub.getOrExtract(clip);
-//     // const { frames } = clipData;
-//     Float32Array textureBuffer;
-//     bool         buildTexture = false;
-//     uint32_t     jointCount   = joints.size();
-//     if (!texture.has_value()) {
-//         uint32_t             bufSize = jointCount * 12;
-//         ITextureBufferHandle handle;
-//         if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
-//             handle = _customPool->alloc(bufSize * sizeof(Float32Array), _chunkIdxMap[hash]); // TODO(xwx): Float32Array.BYTES_PER_ELEMENT == sizeof(Float32Array) ?
-//         } else {
-//             handle = _pool->alloc(bufSize * sizeof(Float32Array));
-//             return texture;
-//         }
-//         // auto animInfos = createAnimInfos(skeleton, clip, skinningRoot); // TODO(xwx): createAnimInfos not implement
-
-//         texture = IJointTextureHandle{
-//             .pixelOffset      = handle.start / _formatSize,
-//             .refCount         = 1,
-//             .clipHash         = 0,
-//             .skeletonHash     = skeleton->getHash(),
-//             .readyToBeDeleted = false,
-//             .handle           = handle,
-//             // .animInfos        = animInfos // TODO(xwx)
-//         };
-//         textureBuffer.resize(bufSize);
-//         buildTexture = true;
-//     } else {
-//         texture->refCount++;
-//     }
-//     auto                        boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
-//     ccstd::vector<geometry::AABB> bounds;
-//     texture->bounds[mesh->getHash()] = bounds;
-
-//     // for (uint32_t f = 0; f < frames; ++f) { // TODO(xwx): frames not define
-//     //     bounds.emplace_back(geometry::AABB(INF, INF, INF, -INF, -INF, -INF));
-//     // }
-
-//     // TODO(xwx) : need to implement when define animInfos
-//     // for (uint32_t f = 0, offset = 0; f < frames; ++f) {
-//     //     auto bound = bounds[f];
-//     //     for (uint32_t j = 0; j < jointCount; ++j, offset += 12) {
-//     //         const {
-//     //             curveData,
-//     //             downstream,
-//     //             bindposeIdx,
-//     //             bindposeCorrection,
-//     //         } = texture.animInfos ![j];
-//     //         let mat : Mat4;
-//     //         let transformValid = true;
-//     //         if (curveData && downstream) { // curve & static two-way combination
-//     //             mat = Mat4.multiply(m4_1, curveData[f], downstream);
-//     //         } else if (curveData) { // there is a curve directly controlling the joint
-//     //             mat = curveData[f];
-//     //         } else if (downstream) { // fallback to default pose if no animation curve can be found upstream
-//     //             mat = downstream;
-//     //         } else { // bottom line: render the original mesh as-is
-//     //             mat            = skeleton.inverseBindposes[bindposeIdx];
-//     //             transformValid = false;
-//     //         }
-//     //         if (j < boneSpaceBounds.size()) {
-//     //             auto bound     = boneSpaceBounds[j];
-//     //             auto tarnsform = bindposeCorrection ? Mat4::multiply(mat, bindposeCorrection, &m42) : mat; // TODO(xwx): mat not define
-//     //             ab1.getBoundary(&v33, &v34);
-//     //             Vec3::min(bound.center, v33, &bound.center);
-//     //             Vec3::max(bound.halfExtents, v34, &bound.halfExtents);
-//     //         }
-
-//     //         if (buildTexture) {
-//     //             if (transformValid) {
-//     //                 Mat4::multiply(mat, bindPoses[bindposIdx], &m41);
-//     //                 UPLOAD_JOINT_DATA(textureBuffer, offset, transformValid ? m41 : Mat4::IDENTITY, j == 0);
-//     //             }
-//     //         }
-//     //     }
-//     //     AABB::fromPoints(bound.center, bound.halfExtents, &bound);
-//     // }
-//     if (buildTexture) {
-//         // _pool->update(texture->handle, textureBuffer.buffer); // TODO(xwx): ArrayBuffer not implemented
-//         _textureBuffers[hash] = texture.value();
-//     }
-//     return texture;
-// }
-// }
+cc::optional<IJointTextureHandle *> JointTexturePool::getSequencePoseTexture(Skeleton *skeleton, const IBakedClipData &clip, Mesh *mesh, Node *skinningRoot) {
+    uint64_t                            hash     = skeleton->getHash() ^ clip.hash;
+    const auto                          meshHash = static_cast<uint32_t>(mesh->getHash());
+    cc::optional<IJointTextureHandle *> texture;
+    auto                                iter = _textureBuffers.find(hash);
+    if (iter != _textureBuffers.end()) {
+        texture = iter->second;
+        texture.value()->refCount++;
+        if (texture.value()->bounds.count(meshHash) != 0) {
+            return texture;
+        }
+    }
+
+    const ccstd::vector<ccstd::string> &joints    = skeleton->getJoints();
+    const ccstd::vector<Mat4> &         bindPoses = skeleton->getBindposes();
+    const uint32_t                      frames    = clip.frames;
+    Float32Array                        textureBuffer;
+    bool                                buildTexture = false;
+    auto                                jointCount   = static_cast<uint32_t>(joints.size());
+    if (!texture.has_value()) {
+        if (jointCount == 0 || frames == 0) {
+            return texture;
+        }
+        uint32_t bufSize              = jointCount * 12 * frames;
+        texture                       = createHandle(hash, bufSize);
+        texture.value()->clipHash     = clip.hash;
+        texture.value()->skeletonHash = skeleton->getHash();
+        texture.value()->animInfos    = createAnimInfos(skeleton, clip, skinningRoot);
+        textureBuffer                 = Float32Array(bufSize);
+        buildTexture                  = true;
+    }
+
+    geometry::AABB ab1;
+    Mat4           m41;
+    Mat4           m42;
+    Vec3           v33;
+    Vec3           v34;
+    const auto &   boneSpaceBounds = mesh->getBoneSpaceBounds(skeleton);
+    const auto &   animInfos       = texture.value()->animInfos.value();
+    auto &         bounds          = texture.value()->bounds[meshHash];
+    bounds.assign(frames, geometry::AABB(INF, INF, INF, -INF, -INF, -INF));
+    for (uint32_t f = 0, offset = 0; f < frames; ++f) {
+        auto &bound = bounds[f];
+        for (uint32_t j = 0; j < jointCount; ++j, offset += 12) {
+            const auto &animInfo       = animInfos[j];
+            Mat4        mat;
+            bool        transformValid = true;
+            if (animInfo.curveData.has_value() && animInfo.downstream.has_value()) { // curve & static two-way combination
+                Mat4::multiply(animInfo.curveData.value()[f], animInfo.downstream.value(), &mat);
+            } else if (animInfo.curveData.has_value()) { // there is a curve directly controlling the joint
+                mat = animInfo.curveData.value()[f];
+            } else if (animInfo.downstream.has_value()) { // fallback to default pose if no animation curve can be found upstream
+                mat = animInfo.downstream.value();
+            } else { // bottom line: render the original mesh as-is
+                mat            = skeleton->getInverseBindposes()[animInfo.bindposeIdx];
+                transformValid = false;
+            }
+
+            if (j < boneSpaceBounds.size() && boneSpaceBounds[j]) {
+                if (animInfo.bindposeCorrection.has_value()) {
+                    Mat4::multiply(mat, animInfo.bindposeCorrection.value(), &m42);
+                    boneSpaceBounds[j]->transform(m42, &ab1);
+                } else {
+                    boneSpaceBounds[j]->transform(mat, &ab1);
+                }
+                ab1.getBoundary(&v33, &v34);
+                Vec3::min(bound.center, v33, &bound.center);
+                Vec3::max(bound.halfExtents, v34, &bound.halfExtents);
+            }
+
+            if (buildTexture) {
+                if (transformValid) {
+                    Mat4::multiply(mat, bindPoses[animInfo.bindposeIdx], &m41);
+                }
+                UPLOAD_JOINT_DATA(textureBuffer, offset, transformValid ? m41 : Mat4::IDENTITY, j == 0);
+            }
+        }
+        geometry::AABB::fromPoints(bound.center, bound.halfExtents, &bound);
+    }
+
+    if (buildTexture) {
+        uploadTexture(texture.value(), textureBuffer);
+        _textureBuffers[hash] = texture.value();
+    }
+    return texture;
+}
 
 void JointTexturePool::releaseHandle(IJointTextureHandle *handle) {
     if (handle->refCount > 0) {
@@ -346,119 +373,103 @@ void JointTexturePool::releaseHandle(IJointTextureHandle *handle) {
     }
     if (!handle->refCount && handle->readyToBeDeleted) {
         uint64_t hash = handle->skeletonHash ^ handle->clipHash;
-        if (_chunkIdxMap.find(hash) != _chunkIdxMap.end()) {
-            _customPool->free(handle->handle);
-        } else {
-            _pool->free(handle->handle);
+        getPool(hash)->free(handle->handle);
+        auto iter = _textureBuffers.find(hash);
+        if (iter != _textureBuffers.end() && iter->second == handle) {
+            _textureBuffers.erase(iter);
         }
-        if (_textureBuffers[hash] == handle) {
-            _textureBuffers.erase(hash);
-            CC_SAFE_DELETE(handle);
+        CC_SAFE_DELETE(handle);
+    }
+}
+
+template <typename Predicate>
+void JointTexturePool::releaseTextures(Predicate &&predicate) {
+    for (auto iter = _textureBuffers.begin(); iter != _textureBuffers.end();) {
+        auto *handle = iter->second;
+        if (!predicate(handle)) {
+            ++iter;
+            continue;
+        }
+        handle->readyToBeDeleted = true;
+        // delete handle record immediately so new allocations with the same asset could work
+        iter = _textureBuffers.erase(iter);
+        if (handle->refCount == 0) {
+            releaseHandle(handle);
         }
     }
 }
 
 void JointTexturePool::releaseSkeleton(Skeleton *skeleton) {
-    for (const auto &texture : _textureBuffers) {
-        auto *handle = texture.second;
-        if (handle->skeletonHash == skeleton->getHash()) {
-            handle->readyToBeDeleted = true;
-            if (handle->refCount > 0) {
-                // delete handle record immediately so new allocations with the same asset could work
-                _textureBuffers.erase(handle->skeletonHash ^ handle->clipHash);
-            } else {
-                releaseHandle(handle);
+    const uint64_t skeletonHash = skeleton->getHash();
+    releaseTextures([skeletonHash](const IJointTextureHandle *handle) { return handle->skeletonHash == skeletonHash; });
+}
+
+void JointTexturePool::releaseAnimationClip(uint64_t clipHash) {
+    releaseTextures([clipHash](const IJointTextureHandle *handle) { return handle->clipHash == clipHash; });
+}
+
+ccstd::vector<IInternalJointAnimInfo> JointTexturePool::createAnimInfos(Skeleton *skeleton, const IBakedClipData &clip, Node *skinningRoot) {
+    ccstd::vector<IInternalJointAnimInfo> animInfos;
+    const auto &                          joints     = skeleton->getJoints();
+    const auto &                          bindposes  = skeleton->getBindposes();
+    const auto                            jointCount = static_cast<index_t>(joints.size());
+    Mat4                                  m41;
+    animInfos.reserve(jointCount);
+    for (index_t j = 0; j < jointCount; ++j) {
+        ccstd::string               animPath = joints[j];
+        auto                        source   = clip.joints.find(animPath);
+        Node *                      animNode = skinningRoot->getChildByPath(animPath);
+        cc::optional<Mat4>          downstream;
+        cc::optional<ccstd::string> correctionPath;
+        while (source == clip.joints.end()) {
+            const auto idx = animPath.rfind('/');
+            animPath       = idx == ccstd::string::npos ? ccstd::string() : animPath.substr(0, idx);
+            source         = clip.joints.find(animPath);
+            if (animNode) {
+                if (!downstream.has_value()) {
+                    downstream = Mat4::IDENTITY;
+                }
+                Mat4::fromRTS(animNode->getRotation(), animNode->getPosition(), animNode->getScale(), &m41);
+                Mat4::multiply(downstream.value(), m41, &downstream.value());
+                animNode = animNode->getParent();
+            } else { // record the nearest curve path if no downstream pose is present
+                correctionPath = animPath;
+            }
+            if (idx == ccstd::string::npos) {
+                break;
+            }
+        }
+
+        // the default behavior, just use the bindpose for current joint directly
+        IInternalJointAnimInfo animInfo;
+        animInfo.bindposeIdx = j;
+        /**
+         * Developers may delete the skeleton node tree of models that only play baked animations. A joint that isn't controlled
+         * by any curve then has no downstream default pose when its parents are animated. The bindpose of the joint of the nearest
+         * curve is used instead, which merges the skinning influence of the joint into that parent.
+         */
+        if (correctionPath.has_value() && source != clip.joints.end()) {
+            // just use the previous joint if the exact path is not found
+            animInfo.bindposeIdx = std::max(j - 1, 0);
+            for (index_t t = 0; t < jointCount; ++t) {
+                if (joints[t] == correctionPath.value()) {
+                    Mat4 correction;
+                    Mat4::multiply(bindposes[t], skeleton->getInverseBindposes()[j], &correction);
+                    animInfo.bindposeIdx        = t;
+                    animInfo.bindposeCorrection = correction;
+                    break;
+                }
             }
         }
+        if (source != clip.joints.end()) {
+            animInfo.curveData = source->second;
+        }
+        animInfo.downstream = downstream;
+        animInfos.emplace_back(std::move(animInfo));
     }
+    return animInfos;
 }
 
-// TODO(xwx): AnimationClip not define
-// public releaseAnimationClip(clip: AnimationClip) {
-//     const it = this._textureBuffers.values();
-//     let res  = it.next();
-//     while (!res.done) {
-//         const handle = res.value;
-//         if (handle.clipHash == = clip.hash) {
-//             handle.readyToBeDeleted = true;
-//             if (handle.refCount) {
-//                 // delete handle record immediately so new allocations with the same asset could work
-//                 this._textureBuffers.delete(handle.skeletonHash ^ handle.clipHash);
-//             } else {
-//                 this.releaseHandle(handle);
-//             }
-//         }
-//         res = it.next();
-//     }
-// }
-
-// TODO(xwx): AnimationClip not define
-// private _createAnimInfos (skeleton: Skeleton, clip: AnimationClip, skinningRoot: Node) {
-//     const animInfos: IInternalJointAnimInfo[] = [];
-//     const { joints, bindposes } = skeleton;
-//     const jointCount = joints.length;
-//     const clipData = SkelAnimDataHub.getOrExtract(clip);
-//     for (let j = 0; j < jointCount; j++) {
-//         let animPath = joints[j];
-//         let source = clipData.joints[animPath];
-//         let animNode = skinningRoot.getChildByPath(animPath);
-//         let downstream: Mat4 | undefined;
-//         let correctionPath: string | undefined;
-//         while (!source) {
-//             const idx = animPath.lastIndexOf('/');
-//             animPath = animPath.substring(0, idx);
-//             source = clipData.joints[animPath];
-//             if (animNode) {
-//                 if (!downstream) { downstream = new Mat4(); }
-//                 Mat4.fromRTS(m4_1, animNode.rotation, animNode.position, animNode.scale);
-//                 Mat4.multiply(downstream, m4_1, downstream);
-//                 animNode = animNode.parent;
-//             } else { // record the nearest curve path if no downstream pose is present
-//                 correctionPath = animPath;
-//             }
-//             if (idx < 0) { break; }
-//         }
-//         // the default behavior, just use the bindpose for current joint directly
-//         let bindposeIdx = j;
-//         let bindposeCorrection: Mat4 | undefined;
-//         /**
-//          * It is regularly observed that developers may choose to delete the whole
-//          * skeleton node tree for skinning models that only use baked animations
-//          * as an effective optimization strategy (substantial improvements on both
-//          * package size and runtime efficiency).
-//          *
-//          * This becomes troublesome in some cases during baking though, e.g. when a
-//          * skeleton joint node is not directly controlled by any animation curve,
-//          * but its parent nodes are. Due to lack of proper downstream default pose,
-//          * the joint transform can not be calculated accurately.
-//          *
-//          * We address this issue by employing some pragmatic approximation.
-//          * Specifically, by multiplying the bindpose of the joint corresponding to
-//          * the nearest curve, instead of the actual target joint. This effectively
-//          * merges the skinning influence of the 'incomplete' joint into its nearest
-//          * parent with accurate transform data.
-//          * It gives more visually-plausible results compared to the naive approach
-//          * for most cases we've covered.
-//          */
-//         if (correctionPath !== undefined && source) {
-//             // just use the previous joint if the exact path is not found
-//             bindposeIdx = j - 1;
-//             for (let t = 0; t < jointCount; t++) {
-//                 if (joints[t] === correctionPath) {
-//                     bindposeIdx = t;
-//                     bindposeCorrection = new Mat4();
-//                     Mat4.multiply(bindposeCorrection, bindposes[t], skeleton.inverseBindposes[j]);
-//                     break;
-//                 }
-//             }
-//         }
-//         animInfos.push({
-//             curveData: source && source.transforms, downstream, bindposeIdx, bindposeCorrection,
-//         });
-//     }
-//     return animInfos;
-// }
-
 IAnimInfo JointAnimationInfo::getData(const ccstd::string &nodeID) {
     if (_pool.find(nodeID) != _pool.end()) {
         return _pool[nodeID];
@@ -58,6 +58,17 @@ struct IInternalJointAnimInfo {
     cc::optional<Mat4>                bindposeCorrection; // correction factor from the original bindpose
 };
 
+/**
+ * @en Joint transforms of an animation clip sampled at a fixed frame rate, relative to the skinning root.
+ * It is the native counterpart of the clip data extracted by SkelAnimDataHub.
+ * @zh 以固定帧率采样的动画片段骨骼变换，相对于蒙皮根节点，对应 SkelAnimDataHub 提取的片段数据。
+ */
+struct IBakedClipData {
+    uint64_t                                                 hash{0}; // hash of the animation clip
+    uint32_t                                                 frames{0};
+    ccstd::unordered_map<ccstd::string, ccstd::vector<Mat4>> joints; // joint path -> transform of each frame
+};
+
 class IJointTextureHandle {
 public:
     uint32_t                                                      pixelOffset{0};
@@ -80,10 +91,18 @@ private:
 class JointTexturePool : public RefCounted {
 public:
     JointTexturePool() = default;
-    explicit JointTexturePool(gfx::Device *device);
+    /**
+     * @en Joint textures are stored as half floats when halfFloat is true and the device can sample them. This halves the texture
+     * memory but reduces the precision of the joint transforms. Otherwise they are stored as 32 bit floats, or packed into RGBA8
+     * pixels on devices without float textures.
+     * @zh halfFloat 为 true 且设备支持采样时以半精度浮点存储骨骼贴图，贴图内存减半，但骨骼变换的精度降低。
+     * 否则以 32 位浮点存储，不支持浮点贴图的设备上则打包存储在 RGBA8 像素中。
+     */
+    explicit JointTexturePool(gfx::Device *device, bool halfFloat = true);
     ~JointTexturePool() override = default;
 
-    inline uint32_t getPixelsPerJoint() const { return _pixelsPerJoint; }
+    inline uint32_t    getPixelsPerJoint() const { return _pixelsPerJoint; }
+    inline gfx::Format getFormat() const { return _format; }
 
     void clear();
 
@@ -99,25 +118,34 @@ public:
 
     /**
      * @en
-     * Get joint texture for the specified animation clip.
+     * Get joint texture for the specified animation clip. Every frame of the clip is baked into one range of the shared texture,
+     * reused by all the models with the same skeleton and clip.
      * @zh
-     * 获取指定动画片段的骨骼贴图。
+     * 获取指定动画片段的骨骼贴图。片段的所有帧烘焙到共享贴图的同一段区域中，由骨骼与片段相同的所有模型共用。
      */
-    // cc::optional<IJointTextureHandle> getSequencePoseTexture(Skeleton *skeleton, AnimationClip *clip, Mesh *mesh, Node *skinningRoot);
+    cc::optional<IJointTextureHandle *> getSequencePoseTexture(Skeleton *skeleton, const IBakedClipData &clip, Mesh *mesh, Node *skinningRoot);
 
     void releaseHandle(IJointTextureHandle *handle);
 
     void releaseSkeleton(Skeleton *skeleton);
 
-    // void releaseAnimationClip (AnimationClip* clip); // TODO(xwx): AnimationClip not define
+    void releaseAnimationClip(uint64_t clipHash);
 
 private:
-    // const IInternalJointAnimInfo &createAnimInfos(Skeleton *skeleton, AnimationClip *clip, Node *skinningRoot); // TODO(xwx): AnimationClip not define
+    ccstd::vector<IInternalJointAnimInfo> createAnimInfos(Skeleton *skeleton, const IBakedClipData &clip, Node *skinningRoot);
+
+    TextureBufferPool *  getPool(uint64_t hash) const;
+    IJointTextureHandle *createHandle(uint64_t hash, uint32_t floatCount);
+    void                 uploadTexture(const IJointTextureHandle *texture, const Float32Array &data);
+    template <typename Predicate>
+    void releaseTextures(Predicate &&predicate);
 
     gfx::Device *                                         _device{nullptr};
     IntrusivePtr<TextureBufferPool>                       _pool;
     ccstd::unordered_map<uint64_t, IJointTextureHandle *> _textureBuffers;
+    gfx::Format                                           _format{gfx::Format::UNKNOWN};
     uint32_t                                              _formatSize{0};
+    uint32_t                                              _bytesPerFloat{0}; // bytes a joint texture float takes in the texture
     uint32_t                                              _pixelsPerJoint{0};
     IntrusivePtr<TextureBufferPool>                       _customPool;
     ccstd::unordered_map<uint64_t, index_t>               _chunkIdxMap; // hash -> chunkIdx
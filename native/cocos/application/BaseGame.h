@@ -24,6 +24,8 @@
 ****************************************************************************/
 #include <string>
 #include "CocosApplication.h"
+#include "engine/Benchmark.h"
+#include "profiler/StartupTimer.h"
 #include "renderer/pipeline/GlobalDescriptorSetManager.h"
 
 namespace cc {
@@ -76,14 +78,23 @@ public:
 
         setXXTeaKey(_xxteaKey);
 
+        if (_benchmarkInfo.enabled) {
+            getEngine()->setBenchmark(_benchmarkInfo);
+            if (!_benchmarkInfo.capturePath.empty()) {
+                return 0; // the benchmark replays the capture on its own device
+            }
+        }
+
+        CC_STARTUP_PHASE(main_scripts);
         runScript("jsb-adapter/jsb-builtin.js");
         runScript("main.js");
         return 0;
     }
 
 protected:
-    std::string  _xxteaKey;
-    DebuggerInfo _debuggerInfo;
-    WindowInfo   _windowInfo;
+    std::string   _xxteaKey;
+    DebuggerInfo  _debuggerInfo;
+    WindowInfo    _windowInfo;
+    BenchmarkInfo _benchmarkInfo;
 };
 } // namespace cc
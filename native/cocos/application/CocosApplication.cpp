@@ -35,6 +35,7 @@
 #include "cocos/bindings/manual/jsb_module_register.h"
 #include "cocos/engine/BaseEngine.h"
 #include "cocos/platform/interfaces/modules/IScreen.h"
+#include "cocos/profiler/StartupTimer.h"
 
 namespace cc {
 
@@ -51,6 +52,7 @@ CocosApplication::~CocosApplication() {
 }
 
 int CocosApplication::init() {
+    CC_STARTUP_PHASE(application_init);
     if (_engine->init()) {
         return -1;
     }
@@ -75,7 +77,11 @@ int CocosApplication::init() {
 
     jsb_register_all_modules();
 
-    se->start();
+    {
+        // binding modules are registered in here
+        CC_STARTUP_PHASE(script_engine_start);
+        se->start();
+    }
 
 #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS)
     auto     logicSize  = _systemWidow->getViewSize();
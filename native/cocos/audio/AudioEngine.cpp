@@ -25,13 +25,15 @@
 ****************************************************************************/
 
 #include "audio/include/AudioEngine.h"
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 #include "base/Log.h"
 #include "base/Utils.h"
-#include "base/std/container/queue.h"
+#include "base/std/container/deque.h"
 #include "platform/FileUtils.h"
+#include "profiler/StartupTimer.h"
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #include "audio/android/AudioEngine-inl.h"
@@ -63,6 +65,8 @@ ccstd::unordered_map<ccstd::string, ccstd::list<int>> AudioEngine::sAudioPathIDM
 //profileName,ProfileHelper
 ccstd::unordered_map<ccstd::string, AudioEngine::ProfileHelper> AudioEngine::sAudioPathProfileHelperMap;
 unsigned int                                                    AudioEngine::sMaxInstances         = MAX_AUDIOINSTANCES;
+uint32_t                                                        AudioEngine::sStreamingThreshold   = 1048576;
+uint32_t                                                        AudioEngine::sCacheBudget          = 0;
 AudioEngine::ProfileHelper *                                    AudioEngine::sDefaultProfileHelper = nullptr;
 ccstd::unordered_map<int, AudioEngine::AudioInfo>               AudioEngine::sAudioIDInfoMap;
 AudioEngineImpl *                                               AudioEngine::sAudioEngineImpl = nullptr;
@@ -75,6 +79,11 @@ ccstd::vector<int> AudioEngine::sBreakAudioID;
 AudioEngine::AudioEngineThreadPool *AudioEngine::sThreadPool = nullptr;
 bool                                AudioEngine::sIsEnabled  = true;
 
+namespace {
+std::mutex              gCacheStatsMutex;
+AudioEngine::CacheStats gCacheStats;
+} // namespace
+
 AudioEngine::AudioInfo::AudioInfo()
 : filePath(nullptr),
   profileHelper(nullptr),
@@ -94,12 +103,21 @@ public:
         }
     }
 
-    void addTask(const std::function<void()> &task) {
+    void addTask(const std::function<void()> &task, TaskPriority priority, uint32_t key) {
         std::unique_lock<std::mutex> lk(_queueMutex);
-        _taskQueue.emplace(task);
+        (priority == TaskPriority::PLAY ? _playTasks : _preloadTasks).push_back({task, key});
         _taskCondition.notify_one();
     }
 
+    void promoteTask(uint32_t key) {
+        std::unique_lock<std::mutex> lk(_queueMutex);
+        auto iter = std::find_if(_preloadTasks.begin(), _preloadTasks.end(), [key](const Task &task) { return task.key == key; });
+        if (iter != _preloadTasks.end()) {
+            _playTasks.push_back(std::move(*iter));
+            _preloadTasks.erase(iter);
+        }
+    }
+
     ~AudioEngineThreadPool() {
         {
             std::unique_lock<std::mutex> lk(_queueMutex);
@@ -121,9 +139,10 @@ private:
                 if (_stop) {
                     break;
                 }
-                if (!_taskQueue.empty()) {
-                    task = std::move(_taskQueue.front());
-                    _taskQueue.pop();
+                auto &queue = _playTasks.empty() ? _preloadTasks : _playTasks;
+                if (!queue.empty()) {
+                    task = std::move(queue.front().function);
+                    queue.pop_front();
                 } else {
                     _taskCondition.wait(lk);
                     continue;
@@ -134,8 +153,14 @@ private:
         }
     }
 
-    ccstd::vector<std::thread>          _workers;
-    ccstd::queue<std::function<void()>> _taskQueue;
+    struct Task {
+        std::function<void()> function;
+        uint32_t              key{0};
+    };
+
+    ccstd::vector<std::thread> _workers;
+    ccstd::deque<Task>         _playTasks;
+    ccstd::deque<Task>         _preloadTasks;
 
     std::mutex              _queueMutex;
     std::condition_variable _taskCondition;
@@ -169,6 +194,7 @@ void AudioEngine::end() {
 
 bool AudioEngine::lazyInit() {
     if (sAudioEngineImpl == nullptr) {
+        CC_STARTUP_PHASE(audio);
         sAudioEngineImpl = new (std::nothrow) AudioEngineImpl();
         if (!sAudioEngineImpl || !sAudioEngineImpl->init()) {
             delete sAudioEngineImpl;
@@ -211,23 +237,42 @@ int AudioEngine::play2d(const ccstd::string &filePath, bool loop, float volume,
             profileHelper->profile = *profile;
         }
 
-        if (sAudioIDInfoMap.size() >= sMaxInstances) {
-            CC_LOG_INFO("Fail to play %s cause by limited max instance of AudioEngine", filePath.c_str());
-            break;
-        }
         if (profileHelper) {
-            if (profileHelper->profile.maxInstances != 0 && profileHelper->audioIDs.size() >= profileHelper->profile.maxInstances) {
-                CC_LOG_INFO("Fail to play %s cause by limited max instance of AudioProfile", filePath.c_str());
-                break;
-            }
-            if (profileHelper->profile.minDelay > TIME_DELAY_PRECISION) {
+            const auto &profile = profileHelper->profile;
+            if (profile.minDelay > TIME_DELAY_PRECISION) {
                 auto currTime = std::chrono::high_resolution_clock::now();
                 auto delay    = static_cast<float>(std::chrono::duration_cast<std::chrono::microseconds>(currTime - profileHelper->lastPlayTime).count()) / 1000000.0;
-                if (profileHelper->lastPlayTime.time_since_epoch().count() != 0 && delay <= profileHelper->profile.minDelay) {
+                if (profileHelper->lastPlayTime.time_since_epoch().count() != 0 && delay <= profile.minDelay) {
                     CC_LOG_INFO("Fail to play %s cause by limited minimum delay", filePath.c_str());
                     break;
                 }
             }
+            if (profile.maxInstancesPerClip != 0) {
+                int          oldest = INVALID_AUDIO_ID;
+                unsigned int count  = 0;
+                auto         iter   = sAudioPathIDMap.find(filePath);
+                if (iter != sAudioPathIDMap.end()) {
+                    // the IDs are in play order
+                    for (int audioID : iter->second) {
+                        if (sAudioIDInfoMap[audioID].profileHelper == profileHelper && count++ == 0) {
+                            oldest = audioID;
+                        }
+                    }
+                }
+                if (count >= profile.maxInstancesPerClip && !(profile.stealOldest && stopVoice(oldest))) {
+                    CC_LOG_INFO("Fail to play %s cause by limited max instance of the clip in AudioProfile", filePath.c_str());
+                    break;
+                }
+            }
+            if (profile.maxInstances != 0 && profileHelper->audioIDs.size() >= profile.maxInstances &&
+                !(profile.stealOldest && stopVoice(profileHelper->audioIDs.front()))) {
+                CC_LOG_INFO("Fail to play %s cause by limited max instance of AudioProfile", filePath.c_str());
+                break;
+            }
+        }
+        if (sAudioIDInfoMap.size() >= sMaxInstances && !stopVoice(findVoiceToSteal(profileHelper))) {
+            CC_LOG_INFO("Fail to play %s cause by limited max instance of AudioEngine", filePath.c_str());
+            break;
         }
 
         if (volume < 0.0F) {
@@ -257,6 +302,36 @@ int AudioEngine::play2d(const ccstd::string &filePath, bool loop, float volume,
     return ret;
 }
 
+int AudioEngine::findVoiceToSteal(const ProfileHelper *profileHelper) {
+    if (!profileHelper) {
+        return INVALID_AUDIO_ID;
+    }
+    const int priority = profileHelper->profile.priority;
+    int       victim   = INVALID_AUDIO_ID;
+    int       lowest   = priority;
+    for (const auto &it : sAudioIDInfoMap) {
+        const int  instancePriority = it.second.profileHelper ? it.second.profileHelper->profile.priority : 0;
+        const bool stealable        = instancePriority < priority || (instancePriority == priority && profileHelper->profile.stealOldest);
+        if (!stealable || instancePriority > lowest) {
+            continue;
+        }
+        // IDs grow with each play, the smallest one is the oldest
+        if (victim == INVALID_AUDIO_ID || instancePriority < lowest || it.first < victim) {
+            victim = it.first;
+            lowest = instancePriority;
+        }
+    }
+    return victim;
+}
+
+bool AudioEngine::stopVoice(int audioID) {
+    if (audioID == INVALID_AUDIO_ID) {
+        return false;
+    }
+    stop(audioID);
+    return true;
+}
+
 void AudioEngine::setLoop(int audioID, bool loop) {
     auto it = sAudioIDInfoMap.find(audioID);
     if (it != sAudioIDInfoMap.end() && it->second.loop != loop) {
@@ -564,14 +639,48 @@ void AudioEngine::preload(const ccstd::string &filePath, const std::function<voi
     }
 }
 
-void AudioEngine::addTask(const std::function<void()> &task) {
+void AudioEngine::addTask(const std::function<void()> &task, TaskPriority priority, uint32_t key) {
     lazyInit();
 
     if (sAudioEngineImpl && sThreadPool) {
-        sThreadPool->addTask(task);
+        sThreadPool->addTask(task, priority, key);
     }
 }
 
+void AudioEngine::promoteTask(uint32_t key) {
+    if (sThreadPool) {
+        sThreadPool->promoteTask(key);
+    }
+}
+
+AudioEngine::CacheStats AudioEngine::getCacheStats() {
+    std::lock_guard<std::mutex> lock(gCacheStatsMutex);
+    return gCacheStats;
+}
+
+void AudioEngine::resetCacheStats() {
+    std::lock_guard<std::mutex> lock(gCacheStatsMutex);
+    gCacheStats = {};
+}
+
+void AudioEngine::recordCacheLookup(bool hit) {
+    std::lock_guard<std::mutex> lock(gCacheStatsMutex);
+    ++(hit ? gCacheStats.hits : gCacheStats.misses);
+}
+
+void AudioEngine::recordCacheEviction() {
+    std::lock_guard<std::mutex> lock(gCacheStatsMutex);
+    ++gCacheStats.evictions;
+}
+
+void AudioEngine::recordDecode(float milliseconds) {
+    // decodes run on the threads of the pool
+    std::lock_guard<std::mutex> lock(gCacheStatsMutex);
+    ++gCacheStats.decodes;
+    gCacheStats.decodeTime += milliseconds;
+    gCacheStats.maxDecodeTime = std::max(gCacheStats.maxDecodeTime, milliseconds);
+}
+
 int AudioEngine::getPlayingAudioCount() {
     return static_cast<int>(sAudioIDInfoMap.size());
 }
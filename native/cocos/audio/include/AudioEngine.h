@@ -63,6 +63,15 @@ public:
     /* Minimum delay in between sounds */
     double minDelay{};
 
+    //The maximum number of simultaneous instances of the same audio file in this profile, 0 for no limit.
+    unsigned int maxInstancesPerClip{};
+
+    //Once all voices of AudioEngine are taken, an instance of a profile with a lower priority is stopped for this one.
+    int priority{};
+
+    //When a limit of the profile is reached, stops its oldest instance instead of not playing the new one.
+    bool stealOldest{};
+
     /**
      * Default constructor
      *
@@ -255,6 +264,23 @@ public:
      */
     static bool setMaxAudioInstance(int maxInstances);
 
+    /**
+     * Sets the size in bytes of decoded PCM data above which a clip is streamed from its file while it plays, through a
+     * small ring of buffers refilled by a decoder thread, instead of being decoded into memory as a whole.
+     * Clips loaded before keep the way they were loaded with.
+     * @note Only the OpenAL Soft backend (Windows, Linux, OpenHarmony) streams clips by size.
+     */
+    static void     setStreamingThreshold(uint32_t bytes) { sStreamingThreshold = bytes; }
+    static uint32_t getStreamingThreshold() { return sStreamingThreshold; }
+
+    /**
+     * Sets the size in bytes the clips decoded into memory may take together, 0 for no limit. Once it is exceeded the
+     * clips played least recently which aren't playing are uncached, they are loaded again the next time they play.
+     * @note Only the OpenAL Soft backend (Windows, Linux, OpenHarmony) has a budget.
+     */
+    static void     setCacheBudget(uint32_t bytes) { sCacheBudget = bytes; }
+    static uint32_t getCacheBudget() { return sCacheBudget; }
+
     /** 
      * Uncache the audio data from internal buffer.
      * AudioEngine cache audio data on ios,mac, and oalsoft platform.
@@ -315,10 +341,39 @@ public:
      */
     static bool isEnabled();
 
+    struct CacheStats {
+        uint32_t hits{0};      // plays and preloads of clips which were cached already
+        uint32_t misses{0};    // plays and preloads which had to load their clip
+        uint32_t evictions{0}; // clips uncached to fit the cache budget
+        uint32_t decodes{0};
+        float    decodeTime{0.F}; // milliseconds spent loading clips in total
+        float    maxDecodeTime{0.F};
+    };
+
+    /**
+     * Gets the counters of the clip cache since the start or the last reset.
+     * @note Only the OpenAL Soft backend (Windows, Linux, OpenHarmony) counts them.
+     */
+    static CacheStats getCacheStats();
+    static void       resetCacheStats();
+
 protected:
-    static void addTask(const std::function<void()> &task);
+    // tasks of clips someone waits to play run before the ones of preloads, each kind in the order it was added
+    enum class TaskPriority : uint8_t {
+        PLAY,
+        PRELOAD,
+    };
+
+    // key identifies the task for promoteTask(), 0 if it never needs to
+    static void addTask(const std::function<void()> &task, TaskPriority priority = TaskPriority::PRELOAD, uint32_t key = 0);
+    // moves a preload task which hasn't started yet among the play ones, e.g. once its clip is played
+    static void promoteTask(uint32_t key);
     static void remove(int audioID);
 
+    static void recordCacheLookup(bool hit);
+    static void recordCacheEviction();
+    static void recordDecode(float milliseconds);
+
     static void pauseAll(ccstd::vector<int> *pausedAudioIDs);
     static void resumeAll(ccstd::vector<int> *pausedAudioIDs);
 
@@ -332,6 +387,11 @@ protected:
         ProfileHelper() = default;
     };
 
+    // the instance a new one of profileHelper may stop once all voices are taken: the oldest of the lowest priority
+    // below its own, or of the same priority if its profile steals, INVALID_AUDIO_ID if there is none
+    static int  findVoiceToSteal(const ProfileHelper *profileHelper);
+    static bool stopVoice(int audioID);
+
     struct AudioInfo {
         const ccstd::string *filePath;
         ProfileHelper *      profileHelper;
@@ -361,6 +421,8 @@ protected:
     static ccstd::unordered_map<ccstd::string, ProfileHelper> sAudioPathProfileHelperMap;
 
     static unsigned int sMaxInstances;
+    static uint32_t     sStreamingThreshold;
+    static uint32_t     sCacheBudget;
 
     static ProfileHelper *sDefaultProfileHelper;
 
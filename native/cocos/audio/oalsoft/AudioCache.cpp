@@ -30,8 +30,10 @@
 #include <algorithm>
 #include <thread>
 #include "application/ApplicationManager.h"
+#include "audio/include/AudioEngine.h"
 #include "audio/oalsoft/AudioDecoder.h"
 #include "audio/oalsoft/AudioDecoderManager.h"
+#include "base/memory/MemoryAccounting.h"
 
 #include <string.h>
 
@@ -49,7 +51,6 @@ unsigned int gIdIndex = 0;
 }
 
 #define INVALID_AL_BUFFER_ID 0xFFFFFFFF
-#define PCMDATA_CACHEMAXSIZE 1048576
 
 using namespace cc; //NOLINT
 
@@ -89,11 +90,13 @@ AudioCache::~AudioCache() {
         }
 
         free(_pcmData);
+        CC_MEMORY_ACCOUNT_FREE(AUDIO, _pcmDataSize);
     }
 
     if (_queBufferFrames > 0) {
-        for (auto &buffer : _queBuffers) {
-            free(buffer);
+        for (int index = 0; index < QUEUEBUFFER_NUM; ++index) {
+            free(_queBuffers[index]);
+            CC_MEMORY_ACCOUNT_FREE(AUDIO, _queBufferSize[index]);
         }
     }
     ALOGVV("~AudioCache() %p, id=%u, end", this, _id);
@@ -127,7 +130,8 @@ void AudioCache::readDataTask(unsigned int selfId) {
         _duration    = 1.0F * totalFrames / sampleRate;
         _totalFrames = totalFrames;
 
-        if (dataSize <= PCMDATA_CACHEMAXSIZE) {
+        // larger clips are streamed by the players from their own decoders, only the first buffers are cached
+        if (dataSize <= AudioEngine::getStreamingThreshold()) {
             uint32_t       framesRead       = 0;
             const uint32_t framesToReadOnce = std::min(totalFrames, static_cast<uint32_t>(sampleRate * QUEUEBUFFER_TIME_STEP * QUEUEBUFFER_NUM));
 
@@ -162,7 +166,9 @@ void AudioCache::readDataTask(unsigned int selfId) {
             // Reset to frame 0
             BREAK_IF_ERR_LOG(!decoder->seek(0), "AudioDecoder::seek(0) failed!");
 
-            _pcmData = static_cast<char *>(malloc(dataSize));
+            _pcmData     = static_cast<char *>(malloc(dataSize));
+            _pcmDataSize = dataSize;
+            CC_MEMORY_ACCOUNT_ALLOC(AUDIO, dataSize);
 
             CC_ASSERT(_pcmData);
             memset(_pcmData, 0x00, dataSize);
@@ -227,6 +233,7 @@ void AudioCache::readDataTask(unsigned int selfId) {
             for (int index = 0; index < QUEUEBUFFER_NUM; ++index) {
                 _queBuffers[index]    = static_cast<char *>(malloc(queBufferBytes));
                 _queBufferSize[index] = queBufferBytes;
+                CC_MEMORY_ACCOUNT_ALLOC(AUDIO, queBufferBytes);
 
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
@@ -79,13 +79,14 @@ protected:
     uint32_t _framesRead;
 
     /*Cache related stuff;
-     * Cache pcm data when sizeInBytes less than PCMDATA_CACHEMAXSIZE
+     * Cache pcm data when sizeInBytes isn't more than AudioEngine::getStreamingThreshold()
      */
-    ALuint _alBufferId;
-    char * _pcmData;
+    ALuint   _alBufferId;
+    char *   _pcmData;
+    uint32_t _pcmDataSize{0};
 
     /*Queue buffer related stuff
-     *  Streaming in OpenAL when sizeInBytes greater then PCMDATA_CACHEMAXSIZE
+     *  Streaming in OpenAL when sizeInBytes greater then AudioEngine::getStreamingThreshold()
      */
     char *   _queBuffers[QUEUEBUFFER_NUM];
     ALsizei  _queBufferSize[QUEUEBUFFER_NUM];
@@ -104,6 +105,7 @@ protected:
     std::shared_ptr<bool> _isDestroyed;
     ccstd::string         _fileFullPath;
     unsigned int          _id;
+    uint64_t              _lastUsed{0}; // serial of the last preload or play, the least recent is uncached first
     bool                  _isLoadingFinished;
     bool                  _isSkipReadDataTask;
 
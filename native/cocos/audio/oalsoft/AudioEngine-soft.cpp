@@ -27,6 +27,7 @@
 #define LOG_TAG "AudioEngine-OALSOFT"
 
 #include "audio/oalsoft/AudioEngine-soft.h"
+#include <chrono>
 
 #ifdef OPENAL_PLAIN_INCLUDES
     #include "alc.h"
@@ -126,6 +127,11 @@ AudioEngineImpl::~AudioEngineImpl() {
         sche->unschedule("AudioEngine", this);
     }
 
+    for (auto *player : _playerPool) {
+        delete player;
+    }
+    _playerPool.clear();
+
     if (sALContext) {
         alDeleteSources(MAX_AUDIOINSTANCES, _alSources);
 
@@ -164,6 +170,10 @@ bool AudioEngineImpl::init() {
             for (unsigned int src : _alSources) {
                 _alSourceUsed[src] = false;
             }
+            _playerPool.reserve(MAX_AUDIOINSTANCES);
+            for (int i = 0; i < MAX_AUDIOINSTANCES; ++i) {
+                _playerPool.push_back(new AudioPlayer);
+            }
 
             _scheduler = CC_CURRENT_ENGINE()->getScheduler();
             ret        = AudioDecoderManager::init();
@@ -174,26 +184,35 @@ bool AudioEngineImpl::init() {
     return ret;
 }
 
-AudioCache *AudioEngineImpl::preload(const ccstd::string &filePath, const std::function<void(bool)> &callback) {
+AudioCache *AudioEngineImpl::preload(const ccstd::string &filePath, const std::function<void(bool)> &callback, bool toPlay) {
     AudioCache *audioCache = nullptr;
 
     auto it = _audioCaches.find(filePath);
+    AudioEngine::recordCacheLookup(it != _audioCaches.end());
     if (it == _audioCaches.end()) {
+        trimCaches();
         audioCache                    = &_audioCaches[filePath];
         audioCache->_fileFullPath     = FileUtils::getInstance()->fullPathForFilename(filePath);
         unsigned int cacheId          = audioCache->_id;
         auto         isCacheDestroyed = audioCache->_isDestroyed;
-        AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
+        auto readDataTask = [audioCache, cacheId, isCacheDestroyed]() {
             if (*isCacheDestroyed) {
                 ALOGV("AudioCache (id=%u) was destroyed, no need to launch readDataTask.", cacheId);
                 audioCache->setSkipReadDataTask(true);
                 return;
             }
+            const auto start = std::chrono::steady_clock::now();
             audioCache->readDataTask(cacheId);
-        });
+            AudioEngine::recordDecode(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+        };
+        AudioEngine::addTask(readDataTask, toPlay ? AudioEngine::TaskPriority::PLAY : AudioEngine::TaskPriority::PRELOAD, cacheId);
     } else {
         audioCache = &it->second;
+        if (toPlay && audioCache->_state == AudioCache::State::INITIAL) {
+            AudioEngine::promoteTask(audioCache->_id);
+        }
     }
+    audioCache->_lastUsed = ++_cacheUseSerial;
 
     if (audioCache && callback) {
         audioCache->addLoadCallback(callback);
@@ -220,7 +239,7 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
-    auto player = new (std::nothrow) AudioPlayer;
+    auto *player = acquirePlayer();
     if (player == nullptr) {
         return AudioEngine::INVALID_AUDIO_ID;
     }
@@ -229,9 +248,9 @@ int AudioEngineImpl::play2d(const ccstd::string &filePath, bool loop, float volu
     player->_loop     = loop;
     player->_volume   = volume;
 
-    auto audioCache = preload(filePath, nullptr);
+    auto audioCache = preload(filePath, nullptr, true);
     if (audioCache == nullptr) {
-        delete player;
+        releasePlayer(player);
         return AudioEngine::INVALID_AUDIO_ID;
     }
 
@@ -487,7 +506,7 @@ void AudioEngineImpl::update(float /*dt*/) {
             _threadMutex.lock();
             it = _audioPlayers.erase(it);
             _threadMutex.unlock();
-            delete player;
+            releasePlayer(player);
             _alSourceUsed[alSource] = false;
         } else if (player->_ready && sourceState == AL_STOPPED) {
             ccstd::string filePath;
@@ -505,7 +524,7 @@ void AudioEngineImpl::update(float /*dt*/) {
             if (player->_finishCallbak) {
                 player->_finishCallbak(audioID, filePath); //IDEA: callback will delay 50ms
             }
-            delete player;
+            releasePlayer(player);
             _alSourceUsed[alSource] = false;
         } else {
             ++it;
@@ -517,7 +536,68 @@ void AudioEngineImpl::update(float /*dt*/) {
         if (auto sche = _scheduler.lock()) {
             sche->unschedule("AudioEngine", this);
         }
+        // clips which were playing may be over the budget
+        trimCaches();
+    }
+}
+
+void AudioEngineImpl::trimCaches() {
+    const uint32_t budget = AudioEngine::getCacheBudget();
+    if (budget == 0) {
+        return;
+    }
+
+    const auto isEvictable = [this](const AudioCache &cache) {
+        return cache._isLoadingFinished && cache._state == AudioCache::State::READY && cache._pcmDataSize > 0 && !isCacheInUse(&cache);
+    };
+    uint64_t total = 0;
+    for (const auto &it : _audioCaches) {
+        if (it.second._state == AudioCache::State::READY) {
+            total += it.second._pcmDataSize;
+        }
+    }
+    while (total > budget) {
+        auto victim = _audioCaches.end();
+        for (auto it = _audioCaches.begin(); it != _audioCaches.end(); ++it) {
+            if (isEvictable(it->second) && (victim == _audioCaches.end() || it->second._lastUsed < victim->second._lastUsed)) {
+                victim = it;
+            }
+        }
+        if (victim == _audioCaches.end()) {
+            break;
+        }
+        ALOGV("uncache %s to fit the cache budget of %u bytes", victim->first.c_str(), budget);
+        total -= victim->second._pcmDataSize;
+        _audioCaches.erase(victim);
+        AudioEngine::recordCacheEviction();
+    }
+}
+
+AudioPlayer *AudioEngineImpl::acquirePlayer() {
+    if (_playerPool.empty()) {
+        return new (std::nothrow) AudioPlayer;
+    }
+    auto *player = _playerPool.back();
+    _playerPool.pop_back();
+    return player;
+}
+
+void AudioEngineImpl::releasePlayer(AudioPlayer *player) {
+    if (_playerPool.size() >= MAX_AUDIOINSTANCES) {
+        delete player;
+        return;
+    }
+    player->reset();
+    _playerPool.push_back(player);
+}
+
+bool AudioEngineImpl::isCacheInUse(const AudioCache *cache) const {
+    for (const auto &it : _audioPlayers) {
+        if (it.second->_audioCache == cache) {
+            return true;
+        }
     }
+    return false;
 }
 
 void AudioEngineImpl::uncache(const ccstd::string &filePath) {
@@ -58,12 +58,18 @@ public:
 
     void        uncache(const ccstd::string &filePath);
     void        uncacheAll();
-    AudioCache *preload(const ccstd::string &filePath, const std::function<void(bool)> &callback);
+    // toPlay decodes the clip before the ones which are only preloaded
+    AudioCache *preload(const ccstd::string &filePath, const std::function<void(bool)> &callback, bool toPlay = false);
     void        update(float dt);
 
 private:
     bool checkAudioIdValid(int audioID);
     void play2dImpl(AudioCache *cache, int audioID);
+    // uncaches the least recently used decoded clips until they fit AudioEngine::getCacheBudget()
+    void trimCaches();
+    bool isCacheInUse(const AudioCache *cache) const;
+    AudioPlayer *acquirePlayer();
+    void         releasePlayer(AudioPlayer *player);
 
     ALuint _alSources[MAX_AUDIOINSTANCES];
 
@@ -75,11 +81,14 @@ private:
 
     //audioID,AudioInfo
     ccstd::unordered_map<int, AudioPlayer *> _audioPlayers;
+    // players which don't play, bursts of short sounds reuse them instead of allocating new ones
+    ccstd::vector<AudioPlayer *> _playerPool;
     std::mutex                               _threadMutex;
 
     bool _lazyInitLoop;
 
     int                      _currentAudioID;
+    uint64_t                 _cacheUseSerial{0};
     std::weak_ptr<Scheduler> _scheduler;
 };
 } // namespace cc
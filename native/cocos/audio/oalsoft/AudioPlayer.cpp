@@ -48,6 +48,7 @@ AudioPlayer::AudioPlayer()
   _isDestroyed(false),
   _removeByAudioEngine(false),
   _ready(false),
+  _alSource(0),
   _currTime(0.0F),
   _streamingSource(false),
   _rotateBufferThread(nullptr),
@@ -109,12 +110,15 @@ void AudioPlayer::destroy() {
         }
     } while (false);
 
-    CC_LOG_DEBUG("Before alSourceStop");
-    alSourceStop(_alSource);
-    CHECK_AL_ERROR_DEBUG();
-    CC_LOG_DEBUG("Before alSourcei");
-    alSourcei(_alSource, AL_BUFFER, 0);
-    CHECK_AL_ERROR_DEBUG();
+    // players of the pool don't have a source until they play
+    if (_alSource != 0) {
+        CC_LOG_DEBUG("Before alSourceStop");
+        alSourceStop(_alSource);
+        CHECK_AL_ERROR_DEBUG();
+        CC_LOG_DEBUG("Before alSourcei");
+        alSourcei(_alSource, AL_BUFFER, 0);
+        CHECK_AL_ERROR_DEBUG();
+    }
 
     _removeByAudioEngine = true;
 
@@ -122,6 +126,26 @@ void AudioPlayer::destroy() {
     CC_LOG_DEBUG("AudioPlayer::destroy end, id=%u", _id);
 }
 
+void AudioPlayer::reset() {
+    destroy();
+    if (_streamingSource) {
+        alDeleteBuffers(3, _bufferIds);
+        memset(_bufferIds, 0, sizeof(_bufferIds));
+    }
+
+    _audioCache           = nullptr;
+    _finishCallbak        = nullptr;
+    _isDestroyed          = false;
+    _removeByAudioEngine  = false;
+    _ready                = false;
+    _alSource             = 0;
+    _currTime             = 0.0F;
+    _streamingSource      = false;
+    _timeDirty            = false;
+    _isRotateThreadExited = false;
+    _id                   = ++gIdIndex;
+}
+
 void AudioPlayer::setCache(AudioCache *cache) {
     _audioCache = cache;
 }
@@ -63,6 +63,8 @@ protected:
     void setCache(AudioCache *cache);
     void rotateBufferThread(int offsetFrame);
     bool play2d();
+    // destroys the player and makes it ready for another play, for the pool of AudioEngineImpl
+    void reset();
 
     AudioCache *_audioCache;
 
@@ -47,6 +47,13 @@
     #define CC_USE_WEBP 1
 #endif // CC_USE_WEBP
 
+/** Support KTX2 textures with Basis Universal payloads or not. They are transcoded to a format supported by the device at load time,
+ * which needs the Basis Universal transcoder of the external libraries.
+ */
+#ifndef CC_USE_BASISU
+    #define CC_USE_BASISU 0
+#endif // CC_USE_BASISU
+
 /** Support EditBox
  */
 #ifndef CC_USE_EDITBOX
@@ -65,6 +72,16 @@
     #define USE_MEMORY_LEAK_DETECTOR 0
 #endif
 
+// MemoryHook records one allocation per N bytes on average when non-zero, cheap enough for release builds
+#ifndef CC_MEMORY_HOOK_SAMPLE_INTERVAL
+    #define CC_MEMORY_HOOK_SAMPLE_INTERVAL 0
+#endif
+
 #ifndef CC_USE_PROFILER
     #define CC_USE_PROFILER 0
 #endif
+
+// Per-subsystem memory accounting with budget callbacks, see base/memory/MemoryAccounting.h
+#ifndef CC_USE_MEMORY_ACCOUNTING
+    #define CC_USE_MEMORY_ACCOUNTING 1
+#endif
@@ -0,0 +1,177 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+/**
+ * Slot index plus the generation of the slot when the handle was made, a handle goes stale
+ * once its object is removed from the table even if the slot has been reused since.
+ */
+template <typename T>
+class GenerationalHandle {
+public:
+    GenerationalHandle() noexcept = default;
+    GenerationalHandle(uint32_t index, uint32_t generation) noexcept : _index(index), _generation(generation) {}
+
+    inline bool     isValid() const noexcept { return _generation != INVALID_GENERATION; }
+    inline void     clear() noexcept { _generation = INVALID_GENERATION; }
+    inline uint32_t getIndex() const noexcept { return _index; }
+    inline uint32_t getGeneration() const noexcept { return _generation; }
+
+    inline bool operator==(GenerationalHandle const &rhs) const noexcept { return _index == rhs._index && _generation == rhs._generation; }
+    inline bool operator!=(GenerationalHandle const &rhs) const noexcept { return !operator==(rhs); }
+
+    static constexpr uint32_t INVALID_GENERATION{0};
+
+private:
+    uint32_t _index{0};
+    uint32_t _generation{INVALID_GENERATION};
+};
+
+/**
+ * Owns one reference of each object added and hands out generational handles for them, so that
+ * hot loops can refer to the objects without touching reference counts.
+ * Removed objects stay alive until the next flush() and are released there in one batch, which
+ * usually happens at the end of the frame. get() only reads, so jobs may resolve handles in
+ * parallel as long as add, remove and flush happen outside of them.
+ */
+template <typename T>
+class HandleTable final {
+public:
+    using Handle = GenerationalHandle<T>;
+
+    HandleTable() = default;
+    ~HandleTable();
+
+    HandleTable(const HandleTable &) = delete;
+    HandleTable(HandleTable &&)      = delete;
+    HandleTable &operator=(const HandleTable &) = delete;
+    HandleTable &operator=(HandleTable &&) = delete;
+
+    Handle add(T *object);
+    void   remove(Handle handle);
+    // releases the objects removed since the last flush
+    void   flush();
+    // removes and releases everything immediately
+    void   clear();
+
+    inline T *      get(Handle handle) const noexcept;
+    inline bool     contains(Handle handle) const noexcept { return get(handle) != nullptr; }
+    inline uint32_t size() const noexcept { return _size; }
+
+private:
+    struct Slot {
+        T *      object{nullptr};
+        uint32_t generation{1};
+    };
+
+    ccstd::vector<Slot>     _slots;
+    ccstd::vector<uint32_t> _freeSlots;
+    ccstd::vector<uint32_t> _removedSlots;
+    ccstd::vector<T *>      _releaseQueue;
+    uint32_t                _size{0};
+};
+
+template <typename T>
+HandleTable<T>::~HandleTable() {
+    clear();
+}
+
+template <typename T>
+typename HandleTable<T>::Handle HandleTable<T>::add(T *object) {
+    static_assert(std::is_base_of<RefCounted, T>::value, "HandleTable only holds RefCounted objects");
+    CC_ASSERT(object);
+    uint32_t index = 0;
+    if (!_freeSlots.empty()) {
+        index = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    auto &slot  = _slots[index];
+    slot.object = object;
+    object->addRef();
+    ++_size;
+    return {index, slot.generation};
+}
+
+template <typename T>
+void HandleTable<T>::remove(Handle handle) {
+    if (!contains(handle)) {
+        return;
+    }
+
+    auto &slot = _slots[handle.getIndex()];
+    _releaseQueue.push_back(slot.object);
+    slot.object = nullptr;
+    // skips the invalid generation on wrap around
+    if (++slot.generation == Handle::INVALID_GENERATION) {
+        ++slot.generation;
+    }
+    // not reused before the flush, a stale handle never resolves to an object of the same frame
+    _removedSlots.push_back(handle.getIndex());
+    --_size;
+}
+
+template <typename T>
+void HandleTable<T>::flush() {
+    for (T *object : _releaseQueue) {
+        object->release();
+    }
+    _releaseQueue.clear();
+    _freeSlots.insert(_freeSlots.end(), _removedSlots.begin(), _removedSlots.end());
+    _removedSlots.clear();
+}
+
+template <typename T>
+void HandleTable<T>::clear() {
+    for (uint32_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].object) {
+            remove({i, _slots[i].generation});
+        }
+    }
+    flush();
+}
+
+template <typename T>
+T *HandleTable<T>::get(Handle handle) const noexcept {
+    if (handle.getIndex() >= _slots.size()) {
+        return nullptr;
+    }
+    const auto &slot = _slots[handle.getIndex()];
+    return slot.generation == handle.getGeneration() ? slot.object : nullptr;
+}
+
+} // namespace cc
@@ -38,6 +38,12 @@ namespace {
 constexpr unsigned CC_REPEAT_FOREVER{UINT_MAX - 1};
 constexpr int      MAX_FUNC_TO_PERFORM{30};
 constexpr int      INITIAL_TIMER_COUND{10};
+// resolution of the timer wheel, due timers are still compared against their exact time
+constexpr double TIMER_TICK_SECONDS{0.001};
+
+inline uint64_t toTick(double time) {
+    return static_cast<uint64_t>(std::max(time, 0.0) / TIMER_TICK_SECONDS);
+}
 } // namespace
 
 namespace cc {
@@ -50,6 +56,7 @@ void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float del
     _useDelay   = _delay > 0.0F;
     _repeat     = repeat;
     _runForever = _repeat == CC_REPEAT_FOREVER;
+    _node.data  = this;
 }
 
 void Timer::update(float dt) {
@@ -94,12 +101,39 @@ void Timer::update(float dt) {
             break;
         }
 
-        if (_scheduler->isCurrentTargetSalvaged()) {
+        if (!_scheduled) {
             break;
         }
     }
 }
 
+void Timer::expire(double time) {
+    if (_useDelay) {
+        trigger(_delay);
+        _periodStart += _delay;
+        _timesExecuted += 1;
+        _useDelay = false;
+        if (!_runForever && _timesExecuted > _repeat) {
+            cancel();
+            return;
+        }
+    }
+
+    while (_scheduled && _interval > 0.F && time >= _periodStart + _interval) {
+        trigger(_interval);
+        _periodStart += _interval;
+        _timesExecuted += 1;
+
+        if (!_runForever && _timesExecuted > _repeat) {
+            cancel();
+            break;
+        }
+    }
+}
+
+double Timer::getNextDue() const {
+    return _periodStart + (_useDelay ? _delay : _interval);
+}
 // TimerTargetCallback
 
 bool TimerTargetCallback::initWithCallback(Scheduler *scheduler, const ccSchedulerFunc &callback, void *target, const ccstd::string &key, float seconds, unsigned int repeat, float delay) {
@@ -126,6 +160,8 @@ void TimerTargetCallback::cancel() {
 Scheduler::Scheduler() {
     // I don't expect to have more than 30 functions to all per frame
     _functionsToPerform.reserve(MAX_FUNC_TO_PERFORM);
+    TimerWheel::initList(_frameTimers);
+    TimerWheel::initList(_startingTimers);
 }
 
 Scheduler::~Scheduler() {
@@ -135,12 +171,44 @@ Scheduler::~Scheduler() {
 void Scheduler::removeHashElement(HashTimerEntry *element) {
     if (element) {
         for (auto &timer : element->timers) {
+            unlinkTimer(timer);
             timer->release();
         }
         element->timers.clear();
 
         _hashForTimers.erase(element->target);
-        free(element);
+        delete element;
+    }
+}
+
+void Scheduler::linkTimer(Timer *timer) {
+    if (timer->_interval <= 0.F) {
+        TimerWheel::pushBack(_frameTimers, &timer->_node);
+    } else if (timer->_elapsed == -1) {
+        TimerWheel::pushBack(_startingTimers, &timer->_node);
+    } else {
+        _timerWheel.add(&timer->_node, toTick(timer->getNextDue()));
+    }
+}
+
+void Scheduler::unlinkTimer(Timer *timer) {
+    timer->_scheduled = false;
+    TimerWheel::unlink(&timer->_node);
+}
+
+void Scheduler::setTimerInterval(Timer *timer, float interval) {
+    // timers running every frame count their elapsed time, interval timers the start of their period
+    if (timer->_elapsed != -1) {
+        if (timer->_interval <= 0.F && interval > 0.F) {
+            timer->_periodStart = _time - timer->_elapsed;
+        } else if (timer->_interval > 0.F && interval <= 0.F) {
+            timer->_elapsed = static_cast<float>(_time - timer->_periodStart);
+        }
+    }
+    timer->setInterval(interval);
+    if (timer->_node.isLinked()) {
+        TimerWheel::unlink(&timer->_node);
+        linkTimer(timer);
     }
 }
 
@@ -174,7 +242,7 @@ void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float in
             auto *timer = dynamic_cast<TimerTargetCallback *>(e);
             if (key == timer->getKey()) {
                 CC_LOG_DEBUG("CCScheduler#scheduleSelector. Selector already scheduled. Updating interval from: %.4f to %.4f", timer->getInterval(), interval);
-                timer->setInterval(interval);
+                setTimerInterval(timer, interval);
                 return;
             }
         }
@@ -183,7 +251,13 @@ void Scheduler::schedule(const ccSchedulerFunc &callback, void *target, float in
     auto *timer = new (std::nothrow) TimerTargetCallback();
     timer->addRef();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
+    timer->_scheduled = true;
+    timer->_paused    = element->paused;
+    timer->_pausedAt  = _time;
     element->timers.emplace_back(timer);
+    if (!timer->_paused) {
+        linkTimer(timer);
+    }
 }
 
 void Scheduler::unschedule(const ccstd::string &key, void *target) {
@@ -195,38 +269,23 @@ void Scheduler::unschedule(const ccstd::string &key, void *target) {
     auto iter = _hashForTimers.find(target);
     if (iter != _hashForTimers.end()) {
         HashTimerEntry *element = iter->second;
-        int             i       = 0;
         auto &          timers  = element->timers;
 
-        for (auto *t : timers) {
-            auto *timer = dynamic_cast<TimerTargetCallback *>(t);
+        for (auto timerIter = timers.begin(); timerIter != timers.end(); ++timerIter) {
+            auto *timer = dynamic_cast<TimerTargetCallback *>(*timerIter);
 
             if (timer && key == timer->getKey()) {
-                if (timer == element->currentTimer && (!element->currentTimerSalvaged)) {
-                    element->currentTimer->addRef();
-                    element->currentTimerSalvaged = true;
-                }
-
-                timers.erase(timers.begin() + i);
+                // a timer being triggered is kept alive by update until its callback returns
+                unlinkTimer(timer);
+                timers.erase(timerIter);
                 timer->release();
 
-                // update timerIndex in case we are in tick:, looping over the actions
-                if (element->timerIndex >= i) {
-                    element->timerIndex--;
-                }
-
                 if (timers.empty()) {
-                    if (_currentTarget == element) {
-                        _currentTargetSalvaged = true;
-                    } else {
-                        removeHashElement(element);
-                    }
+                    removeHashElement(element);
                 }
 
                 return;
             }
-
-            ++i;
         }
     }
 }
@@ -253,8 +312,8 @@ bool Scheduler::isScheduled(const ccstd::string &key, void *target) {
 }
 
 void Scheduler::unscheduleAll() {
-    for (auto iter = _hashForTimers.begin(); iter != _hashForTimers.end();) {
-        unscheduleAllForTarget(iter++->first);
+    while (!_hashForTimers.empty()) {
+        unscheduleAllForTarget(_hashForTimers.begin()->first);
     }
 }
 
@@ -268,24 +327,7 @@ void Scheduler::unscheduleAllForTarget(void *target) {
 
     auto iter = _hashForTimers.find(target);
     if (iter != _hashForTimers.end()) {
-        HashTimerEntry *element = iter->second;
-        auto &          timers  = element->timers;
-        if (std::find(timers.begin(), timers.end(), element->currentTimer) != timers.end() &&
-            (!element->currentTimerSalvaged)) {
-            element->currentTimer->addRef();
-            element->currentTimerSalvaged = true;
-        }
-
-        for (auto *t : timers) {
-            t->release();
-        }
-        timers.clear();
-
-        if (_currentTarget == element) {
-            _currentTargetSalvaged = true;
-        } else {
-            removeHashElement(element);
-        }
+        removeHashElement(iter->second);
     }
 }
 
@@ -294,8 +336,16 @@ void Scheduler::resumeTarget(void *target) {
 
     // custom selectors
     auto iter = _hashForTimers.find(target);
-    if (iter != _hashForTimers.end()) {
+    if (iter != _hashForTimers.end() && iter->second->paused) {
         iter->second->paused = false;
+        for (auto *timer : iter->second->timers) {
+            // the time spent paused doesn't count towards the interval
+            timer->_periodStart += _time - timer->_pausedAt;
+            timer->_paused = false;
+            if (timer != _currentTimer) {
+                linkTimer(timer);
+            }
+        }
     }
 }
 
@@ -304,8 +354,13 @@ void Scheduler::pauseTarget(void *target) {
 
     // custom selectors
     auto iter = _hashForTimers.find(target);
-    if (iter != _hashForTimers.end()) {
+    if (iter != _hashForTimers.end() && !iter->second->paused) {
         iter->second->paused = true;
+        for (auto *timer : iter->second->timers) {
+            TimerWheel::unlink(&timer->_node);
+            timer->_paused   = true;
+            timer->_pausedAt = _time;
+        }
     }
 }
 
@@ -334,49 +389,49 @@ void Scheduler::removeAllFunctionsToBePerformedInCocosThread() {
 
 // main loop
 void Scheduler::update(float dt) {
-    _updateHashLocked = true;
-
-    // Iterate over all the custom selectors
-    HashTimerEntry *elt = nullptr;
-    for (auto iter = _hashForTimers.begin(); iter != _hashForTimers.end();) {
-        elt                    = iter->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused) {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < static_cast<int>(elt->timers.size()); ++(elt->timerIndex)) {
-                elt->currentTimer         = elt->timers.at(elt->timerIndex);
-                elt->currentTimerSalvaged = false;
-
-                elt->currentTimer->update(dt);
-
-                if (elt->currentTimerSalvaged) {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
+    _time += dt;
+
+    // interval timers scheduled since the last update start counting from now
+    while (!TimerWheel::isEmpty(_startingTimers)) {
+        auto *timer = static_cast<Timer *>(_startingTimers.next->data);
+        TimerWheel::unlink(&timer->_node);
+        timer->_elapsed       = 0;
+        timer->_timesExecuted = 0;
+        timer->_periodStart   = _time;
+        linkTimer(timer);
+    }
 
-                elt->currentTimer = nullptr;
-            }
+    // callbacks may unschedule any timer, which unlinks it from this list as well
+    TimerWheelNode dueTimers;
+    TimerWheel::initList(dueTimers);
+    TimerWheel::splice(_frameTimers, dueTimers);
+    _timerWheel.advance(toTick(_time), dueTimers);
+
+    while (!TimerWheel::isEmpty(dueTimers)) {
+        auto *timer = static_cast<Timer *>(dueTimers.next->data);
+        TimerWheel::unlink(&timer->_node);
+
+        const bool isFrameTimer = timer->_interval <= 0.F;
+        // the wheel rounds down to whole ticks
+        if (!isFrameTimer && timer->getNextDue() > _time) {
+            linkTimer(timer);
+            continue;
         }
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty()) {
-            ++iter;
-            removeHashElement(_currentTarget);
-            if (iter != _hashForTimers.end()) {
-                ++iter;
-            }
+        timer->addRef();
+        _currentTimer = timer;
+        if (isFrameTimer) {
+            timer->update(dt);
         } else {
-            ++iter;
+            timer->expire(_time);
+        }
+        _currentTimer = nullptr;
+        if (timer->_scheduled && !timer->_paused && !timer->_node.isLinked()) {
+            linkTimer(timer);
         }
+        timer->release();
     }
 
-    _updateHashLocked = false;
-    _currentTarget    = nullptr;
-
     //
     // Functions allocated from another thread
     //
@@ -33,6 +33,7 @@
 #include <mutex>
 
 #include "base/RefCounted.h"
+#include "base/TimerWheel.h"
 #include "base/std/container/set.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
@@ -73,6 +74,20 @@ protected:
     unsigned int _repeat        = 0; //0 = once, 1 is 2 x executed
     float        _delay         = 0.F;
     float        _interval      = 0.F;
+
+private:
+    friend class Scheduler;
+
+    // triggers a timer with an interval which is due at time, catching up on missed intervals
+    void   expire(double time);
+    double getNextDue() const;
+
+    // timers with an interval wait in the timer wheel of the scheduler, the others run every frame
+    TimerWheelNode _node;
+    double         _periodStart = 0.0;
+    double         _pausedAt    = 0.0;
+    bool           _scheduled   = false;
+    bool           _paused      = false;
 };
 
 class CC_DLL TimerTargetCallback final : public Timer {
@@ -270,30 +285,36 @@ public:
      */
     void removeAllFunctionsToBePerformedInCocosThread();
 
-    bool isCurrentTargetSalvaged() const { return _currentTargetSalvaged; };
+    /** Whether the timer being triggered has been unscheduled by its callback. */
+    bool isCurrentTargetSalvaged() const { return _currentTimer && !_currentTimer->_scheduled; };
 
 private:
     // Hash Element used for "selectors with interval"
     struct HashTimerEntry {
         ccstd::vector<Timer *> timers;
         void *                 target;
-        int                    timerIndex;
-        Timer *                currentTimer;
-        bool                   currentTimerSalvaged;
         bool                   paused;
     };
 
     void removeHashElement(struct HashTimerEntry *element);
     void removeUpdateFromHash(struct _listEntry *entry);
 
+    void linkTimer(Timer *timer);
+    void unlinkTimer(Timer *timer);
+    void setTimerInterval(Timer *timer, float interval);
+
     // update specific
 
     // Used for "selectors with interval"
     ccstd::unordered_map<void *, HashTimerEntry *> _hashForTimers;
-    struct HashTimerEntry *                        _currentTarget         = nullptr;
-    bool                                           _currentTargetSalvaged = false;
-    // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
-    bool _updateHashLocked = false;
+    Timer *                                        _currentTimer = nullptr;
+
+    // Only the timers which are due are touched by update, interval timers are sorted by the wheel,
+    // timers without an interval run every frame and new interval timers start counting at the next update.
+    TimerWheel     _timerWheel;
+    TimerWheelNode _frameTimers;
+    TimerWheelNode _startingTimers;
+    double         _time = 0.0;
 
     // Used for "perform Function"
     ccstd::vector<std::function<void()>> _functionsToPerform;
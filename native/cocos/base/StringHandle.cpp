@@ -32,4 +32,10 @@ StringHandle::StringHandle(IndexType handle, const char *str) noexcept
   _str(str) {
 }
 
+StringHandle::StringHandle(IndexType handle, const char *str, std::size_t hash) noexcept
+: IndexHandle(handle),
+  _str(str),
+  _hash(hash) {
+}
+
 } // namespace cc
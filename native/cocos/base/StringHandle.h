@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "IndexHandle.h"
 
 namespace cc {
@@ -33,10 +34,18 @@ class StringHandle final : public IndexHandle<uint32_t> {
 public:
     StringHandle() noexcept = default;
     explicit StringHandle(IndexType handle, const char *str) noexcept;
+    explicit StringHandle(IndexType handle, const char *str, std::size_t hash) noexcept;
     inline char const *str() const noexcept { return _str; }
+    // hash of the string content, computed once when the string is interned
+    inline std::size_t hash() const noexcept { return _hash; }
+
+    struct Hasher {
+        inline std::size_t operator()(StringHandle const &s) const noexcept { return s._hash; }
+    };
 
 private:
     char const *_str{nullptr};
+    std::size_t _hash{0};
 };
 
 } // namespace cc
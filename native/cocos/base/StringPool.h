@@ -77,6 +77,19 @@ private:
 
 using ThreadSafeStringPool = StringPool<true>;
 
+/**
+ * @en The process wide interning table, shared by pass phases, macro and attribute names.
+ * Handles returned by it stay valid until exit and carry their string and its hash,
+ * so they can be compared and used as integer keys without touching the table again.
+ * @zh 进程级的全局字符串驻留表，供 pass 的 phase、宏和属性名等共享。
+ * 返回的句柄在程序退出前一直有效，并自带字符串与其哈希值，比较和作为整数键使用时无需再访问此表。
+ */
+CC_DLL ThreadSafeStringPool &getGlobalStringPool();
+
+inline StringHandle internString(const char *str) noexcept {
+    return getGlobalStringPool().stringToHandle(str);
+}
+
 template <bool ThreadSafe>
 StringPool<ThreadSafe>::~StringPool() {
     for (char const *strCache : _handleToStrings) {
@@ -87,6 +100,11 @@ StringPool<ThreadSafe>::~StringPool() {
 template <bool ThreadSafe>
 inline StringHandle StringPool<ThreadSafe>::stringToHandle(const char *str) noexcept {
     if (ThreadSafe) {
+        // most strings are interned already, only take the exclusive lock when a new one has to be added
+        StringHandle const name = find(str);
+        if (name.isValid()) {
+            return name;
+        }
         return _readWriteLock.lockWrite([this, str]() {
             return doStringToHandle(str);
         });
@@ -122,7 +140,7 @@ inline StringHandle StringPool<ThreadSafe>::doStringToHandle(const char *str) no
         size_t const strLength = strlen(str) + 1;
         char *const  strCache  = new char[strLength];
         strcpy(strCache, str);
-        StringHandle name(static_cast<StringHandle::IndexType>(_handleToStrings.size()), strCache);
+        StringHandle name(static_cast<StringHandle::IndexType>(_handleToStrings.size()), strCache, StringHasher{}(strCache));
         _handleToStrings.emplace_back(strCache);
         _stringToHandles.emplace(strCache, name);
         return name;
@@ -27,6 +27,7 @@
 #include "base/ThreadPool.h"
 #include <chrono>
 #include <memory>
+#include "base/threading/ThreadAffinity.h"
 #include "platform/StdC.h"
 
 #ifdef __ANDROID__
@@ -338,6 +339,8 @@ void LegacyThreadPool::setThread(int tid) {
     std::shared_ptr<std::atomic<bool>> abortPtr(
         _abortFlags[tid]); // a copy of the shared ptr to the flag
     auto f = [this, tid, abortPtr /* a copy of the shared ptr to the abort */]() {
+        // audio decoding, downloads and unzipping, none of it is frame critical
+        ThreadAffinity::setCurrentThread("LegacyThreadPool", ThreadQoS::BACKGROUND);
         std::atomic<bool> &abort = *abortPtr;
         Task               task;
         bool               isPop = _taskQueue.pop(task);
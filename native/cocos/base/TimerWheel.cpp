@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/TimerWheel.h"
+#include <algorithm>
+
+namespace cc {
+
+TimerWheel::TimerWheel() {
+    for (auto &slot : _root) {
+        initList(slot);
+    }
+    for (auto &level : _levels) {
+        for (auto &slot : level) {
+            initList(slot);
+        }
+    }
+}
+
+void TimerWheel::add(TimerWheelNode *node, uint64_t expireTick) {
+    node->expireTick     = expireTick;
+    const uint64_t delta = std::min(std::max(expireTick, _nextTick) - _nextTick, MAX_DELTA);
+    const uint64_t tick  = _nextTick + delta;
+    if (delta < ROOT_SIZE) {
+        pushBack(_root[tick & ROOT_MASK], node);
+        return;
+    }
+
+    uint32_t level = 0;
+    while (delta >= (uint64_t{1} << (ROOT_BITS + (level + 1) * LEVEL_BITS))) {
+        ++level;
+    }
+    pushBack(_levels[level][(tick >> (ROOT_BITS + level * LEVEL_BITS)) & LEVEL_MASK], node);
+}
+
+void TimerWheel::advance(uint64_t tick, TimerWheelNode &expired) {
+    while (_nextTick <= tick) {
+        const auto index = static_cast<uint32_t>(_nextTick & ROOT_MASK);
+        // a new round of the root wheel pulls the next slot of each coarser level down, as far as that level wraps too
+        if (index == 0) {
+            for (uint32_t level = 0; level < LEVEL_COUNT && cascade(level) == 0; ++level) {
+            }
+        }
+        ++_nextTick;
+        splice(_root[index], expired);
+    }
+}
+
+uint32_t TimerWheel::cascade(uint32_t level) {
+    const auto     index = static_cast<uint32_t>((_nextTick >> (ROOT_BITS + level * LEVEL_BITS)) & LEVEL_MASK);
+    TimerWheelNode nodes;
+    initList(nodes);
+    splice(_levels[level][index], nodes);
+    while (!isEmpty(nodes)) {
+        TimerWheelNode *node = nodes.next;
+        unlink(node);
+        add(node, node->expireTick);
+    }
+    return index;
+}
+
+void TimerWheel::initList(TimerWheelNode &list) {
+    list.prev = &list;
+    list.next = &list;
+}
+
+void TimerWheel::pushBack(TimerWheelNode &list, TimerWheelNode *node) {
+    node->prev      = list.prev;
+    node->next      = &list;
+    list.prev->next = node;
+    list.prev       = node;
+}
+
+void TimerWheel::unlink(TimerWheelNode *node) {
+    if (!node->isLinked()) return;
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev       = nullptr;
+    node->next       = nullptr;
+}
+
+void TimerWheel::splice(TimerWheelNode &from, TimerWheelNode &to) {
+    if (isEmpty(from)) return;
+    from.next->prev = to.prev;
+    to.prev->next   = from.next;
+    from.prev->next = &to;
+    to.prev         = from.prev;
+    initList(from);
+}
+
+} // namespace cc
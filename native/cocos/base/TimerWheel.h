@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+
+namespace cc {
+
+/**
+ * Intrusive link of an element in a TimerWheel. A node is in at most one list at a time,
+ * lists are circular with a sentinel node as head.
+ */
+struct TimerWheelNode {
+    TimerWheelNode *prev{nullptr};
+    TimerWheelNode *next{nullptr};
+    void *          data{nullptr};
+    uint64_t        expireTick{0};
+
+    inline bool isLinked() const { return next != nullptr; }
+};
+
+/**
+ * Hierarchical timer wheel, one root wheel of single ticks and coarser levels which are cascaded
+ * down as the root wheel wraps. Adding and removing a node is O(1), advancing only touches the
+ * slots passed and the nodes that expire or cascade.
+ */
+class TimerWheel final {
+public:
+    TimerWheel();
+    ~TimerWheel() = default;
+
+    // a tick which is already passed expires with the next advance
+    void add(TimerWheelNode *node, uint64_t expireTick);
+    // moves the nodes expiring up to and including tick to the end of the expired list
+    void advance(uint64_t tick, TimerWheelNode &expired);
+
+    // the first tick the next advance processes
+    inline uint64_t getNextTick() const { return _nextTick; }
+
+    static void        initList(TimerWheelNode &list);
+    static inline bool isEmpty(const TimerWheelNode &list) { return list.next == &list; }
+    static void        pushBack(TimerWheelNode &list, TimerWheelNode *node);
+    static void        unlink(TimerWheelNode *node);
+    // appends all nodes of from to to, from is empty afterwards
+    static void        splice(TimerWheelNode &from, TimerWheelNode &to);
+
+private:
+    static constexpr uint32_t ROOT_BITS   = 8;
+    static constexpr uint32_t ROOT_SIZE   = 1U << ROOT_BITS;
+    static constexpr uint32_t ROOT_MASK   = ROOT_SIZE - 1;
+    static constexpr uint32_t LEVEL_BITS  = 6;
+    static constexpr uint32_t LEVEL_SIZE  = 1U << LEVEL_BITS;
+    static constexpr uint32_t LEVEL_MASK  = LEVEL_SIZE - 1;
+    static constexpr uint32_t LEVEL_COUNT = 4;
+    // farther ticks are parked in the last level and cascaded again until they are in range
+    static constexpr uint64_t MAX_DELTA = (uint64_t{1} << (ROOT_BITS + LEVEL_COUNT * LEVEL_BITS)) - 1;
+
+    uint32_t cascade(uint32_t level);
+
+    TimerWheelNode _root[ROOT_SIZE];
+    TimerWheelNode _levels[LEVEL_COUNT][LEVEL_SIZE];
+    uint64_t       _nextTick{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TimerWheel);
+};
+
+} // namespace cc
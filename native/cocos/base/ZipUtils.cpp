@@ -41,8 +41,20 @@
 #include "unzip/ioapi_mem.h"
 
 #include <zlib.h>
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if CC_USE_LZ4
+    #include "lz4/lz4.h"
+    #include "lz4/lz4frame.h"
+#endif
+
+#if CC_USE_ZSTD
+    #include "zstd/zstd.h"
+#endif
 
 #include "base/Data.h"
 #include "base/Locked.h"
@@ -57,6 +69,65 @@
 
 namespace cc {
 
+namespace {
+
+bool isSupportedCCZCompression(unsigned int type) {
+    switch (type) {
+        case CCZ_COMPRESSION_ZLIB:
+        case CCZ_COMPRESSION_NONE:
+#if CC_USE_LZ4
+        case CCZ_COMPRESSION_LZ4:
+#endif
+#if CC_USE_ZSTD
+        case CCZ_COMPRESSION_ZSTD:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+#if CC_USE_ZSTD
+// dictionaries are shared read only between decoders, a decoder keeps the one it uses alive
+std::mutex                                                  zstdDictionariesMutex;
+ccstd::unordered_map<uint32_t, std::shared_ptr<ZSTD_DDict>> zstdDictionaries;
+
+std::shared_ptr<ZSTD_DDict> findZstdDictionary(uint32_t id) {
+    std::lock_guard<std::mutex> lock(zstdDictionariesMutex);
+    auto                        iter = zstdDictionaries.find(id);
+    return iter != zstdDictionaries.end() ? iter->second : nullptr;
+}
+
+bool decompressZstdFrame(const unsigned char *src, size_t srcLength, unsigned char *dst, size_t dstLength) {
+    // a context per thread avoids reallocating the decoder state for every small asset
+    thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    if (!context) {
+        return false;
+    }
+
+    size_t         ret          = 0;
+    const uint32_t dictionaryId = ZSTD_getDictID_fromFrame(src, srcLength);
+    if (dictionaryId != 0) {
+        auto dictionary = findZstdDictionary(dictionaryId);
+        if (!dictionary) {
+            CC_LOG_ERROR("zstd dictionary %u isn't registered", dictionaryId);
+            return false;
+        }
+        ret = ZSTD_decompress_usingDDict(context.get(), dst, dstLength, src, srcLength, dictionary.get());
+    } else {
+        ret = ZSTD_decompressDCtx(context.get(), dst, dstLength, src, srcLength);
+    }
+
+    if (ZSTD_isError(ret)) {
+        CC_LOG_DEBUG("zstd: %s", ZSTD_getErrorName(ret));
+        return false;
+    }
+    return ret == dstLength;
+}
+#endif
+
+} // namespace
+
 unsigned int ZipUtils::encryptedPvrKeyParts[4] = {0, 0, 0, 0};
 unsigned int ZipUtils::encryptionKey[1024];
 bool         ZipUtils::encryptionKeyIsValid = false;
@@ -349,7 +420,7 @@ int ZipUtils::inflateCCZBuffer(const unsigned char *buffer, ssize_t bufferLen, u
         }
 
         // verify compression format
-        if (CC_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB) {
+        if (!isSupportedCCZCompression(CC_SWAP_INT16_BIG_TO_HOST(header->compression_type))) {
             CC_LOG_DEBUG("CCZ Unsupported compression method");
             return -1;
         }
@@ -365,7 +436,7 @@ int ZipUtils::inflateCCZBuffer(const unsigned char *buffer, ssize_t bufferLen, u
         }
 
         // verify compression format
-        if (CC_SWAP_INT16_BIG_TO_HOST(header->compression_type) != CCZ_COMPRESSION_ZLIB) {
+        if (!isSupportedCCZCompression(CC_SWAP_INT16_BIG_TO_HOST(header->compression_type))) {
             CC_LOG_DEBUG("CCZ Unsupported compression method");
             return -1;
         }
@@ -398,11 +469,35 @@ int ZipUtils::inflateCCZBuffer(const unsigned char *buffer, ssize_t bufferLen, u
         return -1;
     }
 
-    uLongf      destlen = len;
-    const auto *source  = reinterpret_cast<const Bytef *>(buffer + sizeof(*header));
-    int         ret     = uncompress(*out, &destlen, source, static_cast<uLong>(bufferLen - sizeof(*header)));
+    const unsigned char *source       = buffer + sizeof(*header);
+    const auto           sourceLength = static_cast<size_t>(bufferLen - sizeof(*header));
+    bool                 succeed      = false;
+    switch (CC_SWAP_INT16_BIG_TO_HOST(header->compression_type)) {
+        case CCZ_COMPRESSION_ZLIB: {
+            uLongf destlen = len;
+            succeed        = uncompress(*out, &destlen, source, static_cast<uLong>(sourceLength)) == Z_OK;
+        } break;
+        case CCZ_COMPRESSION_NONE:
+            succeed = sourceLength >= len;
+            if (succeed) {
+                memcpy(*out, source, len);
+            }
+            break;
+#if CC_USE_LZ4
+        case CCZ_COMPRESSION_LZ4:
+            succeed = LZ4_decompress_safe(reinterpret_cast<const char *>(source), reinterpret_cast<char *>(*out), static_cast<int>(sourceLength), static_cast<int>(len)) == static_cast<int>(len);
+            break;
+#endif
+#if CC_USE_ZSTD
+        case CCZ_COMPRESSION_ZSTD:
+            succeed = decompressZstdFrame(source, sourceLength, *out, len);
+            break;
+#endif
+        default:
+            break;
+    }
 
-    if (ret != Z_OK) {
+    if (!succeed) {
         CC_LOG_DEBUG("CCZ: Failed to uncompress data");
         free(*out);
         *out = nullptr;
@@ -443,6 +538,214 @@ void ZipUtils::setPvrEncryptionKey(unsigned int keyPart1, unsigned int keyPart2,
     setPvrEncryptionKeyPart(3, keyPart4);
 }
 
+uint32_t ZipUtils::registerZstdDictionary(const unsigned char *dict, ssize_t len) {
+#if CC_USE_ZSTD
+    if (!dict || len <= 0) {
+        return 0;
+    }
+
+    std::shared_ptr<ZSTD_DDict> dictionary(ZSTD_createDDict(dict, static_cast<size_t>(len)), ZSTD_freeDDict);
+    const uint32_t              id = dictionary ? ZSTD_getDictID_fromDDict(dictionary.get()) : 0;
+    // raw content dictionaries have no id and can't be matched to frames
+    if (id == 0) {
+        CC_LOG_ERROR("Invalid zstd dictionary");
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(zstdDictionariesMutex);
+    zstdDictionaries[id] = std::move(dictionary);
+    return id;
+#else
+    CC_UNUSED_PARAM(dict);
+    CC_UNUSED_PARAM(len);
+    CC_LOG_ERROR("zstd is disabled, enable USE_ZSTD to register dictionaries");
+    return 0;
+#endif
+}
+
+void ZipUtils::unregisterZstdDictionary(uint32_t id) {
+#if CC_USE_ZSTD
+    std::lock_guard<std::mutex> lock(zstdDictionariesMutex);
+    zstdDictionaries.erase(id);
+#else
+    CC_UNUSED_PARAM(id);
+#endif
+}
+
+// --------------------- StreamDecompressor ---------------------
+
+namespace {
+// decoded bytes are appended in chunks of this size, close to the block size of both formats
+constexpr size_t STREAM_OUTPUT_CHUNK_SIZE = 128 * 1024;
+} // namespace
+
+bool StreamDecompressor::isCodecAvailable(Codec codec) {
+    switch (codec) {
+#if CC_USE_LZ4
+        case Codec::LZ4:
+            return true;
+#endif
+#if CC_USE_ZSTD
+        case Codec::ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+StreamDecompressor::StreamDecompressor(Codec codec, uint32_t dictionaryId)
+: _dictionaryId(dictionaryId), _codec(codec) {
+    if (codec == Codec::LZ4) {
+#if CC_USE_LZ4
+        LZ4F_dctx *context = nullptr;
+        if (!LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION))) {
+            _context = context;
+        }
+#endif
+    } else if (codec == Codec::ZSTD) {
+#if CC_USE_ZSTD
+        _context = ZSTD_createDCtx();
+        if (_context && dictionaryId != 0) {
+            _dictionary = findZstdDictionary(dictionaryId);
+            if (!_dictionary) {
+                CC_LOG_ERROR("zstd dictionary %u isn't registered", dictionaryId);
+            }
+        }
+#endif
+    }
+
+    if (!_context) {
+        CC_LOG_ERROR("StreamDecompressor: codec %d isn't available", static_cast<int>(codec));
+        _status = Status::FAILED;
+    }
+}
+
+StreamDecompressor::~StreamDecompressor() {
+    if (!_context) {
+        return;
+    }
+#if CC_USE_LZ4
+    if (_codec == Codec::LZ4) {
+        LZ4F_freeDecompressionContext(static_cast<LZ4F_dctx *>(_context));
+    }
+#endif
+#if CC_USE_ZSTD
+    if (_codec == Codec::ZSTD) {
+        ZSTD_freeDCtx(static_cast<ZSTD_DCtx *>(_context));
+    }
+#endif
+}
+
+void StreamDecompressor::reset() {
+    if (!_context) {
+        return;
+    }
+#if CC_USE_LZ4
+    if (_codec == Codec::LZ4) {
+        LZ4F_resetDecompressionContext(static_cast<LZ4F_dctx *>(_context));
+    }
+#endif
+#if CC_USE_ZSTD
+    if (_codec == Codec::ZSTD) {
+        ZSTD_DCtx_reset(static_cast<ZSTD_DCtx *>(_context), ZSTD_reset_session_only);
+    }
+#endif
+    _status  = Status::NEED_MORE_INPUT;
+    _started = false;
+}
+
+StreamDecompressor::Status StreamDecompressor::decompress(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out) {
+    if (_status != Status::NEED_MORE_INPUT) {
+        return _status;
+    }
+    if (inLength == 0) {
+        return _status;
+    }
+
+    _status  = _codec == Codec::LZ4 ? decompressLZ4(in, inLength, out) : decompressZstd(in, inLength, out);
+    _started = true;
+    return _status;
+}
+
+StreamDecompressor::Status StreamDecompressor::decompressLZ4(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out) {
+#if CC_USE_LZ4
+    auto * context = static_cast<LZ4F_dctx *>(_context);
+    size_t pos     = 0;
+    while (true) {
+        const size_t offset = out->size();
+        out->resize(offset + STREAM_OUTPUT_CHUNK_SIZE);
+        size_t dstSize = STREAM_OUTPUT_CHUNK_SIZE;
+        size_t srcSize = inLength - pos;
+        size_t ret     = LZ4F_decompress(context, out->data() + offset, &dstSize, in + pos, &srcSize, nullptr);
+        out->resize(offset + dstSize);
+        pos += srcSize;
+
+        if (LZ4F_isError(ret)) {
+            CC_LOG_DEBUG("lz4: %s", LZ4F_getErrorName(ret));
+            return Status::FAILED;
+        }
+        if (ret == 0) {
+            return Status::FINISHED;
+        }
+        // a full output chunk may leave decoded bytes buffered in the context
+        if (pos == inLength && dstSize < STREAM_OUTPUT_CHUNK_SIZE) {
+            return Status::NEED_MORE_INPUT;
+        }
+    }
+#else
+    CC_UNUSED_PARAM(in);
+    CC_UNUSED_PARAM(inLength);
+    CC_UNUSED_PARAM(out);
+    return Status::FAILED;
+#endif
+}
+
+StreamDecompressor::Status StreamDecompressor::decompressZstd(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out) {
+#if CC_USE_ZSTD
+    auto *context = static_cast<ZSTD_DCtx *>(_context);
+    if (!_started) {
+        const uint32_t frameDictionaryId = ZSTD_getDictID_fromFrame(in, inLength);
+        if (!_dictionary && frameDictionaryId != 0) {
+            _dictionary = findZstdDictionary(frameDictionaryId);
+        }
+        if (frameDictionaryId != 0 || _dictionaryId != 0) {
+            if (!_dictionary) {
+                CC_LOG_ERROR("zstd dictionary %u isn't registered", frameDictionaryId != 0 ? frameDictionaryId : _dictionaryId);
+                return Status::FAILED;
+            }
+            ZSTD_DCtx_refDDict(context, static_cast<const ZSTD_DDict *>(_dictionary.get()));
+        }
+    }
+
+    ZSTD_inBuffer input{in, inLength, 0};
+    while (true) {
+        const size_t offset = out->size();
+        out->resize(offset + STREAM_OUTPUT_CHUNK_SIZE);
+        ZSTD_outBuffer output{out->data() + offset, STREAM_OUTPUT_CHUNK_SIZE, 0};
+        size_t         ret = ZSTD_decompressStream(context, &output, &input);
+        out->resize(offset + output.pos);
+
+        if (ZSTD_isError(ret)) {
+            CC_LOG_DEBUG("zstd: %s", ZSTD_getErrorName(ret));
+            return Status::FAILED;
+        }
+        if (ret == 0) {
+            return Status::FINISHED;
+        }
+        // a full output chunk may leave decoded bytes buffered in the context
+        if (input.pos == input.size && output.pos < output.size) {
+            return Status::NEED_MORE_INPUT;
+        }
+    }
+#else
+    CC_UNUSED_PARAM(in);
+    CC_UNUSED_PARAM(inLength);
+    CC_UNUSED_PARAM(out);
+    return Status::FAILED;
+#endif
+}
+
 // --------------------- ZipFile ---------------------
 // from unzip.cpp
 #define UNZ_MAXFILENAMEINZIP 256
@@ -658,4 +961,326 @@ bool ZipFile::initWithBuffer(const void *buffer, uint32_t size) {
     return true;
 }
 
+// --------------------- ZipArchive ---------------------
+
+namespace {
+
+constexpr uint32_t ZIP_LOCAL_HEADER_SIGNATURE   = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t ZIP_END_SIGNATURE            = 0x06054b50;
+constexpr uint32_t ZIP64_END_SIGNATURE          = 0x06064b50;
+constexpr uint32_t ZIP64_LOCATOR_SIGNATURE      = 0x07064b50;
+constexpr uint16_t ZIP64_EXTRA_FIELD_ID         = 0x0001;
+constexpr uint16_t ZIP_METHOD_STORED            = 0;
+constexpr uint16_t ZIP_METHOD_DEFLATED          = 8;
+constexpr uint16_t ZIP_FLAG_ENCRYPTED           = 0x0001;
+
+constexpr uint32_t ZIP_LOCAL_HEADER_SIZE   = 30;
+constexpr uint32_t ZIP_CENTRAL_HEADER_SIZE = 46;
+constexpr uint32_t ZIP_END_SIZE            = 22;
+constexpr uint32_t ZIP64_END_SIZE          = 56;
+constexpr uint32_t ZIP64_LOCATOR_SIZE      = 20;
+constexpr uint32_t ZIP_MAX_COMMENT_SIZE    = 0xFFFF;
+
+inline uint16_t readU16(const unsigned char *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t readU32(const unsigned char *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t readU64(const unsigned char *p) {
+    return static_cast<uint64_t>(readU32(p)) | (static_cast<uint64_t>(readU32(p + 4)) << 32);
+}
+
+std::mutex                                                        archivesMutex;
+ccstd::unordered_map<ccstd::string, std::shared_ptr<ZipArchive>> archives;
+
+} // namespace
+
+std::shared_ptr<ZipArchive> ZipArchive::open(const ccstd::string &zipFile) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils || zipFile.empty()) {
+        return nullptr;
+    }
+
+    auto mapping = std::make_shared<MappedFile>(fileUtils->mapFile(zipFile));
+    if (mapping->isNull()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ZipArchive> archive(new (std::nothrow) ZipArchive());
+    if (!archive) {
+        return nullptr;
+    }
+    archive->_mapping = std::move(mapping);
+    if (!archive->parseCentralDirectory()) {
+        CC_LOG_ERROR("ZipArchive: %s isn't a valid zip archive", zipFile.c_str());
+        return nullptr;
+    }
+    return archive;
+}
+
+std::shared_ptr<ZipArchive> ZipArchive::createWithBuffer(const void *buffer, uint32_t size) {
+    if (!buffer || size == 0) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ZipArchive> archive(new (std::nothrow) ZipArchive());
+    if (!archive) {
+        return nullptr;
+    }
+    archive->_mapping = std::make_shared<MappedFile>(static_cast<const unsigned char *>(buffer), size, nullptr, nullptr);
+    if (!archive->parseCentralDirectory()) {
+        return nullptr;
+    }
+    return archive;
+}
+
+std::shared_ptr<ZipArchive> ZipArchive::getArchive(const ccstd::string &zipFile) {
+    std::lock_guard<std::mutex> lock(archivesMutex);
+    auto                        iter = archives.find(zipFile);
+    if (iter != archives.end()) {
+        return iter->second;
+    }
+
+    auto archive = open(zipFile);
+    if (archive) {
+        archives.emplace(zipFile, archive);
+    }
+    return archive;
+}
+
+void ZipArchive::purgeArchives() {
+    std::lock_guard<std::mutex> lock(archivesMutex);
+    archives.clear();
+}
+
+bool ZipArchive::parseCentralDirectory() {
+    const unsigned char *bytes = _mapping->getBytes();
+    const uint64_t       size  = _mapping->getSize();
+    if (size < ZIP_END_SIZE) {
+        return false;
+    }
+
+    // the end of central directory record is followed by a comment of up to 64k
+    uint64_t endOffset = size - ZIP_END_SIZE;
+    uint64_t minOffset = endOffset > ZIP_MAX_COMMENT_SIZE ? endOffset - ZIP_MAX_COMMENT_SIZE : 0;
+    while (readU32(bytes + endOffset) != ZIP_END_SIGNATURE) {
+        if (endOffset == minOffset) {
+            return false;
+        }
+        --endOffset;
+    }
+
+    const unsigned char *end        = bytes + endOffset;
+    uint64_t             entryCount = readU16(end + 10);
+    uint64_t             cdSize     = readU32(end + 12);
+    uint64_t             cdOffset   = readU32(end + 16);
+
+    if (entryCount == 0xFFFF || cdSize == 0xFFFFFFFF || cdOffset == 0xFFFFFFFF) {
+        if (endOffset < ZIP64_LOCATOR_SIZE || readU32(end - ZIP64_LOCATOR_SIZE) != ZIP64_LOCATOR_SIGNATURE) {
+            return false;
+        }
+        const uint64_t zip64EndOffset = readU64(end - ZIP64_LOCATOR_SIZE + 8);
+        if (zip64EndOffset + ZIP64_END_SIZE > size || readU32(bytes + zip64EndOffset) != ZIP64_END_SIGNATURE) {
+            return false;
+        }
+        const unsigned char *zip64End = bytes + zip64EndOffset;
+        entryCount                    = readU64(zip64End + 32);
+        cdSize                        = readU64(zip64End + 40);
+        cdOffset                      = readU64(zip64End + 48);
+    }
+
+    if (cdOffset > size || cdSize > size - cdOffset) {
+        return false;
+    }
+
+    _entries.clear();
+    _entries.reserve(static_cast<size_t>(entryCount));
+
+    const unsigned char *p     = bytes + cdOffset;
+    const unsigned char *cdEnd = p + cdSize;
+    for (uint64_t i = 0; i < entryCount; ++i) {
+        if (cdEnd - p < ZIP_CENTRAL_HEADER_SIZE || readU32(p) != ZIP_CENTRAL_HEADER_SIGNATURE) {
+            return false;
+        }
+
+        const uint16_t flags         = readU16(p + 8);
+        const uint16_t method        = readU16(p + 10);
+        const uint16_t nameLength    = readU16(p + 28);
+        const uint16_t extraLength   = readU16(p + 30);
+        const uint16_t commentLength = readU16(p + 32);
+        const uint64_t recordSize    = ZIP_CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+        if (static_cast<uint64_t>(cdEnd - p) < recordSize) {
+            return false;
+        }
+
+        Entry entry;
+        entry.method            = method;
+        entry.compressedSize    = readU32(p + 20);
+        entry.uncompressedSize  = readU32(p + 24);
+        entry.localHeaderOffset = readU32(p + 42);
+
+        // 64 bit values are stored in the extra field only for the fields that overflowed, in this order
+        const unsigned char *extra    = p + ZIP_CENTRAL_HEADER_SIZE + nameLength;
+        const unsigned char *extraEnd = extra + extraLength;
+        while (extraEnd - extra >= 4) {
+            const uint16_t       id        = readU16(extra);
+            const uint16_t       fieldSize = readU16(extra + 2);
+            const unsigned char *field     = extra + 4;
+            const unsigned char *fieldEnd  = field + fieldSize;
+            if (fieldEnd > extraEnd) {
+                break;
+            }
+            if (id == ZIP64_EXTRA_FIELD_ID) {
+                if (entry.uncompressedSize == 0xFFFFFFFF && fieldEnd - field >= 8) {
+                    entry.uncompressedSize = readU64(field);
+                    field += 8;
+                }
+                if (entry.compressedSize == 0xFFFFFFFF && fieldEnd - field >= 8) {
+                    entry.compressedSize = readU64(field);
+                    field += 8;
+                }
+                if (entry.localHeaderOffset == 0xFFFFFFFF && fieldEnd - field >= 8) {
+                    entry.localHeaderOffset = readU64(field);
+                }
+                break;
+            }
+            extra = fieldEnd;
+        }
+
+        ccstd::string name(reinterpret_cast<const char *>(p + ZIP_CENTRAL_HEADER_SIZE), nameLength);
+        const bool    isDirectory = !name.empty() && name.back() == '/';
+        const bool    isSupported = !(flags & ZIP_FLAG_ENCRYPTED) && (method == ZIP_METHOD_STORED || method == ZIP_METHOD_DEFLATED);
+        if (!isDirectory && isSupported) {
+            _entries.emplace(std::move(name), entry);
+        }
+        p += recordSize;
+    }
+
+    return true;
+}
+
+const ZipArchive::Entry *ZipArchive::findEntry(const ccstd::string &fileName) const {
+    auto iter = _entries.find(fileName);
+    return iter != _entries.end() ? &iter->second : nullptr;
+}
+
+const unsigned char *ZipArchive::getEntryData(const Entry &entry) const {
+    // the local header is resolved lazily, touching every header while indexing would fault in the whole archive
+    const unsigned char *bytes = _mapping->getBytes();
+    const uint64_t       size  = _mapping->getSize();
+    if (entry.localHeaderOffset > size || size - entry.localHeaderOffset < ZIP_LOCAL_HEADER_SIZE) {
+        return nullptr;
+    }
+
+    const unsigned char *header = bytes + entry.localHeaderOffset;
+    if (readU32(header) != ZIP_LOCAL_HEADER_SIGNATURE) {
+        return nullptr;
+    }
+
+    const uint64_t dataOffset = entry.localHeaderOffset + ZIP_LOCAL_HEADER_SIZE + readU16(header + 26) + readU16(header + 28);
+    if (dataOffset > size || size - dataOffset < entry.compressedSize) {
+        return nullptr;
+    }
+    return bytes + dataOffset;
+}
+
+bool ZipArchive::inflateEntry(const Entry &entry, unsigned char *dst) const {
+    const unsigned char *src = getEntryData(entry);
+    if (!src) {
+        return false;
+    }
+
+    if (entry.method == ZIP_METHOD_STORED) {
+        if (entry.compressedSize != entry.uncompressedSize) {
+            return false;
+        }
+        memcpy(dst, src, static_cast<size_t>(entry.uncompressedSize));
+        return true;
+    }
+
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+
+    // zlib counts in uInt, feed large entries in chunks
+    constexpr uint64_t CHUNK_SIZE = 0x40000000;
+    uint64_t           inLeft     = entry.compressedSize;
+    uint64_t           outLeft    = entry.uncompressedSize;
+    stream.next_in                = const_cast<Bytef *>(src);
+    stream.next_out               = dst;
+
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        if (stream.avail_in == 0 && inLeft > 0) {
+            stream.avail_in = static_cast<uInt>(std::min(inLeft, CHUNK_SIZE));
+            inLeft -= stream.avail_in;
+        }
+        if (stream.avail_out == 0 && outLeft > 0) {
+            stream.avail_out = static_cast<uInt>(std::min(outLeft, CHUNK_SIZE));
+            outLeft -= stream.avail_out;
+        }
+        ret = inflate(&stream, Z_NO_FLUSH);
+    }
+
+    const bool succeed = ret == Z_STREAM_END && stream.avail_out == 0 && outLeft == 0;
+    inflateEnd(&stream);
+    return succeed;
+}
+
+bool ZipArchive::fileExists(const ccstd::string &fileName) const {
+    return findEntry(fileName) != nullptr;
+}
+
+int64_t ZipArchive::getFileSize(const ccstd::string &fileName) const {
+    const Entry *entry = findEntry(fileName);
+    return entry ? static_cast<int64_t>(entry->uncompressedSize) : -1;
+}
+
+bool ZipArchive::getFileData(const ccstd::string &fileName, ResizableBuffer *buffer) const {
+    const Entry *entry = findEntry(fileName);
+    if (!entry || entry->uncompressedSize > static_cast<uint64_t>(std::numeric_limits<size_t>::max())) {
+        return false;
+    }
+
+    buffer->resize(static_cast<size_t>(entry->uncompressedSize));
+    if (entry->uncompressedSize == 0) {
+        return getEntryData(*entry) != nullptr;
+    }
+    if (!inflateEntry(*entry, static_cast<unsigned char *>(buffer->buffer()))) {
+        buffer->resize(0);
+        return false;
+    }
+    return true;
+}
+
+MappedFile ZipArchive::mapFileData(const ccstd::string &fileName) const {
+    const Entry *entry = findEntry(fileName);
+    if (!entry) {
+        return {};
+    }
+
+    if (entry->method == ZIP_METHOD_STORED && entry->compressedSize == entry->uncompressedSize) {
+        const unsigned char *bytes = getEntryData(*entry);
+        if (!bytes) {
+            return {};
+        }
+        // the view holds a reference to the archive mapping
+        return MappedFile(bytes, static_cast<size_t>(entry->uncompressedSize), new std::shared_ptr<MappedFile>(_mapping), [](void *handle, const unsigned char * /*bytes*/, size_t /*size*/) {
+            delete static_cast<std::shared_ptr<MappedFile> *>(handle);
+        });
+    }
+
+    Data                         data;
+    ResizableBufferAdapter<Data> buffer(&data);
+    if (!getFileData(fileName, &buffer)) {
+        return {};
+    }
+    return MappedFile(std::move(data));
+}
+
 } // namespace cc
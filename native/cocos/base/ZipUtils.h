@@ -27,8 +27,11 @@
 
 #pragma once
 
+#include <memory>
 #include "base/Macros.h"
 #include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "platform/FileUtils.h"
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
@@ -55,7 +58,9 @@ enum {
     CCZ_COMPRESSION_ZLIB,  /** zlib format. */
     CCZ_COMPRESSION_BZIP2, /** bzip2 format (not supported yet). */
     CCZ_COMPRESSION_GZIP,  /** gzip format (not supported yet). */
-    CCZ_COMPRESSION_NONE,  /** plain (not supported yet). */
+    CCZ_COMPRESSION_NONE,  /** plain. */
+    CCZ_COMPRESSION_LZ4,   /** lz4 block format, requires USE_LZ4. */
+    CCZ_COMPRESSION_ZSTD,  /** zstd frame, optionally compressed with a registered dictionary, requires USE_ZSTD. */
 };
 
 class CC_DLL ZipUtils {
@@ -186,6 +191,20 @@ public:
          */
     static void setPvrEncryptionKey(unsigned int keyPart1, unsigned int keyPart2, unsigned int keyPart3, unsigned int keyPart4);
 
+    /**
+     * Registers a zstd dictionary, as produced by `zstd --train` over a set of small assets.
+     * Frames compressed with it are matched by their dictionary id, both in CCZ buffers
+     * and in StreamDecompressor. This function is thread safe.
+     *
+     * @return The id of the dictionary, 0 if it is invalid or zstd is disabled.
+     */
+    static uint32_t registerZstdDictionary(const unsigned char *dict, ssize_t len);
+
+    /**
+     * Releases a registered zstd dictionary, decoders already using it keep it alive until they finish.
+     */
+    static void unregisterZstdDictionary(uint32_t id);
+
 private:
     static int                 inflateMemoryWithHint(unsigned char *in, ssize_t inLength, unsigned char **out, ssize_t *outLength, ssize_t outLengthHint);
     static inline void         decodeEncodedPvr(unsigned int *data, ssize_t len);
@@ -196,6 +215,59 @@ private:
     static bool         encryptionKeyIsValid;
 };
 
+/**
+ * Incremental decoder for a single LZ4 or zstd frame. Compressed chunks can be fed as they arrive
+ * from a file or the network, decoded bytes are appended to the output as soon as they are available.
+ */
+class CC_DLL StreamDecompressor final {
+public:
+    enum class Codec : uint8_t {
+        LZ4,
+        ZSTD,
+    };
+
+    enum class Status : uint8_t {
+        NEED_MORE_INPUT,
+        FINISHED,
+        FAILED,
+    };
+
+    /** Whether the codec was compiled in, see USE_LZ4 and USE_ZSTD. */
+    static bool isCodecAvailable(Codec codec);
+
+    /**
+     * @param dictionaryId A dictionary registered with ZipUtils::registerZstdDictionary. When 0 the dictionary
+     *                     is picked from the frame header, which then has to be complete in the first chunk.
+     */
+    explicit StreamDecompressor(Codec codec, uint32_t dictionaryId = 0);
+    ~StreamDecompressor();
+    StreamDecompressor(const StreamDecompressor &) = delete;
+    StreamDecompressor &operator=(const StreamDecompressor &) = delete;
+
+    inline bool   isValid() const { return _context != nullptr; }
+    inline Status getStatus() const { return _status; }
+
+    /**
+     * Decodes a chunk of compressed data, the decoded bytes are appended to out.
+     * @return FINISHED once the end of the frame was decoded, bytes after it are ignored.
+     */
+    Status decompress(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out);
+
+    /** Prepares the decoder for a new frame. */
+    void reset();
+
+private:
+    Status decompressLZ4(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out);
+    Status decompressZstd(const unsigned char *in, size_t inLength, ccstd::vector<unsigned char> *out);
+
+    void *                _context{nullptr};
+    std::shared_ptr<void> _dictionary;
+    uint32_t              _dictionaryId{0};
+    Codec                 _codec{Codec::LZ4};
+    Status                _status{Status::NEED_MORE_INPUT};
+    bool                  _started{false};
+};
+
 // forward declaration
 class ZipFilePrivate;
 struct unz_file_info_s;
@@ -277,4 +349,71 @@ private:
     /** Internal data like zip file pointer / file list array and so on */
     ZipFilePrivate *_data{nullptr};
 };
+
+/**
+ * Read only zip archive, the central directory is parsed once into a hash index.
+ *
+ * The whole archive stays mapped while the object lives, so lookups never touch the file system
+ * and entries can be read from several threads at the same time. Stored (uncompressed) entries
+ * are served straight from the mapping, deflated entries are inflated into the caller's buffer.
+ * Unlike ZipFile there is no per-archive lock and no reopening of the file per read.
+ */
+class CC_DLL ZipArchive final {
+public:
+    /**
+     * Maps and indexes an archive.
+     * @return nullptr if the file can't be mapped or isn't a valid zip archive.
+     */
+    static std::shared_ptr<ZipArchive> open(const ccstd::string &zipFile);
+
+    /**
+     * Indexes an archive in memory, the buffer must outlive the archive and the views mapped from it.
+     */
+    static std::shared_ptr<ZipArchive> createWithBuffer(const void *buffer, uint32_t size);
+
+    /**
+     * Shared archive for a path, opened on first use and kept until purgeArchives.
+     * This function is thread safe.
+     */
+    static std::shared_ptr<ZipArchive> getArchive(const ccstd::string &zipFile);
+    static void                        purgeArchives();
+
+    bool fileExists(const ccstd::string &fileName) const;
+
+    /** Uncompressed size of an entry, -1 if it doesn't exist. */
+    int64_t getFileSize(const ccstd::string &fileName) const;
+
+    /**
+     * Reads an entry into buffer, safe to call from any thread.
+     * @return True if successful.
+     */
+    bool getFileData(const ccstd::string &fileName, ResizableBuffer *buffer) const;
+
+    /**
+     * Zero copy view of a stored entry, deflated entries are inflated into an owned buffer instead.
+     * The view keeps the archive mapping alive, so it may outlive the archive.
+     * @return A null MappedFile if the entry doesn't exist or can't be read.
+     */
+    MappedFile mapFileData(const ccstd::string &fileName) const;
+
+    inline uint32_t getEntryCount() const { return static_cast<uint32_t>(_entries.size()); }
+
+private:
+    struct Entry {
+        uint64_t localHeaderOffset{0};
+        uint64_t compressedSize{0};
+        uint64_t uncompressedSize{0};
+        uint16_t method{0};
+    };
+
+    ZipArchive() = default;
+
+    bool                 parseCentralDirectory();
+    const Entry *        findEntry(const ccstd::string &fileName) const;
+    const unsigned char *getEntryData(const Entry &entry) const;
+    bool                 inflateEntry(const Entry &entry, unsigned char *dst) const;
+
+    std::shared_ptr<MappedFile>                _mapping;
+    ccstd::unordered_map<ccstd::string, Entry> _entries;
+};
 } // end of namespace cc
@@ -72,3 +72,212 @@ etc2_uint32 etc2_pkm_get_height(const etc2_byte *pHeader) {
 etc2_uint32 etc2_pkm_get_format(const uint8_t *pHeader) {
     return readBEUint16(pHeader + ETC2_PKM_FORMAT_OFFSET);
 }
+
+//////////////////////////////////////////////////////////////////////////
+// software decoding, for devices which can't sample ETC textures
+
+static const int ETC_MODIFIER_TABLE[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+static const int ETC2_DISTANCE_TABLE[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+
+static const int EAC_MODIFIER_TABLE[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+static uint64_t readBEUint64(const etc2_byte *pIn) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value = (value << 8) | pIn[i];
+    }
+    return value;
+}
+
+static int clampByte(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static int extend4(uint64_t value) {
+    return static_cast<int>((value << 4) | value);
+}
+
+static int extend5(uint64_t value) {
+    return static_cast<int>((value << 3) | (value >> 2));
+}
+
+static int extend6(uint64_t value) {
+    return static_cast<int>((value << 2) | (value >> 4));
+}
+
+static int extend7(uint64_t value) {
+    return static_cast<int>((value << 1) | (value >> 6));
+}
+
+static int signExtend3(uint64_t value) {
+    return static_cast<int>(value & 3) - static_cast<int>(value & 4);
+}
+
+// pixels are indexed column major in a block, for the index bits and the alpha indices alike
+static etc2_uint32 getPixelIndex(uint64_t bits, int pixel) {
+    return static_cast<etc2_uint32>((((bits >> (16 + pixel)) & 1) << 1) | ((bits >> pixel) & 1));
+}
+
+// decodes a color block to 16 column major RGBA8 pixels, alpha set to 255
+static void decodeColorBlock(const etc2_byte *pIn, etc2_byte *pPixels) {
+    const uint64_t bits = readBEUint64(pIn);
+    int            paint[4][3];
+    bool           paintPerPixel = false;
+
+    if ((bits >> 33) & 1) {
+        const int r = static_cast<int>((bits >> 59) & 0x1F) + signExtend3(bits >> 56);
+        const int g = static_cast<int>((bits >> 51) & 0x1F) + signExtend3(bits >> 48);
+        const int b = static_cast<int>((bits >> 43) & 0x1F) + signExtend3(bits >> 40);
+
+        if (r < 0 || r > 31) {
+            // T mode
+            const int c1[3] = {extend4(((bits >> 57) & 0xC) | ((bits >> 56) & 0x3)), extend4((bits >> 52) & 0xF), extend4((bits >> 48) & 0xF)};
+            const int c2[3] = {extend4((bits >> 44) & 0xF), extend4((bits >> 40) & 0xF), extend4((bits >> 36) & 0xF)};
+            const int d     = ETC2_DISTANCE_TABLE[((bits >> 33) & 0x6) | ((bits >> 32) & 0x1)];
+            for (int c = 0; c < 3; ++c) {
+                paint[0][c] = c1[c];
+                paint[1][c] = clampByte(c2[c] + d);
+                paint[2][c] = c2[c];
+                paint[3][c] = clampByte(c2[c] - d);
+            }
+            paintPerPixel = true;
+        } else if (g < 0 || g > 31) {
+            // H mode
+            const int c1[3] = {extend4((bits >> 59) & 0xF),
+                               extend4(((bits >> 55) & 0xE) | ((bits >> 52) & 0x1)),
+                               extend4(((bits >> 48) & 0x8) | ((bits >> 47) & 0x6) | ((bits >> 47) & 0x1))};
+            const int c2[3] = {extend4((bits >> 43) & 0xF), extend4((bits >> 39) & 0xF), extend4((bits >> 35) & 0xF)};
+
+            etc2_uint32 distance = static_cast<etc2_uint32>(((bits >> 32) & 0x4) | ((bits >> 31) & 0x2));
+            if (((c1[0] << 16) | (c1[1] << 8) | c1[2]) >= ((c2[0] << 16) | (c2[1] << 8) | c2[2])) {
+                distance |= 1;
+            }
+            const int d = ETC2_DISTANCE_TABLE[distance];
+            for (int c = 0; c < 3; ++c) {
+                paint[0][c] = clampByte(c1[c] + d);
+                paint[1][c] = clampByte(c1[c] - d);
+                paint[2][c] = clampByte(c2[c] + d);
+                paint[3][c] = clampByte(c2[c] - d);
+            }
+            paintPerPixel = true;
+        } else if (b < 0 || b > 31) {
+            // planar mode, interpolates the origin, horizontal and vertical colors
+            const int o[3] = {extend6((bits >> 57) & 0x3F),
+                              extend7(((bits >> 50) & 0x40) | ((bits >> 49) & 0x3F)),
+                              extend6(((bits >> 43) & 0x20) | ((bits >> 40) & 0x18) | ((bits >> 39) & 0x7))};
+            const int h[3] = {extend6(((bits >> 33) & 0x3E) | ((bits >> 32) & 0x1)), extend7((bits >> 25) & 0x7F), extend6((bits >> 19) & 0x3F)};
+            const int v[3] = {extend6((bits >> 13) & 0x3F), extend7((bits >> 6) & 0x7F), extend6(bits & 0x3F)};
+            for (int x = 0; x < 4; ++x) {
+                for (int y = 0; y < 4; ++y) {
+                    etc2_byte *pixel = pPixels + (x * 4 + y) * 4;
+                    for (int c = 0; c < 3; ++c) {
+                        pixel[c] = static_cast<etc2_byte>(clampByte((x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2) >> 2));
+                    }
+                    pixel[3] = 255;
+                }
+            }
+            return;
+        } else {
+            // differential mode
+            const int base[2][3] = {
+                {extend5((bits >> 59) & 0x1F), extend5((bits >> 51) & 0x1F), extend5((bits >> 43) & 0x1F)},
+                {extend5(static_cast<uint64_t>(r)), extend5(static_cast<uint64_t>(g)), extend5(static_cast<uint64_t>(b))}};
+            for (int c = 0; c < 3; ++c) {
+                paint[0][c] = base[0][c];
+                paint[1][c] = base[1][c];
+            }
+        }
+    } else {
+        // individual mode
+        for (int c = 0; c < 3; ++c) {
+            paint[0][c] = extend4((bits >> (60 - c * 8)) & 0xF);
+            paint[1][c] = extend4((bits >> (56 - c * 8)) & 0xF);
+        }
+    }
+
+    if (paintPerPixel) {
+        // T and H modes pick one of the paint colors per pixel
+        for (int i = 0; i < 16; ++i) {
+            const int *color   = paint[getPixelIndex(bits, i)];
+            pPixels[i * 4 + 0] = static_cast<etc2_byte>(color[0]);
+            pPixels[i * 4 + 1] = static_cast<etc2_byte>(color[1]);
+            pPixels[i * 4 + 2] = static_cast<etc2_byte>(color[2]);
+            pPixels[i * 4 + 3] = 255;
+        }
+        return;
+    }
+
+    // individual and differential modes modulate the base color of the sub block
+    const int  tables[2] = {static_cast<int>((bits >> 37) & 0x7), static_cast<int>((bits >> 34) & 0x7)};
+    const bool flip      = (bits >> 32) & 1;
+    for (int i = 0; i < 16; ++i) {
+        const int         x        = i / 4;
+        const int         y        = i % 4;
+        const int         subBlock = flip ? (y >= 2) : (x >= 2);
+        const etc2_uint32 index    = getPixelIndex(bits, i);
+        const int         modifier = ETC_MODIFIER_TABLE[tables[subBlock]][index & 1] * ((index & 2) ? -1 : 1);
+        for (int c = 0; c < 3; ++c) {
+            pPixels[i * 4 + c] = static_cast<etc2_byte>(clampByte(paint[subBlock][c] + modifier));
+        }
+        pPixels[i * 4 + 3] = 255;
+    }
+}
+
+// decodes an EAC alpha block into the alpha channel of 16 column major RGBA8 pixels
+static void decodeAlphaBlock(const etc2_byte *pIn, etc2_byte *pPixels) {
+    const uint64_t bits       = readBEUint64(pIn);
+    const int      base       = static_cast<int>(bits >> 56);
+    const int      multiplier = static_cast<int>((bits >> 52) & 0xF);
+    const int     *modifiers  = EAC_MODIFIER_TABLE[(bits >> 48) & 0xF];
+    for (int i = 0; i < 16; ++i) {
+        pPixels[i * 4 + 3] = static_cast<etc2_byte>(clampByte(base + modifiers[(bits >> (45 - i * 3)) & 0x7] * multiplier));
+    }
+}
+
+etc2_uint32 etc2_get_block_size(etc2_uint32 format) {
+    return format == ETC2_RGBA_NO_MIPMAPS ? 16 : 8;
+}
+
+void etc2_decode_block_rows(const etc2_byte *pIn, etc2_uint32 format, etc2_uint32 width, etc2_uint32 height,
+                            etc2_uint32 firstRow, etc2_uint32 rowCount, etc2_byte *pOut) {
+    const etc2_uint32 blockSize    = etc2_get_block_size(format);
+    const etc2_uint32 blocksPerRow = (width + 3) / 4;
+    etc2_byte         pixels[16 * 4];
+
+    for (etc2_uint32 row = firstRow; row < firstRow + rowCount && row * 4 < height; ++row) {
+        const etc2_byte *pBlock = pIn + row * blocksPerRow * blockSize;
+        for (etc2_uint32 column = 0; column < blocksPerRow; ++column, pBlock += blockSize) {
+            if (format == ETC2_RGBA_NO_MIPMAPS) {
+                decodeColorBlock(pBlock + 8, pixels);
+                decodeAlphaBlock(pBlock, pixels);
+            } else {
+                decodeColorBlock(pBlock, pixels);
+            }
+
+            // blocks on the right and bottom borders may be clipped
+            for (etc2_uint32 x = 0; x < 4 && column * 4 + x < width; ++x) {
+                for (etc2_uint32 y = 0; y < 4 && row * 4 + y < height; ++y) {
+                    memcpy(pOut + ((row * 4 + y) * width + column * 4 + x) * 4, pixels + (x * 4 + y) * 4, 4);
+                }
+            }
+        }
+    }
+}
@@ -68,6 +68,17 @@ etc2_uint32 etc2_pkm_get_height(const etc2_byte *pHeader);
 
 etc2_uint32 etc2_pkm_get_format(const etc2_byte *pHeader);
 
+// Size of an encoded block of the given PKM format, in bytes.
+
+etc2_uint32 etc2_get_block_size(etc2_uint32 format);
+
+// Decode the block rows [firstRow, firstRow + rowCount) of ETC2 RGB8 or ETC2 RGBA8 data to RGBA8 pixels.
+// ETC1 data can be decoded as ETC2_RGB_NO_MIPMAPS. pIn points to the first block of the image and
+// pOut to the first pixel of the width * height RGBA8 image, so that disjoint rows can be decoded in parallel.
+
+void etc2_decode_block_rows(const etc2_byte *pIn, etc2_uint32 format, etc2_uint32 width, etc2_uint32 height,
+                            etc2_uint32 firstRow, etc2_uint32 rowCount, etc2_byte *pOut);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,192 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "JobScheduler.h"
+#include <chrono>
+#include "base/Log.h"
+#include "base/memory/Memory.h"
+#include "base/threading/ThreadAffinity.h"
+
+namespace cc {
+
+namespace {
+// the worker running on this thread, -1 on other threads
+thread_local const JobScheduler *currentScheduler = nullptr;
+thread_local int                 currentWorker    = -1;
+} // namespace
+
+JobScheduler *JobScheduler::instance = nullptr;
+
+JobScheduler *JobScheduler::getInstance() {
+    if (!instance) {
+        instance = CC_NEW(JobScheduler);
+    }
+    return instance;
+}
+
+void JobScheduler::destroyInstance() {
+    CC_SAFE_DELETE(instance);
+}
+
+JobScheduler::JobScheduler(uint threadCount) noexcept {
+    _queues.reserve(threadCount);
+    for (uint i = 0; i < threadCount; ++i) {
+        _queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    _workers.reserve(threadCount);
+    for (uint i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&JobScheduler::workerLoop, this, i);
+    }
+    CC_LOG_INFO("Job scheduler initialized: %d worker threads", threadCount);
+}
+
+JobScheduler::~JobScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _running.store(false, std::memory_order_release);
+    }
+    _jobQueued.notify_all();
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+
+    QueuedJob job;
+    while (findJob(JobPriority::STREAMING, job)) {
+        runJob(job);
+    }
+}
+
+void JobScheduler::schedule(Job &&job, JobPriority priority, JobCounter *counter) {
+    if (counter) counter->_pending.fetch_add(1, std::memory_order_relaxed);
+
+    QueuedJob queued{std::move(job), counter};
+    if (_queues.empty()) {
+        runJob(queued);
+        return;
+    }
+
+    // workers keep their own jobs local, other threads spread them over all workers
+    const int  worker     = workerIndex();
+    const uint queueIndex = worker >= 0 ? static_cast<uint>(worker)
+                                        : _nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint>(_queues.size());
+    // counted before it is visible so the count never drops below the queued jobs
+    _queuedCount.fetch_add(1, std::memory_order_release);
+    {
+        auto &                      queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs[static_cast<uint>(priority)].push_back(std::move(queued));
+    }
+    {
+        // pairs with the predicate check of sleeping workers, so the notification is never lost
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _jobQueued.notify_one();
+}
+
+void JobScheduler::wait(JobCounter &counter) {
+    while (!counter.isDone()) {
+        if (runPendingJob(JobPriority::FRAME_CRITICAL)) continue;
+
+        // woken when a job finishes, the timeout picks up frame-critical jobs queued meanwhile
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _jobDone.wait_for(lock, std::chrono::microseconds(100), [&counter]() { return counter.isDone(); });
+    }
+}
+
+bool JobScheduler::runPendingJob(JobPriority lowest) {
+    QueuedJob job;
+    if (!findJob(lowest, job)) return false;
+    runJob(job);
+    return true;
+}
+
+bool JobScheduler::popJob(uint queueIndex, uint priority, bool newest, QueuedJob &job) {
+    auto &                      queue = *_queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto &                      jobs = queue.jobs[priority];
+    if (jobs.empty()) return false;
+    if (newest) {
+        job = std::move(jobs.back());
+        jobs.pop_back();
+    } else {
+        job = std::move(jobs.front());
+        jobs.pop_front();
+    }
+    _queuedCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobScheduler::findJob(JobPriority lowest, QueuedJob &job) {
+    if (_queuedCount.load(std::memory_order_acquire) == 0) return false;
+
+    const int  worker     = workerIndex();
+    const auto queueCount = static_cast<uint>(_queues.size());
+    const uint first      = worker >= 0 ? static_cast<uint>(worker) : _nextQueue.load(std::memory_order_relaxed) % queueCount;
+    for (uint priority = 0; priority <= static_cast<uint>(lowest); ++priority) {
+        if (worker >= 0 && popJob(first, priority, true, job)) return true;
+        for (uint i = worker >= 0 ? 1 : 0; i < queueCount; ++i) {
+            if (popJob((first + i) % queueCount, priority, false, job)) return true;
+        }
+    }
+    return false;
+}
+
+void JobScheduler::runJob(QueuedJob &job) {
+    job.func();
+    job.func = nullptr;
+    if (job.counter && job.counter->_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _jobDone.notify_all();
+    }
+}
+
+void JobScheduler::workerLoop(uint index) {
+    ThreadAffinity::setCurrentThread("Job", ThreadQoS::DEFAULT);
+    currentScheduler = this;
+    currentWorker    = static_cast<int>(index);
+    QueuedJob job;
+    while (true) {
+        if (findJob(JobPriority::STREAMING, job)) {
+            runJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _jobQueued.wait(lock, [this]() {
+            return _queuedCount.load(std::memory_order_acquire) > 0 || !_running.load(std::memory_order_acquire);
+        });
+        if (!_running.load(std::memory_order_acquire)) break;
+    }
+    currentScheduler = nullptr;
+    currentWorker    = -1;
+}
+
+int JobScheduler::workerIndex() const {
+    return currentScheduler == this ? currentWorker : -1;
+}
+
+} // namespace cc
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "base/Macros.h"
+#include "base/TypeDef.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+enum class JobPriority : uint8_t {
+    FRAME_CRITICAL, // needed by the current frame, also run by threads waiting on a counter
+    BACKGROUND,
+    STREAMING, // loading and decoding which may span several frames
+    COUNT,
+};
+
+/**
+ * Counts the unfinished jobs scheduled with it. The owner keeps it alive until isDone().
+ */
+class JobCounter final {
+public:
+    JobCounter() = default;
+
+    inline bool isDone() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobScheduler;
+
+    std::atomic<uint> _pending{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(JobCounter);
+};
+
+/**
+ * Work-stealing pool with priorities, independent of the JobSystem backend so it behaves the same
+ * with Taskflow, TBB and the dummy backend. Every worker owns a queue per priority, it takes its own
+ * jobs newest first and steals the oldest ones from the others, higher priorities always first.
+ * A thread waiting on a counter runs frame-critical jobs instead of blocking.
+ */
+class JobScheduler final {
+public:
+    using Job = std::function<void()>;
+
+    static JobScheduler *getInstance();
+    static void          destroyInstance();
+
+    JobScheduler() noexcept : JobScheduler(std::max(2U, std::thread::hardware_concurrency() - 2U)) {}
+    // 0 runs every job on the thread scheduling it
+    explicit JobScheduler(uint threadCount) noexcept;
+    // jobs still queued are run on the destroying thread
+    ~JobScheduler();
+
+    void schedule(Job &&job, JobPriority priority, JobCounter *counter = nullptr);
+
+    // runs frame-critical jobs on the calling thread until the counter is done
+    void wait(JobCounter &counter);
+
+    // runs one queued job on the calling thread, lowest is the least important priority taken, false if none is queued
+    bool runPendingJob(JobPriority lowest);
+
+    inline uint threadCount() const { return static_cast<uint>(_workers.size()); }
+
+private:
+    struct QueuedJob {
+        Job         func;
+        JobCounter *counter{nullptr};
+    };
+
+    struct WorkerQueue {
+        std::mutex              mutex;
+        ccstd::deque<QueuedJob> jobs[static_cast<uint>(JobPriority::COUNT)];
+    };
+
+    bool popJob(uint queueIndex, uint priority, bool newest, QueuedJob &job);
+    bool findJob(JobPriority lowest, QueuedJob &job);
+    void runJob(QueuedJob &job);
+    void workerLoop(uint index);
+    int  workerIndex() const;
+
+    static JobScheduler *instance;
+
+    ccstd::vector<std::unique_ptr<WorkerQueue>> _queues; // one per worker
+    ccstd::vector<std::thread>                  _workers;
+    std::atomic<uint>                           _queuedCount{0};
+    std::atomic<uint>                           _nextQueue{0};
+    std::atomic<bool>                           _running{true};
+    std::mutex                                  _sleepMutex;
+    std::condition_variable                     _jobQueued;
+    std::condition_variable                     _jobDone;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(JobScheduler);
+};
+
+} // namespace cc
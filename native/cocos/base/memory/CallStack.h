@@ -34,6 +34,7 @@
     #include <cstdint>
     #include "../Macros.h"
     #include "base/std/container/string.h"
+    #include "base/std/container/vector.h"
 
 namespace cc {
 
@@ -58,7 +58,7 @@
     }
 
 #define CC_MALLOC(bytes)              malloc(bytes)
-#define CC_MALLOC_ALIGN(bytes, align) _CC_MALLOC_ALIGN(align, bytes)
+#define CC_MALLOC_ALIGN(bytes, align) _CC_MALLOC_ALIGN(bytes, align)
 #define CC_REALLOC(ptr, bytes)        realloc(ptr, bytes)
 #define CC_FREE(ptr)                  free((void *)ptr)
 #define CC_FREE_ALIGN(ptr)            _CC_FREE_ALIGN(ptr)
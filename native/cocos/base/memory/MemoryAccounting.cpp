@@ -0,0 +1,171 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/memory/MemoryAccounting.h"
+#include <algorithm>
+
+namespace cc {
+
+namespace {
+const char *const TAG_NAMES[] = {
+    "Texture",
+    "Buffer",
+    "Mesh",
+    "Audio",
+    "Script",
+    "Spine",
+    "FrameGraph",
+    "Other",
+    "Total",
+};
+static_assert(sizeof(TAG_NAMES) / sizeof(TAG_NAMES[0]) == MemoryAccounting::TAG_COUNT, "TAG_NAMES mismatches MemoryTag");
+
+inline uint32_t toIndex(MemoryTag tag) {
+    return static_cast<uint32_t>(tag);
+}
+} // namespace
+
+MemoryAccounting &MemoryAccounting::getInstance() {
+    // never destroyed, resources released by static destructors still report here
+    static auto *instance = new MemoryAccounting();
+    return *instance;
+}
+
+const char *MemoryAccounting::getTagName(MemoryTag tag) {
+    CC_ASSERT(tag < MemoryTag::COUNT);
+    return TAG_NAMES[toIndex(tag)];
+}
+
+void MemoryAccounting::allocate(MemoryTag tag, uint64_t bytes) {
+    CC_ASSERT(tag < MemoryTag::TOTAL);
+    auto &counter = _counters[toIndex(tag)];
+    updatePeak(counter, counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemoryAccounting::deallocate(MemoryTag tag, uint64_t bytes) {
+    CC_ASSERT(tag < MemoryTag::TOTAL);
+    auto &counter = _counters[toIndex(tag)];
+    CC_ASSERT(counter.current.load(std::memory_order_relaxed) >= bytes);
+    counter.current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::setUsage(MemoryTag tag, uint64_t bytes) {
+    CC_ASSERT(tag < MemoryTag::TOTAL);
+    auto &counter = _counters[toIndex(tag)];
+    counter.current.store(bytes, std::memory_order_relaxed);
+    updatePeak(counter, bytes);
+}
+
+MemoryUsage MemoryAccounting::getUsage(MemoryTag tag) const {
+    CC_ASSERT(tag < MemoryTag::COUNT);
+    const auto &counter = _counters[toIndex(tag)];
+
+    MemoryUsage usage;
+    usage.current = tag == MemoryTag::TOTAL ? getTotal() : counter.current.load(std::memory_order_relaxed);
+    usage.peak    = std::max(usage.current, counter.peak.load(std::memory_order_relaxed));
+    usage.budget  = counter.budget.load(std::memory_order_relaxed);
+    return usage;
+}
+
+void MemoryAccounting::setBudget(MemoryTag tag, uint64_t bytes) {
+    CC_ASSERT(tag < MemoryTag::COUNT);
+    auto &counter = _counters[toIndex(tag)];
+    counter.budget.store(bytes, std::memory_order_relaxed);
+    counter.overBudget = false;
+}
+
+uint32_t MemoryAccounting::addBudgetListener(BudgetCallback &&callback) {
+    const uint32_t id = _nextId++;
+    _listeners.push_back({id, MemoryTag::TOTAL, std::move(callback)});
+    return id;
+}
+
+void MemoryAccounting::removeBudgetListener(uint32_t id) {
+    _listeners.erase(std::remove_if(_listeners.begin(), _listeners.end(), [id](const auto &entry) { return entry.id == id; }), _listeners.end());
+}
+
+uint32_t MemoryAccounting::addProbe(MemoryTag tag, Probe &&probe) {
+    CC_ASSERT(tag < MemoryTag::TOTAL);
+    const uint32_t id = _nextId++;
+    _probes.push_back({id, tag, std::move(probe)});
+    return id;
+}
+
+void MemoryAccounting::removeProbe(uint32_t id) {
+    _probes.erase(std::remove_if(_probes.begin(), _probes.end(), [id](const auto &entry) { return entry.id == id; }), _probes.end());
+}
+
+void MemoryAccounting::update() {
+    for (const auto &probe : _probes) {
+        setUsage(probe.tag, probe.callable());
+    }
+
+    updatePeak(_counters[toIndex(MemoryTag::TOTAL)], getTotal());
+
+    for (uint32_t i = 0; i < TAG_COUNT; ++i) {
+        auto &         counter = _counters[i];
+        const uint64_t budget  = counter.budget.load(std::memory_order_relaxed);
+        if (!budget) {
+            continue;
+        }
+
+        const auto     tag     = static_cast<MemoryTag>(i);
+        const uint64_t current = tag == MemoryTag::TOTAL ? getTotal() : counter.current.load(std::memory_order_relaxed);
+        if (current <= budget) {
+            counter.overBudget = false;
+            continue;
+        }
+        if (counter.overBudget) {
+            continue;
+        }
+
+        // listeners may evict, or remove themselves, while being notified
+        auto listeners = _listeners;
+        for (const auto &listener : listeners) {
+            listener.callable(tag, current, budget);
+        }
+        // stays quiet until usage drops below the budget, unless the listeners already got it there
+        const uint64_t evicted = tag == MemoryTag::TOTAL ? getTotal() : counter.current.load(std::memory_order_relaxed);
+        counter.overBudget     = evicted > budget;
+    }
+}
+
+void MemoryAccounting::updatePeak(Counter &counter, uint64_t current) {
+    uint64_t peak = counter.peak.load(std::memory_order_relaxed);
+    while (current > peak && !counter.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t MemoryAccounting::getTotal() const {
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < toIndex(MemoryTag::TOTAL); ++i) {
+        if (i != toIndex(MemoryTag::FRAME_GRAPH)) {
+            total += _counters[i].current.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+} // namespace cc
@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "base/Config.h"
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+enum class MemoryTag : uint32_t {
+    TEXTURE,
+    BUFFER,
+    MESH,
+    AUDIO,
+    SCRIPT,
+    SPINE,
+    FRAME_GRAPH, // transient textures and buffers, already counted by TEXTURE and BUFFER
+    OTHER,
+    TOTAL, // sum of the tags above except FRAME_GRAPH, can only be queried and budgeted
+    COUNT,
+};
+
+struct MemoryUsage {
+    uint64_t current{0};
+    uint64_t peak{0};
+    uint64_t budget{0};
+};
+
+/**
+ * @en Registry where subsystems report the memory they hold, grouped by tag.
+ * Counters may be updated from any thread. Budgets, listeners and probes are managed on the main thread,
+ * where update() polls the probes and notifies listeners once a tag goes over its budget.
+ * @zh 各子系统按标签上报所占用内存的登记表。
+ * 计数可以在任意线程更新；预算、监听器与探针须在主线程管理，update() 在主线程轮询探针，并在某个标签超出预算时通知监听器。
+ */
+class CC_DLL MemoryAccounting final {
+public:
+    // returns the current usage of subsystems which can only be polled, the JS heap for example
+    using Probe = std::function<uint64_t()>;
+    // called once when the usage of a tag rises above its budget, again only after it has dropped below
+    using BudgetCallback = std::function<void(MemoryTag tag, uint64_t current, uint64_t budget)>;
+
+    static constexpr uint32_t TAG_COUNT{static_cast<uint32_t>(MemoryTag::COUNT)};
+
+    static MemoryAccounting &getInstance();
+    static const char *      getTagName(MemoryTag tag);
+
+    void allocate(MemoryTag tag, uint64_t bytes);
+    void deallocate(MemoryTag tag, uint64_t bytes);
+    void setUsage(MemoryTag tag, uint64_t bytes);
+
+    MemoryUsage getUsage(MemoryTag tag) const;
+
+    /**
+     * @en Sets the budget of a tag in bytes, 0 disables it.
+     * @zh 设置标签的内存预算（字节），0 表示不限制。
+     */
+    void setBudget(MemoryTag tag, uint64_t bytes);
+
+    uint32_t addBudgetListener(BudgetCallback &&callback);
+    void     removeBudgetListener(uint32_t id);
+
+    uint32_t addProbe(MemoryTag tag, Probe &&probe);
+    void     removeProbe(uint32_t id);
+
+    // polls the probes and checks the budgets, called once a frame by Root
+    void update();
+
+private:
+    MemoryAccounting() = default;
+
+    struct Counter {
+        std::atomic<uint64_t> current{0};
+        std::atomic<uint64_t> peak{0};
+        std::atomic<uint64_t> budget{0};
+        bool                  overBudget{false};
+    };
+
+    template <typename Callable>
+    struct Entry {
+        uint32_t  id{0};
+        MemoryTag tag{MemoryTag::OTHER};
+        Callable  callable;
+    };
+
+    static void updatePeak(Counter &counter, uint64_t current);
+    uint64_t    getTotal() const;
+
+    ccstd::array<Counter, TAG_COUNT>     _counters;
+    ccstd::vector<Entry<BudgetCallback>> _listeners;
+    ccstd::vector<Entry<Probe>>          _probes;
+    uint32_t                             _nextId{1};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(MemoryAccounting)
+};
+
+} // namespace cc
+
+#if CC_USE_MEMORY_ACCOUNTING
+    #define CC_MEMORY_ACCOUNT_ALLOC(tag, bytes) cc::MemoryAccounting::getInstance().allocate(cc::MemoryTag::tag, (bytes))
+    #define CC_MEMORY_ACCOUNT_FREE(tag, bytes)  cc::MemoryAccounting::getInstance().deallocate(cc::MemoryTag::tag, (bytes))
+    #define CC_MEMORY_ACCOUNT_SET(tag, bytes)   cc::MemoryAccounting::getInstance().setUsage(cc::MemoryTag::tag, (bytes))
+#else
+    #define CC_MEMORY_ACCOUNT_ALLOC(tag, bytes)
+    #define CC_MEMORY_ACCOUNT_FREE(tag, bytes)
+    #define CC_MEMORY_ACCOUNT_SET(tag, bytes)
+#endif
@@ -26,6 +26,10 @@
 #include "MemoryHook.h"
 #if USE_MEMORY_LEAK_DETECTOR
 
+    #include <algorithm>
+    #include <cmath>
+    #include <cstdio>
+    #include <fstream>
     #include <sstream>
 
     #if CC_PLATFORM == CC_PLATFORM_ANDROID
@@ -140,6 +144,10 @@ static void deleteHook(const void *ptr) {
 }
 
 MemoryHook::MemoryHook() {
+    _sampleInterval = CC_MEMORY_HOOK_SAMPLE_INTERVAL;
+    if (_sampleInterval > 0) {
+        _bytesUntilSample = nextSampleDistance();
+    }
     registerAll();
 }
 
@@ -149,6 +157,12 @@ MemoryHook::~MemoryHook() {
 }
 
 void MemoryHook::addRecord(uint64_t address, size_t size) {
+    _allocationCount.fetch_add(1U, std::memory_order_relaxed);
+    if (_sampleInterval.load(std::memory_order_relaxed) > 0) {
+        addSampledRecord(address, size);
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (_hooking) {
         return;
@@ -170,6 +184,11 @@ void MemoryHook::addRecord(uint64_t address, size_t size) {
 }
 
 void MemoryHook::removeRecord(uint64_t address) {
+    if (_sampleInterval.load(std::memory_order_relaxed) > 0) {
+        removeSampledRecord(address);
+        return;
+    }
+
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     if (_hooking) {
         return;
@@ -189,6 +208,226 @@ void MemoryHook::removeRecord(uint64_t address) {
     _hooking = false;
 }
 
+void MemoryHook::addSampledRecord(uint64_t address, size_t size) {
+    const auto bytes = static_cast<int64_t>(size);
+    if (bytes == 0 || _bytesUntilSample.fetch_sub(bytes, std::memory_order_relaxed) > bytes) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    // another thread may have taken this sample already
+    if (_hooking || _bytesUntilSample.load(std::memory_order_relaxed) > 0) {
+        return;
+    }
+
+    _hooking = true;
+
+    // {} is necessary here to make variables being destroyed before _hooking = false
+    {
+        _bytesUntilSample.store(nextSampleDistance(), std::memory_order_relaxed);
+
+        auto     callstack = CallStack::backtrace();
+        auto     iter      = _siteIndices.find(callstack);
+        uint32_t siteIndex = 0;
+        if (iter != _siteIndices.end()) {
+            siteIndex = iter->second;
+        } else {
+            siteIndex = static_cast<uint32_t>(_sites.size());
+            _sites.emplace_back().callstack = callstack;
+            _siteIndices.emplace(std::move(callstack), siteIndex);
+        }
+
+        auto &site = _sites[siteIndex];
+        ++site.liveCount;
+        site.liveBytes += bytes;
+        ++site.allocCount;
+        site.allocBytes += bytes;
+
+        // an allocation of `size` bytes is sampled with the probability of 1 - e^(-size / interval)
+        const auto interval = static_cast<double>(_sampleInterval.load(std::memory_order_relaxed));
+        const auto estimate = static_cast<size_t>(static_cast<double>(size) / (1.0 - std::exp(-static_cast<double>(size) / interval)));
+
+        auto &record = _sampledRecords[address];
+        if (record.size > 0) {
+            // the free of the previous allocation at this address was missed
+            _sites[record.site].liveCount--;
+            _sites[record.site].liveBytes -= static_cast<int64_t>(record.size);
+            _totalSize -= record.estimate;
+        } else {
+            _sampledSlots[getSampledSlot(address)].fetch_add(1, std::memory_order_relaxed);
+        }
+        record.site     = siteIndex;
+        record.size     = size;
+        record.estimate = estimate;
+        _totalSize += estimate;
+    }
+
+    _hooking = false;
+}
+
+void MemoryHook::removeSampledRecord(uint64_t address) {
+    auto &slot = _sampledSlots[getSampledSlot(address)];
+    if (slot.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    if (_hooking) {
+        return;
+    }
+
+    _hooking = true;
+
+    // {} is necessary here to make variables being destroyed before _hooking = false
+    {
+        auto iter = _sampledRecords.find(address);
+        if (iter != _sampledRecords.end()) {
+            auto &site = _sites[iter->second.site];
+            site.liveCount--;
+            site.liveBytes -= static_cast<int64_t>(iter->second.size);
+            _totalSize -= iter->second.estimate;
+            slot.fetch_sub(1, std::memory_order_relaxed);
+            _sampledRecords.erase(iter);
+        }
+    }
+
+    _hooking = false;
+}
+
+int64_t MemoryHook::nextSampleDistance() {
+    // xorshift64*, mapped to (0, 1]
+    _randomState ^= _randomState >> 12;
+    _randomState ^= _randomState << 25;
+    _randomState ^= _randomState >> 27;
+    const auto bits    = (_randomState * 0x2545F4914F6CDD1DULL) >> 11;
+    const auto uniform = (static_cast<double>(bits) + 1.0) / 9007199254740992.0;
+
+    // exponentially distributed distance, one sample per interval bytes on average
+    const auto interval = static_cast<double>(_sampleInterval.load(std::memory_order_relaxed));
+    return static_cast<int64_t>(-std::log(uniform) * interval) + 1;
+}
+
+void MemoryHook::setSampleInterval(size_t bytes) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _hooking = true;
+
+    // {} is necessary here to make variables being destroyed before _hooking = false
+    {
+        _records.clear();
+        _sampledRecords.clear();
+        _sites.clear();
+        _siteIndices.clear();
+        for (auto &slot : _sampledSlots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+        _totalSize = 0;
+
+        _sampleInterval.store(bytes, std::memory_order_relaxed);
+        _bytesUntilSample.store(bytes > 0 ? nextSampleDistance() : 0, std::memory_order_relaxed);
+    }
+
+    _hooking = false;
+}
+
+HeapProfile MemoryHook::takeSnapshot() {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    HeapProfile                           profile;
+    // the snapshot itself is not recorded
+    _hooking = true;
+
+    {
+        profile.sampleInterval = _sampleInterval.load(std::memory_order_relaxed);
+        profile.entries        = _sites;
+    }
+
+    _hooking = false;
+    return profile;
+}
+
+bool MemoryHook::dumpHeapProfile(const ccstd::string &path) {
+    const auto profile = takeSnapshot();
+    if (profile.sampleInterval == 0) {
+        return false;
+    }
+
+    const auto text = profile.toPprof();
+    FILE *     fp   = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+
+    const bool succeeded = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    fclose(fp);
+    return succeeded;
+}
+
+HeapProfile HeapProfile::diff(const HeapProfile &from, const HeapProfile &to) {
+    HeapProfile result;
+    result.sampleInterval = to.sampleInterval;
+    result.entries        = to.entries;
+
+    ccstd::unordered_map<ccstd::vector<void *>, size_t, CallStackHash> indices;
+    for (size_t i = 0; i < result.entries.size(); ++i) {
+        indices.emplace(result.entries[i].callstack, i);
+    }
+
+    for (const auto &entry : from.entries) {
+        auto iter = indices.find(entry.callstack);
+        if (iter == indices.end()) {
+            // only happens when the sampling was restarted in between
+            result.entries.push_back({entry.callstack, -entry.liveCount, -entry.liveBytes, -entry.allocCount, -entry.allocBytes});
+            continue;
+        }
+
+        auto &delta = result.entries[iter->second];
+        delta.liveCount -= entry.liveCount;
+        delta.liveBytes -= entry.liveBytes;
+        delta.allocCount -= entry.allocCount;
+        delta.allocBytes -= entry.allocBytes;
+    }
+
+    result.entries.erase(std::remove_if(result.entries.begin(), result.entries.end(), [](const HeapProfileEntry &entry) {
+                             return entry.liveCount == 0 && entry.liveBytes == 0 && entry.allocCount == 0 && entry.allocBytes == 0;
+                         }),
+                         result.entries.end());
+    return result;
+}
+
+ccstd::string HeapProfile::toPprof() const {
+    HeapProfileEntry total;
+    for (const auto &entry : entries) {
+        total.liveCount += entry.liveCount;
+        total.liveBytes += entry.liveBytes;
+        total.allocCount += entry.allocCount;
+        total.allocBytes += entry.allocBytes;
+    }
+
+    // pprof only accepts negative values on the sample lines
+    std::stringstream stream;
+    stream << "heap profile: " << std::max<int64_t>(total.liveCount, 0) << ": " << std::max<int64_t>(total.liveBytes, 0)
+           << " [" << std::max<int64_t>(total.allocCount, 0) << ": " << std::max<int64_t>(total.allocBytes, 0)
+           << "] @ heap_v2/" << sampleInterval << "\n";
+
+    for (const auto &entry : entries) {
+        stream << entry.liveCount << ": " << entry.liveBytes << " [" << entry.allocCount << ": " << entry.allocBytes << "] @";
+        for (const auto *frame : entry.callstack) {
+            stream << " 0x" << std::hex << reinterpret_cast<uintptr_t>(frame) << std::dec;
+        }
+        stream << "\n";
+    }
+
+    #if CC_PLATFORM == CC_PLATFORM_ANDROID
+    // lets pprof map the addresses to the shared libraries
+    std::ifstream maps("/proc/self/maps");
+    if (maps) {
+        stream << "\nMAPPED_LIBRARIES:\n"
+               << maps.rdbuf();
+    }
+    #endif
+
+    return stream.str();
+}
+
 void MemoryHook::dumpMemoryLeak() {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
     #if CC_PLATFORM == CC_PLATFORM_WINDOWS
@@ -202,7 +441,7 @@ void MemoryHook::dumpMemoryLeak() {
     startStream << "---------------------------------------------------------------------------------------------------------" << std::endl;
     log(startStream.str());
 
-    if (_records.size() == 0) {
+    if (_records.empty() && _sampledRecords.empty()) {
         std::stringstream stream;
         stream << std::endl;
         stream << "Congratulations! There is no memory leak at all." << std::endl;
@@ -226,6 +465,27 @@ void MemoryHook::dumpMemoryLeak() {
         log(stream.str());
     }
 
+    // sampled sites only, the total below is an estimate
+    for (const auto &site : _sites) {
+        if (site.liveCount <= 0) {
+            continue;
+        }
+
+        std::stringstream stream;
+        int               k = 0;
+
+        stream << std::endl;
+        stream << "<" << ++i << ">:"
+               << "leak " << site.liveBytes << " sampled bytes in " << site.liveCount << " allocations" << std::endl;
+        stream << "\tcallstack:" << std::endl;
+        auto frames = CallStack::backtraceSymbols(site.callstack);
+        for (auto &frame : frames) {
+            stream << "\t[" << ++k << "]:" << frame.toString() << std::endl;
+        }
+
+        log(stream.str());
+    }
+
     std::stringstream endStream;
     endStream << std::endl
               << "Total Leak: " << _totalSize << " bytes" << std::endl;
@@ -31,7 +31,11 @@
     #include "../Macros.h"
     #include "CallStack.h"
     #include "base/std/container/unordered_map.h"
+    #include "base/std/container/vector.h"
+    #include "boost/functional/hash.hpp"
 
+    #include <array>
+    #include <atomic>
     #include <mutex>
 
 typedef void *(*MallocType)(size_t size);
@@ -48,6 +52,39 @@ struct CC_DLL MemoryRecord {
     ccstd::vector<void *> callstack;
 };
 
+struct CC_DLL CallStackHash {
+    size_t operator()(const ccstd::vector<void *> &callstack) const {
+        return boost::hash_range(callstack.begin(), callstack.end());
+    }
+};
+
+/**
+ * Allocations of one call site in a sampled heap profile, the sizes are the
+ * sampled ones and are not scaled by the sample interval.
+ */
+struct CC_DLL HeapProfileEntry {
+    ccstd::vector<void *> callstack;
+    int64_t               liveCount{0};
+    int64_t               liveBytes{0};
+    int64_t               allocCount{0};
+    int64_t               allocBytes{0};
+};
+
+struct CC_DLL HeapProfile {
+    size_t                          sampleInterval{0};
+    ccstd::vector<HeapProfileEntry> entries;
+
+    /**
+     * Growth from `from` to `to` per call site, sites that did not change are dropped.
+     */
+    static HeapProfile diff(const HeapProfile &from, const HeapProfile &to);
+
+    /**
+     * Serialize in the legacy heap_v2 text format which `pprof` reads directly.
+     */
+    ccstd::string toPprof() const;
+};
+
 class CC_DLL MemoryHook {
 public:
     MemoryHook();
@@ -58,9 +95,24 @@ public:
      */
     using RecordMap = ccstd::unordered_map<uint64_t, MemoryRecord>;
 
-    void   addRecord(uint64_t address, size_t size);
-    void   removeRecord(uint64_t address);
-    size_t getTotalSize() const { return _totalSize; }
+    void     addRecord(uint64_t address, size_t size);
+    void     removeRecord(uint64_t address);
+    size_t   getTotalSize() const { return _totalSize; }
+    // number of allocations since the hook was registered, sampled or not
+    uint64_t getAllocationCount() const { return _allocationCount.load(std::memory_order_relaxed); }
+
+    /**
+     * Record one allocation per `bytes` on average, aggregated by call site.
+     * 0 records every allocation. Switching drops the records taken so far.
+     */
+    void   setSampleInterval(size_t bytes);
+    size_t getSampleInterval() const { return _sampleInterval.load(std::memory_order_relaxed); }
+
+    /**
+     * Copy of the sampled call sites, empty when sampling is disabled.
+     */
+    HeapProfile takeSnapshot();
+    bool        dumpHeapProfile(const ccstd::string &path);
 
 private:
     /**
@@ -80,11 +132,39 @@ private:
      */
     void unRegisterAll();
 
+    void addSampledRecord(uint64_t address, size_t size);
+    void removeSampledRecord(uint64_t address);
+
+    // randomized so that periodic allocation patterns are not aliased
+    int64_t nextSampleDistance();
+
+    struct SampledRecord {
+        uint32_t site{0};
+        size_t   size{0};
+        size_t   estimate{0};
+    };
+
+    static constexpr uint32_t SAMPLED_SLOT_COUNT{4096};
+
+    static uint32_t getSampledSlot(uint64_t address) {
+        return static_cast<uint32_t>((address >> 4) ^ (address >> 16)) & (SAMPLED_SLOT_COUNT - 1);
+    }
+
 private:
     std::recursive_mutex _mutex;
     bool                 _hooking{false};
     RecordMap            _records;
     size_t               _totalSize{0U};
+
+    std::atomic<uint64_t>                                                _allocationCount{0U};
+    std::atomic<size_t>                                                  _sampleInterval{0U};
+    std::atomic<int64_t>                                                 _bytesUntilSample{0};
+    uint64_t                                                             _randomState{0x9E3779B97F4A7C15ULL};
+    ccstd::unordered_map<uint64_t, SampledRecord>                        _sampledRecords;
+    ccstd::vector<HeapProfileEntry>                                      _sites;
+    ccstd::unordered_map<ccstd::vector<void *>, uint32_t, CallStackHash> _siteIndices;
+    // live sampled records per address bucket, lets free skip the lock for addresses never sampled
+    std::array<std::atomic<uint32_t>, SAMPLED_SLOT_COUNT>                _sampledSlots{};
 };
 
 extern MemoryHook GMemoryHook;
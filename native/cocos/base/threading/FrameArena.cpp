@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "FrameArena.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include "ThreadSafeLinearAllocator.h"
+
+namespace cc {
+
+namespace {
+// arenas live as long as the process, job threads are never recreated
+std::mutex                                   arenasMutex;
+ccstd::vector<std::unique_ptr<FrameArena>> & getArenas() {
+    static ccstd::vector<std::unique_ptr<FrameArena>> arenas;
+    return arenas;
+}
+thread_local FrameArena *threadArena = nullptr;
+} // namespace
+
+std::atomic<uint32_t> FrameArena::frame{0};
+
+FrameArena *FrameArena::getInstance() {
+    if (!threadArena) {
+        std::lock_guard<std::mutex> lock(arenasMutex);
+        getArenas().emplace_back(new FrameArena());
+        threadArena = getArenas().back().get();
+    }
+    return threadArena;
+}
+
+void FrameArena::nextFrame() {
+    frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameArena::FrameArena()
+: _frame(frame.load(std::memory_order_relaxed)) {
+    _pages.emplace_back(new ThreadSafeLinearAllocator(INITIAL_CAPACITY));
+}
+
+FrameArena::~FrameArena() {
+    for (auto *page : _pages) {
+        delete page;
+    }
+    _pages.clear();
+}
+
+size_t FrameArena::getCapacity() const noexcept {
+    size_t capacity = 0;
+    for (const auto *page : _pages) {
+        capacity += page->getCapacity();
+    }
+    return capacity;
+}
+
+size_t FrameArena::getUsedSize() const noexcept {
+    size_t usedSize = 0;
+    for (const auto *page : _pages) {
+        usedSize += page->getUsedSize();
+    }
+    return usedSize;
+}
+
+void FrameArena::recycle() {
+    if (_pages.size() > 1) {
+        // replaced by one page large enough for the whole last frame
+        const size_t capacity = getCapacity();
+        for (auto *page : _pages) {
+            delete page;
+        }
+        _pages.clear();
+        _pages.emplace_back(new ThreadSafeLinearAllocator(capacity));
+        return;
+    }
+    _pages.back()->recycle();
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    bytes = std::max<std::size_t>(bytes, 1U);
+
+    const uint32_t currentFrame = frame.load(std::memory_order_relaxed);
+    if (_frame != currentFrame) {
+        _frame = currentFrame;
+        recycle();
+    }
+
+    void *ptr = _pages.back()->allocate<uint8_t>(bytes, alignment);
+    if (!ptr) {
+        // overflowed, the next frame will fit in one page again
+        const size_t capacity = std::max(_pages.back()->getCapacity() * 2, bytes + alignment);
+        _pages.emplace_back(new ThreadSafeLinearAllocator(capacity));
+        ptr = _pages.back()->allocate<uint8_t>(bytes, alignment);
+    }
+    CCASSERT(ptr, "Out of memory");
+    return ptr;
+}
+
+} // namespace cc
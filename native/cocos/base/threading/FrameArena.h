@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "boost/container/pmr/memory_resource.hpp"
+
+namespace cc {
+
+class ThreadSafeLinearAllocator;
+
+/**
+ * Per-thread linear memory resource for the transient containers of the render path, e.g.
+ * ccstd::pmr::vector<uint8_t> visibility(FrameArena::getInstance());
+ * Deallocation is a no-op, the memory of a frame is recycled all at once by nextFrame,
+ * so a container using an arena must never outlive the frame it is created in.
+ */
+class CC_DLL FrameArena final : public boost::container::pmr::memory_resource {
+public:
+    static constexpr size_t INITIAL_CAPACITY{256 * 1024};
+
+    // the arena of the calling thread, created on its first use
+    static FrameArena *getInstance();
+    // called once at the end of each frame, each arena is recycled the next time its thread allocates from it
+    static void nextFrame();
+
+    ~FrameArena() override;
+
+    size_t getCapacity() const noexcept;
+    size_t getUsedSize() const noexcept;
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void * /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) override {}
+    bool  do_is_equal(const boost::container::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    FrameArena();
+
+    void recycle();
+
+    static std::atomic<uint32_t> frame;
+
+    // pages are only added when a frame overflows, they are merged into one on the next recycle
+    ccstd::vector<ThreadSafeLinearAllocator *> _pages;
+    uint32_t                                   _frame{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(FrameArena);
+};
+
+} // namespace cc
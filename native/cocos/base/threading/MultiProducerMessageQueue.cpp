@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "MultiProducerMessageQueue.h"
+
+namespace cc {
+
+MultiProducerMessageQueue::MultiProducerMessageQueue(uint32_t producerCount) {
+    _producers.resize(producerCount);
+    for (auto &producer : _producers) {
+        producer = CC_NEW_ALIGN(MessageQueue, alignof(MessageQueue));
+    }
+}
+
+MultiProducerMessageQueue::~MultiProducerMessageQueue() {
+    for (auto *producer : _producers) {
+        CC_DELETE_ALIGN(producer, MessageQueue, alignof(MessageQueue));
+    }
+    _producers.clear();
+}
+
+void MultiProducerMessageQueue::setImmediateMode(bool immediateMode) noexcept {
+    _immediateMode = immediateMode;
+    for (auto *producer : _producers) {
+        producer->setImmediateMode(immediateMode);
+    }
+}
+
+void MultiProducerMessageQueue::finishWriting(uint32_t index) noexcept {
+    // immediate messages have been executed on the producer thread already
+    _producers[index]->finishWriting();
+}
+
+void MultiProducerMessageQueue::flushMessages() noexcept {
+    if (_immediateMode) {
+        return;
+    }
+
+    for (auto *producer : _producers) {
+        producer->flushMessages();
+    }
+}
+
+void MultiProducerMessageQueue::merge(MessageQueue *consumerQueue) noexcept {
+    if (_immediateMode) {
+        return;
+    }
+
+    MultiProducerMessageQueue *const queue = this;
+
+    ENQUEUE_MESSAGE_1(
+        consumerQueue, MultiProducerMerge,
+        queue, queue,
+        {
+            queue->flushMessages();
+        });
+}
+
+} // namespace cc
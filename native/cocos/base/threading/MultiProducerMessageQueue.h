@@ -0,0 +1,70 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "MessageQueue.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+// Lets several producer threads feed a single consumer without locking.
+// Every producer owns a single-producer queue whose memory chunks are requested
+// from the shared chunk allocator of MessageQueue, and the consumer drains them
+// one after another in producer index order, so the merged order is deterministic
+// regardless of which producer finishes first.
+class MultiProducerMessageQueue final {
+public:
+    explicit MultiProducerMessageQueue(uint32_t producerCount);
+    ~MultiProducerMessageQueue();
+    MultiProducerMessageQueue(MultiProducerMessageQueue const &) = delete;
+    MultiProducerMessageQueue(MultiProducerMessageQueue &&)      = delete;
+    MultiProducerMessageQueue &operator=(MultiProducerMessageQueue const &) = delete;
+    MultiProducerMessageQueue &operator=(MultiProducerMessageQueue &&) = delete;
+
+    // the queue of a producer can be written by one thread at a time, with the usual ENQUEUE_MESSAGE macros
+    inline MessageQueue *getProducerQueue(uint32_t index) const noexcept { return _producers[index]; }
+    inline uint32_t      getProducerCount() const noexcept { return static_cast<uint32_t>(_producers.size()); }
+
+    void        setImmediateMode(bool immediateMode) noexcept;
+    inline bool isImmediateMode() const noexcept { return _immediateMode; }
+
+    // producer side, marks the end of the current batch of the producer and publishes it
+    void finishWriting(uint32_t index) noexcept;
+
+    // consumer side, executes the current batch of every producer in producer index order,
+    // waits for the producers which haven't finished writing yet
+    void flushMessages() noexcept;
+
+    // enqueues the flush into consumerQueue, so that the batches are executed at this point of its message stream
+    void merge(MessageQueue *consumerQueue) noexcept;
+
+private:
+    ccstd::vector<MessageQueue *> _producers;
+    bool                          _immediateMode{true};
+};
+
+} // namespace cc
@@ -0,0 +1,360 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ThreadAffinity.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include "base/Log.h"
+
+#if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OHOS || CC_PLATFORM == CC_PLATFORM_LINUX)
+    #define CC_THREAD_AFFINITY_SCHED 1
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+    #include <cstdio>
+    #include <ctime>
+#elif (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_MAC_OSX)
+    #define CC_THREAD_AFFINITY_APPLE 1
+    #include <mach/mach.h>
+    #include <pthread.h>
+    #include <pthread/qos.h>
+    #include <sys/sysctl.h>
+#elif (CC_PLATFORM == CC_PLATFORM_WINDOWS)
+    #define CC_THREAD_AFFINITY_WINDOWS 1
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#endif
+
+namespace cc {
+
+namespace {
+
+constexpr uint64_t NANOSECONDS_PER_SECOND = 1000000000ULL;
+constexpr const char *QOS_NAMES[] = {"critical", "default", "background"};
+
+struct ThreadRecord {
+    ccstd::string name;
+    ThreadQoS     qos{ThreadQoS::DEFAULT};
+#if CC_THREAD_AFFINITY_SCHED
+    clockid_t clock{};
+#elif CC_THREAD_AFFINITY_APPLE
+    mach_port_t port{MACH_PORT_NULL};
+#elif CC_THREAD_AFFINITY_WINDOWS
+    HANDLE handle{nullptr};
+#endif
+};
+
+// leaked on purpose, detached threads may still unregister while statics are destroyed at exit
+struct Registry {
+    std::mutex                    mutex;
+    ccstd::vector<ThreadRecord *> threads;
+};
+
+Registry &getRegistry() {
+    static auto *registry = new Registry();
+    return *registry;
+}
+
+void releaseRecord(ThreadRecord *record) {
+#if CC_THREAD_AFFINITY_WINDOWS
+    if (record->handle) {
+        CloseHandle(record->handle);
+    }
+#endif
+    delete record;
+}
+
+struct CurrentThreadRecord {
+    ThreadRecord *record{nullptr};
+
+    ~CurrentThreadRecord() {
+        if (!record) return;
+        Registry &registry = getRegistry();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.erase(std::remove(registry.threads.begin(), registry.threads.end(), record), registry.threads.end());
+        releaseRecord(record);
+    }
+};
+
+thread_local CurrentThreadRecord currentRecord;
+
+// a record that can only be read from the calling thread
+ThreadRecord getCallingThreadRecord() {
+    ThreadRecord record;
+#if CC_THREAD_AFFINITY_SCHED
+    record.clock = CLOCK_THREAD_CPUTIME_ID;
+#elif CC_THREAD_AFFINITY_APPLE
+    record.port = pthread_mach_thread_np(pthread_self());
+#elif CC_THREAD_AFFINITY_WINDOWS
+    record.handle = GetCurrentThread();
+#endif
+    return record;
+}
+
+// a record that other threads can read as long as the calling thread is alive
+void initRecord(ThreadRecord *record) {
+#if CC_THREAD_AFFINITY_SCHED
+    if (pthread_getcpuclockid(pthread_self(), &record->clock) != 0) {
+        record->clock = CLOCK_THREAD_CPUTIME_ID;
+    }
+#elif CC_THREAD_AFFINITY_APPLE
+    record->port = pthread_mach_thread_np(pthread_self());
+#elif CC_THREAD_AFFINITY_WINDOWS
+    DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &record->handle, THREAD_QUERY_LIMITED_INFORMATION, FALSE, 0);
+#endif
+}
+
+uint64_t readCpuTime(const ThreadRecord &record) {
+#if CC_THREAD_AFFINITY_SCHED
+    timespec time{};
+    if (clock_gettime(record.clock, &time) != 0) return 0;
+    return static_cast<uint64_t>(time.tv_sec) * NANOSECONDS_PER_SECOND + static_cast<uint64_t>(time.tv_nsec);
+#elif CC_THREAD_AFFINITY_APPLE
+    thread_basic_info_data_t info{};
+    mach_msg_type_number_t   count = THREAD_BASIC_INFO_COUNT;
+    if (thread_info(record.port, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>(&info), &count) != KERN_SUCCESS) return 0;
+    const auto seconds      = static_cast<uint64_t>(info.user_time.seconds) + static_cast<uint64_t>(info.system_time.seconds);
+    const auto microseconds = static_cast<uint64_t>(info.user_time.microseconds) + static_cast<uint64_t>(info.system_time.microseconds);
+    return seconds * NANOSECONDS_PER_SECOND + microseconds * 1000ULL;
+#elif CC_THREAD_AFFINITY_WINDOWS
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (!record.handle || !GetThreadTimes(record.handle, &creationTime, &exitTime, &kernelTime, &userTime)) return 0;
+    const auto toTicks = [](const FILETIME &time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32U) | time.dwLowDateTime;
+    };
+    // in units of 100ns
+    return (toTicks(kernelTime) + toTicks(userTime)) * 100ULL;
+#else
+    return 0;
+#endif
+}
+
+#if CC_THREAD_AFFINITY_SCHED
+uint32_t readCoreValue(const char *format, uint32_t core) {
+    char path[128];
+    snprintf(path, sizeof(path), format, core);
+    FILE *file = fopen(path, "r");
+    if (!file) return 0;
+    unsigned int value = 0;
+    if (fscanf(file, "%u", &value) != 1) {
+        value = 0;
+    }
+    fclose(file);
+    return value;
+}
+#endif
+
+void classifyCores(CpuTopology &topology, const ccstd::vector<uint32_t> &coreIds, const ccstd::vector<uint32_t> &performance) {
+    const auto range = std::minmax_element(performance.begin(), performance.end());
+    for (size_t i = 0; i < coreIds.size(); ++i) {
+        // every core counts as a performance core on CPUs whose cores are all alike
+        if (*range.first != *range.second && performance[i] == *range.first) {
+            topology.efficiencyCores.push_back(coreIds[i]);
+        } else {
+            topology.performanceCores.push_back(coreIds[i]);
+        }
+    }
+    topology.performanceCoreCount = static_cast<uint32_t>(topology.performanceCores.size());
+    topology.efficiencyCoreCount  = static_cast<uint32_t>(topology.efficiencyCores.size());
+}
+
+CpuTopology queryTopology() {
+    CpuTopology topology;
+#if CC_THREAD_AFFINITY_SCHED
+    const long configured = sysconf(_SC_NPROCESSORS_CONF); //NOLINT(google-runtime-int)
+    topology.coreCount    = configured > 0 ? static_cast<uint32_t>(configured) : std::thread::hardware_concurrency();
+
+    ccstd::vector<uint32_t> coreIds(topology.coreCount);
+    ccstd::vector<uint32_t> capacities(topology.coreCount, 0);
+    for (uint32_t i = 0; i < topology.coreCount; ++i) {
+        coreIds[i] = i;
+    }
+    // the capacity is what the energy aware scheduler uses, older kernels only tell the max frequency
+    for (const char *format : {"/sys/devices/system/cpu/cpu%u/cpu_capacity", "/sys/devices/system/cpu/cpu%u/cpufreq/cpuinfo_max_freq"}) {
+        bool complete = true;
+        for (uint32_t i = 0; i < topology.coreCount && complete; ++i) {
+            capacities[i] = readCoreValue(format, i);
+            complete      = capacities[i] > 0;
+        }
+        if (complete) break;
+        std::fill(capacities.begin(), capacities.end(), 0);
+    }
+    classifyCores(topology, coreIds, capacities);
+#elif CC_THREAD_AFFINITY_APPLE
+    const auto readInt = [](const char *name) {
+        int    value = 0;
+        size_t size  = sizeof(value);
+        return sysctlbyname(name, &value, &size, nullptr, 0) == 0 ? static_cast<uint32_t>(value) : 0U;
+    };
+    topology.coreCount = std::max(readInt("hw.logicalcpu"), 1U);
+    // perflevel0 is the fastest cluster, the last level the most efficient one
+    const uint32_t levels = readInt("hw.nperflevels");
+    if (levels > 1) {
+        char name[64];
+        snprintf(name, sizeof(name), "hw.perflevel%u.logicalcpu", levels - 1);
+        topology.efficiencyCoreCount = std::min(readInt(name), topology.coreCount);
+    }
+    topology.performanceCoreCount = topology.coreCount - topology.efficiencyCoreCount;
+#elif CC_THREAD_AFFINITY_WINDOWS
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
+    ccstd::vector<uint8_t>  buffer(length);
+    ccstd::vector<uint32_t> coreIds;
+    ccstd::vector<uint32_t> efficiencyClasses;
+    if (length > 0 && GetLogicalProcessorInformationEx(RelationProcessorCore, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+        for (DWORD offset = 0; offset < length;) {
+            const auto *info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+            offset += info->Size;
+            // affinity masks only cover the first processor group
+            if (info->Relationship != RelationProcessorCore || info->Processor.GroupMask[0].Group != 0) continue;
+            const KAFFINITY mask = info->Processor.GroupMask[0].Mask;
+            for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+                if (mask & (static_cast<KAFFINITY>(1) << bit)) {
+                    coreIds.push_back(bit);
+                    // a higher class is a faster core
+                    efficiencyClasses.push_back(info->Processor.EfficiencyClass);
+                }
+            }
+        }
+    }
+    if (coreIds.empty()) {
+        for (uint32_t i = 0; i < std::thread::hardware_concurrency(); ++i) {
+            coreIds.push_back(i);
+            efficiencyClasses.push_back(0);
+        }
+    }
+    topology.coreCount = static_cast<uint32_t>(coreIds.size());
+    classifyCores(topology, coreIds, efficiencyClasses);
+#else
+    topology.coreCount            = std::max(std::thread::hardware_concurrency(), 1U);
+    topology.performanceCoreCount = topology.coreCount;
+#endif
+    return topology;
+}
+
+bool applyQoS(ThreadQoS qos) {
+#if CC_THREAD_AFFINITY_APPLE
+    qos_class_t qosClass = QOS_CLASS_USER_INITIATED;
+    if (qos == ThreadQoS::CRITICAL) {
+        qosClass = QOS_CLASS_USER_INTERACTIVE;
+    } else if (qos == ThreadQoS::BACKGROUND) {
+        qosClass = QOS_CLASS_UTILITY;
+    }
+    return pthread_set_qos_class_self_np(qosClass, 0) == 0;
+#elif CC_THREAD_AFFINITY_SCHED || CC_THREAD_AFFINITY_WINDOWS
+    const CpuTopology &topology = ThreadAffinity::getTopology();
+
+    ccstd::vector<uint32_t> cores;
+    if (!topology.isHeterogeneous() || qos != ThreadQoS::BACKGROUND) {
+        cores.insert(cores.end(), topology.performanceCores.begin(), topology.performanceCores.end());
+    }
+    if (!topology.isHeterogeneous() || qos != ThreadQoS::CRITICAL) {
+        cores.insert(cores.end(), topology.efficiencyCores.begin(), topology.efficiencyCores.end());
+    }
+    #if CC_THREAD_AFFINITY_SCHED
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t core : cores) {
+        if (core < CPU_SETSIZE) {
+            CPU_SET(core, &set);
+        }
+    }
+    // 0 is the calling thread
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+    #else
+    KAFFINITY mask = 0;
+    for (uint32_t core : cores) {
+        mask |= static_cast<KAFFINITY>(1) << core;
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+    #endif
+#else
+    CC_UNUSED_PARAM(qos);
+    return false;
+#endif
+}
+
+} // namespace
+
+const CpuTopology &ThreadAffinity::getTopology() {
+    static const CpuTopology topology = queryTopology();
+    return topology;
+}
+
+bool ThreadAffinity::setCurrentThread(const char *name, ThreadQoS qos) {
+    const bool applied = applyQoS(qos);
+    if (!applied) {
+        CC_LOG_DEBUG("Failed to apply the %s QoS to thread %s", QOS_NAMES[static_cast<uint32_t>(qos)], name);
+    }
+
+    Registry                   &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!currentRecord.record) {
+        currentRecord.record = new ThreadRecord();
+        initRecord(currentRecord.record);
+        registry.threads.push_back(currentRecord.record);
+    }
+    currentRecord.record->name = name;
+    currentRecord.record->qos  = qos;
+    return applied;
+}
+
+const char *ThreadAffinity::getCurrentThreadName() {
+    // only the calling thread renames its record
+    return currentRecord.record ? currentRecord.record->name.c_str() : nullptr;
+}
+
+uint64_t ThreadAffinity::getCurrentThreadCpuTimeNS() {
+    return readCpuTime(getCallingThreadRecord());
+}
+
+ccstd::vector<ThreadCpuTime> ThreadAffinity::getThreadCpuTimes() {
+    Registry                   &registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    ccstd::vector<ThreadCpuTime> times;
+    times.reserve(registry.threads.size());
+    for (const auto *record : registry.threads) {
+        times.push_back({record->name, record->qos, readCpuTime(*record)});
+    }
+    return times;
+}
+
+void ThreadAffinity::dumpThreadCpuTimes() {
+    const CpuTopology &topology = getTopology();
+    CC_LOG_INFO("CPU cores: %u, performance: %u, efficiency: %u", topology.coreCount, topology.performanceCoreCount, topology.efficiencyCoreCount);
+    for (const auto &thread : getThreadCpuTimes()) {
+        CC_LOG_INFO("Thread %s (%s): %.3f ms CPU time", thread.name.c_str(), QOS_NAMES[static_cast<uint32_t>(thread.qos)], static_cast<double>(thread.cpuTimeNS) / 1e6);
+    }
+}
+
+} // namespace cc
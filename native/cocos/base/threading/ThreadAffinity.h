@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+enum class ThreadQoS : uint8_t {
+    // main and render threads, kept on the performance cores
+    CRITICAL,
+    // job workers, free to run on any core
+    DEFAULT,
+    // streaming, decoding and loading, kept on the efficiency cores
+    BACKGROUND,
+};
+
+struct CpuTopology {
+    uint32_t coreCount{0};
+    uint32_t performanceCoreCount{0};
+    uint32_t efficiencyCoreCount{0};
+    // core ids usable for affinity, empty where the OS doesn't expose them (iOS/macOS)
+    ccstd::vector<uint32_t> performanceCores;
+    ccstd::vector<uint32_t> efficiencyCores;
+
+    inline bool isHeterogeneous() const { return performanceCoreCount > 0 && efficiencyCoreCount > 0; }
+};
+
+struct ThreadCpuTime {
+    ccstd::string name;
+    ThreadQoS     qos{ThreadQoS::DEFAULT};
+    uint64_t      cpuTimeNS{0};
+};
+
+/**
+ * Places threads on the right kind of core of big.LITTLE and hybrid CPUs.
+ * Android, OHOS, Linux and Windows pin a thread to the performance or efficiency cores by affinity,
+ * iOS/macOS map ThreadQoS to the QoS classes and let the OS pick the cores.
+ * Nothing is pinned on CPUs whose cores are all alike.
+ */
+class CC_DLL ThreadAffinity final {
+public:
+    static const CpuTopology &getTopology();
+
+    // applies qos to the calling thread and registers it for getThreadCpuTimes, calling it again updates both
+    static bool setCurrentThread(const char *name, ThreadQoS qos);
+    // name given to the calling thread by setCurrentThread, nullptr if it has none
+    static const char *getCurrentThreadName();
+
+    static uint64_t getCurrentThreadCpuTimeNS();
+    // CPU time used so far by each registered thread that is still alive
+    static ccstd::vector<ThreadCpuTime> getThreadCpuTimes();
+    static void                         dumpThreadCpuTimes();
+
+private:
+    ThreadAffinity() = default;
+};
+
+} // namespace cc
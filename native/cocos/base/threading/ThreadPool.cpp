@@ -63,6 +63,7 @@ void ThreadPool::addThread() {
     assert(_workers.size() < MAX_THREAD_COUNT);
 
     auto workerLoop = [this]() {
+        ThreadAffinity::setCurrentThread("ThreadPool", _qos);
         while (_running) {
             Task task = nullptr;
 
@@ -32,6 +32,7 @@
 #include <future>
 #include <thread>
 #include "Event.h"
+#include "ThreadAffinity.h"
 #include "base/std/container/list.h"
 #include "concurrentqueue/concurrentqueue.h"
 
@@ -45,7 +46,7 @@ public:
     static uint8_t const CPU_CORE_COUNT;
     static uint8_t const MAX_THREAD_COUNT;
 
-    ThreadPool()                       = default;
+    explicit ThreadPool(ThreadQoS qos = ThreadQoS::DEFAULT) : _qos(qos) {}
     ~ThreadPool()                      = default;
     ThreadPool(ThreadPool const &)     = delete;
     ThreadPool(ThreadPool &&) noexcept = delete;
@@ -67,6 +68,7 @@ private:
     Event                    _event{};
     std::atomic<bool>        _running{false};
     uint8_t                  _workerCount{MAX_THREAD_COUNT};
+    ThreadQoS                _qos{ThreadQoS::DEFAULT};
 };
 
 template <typename Function, typename... Args>
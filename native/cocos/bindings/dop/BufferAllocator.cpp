@@ -27,6 +27,10 @@
 #include "base/Log.h"
 #include "base/memory/Memory.h"
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
 namespace se {
 
 BufferAllocator::BufferAllocator(PoolType type)
@@ -34,34 +38,85 @@ BufferAllocator::BufferAllocator(PoolType type)
 }
 
 BufferAllocator::~BufferAllocator() {
-    for (auto buffer : _buffers) {
-        buffer.second->decRef();
+    for (auto &buffer : _buffers) {
+        buffer.second.obj->decRef();
     }
     _buffers.clear();
+    compact(true);
 }
 
 se::Object *BufferAllocator::alloc(uint index, uint bytes) {
-    if (_buffers.count(index)) {
-        se::Object *oldObj = _buffers[index];
-        oldObj->decRef();
+    auto oldIter = _buffers.find(index);
+    if (oldIter != _buffers.end()) {
+        // the caller may still copy from the old buffer, so it is not recycled
+        oldIter->second.obj->decRef();
+        --_stats.liveBuffers;
+        _stats.liveBytes -= oldIter->second.bytes;
+        _buffers.erase(oldIter);
     }
-    se::Object *obj = se::Object::createArrayBufferObject(nullptr, bytes);
 
-    _buffers[index] = obj;
+    se::Object *obj      = nullptr;
+    auto        freeIter = _freeBuffers.find(bytes);
+    if (freeIter != _freeBuffers.end() && !freeIter->second.empty()) {
+        obj = freeIter->second.back();
+        freeIter->second.pop_back();
+        --_stats.freeBuffers;
+        _stats.freeBytes -= bytes;
+
+        // match what a new buffer would contain
+        uint8_t *data = nullptr;
+        size_t   len  = 0;
+        obj->getArrayBufferData(&data, &len);
+        memset(data, 0, len);
+    } else {
+        obj = se::Object::createArrayBufferObject(nullptr, bytes);
+    }
 
-    uint8_t *ret = nullptr;
-    size_t   len;
-    obj->getArrayBufferData(static_cast<uint8_t **>(&ret), &len);
+    _buffers[index] = {obj, bytes};
+    ++_stats.liveBuffers;
+    _stats.liveBytes += bytes;
 
     return obj;
 }
 
 void BufferAllocator::free(uint index) {
-    if (_buffers.count(index)) {
-        se::Object *oldObj = _buffers[index];
-        oldObj->decRef();
-        _buffers.erase(index);
+    auto iter = _buffers.find(index);
+    if (iter == _buffers.end()) {
+        return;
     }
+
+    const Buffer buffer = iter->second;
+    _buffers.erase(iter);
+    --_stats.liveBuffers;
+    _stats.liveBytes -= buffer.bytes;
+
+    _freeBuffers[buffer.bytes].push_back(buffer.obj);
+    ++_stats.freeBuffers;
+    _stats.freeBytes += buffer.bytes;
+
+    compact();
+}
+
+void BufferAllocator::compact(bool force) {
+    const uint maxFreeBytes = force ? 0 : std::max(MIN_COMPACT_BYTES, _stats.liveBytes / 100 * MAX_FREE_PERCENT);
+    if (_stats.freeBytes <= maxFreeBytes) {
+        return;
+    }
+
+    for (auto iter = _freeBuffers.begin(); iter != _freeBuffers.end() && _stats.freeBytes > maxFreeBytes;) {
+        auto &objs = iter->second;
+        while (!objs.empty() && _stats.freeBytes > maxFreeBytes) {
+            releaseBuffer({objs.back(), iter->first});
+            objs.pop_back();
+        }
+        iter = objs.empty() ? _freeBuffers.erase(iter) : std::next(iter);
+    }
+}
+
+void BufferAllocator::releaseBuffer(const Buffer &buffer) {
+    buffer.obj->decRef();
+    --_stats.freeBuffers;
+    _stats.freeBytes -= buffer.bytes;
 }
 
 } // namespace se
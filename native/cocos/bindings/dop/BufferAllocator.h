@@ -30,23 +30,51 @@
 #include "cocos/base/Object.h"
 #include "cocos/base/TypeDef.h"
 #include "cocos/base/std/container/unordered_map.h"
+#include "cocos/base/std/container/vector.h"
 #include "cocos/bindings/jswrapper/Object.h"
 
 namespace se {
 
 class CC_DLL BufferAllocator final : public cc::Object {
 public:
+    struct Stats {
+        uint liveBuffers{0};
+        uint liveBytes{0};
+        uint freeBuffers{0};
+        uint freeBytes{0};
+    };
+
     explicit BufferAllocator(PoolType type);
     ~BufferAllocator() override;
 
+    // Freed buffers are kept in a free list of their byte size and handed out again zero filled,
+    // the owner of an index must not touch its buffer once the index is freed.
     se::Object *alloc(uint index, uint bytes);
     void        free(uint index);
 
+    // Releases cached free buffers down to the share of the live bytes allowed to stay cached,
+    // or all of them if force is true.
+    void compact(bool force = false);
+
+    inline const Stats &getStats() const { return _stats; }
+
 private:
     static constexpr uint BUFFER_MASK = ~(1 << 30);
+    // free buffers are released once they exceed both limits
+    static constexpr uint MIN_COMPACT_BYTES = 256 * 1024;
+    static constexpr uint MAX_FREE_PERCENT  = 50;
+
+    struct Buffer {
+        se::Object *obj{nullptr};
+        uint        bytes{0};
+    };
+
+    void releaseBuffer(const Buffer &buffer);
 
-    ccstd::unordered_map<uint, se::Object *> _buffers;
-    PoolType                                 _type = PoolType::UNKNOWN;
+    ccstd::unordered_map<uint, Buffer>                      _buffers;
+    ccstd::unordered_map<uint, ccstd::vector<se::Object *>> _freeBuffers; // byte size -> free buffers
+    Stats                                                   _stats;
+    PoolType                                                _type = PoolType::UNKNOWN;
 };
 
 } // namespace se
@@ -27,6 +27,8 @@
 #include "base/Macros.h"
 #include "base/memory/Memory.h"
 
+#include <cstring>
+
 namespace se {
 
 BufferPool::BufferPool(PoolType type, uint entryBits, uint bytesPerEntry)
@@ -50,8 +52,136 @@ se::Object *BufferPool::allocateNewChunk() {
     size_t   len     = 0;
     jsObj->getArrayBufferData(&realPtr, &len);
     _chunks.push_back(realPtr);
+    _chunkInfos.emplace_back();
 
     return jsObj;
 }
 
+void BufferPool::releaseChunk(uint chunk) {
+    CCASSERT(chunk < _chunks.size(), "BufferPool: Invalid chunk index");
+    if (!_chunks[chunk]) {
+        return;
+    }
+
+    _allocator.free(chunk);
+    _chunks[chunk] = nullptr;
+
+    auto &info = _chunkInfos[chunk];
+    info.freeEntries.clear();
+    info.freeEntries.shrink_to_fit();
+    info.usedCount = 0;
+    info.managed   = false;
+}
+
+uint BufferPool::allocateEntry() {
+    uint chunk = findChunkForNewEntry();
+    if (chunk == static_cast<uint>(-1)) {
+        chunk = allocateManagedChunk();
+    }
+
+    auto &info  = _chunkInfos[chunk];
+    uint  entry = info.freeEntries.back();
+    info.freeEntries.pop_back();
+    ++info.usedCount;
+
+    // entries of a new chunk are zero filled already, recycled ones are cleared here
+    memset(_chunks[chunk] + entry * _bytesPerEntry, 0, _bytesPerEntry);
+    return (chunk << _entryBits) | entry;
+}
+
+void BufferPool::freeEntry(uint id) {
+    uint chunk = (_chunkMask & id) >> _entryBits;
+    uint entry = _entryMask & id;
+    CCASSERT(chunk < _chunks.size() && _chunks[chunk] && _chunkInfos[chunk].managed && entry < _entriesPerChunk, "BufferPool: Invalid buffer pool entry id");
+
+    auto &info = _chunkInfos[chunk];
+    info.freeEntries.push_back(entry);
+    --info.usedCount;
+    if (info.usedCount > 0) {
+        return;
+    }
+
+    // keep one empty chunk around so that a single entry going back and forth doesn't reallocate
+    for (uint i = 0; i < _chunkInfos.size(); ++i) {
+        if (i != chunk && _chunkInfos[i].managed && _chunkInfos[i].usedCount == 0) {
+            releaseChunk(chunk);
+            break;
+        }
+    }
+}
+
+void BufferPool::compact() {
+    for (uint i = 0; i < _chunkInfos.size(); ++i) {
+        if (_chunkInfos[i].managed && _chunkInfos[i].usedCount == 0) {
+            releaseChunk(i);
+        }
+    }
+    _allocator.compact(true);
+}
+
+BufferPool::Stats BufferPool::getStats() const {
+    Stats stats;
+    for (uint i = 0; i < _chunks.size(); ++i) {
+        if (!_chunks[i]) {
+            continue;
+        }
+        ++stats.chunks;
+        stats.entries += _entriesPerChunk;
+        // entries of chunks managed by the caller are not tracked and count as used
+        stats.usedEntries += _chunkInfos[i].managed ? _chunkInfos[i].usedCount : _entriesPerChunk;
+    }
+    stats.occupancy = stats.entries > 0 ? static_cast<float>(stats.usedEntries) / static_cast<float>(stats.entries) : 0.F;
+    return stats;
+}
+
+uint BufferPool::findChunkForNewEntry() const {
+    const uint drainCount = static_cast<uint>(static_cast<float>(_entriesPerChunk) * DRAIN_OCCUPANCY);
+
+    uint bestChunk  = static_cast<uint>(-1);
+    uint bestUsed   = 0;
+    uint drainChunk = static_cast<uint>(-1);
+    for (uint i = 0; i < _chunkInfos.size(); ++i) {
+        const auto &info = _chunkInfos[i];
+        if (!info.managed || info.freeEntries.empty()) {
+            continue;
+        }
+        if (info.usedCount < drainCount) {
+            if (drainChunk == static_cast<uint>(-1) || info.usedCount > _chunkInfos[drainChunk].usedCount) {
+                drainChunk = i;
+            }
+        } else if (bestChunk == static_cast<uint>(-1) || info.usedCount > bestUsed) {
+            bestChunk = i;
+            bestUsed  = info.usedCount;
+        }
+    }
+    return bestChunk != static_cast<uint>(-1) ? bestChunk : drainChunk;
+}
+
+uint BufferPool::allocateManagedChunk() {
+    // reuse the slot of a released chunk so that ids stay small
+    uint chunk = 0;
+    while (chunk < _chunks.size() && _chunks[chunk]) {
+        ++chunk;
+    }
+    if (chunk == _chunks.size()) {
+        _chunks.push_back(nullptr);
+        _chunkInfos.emplace_back();
+    }
+
+    se::Object *jsObj   = _allocator.alloc(chunk, _bytesPerChunk);
+    uint8_t *   realPtr = nullptr;
+    size_t      len     = 0;
+    jsObj->getArrayBufferData(&realPtr, &len);
+    _chunks[chunk] = realPtr;
+
+    auto &info   = _chunkInfos[chunk];
+    info.managed = true;
+    info.freeEntries.resize(_entriesPerChunk);
+    for (uint i = 0; i < _entriesPerChunk; ++i) {
+        // popped from the back, so low entries are handed out first
+        info.freeEntries[i] = _entriesPerChunk - 1 - i;
+    }
+    return chunk;
+}
+
 } // namespace se
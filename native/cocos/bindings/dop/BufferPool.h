@@ -39,6 +39,13 @@ class CC_DLL BufferPool final : public cc::Object {
 public:
     using Chunk = uint8_t *;
 
+    struct Stats {
+        uint  chunks{0};
+        uint  entries{0};
+        uint  usedEntries{0};
+        float occupancy{0.F};
+    };
+
     inline static uint getPoolFlag() { return POOL_FLAG; }
 
     BufferPool(PoolType type, uint entryBits, uint bytesPerEntry);
@@ -48,24 +55,49 @@ public:
     T *getTypedObject(uint id) const {
         uint chunk = (_chunkMask & id) >> _entryBits;
         uint entry = _entryMask & id;
-        CCASSERT(chunk < _chunks.size() && entry < _entriesPerChunk, "BufferPool: Invalid buffer pool entry id");
+        CCASSERT(chunk < _chunks.size() && _chunks[chunk] && entry < _entriesPerChunk, "BufferPool: Invalid buffer pool entry id");
         return reinterpret_cast<T *>(_chunks[chunk] + (entry * _bytesPerEntry));
     }
 
+    // Appends a chunk whose entries are managed by the caller.
     se::Object *allocateNewChunk();
+    // Returns the chunk memory to the allocator, entries of the chunk must not be used any more.
+    void releaseChunk(uint chunk);
+
+    // Entries managed by the pool: new entries go to the densest chunks so that sparse chunks drain,
+    // chunks are released once they are empty.
+    uint allocateEntry();
+    void freeEntry(uint id);
+    // Releases all empty chunks managed by the pool and trims the allocator.
+    void compact();
+
+    Stats                         getStats() const;
+    inline const BufferAllocator &getAllocator() const { return _allocator; }
 
 private:
     static constexpr uint POOL_FLAG = 1 << 30;
+    // chunks below this share of used entries only get new entries if no other chunk has room
+    static constexpr float DRAIN_OCCUPANCY = 0.25F;
+
+    struct ChunkInfo {
+        ccstd::vector<uint> freeEntries;
+        uint                usedCount{0};
+        bool                managed{false};
+    };
+
+    uint findChunkForNewEntry() const;
+    uint allocateManagedChunk();
 
-    BufferAllocator      _allocator;
-    ccstd::vector<Chunk> _chunks;
-    uint                 _entryBits       = 1 << 8;
-    uint                 _chunkMask       = 0;
-    uint                 _entryMask       = 0;
-    uint                 _bytesPerChunk   = 0;
-    uint                 _entriesPerChunk = 0;
-    uint                 _bytesPerEntry   = 0;
-    PoolType             _type            = PoolType::UNKNOWN;
+    BufferAllocator          _allocator;
+    ccstd::vector<Chunk>     _chunks;
+    ccstd::vector<ChunkInfo> _chunkInfos;
+    uint                     _entryBits       = 1 << 8;
+    uint                     _chunkMask       = 0;
+    uint                     _entryMask       = 0;
+    uint                     _bytesPerChunk   = 0;
+    uint                     _entriesPerChunk = 0;
+    uint                     _bytesPerEntry   = 0;
+    PoolType                 _type            = PoolType::UNKNOWN;
 };
 
 } // namespace se
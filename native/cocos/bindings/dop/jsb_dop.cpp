@@ -44,6 +44,75 @@ static bool jsb_BufferPool_allocateNewChunk(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(jsb_BufferPool_allocateNewChunk);
 
+static bool jsb_BufferPool_releaseChunk(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_releaseChunk : Invalid Native Object");
+
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint chunk = 0;
+        sevalue_to_native(args[0], &chunk);
+        pool->releaseChunk(chunk);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(jsb_BufferPool_releaseChunk);
+
+static bool jsb_BufferPool_allocateEntry(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_allocateEntry : Invalid Native Object");
+    s.rval().setUint32(pool->allocateEntry());
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_allocateEntry);
+
+static bool jsb_BufferPool_freeEntry(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_freeEntry : Invalid Native Object");
+
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint id = 0;
+        sevalue_to_native(args[0], &id);
+        pool->freeEntry(id);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d", (int)argc);
+    return false;
+}
+SE_BIND_FUNC(jsb_BufferPool_freeEntry);
+
+static bool jsb_BufferPool_compact(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_compact : Invalid Native Object");
+    pool->compact();
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_compact);
+
+static bool jsb_BufferPool_getStats(se::State &s) { // NOLINT
+    auto *pool = static_cast<se::BufferPool *>(s.nativeThisObject());
+    SE_PRECONDITION2(pool, false, "jsb_BufferPool_getStats : Invalid Native Object");
+
+    const auto       stats          = pool->getStats();
+    const auto &     allocatorStats = pool->getAllocator().getStats();
+    se::HandleObject obj(se::Object::createPlainObject());
+    obj->setProperty("chunks", se::Value(stats.chunks));
+    obj->setProperty("entries", se::Value(stats.entries));
+    obj->setProperty("usedEntries", se::Value(stats.usedEntries));
+    obj->setProperty("occupancy", se::Value(stats.occupancy));
+    obj->setProperty("freeBytes", se::Value(allocatorStats.freeBytes));
+    s.rval().setObject(obj);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferPool_getStats);
+
 SE_DECLARE_FINALIZE_FUNC(jsb_BufferPool_finalize)
 
 static bool jsb_BufferPool_constructor(se::State &s) { // NOLINT
@@ -82,6 +151,11 @@ static bool js_register_se_BufferPool(se::Object *obj) { // NOLINT
     se::Class *cls = se::Class::create("NativeBufferPool", obj, nullptr, _SE(jsb_BufferPool_constructor));
 
     cls->defineFunction("allocateNewChunk", _SE(jsb_BufferPool_allocateNewChunk));
+    cls->defineFunction("releaseChunk", _SE(jsb_BufferPool_releaseChunk));
+    cls->defineFunction("allocateEntry", _SE(jsb_BufferPool_allocateEntry));
+    cls->defineFunction("freeEntry", _SE(jsb_BufferPool_freeEntry));
+    cls->defineFunction("compact", _SE(jsb_BufferPool_compact));
+    cls->defineFunction("getStats", _SE(jsb_BufferPool_getStats));
     cls->install();
     JSBClassType::registerClass<se::BufferPool>(cls);
 
@@ -157,10 +231,41 @@ static bool jsb_BufferAllocator_free(se::State &s) { // NOLINT
 }
 SE_BIND_FUNC(jsb_BufferAllocator_free);
 
+static bool jsb_BufferAllocator_compact(se::State &s) { // NOLINT
+    auto *bufferAllocator = static_cast<se::BufferAllocator *>(s.nativeThisObject());
+    SE_PRECONDITION2(bufferAllocator, false, "jsb_BufferAllocator_compact : Invalid Native Object");
+
+    const auto &args  = s.args();
+    bool        force = false;
+    if (!args.empty()) {
+        sevalue_to_native(args[0], &force);
+    }
+    bufferAllocator->compact(force);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferAllocator_compact);
+
+static bool jsb_BufferAllocator_getStats(se::State &s) { // NOLINT
+    auto *bufferAllocator = static_cast<se::BufferAllocator *>(s.nativeThisObject());
+    SE_PRECONDITION2(bufferAllocator, false, "jsb_BufferAllocator_getStats : Invalid Native Object");
+
+    const auto &     stats = bufferAllocator->getStats();
+    se::HandleObject obj(se::Object::createPlainObject());
+    obj->setProperty("liveBuffers", se::Value(stats.liveBuffers));
+    obj->setProperty("liveBytes", se::Value(stats.liveBytes));
+    obj->setProperty("freeBuffers", se::Value(stats.freeBuffers));
+    obj->setProperty("freeBytes", se::Value(stats.freeBytes));
+    s.rval().setObject(obj);
+    return true;
+}
+SE_BIND_FUNC(jsb_BufferAllocator_getStats);
+
 static bool js_register_se_BufferAllocator(se::Object *obj) { // NOLINT
     se::Class *cls = se::Class::create("NativeBufferAllocator", obj, nullptr, _SE(jsb_BufferAllocator_constructor));
     cls->defineFunction("alloc", _SE(jsb_BufferAllocator_alloc));
     cls->defineFunction("free", _SE(jsb_BufferAllocator_free));
+    cls->defineFunction("compact", _SE(jsb_BufferAllocator_compact));
+    cls->defineFunction("getStats", _SE(jsb_BufferAllocator_getStats));
     cls->install();
     JSBClassType::registerClass<se::BufferAllocator>(cls);
 
@@ -117,6 +117,66 @@ private:
     friend TypedPrivateObject<T>;
 };
 
+/**
+ * Opt-in for small value types (gfx::Color, geometry structs, ...) created and dropped by scripts at a high rate,
+ * their wrappers are then allocated from a per-type free list instead of the heap, see SE_DECLARE_POOLED_PRIVATE_OBJECT.
+ */
+template <typename T>
+struct IsPooledPrivateObject : std::false_type {};
+
+// stores the value inline, it can't be shared with shared_ptr or IntrusivePtr
+template <typename T>
+class PooledPrivateObject final : public TypedPrivateObject<T> {
+public:
+    template <typename... ARGS>
+    explicit PooledPrivateObject(ARGS &&...args) : _data(std::forward<ARGS>(args)...) {}
+    ~PooledPrivateObject() override = default;
+
+    void *getRaw() const override { return const_cast<T *>(&_data); }
+
+    static void *operator new(size_t size) {
+        if (size != sizeof(PooledPrivateObject) || freeList() == nullptr) {
+            return ::operator new(size);
+        }
+        auto *node = freeList();
+        freeList() = node->next;
+        --freeCount();
+        return node;
+    }
+
+    static void operator delete(void *ptr, size_t size) {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (size != sizeof(PooledPrivateObject) || freeCount() >= MAX_FREE_COUNT) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto *node = static_cast<FreeNode *>(ptr);
+        node->next = freeList();
+        freeList() = node;
+        ++freeCount();
+    }
+
+private:
+    // wrappers are only created and finalized on the script thread
+    struct FreeNode {
+        FreeNode *next;
+    };
+    static constexpr uint32_t MAX_FREE_COUNT = 1024;
+
+    static FreeNode *&freeList() {
+        static FreeNode *list = nullptr;
+        return list;
+    }
+    static uint32_t &freeCount() {
+        static uint32_t count = 0;
+        return count;
+    }
+
+    T _data;
+};
+
 template <typename T>
 inline typename std::enable_if_t<std::is_destructible<T>::value, void> cctryDelete(T *t) {
     delete t;
@@ -235,4 +295,17 @@ inline PrivateObjectBase *ccshared_private_object(T *cobj) { // NOLINT
     static_assert(std::is_base_of<cc::RefCounted, T>::value, "cc::RefCounted expected!");
     return new CCSharedPtrPrivateObject<T>(cc::IntrusivePtr<T>(cobj));
 }
+
+template <typename T, typename... ARGS>
+inline PrivateObjectBase *pooled_private_object(ARGS &&...args) { // NOLINT
+    static_assert(!std::is_base_of<cc::RefCounted, T>::value, "cc::RefCounted is not acceptable for pooled private object");
+    return new PooledPrivateObject<T>(std::forward<ARGS>(args)...);
+}
 } // namespace se
+
+// must be used in the global namespace, before the bindings of `kls` are compiled
+#define SE_DECLARE_POOLED_PRIVATE_OBJECT(kls)              \
+    namespace se {                                         \
+    template <>                                            \
+    struct IsPooledPrivateObject<kls> : std::true_type {}; \
+    }
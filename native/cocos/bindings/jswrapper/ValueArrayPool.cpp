@@ -32,32 +32,33 @@ namespace se {
 
 ValueArrayPool gValueArrayPool;
 
-#define SE_DEFAULT_MAX_DEPTH (5)
-
 ValueArrayPool::ValueArrayPool() {
-    _pools.resize(SE_DEFAULT_MAX_DEPTH);
-    for (uint32_t i = 0; i < SE_DEFAULT_MAX_DEPTH; ++i) {
-        initPool(i);
+    for (auto &pool : _arena) {
+        initPool(pool);
     }
 }
 
 ValueArray &ValueArrayPool::get(uint32_t argc) {
-    if (SE_UNLIKELY(_depth >= _pools.size())) {
-        auto *ptr = _pools.data();
-        _pools.resize(_depth + 1);
-        assert(_pools.data() == ptr);
-        initPool(_depth);
+    assert(argc <= MAX_ARGS);
+    Pool *pool = nullptr;
+    if (SE_LIKELY(_depth < FIXED_DEPTH)) {
+        pool = &_arena[_depth];
+    } else {
+        const uint32_t index = _depth - FIXED_DEPTH;
+        while (_overflowPools.size() <= index) {
+            _overflowPools.emplace_back(std::make_unique<Pool>());
+            initPool(*_overflowPools.back());
+        }
+        pool = _overflowPools[index].get();
     }
 
-    assert(argc <= MAX_ARGS);
-    auto &ret = _pools[_depth][argc];
+    auto &ret = (*pool)[argc];
     assert(ret.size() == argc);
     return ret;
 }
 
-void ValueArrayPool::initPool(uint32_t index) {
-    auto &   pool = _pools[index];
-    uint32_t i    = 0;
+void ValueArrayPool::initPool(Pool &pool) {
+    uint32_t i = 0;
     for (auto &arr : pool) {
         arr.resize(i);
         ++i;
@@ -26,8 +26,11 @@
 
 #pragma once
 
+#include <cassert>
+#include <memory>
 #include "Value.h"
 #include "base/std/container/array.h"
+#include "config.h"
 
 namespace se {
 
@@ -53,6 +56,8 @@ private:
 class ValueArrayPool final {
 public:
     static const uint32_t MAX_ARGS = 20;
+    // nested native calls up to this depth are served from a preallocated arena
+    static const uint32_t FIXED_DEPTH = 8;
 
     ValueArrayPool();
 
@@ -61,8 +66,56 @@ public:
     uint32_t _depth{0};
 
 private:
-    void                                                  initPool(uint32_t index);
-    ccstd::vector<ccstd::array<ValueArray, MAX_ARGS + 1>> _pools;
+    using Pool = ccstd::array<ValueArray, MAX_ARGS + 1>;
+
+    static void initPool(Pool &pool);
+
+    ccstd::array<Pool, FIXED_DEPTH> _arena;
+    // deeper recursion, allocated once and never moved so that outer references stay valid
+    ccstd::vector<std::unique_ptr<Pool>> _overflowPools;
+};
+
+/**
+ * Arguments of a fast native call, read straight from the script engine without creating se::Value.
+ * Numbers and booleans take one slot, number arrays and Float32Array/Float64Array are expanded element by element.
+ */
+class NumberArgs final {
+public:
+    static const uint32_t MAX_NUMBERS = 32;
+
+    inline double operator[](uint32_t index) const {
+        assert(index < _count);
+        return _values[index];
+    }
+
+    inline float    toFloat(uint32_t index) const { return static_cast<float>((*this)[index]); }
+    inline int32_t  toInt32(uint32_t index) const { return static_cast<int32_t>((*this)[index]); }
+    inline uint32_t toUint32(uint32_t index) const { return static_cast<uint32_t>((*this)[index]); }
+    inline bool     toBoolean(uint32_t index) const { return (*this)[index] != 0.0; }
+
+    // count of numbers after expanding arrays
+    inline uint32_t size() const { return _count; }
+    // count of arguments passed by script
+    inline uint32_t argc() const { return _argc; }
+
+    inline void setArgc(uint32_t argc) { _argc = argc; }
+
+    /**
+     * Reserves 'count' slots and returns where to write them, or nullptr if there is not enough room.
+     */
+    inline double *append(uint32_t count) {
+        if (SE_UNLIKELY(count > MAX_NUMBERS - _count)) {
+            return nullptr;
+        }
+        double *ret = _values.data() + _count;
+        _count += count;
+        return ret;
+    }
+
+private:
+    ccstd::array<double, MAX_NUMBERS> _values;
+    uint32_t                          _count{0};
+    uint32_t                          _argc{0};
 };
 
 extern ValueArrayPool gValueArrayPool;
@@ -46,6 +46,20 @@
 
 #define SE_LOG_TO_JS_ENV 0 // print log to JavaScript environment, for example DevTools
 
+// cache the compiled code of evaluated scripts in the writable path, only supported by V8
+#ifndef SE_ENABLE_CODE_CACHE
+    #if defined(CC_EDITOR) && CC_EDITOR
+        #define SE_ENABLE_CODE_CACHE 0
+    #else
+        #define SE_ENABLE_CODE_CACHE 1
+    #endif
+#endif
+
+// let optimized code call bindings with primitive signatures through v8::CFunction, needs the V8 build to ship v8-fast-api-calls.h
+#ifndef SE_ENABLE_FAST_API_CALLS
+    #define SE_ENABLE_FAST_API_CALLS 0
+#endif
+
 #if !defined(ANDROID_INSTANT) && defined(USE_V8_DEBUGGER) && USE_V8_DEBUGGER > 0
     #define SE_ENABLE_INSPECTOR 1
     #define SE_DEBUG            2
@@ -26,6 +26,7 @@
 
 #pragma once
 
+#include "../config.h"
 #include "libplatform/libplatform.h"
 
 //#define V8_DEPRECATION_WARNINGS 1
@@ -33,6 +34,9 @@
 //#define V8_HAS_ATTRIBUTE_DEPRECATED_MESSAGE 1
 
 #include "v8.h"
+#if SE_ENABLE_FAST_API_CALLS
+    #include "v8-fast-api-calls.h"
+#endif
 
 #include <assert.h>
 #include <string.h>  // Resolves that memset, memcpy aren't found while APP_PLATFORM >= 22 on Android
@@ -59,7 +59,8 @@ Class::Class()
   _proto(nullptr),
   _ctor(nullptr),
   _finalizeFunc(nullptr),
-  _createProto(true) {
+  _createProto(true),
+  _restoredFromSnapshot(false) {
     __allClasses.push_back(this);
 }
 
@@ -104,6 +105,17 @@ bool Class::init(const ccstd::string &clsName, Object *parent, Object *parentPro
 
     v8::FunctionCallback ctorToSet = _ctor != nullptr ? _ctor : invalidConstructor;
 
+    auto *engine = ScriptEngine::getInstance();
+    engine->_registerExternalReference(ctorToSet);
+    if (engine->_isRestoringSnapshot()) {
+        v8::Local<v8::FunctionTemplate> restored;
+        if (engine->_getSnapshotTemplate().ToLocal(&restored)) {
+            _ctorTemplate.Reset(__isolate, restored);
+            _restoredFromSnapshot = true;
+            return true;
+        }
+    }
+
     _ctorTemplate.Reset(__isolate, v8::FunctionTemplate::New(__isolate, ctorToSet));
     v8::MaybeLocal<v8::String> jsNameVal = v8::String::NewFromUtf8(__isolate, _name.c_str(), v8::NewStringType::kNormal);
     if (jsNameVal.IsEmpty()) {
@@ -145,7 +157,7 @@ bool Class::install() {
     //
     //        __clsMap.emplace(_name, this);
 
-    if (_parentProto != nullptr) {
+    if (_parentProto != nullptr && !_restoredFromSnapshot) {
         _ctorTemplate.Get(__isolate)->Inherit(_parentProto->_getClass()->_ctorTemplate.Get(__isolate));
     }
 
@@ -185,6 +197,10 @@ bool Class::install() {
 }
 
 bool Class::defineFunction(const char *name, v8::FunctionCallback func) {
+    ScriptEngine::getInstance()->_registerExternalReference(func);
+    if (_restoredFromSnapshot) {
+        return true;
+    }
     v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (jsName.IsEmpty()) {
         return false;
@@ -193,7 +209,37 @@ bool Class::defineFunction(const char *name, v8::FunctionCallback func) {
     return true;
 }
 
+bool Class::defineFunction(const char *name, v8::FunctionCallback func, const v8::CFunction *fastFunc) {
+    if (fastFunc == nullptr) {
+        return defineFunction(name, func);
+    }
+
+    ScriptEngine::getInstance()->_registerExternalReference(func);
+    #if SE_ENABLE_FAST_API_CALLS
+    ScriptEngine::getInstance()->_registerExternalReference(fastFunc->GetAddress());
+    ScriptEngine::getInstance()->_registerExternalReference(fastFunc->GetTypeInfo());
+    #endif
+    if (_restoredFromSnapshot) {
+        return true;
+    }
+    v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
+    if (jsName.IsEmpty()) {
+        return false;
+    }
+    // the signature makes V8 check the receiver, the fast callback reads its internal field without checking
+    auto ctorTemplate = _ctorTemplate.Get(__isolate);
+    auto funcTemplate = v8::FunctionTemplate::New(__isolate, func, v8::Local<v8::Value>(), v8::Signature::New(__isolate, ctorTemplate), 0,
+                                                  v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect, fastFunc);
+    ctorTemplate->PrototypeTemplate()->Set(jsName.ToLocalChecked(), funcTemplate);
+    return true;
+}
+
 bool Class::defineProperty(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter) {
+    ScriptEngine::getInstance()->_registerExternalReference(getter);
+    ScriptEngine::getInstance()->_registerExternalReference(setter);
+    if (_restoredFromSnapshot) {
+        return true;
+    }
     v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (jsName.IsEmpty()) {
         return false;
@@ -211,6 +257,10 @@ bool Class::defineProperty(const std::initializer_list<const char *> &names, v8:
 }
 
 bool Class::defineStaticFunction(const char *name, v8::FunctionCallback func) {
+    ScriptEngine::getInstance()->_registerExternalReference(func);
+    if (_restoredFromSnapshot) {
+        return true;
+    }
     v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (jsName.IsEmpty()) {
         return false;
@@ -220,6 +270,11 @@ bool Class::defineStaticFunction(const char *name, v8::FunctionCallback func) {
 }
 
 bool Class::defineStaticProperty(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter) {
+    ScriptEngine::getInstance()->_registerExternalReference(getter);
+    ScriptEngine::getInstance()->_registerExternalReference(setter);
+    if (_restoredFromSnapshot) {
+        return true;
+    }
     v8::MaybeLocal<v8::String> jsName = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (jsName.IsEmpty()) {
         return false;
@@ -266,6 +321,14 @@ void Class::setIsolate(v8::Isolate *isolate) {
     __isolate = isolate;
 }
 
+/* static */
+size_t Class::addTemplatesToSnapshot(v8::SnapshotCreator *creator) {
+    for (auto *cls : __allClasses) {
+        creator->AddData(cls->_ctorTemplate.Get(__isolate));
+    }
+    return __allClasses.size();
+}
+
 } // namespace se
 
 #endif // #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
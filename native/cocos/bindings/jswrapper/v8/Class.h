@@ -62,6 +62,15 @@ public:
          */
     bool defineFunction(const char *name, v8::FunctionCallback func);
 
+    /**
+         *  @brief Defines a member function with a slow callback and a V8 Fast API callback used by optimized code.
+         *  @param[in] name A null-terminated UTF8 string containing the function name.
+         *  @param[in] func A callback to invoke when the fast path can't be taken, it must behave the same.
+         *  @param[in] fastFunc The fast callback created with SE_BIND_FAST_FUNC, nullptr if SE_ENABLE_FAST_API_CALLS is off.
+         *  @return true if succeed, otherwise false.
+         */
+    bool defineFunction(const char *name, v8::FunctionCallback func, const v8::CFunction *fastFunc);
+
     /**
          *  @brief Defines a property with accessor callbacks. Each objects created by class will have this property.
          *  @param[in] name A null-terminated UTF8 string containing the property name.
@@ -133,6 +142,8 @@ private:
     //        static v8::Local<v8::Object> _createJSObject(const ccstd::string &clsName, Class** outCls);
     static v8::Local<v8::Object> _createJSObjectWithClass(Class *cls); // NOLINT(readability-identifier-naming)
     static void                  setIsolate(v8::Isolate *isolate);
+    // Adds the templates of all classes to the snapshot in creation order, returns the count
+    static size_t addTemplatesToSnapshot(v8::SnapshotCreator *creator);
 
     ccstd::string _name;
     Object *      _parent;
@@ -143,6 +154,8 @@ private:
     v8::UniquePersistent<v8::FunctionTemplate> _ctorTemplate;
     V8FinalizeFunc                             _finalizeFunc;
     bool                                       _createProto;
+    // The template was deserialized from the startup snapshot with all its functions and properties
+    bool _restoredFromSnapshot;
 
     friend class ScriptEngine;
     friend class Object;
@@ -24,25 +24,46 @@
 ****************************************************************************/
 
 #include "HelperMacros.h"
+#include "base/Macros.h"
 
 #if defined(RECORD_JSB_INVOKING)
 
 namespace {
-bool cmp(const std::pair<const char *, std::tuple<int, uint64_t>> &a, const std::pair<const char *, std::tuple<int, uint64_t>> &b) {
-    return std::get<1>(a.second) > std::get<1>(b.second);
+unsigned int     __jsbInvocationCount;       // NOLINT(readability-identifier-naming)
+JsbInvokeRecord *__jsbInvokeRecords;         // NOLINT(readability-identifier-naming)
+bool             __jsbInvokeRecording{true}; // NOLINT(readability-identifier-naming)
+
+uint64_t elapsedNs(const std::chrono::time_point<std::chrono::high_resolution_clock> &start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
 }
-unsigned int                                                  __jsbInvocationCount;        // NOLINT(readability-identifier-naming)
-ccstd::unordered_map<char const *, std::tuple<int, uint64_t>> __jsbFunctionInvokedRecords; // NOLINT(readability-identifier-naming)
 } // namespace
 
-JsbInvokeScopeT::JsbInvokeScopeT(const char *functionName) : _functionName(functionName) {
-    _start = std::chrono::high_resolution_clock::now();
-    __jsbInvocationCount++;
+JsbInvokeRecord::JsbInvokeRecord(const char *name) : functionName(name), next(__jsbInvokeRecords) {
+    __jsbInvokeRecords = this;
+}
+
+JsbInvokeScopeT::JsbInvokeScopeT(JsbInvokeRecord *record) : _record(__jsbInvokeRecording ? record : nullptr) {
+    if (_record) {
+        _start = std::chrono::high_resolution_clock::now();
+        __jsbInvocationCount++;
+    }
 }
 JsbInvokeScopeT::~JsbInvokeScopeT() {
-    auto &ref = __jsbFunctionInvokedRecords[_functionName];
-    std::get<0>(ref) += 1;
-    std::get<1>(ref) += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _start).count();
+    if (_record) {
+        _record->count += 1;
+        _record->totalNs += elapsedNs(_start);
+    }
+}
+
+JsbConvertScopeT::JsbConvertScopeT(JsbInvokeRecord *record) : _record(__jsbInvokeRecording ? record : nullptr) {
+    if (_record) {
+        _start = std::chrono::high_resolution_clock::now();
+    }
+}
+JsbConvertScopeT::~JsbConvertScopeT() {
+    if (_record) {
+        _record->convertNs += elapsedNs(_start);
+    }
 }
 
 #endif
@@ -60,23 +81,60 @@ void printJSBInvokeAtFrame(int n) {
 void clearRecordJSBInvoke() {
 #if defined(RECORD_JSB_INVOKING)
     __jsbInvocationCount = 0;
-    __jsbFunctionInvokedRecords.clear();
+    // records are function-local statics, reset them in place rather than unlinking
+    for (auto *record = __jsbInvokeRecords; record; record = record->next) {
+        record->count     = 0;
+        record->totalNs   = 0;
+        record->convertNs = 0;
+    }
 #endif
 }
 
 void printJSBInvoke() {
 #if defined(RECORD_JSB_INVOKING)
-    static ccstd::vector<std::pair<const char *, std::tuple<int, uint64_t>>> pairs;
-    for (const auto &it : __jsbFunctionInvokedRecords) {
-        pairs.emplace_back(it); //NOLINT
-    }
-
-    std::sort(pairs.begin(), pairs.end(), cmp);
+    const auto stats = getJSBInvokeStats(UINT32_MAX);
     cc::Log::logMessage(cc::LogType::KERNEL, cc::LogLevel::LEVEL_DEBUG, "Start print JSB function record info....... %d times", __jsbInvocationCount);
-    for (const auto &pair : pairs) {
-        cc::Log::logMessage(cc::LogType::KERNEL, cc::LogLevel::LEVEL_DEBUG, "\t%s takes %.3lf ms, invoked %u times,", pair.first, std::get<1>(pair.second) / 1000000.0, std::get<0>(pair.second));
+    for (const auto &stat : stats) {
+        cc::Log::logMessage(cc::LogType::KERNEL, cc::LogLevel::LEVEL_DEBUG, "\t%s takes %.3lf ms (args %.3lf ms), invoked %u times, %.3lf us per call",
+                            stat.functionName, stat.totalNs / 1000000.0, stat.convertNs / 1000000.0, stat.count, stat.totalNs / 1000.0 / stat.count);
     }
-    pairs.clear();
     cc::Log::logMessage(cc::LogType::KERNEL, cc::LogLevel::LEVEL_DEBUG, "End print JSB function record info.......\n");
 #endif
 }
+
+void setJSBInvokeRecordingEnabled(bool enabled) {
+#if defined(RECORD_JSB_INVOKING)
+    __jsbInvokeRecording = enabled;
+#else
+    CC_UNUSED_PARAM(enabled);
+#endif
+}
+
+bool isJSBInvokeRecordingEnabled() {
+#if defined(RECORD_JSB_INVOKING)
+    return __jsbInvokeRecording;
+#else
+    return false;
+#endif
+}
+
+ccstd::vector<JsbInvokeStat> getJSBInvokeStats(uint32_t maxCount) {
+    ccstd::vector<JsbInvokeStat> stats;
+#if defined(RECORD_JSB_INVOKING)
+    for (const auto *record = __jsbInvokeRecords; record; record = record->next) {
+        if (record->count > 0) {
+            stats.push_back({record->functionName, record->count, record->totalNs, record->convertNs});
+        }
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const JsbInvokeStat &a, const JsbInvokeStat &b) {
+        return a.totalNs > b.totalNs;
+    });
+    if (stats.size() > maxCount) {
+        stats.resize(maxCount);
+    }
+#else
+    CC_UNUSED_PARAM(maxCount);
+#endif
+    return stats;
+}
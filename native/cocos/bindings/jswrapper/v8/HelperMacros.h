@@ -36,6 +36,7 @@
 #include "../config.h"
 #include "base/Log.h"
 #include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 
 //#define RECORD_JSB_INVOKING
 
@@ -47,21 +48,54 @@
 
     #if defined(RECORD_JSB_INVOKING)
 
+// one record per binding, created on the first call and linked into a global list
+struct JsbInvokeRecord {
+    explicit JsbInvokeRecord(const char *name);
+
+    const char *     functionName{nullptr};
+    uint32_t         count{0};
+    uint64_t         totalNs{0};
+    uint64_t         convertNs{0}; // time spent converting the arguments to se::Value
+    JsbInvokeRecord *next{nullptr};
+};
+
 class JsbInvokeScopeT {
 public:
-    JsbInvokeScopeT(const char *functionName);
+    explicit JsbInvokeScopeT(JsbInvokeRecord *record);
     ~JsbInvokeScopeT();
 
 private:
-    const char *                                                _functionName;
+    JsbInvokeRecord *                                           _record;
+    std::chrono::time_point<std::chrono::high_resolution_clock> _start;
+};
+
+class JsbConvertScopeT {
+public:
+    explicit JsbConvertScopeT(JsbInvokeRecord *record);
+    ~JsbConvertScopeT();
+
+private:
+    JsbInvokeRecord *                                           _record;
     std::chrono::time_point<std::chrono::high_resolution_clock> _start;
 };
-        #define JsbInvokeScope(arg) JsbInvokeScopeT invokeScope(arg); // NOLINT(readability-identifier-naming)
+
+        // NOLINTNEXTLINE(readability-identifier-naming)
+        #define JsbInvokeScope(arg)                        \
+            static JsbInvokeRecord jsbInvokeRecord{(arg)}; \
+            JsbInvokeScopeT        invokeScope(&jsbInvokeRecord);
+        // NOLINTNEXTLINE(readability-identifier-naming)
+        #define JsbConvertArgs(expr)                             \
+            {                                                    \
+                JsbConvertScopeT convertScope(&jsbInvokeRecord); \
+                expr;                                            \
+            }
     #else
         // NOLINTNEXTLINE(readability-identifier-naming)
         #define JsbInvokeScope(arg) \
             do {                    \
             } while (0)
+        // NOLINTNEXTLINE(readability-identifier-naming)
+        #define JsbConvertArgs(expr) expr
 
     #endif
 
@@ -86,6 +120,24 @@ void printJSBInvoke();
 
 void printJSBInvokeAtFrame(int n);
 
+struct JsbInvokeStat {
+    const char *functionName{nullptr};
+    uint32_t    count{0};
+    uint64_t    totalNs{0};
+    uint64_t    convertNs{0};
+};
+
+/**
+ * Recording is compiled in with RECORD_JSB_INVOKING, and can then be paused at runtime,
+ * a paused binding only pays for a boolean check.
+ */
+void setJSBInvokeRecordingEnabled(bool enabled);
+
+bool isJSBInvokeRecordingEnabled();
+
+// the `maxCount` bindings with the most cumulative time, empty if RECORD_JSB_INVOKING is off
+ccstd::vector<JsbInvokeStat> getJSBInvokeStats(uint32_t maxCount);
+
     #ifdef __GNUC__
         #define SE_UNUSED __attribute__((unused))
     #else
@@ -113,7 +165,7 @@ void printJSBInvokeAtFrame(int n);
             v8::HandleScope        _hs(_isolate);                                                                                               \
             se::ValueArray &       args = se::gValueArrayPool.get(_v8args.Length());                                                            \
             se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                                                                \
-            se::internal::jsToSeArgs(_v8args, args);                                                                                            \
+            JsbConvertArgs(se::internal::jsToSeArgs(_v8args, args));                                                                            \
             se::PrivateObjectBase *privateObject = static_cast<se::PrivateObjectBase *>(se::internal::getPrivate(_isolate, _v8args.This(), 0)); \
             se::Object *           thisObject    = reinterpret_cast<se::Object *>(se::internal::getPrivate(_isolate, _v8args.This(), 1));       \
             se::State              state(thisObject, privateObject, args);                                                                      \
@@ -130,6 +182,26 @@ void printJSBInvokeAtFrame(int n);
             funcName(privateObject->getRaw());                                                                                 \
         }
 
+    // for bindings taking only numbers, booleans or number arrays, skips se::Value construction entirely
+    #define SE_BIND_FUNC_FAST_NUMBERS(funcName)                                                                                         \
+        void funcName##Registry(const v8::FunctionCallbackInfo<v8::Value> &_v8args) {                                                   \
+            auto *         privateObject = static_cast<se::PrivateObjectBase *>(_v8args.This()->GetAlignedPointerFromInternalField(0)); \
+            se::NumberArgs args;                                                                                                        \
+            if (!se::internal::jsToNumberArgs(_v8args, &args) || !funcName(privateObject->getRaw(), args)) {                            \
+                SE_LOGE("[ERROR] Failed to invoke %s, location: %s:%d\n", #funcName, __FILE__, __LINE__);                               \
+            }                                                                                                                           \
+        }
+
+    #if SE_ENABLE_FAST_API_CALLS
+        // funcName##Fast takes the receiver, primitive arguments and v8::FastApiCallbackOptions &, see se::internal::fastThisObject
+        #define SE_BIND_FAST_FUNC(funcName) \
+            const v8::CFunction funcName##FastRegistry = v8::CFunction::Make(funcName##Fast);
+        #define _SE_FAST(name) (&name##FastRegistry) // NOLINT(readability-identifier-naming, bugprone-reserved-identifier)
+    #else
+        #define SE_BIND_FAST_FUNC(funcName)
+        #define _SE_FAST(name) nullptr // NOLINT(readability-identifier-naming, bugprone-reserved-identifier)
+    #endif
+
     #define SE_BIND_FINALIZE_FUNC(funcName)                                                               \
         void funcName##Registry(se::PrivateObjectBase *privateObject) {                                   \
             JsbInvokeScope(#funcName);                                                                    \
@@ -157,7 +229,7 @@ void printJSBInvokeAtFrame(int n);
             bool                   ret  = true;                                                           \
             se::ValueArray &       args = se::gValueArrayPool.get(_v8args.Length());                      \
             se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                          \
-            se::internal::jsToSeArgs(_v8args, args);                                                      \
+            JsbConvertArgs(se::internal::jsToSeArgs(_v8args, args));                                      \
             se::Object *thisObject = se::Object::_createJSObject(cls, _v8args.This());                    \
             thisObject->_setFinalizeCallback(_SE(finalizeCb));                                            \
             se::State state(thisObject, args);                                                            \
@@ -201,7 +273,7 @@ void printJSBInvokeAtFrame(int n);
             se::ValueArray &       args          = se::gValueArrayPool.get(1);                                                                            \
             se::CallbackDepthGuard depthGuard{args, se::gValueArrayPool._depth};                                                                          \
             se::Value &            data{args[0]};                                                                                                         \
-            se::internal::jsToSeValue(_isolate, _value, &data);                                                                                           \
+            JsbConvertArgs(se::internal::jsToSeValue(_isolate, _value, &data));                                                                           \
             se::State state(thisObject, privateObject, args);                                                                                             \
             ret = funcName(state);                                                                                                                        \
             if (!ret) {                                                                                                                                   \
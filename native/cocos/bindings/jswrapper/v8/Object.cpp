@@ -46,6 +46,10 @@ std::unique_ptr<ccstd::unordered_map<Object *, void *>> __objectMap; // Currentl
 
 namespace {
 v8::Isolate *__isolate = nullptr; //NOLINT
+// wrappers collected by GC whose native objects are released in Object::flushPendingFinalizers
+ccstd::vector<Object *> pendingFinalizeObjects;
+ccstd::vector<Object *> finalizingObjects;
+bool                    deferredFinalizeEnabled{true};
     #if CC_DEBUG_JS_OBJECT_ID && CC_DEBUG
 uint32_t nativeObjectId = 0;
     #endif
@@ -83,6 +87,17 @@ void Object::nativeObjectFinalizeHook(Object *seObj) {
         }
     }
 
+    // objects keeping their mapping are looked up by their own finalizers, release them right away
+    if (deferredFinalizeEnabled && seObj->_clearMappingInFinalizer && !ScriptEngine::getInstance()->isInCleanup()) {
+        pendingFinalizeObjects.push_back(seObj);
+        return;
+    }
+
+    finalizeNativeObject(seObj);
+}
+
+/* static */
+void Object::finalizeNativeObject(Object *seObj) {
     if (seObj->_finalizeCb != nullptr) {
         seObj->_finalizeCb(seObj->_privateObject);
     } else {
@@ -93,6 +108,26 @@ void Object::nativeObjectFinalizeHook(Object *seObj) {
     seObj->decRef();
 }
 
+/* static */
+void Object::setDeferredFinalizeEnabled(bool enabled) {
+    deferredFinalizeEnabled = enabled;
+    if (!enabled) {
+        flushPendingFinalizers();
+    }
+}
+
+/* static */
+void Object::flushPendingFinalizers() {
+    // finalizers may release other wrappers, which are queued again and handled by the next round
+    while (!pendingFinalizeObjects.empty()) {
+        finalizingObjects.swap(pendingFinalizeObjects);
+        for (auto *seObj : finalizingObjects) {
+            finalizeNativeObject(seObj);
+        }
+        finalizingObjects.clear();
+    }
+}
+
 /* static */
 void Object::setIsolate(v8::Isolate *isolate) {
     __isolate = isolate;
@@ -103,6 +138,8 @@ void Object::setup() {
 }
 
 void Object::cleanup() {
+    flushPendingFinalizers();
+
     void *  nativeObj = nullptr;
     Object *obj       = nullptr;
     Class * cls       = nullptr;
@@ -449,6 +486,8 @@ bool Object::setProperty(const char *name, const Value &data) {
 }
 
 bool Object::defineProperty(const char *name, v8::AccessorNameGetterCallback getter, v8::AccessorNameSetterCallback setter) {
+    ScriptEngine::getInstance()->_registerExternalReference(getter);
+    ScriptEngine::getInstance()->_registerExternalReference(setter);
     v8::MaybeLocal<v8::String> nameValue = v8::String::NewFromUtf8(__isolate, name, v8::NewStringType::kNormal);
     if (nameValue.IsEmpty()) {
         return false;
@@ -670,6 +709,7 @@ bool Object::call(const ValueArray &args, Object *thisObject, Value *rval /* = n
 }
 
 bool Object::defineFunction(const char *funcName, void (*func)(const v8::FunctionCallbackInfo<v8::Value> &args)) {
+    ScriptEngine::getInstance()->_registerExternalReference(func);
     v8::MaybeLocal<v8::String> maybeFuncName = v8::String::NewFromUtf8(__isolate, funcName, v8::NewStringType::kNormal);
     if (maybeFuncName.IsEmpty()) {
         return false;
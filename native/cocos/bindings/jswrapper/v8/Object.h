@@ -335,6 +335,17 @@ public:
      */
     void setClearMappingInFinalizer(bool v) { _clearMappingInFinalizer = v; }
 
+    /**
+     * @brief Sets whether native objects of collected wrappers are released in one pass per frame rather than inside the GC pause.
+     * @note The (native object & se::Object) mapping is still cleared right away, enabled by default.
+     */
+    static void setDeferredFinalizeEnabled(bool enabled);
+
+    /**
+     * @brief Releases the native objects of all wrappers collected since the last call, ScriptEngine calls it once per frame.
+     */
+    static void flushPendingFinalizers();
+
     /**
          *  @brief Roots an object from garbage collection.
          *  @note Use this method when you want to store an object in a global or on the heap, where the garbage collector will not be able to discover your reference to it.
@@ -445,6 +456,7 @@ public:
 
 private:
     static void nativeObjectFinalizeHook(Object *seObj);
+    static void finalizeNativeObject(Object *seObj);
     static void setIsolate(v8::Isolate *isolate);
     static void cleanup();
     static void setup();
@@ -27,15 +27,19 @@
 
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
 
+    #include "../HandleObject.h"
     #include "../MappingUtils.h"
     #include "../State.h"
     #include "Class.h"
     #include "MissingSymbols.h"
     #include "Object.h"
     #include "Utils.h"
+    #include "base/memory/MemoryAccounting.h"
     #include "base/std/container/unordered_map.h"
     #include "platform/FileUtils.h"
 
+    #include <cstdio>
+    #include <memory>
     #include <sstream>
 
     #if SE_ENABLE_INSPECTOR
@@ -51,6 +55,26 @@
 
 const unsigned int JSB_STACK_FRAME_LIMIT = 20;
 
+// Scripts smaller than this are parsed fast enough without code cache
+const ssize_t     CODE_CACHE_MIN_SCRIPT_LENGTH = 16 * 1024;
+const int         CODE_CACHE_WARMUP_SECONDS    = 5;
+const char *const CODE_CACHE_DIRECTORY         = "jsb-code-cache/";
+
+// The original console functions are kept on console in a startup snapshot, which already has the jsb ones installed
+const char *const CONSOLE_ORIGIN_KEY = "__jsb_console_origin__";
+
+const char SNAPSHOT_MAGIC[8] = {'J', 'S', 'B', 'S', 'N', 'A', 'P', '1'};
+
+// Layout of a startup snapshot file: header | int64 external reference offsets | v8 blob
+struct SnapshotFileHeader {
+    char     magic[8];
+    char     v8Version[32];
+    uint32_t referenceCount;
+    uint32_t templateCount;
+    uint64_t blobSize;
+    uint64_t blobHash;
+};
+
     #ifdef CC_DEBUG
 unsigned int                                  jsbInvocationCount = 0;
 ccstd::unordered_map<ccstd::string, unsigned> jsbFunctionInvokedRecords;
@@ -214,6 +238,9 @@ public:
         #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS)
         flags.append(" --jitless");
         #endif
+        #if SE_ENABLE_FAST_API_CALLS
+        flags.append(" --turbo-fast-api-calls");
+        #endif
         if (!flags.empty()) {
             v8::V8::SetFlagsFromString(flags.c_str(), static_cast<int>(flags.length()));
         }
@@ -498,10 +525,12 @@ ScriptEngine::ScriptEngine()
   ,
   _debuggerServerPort(0),
   _vmId(0),
+  _memoryProbeId(0),
   _isValid(false),
   _isGarbageCollecting(false),
   _isInCleanup(false),
-  _isErrorHandleWorking(false) {
+  _isErrorHandleWorking(false),
+  _codeCacheEnabled(SE_ENABLE_CODE_CACHE != 0) {
     #if !CC_EDITOR
     if (!gSharedV8) {
         gSharedV8 = new ScriptEngineV8Context();
@@ -519,6 +548,8 @@ bool ScriptEngine::postInit() {
     _isolate->SetOOMErrorHandler(onOOMErrorCallback);
     _isolate->AddMessageListener(onMessageCallback);
     _isolate->SetPromiseRejectCallback(onPromiseRejectCallback);
+    _isolate->AddGCPrologueCallback(onGCPrologueCallback, this);
+    _isolate->AddGCEpilogueCallback(onGCEpilogueCallback, this);
 
     NativePtrToObjectMap::init();
     Object::setup();
@@ -531,22 +562,38 @@ bool ScriptEngine::postInit() {
 
     se::Value consoleVal;
     if (_globalObj->getProperty("console", &consoleVal) && consoleVal.isObject()) {
-        consoleVal.toObject()->getProperty("log", &oldConsoleLog);
+        se::Object *origin = consoleVal.toObject();
+        se::Value   originVal;
+        if (_snapshotMode != SnapshotMode::NONE) {
+            if (!origin->getProperty(CONSOLE_ORIGIN_KEY, &originVal) || !originVal.isObject()) {
+                se::HandleObject originObj(se::Object::createPlainObject());
+                for (const char *name : {"log", "debug", "info", "warn", "error", "assert"}) {
+                    se::Value func;
+                    origin->getProperty(name, &func);
+                    originObj->setProperty(name, func);
+                }
+                originVal.setObject(originObj);
+                origin->defineOwnProperty(CONSOLE_ORIGIN_KEY, originVal, false, false, false);
+            }
+            origin = originVal.toObject();
+        }
+
+        origin->getProperty("log", &oldConsoleLog);
         consoleVal.toObject()->defineFunction("log", _SE(jsbConsoleLog));
 
-        consoleVal.toObject()->getProperty("debug", &oldConsoleDebug);
+        origin->getProperty("debug", &oldConsoleDebug);
         consoleVal.toObject()->defineFunction("debug", _SE(jsbConsoleDebug));
 
-        consoleVal.toObject()->getProperty("info", &oldConsoleInfo);
+        origin->getProperty("info", &oldConsoleInfo);
         consoleVal.toObject()->defineFunction("info", _SE(jsbConsoleInfo));
 
-        consoleVal.toObject()->getProperty("warn", &oldConsoleWarn);
+        origin->getProperty("warn", &oldConsoleWarn);
         consoleVal.toObject()->defineFunction("warn", _SE(jsbConsoleWarn));
 
-        consoleVal.toObject()->getProperty("error", &oldConsoleError);
+        origin->getProperty("error", &oldConsoleError);
         consoleVal.toObject()->defineFunction("error", _SE(jsbConsoleError));
 
-        consoleVal.toObject()->getProperty("assert", &oldConsoleAssert);
+        origin->getProperty("assert", &oldConsoleAssert);
         consoleVal.toObject()->defineFunction("assert", _SE(jsbConsoleAssert));
     }
 
@@ -562,6 +609,14 @@ bool ScriptEngine::postInit() {
         _gcFunc = nullptr;
     }
 
+    #if CC_USE_MEMORY_ACCOUNTING
+    _memoryProbeId = cc::MemoryAccounting::getInstance().addProbe(cc::MemoryTag::SCRIPT, [this]() -> uint64_t {
+        v8::HeapStatistics stats;
+        _isolate->GetHeapStatistics(&stats);
+        return stats.used_heap_size() + stats.external_memory();
+    });
+    #endif
+
     _isValid = true;
 
     for (const auto &hook : _afterInitHookArray) {
@@ -593,10 +648,19 @@ bool ScriptEngine::init(v8::Isolate *isolate) {
         v8::Local<v8::Context> context = _isolate->GetCurrentContext();
         _context.Reset(_isolate, context);
         _context.Get(isolate)->Enter();
+    } else if (_snapshotCreator != nullptr) {
+        _isolate = _snapshotCreator->GetIsolate();
+        v8::HandleScope hs(_isolate);
+        _context.Reset(_isolate, v8::Context::New(_isolate));
+        _context.Get(_isolate)->Enter();
     } else {
         v8::Isolate::CreateParams createParams;
         createParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
-        _isolate                            = v8::Isolate::New(createParams);
+        if (_snapshotMode == SnapshotMode::RESTORE) {
+            createParams.snapshot_blob       = &_snapshotBlob;
+            createParams.external_references = _externalReferences.data();
+        }
+        _isolate = v8::Isolate::New(createParams);
         v8::HandleScope hs(_isolate);
         _context.Reset(_isolate, v8::Context::New(_isolate));
         _context.Get(_isolate)->Enter();
@@ -611,8 +675,15 @@ void ScriptEngine::cleanup() {
     }
 
     SE_LOGD("ScriptEngine::cleanup begin ...\n");
+    saveCodeCache();
     _isInCleanup = true;
 
+    #if CC_USE_MEMORY_ACCOUNTING
+    cc::MemoryAccounting::getInstance().removeProbe(_memoryProbeId);
+    cc::MemoryAccounting::getInstance().setUsage(cc::MemoryTag::SCRIPT, 0);
+    _memoryProbeId = 0;
+    #endif
+
     {
         AutoHandleScope hs;
         for (const auto &hook : _beforeCleanupHookArray) {
@@ -653,11 +724,20 @@ void ScriptEngine::cleanup() {
         }
     #endif
 
+        _gcFuncValue.setUndefined();
         _context.Get(_isolate)->Exit();
         _context.Reset();
         _isolate->Exit();
     }
-    _isolate->Dispose();
+    // The isolate of a snapshot creator is disposed with it
+    if (_snapshotCreator == nullptr) {
+        _isolate->Dispose();
+    }
+    if (_snapshotMode == SnapshotMode::NONE) {
+        _snapshotData.clear();
+        _externalReferences.clear();
+        _snapshotBlob = {nullptr, 0};
+    }
 
     _isolate   = nullptr;
     _globalObj = nullptr;
@@ -735,6 +815,9 @@ bool ScriptEngine::callRegisteredCallback() {
 }
 
 bool ScriptEngine::start() {
+    if (!_snapshotPath.empty() && !isDebuggerEnabled() && startFromSnapshot()) {
+        return true;
+    }
     if (!init()) {
         return false;
     }
@@ -769,11 +852,59 @@ bool ScriptEngine::start(v8::Isolate *isolate) {
 void ScriptEngine::garbageCollect() {
     int objSize = __objectMap ? static_cast<int>(__objectMap->size()) : -1;
     SE_LOGD("GC begin ..., (js->native map) size: %d, all objects: %d\n", (int)NativePtrToObjectMap::size(), objSize);
-    _gcFunc->call({}, nullptr);
+    if (_gcFunc != nullptr) {
+        _gcFunc->call({}, nullptr);
+    } else {
+        // The gc extension isn't installed in a heap which is going to be serialized
+        _isolate->LowMemoryNotification();
+    }
+    Object::flushPendingFinalizers();
     objSize = __objectMap ? static_cast<int>(__objectMap->size()) : -1;
     SE_LOGD("GC end ..., (js->native map) size: %d, all objects: %d\n", (int)NativePtrToObjectMap::size(), objSize);
 }
 
+bool ScriptEngine::idleNotification(double budgetInSeconds) {
+    if (!_isValid || budgetInSeconds <= 0.0) {
+        return true;
+    }
+
+    bool done = true;
+    #if !CC_EDITOR
+    // the deadline is in the time base of the platform
+    done = _isolate->IdleNotificationDeadline(gSharedV8->platform->MonotonicallyIncreasingTime() + budgetInSeconds);
+    _frameGCStats.idleTime += static_cast<float>(budgetInSeconds * 1000.0);
+    #endif
+    return done;
+}
+
+void ScriptEngine::memoryPressureNotification(bool critical) {
+    if (_isValid) {
+        _isolate->MemoryPressureNotification(critical ? v8::MemoryPressureLevel::kCritical : v8::MemoryPressureLevel::kModerate);
+    }
+}
+
+void ScriptEngine::beginFrameGCStats() {
+    _lastFrameGCStats = _frameGCStats;
+    _frameGCStats     = {};
+}
+
+void ScriptEngine::onGCPrologueCallback(v8::Isolate * /*isolate*/, v8::GCType /*type*/, v8::GCCallbackFlags /*flags*/, void *data) {
+    auto *engine = static_cast<ScriptEngine *>(data);
+    if (engine->_gcDepth++ == 0) {
+        engine->_gcStartTime = std::chrono::steady_clock::now();
+    }
+}
+
+void ScriptEngine::onGCEpilogueCallback(v8::Isolate * /*isolate*/, v8::GCType /*type*/, v8::GCCallbackFlags /*flags*/, void *data) {
+    auto *engine = static_cast<ScriptEngine *>(data);
+    if (engine->_gcDepth == 0 || --engine->_gcDepth > 0) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - engine->_gcStartTime).count();
+    engine->_frameGCStats.count++;
+    engine->_frameGCStats.pauseTime += static_cast<float>(elapsed) / 1000.F;
+}
+
 bool ScriptEngine::isGarbageCollecting() const {
     return _isGarbageCollecting;
 }
@@ -825,7 +956,12 @@ bool ScriptEngine::evalString(const char *script, ssize_t length /* = -1 */, Val
     }
 
     v8::ScriptOrigin           origin(_isolate, originStr.ToLocalChecked());
-    v8::MaybeLocal<v8::Script> maybeScript = v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+    v8::MaybeLocal<v8::Script> maybeScript;
+    if (_codeCacheEnabled && length >= CODE_CACHE_MIN_SCRIPT_LENGTH) {
+        maybeScript = compileWithCodeCache(source.ToLocalChecked(), origin, script, length);
+    } else {
+        maybeScript = v8::Script::Compile(_context.Get(_isolate), source.ToLocalChecked(), &origin);
+    }
 
     bool success = false;
 
@@ -933,6 +1069,81 @@ bool ScriptEngine::saveByteCodeToFile(const ccstd::string &path, const ccstd::st
     return success;
 }
 
+v8::MaybeLocal<v8::Script> ScriptEngine::compileWithCodeCache(v8::Local<v8::String> source, const v8::ScriptOrigin &origin, const char *script, ssize_t length) {
+    // Key the cache by the content, so that a hot updated script never consumes the cache of its previous version
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a
+    for (ssize_t i = 0; i < length; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(script[i])) * 1099511628211ULL;
+    }
+    char name[40];
+    snprintf(name, sizeof(name), "%016llx-%x.cache", static_cast<unsigned long long>(hash), static_cast<uint32_t>(length));
+    auto *        fu   = cc::FileUtils::getInstance();
+    ccstd::string path = fu->getWritablePath() + CODE_CACHE_DIRECTORY + name;
+
+    v8::Local<v8::Context>     context = _context.Get(_isolate);
+    v8::MaybeLocal<v8::Script> maybeScript;
+    cc::Data                   cachedData;
+    if (fu->isFileExist(path) && fu->getContents(path, &cachedData) == cc::FileUtils::Status::OK && !cachedData.isNull()) {
+        // The buffer is not owned by v8, cachedData outlives the compilation
+        auto *                     v8CacheData = new v8::ScriptCompiler::CachedData(cachedData.getBytes(), static_cast<int>(cachedData.getSize()));
+        v8::ScriptCompiler::Source cacheSource(source, origin, v8CacheData);
+        maybeScript = v8::ScriptCompiler::Compile(context, &cacheSource, v8::ScriptCompiler::kConsumeCodeCache);
+        if (!cacheSource.GetCachedData()->rejected) {
+            return maybeScript;
+        }
+        // Produced by another version of v8 or with other flags, v8 compiled the source instead
+        SE_LOGD("ScriptEngine::evalString code cache of %s rejected\n", name);
+        fu->removeFile(path);
+    } else {
+        v8::ScriptCompiler::Source noCacheSource(source, origin);
+        maybeScript = v8::ScriptCompiler::Compile(context, &noCacheSource, v8::ScriptCompiler::kNoCompileOptions);
+    }
+
+    v8::Local<v8::Script> v8Script;
+    if (maybeScript.ToLocal(&v8Script)) {
+        _pendingCodeCaches.push_back({path, std::make_unique<v8::Persistent<v8::UnboundScript>>(_isolate, v8Script->GetUnboundScript()), std::chrono::steady_clock::now()});
+    }
+    return maybeScript;
+}
+
+void ScriptEngine::saveCodeCache() {
+    saveCodeCache(false);
+}
+
+void ScriptEngine::saveCodeCache(bool warmedUpOnly) {
+    if (_pendingCodeCaches.empty()) {
+        return;
+    }
+
+    // The cache is produced after the scripts ran, so it also covers the functions compiled lazily during warm-up
+    auto now   = std::chrono::steady_clock::now();
+    auto first = _pendingCodeCaches.begin();
+    auto last  = first;
+    while (last != _pendingCodeCaches.end() && (!warmedUpOnly || now - last->evalTime >= std::chrono::seconds(CODE_CACHE_WARMUP_SECONDS))) {
+        ++last;
+    }
+    if (first == last) {
+        return;
+    }
+
+    auto *fu = cc::FileUtils::getInstance();
+    fu->createDirectory(fu->getWritablePath() + CODE_CACHE_DIRECTORY);
+    v8::HandleScope handleScope(_isolate);
+    for (auto it = first; it != last; ++it) {
+        v8::ScriptCompiler::CachedData *cd = v8::ScriptCompiler::CreateCodeCache(it->script->Get(_isolate));
+        if (cd != nullptr) {
+            cc::Data writeData;
+            writeData.copy(cd->data, cd->length);
+            if (!fu->writeDataToFile(writeData, it->path)) {
+                SE_LOGE("ScriptEngine::saveCodeCache failed to write %s\n", it->path.c_str());
+            }
+            delete cd;
+        }
+        it->script->Reset();
+    }
+    _pendingCodeCaches.erase(first, last);
+}
+
 bool ScriptEngine::runByteCodeFile(const ccstd::string &pathBc, Value *ret /* = nullptr */) {
     auto *fu = cc::FileUtils::getInstance();
 
@@ -1039,6 +1250,241 @@ bool ScriptEngine::runScript(const ccstd::string &path, Value *ret /* = nullptr
     return false;
 }
 
+namespace {
+uint64_t snapshotHash(const char *data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+intptr_t externalReferenceBase() {
+    // Offsets from a function of this module don't change between launches of the same build
+    return reinterpret_cast<intptr_t>(&ScriptEngine::getInstance);
+}
+
+v8::StartupData serializeInternalField(v8::Local<v8::Object> holder, int index, void *data) {
+    if (holder->GetAlignedPointerFromInternalField(index) != nullptr) {
+        *static_cast<bool *>(data) = true;
+    }
+    return {nullptr, 0};
+}
+} // namespace
+
+void ScriptEngine::registerExternalReference(intptr_t ref) {
+    if (!_seenExternalReferences.insert(ref).second) {
+        return;
+    }
+    if (_snapshotMode == SnapshotMode::COLLECT) {
+        _externalReferences.push_back(ref);
+        return;
+    }
+
+    // The bindings are registered in the same order as when the references were listed
+    size_t count = _externalReferences.size() - 1; // null terminated
+    if (_externalReferenceIndex < count && _externalReferences[_externalReferenceIndex] == ref) {
+        ++_externalReferenceIndex;
+        return;
+    }
+    _snapshotMismatch = true;
+    if (_snapshotMode == SnapshotMode::CREATE && std::find(_externalReferences.begin(), _externalReferences.end(), ref) == _externalReferences.end()) {
+        // The serializer aborts on an unknown reference, the table is reserved so that v8 keeps pointing to it
+        if (_externalReferences.size() < _externalReferences.capacity()) {
+            _externalReferences.back() = ref;
+            _externalReferences.push_back(0);
+        } else {
+            _snapshotUnknownReference = true;
+        }
+    }
+}
+
+v8::MaybeLocal<v8::FunctionTemplate> ScriptEngine::_getSnapshotTemplate() { // NOLINT(readability-identifier-naming)
+    if (_snapshotTemplateIndex >= _snapshotTemplateCount) {
+        _snapshotMismatch = true;
+        return {};
+    }
+    v8::MaybeLocal<v8::FunctionTemplate> ret = _isolate->GetDataFromSnapshotOnce<v8::FunctionTemplate>(_snapshotTemplateIndex++);
+    if (ret.IsEmpty()) {
+        _snapshotMismatch = true;
+    }
+    return ret;
+}
+
+bool ScriptEngine::createStartupSnapshot(const ccstd::string &path, const ccstd::vector<ccstd::string> &scripts /* = {}*/) {
+    if (_isValid) {
+        SE_LOGE("ScriptEngine::createStartupSnapshot should be invoked before start\n");
+        return false;
+    }
+
+    // Both passes consume the callbacks and hooks, which are needed by start afterwards
+    auto registerCallbacks = _registerCallbackArray;
+    auto beforeInitHooks   = _beforeInitHookArray;
+    auto afterInitHooks    = _afterInitHookArray;
+    auto restoreCallbacks  = [&]() {
+        _registerCallbackArray = registerCallbacks;
+        _beforeInitHookArray   = beforeInitHooks;
+        _afterInitHookArray    = afterInitHooks;
+    };
+
+    // List the native callbacks referenced by the bindings, the snapshot creator needs them before the bindings are registered
+    _externalReferences.clear();
+    _seenExternalReferences.clear();
+    _snapshotMode = SnapshotMode::COLLECT;
+    bool ok       = init() && callRegisteredCallback();
+    cleanup();
+    restoreCallbacks();
+    size_t referenceCount = _externalReferences.size();
+    _externalReferences.reserve(referenceCount * 2 + 64);
+    _externalReferences.push_back(0);
+
+    _seenExternalReferences.clear();
+    _externalReferenceIndex   = 0;
+    _snapshotMismatch         = false;
+    _snapshotUnknownReference = false;
+    _snapshotMode             = SnapshotMode::CREATE;
+    _snapshotCreator          = new v8::SnapshotCreator(_externalReferences.data());
+    ok                        = ok && init() && callRegisteredCallback();
+    for (const auto &script : scripts) {
+        ok = ok && runScript(script);
+    }
+    ok = ok && !_snapshotMismatch && _externalReferenceIndex == referenceCount;
+
+    size_t templateCount    = 0;
+    bool   hasNativeObjects = false;
+    if (_isValid) {
+        v8::HandleScope hs(_isolate);
+        templateCount = Class::addTemplatesToSnapshot(_snapshotCreator);
+        _snapshotCreator->SetDefaultContext(_context.Get(_isolate), v8::SerializeInternalFieldsCallback(serializeInternalField, &hasNativeObjects));
+    }
+    // All handles are released before serializing
+    cleanup();
+    restoreCallbacks();
+
+    v8::StartupData blob{nullptr, 0};
+    if (!_snapshotUnknownReference) {
+        blob = _snapshotCreator->CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+    }
+    delete _snapshotCreator;
+    _snapshotCreator = nullptr;
+    _snapshotMode    = SnapshotMode::NONE;
+
+    if (hasNativeObjects) {
+        SE_LOGE("ScriptEngine::createStartupSnapshot the heap contains native objects\n");
+        ok = false;
+    }
+    if (!ok || blob.data == nullptr) {
+        SE_LOGE("ScriptEngine::createStartupSnapshot failed, the bindings should be registered in the same order every time\n");
+        delete[] blob.data;
+        _externalReferences.clear();
+        return false;
+    }
+
+    SnapshotFileHeader header{};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    snprintf(header.v8Version, sizeof(header.v8Version), "%s", v8::V8::GetVersion());
+    header.referenceCount = static_cast<uint32_t>(referenceCount);
+    header.templateCount  = static_cast<uint32_t>(templateCount);
+    header.blobSize       = static_cast<uint64_t>(blob.raw_size);
+    header.blobHash       = snapshotHash(blob.data, blob.raw_size);
+
+    ccstd::vector<char> content(sizeof(header) + referenceCount * sizeof(int64_t) + blob.raw_size);
+    char *              p = content.data();
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    for (size_t i = 0; i < referenceCount; ++i) {
+        auto offset = static_cast<int64_t>(_externalReferences[i] - externalReferenceBase());
+        memcpy(p, &offset, sizeof(offset));
+        p += sizeof(offset);
+    }
+    memcpy(p, blob.data, blob.raw_size);
+    delete[] blob.data;
+    _externalReferences.clear();
+
+    cc::Data data;
+    data.copy(reinterpret_cast<unsigned char *>(content.data()), static_cast<ssize_t>(content.size()));
+    if (!cc::FileUtils::getInstance()->writeDataToFile(data, path)) {
+        SE_LOGE("ScriptEngine::createStartupSnapshot failed to write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ScriptEngine::loadStartupSnapshot() {
+    cc::Data data;
+    auto *   fu = cc::FileUtils::getInstance();
+    if (!fu->isFileExist(_snapshotPath) || fu->getContents(_snapshotPath, &data) != cc::FileUtils::Status::OK) {
+        return false;
+    }
+
+    SnapshotFileHeader header{};
+    auto               size = static_cast<size_t>(data.getSize());
+    if (size < sizeof(header)) {
+        return false;
+    }
+    const char *p = reinterpret_cast<const char *>(data.getBytes());
+    memcpy(&header, p, sizeof(header));
+    // v8 aborts on a blob of another version instead of rejecting it
+    header.v8Version[sizeof(header.v8Version) - 1] = '\0';
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || strcmp(header.v8Version, v8::V8::GetVersion()) != 0 ||
+        size != sizeof(header) + header.referenceCount * sizeof(int64_t) + header.blobSize) {
+        return false;
+    }
+    p += sizeof(header);
+
+    _externalReferences.clear();
+    _externalReferences.reserve(header.referenceCount + 1);
+    for (uint32_t i = 0; i < header.referenceCount; ++i) {
+        int64_t offset = 0;
+        memcpy(&offset, p, sizeof(offset));
+        p += sizeof(offset);
+        _externalReferences.push_back(externalReferenceBase() + static_cast<intptr_t>(offset));
+    }
+    _externalReferences.push_back(0);
+
+    if (snapshotHash(p, header.blobSize) != header.blobHash) {
+        _externalReferences.clear();
+        return false;
+    }
+    _snapshotData.assign(p, p + header.blobSize);
+    _snapshotBlob          = {_snapshotData.data(), static_cast<int>(_snapshotData.size())};
+    _snapshotTemplateCount = header.templateCount;
+    return true;
+}
+
+bool ScriptEngine::startFromSnapshot() {
+    if (!loadStartupSnapshot()) {
+        SE_LOGE("ScriptEngine::start can't load the startup snapshot %s\n", _snapshotPath.c_str());
+        return false;
+    }
+
+    auto registerCallbacks = _registerCallbackArray;
+    auto beforeInitHooks   = _beforeInitHookArray;
+    auto afterInitHooks    = _afterInitHookArray;
+
+    _seenExternalReferences.clear();
+    _externalReferenceIndex = 0;
+    _snapshotTemplateIndex  = 0;
+    _snapshotMismatch       = false;
+    _snapshotMode           = SnapshotMode::RESTORE;
+    // Registering the bindings again finds their templates in the heap, and checks that the callbacks are the ones listed in the snapshot
+    bool ok = init() && callRegisteredCallback();
+    ok      = ok && !_snapshotMismatch && _externalReferenceIndex == _externalReferences.size() - 1 && _snapshotTemplateIndex == _snapshotTemplateCount;
+    _snapshotMode = SnapshotMode::NONE;
+    _seenExternalReferences.clear();
+    if (ok) {
+        return true;
+    }
+
+    // None of the mismatching callbacks was invoked, no script has run yet
+    SE_LOGE("ScriptEngine::start the startup snapshot doesn't match this build, starting without it\n");
+    cleanup();
+    _registerCallbackArray = registerCallbacks;
+    _beforeInitHookArray   = beforeInitHooks;
+    _afterInitHookArray    = afterInitHooks;
+    return false;
+}
+
 void ScriptEngine::clearException() {
     //IDEA:
 }
@@ -1073,7 +1519,11 @@ bool ScriptEngine::isDebuggerEnabled() const {
 }
 
 void ScriptEngine::mainLoopUpdate() {
-    // empty implementation
+    Object::flushPendingFinalizers();
+
+    if (!_pendingCodeCaches.empty()) {
+        saveCodeCache(true);
+    }
 }
 
 bool ScriptEngine::callFunction(Object *targetObj, const char *funcName, uint32_t argc, Value *args, Value *rval /* = nullptr*/) {
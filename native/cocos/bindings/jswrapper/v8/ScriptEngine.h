@@ -32,6 +32,7 @@
 
     #include "../Value.h"
     #include "Base.h"
+    #include "base/std/container/unordered_set.h"
 
     #include <thread>
 
@@ -186,6 +187,37 @@ public:
      */
     bool saveByteCodeToFile(const ccstd::string &path, const ccstd::string &pathBc);
 
+    /**
+     *  @brief Enables or disables the code cache of evaluated scripts, enabled by default if SE_ENABLE_CODE_CACHE is on.
+     *  Large scripts are keyed by their content, their compiled code is saved in the writable path after a warm-up
+     *  and consumed instead of parsing the scripts again on next launches.
+     */
+    void setCodeCacheEnabled(bool enabled) { _codeCacheEnabled = enabled; }
+    bool isCodeCacheEnabled() const { return _codeCacheEnabled; }
+
+    /**
+     *  @brief Saves the code cache of all evaluated scripts which don't have one yet, it's done automatically after warm-up.
+     */
+    void saveCodeCache();
+
+    /**
+     *  @brief Creates a startup snapshot of the JavaScript heap with all registered bindings and the given scripts evaluated, and saves it to a file.
+     *  It should be invoked before `start`, the register callbacks are kept for it. The scripts must not create objects of native classes,
+     *  a heap which contains some can't be saved.
+     *  @param[in] path The location where the snapshot file should be written to.
+     *  @param[in] scripts The paths of the scripts to evaluate before taking the snapshot.
+     *  @return true if succeed, otherwise false.
+     */
+    bool createStartupSnapshot(const ccstd::string &path, const ccstd::vector<ccstd::string> &scripts = {});
+
+    /**
+     *  @brief Sets the startup snapshot which `start` deserializes the JavaScript heap and the binding templates from.
+     *  The binding classes are still registered in the same order, which checks the snapshot matches this build,
+     *  the engine starts without the snapshot otherwise.
+     *  @param[in] path The path of a file written by createStartupSnapshot, an empty path disables the snapshot.
+     */
+    void setStartupSnapshot(const ccstd::string &path) { _snapshotPath = path; }
+
     /**
      * @brief Grab a snapshot of the current JavaScript execution stack.
      * @return current stack trace string
@@ -251,6 +283,34 @@ public:
      */
     void garbageCollect();
 
+    struct GCStats {
+        uint32_t count{0};       // collections that finished during the frame
+        float    pauseTime{0.F}; // milliseconds the engine thread was paused by collections
+        float    idleTime{0.F};  // milliseconds of idle time handed to V8
+    };
+
+    /**
+     *  @brief Hands the spare time of a frame to V8, so incremental marking and sweeping run there instead of mid-frame.
+     *  @param[in] budgetInSeconds The time left before the next frame should start.
+     *  @return true if V8 has no more idle work to do.
+     */
+    bool idleNotification(double budgetInSeconds);
+
+    /**
+     *  @brief Tells V8 the system is short of memory, a critical level collects synchronously.
+     */
+    void memoryPressureNotification(bool critical);
+
+    /**
+     *  @brief Starts collecting GC stats of a new frame, the stats so far become the ones of the last frame.
+     */
+    void beginFrameGCStats();
+
+    /**
+     *  @brief GC stats of the last frame, including the idle time handed to V8 after it.
+     */
+    const GCStats &getFrameGCStats() const { return _lastFrameGCStats; }
+
     /**
      *  @brief Tests whether script engine is being cleaned up.
      *  @return true if it's in cleaning up, otherwise false.
@@ -344,6 +404,16 @@ public:
     v8::Local<v8::Context> _getContext() const;                             // NOLINT(readability-identifier-naming)
     void                   _setGarbageCollecting(bool isGarbageCollecting); // NOLINT(readability-identifier-naming)
 
+    // Native callbacks referenced by the JavaScript heap, they are listed in a startup snapshot
+    template <typename F>
+    void _registerExternalReference(F func) { // NOLINT(readability-identifier-naming)
+        if (_snapshotMode != SnapshotMode::NONE && func != nullptr) {
+            registerExternalReference(reinterpret_cast<intptr_t>(func));
+        }
+    }
+    bool                                 _isRestoringSnapshot() const { return _snapshotMode == SnapshotMode::RESTORE; } // NOLINT(readability-identifier-naming)
+    v8::MaybeLocal<v8::FunctionTemplate> _getSnapshotTemplate();                                                        // NOLINT(readability-identifier-naming)
+
     //
 private:
     ScriptEngine();
@@ -353,6 +423,8 @@ private:
     static void onOOMErrorCallback(const char *location, bool isHeapOom);
     static void onMessageCallback(v8::Local<v8::Message> message, v8::Local<v8::Value> data);
     static void onPromiseRejectCallback(v8::PromiseRejectMessage msg);
+    static void onGCPrologueCallback(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data);
+    static void onGCEpilogueCallback(v8::Isolate *isolate, v8::GCType type, v8::GCCallbackFlags flags, void *data);
 
     /**
      *  @brief Load the bytecode file and set the return value
@@ -364,6 +436,11 @@ private:
     void callExceptionCallback(const char *, const char *, const char *);
     bool callRegisteredCallback();
     bool postInit();
+    v8::MaybeLocal<v8::Script> compileWithCodeCache(v8::Local<v8::String> source, const v8::ScriptOrigin &origin, const char *script, ssize_t length);
+    void                       saveCodeCache(bool warmedUpOnly);
+    void                       registerExternalReference(intptr_t ref);
+    bool                       loadStartupSnapshot();
+    bool                       startFromSnapshot();
     // Struct to save exception info
     struct PromiseExceptionMsg {
         ccstd::string event;
@@ -374,6 +451,33 @@ private:
 
     ccstd::vector<std::tuple<std::unique_ptr<v8::Persistent<v8::Promise>>, ccstd::vector<PromiseExceptionMsg>>> _promiseArray;
 
+    // Scripts compiled without a usable code cache, their cache is produced once they ran for a while
+    struct PendingCodeCache {
+        ccstd::string                                      path;
+        std::unique_ptr<v8::Persistent<v8::UnboundScript>> script;
+        std::chrono::steady_clock::time_point              evalTime;
+    };
+    ccstd::vector<PendingCodeCache> _pendingCodeCaches;
+
+    enum class SnapshotMode {
+        NONE,
+        COLLECT, // lists the external references while registering the bindings
+        CREATE,  // registers the bindings again into a heap which is serialized
+        RESTORE, // deserializes the heap, registering the bindings checks the external references
+    };
+    SnapshotMode                   _snapshotMode{SnapshotMode::NONE};
+    ccstd::string                  _snapshotPath;
+    ccstd::vector<char>            _snapshotData; // the isolate deserialized from it keeps referring to it
+    ccstd::vector<intptr_t>        _externalReferences;
+    ccstd::unordered_set<intptr_t> _seenExternalReferences;
+    size_t                         _externalReferenceIndex{0};
+    size_t                         _snapshotTemplateCount{0};
+    size_t                         _snapshotTemplateIndex{0};
+    bool                           _snapshotMismatch{false};
+    bool                           _snapshotUnknownReference{false};
+    v8::StartupData                _snapshotBlob{nullptr, 0};
+    v8::SnapshotCreator *          _snapshotCreator{nullptr};
+
     std::chrono::steady_clock::time_point _startTime;
     ccstd::vector<RegisterCallback>       _registerCallbackArray;
     ccstd::vector<RegisterCallback>       _permRegisterCallbackArray;
@@ -390,6 +494,11 @@ private:
     Value            _gcFuncValue;
     Object *         _gcFunc = nullptr;
 
+    GCStats                               _frameGCStats;
+    GCStats                               _lastFrameGCStats;
+    std::chrono::steady_clock::time_point _gcStartTime;
+    uint32_t                              _gcDepth{0};
+
     FileOperationDelegate _fileOperationDelegate;
     ExceptionCallback     _nativeExceptionCallback = nullptr;
     ExceptionCallback     _jsExceptionCallback     = nullptr;
@@ -407,11 +516,13 @@ private:
     bool            _isWaitForConnect;
 
     uint32_t _vmId;
+    uint32_t _memoryProbeId;
 
     bool _isValid;
     bool _isGarbageCollecting;
     bool _isInCleanup;
     bool _isErrorHandleWorking;
+    bool _codeCacheEnabled;
 };
 
 } // namespace se
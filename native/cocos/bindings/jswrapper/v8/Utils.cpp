@@ -43,6 +43,55 @@ void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &v8args, ValueArray &o
     }
 }
 
+bool jsToNumberArgs(const v8::FunctionCallbackInfo<v8::Value> &v8args, NumberArgs *outArgs) {
+    assert(outArgs != nullptr);
+    outArgs->setArgc(v8args.Length());
+    for (int i = 0; i < v8args.Length(); i++) {
+        v8::Local<v8::Value> jsval = v8args[i];
+        if (jsval->IsNumber()) {
+            double *out = outArgs->append(1);
+            if (out == nullptr) return false;
+            *out = jsval.As<v8::Number>()->Value();
+        } else if (jsval->IsBoolean()) {
+            double *out = outArgs->append(1);
+            if (out == nullptr) return false;
+            *out = jsval->IsTrue() ? 1.0 : 0.0;
+        } else if (jsval->IsFloat64Array()) {
+            v8::Local<v8::Float64Array> arr = jsval.As<v8::Float64Array>();
+            const auto                  len = static_cast<uint32_t>(arr->Length());
+            double *                    out = outArgs->append(len);
+            if (out == nullptr) return false;
+            arr->CopyContents(out, len * sizeof(double));
+        } else if (jsval->IsFloat32Array()) {
+            v8::Local<v8::Float32Array> arr = jsval.As<v8::Float32Array>();
+            const auto                  len = static_cast<uint32_t>(arr->Length());
+            double *                    out = outArgs->append(len);
+            if (out == nullptr) return false;
+            float tmp[NumberArgs::MAX_NUMBERS];
+            arr->CopyContents(tmp, len * sizeof(float));
+            for (uint32_t j = 0; j < len; j++) {
+                out[j] = tmp[j];
+            }
+        } else if (jsval->IsArray()) {
+            v8::Local<v8::Array>   arr     = jsval.As<v8::Array>();
+            v8::Local<v8::Context> context = v8args.GetIsolate()->GetCurrentContext();
+            const uint32_t         len     = arr->Length();
+            double *               out     = outArgs->append(len);
+            if (out == nullptr) return false;
+            for (uint32_t j = 0; j < len; j++) {
+                v8::Local<v8::Value> element;
+                if (!arr->Get(context, j).ToLocal(&element) || !element->IsNumber()) {
+                    return false;
+                }
+                out[j] = element.As<v8::Number>()->Value();
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
 void seToJsArgs(v8::Isolate *isolate, const ValueArray &args, v8::Local<v8::Value> *outArr) {
     assert(outArr != nullptr);
     uint32_t i = 0;
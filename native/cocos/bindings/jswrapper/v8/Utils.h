@@ -31,6 +31,7 @@
 #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
 
     #include "../Value.h"
+    #include "../ValueArrayPool.h"
     #include "Base.h"
     #include "ObjectWrap.h"
 
@@ -45,6 +46,8 @@ struct PrivateData {
 
 void jsToSeArgs(const v8::FunctionCallbackInfo<v8::Value> &_v8args, ValueArray &outArr);
 void jsToSeValue(v8::Isolate *isolate, v8::Local<v8::Value> jsval, Value *v);
+// returns false if an argument is neither a number, a boolean nor a number array
+bool jsToNumberArgs(const v8::FunctionCallbackInfo<v8::Value> &v8args, NumberArgs *outArgs);
 void seToJsArgs(v8::Isolate *isolate, const ValueArray &args, v8::Local<v8::Value> *outArr);
 void seToJsValue(v8::Isolate *isolate, const Value &v, v8::Local<v8::Value> *outJsVal);
 
@@ -56,6 +59,13 @@ void  setPrivate(v8::Isolate *isolate, ObjectWrap &wrap, PrivateObjectBase *data
 void *getPrivate(v8::Isolate *isolate, v8::Local<v8::Value> value, uint32_t index = 0);
 void  clearPrivate(v8::Isolate *isolate, ObjectWrap &wrap);
 
+// native object of the receiver of a fast API call, nullptr if its private data has been cleared
+template <typename T>
+inline T *fastThisObject(v8::Local<v8::Object> receiver) {
+    auto *privateObject = static_cast<PrivateObjectBase *>(receiver->GetAlignedPointerFromInternalField(0));
+    return privateObject != nullptr ? privateObject->get<T>() : nullptr;
+}
+
 } // namespace internal
 } // namespace se
 
@@ -26,6 +26,8 @@
 #include "jsb_cocos_manual.h"
 
 #include "cocos/bindings/auto/jsb_cocos_auto.h"
+#include "cocos/bindings/event/CustomEventTypes.h"
+#include "cocos/bindings/event/EventDispatcher.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/manual/jsb_conversions.h"
 #include "cocos/bindings/manual/jsb_global_init.h"
@@ -337,13 +339,26 @@ static bool register_sys_localStorage(se::Object *obj) { // NOLINT(readability-i
     // Use another way
     char path[256] = {0};
     sprintf(path, "%s/jsb.sqlite", strFilePath.c_str());
-    localStorageInit(path);
+    localStorageInit(path, true);
 #else
     strFilePath += "/jsb.sqlite";
-    localStorageInit(strFilePath);
+    localStorageInit(strFilePath, true);
 #endif
 
+    // Pending writes must reach the disk before the app may be killed in background
+    static uint32_t onPauseListenerID = 0;
+    static uint32_t onCloseListenerID = 0;
+
+    onPauseListenerID = cc::EventDispatcher::addCustomEventListener(EVENT_COME_TO_BACKGROUND, [](const cc::CustomEvent & /*unused*/) {
+        localStorageFlush();
+    });
+    onCloseListenerID = cc::EventDispatcher::addCustomEventListener(EVENT_CLOSE, [](const cc::CustomEvent & /*unused*/) {
+        localStorageFlush();
+    });
+
     se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
+        cc::EventDispatcher::removeCustomEventListener(EVENT_COME_TO_BACKGROUND, onPauseListenerID);
+        cc::EventDispatcher::removeCustomEventListener(EVENT_CLOSE, onCloseListenerID);
         localStorageFree();
     });
 
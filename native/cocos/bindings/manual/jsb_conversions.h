@@ -802,6 +802,33 @@ sevalue_to_native(const se::Value &from, cc::TypedArrayTemp<T> *to, se::Object *
     return true;
 }
 
+////////////////// BufferView
+
+template <typename T>
+bool sevalue_to_native(const se::Value &from, cc::BufferView<T> *to, se::Object *ctx) { // NOLINT(readability-identifier-naming)
+    if (from.isNullOrUndefined()) {
+        to->setJSObject(nullptr);
+        return true;
+    }
+    SE_PRECONDITION2(from.isObject(), false, "Convert parameter to BufferView failed!");
+    se::Object *obj = from.toObject();
+    if (obj->isTypedArray() || obj->isArrayBuffer()) {
+        // borrow the backing store, the argument keeps it alive during the call
+        to->setJSObject(obj);
+        return true;
+    }
+    if (obj->isArray()) {
+        ccstd::vector<T> storage;
+        if (!sevalue_to_native(from, &storage, ctx)) {
+            return false;
+        }
+        to->assign(std::move(storage));
+        return true;
+    }
+    SE_LOGE("[warn] failed to convert to cc::BufferView\n");
+    return false;
+}
+
 ////////////////// pointer types
 
 template <typename T>
@@ -1236,6 +1263,9 @@ inline bool nativevalue_to_se(const ccstd::unordered_map<K, V> &from, se::Value
 template <typename T>
 inline bool nativevalue_to_se(const cc::TypedArrayTemp<T> &typedArray, se::Value &to, se::Object *ctx); // NOLINT
 
+template <typename T>
+inline bool nativevalue_to_se(const cc::BufferView<T> &from, se::Value &to, se::Object *ctx); // NOLINT
+
 /// nativevalue_to_se cc::optional
 template <typename T>
 bool nativevalue_to_se(const cc::optional<T> &from, se::Value &to, se::Object *ctx) { // NOLINT
@@ -1252,6 +1282,25 @@ inline bool nativevalue_to_se(const cc::TypedArrayTemp<T> &typedArray, se::Value
     return true;
 }
 
+template <typename T>
+inline bool nativevalue_to_se(const cc::BufferView<T> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT
+    if (from.getJSObject() != nullptr) {
+        to.setObject(from.getJSObject());
+        return true;
+    }
+    if (from.data() == nullptr) {
+        to.setNull();
+        return true;
+    }
+    se::Value buffer;
+    if (!wrapExternalArrayBuffer(from.data(), from.byteLength(), from.getOwner(), buffer)) {
+        return false;
+    }
+    se::HandleObject array(se::Object::createTypedArrayWithBuffer(cc::toTypedArrayType<T>(), buffer.toObject()));
+    to.setObject(array);
+    return true;
+}
+
 template <typename T>
 inline bool nativevalue_to_se(const ccstd::vector<T> &from, se::Value &to, se::Object *ctx) { // NOLINT(readability-identifier-naming)
     se::HandleObject array(se::Object::createArrayObject(from.size()));
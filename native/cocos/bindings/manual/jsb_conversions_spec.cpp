@@ -19,6 +19,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <mutex>
 #include <sstream>
 #include "jsb_conversions.h"
 
@@ -1492,6 +1493,59 @@ bool nativevalue_to_se(const cc::ArrayBuffer &arrayBuffer, se::Value &to, se::Ob
     return true;
 }
 
+namespace {
+// V8 may free external backing stores on a GC thread, owners are released on the script thread instead
+std::mutex                      gExternalOwnerMutex;
+ccstd::vector<cc::RefCounted *> gReleasedExternalOwners;
+bool                            gExternalOwnerHookAdded{false};
+
+void releaseExternalOwners() {
+    ccstd::vector<cc::RefCounted *> owners;
+    {
+        std::lock_guard<std::mutex> lock(gExternalOwnerMutex);
+        owners.swap(gReleasedExternalOwners);
+    }
+    for (auto *owner : owners) {
+        owner->release();
+    }
+}
+
+void onExternalArrayBufferFreed(void * /*contents*/, size_t /*byteLength*/, void *userData) {
+    if (userData != nullptr) {
+        std::lock_guard<std::mutex> lock(gExternalOwnerMutex);
+        gReleasedExternalOwners.push_back(static_cast<cc::RefCounted *>(userData));
+    }
+}
+} // namespace
+
+bool wrapExternalArrayBuffer(void *data, size_t byteLength, cc::RefCounted *owner, se::Value &to) {
+// NOTE: Currently V8 use shared_ptr which has different abi on win64-debug and win64-release
+#if CC_PLATFORM == CC_PLATFORM_WINDOWS && SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    CC_UNUSED_PARAM(owner);
+    se::HandleObject buffer(se::Object::createArrayBufferObject(data, byteLength));
+#else
+    releaseExternalOwners();
+    if (owner != nullptr) {
+        if (!gExternalOwnerHookAdded) {
+            // the isolate frees the remaining backing stores when it is disposed
+            gExternalOwnerHookAdded = true;
+            se::ScriptEngine::getInstance()->addAfterCleanupHook([]() {
+                gExternalOwnerHookAdded = false;
+                releaseExternalOwners();
+            });
+        }
+        owner->addRef();
+    }
+    se::HandleObject buffer(se::Object::createExternalArrayBufferObject(data, byteLength, onExternalArrayBufferFreed, owner));
+#endif
+    if (buffer.isEmpty()) {
+        to.setUndefined();
+        return false;
+    }
+    to.setObject(buffer);
+    return true;
+}
+
 //// NOLINTNEXTLINE(readability-identifier-naming)
 // bool nativevalue_to_se(const cc::TypedArray &from, se::Value &to, se::Object * /*ctx*/) {
 //     std::visit([&](auto &typedArray) {
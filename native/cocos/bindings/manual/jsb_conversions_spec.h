@@ -29,6 +29,7 @@
 #include "cocos/base/Optional.h"
 #include "cocos/base/Variant.h"
 #include "cocos/core/assets/AssetsModuleHeader.h"
+#include "core/BufferView.h"
 #include "core/TypedArray.h"
 #include "core/assets/RenderingSubMesh.h"
 
@@ -376,6 +377,9 @@ bool DownloadTask_to_seval(const cc::network::DownloadTask &v, se::Value *ret);
 
 bool nativevalue_to_se(const cc::ArrayBuffer &arrayBuffer, se::Value &to, se::Object * /*ctx*/); // NOLINT(readability-identifier-naming) // NOLINT
 
+// Wraps engine-owned memory in an external ArrayBuffer without copying, the owner (if any) is retained until the ArrayBuffer is collected.
+bool wrapExternalArrayBuffer(void *data, size_t byteLength, cc::RefCounted *owner, se::Value &to);
+
 inline bool nativevalue_to_se(const ccstd::vector<int8_t> &from, se::Value &to, se::Object * /*ctx*/) { // NOLINT(readability-identifier-naming)
     se::Object *array = se::Object::createTypedArray(se::Object::TypedArrayType::INT8, from.data(), from.size());
     to.setObject(array);
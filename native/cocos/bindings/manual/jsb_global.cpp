@@ -27,14 +27,17 @@
 #include "application/ApplicationManager.h"
 #include "base/DeferredReleasePool.h"
 #include "base/Scheduler.h"
-#include "base/ThreadPool.h"
 #include "base/ZipUtils.h"
 #include "base/base64.h"
+#include "engine/Benchmark.h"
+#include "gfx-agent/DeviceAgent.h"
 #include "gfx-base/GFXDef.h"
 #include "jsb_conversions.h"
 #include "network/Downloader.h"
 #include "network/HttpClient.h"
+#include "platform/AsyncFileReader.h"
 #include "platform/Image.h"
+#include "platform/ImageDecodeQueue.h"
 #include "platform/interfaces/modules/ISystem.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "ui/edit-box/EditBox.h"
@@ -49,7 +52,7 @@
 
 using namespace cc; //NOLINT
 
-static LegacyThreadPool *gThreadPool = nullptr;
+static ImageDecodeQueue *gImageDecodeQueue = nullptr;
 
 static std::shared_ptr<cc::network::Downloader>                                                               gLocalDownloader = nullptr;
 static ccstd::unordered_map<ccstd::string, std::function<void(const ccstd::string &, unsigned char *, uint)>> gLocalDownloaderHandlers;
@@ -310,6 +313,29 @@ static bool jsc_dumpRoot(se::State &s) { //NOLINT
 }
 SE_BIND_FUNC(jsc_dumpRoot)
 
+// per-binding call counts and timings, only recorded when RECORD_JSB_INVOKING is defined
+static bool jsc_dumpBindingStats(se::State &s) { //NOLINT
+    printJSBInvoke();
+    return true;
+}
+SE_BIND_FUNC(jsc_dumpBindingStats)
+
+static bool jsc_clearBindingStats(se::State &s) { //NOLINT
+    clearRecordJSBInvoke();
+    return true;
+}
+SE_BIND_FUNC(jsc_clearBindingStats)
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+static bool jsc_setBindingStatsEnabled(se::State &s) { //NOLINT
+    const auto &args = s.args();
+    SE_PRECONDITION2(args.size() == 1, false, "Invalid number of arguments");
+    setJSBInvokeRecordingEnabled(args[0].toBoolean());
+    return true;
+}
+SE_BIND_FUNC(jsc_setBindingStatsEnabled)
+#endif
+
 static bool JSBCore_platform(se::State &s) { //NOLINT
     //Application::Platform platform = CC_CURRENT_ENGINE()->getPlatform();
     cc::BasePlatform::OSType type =
@@ -466,39 +492,6 @@ struct ImageInfo {
     bool            compressed = false;
 };
 
-uint8_t *convertRGB2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src++;
-        dst[i + 1] = *src++;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
-uint8_t *convertIA2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = *src++;
-    }
-    return dst;
-}
-
-uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
-    auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
-    return dst;
-}
-
 struct ImageInfo *createImageInfo(Image *img) {
     auto *imgInfo   = new struct ImageInfo();
     imgInfo->length = static_cast<uint32_t>(img->getDataLen());
@@ -508,39 +501,6 @@ struct ImageInfo *createImageInfo(Image *img) {
     imgInfo->format     = img->getRenderFormat();
     imgInfo->compressed = img->isCompressed();
 
-    // Convert to RGBA888 because standard web api will return only RGBA888.
-    // If not, then it may have issue in glTexSubImage. For example, engine
-    // will create a big texture, and update its content with small pictures.
-    // The big texture is RGBA888, then the small picture should be the same
-    // format, or it will cause 0x502 error on OpenGL ES 2.
-    if (!imgInfo->compressed && imgInfo->format != cc::gfx::Format::RGBA8) {
-        imgInfo->length = img->getWidth() * img->getHeight() * 4;
-        uint8_t *dst    = nullptr;
-        uint32_t length = imgInfo->length;
-        uint8_t *src    = imgInfo->data;
-        switch (imgInfo->format) {
-            case cc::gfx::Format::A8:
-            case cc::gfx::Format::LA8:
-                dst = convertIA2RGBA(length, src);
-                break;
-            case cc::gfx::Format::L8:
-            case cc::gfx::Format::R8:
-            case cc::gfx::Format::R8I:
-                dst = convertI2RGBA(length, src);
-                break;
-            case cc::gfx::Format::RGB8:
-                dst = convertRGB2RGBA(length, src);
-                break;
-            default:
-                SE_LOGE("unknown image format");
-                break;
-        }
-
-        if (dst != imgInfo->data) free(imgInfo->data);
-        imgInfo->data     = dst;
-        imgInfo->hasAlpha = true;
-    }
-
     return imgInfo;
 }
 } // namespace
@@ -554,26 +514,28 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
 
     std::shared_ptr<se::Value> callbackPtr = std::make_shared<se::Value>(callbackVal);
 
-    auto initImageFunc = [path, callbackPtr](const ccstd::string &fullPath, unsigned char *imageData, int imageBytes) {
-        auto *img = new (std::nothrow) Image();
-
-        gThreadPool->pushTask([=](int /*tid*/) {
-            // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
-            // Image::initWithImageFile will call fullPathForFilename internally which may
-            // cause thread race issues. Therefore, we get the full path of file before
-            // going into task callback.
-            // Be careful of invoking any Cocos2d-x interface in a sub-thread.
-            bool loadSucceed = false;
-            if (fullPath.empty()) {
-                loadSucceed = img->initWithImageData(imageData, imageBytes);
-                free(imageData);
-            } else {
-                loadSucceed = img->initWithImageFile(fullPath);
-            }
+    auto initImageFunc = [path, callbackPtr](const ccstd::string & /*fullPath*/, unsigned char *imageData, int imageBytes) {
+        // NOTE: FileUtils::getInstance()->fullPathForFilename isn't a threadsafe method,
+        // every source is read into memory before it reaches the decode threads.
+        // Be careful of invoking any Cocos2d-x interface in a sub-thread.
+        Data data;
+        if (imageData && imageBytes > 0) {
+            data.fastSet(imageData, imageBytes);
+        } else {
+            free(imageData);
+        }
 
+        // Convert to RGBA888 because standard web api will return only RGBA888.
+        // If not, then it may have issue in glTexSubImage. For example, engine
+        // will create a big texture, and update its content with small pictures.
+        // The big texture is RGBA888, then the small picture should be the same
+        // format, or it will cause 0x502 error on OpenGL ES 2.
+        ImageDecodeQueue::Options options;
+        options.convertToRGBA = true;
+        gImageDecodeQueue->decode(std::move(data), options, [path, callbackPtr](IntrusivePtr<Image> &&image) {
             ImageInfo *imgInfo = nullptr;
-            if (loadSucceed) {
-                imgInfo = createImageInfo(img);
+            if (image) {
+                imgInfo = createImageInfo(image);
             }
 
             CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread([=]() {
@@ -581,7 +543,7 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
                 se::ValueArray      seArgs;
                 se::Value           dataVal;
 
-                if (loadSucceed) {
+                if (imgInfo) {
                     se::HandleObject retObj(se::Object::createPlainObject());
                     dataVal.setUint64(reinterpret_cast<uintptr_t>(imgInfo->data));
                     retObj->setProperty("data", dataVal);
@@ -595,7 +557,6 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
                     SE_REPORT_ERROR("initWithImageFile: %s failed!", path.c_str());
                 }
                 callbackPtr->toObject()->call(seArgs, nullptr);
-                delete img;
             });
         });
     };
@@ -625,7 +586,15 @@ bool jsb_global_load_image(const ccstd::string &path, const se::Value &callbackV
             SE_REPORT_ERROR("File (%s) doesn't exist!", path.c_str());
             return false;
         }
-        initImageFunc(fullPath, nullptr, 0);
+        // read on the I/O threads, decode on the image threads
+        AsyncFileReader::getInstance()->read(fullPath, [initImageFunc](AsyncFileReader::Result &result) {
+            ssize_t        imageBytes = 0;
+            unsigned char *imageData  = nullptr;
+            if (result.status == FileUtils::Status::OK) {
+                imageData = result.data.takeBuffer(&imageBytes);
+            }
+            initImageFunc("", imageData, static_cast<int>(imageBytes));
+        });
     }
     return true;
 }
@@ -721,6 +690,76 @@ static bool JSB_setPreferredFramesPerSecond(se::State &s) { //NOLINT
 }
 SE_BIND_FUNC(JSB_setPreferredFramesPerSecond)
 
+static bool JSB_setIdleFramesPerSecond(se::State &s) { //NOLINT
+    const auto &   args = s.args();
+    size_t         argc = args.size();
+    CC_UNUSED bool ok   = true;
+    if (argc > 1) {
+        int32_t fps;
+        float   timeout;
+        ok = sevalue_to_native(args[0], &fps);
+        SE_PRECONDITION2(ok, false, "fps is invalid!");
+        ok = sevalue_to_native(args[1], &timeout);
+        SE_PRECONDITION2(ok, false, "timeout is invalid!");
+        CC_CURRENT_ENGINE()->setIdleFramesPerSecond(fps, timeout);
+        return true;
+    }
+
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 2);
+    return false;
+}
+SE_BIND_FUNC(JSB_setIdleFramesPerSecond)
+
+static bool JSB_notifyActivity(se::State &s) { //NOLINT
+    CC_CURRENT_ENGINE()->notifyActivity();
+    return true;
+}
+SE_BIND_FUNC(JSB_notifyActivity)
+
+static bool JSB_getBenchmarkInfo(se::State &s) { //NOLINT
+    const auto *benchmark = CC_CURRENT_ENGINE()->getBenchmark();
+    if (!benchmark) {
+        s.rval().setUndefined();
+        return true;
+    }
+
+    const auto &     info = benchmark->getInfo();
+    se::HandleObject infoObj(se::Object::createPlainObject());
+    infoObj->setProperty("scene", se::Value(info.scene));
+    infoObj->setProperty("frames", se::Value(info.frames));
+    infoObj->setProperty("warmupFrames", se::Value(info.warmupFrames));
+    infoObj->setProperty("framesPerSecond", se::Value(info.framesPerSecond));
+    infoObj->setProperty("recording", se::Value(benchmark->isRecording()));
+    s.rval().setObject(infoObj);
+    return true;
+}
+SE_BIND_FUNC(JSB_getBenchmarkInfo)
+
+static bool JSB_startBenchmark(se::State &s) { //NOLINT
+    if (auto *benchmark = CC_CURRENT_ENGINE()->getBenchmark()) {
+        benchmark->start();
+    }
+    return true;
+}
+SE_BIND_FUNC(JSB_startBenchmark)
+
+// jsb.startGFXCapture(path, frames), see DeviceAgent::startCapture()
+static bool JSB_startGFXCapture(se::State &s) { //NOLINT
+    const auto &args = s.args();
+    int         argc = static_cast<int>(args.size());
+    SE_PRECONDITION2(argc == 2, false, "Invalid number of arguments");
+    bool          ok = true;
+    ccstd::string path;
+    uint32_t      frames{0};
+    ok &= sevalue_to_native(args[0], &path);
+    ok &= sevalue_to_native(args[1], &frames);
+    SE_PRECONDITION2(ok, false, "Error processing arguments");
+    auto *device = cc::gfx::DeviceAgent::getInstance();
+    s.rval().setBoolean(device && device->startCapture(path, frames));
+    return true;
+}
+SE_BIND_FUNC(JSB_startGFXCapture)
+
 #if CC_USE_EDITBOX
 static bool JSB_showInputBox(se::State &s) { //NOLINT
     const auto &args = s.args();
@@ -1172,7 +1211,7 @@ static bool JSB_zipUtils_setPvrEncryptionKey(se::State &s) { //NOLINT
 SE_BIND_FUNC(JSB_zipUtils_setPvrEncryptionKey)
 
 bool jsb_register_global_variables(se::Object *global) { //NOLINT
-    gThreadPool = LegacyThreadPool::newFixedThreadPool(3);
+    gImageDecodeQueue = new (std::nothrow) ImageDecodeQueue();
 
     global->defineFunction("require", _SE(require));
     global->defineFunction("requireModule", _SE(moduleRequire));
@@ -1181,11 +1220,21 @@ bool jsb_register_global_variables(se::Object *global) { //NOLINT
 
     __jsbObj->defineFunction("garbageCollect", _SE(jsc_garbageCollect));
     __jsbObj->defineFunction("dumpNativePtrToSeObjectMap", _SE(jsc_dumpNativePtrToSeObjectMap));
+    __jsbObj->defineFunction("dumpBindingStats", _SE(jsc_dumpBindingStats));
+    __jsbObj->defineFunction("clearBindingStats", _SE(jsc_clearBindingStats));
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    __jsbObj->defineFunction("setBindingStatsEnabled", _SE(jsc_setBindingStatsEnabled));
+#endif
 
     __jsbObj->defineFunction("loadImage", _SE(js_loadImage));
     __jsbObj->defineFunction("openURL", _SE(JSB_openURL));
     __jsbObj->defineFunction("copyTextToClipboard", _SE(JSB_copyTextToClipboard));
     __jsbObj->defineFunction("setPreferredFramesPerSecond", _SE(JSB_setPreferredFramesPerSecond));
+    __jsbObj->defineFunction("setIdleFramesPerSecond", _SE(JSB_setIdleFramesPerSecond));
+    __jsbObj->defineFunction("notifyActivity", _SE(JSB_notifyActivity));
+    __jsbObj->defineFunction("getBenchmarkInfo", _SE(JSB_getBenchmarkInfo));
+    __jsbObj->defineFunction("startBenchmark", _SE(JSB_startBenchmark));
+    __jsbObj->defineFunction("startGFXCapture", _SE(JSB_startGFXCapture));
     __jsbObj->defineFunction("destroyImage", _SE(js_destroyImage));
 #if CC_USE_EDITBOX
     __jsbObj->defineFunction("showInputBox", _SE(JSB_showInputBox));
@@ -1225,8 +1274,8 @@ bool jsb_register_global_variables(se::Object *global) { //NOLINT
     se::ScriptEngine::getInstance()->clearException();
 
     se::ScriptEngine::getInstance()->addBeforeCleanupHook([]() {
-        delete gThreadPool;
-        gThreadPool = nullptr;
+        delete gImageDecodeQueue;
+        gImageDecodeQueue = nullptr;
 
         DeferredReleasePool::clear();
     });
@@ -48,11 +48,17 @@ jsb_make_private_object(ARGS &&...args) { //NOLINT(readability-identifier-naming
 }
 
 template <typename T, typename... ARGS>
-typename std::enable_if<!std::is_base_of<cc::RefCounted, T>::value, se::PrivateObjectBase *>::type
+typename std::enable_if<!std::is_base_of<cc::RefCounted, T>::value && !se::IsPooledPrivateObject<T>::value, se::PrivateObjectBase *>::type
 jsb_make_private_object(ARGS &&...args) { //NOLINT(readability-identifier-naming)
     return se::shared_private_object(std::make_shared<T>(std::forward<ARGS>(args)...));
 }
 
+template <typename T, typename... ARGS>
+typename std::enable_if<se::IsPooledPrivateObject<T>::value, se::PrivateObjectBase *>::type
+jsb_make_private_object(ARGS &&...args) { //NOLINT(readability-identifier-naming)
+    return se::pooled_private_object<T>(std::forward<ARGS>(args)...);
+}
+
 #define JSB_MAKE_PRIVATE_OBJECT(kls, ...) jsb_make_private_object<kls>(__VA_ARGS__)
 #define JSB_ALLOC(kls, ...)               jsb_override_new<kls>(__VA_ARGS__)
 #define JSB_FREE(kls)                     jsb_override_delete(kls)
@@ -46,6 +46,12 @@
 #include "cocos/bindings/manual/jsb_platform.h"
 #include "cocos/bindings/manual/jsb_scene_manual.h"
 #include "cocos/bindings/manual/jsb_xmlhttprequest.h"
+#include "cocos/profiler/StartupTimer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
 
 #if USE_GFX_RENDERER
 #endif
@@ -102,92 +108,243 @@
     #include "cocos/bindings/auto/jsb_physics_auto.h"
 #endif
 
-bool jsb_register_all_modules() {
-    se::ScriptEngine *se = se::ScriptEngine::getInstance();
-
-    se->addBeforeCleanupHook([se]() {
-        se->garbageCollect();
-        cc::DeferredReleasePool::clear();
-        se->garbageCollect();
-        cc::DeferredReleasePool::clear();
-    });
-
-    se->addRegisterCallback(jsb_register_global_variables);
-    se->addRegisterCallback(register_all_engine);
-    se->addRegisterCallback(register_all_cocos_manual);
-    se->addRegisterCallback(register_platform_bindings);
-    se->addRegisterCallback(register_all_gfx);
-    se->addRegisterCallback(register_all_gfx_manual);
+// Modules which are only used by some games register their classes on first access of their namespace or classes.
+#ifndef JSB_LAZY_MODULE_REGISTRATION
+    #define JSB_LAZY_MODULE_REGISTRATION (SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8)
+#endif
 
-    se->addRegisterCallback(register_all_network);
-    se->addRegisterCallback(register_all_network_manual);
-    se->addRegisterCallback(register_all_xmlhttprequest);
+namespace {
+
+using RegisterCallback = se::ScriptEngine::RegisterCallback;
+
+constexpr uint32_t MAX_MODULE_CALLBACKS     = 3;
+constexpr uint32_t MAX_MODULE_LAZY_PROPERTY = 2;
+
+struct BindingModule {
+    const char *     name;
+    RegisterCallback callbacks[MAX_MODULE_CALLBACKS];
+    // properties created by the module, if not empty the module is registered on first access of one of them
+    const char *lazyProperties[MAX_MODULE_LAZY_PROPERTY];
+    // global object which holds the lazy properties, the global object itself if nullptr
+    const char *lazyOwner;
+    // module whose classes this one uses, registered first if it is lazy too
+    const char *dependency;
+};
+
+// in registration order, later modules may depend on earlier ones
+const BindingModule BINDING_MODULES[] = {
+    {"global", {jsb_register_global_variables}, {}},
+    {"engine", {register_all_engine, register_all_cocos_manual}, {}},
+    {"platform", {register_platform_bindings}, {}},
+    {"gfx", {register_all_gfx, register_all_gfx_manual}, {}},
+    {"network", {register_all_network, register_all_network_manual, register_all_xmlhttprequest}, {}},
     // extension depend on network
-    se->addRegisterCallback(register_all_extension);
-    se->addRegisterCallback(register_all_dop_bindings);
-    se->addRegisterCallback(register_all_assets);
-    se->addRegisterCallback(register_all_assets_manual);
+    {"extension", {register_all_extension}, {}},
+    {"dop", {register_all_dop_bindings}, {}},
+    {"assets", {register_all_assets, register_all_assets_manual}, {}},
     // pipeline depend on asset
-    se->addRegisterCallback(register_all_pipeline);
-    se->addRegisterCallback(register_all_pipeline_manual);
-    se->addRegisterCallback(register_all_geometry);
-    se->addRegisterCallback(register_all_scene);
-    se->addRegisterCallback(register_all_scene_manual);
-    se->addRegisterCallback(register_all_render);
+    {"pipeline", {register_all_pipeline, register_all_pipeline_manual}, {}},
+    {"geometry", {register_all_geometry}, {}},
+    {"scene", {register_all_scene, register_all_scene_manual}, {}},
+    {"render", {register_all_render}, {}},
 
 #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_MAC_OSX)
-    se->addRegisterCallback(register_javascript_objc_bridge);
-    se->addRegisterCallback(register_script_native_bridge);
+    {"bridge", {register_javascript_objc_bridge, register_script_native_bridge}, {}},
 #endif
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OHOS)
-    se->addRegisterCallback(register_javascript_java_bridge);
-    se->addRegisterCallback(register_script_native_bridge);
+    {"bridge", {register_javascript_java_bridge, register_script_native_bridge}, {}},
 #endif
 
 #if CC_USE_AUDIO
-    se->addRegisterCallback(register_all_audio);
+    {"audio", {register_all_audio}, {"AudioEngine", "AudioProfile"}, "jsb"},
 #endif
 
 #if CC_USE_SOCKET
-    se->addRegisterCallback(register_all_websocket);
-    se->addRegisterCallback(register_all_socketio);
+    {"websocket", {register_all_websocket}, {"WebSocket"}},
+    {"socketio", {register_all_socketio}, {"SocketIO"}},
 #endif
 
 #if CC_USE_MIDDLEWARE
-    se->addRegisterCallback(register_all_editor_support);
+    {"middleware", {register_all_editor_support}, {"middleware"}},
 
     #if CC_USE_SPINE
-    se->addRegisterCallback(register_all_spine);
-    se->addRegisterCallback(register_all_spine_manual);
+    {"spine", {register_all_spine, register_all_spine_manual}, {"spine"}, nullptr, "middleware"},
     #endif
 
     #if CC_USE_DRAGONBONES
-    se->addRegisterCallback(register_all_dragonbones);
-    se->addRegisterCallback(register_all_dragonbones_manual);
+    {"dragonbones", {register_all_dragonbones, register_all_dragonbones_manual}, {"dragonBones"}, nullptr, "middleware"},
     #endif
 
 #endif // CC_USE_MIDDLEWARE
 
 #if CC_USE_PHYSICS_PHYSX
-    se->addRegisterCallback(register_all_physics);
+    {"physics", {register_all_physics}, {"jsb.physics"}},
 #endif
 
 #if (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OHOS)
 
     #if CC_USE_VIDEO
-    se->addRegisterCallback(register_all_video);
+    {"video", {register_all_video}, {}},
     #endif
 
     #if CC_USE_WEBVIEW
-    se->addRegisterCallback(register_all_webview);
+    {"webview", {register_all_webview}, {}},
     #endif
 
 #endif // (CC_PLATFORM == CC_PLATFORM_MAC_IOS || CC_PLATFORM == CC_PLATFORM_ANDROID)
 
 #if CC_USE_SOCKET && CC_USE_WEBSOCKET_SERVER
-    se->addRegisterCallback(register_all_websocket_server);
+    {"websocket_server", {register_all_websocket_server}, {"WebSocketServer", "WebSocketServerConnection"}},
 #endif
+};
+
+constexpr uint32_t BINDING_MODULE_COUNT = sizeof(BINDING_MODULES) / sizeof(BINDING_MODULES[0]);
+
+bool gModuleRegistered[BINDING_MODULE_COUNT] = {};
+
+bool isLazyModule(const BindingModule &module) {
+    return JSB_LAZY_MODULE_REGISTRATION && module.lazyProperties[0] != nullptr;
+}
+
+bool registerModule(uint32_t index, se::Object *global) {
+    const auto &module = BINDING_MODULES[index];
+    const auto  start  = std::chrono::steady_clock::now();
+    cc::StartupTimer::begin(module.name);
+
+    gModuleRegistered[index] = true;
+    bool ok                  = true;
+    for (auto *cb : module.callbacks) {
+        if (cb == nullptr) {
+            break;
+        }
+        ok = cb(global);
+        CC_ASSERT(ok);
+        if (!ok) {
+            break;
+        }
+    }
+
+    cc::StartupTimer::end();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    SE_LOGD("JSB module '%s' registered in %.3f ms%s\n", module.name, static_cast<float>(elapsed) / 1000.F, isLazyModule(module) ? " (on first access)" : "");
+    return ok;
+}
+
+#if JSB_LAZY_MODULE_REGISTRATION
+// the object the stubs of the module are defined on, nullptr if it doesn't exist
+se::Object *getLazyOwner(const BindingModule &module, se::Object *global, se::Value *outOwner) {
+    if (module.lazyOwner == nullptr) {
+        return global;
+    }
+    return global->getProperty(module.lazyOwner, outOwner) && outOwner->isObject() ? outOwner->toObject() : nullptr;
+}
+
+bool registerLazyModule(uint32_t index, se::Object *global) {
+    const auto &module = BINDING_MODULES[index];
+    if (module.dependency != nullptr) {
+        for (uint32_t i = 0; i < BINDING_MODULE_COUNT; ++i) {
+            if (!gModuleRegistered[i] && strcmp(BINDING_MODULES[i].name, module.dependency) == 0) {
+                registerLazyModule(i, global);
+            }
+        }
+    }
+
+    // remove the stubs first, the module creates the real properties
+    se::Value ownerVal;
+    if (auto *owner = getLazyOwner(module, global, &ownerVal)) {
+        for (const auto *stub : module.lazyProperties) {
+            if (stub != nullptr) {
+                owner->deleteProperty(stub);
+            }
+        }
+    }
+    return registerModule(index, global);
+}
+
+void registerLazyModule(const char *property) {
+    se::Object *global = se::ScriptEngine::getInstance()->getGlobalObject();
+    for (uint32_t i = 0; i < BINDING_MODULE_COUNT; ++i) {
+        const auto &module = BINDING_MODULES[i];
+        if (gModuleRegistered[i] || !isLazyModule(module)) {
+            continue;
+        }
+        for (const auto *lazyProperty : module.lazyProperties) {
+            if (lazyProperty != nullptr && strcmp(lazyProperty, property) == 0) {
+                registerLazyModule(i, global);
+                return;
+            }
+        }
+    }
+}
+
+void lazyModuleGetter(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    v8::Isolate *         isolate = info.GetIsolate();
+    v8::String::Utf8Value name(isolate, property);
+    registerLazyModule(*name);
+
+    v8::Local<v8::Value> value;
+    if (info.This()->Get(isolate->GetCurrentContext(), property).ToLocal(&value)) {
+        info.GetReturnValue().Set(value);
+    }
+}
+
+void lazyModuleSetter(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info) {
+    v8::Isolate *         isolate = info.GetIsolate();
+    v8::String::Utf8Value name(isolate, property);
+    registerLazyModule(*name);
+    // the assigned value replaces what the module created, as it would without the stub
+    info.This()->Set(isolate->GetCurrentContext(), property, value).Check();
+}
+#endif
+
+bool registerBindingModules(se::Object *global) {
+    CC_STARTUP_PHASE(bindings);
+    const auto start = std::chrono::steady_clock::now();
+    bool       ok    = true;
+    for (uint32_t i = 0; i < BINDING_MODULE_COUNT && ok; ++i) {
+        const auto &module = BINDING_MODULES[i];
+        if (!isLazyModule(module)) {
+            ok = registerModule(i, global);
+            continue;
+        }
+#if JSB_LAZY_MODULE_REGISTRATION
+        se::Value ownerVal;
+        auto *    owner = getLazyOwner(module, global, &ownerVal);
+        if (owner == nullptr) {
+            ok = registerModule(i, global);
+            continue;
+        }
+        for (const auto *property : module.lazyProperties) {
+            if (property != nullptr) {
+                owner->defineProperty(property, lazyModuleGetter, lazyModuleSetter);
+            }
+        }
+        SE_LOGD("JSB module '%s' deferred to first access\n", module.name);
+#endif
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    SE_LOGD("JSB modules registered in %.3f ms\n", static_cast<float>(elapsed) / 1000.F);
+    return ok;
+}
+
+} // namespace
+
+bool jsb_register_all_modules() {
+    se::ScriptEngine *se = se::ScriptEngine::getInstance();
+
+    se->addBeforeCleanupHook([se]() {
+        se->garbageCollect();
+        cc::DeferredReleasePool::clear();
+        se->garbageCollect();
+        cc::DeferredReleasePool::clear();
+    });
+
+    // the engine may be restarted, modules of the previous run don't count
+    std::fill(std::begin(gModuleRegistered), std::end(gModuleRegistered), false);
+    se->addRegisterCallback(registerBindingModules);
+
     se->addAfterCleanupHook([]() {
         cc::DeferredReleasePool::clear();
         JSBClassType::cleanup();
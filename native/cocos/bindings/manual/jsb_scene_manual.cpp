@@ -28,6 +28,7 @@
 #include "core/Root.h"
 #include "core/event/EventTypesToJS.h"
 #include "core/scene-graph/Node.h"
+#include "core/scene-graph/NodeCommandBuffer.h"
 #include "core/scene-graph/NodeEvent.h"
 #include "scene/Model.h"
 
@@ -70,6 +71,60 @@ static bool js_root_registerListeners(se::State &s) // NOLINT(readability-identi
 }
 SE_BIND_FUNC(js_root_registerListeners) // NOLINT(readability-identifier-naming)
 
+static bool js_root_getNodeCommandBuffer(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Root>(s);
+    SE_PRECONDITION2(cobj, false, "js_root_getNodeCommandBuffer : Invalid Native Object");
+    return nativevalue_to_se(*cobj->getNodeCommandBuffer()->getBuffer(), s.rval(), s.thisObject());
+}
+SE_BIND_FUNC(js_root_getNodeCommandBuffer) // NOLINT(readability-identifier-naming)
+
+static bool js_root_registerCommandNode(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Root>(s);
+    SE_PRECONDITION2(cobj, false, "js_root_registerCommandNode : Invalid Native Object");
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        cc::Node *node = nullptr;
+        bool      ok   = sevalue_to_native(args[0], &node, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_root_registerCommandNode : Error processing arguments");
+        s.rval().setUint32(cobj->getNodeCommandBuffer()->registerNode(node));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_root_registerCommandNode) // NOLINT(readability-identifier-naming)
+
+static bool js_root_unregisterCommandNode(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Root>(s);
+    SE_PRECONDITION2(cobj, false, "js_root_unregisterCommandNode : Invalid Native Object");
+    const auto &args = s.args();
+    size_t      argc = args.size();
+    if (argc == 1) {
+        uint32_t slot = 0;
+        bool     ok   = sevalue_to_native(args[0], &slot, s.thisObject());
+        SE_PRECONDITION2(ok, false, "js_root_unregisterCommandNode : Error processing arguments");
+        cobj->getNodeCommandBuffer()->unregisterNode(slot);
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_root_unregisterCommandNode) // NOLINT(readability-identifier-naming)
+
+// applies the recorded commands before reading back transforms in the middle of a frame
+static bool js_root_flushNodeCommands(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    auto *cobj = SE_THIS_OBJECT<cc::Root>(s);
+    SE_PRECONDITION2(cobj, false, "js_root_flushNodeCommands : Invalid Native Object");
+    cobj->getNodeCommandBuffer()->apply();
+    return true;
+}
+SE_BIND_FUNC(js_root_flushNodeCommands) // NOLINT(readability-identifier-naming)
+
 static void registerOnTransformChanged(cc::Node *node, se::Object *jsObject) {
     node->on(
         cc::NodeEventType::TRANSFORM_CHANGED,
@@ -197,6 +252,26 @@ static void registerLayerArr(cc::Node *node, se::Object *jsObject) {
     node->setLayerPtr(reinterpret_cast<uint32_t *>(pLayerArrValData));
 }
 
+// optional, nodes allocated from the shared transform pool carry views on their slab entry
+static void registerSharedTransformArr(cc::Node *node, se::Object *jsObject) {
+    se::Value transformArrVal;
+    se::Value changedBitsArrVal;
+    if (!jsObject->getProperty("_sharedTransformArr", &transformArrVal) || !transformArrVal.isObject() ||
+        !jsObject->getProperty("_sharedTransformChangedArr", &changedBitsArrVal) || !changedBitsArrVal.isObject()) {
+        return;
+    }
+    CC_ASSERT(transformArrVal.toObject()->isTypedArray() && transformArrVal.toObject()->getTypedArrayType() == se::Object::TypedArrayType::FLOAT32);
+    CC_ASSERT(changedBitsArrVal.toObject()->isTypedArray() && changedBitsArrVal.toObject()->getTypedArrayType() == se::Object::TypedArrayType::UINT32);
+
+    uint8_t *pTransform{nullptr};
+    size_t   transformBytes{0};
+    uint8_t *pChangedBits{nullptr};
+    bool     ok = transformArrVal.toObject()->getTypedArrayData(&pTransform, &transformBytes);
+    ok &= changedBitsArrVal.toObject()->getTypedArrayData(&pChangedBits, nullptr);
+    CC_ASSERT(ok && transformBytes >= cc::Node::SHARED_TRANSFORM_LENGTH * sizeof(float));
+    node->setSharedTransformPtr(reinterpret_cast<float *>(pTransform), reinterpret_cast<uint32_t *>(pChangedBits));
+}
+
 static void registerLocalPositionRotationScaleUpdated(cc::Node *node, se::Object *jsObject) {
     node->on(cc::EventTypesToJS::NODE_LOCAL_POSITION_UPDATED, [jsObject](float x, float y, float z) {
         se::AutoHandleScope        hs;
@@ -254,6 +329,7 @@ static bool js_scene_Node_registerListeners(se::State &s) // NOLINT(readability-
     auto *jsObject = s.thisObject();
     registerActiveInHierarchyArr(cobj, jsObject);
     registerLayerArr(cobj, jsObject);
+    registerSharedTransformArr(cobj, jsObject);
 
 #define NODE_DISPATCH_EVENT_TO_JS(eventType, jsFuncName)                                      \
     cobj->on(                                                                                 \
@@ -503,6 +579,22 @@ static bool js_scene_Node_setTempFloatArray(se::State &s) // NOLINT(readability-
 }
 SE_BIND_FUNC(js_scene_Node_setTempFloatArray)
 
+static bool js_scene_Node_setSharedTransformDirtyArr(se::State &s) // NOLINT(readability-identifier-naming)
+{
+    const auto &   args = s.args();
+    size_t         argc = args.size();
+    CC_UNUSED bool ok   = true;
+    if (argc == 1) {
+        uint8_t *buffer = nullptr;
+        args[0].toObject()->getTypedArrayData(&buffer, nullptr);
+        cc::Node::setSharedTransformDirtyPtr(reinterpret_cast<uint32_t *>(buffer));
+        return true;
+    }
+    SE_REPORT_ERROR("wrong number of arguments: %d, was expecting %d", (int)argc, 1);
+    return false;
+}
+SE_BIND_FUNC(js_scene_Node_setSharedTransformDirtyArr)
+
 static bool js_scene_Node_getRight(se::State &s) // NOLINT(readability-identifier-naming)
 {
     auto *cobj = SE_THIS_OBJECT<cc::Node>(s);
@@ -821,6 +913,8 @@ static bool js_scene_Pass_blocks_getter(se::State &s) { // NOLINT(readability-id
         return true;
     }
 
+    // the blocks are written from JS, so a pass instance must not keep sharing them with its parent
+    cobj->ensureOwnResources();
     const auto &   blocks        = cobj->getBlocks();
     const uint8_t *blockDataBase = cobj->getRootBlock()->getData();
 
@@ -949,6 +1043,10 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     });
 
     __jsb_cc_Root_proto->defineFunction("_registerListeners", _SE(js_root_registerListeners));
+    __jsb_cc_Root_proto->defineFunction("_getNodeCommandBuffer", _SE(js_root_getNodeCommandBuffer));
+    __jsb_cc_Root_proto->defineFunction("_registerCommandNode", _SE(js_root_registerCommandNode));
+    __jsb_cc_Root_proto->defineFunction("_unregisterCommandNode", _SE(js_root_unregisterCommandNode));
+    __jsb_cc_Root_proto->defineFunction("_flushNodeCommands", _SE(js_root_flushNodeCommands));
 
     __jsb_cc_scene_Camera_proto->defineFunction("screenPointToRay", _SE(js_scene_Camera_screenPointToRay));
     __jsb_cc_scene_Camera_proto->defineFunction("screenToWorld", _SE(js_scene_Camera_screenToWorld));
@@ -971,6 +1069,7 @@ bool register_all_scene_manual(se::Object *obj) // NOLINT(readability-identifier
     jsbVal.toObject()->getProperty("Node", &nodeVal);
 
     nodeVal.toObject()->defineFunction("_setTempFloatArray", _SE(js_scene_Node_setTempFloatArray));
+    nodeVal.toObject()->defineFunction("_setSharedTransformDirtyArr", _SE(js_scene_Node_setSharedTransformDirtyArr));
 
     __jsb_cc_Node_proto->defineFunction("getPosition", _SE(js_scene_Node_getPosition));
     __jsb_cc_Node_proto->defineFunction("getRotation", _SE(js_scene_Node_getRotation));
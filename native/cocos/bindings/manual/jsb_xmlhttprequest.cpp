@@ -32,13 +32,18 @@
 //
 #include "jsb_xmlhttprequest.h"
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include "base/Config.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "cocos/base/Data.h"
 #include "cocos/base/DeferredReleasePool.h"
+#include "cocos/base/Ptr.h"
+#include "cocos/base/Scheduler.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/bindings/manual/jsb_conversions.h"
 #include "cocos/network/HttpClient.h"
@@ -114,6 +119,166 @@ ccstd::unordered_map<int, ccstd::string> _httpStatusCodeMap = {
     {510, "Not Extended"},
     {511, "Network Authentication Required"},
     {599, "Network Connect Timeout Error"}};
+
+// the last content-length of the header block, 0 if there is none
+size_t parseContentLength(const ccstd::vector<char> &headers) {
+    static const char FIELD[]     = "content-length:";
+    const size_t      fieldLength = sizeof(FIELD) - 1;
+
+    size_t length    = 0;
+    size_t lineStart = 0;
+    for (size_t i = 0; i <= headers.size(); ++i) {
+        if (i < headers.size() && headers[i] != '\n') {
+            continue;
+        }
+        // headers of redirects are kept as well, the last field belongs to the final response
+        size_t pos = lineStart;
+        while (pos < i && pos - lineStart < fieldLength && ::tolower(headers[pos]) == FIELD[pos - lineStart]) {
+            ++pos;
+        }
+        if (pos - lineStart == fieldLength) {
+            while (pos < i && headers[pos] == ' ') {
+                ++pos;
+            }
+            length = 0;
+            while (pos < i && headers[pos] >= '0' && headers[pos] <= '9') {
+                length = length * 10 + static_cast<size_t>(headers[pos] - '0');
+                ++pos;
+            }
+        }
+        lineStart = i + 1;
+    }
+    return length;
+}
+
+// Response body written on the network thread while it arrives, read on the script thread.
+class ResponseStream final : public std::enable_shared_from_this<ResponseStream> {
+public:
+    ResponseStream(bool preallocate, std::weak_ptr<Scheduler> scheduler)
+    : _scheduler(std::move(scheduler)),
+      _preallocate(preallocate) {}
+
+    ~ResponseStream() {
+        free(_data);
+    }
+
+    // script thread only, invoked at most once per frame while data arrives
+    std::function<void()> onProgress;
+
+    // network thread
+    bool append(HttpResponse *response, const char *data, size_t len) {
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_received == 0) {
+                _total = parseContentLength(*response->getResponseHeader());
+            }
+            if (_size + len > _capacity) {
+                size_t capacity = std::max(_capacity * 2, _size + len);
+                if (_capacity == 0 && _preallocate && _total >= len) {
+                    // the whole body fits into one allocation which is handed to JS as is
+                    capacity = _total;
+                }
+                auto *newData = static_cast<uint8_t *>(realloc(_data, capacity));
+                if (newData == nullptr) {
+                    return false;
+                }
+                _data     = newData;
+                _capacity = capacity;
+            }
+            memcpy(_data + _size, data, len);
+            _size += len;
+            _received += len;
+
+            notify           = !_progressPending;
+            _progressPending = true;
+        }
+
+        if (notify) {
+            if (auto scheduler = _scheduler.lock()) {
+                std::shared_ptr<ResponseStream> self = shared_from_this();
+                scheduler->performFunctionInCocosThread([self]() {
+                    self->dispatchProgress();
+                });
+            }
+        }
+        return true;
+    }
+
+    size_t getReceived() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _received;
+    }
+
+    size_t getTotal() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _total;
+    }
+
+    // moves the data received so far to the end of out
+    void takeText(ccstd::string &out) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        out.append(reinterpret_cast<const char *>(_data), _size);
+        _size = 0;
+    }
+
+    // the caller owns the returned memory, it is released with free()
+    uint8_t *releaseData(size_t *outSize) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_capacity - _size > _size / 8) {
+            auto *shrunk = static_cast<uint8_t *>(realloc(_data, std::max<size_t>(_size, 1)));
+            if (shrunk != nullptr) {
+                _data = shrunk;
+            }
+        }
+        uint8_t *data = _data;
+        *outSize      = _size;
+        _data         = nullptr;
+        _size         = 0;
+        _capacity     = 0;
+        return data;
+    }
+
+private:
+    void dispatchProgress() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _progressPending = false;
+        }
+        if (onProgress != nullptr) {
+            onProgress();
+        }
+    }
+
+    std::mutex               _mutex;
+    std::weak_ptr<Scheduler> _scheduler;
+    uint8_t *                _data{nullptr};
+    size_t                   _size{0};
+    size_t                   _capacity{0};
+    size_t                   _received{0};
+    size_t                   _total{0};
+    bool                     _preallocate{false};
+    bool                     _progressPending{false};
+};
+
+// Memory of an arraybuffer response, shared with the external ArrayBuffers created for it.
+class ResponseBuffer final : public cc::RefCounted {
+public:
+    ResponseBuffer(uint8_t *data, size_t size)
+    : _data(data),
+      _size(size) {}
+
+    ~ResponseBuffer() override {
+        free(_data);
+    }
+
+    uint8_t *getData() const { return _data; }
+    size_t   getSize() const { return _size; }
+
+private:
+    uint8_t *_data{nullptr};
+    size_t   _size{0};
+};
 } // namespace
 
 class XMLHttpRequest : public RefCounted {
@@ -142,6 +307,8 @@ public:
     std::function<void()> onabort;
     std::function<void()> onerror;
     std::function<void()> ontimeout;
+    // loaded and total bytes of the response body, total is 0 if the length isn't known
+    std::function<void(size_t, size_t)> onprogress;
 
     XMLHttpRequest();
 
@@ -159,6 +326,7 @@ public:
     const ccstd::string &getStatusText() const { return _statusText; }
     const ccstd::string &getResponseText() const { return _responseText; }
     const cc::Data &     getResponseData() const { return _responseData; }
+    ResponseBuffer *     getResponseBuffer() const { return _responseBuffer; }
     ResponseType         getResponseType() const { return _responseType; }
     void                 setResponseType(ResponseType type) { _responseType = type; }
 
@@ -178,6 +346,8 @@ private:
     void setReadyState(ReadyState readyState);
     void getHeader(const ccstd::string &header);
     void onResponse(cc::network::HttpClient *client, cc::network::HttpResponse *response);
+    void onStreamProgress();
+    void resetResponse();
 
     void setHttpRequestData(const char *data, size_t len);
     void sendRequest();
@@ -195,6 +365,9 @@ private:
 
     cc::Data _responseData;
 
+    std::shared_ptr<ResponseStream>  _responseStream;
+    cc::IntrusivePtr<ResponseBuffer> _responseBuffer;
+
     cc::network::HttpRequest *_httpRequest;
     //    cc::EventListenerCustom* _resetDirectorListener;
 
@@ -222,6 +395,7 @@ XMLHttpRequest::XMLHttpRequest()
   onabort(nullptr),
   onerror(nullptr),
   ontimeout(nullptr),
+  onprogress(nullptr),
   _httpRequest(new (std::nothrow) HttpRequest()),
   _responseType(ResponseType::STRING),
   _readyState(ReadyState::UNSENT) {
@@ -231,6 +405,9 @@ XMLHttpRequest::~XMLHttpRequest() {
     CC_CURRENT_ENGINE()->getScheduler()->unscheduleAllForTarget(this);
     // Avoid HttpClient response call a released object!
     _httpRequest->setResponseCallback(nullptr);
+    if (_responseStream != nullptr) {
+        _responseStream->onProgress = nullptr;
+    }
     CC_SAFE_RELEASE(_httpRequest);
 }
 
@@ -316,6 +493,9 @@ void XMLHttpRequest::abort() {
 
     //request is aborted, no more callback needed.
     _httpRequest->setResponseCallback(nullptr);
+    if (_responseStream != nullptr) {
+        _responseStream->onProgress = nullptr;
+    }
 }
 
 void XMLHttpRequest::setReadyState(ReadyState readyState) {
@@ -401,9 +581,6 @@ void XMLHttpRequest::onResponse(HttpClient * /*client*/, HttpResponse *response)
     char statusString[64] = {0};
     sprintf(statusString, "HTTP Status Code: %ld, tag = %s", statusCode, tag.c_str());
 
-    _responseText.clear();
-    _responseData.clear();
-
     if (!response->isSucceed()) {
         ccstd::string errorBuffer = response->getErrorBuffer();
         SE_LOGD("Response failed, error buffer: %s\n", errorBuffer.c_str());
@@ -411,6 +588,7 @@ void XMLHttpRequest::onResponse(HttpClient * /*client*/, HttpResponse *response)
             _errorFlag = true;
             _status    = 0;
             _statusText.clear();
+            resetResponse();
             if (onerror != nullptr) {
                 onerror();
             }
@@ -435,18 +613,38 @@ void XMLHttpRequest::onResponse(HttpClient * /*client*/, HttpResponse *response)
     }
 
     /** get the response data **/
-    ccstd::vector<char> *buffer = response->getResponseData();
+    size_t loaded = 0;
+    if (_responseStream != nullptr && _responseStream->getReceived() > 0) {
+        // the body was streamed by the network thread, text arrived partly with the progress events already
+        loaded = _responseStream->getReceived();
+        if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
+            _responseStream->takeText(_responseText);
+        } else {
+            size_t   size = 0;
+            uint8_t *data = _responseStream->releaseData(&size);
 
-    if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
-        _responseText.append(buffer->data(), buffer->size());
+            _responseBuffer = new (std::nothrow) ResponseBuffer(data, size);
+        }
     } else {
-        _responseData.copy(reinterpret_cast<unsigned char *>(buffer->data()), static_cast<ssize_t>(buffer->size()));
+        ccstd::vector<char> *buffer = response->getResponseData();
+
+        resetResponse();
+        loaded = buffer->size();
+        if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
+            _responseText.append(buffer->data(), buffer->size());
+        } else {
+            _responseData.copy(reinterpret_cast<unsigned char *>(buffer->data()), static_cast<ssize_t>(buffer->size()));
+        }
     }
 
     _status = statusCode;
 
     setReadyState(ReadyState::DONE);
 
+    if (onprogress != nullptr) {
+        onprogress(loaded, _responseStream != nullptr ? std::max(_responseStream->getTotal(), loaded) : loaded);
+    }
+
     if (onload != nullptr) {
         onload();
     }
@@ -457,6 +655,28 @@ void XMLHttpRequest::onResponse(HttpClient * /*client*/, HttpResponse *response)
     }
 }
 
+void XMLHttpRequest::onStreamProgress() {
+    if (_isAborted || _isTimeout || _readyState == ReadyState::UNSENT || _readyState == ReadyState::DONE) {
+        return;
+    }
+
+    if (_responseType == ResponseType::STRING || _responseType == ResponseType::JSON) {
+        // responseText holds the partial data while loading
+        _responseStream->takeText(_responseText);
+    }
+    setReadyState(ReadyState::LOADING);
+
+    if (onprogress != nullptr) {
+        onprogress(_responseStream->getReceived(), _responseStream->getTotal());
+    }
+}
+
+void XMLHttpRequest::resetResponse() {
+    _responseText.clear();
+    _responseData.clear();
+    _responseBuffer = nullptr;
+}
+
 void XMLHttpRequest::overrideMimeType(const ccstd::string &mimeType) {
     _overrideMimeType = mimeType;
 }
@@ -489,6 +709,19 @@ void XMLHttpRequest::sendRequest() {
     }
     setHttpRequestHeader();
 
+    resetResponse();
+    if (_responseStream != nullptr) {
+        _responseStream->onProgress = nullptr;
+    }
+    // arraybuffer responses are written into one allocation sized from Content-Length and exposed without copies
+    _responseStream             = std::make_shared<ResponseStream>(_responseType == ResponseType::ARRAY_BUFFER, CC_CURRENT_ENGINE()->getScheduler());
+    _responseStream->onProgress = [this]() { onStreamProgress(); };
+
+    std::shared_ptr<ResponseStream> stream = _responseStream;
+    _httpRequest->setResponseDataCallback([stream](HttpResponse *response, const char *data, size_t len) {
+        return stream->append(response, data, len);
+    });
+
     _httpRequest->setResponseCallback(CC_CALLBACK_2(XMLHttpRequest::onResponse, this)); //NOLINT
     cc::network::HttpClient::getInstance()->sendImmediate(_httpRequest);
 
@@ -634,6 +867,26 @@ static bool XMLHttpRequest_constructor(se::State &s) { //NOLINT(readability-iden
             cb("onerror");
         }
     };
+    request->onprogress = [=](size_t loaded, size_t total) {
+        if (!request->isDiscardedByReset()) {
+            se::ScriptEngine::getInstance()->clearException();
+            se::AutoHandleScope hs;
+
+            se::Object *thizObj = thiz.toObject();
+
+            se::Value func;
+            if (thizObj->getProperty("onprogress", &func) && func.isObject() && func.toObject()->isFunction()) {
+                se::HandleObject event(se::Object::createPlainObject());
+                event->setProperty("loaded", se::Value(static_cast<double>(loaded)));
+                event->setProperty("total", se::Value(static_cast<double>(total)));
+                event->setProperty("lengthComputable", se::Value(total > 0));
+
+                se::ValueArray args;
+                args.emplace_back(se::Value(event.get()));
+                func.toObject()->call(args, thizObj);
+            }
+        }
+    };
     request->ontimeout = [=]() {
         if (!request->isDiscardedByReset()) {
             cb("ontimeout");
@@ -854,6 +1107,12 @@ static bool XMLHttpRequest_getResponse(se::State &s) { //NOLINT(readability-iden
                 } else {
                     s.rval().setNull();
                 }
+            } else if (xhr->getResponseType() == XMLHttpRequest::ResponseType::ARRAY_BUFFER && xhr->getResponseBuffer() != nullptr) {
+                // streamed responses share their memory with the ArrayBuffer
+                ResponseBuffer *buffer = xhr->getResponseBuffer();
+                if (!wrapExternalArrayBuffer(buffer->getData(), buffer->getSize(), buffer, s.rval())) {
+                    s.rval().setNull();
+                }
             } else if (xhr->getResponseType() == XMLHttpRequest::ResponseType::ARRAY_BUFFER) {
                 const Data &     data = xhr->getResponseData();
                 se::HandleObject seObj(se::Object::createArrayBufferObject(data.getBytes(), data.getSize()));
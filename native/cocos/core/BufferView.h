@@ -0,0 +1,176 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+#include "bindings/jswrapper/Object.h"
+
+namespace cc {
+
+/**
+ * A non-owning view of contiguous arithmetic data shared between JS and native.
+ *
+ * When converted from JS, the view borrows the backing store of the TypedArray or
+ * ArrayBuffer instead of copying it, so it is only valid during the native call it is
+ * passed to. Plain JS arrays can't be borrowed and are copied into a local storage.
+ *
+ * When converted to JS, the viewed memory is wrapped in an external ArrayBuffer. If an
+ * owner is given, it is retained until the JS object is collected, otherwise the memory
+ * must outlive every JS reference to it.
+ */
+template <typename T>
+class BufferView final {
+public:
+    static_assert(std::is_arithmetic<T>::value, "BufferView only supports arithmetic types");
+    static constexpr uint32_t BYTES_PER_ELEMENT{sizeof(T)};
+    using value_type = T;
+
+    BufferView() = default;
+
+    BufferView(T *data, uint32_t length, RefCounted *owner = nullptr)
+    : _data(data),
+      _length(length),
+      _owner(owner) {}
+
+    BufferView(const BufferView &o) {
+        *this = o;
+    }
+
+    BufferView(BufferView &&o) noexcept {
+        *this = std::move(o);
+    }
+
+    ~BufferView() {
+        setJSObject(nullptr);
+    }
+
+    BufferView &operator=(const BufferView &o) {
+        if (this != &o) {
+            setJSObject(o._jsObject);
+            if (!o._storage.empty()) {
+                assign(ccstd::vector<T>(o._storage));
+            } else {
+                _data   = o._data;
+                _length = o._length;
+            }
+            _owner = o._owner;
+        }
+        return *this;
+    }
+
+    BufferView &operator=(BufferView &&o) noexcept {
+        if (this != &o) {
+            setJSObject(nullptr);
+            _jsObject = o._jsObject;
+            _storage  = std::move(o._storage);
+            _data     = _storage.empty() ? o._data : _storage.data();
+            _length   = o._length;
+            _owner    = o._owner;
+
+            o._jsObject = nullptr;
+            o._data     = nullptr;
+            o._length   = 0;
+            o._owner    = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * Borrows the memory of a JS TypedArray or ArrayBuffer, nullptr resets the view.
+     */
+    void setJSObject(se::Object *obj) {
+        if (obj != nullptr) {
+            obj->incRef();
+        }
+        if (_jsObject != nullptr) {
+            _jsObject->decRef();
+        }
+        _jsObject = obj;
+        _storage.clear();
+        _owner = nullptr;
+
+        uint8_t *ptr{nullptr};
+        size_t   byteLength{0};
+        if (obj != nullptr) {
+            if (obj->isTypedArray()) {
+                obj->getTypedArrayData(&ptr, &byteLength);
+            } else if (obj->isArrayBuffer()) {
+                obj->getArrayBufferData(&ptr, &byteLength);
+            } else {
+                CC_ASSERT(false);
+            }
+        }
+        _data   = reinterpret_cast<T *>(ptr);
+        _length = static_cast<uint32_t>(byteLength / BYTES_PER_ELEMENT);
+    }
+
+    /**
+     * Takes the elements converted from a plain JS array.
+     */
+    void assign(ccstd::vector<T> &&storage) {
+        setJSObject(nullptr);
+        _storage = std::move(storage);
+        _data    = _storage.data();
+        _length  = static_cast<uint32_t>(_storage.size());
+    }
+
+    inline T &operator[](uint32_t idx) const {
+        CC_ASSERT(idx < _length);
+        return _data[idx];
+    }
+
+    inline T *          data() const { return _data; }
+    inline T *          begin() const { return _data; }
+    inline T *          end() const { return _data + _length; }
+    inline uint32_t     length() const { return _length; }
+    inline uint32_t     byteLength() const { return _length * BYTES_PER_ELEMENT; }
+    inline bool         empty() const { return _length == 0; }
+    inline RefCounted * getOwner() const { return _owner; }
+    inline se::Object * getJSObject() const { return _jsObject; }
+
+private:
+    T *              _data{nullptr};
+    uint32_t         _length{0};
+    RefCounted *     _owner{nullptr};
+    se::Object *     _jsObject{nullptr};
+    ccstd::vector<T> _storage;
+};
+
+using Int8View    = BufferView<int8_t>;
+using Int16View   = BufferView<int16_t>;
+using Int32View   = BufferView<int32_t>;
+using Uint8View   = BufferView<uint8_t>;
+using Uint16View  = BufferView<uint16_t>;
+using Uint32View  = BufferView<uint32_t>;
+using Float32View = BufferView<float>;
+using Float64View = BufferView<double>;
+
+} // namespace cc
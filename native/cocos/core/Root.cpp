@@ -24,13 +24,22 @@
  ****************************************************************************/
 
 #include "core/Root.h"
+#include "base/memory/MemoryAccounting.h"
+#include "base/threading/FrameArena.h"
 // #include "core/Director.h"
+#include "core/assets/AssetResidencyCache.h"
+#include "core/assets/TextureStreaming.h"
 #include "core/event/CallbacksInvoker.h"
 #include "core/event/EventTypesToJS.h"
+#include "core/scene-graph/NodeCommandBuffer.h"
 #include "profiler/Profiler.h"
+#include "profiler/StartupTimer.h"
 #include "renderer/gfx-base/GFXDef.h"
+#include "renderer/gfx-base/GFXDescriptorSetCache.h"
 #include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/core/ProgramLib.h"
 #include "renderer/gfx-base/GFXSwapchain.h"
+#include "renderer/pipeline/GlobalDescriptorSetManager.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/NativePipelineTypes.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
@@ -38,7 +47,7 @@
 #include "renderer/pipeline/forward/ForwardPipeline.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
-#include "scene/DrawBatch2D.h"
+#include "scene/Batcher2D.h"
 #include "scene/SpotLight.h"
 
 namespace cc {
@@ -60,6 +69,9 @@ Root::Root(gfx::Device *device)
     _cameraPool = new memop::Pool<scene::Camera>([this]() { return new scene::Camera(_device); },
                                                  4);
 
+    _textureStreaming    = new TextureStreaming();
+    _assetResidencyCache = new AssetResidencyCache();
+
     _cameraList.reserve(6);
     _swapchains.reserve(2);
 }
@@ -71,6 +83,7 @@ Root::~Root() {
 }
 
 void Root::initialize(gfx::Swapchain *swapchain) {
+    CC_STARTUP_PHASE(root);
     _swapchain = swapchain;
 
     gfx::RenderPassInfo renderPassInfo;
@@ -100,6 +113,8 @@ void Root::initialize(gfx::Swapchain *swapchain) {
 
 void Root::destroy() {
     destroyScenes();
+    // resident assets hold GFX resources, release them while the device is alive
+    CC_SAFE_DELETE(_assetResidencyCache);
 
     if (_usesCustomPipeline) {
         _pipelineRuntime->destroy();
@@ -107,13 +122,21 @@ void Root::destroy() {
     _pipelineRuntime.reset();
 
     CC_SAFE_DESTROY_NULL(_pipeline);
-    // TODO(minggo):
-    //    CC_SAFE_DESTROY(_batcher2D);
+    CC_SAFE_DESTROY_AND_DELETE(_batcher2D);
+    CC_SAFE_DELETE(_textureStreaming);
+    CC_SAFE_DELETE(_nodeCommandBuffer);
 
     // TODO(minggo):
     //    this.dataPoolManager.clear();
 }
 
+NodeCommandBuffer *Root::getNodeCommandBuffer() {
+    if (_nodeCommandBuffer == nullptr) {
+        _nodeCommandBuffer = new NodeCommandBuffer();
+    }
+    return _nodeCommandBuffer;
+}
+
 void Root::resize(uint32_t width, uint32_t height) {
     for (const auto &window : _windows) {
         if (window->getSwapchain()) {
@@ -231,14 +254,9 @@ bool Root::setRenderPipeline(pipeline::RenderPipeline *rppl /* = nullptr*/) {
     onGlobalPipelineStateChanged();
 
     _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_INIT, this);
-    // TODO(minggo):
-    //    if (!_batcher) {
-    //        _batcher = new Batcher2D(this);
-    //        if (!this._batcher.initialize()) {
-    //            this.destroy();
-    //            return false;
-    //        }
-    //    }
+    if (!_batcher2D) {
+        _batcher2D = new scene::Batcher2D(_device);
+    }
 
     return true;
 }
@@ -260,6 +278,12 @@ void Root::resetCumulativeTime() {
 }
 
 void Root::frameMove(float deltaTime, int32_t totalFrames) {
+    // apply the transforms recorded or shared by JS since last frame, even if nothing is rendered
+    if (_nodeCommandBuffer) {
+        _nodeCommandBuffer->apply();
+    }
+    Node::syncSharedTransforms();
+
     if (!cc::gfx::Device::getInstance()->isRendererAvailable()) {
         return;
     }
@@ -274,16 +298,23 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         _fpsTime    = 0.0;
     }
 
+    // compile a few of the shader variants requested asynchronously last frame
+    ProgramLib::getInstance()->update();
+
+    // stream the mipmaps requested by culling last frame
+    if (_textureStreaming) {
+        _textureStreaming->update();
+    }
+
     for (const auto &scene : _scenes) {
         scene->removeBatches();
     }
 
     _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPDATE, this); // cjh added for sync logic in ts.
 
-    // TODO(minggo):
-    //    if (_batcher) {
-    //        _batcher.update();
-    //    }
+    if (_batcher2D) {
+        _batcher2D->update();
+    }
 
     //
     _cameraList.clear();
@@ -299,9 +330,9 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         uint32_t stamp = totalFrames;
 
         _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_UPLOAD_BUFFERS, this);
-        //                if (_batcher != nullptr) {
-        //                    _batcher->uploadBuffers();
-        //                }
+        if (_batcher2D) {
+            _batcher2D->uploadBuffers();
+        }
 
         for (const auto &scene : _scenes) {
             scene->update(stamp);
@@ -316,10 +347,29 @@ void Root::frameMove(float deltaTime, int32_t totalFrames) {
         });
         _pipelineRuntime->render(_cameraList);
         _device->present();
+
+        const auto *globalDSManager = _pipelineRuntime->getGlobalDSManager();
+        if (globalDSManager && globalDSManager->getDescriptorSetCache()) {
+            globalDSManager->getDescriptorSetCache()->nextFrame();
+        }
     }
 
     _eventProcessor->emit(EventTypesToJS::ROOT_BATCH2D_RESET, this);
-    // cjh TODO:    if (this._batcher) this._batcher.reset();
+    if (_batcher2D) {
+        _batcher2D->reset();
+    }
+
+    for (const auto &scene : _scenes) {
+        scene->flushRemovedModels();
+    }
+
+#if CC_USE_MEMORY_ACCOUNTING
+    // budget listeners may evict caches, after this frame no longer uses them
+    MemoryAccounting::getInstance().update();
+#endif
+
+    // transient allocations of this frame are reclaimed from here on
+    FrameArena::nextFrame();
 }
 
 scene::RenderWindow *Root::createWindow(scene::IRenderWindowInfo &info) {
@@ -37,7 +37,7 @@
 namespace cc {
 namespace scene {
 class Camera;
-struct DrawBatch2D;
+class Batcher2D;
 } // namespace scene
 namespace gfx {
 class SwapChain;
@@ -47,6 +47,9 @@ namespace render {
 class PipelineRuntime;
 } // namespace render
 class CallbacksInvoker;
+class AssetResidencyCache;
+class NodeCommandBuffer;
+class TextureStreaming;
 
 class Root final {
 public:
@@ -131,7 +134,7 @@ public:
 
     template <typename T, typename = std::enable_if_t<std::is_base_of<scene::Model, T>::value>>
     T *createModel() {
-        //cjh TODO: need use model pool?
+        // the built-in model types are recycled by their slab allocators, see CC_SLAB_ALLOCATED
         T *model = new T();
         model->initialize();
         return model;
@@ -141,7 +144,7 @@ public:
 
     template <typename T, typename = std::enable_if_t<std::is_base_of<scene::Light, T>::value>>
     T *createLight() {
-        //TODO(xwx): need use model pool?
+        // sphere and spot lights are recycled by their slab allocators, see CC_SLAB_ALLOCATED
         T *light = new T();
         light->initialize();
         return light;
@@ -198,11 +201,31 @@ public:
     inline render::PipelineRuntime *getPipeline() const { return _pipelineRuntime.get(); }
 
     /**
+     * @en The native 2D batcher, entities committed to it are merged into batches every frame.
      * @zh
-     * UI实例
+     * UI实例，提交到其中的 2D 对象每帧会被合批。
      * 引擎内部使用，用户无需调用此接口
      */
-    inline scene::DrawBatch2D *getBatcher2D() const { return _batcher2D; }
+    inline scene::Batcher2D *getBatcher2D() const { return _batcher2D; }
+
+    /**
+     * @en The texture streaming system, it streams the mipmaps of the textures loaded while it's enabled.
+     * @zh
+     * 贴图流式加载系统，启用后加载的贴图会流式加载其 Mipmap。
+     */
+    inline TextureStreaming *getTextureStreaming() const { return _textureStreaming; }
+
+    /**
+     * @en The cache keeping textures and meshes released with a scene resident, so that the next scenes can reuse them.
+     * @zh 资源驻留缓存，保留随场景释放的贴图与网格，以便之后的场景复用。
+     */
+    inline AssetResidencyCache *getAssetResidencyCache() const { return _assetResidencyCache; }
+
+    /**
+     * @en The buffer of node transform mutations recorded by JS, they are applied in one pass at the beginning of frameMove.
+     * @zh JS 记录的节点变换修改缓冲区，会在 frameMove 开始时一次性应用。
+     */
+    NodeCommandBuffer *getNodeCommandBuffer();
 
     /**
      * @zh
@@ -257,7 +280,10 @@ private:
     ccstd::vector<IntrusivePtr<scene::RenderWindow>> _windows;
     IntrusivePtr<pipeline::RenderPipeline>           _pipeline{nullptr};
     std::unique_ptr<render::PipelineRuntime>         _pipelineRuntime;
-    scene::DrawBatch2D *                             _batcher2D{nullptr};
+    scene::Batcher2D *                               _batcher2D{nullptr};
+    TextureStreaming *                               _textureStreaming{nullptr};
+    AssetResidencyCache *                            _assetResidencyCache{nullptr};
+    NodeCommandBuffer *                              _nodeCommandBuffer{nullptr};
     //    IntrusivePtr<DataPoolManager>                  _dataPoolMgr;
     ccstd::vector<IntrusivePtr<scene::RenderScene>> _scenes;
     memop::Pool<scene::Camera> *                    _cameraPool{nullptr};
@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/assets/AssetResidencyCache.h"
+#include "3d/assets/Mesh.h"
+#include "base/memory/MemoryAccounting.h"
+#include "base/std/container/unordered_set.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "core/assets/Texture2D.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXTexture.h"
+
+namespace cc {
+
+namespace {
+uint64_t getTextureBytes(Texture2D *texture) {
+    // size of the base level, the same as the GFX backends report to MemoryAccounting
+    auto *gfxTexture = texture->getGFXTexture();
+    return gfxTexture ? gfxTexture->getSize() : 0;
+}
+
+uint64_t getMeshBytes(Mesh *mesh) {
+    uint64_t bytes = mesh->getData().byteLength();
+
+    // sub meshes of the same bundle share their vertex buffers
+    ccstd::unordered_set<const gfx::Buffer *> buffers;
+    for (const auto &subMesh : mesh->getRenderingSubMeshes()) {
+        if (!subMesh) {
+            continue;
+        }
+        for (const auto *buffer : subMesh->getVertexBuffers()) {
+            buffers.insert(buffer);
+        }
+        buffers.insert(subMesh->getIndexBuffer());
+    }
+    for (const auto *buffer : buffers) {
+        bytes += buffer ? buffer->getSize() : 0;
+    }
+    return bytes;
+}
+} // namespace
+
+AssetResidencyCache::AssetResidencyCache() {
+    _budgetListener = MemoryAccounting::getInstance().addBudgetListener([this](MemoryTag tag, uint64_t current, uint64_t budget) {
+        if (tag == MemoryTag::TEXTURE || tag == MemoryTag::MESH || tag == MemoryTag::BUFFER || tag == MemoryTag::TOTAL) {
+            onBudgetExceeded(current, budget);
+        }
+    });
+}
+
+AssetResidencyCache::~AssetResidencyCache() {
+    MemoryAccounting::getInstance().removeBudgetListener(_budgetListener);
+    clear();
+}
+
+void AssetResidencyCache::setEnabled(bool enabled) {
+    _enabled = enabled;
+    if (!_enabled) {
+        clear();
+    }
+}
+
+void AssetResidencyCache::setBudget(uint64_t bytes) {
+    _budget = bytes;
+    if (_residentBytes > _budget) {
+        evict(_residentBytes - _budget);
+    }
+}
+
+bool AssetResidencyCache::keep(Texture2D *texture) {
+    return texture && keep(texture, Type::TEXTURE, getTextureBytes(texture));
+}
+
+bool AssetResidencyCache::keep(Mesh *mesh) {
+    return mesh && keep(mesh, Type::MESH, getMeshBytes(mesh));
+}
+
+bool AssetResidencyCache::keep(Asset *asset, Type type, uint64_t bytes) {
+    const auto &uuid = asset->getUuid();
+    if (!_enabled || uuid.empty() || asset->isDefault() || bytes > _budget) {
+        return false;
+    }
+
+    auto iter = _index.find(uuid);
+    if (iter != _index.end()) {
+        if (iter->second->asset == asset) {
+            return true;
+        }
+        _residentBytes -= iter->second->bytes;
+        _entries.erase(iter->second);
+        _index.erase(iter);
+    }
+
+    if (_residentBytes + bytes > _budget) {
+        evict(_residentBytes + bytes - _budget);
+    }
+
+    _entries.push_front({uuid, type, asset, bytes});
+    _index.emplace(uuid, _entries.begin());
+    _residentBytes += bytes;
+    return true;
+}
+
+IntrusivePtr<Texture2D> AssetResidencyCache::takeTexture(const ccstd::string &uuid) {
+    return static_cast<Texture2D *>(take(uuid, Type::TEXTURE).get());
+}
+
+IntrusivePtr<Mesh> AssetResidencyCache::takeMesh(const ccstd::string &uuid) {
+    return static_cast<Mesh *>(take(uuid, Type::MESH).get());
+}
+
+IntrusivePtr<Asset> AssetResidencyCache::take(const ccstd::string &uuid, Type type) {
+    auto iter = _index.find(uuid);
+    if (iter == _index.end() || iter->second->type != type) {
+        return nullptr;
+    }
+
+    IntrusivePtr<Asset> asset = iter->second->asset;
+    _residentBytes -= iter->second->bytes;
+    _entries.erase(iter->second);
+    _index.erase(iter);
+    return asset;
+}
+
+bool AssetResidencyCache::contains(const ccstd::string &uuid) const {
+    return _index.count(uuid) != 0;
+}
+
+void AssetResidencyCache::evict(uint64_t bytes) {
+    uint64_t released = 0;
+    while (released < bytes && !_entries.empty()) {
+        auto &entry = _entries.back();
+        released += entry.bytes;
+        _residentBytes -= entry.bytes;
+        _index.erase(entry.uuid);
+        // destroyed with the last reference, the asset may still be referenced elsewhere
+        _entries.pop_back();
+    }
+}
+
+void AssetResidencyCache::clear() {
+    _index.clear();
+    _entries.clear();
+    _residentBytes = 0;
+}
+
+void AssetResidencyCache::onBudgetExceeded(uint64_t current, uint64_t budget) {
+    // give back what the process is over budget, kept assets are the cheapest memory to release
+    evict(current > budget ? current - budget : 0);
+}
+
+} // namespace cc
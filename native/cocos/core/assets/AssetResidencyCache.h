@@ -0,0 +1,122 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/list.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+
+namespace cc {
+
+class Asset;
+class Mesh;
+class Texture2D;
+
+/**
+ * @en Keeps decoded and GPU resident textures and meshes alive after the scene using them was released,
+ * so that loading another scene sharing them only needs to take them back by UUID.
+ * Assets are evicted in least recently kept order once the budget is exceeded,
+ * or when the TEXTURE, MESH or TOTAL memory budget of MemoryAccounting is exceeded.
+ * @zh 在使用贴图与网格的场景释放后，继续保留已解码并驻留在 GPU 的贴图与网格，
+ * 加载共享这些资源的其他场景时只需要按 UUID 取回。
+ * 超出预算，或 MemoryAccounting 中 TEXTURE、MESH、TOTAL 标签超出预算时，按最久未保留的顺序淘汰资源。
+ */
+class CC_DLL AssetResidencyCache final {
+public:
+    AssetResidencyCache();
+    ~AssetResidencyCache();
+
+    /**
+     * @en Whether released assets are kept, disabled by default. Disabling it evicts every asset.
+     * @zh 是否保留被释放的资源，默认关闭。关闭时会淘汰所有资源。
+     */
+    void        setEnabled(bool enabled);
+    inline bool isEnabled() const { return _enabled; }
+
+    /**
+     * @en Bytes of assets kept at most.
+     * @zh 最多保留的资源字节数。
+     */
+    void            setBudget(uint64_t bytes);
+    inline uint64_t getBudget() const { return _budget; }
+
+    inline uint64_t getResidentBytes() const { return _residentBytes; }
+    inline size_t   getCount() const { return _entries.size(); }
+
+    /**
+     * @en Keeps an asset no longer used by any scene, instead of destroying it. An asset kept before under the same UUID is replaced.
+     * @zh 保留不再被任何场景使用的资源而不是销毁它，已保留的同 UUID 资源会被替换。
+     * @return @en Whether the asset is kept, false if disabled, the asset has no UUID or is larger than the budget.
+     * @zh 资源是否被保留，若未启用、资源没有 UUID 或超过预算则返回 false。
+     */
+    bool keep(Texture2D *texture);
+    bool keep(Mesh *mesh);
+
+    /**
+     * @en Takes an asset back out of the cache for reuse, returns nullptr if it isn't resident.
+     * @zh 从缓存中取回资源以便复用，资源未驻留时返回 nullptr。
+     */
+    IntrusivePtr<Texture2D> takeTexture(const ccstd::string &uuid);
+    IntrusivePtr<Mesh>      takeMesh(const ccstd::string &uuid);
+
+    bool contains(const ccstd::string &uuid) const;
+
+    // Evicts the least recently kept assets until at least bytes are released or the cache is empty.
+    void evict(uint64_t bytes);
+    void clear();
+
+private:
+    enum class Type {
+        TEXTURE,
+        MESH,
+    };
+
+    struct Entry {
+        ccstd::string       uuid;
+        Type                type{Type::TEXTURE};
+        IntrusivePtr<Asset> asset;
+        uint64_t            bytes{0};
+    };
+    using EntryList = ccstd::list<Entry>;
+
+    bool                keep(Asset *asset, Type type, uint64_t bytes);
+    IntrusivePtr<Asset> take(const ccstd::string &uuid, Type type);
+    void                onBudgetExceeded(uint64_t current, uint64_t budget);
+
+    // most recently kept at the front
+    EntryList                                                _entries;
+    ccstd::unordered_map<ccstd::string, EntryList::iterator> _index;
+    uint64_t                                                 _budget{128 * 1024 * 1024};
+    uint64_t                                                 _residentBytes{0};
+    uint32_t                                                 _budgetListener{0};
+    bool                                                     _enabled{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(AssetResidencyCache);
+};
+
+} // namespace cc
@@ -620,6 +620,7 @@ protected:
     CC_DISALLOW_COPY_MOVE_ASSIGN(EffectAsset);
 
     friend class EffectAssetDeserializer;
+    friend class EffectAssetBinaryDeserializer;
     friend class Material;
     friend class ProgramLib;
     friend class MaterialInstance;
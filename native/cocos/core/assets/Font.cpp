@@ -94,14 +94,13 @@ Font::~Font() {
 }
 
 void Font::load(const ccstd::string &path) {
-    Data data = FileUtils::getInstance()->getDataFromFile(path);
-    if (data.isNull()) {
+    const MappedFile file = FileUtils::getInstance()->mapFile(path);
+    if (file.isNull()) {
         CC_LOG_WARNING("Font load failed, path: %s.", path.c_str());
         return;
     }
 
-    _data.resize(data.getSize());
-    memcpy(&_data[0], data.getBytes(), data.getSize());
+    _data.assign(file.getBytes(), file.getBytes() + file.getSize());
     CC_PROFILE_MEMORY_INC(Font, _data.size());
 }
 
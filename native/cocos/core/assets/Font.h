@@ -40,6 +40,13 @@ constexpr uint32_t DEFAULT_FREETYPE_TEXTURE_SIZE = 512U;
 constexpr uint32_t MIN_FONT_SIZE                 = 1U;
 constexpr uint32_t MAX_FONT_SIZE                 = 128U;
 
+// sdf glyphs are rasterized once at SDF_FONT_SIZE and scaled to any size at draw time,
+// SDF_SPREAD is the distance range in pixels encoded around the glyph outline.
+// faces created with FontFaceInfo::sdf are shared by all sizes and stored under SDF_FACE_KEY.
+constexpr uint32_t SDF_FONT_SIZE = 48U;
+constexpr uint32_t SDF_SPREAD    = 6U;
+constexpr uint32_t SDF_FACE_KEY  = 0U;
+
 enum class FontType {
     INVALID,
     FREETYPE,
@@ -87,6 +94,8 @@ struct FontFaceInfo {
     uint32_t                textureWidth{DEFAULT_FREETYPE_TEXTURE_SIZE};
     uint32_t                textureHeight{DEFAULT_FREETYPE_TEXTURE_SIZE};
     ccstd::vector<uint32_t> preLoadedCharacters;
+    // only used in freetype, rasterize signed distance fields instead of coverage bitmaps.
+    bool sdf{false};
     //~
 };
 
@@ -104,6 +113,8 @@ public:
 
     virtual const FontGlyph *getGlyph(uint32_t code)                          = 0;
     virtual float            getKerning(uint32_t prevCode, uint32_t nextCode) = 0;
+    // uploads glyphs loaded since the last call, call it once per frame before drawing.
+    virtual void flush() {}
 
     inline Font *                               getFont() const { return _font; }
     inline uint32_t                             getFontSize() const { return _fontSize; }
@@ -112,6 +123,7 @@ public:
     inline gfx::Texture *                       getTexture(uint32_t page) const { return _textures[page]; }
     inline uint32_t                             getTextureWidth() const { return _textureWidth; }
     inline uint32_t                             getTextureHeight() const { return _textureHeight; }
+    inline bool                                 isSDF() const { return _sdf; }
 
 protected:
     virtual void doInit(const FontFaceInfo &info) = 0;
@@ -124,6 +136,7 @@ protected:
     ccstd::vector<gfx::Texture *>                         _textures;
     uint32_t                                              _textureWidth{0U};
     uint32_t                                              _textureHeight{0U};
+    bool                                                  _sdf{false};
 };
 
 /**
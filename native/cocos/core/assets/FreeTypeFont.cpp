@@ -29,9 +29,17 @@
 #include "FreeTypeFont.h"
 #include <freetype/ft2build.h>
 #include FT_FREETYPE_H
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <thread>
+#include <boost/functional/hash.hpp>
+#include "base/Data.h"
 #include "base/Log.h"
 #include "gfx-base/GFXDevice.h"
+#include "platform/FileUtils.h"
 
 namespace cc {
 
@@ -133,6 +141,175 @@ private:
     uint32_t _maxLineHeight{0U};
 };
 
+/**
+ * FTGlyphBitmap: glyph metrics and tightly packed pixels produced by rasterization.
+ */
+struct FTGlyphBitmap {
+    FontGlyph              glyph;
+    ccstd::vector<uint8_t> pixels;
+    bool                   loaded{false};
+};
+
+namespace {
+
+constexpr uint32_t GLYPH_CACHE_MAGIC   = 0x43474343; // "CCGC"
+constexpr uint32_t GLYPH_CACHE_VERSION = 1U;
+
+// rasterization of a single glyph is cheap, a worker only pays off after its own FT_Face is created
+constexpr uint32_t MIN_GLYPHS_PER_THREAD = 64U;
+constexpr uint32_t MAX_RASTER_THREADS    = 4U;
+
+constexpr float SDF_INF = 1e20F;
+
+// 1D squared euclidean distance transform, Felzenszwalb & Huttenlocher
+void distanceTransform1D(const float *f, float *d, int32_t *v, float *z, int32_t n) {
+    int32_t k = 0;
+    v[0]      = 0;
+    z[0]      = -SDF_INF;
+    z[1]      = SDF_INF;
+    for (int32_t q = 1; q < n; ++q) {
+        float s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + static_cast<float>(q * q)) - (f[v[k]] + static_cast<float>(v[k] * v[k]))) / static_cast<float>(2 * q - 2 * v[k]);
+        }
+        ++k;
+        v[k]     = q;
+        z[k]     = s;
+        z[k + 1] = SDF_INF;
+    }
+
+    k = 0;
+    for (int32_t q = 0; q < n; ++q) {
+        while (z[k + 1] < static_cast<float>(q)) {
+            ++k;
+        }
+        const auto dq = static_cast<float>(q - v[k]);
+        d[q]          = dq * dq + f[v[k]];
+    }
+}
+
+void distanceTransform2D(ccstd::vector<float> &grid, int32_t width, int32_t height) {
+    const int32_t          n = std::max(width, height);
+    ccstd::vector<float>   f(n);
+    ccstd::vector<float>   d(n);
+    ccstd::vector<float>   z(n + 1);
+    ccstd::vector<int32_t> v(n);
+
+    for (int32_t x = 0; x < width; ++x) {
+        for (int32_t y = 0; y < height; ++y) {
+            f[y] = grid[y * width + x];
+        }
+        distanceTransform1D(f.data(), d.data(), v.data(), z.data(), height);
+        for (int32_t y = 0; y < height; ++y) {
+            grid[y * width + x] = d[y];
+        }
+    }
+
+    for (int32_t y = 0; y < height; ++y) {
+        float *row = grid.data() + y * width;
+        distanceTransform1D(row, d.data(), v.data(), z.data(), width);
+        std::copy(d.begin(), d.begin() + width, row);
+    }
+}
+
+// encodes the outline at 0.5, inside approaches 1.0 and outside approaches 0.0 within SDF_SPREAD pixels
+void generateSDF(const uint8_t *coverage, uint32_t width, uint32_t height, ccstd::vector<uint8_t> &out) {
+    const auto spread    = static_cast<int32_t>(SDF_SPREAD);
+    const auto outWidth  = static_cast<int32_t>(width) + 2 * spread;
+    const auto outHeight = static_cast<int32_t>(height) + 2 * spread;
+    const auto count     = static_cast<size_t>(outWidth * outHeight);
+
+    ccstd::vector<float> outside(count, SDF_INF);
+    ccstd::vector<float> inside(count, 0.0F);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            if (coverage[y * width + x] >= 128U) {
+                const size_t index = (y + spread) * outWidth + (x + spread);
+                outside[index]     = 0.0F;
+                inside[index]      = SDF_INF;
+            }
+        }
+    }
+
+    distanceTransform2D(outside, outWidth, outHeight);
+    distanceTransform2D(inside, outWidth, outHeight);
+
+    const float scale = 0.5F / static_cast<float>(spread);
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const float distance = std::sqrt(outside[i]) - std::sqrt(inside[i]);
+        const float value    = std::min(std::max(0.5F - distance * scale, 0.0F), 1.0F);
+        out[i]               = static_cast<uint8_t>(value * 255.0F + 0.5F);
+    }
+}
+
+bool rasterizeGlyph(FT_Face face, uint32_t code, bool sdf, FTGlyphBitmap &out) {
+    FT_Error error = FT_Load_Char(face, code, FT_LOAD_RENDER);
+    if (error) {
+        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, code);
+        return false;
+    }
+
+    const FT_Bitmap &bitmap = face->glyph->bitmap;
+    FontGlyph &      glyph  = out.glyph;
+    glyph.width             = bitmap.width;
+    glyph.height            = bitmap.rows;
+    glyph.bearingX          = face->glyph->bitmap_left;
+    glyph.bearingY          = face->glyph->bitmap_top;
+    glyph.advance           = static_cast<int32_t>(face->glyph->advance.x >> 6); // advance.x's unit is 1/64 pixels
+
+    // rows may be padded, repack them tightly
+    out.pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.rows);
+    for (uint32_t row = 0; row < bitmap.rows; ++row) {
+        memcpy(out.pixels.data() + row * bitmap.width, bitmap.buffer + static_cast<int32_t>(row) * bitmap.pitch, bitmap.width);
+    }
+
+    if (sdf && glyph.width > 0U && glyph.height > 0U) {
+        ccstd::vector<uint8_t> field;
+        generateSDF(out.pixels.data(), glyph.width, glyph.height, field);
+        out.pixels = std::move(field);
+
+        const auto spread = static_cast<int16_t>(SDF_SPREAD);
+        glyph.width       = static_cast<uint16_t>(glyph.width + 2 * spread);
+        glyph.height      = static_cast<uint16_t>(glyph.height + 2 * spread);
+        glyph.bearingX    = static_cast<int16_t>(glyph.bearingX - spread);
+        glyph.bearingY    = static_cast<int16_t>(glyph.bearingY + spread);
+    }
+
+    out.loaded = true;
+    return true;
+}
+
+uint32_t getRasterThreadCount(size_t glyphCount) {
+    const uint32_t cores = std::max(std::thread::hardware_concurrency(), 1U);
+    const auto     limit = static_cast<uint32_t>(glyphCount / MIN_GLYPHS_PER_THREAD);
+    return std::max(std::min({cores, MAX_RASTER_THREADS, limit}), 1U);
+}
+
+uint64_t hashFontData(const ccstd::vector<uint8_t> &data) {
+    return static_cast<uint64_t>(boost::hash_range(data.begin(), data.end()));
+}
+
+template <typename T>
+void writeValue(ccstd::vector<uint8_t> &bytes, T value) {
+    const auto offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue(const uint8_t *&ptr, const uint8_t *end, T &value) {
+    if (static_cast<size_t>(end - ptr) < sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return true;
+}
+
+} // namespace
+
 /**
  * FreeTypeFontFace
  */
@@ -151,7 +328,8 @@ void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
         return;
     }
 
-    _fontSize      = info.fontSize < MIN_FONT_SIZE ? MIN_FONT_SIZE : (info.fontSize > MAX_FONT_SIZE ? MAX_FONT_SIZE : info.fontSize);
+    _sdf           = info.sdf;
+    _fontSize      = _sdf ? SDF_FONT_SIZE : (info.fontSize < MIN_FONT_SIZE ? MIN_FONT_SIZE : (info.fontSize > MAX_FONT_SIZE ? MAX_FONT_SIZE : info.fontSize));
     _textureWidth  = info.textureWidth;
     _textureHeight = info.textureHeight;
     _allocator     = std::make_unique<GlyphAllocator>(_textureWidth, _textureHeight);
@@ -172,9 +350,7 @@ void FreeTypeFontFace::doInit(const FontFaceInfo &info) {
     _face       = std::make_unique<FTFace>(face);
     _lineHeight = static_cast<uint32_t>(face->size->metrics.height >> 6);
 
-    for (const auto &code : info.preLoadedCharacters) {
-        loadGlyph(code);
-    }
+    loadGlyphs(info.preLoadedCharacters);
 }
 
 const FontGlyph *FreeTypeFontFace::getGlyph(uint32_t code) {
@@ -214,22 +390,82 @@ float FreeTypeFontFace::getKerning(uint32_t prevCode, uint32_t nextCode) {
 }
 
 const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
-    FT_Face  face  = _face->face;
-    FT_Error error = FT_Load_Char(face, code, FT_LOAD_RENDER);
-    if (error) {
-        CC_LOG_WARNING("FT_Load_Char failed, error code: %d, character: %u.", error, code);
+    FTGlyphBitmap bitmap;
+    if (!rasterizeGlyph(_face->face, code, _sdf, bitmap)) {
         return nullptr;
     }
 
-    FontGlyph glyph;
-    glyph.width    = face->glyph->bitmap.width;
-    glyph.height   = face->glyph->bitmap.rows;
-    glyph.bearingX = face->glyph->bitmap_left;
-    glyph.bearingY = face->glyph->bitmap_top;
-    glyph.advance  = static_cast<int32_t>(face->glyph->advance.x >> 6); // advance.x's unit is 1/64 pixels
+    return addGlyph(code, bitmap);
+}
 
-    uint32_t x = 0U;
-    uint32_t y = 0U;
+void FreeTypeFontFace::loadGlyphs(const ccstd::vector<uint32_t> &codes) {
+    if (!_face) {
+        return;
+    }
+
+    ccstd::vector<uint32_t> pending;
+    pending.reserve(codes.size());
+    for (const auto code : codes) {
+        if (_glyphs.find(code) == _glyphs.end()) {
+            pending.push_back(code);
+        }
+    }
+
+    if (pending.empty()) {
+        return;
+    }
+
+    ccstd::vector<FTGlyphBitmap> results(pending.size());
+    std::atomic<size_t>          next{0U};
+    auto                         rasterize = [&](FT_Face face) {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            rasterizeGlyph(face, pending[i], _sdf, results[i]);
+        }
+    };
+
+    // FT_Face is not thread safe, every worker opens its own library and face on the shared font data,
+    // the calling thread takes part with the face it already owns.
+    const uint32_t             threadCount = getRasterThreadCount(pending.size());
+    const auto &               fontData    = _font->getData();
+    ccstd::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back([&]() {
+            FTLibrary workerLibrary;
+            FT_Face   face{nullptr};
+            if (!workerLibrary.lib || FT_New_Memory_Face(workerLibrary.lib, fontData.data(), static_cast<FT_Long>(fontData.size()), 0, &face)) {
+                return;
+            }
+
+            FTFace workerFace(face);
+            if (!FT_Set_Pixel_Sizes(face, 0, _fontSize)) {
+                rasterize(face);
+            }
+        });
+    }
+
+    rasterize(_face->face);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    // atlas packing stays in request order so page layout is deterministic
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (results[i].loaded) {
+            addGlyph(pending[i], results[i]);
+        }
+    }
+}
+
+const FontGlyph *FreeTypeFontFace::addGlyph(uint32_t code, const FTGlyphBitmap &bitmap) {
+    auto iter = _glyphs.find(code);
+    if (iter != _glyphs.end()) {
+        return &iter->second;
+    }
+
+    FontGlyph glyph = bitmap.glyph;
+    uint32_t  x     = 0U;
+    uint32_t  y     = 0U;
 
     if (_textures.empty()) {
         createTexture(_textureWidth, _textureHeight);
@@ -248,8 +484,16 @@ const FontGlyph *FreeTypeFontFace::loadGlyph(uint32_t code) {
             }
         }
 
-        auto page = static_cast<uint32_t>(_textures.size() - 1);
-        updateTexture(page, x, y, glyph.width, glyph.height, face->glyph->bitmap.buffer);
+        auto  page  = static_cast<uint32_t>(_textures.size() - 1);
+        auto &atlas = _pages[page];
+        for (uint32_t row = 0; row < glyph.height; ++row) {
+            memcpy(atlas.pixels.data() + (y + row) * _textureWidth + x, bitmap.pixels.data() + row * glyph.width, glyph.width);
+        }
+
+        atlas.dirtyLeft   = std::min(atlas.dirtyLeft, x);
+        atlas.dirtyTop    = std::min(atlas.dirtyTop, y);
+        atlas.dirtyRight  = std::max(atlas.dirtyRight, x + glyph.width);
+        atlas.dirtyBottom = std::max(atlas.dirtyBottom, y + glyph.height);
 
         glyph.x    = x;
         glyph.y    = y;
@@ -271,9 +515,43 @@ void FreeTypeFontFace::createTexture(uint32_t width, uint32_t height) {
 
     _textures.push_back(texture);
 
-    std::vector<uint8_t> empty(width * height, 0);
-    auto                 page = static_cast<uint32_t>(_textures.size() - 1);
-    updateTexture(page, 0U, 0U, width, height, empty.data());
+    // the whole page is dirty so the first flush clears it
+    AtlasPage atlas;
+    atlas.pixels.resize(width * height, 0U);
+    atlas.dirtyRight  = width;
+    atlas.dirtyBottom = height;
+    _pages.push_back(std::move(atlas));
+}
+
+void FreeTypeFontFace::flush() {
+    ccstd::vector<uint8_t> staging;
+    for (uint32_t page = 0; page < _pages.size(); ++page) {
+        auto &atlas = _pages[page];
+        if (atlas.dirtyLeft >= atlas.dirtyRight || atlas.dirtyTop >= atlas.dirtyBottom) {
+            continue;
+        }
+
+        // gles backends ignore buffStride, so the dirty rect is packed before upload
+        const uint32_t width  = atlas.dirtyRight - atlas.dirtyLeft;
+        const uint32_t height = atlas.dirtyBottom - atlas.dirtyTop;
+        const uint8_t *buffer = atlas.pixels.data();
+        if (width != _textureWidth) {
+            staging.resize(width * height);
+            for (uint32_t row = 0; row < height; ++row) {
+                memcpy(staging.data() + row * width, atlas.pixels.data() + (atlas.dirtyTop + row) * _textureWidth + atlas.dirtyLeft, width);
+            }
+            buffer = staging.data();
+        } else {
+            buffer += atlas.dirtyTop * _textureWidth;
+        }
+
+        updateTexture(page, atlas.dirtyLeft, atlas.dirtyTop, width, height, buffer);
+
+        atlas.dirtyLeft   = _textureWidth;
+        atlas.dirtyTop    = _textureHeight;
+        atlas.dirtyRight  = 0U;
+        atlas.dirtyBottom = 0U;
+    }
 }
 
 void FreeTypeFontFace::updateTexture(uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *buffer) {
@@ -289,6 +567,90 @@ void FreeTypeFontFace::updateTexture(uint32_t page, uint32_t x, uint32_t y, uint
     device->copyBuffersToTexture(buffers, texture, regions);
 }
 
+bool FreeTypeFontFace::saveGlyphCache(const ccstd::string &path) const {
+    ccstd::vector<uint8_t> bytes;
+    writeValue(bytes, GLYPH_CACHE_MAGIC);
+    writeValue(bytes, GLYPH_CACHE_VERSION);
+    writeValue(bytes, hashFontData(_font->getData()));
+    writeValue(bytes, _fontSize);
+    writeValue(bytes, static_cast<uint32_t>(_sdf));
+    writeValue(bytes, static_cast<uint32_t>(_glyphs.size()));
+
+    for (const auto &iter : _glyphs) {
+        const auto &glyph = iter.second;
+        writeValue(bytes, iter.first);
+        writeValue(bytes, glyph.width);
+        writeValue(bytes, glyph.height);
+        writeValue(bytes, glyph.bearingX);
+        writeValue(bytes, glyph.bearingY);
+        writeValue(bytes, glyph.advance);
+
+        const auto &atlas  = _pages[glyph.page];
+        const auto  offset = bytes.size();
+        bytes.resize(offset + glyph.width * glyph.height);
+        for (uint32_t row = 0; row < glyph.height; ++row) {
+            memcpy(bytes.data() + offset + row * glyph.width, atlas.pixels.data() + (glyph.y + row) * _textureWidth + glyph.x, glyph.width);
+        }
+    }
+
+    Data data;
+    data.copy(bytes.data(), static_cast<ssize_t>(bytes.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, path);
+}
+
+bool FreeTypeFontFace::loadGlyphCache(const ccstd::string &path) {
+    if (!_face) {
+        return false;
+    }
+
+    const Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) {
+        return false;
+    }
+
+    const uint8_t *ptr = data.getBytes();
+    const uint8_t *end = ptr + data.getSize();
+
+    uint32_t magic{0U};
+    uint32_t version{0U};
+    uint64_t fontHash{0U};
+    uint32_t fontSize{0U};
+    uint32_t sdf{0U};
+    uint32_t count{0U};
+    if (!readValue(ptr, end, magic) || !readValue(ptr, end, version) || !readValue(ptr, end, fontHash) ||
+        !readValue(ptr, end, fontSize) || !readValue(ptr, end, sdf) || !readValue(ptr, end, count)) {
+        return false;
+    }
+
+    // a stale cache is simply ignored, glyphs are rasterized again on demand
+    if (magic != GLYPH_CACHE_MAGIC || version != GLYPH_CACHE_VERSION || fontHash != hashFontData(_font->getData()) ||
+        fontSize != _fontSize || (sdf != 0U) != _sdf) {
+        CC_LOG_WARNING("Glyph cache mismatch, path: %s.", path.c_str());
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t      code{0U};
+        FTGlyphBitmap bitmap;
+        FontGlyph &   glyph = bitmap.glyph;
+        if (!readValue(ptr, end, code) || !readValue(ptr, end, glyph.width) || !readValue(ptr, end, glyph.height) ||
+            !readValue(ptr, end, glyph.bearingX) || !readValue(ptr, end, glyph.bearingY) || !readValue(ptr, end, glyph.advance)) {
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>(glyph.width) * glyph.height;
+        if (static_cast<size_t>(end - ptr) < size) {
+            return false;
+        }
+
+        bitmap.pixels.assign(ptr, ptr + size);
+        ptr += size;
+        addGlyph(code, bitmap);
+    }
+
+    return true;
+}
+
 void FreeTypeFontFace::destroyFreeType() {
     if (library) {
         delete library;
@@ -304,10 +666,19 @@ FreeTypeFont::FreeTypeFont(const ccstd::string &path)
 }
 
 FontFace *FreeTypeFont::createFace(const FontFaceInfo &info) {
+    // one sdf face serves every font size
+    if (info.sdf) {
+        auto iter = _faces.find(SDF_FACE_KEY);
+        if (iter != _faces.end()) {
+            static_cast<FreeTypeFontFace *>(iter->second)->loadGlyphs(info.preLoadedCharacters);
+            return iter->second;
+        }
+    }
+
     auto *face = new FreeTypeFontFace(this);
     face->doInit(info);
 
-    uint32_t fontSize = face->getFontSize();
+    uint32_t fontSize = info.sdf ? SDF_FACE_KEY : face->getFontSize();
     _faces[fontSize]  = face;
 
     return face;
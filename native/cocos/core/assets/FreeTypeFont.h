@@ -30,11 +30,13 @@
 #include <memory>
 #include "Font.h"
 #include "base/std/container/string.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
 struct FTLibrary;
 struct FTFace;
+struct FTGlyphBitmap;
 class GlyphAllocator;
 
 /**
@@ -51,14 +53,33 @@ public:
 
     const FontGlyph *getGlyph(uint32_t code) override;
     float            getKerning(uint32_t prevCode, uint32_t nextCode) override;
+    void             flush() override;
     static void      destroyFreeType();
 
+    // rasterizes a batch of characters on worker threads, then packs them into the atlas.
+    void loadGlyphs(const ccstd::vector<uint32_t> &codes);
+
+    // persists loaded glyphs, so large character sets(e.g. CJK) can skip rasterization on next launch.
+    bool saveGlyphCache(const ccstd::string &path) const;
+    bool loadGlyphCache(const ccstd::string &path);
+
 private:
+    struct AtlasPage {
+        ccstd::vector<uint8_t> pixels;
+        uint32_t               dirtyLeft{0U};
+        uint32_t               dirtyTop{0U};
+        uint32_t               dirtyRight{0U};
+        uint32_t               dirtyBottom{0U};
+    };
+
     void             doInit(const FontFaceInfo &info) override;
     const FontGlyph *loadGlyph(uint32_t code);
+    const FontGlyph *addGlyph(uint32_t code, const FTGlyphBitmap &bitmap);
     void             createTexture(uint32_t width, uint32_t height);
     void             updateTexture(uint32_t page, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const uint8_t *buffer);
 
+    // cpu copy of every texture page, glyphs are written here and uploaded by flush.
+    ccstd::vector<AtlasPage>        _pages;
     std::unique_ptr<GlyphAllocator> _allocator{nullptr};
     std::unique_ptr<FTFace>         _face;
     static FTLibrary *              library;
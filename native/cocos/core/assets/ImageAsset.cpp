@@ -44,6 +44,8 @@ void ImageAsset::setNativeAsset(const cc::any &obj) {
             Image *image = *pImage;
             image->takeData(&_data);
             _needFreeData = true;
+            _dataSize     = static_cast<uint32_t>(image->getDataLen());
+            _dataReleased = false;
 
             _width  = image->getWidth();
             _height = image->getHeight();
@@ -52,11 +54,13 @@ void ImageAsset::setNativeAsset(const cc::any &obj) {
         } else {
             const auto *imageSource = cc::any_cast<IMemoryImageSource>(&obj);
             if (imageSource != nullptr) {
-                _arrayBuffer = imageSource->data;
-                _data        = const_cast<uint8_t *>(_arrayBuffer->getData());
-                _width       = imageSource->width;
-                _height      = imageSource->height;
-                _format      = imageSource->format;
+                _arrayBuffer  = imageSource->data;
+                _data         = const_cast<uint8_t *>(_arrayBuffer->getData());
+                _dataSize     = _arrayBuffer->byteLength();
+                _dataReleased = false;
+                _width        = imageSource->width;
+                _height       = imageSource->height;
+                _format       = imageSource->format;
             } else {
                 CC_LOG_WARNING("ImageAsset::setNativeAsset, unknown type!");
             }
@@ -88,4 +92,42 @@ ccstd::string ImageAsset::getUrl() const {
     return _url;
 }
 
+uint32_t ImageAsset::releaseData() {
+    // only images decoded from a file can be decoded again
+    if (!_data || !_needFreeData || _url.empty()) {
+        return 0;
+    }
+
+    free(_data);
+    _data         = nullptr;
+    _needFreeData = false;
+    _dataReleased = true;
+    return _dataSize;
+}
+
+bool ImageAsset::reloadData() {
+    if (_data) {
+        return true;
+    }
+    if (!_dataReleased) {
+        return false;
+    }
+
+    IntrusivePtr<Image> image = new Image();
+    if (!image->initWithImageFile(_url)) {
+        CC_LOG_WARNING("ImageAsset::reloadData, failed to decode %s", _url.c_str());
+        return false;
+    }
+    if (static_cast<uint32_t>(image->getWidth()) != _width || static_cast<uint32_t>(image->getHeight()) != _height || static_cast<PixelFormat>(image->getRenderFormat()) != _format) {
+        CC_LOG_WARNING("ImageAsset::reloadData, %s changed on disk", _url.c_str());
+        return false;
+    }
+
+    image->takeData(&_data);
+    _needFreeData = true;
+    _dataSize     = static_cast<uint32_t>(image->getDataLen());
+    _dataReleased = false;
+    return true;
+}
+
 } // namespace cc
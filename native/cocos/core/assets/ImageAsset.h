@@ -98,11 +98,31 @@ public:
      */
     ccstd::string getUrl() const;
 
+    /**
+     * @en Frees the pixel data decoded from the image file, it can be decoded again with reloadData.
+     * Data assigned from memory or from script is kept.
+     * @zh 释放从图像文件解码的像素数据，之后可通过 reloadData 重新解码。来自内存或脚本的数据会被保留。
+     * @return @en The number of bytes released. @zh 释放的字节数。
+     */
+    uint32_t releaseData();
+
+    /**
+     * @en Decodes the pixel data from the url again after releaseData.
+     * @zh 在 releaseData 之后从 url 重新解码像素数据。
+     * @return @en Whether the data is available. @zh 数据是否可用。
+     */
+    bool reloadData();
+
+    inline bool isDataReleased() const { return _dataReleased; }
+
     // Functions for TS.
     inline void setWidth(uint32_t width) { _width = width; }
     inline void setHeight(uint32_t height) { _height = height; }
     inline void setFormat(PixelFormat format) { _format = format; }
-    inline void setData(uint8_t *data) { _data = data; }
+    inline void setData(uint8_t *data) {
+        _data         = data;
+        _dataReleased = false;
+    }
     inline void setUrl(const ccstd::string &url) { _url = url; }
 
 private:
@@ -113,6 +133,8 @@ private:
     bool             _needFreeData{false}; // Should free data if the data is assigned in C++.
     ArrayBuffer::Ptr _arrayBuffer;         //minggo: hold the data from ImageSource.
     ccstd::string    _url;
+    uint32_t         _dataSize{0};
+    bool             _dataReleased{false};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(ImageAsset);
 };
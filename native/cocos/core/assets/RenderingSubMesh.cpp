@@ -35,6 +35,34 @@
 
 namespace cc {
 
+namespace {
+bool getJointAttribute(const Mesh::IVertexBundle &bundle, gfx::Format *outFormat, int32_t *outOffset) {
+    int32_t offset = 0;
+    for (const auto &attr : bundle.attributes) {
+        if (attr.name == gfx::ATTR_NAME_JOINTS) {
+            *outFormat = attr.format;
+            *outOffset = offset;
+            return true;
+        }
+        offset += static_cast<int32_t>(gfx::GFX_FORMAT_INFOS[static_cast<int32_t>(attr.format)].size);
+    }
+    return false;
+}
+
+void mapJointIndices(DataView &dataView, const Mesh::IVertexBundle &bundle, gfx::Format jointFormat, int32_t jointOffset, const ccstd::vector<index_t> &idxMap) {
+    mapBuffer(
+        dataView, [&](const DataVariant &cur, uint32_t /*idx*/, const DataView & /*view*/) -> DataVariant {
+            auto iter = std::find(idxMap.begin(), idxMap.end(), cc::get<0>(cur));
+            if (iter != idxMap.end()) {
+                return static_cast<int32_t>(iter - idxMap.begin());
+            }
+            CC_ASSERT(false);
+            return -1;
+        },
+        jointFormat, jointOffset, bundle.view.length, bundle.view.stride, &dataView);
+}
+} // namespace
+
 RenderingSubMesh::RenderingSubMesh(const gfx::BufferList &   vertexBuffers,
                                    const gfx::AttributeList &attributes,
                                    gfx::PrimitiveMode        primitiveMode)
@@ -211,6 +239,11 @@ bool RenderingSubMesh::destroy() {
         _jointMappedBufferIndices.clear();
     }
 
+    for (auto &buffer : _skinningSourceBuffers) {
+        CC_SAFE_DESTROY(buffer);
+    }
+    _skinningSourceBuffers.clear();
+
     CC_SAFE_DESTROY_NULL(_indirectBuffer);
     return true;
 }
@@ -234,35 +267,16 @@ const gfx::BufferList &RenderingSubMesh::getJointMappedBuffers() {
         _jointMappedBuffers = _vertexBuffers;
         return _jointMappedBuffers.get();
     }
-    gfx::Format  jointFormat = gfx::Format::UNKNOWN;
-    int32_t      jointOffset = 0;
-    gfx::Device *device      = gfx::Device::getInstance();
+    gfx::Device *device = gfx::Device::getInstance();
+    const auto & idxMap = structInfo.jointMaps.value()[prim.jointMapIndex.value()];
     for (size_t i = 0; i < prim.vertexBundelIndices.size(); i++) {
-        const auto &bundle = structInfo.vertexBundles[prim.vertexBundelIndices[i]];
-        jointOffset        = 0;
-        jointFormat        = gfx::Format::UNKNOWN;
-        for (const auto &attr : bundle.attributes) {
-            if (attr.name == gfx::ATTR_NAME_JOINTS) {
-                jointFormat = attr.format;
-                break;
-            }
-            jointOffset += static_cast<int32_t>(gfx::GFX_FORMAT_INFOS[static_cast<int32_t>(attr.format)].size);
-        }
-        if (jointFormat != gfx::Format::UNKNOWN) {
-            Uint8Array  data{_mesh->getData().buffer(), bundle.view.offset, bundle.view.length};
-            DataView    dataView(data.slice().buffer());
-            const auto &idxMap = structInfo.jointMaps.value()[prim.jointMapIndex.value()];
-
-            mapBuffer(
-                dataView, [&](const DataVariant &cur, uint32_t /*idx*/, const DataView & /*view*/) -> DataVariant {
-                    auto iter = std::find(idxMap.begin(), idxMap.end(), cc::get<0>(cur));
-                    if (iter != idxMap.end()) {
-                        return static_cast<int32_t>(iter - idxMap.begin());
-                    }
-                    CC_ASSERT(false);
-                    return -1;
-                },
-                jointFormat, jointOffset, bundle.view.length, bundle.view.stride, &dataView);
+        const auto &bundle      = structInfo.vertexBundles[prim.vertexBundelIndices[i]];
+        gfx::Format jointFormat = gfx::Format::UNKNOWN;
+        int32_t     jointOffset = 0;
+        if (getJointAttribute(bundle, &jointFormat, &jointOffset)) {
+            Uint8Array data{_mesh->getData().buffer(), bundle.view.offset, bundle.view.length};
+            DataView   dataView(data.slice().buffer());
+            mapJointIndices(dataView, bundle, jointFormat, jointOffset, idxMap);
 
             auto *buffer = device->createBuffer(gfx::BufferInfo{
                 gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
@@ -284,6 +298,44 @@ const gfx::BufferList &RenderingSubMesh::getJointMappedBuffers() {
     return buffers.get();
 }
 
+gfx::Buffer *RenderingSubMesh::getSkinningSourceBuffer(uint32_t stream) {
+    if (stream < _skinningSourceBuffers.size() && _skinningSourceBuffers[stream]) {
+        return _skinningSourceBuffers[stream];
+    }
+    if (!_mesh || !_subMeshIdx.has_value()) {
+        return nullptr;
+    }
+
+    const auto &structInfo = _mesh->getStruct();
+    const auto &prim       = structInfo.primitives[_subMeshIdx.value()];
+    if (stream >= prim.vertexBundelIndices.size()) {
+        return nullptr;
+    }
+    const auto &bundle = structInfo.vertexBundles[prim.vertexBundelIndices[stream]];
+    Uint8Array  data{_mesh->getData().buffer(), bundle.view.offset, bundle.view.length};
+    DataView    dataView(data.slice().buffer());
+
+    gfx::Format jointFormat = gfx::Format::UNKNOWN;
+    int32_t     jointOffset = 0;
+    if (structInfo.jointMaps.has_value() && prim.jointMapIndex.has_value() && !structInfo.jointMaps.value()[prim.jointMapIndex.value()].empty() &&
+        getJointAttribute(bundle, &jointFormat, &jointOffset)) {
+        mapJointIndices(dataView, bundle, jointFormat, jointOffset, structInfo.jointMaps.value()[prim.jointMapIndex.value()]);
+    }
+
+    auto *buffer = gfx::Device::getInstance()->createBuffer(gfx::BufferInfo{
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        bundle.view.length,
+        bundle.view.stride});
+    buffer->update(dataView.buffer()->getData());
+
+    if (stream >= _skinningSourceBuffers.size()) {
+        _skinningSourceBuffers.resize(stream + 1);
+    }
+    _skinningSourceBuffers[stream] = buffer;
+    return buffer;
+}
+
 gfx::Buffer *RenderingSubMesh::allocVertexIdBuffer(gfx::Device *device) {
     const uint32_t vertexCount = (_vertexBuffers.empty() || _vertexBuffers.at(0)->getStride() == 0)
                                      ? 0
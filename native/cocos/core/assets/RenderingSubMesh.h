@@ -165,6 +165,12 @@ public:
      */
     const gfx::BufferList &getJointMappedBuffers();
 
+    /**
+     * @en The joint mapped data of a vertex stream in a storage buffer, read by compute skinning. Created on first use.
+     * @zh 存储缓冲形式的单个顶点流的骨骼映射后数据，供计算着色器蒙皮读取，首次使用时创建。
+     */
+    gfx::Buffer *getSkinningSourceBuffer(uint32_t stream);
+
     bool destroy() override;
 
     /**
@@ -196,6 +202,8 @@ private:
 
     ccstd::vector<uint32_t> _jointMappedBufferIndices;
 
+    ccstd::vector<IntrusivePtr<gfx::Buffer>> _skinningSourceBuffers;
+
     cc::optional<VertexIdChannel> _vertexIdChannel;
 
     cc::optional<IGeometricInfo> _geometricInfo;
@@ -50,6 +50,9 @@ bool canGenerateMipmap(uint32_t w, uint32_t h) {
     return isPOT(w) && isPOT(h);
 }
 
+SimpleTexture::ImageDataPolicy defaultImageDataPolicy{SimpleTexture::ImageDataPolicy::KEEP};
+uint64_t                       releasedImageDataBytes{0};
+
 } // namespace
 
 SimpleTexture::SimpleTexture()= default;
@@ -91,6 +94,9 @@ void SimpleTexture::uploadData(const uint8_t *source, uint32_t level /* = 0 */,
 }
 
 void SimpleTexture::assignImage(ImageAsset *image, uint32_t level, uint32_t arrayIndex /* = 0 */) {
+    if (image->isDataReleased() && !image->reloadData()) {
+        return;
+    }
     const uint8_t *data = image->getData();
     if (!data) {
         return;
@@ -102,6 +108,29 @@ void SimpleTexture::assignImage(ImageAsset *image, uint32_t level, uint32_t arra
     emit(EventTypesToJS::SIMPLE_TEXTURE_AFTER_ASSIGN_IMAGE, image);
 }
 
+void SimpleTexture::setDefaultImageDataPolicy(ImageDataPolicy policy) {
+    defaultImageDataPolicy = policy == ImageDataPolicy::DEFAULT ? ImageDataPolicy::KEEP : policy;
+}
+
+SimpleTexture::ImageDataPolicy SimpleTexture::getDefaultImageDataPolicy() {
+    return defaultImageDataPolicy;
+}
+
+uint64_t SimpleTexture::getReleasedImageDataBytes() {
+    return releasedImageDataBytes;
+}
+
+bool SimpleTexture::shouldReleaseImageData() const {
+    const ImageDataPolicy policy = _imageDataPolicy == ImageDataPolicy::DEFAULT ? defaultImageDataPolicy : _imageDataPolicy;
+    return policy == ImageDataPolicy::RELEASE;
+}
+
+void SimpleTexture::releaseImageData(ImageAsset *image) {
+    if (image && _gfxTexture && shouldReleaseImageData()) {
+        releasedImageDataBytes += image->releaseData();
+    }
+}
+
 void SimpleTexture::checkTextureLoaded() {
     textureReady();
 }
@@ -163,11 +192,12 @@ void SimpleTexture::createTextureView(gfx::Device *device) {
     if (!_gfxTexture) {
         return;
     }
-    auto textureViewCreateInfo = getGfxTextureViewCreateInfo(
+    const uint32_t baseLevel             = getViewBaseLevel();
+    auto           textureViewCreateInfo = getGfxTextureViewCreateInfo(
     _gfxTexture,
     getGFXFormat(),
-    _baseLevel,
-    _maxLevel - _baseLevel + 1
+    baseLevel,
+    _maxLevel - baseLevel + 1
     );
 
     //TODO(minggo)
@@ -218,6 +248,26 @@ void SimpleTexture::setMipRangeInternal(uint32_t baseLevel, uint32_t maxLevel){
     _maxLevel = _maxLevel < _mipmapLevel ? _maxLevel : _mipmapLevel - 1;
 }
 
+void SimpleTexture::setStreamingBaseLevel(uint32_t level) {
+    if (_streamingBaseLevel == level) {
+        return;
+    }
+    _streamingBaseLevel = level;
+
+    if (!_gfxTexture || !_gfxTextureView) {
+        return;
+    }
+    // keep the view object so that descriptor sets holding it stay valid
+    const uint32_t baseLevel             = getViewBaseLevel();
+    auto           textureViewCreateInfo = getGfxTextureViewCreateInfo(_gfxTexture, getGFXFormat(), baseLevel, _maxLevel - baseLevel + 1);
+    _gfxTextureView->destroy();
+    _gfxTextureView->initialize(textureViewCreateInfo);
+}
+
+uint32_t SimpleTexture::getViewBaseLevel() const {
+    return std::min(std::max(_baseLevel, _streamingBaseLevel), _maxLevel);
+}
+
 void SimpleTexture::notifyTextureUpdated() {
     emit(EventTypesToJS::SIMPLE_TEXTURE_GFX_TEXTURE_UPDATED, _gfxTexture.get());
 }
@@ -41,6 +41,28 @@ class ImageAsset;
  */
 class SimpleTexture : public TextureBase {
 public:
+    /**
+     * @en What happens to the CPU copy of the images once they have been uploaded to the GPU.
+     * Released images are decoded again from their url when they have to be uploaded again,
+     * for example by updateImage after the graphics context has been recreated.
+     * @zh 图像上传至 GPU 后如何处理其 CPU 端数据。
+     * 被释放的图像在需要重新上传时（例如图形上下文重建后调用 updateImage）会从其 url 重新解码。
+     */
+    enum class ImageDataPolicy : uint8_t {
+        DEFAULT, // follows the global policy
+        KEEP,
+        RELEASE,
+    };
+
+    static void            setDefaultImageDataPolicy(ImageDataPolicy policy);
+    static ImageDataPolicy getDefaultImageDataPolicy();
+
+    /**
+     * @en The total number of image bytes released after upload.
+     * @zh 上传后被释放的图像数据总字节数。
+     */
+    static uint64_t getReleasedImageDataBytes();
+
     ~SimpleTexture() override;
 
     using Super = TextureBase;
@@ -116,6 +138,19 @@ public:
      */
     void setMipRange(uint32_t baseLevel, uint32_t maxLevel);
 
+    /**
+     * @en Set the first mipmap level exposed by the texture view for texture streaming, levels above it may not be uploaded yet.
+     * The view is re-initialized in place, so descriptor sets holding it need to be bound again.
+     * @zh 设置贴图流式加载时贴图视图的起始 Mipmap 层级，低于该层级的 Mipmap 可能尚未上传。
+     * 贴图视图会被原地重新初始化，持有它的描述符集需要重新绑定。
+     * @param level The first streamed mipmap level.
+     */
+    void setStreamingBaseLevel(uint32_t level);
+
+    inline void            setImageDataPolicy(ImageDataPolicy policy) { _imageDataPolicy = policy; }
+    inline ImageDataPolicy getImageDataPolicy() const { return _imageDataPolicy; }
+    bool                   shouldReleaseImageData() const;
+
 protected:
     SimpleTexture();
     void textureReady();
@@ -143,6 +178,8 @@ protected:
     void tryDestroyTextureView();
     void notifyTextureUpdated();
     void setMipRangeInternal(uint32_t baseLevel, uint32_t maxLevel);
+    uint32_t getViewBaseLevel() const;
+    void     releaseImageData(ImageAsset *image);
 
 
     IntrusivePtr<gfx::Texture> _gfxTexture;
@@ -155,6 +192,9 @@ protected:
     
     uint32_t _baseLevel{0};
     uint32_t _maxLevel{0};
+    uint32_t _streamingBaseLevel{0};
+
+    ImageDataPolicy _imageDataPolicy{ImageDataPolicy::DEFAULT};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(SimpleTexture);
 };
@@ -0,0 +1,161 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TextLayoutCache.h"
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include "Font.h"
+#include "base/UTF8.h"
+
+namespace cc {
+
+std::size_t TextLayoutCache::KeyHash::operator()(const Key &k) const {
+    size_t seed = boost::hash_range(k.text.begin(), k.text.end());
+    boost::hash_combine(seed, k.face);
+    boost::hash_combine(seed, k.scale);
+    boost::hash_combine(seed, k.kerning);
+    return seed;
+}
+
+TextLayoutCache::TextLayoutCache(size_t memoryLimit)
+: _memoryLimit(memoryLimit) {
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::getLayout(FontFace *face, const ccstd::string &text, const TextLayoutParams &params) {
+    Key  key{face, text, params.scale, params.kerning};
+    auto iter = _lookup.find(key);
+    if (iter != _lookup.end()) {
+        _entries.splice(_entries.begin(), _entries, iter->second);
+        return iter->second->layout;
+    }
+
+    std::shared_ptr<const TextLayout> result = layout(face, text, params);
+
+    const size_t size = sizeof(Entry) + sizeof(TextLayout) + 2 * text.size() + result->quads.capacity() * sizeof(TextLayoutQuad);
+    if (size > _memoryLimit) {
+        return result;
+    }
+
+    _entries.push_front({std::move(key), result, size});
+    _lookup.emplace(_entries.front().key, _entries.begin());
+    _memoryUsage += size;
+    evict();
+
+    return result;
+}
+
+std::shared_ptr<TextLayout> TextLayoutCache::layout(FontFace *face, const ccstd::string &text, const TextLayoutParams &params) {
+    auto result = std::make_shared<TextLayout>();
+
+    std::u32string unicodeText;
+    if (!face || !StringUtils::UTF8ToUTF32(text, unicodeText)) {
+        return result;
+    }
+
+    const auto scale      = params.scale;
+    const auto lineHeight = static_cast<float>(face->getLineHeight()) * scale;
+    const auto invWidth   = 1.0F / static_cast<float>(face->getTextureWidth());
+    const auto invHeight  = 1.0F / static_cast<float>(face->getTextureHeight());
+    auto       offsetX    = 0.0F;
+    auto       offsetY    = 0.0F;
+
+    result->quads.reserve(unicodeText.size());
+    for (size_t i = 0; i < unicodeText.size(); ++i) {
+        const char32_t code = unicodeText[i];
+        if (code == '\r') {
+            continue;
+        }
+
+        if (code == '\n') {
+            result->width = std::max(result->width, offsetX);
+            offsetX       = 0.0F;
+            offsetY += lineHeight;
+            continue;
+        }
+
+        const auto *glyph = face->getGlyph(code);
+        if (!glyph) {
+            continue;
+        }
+
+        if (glyph->width > 0U && glyph->height > 0U) {
+            TextLayoutQuad quad;
+            quad.rect = {offsetX + static_cast<float>(glyph->bearingX) * scale,
+                         offsetY - static_cast<float>(glyph->bearingY) * scale,
+                         static_cast<float>(glyph->width) * scale,
+                         static_cast<float>(glyph->height) * scale};
+            quad.uv   = {static_cast<float>(glyph->x) * invWidth,
+                         static_cast<float>(glyph->y) * invHeight,
+                         static_cast<float>(glyph->width) * invWidth,
+                         static_cast<float>(glyph->height) * invHeight};
+            quad.page = glyph->page;
+            result->quads.push_back(quad);
+        }
+
+        offsetX += static_cast<float>(glyph->advance) * scale;
+        if (params.kerning && i + 1 < unicodeText.size()) {
+            offsetX += face->getKerning(code, unicodeText[i + 1]) * scale;
+        }
+    }
+
+    result->width  = std::max(result->width, offsetX);
+    result->height = offsetY + lineHeight;
+
+    return result;
+}
+
+void TextLayoutCache::purge(const FontFace *face) {
+    for (auto iter = _entries.begin(); iter != _entries.end();) {
+        if (iter->key.face == face) {
+            _memoryUsage -= iter->size;
+            _lookup.erase(iter->key);
+            iter = _entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void TextLayoutCache::clear() {
+    _lookup.clear();
+    _entries.clear();
+    _memoryUsage = 0U;
+}
+
+void TextLayoutCache::setMemoryLimit(size_t memoryLimit) {
+    _memoryLimit = memoryLimit;
+    evict();
+}
+
+void TextLayoutCache::evict() {
+    while (_memoryUsage > _memoryLimit && !_entries.empty()) {
+        const auto &entry = _entries.back();
+        _memoryUsage -= entry.size;
+        _lookup.erase(entry.key);
+        _entries.pop_back();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+#include <memory>
+#include "base/std/container/list.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "math/Vec4.h"
+
+namespace cc {
+
+class FontFace;
+
+constexpr size_t DEFAULT_TEXT_LAYOUT_CACHE_SIZE = 1024U * 1024U;
+
+struct TextLayoutParams {
+    float scale{1.0F};
+    bool  kerning{false};
+};
+
+struct TextLayoutQuad {
+    Vec4     rect; // x, y relative to the layout origin, and size
+    Vec4     uv;   // normalized x, y, width, height in the atlas page
+    uint32_t page{0U};
+};
+
+/**
+ * TextLayout: ready-made glyph quads of a string, shared by every user of the same text.
+ */
+struct TextLayout {
+    ccstd::vector<TextLayoutQuad> quads;
+    float                         width{0.0F};
+    float                         height{0.0F};
+};
+
+/**
+ * TextLayoutCache: caches text layouts by (face, text, params), evicting the least recently used ones
+ * once the memory limit is exceeded. Layouts already handed out stay valid after eviction.
+ */
+class TextLayoutCache {
+public:
+    explicit TextLayoutCache(size_t memoryLimit = DEFAULT_TEXT_LAYOUT_CACHE_SIZE);
+    ~TextLayoutCache()                       = default;
+    TextLayoutCache(const TextLayoutCache &) = delete;
+    TextLayoutCache(TextLayoutCache &&)      = delete;
+    TextLayoutCache &operator=(const TextLayoutCache &) = delete;
+    TextLayoutCache &operator=(TextLayoutCache &&) = delete;
+
+    std::shared_ptr<const TextLayout> getLayout(FontFace *face, const ccstd::string &text, const TextLayoutParams &params = TextLayoutParams());
+
+    // drops layouts of a face, call it before the face is destroyed.
+    void purge(const FontFace *face);
+    void clear();
+    void setMemoryLimit(size_t memoryLimit);
+
+    inline size_t getMemoryLimit() const { return _memoryLimit; }
+    inline size_t getMemoryUsage() const { return _memoryUsage; }
+    inline size_t getCount() const { return _entries.size(); }
+
+    static std::shared_ptr<TextLayout> layout(FontFace *face, const ccstd::string &text, const TextLayoutParams &params);
+
+private:
+    struct Key {
+        const FontFace *face{nullptr};
+        ccstd::string   text;
+        float           scale{1.0F};
+        bool            kerning{false};
+
+        bool operator==(const Key &k) const noexcept {
+            return face == k.face && scale == k.scale && kerning == k.kerning && text == k.text;
+        }
+    };
+
+    struct KeyHash {
+        std::size_t operator()(const Key &k) const;
+    };
+
+    struct Entry {
+        Key                               key;
+        std::shared_ptr<const TextLayout> layout;
+        size_t                            size{0U};
+    };
+
+    using EntryList = ccstd::list<Entry>;
+
+    void evict();
+
+    // front is the most recently used
+    EntryList                                               _entries;
+    ccstd::unordered_map<Key, EntryList::iterator, KeyHash> _lookup;
+    size_t                                                  _memoryLimit{DEFAULT_TEXT_LAYOUT_CACHE_SIZE};
+    size_t                                                  _memoryUsage{0U};
+};
+
+} // namespace cc
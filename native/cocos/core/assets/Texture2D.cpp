@@ -28,12 +28,27 @@
 #include <sstream>
 
 #include "base/Log.h"
+#include "core/Root.h"
 #include "core/assets/ImageAsset.h"
+#include "core/assets/TextureStreaming.h"
+#include "renderer/gfx-base/GFXTexture.h"
 
 namespace cc {
 
-Texture2D::Texture2D()  = default;
-Texture2D::~Texture2D() = default;
+namespace {
+TextureStreaming *getTextureStreaming() {
+    auto *root = Root::getInstance();
+    return root ? root->getTextureStreaming() : nullptr;
+}
+} // namespace
+
+Texture2D::Texture2D() = default;
+
+Texture2D::~Texture2D() {
+    if (auto *streaming = getTextureStreaming()) {
+        streaming->unregisterTexture(this);
+    }
+}
 
 void Texture2D::syncMipmapsForJS(const ccstd::vector<IntrusivePtr<ImageAsset>> &value) {
     _mipmaps = value;
@@ -42,6 +57,13 @@ void Texture2D::syncMipmapsForJS(const ccstd::vector<IntrusivePtr<ImageAsset>> &
 void Texture2D::setMipmaps(const ccstd::vector<IntrusivePtr<ImageAsset>> &value) {
     _mipmaps = value;
     setMipmapLevel(static_cast<uint32_t>(_mipmaps.size()));
+
+    auto *streaming = getTextureStreaming();
+    if (streaming) {
+        streaming->unregisterTexture(this);
+    }
+    _streamingBaseLevel = 0;
+
     if (!_mipmaps.empty()) {
         ImageAsset *         imageAsset = _mipmaps[0];
         ITexture2DCreateInfo info;
@@ -53,10 +75,28 @@ void Texture2D::setMipmaps(const ccstd::vector<IntrusivePtr<ImageAsset>> &value)
         info.maxLevel    = _maxLevel;
         reset(info);
 
-        for (size_t i = 0, len = _mipmaps.size(); i < len; ++i) {
+        // only the lowest mipmaps are uploaded up front when streamed, generated mipmaps can't be streamed
+        const bool streamed = streaming && streaming->isEnabled() && _gfxTexture && _mipmapLevel == _mipmaps.size() &&
+                              _mipmapLevel > streaming->getResidentMipCount() && !hasFlag(_gfxTexture->getInfo().flags, gfx::TextureFlagBit::GEN_MIPMAP);
+        const uint32_t firstLevel = streamed ? streaming->getFloorLevel(_mipmapLevel) : 0;
+        if (streamed) {
+            setStreamingBaseLevel(firstLevel);
+        }
+
+        for (size_t i = firstLevel, len = _mipmaps.size(); i < len; ++i) {
             assignImage(_mipmaps[i], static_cast<uint32_t>(i));
         }
 
+        if (streamed) {
+            streaming->registerTexture(this);
+        } else {
+            // streamed textures upload their mipmaps again later and keep the data
+            for (const auto &mipmap : _mipmaps) {
+                releaseImageData(mipmap);
+            }
+        }
+        _streamed = streamed;
+
     } else {
         ITexture2DCreateInfo info;
         info.width       = 0;
@@ -65,6 +105,7 @@ void Texture2D::setMipmaps(const ccstd::vector<IntrusivePtr<ImageAsset>> &value)
         info.baseLevel   = _baseLevel;
         info.maxLevel    = _maxLevel;
         reset(info);
+        _streamed = false;
     }
 }
 
@@ -122,6 +163,9 @@ void Texture2D::updateMipmaps(uint32_t firstLevel, uint32_t count) {
     for (uint32_t i = 0; i < nUpdate; ++i) {
         uint32_t level = firstLevel + i;
         assignImage(_mipmaps[level], level);
+        if (!_streamed) {
+            releaseImageData(_mipmaps[level]);
+        }
     }
 }
 
@@ -130,6 +174,9 @@ HTMLElement *Texture2D::getHtmlElementObj() { //NOLINT
 }
 
 bool Texture2D::destroy() {
+    if (auto *streaming = getTextureStreaming()) {
+        streaming->unregisterTexture(this);
+    }
     _mipmaps.clear();
     return Super::destroy();
 }
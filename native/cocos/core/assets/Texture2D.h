@@ -212,6 +212,7 @@ public:
 
 private:
     ccstd::vector<IntrusivePtr<ImageAsset>> _mipmaps;
+    bool                                    _streamed{false};
 
     ccstd::vector<ccstd::string> _mipmapsUuids; // TODO(xwx): temporary use _mipmaps as UUIDs string array
 
@@ -0,0 +1,237 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/assets/TextureStreaming.h"
+#include <algorithm>
+#include <cmath>
+#include "core/assets/ImageAsset.h"
+#include "core/assets/Texture2D.h"
+#include "renderer/gfx-base/GFXDef.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDescriptorSetLayout.h"
+#include "renderer/gfx-base/GFXTexture.h"
+
+namespace cc {
+
+namespace {
+// frames a texture keeps its requested mipmaps after it was last requested
+constexpr uint32_t UNUSED_FRAMES = 60;
+
+// rebinds every slot holding the view so that backends refresh the resources they cached for it
+void refreshBindings(gfx::DescriptorSet *descriptorSet, gfx::Texture *view) {
+    for (const auto &binding : descriptorSet->getLayout()->getBindings()) {
+        if (binding.descriptorType != gfx::DescriptorType::SAMPLER_TEXTURE) {
+            continue;
+        }
+        for (uint32_t i = 0; i < binding.count; ++i) {
+            if (descriptorSet->getTexture(binding.binding, i) == view) {
+                descriptorSet->bindTexture(binding.binding, nullptr, i);
+                descriptorSet->bindTexture(binding.binding, view, i);
+            }
+        }
+    }
+    descriptorSet->update();
+}
+} // namespace
+
+TextureStreaming::TextureStreaming()  = default;
+TextureStreaming::~TextureStreaming() = default;
+
+void TextureStreaming::registerTexture(Texture2D *texture) {
+    if (!texture || !texture->getGFXTexture()) {
+        return;
+    }
+    unregisterTexture(texture);
+
+    auto *view           = texture->getGFXTexture();
+    auto &entry          = _entries[view];
+    entry.texture        = texture;
+    entry.levelCount     = texture->mipmapLevel();
+    entry.floorLevel     = getFloorLevel(entry.levelCount);
+    entry.residentLevel  = entry.floorLevel;
+    entry.uploadedLevel  = entry.floorLevel;
+    entry.requestedLevel = entry.levelCount;
+    entry.wantedLevel    = entry.floorLevel;
+    entry.lastUsedFrame  = _frame;
+    for (uint32_t level = entry.residentLevel; level < entry.levelCount; ++level) {
+        _residentBytes += getLevelBytes(entry, level);
+    }
+    _views[texture] = view;
+}
+
+void TextureStreaming::unregisterTexture(Texture2D *texture) {
+    auto viewIter = _views.find(texture);
+    if (viewIter == _views.end()) {
+        return;
+    }
+
+    auto iter = _entries.find(viewIter->second);
+    if (iter != _entries.end()) {
+        const auto &entry = iter->second;
+        for (uint32_t level = entry.residentLevel; level < entry.levelCount; ++level) {
+            _residentBytes -= getLevelBytes(entry, level);
+        }
+        _entries.erase(iter);
+    }
+    _views.erase(viewIter);
+}
+
+void TextureStreaming::requestMipLevels(gfx::DescriptorSet *descriptorSet, float screenSize) {
+    if (_entries.empty() || !descriptorSet) {
+        return;
+    }
+
+    for (const auto &binding : descriptorSet->getLayout()->getBindings()) {
+        if (binding.descriptorType != gfx::DescriptorType::SAMPLER_TEXTURE) {
+            continue;
+        }
+        for (uint32_t i = 0; i < binding.count; ++i) {
+            auto *view = descriptorSet->getTexture(binding.binding, i);
+            auto  iter = _entries.find(view);
+            if (iter == _entries.end()) {
+                continue;
+            }
+
+            // one texel per pixel, assuming the texture spans the object once
+            auto &      entry = iter->second;
+            const float size  = static_cast<float>(std::max(entry.texture->getWidth(), entry.texture->getHeight()));
+            const float ratio = size / std::max(screenSize, 1.F);
+            const auto  level = ratio > 1.F ? static_cast<uint32_t>(std::log2(ratio)) : 0U;
+
+            entry.requestedLevel = std::min(entry.requestedLevel, std::min(level, entry.floorLevel));
+            if (entry.refreshedSets.emplace(descriptorSet).second) {
+                refreshBindings(descriptorSet, view);
+            }
+        }
+    }
+}
+
+void TextureStreaming::update() {
+    ++_frame;
+
+    _sortedEntries.clear();
+    for (auto &pair : _entries) {
+        auto &entry = pair.second;
+        if (entry.requestedLevel < entry.levelCount) {
+            entry.wantedLevel   = entry.requestedLevel;
+            entry.lastUsedFrame = _frame;
+        } else if (_frame - entry.lastUsedFrame > UNUSED_FRAMES) {
+            entry.wantedLevel = entry.floorLevel;
+        }
+        entry.requestedLevel = entry.levelCount;
+
+        // the uploaded data stays in the texture, so finer mipmaps can be put back without uploading again
+        if (entry.residentLevel < entry.wantedLevel) {
+            setResidentLevel(entry, entry.wantedLevel);
+        } else if (entry.wantedLevel < entry.residentLevel) {
+            _sortedEntries.emplace_back(&entry);
+        }
+    }
+
+    if (_residentBytes > _budget) {
+        evict(0, _frame + 1);
+    }
+
+    // the most recently used first, then the ones missing the most mipmaps
+    std::sort(_sortedEntries.begin(), _sortedEntries.end(), [](const Entry *lhs, const Entry *rhs) {
+        if (lhs->lastUsedFrame != rhs->lastUsedFrame) {
+            return lhs->lastUsedFrame > rhs->lastUsedFrame;
+        }
+        return lhs->residentLevel - lhs->wantedLevel > rhs->residentLevel - rhs->wantedLevel;
+    });
+
+    uint32_t uploadedBytes = 0;
+    for (auto *entry : _sortedEntries) {
+        while (entry->residentLevel > entry->wantedLevel) {
+            const uint32_t level  = entry->residentLevel - 1;
+            const uint32_t bytes  = getLevelBytes(*entry, level);
+            const bool     upload = level < entry->uploadedLevel;
+            if (upload && uploadedBytes > 0 && uploadedBytes + bytes > _uploadBytesPerFrame) {
+                break;
+            }
+            if (_residentBytes + bytes > _budget && !evict(bytes, entry->lastUsedFrame)) {
+                break;
+            }
+
+            if (upload) {
+                auto *image = entry->texture->getMipmaps()[level].get();
+                if (!image || (image->isDataReleased() && !image->reloadData()) || !image->getData()) {
+                    break;
+                }
+                entry->texture->uploadData(image->getData(), level);
+                entry->uploadedLevel = level;
+                uploadedBytes += bytes;
+            }
+            setResidentLevel(*entry, level);
+        }
+    }
+}
+
+uint32_t TextureStreaming::getLevelBytes(const Entry &entry, uint32_t level) const {
+    const uint32_t width  = std::max(entry.texture->getWidth() >> level, 1U);
+    const uint32_t height = std::max(entry.texture->getHeight() >> level, 1U);
+    return gfx::formatSize(entry.texture->getGFXTexture()->getFormat(), width, height, 1);
+}
+
+void TextureStreaming::setResidentLevel(Entry &entry, uint32_t level) {
+    if (entry.residentLevel == level) {
+        return;
+    }
+
+    for (uint32_t i = std::min(level, entry.residentLevel), end = std::max(level, entry.residentLevel); i < end; ++i) {
+        const uint32_t bytes = getLevelBytes(entry, i);
+        _residentBytes       = level < entry.residentLevel ? _residentBytes + bytes : _residentBytes - bytes;
+    }
+    entry.residentLevel = level;
+    entry.texture->setStreamingBaseLevel(level);
+    entry.refreshedSets.clear();
+}
+
+bool TextureStreaming::evict(uint32_t bytes, uint32_t protectedFrame) {
+    _evictedEntries.clear();
+    for (auto &pair : _entries) {
+        auto &entry = pair.second;
+        if (entry.residentLevel < entry.floorLevel && entry.lastUsedFrame < protectedFrame) {
+            _evictedEntries.emplace_back(&entry);
+        }
+    }
+
+    // the least recently used first
+    std::sort(_evictedEntries.begin(), _evictedEntries.end(), [](const Entry *lhs, const Entry *rhs) {
+        return lhs->lastUsedFrame < rhs->lastUsedFrame;
+    });
+
+    for (auto *entry : _evictedEntries) {
+        while (_residentBytes + bytes > _budget && entry->residentLevel < entry->floorLevel) {
+            setResidentLevel(*entry, entry->residentLevel + 1);
+        }
+        if (_residentBytes + bytes <= _budget) {
+            return true;
+        }
+    }
+    return _residentBytes + bytes <= _budget;
+}
+
+} // namespace cc
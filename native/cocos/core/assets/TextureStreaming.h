@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class Texture2D;
+
+namespace gfx {
+class DescriptorSet;
+class Texture;
+} // namespace gfx
+
+/**
+ * @en Streams the mipmaps of registered 2D textures under a global budget.
+ * Only the lowest mipmaps are uploaded when a texture is loaded, finer ones are uploaded over the following frames
+ * once culling requests them, and the least recently used textures fall back to coarser mipmaps when the budget is exceeded.
+ * The GFX texture keeps its full mip chain, streaming only moves the base level of its texture view.
+ * @zh 在全局预算内流式加载已注册的 2D 贴图的 Mipmap。
+ * 贴图加载时只上传最低的几级 Mipmap，剔除请求了更精细的层级后会在之后的几帧内逐步上传，超出预算时最近最少使用的贴图会退回到更粗糙的层级。
+ * GFX 贴图始终保留完整的 Mipmap 链，流式加载只会移动其贴图视图的起始层级。
+ */
+class CC_DLL TextureStreaming final {
+public:
+    TextureStreaming();
+    ~TextureStreaming();
+
+    /**
+     * @en Whether textures set up afterwards are streamed, disabled by default.
+     * @zh 之后设置的贴图是否使用流式加载，默认关闭。
+     */
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+    inline bool isEnabled() const { return _enabled; }
+
+    /**
+     * @en Bytes of mipmaps that may be resident at once, the lowest mipmaps of each texture are always resident.
+     * @zh 同时驻留的 Mipmap 字节数上限，每张贴图最低的几级 Mipmap 总是驻留。
+     */
+    inline void     setBudget(uint32_t bytes) { _budget = bytes; }
+    inline uint32_t getBudget() const { return _budget; }
+
+    /**
+     * @en Bytes of mipmap data uploaded per frame at most, a single mipmap larger than this is still uploaded alone.
+     * @zh 每帧最多上传的 Mipmap 字节数，单个超过该值的 Mipmap 仍会被单独上传。
+     */
+    inline void     setUploadBytesPerFrame(uint32_t bytes) { _uploadBytesPerFrame = bytes; }
+    inline uint32_t getUploadBytesPerFrame() const { return _uploadBytesPerFrame; }
+
+    /**
+     * @en Count of the lowest mipmaps uploaded when a texture is loaded.
+     * @zh 贴图加载时上传的最低 Mipmap 层级数量。
+     */
+    inline void     setResidentMipCount(uint32_t count) { _residentMipCount = count < 1 ? 1 : count; }
+    inline uint32_t getResidentMipCount() const { return _residentMipCount; }
+
+    inline uint32_t getResidentBytes() const { return _residentBytes; }
+
+    // First level uploaded when a texture with levelCount mipmaps is loaded.
+    inline uint32_t getFloorLevel(uint32_t levelCount) const { return levelCount > _residentMipCount ? levelCount - _residentMipCount : 0; }
+
+    // The texture must have uploaded the mipmaps from getFloorLevel() on, and its GFX texture view must not be recreated while registered.
+    void registerTexture(Texture2D *texture);
+    void unregisterTexture(Texture2D *texture);
+
+    /**
+     * @en Requests the mipmaps of the streamed textures bound to the descriptor set, for an object covering screenSize pixels.
+     * Bindings of the descriptor set are refreshed if the texture views have changed since they were last seen.
+     * @zh 为覆盖 screenSize 个像素的物体请求绑定在该描述符集上的流式贴图的 Mipmap。
+     * 若贴图视图在上次请求之后发生了变化，会刷新该描述符集的绑定。
+     */
+    void requestMipLevels(gfx::DescriptorSet *descriptorSet, float screenSize);
+
+    // Applies the requests of the last frame, evicts and uploads mipmaps. Called once per frame by Root.
+    void update();
+
+private:
+    struct Entry {
+        Texture2D *texture{nullptr};
+        uint32_t   levelCount{0};
+        uint32_t   floorLevel{0};
+        uint32_t   residentLevel{0};
+        uint32_t   uploadedLevel{0};
+        uint32_t   requestedLevel{0};
+        uint32_t   wantedLevel{0};
+        uint32_t   lastUsedFrame{0};
+        // descriptor sets bound again since the view last changed
+        ccstd::unordered_set<gfx::DescriptorSet *> refreshedSets;
+    };
+
+    uint32_t getLevelBytes(const Entry &entry, uint32_t level) const;
+    void     setResidentLevel(Entry &entry, uint32_t level);
+    bool     evict(uint32_t bytes, uint32_t protectedFrame);
+
+    ccstd::unordered_map<const gfx::Texture *, Entry> _entries;
+    ccstd::unordered_map<Texture2D *, gfx::Texture *> _views;
+    ccstd::vector<Entry *>                            _sortedEntries;
+    ccstd::vector<Entry *>                            _evictedEntries;
+    uint32_t                                          _budget{64 * 1024 * 1024};
+    uint32_t                                          _uploadBytesPerFrame{4 * 1024 * 1024};
+    uint32_t                                          _residentMipCount{4};
+    uint32_t                                          _residentBytes{0};
+    uint32_t                                          _frame{0};
+    bool                                              _enabled{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TextureStreaming);
+};
+
+} // namespace cc
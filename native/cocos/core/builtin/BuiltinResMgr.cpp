@@ -9,6 +9,7 @@
 #include "core/data/deserializer/AssetDeserializerFactory.h"
 #include "math/Color.h"
 #include "platform/Image.h"
+#include "profiler/StartupTimer.h"
 #include "rapidjson/document.h"
 #include "renderer/core/ProgramLib.h"
 #include "scene/Pass.h"
@@ -147,6 +148,7 @@ bool BuiltinResMgr::initBuiltinRes(gfx::Device *device) {
     if (_isInitialized) {
         return true;
     }
+    CC_STARTUP_PHASE(builtin_resources);
 
     _isInitialized = true;
 
@@ -215,21 +217,10 @@ bool BuiltinResMgr::initBuiltinRes(gfx::Device *device) {
         IntrusivePtr<EffectAsset> effect = new EffectAsset();
         assetDeserializer->deserialize(e, effect);
 
+        // the sources are only assembled when ProgramLib registers the effect below
         index_t shaderIndex = 0;
         for (auto &shaderInfo : effect->_shaders) {
-            const auto &shaderSource = (*shaderSources)[effectIndex][shaderIndex];
-            if (!shaderSource.empty()) {
-                if (0 == strcmp(shaderVersionKey, "glsl1")) {
-                    shaderInfo.glsl1.vert = shaderSource.at("vert").value();
-                    shaderInfo.glsl1.frag = shaderSource.at("frag").value();
-                } else if (0 == strcmp(shaderVersionKey, "glsl3")) {
-                    shaderInfo.glsl3.vert = shaderSource.at("vert").value();
-                    shaderInfo.glsl3.frag = shaderSource.at("frag").value();
-                } else if (0 == strcmp(shaderVersionKey, "glsl4")) {
-                    shaderInfo.glsl4.vert = shaderSource.at("vert").value();
-                    shaderInfo.glsl4.frag = shaderSource.at("frag").value();
-                }
-            }
+            ShaderSourceAssembly::bind(shaderInfo.name, shaderVersionKey, effectIndex, shaderIndex);
             ++shaderIndex;
         }
 
@@ -238,6 +229,7 @@ bool BuiltinResMgr::initBuiltinRes(gfx::Device *device) {
 
         ++effectIndex;
     }
+    ShaderSourceAssembly::purge();
 
     initMaterials();
 
@@ -24,6 +24,9 @@
 ****************************************************************************/
 
 #include "core/builtin/ShaderSourceAssembly.h"
+#include <cstring>
+#include "base/Log.h"
+#include "core/assets/EffectAsset.h"
 #include "core/builtin/shader-sources/glsl1.h"
 #include "core/builtin/shader-sources/glsl3.h"
 #include "core/builtin/shader-sources/glsl4.h"
@@ -32,6 +35,163 @@ namespace cc {
 
 namespace {
 ShaderSourceMap assembly;
+
+struct ShaderBinding {
+    ShaderSource *source{nullptr};
+    ccstd::string version;
+    index_t       effectIndex{0};
+    index_t       shaderIndex{0};
+};
+ccstd::unordered_map<ccstd::string, ShaderBinding> bindings;
+
+class LayoutReader {
+public:
+    LayoutReader(const ccstd::string &table, size_t offset) : _table(table), _offset(offset) {}
+
+    bool readU32(uint32_t *value) {
+        if (_offset + sizeof(uint32_t) > _table.size()) {
+            return false;
+        }
+        memcpy(value, _table.data() + _offset, sizeof(uint32_t));
+        _offset += sizeof(uint32_t);
+        return true;
+    }
+
+    bool readString(const char **str) {
+        const auto end = _table.find('\0', _offset);
+        if (end == ccstd::string::npos) {
+            return false;
+        }
+        *str    = _table.data() + _offset;
+        _offset = end + 1;
+        return true;
+    }
+
+    // skips count u32 values, returns where they start
+    bool skipU32(uint32_t count, size_t *start) {
+        if (static_cast<uint64_t>(count) * sizeof(uint32_t) > _table.size() - _offset) {
+            return false;
+        }
+        *start = _offset;
+        _offset += count * sizeof(uint32_t);
+        return true;
+    }
+
+    inline size_t getOffset() const { return _offset; }
+    inline size_t getRemaining() const { return _table.size() - _offset; }
+
+private:
+    const ccstd::string &_table;
+    size_t               _offset{0};
+};
+} // namespace
+
+bool ShaderSource::load() {
+    if (_loaded) {
+        return !_shaders.empty();
+    }
+    _loaded = true;
+    _table  = _data.value();
+
+    LayoutReader reader(_table, 0);
+    uint32_t     lineCount = 0;
+    bool         ok        = reader.readU32(&lineCount) && lineCount <= reader.getRemaining();
+    _lineOffsets.reserve(ok ? lineCount + 1 : 0);
+    for (uint32_t i = 0; ok && i < lineCount; ++i) {
+        const char *line = nullptr;
+        _lineOffsets.push_back(static_cast<uint32_t>(reader.getOffset()));
+        ok = reader.readString(&line);
+    }
+    _lineOffsets.push_back(static_cast<uint32_t>(reader.getOffset()));
+
+    uint32_t effectCount = 0;
+    ok                   = ok && reader.readU32(&effectCount) && effectCount <= reader.getRemaining();
+    _shaders.resize(ok ? effectCount : 0);
+    for (auto &shaders : _shaders) {
+        uint32_t shaderCount = 0;
+        ok                   = ok && reader.readU32(&shaderCount) && shaderCount <= reader.getRemaining();
+        for (uint32_t i = 0; ok && i < shaderCount; ++i) {
+            shaders.push_back(reader.getOffset());
+
+            uint32_t stageCount = 0;
+            ok                  = reader.readU32(&stageCount);
+            for (uint32_t j = 0; ok && j < stageCount; ++j) {
+                const char *stage = nullptr;
+                uint32_t    count = 0;
+                size_t      start = 0;
+                ok                = reader.readString(&stage) && reader.readU32(&count) && reader.skipU32(count, &start);
+            }
+        }
+    }
+
+    if (!ok || reader.getRemaining() != 0) {
+        CC_LOG_ERROR("Builtin shader sources are corrupted.");
+        purge();
+        _loaded = true;
+        return false;
+    }
+    return true;
+}
+
+uint32_t ShaderSource::getEffectCount() {
+    return load() ? static_cast<uint32_t>(_shaders.size()) : 0;
+}
+
+uint32_t ShaderSource::getShaderCount(index_t effectIndex) {
+    if (!load() || effectIndex < 0 || effectIndex >= static_cast<index_t>(_shaders.size())) {
+        return 0;
+    }
+    return static_cast<uint32_t>(_shaders[effectIndex].size());
+}
+
+ShaderInfo ShaderSource::get(index_t effectIndex, index_t shaderIndex) {
+    ShaderInfo stages;
+    if (shaderIndex < 0 || static_cast<uint32_t>(shaderIndex) >= getShaderCount(effectIndex)) {
+        return stages;
+    }
+
+    const auto   lineCount = static_cast<uint32_t>(_lineOffsets.size() - 1);
+    LayoutReader reader(_table, _shaders[effectIndex][shaderIndex]);
+    uint32_t     stageCount = 0;
+    reader.readU32(&stageCount); // the layout was validated by load()
+    for (uint32_t i = 0; i < stageCount; ++i) {
+        const char *stage = nullptr;
+        uint32_t    count = 0;
+        size_t      start = 0;
+        reader.readString(&stage);
+        reader.readU32(&count);
+        reader.skipU32(count, &start);
+
+        const char *indices = _table.data() + start;
+        size_t      size    = 0;
+        for (uint32_t j = 0; j < count; ++j) {
+            uint32_t index = 0;
+            memcpy(&index, indices + j * sizeof(uint32_t), sizeof(uint32_t));
+            size += index < lineCount ? _lineOffsets[index + 1] - _lineOffsets[index] : 0;
+        }
+
+        // lines are joined with '\n', the NUL each of them is stored with takes its place in the size
+        ccstd::string &source = stages[stage];
+        source.reserve(size);
+        for (uint32_t j = 0; j < count; ++j) {
+            uint32_t index = 0;
+            memcpy(&index, indices + j * sizeof(uint32_t), sizeof(uint32_t));
+            if (j > 0) {
+                source.push_back('\n');
+            }
+            if (index < lineCount) {
+                source.append(_table.data() + _lineOffsets[index], _lineOffsets[index + 1] - _lineOffsets[index] - 1);
+            }
+        }
+    }
+    return stages;
+}
+
+void ShaderSource::purge() {
+    ccstd::string().swap(_table);
+    ccstd::vector<uint32_t>().swap(_lineOffsets);
+    ccstd::vector<ccstd::vector<size_t>>().swap(_shaders);
+    _loaded = false;
 }
 
 /*static*/
@@ -45,4 +205,48 @@ const ShaderSourceMap &ShaderSourceAssembly::get() {
     return assembly;
 }
 
+/*static*/
+void ShaderSourceAssembly::bind(const ccstd::string &shaderName, const char *version, index_t effectIndex, index_t shaderIndex) {
+    const auto &sources = get();
+    const auto  iter    = sources.find(version);
+    if (iter == sources.end()) {
+        return;
+    }
+    bindings[shaderName] = {iter->second, version, effectIndex, shaderIndex};
+}
+
+/*static*/
+bool ShaderSourceAssembly::resolve(IShaderInfo *shader) {
+    auto iter = bindings.find(shader->name);
+    if (iter == bindings.end()) {
+        return false;
+    }
+
+    const auto &   binding = iter->second;
+    IShaderSource *dst     = nullptr;
+    if (binding.version == "glsl1") {
+        dst = &shader->glsl1;
+    } else if (binding.version == "glsl3") {
+        dst = &shader->glsl3;
+    } else if (binding.version == "glsl4") {
+        dst = &shader->glsl4;
+    }
+
+    if (dst) {
+        ShaderInfo stages = binding.source->get(binding.effectIndex, binding.shaderIndex);
+        dst->vert         = std::move(stages["vert"]);
+        dst->frag         = std::move(stages["frag"]);
+    }
+    bindings.erase(iter);
+    return true;
+}
+
+/*static*/
+void ShaderSourceAssembly::purge() {
+    bindings.clear();
+    for (auto &iter : assembly) {
+        iter.second->purge();
+    }
+}
+
 } // namespace cc
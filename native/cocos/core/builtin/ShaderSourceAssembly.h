@@ -25,19 +25,61 @@
 
 #pragma once
 
+#include "base/Macros.h"
 #include "base/StringUtil.h"
+#include "base/TypeDef.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
 namespace cc {
 
-using ShaderInfo      = ccstd::unordered_map<ccstd::string, GzipedString>;
-using ShaderSource    = ccstd::vector<ccstd::vector<ShaderInfo>>;
-using ShaderSourceMap = ccstd::unordered_map<ccstd::string, const ShaderSource *>;
+struct IShaderInfo;
+
+// stage name ("vert", "frag") -> source
+using ShaderInfo = ccstd::unordered_map<ccstd::string, ccstd::string>;
+
+/**
+ * Builtin shader sources of one glsl version. Every distinct line is stored once and
+ * the table is compressed as a whole, see cmake/scripts/glsl_gzip.js for the layout.
+ * The table is inflated on first use and kept until purge().
+ */
+class CC_DLL ShaderSource final {
+public:
+    explicit ShaderSource(const char *data) : _data(data) {}
+
+    uint32_t getEffectCount();
+    uint32_t getShaderCount(index_t effectIndex);
+
+    // assembles the stages of a shader, empty if the effect has no sources for it
+    ShaderInfo get(index_t effectIndex, index_t shaderIndex);
+
+    void purge();
+
+private:
+    bool load();
+
+    GzipedString                         _data;
+    ccstd::string                        _table;
+    ccstd::vector<uint32_t>              _lineOffsets; // start of every line in _table, plus the end of the last one
+    ccstd::vector<ccstd::vector<size_t>> _shaders;     // start of every shader layout in _table, per effect
+    bool                                 _loaded{false};
+};
+
+using ShaderSourceMap = ccstd::unordered_map<ccstd::string, ShaderSource *>;
 
 class ShaderSourceAssembly final {
 public:
     static const ShaderSourceMap &get();
+
+    /**
+     * Builtin effects are registered without sources, bind() records where the sources of a
+     * shader are and ProgramLib pulls them in with resolve() when the effect is registered.
+     */
+    static void bind(const ccstd::string &shaderName, const char *version, index_t effectIndex, index_t shaderIndex);
+    static bool resolve(IShaderInfo *shader);
+
+    // drops the pending bindings and the inflated tables
+    static void purge();
 };
 
 } // namespace cc
@@ -0,0 +1,687 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/data/deserializer/EffectAssetBinaryDeserializer.h"
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "base/Log.h"
+#include "base/std/container/unordered_map.h"
+#include "core/assets/EffectAsset.h"
+
+namespace cc {
+
+namespace {
+
+constexpr size_t HEADER_SIZE = 5 * sizeof(uint32_t);
+
+inline uint32_t readU32(const uint8_t *p) {
+    uint32_t v = 0;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void appendU32(ccstd::vector<uint8_t> &out, uint32_t v) {
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&v);
+    out.insert(out.end(), bytes, bytes + sizeof(v));
+}
+
+class BinaryWriter {
+public:
+    static constexpr bool isReading() { return false; }
+    static constexpr bool isOk() { return true; }
+    static void           fail() {}
+
+    template <typename T>
+    void pod(T &v) {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic values are written as is");
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&v);
+        _payload.insert(_payload.end(), bytes, bytes + sizeof(T));
+    }
+
+    void string(ccstd::string &v) {
+        auto iter = _stringIndices.find(v);
+        if (iter == _stringIndices.end()) {
+            iter = _stringIndices.emplace(v, static_cast<uint32_t>(_strings.size())).first;
+            _strings.push_back(&iter->first);
+        }
+        pod(iter->second);
+    }
+
+    bool count(uint32_t &n, uint32_t /*minElementBytes*/) {
+        pod(n);
+        return true;
+    }
+
+    ccstd::vector<uint8_t> finish(uint32_t effectCount) const {
+        uint32_t stringBytes = 0;
+        for (const auto *str : _strings) {
+            stringBytes += static_cast<uint32_t>(str->size()) + 1;
+        }
+
+        ccstd::vector<uint8_t> out;
+        out.reserve(HEADER_SIZE + (_strings.size() + 1) * sizeof(uint32_t) + stringBytes + _payload.size());
+        appendU32(out, EffectAssetBinaryDeserializer::MAGIC);
+        appendU32(out, EffectAssetBinaryDeserializer::VERSION);
+        appendU32(out, static_cast<uint32_t>(_strings.size()));
+        appendU32(out, stringBytes);
+        appendU32(out, effectCount);
+
+        uint32_t offset = 0;
+        for (const auto *str : _strings) {
+            appendU32(out, offset);
+            offset += static_cast<uint32_t>(str->size()) + 1;
+        }
+        appendU32(out, offset);
+        for (const auto *str : _strings) {
+            out.insert(out.end(), str->begin(), str->end());
+            out.push_back(0);
+        }
+        out.insert(out.end(), _payload.begin(), _payload.end());
+        return out;
+    }
+
+private:
+    ccstd::vector<uint8_t>                        _payload;
+    ccstd::unordered_map<ccstd::string, uint32_t> _stringIndices;
+    ccstd::vector<const ccstd::string *>          _strings; // keys of _stringIndices, in index order
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t *data, size_t size) : _cursor(data), _end(data + size) {}
+
+    static constexpr bool isReading() { return true; }
+    inline bool           isOk() const { return !_failed; }
+
+    // validates the header and the string table, leaves the cursor at the first effect
+    bool open(uint32_t *effectCount) {
+        const size_t size = _end - _cursor;
+        if (size < HEADER_SIZE || readU32(_cursor) != EffectAssetBinaryDeserializer::MAGIC) {
+            CC_LOG_ERROR("EffectAssetBinaryDeserializer: not a binary effect");
+            return false;
+        }
+        if (readU32(_cursor + 4) != EffectAssetBinaryDeserializer::VERSION) {
+            CC_LOG_ERROR("EffectAssetBinaryDeserializer: unsupported version %u", readU32(_cursor + 4));
+            return false;
+        }
+        _stringCount               = readU32(_cursor + 8);
+        const uint32_t stringBytes = readU32(_cursor + 12);
+        *effectCount               = readU32(_cursor + 16);
+
+        const uint64_t tableSize = (static_cast<uint64_t>(_stringCount) + 1) * sizeof(uint32_t) + stringBytes;
+        if (tableSize > size - HEADER_SIZE) {
+            CC_LOG_ERROR("EffectAssetBinaryDeserializer: truncated string table");
+            return false;
+        }
+        _offsets = _cursor + HEADER_SIZE;
+        _chars   = reinterpret_cast<const char *>(_offsets + (_stringCount + 1) * sizeof(uint32_t));
+
+        // every string must be NUL terminated inside the table, string() relies on it
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i <= _stringCount; ++i) {
+            const uint32_t offset = readU32(_offsets + i * sizeof(uint32_t));
+            if ((i == 0 && offset != 0) || offset < previous || offset > stringBytes || (i > 0 && (offset == previous || _chars[offset - 1] != '\0'))) {
+                CC_LOG_ERROR("EffectAssetBinaryDeserializer: corrupted string table");
+                return false;
+            }
+            previous = offset;
+        }
+        if (previous != stringBytes) {
+            CC_LOG_ERROR("EffectAssetBinaryDeserializer: corrupted string table");
+            return false;
+        }
+
+        _cursor = reinterpret_cast<const uint8_t *>(_chars) + stringBytes;
+        return true;
+    }
+
+    template <typename T>
+    void pod(T &v) {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic values are read as is");
+        if (static_cast<size_t>(_end - _cursor) < sizeof(T)) {
+            fail();
+            return;
+        }
+        memcpy(&v, _cursor, sizeof(T));
+        _cursor += sizeof(T);
+    }
+
+    void string(ccstd::string &v) {
+        uint32_t index = 0;
+        pod(index);
+        if (_failed) {
+            return;
+        }
+        if (index >= _stringCount) {
+            fail();
+            return;
+        }
+        const uint32_t begin = readU32(_offsets + index * sizeof(uint32_t));
+        const uint32_t end   = readU32(_offsets + (index + 1) * sizeof(uint32_t)) - 1;
+        v.assign(_chars + begin, end - begin);
+    }
+
+    // rejects counts that can't fit in the remaining bytes before anything is allocated for them
+    bool count(uint32_t &n, uint32_t minElementBytes) {
+        pod(n);
+        if (!_failed && static_cast<uint64_t>(n) * minElementBytes > static_cast<uint64_t>(_end - _cursor)) {
+            fail();
+        }
+        return !_failed;
+    }
+
+    void fail() {
+        _failed = true;
+        _cursor = _end;
+    }
+
+    inline size_t getRemaining() const { return _end - _cursor; }
+
+private:
+
+    const uint8_t *_cursor{nullptr};
+    const uint8_t *_end{nullptr};
+    const uint8_t *_offsets{nullptr};
+    const char *   _chars{nullptr};
+    uint32_t       _stringCount{0};
+    bool           _failed{false};
+};
+
+// Every value is visited through transfer(), the same code writes and reads it.
+
+template <typename IO, typename T>
+std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> transfer(IO &io, T &v) {
+    io.pod(v);
+}
+
+template <typename IO, typename T>
+std::enable_if_t<std::is_enum<T>::value> transfer(IO &io, T &v) {
+    auto raw = static_cast<std::underlying_type_t<T>>(v);
+    io.pod(raw);
+    v = static_cast<T>(raw);
+}
+
+template <typename IO>
+void transfer(IO &io, bool &v) {
+    uint8_t raw = v ? 1 : 0;
+    io.pod(raw);
+    v = raw != 0;
+}
+
+template <typename IO>
+void transfer(IO &io, ccstd::string &v) {
+    io.string(v);
+}
+
+template <typename IO, typename T>
+void transfer(IO &io, cc::optional<T> &v);
+template <typename IO, typename T>
+void transfer(IO &io, ccstd::vector<T> &v);
+template <typename IO>
+void transfer(IO &io, ccstd::vector<bool> &v);
+template <typename IO, typename T>
+void transfer(IO &io, ccstd::unordered_map<ccstd::string, T> &v);
+template <typename IO, typename... Ts>
+void transfer(IO &io, cc::variant<Ts...> &v);
+template <typename IO>
+void transfer(IO &io, IPropertyHandleInfo &v);
+template <typename IO>
+void transfer(IO &io, gfx::Color &v);
+template <typename IO>
+void transfer(IO &io, gfx::Uniform &v);
+template <typename IO>
+void transfer(IO &io, IPropertyInfo &v);
+template <typename IO>
+void transfer(IO &io, RasterizerStateInfo &v);
+template <typename IO>
+void transfer(IO &io, DepthStencilStateInfo &v);
+template <typename IO>
+void transfer(IO &io, BlendTargetInfo &v);
+template <typename IO>
+void transfer(IO &io, BlendStateInfo &v);
+template <typename IO>
+void transfer(IO &io, IPassInfoFull &v);
+template <typename IO>
+void transfer(IO &io, ITechniqueInfo &v);
+template <typename IO>
+void transfer(IO &io, IBlockInfo &v);
+template <typename IO>
+void transfer(IO &io, ISamplerTextureInfo &v);
+template <typename IO>
+void transfer(IO &io, ITextureInfo &v);
+template <typename IO>
+void transfer(IO &io, ISamplerInfo &v);
+template <typename IO>
+void transfer(IO &io, IBufferInfo &v);
+template <typename IO>
+void transfer(IO &io, IImageInfo &v);
+template <typename IO>
+void transfer(IO &io, IInputAttachmentInfo &v);
+template <typename IO>
+void transfer(IO &io, IAttributeInfo &v);
+template <typename IO>
+void transfer(IO &io, IDefineInfo &v);
+template <typename IO>
+void transfer(IO &io, IBuiltin &v);
+template <typename IO>
+void transfer(IO &io, IBuiltinInfo &v);
+template <typename IO>
+void transfer(IO &io, IBuiltins &v);
+template <typename IO>
+void transfer(IO &io, IShaderSource &v);
+template <typename IO>
+void transfer(IO &io, IShaderInfo &v);
+
+template <typename IO, typename T>
+void transfer(IO &io, cc::optional<T> &v) {
+    bool present = v.has_value();
+    transfer(io, present);
+    if (!present || !io.isOk()) {
+        return;
+    }
+    if (io.isReading()) {
+        v.emplace();
+    }
+    transfer(io, v.value());
+}
+
+template <typename IO, typename T>
+void transfer(IO &io, ccstd::vector<T> &v) {
+    auto n = static_cast<uint32_t>(v.size());
+    if (!io.count(n, 1)) {
+        return;
+    }
+    if (io.isReading()) {
+        v.resize(n);
+    }
+    for (auto &e : v) {
+        transfer(io, e);
+    }
+}
+
+template <typename IO>
+void transfer(IO &io, ccstd::vector<bool> &v) {
+    auto n = static_cast<uint32_t>(v.size());
+    if (!io.count(n, 1)) {
+        return;
+    }
+    if (io.isReading()) {
+        v.resize(n);
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        bool e = v[i];
+        transfer(io, e);
+        v[i] = e;
+    }
+}
+
+// records are flattened into (name, value) lists
+template <typename IO, typename T>
+void transfer(IO &io, ccstd::unordered_map<ccstd::string, T> &v) {
+    auto n = static_cast<uint32_t>(v.size());
+    if (!io.count(n, sizeof(uint32_t))) {
+        return;
+    }
+    if (!io.isReading()) {
+        for (auto &e : v) {
+            transfer(io, const_cast<ccstd::string &>(e.first));
+            transfer(io, e.second);
+        }
+        return;
+    }
+    v.reserve(n);
+    for (uint32_t i = 0; i < n && io.isOk(); ++i) {
+        ccstd::string key;
+        T             value;
+        transfer(io, key);
+        transfer(io, value);
+        v.emplace(std::move(key), std::move(value));
+    }
+}
+
+template <size_t I, typename IO, typename... Ts>
+std::enable_if_t<(I == sizeof...(Ts))> transferAlternative(IO &io, cc::variant<Ts...> & /*v*/, uint8_t /*index*/) {
+    // out of range index, only reachable when reading
+    io.fail();
+}
+
+template <size_t I, typename IO, typename... Ts>
+std::enable_if_t<(I < sizeof...(Ts))> transferAlternative(IO &io, cc::variant<Ts...> &v, uint8_t index) {
+    if (index != I) {
+        transferAlternative<I + 1>(io, v, index);
+        return;
+    }
+    if (io.isReading()) {
+        v.template emplace<I>();
+    }
+    transfer(io, cc::get<I>(v));
+}
+
+template <typename IO, typename... Ts>
+void transfer(IO &io, cc::variant<Ts...> &v) {
+    auto index = static_cast<uint8_t>(v.index());
+    io.pod(index);
+    if (io.isOk()) {
+        transferAlternative<0>(io, v, index);
+    }
+}
+
+template <typename IO>
+void transfer(IO &io, IPropertyHandleInfo &v) {
+    transfer(io, std::get<0>(v));
+    transfer(io, std::get<1>(v));
+    transfer(io, std::get<2>(v));
+}
+
+template <typename IO>
+void transfer(IO &io, gfx::Color &v) {
+    transfer(io, v.x);
+    transfer(io, v.y);
+    transfer(io, v.z);
+    transfer(io, v.w);
+}
+
+template <typename IO>
+void transfer(IO &io, gfx::Uniform &v) {
+    transfer(io, v.name);
+    transfer(io, v.type);
+    transfer(io, v.count);
+}
+
+template <typename IO>
+void transfer(IO &io, IPropertyInfo &v) {
+    transfer(io, v.type);
+    transfer(io, v.handleInfo);
+    transfer(io, v.samplerHash);
+    transfer(io, v.value);
+    transfer(io, v.linear);
+}
+
+template <typename IO>
+void transfer(IO &io, RasterizerStateInfo &v) {
+    transfer(io, v.isDiscard);
+    transfer(io, v.isFrontFaceCCW);
+    transfer(io, v.depthBiasEnabled);
+    transfer(io, v.isDepthClip);
+    transfer(io, v.isMultisample);
+    transfer(io, v.polygonMode);
+    transfer(io, v.shadeModel);
+    transfer(io, v.cullMode);
+    transfer(io, v.depthBias);
+    transfer(io, v.depthBiasClamp);
+    transfer(io, v.depthBiasSlop);
+    transfer(io, v.lineWidth);
+}
+
+template <typename IO>
+void transfer(IO &io, DepthStencilStateInfo &v) {
+    transfer(io, v.depthTest);
+    transfer(io, v.depthWrite);
+    transfer(io, v.stencilTestFront);
+    transfer(io, v.stencilTestBack);
+    transfer(io, v.depthFunc);
+    transfer(io, v.stencilFuncFront);
+    transfer(io, v.stencilReadMaskFront);
+    transfer(io, v.stencilWriteMaskFront);
+    transfer(io, v.stencilFailOpFront);
+    transfer(io, v.stencilZFailOpFront);
+    transfer(io, v.stencilPassOpFront);
+    transfer(io, v.stencilRefFront);
+    transfer(io, v.stencilFuncBack);
+    transfer(io, v.stencilReadMaskBack);
+    transfer(io, v.stencilWriteMaskBack);
+    transfer(io, v.stencilFailOpBack);
+    transfer(io, v.stencilZFailOpBack);
+    transfer(io, v.stencilPassOpBack);
+    transfer(io, v.stencilRefBack);
+}
+
+template <typename IO>
+void transfer(IO &io, BlendTargetInfo &v) {
+    transfer(io, v.blend);
+    transfer(io, v.blendSrc);
+    transfer(io, v.blendDst);
+    transfer(io, v.blendEq);
+    transfer(io, v.blendSrcAlpha);
+    transfer(io, v.blendDstAlpha);
+    transfer(io, v.blendAlphaEq);
+    transfer(io, v.blendColorMask);
+}
+
+template <typename IO>
+void transfer(IO &io, BlendStateInfo &v) {
+    transfer(io, v.isA2C);
+    transfer(io, v.isIndepend);
+    transfer(io, v.blendColor);
+    transfer(io, v.targets);
+}
+
+template <typename IO>
+void transfer(IO &io, IPassInfoFull &v) {
+    // passIndex, defines and stateOverrides are filled in by Material::createPasses
+    transfer(io, v.priority);
+    transfer(io, v.primitive);
+    transfer(io, v.stage);
+    transfer(io, v.rasterizerState);
+    transfer(io, v.depthStencilState);
+    transfer(io, v.blendState);
+    transfer(io, v.dynamicStates);
+    transfer(io, v.phase);
+    transfer(io, v.program);
+    transfer(io, v.embeddedMacros);
+    transfer(io, v.propertyIndex);
+    transfer(io, v.switch_);
+    transfer(io, v.properties);
+}
+
+template <typename IO>
+void transfer(IO &io, ITechniqueInfo &v) {
+    transfer(io, v.passes);
+    transfer(io, v.name);
+}
+
+template <typename IO>
+void transfer(IO &io, IBlockInfo &v) {
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.members);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, ISamplerTextureInfo &v) {
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.type);
+    transfer(io, v.count);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, ITextureInfo &v) {
+    transfer(io, v.set);
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.type);
+    transfer(io, v.count);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, ISamplerInfo &v) {
+    transfer(io, v.set);
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.count);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, IBufferInfo &v) {
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.memoryAccess);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, IImageInfo &v) {
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.type);
+    transfer(io, v.count);
+    transfer(io, v.memoryAccess);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, IInputAttachmentInfo &v) {
+    transfer(io, v.set);
+    transfer(io, v.binding);
+    transfer(io, v.name);
+    transfer(io, v.count);
+    transfer(io, v.stageFlags);
+}
+
+template <typename IO>
+void transfer(IO &io, IAttributeInfo &v) {
+    transfer(io, v.name);
+    transfer(io, v.format);
+    transfer(io, v.isNormalized);
+    transfer(io, v.stream);
+    transfer(io, v.isInstanced);
+    transfer(io, v.location);
+    transfer(io, v.defines);
+}
+
+template <typename IO>
+void transfer(IO &io, IDefineInfo &v) {
+    transfer(io, v.name);
+    transfer(io, v.type);
+    transfer(io, v.range);
+    transfer(io, v.options);
+    transfer(io, v.defaultVal);
+}
+
+template <typename IO>
+void transfer(IO &io, IBuiltin &v) {
+    transfer(io, v.name);
+    transfer(io, v.defines);
+}
+
+template <typename IO>
+void transfer(IO &io, IBuiltinInfo &v) {
+    transfer(io, v.buffers);
+    transfer(io, v.blocks);
+    transfer(io, v.samplerTextures);
+    transfer(io, v.images);
+}
+
+template <typename IO>
+void transfer(IO &io, IBuiltins &v) {
+    transfer(io, v.globals);
+    transfer(io, v.locals);
+    transfer(io, v.statistics);
+}
+
+template <typename IO>
+void transfer(IO &io, IShaderSource &v) {
+    transfer(io, v.vert);
+    transfer(io, v.frag);
+}
+
+template <typename IO>
+void transfer(IO &io, IShaderInfo &v) {
+    transfer(io, v.name);
+    transfer(io, v.hash);
+    transfer(io, v.glsl4);
+    transfer(io, v.glsl3);
+    transfer(io, v.glsl1);
+    transfer(io, v.builtins);
+    transfer(io, v.defines);
+    transfer(io, v.attributes);
+    transfer(io, v.blocks);
+    transfer(io, v.samplerTextures);
+    transfer(io, v.samplers);
+    transfer(io, v.textures);
+    transfer(io, v.buffers);
+    transfer(io, v.images);
+    transfer(io, v.subpassInputs);
+}
+
+} // namespace
+
+template <typename IO>
+void EffectAssetBinaryDeserializer::transferEffect(IO &io, EffectAsset *effect) {
+    transfer(io, effect->_name);
+    transfer(io, effect->_techniques);
+    transfer(io, effect->_shaders);
+    transfer(io, effect->_combinations);
+}
+
+bool EffectAssetBinaryDeserializer::isBinaryEffect(const uint8_t *data, size_t size) {
+    return data && size >= HEADER_SIZE && readU32(data) == MAGIC;
+}
+
+ccstd::vector<uint8_t> EffectAssetBinaryDeserializer::serialize(const ccstd::vector<const EffectAsset *> &effects) {
+    BinaryWriter writer;
+    for (const auto *effect : effects) {
+        // the writer only reads through the references it is given
+        transferEffect(writer, const_cast<EffectAsset *>(effect));
+    }
+    return writer.finish(static_cast<uint32_t>(effects.size()));
+}
+
+bool EffectAssetBinaryDeserializer::deserialize(const uint8_t *data, size_t size, ccstd::vector<IntrusivePtr<EffectAsset>> *outEffects) {
+    BinaryReader reader(data, size);
+    uint32_t     effectCount = 0;
+    if (!data || !outEffects || !reader.open(&effectCount)) {
+        return false;
+    }
+
+    // an effect takes at least its name and three counts
+    if (static_cast<uint64_t>(effectCount) * 4 * sizeof(uint32_t) > reader.getRemaining()) {
+        CC_LOG_ERROR("EffectAssetBinaryDeserializer: invalid effect count %u", effectCount);
+        return false;
+    }
+
+    ccstd::vector<IntrusivePtr<EffectAsset>> effects;
+    effects.reserve(effectCount);
+    for (uint32_t i = 0; i < effectCount && reader.isOk(); ++i) {
+        IntrusivePtr<EffectAsset> effect = new EffectAsset();
+        transferEffect(reader, effect.get());
+        effects.push_back(std::move(effect));
+    }
+    if (!reader.isOk() || reader.getRemaining() != 0) {
+        CC_LOG_ERROR("EffectAssetBinaryDeserializer: corrupted effect data");
+        return false;
+    }
+
+    outEffects->insert(outEffects->end(), effects.begin(), effects.end());
+    return true;
+}
+
+} // namespace cc
@@ -0,0 +1,68 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+class EffectAsset;
+
+/**
+ * Compact binary alternative to the json effect format, for large effect libraries.
+ *
+ * Layout, little endian:
+ *   header       magic, version, string count, string bytes, effect count
+ *   string table (string count + 1) offsets followed by the NUL terminated characters,
+ *                used in place: strings are referenced by index everywhere else
+ *   payload      effects, one after another, macros and combinations stored as flat lists
+ *
+ * The payload is read with a single forward cursor straight into the EffectAsset
+ * structures, there is no intermediate document.
+ */
+class EffectAssetBinaryDeserializer final {
+public:
+    static constexpr uint32_t MAGIC{0x58464343}; // "CCFX"
+    static constexpr uint32_t VERSION{1};
+
+    static bool isBinaryEffect(const uint8_t *data, size_t size);
+
+    static ccstd::vector<uint8_t> serialize(const ccstd::vector<const EffectAsset *> &effects);
+
+    /**
+     * Creates one EffectAsset per effect stored in data, outEffects is left untouched on failure.
+     * The assets are not registered, callers finish them with onLoaded() as with json effects.
+     */
+    static bool deserialize(const uint8_t *data, size_t size, ccstd::vector<IntrusivePtr<EffectAsset>> *outEffects);
+
+private:
+    template <typename IO>
+    static void transferEffect(IO &io, EffectAsset *effect);
+};
+
+} // namespace cc
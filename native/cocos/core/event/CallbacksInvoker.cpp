@@ -57,7 +57,10 @@ void CallbackList::cancel(index_t index) {
 
     if (info) {
         if (_isInvoking) {
-            _callbackInfos[index] = nullptr;
+            if (*info != nullptr) {
+                _canceledInfos.emplace_back(std::move(*info));
+            }
+            *info = nullptr;
         } else {
             utils::array::fastRemoveAt(_callbackInfos, index);
         }
@@ -67,6 +70,9 @@ void CallbackList::cancel(index_t index) {
 
 void CallbackList::cancelAll() {
     for (auto &callbackInfo : _callbackInfos) {
+        if (_isInvoking && callbackInfo != nullptr) {
+            _canceledInfos.emplace_back(std::move(callbackInfo));
+        }
         callbackInfo = nullptr;
     }
     _containCanceled = true;
@@ -79,12 +85,14 @@ void CallbackList::purgeCanceled() {
             utils::array::fastRemoveAt(_callbackInfos, i);
         }
     }
+    _canceledInfos.clear();
     _containCanceled = false;
 }
 
 void CallbackList::clear() {
     cancelAll();
     _callbackInfos.clear();
+    _canceledInfos.clear();
     _isInvoking      = false;
     _containCanceled = false;
 }
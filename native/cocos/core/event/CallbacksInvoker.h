@@ -126,6 +126,8 @@ struct CallbackInfo final : public CallbackInfoBase {
 class CallbackList final {
 public:
     ccstd::vector<std::shared_ptr<CallbackInfoBase>> _callbackInfos;
+    // callbacks canceled while invoking, kept alive until the outermost emit returns
+    ccstd::vector<std::shared_ptr<CallbackInfoBase>> _canceledInfos;
     bool                                             _isInvoking{false};
     bool                                             _containCanceled{false};
 
@@ -376,74 +378,75 @@ void CallbacksInvoker::off(const KeyType &key, void (Target::*memberFn)(Args...)
 
 template <typename... Args>
 void CallbacksInvoker::emit(const KeyType &key, Args &&...args) {
+    auto iter = _callbackTable.find(key);
+    if (iter == _callbackTable.end() || iter->second._callbackInfos.empty()) {
+        return;
+    }
+
 #if CC_DEBUG
-    ccstd::vector<ccstd::string> argTypes{(typeid(Args).name())...};
+    const char *const argTypes[] = {(typeid(Args).name())..., nullptr};
+    const size_t      argCount   = sizeof...(Args);
 #endif
-    auto iter = _callbackTable.find(key);
-    if (iter != _callbackTable.end()) {
-        auto &list        = iter->second;
-        bool  rootInvoker = !list._isInvoking;
-        list._isInvoking  = true;
-
-        auto &infos = list._callbackInfos;
-        for (auto &i : infos) {
-            auto &baseInfo = i;
-            if (baseInfo == nullptr) {
-                continue;
-            }
+    auto &list        = iter->second;
+    bool  rootInvoker = !list._isInvoking;
+    list._isInvoking  = true;
+
+    // Callbacks added during the dispatch are appended and not invoked until the next emit,
+    // canceled ones are moved to _canceledInfos, so the raw pointers below stay valid.
+    auto &infos = list._callbackInfos;
+    for (size_t index = 0, count = infos.size(); index < count; ++index) {
+        auto *baseInfo = infos[index].get();
+        if (baseInfo == nullptr) {
+            continue;
+        }
 
 #if CC_DEBUG
-            CC_ASSERT(baseInfo->_argTypes.size() == argTypes.size());
-            for (size_t i = 0, len = argTypes.size(); i < len; ++i) {
-                if (baseInfo->_argTypes[i] != argTypes[i]) {
-                    CC_LOG_ERROR("Wrong argument type! baseInfo->_argTypes[%d]=%s, argTypes[%d]=%s", i, baseInfo->_argTypes[i].c_str(), i, argTypes[i].c_str());
-                    CC_ASSERT(false);
-                }
+        CC_ASSERT(baseInfo->_argTypes.size() == argCount);
+        for (size_t i = 0; i < argCount; ++i) {
+            if (baseInfo->_argTypes[i] != argTypes[i]) {
+                CC_LOG_ERROR("Wrong argument type! baseInfo->_argTypes[%d]=%s, argTypes[%d]=%s", i, baseInfo->_argTypes[i].c_str(), i, argTypes[i]);
+                CC_ASSERT(false);
             }
+        }
 #endif
-            using CallbackInfoType = CallbackInfo<Args...>;
-            auto info              = std::static_pointer_cast<CallbackInfoType>(i);
-            if (info != nullptr) {
-                if (info->_memberFn != nullptr && info->_target != nullptr) {
-                    auto  memberFn = info->_memberFn;
-                    auto *target   = reinterpret_cast<CCObject *>(info->_target);
-
-                    // Pre off once callbacks to avoid influence on logic in callback
-                    if (info->_once) {
-                        off(key, memberFn, target);
-                    }
-                    // Lazy check validity of callback target,
-                    // if target is CCObject and is no longer valid, then remove the callback info directly
-                    if (!info->check()) {
-                        off(key, memberFn, target);
-                    } else {
-                        (target->*memberFn)(std::forward<Args>(args)...);
-                    }
-                } else {
-                    const auto &         callback = info->_callback;
-                    CallbackInfoBase::ID cbID     = info->_id;
-                    // Pre off once callbacks to avoid influence on logic in callback
-                    if (info->_once) {
-                        off(key, cbID);
-                    }
-                    // Lazy check validity of callback target,
-                    // if target is CCObject and is no longer valid, then remove the callback info directly
-                    if (!info->check()) {
-                        off(key, cbID);
-                    } else {
-                        callback(std::forward<Args>(args)...);
-                    }
-                }
+        using CallbackInfoType = CallbackInfo<Args...>;
+        auto *info             = static_cast<CallbackInfoType *>(baseInfo);
+        if (info->_memberFn != nullptr && info->_target != nullptr) {
+            auto  memberFn = info->_memberFn;
+            auto *target   = reinterpret_cast<CCObject *>(info->_target);
+
+            // Pre off once callbacks to avoid influence on logic in callback
+            if (info->_once) {
+                off(key, memberFn, target);
+            }
+            // Lazy check validity of callback target,
+            // if target is CCObject and is no longer valid, then remove the callback info directly
+            if (!info->check()) {
+                off(key, memberFn, target);
             } else {
-                CC_ASSERT(false);
+                (target->*memberFn)(std::forward<Args>(args)...);
+            }
+        } else {
+            const auto &         callback = info->_callback;
+            CallbackInfoBase::ID cbID     = info->_id;
+            // Pre off once callbacks to avoid influence on logic in callback
+            if (info->_once) {
+                off(key, cbID);
+            }
+            // Lazy check validity of callback target,
+            // if target is CCObject and is no longer valid, then remove the callback info directly
+            if (!info->check()) {
+                off(key, cbID);
+            } else {
+                callback(std::forward<Args>(args)...);
             }
         }
+    }
 
-        if (rootInvoker) {
-            list._isInvoking = false;
-            if (list._containCanceled) {
-                list.purgeCanceled();
-            }
+    if (rootInvoker) {
+        list._isInvoking = false;
+        if (list._containCanceled) {
+            list.purgeCanceled();
         }
     }
 }
@@ -0,0 +1,236 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/geometry/BVH.h"
+
+#include "core/geometry/Intersect.h"
+
+namespace cc {
+namespace geometry {
+
+void BVH::build(const Vec3 *mins, const Vec3 *maxs, uint32_t count) {
+    clear();
+    if (count == 0) {
+        return;
+    }
+
+    _primitives.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        _primitives[i] = i;
+    }
+    // a balanced tree has less than 2 * count / MAX_LEAF_SIZE nodes
+    _nodes.reserve(2 * (count / MAX_LEAF_SIZE + 1));
+    buildNode(mins, maxs, 0, count, 0);
+}
+
+uint32_t BVH::buildNode(const Vec3 *mins, const Vec3 *maxs, uint32_t start, uint32_t count, uint32_t depth) {
+    const auto index = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+
+    Vec3 boundsMin{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 boundsMax{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    Vec3 centroidMin{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 centroidMax{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (uint32_t i = start; i < start + count; ++i) {
+        const uint32_t p = _primitives[i];
+        Vec3::min(boundsMin, mins[p], &boundsMin);
+        Vec3::max(boundsMax, maxs[p], &boundsMax);
+        const Vec3 centroid = (mins[p] + maxs[p]) * 0.5F;
+        Vec3::min(centroidMin, centroid, &centroidMin);
+        Vec3::max(centroidMax, centroid, &centroidMax);
+    }
+    _nodes[index].min = boundsMin;
+    _nodes[index].max = boundsMax;
+
+    const Vec3 extent = centroidMax - centroidMin;
+    // the traversal stack holds at most one pending node per level
+    if (count <= MAX_LEAF_SIZE || depth + 2 >= MAX_DEPTH || (extent.x <= 0.F && extent.y <= 0.F && extent.z <= 0.F)) {
+        _nodes[index].start = start;
+        _nodes[index].count = count;
+        return index;
+    }
+
+    // median split along the longest axis of the centroid bounds
+    int axis = 0;
+    if (extent.y > extent.x) axis = 1;
+    if (extent.z > (axis == 0 ? extent.x : extent.y)) axis = 2;
+    const auto centroidOf = [&](uint32_t p) {
+        const float *lo = &mins[p].x;
+        const float *hi = &maxs[p].x;
+        return lo[axis] + hi[axis];
+    };
+    const uint32_t half = count / 2;
+    std::nth_element(_primitives.begin() + start, _primitives.begin() + start + half, _primitives.begin() + start + count,
+                     [&](uint32_t a, uint32_t b) { return centroidOf(a) < centroidOf(b); });
+
+    buildNode(mins, maxs, start, half, depth + 1);
+    const uint32_t right = buildNode(mins, maxs, start + half, count - half, depth + 1);
+    _nodes[index].right  = right;
+    return index;
+}
+
+void BVH::refit(const Vec3 *mins, const Vec3 *maxs) {
+    // children are always stored after their parents
+    for (auto i = static_cast<int32_t>(_nodes.size()) - 1; i >= 0; --i) {
+        Node &node = _nodes[i];
+        if (node.count > 0) {
+            node.min = {FLT_MAX, FLT_MAX, FLT_MAX};
+            node.max = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            for (uint32_t j = node.start; j < node.start + node.count; ++j) {
+                Vec3::min(node.min, mins[_primitives[j]], &node.min);
+                Vec3::max(node.max, maxs[_primitives[j]], &node.max);
+            }
+        } else {
+            const Node &left  = _nodes[i + 1];
+            const Node &right = _nodes[node.right];
+            Vec3::min(left.min, right.min, &node.min);
+            Vec3::max(left.max, right.max, &node.max);
+        }
+    }
+}
+
+void BVH::clear() {
+    _nodes.clear();
+    _primitives.clear();
+}
+
+void TriangleBVH::build(const Float32Array &positions, const IBArray *indices, gfx::PrimitiveMode mode) {
+    _vertices.clear();
+    _vertexIndices.clear();
+
+    const uint32_t vertexCount = positions.length() / 3;
+    const uint32_t indexCount  = indices ? cc::visit([](const auto &arr) { return arr.length(); }, *indices) : vertexCount;
+    const auto     indexAt     = [&](uint32_t i) -> uint32_t {
+        return indices ? cc::visit([i](const auto &arr) { return static_cast<uint32_t>(arr[i]); }, *indices) : i;
+    };
+    const auto addTriangle = [&](uint32_t i0, uint32_t i1, uint32_t i2) {
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+            return;
+        }
+        for (const uint32_t v : {i0, i1, i2}) {
+            _vertexIndices.emplace_back(v);
+            _vertices.emplace_back(positions[v * 3], positions[v * 3 + 1], positions[v * 3 + 2]);
+        }
+    };
+
+    // same triangle order as the narrow phase of raySubMesh
+    if (mode == gfx::PrimitiveMode::TRIANGLE_LIST) {
+        for (uint32_t j = 0; j + 2 < indexCount; j += 3) {
+            addTriangle(indexAt(j), indexAt(j + 1), indexAt(j + 2));
+        }
+    } else if (mode == gfx::PrimitiveMode::TRIANGLE_STRIP) {
+        int32_t rev = 0;
+        for (uint32_t j = 0; j + 2 < indexCount; ++j) {
+            addTriangle(indexAt(j - rev), indexAt(j + rev + 1), indexAt(j + 2));
+            rev = ~rev;
+        }
+    } else if (mode == gfx::PrimitiveMode::TRIANGLE_FAN) {
+        for (uint32_t j = 1; j + 1 < indexCount; ++j) {
+            addTriangle(indexAt(0), indexAt(j), indexAt(j + 1));
+        }
+    }
+
+    const uint32_t      triangleCount = getTriangleCount();
+    ccstd::vector<Vec3> mins(triangleCount);
+    ccstd::vector<Vec3> maxs(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const Vec3 *v = &_vertices[t * 3];
+        Vec3::min(v[0], v[1], &mins[t]);
+        Vec3::min(mins[t], v[2], &mins[t]);
+        Vec3::max(v[0], v[1], &maxs[t]);
+        Vec3::max(maxs[t], v[2], &maxs[t]);
+    }
+    _bvh.build(mins.data(), maxs.data(), triangleCount);
+
+    // store the triangles in the primitive order of the tree, so each leaf is tested in one packet
+    ccstd::vector<Vec3>     vertices(_vertices.size());
+    ccstd::vector<uint32_t> vertexIndices(_vertexIndices.size());
+    for (uint32_t slot = 0; slot < triangleCount; ++slot) {
+        const uint32_t t = _bvh.getPrimitive(slot);
+        for (uint32_t k = 0; k < 3; ++k) {
+            vertices[slot * 3 + k]      = _vertices[t * 3 + k];
+            vertexIndices[slot * 3 + k] = _vertexIndices[t * 3 + k];
+        }
+    }
+    _vertices.swap(vertices);
+    _vertexIndices.swap(vertexIndices);
+}
+
+template <typename OnHit>
+float TriangleBVH::hitLeaf(const Ray &ray, uint32_t start, uint32_t count, float maxDistance, ERaycastMode mode, bool doubleSided, OnHit &&onHit) const {
+    ccstd::array<float, BVH::MAX_LEAF_SIZE> distances;
+    float                                   result = 0.F;
+    // leaves that could not be split may hold more triangles than one packet
+    for (uint32_t first = start; first < start + count; first += BVH::MAX_LEAF_SIZE) {
+        const uint32_t n = std::min(BVH::MAX_LEAF_SIZE, start + count - first);
+        rayTriangles(ray, &_vertices[first * 3], n, doubleSided, distances.data());
+        for (uint32_t i = 0; i < n; ++i) {
+            const float dist = distances[i];
+            if (dist == 0.F || dist > maxDistance) {
+                continue;
+            }
+            onHit(first + i, dist);
+            result = (mode != ERaycastMode::CLOSEST || result == 0.F || dist < result) ? dist : result;
+            if (mode == ERaycastMode::ANY) {
+                return result;
+            }
+            if (mode == ERaycastMode::CLOSEST) {
+                maxDistance = dist;
+            }
+        }
+    }
+    return result;
+}
+
+float TriangleBVH::raycast(const Ray &ray, IRaySubMeshOptions *opt) const {
+    auto &results = opt->result;
+    return _bvh.raycastLeaves(ray, opt->distance, opt->mode, [&](uint32_t start, uint32_t count, float maxDistance) {
+        return hitLeaf(ray, start, count, maxDistance, opt->mode, opt->doubleSided, [&](uint32_t triangle, float dist) {
+            if (!results.has_value()) {
+                return;
+            }
+            const IRaySubMeshResult hit{dist, _vertexIndices[triangle * 3], _vertexIndices[triangle * 3 + 1], _vertexIndices[triangle * 3 + 2]};
+            if (opt->mode != ERaycastMode::CLOSEST) {
+                results->emplace_back(hit);
+            } else if (results->empty()) {
+                results->emplace_back(hit);
+            } else if (dist < (*results)[0].distance) {
+                (*results)[0] = hit;
+            }
+        });
+    });
+}
+
+void TriangleBVH::raycastBatch(const Ray *rays, uint32_t count, float maxDistance, bool doubleSided, float *outDistances) const {
+    for (uint32_t i = 0; i < count; ++i) {
+        const Ray &ray  = rays[i];
+        outDistances[i] = _bvh.raycastLeaves(ray, maxDistance, ERaycastMode::CLOSEST, [&](uint32_t start, uint32_t n, float leafDistance) {
+            return hitLeaf(ray, start, n, leafDistance, ERaycastMode::CLOSEST, doubleSided, [](uint32_t /*triangle*/, float /*dist*/) {});
+        });
+    }
+}
+
+} // namespace geometry
+} // namespace cc
@@ -0,0 +1,234 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+#include "3d/assets/Types.h"
+#include "core/geometry/Ray.h"
+#include "core/geometry/Spec.h"
+#include "math/Vec3.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace geometry {
+
+/**
+ * @en Bounding volume hierarchy over axis aligned boxes, used to answer ray queries in logarithmic time.
+ * Nodes are stored depth first, so the left child of a node directly follows it.
+ * @zh 轴对齐包围盒的层次包围体，用于以对数复杂度回答射线查询。节点按深度优先存储，左子节点紧跟在父节点之后。
+ */
+class CC_DLL BVH final {
+public:
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+    static constexpr uint32_t MAX_DEPTH     = 64;
+
+    BVH()  = default;
+    ~BVH() = default;
+
+    // primitive i is bounded by [mins[i], maxs[i]], primitives with inverted bounds are never hit
+    void build(const Vec3 *mins, const Vec3 *maxs, uint32_t count);
+    // update the node bounds after the primitives moved, the tree layout is kept
+    void refit(const Vec3 *mins, const Vec3 *maxs);
+    void clear();
+
+    inline bool     empty() const { return _nodes.empty(); }
+    inline uint32_t getPrimitiveCount() const { return static_cast<uint32_t>(_primitives.size()); }
+    inline uint32_t getNodeCount() const { return static_cast<uint32_t>(_nodes.size()); }
+
+    /**
+     * @en Visit the primitives whose bounds are hit by the ray within maxDistance, nearer nodes first.
+     * visitor(primitive, maxDistance) returns the hit distance, or 0 on miss.
+     * In CLOSEST mode the search distance shrinks with every hit, in ANY mode the query stops at the first hit.
+     * Returns the closest hit distance in CLOSEST mode and the last hit distance otherwise, 0 if nothing is hit.
+     * @zh 访问射线在 maxDistance 内击中包围盒的图元，较近的节点优先。visitor(primitive, maxDistance) 返回击中距离，未击中返回 0。
+     * CLOSEST 模式下每次击中都会缩短搜索距离，ANY 模式下首次击中即停止。
+     */
+    template <typename Visitor>
+    float raycast(const Ray &ray, float maxDistance, ERaycastMode mode, Visitor &&visitor) const;
+
+    /**
+     * @en Same as raycast, but the leaves are visited as a whole so their primitives can be tested together.
+     * visitor(start, count, maxDistance) tests the primitives getPrimitive(start) to getPrimitive(start + count - 1),
+     * and returns the hit distance in the same way as the visitor of raycast.
+     * @zh 与 raycast 相同，但以整个叶节点为单位访问，便于同时检测其中的图元。
+     * visitor(start, count, maxDistance) 检测 getPrimitive(start) 到 getPrimitive(start + count - 1) 的图元，返回值与 raycast 的 visitor 相同。
+     */
+    template <typename LeafVisitor>
+    float raycastLeaves(const Ray &ray, float maxDistance, ERaycastMode mode, LeafVisitor &&visitor) const;
+
+    // primitives are reordered by build so the ones of each leaf are contiguous
+    inline uint32_t getPrimitive(uint32_t slot) const { return _primitives[slot]; }
+
+private:
+    struct Node {
+        Vec3     min;
+        Vec3     max;
+        uint32_t start{0};
+        uint32_t count{0}; // 0 for inner nodes
+        uint32_t right{0}; // index of the right child of inner nodes
+    };
+
+    uint32_t buildNode(const Vec3 *mins, const Vec3 *maxs, uint32_t start, uint32_t count, uint32_t depth);
+
+    // returns the entry distance of the ray into the box, or a negative value on miss
+    static inline float rayBox(const Vec3 &origin, const Vec3 &invDir, const Vec3 &min, const Vec3 &max, float maxDistance) {
+        const float tx1  = (min.x - origin.x) * invDir.x;
+        const float tx2  = (max.x - origin.x) * invDir.x;
+        const float ty1  = (min.y - origin.y) * invDir.y;
+        const float ty2  = (max.y - origin.y) * invDir.y;
+        const float tz1  = (min.z - origin.z) * invDir.z;
+        const float tz2  = (max.z - origin.z) * invDir.z;
+        const float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+        const float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+        // NaN from 0 * inf fails both comparisons and counts as a miss
+        return (tmax >= std::max(tmin, 0.F) && tmin <= maxDistance) ? std::max(tmin, 0.F) : -1.F;
+    }
+
+    ccstd::vector<Node>     _nodes;
+    ccstd::vector<uint32_t> _primitives;
+};
+
+template <typename Visitor>
+float BVH::raycast(const Ray &ray, float maxDistance, ERaycastMode mode, Visitor &&visitor) const {
+    return raycastLeaves(ray, maxDistance, mode, [&](uint32_t start, uint32_t count, float leafDistance) {
+        float result = 0.F;
+        for (uint32_t i = start; i < start + count; ++i) {
+            const float dist = visitor(_primitives[i], leafDistance);
+            if (dist == 0.F || dist > leafDistance) {
+                continue;
+            }
+            result = (mode != ERaycastMode::CLOSEST || result == 0.F || dist < result) ? dist : result;
+            if (mode == ERaycastMode::ANY) {
+                return result;
+            }
+            if (mode == ERaycastMode::CLOSEST) {
+                leafDistance = dist;
+            }
+        }
+        return result;
+    });
+}
+
+template <typename LeafVisitor>
+float BVH::raycastLeaves(const Ray &ray, float maxDistance, ERaycastMode mode, LeafVisitor &&visitor) const {
+    if (_nodes.empty()) {
+        return 0.F;
+    }
+
+    const Vec3 invDir{1.F / ray.d.x, 1.F / ray.d.y, 1.F / ray.d.z};
+    if (rayBox(ray.o, invDir, _nodes[0].min, _nodes[0].max, maxDistance) < 0.F) {
+        return 0.F;
+    }
+
+    float                              result = 0.F;
+    ccstd::array<uint32_t, MAX_DEPTH> stack;
+    uint32_t                           top = 0;
+    stack[top++]                           = 0;
+    while (top > 0) {
+        const Node &node = _nodes[stack[--top]];
+        if (node.count > 0) {
+            const float dist = visitor(node.start, node.count, maxDistance);
+            if (dist == 0.F || dist > maxDistance) {
+                continue;
+            }
+            result = (mode != ERaycastMode::CLOSEST || result == 0.F || dist < result) ? dist : result;
+            if (mode == ERaycastMode::ANY) {
+                return result;
+            }
+            if (mode == ERaycastMode::CLOSEST) {
+                maxDistance = dist;
+            }
+            continue;
+        }
+
+        const uint32_t left   = static_cast<uint32_t>(&node - _nodes.data()) + 1;
+        const uint32_t right  = node.right;
+        const float    tLeft  = rayBox(ray.o, invDir, _nodes[left].min, _nodes[left].max, maxDistance);
+        const float    tRight = rayBox(ray.o, invDir, _nodes[right].min, _nodes[right].max, maxDistance);
+        // push the farther child first so the nearer one is visited first
+        if (tLeft >= 0.F && tRight >= 0.F) {
+            stack[top++] = tLeft < tRight ? right : left;
+            stack[top++] = tLeft < tRight ? left : right;
+        } else if (tLeft >= 0.F) {
+            stack[top++] = left;
+        } else if (tRight >= 0.F) {
+            stack[top++] = right;
+        }
+    }
+    return result;
+}
+
+/**
+ * @en Triangle BVH of a sub mesh in model space, strips and fans are expanded into triangle lists.
+ * @zh 模型空间下子网格的三角形层次包围体，三角形带与扇会展开为三角形列表。
+ */
+class CC_DLL TriangleBVH final : public RefCounted {
+public:
+    TriangleBVH()           = default;
+    ~TriangleBVH() override = default;
+
+    void build(const Float32Array &positions, const IBArray *indices, gfx::PrimitiveMode mode);
+
+    inline uint32_t getTriangleCount() const { return static_cast<uint32_t>(_vertexIndices.size() / 3); }
+
+    /**
+     * @en Same as raySubMesh, the results of opt are filled in the same way.
+     * @zh 与 raySubMesh 相同，opt 中的结果填充方式也相同。
+     */
+    float raycast(const Ray &ray, IRaySubMeshOptions *opt) const;
+
+    /**
+     * @en Closest hits of a batch of rays, outDistances[i] is 0 if the i-th ray misses.
+     * @zh 批量计算多条射线的最近击中距离，第 i 条射线未击中时 outDistances[i] 为 0。
+     */
+    void raycastBatch(const Ray *rays, uint32_t count, float maxDistance, bool doubleSided, float *outDistances) const;
+
+    // the positions the tree was built from, used to detect stale trees
+    inline const void *getSource() const { return _source; }
+    inline void        setSource(const void *source) { _source = source; }
+
+private:
+    // closest hit among the triangles of a leaf, onHit(triangle, distance) is called for every hit within maxDistance
+    template <typename OnHit>
+    float hitLeaf(const Ray &ray, uint32_t start, uint32_t count, float maxDistance, ERaycastMode mode, bool doubleSided, OnHit &&onHit) const;
+
+    BVH                     _bvh;
+    ccstd::vector<Vec3>     _vertices;      // 3 per triangle, in the primitive order of the BVH
+    ccstd::vector<uint32_t> _vertexIndices; // 3 per triangle, in the primitive order of the BVH
+    const void *            _source{nullptr};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TriangleBVH);
+};
+
+} // namespace geometry
+} // namespace cc
@@ -1,14 +1,337 @@
 #include "cocos/core/geometry/Curve.h"
+#include <algorithm>
+#include <cmath>
+#include "math/Utils.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC_CURVE_USE_SSE
+#elif defined(__aarch64__) || defined(__arm64__)
+    #include <arm_neon.h>
+    #define CC_CURVE_USE_NEON
+#endif
+
 namespace cc {
 namespace geometry {
 
-float OptimizedKey::evaluate(float tt) {
-    const t = tt - time;
-    return evalOptCurve(t, coefficient);
+namespace {
+// the coarsest table tried, resolution doubles from here
+constexpr uint32_t LUT_MIN_SEGMENTS = 4;
+
+#if defined(CC_CURVE_USE_SSE)
+inline __m128 floor4(__m128 v) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.F)));
 }
 
-float evalOptCurve(float t, const ccstd::vector<float> &coefs) {
+inline __m128 wrap4(__m128 t, ExtrapolationMode mode, __m128 start, __m128 end, __m128 length, __m128 invLength) {
+    switch (mode) {
+        case ExtrapolationMode::LOOP: {
+            __m128 x = _mm_sub_ps(t, start);
+            x        = _mm_sub_ps(x, _mm_mul_ps(floor4(_mm_mul_ps(x, invLength)), length));
+            return _mm_add_ps(x, start);
+        }
+        case ExtrapolationMode::PING_PONG: {
+            __m128 x        = _mm_sub_ps(t, start);
+            __m128 length2  = _mm_add_ps(length, length);
+            __m128 invHalf  = _mm_mul_ps(invLength, _mm_set1_ps(0.5F));
+            x               = _mm_sub_ps(x, _mm_mul_ps(floor4(_mm_mul_ps(x, invHalf)), length2));
+            __m128 distance = _mm_sub_ps(x, length);
+            __m128 absDist  = _mm_andnot_ps(_mm_set1_ps(-0.F), distance);
+            return _mm_add_ps(_mm_sub_ps(length, absDist), start);
+        }
+        case ExtrapolationMode::CLAMP:
+        default:
+            return _mm_min_ps(_mm_max_ps(t, start), end);
+    }
+}
+#elif defined(CC_CURVE_USE_NEON)
+inline float32x4_t wrap4(float32x4_t t, ExtrapolationMode mode, float32x4_t start, float32x4_t end, float32x4_t length, float32x4_t invLength) {
+    switch (mode) {
+        case ExtrapolationMode::LOOP: {
+            float32x4_t x = vsubq_f32(t, start);
+            x             = vsubq_f32(x, vmulq_f32(vrndmq_f32(vmulq_f32(x, invLength)), length));
+            return vaddq_f32(x, start);
+        }
+        case ExtrapolationMode::PING_PONG: {
+            float32x4_t x       = vsubq_f32(t, start);
+            float32x4_t length2 = vaddq_f32(length, length);
+            float32x4_t invHalf = vmulq_n_f32(invLength, 0.5F);
+            x                   = vsubq_f32(x, vmulq_f32(vrndmq_f32(vmulq_f32(x, invHalf)), length2));
+            return vaddq_f32(vsubq_f32(length, vabsq_f32(vsubq_f32(x, length))), start);
+        }
+        case ExtrapolationMode::CLAMP:
+        default:
+            return vminq_f32(vmaxq_f32(t, start), end);
+    }
+}
+#endif
+} // namespace
+
+float evalOptCurve(float t, const ccstd::array<float, 4> &coefs) {
     return (t * (t * (t * coefs[0] + coefs[1]) + coefs[2])) + coefs[3];
 }
+
+float OptimizedKey::evaluate(float tt) const {
+    return evalOptCurve(tt - time, coefficient);
+}
+
+AnimationCurve::AnimationCurve()
+: AnimationCurve({{0.F, 1.F, 0.F, 0.F}, {1.F, 1.F, 0.F, 0.F}}) {
+}
+
+AnimationCurve::AnimationCurve(const ccstd::vector<Keyframe> &keyFrames) {
+    setKeyFrames(keyFrames);
+}
+
+void AnimationCurve::setKeyFrames(const ccstd::vector<Keyframe> &keyFrames) {
+    _keyFrames = keyFrames;
+    std::stable_sort(_keyFrames.begin(), _keyFrames.end(), [](const Keyframe &a, const Keyframe &b) {
+        return a.time < b.time;
+    });
+    onKeyFramesChanged();
+}
+
+void AnimationCurve::setPreWrapMode(ExtrapolationMode mode) {
+    _preWrapMode = mode;
+}
+
+void AnimationCurve::setPostWrapMode(ExtrapolationMode mode) {
+    _postWrapMode = mode;
+}
+
+void AnimationCurve::addKey(const Keyframe &keyFrame) {
+    auto iter = std::upper_bound(_keyFrames.begin(), _keyFrames.end(), keyFrame.time, [](float time, const Keyframe &key) {
+        return time < key.time;
+    });
+    _keyFrames.insert(iter, keyFrame);
+    onKeyFramesChanged();
+}
+
+void AnimationCurve::onKeyFramesChanged() {
+    _cachedKey = OptimizedKey();
+    clearLut();
+}
+
+float AnimationCurve::wrapTime(float time) const {
+    if (_keyFrames.empty()) return time;
+
+    const float startTime = _keyFrames.front().time;
+    const float endTime   = _keyFrames.back().time;
+    if (endTime <= startTime) return startTime;
+
+    switch (time < 0 ? _preWrapMode : _postWrapMode) {
+        case ExtrapolationMode::LOOP:
+            return mathutils::repeat(time - startTime, endTime - startTime) + startTime;
+        case ExtrapolationMode::PING_PONG:
+            return mathutils::pingPong(time - startTime, endTime - startTime) + startTime;
+        case ExtrapolationMode::CLAMP:
+        default:
+            return mathutils::clamp(time, startTime, endTime);
+    }
+}
+
+float AnimationCurve::evaluate(float time) {
+    const float wrappedTime = wrapTime(time);
+    return _lut.empty() ? evaluateWrapped(wrappedTime) : evaluateLut(wrappedTime);
+}
+
+float AnimationCurve::evaluateCurve(float time) {
+    return evaluateWrapped(wrapTime(time));
+}
+
+float AnimationCurve::evaluateWrapped(float wrappedTime) {
+    const auto nKeyframes = static_cast<int>(_keyFrames.size());
+    if (nKeyframes == 0) return 0.F;
+    if (nKeyframes == 1) return _keyFrames[0].value;
+
+    if (wrappedTime >= _cachedKey.time && wrappedTime < _cachedKey.endTime) {
+        return _cachedKey.evaluate(wrappedTime);
+    }
+    const int leftIndex  = findIndex(_cachedKey, wrappedTime);
+    const int rightIndex = std::min(leftIndex + 1, nKeyframes - 1);
+    calcOptimizedKey(_cachedKey, leftIndex, rightIndex);
+    return _cachedKey.evaluate(wrappedTime);
+}
+
+float AnimationCurve::evaluateLut(float wrappedTime) const {
+    const auto last = static_cast<uint32_t>(_lut.size()) - 1;
+    if (last == 0) return _lut[0];
+
+    const float x     = (wrappedTime - _keyFrames.front().time) * _lutInvStep;
+    const auto  index = std::min(static_cast<uint32_t>(std::max(x, 0.F)), last - 1);
+    const float ratio = std::min(x - static_cast<float>(index), 1.F);
+    return _lut[index] + (_lut[index + 1] - _lut[index]) * ratio;
+}
+
+void AnimationCurve::evaluate(const float *times, float *results, uint32_t count) {
+    if (_lut.empty() || _lut.size() == 1) {
+        for (uint32_t i = 0; i < count; ++i) {
+            results[i] = evaluate(times[i]);
+        }
+        return;
+    }
+
+    uint32_t i = 0;
+#if defined(CC_CURVE_USE_SSE) || defined(CC_CURVE_USE_NEON)
+    const float startTime = _keyFrames.front().time;
+    const float endTime   = _keyFrames.back().time;
+    const float length    = endTime - startTime;
+    const float lastIndex = static_cast<float>(_lut.size() - 2);
+    alignas(16) int32_t indices[4];
+    alignas(16) float   lhs[4];
+    alignas(16) float   rhs[4];
+    #if defined(CC_CURVE_USE_SSE)
+    const __m128 start    = _mm_set1_ps(startTime);
+    const __m128 end      = _mm_set1_ps(endTime);
+    const __m128 len      = _mm_set1_ps(length);
+    const __m128 invLen   = _mm_set1_ps(1.F / length);
+    const __m128 invStep  = _mm_set1_ps(_lutInvStep);
+    const __m128 maxIndex = _mm_set1_ps(lastIndex);
+    const __m128 zero     = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 t       = _mm_loadu_ps(times + i);
+        __m128 pre     = wrap4(t, _preWrapMode, start, end, len, invLen);
+        __m128 post    = wrap4(t, _postWrapMode, start, end, len, invLen);
+        __m128 isPre   = _mm_cmplt_ps(t, zero);
+        __m128 wrapped = _mm_or_ps(_mm_and_ps(isPre, pre), _mm_andnot_ps(isPre, post));
+        __m128 x       = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(wrapped, start), invStep), zero);
+        __m128 index   = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(x)), maxIndex);
+        __m128 ratio   = _mm_min_ps(_mm_sub_ps(x, index), _mm_set1_ps(1.F));
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices), _mm_cvttps_epi32(index));
+        for (int lane = 0; lane < 4; ++lane) {
+            lhs[lane] = _lut[indices[lane]];
+            rhs[lane] = _lut[indices[lane] + 1];
+        }
+        __m128 a = _mm_load_ps(lhs);
+        __m128 b = _mm_load_ps(rhs);
+        _mm_storeu_ps(results + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), ratio)));
+    }
+    #else
+    const float32x4_t start    = vdupq_n_f32(startTime);
+    const float32x4_t end      = vdupq_n_f32(endTime);
+    const float32x4_t len      = vdupq_n_f32(length);
+    const float32x4_t invLen   = vdupq_n_f32(1.F / length);
+    const float32x4_t invStep  = vdupq_n_f32(_lutInvStep);
+    const float32x4_t maxIndex = vdupq_n_f32(lastIndex);
+    const float32x4_t zero     = vdupq_n_f32(0.F);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t t       = vld1q_f32(times + i);
+        float32x4_t pre     = wrap4(t, _preWrapMode, start, end, len, invLen);
+        float32x4_t post    = wrap4(t, _postWrapMode, start, end, len, invLen);
+        float32x4_t wrapped = vbslq_f32(vcltq_f32(t, zero), pre, post);
+        float32x4_t x       = vmaxq_f32(vmulq_f32(vsubq_f32(wrapped, start), invStep), zero);
+        float32x4_t index   = vminq_f32(vrndq_f32(x), maxIndex);
+        float32x4_t ratio   = vminq_f32(vsubq_f32(x, index), vdupq_n_f32(1.F));
+        vst1q_s32(indices, vcvtq_s32_f32(index));
+        for (int lane = 0; lane < 4; ++lane) {
+            lhs[lane] = _lut[indices[lane]];
+            rhs[lane] = _lut[indices[lane] + 1];
+        }
+        float32x4_t a = vld1q_f32(lhs);
+        float32x4_t b = vld1q_f32(rhs);
+        vst1q_f32(results + i, vmlaq_f32(a, vsubq_f32(b, a), ratio));
+    }
+    #endif
+#endif
+    for (; i < count; ++i) {
+        results[i] = evaluateLut(wrapTime(times[i]));
+    }
+}
+
+bool AnimationCurve::bakeLut(uint32_t maxResolution, float tolerance) {
+    clearLut();
+    if (_keyFrames.size() < 2 || _keyFrames.back().time <= _keyFrames.front().time) {
+        _lut.push_back(evaluateWrapped(wrapTime(0.F)));
+        return true;
+    }
+
+    const float startTime = _keyFrames.front().time;
+    const float length    = _keyFrames.back().time - startTime;
+    for (uint32_t segments = LUT_MIN_SEGMENTS; segments + 1 <= maxResolution; segments *= 2) {
+        const float step = length / static_cast<float>(segments);
+        _lut.resize(segments + 1);
+        for (uint32_t i = 0; i < segments; ++i) {
+            _lut[i] = evaluateWrapped(startTime + step * static_cast<float>(i));
+        }
+        _lut[segments] = evaluateWrapped(_keyFrames.back().time);
+
+        // the interpolation error peaks between samples
+        float maxError = 0.F;
+        for (uint32_t i = 0; i < segments && maxError <= tolerance; ++i) {
+            const float mid = evaluateWrapped(startTime + step * (static_cast<float>(i) + 0.5F));
+            maxError        = std::max(maxError, std::abs(mid - (_lut[i] + _lut[i + 1]) * 0.5F));
+        }
+        if (maxError <= tolerance) {
+            _lutInvStep = 1.F / step;
+            return true;
+        }
+    }
+    clearLut();
+    return false;
+}
+
+void AnimationCurve::clearLut() {
+    _lut.clear();
+    _lutInvStep = 0.F;
+}
+
+void AnimationCurve::calcOptimizedKey(OptimizedKey &optKey, int leftIndex, int rightIndex) const {
+    const Keyframe &lhs = _keyFrames[leftIndex];
+    const Keyframe &rhs = _keyFrames[rightIndex];
+    optKey.index        = leftIndex;
+    optKey.time         = lhs.time;
+    optKey.endTime      = rhs.time;
+
+    const float dx = rhs.time - lhs.time;
+    if (dx <= 0.F) {
+        optKey.coefficient = {0.F, 0.F, 0.F, lhs.value};
+        return;
+    }
+    const float dy     = rhs.value - lhs.value;
+    const float length = 1 / (dx * dx);
+    const float d1     = lhs.outTangent * dx;
+    const float d2     = rhs.inTangent * dx;
+
+    optKey.coefficient[0] = (d1 + d2 - dy - dy) * length / dx;
+    optKey.coefficient[1] = (dy + dy + dy - d1 - d1 - d2) * length;
+    optKey.coefficient[2] = lhs.outTangent;
+    optKey.coefficient[3] = lhs.value;
+}
+
+int AnimationCurve::findIndex(const OptimizedKey &optKey, float t) const {
+    const auto nKeyframes  = static_cast<int>(_keyFrames.size());
+    const int  cachedIndex = optKey.index;
+    if (cachedIndex != -1) {
+        const float cachedTime = _keyFrames[cachedIndex].time;
+        if (t > cachedTime) {
+            for (int i = 0; i < LOOK_FORWARD; i++) {
+                const int currIndex = cachedIndex + i;
+                if (currIndex + 1 < nKeyframes && _keyFrames[currIndex + 1].time > t) {
+                    return currIndex;
+                }
+            }
+        } else {
+            for (int i = 0; i < LOOK_FORWARD; i++) {
+                const int currIndex = cachedIndex - i;
+                if (currIndex >= 1 && _keyFrames[currIndex - 1].time <= t) {
+                    return currIndex - 1;
+                }
+            }
+        }
+    }
+    int left  = 0;
+    int right = nKeyframes;
+    while (right - left > 1) {
+        const int mid = (left + right) / 2;
+        if (_keyFrames[mid].time >= t) {
+            right = mid;
+        } else {
+            left = mid;
+        }
+    }
+    return left;
+}
+
 } // namespace geometry
-} // namespace cc
\ No newline at end of file
+} // namespace cc
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+
 namespace cc {
 namespace geometry {
 
@@ -37,20 +41,27 @@ struct Keyframe {
     float outTangent = 0;
 };
 
-float evalOptCurve(float t, const ccstd::vector<float> &coefs);
+/**
+ * @en
+ * How a curve is sampled outside of its key frames.
+ * @zh
+ * 曲线在关键帧范围之外的采样方式。
+ */
+enum class ExtrapolationMode {
+    CLAMP,
+    LOOP,
+    PING_PONG,
+};
+
+float evalOptCurve(float t, const ccstd::array<float, 4> &coefs);
 
 struct OptimizedKey {
-    float                index;
-    float                time;
-    float                endTime;
-    ccstd::vector<float> coefficient;
-    OptimizedKey() {
-        index   = -1;
-        time    = 0;
-        endTime = 0;
-        coefficient.resize(4);
-    }
-    static float evaluate(float t);
+    int                    index{-1};
+    float                  time{0.F};
+    float                  endTime{0.F};
+    ccstd::array<float, 4> coefficient{};
+
+    float evaluate(float tt) const;
 };
 
 /**
@@ -59,122 +70,45 @@ struct OptimizedKey {
  * @zh
  * 描述一条曲线，其中每个相邻关键帧采用三次hermite插值计算。
  */
-class AnimationCurve {
-    // @serializable
-private:
-    // _curve ! : RealCurve;
-
+class AnimationCurve final {
 public:
-    static ccstd::vector<KeyFrame> defaultKF = [ {
-                                                    time : 0,
-                                                    value : 1,
-                                                    inTangent : 0,
-                                                    outTangent : 0,
-                                                },
-                                                 {
-                                                     time : 1,
-                                                     value : 1,
-                                                     inTangent : 0,
-                                                     outTangent : 0,
-                                                 } ];
+    // resolution of the lookup table above which baking gives up
+    static constexpr uint32_t DEFAULT_LUT_MAX_RESOLUTION = 1024;
+    static constexpr float    DEFAULT_LUT_TOLERANCE      = 1e-3F;
 
     /**
-     * For internal usage only.
-     * @internal
+     * @en Creates a constant curve of value 1 between time 0 and 1.
+     * @zh 创建一条在时间 0 到 1 之间恒为 1 的曲线。
      */
-    get _internalCurve() {
-        return this._curve;
-    }
+    AnimationCurve();
+    explicit AnimationCurve(const ccstd::vector<Keyframe> &keyFrames);
 
     /**
      * @en
-     * The key frame of the curve.
+     * The key frame of the curve, sorted by time.
      * @zh
-     * 曲线的关键帧。
+     * 曲线的关键帧，按时间排序。
      */
-    auto getKeyFrames() {
-        return Array.from(this._curve.keyframes()).map(([ time, value ]) = > {
-            const legacyKeyframe      = new Keyframe();
-            legacyKeyframe.time       = time;
-            legacyKeyframe.value      = value.value;
-            legacyKeyframe.inTangent  = value.leftTangent;
-            legacyKeyframe.outTangent = value.rightTangent;
-            return legacyKeyframe;
-        });
-    }
-
-    void setKeyFrames(value) {
-        this._curve.assignSorted(value.map((legacyCurve) = > [
-            legacyCurve.time,
-            {
-                interpolationMode : RealInterpolationMode.CUBIC,
-                value : legacyCurve.value,
-                leftTangent : legacyCurve.inTangent,
-                rightTangent : legacyCurve.outTangent,
-            },
-        ]));
-    }
+    inline const ccstd::vector<Keyframe> &getKeyFrames() const { return _keyFrames; }
+    void                                  setKeyFrames(const ccstd::vector<Keyframe> &keyFrames);
 
     /**
      * @en
-     * Loop mode [[WrapMode]] when the sampling time exceeds the left end.
+     * Loop mode when the sampling time exceeds the left end.
      * @zh
-     * 当采样时间超出左端时采用的循环模式[[WrapMode]]。
+     * 当采样时间超出左端时采用的循环模式。
      */
-    auto getPreWrapMode() {
-        return toLegacyWrapMode(this._curve.preExtrapolation);
-    }
-
-    void sPreWrapMode(value) {
-        this._curve.preExtrapolation = fromLegacyWrapMode(value);
-    }
+    inline ExtrapolationMode getPreWrapMode() const { return _preWrapMode; }
+    void                     setPreWrapMode(ExtrapolationMode mode);
 
     /**
      * @en
-     * Cycle mode [[WrapMode]] when the sampling time exceeds the right end.
+     * Cycle mode when the sampling time exceeds the right end.
      * @zh
-     * 当采样时间超出右端时采用的循环模式[[WrapMode]]。
-     */
-    get postWrapMode() {
-        return toLegacyWrapMode(this._curve.postExtrapolation);
-    }
-
-    set postWrapMode(value) {
-        this._curve.postExtrapolation = fromLegacyWrapMode(value);
-    }
-
-private
-    cachedKey : OptimizedKey;
-
-    /**
-     * 构造函数。
-     * @param keyFrames 关键帧。
+     * 当采样时间超出右端时采用的循环模式。
      */
-    constructor(keyFrames
-                : Keyframe[] | null | RealCurve = null) {
-        if (keyFrames instanceof RealCurve) {
-            this._curve = keyFrames;
-        } else {
-            const curve             = new RealCurve();
-            this._curve             = curve;
-            curve.preExtrapolation  = ExtrapolationMode.LOOP;
-            curve.postExtrapolation = ExtrapolationMode.CLAMP;
-            if (!keyFrames) {
-                curve.assignSorted([
-                    [ 0.0, {interpolationMode : RealInterpolationMode.CUBIC, value : 1.0} ],
-                    [ 1.0, {interpolationMode : RealInterpolationMode.CUBIC, value : 1.0} ],
-                ]);
-            } else {
-                curve.assignSorted(keyFrames.map((legacyKeyframe) = > [ legacyKeyframe.time, {
-                                                                           interpolationMode : RealInterpolationMode.CUBIC,
-                                                                           value : legacyKeyframe.value,
-                                                                           leftTangent : legacyKeyframe.inTangent,
-                                                                           rightTangent : legacyKeyframe.outTangent,
-                                                                       } ]));
-            }
-        }
-        this.cachedKey = new OptimizedKey();
-    }
+    inline ExtrapolationMode getPostWrapMode() const { return _postWrapMode; }
+    void                     setPostWrapMode(ExtrapolationMode mode);
 
     /**
      * @en
@@ -183,180 +117,64 @@ private
      * 添加一个关键帧。
      * @param keyFrame 关键帧。
      */
-public
-    addKey(keyFrame
-           : Keyframe | null) {
-        if (!keyFrame) {
-            this._curve.clear();
-        } else {
-            this._curve.addKeyFrame(keyFrame.time, {
-                interpolationMode : RealInterpolationMode.CUBIC,
-                value : keyFrame.value,
-                leftTangent : keyFrame.inTangent,
-                rightTangent : keyFrame.outTangent,
-            });
-        }
-    }
+    void addKey(const Keyframe &keyFrame);
 
     /**
-     * @ignore
-     * @param time
+     * @en
+     * Calculate the curve interpolation at a given point in time, uses the lookup table if one is baked.
+     * @zh
+     * 计算给定时间点的曲线插值，若已烘焙查找表则使用查找表。
+     * @param time 时间。
      */
-public
-    evaluate_slow(time
-                  : number) {
-        return this._curve.evaluate(time);
-    }
+    float evaluate(float time);
 
     /**
      * @en
-     * Calculate the curve interpolation at a given point in time.
+     * Samples the curve at count points in time at once, four at a time with SIMD when the lookup table is baked.
      * @zh
-     * 计算给定时间点的曲线插值。
-     * @param time 时间。
+     * 一次性在 count 个时间点采样曲线，若已烘焙查找表则使用 SIMD 每次处理四个采样。
      */
-public
-    evaluate(time
-             : number) {
-        const {cachedKey, _curve : curve} = this;
-        const nKeyframes                  = curve.keyFramesCount;
-        const lastKeyframeIndex           = nKeyframes - 1;
-        let wrappedTime                   = time;
-        const extrapolationMode           = time < 0 ? curve.preExtrapolation : curve.postExtrapolation;
-        const startTime                   = curve.getKeyframeTime(0);
-        const endTime                     = curve.getKeyframeTime(lastKeyframeIndex);
-        switch (extrapolationMode) {
-            case ExtrapolationMode.LOOP:
-                wrappedTime = repeat(time - startTime, endTime - startTime) + startTime;
-                break;
-            case ExtrapolationMode.PING_PONG:
-                wrappedTime = pingPong(time - startTime, endTime - startTime) + startTime;
-                break;
-            case ExtrapolationMode.CLAMP:
-            default:
-                wrappedTime = clamp(time, startTime, endTime);
-                break;
-        }
-        if (wrappedTime >= cachedKey.time && wrappedTime < cachedKey.endTime) {
-            return cachedKey.evaluate(wrappedTime);
-        }
-        const leftIndex  = this.findIndex(cachedKey, wrappedTime);
-        const rightIndex = Math.min(leftIndex + 1, lastKeyframeIndex);
-        this.calcOptimizedKey(cachedKey, leftIndex, rightIndex);
-        return cachedKey.evaluate(wrappedTime);
-    }
+    void evaluate(const float *times, float *results, uint32_t count);
 
     /**
-     * @ignore
-     * @param optKey
-     * @param leftIndex
-     * @param rightIndex
+     * @en
+     * Bakes the curve into a uniformly sampled lookup table, doubling its resolution until the linear interpolation
+     * between samples stays within tolerance of the curve. The table is dropped when the key frames change.
+     * @zh
+     * 将曲线烘焙为均匀采样的查找表，分辨率逐次翻倍，直到采样点之间的线性插值与曲线的误差不超过 tolerance。关键帧改变时查找表会被清除。
+     * @return @en false if maxResolution samples are not enough, no table is used then. @zh 若 maxResolution 个采样仍不足则返回 false，此时不使用查找表。
      */
-public
-    calcOptimizedKey(optKey
-                     : OptimizedKey, leftIndex
-                     : number, rightIndex
-                     : number) {
-        const lhsTime                                         = this._curve.getKeyframeTime(leftIndex);
-        const rhsTime                                         = this._curve.getKeyframeTime(rightIndex);
-        const {value : lhsValue, leftTangent : lhsOutTangent} = this._curve.getKeyframeValue(leftIndex);
-        const {value : rhsValue, rightTangent : rhsInTangent} = this._curve.getKeyframeValue(rightIndex);
-        optKey.index                                          = leftIndex;
-        optKey.time                                           = lhsTime;
-        optKey.endTime                                        = rhsTime;
-
-        const dx     = rhsTime - lhsTime;
-        const dy     = rhsValue - lhsValue;
-        const length = 1 / (dx * dx);
-        const d1     = lhsOutTangent * dx;
-        const d2     = rhsInTangent * dx;
-
-        optKey.coefficient[0] = (d1 + d2 - dy - dy) * length / dx;
-        optKey.coefficient[1] = (dy + dy + dy - d1 - d1 - d2) * length;
-        optKey.coefficient[2] = lhsOutTangent;
-        optKey.coefficient[3] = lhsValue;
-    }
+    bool bakeLut(uint32_t maxResolution = DEFAULT_LUT_MAX_RESOLUTION, float tolerance = DEFAULT_LUT_TOLERANCE);
+    void clearLut();
+    inline bool     isLutBaked() const { return !_lut.empty(); }
+    inline uint32_t getLutResolution() const { return static_cast<uint32_t>(_lut.size()); }
 
     /**
-     * @ignore
-     * @param optKey
-     * @param t
+     * @en
+     * Samples the key frames directly, ignoring the lookup table.
+     * @zh
+     * 忽略查找表，直接对关键帧采样。
      */
-private
-    findIndex(optKey
-              : OptimizedKey, t
-              : number) {
-        const {_curve : curve} = this;
-        const nKeyframes       = curve.keyFramesCount;
-        const cachedIndex      = optKey.index;
-        if (cachedIndex != = -1) {
-            const cachedTime = curve.getKeyframeTime(cachedIndex);
-            if (t > cachedTime) {
-                for (let i = 0; i < LOOK_FORWARD; i++) {
-                    const currIndex = cachedIndex + i;
-                    if (currIndex + 1 < nKeyframes && curve.getKeyframeTime(currIndex + 1) > t) {
-                        return currIndex;
-                    }
-                }
-            } else {
-                for (let i = 0; i < LOOK_FORWARD; i++) {
-                    const currIndex = cachedIndex - i;
-                    if (currIndex >= 0 && curve.getKeyframeTime(currIndex - 1) <= t) {
-                        return currIndex - 1;
-                    }
-                }
-            }
-        }
-        let left  = 0;
-        let right = nKeyframes;
-        let mid;
-        while (right - left > 1) {
-            mid = Math.floor((left + right) / 2);
-            if (curve.getKeyframeTime(mid) >= t) {
-                right = mid;
-            } else {
-                left = mid;
-            }
-        }
-        return left;
-    }
-}
-
-function
-fromLegacyWrapMode(legacyWrapMode
-                   : WrapModeMask) : ExtrapolationMode {
-    switch (legacyWrapMode) {
-        default:
-        case WrapModeMask.Default:
-        case WrapModeMask.Normal:
-        case WrapModeMask.Clamp: return ExtrapolationMode.CLAMP;
-        case WrapModeMask.PingPong: return ExtrapolationMode.PING_PONG;
-        case WrapModeMask.Loop: return ExtrapolationMode.LOOP;
-    }
-}
+    float evaluateCurve(float time);
 
-function toLegacyWrapMode(extrapolationMode
-                          : ExtrapolationMode) : WrapModeMask {
-    switch (extrapolationMode) {
-        default:
-        case ExtrapolationMode.LINEAR:
-        case ExtrapolationMode.CLAMP: return WrapModeMask.Clamp;
-        case ExtrapolationMode.PING_PONG: return WrapModeMask.PingPong;
-        case ExtrapolationMode.LOOP: return WrapModeMask.Loop;
-    }
-}
+    void calcOptimizedKey(OptimizedKey &optKey, int leftIndex, int rightIndex) const;
 
-/**
- * Same as but more effective than `new LegacyCurve()._internalCurve`.
- */
-export function constructLegacyCurveAndConvert() {
-    const curve = new RealCurve();
-    curve.assignSorted([
-        [ 0.0, {interpolationMode : RealInterpolationMode.CUBIC, value : 1.0} ],
-        [ 1.0, {interpolationMode : RealInterpolationMode.CUBIC, value : 1.0} ],
-    ]);
-    return curve;
-}
+private:
+    float wrapTime(float time) const;
+    float evaluateWrapped(float wrappedTime);
+    float evaluateLut(float wrappedTime) const;
+    int   findIndex(const OptimizedKey &optKey, float t) const;
+    void  onKeyFramesChanged();
+
+    ccstd::vector<Keyframe> _keyFrames;
+    ExtrapolationMode       _preWrapMode{ExtrapolationMode::LOOP};
+    ExtrapolationMode       _postWrapMode{ExtrapolationMode::CLAMP};
+    OptimizedKey            _cachedKey;
+
+    // samples at uniform steps from the first to the last key frame
+    ccstd::vector<float> _lut;
+    float                _lutInvStep{0.F};
+};
 
-}
-} // namespace cc
\ No newline at end of file
+} // namespace geometry
+} // namespace cc
@@ -2,7 +2,7 @@
 
 #include "AABB.h"
 #include "Capsule.h"
-// #include "Curve.h"
+#include "Curve.h"
 #include "Distance.h"
 #include "Enums.h"
 #include "Frustum.h"
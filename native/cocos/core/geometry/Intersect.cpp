@@ -16,6 +16,7 @@
 #include "core/geometry/Triangle.h"
 #include "math/Mat3.h"
 #include "math/Math.h"
+#include "math/MathUtil.h"
 #include "math/Vec3.h"
 #include "renderer/gfx-base/GFXDef.h"
 #include "scene/Model.h"
@@ -210,6 +211,50 @@ float rayCapsule(const Ray &ray, const Capsule &capsule) {
     return 0;
 }
 
+void rayTriangles(const Ray &ray, const Vec3 *vertices, uint32_t count, bool doubleSided, float *outDistances) {
+    MathUtil::rayTriangleBatch(&ray.o.x, &ray.d.x, &vertices->x, count, doubleSided, outDistances);
+}
+
+void rayAABBs(const Ray &ray, const Vec3 *mins, const Vec3 *maxs, uint32_t count, float *outDistances) {
+    MathUtil::rayAABBBatch(&ray.o.x, &ray.d.x, &mins->x, &maxs->x, count, outDistances);
+}
+
+namespace {
+// rays are not tightly packed, they are copied into the kernel layout this many at a time
+constexpr uint32_t RAY_PACKET_CHUNK = 64;
+
+template <typename Kernel>
+void forEachRayChunk(const Ray *rays, uint32_t count, float *outDistances, Kernel &&kernel) {
+    ccstd::array<Vec3, RAY_PACKET_CHUNK> origins;
+    ccstd::array<Vec3, RAY_PACKET_CHUNK> directions;
+    for (uint32_t first = 0; first < count; first += RAY_PACKET_CHUNK) {
+        const uint32_t n = std::min(RAY_PACKET_CHUNK, count - first);
+        for (uint32_t i = 0; i < n; ++i) {
+            origins[i]    = rays[first + i].o;
+            directions[i] = rays[first + i].d;
+        }
+        kernel(&origins[0].x, &directions[0].x, n, outDistances + first);
+    }
+}
+} // namespace
+
+void raysTriangle(const Ray *rays, uint32_t count, const Triangle &triangle, bool doubleSided, float *outDistances) {
+    const ccstd::array<float, 9> vertices{triangle.a.x, triangle.a.y, triangle.a.z,
+                                          triangle.b.x, triangle.b.y, triangle.b.z,
+                                          triangle.c.x, triangle.c.y, triangle.c.z};
+    forEachRayChunk(rays, count, outDistances, [&](const float *origins, const float *directions, uint32_t n, float *out) {
+        MathUtil::raysTriangleBatch(origins, directions, n, vertices.data(), doubleSided, out);
+    });
+}
+
+void raysAABB(const Ray *rays, uint32_t count, const AABB &aabb, float *outDistances) {
+    const Vec3 min = aabb.getCenter() - aabb.getHalfExtents();
+    const Vec3 max = aabb.getCenter() + aabb.getHalfExtents();
+    forEachRayChunk(rays, count, outDistances, [&](const float *origins, const float *directions, uint32_t n, float *out) {
+        MathUtil::raysAABBBatch(origins, directions, n, &min.x, &max.x, out);
+    });
+}
+
 namespace {
 void fillResult(float *minDis, ERaycastMode m, float d, float i0, float i1, float i2, cc::optional<ccstd::vector<IRaySubMeshResult>> &r) {
     if (m == ERaycastMode::CLOSEST) {
@@ -300,6 +345,15 @@ float raySubMesh(const Ray &ray, const RenderingSubMesh &submesh, IRaySubMeshOpt
     auto                min = mesh.getGeometricInfo().boundingBox.min;
     auto                max = mesh.getGeometricInfo().boundingBox.max;
     if (rayAABB2(ray, min, max) != 0.0F) {
+        // sub meshes owned by a mesh use its cached triangle BVH
+        Mesh *owner = mesh.getMesh();
+        if (owner && mesh.getSubMeshIdx().has_value()) {
+            const auto *bvh = owner->getTriangleBVH(mesh.getSubMeshIdx().value());
+            if (bvh) {
+                return bvh->raycast(ray, opt);
+            }
+        }
+
         const auto &pm   = mesh.getPrimitiveMode();
         const auto &info = mesh.getGeometricInfo();
         narrowphase(&minDis, info.positions, info.indices.value(), pm, ray, opt);
@@ -100,6 +100,57 @@ float rayOBB(const Ray &ray, const OBB &obb);
  */
 float rayCapsule(const Ray &ray, const Capsule &capsule);
 
+/**
+ * @en
+ * ray-triangle intersect detect of one ray against several triangles, four triangles at a time with SIMD.
+ * @zh
+ * 一条射线与多个三角形的相交性检测，使用 SIMD 每次检测四个三角形。
+ * @param {Ray} ray 射线
+ * @param {Vec3} vertices 三角形的顶点，每个三角形三个
+ * @param {number} count 三角形数量
+ * @param {boolean} doubleSided 三角形是否为双面
+ * @param {number} outDistances 每个三角形的击中距离，未击中为 0
+ */
+void rayTriangles(const Ray &ray, const Vec3 *vertices, uint32_t count, bool doubleSided, float *outDistances);
+
+/**
+ * @en
+ * ray-aabb intersect detect of one ray against several boxes, four boxes at a time with SIMD.
+ * @zh
+ * 一条射线与多个轴对齐包围盒的相交性检测，使用 SIMD 每次检测四个包围盒。
+ * @param {Ray} ray 射线
+ * @param {Vec3} mins 包围盒的最小点
+ * @param {Vec3} maxs 包围盒的最大点
+ * @param {number} count 包围盒数量
+ * @param {number} outDistances 每个包围盒的击中距离，未击中为 0
+ */
+void rayAABBs(const Ray &ray, const Vec3 *mins, const Vec3 *maxs, uint32_t count, float *outDistances);
+
+/**
+ * @en
+ * ray-triangle intersect detect of several rays against one triangle, four rays at a time with SIMD.
+ * @zh
+ * 多条射线与一个三角形的相交性检测，使用 SIMD 每次检测四条射线。
+ * @param {Ray} rays 射线
+ * @param {number} count 射线数量
+ * @param {Triangle} triangle 三角形
+ * @param {boolean} doubleSided 三角形是否为双面
+ * @param {number} outDistances 每条射线的击中距离，未击中为 0
+ */
+void raysTriangle(const Ray *rays, uint32_t count, const Triangle &triangle, bool doubleSided, float *outDistances);
+
+/**
+ * @en
+ * ray-aabb intersect detect of several rays against one box, four rays at a time with SIMD.
+ * @zh
+ * 多条射线与一个轴对齐包围盒的相交性检测，使用 SIMD 每次检测四条射线。
+ * @param {Ray} rays 射线
+ * @param {number} count 射线数量
+ * @param {AABB} aabb 轴对齐包围盒
+ * @param {number} outDistances 每条射线的击中距离，未击中为 0
+ */
+void raysAABB(const Ray *rays, uint32_t count, const AABB &aabb, float *outDistances);
+
 /**
  * @en
  * ray-subMesh intersect detect, in model space.
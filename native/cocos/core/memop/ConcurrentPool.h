@@ -0,0 +1,235 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace memop {
+
+/**
+ * @en Thread safe object pool. Each thread caches free objects in its own magazine and only locks the shared depot
+ * when the magazine runs empty or full, so it can be used inside parallel jobs.
+ * The pool must not be destroyed while other threads are still using it.
+ * @zh 线程安全的对象池。每个线程在各自的弹匣中缓存空闲对象，仅在弹匣为空或已满时才锁定共享仓库，因此可以在并行任务中使用。
+ * 仍有其他线程在使用时不能销毁对象池。
+ * @see [[Pool]]
+ */
+template <typename T>
+class ConcurrentPool final {
+public:
+    /**
+     * @en Threads created after this many threads have used the pool go to the depot directly
+     * @zh 超出该数量的线程直接访问共享仓库
+     */
+    static constexpr uint32_t MAX_THREAD_SLOTS{64};
+
+    /**
+     * @en Constructor with the allocator of elements and the magazine size
+     * @zh 使用元素的构造器和弹匣大小的构造函数
+     * @param ctor The allocator of elements in pool, it's invoked directly without `new` and may be invoked from any thread
+     * @param elementsPerBatch The number of objects moved between a magazine and the depot at once, a magazine caches up to twice this number
+     */
+    ConcurrentPool(const std::function<T *()> &ctor, uint32_t elementsPerBatch)
+    : _ctor(ctor),
+      _elementsPerBatch(std::max(elementsPerBatch, static_cast<uint32_t>(1))) {}
+
+    ConcurrentPool(const ConcurrentPool &) = delete;
+    ConcurrentPool(ConcurrentPool &&)      = delete;
+    ~ConcurrentPool()                      = default;
+    ConcurrentPool &operator=(const ConcurrentPool &) = delete;
+    ConcurrentPool &operator=(ConcurrentPool &&) = delete;
+
+    /**
+     * @en Take an object out of the object pool.
+     * @zh 从对象池中取出一个对象。
+     * @return An object ready for use. This function always return an object.
+     */
+    T *alloc() {
+        auto *magazine = getMagazine();
+        if (!magazine) {
+            T *obj = nullptr;
+            takeFromDepot(1, &obj);
+            return obj;
+        }
+
+        if (magazine->objects.empty()) {
+            magazine->objects.resize(_elementsPerBatch);
+            takeFromDepot(_elementsPerBatch, magazine->objects.data());
+        }
+
+        T *obj = magazine->objects.back();
+        magazine->objects.pop_back();
+        return obj;
+    }
+
+    /**
+     * @en Take multiple objects out of the object pool.
+     * @zh 从对象池中取出一组对象。
+     * @param count The number of objects to take
+     * @param objs The array the objects are appended to
+     */
+    void allocArray(uint32_t count, ccstd::vector<T *> &objs) {
+        const auto offset = objs.size();
+        objs.resize(offset + count);
+
+        uint32_t cached   = 0;
+        auto *   magazine = getMagazine();
+        if (magazine) {
+            cached = std::min(count, static_cast<uint32_t>(magazine->objects.size()));
+            std::copy(magazine->objects.end() - cached, magazine->objects.end(), objs.begin() + offset);
+            magazine->objects.resize(magazine->objects.size() - cached);
+        }
+
+        if (cached < count) {
+            takeFromDepot(count - cached, objs.data() + offset + cached);
+        }
+    }
+
+    /**
+     * @en Put an object back into the object pool.
+     * @zh 将一个对象放回对象池中。
+     * @param obj The object to be put back into the pool
+     */
+    void free(T *obj) {
+        auto *magazine = getMagazine();
+        if (!magazine) {
+            putToDepot(&obj, 1);
+            return;
+        }
+
+        if (magazine->objects.size() >= _elementsPerBatch * 2) {
+            flush(magazine);
+        }
+        magazine->objects.push_back(obj);
+    }
+
+    /**
+     * @en Put multiple objects back into the object pool.
+     * @zh 将一组对象放回对象池中。
+     * @param objs An array of objects to be put back into the pool
+     */
+    void freeArray(const ccstd::vector<T *> &objs) {
+        auto *magazine = getMagazine();
+        if (!magazine) {
+            putToDepot(objs.data(), objs.size());
+            return;
+        }
+
+        const auto room   = _elementsPerBatch * 2 - std::min<size_t>(magazine->objects.size(), _elementsPerBatch * 2);
+        const auto cached = std::min(room, objs.size());
+        magazine->objects.insert(magazine->objects.end(), objs.begin(), objs.begin() + cached);
+        if (cached < objs.size()) {
+            putToDepot(objs.data() + cached, objs.size() - cached);
+        }
+    }
+
+    /**
+     * @en Destroy all elements and clear the pool, no other thread may use the pool at the same time.
+     * @zh 释放对象池中所有资源并清空缓存池，此时不能有其他线程使用对象池。
+     * @param dtor The destructor function, it will be invoked for all elements in the pool
+     */
+    void destroy(const std::function<void(T *)> &dtor) {
+        for (auto &magazine : _magazines) {
+            for (T *obj : magazine.objects) {
+                dtor(obj);
+            }
+        }
+        for (T *obj : _depot) {
+            dtor(obj);
+        }
+        destroy();
+    }
+
+    void destroy() {
+        for (auto &magazine : _magazines) {
+            magazine.objects.clear();
+        }
+        std::lock_guard<std::mutex> lock(_depotMutex);
+        _depot.clear();
+    }
+
+private:
+    // on its own cache line, only ever touched by the owning thread
+    struct alignas(64) Magazine {
+        ccstd::vector<T *> objects;
+    };
+
+    static uint32_t getThreadSlot() {
+        static std::atomic<uint32_t> slotCount{0};
+        thread_local const uint32_t  slot = slotCount.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    Magazine *getMagazine() {
+        const auto slot = getThreadSlot();
+        return slot < MAX_THREAD_SLOTS ? &_magazines[slot] : nullptr;
+    }
+
+    void takeFromDepot(uint32_t count, T **objs) {
+        uint32_t taken = 0;
+        {
+            std::lock_guard<std::mutex> lock(_depotMutex);
+            taken = std::min(count, static_cast<uint32_t>(_depot.size()));
+            std::copy(_depot.end() - taken, _depot.end(), objs);
+            _depot.resize(_depot.size() - taken);
+        }
+
+        // created outside of the lock, the allocator may be slow
+        for (uint32_t i = taken; i < count; ++i) {
+            objs[i] = _ctor();
+        }
+    }
+
+    void putToDepot(T *const *objs, size_t count) {
+        std::lock_guard<std::mutex> lock(_depotMutex);
+        _depot.insert(_depot.end(), objs, objs + count);
+    }
+
+    // hands the least recently freed half back to the depot
+    void flush(Magazine *magazine) {
+        auto &objects = magazine->objects;
+        putToDepot(objects.data(), _elementsPerBatch);
+        objects.erase(objects.begin(), objects.begin() + _elementsPerBatch);
+    }
+
+    std::function<T *()>                   _ctor{nullptr};
+    uint32_t                               _elementsPerBatch{0};
+    std::array<Magazine, MAX_THREAD_SLOTS> _magazines;
+    std::mutex                             _depotMutex;
+    ccstd::vector<T *>                     _depot;
+};
+
+} // namespace memop
+
+} // namespace cc
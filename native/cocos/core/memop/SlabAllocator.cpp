@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/memop/SlabAllocator.h"
+#include <new>
+#include "base/memory/Memory.h"
+
+namespace cc {
+
+namespace memop {
+
+SlabAllocator::SlabAllocator(size_t blockSize, size_t alignment, uint32_t blocksPerSlab)
+: _objectSize(blockSize),
+  _blockSize((std::max(blockSize, sizeof(FreeBlock)) + alignment - 1) / alignment * alignment),
+  _alignment(alignment),
+  _blocksPerSlab(std::max(blocksPerSlab, static_cast<uint32_t>(1))) {}
+
+SlabAllocator::~SlabAllocator() {
+    // the live blocks would dangle otherwise
+    if (_liveCount > 0) {
+        return;
+    }
+
+    for (void *slab : _slabs) {
+        CC_FREE_ALIGN(slab);
+    }
+    _slabs.clear();
+    _freeList = nullptr;
+}
+
+void *SlabAllocator::allocate(size_t size) {
+    if (size != _objectSize) {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_freeList) {
+        addSlab();
+    }
+
+    FreeBlock *block = _freeList;
+    _freeList        = block->next;
+    ++_liveCount;
+    return block;
+}
+
+void SlabAllocator::deallocate(void *ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+
+    if (size != _objectSize) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto *block = static_cast<FreeBlock *>(ptr);
+    block->next = _freeList;
+    _freeList   = block;
+    --_liveCount;
+}
+
+void SlabAllocator::addSlab() {
+    auto *slab = static_cast<uint8_t *>(CC_MALLOC_ALIGN(_blockSize * _blocksPerSlab, _alignment));
+    CC_ASSERT(slab);
+    _slabs.push_back(slab);
+
+    // linked backwards so that a fresh slab is handed out in address order
+    for (uint32_t i = _blocksPerSlab; i > 0; --i) {
+        auto *block = reinterpret_cast<FreeBlock *>(slab + _blockSize * (i - 1));
+        block->next = _freeList;
+        _freeList   = block;
+    }
+}
+
+} // namespace memop
+
+} // namespace cc
@@ -0,0 +1,110 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+namespace memop {
+
+/**
+ * @en Fixed size block allocator, blocks are carved out of contiguous slabs and recycled when freed,
+ * so objects created and destroyed in waves reuse the same memory and stay close to each other.
+ * Requests of any other size fall back to the global allocator, which is how derived classes without
+ * their own slab are handled. Thread safe.
+ * @zh 固定尺寸的块分配器，块从连续的内存板中分配并在释放时回收，成批创建销毁的对象会复用同一片内存并彼此相邻。
+ * 其他尺寸的请求交由全局分配器处理，没有自己内存板的派生类即是如此。线程安全。
+ */
+class CC_DLL SlabAllocator final {
+public:
+    static constexpr uint32_t BLOCKS_PER_SLAB{64};
+
+    /**
+     * @en The allocator of a class, it is never destroyed since objects may outlive static destruction.
+     * @zh 类所使用的分配器，由于对象可能在静态析构之后才释放，它永远不会被销毁。
+     */
+    template <typename T>
+    static SlabAllocator *get() {
+        static auto *allocator = new SlabAllocator(sizeof(T), std::max(alignof(T), alignof(std::max_align_t)), BLOCKS_PER_SLAB);
+        return allocator;
+    }
+
+    SlabAllocator(size_t blockSize, size_t alignment, uint32_t blocksPerSlab);
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator(SlabAllocator &&)      = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(SlabAllocator &&) = delete;
+
+    void *allocate(size_t size);
+    void  deallocate(void *ptr, size_t size);
+
+    inline uint32_t getLiveCount() const { return _liveCount; }
+    inline size_t   getSlabCount() const { return _slabs.size(); }
+
+private:
+    struct FreeBlock {
+        FreeBlock *next{nullptr};
+    };
+
+    void addSlab();
+
+    std::mutex            _mutex;
+    size_t                _objectSize{0};
+    size_t                _blockSize{0};
+    size_t                _alignment{0};
+    uint32_t              _blocksPerSlab{0};
+    uint32_t              _liveCount{0};
+    FreeBlock *           _freeList{nullptr};
+    ccstd::vector<void *> _slabs;
+};
+
+} // namespace memop
+
+} // namespace cc
+
+/**
+ * Routes `new` and `delete` of the class to its SlabAllocator, put CC_SLAB_ALLOCATED_IMPL in the source file.
+ */
+#define CC_SLAB_ALLOCATED(klass)                 \
+public:                                          \
+    static void *operator new(std::size_t size); \
+    static void  operator delete(void *ptr, std::size_t size)
+
+#define CC_SLAB_ALLOCATED_IMPL(klass)                                    \
+    void *klass::operator new(std::size_t size) {                        \
+        return ::cc::memop::SlabAllocator::get<klass>()->allocate(size); \
+    }                                                                    \
+    void klass::operator delete(void *ptr, std::size_t size) {           \
+        ::cc::memop::SlabAllocator::get<klass>()->deallocate(ptr, size); \
+    }
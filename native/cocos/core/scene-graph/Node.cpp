@@ -41,15 +41,15 @@ namespace cc {
 
 // static variables
 
-uint32_t                             Node::clearFrame{0};
-uint32_t                             Node::clearRound{1000};
-bool                                 Node::isStatic{false};
-const uint32_t                       Node::TRANSFORM_ON{1 << 0};
-const uint32_t                       Node::DESTROYING{static_cast<uint>(CCObject::Flags::DESTROYING)};
-const uint32_t                       Node::DEACTIVATING{static_cast<uint>(CCObject::Flags::DEACTIVATING)};
-const uint32_t                       Node::DONT_DESTROY{static_cast<uint>(CCObject::Flags::DONT_DESTROY)};
-index_t                              Node::stackId{0};
-ccstd::vector<ccstd::vector<Node *>> Node::stacks;
+uint32_t                                             Node::clearFrame{0};
+uint32_t                                             Node::clearRound{1000};
+bool                                                 Node::isStatic{false};
+const uint32_t                                       Node::TRANSFORM_ON{1 << 0};
+const uint32_t                                       Node::DESTROYING{static_cast<uint>(CCObject::Flags::DESTROYING)};
+const uint32_t                                       Node::DEACTIVATING{static_cast<uint>(CCObject::Flags::DEACTIVATING)};
+const uint32_t                                       Node::DONT_DESTROY{static_cast<uint>(CCObject::Flags::DONT_DESTROY)};
+index_t                                              Node::stackId{0};
+ccstd::vector<std::unique_ptr<Node::TraversalStack>> Node::stacks;
 //
 
 namespace {
@@ -75,6 +75,9 @@ CC_FORCE_INLINE Node *getDirtyNode(const index_t idx) {
     return dirtyNodes[idx];
 }
 
+ccstd::vector<Node *> sharedTransformNodes;
+uint32_t *            sharedTransformDirty{nullptr};
+
 } // namespace
 
 Node::Node() : Node(EMPTY_NODE_NAME) {
@@ -92,6 +95,10 @@ Node::Node(const ccstd::string &name) {
 }
 
 Node::~Node() {
+    if (_transformStore) {
+        _transformStore->detach(this);
+    }
+    setSharedTransformPtr(nullptr, nullptr);
     uint32_t index = allNodes.indexOf(this);
     allNodes.fastRemove(index);
     CC_SAFE_DELETE(_eventProcessor);
@@ -276,9 +283,22 @@ void Node::setParent(Node *parent, bool isKeepWorld /* = false */) {
         _siblingIndex = static_cast<int32_t>(newParent->_children.size() - 1);
         newParent->emit(NodeEventType::CHILD_ADDED, this);
     }
+    markTransformStoreHierarchyDirty(oldParent);
     onHierarchyChanged(oldParent);
 }
 
+void Node::markTransformStoreHierarchyDirty(Node *oldParent) const {
+    if (_transformStore) {
+        _transformStore->markHierarchyDirty();
+    }
+    if (oldParent && oldParent->_transformStore) {
+        oldParent->_transformStore->markHierarchyDirty();
+    }
+    if (_parent && _parent->_transformStore) {
+        _parent->_transformStore->markHierarchyDirty();
+    }
+}
+
 Scene *Node::getScene() const {
     return _scene;
 }
@@ -288,89 +308,17 @@ void Node::walk(const std::function<void(Node *)> &preFunc) {
 }
 
 void Node::walk(const std::function<void(Node *)> &preFunc, const std::function<void(Node *)> &postFunc) {
-    index_t                                  index{1};
-    index_t                                  i{0};
-    const ccstd::vector<IntrusivePtr<Node>> *children = nullptr;
-    Node *                                   curr{nullptr};
-    auto                                     stacksCount = static_cast<index_t>(Node::stacks.size());
-    if (stackId >= stacksCount) {
-        stacks.resize(stackId + 1);
-    }
-    auto stack = stacks[stackId];
-    stackId++;
-
-    stack.clear();
-    stack.resize(1);
-    stack[0] = this;
-    Node *parent{nullptr};
-    bool  afterChildren{false};
-    while (index) {
-        index--;
-        auto stackCount = static_cast<index_t>(stack.size());
-        if (index >= stackCount) {
-            continue;
-        }
-        curr = stack[index];
-        if (curr == nullptr) {
-            continue;
-        }
-        if (!afterChildren && preFunc != nullptr) {
-            // pre call
-            preFunc(curr);
-        } else if (afterChildren && postFunc != nullptr) {
-            // post call
-            postFunc(curr);
-        }
-        stack[index] = nullptr;
-        if (afterChildren) {
-            if (parent == _parent) {
-                break;
-            }
-            afterChildren = false;
-        } else {
-            if (static_cast<index_t>(curr->_children.size()) > 0) {
-                parent       = curr;
-                children     = &curr->_children;
-                i            = 0;
-                stack[index] = (*children)[i];
-                stack.resize(++index);
-            } else {
-                stack[index] = curr;
-                stack.resize(++index);
-                afterChildren = true;
-            }
-            continue;
+    const auto pre = [&preFunc](Node *node) {
+        if (preFunc) {
+            preFunc(node);
         }
-
-        if (children != nullptr && !children->empty()) {
-            i++;
-            if (i < children->size() && children->at(i) != nullptr) {
-                stack[index] = children->at(i);
-                stack.resize(++index);
-            } else if (parent) {
-                stack[index] = parent;
-                stack.resize(++index);
-                afterChildren = true;
-                if (parent->_parent != nullptr) {
-                    children    = &parent->_parent->_children;
-                    index_t idx = getIdxOfChild(*children, parent);
-                    if (idx != CC_INVALID_INDEX) {
-                        i = idx;
-                    }
-                    parent = parent->_parent;
-                } else {
-                    // At root
-                    parent   = nullptr;
-                    children = nullptr;
-                }
-                if (i < 0) {
-                    break;
-                }
-            }
+    };
+    const auto post = [&postFunc](Node *node) {
+        if (postFunc) {
+            postFunc(node);
         }
-    }
-    stack.clear();
-    stackId--;
+    };
+    traverse(pre, post);
 }
 
 //Component *Node::addComponent(Component *comp) {
@@ -597,17 +545,72 @@ void Node::setScaleInternal(float x, float y, float z, bool calledFromJS) {
     }
 }
 
+void Node::setSharedTransformPtr(float *transform, uint32_t *changedBits) {
+    if (transform != nullptr && _sharedTransformIndex < 0) {
+        _sharedTransformIndex = static_cast<index_t>(sharedTransformNodes.size());
+        sharedTransformNodes.push_back(this);
+    } else if (transform == nullptr && _sharedTransformIndex >= 0) {
+        Node *last                                  = sharedTransformNodes.back();
+        last->_sharedTransformIndex                 = _sharedTransformIndex;
+        sharedTransformNodes[_sharedTransformIndex] = last;
+        sharedTransformNodes.pop_back();
+        _sharedTransformIndex = -1;
+    }
+    _sharedTransform            = transform;
+    _sharedTransformChangedBits = transform ? changedBits : nullptr;
+    if (_sharedTransform) {
+        notifyLocalPositionRotationScaleUpdated();
+        *_sharedTransformChangedBits = 0;
+    }
+}
+
+void Node::setSharedTransformDirtyPtr(uint32_t *ptr) {
+    sharedTransformDirty = ptr;
+}
+
+void Node::syncSharedTransforms() {
+    if (sharedTransformDirty == nullptr || *sharedTransformDirty == 0) {
+        return;
+    }
+    *sharedTransformDirty = 0;
+    // TRANSFORM_CHANGED listeners may add or remove shared nodes, don't hold an iterator
+    for (size_t i = 0; i < sharedTransformNodes.size(); ++i) {
+        Node *         node        = sharedTransformNodes[i];
+        const uint32_t changedBits = *node->_sharedTransformChangedBits;
+        if (changedBits == 0) {
+            continue;
+        }
+        *node->_sharedTransformChangedBits = 0;
+
+        const float *transform = node->_sharedTransform;
+        if (changedBits & static_cast<uint32_t>(TransformBit::POSITION)) {
+            const float *p = transform + SHARED_POSITION_OFFSET;
+            node->setPositionInternal(p[0], p[1], p[2], true);
+        }
+        if (changedBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
+            const float *r = transform + SHARED_ROTATION_OFFSET;
+            node->setRotationInternal(r[0], r[1], r[2], r[3], true);
+        }
+        if (changedBits & static_cast<uint32_t>(TransformBit::SCALE)) {
+            const float *s = transform + SHARED_SCALE_OFFSET;
+            node->setScaleInternal(s[0], s[1], s[2], true);
+        }
+    }
+}
+
 void Node::updateWorldTransform() { //NOLINT(misc-no-recursion)
+    syncSharedTransforms();
     if (!getDirtyFlag()) {
         return;
     }
+    if (_transformStore && _transformStore->resolve(this)) {
+        return;
+    }
 
-    index_t    i    = 0;
-    Node *     curr = this;
-    Mat3       mat3;
-    Mat3       m43;
-    Quaternion quat;
-    while (curr && curr->getDirtyFlag()) {
+    index_t i    = 0;
+    Node *  curr = this;
+    // Stop at nodes owned by a transform store, they are resolved by the store itself.
+    while (curr && !curr->_transformStore && curr->getDirtyFlag()) {
         setDirtyNode(i++, curr);
         curr = curr->getParent();
     }
@@ -619,44 +622,9 @@ void Node::updateWorldTransform() { //NOLINT(misc-no-recursion)
             continue;
         }
         dirtyBits |= child->getDirtyFlag();
-        auto *currChild = child;
-        if (curr) {
-            if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
-                currChild->_worldPosition.transformMat4(currChild->_localPosition, curr->getWorldMatrix());
-                currChild->_worldMatrix.m[12] = currChild->_worldPosition.x;
-                currChild->_worldMatrix.m[13] = currChild->_worldPosition.y;
-                currChild->_worldMatrix.m[14] = currChild->_worldPosition.z;
-            }
-            if (dirtyBits & static_cast<uint32_t>(TransformBit::RS)) {
-                Mat4::fromRTS(currChild->_localRotation, currChild->_localPosition, currChild->_localScale, &currChild->_worldMatrix);
-                Mat4::multiply(curr->getWorldMatrix(), currChild->_worldMatrix, &currChild->_worldMatrix);
-                if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
-                    Quaternion::multiply(curr->getWorldRotation(), currChild->_localRotation, &currChild->_worldRotation);
-                }
-                quat = currChild->_worldRotation;
-                quat.conjugate();
-                Mat3::fromQuat(quat, &mat3);
-                Mat3::fromMat4(currChild->_worldMatrix, &m43);
-                Mat3::multiply(mat3, m43, &mat3);
-                currChild->_worldScale.set(mat3.m[0], mat3.m[4], mat3.m[8]);
-            }
-        } else if (child) {
-            if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
-                currChild->_worldPosition.set(currChild->_localPosition);
-                currChild->_worldMatrix.m[12] = currChild->_worldPosition.x;
-                currChild->_worldMatrix.m[13] = currChild->_worldPosition.y;
-                currChild->_worldMatrix.m[14] = currChild->_worldPosition.z;
-            }
-            if (dirtyBits & static_cast<uint32_t>(TransformBit::RS)) {
-                if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
-                    currChild->_worldRotation.set(currChild->_localRotation);
-                }
-                if (dirtyBits & static_cast<uint32_t>(TransformBit::SCALE)) {
-                    currChild->_worldScale.set(currChild->_localScale);
-                    Mat4::fromRTS(currChild->_worldRotation, currChild->_worldPosition, currChild->_worldScale, &currChild->_worldMatrix);
-                }
-            }
-        }
+        TransformStore::computeWorldTransform(dirtyBits, child->_localPosition, child->_localRotation, child->_localScale,
+                                              curr ? &curr->getWorldMatrix() : nullptr, curr ? &curr->getWorldRotation() : nullptr,
+                                              &child->_worldPosition, &child->_worldRotation, &child->_worldScale, &child->_worldMatrix);
         child->setDirtyFlag(static_cast<uint32_t>(TransformBit::NONE));
         curr = child;
     }
@@ -664,12 +632,12 @@ void Node::updateWorldTransform() { //NOLINT(misc-no-recursion)
 
 const Mat4 &Node::getWorldMatrix() const { //NOLINT(misc-no-recursion)
     const_cast<Node *>(this)->updateWorldTransform();
-    return _worldMatrix;
+    return worldMatrixData();
 }
 
 Mat4 Node::getWorldRS() {
     updateWorldTransform();
-    Mat4 target{_worldMatrix};
+    Mat4 target{worldMatrixData()};
     target.m[12] = target.m[13] = target.m[14] = 0;
     return target;
 }
@@ -677,7 +645,7 @@ Mat4 Node::getWorldRS() {
 Mat4 Node::getWorldRT() {
     updateWorldTransform();
     Mat4 target;
-    Mat4::fromRT(_worldRotation, _worldPosition, &target);
+    Mat4::fromRT(worldRotationData(), worldPositionData(), &target);
     return target;
 }
 
@@ -727,7 +695,7 @@ void Node::setWorldPosition(float x, float y, float z) {
 
 const Vec3 &Node::getWorldPosition() const {
     const_cast<Node *>(this)->updateWorldTransform();
-    return _worldPosition;
+    return worldPositionData();
 }
 
 void Node::setWorldRotation(float x, float y, float z, float w) {
@@ -753,7 +721,7 @@ void Node::setWorldRotation(float x, float y, float z, float w) {
 
 const Quaternion &Node::getWorldRotation() const { //NOLINT(misc-no-recursion)
     const_cast<Node *>(this)->updateWorldTransform();
-    return _worldRotation;
+    return worldRotationData();
 }
 
 void Node::setWorldScale(float x, float y, float z) {
@@ -789,7 +757,7 @@ void Node::setWorldScale(float x, float y, float z) {
 
 const Vec3 &Node::getWorldScale() const {
     const_cast<Node *>(this)->updateWorldTransform();
-    return _worldScale;
+    return worldScaleData();
 }
 
 void Node::setAngle(float val) {
@@ -805,6 +773,7 @@ void Node::setAngle(float val) {
 }
 
 void Node::onSetParent(Node *oldParent, bool keepWorldTransform) {
+    markTransformStoreHierarchyDirty(oldParent);
     if (_parent) {
         if ((oldParent == nullptr || oldParent->_scene != _parent->_scene) && _parent->_scene != nullptr) {
             walk(setScene);
@@ -817,12 +786,12 @@ void Node::onSetParent(Node *oldParent, bool keepWorldTransform) {
             parent->updateWorldTransform();
             Mat4 mTemp{Mat4::IDENTITY}; // cjh FIXME: the logic is different from ts version.
             Mat4::inverseTranspose(parent->getWorldMatrix(), &mTemp);
-            mTemp *= _worldMatrix;
+            mTemp *= worldMatrixData();
 
         } else {
-            _localPosition.set(_worldPosition);
-            _localRotation.set(_worldRotation);
-            _localScale.set(_worldScale);
+            _localPosition.set(worldPositionData());
+            _localRotation.set(worldRotationData());
+            _localScale.set(worldScaleData());
         }
 
         notifyLocalPositionRotationScaleUpdated();
@@ -838,8 +807,8 @@ void Node::rotate(const Quaternion &rot, NodeSpace ns /* = NodeSpace::LOCAL*/, b
         _localRotation *= qTempA;
     } else if (ns == NodeSpace::WORLD) {
         Quaternion qTempB{Quaternion::identity()};
-        qTempB = qTempA * _worldRotation;
-        qTempA = _worldRotation;
+        qTempB = qTempA * worldRotationData();
+        qTempA = worldRotationData();
         qTempA.inverse();
         qTempB         = qTempA * qTempB;
         _localRotation = _localRotation * qTempB;
@@ -963,7 +932,7 @@ void Node::translate(const Vec3 &trans, NodeSpace ns) {
             Quaternion qTemp = _parent->getWorldRotation();
             qTemp.inverse();
             v3Temp.transformQuat(qTemp);
-            Vec3 scale{_worldScale};
+            Vec3 scale{worldScaleData()};
             _localPosition.x += v3Temp.x / scale.x;
             _localPosition.y += v3Temp.y / scale.y;
             _localPosition.z += v3Temp.z / scale.z;
@@ -1026,6 +995,9 @@ void Node::onHierarchyChanged(Node *oldParent) {
 //
 void Node::_setChildren(ccstd::vector<IntrusivePtr<Node>> &&children) {
     _children = std::move(children);
+    if (_transformStore) {
+        _transformStore->markHierarchyDirty();
+    }
 }
 
 //
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include "base/Ptr.h"
 #include "base/TypeDef.h"
 #include "cocos/base/Any.h"
@@ -36,6 +38,7 @@
 #include "core/scene-graph/NodeEnum.h"
 #include "core/scene-graph/NodeEvent.h"
 #include "core/scene-graph/NodeEventProcessor.h"
+#include "core/scene-graph/TransformStore.h"
 
 #include "math/Mat3.h"
 #include "math/Mat4.h"
@@ -76,9 +79,10 @@ public:
     static const uint32_t DONT_DESTROY;
 
     static Node *instantiate(Node *cloned, bool isSyncedNode);
-    // for walk
-    static ccstd::vector<ccstd::vector<Node *>> stacks;
-    static index_t                              stackId;
+    // for traverse, the nodes being visited and the index of their next child, one stack per nesting level of traversals
+    using TraversalStack = ccstd::vector<std::pair<Node *, uint32_t>>;
+    static ccstd::vector<std::unique_ptr<TraversalStack>> stacks;
+    static index_t                                         stackId;
 
     static void    setScene(Node *);
     static index_t getIdxOfChild(const ccstd::vector<IntrusivePtr<Node>> &, Node *);
@@ -118,6 +122,20 @@ public:
     void walk(const std::function<void(Node *)> &preFunc);
     void walk(const std::function<void(Node *)> &preFunc, const std::function<void(Node *)> &postFunc);
 
+    /**
+     * @en Visit the node and its descendants depth first without recursion, preFunc is called on a node before its children
+     * and postFunc after them. The callbacks are inlined and the traversal stacks are reused, so nothing is allocated once warmed up.
+     * Children added or removed by the callbacks are visited according to the children list at the time the traversal reaches them.
+     * @zh 以非递归的方式深度优先访问节点及其子孙节点，preFunc 在访问子节点之前调用，postFunc 在访问子节点之后调用。
+     * 回调会被内联，遍历栈会被复用，预热后不会分配内存。回调中增删的子节点按遍历到达时的子节点列表访问。
+     */
+    template <typename PreFunc, typename PostFunc>
+    void traverse(PreFunc &&preFunc, PostFunc &&postFunc);
+    template <typename PreFunc>
+    void traverse(PreFunc &&preFunc) {
+        traverse(std::forward<PreFunc>(preFunc), [](Node * /*node*/) {});
+    }
+
     template <typename Target, typename... Args>
     void on(const CallbacksInvoker::KeyType &type, void (Target::*memberFn)(Args...), Target *target, bool useCapture = false);
 
@@ -260,6 +278,23 @@ public:
     inline void setActiveInHierarchy(bool v) { _activeInHierarchyArr[0] = (v ? 1 : 0); }
     inline void setActiveInHierarchyPtr(uint8_t *ptr) { _activeInHierarchyArr = ptr; }
 
+    // Layout of the shared transform, in floats.
+    static constexpr uint32_t SHARED_POSITION_OFFSET{0};
+    static constexpr uint32_t SHARED_ROTATION_OFFSET{3};
+    static constexpr uint32_t SHARED_SCALE_OFFSET{7};
+    static constexpr uint32_t SHARED_TRANSFORM_LENGTH{10};
+
+    /**
+     * @en Maps the local transform to memory shared with JS: position, rotation and scale as 10 floats,
+     * and the TransformBit changed by JS since the last sync. Pass nullptr to unmap.
+     * @zh 将本地变换映射到与 JS 共享的内存：位置、旋转与缩放共 10 个浮点数，以及自上次同步后 JS 修改的 TransformBit。传入 nullptr 取消映射。
+     */
+    void setSharedTransformPtr(float *transform, uint32_t *changedBits);
+    // A word JS sets to non-zero whenever it changes any shared transform.
+    static void setSharedTransformDirtyPtr(uint32_t *ptr);
+    // Applies the shared transforms changed by JS, called before world transforms are resolved.
+    static void syncSharedTransforms();
+
     virtual void                                    onPostActivated(bool active) {}
     inline const ccstd::vector<IntrusivePtr<Node>> &getChildren() const { return _children; }
     inline Node *                                   getParent() const { return _parent; }
@@ -481,19 +516,19 @@ public:
 
     inline Vec3 getForward() {
         Vec3 forward{0, 0, -1};
-        forward.transformQuat(_worldRotation);
+        forward.transformQuat(worldRotationData());
         return forward;
     }
 
     inline Vec3 getUp() {
         Vec3 up{0, 1, 0};
-        up.transformQuat(_worldRotation);
+        up.transformQuat(worldRotationData());
         return up;
     }
 
     inline Vec3 getRight() {
         Vec3 right{1, 0, 0};
-        right.transformQuat(_worldRotation);
+        right.transformQuat(worldRotationData());
         return right;
     }
 
@@ -504,7 +539,12 @@ public:
     inline uint32_t getChangedFlags() const { return _flagChange; }
     inline void     setChangedFlags(uint32_t value) { _flagChange = value; }
 
-    inline void     setDirtyFlag(uint32_t value) { _dirtyFlag = value; }
+    inline void setDirtyFlag(uint32_t value) {
+        _dirtyFlag = value;
+        if (_transformStore) {
+            _transformStore->setDirtyFlag(_transformStoreIndex, value);
+        }
+    }
     inline uint32_t getDirtyFlag() const { return _dirtyFlag; }
     inline void     setLayer(uint32_t layer) {
         _layerArr[0] = layer;
@@ -639,19 +679,56 @@ protected:
     static uint32_t clearRound;
 
 private:
+    // World transform data is owned by the transform store while the node is attached to one.
+    inline const Mat4 &      worldMatrixData() const { return _transformStore ? _transformStore->getWorldMatrix(_transformStoreIndex) : _worldMatrix; }
+    inline const Vec3 &      worldPositionData() const { return _transformStore ? _transformStore->getWorldPosition(_transformStoreIndex) : _worldPosition; }
+    inline const Quaternion &worldRotationData() const { return _transformStore ? _transformStore->getWorldRotation(_transformStoreIndex) : _worldRotation; }
+    inline const Vec3 &      worldScaleData() const { return _transformStore ? _transformStore->getWorldScale(_transformStoreIndex) : _worldScale; }
+
+    void markTransformStoreHierarchyDirty(Node *oldParent) const;
+
+    // JS reads the shared transform directly when it's mapped, no event is needed then
     inline void notifyLocalPositionUpdated() {
+        if (_sharedTransform) {
+            float *out = _sharedTransform + SHARED_POSITION_OFFSET;
+            out[0]     = _localPosition.x;
+            out[1]     = _localPosition.y;
+            out[2]     = _localPosition.z;
+            return;
+        }
         emit(EventTypesToJS::NODE_LOCAL_POSITION_UPDATED, _localPosition.x, _localPosition.y, _localPosition.z);
     }
 
     inline void notifyLocalRotationUpdated() {
+        if (_sharedTransform) {
+            float *out = _sharedTransform + SHARED_ROTATION_OFFSET;
+            out[0]     = _localRotation.x;
+            out[1]     = _localRotation.y;
+            out[2]     = _localRotation.z;
+            out[3]     = _localRotation.w;
+            return;
+        }
         emit(EventTypesToJS::NODE_LOCAL_ROTATION_UPDATED, _localRotation.x, _localRotation.y, _localRotation.z, _localRotation.w);
     }
 
     inline void notifyLocalScaleUpdated() {
+        if (_sharedTransform) {
+            float *out = _sharedTransform + SHARED_SCALE_OFFSET;
+            out[0]     = _localScale.x;
+            out[1]     = _localScale.y;
+            out[2]     = _localScale.z;
+            return;
+        }
         emit(EventTypesToJS::NODE_LOCAL_SCALE_UPDATED, _localScale.x, _localScale.y, _localScale.z);
     }
 
     inline void notifyLocalPositionRotationScaleUpdated() {
+        if (_sharedTransform) {
+            notifyLocalPositionUpdated();
+            notifyLocalRotationUpdated();
+            notifyLocalScaleUpdated();
+            return;
+        }
         emit(EventTypesToJS::NODE_LOCAL_POSITION_ROTATION_SCALE_UPDATED,
              _localPosition.x, _localPosition.y, _localPosition.z,
              _localRotation.x, _localRotation.y, _localRotation.z, _localRotation.w,
@@ -698,11 +775,17 @@ private:
     //
     Vec3 _euler{0, 0, 0};
 
-    //
+    TransformStore *_transformStore{nullptr};
+    index_t         _transformStoreIndex{-1};
+
+    float *   _sharedTransform{nullptr};
+    uint32_t *_sharedTransformChangedBits{nullptr};
+    index_t   _sharedTransformIndex{-1};
 
     IntrusivePtr<UserData> _userData;
     friend class NodeActivator;
     friend class Scene;
+    friend class TransformStore;
 
     // Used to shared memory of Node._uiProps._uiTransformDirty.
     uint32_t *_uiTransformDirty{nullptr};
@@ -715,6 +798,32 @@ bool Node::isNode(T *obj) {
     return dynamic_cast<Node *>(obj) != nullptr && dynamic_cast<Scene *>(obj) == nullptr;
 }
 
+template <typename PreFunc, typename PostFunc>
+void Node::traverse(PreFunc &&preFunc, PostFunc &&postFunc) {
+    // the callbacks may start nested traversals, each one takes the stack of its own level
+    if (stackId >= static_cast<index_t>(stacks.size())) {
+        stacks.emplace_back(std::make_unique<TraversalStack>());
+    }
+    TraversalStack &stack = *stacks[stackId++];
+
+    preFunc(this);
+    stack.emplace_back(this, 0);
+    while (!stack.empty()) {
+        Node *         node  = stack.back().first;
+        const uint32_t index = stack.back().second;
+        if (index < node->_children.size()) {
+            Node *child         = node->_children[index].get();
+            stack.back().second = index + 1;
+            preFunc(child);
+            stack.emplace_back(child, 0);
+        } else {
+            stack.pop_back();
+            postFunc(node);
+        }
+    }
+    --stackId;
+}
+
 template <typename... Args>
 void Node::emit(const CallbacksInvoker::KeyType &type, Args &&...args) {
     _eventProcessor->emit(type, std::forward<Args>(args)...);
@@ -0,0 +1,124 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/scene-graph/NodeCommandBuffer.h"
+#include "base/Log.h"
+#include "core/scene-graph/Node.h"
+
+namespace cc {
+
+namespace {
+constexpr uint32_t SLOT_WORDS{1};
+
+uint32_t getPayloadWords(NodeCommandBuffer::Opcode opcode) {
+    switch (opcode) {
+        case NodeCommandBuffer::Opcode::SET_POSITION:
+        case NodeCommandBuffer::Opcode::SET_ROTATION_FROM_EULER:
+        case NodeCommandBuffer::Opcode::SET_SCALE:
+            return 3;
+        case NodeCommandBuffer::Opcode::SET_ROTATION:
+            return 4;
+        default:
+            return 0;
+    }
+}
+} // namespace
+
+NodeCommandBuffer::NodeCommandBuffer(uint32_t byteLength)
+: _buffer(new ArrayBuffer(byteLength)) {
+}
+
+NodeCommandBuffer::~NodeCommandBuffer() = default;
+
+uint32_t NodeCommandBuffer::registerNode(Node *node) {
+    if (node == nullptr) {
+        return INVALID_SLOT;
+    }
+    if (!_freeSlots.empty()) {
+        const uint32_t slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _nodes[slot] = node;
+        return slot;
+    }
+    _nodes.emplace_back(node);
+    return static_cast<uint32_t>(_nodes.size() - 1);
+}
+
+void NodeCommandBuffer::unregisterNode(uint32_t slot) {
+    if (slot >= _nodes.size() || _nodes[slot] == nullptr) {
+        return;
+    }
+    _nodes[slot] = nullptr;
+    _freeSlots.push_back(slot);
+}
+
+void NodeCommandBuffer::apply() {
+    auto *         words    = reinterpret_cast<uint32_t *>(_buffer->getData());
+    const uint32_t capacity = _buffer->byteLength() / sizeof(uint32_t);
+    const uint32_t count    = words[0];
+    if (count == 0) {
+        return;
+    }
+
+    const uint32_t end = count < capacity ? count + 1 : capacity;
+    uint32_t       pos = 1;
+    while (pos < end) {
+        const uint32_t header      = words[pos];
+        const auto     opcode      = static_cast<Opcode>(header & 0xFFFF);
+        const uint32_t recordWords = header >> 16;
+        const uint32_t payload     = getPayloadWords(opcode);
+        if (payload == 0 || recordWords != 1 + SLOT_WORDS + payload || pos + recordWords > end) {
+            CC_LOG_WARNING("NodeCommandBuffer: invalid record at word %u, the remaining records are dropped", pos);
+            break;
+        }
+
+        const uint32_t slot = words[pos + 1];
+        Node *         node = slot < _nodes.size() ? _nodes[slot].get() : nullptr;
+        const float *  args = reinterpret_cast<const float *>(words + pos + 1 + SLOT_WORDS);
+        pos += recordWords;
+        if (node == nullptr) {
+            continue;
+        }
+
+        switch (opcode) {
+            case Opcode::SET_POSITION:
+                node->setPositionInternal(args[0], args[1], args[2], true);
+                break;
+            case Opcode::SET_ROTATION:
+                node->setRotationInternal(args[0], args[1], args[2], args[3], true);
+                break;
+            case Opcode::SET_ROTATION_FROM_EULER:
+                node->setRotationFromEuler(args[0], args[1], args[2]);
+                break;
+            case Opcode::SET_SCALE:
+                node->setScaleInternal(args[0], args[1], args[2], true);
+                break;
+        }
+    }
+
+    words[0] = 0;
+}
+
+} // namespace cc
@@ -0,0 +1,84 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/vector.h"
+#include "core/ArrayBuffer.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Transform mutations recorded by JS into a shared buffer and applied in one pass.
+ * The first word of the buffer is the count of words recorded after it. Each record starts with
+ * a header word, `opcode | (recordWords << 16)` where recordWords includes the header, followed by
+ * the slot of the node returned by registerNode() and the float payload of the opcode.
+ * @zh JS 记录在共享内存中、一次性应用的节点变换修改。
+ * 缓冲区的第一个字表示其后已记录的字数。每条记录以头部字 `opcode | (recordWords << 16)` 开始（recordWords 包含头部），
+ * 随后是 registerNode() 返回的节点槽位以及该操作的浮点参数。
+ */
+class CC_DLL NodeCommandBuffer final {
+public:
+    enum class Opcode : uint32_t {
+        SET_POSITION = 1,        // x, y, z
+        SET_ROTATION,            // x, y, z, w
+        SET_ROTATION_FROM_EULER, // x, y, z
+        SET_SCALE,               // x, y, z
+    };
+
+    static constexpr uint32_t DEFAULT_BYTE_LENGTH{64 * 1024};
+    static constexpr uint32_t INVALID_SLOT{0xFFFFFFFF};
+
+    explicit NodeCommandBuffer(uint32_t byteLength = DEFAULT_BYTE_LENGTH);
+    ~NodeCommandBuffer();
+
+    /**
+     * @en Makes a node addressable by the records, it's retained until unregisterNode() is called.
+     * @zh 使节点可以被记录引用，在调用 unregisterNode() 之前节点会被持有。
+     */
+    uint32_t registerNode(Node *node);
+    void     unregisterNode(uint32_t slot);
+
+    /**
+     * @en Applies the recorded mutations in order and resets the buffer, called by Root before each frame.
+     * @zh 按顺序应用已记录的修改并重置缓冲区，Root 会在每帧开始前调用。
+     */
+    void apply();
+
+    inline ArrayBuffer *getBuffer() const { return _buffer; }
+
+private:
+    ArrayBuffer::Ptr                  _buffer;
+    ccstd::vector<IntrusivePtr<Node>> _nodes;
+    ccstd::vector<uint32_t>           _freeSlots;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(NodeCommandBuffer);
+};
+
+} // namespace cc
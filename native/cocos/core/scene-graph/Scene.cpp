@@ -27,6 +27,7 @@
 #include "core/scene-graph/SceneGlobals.h"
 // #include "core/Director.h"
 #include "core/Root.h"
+#include "scene/RenderScene.h"
 //#include "core/scene-graph/NodeActivator.h"
 
 namespace cc {
@@ -41,10 +42,26 @@ Scene::Scene(const ccstd::string &name)
 
 Scene::Scene() : Scene("") {}
 
-Scene::~Scene() = default;
+Scene::~Scene() {
+    CC_SAFE_DELETE(_transformStore);
+}
 
 void Scene::setSceneGlobals(SceneGlobals *globals) { _globals = globals; }
 
+void Scene::setTransformStoreEnabled(bool enabled) {
+    if (enabled == isTransformStoreEnabled()) {
+        return;
+    }
+    if (enabled) {
+        _transformStore = new TransformStore(this);
+    } else {
+        CC_SAFE_DELETE(_transformStore);
+    }
+    if (_renderScene) {
+        _renderScene->setTransformStore(_transformStore);
+    }
+}
+
 void Scene::load() {
     if (!_inited) {
         //cjh        if (TEST) {
@@ -102,6 +119,7 @@ bool Scene::destroy() {
     }
 
     if (_renderScene != nullptr) {
+        _renderScene->setTransformStore(nullptr);
         Root::getInstance()->destroyScene(_renderScene);
     }
 
@@ -49,6 +49,15 @@ public:
     void load();
     void activate(bool active = true);
 
+    /**
+     * @en Whether to keep the transforms of all nodes in this scene in a contiguous transform store,
+     * dirty transforms are then resolved in one sweep before the render scene updates its models.
+     * @zh 是否将场景中所有节点的变换保存在连续的变换存储中，脏变换会在渲染场景更新模型前一次性解算。
+     */
+    void                   setTransformStoreEnabled(bool enabled);
+    inline bool            isTransformStoreEnabled() const { return _transformStore != nullptr; }
+    inline TransformStore *getTransformStore() const { return _transformStore; }
+
     void onBatchCreated(bool dontSyncChildPrefab) override;
     bool destroy() override;
 
@@ -63,6 +72,7 @@ protected:
     //    @serializable
     IntrusivePtr<SceneGlobals> _globals;
     bool                       _inited{false};
+    TransformStore *           _transformStore{nullptr};
 
     /**
      * @en Indicates whether all (directly or indirectly) static referenced assets of this scene are releasable by default after scene unloading.
@@ -0,0 +1,267 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/scene-graph/TransformStore.h"
+#include "core/scene-graph/Node.h"
+#include "math/Mat3.h"
+
+namespace cc {
+
+TransformStore::TransformStore(Node *root)
+: _root(root) {
+    CC_ASSERT(_root && !_root->getParent()); // the store root must be a scene root
+}
+
+TransformStore::~TransformStore() {
+    for (auto i = 0; i < static_cast<index_t>(_nodes.size()); ++i) {
+        Node *node = _nodes[i];
+        if (node && node->_transformStore == this) {
+            restoreWorldTransform(node, _worldPositions[i], _worldRotations[i], _worldScales[i], _worldMatrices[i]);
+        }
+    }
+}
+
+void TransformStore::computeWorldTransform(uint32_t dirtyBits, const Vec3 &localPosition, const Quaternion &localRotation, const Vec3 &localScale,
+                                           const Mat4 *parentMatrix, const Quaternion *parentRotation,
+                                           Vec3 *worldPosition, Quaternion *worldRotation, Vec3 *worldScale, Mat4 *worldMatrix) {
+    if (parentMatrix) {
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
+            worldPosition->transformMat4(localPosition, *parentMatrix);
+            worldMatrix->m[12] = worldPosition->x;
+            worldMatrix->m[13] = worldPosition->y;
+            worldMatrix->m[14] = worldPosition->z;
+        }
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::RS)) {
+            Mat4::fromRTS(localRotation, localPosition, localScale, worldMatrix);
+            Mat4::multiply(*parentMatrix, *worldMatrix, worldMatrix);
+            if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
+                Quaternion::multiply(*parentRotation, localRotation, worldRotation);
+            }
+            Mat3       mat3;
+            Mat3       m43;
+            Quaternion quat{*worldRotation};
+            quat.conjugate();
+            Mat3::fromQuat(quat, &mat3);
+            Mat3::fromMat4(*worldMatrix, &m43);
+            Mat3::multiply(mat3, m43, &mat3);
+            worldScale->set(mat3.m[0], mat3.m[4], mat3.m[8]);
+        }
+    } else {
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::POSITION)) {
+            worldPosition->set(localPosition);
+            worldMatrix->m[12] = worldPosition->x;
+            worldMatrix->m[13] = worldPosition->y;
+            worldMatrix->m[14] = worldPosition->z;
+        }
+        if (dirtyBits & static_cast<uint32_t>(TransformBit::RS)) {
+            if (dirtyBits & static_cast<uint32_t>(TransformBit::ROTATION)) {
+                worldRotation->set(localRotation);
+            }
+            if (dirtyBits & static_cast<uint32_t>(TransformBit::SCALE)) {
+                worldScale->set(localScale);
+                Mat4::fromRTS(*worldRotation, *worldPosition, *worldScale, worldMatrix);
+            }
+        }
+    }
+}
+
+void TransformStore::update() {
+    if (_hierarchyDirty) {
+        rebuild();
+    }
+    if (!_dirty) {
+        return;
+    }
+    _dirty = false;
+
+    // Parents always precede their children, so a single forward pass resolves the whole tree.
+    const auto count = static_cast<index_t>(_nodes.size());
+    _resolvedBits.resize(count);
+    for (index_t i = 0; i < count; ++i) {
+        uint32_t dirtyBits = _dirtyFlags[i];
+        if (!dirtyBits) {
+            _resolvedBits[i] = 0;
+            continue;
+        }
+        const index_t parent = _parents[i];
+        if (parent >= 0) {
+            dirtyBits |= _resolvedBits[parent];
+        }
+        _resolvedBits[i] = dirtyBits;
+        resolveIndex(i, dirtyBits);
+    }
+}
+
+bool TransformStore::resolve(Node *node) {
+    if (_hierarchyDirty) {
+        rebuild();
+        if (node->_transformStore != this) {
+            return false;
+        }
+    }
+
+    const index_t index = node->_transformStoreIndex;
+    if (!_dirtyFlags[index]) {
+        return true;
+    }
+
+    _chain.clear();
+    for (index_t i = index; i >= 0 && _dirtyFlags[i]; i = _parents[i]) {
+        _chain.emplace_back(i);
+    }
+    uint32_t dirtyBits = 0;
+    for (auto iter = _chain.rbegin(); iter != _chain.rend(); ++iter) {
+        dirtyBits |= _dirtyFlags[*iter];
+        resolveIndex(*iter, dirtyBits);
+    }
+    return true;
+}
+
+void TransformStore::resolveIndex(index_t index, uint32_t dirtyBits) {
+    Node *node = _nodes[index];
+    if (!node) {
+        return;
+    }
+
+    _localPositions[index] = node->_localPosition;
+    _localRotations[index] = node->_localRotation;
+    _localScales[index]    = node->_localScale;
+
+    const index_t     parent         = _parents[index];
+    const Mat4 *      parentMatrix   = parent >= 0 ? &_worldMatrices[parent] : nullptr;
+    const Quaternion *parentRotation = parent >= 0 ? &_worldRotations[parent] : nullptr;
+    computeWorldTransform(dirtyBits, _localPositions[index], _localRotations[index], _localScales[index],
+                          parentMatrix, parentRotation,
+                          &_worldPositions[index], &_worldRotations[index], &_worldScales[index], &_worldMatrices[index]);
+
+    _dirtyFlags[index] = 0;
+    node->_dirtyFlag   = 0;
+}
+
+void TransformStore::detach(Node *node) {
+    const index_t index = node->_transformStoreIndex;
+    if (node->_transformStore != this || index < 0) {
+        return;
+    }
+    restoreWorldTransform(node, _worldPositions[index], _worldRotations[index], _worldScales[index], _worldMatrices[index]);
+    _nodes[index]   = nullptr;
+    _hierarchyDirty = true;
+}
+
+void TransformStore::rebuild() {
+    _hierarchyDirty = false;
+
+    ccstd::vector<Node *>     oldNodes;
+    ccstd::vector<Vec3>       oldWorldPositions;
+    ccstd::vector<Quaternion> oldWorldRotations;
+    ccstd::vector<Vec3>       oldWorldScales;
+    ccstd::vector<Mat4>       oldWorldMatrices;
+    oldNodes.swap(_nodes);
+    oldWorldPositions.swap(_worldPositions);
+    oldWorldRotations.swap(_worldRotations);
+    oldWorldScales.swap(_worldScales);
+    oldWorldMatrices.swap(_worldMatrices);
+
+    const size_t capacity = oldNodes.size();
+    _parents.clear();
+    _dirtyFlags.clear();
+    _localPositions.clear();
+    _localRotations.clear();
+    _localScales.clear();
+    _nodes.reserve(capacity);
+    _parents.reserve(capacity);
+    _dirtyFlags.reserve(capacity);
+    _localPositions.reserve(capacity);
+    _localRotations.reserve(capacity);
+    _localScales.reserve(capacity);
+    _worldPositions.reserve(capacity);
+    _worldRotations.reserve(capacity);
+    _worldScales.reserve(capacity);
+    _worldMatrices.reserve(capacity);
+
+    ccstd::vector<std::pair<Node *, index_t>> stack;
+    stack.emplace_back(_root, -1);
+    while (!stack.empty()) {
+        Node *        node   = stack.back().first;
+        const index_t parent = stack.back().second;
+        stack.pop_back();
+
+        if (node->_transformStore && node->_transformStore != this) {
+            node->_transformStore->detach(node);
+        }
+
+        const auto index = static_cast<index_t>(_nodes.size());
+        if (node->_transformStore == this) {
+            const index_t oldIndex = node->_transformStoreIndex;
+            _worldPositions.emplace_back(oldWorldPositions[oldIndex]);
+            _worldRotations.emplace_back(oldWorldRotations[oldIndex]);
+            _worldScales.emplace_back(oldWorldScales[oldIndex]);
+            _worldMatrices.emplace_back(oldWorldMatrices[oldIndex]);
+        } else {
+            _worldPositions.emplace_back(node->_worldPosition);
+            _worldRotations.emplace_back(node->_worldRotation);
+            _worldScales.emplace_back(node->_worldScale);
+            _worldMatrices.emplace_back(node->_worldMatrix);
+        }
+        _nodes.emplace_back(node);
+        _parents.emplace_back(parent);
+        _dirtyFlags.emplace_back(node->_dirtyFlag);
+        _localPositions.emplace_back(node->_localPosition);
+        _localRotations.emplace_back(node->_localRotation);
+        _localScales.emplace_back(node->_localScale);
+        node->_transformStore      = this;
+        node->_transformStoreIndex = index;
+
+        const auto &children = node->getChildren();
+        for (auto iter = children.rbegin(); iter != children.rend(); ++iter) {
+            stack.emplace_back(iter->get(), index);
+        }
+    }
+    _dirty = true;
+
+    // Nodes which have left the tree go back to storing their own transforms.
+    const auto count = static_cast<index_t>(_nodes.size());
+    for (Node *node : oldNodes) {
+        if (!node || node->_transformStore != this) {
+            continue;
+        }
+        const index_t index = node->_transformStoreIndex;
+        if (index < count && _nodes[index] == node) {
+            continue;
+        }
+        restoreWorldTransform(node, oldWorldPositions[index], oldWorldRotations[index], oldWorldScales[index], oldWorldMatrices[index]);
+    }
+}
+
+void TransformStore::restoreWorldTransform(Node *node, const Vec3 &position, const Quaternion &rotation, const Vec3 &scale, const Mat4 &matrix) {
+    node->_transformStore      = nullptr;
+    node->_transformStoreIndex = -1;
+    node->_worldPosition       = position;
+    node->_worldRotation       = rotation;
+    node->_worldScale          = scale;
+    node->_worldMatrix         = matrix;
+}
+
+} // namespace cc
@@ -0,0 +1,111 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/TypeDef.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Quaternion.h"
+#include "math/Vec3.h"
+
+namespace cc {
+
+class Node;
+
+/**
+ * @en Optional storage for the transforms of a whole node tree.
+ * Local and world TRS as well as world matrices of all nodes under the root are kept
+ * in contiguous structure-of-arrays, ordered so that a parent always precedes its children.
+ * Dirty transforms are then resolved with a single linear sweep per frame.
+ * Nodes keep their API, their world transform getters read from the store while attached.
+ * @zh 可选的节点树变换存储。根节点下所有节点的本地与世界 TRS 以及世界矩阵按层级顺序（父节点总在子节点之前）
+ * 连续存放为 SoA 数组，每帧通过一次线性遍历解算所有脏变换。
+ */
+class CC_DLL TransformStore final {
+public:
+    explicit TransformStore(Node *root);
+    ~TransformStore();
+
+    /**
+     * @en Resolves all dirty world transforms in hierarchy order.
+     * @zh 按层级顺序解算所有脏的世界变换。
+     */
+    void update();
+
+    // Resolves the world transform of the given node and its dirty ancestors only.
+    // Returns false if the node is no longer part of this store.
+    bool resolve(Node *node);
+
+    // Copies the world transform back to the node and drops it from the store.
+    void detach(Node *node);
+
+    inline void markHierarchyDirty() { _hierarchyDirty = true; }
+    inline void setDirtyFlag(index_t index, uint32_t value) {
+        _dirtyFlags[index] = value;
+        _dirty |= value != 0;
+    }
+
+    inline Node *           getRoot() const { return _root; }
+    inline uint32_t         getCount() const { return static_cast<uint32_t>(_nodes.size()); }
+    inline const Mat4 &     getWorldMatrix(index_t index) const { return _worldMatrices[index]; }
+    inline const Vec3 &     getWorldPosition(index_t index) const { return _worldPositions[index]; }
+    inline const Quaternion &getWorldRotation(index_t index) const { return _worldRotations[index]; }
+    inline const Vec3 &     getWorldScale(index_t index) const { return _worldScales[index]; }
+
+    // Shared by Node::updateWorldTransform, dirtyBits are the accumulated TransformBit of the node and its dirty ancestors.
+    static void computeWorldTransform(uint32_t dirtyBits, const Vec3 &localPosition, const Quaternion &localRotation, const Vec3 &localScale,
+                                      const Mat4 *parentMatrix, const Quaternion *parentRotation,
+                                      Vec3 *worldPosition, Quaternion *worldRotation, Vec3 *worldScale, Mat4 *worldMatrix);
+
+private:
+    static void restoreWorldTransform(Node *node, const Vec3 &position, const Quaternion &rotation, const Vec3 &scale, const Mat4 &matrix);
+
+    void rebuild();
+    void resolveIndex(index_t index, uint32_t dirtyBits);
+
+    Node *_root{nullptr};
+    bool  _hierarchyDirty{true};
+    bool  _dirty{false};
+
+    ccstd::vector<Node *>     _nodes;
+    ccstd::vector<index_t>    _parents;
+    ccstd::vector<uint32_t>   _dirtyFlags;
+    ccstd::vector<Vec3>       _localPositions;
+    ccstd::vector<Quaternion> _localRotations;
+    ccstd::vector<Vec3>       _localScales;
+    ccstd::vector<Vec3>       _worldPositions;
+    ccstd::vector<Quaternion> _worldRotations;
+    ccstd::vector<Vec3>       _worldScales;
+    ccstd::vector<Mat4>       _worldMatrices;
+
+    ccstd::vector<uint32_t> _resolvedBits;
+    ccstd::vector<index_t>  _chain;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TransformStore);
+};
+
+} // namespace cc
@@ -24,39 +24,56 @@
 ****************************************************************************/
 
 #include "core/utils/ImageUtils.h"
+#include <algorithm>
+#include <cstdlib>
 #include "base/Log.h"
 #include "renderer/gfx-base/GFXDef-common.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define CC_IMAGE_UTILS_NEON
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define CC_IMAGE_UTILS_SSE2
+    #if defined(__SSSE3__)
+        #include <tmmintrin.h>
+        #define CC_IMAGE_UTILS_SSSE3
+    #endif
+#endif
+
 namespace {
+// round(x / 255) for x in [0, 255 * 255], exact
+inline uint8_t divide255(uint32_t x) {
+    x += 128;
+    return static_cast<uint8_t>((x + (x >> 8)) >> 8);
+}
+
+struct UnpremultiplyTable {
+    // 16.16 fixed point 255 / alpha
+    uint32_t reciprocal[256];
+    UnpremultiplyTable() {
+        reciprocal[0] = 0;
+        for (uint32_t a = 1; a < 256; ++a) {
+            reciprocal[a] = (255U * 65536U + a / 2) / a;
+        }
+    }
+};
+
 uint8_t *convertRGB2RGBA(uint32_t length, uint8_t *src) {
     auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src++;
-        dst[i + 1] = *src++;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
+    cc::ImageUtils::expandRGBToRGBA(src, dst, length / 4);
     return dst;
 }
 
 uint8_t *convertIA2RGBA(uint32_t length, uint8_t *src) {
     auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = *src++;
-    }
+    cc::ImageUtils::expandLAToRGBA(src, dst, length / 4);
     return dst;
 }
 
 uint8_t *convertI2RGBA(uint32_t length, uint8_t *src) {
     auto *dst = reinterpret_cast<uint8_t *>(malloc(length));
-    for (uint32_t i = 0; i < length; i += 4) {
-        dst[i]     = *src;
-        dst[i + 1] = *src;
-        dst[i + 2] = *src++;
-        dst[i + 3] = 255;
-    }
+    cc::ImageUtils::expandLToRGBA(src, dst, length / 4);
     return dst;
 }
 } // namespace
@@ -91,4 +108,162 @@ void ImageUtils::convert2RGBA(Image *image) {
     }
 }
 
-} // namespace cc
\ No newline at end of file
+void ImageUtils::premultiplyAlpha(Image *image) {
+    if (image->_isCompressed || image->_renderFormat != gfx::Format::RGBA8 || !image->_data) {
+        return;
+    }
+    premultiplyAlpha(image->_data, static_cast<uint32_t>(image->_width * image->_height));
+}
+
+void ImageUtils::premultiplyAlpha(uint8_t *rgba, uint32_t pixelCount) {
+    uint32_t i = 0;
+#if defined(CC_IMAGE_UTILS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x4_t px = vld4_u8(rgba + i * 4);
+        // vraddhn(x, x >> 8 rounded) is the exact round(x / 255)
+        uint16x8_t r = vmull_u8(px.val[0], px.val[3]);
+        uint16x8_t g = vmull_u8(px.val[1], px.val[3]);
+        uint16x8_t b = vmull_u8(px.val[2], px.val[3]);
+        px.val[0]    = vraddhn_u16(r, vrshrq_n_u16(r, 8));
+        px.val[1]    = vraddhn_u16(g, vrshrq_n_u16(g, 8));
+        px.val[2]    = vraddhn_u16(b, vrshrq_n_u16(b, 8));
+        vst4_u8(rgba + i * 4, px);
+    }
+#elif defined(CC_IMAGE_UTILS_SSE2)
+    const __m128i zero      = _mm_setzero_si128();
+    const __m128i half      = _mm_set1_epi16(128);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 4 <= pixelCount; i += 4) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba + i * 4));
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+        // broadcast the alpha of each pixel to its four lanes
+        __m128i alphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i alphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        lo              = _mm_add_epi16(_mm_mullo_epi16(lo, alphaLo), half);
+        hi              = _mm_add_epi16(_mm_mullo_epi16(hi, alphaHi), half);
+        lo              = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi              = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        __m128i result  = _mm_packus_epi16(lo, hi);
+        result          = _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, px));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4), result);
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        uint8_t *px = rgba + i * 4;
+        px[0]       = divide255(px[0] * px[3]);
+        px[1]       = divide255(px[1] * px[3]);
+        px[2]       = divide255(px[2] * px[3]);
+    }
+}
+
+void ImageUtils::unpremultiplyAlpha(uint8_t *rgba, uint32_t pixelCount) {
+    // a division per channel is replaced by a table lookup and a multiply
+    static const UnpremultiplyTable TABLE;
+    for (uint32_t i = 0; i < pixelCount; ++i) {
+        uint8_t *      px    = rgba + i * 4;
+        const uint32_t alpha = px[3];
+        if (alpha == 0 || alpha == 255) {
+            continue;
+        }
+        const uint32_t reciprocal = TABLE.reciprocal[alpha];
+        px[0]                     = static_cast<uint8_t>(std::min((px[0] * reciprocal + 32768) >> 16, 255U));
+        px[1]                     = static_cast<uint8_t>(std::min((px[1] * reciprocal + 32768) >> 16, 255U));
+        px[2]                     = static_cast<uint8_t>(std::min((px[2] * reciprocal + 32768) >> 16, 255U));
+    }
+}
+
+void ImageUtils::expandRGBToRGBA(const uint8_t *rgb, uint8_t *rgba, uint32_t pixelCount) {
+    uint32_t i = 0;
+#if defined(CC_IMAGE_UTILS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x3_t src = vld3_u8(rgb + i * 3);
+        uint8x8x4_t dst;
+        dst.val[0] = src.val[0];
+        dst.val[1] = src.val[1];
+        dst.val[2] = src.val[2];
+        dst.val[3] = vdup_n_u8(255);
+        vst4_u8(rgba + i * 4, dst);
+    }
+#elif defined(CC_IMAGE_UTILS_SSSE3)
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha   = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    // each load reads 16 bytes for 4 pixels, stop while 4 bytes of slack remain
+    for (; i + 6 <= pixelCount; i += 4) {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgb + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4), _mm_or_si128(_mm_shuffle_epi8(src, shuffle), alpha));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        rgba[i * 4]     = rgb[i * 3];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+void ImageUtils::expandLAToRGBA(const uint8_t *la, uint8_t *rgba, uint32_t pixelCount) {
+    uint32_t i = 0;
+#if defined(CC_IMAGE_UTILS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8x2_t src = vld2_u8(la + i * 2);
+        uint8x8x4_t dst;
+        dst.val[0] = src.val[0];
+        dst.val[1] = src.val[0];
+        dst.val[2] = src.val[0];
+        dst.val[3] = src.val[1];
+        vst4_u8(rgba + i * 4, dst);
+    }
+#elif defined(CC_IMAGE_UTILS_SSE2)
+    for (; i + 8 <= pixelCount; i += 8) {
+        // 16 bit lanes hold L | A << 8, duplicating L into the low half of each pixel gives L L L A
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(la + i * 2));
+        __m128i ll  = _mm_and_si128(src, _mm_set1_epi16(0x00FF));
+        ll          = _mm_or_si128(ll, _mm_slli_epi16(ll, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4), _mm_unpacklo_epi16(ll, src));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4 + 16), _mm_unpackhi_epi16(ll, src));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        rgba[i * 4]     = la[i * 2];
+        rgba[i * 4 + 1] = la[i * 2];
+        rgba[i * 4 + 2] = la[i * 2];
+        rgba[i * 4 + 3] = la[i * 2 + 1];
+    }
+}
+
+void ImageUtils::expandLToRGBA(const uint8_t *l, uint8_t *rgba, uint32_t pixelCount) {
+    uint32_t i = 0;
+#if defined(CC_IMAGE_UTILS_NEON)
+    for (; i + 8 <= pixelCount; i += 8) {
+        uint8x8_t   src = vld1_u8(l + i);
+        uint8x8x4_t dst;
+        dst.val[0] = src;
+        dst.val[1] = src;
+        dst.val[2] = src;
+        dst.val[3] = vdup_n_u8(255);
+        vst4_u8(rgba + i * 4, dst);
+    }
+#elif defined(CC_IMAGE_UTILS_SSE2)
+    const __m128i opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 16 <= pixelCount; i += 16) {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i *>(l + i));
+        __m128i ll  = _mm_unpacklo_epi8(src, src);
+        __m128i hh  = _mm_unpackhi_epi8(src, src);
+        __m128i la0 = _mm_unpacklo_epi8(src, opaque);
+        __m128i la1 = _mm_unpackhi_epi8(src, opaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4), _mm_unpacklo_epi16(ll, la0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4 + 16), _mm_unpackhi_epi16(ll, la0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4 + 32), _mm_unpacklo_epi16(hh, la1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4 + 48), _mm_unpackhi_epi16(hh, la1));
+    }
+#endif
+    for (; i < pixelCount; ++i) {
+        rgba[i * 4]     = l[i];
+        rgba[i * 4 + 1] = l[i];
+        rgba[i * 4 + 2] = l[i];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+} // namespace cc
@@ -25,12 +25,25 @@
 
 #pragma once
 
+#include <cstdint>
 #include "cocos/platform/Image.h"
 
 namespace cc {
 class ImageUtils {
 public:
     static void convert2RGBA(Image *image);
+
+    /**
+     * Premultiplies the color of an uncompressed RGBA8 image by its alpha, does nothing for other formats.
+     */
+    static void premultiplyAlpha(Image *image);
+
+    // Pixel kernels, SIMD accelerated where available. Pixels are tightly packed 8 bit channels.
+    static void premultiplyAlpha(uint8_t *rgba, uint32_t pixelCount);
+    static void unpremultiplyAlpha(uint8_t *rgba, uint32_t pixelCount);
+    static void expandRGBToRGBA(const uint8_t *rgb, uint8_t *rgba, uint32_t pixelCount);
+    static void expandLAToRGBA(const uint8_t *la, uint8_t *rgba, uint32_t pixelCount);
+    static void expandLToRGBA(const uint8_t *l, uint8_t *rgba, uint32_t pixelCount);
 };
 
-} // namespace cc
\ No newline at end of file
+} // namespace cc
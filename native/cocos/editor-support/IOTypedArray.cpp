@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "IOTypedArray.h"
+#include <algorithm>
 #include "TypedArrayPool.h"
 
 #define USE_TYPEARRAY_POOL 0
@@ -60,6 +61,9 @@ IOTypedArray::~IOTypedArray() {
 
 void IOTypedArray::resize(std::size_t newLen, bool needCopy) {
     if (_bufferSize >= newLen) return;
+    if (_geometricGrowth) {
+        newLen = std::max(newLen, _bufferSize * 2);
+    }
 
     se::Object *newTypeBuffer = nullptr;
 
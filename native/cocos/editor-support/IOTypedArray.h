@@ -51,10 +51,16 @@ public:
 
     void resize(std::size_t newLen, bool needCopy) override;
 
+    // doubles the capacity at least on resize, so a buffer growing a little every frame is not reallocated every frame
+    void setGeometricGrowth(bool enabled) {
+        _geometricGrowth = enabled;
+    }
+
 private:
-    se::Object::TypedArrayType _arrayType = se::Object::TypedArrayType::NONE;
-    se::Object *               _typeArray = nullptr;
-    bool                       _usePool   = false;
+    se::Object::TypedArrayType _arrayType       = se::Object::TypedArrayType::NONE;
+    se::Object *               _typeArray       = nullptr;
+    bool                       _usePool         = false;
+    bool                       _geometricGrowth = false;
 };
 
 MIDDLEWARE_END
@@ -24,9 +24,15 @@
 ****************************************************************************/
 
 #include "MeshBuffer.h"
+#include <algorithm>
 
 MIDDLEWARE_BEGIN
 
+namespace {
+// granularity of the change detection, small enough to skip paused skeletons between animated ones
+constexpr std::size_t DIRTY_BLOCK_SIZE = 4096;
+} // namespace
+
 MeshBuffer::MeshBuffer(int vertexFormat)
 : MeshBuffer(vertexFormat, INIT_INDEX_BUFFER_SIZE, MAX_VERTEX_BUFFER_SIZE) {
 }
@@ -58,6 +64,8 @@ void MeshBuffer::clear() {
     }
     _ibArr.clear();
     _vbArr.clear();
+    _ibDirty.clear();
+    _vbDirty.clear();
 }
 
 void MeshBuffer::afterCleanupHandle() {
@@ -72,25 +80,59 @@ void MeshBuffer::init() {
     auto *rVB = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, _vb.getCapacity());
     _vbArr.push_back(rVB);
 
+    _ibDirty.resize(_ibArr.size());
+    _vbDirty.resize(_vbArr.size());
+
     se::ScriptEngine::getInstance()->addAfterCleanupHook([this] { afterCleanupHandle(); });
 }
 
+MeshBuffer::DirtyRange MeshBuffer::uploadDirtyBlocks(IOTypedArray *dst, const IOBuffer &src) {
+    auto        length     = src.length();
+    auto        prevLength = dst->length();
+    const auto *prevData   = dst->getBuffer();
+
+    dst->reset();
+    dst->checkSpace(length, true);
+    // a new typed array has been created, upload it as a whole
+    if (dst->getBuffer() != prevData) {
+        prevLength = 0;
+    }
+
+    const auto *srcData = src.getBuffer();
+    auto *      dstData = dst->getBuffer();
+    std::size_t begin   = length;
+    std::size_t end     = 0;
+    for (std::size_t offset = 0; offset < length; offset += DIRTY_BLOCK_SIZE) {
+        auto blockSize = std::min(DIRTY_BLOCK_SIZE, length - offset);
+        if (offset + blockSize <= prevLength && memcmp(dstData + offset, srcData + offset, blockSize) == 0) {
+            continue;
+        }
+        memcpy(dstData + offset, srcData + offset, blockSize);
+        begin = std::min(begin, offset);
+        end   = offset + blockSize;
+    }
+    dst->move(static_cast<int>(length));
+
+    DirtyRange range;
+    if (end > begin) {
+        range.offset = begin;
+        range.length = end - begin;
+    }
+    return range;
+}
+
 void MeshBuffer::uploadVB() {
     auto length = _vb.length();
     if (length == 0) return;
 
-    auto *rVB = _vbArr[_bufferPos];
-    rVB->reset();
-    rVB->writeBytes(reinterpret_cast<const char *>(_vb.getBuffer()), _vb.length());
+    _vbDirty[_bufferPos] = uploadDirtyBlocks(_vbArr[_bufferPos], _vb);
 }
 
 void MeshBuffer::uploadIB() {
     auto length = _ib.length();
     if (length == 0) return;
 
-    auto *rIB = _ibArr[_bufferPos];
-    rIB->reset();
-    rIB->writeBytes(reinterpret_cast<const char *>(_ib.getBuffer()), _ib.length());
+    _ibDirty[_bufferPos] = uploadDirtyBlocks(_ibArr[_bufferPos], _ib);
 }
 
 void MeshBuffer::next() {
@@ -104,6 +146,9 @@ void MeshBuffer::next() {
         auto *rVB = new IOTypedArray(se::Object::TypedArrayType::FLOAT32, _vb.getCapacity());
         _vbArr.push_back(rVB);
     }
+
+    _ibDirty.resize(_ibArr.size());
+    _vbDirty.resize(_vbArr.size());
 }
 
 void MeshBuffer::reset() {
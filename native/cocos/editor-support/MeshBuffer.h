@@ -58,6 +58,28 @@ public:
         return _ibArr[bufferPos]->length();
     }
 
+    // byte range of the vertex typed array which changed since the previous upload
+    std::size_t getVBDirtyOffset(std::size_t bufferPos) const {
+        if (_vbDirty.size() <= bufferPos) return 0;
+        return _vbDirty[bufferPos].offset;
+    }
+
+    std::size_t getVBDirtyLength(std::size_t bufferPos) const {
+        if (_vbDirty.size() <= bufferPos) return 0;
+        return _vbDirty[bufferPos].length;
+    }
+
+    // byte range of the index typed array which changed since the previous upload
+    std::size_t getIBDirtyOffset(std::size_t bufferPos) const {
+        if (_ibDirty.size() <= bufferPos) return 0;
+        return _ibDirty[bufferPos].offset;
+    }
+
+    std::size_t getIBDirtyLength(std::size_t bufferPos) const {
+        if (_ibDirty.size() <= bufferPos) return 0;
+        return _ibDirty[bufferPos].length;
+    }
+
     std::size_t getBufferCount() const {
         return _bufferPos + 1;
     }
@@ -79,6 +101,14 @@ public:
     void reset();
 
 private:
+    struct DirtyRange {
+        std::size_t offset = 0;
+        std::size_t length = 0;
+    };
+
+    // copies the blocks of src which differ from what dst holds, dst keeps the previous upload of the same buffer pos
+    static DirtyRange uploadDirtyBlocks(IOTypedArray *dst, const IOBuffer &src);
+
     void next();
     void clear();
     void init();
@@ -86,6 +116,8 @@ private:
 
     ccstd::vector<IOTypedArray *> _ibArr;
     ccstd::vector<IOTypedArray *> _vbArr;
+    ccstd::vector<DirtyRange>     _ibDirty;
+    ccstd::vector<DirtyRange>     _vbDirty;
     std::size_t                   _bufferPos = 0;
     IOBuffer                      _vb;
     IOBuffer                      _ib;
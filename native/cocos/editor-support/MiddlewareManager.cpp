@@ -25,7 +25,13 @@
 
 #include "MiddlewareManager.h"
 #include "SeApi.h"
+#include "TypedArrayPool.h"
 #include <algorithm>
+#include "base/job-system/JobSystem.h"
+
+namespace {
+constexpr uint32_t PARALLEL_UPDATE_MIN_CHUNK_SIZE = 8; // elements per job, smaller chunks cost more to dispatch than they save
+} // namespace
 
 MIDDLEWARE_BEGIN
 
@@ -65,9 +71,44 @@ void MiddlewareManager::clearRemoveList() {
     _removeList.clear();
 }
 
+bool MiddlewareManager::isRemoved(IMiddleware *editor) const {
+    return !_removeList.empty() && std::find(_removeList.begin(), _removeList.end(), editor) != _removeList.end();
+}
+
+bool MiddlewareManager::updateParallel(float dt) {
+    _parallelUpdateList.clear();
+    for (auto *editor : _updateList) {
+        if (editor->isParallelUpdateSupported() && !isRemoved(editor)) {
+            _parallelUpdateList.emplace_back(editor);
+        }
+    }
+
+    const auto editorCount = static_cast<uint32_t>(_parallelUpdateList.size());
+    const auto chunkCount  = std::min(cc::JobSystem::getInstance()->threadCount(), editorCount / PARALLEL_UPDATE_MIN_CHUNK_SIZE);
+    if (chunkCount <= 1) {
+        _parallelUpdateList.clear();
+        return false;
+    }
+
+    const auto chunkSize = (editorCount + chunkCount - 1) / chunkCount;
+    auto       job       = [this, dt, editorCount, chunkSize](uint32_t chunk) {
+        for (uint32_t i = chunk * chunkSize; i < std::min(editorCount, (chunk + 1) * chunkSize); ++i) {
+            _parallelUpdateList[i]->updateParallel(dt);
+        }
+    };
+    cc::JobGraph g(cc::JobSystem::getInstance());
+    g.createForEachIndexJob(1U, chunkCount, 1U, job);
+    g.run();
+    job(0);
+    g.waitForAll();
+    return true;
+}
+
 void MiddlewareManager::update(float dt) {
     isUpdating = true;
 
+    TypedArrayPool::trimInstance();
+
     _renderInfo.reset();
     auto *renderBuffer = _renderInfo.getBuffer();
     if (renderBuffer) {
@@ -80,18 +121,19 @@ void MiddlewareManager::update(float dt) {
         attachBuffer->writeUint32(0);
     }
 
+    // the elements updated in parallel only raise their events here, in the same order as serial updates
+    const bool parallel = _parallelUpdateEnabled && updateParallel(dt);
+
     auto isOrderDirty = false;
     uint32_t maxRenderOrder = 0;
     for (auto *editor : _updateList) {
         uint32_t renderOrder = maxRenderOrder;
-        if (!_removeList.empty()) {
-            auto removeIt = std::find(_removeList.begin(), _removeList.end(), editor);
-            if (removeIt == _removeList.end()) {
+        if (!isRemoved(editor)) {
+            if (parallel && editor->isParallelUpdateSupported()) {
+                editor->flushParallelUpdate();
+            } else {
                 editor->update(dt);
-                renderOrder = editor->getRenderOrder();
             }
-        } else {
-            editor->update(dt);
             renderOrder = editor->getRenderOrder();
         }
 
@@ -203,6 +245,30 @@ std::size_t MiddlewareManager::getIBTypedArrayLength(int format, std::size_t buf
     return mb->getIBTypedArrayLength(bufferPos);
 }
 
+std::size_t MiddlewareManager::getVBDirtyOffset(int format, std::size_t bufferPos) {
+    MeshBuffer *mb = _mbMap[format];
+    if (!mb) return 0;
+    return mb->getVBDirtyOffset(bufferPos);
+}
+
+std::size_t MiddlewareManager::getVBDirtyLength(int format, std::size_t bufferPos) {
+    MeshBuffer *mb = _mbMap[format];
+    if (!mb) return 0;
+    return mb->getVBDirtyLength(bufferPos);
+}
+
+std::size_t MiddlewareManager::getIBDirtyOffset(int format, std::size_t bufferPos) {
+    MeshBuffer *mb = _mbMap[format];
+    if (!mb) return 0;
+    return mb->getIBDirtyOffset(bufferPos);
+}
+
+std::size_t MiddlewareManager::getIBDirtyLength(int format, std::size_t bufferPos) {
+    MeshBuffer *mb = _mbMap[format];
+    if (!mb) return 0;
+    return mb->getIBDirtyLength(bufferPos);
+}
+
 std::size_t MiddlewareManager::getBufferCount(int format) {
     MeshBuffer *mb = getMeshBuffer(format);
     if (!mb) return 0;
@@ -44,6 +44,12 @@ public:
     virtual void     update(float dt)       = 0;
     virtual void     render(float dt)       = 0;
     virtual uint32_t getRenderOrder() const = 0;
+
+    // if true, updateParallel may run on a job thread, concurrently with the other middlewares
+    virtual bool isParallelUpdateSupported() const { return false; }
+    // must not call into script, the events are raised by flushParallelUpdate on the main thread
+    virtual void updateParallel(float dt) { update(dt); }
+    virtual void flushParallelUpdate() {}
 };
 
 /**
@@ -79,6 +85,13 @@ public:
      */
     void update(float dt);
 
+    /**
+     * @brief Updates the elements that support it on job threads, the others on the main thread afterwards.
+     * The events of all elements are raised on the main thread in update order. Disabled by default.
+     */
+    inline void setParallelUpdateEnabled(bool enabled) { _parallelUpdateEnabled = enabled; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
     /**
      * @brief render all elements
      */
@@ -103,6 +116,11 @@ public:
     std::size_t   getBufferCount(int format);
     std::size_t   getVBTypedArrayLength(int format, std::size_t bufferPos);
     std::size_t   getIBTypedArrayLength(int format, std::size_t bufferPos);
+    // byte ranges written by the last render which differ from the frame before, the rest of the typed arrays is unchanged
+    std::size_t getVBDirtyOffset(int format, std::size_t bufferPos);
+    std::size_t getVBDirtyLength(int format, std::size_t bufferPos);
+    std::size_t getIBDirtyOffset(int format, std::size_t bufferPos);
+    std::size_t getIBDirtyLength(int format, std::size_t bufferPos);
 
     SharedBufferManager *getRenderInfoMgr();
     SharedBufferManager *getAttachInfoMgr();
@@ -116,10 +134,15 @@ public:
 
 private:
     void clearRemoveList();
+    bool isRemoved(IMiddleware *editor) const;
+    // returns false if there are too few elements to be worth it
+    bool updateParallel(float dt);
 
     ccstd::vector<IMiddleware *> _updateList;
     ccstd::vector<IMiddleware *> _removeList;
+    ccstd::vector<IMiddleware *> _parallelUpdateList;
     std::map<int, MeshBuffer *>  _mbMap;
+    bool                         _parallelUpdateEnabled{false};
 
     SharedBufferManager _renderInfo;
     SharedBufferManager _attachInfo;
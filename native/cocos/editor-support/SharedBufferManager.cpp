@@ -47,6 +47,7 @@ void SharedBufferManager::afterCleanupHandle() {
 void SharedBufferManager::init() {
     if (!_buffer) {
         _buffer = new IOTypedArray(_arrayType, INIT_RENDER_INFO_BUFFER_SIZE);
+        _buffer->setGeometricGrowth(true);
         _buffer->setResizeCallback([this] {
             if (_resizeCallback) {
                 _resizeCallback();
@@ -56,4 +57,19 @@ void SharedBufferManager::init() {
     se::ScriptEngine::getInstance()->addAfterCleanupHook([this] { afterCleanupHandle(); });
 }
 
+void SharedBufferManager::reset() {
+    if (!_buffer) return;
+
+    // nothing has been written for the new frame yet, so the data needs no copy and script
+    // reacquires the view before any element refers to it
+    auto capacity = _buffer->getCapacity();
+    if (_buffer->getCurPos() > capacity / 4 * 3) {
+        _buffer->resize(capacity * 2, false);
+        if (_resizeCallback) {
+            _resizeCallback();
+        }
+    }
+    _buffer->reset();
+}
+
 MIDDLEWARE_END
@@ -36,9 +36,8 @@ public:
     explicit SharedBufferManager(se::Object::TypedArrayType arrayType);
     virtual ~SharedBufferManager();
 
-    void reset() {
-        _buffer->reset();
-    }
+    // called at the start of a frame, grows the buffer ahead of time when the last frame came close to its capacity
+    void reset();
 
     IOTypedArray *getBuffer() {
         return _buffer;
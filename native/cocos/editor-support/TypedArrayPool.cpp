@@ -24,9 +24,10 @@
 ****************************************************************************/
 
 #include "TypedArrayPool.h"
-#include <cmath>
+#include <algorithm>
 #include <functional>
 #include "MiddlewareMacro.h"
+#include "application/ApplicationManager.h"
 #include "base/Log.h"
 #include "base/Macros.h"
 
@@ -44,11 +45,32 @@
 
 MIDDLEWARE_BEGIN
 
-const static std::size_t MAX_POOL_SIZE = 50;
+const static std::size_t MAX_POOL_SIZE   = 50;
+const static uint32_t    MAX_IDLE_FRAMES = 600;
+
+namespace {
+// smallest size class holding size, every array of the class fits the request
+std::size_t ceilSizeClass(std::size_t size) {
+    std::size_t sizeClass = MIN_TYPE_ARRAY_SIZE;
+    while (sizeClass < size) {
+        sizeClass <<= 1;
+    }
+    return sizeClass;
+}
+
+// largest size class not above capacity, the array fits every request of the class
+std::size_t floorSizeClass(std::size_t capacity) {
+    std::size_t sizeClass = MIN_TYPE_ARRAY_SIZE;
+    while ((sizeClass << 1) <= capacity) {
+        sizeClass <<= 1;
+    }
+    return sizeClass;
+}
+} // namespace
 
 TypedArrayPool *TypedArrayPool::instance = nullptr;
 
-TypedArrayPool::TypedArrayPool() {
+TypedArrayPool::TypedArrayPool() : _maxPerClass(MAX_POOL_SIZE), _maxIdleFrames(MAX_IDLE_FRAMES) {
     se::ScriptEngine::getInstance()->addAfterCleanupHook([this] { afterCleanupHandle(); });
 }
 
@@ -67,6 +89,11 @@ void TypedArrayPool::afterInitHandle() {
     se::ScriptEngine::getInstance()->addAfterCleanupHook([this] { afterCleanupHandle(); });
 }
 
+void TypedArrayPool::releaseObject(se::Object *object) {
+    object->unroot();
+    object->decRef();
+}
+
 void TypedArrayPool::clearPool() {
     POOL_LOG("*****clearPool TypeArray pool begin");
 
@@ -77,21 +104,23 @@ void TypedArrayPool::clearPool() {
         for (auto &itMapPool : mapPool) {
             //vector
             objPool &itFitPool = *(itMapPool.second);
-            POOL_LOG("clear arrayType:%d,fitSize:%lu,objSize:%lu\n", it->first, itMapPool->first, itFitPool.size());
+            POOL_LOG("clear arrayType:%d,sizeClass:%lu,objSize:%lu\n", (int)it.first, itMapPool.first, itFitPool.size());
             for (auto &itFit : itFitPool) {
-                itFit->unroot();
-                itFit->decRef();
+                releaseObject(itFit.object);
             }
             delete &itFitPool;
         }
         delete &mapPool;
     }
     _pool.clear();
+    _pooledBytes = 0;
+    _liveBytes   = 0;
 
     POOL_LOG("*****clearPool TypeArray pool end");
 }
 
 void TypedArrayPool::dump() {
+    POOL_LOG("pooledBytes:%lu,liveBytes:%lu\n", _pooledBytes, _liveBytes);
     //map
     for (auto &it : _pool) {
         //map
@@ -99,30 +128,33 @@ void TypedArrayPool::dump() {
         for (auto &itMapPool : mapPool) {
             //vector
             CC_UNUSED objPool &itFitPool = *(itMapPool.second);
-            POOL_LOG("arrayType:%d,fitSize:%lu,objSize:%lu\n", it->first, itMapPool->first, itFitPool.size());
+            POOL_LOG("arrayType:%d,sizeClass:%lu,objSize:%lu\n", (int)it.first, itMapPool.first, itFitPool.size());
         }
     }
 }
 
 se::Object *TypedArrayPool::pop(arrayType type, std::size_t size) {
-    auto     fitSize    = static_cast<std::size_t>(std::ceil(static_cast<float>(size) / float(MIN_TYPE_ARRAY_SIZE)) * MIN_TYPE_ARRAY_SIZE);
-    objPool *objPoolPtr = getObjPool(type, fitSize);
+    auto     sizeClass  = ceilSizeClass(size);
+    objPool *objPoolPtr = getObjPool(type, sizeClass);
 
     if (!objPoolPtr->empty()) {
-        se::Object *obj = objPoolPtr->back();
+        PoolEntry entry = objPoolPtr->back();
         objPoolPtr->pop_back();
-        POOL_LOG("TypedArrayPool:pop result:success,type:%d,fitSize:%lu,objSize:%lu\n", (int)type, fitSize, objPoolPtr->size());
-        return obj;
+        _pooledBytes -= entry.capacity;
+        _liveBytes += entry.capacity;
+        POOL_LOG("TypedArrayPool:pop result:success,type:%d,sizeClass:%lu,objSize:%lu\n", (int)type, sizeClass, objPoolPtr->size());
+        return entry.object;
     }
 
-    POOL_LOG("TypedArrayPool:pop result:empty,type:%d,fitSize:%lu,objSize:%lu\n", (int)type, fitSize, objPoolPtr->size());
+    POOL_LOG("TypedArrayPool:pop result:empty,type:%d,sizeClass:%lu,objSize:%lu\n", (int)type, sizeClass, objPoolPtr->size());
     se::AutoHandleScope hs;
-    auto *              typeArray = se::Object::createTypedArray(type, nullptr, fitSize);
+    auto *              typeArray = se::Object::createTypedArray(type, nullptr, sizeClass);
     typeArray->root();
+    _liveBytes += sizeClass;
     return typeArray;
 }
 
-TypedArrayPool::objPool *TypedArrayPool::getObjPool(arrayType type, std::size_t fitSize) {
+TypedArrayPool::objPool *TypedArrayPool::getObjPool(arrayType type, std::size_t sizeClass) {
     auto    it        = _pool.find(type);
     fitMap *fitMapPtr = nullptr;
     if (it == _pool.end()) {
@@ -132,11 +164,11 @@ TypedArrayPool::objPool *TypedArrayPool::getObjPool(arrayType type, std::size_t
         fitMapPtr = it->second;
     }
 
-    auto     itPool     = fitMapPtr->find(fitSize);
+    auto     itPool     = fitMapPtr->find(sizeClass);
     objPool *objPoolPtr = nullptr;
     if (itPool == fitMapPtr->end()) {
-        objPoolPtr            = new objPool();
-        (*fitMapPtr)[fitSize] = objPoolPtr;
+        objPoolPtr              = new objPool();
+        (*fitMapPtr)[sizeClass] = objPoolPtr;
     } else {
         objPoolPtr = itPool->second;
     }
@@ -149,27 +181,50 @@ void TypedArrayPool::push(arrayType type, std::size_t arrayCapacity, se::Object
 
     // If script engine is cleaning,delete object directly
     if (!_allowPush) {
-        object->unroot();
-        object->decRef();
-        object = nullptr;
+        releaseObject(object);
         POOL_LOG("TypedArrayPool:push result:not allow,type:%d,arrayCapacity:%lu\n", (int)type, arrayCapacity);
         return;
     }
 
-    objPool *objPoolPtr = getObjPool(type, arrayCapacity);
-    auto     it         = std::find(objPoolPtr->begin(), objPoolPtr->end(), object);
+    objPool *objPoolPtr = getObjPool(type, floorSizeClass(arrayCapacity));
+    auto     it         = std::find_if(objPoolPtr->begin(), objPoolPtr->end(), [object](const PoolEntry &entry) {
+        return entry.object == object;
+    });
     if (it != objPoolPtr->end()) {
         POOL_LOG("TypedArrayPool:push result:repeat\n");
         return;
     }
 
-    if (objPoolPtr->size() < MAX_POOL_SIZE) {
-        objPoolPtr->push_back(object);
+    _liveBytes -= std::min(_liveBytes, arrayCapacity);
+
+    // an array below the smallest class fits no request
+    if (arrayCapacity >= MIN_TYPE_ARRAY_SIZE && objPoolPtr->size() < _maxPerClass) {
+        objPoolPtr->push_back({object, arrayCapacity, CC_CURRENT_ENGINE()->getTotalFrames()});
+        _pooledBytes += arrayCapacity;
         POOL_LOG("TypedArrayPool:push result:success,type:%d,arrayCapacity:%lu,objSize:%lu\n", (int)type, arrayCapacity, objPoolPtr->size());
     } else {
-        object->unroot();
-        object->decRef();
-        object = nullptr;
+        releaseObject(object);
+    }
+}
+
+void TypedArrayPool::trim() {
+    if (_maxIdleFrames == 0 || _pooledBytes == 0) return;
+
+    auto curFrame = CC_CURRENT_ENGINE()->getTotalFrames();
+    if (curFrame == _lastTrimFrame) return;
+    _lastTrimFrame = curFrame;
+
+    for (auto &it : _pool) {
+        for (auto &itMapPool : *(it.second)) {
+            objPool &itFitPool = *(itMapPool.second);
+            auto     itIdle    = std::remove_if(itFitPool.begin(), itFitPool.end(), [&](const PoolEntry &entry) {
+                if (curFrame - entry.lastUsedFrame <= _maxIdleFrames) return false;
+                releaseObject(entry.object);
+                _pooledBytes -= entry.capacity;
+                return true;
+            });
+            itFitPool.erase(itIdle, itFitPool.end());
+        }
     }
 }
 
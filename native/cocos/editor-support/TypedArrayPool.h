@@ -31,7 +31,8 @@
 
 MIDDLEWARE_BEGIN
 /** 
- * TypeArray Pool for IOTypedArray
+ * TypeArray Pool for IOTypedArray.
+ * Arrays are bucketed by power of two size classes, a popped array may be larger than requested.
  */
 class TypedArrayPool {
 private:
@@ -52,13 +53,27 @@ public:
         }
     }
 
+    // called once per frame, does nothing if the pool has never been used
+    static void trimInstance() {
+        if (instance) {
+            instance->trim();
+        }
+    }
+
 private:
+    struct PoolEntry {
+        se::Object *object        = nullptr;
+        std::size_t capacity      = 0;
+        uint32_t    lastUsedFrame = 0;
+    };
+
     using arrayType = se::Object::TypedArrayType;
-    using objPool   = ccstd::vector<se::Object *>;
+    using objPool   = ccstd::vector<PoolEntry>;
     using fitMap    = std::map<std::size_t, objPool *>;
     using typeMap   = std::map<arrayType, fitMap *>;
 
-    objPool *getObjPool(arrayType type, std::size_t size);
+    objPool *getObjPool(arrayType type, std::size_t sizeClass);
+    void     releaseObject(se::Object *object);
 
     TypedArrayPool();
     ~TypedArrayPool();
@@ -72,8 +87,14 @@ private:
     void afterCleanupHandle();
     void afterInitHandle();
 
-    typeMap _pool;
-    bool    _allowPush = true;
+    typeMap     _pool;
+    bool        _allowPush     = true;
+    std::size_t _pooledBytes   = 0;
+    std::size_t _liveBytes     = 0;
+    uint32_t    _lastTrimFrame = 0;
+
+    std::size_t _maxPerClass;
+    uint32_t    _maxIdleFrames;
 
 public:
     /**
@@ -90,5 +111,25 @@ public:
      * @param[in] object TypeArray which want to put in pool.
      */
     void push(arrayType type, std::size_t arrayCapacity, se::Object *object);
+    /**
+     * @brief Release the pooled arrays which have not been popped for more than the max idle frames.
+     */
+    void trim();
+
+    /**
+     * @brief Max count of pooled arrays in one size class, arrays pushed beyond it are released.
+     */
+    void        setMaxPerClass(std::size_t count) { _maxPerClass = count; }
+    std::size_t getMaxPerClass() const { return _maxPerClass; }
+    /**
+     * @brief Frames a pooled array may stay unused before trim releases it, 0 disables trimming.
+     */
+    void     setMaxIdleFrames(uint32_t frames) { _maxIdleFrames = frames; }
+    uint32_t getMaxIdleFrames() const { return _maxIdleFrames; }
+
+    // bytes of the arrays waiting in the pool
+    std::size_t getPooledBytes() const { return _pooledBytes; }
+    // bytes of the arrays popped and not pushed back yet
+    std::size_t getLiveBytes() const { return _liveBytes; }
 };
 MIDDLEWARE_END
@@ -22,7 +22,9 @@
  */
 
 #include "ArmatureCache.h"
+#include "ArmatureCacheMgr.h"
 #include "CCFactory.h"
+#include "application/ApplicationManager.h"
 #include "base/TypeDef.h"
 #include "base/memory/Memory.h"
 
@@ -54,16 +56,6 @@ cc::middleware::Texture2D *ArmatureCache::SegmentData::getTexture() const {
 ArmatureCache::FrameData::FrameData() = default;
 
 ArmatureCache::FrameData::~FrameData() {
-    for (auto &bone : _bones) {
-        delete bone;
-    }
-    _bones.clear();
-
-    for (auto &color : _colors) {
-        delete color;
-    }
-    _colors.clear();
-
     for (auto &segment : _segments) {
         delete segment;
     }
@@ -73,10 +65,9 @@ ArmatureCache::FrameData::~FrameData() {
 ArmatureCache::BoneData *ArmatureCache::FrameData::buildBoneData(std::size_t index) {
     if (index > _bones.size()) return nullptr;
     if (index == _bones.size()) {
-        auto *boneData = new BoneData;
-        _bones.push_back(boneData);
+        _bones.emplace_back();
     }
-    return _bones[index];
+    return &_bones[index];
 }
 
 std::size_t ArmatureCache::FrameData::getBoneCount() const {
@@ -86,10 +77,9 @@ std::size_t ArmatureCache::FrameData::getBoneCount() const {
 ArmatureCache::ColorData *ArmatureCache::FrameData::buildColorData(std::size_t index) {
     if (index > _colors.size()) return nullptr;
     if (index == _colors.size()) {
-        auto *colorData = new ColorData;
-        _colors.push_back(colorData);
+        _colors.emplace_back();
     }
-    return _colors[index];
+    return &_colors[index];
 }
 
 std::size_t ArmatureCache::FrameData::getColorCount() const {
@@ -109,6 +99,10 @@ std::size_t ArmatureCache::FrameData::getSegmentCount() const {
     return _segments.size();
 }
 
+std::size_t ArmatureCache::FrameData::getMemorySize() const {
+    return sizeof(FrameData) + _bones.capacity() * sizeof(BoneData) + _colors.capacity() * sizeof(ColorData) + _segments.size() * sizeof(SegmentData);
+}
+
 ArmatureCache::AnimationData::AnimationData() = default;
 
 ArmatureCache::AnimationData::~AnimationData() {
@@ -120,8 +114,25 @@ void ArmatureCache::AnimationData::reset() {
         delete frame;
     }
     _frames.clear();
-    _isComplete = false;
-    _totalTime  = 0.0F;
+    _vertices.clear();
+    _indices.clear();
+    _isComplete      = false;
+    _totalTime       = 0.0F;
+    _frameMemorySize = 0;
+}
+
+void ArmatureCache::AnimationData::markUsed() {
+    _lastUsedFrame = CC_CURRENT_ENGINE()->getTotalFrames();
+}
+
+std::size_t ArmatureCache::AnimationData::getMemorySize() const {
+    return _frameMemorySize + _frames.capacity() * sizeof(FrameData *) + _vertices.capacity() * sizeof(float) + _indices.capacity() * sizeof(uint16_t);
+}
+
+void ArmatureCache::AnimationData::shrinkToFit() {
+    _frames.shrink_to_fit();
+    _vertices.shrink_to_fit();
+    _indices.shrink_to_fit();
 }
 
 bool ArmatureCache::AnimationData::needUpdate(int toFrameIdx) const {
@@ -133,7 +144,9 @@ ArmatureCache::FrameData *ArmatureCache::AnimationData::buildFrameData(std::size
         return nullptr;
     }
     if (frameIdx == _frames.size()) {
-        auto *frameData = new FrameData();
+        auto *frameData               = new FrameData();
+        frameData->_vertexFloatOffset = _vertices.size();
+        frameData->_indexOffset       = _indices.size();
         _frames.push_back(frameData);
     }
     return _frames[frameIdx];
@@ -207,6 +220,7 @@ void ArmatureCache::updateToFrame(const std::string &animationName, int toFrameI
     if (!animationData || !animationData->needUpdate(toFrameIdx)) {
         return;
     }
+    animationData->markUsed();
 
     if (_curAnimationName != animationName) {
         updateToFrame(_curAnimationName);
@@ -229,10 +243,16 @@ void ArmatureCache::updateToFrame(const std::string &animationName, int toFrameI
             animationData->_isComplete = true;
         }
     } while (animationData->needUpdate(toFrameIdx));
+
+    if (!animationData->needUpdate(-1)) {
+        animationData->shrinkToFit();
+    }
+    ArmatureCacheMgr::getInstance()->trimToBudget();
 }
 
 void ArmatureCache::renderAnimationFrame(AnimationData *animationData) {
     std::size_t frameIndex = animationData->getFrameCount();
+    _animationData         = animationData;
     _frameData             = animationData->buildFrameData(frameIndex);
 
     _preColor = Color4F(-1.0F, -1.0F, -1.0F, -1.0F);
@@ -258,15 +278,17 @@ void ArmatureCache::renderAnimationFrame(AnimationData *animationData) {
     auto colorCount = _frameData->getColorCount();
     if (colorCount > 0) {
         ColorData *preColorData         = _frameData->buildColorData(colorCount - 1);
-        preColorData->vertexFloatOffset = static_cast<int>(_frameData->vb.getCurPos()) / sizeof(float);
+        preColorData->vertexFloatOffset = animationData->_vertices.size() - _frameData->_vertexFloatOffset;
     }
 
-    _frameData = nullptr;
+    animationData->_frameMemorySize += _frameData->getMemorySize();
+    _animationData = nullptr;
+    _frameData     = nullptr;
 }
 
 void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*= 1.0f*/) {
-    middleware::IOBuffer &vb = _frameData->vb;
-    middleware::IOBuffer &ib = _frameData->ib;
+    auto &vertices = _animationData->_vertices;
+    auto &indices  = _animationData->_indices;
 
     const auto &bones = armature->getBones();
     Bone *      bone  = nullptr;
@@ -290,7 +312,7 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
         segmentData->blendMode = static_cast<int>(slot->_blendMode);
 
         // save new segment count pos field
-        _preISegWritePos = static_cast<int>(ib.getCurPos() / sizeof(uint16_t));
+        _preISegWritePos = static_cast<int>(indices.size());
         // reset pre blend mode to current
         _preBlendMode = static_cast<int>(slot->_blendMode);
         // reset pre texture index to current
@@ -341,7 +363,6 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
         _curTextureIndex = texture->getRealTextureIndex();
 
         auto vbSize = slot->triangles.vertCount * sizeof(middleware::V2F_T2F_C4F);
-        vb.checkSpace(vbSize, true);
 
         // If texture or blendMode change,will change material.
         if (_preTextureIndex != _curTextureIndex || _preBlendMode != static_cast<int>(slot->_blendMode)) {
@@ -359,7 +380,7 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
             auto colorCount = _frameData->getColorCount();
             if (colorCount > 0) {
                 ColorData *preColorData         = _frameData->buildColorData(colorCount - 1);
-                preColorData->vertexFloatOffset = vb.getCurPos() / sizeof(float);
+                preColorData->vertexFloatOffset = vertices.size() - _frameData->_vertexFloatOffset;
             }
             ColorData *colorData = _frameData->buildColorData(colorCount);
             colorData->color     = color;
@@ -381,14 +402,12 @@ void ArmatureCache::traverseArmature(Armature *armature, float parentOpacity /*=
             worldVertex->color.a = color.a;
         }
 
-        vb.writeBytes(reinterpret_cast<char *>(worldTriangles), vbSize);
-
-        auto ibSize = triangles.indexCount * sizeof(uint16_t);
-        ib.checkSpace(ibSize, true);
+        auto *worldFloats = reinterpret_cast<float *>(worldTriangles);
+        vertices.insert(vertices.end(), worldFloats, worldFloats + vbSize / sizeof(float));
 
         auto vertexOffset = _curVSegLen / VF_XYZUVC;
         for (int ii = 0, nn = triangles.indexCount; ii < nn; ii++) {
-            ib.writeUint16(triangles.indices[ii] + vertexOffset);
+            indices.push_back(triangles.indices[ii] + vertexOffset);
         }
 
         _curISegLen += triangles.indexCount;
@@ -402,6 +421,23 @@ void ArmatureCache::resetAllAnimationData() {
     }
 }
 
+std::size_t ArmatureCache::getMemorySize() const {
+    std::size_t size = 0;
+    for (const auto &animationCache : _animationCaches) {
+        size += animationCache.second->getMemorySize();
+    }
+    return size;
+}
+
+void ArmatureCache::evictAnimationData(AnimationData *animationData) {
+    animationData->reset();
+    animationData->shrinkToFit();
+    // the armature state no longer matches the baked frames, start over on next play.
+    if (animationData->_animationName == _curAnimationName) {
+        _curAnimationName = "";
+    }
+}
+
 void ArmatureCache::resetAnimationData(const std::string &animationName) {
     for (auto &animationCache : _animationCaches) {
         if (animationCache.second->_animationName == animationName) {
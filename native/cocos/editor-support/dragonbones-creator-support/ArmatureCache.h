@@ -29,7 +29,11 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+class ArmatureCacheMgr;
+
 class ArmatureCache : public cc::RefCounted {
+    friend class ArmatureCacheMgr;
+
 public:
     struct SegmentData {
         friend class ArmatureCache;
@@ -64,12 +68,12 @@ public:
         FrameData();
         ~FrameData();
 
-        const std::vector<BoneData *> &getBones() const {
+        const std::vector<BoneData> &getBones() const {
             return _bones;
         }
         std::size_t getBoneCount() const;
 
-        const std::vector<ColorData *> &getColors() const {
+        const std::vector<ColorData> &getColors() const {
             return _colors;
         }
         std::size_t getColorCount() const;
@@ -79,6 +83,10 @@ public:
         }
         std::size_t getSegmentCount() const;
 
+        // offset of the frame in the vertex and index arenas of its animation.
+        std::size_t getVertexFloatOffset() const { return _vertexFloatOffset; }
+        std::size_t getIndexOffset() const { return _indexOffset; }
+
     private:
         // if segment data is empty, it will build new one.
         SegmentData *buildSegmentData(std::size_t index);
@@ -86,18 +94,18 @@ public:
         ColorData *buildColorData(std::size_t index);
         // if bone data is empty, it will build new one.
         BoneData *buildBoneData(std::size_t index);
+        std::size_t getMemorySize() const;
 
-        std::vector<BoneData *>    _bones;
-        std::vector<ColorData *>   _colors;
+        std::vector<BoneData>      _bones;
+        std::vector<ColorData>     _colors;
         std::vector<SegmentData *> _segments;
-
-    public:
-        cc::middleware::IOBuffer ib;
-        cc::middleware::IOBuffer vb;
+        std::size_t                _vertexFloatOffset = 0;
+        std::size_t                _indexOffset       = 0;
     };
 
     struct AnimationData {
         friend class ArmatureCache;
+        friend class ArmatureCacheMgr;
 
         AnimationData();
         ~AnimationData();
@@ -109,14 +117,28 @@ public:
         bool isComplete() const { return _isComplete; }
         bool needUpdate(int toFrameIdx) const;
 
+        // vertices and indices of all baked frames, a frame starts at its own offsets.
+        const float *   getVertices() const { return _vertices.data(); }
+        const uint16_t *getIndices() const { return _indices.data(); }
+
+        // stamps the data as used in the current engine frame, least recently used data is evicted first.
+        void        markUsed();
+        std::size_t getMemorySize() const;
+
     private:
         // if frame is empty, it will build new one.
         FrameData *buildFrameData(std::size_t frameIdx);
-    
+        // releases the spare capacity once every frame is baked.
+        void shrinkToFit();
+
         std::string _animationName;
         bool _isComplete = false;
         float _totalTime = 0.0F;
         std::vector<FrameData *> _frames;
+        std::vector<float> _vertices;
+        std::vector<uint16_t> _indices;
+        std::size_t _frameMemorySize = 0;
+        uint32_t _lastUsedFrame = 0;
     };
 
     ArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID);
@@ -130,9 +152,13 @@ public:
 
     void resetAllAnimationData();
     void resetAnimationData(const std::string &animationName);
+    // sum of the baked frame data of all animations.
+    std::size_t getMemorySize() const;
 
 private:
     void renderAnimationFrame(AnimationData *animationData);
+    // drops the baked frames, they are baked again when the animation is played.
+    void evictAnimationData(AnimationData *animationData);
     void traverseArmature(Armature *armature, float parentOpacity = 1.0F);
 
 public:
@@ -140,6 +166,7 @@ public:
     static float MaxCacheTime; // NOLINT
 
 private:
+    AnimationData *_animationData = nullptr;
     FrameData *_frameData = nullptr;
     cc::middleware::Color4F _preColor = cc::middleware::Color4F(-1.0F, -1.0F, -1.0F, -1.0F);
     cc::middleware::Color4F _color = cc::middleware::Color4F(1.0F, 1.0F, 1.0F, 1.0F);
@@ -22,6 +22,8 @@
  */
 
 #include "ArmatureCacheMgr.h"
+#include <algorithm>
+#include "application/ApplicationManager.h"
 #include "base/DeferredReleasePool.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
@@ -49,4 +51,45 @@ void ArmatureCacheMgr::removeArmatureCache(const std::string &armatureKey) {
     }
 }
 
+void ArmatureCacheMgr::setMemoryBudget(uint32_t bytes) {
+    _memoryBudget = bytes;
+    trimToBudget();
+}
+
+std::size_t ArmatureCacheMgr::getMemoryUsage() const {
+    std::size_t size = 0;
+    for (const auto &cache : _caches) {
+        size += cache.second->getMemorySize();
+    }
+    return size;
+}
+
+void ArmatureCacheMgr::trimToBudget() {
+    if (_memoryBudget == 0) return;
+    std::size_t usage = getMemoryUsage();
+    if (usage <= _memoryBudget) return;
+
+    using Candidate = std::pair<ArmatureCache *, ArmatureCache::AnimationData *>;
+    std::vector<Candidate> candidates;
+    auto                   curFrame = CC_CURRENT_ENGINE()->getTotalFrames();
+    for (const auto &cache : _caches) {
+        for (const auto &animationCache : cache.second->_animationCaches) {
+            auto *animationData = animationCache.second;
+            // data in use this frame would only be baked again right away
+            if (!animationData->_frames.empty() && animationData->_lastUsedFrame != curFrame) {
+                candidates.emplace_back(cache.second, animationData);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.second->_lastUsedFrame < b.second->_lastUsedFrame;
+    });
+
+    for (const auto &candidate : candidates) {
+        if (usage <= _memoryBudget) break;
+        usage -= candidate.second->getMemorySize();
+        candidate.first->evictAnimationData(candidate.second);
+    }
+}
+
 DRAGONBONES_NAMESPACE_END
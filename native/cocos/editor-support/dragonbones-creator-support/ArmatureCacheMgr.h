@@ -48,9 +48,17 @@ public:
     void removeArmatureCache(const std::string &armatureKey);
     ArmatureCache *buildArmatureCache(const std::string &armatureName, const std::string &armatureKey, const std::string &atlasUUID);
 
+    // bytes of baked frame data kept across all caches, 0 means unlimited.
+    void setMemoryBudget(uint32_t bytes);
+    uint32_t getMemoryBudget() const { return _memoryBudget; }
+    std::size_t getMemoryUsage() const;
+    // evicts least recently used animation data not used in the current frame until under budget.
+    void trimToBudget();
+
 private:
     static ArmatureCacheMgr *_instance;
     cc::RefMap<std::string, ArmatureCache *> _caches;
+    uint32_t _memoryBudget = 0;
 };
 
 DRAGONBONES_NAMESPACE_END
@@ -138,6 +138,7 @@ void CCArmatureCacheDisplay::update(float dt) {
 
 void CCArmatureCacheDisplay::render(float /*dt*/) {
     if (!_animationData) return;
+    _animationData->markUsed();
     ArmatureCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
     if (!frameData) return;
 
@@ -168,7 +169,11 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
     // write border
     renderInfo->writeUint32(0xffffffff);
 
-    // matieral len
+    // matieral len, nothing is drawn when culled
+    if (_culled && !_alwaysUpdate) {
+        renderInfo->writeUint32(0);
+        return;
+    }
     renderInfo->writeUint32(segments.size());
 
     if (segments.empty() || colors.empty()) return;
@@ -176,14 +181,14 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
     middleware::MeshBuffer *mb    = mgr->getMeshBuffer(VF_XYZUVC);
     middleware::IOBuffer &  vb    = mb->getVB();
     middleware::IOBuffer &  ib    = mb->getIB();
-    const auto &            srcVB = frameData->vb;
-    const auto &            srcIB = frameData->ib;
+    const auto *            srcVB = _animationData->getVertices() + frameData->getVertexFloatOffset();
+    const auto *            srcIB = _animationData->getIndices() + frameData->getIndexOffset();
 
     auto *          paramsBuffer = _paramsBuffer->getBuffer();
     const cc::Mat4 &nodeWorldMat = *reinterpret_cast<cc::Mat4 *>(&paramsBuffer[4]);
 
     int                       colorOffset = 0;
-    ArmatureCache::ColorData *nowColor    = colors[colorOffset++];
+    const auto *              nowColor    = &colors[colorOffset++];
     auto                      maxVFOffset = nowColor->vertexFloatOffset;
 
     Color4F color;
@@ -216,7 +221,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         needColor = true;
     }
 
-    auto handleColor = [&](ArmatureCache::ColorData *colorData) {
+    auto handleColor = [&](const ArmatureCache::ColorData *colorData) {
         tempA      = colorData->color.a * _nodeColor.a;
         multiplier = _premultipliedAlpha ? tempA / 255.0f : 1.0f;
         tempR      = _nodeColor.r * multiplier;
@@ -269,7 +274,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         dstVertexOffset = vb.getCurPos() / sizeof(V2F_T2F_C4F);
         dstVertexBuffer = reinterpret_cast<float *>(vb.getCurBuffer());
         dstColorBuffer  = reinterpret_cast<unsigned int *>(vb.getCurBuffer());
-        vb.writeBytes(reinterpret_cast<char *>(srcVB.getBuffer()) + srcVertexBytesOffset, vertexBytes);
+        vb.writeBytes(reinterpret_cast<const char *>(srcVB) + srcVertexBytesOffset, vertexBytes);
 
         // batch handle
         if (_batch) {
@@ -288,7 +293,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
             auto frameFloatOffset = srcVertexBytesOffset / sizeof(float);
             for (auto colorIndex = 0; colorIndex < segment->vertexFloatCount; colorIndex += VF_XYZUVC, frameFloatOffset += VF_XYZUVC) {
                 if (frameFloatOffset >= maxVFOffset) {
-                    nowColor = colors[colorOffset++];
+                    nowColor = &colors[colorOffset++];
                     handleColor(nowColor);
                     maxVFOffset = nowColor->vertexFloatOffset;
                 }
@@ -304,7 +309,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         ib.checkSpace(indexBytes, true);
         dstIndexOffset = static_cast<int>(ib.getCurPos()) / sizeof(uint16_t);
         dstIndexBuffer = reinterpret_cast<uint16_t *>(ib.getCurBuffer());
-        ib.writeBytes(reinterpret_cast<char *>(srcIB.getBuffer()) + srcIndexBytesOffset, indexBytes);
+        ib.writeBytes(reinterpret_cast<const char *>(srcIB) + srcIndexBytesOffset, indexBytes);
         for (auto indexPos = 0; indexPos < segment->indexCount; indexPos++) {
             dstIndexBuffer[indexPos] += dstVertexOffset;
         }
@@ -325,7 +330,7 @@ void CCArmatureCacheDisplay::render(float /*dt*/) {
         auto        boneCount = frameData->getBoneCount();
 
         for (int i = 0; i < boneCount; i++) {
-            auto *bone = bonesData[i];
+            const auto *bone = &bonesData[i];
             attachInfo->checkSpace(sizeof(cc::Mat4), true);
             attachInfo->writeBytes(reinterpret_cast<const char *>(&bone->globalTransformMatrix), sizeof(cc::Mat4));
         }
@@ -413,6 +418,22 @@ void CCArmatureCacheDisplay::setAttachEnabled(bool enabled) {
     _useAttach = enabled;
 }
 
+void CCArmatureCacheDisplay::setCulled(bool culled) {
+    _culled = culled;
+}
+
+bool CCArmatureCacheDisplay::isCulled() const {
+    return _culled;
+}
+
+void CCArmatureCacheDisplay::setAlwaysUpdate(bool enabled) {
+    _alwaysUpdate = enabled;
+}
+
+bool CCArmatureCacheDisplay::isAlwaysUpdate() const {
+    return _alwaysUpdate;
+}
+
 se_object_ptr CCArmatureCacheDisplay::getSharedBufferOffset() const {
     if (_sharedBufferOffset) {
         return _sharedBufferOffset->getTypeArray();
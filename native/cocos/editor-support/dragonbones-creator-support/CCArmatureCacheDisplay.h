@@ -64,6 +64,11 @@ public:
         // _batch = enabled;
     }
     void setAttachEnabled(bool enabled);
+    // set from script with the culling result of the last frame, a culled armature writes no render data unless always update is enabled
+    void setCulled(bool culled);
+    bool isCulled() const;
+    void setAlwaysUpdate(bool enabled);
+    bool isAlwaysUpdate() const;
 
     void setOpacityModifyRGB(bool value) {
         _premultipliedAlpha = value;
@@ -107,9 +112,11 @@ private:
 
     bool                    _useAttach = false;
     bool                    _batch     = true;
+    bool                    _culled    = false;
     cc::middleware::Color4F _nodeColor = cc::middleware::Color4F::WHITE;
 
     bool            _premultipliedAlpha = false;
+    bool            _alwaysUpdate       = false;
     dbEventCallback _dbEventCallback    = nullptr;
     ArmatureCache * _armatureCache      = nullptr;
     EventObject *   _eventObject;
@@ -134,6 +134,11 @@ void CCArmatureDisplay::dbRender() {
         return;
     }
 
+    // off-screen, skip vertex generation
+    if (_culled && !_alwaysUpdate) {
+        return;
+    }
+
     _preBlendMode    = -1;
     _preTextureIndex = -1;
     _curTextureIndex = -1;
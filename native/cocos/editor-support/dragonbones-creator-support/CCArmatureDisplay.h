@@ -153,6 +153,23 @@ public:
         _useAttach = enabled;
     }
 
+    // set from script with the culling result of the last frame, a culled armature writes no render data unless always update is enabled
+    void setCulled(bool culled) {
+        _culled = culled;
+    }
+
+    bool isCulled() const {
+        return _culled;
+    }
+
+    void setAlwaysUpdate(bool enabled) {
+        _alwaysUpdate = enabled;
+    }
+
+    bool isAlwaysUpdate() const {
+        return _alwaysUpdate;
+    }
+
     void setOpacityModifyRGB(bool value) {
         _premultipliedAlpha = value;
     }
@@ -186,6 +203,8 @@ private:
     bool _batch              = true;
     bool _useAttach          = false;
     bool _premultipliedAlpha = false;
+    bool _culled             = false;
+    bool _alwaysUpdate       = false;
 
     // NOTE: We bind Vec2 to make JS deserialization works, we need to return const reference in convertToRootSpace method,
     // because returning Vec2 JSB object on stack to JS will let JS get mess data.
@@ -126,11 +126,26 @@ void SkeletonAnimation::update(float deltaTime) {
         deltaTime *= _timeScale * GlobalTimeScale;
         if (_ownsSkeleton) _skeleton->update(deltaTime);
         _state->update(deltaTime);
+        // the pose is applied again once the skeleton comes back into view
+        if (_culled && !_alwaysUpdate) return;
         _state->apply(*_skeleton);
         _skeleton->updateWorldTransform();
     }
 }
 
+void SkeletonAnimation::updateParallel(float deltaTime) {
+    if (!_state) return;
+    // the listeners call into script, keep the events queued until flushParallelUpdate
+    _state->disableQueue();
+    update(deltaTime);
+}
+
+void SkeletonAnimation::flushParallelUpdate() {
+    if (!_state) return;
+    _state->enableQueue();
+    _state->drainQueue();
+}
+
 void SkeletonAnimation::setAnimationStateData(AnimationStateData *stateData) {
     CCASSERT(stateData, "stateData cannot be null.");
 
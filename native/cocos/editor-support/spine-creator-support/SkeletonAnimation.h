@@ -51,6 +51,10 @@ public:
     static void setGlobalTimeScale(float timeScale);
 
     virtual void update(float deltaTime) override;
+    // a skeleton shared with other renderers can't be posed concurrently
+    bool isParallelUpdateSupported() const override { return _ownsSkeleton; }
+    void updateParallel(float deltaTime) override;
+    void flushParallelUpdate() override;
 
     void setAnimationStateData(AnimationStateData *stateData);
     void setMix(const std::string &fromAnimation, const std::string &toAnimation, float duration);
@@ -28,8 +28,11 @@
  *****************************************************************************/
 
 #include "SkeletonCache.h"
+#include "SkeletonCacheMgr.h"
+#include "application/ApplicationManager.h"
 #include "spine-creator-support/AttachmentVertices.h"
 #include "base/memory/Memory.h"
+#include "base/memory/MemoryAccounting.h"
 
 USING_NS_MW;        // NOLINT(google-build-using-namespace)
 using namespace cc; // NOLINT(google-build-using-namespace)
@@ -72,6 +75,19 @@ SkeletonCache::FrameData::~FrameData() {
         delete segment;
     }
     _segments.clear();
+
+    CC_MEMORY_ACCOUNT_FREE(SPINE, _accountedSize);
+}
+
+void SkeletonCache::FrameData::updateMemoryAccounting() {
+    std::size_t size = vb.getCapacity() + ib.getCapacity();
+    size += _bones.size() * sizeof(BoneData) + _colors.size() * sizeof(ColorData) + _segments.size() * sizeof(SegmentData);
+    if (size > _accountedSize) {
+        CC_MEMORY_ACCOUNT_ALLOC(SPINE, size - _accountedSize);
+    } else {
+        CC_MEMORY_ACCOUNT_FREE(SPINE, _accountedSize - size);
+    }
+    _accountedSize = size;
 }
 
 SkeletonCache::BoneData *SkeletonCache::FrameData::buildBoneData(std::size_t index) {
@@ -126,6 +142,11 @@ void SkeletonCache::AnimationData::reset() {
     _frames.clear();
     _isComplete = false;
     _totalTime  = 0.0F;
+    _memorySize = 0;
+}
+
+void SkeletonCache::AnimationData::markUsed() {
+    _lastUsedFrame = CC_CURRENT_ENGINE()->getTotalFrames();
 }
 
 bool SkeletonCache::AnimationData::needUpdate(int toFrameIdx) const {
@@ -205,6 +226,7 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
     if (!animationData || !animationData->needUpdate(toFrameIdx)) {
         return;
     }
+    animationData->markUsed();
 
     if (_curAnimationName != animationName) {
         updateToFrame(_curAnimationName);
@@ -221,6 +243,8 @@ void SkeletonCache::updateToFrame(const std::string &animationName, int toFrameI
         renderAnimationFrame(animationData);
         animationData->_totalTime += FrameTime;
     } while (animationData->needUpdate(toFrameIdx));
+
+    SkeletonCacheMgr::getInstance()->trimToBudget();
 }
 
 void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
@@ -526,6 +550,9 @@ void SkeletonCache::renderAnimationFrame(AnimationData *animationData) {
         ColorData *preColorData         = frameData->buildColorData(colorCount - 1);
         preColorData->vertexFloatOffset = static_cast<int>(vb.getCurPos() / sizeof(float));
     }
+
+    frameData->updateMemoryAccounting();
+    animationData->_memorySize += frameData->_accountedSize;
 }
 
 void SkeletonCache::onAnimationStateEvent(TrackEntry *entry, EventType type, Event *event) {
@@ -548,6 +575,22 @@ void SkeletonCache::resetAllAnimationData() {
     }
 }
 
+std::size_t SkeletonCache::getMemorySize() const {
+    std::size_t size = 0;
+    for (const auto &animationCache : _animationCaches) {
+        size += animationCache.second->_memorySize;
+    }
+    return size;
+}
+
+void SkeletonCache::evictAnimationData(AnimationData *animationData) {
+    animationData->reset();
+    // the skeleton state no longer matches the baked frames, start over on next play.
+    if (animationData->_animationName == _curAnimationName) {
+        _curAnimationName = "";
+    }
+}
+
 void SkeletonCache::resetAnimationData(const std::string &animationName) {
     for (auto &animationCache : _animationCaches) {
         if (animationCache.second->_animationName == animationName) {
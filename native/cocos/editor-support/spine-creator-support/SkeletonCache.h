@@ -35,7 +35,11 @@
 #include <vector>
 
 namespace spine {
+class SkeletonCacheMgr;
+
 class SkeletonCache : public SkeletonAnimation {
+    friend class SkeletonCacheMgr;
+
 public:
     struct SegmentData {
         friend class SkeletonCache;
@@ -93,10 +97,13 @@ public:
         ColorData *buildColorData(std::size_t index);
         // if bone data is empty, it will build new one.
         BoneData *buildBoneData(std::size_t index);
+        // reports the memory held by the frame to MemoryAccounting.
+        void updateMemoryAccounting();
 
         std::vector<BoneData *> _bones;
         std::vector<ColorData *> _colors;
         std::vector<SegmentData *> _segments;
+        std::size_t _accountedSize = 0;
 
     public:
         cc::middleware::IOBuffer ib;
@@ -105,6 +112,7 @@ public:
 
     struct AnimationData {
         friend class SkeletonCache;
+        friend class SkeletonCacheMgr;
 
         AnimationData();
         ~AnimationData();
@@ -116,6 +124,10 @@ public:
         bool isComplete() const { return _isComplete; }
         bool needUpdate(int toFrameIdx) const;
 
+        // stamps the data as used in the current engine frame, least recently used data is evicted first.
+        void markUsed();
+        std::size_t getMemorySize() const { return _memorySize; }
+
     private:
         // if frame is empty, it will build new one.
         FrameData *buildFrameData(std::size_t frameIdx);
@@ -125,6 +137,8 @@ public:
         bool _isComplete = false;
         float _totalTime = 0.0f;
         std::vector<FrameData *> _frames;
+        std::size_t _memorySize = 0;
+        uint32_t _lastUsedFrame = 0;
     };
 
     SkeletonCache();
@@ -142,9 +156,13 @@ public:
     AnimationData *getAnimationData(const std::string &animationName);
     void resetAllAnimationData();
     void resetAnimationData(const std::string &animationName);
+    // sum of the baked frame data of all animations.
+    std::size_t getMemorySize() const;
 
 private:
     void renderAnimationFrame(AnimationData *animationData);
+    // drops the baked frames, they are baked again when the animation is played.
+    void evictAnimationData(AnimationData *animationData);
 
 public:
     static float FrameTime;
@@ -158,6 +158,7 @@ void SkeletonCacheAnimation::update(float dt) {
 
 void SkeletonCacheAnimation::render(float /*dt*/) {
     if (!_animationData) return;
+    _animationData->markUsed();
     SkeletonCache::FrameData *frameData = _animationData->getFrameData(_curFrameIndex);
     if (!frameData) return;
 
@@ -189,7 +190,11 @@ void SkeletonCacheAnimation::render(float /*dt*/) {
     // write border
     renderInfo->writeUint32(0xffffffff);
 
-    // material len
+    // material len, nothing is drawn when culled
+    if (_culled && !_alwaysUpdate) {
+        renderInfo->writeUint32(0);
+        return;
+    }
     renderInfo->writeUint32(segments.size());
 
     auto                    vertexFormat = _useTint ? VF_XYZUVCC : VF_XYZUVC;
@@ -498,6 +503,22 @@ void SkeletonCacheAnimation::setAttachEnabled(bool enabled) {
     _useAttach = enabled;
 }
 
+void SkeletonCacheAnimation::setCulled(bool culled) {
+    _culled = culled;
+}
+
+bool SkeletonCacheAnimation::isCulled() const {
+    return _culled;
+}
+
+void SkeletonCacheAnimation::setAlwaysUpdate(bool enabled) {
+    _alwaysUpdate = enabled;
+}
+
+bool SkeletonCacheAnimation::isAlwaysUpdate() const {
+    return _alwaysUpdate;
+}
+
 void SkeletonCacheAnimation::setAnimation(const std::string &name, bool loop) {
     _playTimes     = loop ? 0 : 1;
     _animationName = name;
@@ -65,6 +65,11 @@ public:
     void        setColor(float r, float g, float b, float a);
     void        setBatchEnabled(bool enabled);
     void        setAttachEnabled(bool enabled);
+    // set from script with the culling result of the last frame, a culled animation writes no render data unless always update is enabled
+    void        setCulled(bool culled);
+    bool        isCulled() const;
+    void        setAlwaysUpdate(bool enabled);
+    bool        isAlwaysUpdate() const;
 
     void setOpacityModifyRGB(bool value);
     bool isOpacityModifyRGB() const;
@@ -106,6 +111,8 @@ private:
     bool                    _paused             = false;
     bool                    _useAttach          = false;
     bool                    _batch              = true;
+    bool                    _culled             = false;
+    bool                    _alwaysUpdate       = false;
     cc::middleware::Color4F _nodeColor          = cc::middleware::Color4F::WHITE;
     bool                    _premultipliedAlpha = false;
 
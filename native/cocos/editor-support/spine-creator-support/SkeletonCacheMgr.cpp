@@ -28,6 +28,8 @@
  *****************************************************************************/
 
 #include "SkeletonCacheMgr.h"
+#include <algorithm>
+#include "application/ApplicationManager.h"
 #include "base/DeferredReleasePool.h"
 
 namespace spine {
@@ -50,4 +52,45 @@ void SkeletonCacheMgr::removeSkeletonCache(const std::string &uuid) {
         _caches.erase(it);
     }
 }
+
+void SkeletonCacheMgr::setMemoryBudget(uint32_t bytes) {
+    _memoryBudget = bytes;
+    trimToBudget();
+}
+
+std::size_t SkeletonCacheMgr::getMemoryUsage() const {
+    std::size_t size = 0;
+    for (const auto &cache : _caches) {
+        size += cache.second->getMemorySize();
+    }
+    return size;
+}
+
+void SkeletonCacheMgr::trimToBudget() {
+    if (_memoryBudget == 0) return;
+    std::size_t usage = getMemoryUsage();
+    if (usage <= _memoryBudget) return;
+
+    using Candidate = std::pair<SkeletonCache *, SkeletonCache::AnimationData *>;
+    std::vector<Candidate> candidates;
+    auto                   curFrame = CC_CURRENT_ENGINE()->getTotalFrames();
+    for (const auto &cache : _caches) {
+        for (const auto &animationCache : cache.second->_animationCaches) {
+            auto *animationData = animationCache.second;
+            // data in use this frame would only be baked again right away
+            if (animationData->_memorySize > 0 && animationData->_lastUsedFrame != curFrame) {
+                candidates.emplace_back(cache.second, animationData);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.second->_lastUsedFrame < b.second->_lastUsedFrame;
+    });
+
+    for (const auto &candidate : candidates) {
+        if (usage <= _memoryBudget) break;
+        usage -= candidate.second->_memorySize;
+        candidate.first->evictAnimationData(candidate.second);
+    }
+}
 } // namespace spine
@@ -52,9 +52,17 @@ public:
     void removeSkeletonCache(const std::string &uuid);
     SkeletonCache *buildSkeletonCache(const std::string &uuid);
 
+    // bytes of baked frame data kept across all caches, 0 means unlimited.
+    void setMemoryBudget(uint32_t bytes);
+    uint32_t getMemoryBudget() const { return _memoryBudget; }
+    std::size_t getMemoryUsage() const;
+    // evicts least recently used animation data not used in the current frame until under budget.
+    void trimToBudget();
+
 private:
     static SkeletonCacheMgr *instance;
     cc::RefMap<std::string, SkeletonCache *> _caches;
+    uint32_t _memoryBudget = 0;
 };
 
 } // namespace spine
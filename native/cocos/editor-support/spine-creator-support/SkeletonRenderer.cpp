@@ -292,8 +292,8 @@ void SkeletonRenderer::render(float /*deltaTime*/) {
     //reserved space to save material len
     renderInfo->writeUint32(0);
 
-    // If opacity is 0,then return.
-    if (_skeleton->getColor().a == 0) {
+    // If opacity is 0 or culled,then return.
+    if (_skeleton->getColor().a == 0 || (_culled && !_alwaysUpdate)) {
         return;
     }
 
@@ -1061,6 +1061,22 @@ void SkeletonRenderer::setColor(float r, float g, float b, float a) {
     _nodeColor.a = a / 255.0F;
 }
 
+void SkeletonRenderer::setCulled(bool culled) {
+    _culled = culled;
+}
+
+bool SkeletonRenderer::isCulled() const {
+    return _culled;
+}
+
+void SkeletonRenderer::setAlwaysUpdate(bool enabled) {
+    _alwaysUpdate = enabled;
+}
+
+bool SkeletonRenderer::isAlwaysUpdate() const {
+    return _alwaysUpdate;
+}
+
 void SkeletonRenderer::setBatchEnabled(bool enabled) {
     // disable switch batch mode, force to enable batch, it may be changed in future version
     // _batch = enabled;
@@ -120,6 +120,12 @@ public:
     void setDebugSlotsEnabled(bool enabled);
     void setDebugMeshEnabled(bool enabled);
     void setAttachEnabled(bool enabled);
+    /* Set from script with the culling result of the last frame. A culled skeleton writes no render data and only advances its animation time,
+         * unless always update is enabled for skeletons which drive gameplay through events or attached nodes. */
+    void setCulled(bool culled);
+    bool isCulled() const;
+    void setAlwaysUpdate(bool enabled);
+    bool isAlwaysUpdate() const;
 
     void setOpacityModifyRGB(bool value);
     bool isOpacityModifyRGB() const;
@@ -168,6 +174,8 @@ protected:
     bool                    _premultipliedAlpha = false;
     SkeletonClipping *      _clipper            = nullptr;
     bool                    _useTint            = false;
+    bool                    _culled             = false;
+    bool                    _alwaysUpdate       = false;
     std::string             _uuid;
 
     int _startSlotIndex = -1;
@@ -34,6 +34,9 @@
 
 namespace cc {
 
+class Benchmark;
+struct BenchmarkInfo;
+
 class CC_DLL BaseEngine : public CallbacksInvoker,
                           public std::enable_shared_from_this<BaseEngine> {
 public:
@@ -93,6 +96,26 @@ public:
      * @param fps The preferred frame rate for main loop callback.
      */
     virtual void setPreferredFramesPerSecond(int fps) = 0;
+    /**
+     * @brief Lowers the frame rate once nothing happened for a while to save power.
+     * @param fps The frame rate used while idle, 0 disables the idle mode.
+     * @param timeout Seconds without input or activity before the idle frame rate applies.
+     */
+    virtual void setIdleFramesPerSecond(int fps, float timeout) = 0;
+    /**
+     * @brief Marks the engine as active and leaves the idle frame rate right away.
+     * Input events do this already, animations should call it on every frame they play.
+     */
+    virtual void notifyActivity() = 0;
+    /**
+     * @brief Runs a benchmark, must be called before scripts create the gfx device.
+     * @param info The benchmark to run, see BenchmarkInfo.
+     */
+    virtual void setBenchmark(const BenchmarkInfo &info) = 0;
+    /**
+     @brief Gets the running benchmark, nullptr if none.
+     */
+    virtual Benchmark *getBenchmark() const = 0;
 
     using EventCb = std::function<void(const OSEvent &)>;
     /**
@@ -0,0 +1,451 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "engine/Benchmark.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "application/ApplicationManager.h"
+#include "base/Log.h"
+#include "base/StringUtil.h"
+#include "base/memory/MemoryAccounting.h"
+#include "core/Root.h"
+#include "core/scene-graph/Node.h"
+#include "platform/FileUtils.h"
+#include "platform/interfaces/modules/ISystemWindow.h"
+#include "profiler/StartupTimer.h"
+#include "renderer/GFXDeviceManager.h"
+#include "renderer/gfx-agent/CommandReplayer.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/pipeline/RenderPipeline.h"
+#include "rapidjson/document.h"
+#include "scene/Camera.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+
+namespace {
+
+ccstd::string getFullPath(const ccstd::string &path) {
+    auto *fileUtils = FileUtils::getInstance();
+    return fileUtils->isAbsolutePath(path) ? path : fileUtils->getWritablePath() + path;
+}
+
+template <typename T, size_t N>
+bool parseName(const char *name, const char *const (&names)[N], T *outValue) {
+    for (size_t i = 0; i < N; ++i) {
+        if (strcmp(name, names[i]) == 0) {
+            *outValue = static_cast<T>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *const TOUCH_TYPES[] = {"began", "moved", "ended", "cancelled"};
+const char *const MOUSE_TYPES[] = {"down", "up", "move", "wheel"};
+const char *const KEY_ACTIONS[] = {"press", "release", "repeat"};
+
+// more than any device reports at once
+constexpr size_t MAX_TOUCHES_PER_KEY = 10;
+
+float percentile(ccstd::vector<float> values, float ratio) {
+    if (values.empty()) {
+        return 0.F;
+    }
+    const auto index = std::min(values.size() - 1, static_cast<size_t>(ratio * static_cast<float>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+} // namespace
+
+bool Benchmark::loadInfo(const ccstd::string &path, BenchmarkInfo *outInfo) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path)) {
+        return false;
+    }
+
+    rapidjson::Document doc;
+    doc.Parse(fileUtils->getStringFromFile(path).c_str());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        CC_LOG_ERROR("Benchmark: %s is not a JSON object", path.c_str());
+        return false;
+    }
+
+    const auto readString = [&doc](const char *name, ccstd::string *out) {
+        if (doc.HasMember(name) && doc[name].IsString()) {
+            *out = doc[name].GetString();
+        }
+    };
+    const auto readUint = [&doc](const char *name, uint32_t *out) {
+        if (doc.HasMember(name) && doc[name].IsUint()) {
+            *out = doc[name].GetUint();
+        }
+    };
+    readString("scene", &outInfo->scene);
+    readString("gfxBackend", &outInfo->gfxBackend);
+    readString("trackPath", &outInfo->trackPath);
+    readString("recordTrackPath", &outInfo->recordTrackPath);
+    readString("capturePath", &outInfo->capturePath);
+    readString("outputPath", &outInfo->outputPath);
+    readUint("frames", &outInfo->frames);
+    readUint("warmupFrames", &outInfo->warmupFrames);
+    readUint("framesPerSecond", &outInfo->framesPerSecond);
+    if (doc.HasMember("quitOnFinish") && doc["quitOnFinish"].IsBool()) {
+        outInfo->quitOnFinish = doc["quitOnFinish"].GetBool();
+    }
+
+    outInfo->enabled = true;
+    return true;
+}
+
+Benchmark::Benchmark(BenchmarkInfo info)
+: _info(std::move(info)) {
+    _info.framesPerSecond = std::max(_info.framesPerSecond, 1U);
+    if (!_info.trackPath.empty() && !loadTrack(_info.trackPath)) {
+        CC_LOG_ERROR("Benchmark: failed to load the track %s", _info.trackPath.c_str());
+    }
+    _frames.reserve(_info.frames);
+}
+
+Benchmark::~Benchmark() {
+    if (_replayer) {
+        _replayer->destroy();
+        _replayer.reset();
+    }
+    if (_swapchain) {
+        _swapchain->destroy();
+        CC_SAFE_DELETE(_swapchain);
+    }
+}
+
+bool Benchmark::loadTrack(const ccstd::string &path) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(path)) {
+        return false;
+    }
+
+    _track.clear();
+    _nextKey = 0;
+
+    const auto content = fileUtils->getStringFromFile(path);
+    size_t     begin   = 0;
+    while (begin < content.size()) {
+        auto end = content.find('\n', begin);
+        if (end == ccstd::string::npos) {
+            end = content.size();
+        }
+        ccstd::string line = content.substr(begin, end - begin);
+        begin              = end + 1;
+
+        const auto comment = line.find('#');
+        if (comment != ccstd::string::npos) {
+            line.resize(comment);
+        }
+        uint32_t frame  = 0;
+        int      offset = 0;
+        if (sscanf(line.c_str(), "%u %n", &frame, &offset) != 1) {
+            continue;
+        }
+        _track.push_back({frame, line.substr(offset)});
+    }
+
+    // keys of the same frame keep their order
+    std::stable_sort(_track.begin(), _track.end(), [](const Key &lhs, const Key &rhs) { return lhs.frame < rhs.frame; });
+    return true;
+}
+
+void Benchmark::start() {
+    if (_started) {
+        return;
+    }
+    _started = true;
+    _frame   = 0;
+    if (isReplayingCapture() && !startReplay()) {
+        _finished = true;
+        return;
+    }
+    CC_LOG_INFO("Benchmark: started, %u frames at %u fps after %u warmup frames", _info.frames, _info.framesPerSecond, _info.warmupFrames);
+}
+
+void Benchmark::onFrameBegin(const EventDispatch &dispatch) {
+    if (!_started || _finished) {
+        return;
+    }
+    // captures replay during the warmup too, their first frames fill the caches of the driver
+    if (_replayer && _replayer->replayFrame() < 0.F) {
+        CC_LOG_ERROR("Benchmark: the capture %s is corrupted", _info.capturePath.c_str());
+        _finished = true;
+        return;
+    }
+    if (_frame < _info.warmupFrames) {
+        return;
+    }
+
+    const uint32_t frame = _frame - _info.warmupFrames;
+    if (isRecording()) {
+        recordCamera(frame);
+        return;
+    }
+    while (_nextKey < _track.size() && _track[_nextKey].frame <= frame) {
+        replay(_track[_nextKey++], dispatch);
+    }
+}
+
+void Benchmark::onFrameEnd(std::chrono::steady_clock::duration cpuTime) {
+    if (!_started || _finished) {
+        return;
+    }
+    if (_frame++ < _info.warmupFrames) {
+        return;
+    }
+
+    Frame sample;
+    sample.frame   = _frame - _info.warmupFrames - 1;
+    sample.cpuTime = static_cast<float>(std::chrono::duration_cast<std::chrono::nanoseconds>(cpuTime).count()) / 1e6F;
+
+    auto *device   = gfx::Device::getInstance();
+    auto *pipeline = pipeline::RenderPipeline::getInstance();
+    if (pipeline && pipeline->isGPUTimingEnabled()) {
+        sample.gpuTime = pipeline->getGPUTimer().getFrameTime();
+    } else if (pipeline && device && pipeline::GPUTimer::isSupported(device)) {
+        // the pipeline may not exist yet when the benchmark starts
+        pipeline->setGPUTimingEnabled(true);
+    }
+    if (device) {
+        sample.drawCalls = device->getNumDrawCalls();
+        sample.instances = device->getNumInstances();
+        sample.triangles = device->getNumTris();
+    }
+    const auto &memory  = MemoryAccounting::getInstance();
+    sample.memory       = memory.getUsage(MemoryTag::TOTAL).current;
+    sample.scriptMemory = memory.getUsage(MemoryTag::SCRIPT).current;
+    _frames.push_back(sample);
+
+    if (_frames.size() >= _info.frames) {
+        _finished = true;
+        if (isRecording()) {
+            writeFile(_info.recordTrackPath, _recorded);
+        }
+        if (!_info.outputPath.empty()) {
+            writeReport();
+        }
+    }
+}
+
+void Benchmark::record(const OSEvent &ev) {
+    if (!_started || _finished || _frame < _info.warmupFrames || !isRecording()) {
+        return;
+    }
+
+    const uint32_t frame = _frame - _info.warmupFrames;
+    switch (ev.eventType()) {
+        case OSEventType::TOUCH_OSEVENT: {
+            const auto &touch = OSEvent::castEvent<TouchEvent>(ev);
+            if (touch.type == TouchEvent::Type::UNKNOWN) {
+                break;
+            }
+            _recorded += StringUtil::format("%u touch %s", frame, TOUCH_TYPES[static_cast<uint32_t>(touch.type)]);
+            for (const auto &info : touch.touches) {
+                _recorded += StringUtil::format(" %d %g %g", info.index, info.x, info.y);
+            }
+            _recorded += '\n';
+            break;
+        }
+        case OSEventType::MOUSE_OSEVENT: {
+            const auto &mouse = OSEvent::castEvent<MouseEvent>(ev);
+            if (mouse.type != MouseEvent::Type::UNKNOWN) {
+                _recorded += StringUtil::format("%u mouse %s %u %g %g\n", frame, MOUSE_TYPES[static_cast<uint32_t>(mouse.type)], static_cast<uint32_t>(mouse.button), mouse.x, mouse.y);
+            }
+            break;
+        }
+        case OSEventType::KEYBOARD_OSEVENT: {
+            const auto &key = OSEvent::castEvent<KeyboardEvent>(ev);
+            if (key.action != KeyboardEvent::Action::UNKNOWN) {
+                _recorded += StringUtil::format("%u key %s %d\n", frame, KEY_ACTIONS[static_cast<uint32_t>(key.action)], key.key);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void Benchmark::recordCamera(uint32_t frame) {
+    auto *camera = findCamera();
+    if (!camera) {
+        return;
+    }
+    const auto &position = camera->getNode()->getWorldPosition();
+    const auto &rotation = camera->getNode()->getWorldRotation();
+    _recorded += StringUtil::format("%u camera %g %g %g %g %g %g %g\n", frame,
+                                    position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, rotation.w);
+}
+
+void Benchmark::replay(const Key &key, const EventDispatch &dispatch) {
+    char type[16]{};
+    char name[16]{};
+    int  offset = 0;
+    if (sscanf(key.line.c_str(), "%15s %n", type, &offset) != 1) {
+        return;
+    }
+    const char *args = key.line.c_str() + offset;
+
+    if (strcmp(type, "camera") == 0) {
+        Vec3       position;
+        Quaternion rotation;
+        if (sscanf(args, "%f %f %f %f %f %f %f", &position.x, &position.y, &position.z, &rotation.x, &rotation.y, &rotation.z, &rotation.w) != 7) {
+            return;
+        }
+        if (auto *camera = findCamera()) {
+            camera->getNode()->setWorldPosition(position);
+            camera->getNode()->setWorldRotation(rotation);
+        }
+    } else if (strcmp(type, "touch") == 0) {
+        TouchEvent ev;
+        if (sscanf(args, "%15s %n", name, &offset) != 1 || !parseName(name, TOUCH_TYPES, &ev.type)) {
+            return;
+        }
+        args += offset;
+        int   index = 0;
+        float x     = 0.F;
+        float y     = 0.F;
+        while (ev.touches.size() < MAX_TOUCHES_PER_KEY && sscanf(args, "%d %f %f %n", &index, &x, &y, &offset) == 3) {
+            ev.touches.emplace_back(x, y, index);
+            args += offset;
+        }
+        dispatch(ev);
+    } else if (strcmp(type, "mouse") == 0) {
+        MouseEvent ev;
+        uint32_t   button = 0;
+        if (sscanf(args, "%15s %u %f %f", name, &button, &ev.x, &ev.y) != 4 || !parseName(name, MOUSE_TYPES, &ev.type)) {
+            return;
+        }
+        ev.button = static_cast<uint16_t>(button);
+        dispatch(ev);
+    } else if (strcmp(type, "key") == 0) {
+        KeyboardEvent ev;
+        if (sscanf(args, "%15s %d", name, &ev.key) != 2 || !parseName(name, KEY_ACTIONS, &ev.action)) {
+            return;
+        }
+        dispatch(ev);
+    }
+}
+
+bool Benchmark::startReplay() {
+    // scripts don't run, so the device is created here the way the captured one was
+    gfx::DeviceInfo deviceInfo;
+    if (!gfx::CommandReplayer::loadDeviceInfo(_info.capturePath, &deviceInfo)) {
+        return false;
+    }
+    auto *device = gfx::Device::getInstance();
+    if (!device) {
+        device = gfx::DeviceManager::create(deviceInfo);
+    }
+    auto *window = CC_GET_PLATFORM_INTERFACE(ISystemWindow);
+    if (!device || !window) {
+        CC_LOG_ERROR("Benchmark: no device to replay %s on", _info.capturePath.c_str());
+        return false;
+    }
+
+    const auto         size = window->getViewSize();
+    gfx::SwapchainInfo swapchainInfo;
+    swapchainInfo.windowHandle = reinterpret_cast<void *>(window->getWindowHandler()); // NOLINT(performance-no-int-to-ptr)
+    swapchainInfo.width        = static_cast<uint32_t>(size.x);
+    swapchainInfo.height       = static_cast<uint32_t>(size.y);
+    _swapchain                 = device->createSwapchain(swapchainInfo);
+
+    _replayer = std::make_unique<gfx::CommandReplayer>(device);
+    if (!_replayer->load(_info.capturePath, _swapchain)) {
+        _replayer.reset();
+        return false;
+    }
+    CC_LOG_INFO("Benchmark: replaying %u captured frames of %s", _replayer->getFrameCount(), _info.capturePath.c_str());
+    return true;
+}
+
+scene::Camera *Benchmark::findCamera() {
+    auto *root = Root::getInstance();
+    if (!root) {
+        return nullptr;
+    }
+    for (const auto &scene : root->getScenes()) {
+        for (const auto &camera : scene->getCameras()) {
+            if (camera->isEnabled() && camera->getNode()) {
+                return camera.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+ccstd::string Benchmark::toJSON() const {
+    ccstd::vector<float> cpuTimes;
+    ccstd::vector<float> gpuTimes;
+    cpuTimes.reserve(_frames.size());
+    gpuTimes.reserve(_frames.size());
+    for (const auto &frame : _frames) {
+        cpuTimes.push_back(frame.cpuTime);
+        gpuTimes.push_back(frame.gpuTime);
+    }
+
+    const auto *device = gfx::Device::getInstance();
+    ccstd::string out;
+    out.reserve(128 * _frames.size() + 512);
+    out += StringUtil::format(R"({"gfx":"%s","renderer":"%s","scene":"%s","framesPerSecond":%u,"warmupFrames":%u,)",
+                              device ? device->getDeviceName().c_str() : "", device ? device->getRenderer().c_str() : "",
+                              _info.scene.c_str(), _info.framesPerSecond, _info.warmupFrames);
+    out += StringUtil::format(R"("summary":{"frames":%u,"cpuMedian":%.3f,"cpuP95":%.3f,"cpuMax":%.3f,"gpuMedian":%.3f,"gpuP95":%.3f},)",
+                              static_cast<uint32_t>(_frames.size()), percentile(cpuTimes, 0.5F), percentile(cpuTimes, 0.95F),
+                              percentile(cpuTimes, 1.F), percentile(gpuTimes, 0.5F), percentile(gpuTimes, 0.95F));
+    out += R"("startup":)" + StartupTimer::toJSON() + ",";
+    out += R"("frames":[)";
+    for (size_t i = 0; i < _frames.size(); ++i) {
+        const auto &frame = _frames[i];
+        out += StringUtil::format(R"(%s{"frame":%u,"cpu":%.3f,"gpu":%.3f,"drawCalls":%u,"instances":%u,"triangles":%u,"memory":%llu,"scriptMemory":%llu})",
+                                  i ? "," : "", frame.frame, frame.cpuTime, frame.gpuTime, frame.drawCalls, frame.instances, frame.triangles,
+                                  static_cast<unsigned long long>(frame.memory), static_cast<unsigned long long>(frame.scriptMemory)); // NOLINT(google-runtime-int)
+    }
+    out += "]}";
+    return out;
+}
+
+bool Benchmark::writeReport() const {
+    return writeFile(_info.outputPath, toJSON());
+}
+
+bool Benchmark::writeFile(const ccstd::string &path, const ccstd::string &content) {
+    const auto fullPath  = getFullPath(path);
+    const bool succeeded = FileUtils::getInstance()->writeStringToFile(content, fullPath);
+    if (succeeded) {
+        CC_LOG_INFO("Benchmark: written to %s", fullPath.c_str());
+    } else {
+        CC_LOG_ERROR("Benchmark: failed to write %s", fullPath.c_str());
+    }
+    return succeeded;
+}
+
+} // namespace cc
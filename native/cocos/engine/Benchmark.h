@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "bindings/event/EventDispatcher.h"
+
+namespace cc {
+
+namespace scene {
+class Camera;
+} // namespace scene
+
+namespace gfx {
+class CommandReplayer;
+class Swapchain;
+} // namespace gfx
+
+/**
+ * @en Configuration of a benchmark run. The engine steps with a fixed timestep and without the frame limiter or vsync,
+ * scripts load the scene and call jsb.startBenchmark() once it is ready, then the track is replayed and every frame is
+ * sampled into a JSON report.
+ * @zh 性能测试运行配置。引擎以固定时间步长运行，不限帧也不开启垂直同步；脚本负责加载场景，准备好后调用 jsb.startBenchmark()，
+ * 之后回放输入轨迹并将每帧数据采样写入 JSON 报告。
+ */
+struct BenchmarkInfo {
+    bool          enabled{false};
+    ccstd::string scene;           // handed to scripts through jsb.getBenchmarkInfo(), which load it
+    ccstd::string gfxBackend;      // "Vulkan", "Metal", "GLES3", "GLES2" or "Empty", the first available one if empty
+    ccstd::string trackPath;       // input and camera track to replay, nothing is replayed if empty
+    ccstd::string recordTrackPath; // records the input and the main camera into a track instead of replaying one
+    ccstd::string capturePath;     // gfx capture of DeviceAgent::startCapture() replayed every frame, scripts don't run then
+    ccstd::string outputPath;      // relative paths are under the writable path
+    uint32_t      frames{600};
+    uint32_t      warmupFrames{60}; // run after start, neither sampled nor replayed
+    uint32_t      framesPerSecond{60};
+    bool          quitOnFinish{true};
+};
+
+/**
+ * @en Runs a benchmark which replays a track of input and camera keys at the recorded frames, and reports the CPU time,
+ * GPU time, draw counts and memory of every frame.
+ * Track lines are `<frame> <type> <arguments>`, '#' starts a comment:
+ *   <frame> touch <began|moved|ended|cancelled> <id> <x> <y> [<id> <x> <y> ...]
+ *   <frame> mouse <down|up|move|wheel> <button> <x> <y>
+ *   <frame> key <press|release|repeat> <key code>
+ *   <frame> camera <px> <py> <pz> <qx> <qy> <qz> <qw>
+ * Camera keys move the node of the first enabled camera in world space before scripts update.
+ * @zh 运行性能测试：在录制时的帧回放输入与相机轨迹，并报告每帧的 CPU 耗时、GPU 耗时、绘制数量与内存。
+ */
+class CC_DLL Benchmark final {
+public:
+    struct Frame {
+        uint32_t frame{0};
+        float    cpuTime{0.F}; // milliseconds from the start of the tick to the end of it
+        float    gpuTime{0.F}; // milliseconds, lags a few frames behind as GPUTimer reads queries back late
+        uint32_t drawCalls{0};
+        uint32_t instances{0};
+        uint32_t triangles{0};
+        uint64_t memory{0}; // bytes of MemoryTag::TOTAL
+        uint64_t scriptMemory{0};
+    };
+
+    using EventDispatch = std::function<void(const OSEvent &)>;
+
+    // reads a JSON object with the fields of BenchmarkInfo, returns false if the file can't be read
+    static bool loadInfo(const ccstd::string &path, BenchmarkInfo *outInfo);
+
+    explicit Benchmark(BenchmarkInfo info);
+    ~Benchmark();
+
+    inline const BenchmarkInfo &       getInfo() const { return _info; }
+    inline float                       getTimestep() const { return 1.F / static_cast<float>(_info.framesPerSecond); }
+    inline bool                        isStarted() const { return _started; }
+    inline bool                        isFinished() const { return _finished; }
+    inline bool                        isRecording() const { return !_info.recordTrackPath.empty(); }
+    inline bool                        isReplayingCapture() const { return !_info.capturePath.empty(); }
+    inline const ccstd::vector<Frame> &getFrames() const { return _frames; }
+
+    // starts replaying and sampling from the next frame on
+    void start();
+
+    // track frames count from the first frame after the warmup, replays the keys of the frame
+    void onFrameBegin(const EventDispatch &dispatch);
+    void onFrameEnd(std::chrono::steady_clock::duration cpuTime);
+    // input handled by the engine while recording
+    void record(const OSEvent &ev);
+
+    bool          loadTrack(const ccstd::string &path);
+    ccstd::string toJSON() const;
+    bool          writeReport() const;
+
+private:
+    struct Key {
+        uint32_t      frame{0};
+        ccstd::string line;
+    };
+
+    static void           replay(const Key &key, const EventDispatch &dispatch);
+    static bool           writeFile(const ccstd::string &path, const ccstd::string &content);
+    static scene::Camera *findCamera();
+    void                  recordCamera(uint32_t frame);
+    bool                  startReplay();
+
+    BenchmarkInfo                         _info;
+    ccstd::vector<Key>                    _track;
+    ccstd::vector<Frame>                  _frames;
+    ccstd::string                         _recorded;
+    std::unique_ptr<gfx::CommandReplayer> _replayer;
+    gfx::Swapchain *                      _swapchain{nullptr};
+    size_t                                _nextKey{0};
+    uint32_t                              _frame{0}; // frames since start, warmup included
+    bool                                  _started{false};
+    bool                                  _finished{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(Benchmark)
+};
+
+} // namespace cc
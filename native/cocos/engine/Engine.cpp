@@ -24,18 +24,25 @@
 ****************************************************************************/
 
 #include "engine/Engine.h"
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <sstream>
+#include <thread>
 #include "base/DeferredReleasePool.h"
 #include "base/Macros.h"
+#include "base/job-system/JobScheduler.h"
+#include "base/threading/ThreadAffinity.h"
 #include "cocos/bindings/jswrapper/SeApi.h"
 #include "cocos/core/builtin/BuiltinResMgr.h"
 #include "cocos/renderer/GFXDeviceManager.h"
 #include "cocos/renderer/core/ProgramLib.h"
 #include "pipeline/RenderPipeline.h"
+#include "platform/AsyncFileReader.h"
 #include "platform/BasePlatform.h"
 #include "platform/FileUtils.h"
+#include "primitive/PrimitiveMeshCache.h"
 
 #if CC_USE_AUDIO
     #include "cocos/audio/include/AudioEngine.h"
@@ -54,10 +61,39 @@
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "profiler/DebugRenderer.h"
 #include "profiler/Profiler.h"
+#include "profiler/StartupTimer.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 
 namespace {
 
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+// idle GC work stops this long before the next frame is due
+constexpr int64_t IDLE_GC_MIN_BUDGET_NS = 1000000;
+#endif
+
+#if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS)
+// the OS sleep tends to overshoot, so the last stretch before the deadline is spent yielding
+constexpr int64_t PACING_SPIN_NS = 1000000;
+
+void sleepUntil(std::chrono::steady_clock::time_point deadline) {
+    const auto spinStart = deadline - std::chrono::nanoseconds(PACING_SPIN_NS);
+    if (std::chrono::steady_clock::now() < spinStart) {
+        std::this_thread::sleep_until(spinStart);
+    }
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+#endif
+
+void logStartup() {
+    CC_LOG_INFO("Startup: first frame after %.3f ms", static_cast<float>(cc::StartupTimer::getFirstFrameNS()) / 1e6F);
+    for (const auto &phase : cc::StartupTimer::getPhases()) {
+        CC_LOG_DEBUG("Startup: %*s%s %.3f ms at %.3f ms", static_cast<int>(phase.depth * 2), "", phase.name,
+                     static_cast<float>(phase.durationNS) / 1e6F, static_cast<float>(phase.beginNS) / 1e6F);
+    }
+}
+
 bool setCanvasCallback(se::Object * /*global*/) {
     se::AutoHandleScope scope;
     se::ScriptEngine *  se       = se::ScriptEngine::getInstance();
@@ -87,7 +123,13 @@ bool setCanvasCallback(se::Object * /*global*/) {
 namespace cc {
 
 Engine::Engine() {
+    CC_STARTUP_PHASE(engine);
     _scheduler = std::make_shared<Scheduler>();
+    AsyncFileReader::getInstance()->setDispatcher([scheduler = std::weak_ptr<Scheduler>(_scheduler)](std::function<void()> &&task) {
+        if (auto locked = scheduler.lock()) {
+            locked->performFunctionInCocosThread(task);
+        }
+    });
     FileUtils::getInstance()->addSearchPath("Resources", true);
     FileUtils::getInstance()->addSearchPath("data", true);
     EventDispatcher::init();
@@ -100,12 +142,20 @@ Engine::~Engine() {
     AudioEngine::end();
 #endif
 
-    Root::getInstance()->getPipeline()->destroy();
+    AsyncFileReader::destroyInstance();
+    JobScheduler::destroyInstance();
+    // scripts don't create Root while a benchmark replays a gfx capture
+    if (auto *root = Root::getInstance()) {
+        root->getPipeline()->destroy();
+    }
+    // releases its gfx objects before the device goes
+    _benchmark.reset();
 
     EventDispatcher::destroy();
     se::ScriptEngine::destroyInstance();
     ProgramLib::destroyInstance();
     BuiltinResMgr::destroyInstance();
+    PrimitiveMeshCache::destroyInstance();
     gfx::DeviceManager::destroy();
 
     CCObject::deferredDestroy();
@@ -119,6 +169,8 @@ Engine::~Engine() {
 }
 
 int32_t Engine::init() {
+    ThreadAffinity::setCurrentThread("Main", ThreadQoS::CRITICAL);
+    AsyncFileReader::getInstance()->cancelAll();
     _scheduler->removeAllFunctionsToBePerformedInCocosThread();
     _scheduler->unscheduleAll();
 
@@ -168,6 +220,7 @@ void Engine::close() { // NOLINT
     //    cc::network::WebSocket::closeAllConnections();
     //#endif
     cc::network::HttpClient::destroyInstance();
+    cc::AsyncFileReader::destroyInstance();
 
     _scheduler->removeAllFunctionsToBePerformedInCocosThread();
     _scheduler->unscheduleAll();
@@ -187,11 +240,70 @@ void Engine::setPreferredFramesPerSecond(int fps) {
     if (fps == 0) {
         return;
     }
+    _preferredFramesPerSecond = fps;
+    if (!_idle) {
+        applyFrameRate(fps);
+    }
+}
+
+void Engine::setIdleFramesPerSecond(int fps, float timeout) {
+    _idleFramesPerSecond = std::max(fps, 0);
+    _idleTimeoutNS       = static_cast<int64_t>(std::max(timeout, 0.F) * NANOSECONDS_PER_SECOND);
+    _lastActivityTime    = std::chrono::steady_clock::now();
+    updateIdleState(_lastActivityTime);
+}
+
+void Engine::notifyActivity() {
+    _lastActivityTime = std::chrono::steady_clock::now();
+    if (_idle) {
+        _idle = false;
+        applyFrameRate(_preferredFramesPerSecond);
+        // don't sit out the rest of a long idle frame
+        _nextFrameTime = _lastActivityTime;
+    }
+}
+
+void Engine::updateIdleState(std::chrono::steady_clock::time_point now) {
+    const bool idle = _idleFramesPerSecond > 0 && _idleFramesPerSecond < _preferredFramesPerSecond &&
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(now - _lastActivityTime).count() >= _idleTimeoutNS;
+    if (idle != _idle) {
+        _idle = idle;
+        applyFrameRate(idle ? _idleFramesPerSecond : _preferredFramesPerSecond);
+    }
+}
+
+void Engine::applyFrameRate(int fps) {
+    // iOS/macOS hand it to the display link, Windows paces its message loop with it
     BasePlatform *platform = BasePlatform::getPlatform();
     platform->setFps(fps);
     _prefererredNanosecondsPerFrame = static_cast<long>(1.0 / fps * NANOSECONDS_PER_SECOND); //NOLINT(google-runtime-int)
 }
 
+void Engine::setBenchmark(const BenchmarkInfo &info) {
+    if (!info.enabled) {
+        _benchmark.reset();
+        return;
+    }
+    CC_ASSERT(!gfx::Device::getInstance()); // the backend and vsync only apply to devices created afterwards
+
+    _benchmark = std::make_unique<Benchmark>(info);
+    gfx::DeviceManager::setBackend(info.gfxBackend);
+    gfx::DeviceManager::setVsyncDisabled(true);
+    _idleFramesPerSecond = 0;
+
+    // without a scene to wait for, the first frame is already part of the run
+    if (info.scene.empty()) {
+        _benchmark->start();
+    }
+}
+
+void Engine::updateBenchmark(std::chrono::steady_clock::time_point frameStart) {
+    _benchmark->onFrameEnd(std::chrono::steady_clock::now() - frameStart);
+    if (_benchmark->isFinished() && _benchmark->getInfo().quitOnFinish) {
+        close();
+    }
+}
+
 void Engine::addEventCallback(OSEventType evType, const EventCb &cb) {
     _eventCallbacks.insert(std::make_pair(evType, cb));
 }
@@ -217,24 +329,54 @@ void Engine::tick() {
             _needRestart = false;
         }
 
-        static std::chrono::steady_clock::time_point prevTime;
-        static std::chrono::steady_clock::time_point now;
-        static float                                 dt   = 0.F;
-        static double                                dtNS = NANOSECONDS_60FPS;
+        static float  dt   = 0.F;
+        static double dtNS = NANOSECONDS_60FPS;
 
         ++_totalFrames;
 
+        auto frameStart = std::chrono::steady_clock::now();
+        updateIdleState(frameStart);
+
         // iOS/macOS use its own fps limitation algorithm.
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_WINDOWS || CC_PLATFORM == CC_PLATFORM_OHOS)
-        if (dtNS < static_cast<double>(_prefererredNanosecondsPerFrame)) {
+        if (!_benchmark && frameStart < _nextFrameTime) {
             CC_PROFILE(EngineSleep);
-            std::this_thread::sleep_for(
-                std::chrono::nanoseconds(_prefererredNanosecondsPerFrame - static_cast<int64_t>(dtNS)));
-            dtNS = static_cast<double>(_prefererredNanosecondsPerFrame);
+    #if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+            // let V8 do incremental GC work in the spare time instead of whenever it decides to
+            const auto budgetNS = std::chrono::duration_cast<std::chrono::nanoseconds>(_nextFrameTime - frameStart).count();
+            if (budgetNS > IDLE_GC_MIN_BUDGET_NS) {
+                se::ScriptEngine::getInstance()->idleNotification(static_cast<double>(budgetNS - IDLE_GC_MIN_BUDGET_NS) / NANOSECONDS_PER_SECOND);
+            }
+    #endif
+            sleepUntil(_nextFrameTime);
+            frameStart = std::chrono::steady_clock::now();
         }
+        // frames are due on a fixed cadence, so oversleeping shortens the next wait instead of adding up,
+        // a frame more than a whole period late starts a new cadence rather than rushing to catch up
+        const std::chrono::nanoseconds period{_prefererredNanosecondsPerFrame};
+        _nextFrameTime += period;
+        if (_nextFrameTime <= frameStart) {
+            _nextFrameTime = frameStart + period;
+        }
+#endif
+
+        if (_benchmark) {
+            // a fixed timestep keeps the simulation of every run the same whatever the frame times
+            dt = _benchmark->getTimestep();
+        } else if (_totalFrames > 1) {
+            const auto intervalNS = std::chrono::duration_cast<std::chrono::nanoseconds>(frameStart - _frameStartTime).count();
+            dtNS                  = dtNS * 0.1 + 0.9 * static_cast<double>(intervalNS);
+            dt                    = static_cast<float>(dtNS) / NANOSECONDS_PER_SECOND;
+        }
+        _frameStartTime = frameStart;
+
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+        se::ScriptEngine::getInstance()->beginFrameGCStats();
 #endif
 
-        prevTime = std::chrono::steady_clock::now();
+        if (_benchmark) {
+            _benchmark->onFrameBegin([this](const OSEvent &ev) { handleEvent(ev); });
+        }
 
         _scheduler->update(dt);
 
@@ -244,9 +386,14 @@ void Engine::tick() {
 
         cc::DeferredReleasePool::clear();
 
-        now  = std::chrono::steady_clock::now();
-        dtNS = dtNS * 0.1 + 0.9 * static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - prevTime).count());
-        dt   = static_cast<float>(dtNS) / NANOSECONDS_PER_SECOND;
+        if (_totalFrames == 1) {
+            StartupTimer::markFirstFrame();
+            logStartup();
+        }
+
+        if (_benchmark) {
+            updateBenchmark(frameStart);
+        }
     }
 
     CC_PROFILER_END_FRAME;
@@ -275,6 +422,7 @@ int32_t Engine::restartVM() {
     cc::EventDispatcher::destroy();
     ProgramLib::destroyInstance();
     BuiltinResMgr::destroyInstance();
+    PrimitiveMeshCache::destroyInstance();
     CCObject::deferredDestroy();
 
     // remove all listening events
@@ -290,6 +438,12 @@ int32_t Engine::restartVM() {
 bool Engine::handleEvent(const OSEvent &ev) {
     bool        isHandled = false;
     OSEventType type      = ev.eventType();
+    if (type == OSEventType::TOUCH_OSEVENT || type == OSEventType::MOUSE_OSEVENT || type == OSEventType::KEYBOARD_OSEVENT) {
+        notifyActivity();
+        if (_benchmark && _benchmark->isRecording()) {
+            _benchmark->record(ev);
+        }
+    }
     if (type == OSEventType::TOUCH_OSEVENT) {
         cc::EventDispatcher::dispatchTouchEvent(OSEvent::castEvent<TouchEvent>(ev));
         isHandled = true;
@@ -318,6 +472,10 @@ Engine::SchedulerPtr Engine::getScheduler() const {
 bool Engine::dispatchDeviceEvent(const DeviceEvent &ev) { // NOLINT(readability-convert-member-functions-to-static)
     if (ev.type == DeviceEvent::Type::DEVICE_MEMORY) {
         cc::EventDispatcher::dispatchMemoryWarningEvent();
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+        // collect what scripts released in the warning handlers without blocking the frame
+        se::ScriptEngine::getInstance()->memoryPressureNotification(false);
+#endif
         return true;
     }
     return false;
@@ -30,7 +30,9 @@
 
 #include "bindings/event/EventDispatcher.h"
 #include "engine/BaseEngine.h"
+#include "engine/Benchmark.h"
 
+#include <chrono>
 #include <map>
 #include <memory>
 
@@ -78,6 +80,28 @@ public:
      * @param fps The preferred frame rate for main loop callback.
      */
     void setPreferredFramesPerSecond(int fps) override;
+    /**
+     * @brief Lowers the frame rate once nothing happened for a while to save power.
+     * @param fps The frame rate used while idle, 0 disables the idle mode.
+     * @param timeout Seconds without input or activity before the idle frame rate applies.
+     */
+    void setIdleFramesPerSecond(int fps, float timeout) override;
+    /**
+     * @brief Marks the engine as active and leaves the idle frame rate right away.
+     */
+    void notifyActivity() override;
+    /**
+     @brief Whether the engine runs at the idle frame rate.
+     */
+    inline bool isIdle() const { return _idle; }
+    /**
+     * @brief Runs with a fixed timestep, no frame limiter and the backend of the benchmark, and samples its frames.
+     */
+    void setBenchmark(const BenchmarkInfo& info) override;
+    /**
+     @brief Gets the running benchmark, nullptr if none.
+     */
+    inline Benchmark* getBenchmark() const override { return _benchmark.get(); }
     /**
      @brief Gets the total number of frames in the main loop.
      */
@@ -107,6 +131,9 @@ public:
 
 private:
     void    tick();
+    void    updateIdleState(std::chrono::steady_clock::time_point now);
+    void    applyFrameRate(int fps);
+    void    updateBenchmark(std::chrono::steady_clock::time_point frameStart);
     bool    dispatchWindowEvent(const WindowEvent& ev);
     bool    dispatchDeviceEvent(const DeviceEvent& ev);
     bool    dispatchEventToApp(OSEventType type, const OSEvent& ev);
@@ -117,10 +144,20 @@ private:
     bool                       _resune{false};
     std::shared_ptr<Scheduler> _scheduler{nullptr};
     int64_t                    _prefererredNanosecondsPerFrame{NANOSECONDS_60FPS};
+    int                        _preferredFramesPerSecond{60};
+    int                        _idleFramesPerSecond{0};
+    int64_t                    _idleTimeoutNS{0};
+    bool                       _idle{false};
     uint                       _totalFrames{0};
     cc::Vec2                   _viewLogicalSize{0, 0};
     bool                       _needRestart{false};
 
+    // start of the last frame, and when the next one is due
+    std::chrono::steady_clock::time_point _frameStartTime;
+    std::chrono::steady_clock::time_point _nextFrameTime;
+    std::chrono::steady_clock::time_point _lastActivityTime;
+
+    std::unique_ptr<Benchmark>     _benchmark;
     std::map<OSEventType, EventCb> _eventCallbacks;
     CC_DISALLOW_COPY_MOVE_ASSIGN(Engine);
 };
@@ -21,6 +21,9 @@ This file was modified to fit the cocos2d-x project
 */
 
 #include "math/MathUtil.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include "base/Macros.h"
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
@@ -60,6 +63,15 @@ This file was modified to fit the cocos2d-x project
     #define INCLUDE_SSE
 #endif
 
+// the AVX2 kernels are built on every x86 target and picked at runtime
+#if defined(INCLUDE_SSE) && (defined(__x86_64__) || defined(__i386__))
+    #define INCLUDE_AVX2
+    #include <cpuid.h>
+#endif
+
+// the SIMD kernels fall back to the C ones for the remainders
+#include "math/MathUtil.inl"
+
 #ifdef INCLUDE_NEON32
     #include "math/MathUtilNeon.inl"
 #endif
@@ -69,10 +81,15 @@ This file was modified to fit the cocos2d-x project
 #endif
 
 #ifdef INCLUDE_SSE
+    #ifdef __AVX__
+        #include <immintrin.h>
+    #endif
     #include "math/MathUtilSSE.inl"
 #endif
-#include <cstring>
-#include "math/MathUtil.inl"
+
+#ifdef INCLUDE_AVX2
+    #include "math/MathUtilAVX2.inl"
+#endif
 
 NS_CC_MATH_BEGIN
 
@@ -126,6 +143,38 @@ bool MathUtil::isNeon64Enabled() {
 #endif
 }
 
+bool MathUtil::isAVX2Enabled() {
+#if defined(__AVX2__) && defined(__FMA__)
+    return true;
+#elif defined(INCLUDE_AVX2)
+    static const bool isEnabled = []() {
+        // cpuid tells the CPU support, xgetbv tells whether the OS saves the ymm registers
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        if (__get_cpuid_max(0, nullptr) < 7 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const bool fma     = (ecx & (1U << 12U)) != 0;
+        const bool osxsave = (ecx & (1U << 27U)) != 0;
+        if (!fma || !osxsave) {
+            return false;
+        }
+        uint32_t xcr0     = 0;
+        uint32_t xcr0High = 0;
+        __asm__("xgetbv"
+                : "=a"(xcr0), "=d"(xcr0High)
+                : "c"(0));
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        return (xcr0 & 0x6U) == 0x6U && (ebx & (1U << 5U)) != 0;
+    }();
+    return isEnabled;
+#else
+    return false;
+#endif
+}
+
 void MathUtil::addMatrix(const float *m, float scalar, float *dst) {
 #ifdef USE_NEON32
     MathUtilNeon::addMatrix(m, scalar, dst);
@@ -316,6 +365,208 @@ void MathUtil::crossVec3(const float *v1, const float *v2, float *dst) {
 #endif
 }
 
+void MathUtil::aabbPlanesBatch(const float *centerX, const float *centerY, const float *centerZ,
+                               const float *extentX, const float *extentY, const float *extentZ,
+                               uint32_t count, const float *planes, uint32_t planeCount, uint8_t *results) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::aabbPlanesBatch(centerX, centerY, centerZ, extentX, extentY, extentZ, count, planes, planeCount, results);
+#elif defined(USE_SSE)
+    MathUtilSSE::aabbPlanesBatch(centerX, centerY, centerZ, extentX, extentY, extentZ, count, planes, planeCount, results);
+#else
+    MathUtilC::aabbPlanesBatch(centerX, centerY, centerZ, extentX, extentY, extentZ, count, planes, planeCount, results);
+#endif
+}
+
+void MathUtil::transformAABBBatch(const float *const *matrices, const float *centers, const float *extents, uint32_t count,
+                                  float *outCenters, float *outExtents) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::transformAABBBatch(matrices, centers, extents, count, outCenters, outExtents);
+#elif defined(USE_SSE)
+    MathUtilSSE::transformAABBBatch(matrices, centers, extents, count, outCenters, outExtents);
+#else
+    MathUtilC::transformAABBBatch(matrices, centers, extents, count, outCenters, outExtents);
+#endif
+}
+
+void MathUtil::transformVec3Batch(const float *m, const uint8_t *src, uint32_t srcStride, uint8_t *dst, uint32_t dstStride,
+                                  uint32_t count, float w) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::transformVec3Batch(m, src, srcStride, dst, dstStride, count, w);
+#elif defined(INCLUDE_AVX2)
+    if (isAVX2Enabled()) {
+        MathUtilAVX2::transformVec3Batch(m, src, srcStride, dst, dstStride, count, w);
+    } else {
+        MathUtilSSE::transformVec3Batch(m, src, srcStride, dst, dstStride, count, w);
+    }
+#elif defined(USE_SSE)
+    MathUtilSSE::transformVec3Batch(m, src, srcStride, dst, dstStride, count, w);
+#else
+    MathUtilC::transformVec3Batch(m, src, srcStride, dst, dstStride, count, w);
+#endif
+}
+
+void MathUtil::multiplyJointMatrices(const float *const *worlds, const float *bindposes, uint32_t count, float *outJoints) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyJointMatrices(worlds, bindposes, count, outJoints);
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyJointMatrices(worlds, bindposes, count, outJoints);
+#else
+    MathUtilC::multiplyJointMatrices(worlds, bindposes, count, outJoints);
+#endif
+}
+
+void MathUtil::multiplyMatrixBatch(const float *m, const float *matrices, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyMatrixBatch(m, matrices, count, dst);
+#elif defined(INCLUDE_AVX2)
+    if (isAVX2Enabled()) {
+        MathUtilAVX2::multiplyMatrixBatch(m, matrices, count, dst);
+    } else {
+        MathUtilSSE::multiplyMatrixBatch(m, matrices, count, dst);
+    }
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyMatrixBatch(m, matrices, count, dst);
+#else
+    MathUtilC::multiplyMatrixBatch(m, matrices, count, dst);
+#endif
+}
+
+void MathUtil::fromRTSBatch(const float *rotations, const float *translations, const float *scales, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::fromRTSBatch(rotations, translations, scales, count, dst);
+#elif defined(INCLUDE_AVX2)
+    if (isAVX2Enabled()) {
+        MathUtilAVX2::fromRTSBatch(rotations, translations, scales, count, dst);
+    } else {
+        MathUtilSSE::fromRTSBatch(rotations, translations, scales, count, dst);
+    }
+#elif defined(USE_SSE)
+    MathUtilSSE::fromRTSBatch(rotations, translations, scales, count, dst);
+#else
+    MathUtilC::fromRTSBatch(rotations, translations, scales, count, dst);
+#endif
+}
+
+bool MathUtil::invertAffineBatch(const float *matrices, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    return MathUtilNeon64::invertAffineBatch(matrices, count, dst);
+#elif defined(INCLUDE_AVX2)
+    return isAVX2Enabled() ? MathUtilAVX2::invertAffineBatch(matrices, count, dst) : MathUtilSSE::invertAffineBatch(matrices, count, dst);
+#elif defined(USE_SSE)
+    return MathUtilSSE::invertAffineBatch(matrices, count, dst);
+#else
+    return MathUtilC::invertAffineBatch(matrices, count, dst);
+#endif
+}
+
+void MathUtil::multiplyQuaternion(const float *q1, const float *q2, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyQuaternion(q1, q2, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyQuaternion(q1, q2, dst);
+#else
+    MathUtilC::multiplyQuaternion(q1, q2, dst);
+#endif
+}
+
+void MathUtil::slerpQuaternion(const float *q1, const float *q2, float t, float *dst) {
+    MathUtilC::slerpQuaternion(q1, q2, t, dst);
+}
+
+void MathUtil::multiplyQuaternionBatch(const float *q1, const float *q2, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::multiplyQuaternionBatch(q1, q2, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::multiplyQuaternionBatch(q1, q2, count, dst);
+#else
+    MathUtilC::multiplyQuaternionBatch(q1, q2, count, dst);
+#endif
+}
+
+void MathUtil::slerpQuaternionBatch(const float *from, const float *to, float t, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::slerpQuaternionBatch(from, to, t, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::slerpQuaternionBatch(from, to, t, count, dst);
+#else
+    MathUtilC::slerpQuaternionBatch(from, to, t, count, dst);
+#endif
+}
+
+void MathUtil::nlerpQuaternionBatch(const float *from, const float *to, float t, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::nlerpQuaternionBatch(from, to, t, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::nlerpQuaternionBatch(from, to, t, count, dst);
+#else
+    MathUtilC::nlerpQuaternionBatch(from, to, t, count, dst);
+#endif
+}
+
+void MathUtil::normalizeQuaternionBatch(const float *quats, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::normalizeQuaternionBatch(quats, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::normalizeQuaternionBatch(quats, count, dst);
+#else
+    MathUtilC::normalizeQuaternionBatch(quats, count, dst);
+#endif
+}
+
+void MathUtil::transformVec3QuatBatch(const float *q, const float *vectors, uint32_t count, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::transformVec3QuatBatch(q, vectors, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::transformVec3QuatBatch(q, vectors, count, dst);
+#else
+    MathUtilC::transformVec3QuatBatch(q, vectors, count, dst);
+#endif
+}
+
+void MathUtil::rayTriangleBatch(const float *origin, const float *direction, const float *vertices, uint32_t count,
+                                bool doubleSided, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::rayTriangleBatch(origin, direction, vertices, count, doubleSided, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::rayTriangleBatch(origin, direction, vertices, count, doubleSided, dst);
+#else
+    MathUtilC::rayTriangleBatch(origin, direction, vertices, count, doubleSided, dst);
+#endif
+}
+
+void MathUtil::rayAABBBatch(const float *origin, const float *direction, const float *mins, const float *maxs, uint32_t count,
+                            float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::rayAABBBatch(origin, direction, mins, maxs, count, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::rayAABBBatch(origin, direction, mins, maxs, count, dst);
+#else
+    MathUtilC::rayAABBBatch(origin, direction, mins, maxs, count, dst);
+#endif
+}
+
+void MathUtil::raysTriangleBatch(const float *origins, const float *directions, uint32_t count, const float *vertices,
+                                 bool doubleSided, float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::raysTriangleBatch(origins, directions, count, vertices, doubleSided, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::raysTriangleBatch(origins, directions, count, vertices, doubleSided, dst);
+#else
+    MathUtilC::raysTriangleBatch(origins, directions, count, vertices, doubleSided, dst);
+#endif
+}
+
+void MathUtil::raysAABBBatch(const float *origins, const float *directions, uint32_t count, const float *min, const float *max,
+                             float *dst) {
+#if defined(USE_NEON64)
+    MathUtilNeon64::raysAABBBatch(origins, directions, count, min, max, dst);
+#elif defined(USE_SSE)
+    MathUtilSSE::raysAABBBatch(origins, directions, count, min, max, dst);
+#else
+    MathUtilC::raysAABBBatch(origins, directions, count, min, max, dst);
+#endif
+}
+
 void MathUtil::combineHash(size_t &seed, const size_t &v) {
     seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
@@ -43,6 +43,7 @@ NS_CC_MATH_BEGIN
  */
 class CC_DLL MathUtil {
     friend class Mat4;
+    friend class Quaternion;
     friend class Vec3;
 
 public:
@@ -95,10 +96,209 @@ public:
      */
     static void combineHash(size_t &seed, const size_t &v);
 
+    /**
+     * Tests axis aligned bounding boxes stored in SoA layout against a set of planes, several boxes at a time.
+     * A box is culled when it lies completely on the negative side of any plane, plane normals point to the inside.
+     * Every input stream must be readable up to count rounded up to a multiple of 4.
+     *
+     * @param centerX x components of the box centers.
+     * @param centerY y components of the box centers.
+     * @param centerZ z components of the box centers.
+     * @param extentX x components of the box half extents.
+     * @param extentY y components of the box half extents.
+     * @param extentZ z components of the box half extents.
+     * @param count number of boxes.
+     * @param planes planes laid out as [nx, ny, nz, d] for each plane.
+     * @param planeCount number of planes.
+     * @param results 1 for boxes that are not culled, 0 otherwise, count entries are written.
+     */
+    static void aabbPlanesBatch(const float *centerX, const float *centerY, const float *centerZ,
+                                const float *extentX, const float *extentY, const float *extentZ,
+                                uint32_t count, const float *planes, uint32_t planeCount, uint8_t *results);
+
+    /**
+     * Transforms boxes by their own matrices, the result of each box is the axis aligned box of its transformed corners.
+     *
+     * @param matrices column major matrix of each box.
+     * @param centers box centers laid out as [x, y, z] for each box.
+     * @param extents box half extents laid out as [x, y, z] for each box.
+     * @param count number of boxes.
+     * @param outCenters transformed centers, same layout as centers.
+     * @param outExtents transformed half extents, same layout as extents.
+     */
+    static void transformAABBBatch(const float *const *matrices, const float *centers, const float *extents, uint32_t count,
+                                   float *outCenters, float *outExtents);
+
+    /**
+     * Transforms float vectors stored in interleaved vertex data by one matrix, src and dst may be the same memory.
+     *
+     * @param m column major matrix.
+     * @param src first vector laid out as [x, y, z], read with the given byte stride.
+     * @param srcStride byte distance between two source vectors.
+     * @param dst first transformed vector, written with the given byte stride.
+     * @param dstStride byte distance between two destination vectors.
+     * @param count number of vectors.
+     * @param w 1 to transform points, 0 to transform directions.
+     */
+    static void transformVec3Batch(const float *m, const uint8_t *src, uint32_t srcStride, uint8_t *dst, uint32_t dstStride,
+                                   uint32_t count, float w);
+
+    /**
+     * Multiplies the world matrix of each joint with its bind pose and writes the result in the joint layout of the
+     * skinning uniforms: the x, y, z of the first three columns, each followed by one component of the translation.
+     *
+     * @param worlds column major world matrix of each joint.
+     * @param bindposes column major bind pose matrices, 16 floats for each joint.
+     * @param count number of joints.
+     * @param outJoints 12 floats for each joint.
+     */
+    static void multiplyJointMatrices(const float *const *worlds, const float *bindposes, uint32_t count, float *outJoints);
+
+    /**
+     * Multiplies one matrix by each matrix of an array, dst may be the same memory as matrices.
+     * On x86 the AVX2 kernel is picked at runtime when the CPU supports it.
+     *
+     * @param m column major matrix on the left of every product.
+     * @param matrices column major matrices, 16 floats for each.
+     * @param count number of matrices.
+     * @param dst m * matrices[i] for each matrix, 16 floats for each.
+     */
+    static void multiplyMatrixBatch(const float *m, const float *matrices, uint32_t count, float *dst);
+
+    /**
+     * Composes matrices from rotations, translations and scales, like Mat4::fromRTS for each transform.
+     *
+     * @param rotations quaternions laid out as [x, y, z, w] for each transform.
+     * @param translations translations laid out as [x, y, z] for each transform.
+     * @param scales scales laid out as [x, y, z] for each transform.
+     * @param count number of transforms.
+     * @param dst column major matrices, 16 floats for each transform.
+     */
+    static void fromRTSBatch(const float *rotations, const float *translations, const float *scales, uint32_t count, float *dst);
+
+    /**
+     * Inverts affine matrices, whose last row is [0, 0, 0, 1], dst may be the same memory as matrices.
+     * A matrix that can't be inverted is copied unchanged, like Mat4::inverse leaves it.
+     *
+     * @param matrices column major affine matrices, 16 floats for each.
+     * @param count number of matrices.
+     * @param dst inverted matrices, 16 floats for each.
+     *
+     * @return false if any of the matrices can't be inverted.
+     */
+    static bool invertAffineBatch(const float *matrices, uint32_t count, float *dst);
+
+    /**
+     * Multiplies quaternions pairwise, like Quaternion::multiply, dst may be the same memory as either input.
+     *
+     * @param q1 quaternions laid out as [x, y, z, w], on the left of every product.
+     * @param q2 quaternions laid out as [x, y, z, w], on the right of every product.
+     * @param count number of quaternions.
+     * @param dst q1[i] * q2[i] for each pair.
+     */
+    static void multiplyQuaternionBatch(const float *q1, const float *q2, uint32_t count, float *dst);
+
+    /**
+     * Spherically interpolates quaternions pairwise by the same amount, with the same approximation as Quaternion::slerp.
+     * dst may be the same memory as either input.
+     *
+     * @param from quaternions laid out as [x, y, z, w], returned for t = 0.
+     * @param to quaternions laid out as [x, y, z, w], returned for t = 1.
+     * @param t interpolation amount between [0,1].
+     * @param count number of quaternions.
+     * @param dst interpolated quaternions.
+     */
+    static void slerpQuaternionBatch(const float *from, const float *to, float t, uint32_t count, float *dst);
+
+    /**
+     * Linearly interpolates quaternions pairwise along the shorter arc and normalizes the results,
+     * cheaper than slerp when the angles between the pairs are small. dst may be the same memory as either input.
+     *
+     * @param from quaternions laid out as [x, y, z, w].
+     * @param to quaternions laid out as [x, y, z, w].
+     * @param t interpolation amount between [0,1].
+     * @param count number of quaternions.
+     * @param dst interpolated quaternions.
+     */
+    static void nlerpQuaternionBatch(const float *from, const float *to, float t, uint32_t count, float *dst);
+
+    /**
+     * Normalizes quaternions, like Quaternion::normalize a quaternion too close to zero is copied unchanged.
+     *
+     * @param quats quaternions laid out as [x, y, z, w].
+     * @param count number of quaternions.
+     * @param dst normalized quaternions, may be the same memory as quats.
+     */
+    static void normalizeQuaternionBatch(const float *quats, uint32_t count, float *dst);
+
+    /**
+     * Rotates vectors by one quaternion, like Vec3::transformQuat, dst may be the same memory as vectors.
+     *
+     * @param q quaternion laid out as [x, y, z, w].
+     * @param vectors vectors laid out as [x, y, z].
+     * @param count number of vectors.
+     * @param dst rotated vectors.
+     */
+    static void transformVec3QuatBatch(const float *q, const float *vectors, uint32_t count, float *dst);
+
+    /**
+     * Intersects one ray with triangles, like geometry::rayTriangle for each triangle.
+     *
+     * @param origin ray origin laid out as [x, y, z].
+     * @param direction normalized ray direction laid out as [x, y, z].
+     * @param vertices triangle corners laid out as [ax, ay, az, bx, by, bz, cx, cy, cz] for each triangle.
+     * @param count number of triangles.
+     * @param doubleSided whether the back faces of the triangles are hit too.
+     * @param dst hit distance for each triangle, 0 on miss.
+     */
+    static void rayTriangleBatch(const float *origin, const float *direction, const float *vertices, uint32_t count,
+                                 bool doubleSided, float *dst);
+
+    /**
+     * Intersects one ray with axis aligned boxes, like geometry::rayAABB2 for each box.
+     *
+     * @param origin ray origin laid out as [x, y, z].
+     * @param direction normalized ray direction laid out as [x, y, z].
+     * @param mins minimum corners laid out as [x, y, z] for each box.
+     * @param maxs maximum corners laid out as [x, y, z] for each box.
+     * @param count number of boxes.
+     * @param dst hit distance for each box, 0 on miss.
+     */
+    static void rayAABBBatch(const float *origin, const float *direction, const float *mins, const float *maxs, uint32_t count,
+                             float *dst);
+
+    /**
+     * Intersects rays with one triangle, like geometry::rayTriangle for each ray.
+     *
+     * @param origins ray origins laid out as [x, y, z] for each ray.
+     * @param directions normalized ray directions laid out as [x, y, z] for each ray.
+     * @param count number of rays.
+     * @param vertices triangle corners laid out as [ax, ay, az, bx, by, bz, cx, cy, cz].
+     * @param doubleSided whether the back face of the triangle is hit too.
+     * @param dst hit distance for each ray, 0 on miss.
+     */
+    static void raysTriangleBatch(const float *origins, const float *directions, uint32_t count, const float *vertices,
+                                  bool doubleSided, float *dst);
+
+    /**
+     * Intersects rays with one axis aligned box, like geometry::rayAABB2 for each ray.
+     *
+     * @param origins ray origins laid out as [x, y, z] for each ray.
+     * @param directions normalized ray directions laid out as [x, y, z] for each ray.
+     * @param count number of rays.
+     * @param min minimum corner laid out as [x, y, z].
+     * @param max maximum corner laid out as [x, y, z].
+     * @param dst hit distance for each ray, 0 on miss.
+     */
+    static void raysAABBBatch(const float *origins, const float *directions, uint32_t count, const float *min, const float *max,
+                              float *dst);
+
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
     static bool isNeon64Enabled();
+    //Indicates that if the CPU and the OS support AVX2 and FMA, picked at runtime on x86
+    static bool isAVX2Enabled();
 
 private:
 #ifdef __SSE__
@@ -137,6 +337,10 @@ private:
     static void transformVec4(const float *m, const float *v, float *dst);
 
     static void crossVec3(const float *v1, const float *v2, float *dst);
+
+    static void multiplyQuaternion(const float *q1, const float *q2, float *dst);
+
+    static void slerpQuaternion(const float *q1, const float *q2, float t, float *dst);
 };
 
 NS_CC_MATH_END
@@ -42,6 +42,54 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                       const float* extentX, const float* extentY, const float* extentZ,
+                                       uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results);
+
+    inline static void transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                          float* outCenters, float* outExtents);
+
+    inline static void transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                          uint32_t count, float w);
+
+    inline static void multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints);
+
+    inline static void multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst);
+
+    inline static void fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst);
+
+    inline static bool invertAffineBatch(const float* matrices, uint32_t count, float* dst);
+
+    inline static void multiplyQuaternion(const float* q1, const float* q2, float* dst);
+
+    inline static void multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst);
+
+    inline static void slerpQuaternion(const float* q1, const float* q2, float t, float* dst);
+
+    inline static void slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst);
+
+    inline static void transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst);
+
+    inline static float rayTriangle(const float* origin, const float* direction, const float* vertices, bool doubleSided);
+
+    inline static float rayAABB(const float* origin, const float* direction, const float* min, const float* max);
+
+    inline static void rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                        bool doubleSided, float* dst);
+
+    inline static void rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                    float* dst);
+
+    inline static void raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                         bool doubleSided, float* dst);
+
+    inline static void raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                     float* dst);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +263,486 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                       const float* extentX, const float* extentY, const float* extentZ,
+                                       uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint8_t visible = 1;
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            const float* plane = planes + p * 4;
+            const float  r     = extentX[i] * std::abs(plane[0]) + extentY[i] * std::abs(plane[1]) + extentZ[i] * std::abs(plane[2]);
+            const float  dot   = centerX[i] * plane[0] + centerY[i] * plane[1] + centerZ[i] * plane[2];
+            if (dot + r < plane[3])
+            {
+                visible = 0;
+                break;
+            }
+        }
+        results[i] = visible;
+    }
+}
+
+inline void MathUtilC::transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                          float* outCenters, float* outExtents)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* m = matrices[i];
+        const float* c = centers + i * 3;
+        const float* e = extents + i * 3;
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            outCenters[i * 3 + k] = m[k] * c[0] + m[4 + k] * c[1] + m[8 + k] * c[2] + m[12 + k];
+            outExtents[i * 3 + k] = std::abs(m[k]) * e[0] + std::abs(m[4 + k]) * e[1] + std::abs(m[8 + k]) * e[2];
+        }
+    }
+}
+
+inline void MathUtilC::transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                          uint32_t count, float w)
+{
+    float v[3];
+    float r[3];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        memcpy(v, src + i * srcStride, sizeof(v));
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            r[k] = m[k] * v[0] + m[4 + k] * v[1] + m[8 + k] * v[2] + m[12 + k] * w;
+        }
+        memcpy(dst + i * dstStride, r, sizeof(r));
+    }
+}
+
+inline void MathUtilC::multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints)
+{
+    float r[16];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* w = worlds[i];
+        const float* b = bindposes + i * 16;
+        float*       o = outJoints + i * 12;
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            for (uint32_t k = 0; k < 4; ++k)
+            {
+                r[c * 4 + k] = w[k] * b[c * 4] + w[4 + k] * b[c * 4 + 1] + w[8 + k] * b[c * 4 + 2] + w[12 + k] * b[c * 4 + 3];
+            }
+        }
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+            o[c * 4]     = r[c * 4];
+            o[c * 4 + 1] = r[c * 4 + 1];
+            o[c * 4 + 2] = r[c * 4 + 2];
+            o[c * 4 + 3] = r[12 + c];
+        }
+    }
+}
+
+
+inline void MathUtilC::multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        multiplyMatrix(m, matrices + i * 16, dst + i * 16);
+    }
+}
+
+inline void MathUtilC::fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* q  = rotations + i * 4;
+        const float* t  = translations + i * 3;
+        const float* s  = scales + i * 3;
+        float*       o  = dst + i * 16;
+        const float  x2 = q[0] + q[0];
+        const float  y2 = q[1] + q[1];
+        const float  z2 = q[2] + q[2];
+        const float  xx = q[0] * x2;
+        const float  xy = q[0] * y2;
+        const float  xz = q[0] * z2;
+        const float  yy = q[1] * y2;
+        const float  yz = q[1] * z2;
+        const float  zz = q[2] * z2;
+        const float  wx = q[3] * x2;
+        const float  wy = q[3] * y2;
+        const float  wz = q[3] * z2;
+
+        o[0]  = (1 - (yy + zz)) * s[0];
+        o[1]  = (xy + wz) * s[0];
+        o[2]  = (xz - wy) * s[0];
+        o[3]  = 0;
+        o[4]  = (xy - wz) * s[1];
+        o[5]  = (1 - (xx + zz)) * s[1];
+        o[6]  = (yz + wx) * s[1];
+        o[7]  = 0;
+        o[8]  = (xz + wy) * s[2];
+        o[9]  = (yz - wx) * s[2];
+        o[10] = (1 - (xx + yy)) * s[2];
+        o[11] = 0;
+        o[12] = t[0];
+        o[13] = t[1];
+        o[14] = t[2];
+        o[15] = 1;
+    }
+}
+
+inline bool MathUtilC::invertAffineBatch(const float* matrices, uint32_t count, float* dst)
+{
+    bool  inverted = true;
+    float r[9];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* a = matrices + i * 16;
+        float*       o = dst + i * 16;
+        // the rows of the inverse are the cross products of the columns, divided by the determinant
+        r[0] = a[5] * a[10] - a[6] * a[9];
+        r[1] = a[6] * a[8] - a[4] * a[10];
+        r[2] = a[4] * a[9] - a[5] * a[8];
+        r[3] = a[9] * a[2] - a[10] * a[1];
+        r[4] = a[10] * a[0] - a[8] * a[2];
+        r[5] = a[8] * a[1] - a[9] * a[0];
+        r[6] = a[1] * a[6] - a[2] * a[5];
+        r[7] = a[2] * a[4] - a[0] * a[6];
+        r[8] = a[0] * a[5] - a[1] * a[4];
+
+        const float det = a[0] * r[0] + a[1] * r[1] + a[2] * r[2];
+        if (std::abs(det) <= MATH_TOLERANCE)
+        {
+            if (o != a)
+            {
+                memcpy(o, a, MATRIX_SIZE);
+            }
+            inverted = false;
+            continue;
+        }
+
+        const float invDet = 1.0F / det;
+        for (float& v : r)
+        {
+            v *= invDet;
+        }
+        const float tx = a[12];
+        const float ty = a[13];
+        const float tz = a[14];
+        o[0]  = r[0];
+        o[1]  = r[3];
+        o[2]  = r[6];
+        o[3]  = 0;
+        o[4]  = r[1];
+        o[5]  = r[4];
+        o[6]  = r[7];
+        o[7]  = 0;
+        o[8]  = r[2];
+        o[9]  = r[5];
+        o[10] = r[8];
+        o[11] = 0;
+        o[12] = -(r[0] * tx + r[1] * ty + r[2] * tz);
+        o[13] = -(r[3] * tx + r[4] * ty + r[5] * tz);
+        o[14] = -(r[6] * tx + r[7] * ty + r[8] * tz);
+        o[15] = 1;
+    }
+    return inverted;
+}
+
+
+inline void MathUtilC::multiplyQuaternion(const float* q1, const float* q2, float* dst)
+{
+    // Support the case where q1 or q2 is the same array as dst.
+    const float x = q1[3] * q2[0] + q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1];
+    const float y = q1[3] * q2[1] - q1[0] * q2[2] + q1[1] * q2[3] + q1[2] * q2[0];
+    const float z = q1[3] * q2[2] + q1[0] * q2[1] - q1[1] * q2[0] + q1[2] * q2[3];
+    const float w = q1[3] * q2[3] - q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2];
+
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+    dst[3] = w;
+}
+
+inline void MathUtilC::multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        multiplyQuaternion(q1 + i * 4, q2 + i * 4, dst + i * 4);
+    }
+}
+
+inline void MathUtilC::slerpQuaternion(const float* q1, const float* q2, float t, float* dst)
+{
+    // Fast slerp implementation by kwhatmough:
+    // It contains no division operations, no trig, no inverse trig
+    // and no sqrt. Not only does this code tolerate small constraint
+    // errors in the input quaternions, it actually corrects for them.
+    const float q1x = q1[0];
+    const float q1y = q1[1];
+    const float q1z = q1[2];
+    const float q1w = q1[3];
+    const float q2x = q2[0];
+    const float q2y = q2[1];
+    const float q2z = q2[2];
+    const float q2w = q2[3];
+
+    if (t == 0.F || (q1x == q2x && q1y == q2y && q1z == q2z && q1w == q2w))
+    {
+        memmove(dst, q1, sizeof(float) * 4);
+        return;
+    }
+
+    if (t == 1.F)
+    {
+        memmove(dst, q2, sizeof(float) * 4);
+        return;
+    }
+
+    float halfY;
+    float alpha;
+    float beta;
+
+    float u;
+    float f1;
+    float f2a;
+    float f2b;
+
+    float ratio1;
+    float ratio2;
+
+    float halfSecHalfTheta;
+    float versHalfTheta;
+
+    float sqNotU;
+    float sqU;
+
+    float cosTheta = q1w * q2w + q1x * q2x + q1y * q2y + q1z * q2z;
+
+    // As usual in all slerp implementations, we fold theta.
+    alpha = cosTheta >= 0 ? 1.F : -1.F;
+    halfY = 1.F + alpha * cosTheta;
+
+    // Here we bisect the interval, so we need to fold t as well.
+    f2b = t - 0.5F;
+    u   = f2b >= 0 ? f2b : -f2b;
+    f2a = u - f2b;
+    f2b += u;
+    u += u;
+    f1 = 1.F - u;
+
+    // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
+    halfSecHalfTheta = 1.09F - (0.476537F - 0.0903321F * halfY) * halfY;
+    halfSecHalfTheta *= 1.5F - halfY * halfSecHalfTheta * halfSecHalfTheta;
+    versHalfTheta = 1.F - halfY * halfSecHalfTheta;
+
+    // Evaluate series expansions of the coefficients.
+    sqNotU = f1 * f1;
+    ratio2 = 0.0000440917108F * versHalfTheta;
+    ratio1 = -0.00158730159F + (sqNotU - 16.F) * ratio2;
+    ratio1 = 0.0333333333F + ratio1 * (sqNotU - 9.F) * versHalfTheta;
+    ratio1 = -0.333333333F + ratio1 * (sqNotU - 4.F) * versHalfTheta;
+    ratio1 = 1.F + ratio1 * (sqNotU - 1.F) * versHalfTheta;
+
+    sqU    = u * u;
+    ratio2 = -0.00158730159F + (sqU - 16.F) * ratio2;
+    ratio2 = 0.0333333333F + ratio2 * (sqU - 9.F) * versHalfTheta;
+    ratio2 = -0.333333333F + ratio2 * (sqU - 4.F) * versHalfTheta;
+    ratio2 = 1.F + ratio2 * (sqU - 1.F) * versHalfTheta;
+
+    // Perform the bisection and resolve the folding done earlier.
+    f1 *= ratio1 * halfSecHalfTheta;
+    f2a *= ratio2;
+    f2b *= ratio2;
+    alpha *= f1 + f2a;
+    beta = f1 + f2b;
+
+    // Apply final coefficients to a and b as usual.
+    float w = alpha * q1w + beta * q2w;
+    float x = alpha * q1x + beta * q2x;
+    float y = alpha * q1y + beta * q2y;
+    float z = alpha * q1z + beta * q2z;
+
+    // This final adjustment to the quaternion's length corrects for
+    // any small constraint error in the inputs q1 and q2 But as you
+    // can see, it comes at the cost of 9 additional multiplication
+    // operations. If this error-correcting feature is not required,
+    // the following code may be removed.
+    f1    = 1.5F - 0.5F * (w * w + x * x + y * y + z * z);
+    dst[0] = x * f1;
+    dst[1] = y * f1;
+    dst[2] = z * f1;
+    dst[3] = w * f1;
+}
+
+inline void MathUtilC::slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        slerpQuaternion(from + i * 4, to + i * 4, t, dst + i * 4);
+    }
+}
+
+inline void MathUtilC::nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* a   = from + i * 4;
+        const float* b   = to + i * 4;
+        float*       o   = dst + i * 4;
+        const float  dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        // interpolate towards -to when it is the shorter arc
+        const float t1 = 1.F - t;
+        const float t2 = dot < 0.F ? -t : t;
+        const float x  = t1 * a[0] + t2 * b[0];
+        const float y  = t1 * a[1] + t2 * b[1];
+        const float z  = t1 * a[2] + t2 * b[2];
+        const float w  = t1 * a[3] + t2 * b[3];
+        o[0]           = x;
+        o[1]           = y;
+        o[2]           = z;
+        o[3]           = w;
+    }
+    normalizeQuaternionBatch(dst, count, dst);
+}
+
+inline void MathUtilC::normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* q = quats + i * 4;
+        float*       o = dst + i * 4;
+        const float  n = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        // Too close to zero.
+        const float scale = n < 0.000001F ? 1.F : 1.F / n;
+        o[0]              = q[0] * scale;
+        o[1]              = q[1] * scale;
+        o[2]              = q[2] * scale;
+        o[3]              = q[3] * scale;
+    }
+}
+
+inline void MathUtilC::transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst)
+{
+    const float qx = q[0];
+    const float qy = q[1];
+    const float qz = q[2];
+    const float qw = q[3];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* v = vectors + i * 3;
+        float*       o = dst + i * 3;
+        const float  x = v[0];
+        const float  y = v[1];
+        const float  z = v[2];
+
+        // calculate quat * vec
+        const float ix = qw * x + qy * z - qz * y;
+        const float iy = qw * y + qz * x - qx * z;
+        const float iz = qw * z + qx * y - qy * x;
+        const float iw = -qx * x - qy * y - qz * z;
+
+        // calculate result * inverse quat
+        o[0] = ix * qw + iw * -qx + iy * -qz - iz * -qy;
+        o[1] = iy * qw + iw * -qy + iz * -qx - ix * -qz;
+        o[2] = iz * qw + iw * -qz + ix * -qy - iy * -qx;
+    }
+}
+
+inline float MathUtilC::rayTriangle(const float* origin, const float* direction, const float* vertices, bool doubleSided)
+{
+    // same as geometry::rayTriangle
+    const float* a   = vertices;
+    const float  abx = vertices[3] - a[0];
+    const float  aby = vertices[4] - a[1];
+    const float  abz = vertices[5] - a[2];
+    const float  acx = vertices[6] - a[0];
+    const float  acy = vertices[7] - a[1];
+    const float  acz = vertices[8] - a[2];
+    const float  px  = direction[1] * acz - direction[2] * acy;
+    const float  py  = direction[2] * acx - direction[0] * acz;
+    const float  pz  = direction[0] * acy - direction[1] * acx;
+    const float  det = abx * px + aby * py + abz * pz;
+    if (det < MATH_EPSILON && (!doubleSided || det > -MATH_EPSILON))
+    {
+        return 0.F;
+    }
+    const float invDet = 1.F / det;
+    const float aox    = origin[0] - a[0];
+    const float aoy    = origin[1] - a[1];
+    const float aoz    = origin[2] - a[2];
+    const float u      = (aox * px + aoy * py + aoz * pz) * invDet;
+    if (u < 0.F || u > 1.F)
+    {
+        return 0.F;
+    }
+    const float qx = aoy * abz - aoz * aby;
+    const float qy = aoz * abx - aox * abz;
+    const float qz = aox * aby - aoy * abx;
+    const float v  = (direction[0] * qx + direction[1] * qy + direction[2] * qz) * invDet;
+    if (v < 0.F || u + v > 1.F)
+    {
+        return 0.F;
+    }
+    const float t = (acx * qx + acy * qy + acz * qz) * invDet;
+    return t < 0.F ? 0.F : t;
+}
+
+inline float MathUtilC::rayAABB(const float* origin, const float* direction, const float* min, const float* max)
+{
+    // same as geometry::rayAABB2
+    const float ix   = 1.F / direction[0];
+    const float iy   = 1.F / direction[1];
+    const float iz   = 1.F / direction[2];
+    const float tx1  = (min[0] - origin[0]) * ix;
+    const float tx2  = (max[0] - origin[0]) * ix;
+    const float ty1  = (min[1] - origin[1]) * iy;
+    const float ty2  = (max[1] - origin[1]) * iy;
+    const float tz1  = (min[2] - origin[2]) * iz;
+    const float tz2  = (max[2] - origin[2]) * iz;
+    const float tmin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::min(tz1, tz2));
+    const float tmax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::max(tz1, tz2));
+    if (tmax < 0.F || tmin > tmax)
+    {
+        return 0.F;
+    }
+    return tmin > 0.F ? tmin : tmax;
+}
+
+inline void MathUtilC::rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                        bool doubleSided, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = rayTriangle(origin, direction, vertices + i * 9, doubleSided);
+    }
+}
+
+inline void MathUtilC::rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                    float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = rayAABB(origin, direction, mins + i * 3, maxs + i * 3);
+    }
+}
+
+inline void MathUtilC::raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                         bool doubleSided, float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = rayTriangle(origins + i * 3, directions + i * 3, vertices, doubleSided);
+    }
+}
+
+inline void MathUtilC::raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                     float* dst)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        dst[i] = rayAABB(origins + i * 3, directions + i * 3, min, max);
+    }
+}
+
 NS_CC_MATH_END
@@ -0,0 +1,278 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <immintrin.h>
+
+// the kernels are compiled for AVX2 and FMA whatever the compiler flags are, MathUtil::isAVX2Enabled() picks them at runtime
+#define CC_MATH_AVX2_TARGET __attribute__((target("avx2,fma")))
+
+NS_CC_MATH_BEGIN
+
+class MathUtilAVX2
+{
+public:
+    CC_MATH_AVX2_TARGET inline static void transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                                              uint32_t count, float w);
+
+    CC_MATH_AVX2_TARGET inline static void multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst);
+
+    CC_MATH_AVX2_TARGET inline static void fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst);
+
+    CC_MATH_AVX2_TARGET inline static bool invertAffineBatch(const float* matrices, uint32_t count, float* dst);
+
+private:
+    // eight consecutive matrices, each register holds one entry of the eight matrices
+    CC_MATH_AVX2_TARGET inline static void loadMatrices(const float* src, __m256 e[16]);
+
+    CC_MATH_AVX2_TARGET inline static void storeMatrices(__m256 e[16], float* dst);
+
+    CC_MATH_AVX2_TARGET inline static void transpose(__m256 r[8]);
+};
+
+inline void MathUtilAVX2::transpose(__m256 r[8])
+{
+    const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    r[0]            = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r[1]            = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r[2]            = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r[3]            = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r[4]            = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r[5]            = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r[6]            = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r[7]            = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+inline void MathUtilAVX2::loadMatrices(const float* src, __m256 e[16])
+{
+    // the first and the last eight entries of each matrix are two 8x8 transposes
+    for (uint32_t k = 0; k < 8; ++k)
+    {
+        e[k]     = _mm256_loadu_ps(src + k * 16);
+        e[k + 8] = _mm256_loadu_ps(src + k * 16 + 8);
+    }
+    transpose(e);
+    transpose(e + 8);
+}
+
+inline void MathUtilAVX2::storeMatrices(__m256 e[16], float* dst)
+{
+    transpose(e);
+    transpose(e + 8);
+    for (uint32_t k = 0; k < 8; ++k)
+    {
+        _mm256_storeu_ps(dst + k * 16, e[k]);
+        _mm256_storeu_ps(dst + k * 16 + 8, e[k + 8]);
+    }
+}
+
+inline void MathUtilAVX2::transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                             uint32_t count, float w)
+{
+    const auto   stride  = static_cast<int>(srcStride);
+    const __m256i offset = _mm256_setr_epi32(0, stride, stride * 2, stride * 3, stride * 4, stride * 5, stride * 6, stride * 7);
+    __m256        rows[3][4];
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        rows[k][0] = _mm256_set1_ps(m[k]);
+        rows[k][1] = _mm256_set1_ps(m[4 + k]);
+        rows[k][2] = _mm256_set1_ps(m[8 + k]);
+        rows[k][3] = _mm256_set1_ps(m[12 + k] * w);
+    }
+    alignas(32) float result[3][8];
+    float             r[3];
+    uint32_t          i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // eight vectors per iteration, the gathers read the components out of the interleaved vertices
+        const auto*  base = reinterpret_cast<const float*>(src + i * srcStride);
+        const __m256 vx   = _mm256_i32gather_ps(base, offset, 1);
+        const __m256 vy   = _mm256_i32gather_ps(base + 1, offset, 1);
+        const __m256 vz   = _mm256_i32gather_ps(base + 2, offset, 1);
+        for (uint32_t k = 0; k < 3; ++k)
+        {
+            _mm256_store_ps(result[k], _mm256_fmadd_ps(vx, rows[k][0], _mm256_fmadd_ps(vy, rows[k][1], _mm256_fmadd_ps(vz, rows[k][2], rows[k][3]))));
+        }
+        for (uint32_t k = 0; k < 8; ++k)
+        {
+            r[0] = result[0][k];
+            r[1] = result[1][k];
+            r[2] = result[2][k];
+            memcpy(dst + (i + k) * dstStride, r, sizeof(r));
+        }
+    }
+    MathUtilC::transformVec3Batch(m, src + i * srcStride, srcStride, dst + i * dstStride, dstStride, count - i, w);
+}
+
+inline void MathUtilAVX2::multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst)
+{
+    // both halves of a register hold the same column of m, so two columns of the product are computed at once
+    const __m256 col0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m));
+    const __m256 col1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 4));
+    const __m256 col2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 8));
+    const __m256 col3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m + 12));
+    for (uint32_t i = 0; i < count * 2; ++i)
+    {
+        const __m256 v = _mm256_loadu_ps(matrices + i * 8);
+        __m256       r = _mm256_mul_ps(col0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+        r              = _mm256_fmadd_ps(col1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+        r              = _mm256_fmadd_ps(col2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+        r              = _mm256_fmadd_ps(col3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3)), r);
+        _mm256_storeu_ps(dst + i * 8, r);
+    }
+}
+
+inline void MathUtilAVX2::fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst)
+{
+    const __m256i quatOffset = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+    const __m256i vecOffset  = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256  zero       = _mm256_setzero_ps();
+    const __m256  one        = _mm256_set1_ps(1.F);
+    __m256        e[16];
+    uint32_t      i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // eight transforms per iteration, each lane holds one transform
+        const float* q  = rotations + i * 4;
+        const float* t  = translations + i * 3;
+        const float* s  = scales + i * 3;
+        const __m256 x  = _mm256_i32gather_ps(q, quatOffset, 4);
+        const __m256 y  = _mm256_i32gather_ps(q + 1, quatOffset, 4);
+        const __m256 z  = _mm256_i32gather_ps(q + 2, quatOffset, 4);
+        const __m256 w  = _mm256_i32gather_ps(q + 3, quatOffset, 4);
+        const __m256 sx = _mm256_i32gather_ps(s, vecOffset, 4);
+        const __m256 sy = _mm256_i32gather_ps(s + 1, vecOffset, 4);
+        const __m256 sz = _mm256_i32gather_ps(s + 2, vecOffset, 4);
+
+        const __m256 x2 = _mm256_add_ps(x, x);
+        const __m256 y2 = _mm256_add_ps(y, y);
+        const __m256 z2 = _mm256_add_ps(z, z);
+        const __m256 xx = _mm256_mul_ps(x, x2);
+        const __m256 xy = _mm256_mul_ps(x, y2);
+        const __m256 xz = _mm256_mul_ps(x, z2);
+        const __m256 yy = _mm256_mul_ps(y, y2);
+        const __m256 yz = _mm256_mul_ps(y, z2);
+        const __m256 zz = _mm256_mul_ps(z, z2);
+        const __m256 wx = _mm256_mul_ps(w, x2);
+        const __m256 wy = _mm256_mul_ps(w, y2);
+        const __m256 wz = _mm256_mul_ps(w, z2);
+
+        e[0]  = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), sx);
+        e[1]  = _mm256_mul_ps(_mm256_add_ps(xy, wz), sx);
+        e[2]  = _mm256_mul_ps(_mm256_sub_ps(xz, wy), sx);
+        e[3]  = zero;
+        e[4]  = _mm256_mul_ps(_mm256_sub_ps(xy, wz), sy);
+        e[5]  = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, zz)), sy);
+        e[6]  = _mm256_mul_ps(_mm256_add_ps(yz, wx), sy);
+        e[7]  = zero;
+        e[8]  = _mm256_mul_ps(_mm256_add_ps(xz, wy), sz);
+        e[9]  = _mm256_mul_ps(_mm256_sub_ps(yz, wx), sz);
+        e[10] = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_add_ps(xx, yy)), sz);
+        e[11] = zero;
+        e[12] = _mm256_i32gather_ps(t, vecOffset, 4);
+        e[13] = _mm256_i32gather_ps(t + 1, vecOffset, 4);
+        e[14] = _mm256_i32gather_ps(t + 2, vecOffset, 4);
+        e[15] = one;
+        storeMatrices(e, dst + i * 16);
+    }
+    MathUtilC::fromRTSBatch(rotations + i * 4, translations + i * 3, scales + i * 3, count - i, dst + i * 16);
+}
+
+inline bool MathUtilAVX2::invertAffineBatch(const float* matrices, uint32_t count, float* dst)
+{
+    const __m256 absMask   = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 tolerance = _mm256_set1_ps(MATH_TOLERANCE);
+    const __m256 zero      = _mm256_setzero_ps();
+    const __m256 one       = _mm256_set1_ps(1.F);
+    __m256       a[16];
+    __m256       e[16];
+    bool         inverted = true;
+    uint32_t     i        = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // eight matrices per iteration, every source entry is loaded before anything is stored
+        loadMatrices(matrices + i * 16, a);
+
+        // the rows of the inverse are the cross products of the columns, divided by the determinant
+        const __m256 r00 = _mm256_fmsub_ps(a[5], a[10], _mm256_mul_ps(a[6], a[9]));
+        const __m256 r01 = _mm256_fmsub_ps(a[6], a[8], _mm256_mul_ps(a[4], a[10]));
+        const __m256 r02 = _mm256_fmsub_ps(a[4], a[9], _mm256_mul_ps(a[5], a[8]));
+        const __m256 r10 = _mm256_fmsub_ps(a[9], a[2], _mm256_mul_ps(a[10], a[1]));
+        const __m256 r11 = _mm256_fmsub_ps(a[10], a[0], _mm256_mul_ps(a[8], a[2]));
+        const __m256 r12 = _mm256_fmsub_ps(a[8], a[1], _mm256_mul_ps(a[9], a[0]));
+        const __m256 r20 = _mm256_fmsub_ps(a[1], a[6], _mm256_mul_ps(a[2], a[5]));
+        const __m256 r21 = _mm256_fmsub_ps(a[2], a[4], _mm256_mul_ps(a[0], a[6]));
+        const __m256 r22 = _mm256_fmsub_ps(a[0], a[5], _mm256_mul_ps(a[1], a[4]));
+
+        const __m256 det        = _mm256_fmadd_ps(a[0], r00, _mm256_fmadd_ps(a[1], r01, _mm256_mul_ps(a[2], r02)));
+        const __m256 invertible = _mm256_cmp_ps(_mm256_and_ps(det, absMask), tolerance, _CMP_GT_OQ);
+        inverted                = inverted && _mm256_movemask_ps(invertible) == 0xFF;
+
+        const __m256 invDet = _mm256_div_ps(one, det);
+        e[0]                = _mm256_mul_ps(r00, invDet);
+        e[1]                = _mm256_mul_ps(r10, invDet);
+        e[2]                = _mm256_mul_ps(r20, invDet);
+        e[3]                = zero;
+        e[4]                = _mm256_mul_ps(r01, invDet);
+        e[5]                = _mm256_mul_ps(r11, invDet);
+        e[6]                = _mm256_mul_ps(r21, invDet);
+        e[7]                = zero;
+        e[8]                = _mm256_mul_ps(r02, invDet);
+        e[9]                = _mm256_mul_ps(r12, invDet);
+        e[10]               = _mm256_mul_ps(r22, invDet);
+        e[11]               = zero;
+        e[12]               = _mm256_sub_ps(zero, _mm256_fmadd_ps(e[0], a[12], _mm256_fmadd_ps(e[4], a[13], _mm256_mul_ps(e[8], a[14]))));
+        e[13]               = _mm256_sub_ps(zero, _mm256_fmadd_ps(e[1], a[12], _mm256_fmadd_ps(e[5], a[13], _mm256_mul_ps(e[9], a[14]))));
+        e[14]               = _mm256_sub_ps(zero, _mm256_fmadd_ps(e[2], a[12], _mm256_fmadd_ps(e[6], a[13], _mm256_mul_ps(e[10], a[14]))));
+        e[15]               = one;
+
+        // the lanes of singular matrices keep the source
+        for (uint32_t k = 0; k < 16; ++k)
+        {
+            e[k] = _mm256_blendv_ps(a[k], e[k], invertible);
+        }
+        storeMatrices(e, dst + i * 16);
+    }
+    const bool tailInverted = MathUtilC::invertAffineBatch(matrices + i * 16, count - i, dst + i * 16);
+    return inverted && tailInverted;
+}
+
+NS_CC_MATH_END
+
+#undef CC_MATH_AVX2_TARGET
@@ -18,6 +18,8 @@
  This file was modified to fit the cocos2d-x project
  */
 
+#include <arm_neon.h>
+
 NS_CC_MATH_BEGIN
 
 class MathUtilNeon64
@@ -42,6 +44,72 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                       const float* extentX, const float* extentY, const float* extentZ,
+                                       uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results);
+
+    inline static void transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                          float* outCenters, float* outExtents);
+
+    inline static void transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                          uint32_t count, float w);
+
+    inline static void multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints);
+
+    inline static void multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst);
+
+    inline static void fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst);
+
+    inline static bool invertAffineBatch(const float* matrices, uint32_t count, float* dst);
+
+    inline static void multiplyQuaternion(const float* q1, const float* q2, float* dst);
+
+    inline static void multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst);
+
+    inline static void slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst);
+
+    inline static void transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst);
+
+    inline static void rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                        bool doubleSided, float* dst);
+
+    inline static void rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                    float* dst);
+
+    inline static void raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                         bool doubleSided, float* dst);
+
+    inline static void raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                     float* dst);
+
+private:
+    // four ray and triangle pairs, each lane holds one pair, the coordinates are [x, y, z] in o, d, a, b and c
+    inline static float32x4_t rayTriangles(const float32x4_t o[3], const float32x4_t d[3], const float32x4_t a[3], const float32x4_t b[3],
+                                           const float32x4_t c[3], bool doubleSided);
+
+    // four ray and box pairs, invDir is the reciprocal of the ray directions
+    inline static float32x4_t rayBoxes(const float32x4_t o[3], const float32x4_t invDir[3], const float32x4_t min[3], const float32x4_t max[3]);
+
+    // std::min and std::max of each lane, a is returned when either operand is NaN
+    inline static float32x4_t minLanes(float32x4_t a, float32x4_t b);
+
+    inline static float32x4_t maxLanes(float32x4_t a, float32x4_t b);
+
+    // four floats read with a stride of stride floats
+    inline static float32x4_t loadStrided(const float* src, uint32_t stride);
+
+    // the structure loads and stores put one quaternion in each lane
+    inline static void normalizeQuaternions(float32x4x4_t& q);
+
+    // one column of four consecutive matrices, the lanes of each register hold one entry of the four matrices
+    inline static float32x4x4_t loadColumns(const float* src);
+
+    inline static void storeColumns(float* dst, const float32x4x4_t& columns);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -262,4 +330,610 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                            const float* extentX, const float* extentY, const float* extentZ,
+                                            uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results)
+{
+    for (uint32_t i = 0; i < count; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(centerX + i);
+        float32x4_t cy = vld1q_f32(centerY + i);
+        float32x4_t cz = vld1q_f32(centerZ + i);
+        float32x4_t ex = vld1q_f32(extentX + i);
+        float32x4_t ey = vld1q_f32(extentY + i);
+        float32x4_t ez = vld1q_f32(extentZ + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            const float* plane = planes + p * 4;
+            float32x4_t dot = vmulq_n_f32(cx, plane[0]);
+            dot             = vfmaq_n_f32(dot, cy, plane[1]);
+            dot             = vfmaq_n_f32(dot, cz, plane[2]);
+            float32x4_t r   = vmulq_n_f32(ex, std::abs(plane[0]));
+            r               = vfmaq_n_f32(r, ey, std::abs(plane[1]));
+            r               = vfmaq_n_f32(r, ez, std::abs(plane[2]));
+            outside         = vorrq_u32(outside, vcltq_f32(vaddq_f32(dot, r), vdupq_n_f32(plane[3])));
+        }
+
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        const uint32_t n = std::min(count - i, 4U);
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            results[i + k] = lanes[k] ? 0 : 1;
+        }
+    }
+}
+
+inline void MathUtilNeon64::transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                               float* outCenters, float* outExtents)
+{
+    float center[4];
+    float extent[4];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // one box per iteration, the lanes hold the x, y, z components
+        const float*      m    = matrices[i];
+        const float*      c    = centers + i * 3;
+        const float*      e    = extents + i * 3;
+        const float32x4_t col0 = vld1q_f32(m);
+        const float32x4_t col1 = vld1q_f32(m + 4);
+        const float32x4_t col2 = vld1q_f32(m + 8);
+        const float32x4_t col3 = vld1q_f32(m + 12);
+
+        float32x4_t wc = vfmaq_n_f32(col3, col0, c[0]);
+        wc             = vfmaq_n_f32(wc, col1, c[1]);
+        wc             = vfmaq_n_f32(wc, col2, c[2]);
+        float32x4_t we = vmulq_n_f32(vabsq_f32(col0), e[0]);
+        we             = vfmaq_n_f32(we, vabsq_f32(col1), e[1]);
+        we             = vfmaq_n_f32(we, vabsq_f32(col2), e[2]);
+        vst1q_f32(center, wc);
+        vst1q_f32(extent, we);
+        memcpy(outCenters + i * 3, center, sizeof(float) * 3);
+        memcpy(outExtents + i * 3, extent, sizeof(float) * 3);
+    }
+}
+
+inline void MathUtilNeon64::transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                               uint32_t count, float w)
+{
+    const float32x4_t col0 = vld1q_f32(m);
+    const float32x4_t col1 = vld1q_f32(m + 4);
+    const float32x4_t col2 = vld1q_f32(m + 8);
+    const float32x4_t col3 = vmulq_n_f32(vld1q_f32(m + 12), w);
+    float             result[4];
+    float             v[3];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // the vectors are interleaved with other attributes, so one vector per iteration
+        memcpy(v, src + i * srcStride, sizeof(v));
+        float32x4_t r = vfmaq_n_f32(col3, col0, v[0]);
+        r             = vfmaq_n_f32(r, col1, v[1]);
+        r             = vfmaq_n_f32(r, col2, v[2]);
+        vst1q_f32(result, r);
+        memcpy(dst + i * dstStride, result, sizeof(float) * 3);
+    }
+}
+
+inline void MathUtilNeon64::multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float*      w    = worlds[i];
+        const float*      b    = bindposes + i * 16;
+        float*            o    = outJoints + i * 12;
+        const float32x4_t col0 = vld1q_f32(w);
+        const float32x4_t col1 = vld1q_f32(w + 4);
+        const float32x4_t col2 = vld1q_f32(w + 8);
+        const float32x4_t col3 = vld1q_f32(w + 12);
+        float32x4_t       r[4];
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const float* bc = b + c * 4;
+            r[c]            = vmulq_n_f32(col0, bc[0]);
+            r[c]            = vfmaq_n_f32(r[c], col1, bc[1]);
+            r[c]            = vfmaq_n_f32(r[c], col2, bc[2]);
+            r[c]            = vfmaq_n_f32(r[c], col3, bc[3]);
+        }
+        // the w lane of the first three columns carries one translation component each
+        vst1q_f32(o, vsetq_lane_f32(vgetq_lane_f32(r[3], 0), r[0], 3));
+        vst1q_f32(o + 4, vsetq_lane_f32(vgetq_lane_f32(r[3], 1), r[1], 3));
+        vst1q_f32(o + 8, vsetq_lane_f32(vgetq_lane_f32(r[3], 2), r[2], 3));
+    }
+}
+
+
+inline float32x4x4_t MathUtilNeon64::loadColumns(const float* src)
+{
+    float32x4x4_t columns;
+    columns.val[0] = vdupq_n_f32(0.F);
+    columns.val[1] = columns.val[0];
+    columns.val[2] = columns.val[0];
+    columns.val[3] = columns.val[0];
+    columns        = vld4q_lane_f32(src, columns, 0);
+    columns        = vld4q_lane_f32(src + 16, columns, 1);
+    columns        = vld4q_lane_f32(src + 32, columns, 2);
+    columns        = vld4q_lane_f32(src + 48, columns, 3);
+    return columns;
+}
+
+inline void MathUtilNeon64::storeColumns(float* dst, const float32x4x4_t& columns)
+{
+    vst4q_lane_f32(dst, columns, 0);
+    vst4q_lane_f32(dst + 16, columns, 1);
+    vst4q_lane_f32(dst + 32, columns, 2);
+    vst4q_lane_f32(dst + 48, columns, 3);
+}
+
+inline void MathUtilNeon64::multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst)
+{
+    const float32x4_t col0 = vld1q_f32(m);
+    const float32x4_t col1 = vld1q_f32(m + 4);
+    const float32x4_t col2 = vld1q_f32(m + 8);
+    const float32x4_t col3 = vld1q_f32(m + 12);
+    for (uint32_t i = 0; i < count * 4; ++i)
+    {
+        // every column of the product only depends on the same column of the source
+        const float32x4_t v = vld1q_f32(matrices + i * 4);
+        float32x4_t       r = vmulq_laneq_f32(col0, v, 0);
+        r                   = vfmaq_laneq_f32(r, col1, v, 1);
+        r                   = vfmaq_laneq_f32(r, col2, v, 2);
+        r                   = vfmaq_laneq_f32(r, col3, v, 3);
+        vst1q_f32(dst + i * 4, r);
+    }
+}
+
+inline void MathUtilNeon64::fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst)
+{
+    const float32x4_t zero = vdupq_n_f32(0.F);
+    const float32x4_t one  = vdupq_n_f32(1.F);
+    uint32_t          i    = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four transforms per iteration, the structure loads put one transform in each lane
+        const float32x4x4_t q = vld4q_f32(rotations + i * 4);
+        const float32x4x3_t t = vld3q_f32(translations + i * 3);
+        const float32x4x3_t s = vld3q_f32(scales + i * 3);
+
+        const float32x4_t x2 = vaddq_f32(q.val[0], q.val[0]);
+        const float32x4_t y2 = vaddq_f32(q.val[1], q.val[1]);
+        const float32x4_t z2 = vaddq_f32(q.val[2], q.val[2]);
+        const float32x4_t xx = vmulq_f32(q.val[0], x2);
+        const float32x4_t xy = vmulq_f32(q.val[0], y2);
+        const float32x4_t xz = vmulq_f32(q.val[0], z2);
+        const float32x4_t yy = vmulq_f32(q.val[1], y2);
+        const float32x4_t yz = vmulq_f32(q.val[1], z2);
+        const float32x4_t zz = vmulq_f32(q.val[2], z2);
+        const float32x4_t wx = vmulq_f32(q.val[3], x2);
+        const float32x4_t wy = vmulq_f32(q.val[3], y2);
+        const float32x4_t wz = vmulq_f32(q.val[3], z2);
+
+        float*        o = dst + i * 16;
+        float32x4x4_t c;
+        c.val[0] = vmulq_f32(vsubq_f32(one, vaddq_f32(yy, zz)), s.val[0]);
+        c.val[1] = vmulq_f32(vaddq_f32(xy, wz), s.val[0]);
+        c.val[2] = vmulq_f32(vsubq_f32(xz, wy), s.val[0]);
+        c.val[3] = zero;
+        storeColumns(o, c);
+        c.val[0] = vmulq_f32(vsubq_f32(xy, wz), s.val[1]);
+        c.val[1] = vmulq_f32(vsubq_f32(one, vaddq_f32(xx, zz)), s.val[1]);
+        c.val[2] = vmulq_f32(vaddq_f32(yz, wx), s.val[1]);
+        storeColumns(o + 4, c);
+        c.val[0] = vmulq_f32(vaddq_f32(xz, wy), s.val[2]);
+        c.val[1] = vmulq_f32(vsubq_f32(yz, wx), s.val[2]);
+        c.val[2] = vmulq_f32(vsubq_f32(one, vaddq_f32(xx, yy)), s.val[2]);
+        storeColumns(o + 8, c);
+        c.val[0] = t.val[0];
+        c.val[1] = t.val[1];
+        c.val[2] = t.val[2];
+        c.val[3] = one;
+        storeColumns(o + 12, c);
+    }
+    MathUtilC::fromRTSBatch(rotations + i * 4, translations + i * 3, scales + i * 3, count - i, dst + i * 16);
+}
+
+inline bool MathUtilNeon64::invertAffineBatch(const float* matrices, uint32_t count, float* dst)
+{
+    const float32x4_t tolerance = vdupq_n_f32(MATH_TOLERANCE);
+    const float32x4_t zero      = vdupq_n_f32(0.F);
+    const float32x4_t one       = vdupq_n_f32(1.F);
+    bool              inverted  = true;
+    uint32_t          i         = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four matrices per iteration, every source entry is loaded before anything is stored
+        const float*        src = matrices + i * 16;
+        const float32x4x4_t a   = loadColumns(src);
+        const float32x4x4_t b   = loadColumns(src + 4);
+        const float32x4x4_t c   = loadColumns(src + 8);
+        const float32x4x4_t t   = loadColumns(src + 12);
+
+        // the rows of the inverse are the cross products of the columns, divided by the determinant
+        float32x4_t r00 = vmlsq_f32(vmulq_f32(b.val[1], c.val[2]), b.val[2], c.val[1]);
+        float32x4_t r01 = vmlsq_f32(vmulq_f32(b.val[2], c.val[0]), b.val[0], c.val[2]);
+        float32x4_t r02 = vmlsq_f32(vmulq_f32(b.val[0], c.val[1]), b.val[1], c.val[0]);
+        float32x4_t r10 = vmlsq_f32(vmulq_f32(c.val[1], a.val[2]), c.val[2], a.val[1]);
+        float32x4_t r11 = vmlsq_f32(vmulq_f32(c.val[2], a.val[0]), c.val[0], a.val[2]);
+        float32x4_t r12 = vmlsq_f32(vmulq_f32(c.val[0], a.val[1]), c.val[1], a.val[0]);
+        float32x4_t r20 = vmlsq_f32(vmulq_f32(a.val[1], b.val[2]), a.val[2], b.val[1]);
+        float32x4_t r21 = vmlsq_f32(vmulq_f32(a.val[2], b.val[0]), a.val[0], b.val[2]);
+        float32x4_t r22 = vmlsq_f32(vmulq_f32(a.val[0], b.val[1]), a.val[1], b.val[0]);
+
+        const float32x4_t det        = vfmaq_f32(vfmaq_f32(vmulq_f32(a.val[0], r00), a.val[1], r01), a.val[2], r02);
+        const uint32x4_t  invertible = vcagtq_f32(det, tolerance);
+        inverted                     = inverted && vminvq_u32(invertible) != 0;
+
+        const float32x4_t invDet = vdivq_f32(one, det);
+        r00                      = vmulq_f32(r00, invDet);
+        r01                      = vmulq_f32(r01, invDet);
+        r02                      = vmulq_f32(r02, invDet);
+        r10                      = vmulq_f32(r10, invDet);
+        r11                      = vmulq_f32(r11, invDet);
+        r12                      = vmulq_f32(r12, invDet);
+        r20                      = vmulq_f32(r20, invDet);
+        r21                      = vmulq_f32(r21, invDet);
+        r22                      = vmulq_f32(r22, invDet);
+
+        // the lanes of singular matrices keep the source
+        float*        o = dst + i * 16;
+        float32x4x4_t column;
+        column.val[0] = vbslq_f32(invertible, r00, a.val[0]);
+        column.val[1] = vbslq_f32(invertible, r10, a.val[1]);
+        column.val[2] = vbslq_f32(invertible, r20, a.val[2]);
+        column.val[3] = vbslq_f32(invertible, zero, a.val[3]);
+        storeColumns(o, column);
+        column.val[0] = vbslq_f32(invertible, r01, b.val[0]);
+        column.val[1] = vbslq_f32(invertible, r11, b.val[1]);
+        column.val[2] = vbslq_f32(invertible, r21, b.val[2]);
+        column.val[3] = vbslq_f32(invertible, zero, b.val[3]);
+        storeColumns(o + 4, column);
+        column.val[0] = vbslq_f32(invertible, r02, c.val[0]);
+        column.val[1] = vbslq_f32(invertible, r12, c.val[1]);
+        column.val[2] = vbslq_f32(invertible, r22, c.val[2]);
+        column.val[3] = vbslq_f32(invertible, zero, c.val[3]);
+        storeColumns(o + 8, column);
+        column.val[0] = vbslq_f32(invertible, vnegq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(r00, t.val[0]), r01, t.val[1]), r02, t.val[2])), t.val[0]);
+        column.val[1] = vbslq_f32(invertible, vnegq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(r10, t.val[0]), r11, t.val[1]), r12, t.val[2])), t.val[1]);
+        column.val[2] = vbslq_f32(invertible, vnegq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(r20, t.val[0]), r21, t.val[1]), r22, t.val[2])), t.val[2]);
+        column.val[3] = vbslq_f32(invertible, one, t.val[3]);
+        storeColumns(o + 12, column);
+    }
+    const bool tailInverted = MathUtilC::invertAffineBatch(matrices + i * 16, count - i, dst + i * 16);
+    return inverted && tailInverted;
+}
+
+
+inline void MathUtilNeon64::normalizeQuaternions(float32x4x4_t& q)
+{
+    const float32x4_t one = vdupq_n_f32(1.F);
+    float32x4_t       n   = vmulq_f32(q.val[0], q.val[0]);
+    n                     = vfmaq_f32(n, q.val[1], q.val[1]);
+    n                     = vfmaq_f32(n, q.val[2], q.val[2]);
+    n                     = vfmaq_f32(n, q.val[3], q.val[3]);
+    n                     = vsqrtq_f32(n);
+    // the lanes too close to zero are kept
+    const float32x4_t scale = vbslq_f32(vcltq_f32(n, vdupq_n_f32(0.000001F)), one, vdivq_f32(one, n));
+    q.val[0]                = vmulq_f32(q.val[0], scale);
+    q.val[1]                = vmulq_f32(q.val[1], scale);
+    q.val[2]                = vmulq_f32(q.val[2], scale);
+    q.val[3]                = vmulq_f32(q.val[3], scale);
+}
+
+inline void MathUtilNeon64::multiplyQuaternion(const float* q1, const float* q2, float* dst)
+{
+    // the product is w1 * q2 plus x1, y1 and z1 times signed permutations of q2
+    static const float signs[12] = {1.F, -1.F, 1.F, -1.F, 1.F, 1.F, -1.F, -1.F, -1.F, 1.F, 1.F, -1.F};
+    const float32x4_t  a         = vld1q_f32(q1);
+    const float32x4_t  b         = vld1q_f32(q2);
+    const float32x4_t  zwxy      = vextq_f32(b, b, 2);
+    const float32x4_t  bx        = vmulq_f32(vrev64q_f32(zwxy), vld1q_f32(signs));
+    const float32x4_t  by        = vmulq_f32(zwxy, vld1q_f32(signs + 4));
+    const float32x4_t  bz        = vmulq_f32(vrev64q_f32(b), vld1q_f32(signs + 8));
+    float32x4_t        r         = vmulq_laneq_f32(b, a, 3);
+    r                            = vfmaq_laneq_f32(r, bx, a, 0);
+    r                            = vfmaq_laneq_f32(r, by, a, 1);
+    r                            = vfmaq_laneq_f32(r, bz, a, 2);
+    vst1q_f32(dst, r);
+}
+
+inline void MathUtilNeon64::multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x4_t a = vld4q_f32(q1 + i * 4);
+        const float32x4x4_t b = vld4q_f32(q2 + i * 4);
+        float32x4x4_t       r;
+        r.val[0] = vmlsq_f32(vfmaq_f32(vfmaq_f32(vmulq_f32(a.val[3], b.val[0]), a.val[0], b.val[3]), a.val[1], b.val[2]), a.val[2], b.val[1]);
+        r.val[1] = vfmaq_f32(vfmaq_f32(vmlsq_f32(vmulq_f32(a.val[3], b.val[1]), a.val[0], b.val[2]), a.val[1], b.val[3]), a.val[2], b.val[0]);
+        r.val[2] = vfmaq_f32(vmlsq_f32(vfmaq_f32(vmulq_f32(a.val[3], b.val[2]), a.val[0], b.val[1]), a.val[1], b.val[0]), a.val[2], b.val[3]);
+        r.val[3] = vmlsq_f32(vmlsq_f32(vmlsq_f32(vmulq_f32(a.val[3], b.val[3]), a.val[0], b.val[0]), a.val[1], b.val[1]), a.val[2], b.val[2]);
+        vst4q_f32(dst + i * 4, r);
+    }
+    MathUtilC::multiplyQuaternionBatch(q1 + i * 4, q2 + i * 4, count - i, dst + i * 4);
+}
+
+inline void MathUtilNeon64::slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    if (t == 0.F || t == 1.F)
+    {
+        memmove(dst, t == 0.F ? from : to, sizeof(float) * 4 * count);
+        return;
+    }
+
+    // the terms that only depend on t are shared by all lanes, see MathUtilC::slerpQuaternion for the approximation
+    const float       bisect = t - 0.5F;
+    const float       halfU  = std::abs(bisect);
+    const float       f2a    = halfU - bisect;
+    const float       f2b    = halfU + bisect;
+    const float       u      = halfU + halfU;
+    const float       f1     = 1.F - u;
+    const float32x4_t sqNotU = vdupq_n_f32(f1 * f1);
+    const float32x4_t sqU    = vdupq_n_f32(u * u);
+    const float32x4_t one    = vdupq_n_f32(1.F);
+    uint32_t          i      = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x4_t a        = vld4q_f32(from + i * 4);
+        const float32x4x4_t b        = vld4q_f32(to + i * 4);
+        float32x4_t         cosTheta = vmulq_f32(a.val[3], b.val[3]);
+        cosTheta                     = vfmaq_f32(cosTheta, a.val[0], b.val[0]);
+        cosTheta                     = vfmaq_f32(cosTheta, a.val[1], b.val[1]);
+        cosTheta                     = vfmaq_f32(cosTheta, a.val[2], b.val[2]);
+
+        // fold theta
+        float32x4_t       alpha = vbslq_f32(vcltzq_f32(cosTheta), vdupq_n_f32(-1.F), one);
+        const float32x4_t halfY = vfmaq_f32(one, alpha, cosTheta);
+
+        // one iteration of Newton to get 1-cos(theta / 2)
+        float32x4_t halfSecHalfTheta = vmlsq_f32(vdupq_n_f32(1.09F), vmlsq_n_f32(vdupq_n_f32(0.476537F), halfY, 0.0903321F), halfY);
+        halfSecHalfTheta             = vmulq_f32(halfSecHalfTheta, vmlsq_f32(vdupq_n_f32(1.5F), vmulq_f32(halfY, halfSecHalfTheta), halfSecHalfTheta));
+        const float32x4_t vers       = vmlsq_f32(one, halfY, halfSecHalfTheta);
+
+        // series expansions of the coefficients
+        const float32x4_t ratio  = vmulq_n_f32(vers, 0.0000440917108F);
+        float32x4_t       ratio1 = vfmaq_f32(vdupq_n_f32(-0.00158730159F), vsubq_f32(sqNotU, vdupq_n_f32(16.F)), ratio);
+        ratio1                   = vfmaq_f32(vdupq_n_f32(0.0333333333F), vmulq_f32(ratio1, vsubq_f32(sqNotU, vdupq_n_f32(9.F))), vers);
+        ratio1                   = vfmaq_f32(vdupq_n_f32(-0.333333333F), vmulq_f32(ratio1, vsubq_f32(sqNotU, vdupq_n_f32(4.F))), vers);
+        ratio1                   = vfmaq_f32(one, vmulq_f32(ratio1, vsubq_f32(sqNotU, one)), vers);
+        float32x4_t ratio2       = vfmaq_f32(vdupq_n_f32(-0.00158730159F), vsubq_f32(sqU, vdupq_n_f32(16.F)), ratio);
+        ratio2                   = vfmaq_f32(vdupq_n_f32(0.0333333333F), vmulq_f32(ratio2, vsubq_f32(sqU, vdupq_n_f32(9.F))), vers);
+        ratio2                   = vfmaq_f32(vdupq_n_f32(-0.333333333F), vmulq_f32(ratio2, vsubq_f32(sqU, vdupq_n_f32(4.F))), vers);
+        ratio2                   = vfmaq_f32(one, vmulq_f32(ratio2, vsubq_f32(sqU, one)), vers);
+
+        // bisect and resolve the folding
+        const float32x4_t c1   = vmulq_n_f32(vmulq_f32(ratio1, halfSecHalfTheta), f1);
+        const float32x4_t beta = vfmaq_n_f32(c1, ratio2, f2b);
+        alpha                  = vmulq_f32(alpha, vfmaq_n_f32(c1, ratio2, f2a));
+
+        float32x4x4_t r;
+        float32x4_t   length = vdupq_n_f32(0.F);
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            r.val[k] = vfmaq_f32(vmulq_f32(alpha, a.val[k]), beta, b.val[k]);
+            length   = vfmaq_f32(length, r.val[k], r.val[k]);
+        }
+
+        // correct the length, equal pairs return from like the scalar path
+        length                 = vmlsq_n_f32(vdupq_n_f32(1.5F), length, 0.5F);
+        const uint32x4_t equal = vandq_u32(vandq_u32(vceqq_f32(a.val[0], b.val[0]), vceqq_f32(a.val[1], b.val[1])),
+                                           vandq_u32(vceqq_f32(a.val[2], b.val[2]), vceqq_f32(a.val[3], b.val[3])));
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            r.val[k] = vbslq_f32(equal, a.val[k], vmulq_f32(r.val[k], length));
+        }
+        vst4q_f32(dst + i * 4, r);
+    }
+    MathUtilC::slerpQuaternionBatch(from + i * 4, to + i * 4, t, count - i, dst + i * 4);
+}
+
+inline void MathUtilNeon64::nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    const float32x4_t t1 = vdupq_n_f32(1.F - t);
+    const float32x4_t t2 = vdupq_n_f32(t);
+    uint32_t          i  = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x4_t a   = vld4q_f32(from + i * 4);
+        const float32x4x4_t b   = vld4q_f32(to + i * 4);
+        float32x4_t         dot = vmulq_f32(a.val[0], b.val[0]);
+        dot                     = vfmaq_f32(dot, a.val[1], b.val[1]);
+        dot                     = vfmaq_f32(dot, a.val[2], b.val[2]);
+        dot                     = vfmaq_f32(dot, a.val[3], b.val[3]);
+        // interpolate towards -to when it is the shorter arc
+        const float32x4_t weight = vbslq_f32(vcltzq_f32(dot), vnegq_f32(t2), t2);
+        float32x4x4_t     r;
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            r.val[k] = vfmaq_f32(vmulq_f32(t1, a.val[k]), weight, b.val[k]);
+        }
+        normalizeQuaternions(r);
+        vst4q_f32(dst + i * 4, r);
+    }
+    MathUtilC::nlerpQuaternionBatch(from + i * 4, to + i * 4, t, count - i, dst + i * 4);
+}
+
+inline void MathUtilNeon64::normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4x4_t q = vld4q_f32(quats + i * 4);
+        normalizeQuaternions(q);
+        vst4q_f32(dst + i * 4, q);
+    }
+    MathUtilC::normalizeQuaternionBatch(quats + i * 4, count - i, dst + i * 4);
+}
+
+inline void MathUtilNeon64::transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst)
+{
+    const float32x4_t qx = vdupq_n_f32(q[0]);
+    const float32x4_t qy = vdupq_n_f32(q[1]);
+    const float32x4_t qz = vdupq_n_f32(q[2]);
+    const float32x4_t qw = vdupq_n_f32(q[3]);
+    uint32_t          i  = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four vectors per iteration, the structure load puts one vector in each lane
+        const float32x4x3_t v = vld3q_f32(vectors + i * 3);
+
+        // calculate quat * vec, iw holds the negated w of the product
+        const float32x4_t ix = vmlsq_f32(vfmaq_f32(vmulq_f32(qw, v.val[0]), qy, v.val[2]), qz, v.val[1]);
+        const float32x4_t iy = vmlsq_f32(vfmaq_f32(vmulq_f32(qw, v.val[1]), qz, v.val[0]), qx, v.val[2]);
+        const float32x4_t iz = vmlsq_f32(vfmaq_f32(vmulq_f32(qw, v.val[2]), qx, v.val[1]), qy, v.val[0]);
+        const float32x4_t iw = vfmaq_f32(vfmaq_f32(vmulq_f32(qx, v.val[0]), qy, v.val[1]), qz, v.val[2]);
+
+        // calculate result * inverse quat
+        float32x4x3_t r;
+        r.val[0] = vfmaq_f32(vmlsq_f32(vfmaq_f32(vmulq_f32(ix, qw), iw, qx), iy, qz), iz, qy);
+        r.val[1] = vfmaq_f32(vmlsq_f32(vfmaq_f32(vmulq_f32(iy, qw), iw, qy), iz, qx), ix, qz);
+        r.val[2] = vfmaq_f32(vmlsq_f32(vfmaq_f32(vmulq_f32(iz, qw), iw, qz), ix, qy), iy, qx);
+        vst3q_f32(dst + i * 3, r);
+    }
+    MathUtilC::transformVec3QuatBatch(q, vectors + i * 3, count - i, dst + i * 3);
+}
+
+inline float32x4_t MathUtilNeon64::minLanes(float32x4_t a, float32x4_t b)
+{
+    return vbslq_f32(vcltq_f32(b, a), b, a);
+}
+
+inline float32x4_t MathUtilNeon64::maxLanes(float32x4_t a, float32x4_t b)
+{
+    return vbslq_f32(vcltq_f32(a, b), b, a);
+}
+
+inline float32x4_t MathUtilNeon64::loadStrided(const float* src, uint32_t stride)
+{
+    float32x4_t r = vld1q_dup_f32(src);
+    r             = vld1q_lane_f32(src + stride, r, 1);
+    r             = vld1q_lane_f32(src + stride * 2, r, 2);
+    return vld1q_lane_f32(src + stride * 3, r, 3);
+}
+
+inline float32x4_t MathUtilNeon64::rayTriangles(const float32x4_t o[3], const float32x4_t d[3], const float32x4_t a[3], const float32x4_t b[3],
+                                                const float32x4_t c[3], bool doubleSided)
+{
+    // same as MathUtilC::rayTriangle, the early outs become negated compares and the lanes that miss are masked to 0
+    const float32x4_t zero   = vdupq_n_f32(0.F);
+    const float32x4_t one    = vdupq_n_f32(1.F);
+    const float32x4_t abx    = vsubq_f32(b[0], a[0]);
+    const float32x4_t aby    = vsubq_f32(b[1], a[1]);
+    const float32x4_t abz    = vsubq_f32(b[2], a[2]);
+    const float32x4_t acx    = vsubq_f32(c[0], a[0]);
+    const float32x4_t acy    = vsubq_f32(c[1], a[1]);
+    const float32x4_t acz    = vsubq_f32(c[2], a[2]);
+    const float32x4_t px     = vsubq_f32(vmulq_f32(d[1], acz), vmulq_f32(d[2], acy));
+    const float32x4_t py     = vsubq_f32(vmulq_f32(d[2], acx), vmulq_f32(d[0], acz));
+    const float32x4_t pz     = vsubq_f32(vmulq_f32(d[0], acy), vmulq_f32(d[1], acx));
+    const float32x4_t det    = vaddq_f32(vaddq_f32(vmulq_f32(abx, px), vmulq_f32(aby, py)), vmulq_f32(abz, pz));
+    uint32x4_t        hit    = vmvnq_u32(vcltq_f32(det, vdupq_n_f32(MATH_EPSILON)));
+    if (doubleSided)
+    {
+        hit = vorrq_u32(hit, vmvnq_u32(vcgtq_f32(det, vdupq_n_f32(-MATH_EPSILON))));
+    }
+    const float32x4_t invDet = vdivq_f32(one, det);
+    const float32x4_t aox    = vsubq_f32(o[0], a[0]);
+    const float32x4_t aoy    = vsubq_f32(o[1], a[1]);
+    const float32x4_t aoz    = vsubq_f32(o[2], a[2]);
+    const float32x4_t u      = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(aox, px), vmulq_f32(aoy, py)), vmulq_f32(aoz, pz)), invDet);
+    hit                      = vandq_u32(hit, vmvnq_u32(vorrq_u32(vcltq_f32(u, zero), vcgtq_f32(u, one))));
+    const float32x4_t qx     = vsubq_f32(vmulq_f32(aoy, abz), vmulq_f32(aoz, aby));
+    const float32x4_t qy     = vsubq_f32(vmulq_f32(aoz, abx), vmulq_f32(aox, abz));
+    const float32x4_t qz     = vsubq_f32(vmulq_f32(aox, aby), vmulq_f32(aoy, abx));
+    const float32x4_t v      = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(d[0], qx), vmulq_f32(d[1], qy)), vmulq_f32(d[2], qz)), invDet);
+    hit                      = vandq_u32(hit, vmvnq_u32(vorrq_u32(vcltq_f32(v, zero), vcgtq_f32(vaddq_f32(u, v), one))));
+    const float32x4_t t      = vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(acx, qx), vmulq_f32(acy, qy)), vmulq_f32(acz, qz)), invDet);
+    return vbslq_f32(vandq_u32(hit, vmvnq_u32(vcltq_f32(t, zero))), t, zero);
+}
+
+inline float32x4_t MathUtilNeon64::rayBoxes(const float32x4_t o[3], const float32x4_t invDir[3], const float32x4_t min[3], const float32x4_t max[3])
+{
+    // same as MathUtilC::rayAABB
+    const float32x4_t tx1  = vmulq_f32(vsubq_f32(min[0], o[0]), invDir[0]);
+    const float32x4_t tx2  = vmulq_f32(vsubq_f32(max[0], o[0]), invDir[0]);
+    const float32x4_t ty1  = vmulq_f32(vsubq_f32(min[1], o[1]), invDir[1]);
+    const float32x4_t ty2  = vmulq_f32(vsubq_f32(max[1], o[1]), invDir[1]);
+    const float32x4_t tz1  = vmulq_f32(vsubq_f32(min[2], o[2]), invDir[2]);
+    const float32x4_t tz2  = vmulq_f32(vsubq_f32(max[2], o[2]), invDir[2]);
+    const float32x4_t tmin = maxLanes(maxLanes(minLanes(tx1, tx2), minLanes(ty1, ty2)), minLanes(tz1, tz2));
+    const float32x4_t tmax = minLanes(minLanes(maxLanes(tx1, tx2), maxLanes(ty1, ty2)), maxLanes(tz1, tz2));
+    const float32x4_t zero = vdupq_n_f32(0.F);
+    const uint32x4_t  hit  = vmvnq_u32(vorrq_u32(vcltq_f32(tmax, zero), vcgtq_f32(tmin, tmax)));
+    return vbslq_f32(hit, vbslq_f32(vcgtq_f32(tmin, zero), tmin, tmax), zero);
+}
+
+inline void MathUtilNeon64::rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                             bool doubleSided, float* dst)
+{
+    const float32x4_t o[3] = {vdupq_n_f32(origin[0]), vdupq_n_f32(origin[1]), vdupq_n_f32(origin[2])};
+    const float32x4_t d[3] = {vdupq_n_f32(direction[0]), vdupq_n_f32(direction[1]), vdupq_n_f32(direction[2])};
+    float32x4_t       corners[9];
+    uint32_t          i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four triangles per iteration, each lane holds one triangle
+        for (uint32_t k = 0; k < 9; ++k)
+        {
+            corners[k] = loadStrided(vertices + i * 9 + k, 9);
+        }
+        vst1q_f32(dst + i, rayTriangles(o, d, corners, corners + 3, corners + 6, doubleSided));
+    }
+    MathUtilC::rayTriangleBatch(origin, direction, vertices + i * 9, count - i, doubleSided, dst + i);
+}
+
+inline void MathUtilNeon64::rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                         float* dst)
+{
+    const float32x4_t o[3]      = {vdupq_n_f32(origin[0]), vdupq_n_f32(origin[1]), vdupq_n_f32(origin[2])};
+    const float32x4_t invDir[3] = {vdupq_n_f32(1.F / direction[0]), vdupq_n_f32(1.F / direction[1]), vdupq_n_f32(1.F / direction[2])};
+    uint32_t          i         = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four boxes per iteration, the structure loads put one box in each lane
+        const float32x4x3_t min = vld3q_f32(mins + i * 3);
+        const float32x4x3_t max = vld3q_f32(maxs + i * 3);
+        vst1q_f32(dst + i, rayBoxes(o, invDir, min.val, max.val));
+    }
+    MathUtilC::rayAABBBatch(origin, direction, mins + i * 3, maxs + i * 3, count - i, dst + i);
+}
+
+inline void MathUtilNeon64::raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                              bool doubleSided, float* dst)
+{
+    float32x4_t corners[9];
+    for (uint32_t k = 0; k < 9; ++k)
+    {
+        corners[k] = vdupq_n_f32(vertices[k]);
+    }
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four rays per iteration, the structure loads put one ray in each lane
+        const float32x4x3_t o = vld3q_f32(origins + i * 3);
+        const float32x4x3_t d = vld3q_f32(directions + i * 3);
+        vst1q_f32(dst + i, rayTriangles(o.val, d.val, corners, corners + 3, corners + 6, doubleSided));
+    }
+    MathUtilC::raysTriangleBatch(origins + i * 3, directions + i * 3, count - i, vertices, doubleSided, dst + i);
+}
+
+inline void MathUtilNeon64::raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                          float* dst)
+{
+    const float32x4_t boxMin[3] = {vdupq_n_f32(min[0]), vdupq_n_f32(min[1]), vdupq_n_f32(min[2])};
+    const float32x4_t boxMax[3] = {vdupq_n_f32(max[0]), vdupq_n_f32(max[1]), vdupq_n_f32(max[2])};
+    const float32x4_t one       = vdupq_n_f32(1.F);
+    uint32_t          i         = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four rays per iteration, the structure loads put one ray in each lane
+        const float32x4x3_t o         = vld3q_f32(origins + i * 3);
+        const float32x4x3_t d         = vld3q_f32(directions + i * 3);
+        const float32x4_t   invDir[3] = {vdivq_f32(one, d.val[0]), vdivq_f32(one, d.val[1]), vdivq_f32(one, d.val[2])};
+        vst1q_f32(dst + i, rayBoxes(o.val, invDir, boxMin, boxMax));
+    }
+    MathUtilC::raysAABBBatch(origins + i * 3, directions + i * 3, count - i, min, max, dst + i);
+}
+
 NS_CC_MATH_END
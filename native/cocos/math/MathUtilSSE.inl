@@ -151,6 +151,718 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+class MathUtilSSE
+{
+public:
+    inline static void aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                       const float* extentX, const float* extentY, const float* extentZ,
+                                       uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results);
+
+    inline static void transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                          float* outCenters, float* outExtents);
+
+    inline static void transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                          uint32_t count, float w);
+
+    inline static void multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints);
+
+    inline static void multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst);
+
+    inline static void fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst);
+
+    inline static bool invertAffineBatch(const float* matrices, uint32_t count, float* dst);
+
+    inline static void multiplyQuaternion(const float* q1, const float* q2, float* dst);
+
+    inline static void multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst);
+
+    inline static void slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst);
+
+    inline static void normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst);
+
+    inline static void transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst);
+
+    inline static void rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                        bool doubleSided, float* dst);
+
+    inline static void rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                    float* dst);
+
+    inline static void raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                         bool doubleSided, float* dst);
+
+    inline static void raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                     float* dst);
+
+private:
+    // four ray and triangle pairs, each lane holds one pair, the coordinates are [x, y, z] in o, d, a, b and c
+    inline static __m128 rayTriangles(const __m128 o[3], const __m128 d[3], const __m128 a[3], const __m128 b[3], const __m128 c[3],
+                                      bool doubleSided);
+
+    // four ray and box pairs, invDir is the reciprocal of the ray directions
+    inline static __m128 rayBoxes(const __m128 o[3], const __m128 invDir[3], const __m128 min[3], const __m128 max[3]);
+
+    // four consecutive quaternions, each register holds one component of the four quaternions
+    inline static void loadQuaternions(const float* src, __m128& x, __m128& y, __m128& z, __m128& w);
+
+    inline static void storeQuaternions(__m128 x, __m128 y, __m128 z, __m128 w, float* dst);
+
+    inline static void normalizeQuaternions(__m128& x, __m128& y, __m128& z, __m128& w);
+
+    // one column of four consecutive matrices, the lanes of each register hold one entry of the four matrices
+    inline static void loadColumns(const float* src, __m128& e0, __m128& e1, __m128& e2, __m128& e3);
+
+    inline static void storeColumns(__m128 e0, __m128 e1, __m128 e2, __m128 e3, float* dst);
+
+    inline static __m128 select(__m128 mask, __m128 a, __m128 b);
+};
+
+inline void MathUtilSSE::aabbPlanesBatch(const float* centerX, const float* centerY, const float* centerZ,
+                                         const float* extentX, const float* extentY, const float* extentZ,
+                                         uint32_t count, const float* planes, uint32_t planeCount, uint8_t* results)
+{
+    uint32_t i = 0;
+#ifdef __AVX__
+    // 8 boxes per iteration, the remaining boxes fall through to the SSE loop
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(centerX + i);
+        __m256 cy = _mm256_loadu_ps(centerY + i);
+        __m256 cz = _mm256_loadu_ps(centerZ + i);
+        __m256 ex = _mm256_loadu_ps(extentX + i);
+        __m256 ey = _mm256_loadu_ps(extentY + i);
+        __m256 ez = _mm256_loadu_ps(extentZ + i);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            const float* plane = planes + p * 4;
+            __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(plane[0])),
+                                                     _mm256_mul_ps(cy, _mm256_set1_ps(plane[1]))),
+                                       _mm256_mul_ps(cz, _mm256_set1_ps(plane[2])));
+            __m256 r   = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(std::abs(plane[0]))),
+                                                     _mm256_mul_ps(ey, _mm256_set1_ps(std::abs(plane[1])))),
+                                       _mm256_mul_ps(ez, _mm256_set1_ps(std::abs(plane[2]))));
+            outside    = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(dot, r), _mm256_set1_ps(plane[3]), _CMP_LT_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(outside);
+        for (uint32_t k = 0; k < 8; ++k)
+        {
+            results[i + k] = (mask & (1 << k)) ? 0 : 1;
+        }
+    }
+#endif
+
+    for (; i < count; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(centerX + i);
+        __m128 cy = _mm_loadu_ps(centerY + i);
+        __m128 cz = _mm_loadu_ps(centerZ + i);
+        __m128 ex = _mm_loadu_ps(extentX + i);
+        __m128 ey = _mm_loadu_ps(extentY + i);
+        __m128 ez = _mm_loadu_ps(extentZ + i);
+
+        __m128 outside = _mm_setzero_ps();
+        for (uint32_t p = 0; p < planeCount; ++p)
+        {
+            const float* plane = planes + p * 4;
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane[0])), _mm_mul_ps(cy, _mm_set1_ps(plane[1]))),
+                                    _mm_mul_ps(cz, _mm_set1_ps(plane[2])));
+            __m128 r   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::abs(plane[0]))), _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane[1])))),
+                                    _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane[2]))));
+            outside    = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dot, r), _mm_set1_ps(plane[3])));
+        }
+
+        const int      mask = _mm_movemask_ps(outside);
+        const uint32_t n    = std::min(count - i, 4U);
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            results[i + k] = (mask & (1 << k)) ? 0 : 1;
+        }
+    }
+}
+
+inline void MathUtilSSE::transformAABBBatch(const float* const* matrices, const float* centers, const float* extents, uint32_t count,
+                                            float* outCenters, float* outExtents)
+{
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    alignas(16) float center[4];
+    alignas(16) float extent[4];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // one box per iteration, the lanes hold the x, y, z components
+        const float* m    = matrices[i];
+        const float* c    = centers + i * 3;
+        const float* e    = extents + i * 3;
+        const __m128 col0 = _mm_loadu_ps(m);
+        const __m128 col1 = _mm_loadu_ps(m + 4);
+        const __m128 col2 = _mm_loadu_ps(m + 8);
+        const __m128 col3 = _mm_loadu_ps(m + 12);
+
+        __m128 wc = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(c[0])), _mm_mul_ps(col1, _mm_set1_ps(c[1]))),
+                               _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(c[2])), col3));
+        __m128 we = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(col0, absMask), _mm_set1_ps(e[0])),
+                                          _mm_mul_ps(_mm_and_ps(col1, absMask), _mm_set1_ps(e[1]))),
+                               _mm_mul_ps(_mm_and_ps(col2, absMask), _mm_set1_ps(e[2])));
+        _mm_store_ps(center, wc);
+        _mm_store_ps(extent, we);
+        memcpy(outCenters + i * 3, center, sizeof(float) * 3);
+        memcpy(outExtents + i * 3, extent, sizeof(float) * 3);
+    }
+}
+
+inline void MathUtilSSE::transformVec3Batch(const float* m, const uint8_t* src, uint32_t srcStride, uint8_t* dst, uint32_t dstStride,
+                                            uint32_t count, float w)
+{
+    const __m128 col0 = _mm_loadu_ps(m);
+    const __m128 col1 = _mm_loadu_ps(m + 4);
+    const __m128 col2 = _mm_loadu_ps(m + 8);
+    const __m128 col3 = _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(w));
+    alignas(16) float result[4];
+    float             v[3];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // the vectors are interleaved with other attributes, so one vector per iteration
+        memcpy(v, src + i * srcStride, sizeof(v));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(v[0])), _mm_mul_ps(col1, _mm_set1_ps(v[1]))),
+                              _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(v[2])), col3));
+        _mm_store_ps(result, r);
+        memcpy(dst + i * dstStride, result, sizeof(float) * 3);
+    }
+}
+
+inline void MathUtilSSE::multiplyJointMatrices(const float* const* worlds, const float* bindposes, uint32_t count, float* outJoints)
+{
+    alignas(16) float translation[4];
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float* w    = worlds[i];
+        const float* b    = bindposes + i * 16;
+        float*       o    = outJoints + i * 12;
+        const __m128 col0 = _mm_loadu_ps(w);
+        const __m128 col1 = _mm_loadu_ps(w + 4);
+        const __m128 col2 = _mm_loadu_ps(w + 8);
+        const __m128 col3 = _mm_loadu_ps(w + 12);
+        for (uint32_t c = 0; c < 4; ++c)
+        {
+            const float* bc = b + c * 4;
+            __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(bc[0])), _mm_mul_ps(col1, _mm_set1_ps(bc[1]))),
+                                  _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(bc[2])), _mm_mul_ps(col3, _mm_set1_ps(bc[3]))));
+            if (c < 3)
+            {
+                // the w lane is overwritten by the translation below
+                _mm_storeu_ps(o + c * 4, r);
+            }
+            else
+            {
+                _mm_store_ps(translation, r);
+            }
+        }
+        o[3]  = translation[0];
+        o[7]  = translation[1];
+        o[11] = translation[2];
+    }
+}
+
+
+inline void MathUtilSSE::loadColumns(const float* src, __m128& e0, __m128& e1, __m128& e2, __m128& e3)
+{
+    e0 = _mm_loadu_ps(src);
+    e1 = _mm_loadu_ps(src + 16);
+    e2 = _mm_loadu_ps(src + 32);
+    e3 = _mm_loadu_ps(src + 48);
+    _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+}
+
+inline void MathUtilSSE::storeColumns(__m128 e0, __m128 e1, __m128 e2, __m128 e3, float* dst)
+{
+    _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+    _mm_storeu_ps(dst, e0);
+    _mm_storeu_ps(dst + 16, e1);
+    _mm_storeu_ps(dst + 32, e2);
+    _mm_storeu_ps(dst + 48, e3);
+}
+
+inline __m128 MathUtilSSE::select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline void MathUtilSSE::multiplyMatrixBatch(const float* m, const float* matrices, uint32_t count, float* dst)
+{
+    const __m128 col0 = _mm_loadu_ps(m);
+    const __m128 col1 = _mm_loadu_ps(m + 4);
+    const __m128 col2 = _mm_loadu_ps(m + 8);
+    const __m128 col3 = _mm_loadu_ps(m + 12);
+    for (uint32_t i = 0; i < count * 4; ++i)
+    {
+        // every column of the product only depends on the same column of the source
+        const __m128 v = _mm_loadu_ps(matrices + i * 4);
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))),
+                                         _mm_mul_ps(col1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)))),
+                              _mm_add_ps(_mm_mul_ps(col2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))),
+                                         _mm_mul_ps(col3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)))));
+        _mm_storeu_ps(dst + i * 4, r);
+    }
+}
+
+inline void MathUtilSSE::fromRTSBatch(const float* rotations, const float* translations, const float* scales, uint32_t count, float* dst)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.F);
+    uint32_t     i    = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four transforms per iteration, each lane holds one transform
+        __m128 x = _mm_loadu_ps(rotations + i * 4);
+        __m128 y = _mm_loadu_ps(rotations + i * 4 + 4);
+        __m128 z = _mm_loadu_ps(rotations + i * 4 + 8);
+        __m128 w = _mm_loadu_ps(rotations + i * 4 + 12);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        const float* t  = translations + i * 3;
+        const float* s  = scales + i * 3;
+        const __m128 sx = _mm_setr_ps(s[0], s[3], s[6], s[9]);
+        const __m128 sy = _mm_setr_ps(s[1], s[4], s[7], s[10]);
+        const __m128 sz = _mm_setr_ps(s[2], s[5], s[8], s[11]);
+
+        const __m128 x2 = _mm_add_ps(x, x);
+        const __m128 y2 = _mm_add_ps(y, y);
+        const __m128 z2 = _mm_add_ps(z, z);
+        const __m128 xx = _mm_mul_ps(x, x2);
+        const __m128 xy = _mm_mul_ps(x, y2);
+        const __m128 xz = _mm_mul_ps(x, z2);
+        const __m128 yy = _mm_mul_ps(y, y2);
+        const __m128 yz = _mm_mul_ps(y, z2);
+        const __m128 zz = _mm_mul_ps(z, z2);
+        const __m128 wx = _mm_mul_ps(w, x2);
+        const __m128 wy = _mm_mul_ps(w, y2);
+        const __m128 wz = _mm_mul_ps(w, z2);
+
+        float* o = dst + i * 16;
+        storeColumns(_mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx), _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+                     _mm_mul_ps(_mm_sub_ps(xz, wy), sx), zero, o);
+        storeColumns(_mm_mul_ps(_mm_sub_ps(xy, wz), sy), _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+                     _mm_mul_ps(_mm_add_ps(yz, wx), sy), zero, o + 4);
+        storeColumns(_mm_mul_ps(_mm_add_ps(xz, wy), sz), _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz), zero, o + 8);
+        storeColumns(_mm_setr_ps(t[0], t[3], t[6], t[9]), _mm_setr_ps(t[1], t[4], t[7], t[10]),
+                     _mm_setr_ps(t[2], t[5], t[8], t[11]), one, o + 12);
+    }
+    MathUtilC::fromRTSBatch(rotations + i * 4, translations + i * 3, scales + i * 3, count - i, dst + i * 16);
+}
+
+inline bool MathUtilSSE::invertAffineBatch(const float* matrices, uint32_t count, float* dst)
+{
+    const __m128 absMask   = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 tolerance = _mm_set1_ps(MATH_TOLERANCE);
+    const __m128 zero      = _mm_setzero_ps();
+    const __m128 one       = _mm_set1_ps(1.F);
+    bool         inverted  = true;
+    uint32_t     i         = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four matrices per iteration, every source entry is loaded before anything is stored
+        const float* src = matrices + i * 16;
+        __m128 a0, a1, a2, a3, b0, b1, b2, b3, c0, c1, c2, c3, t0, t1, t2, t3;
+        loadColumns(src, a0, a1, a2, a3);
+        loadColumns(src + 4, b0, b1, b2, b3);
+        loadColumns(src + 8, c0, c1, c2, c3);
+        loadColumns(src + 12, t0, t1, t2, t3);
+
+        // the rows of the inverse are the cross products of the columns, divided by the determinant
+        __m128 r00 = _mm_sub_ps(_mm_mul_ps(b1, c2), _mm_mul_ps(b2, c1));
+        __m128 r01 = _mm_sub_ps(_mm_mul_ps(b2, c0), _mm_mul_ps(b0, c2));
+        __m128 r02 = _mm_sub_ps(_mm_mul_ps(b0, c1), _mm_mul_ps(b1, c0));
+        __m128 r10 = _mm_sub_ps(_mm_mul_ps(c1, a2), _mm_mul_ps(c2, a1));
+        __m128 r11 = _mm_sub_ps(_mm_mul_ps(c2, a0), _mm_mul_ps(c0, a2));
+        __m128 r12 = _mm_sub_ps(_mm_mul_ps(c0, a1), _mm_mul_ps(c1, a0));
+        __m128 r20 = _mm_sub_ps(_mm_mul_ps(a1, b2), _mm_mul_ps(a2, b1));
+        __m128 r21 = _mm_sub_ps(_mm_mul_ps(a2, b0), _mm_mul_ps(a0, b2));
+        __m128 r22 = _mm_sub_ps(_mm_mul_ps(a0, b1), _mm_mul_ps(a1, b0));
+
+        const __m128 det        = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, r00), _mm_mul_ps(a1, r01)), _mm_mul_ps(a2, r02));
+        const __m128 invertible = _mm_cmpgt_ps(_mm_and_ps(det, absMask), tolerance);
+        inverted                = inverted && _mm_movemask_ps(invertible) == 0xF;
+
+        const __m128 invDet = _mm_div_ps(one, det);
+        r00                 = _mm_mul_ps(r00, invDet);
+        r01                 = _mm_mul_ps(r01, invDet);
+        r02                 = _mm_mul_ps(r02, invDet);
+        r10                 = _mm_mul_ps(r10, invDet);
+        r11                 = _mm_mul_ps(r11, invDet);
+        r12                 = _mm_mul_ps(r12, invDet);
+        r20                 = _mm_mul_ps(r20, invDet);
+        r21                 = _mm_mul_ps(r21, invDet);
+        r22                 = _mm_mul_ps(r22, invDet);
+        const __m128 tx     = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r00, t0), _mm_mul_ps(r01, t1)), _mm_mul_ps(r02, t2)));
+        const __m128 ty     = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r10, t0), _mm_mul_ps(r11, t1)), _mm_mul_ps(r12, t2)));
+        const __m128 tz     = _mm_sub_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(r20, t0), _mm_mul_ps(r21, t1)), _mm_mul_ps(r22, t2)));
+
+        // the lanes of singular matrices keep the source
+        float* o = dst + i * 16;
+        storeColumns(select(invertible, r00, a0), select(invertible, r10, a1), select(invertible, r20, a2), select(invertible, zero, a3), o);
+        storeColumns(select(invertible, r01, b0), select(invertible, r11, b1), select(invertible, r21, b2), select(invertible, zero, b3), o + 4);
+        storeColumns(select(invertible, r02, c0), select(invertible, r12, c1), select(invertible, r22, c2), select(invertible, zero, c3), o + 8);
+        storeColumns(select(invertible, tx, t0), select(invertible, ty, t1), select(invertible, tz, t2), select(invertible, one, t3), o + 12);
+    }
+    const bool tailInverted = MathUtilC::invertAffineBatch(matrices + i * 16, count - i, dst + i * 16);
+    return inverted && tailInverted;
+}
+
+
+inline void MathUtilSSE::loadQuaternions(const float* src, __m128& x, __m128& y, __m128& z, __m128& w)
+{
+    x = _mm_loadu_ps(src);
+    y = _mm_loadu_ps(src + 4);
+    z = _mm_loadu_ps(src + 8);
+    w = _mm_loadu_ps(src + 12);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+inline void MathUtilSSE::storeQuaternions(__m128 x, __m128 y, __m128 z, __m128 w, float* dst)
+{
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(dst, x);
+    _mm_storeu_ps(dst + 4, y);
+    _mm_storeu_ps(dst + 8, z);
+    _mm_storeu_ps(dst + 12, w);
+}
+
+inline void MathUtilSSE::normalizeQuaternions(__m128& x, __m128& y, __m128& z, __m128& w)
+{
+    const __m128 one  = _mm_set1_ps(1.F);
+    const __m128 n    = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+    // the lanes too close to zero are kept
+    const __m128 scale = select(_mm_cmplt_ps(n, _mm_set1_ps(0.000001F)), one, _mm_div_ps(one, n));
+    x                  = _mm_mul_ps(x, scale);
+    y                  = _mm_mul_ps(y, scale);
+    z                  = _mm_mul_ps(z, scale);
+    w                  = _mm_mul_ps(w, scale);
+}
+
+inline void MathUtilSSE::multiplyQuaternion(const float* q1, const float* q2, float* dst)
+{
+    // the product is w1 * q2 plus x1, y1 and z1 times signed permutations of q2
+    const __m128 a  = _mm_loadu_ps(q1);
+    const __m128 b  = _mm_loadu_ps(q2);
+    const __m128 bx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.F, -0.F, 0.F, -0.F));
+    const __m128 by = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.F, 0.F, -0.F, -0.F));
+    const __m128 bz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.F, 0.F, 0.F, -0.F));
+    __m128       r  = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3)), b);
+    r               = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 0, 0)), bx));
+    r               = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 1, 1, 1)), by));
+    r               = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 2, 2)), bz));
+    _mm_storeu_ps(dst, r);
+}
+
+inline void MathUtilSSE::multiplyQuaternionBatch(const float* q1, const float* q2, uint32_t count, float* dst)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x1, y1, z1, w1, x2, y2, z2, w2;
+        loadQuaternions(q1 + i * 4, x1, y1, z1, w1);
+        loadQuaternions(q2 + i * 4, x2, y2, z2, w2);
+        const __m128 x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w1, x2), _mm_mul_ps(x1, w2)), _mm_mul_ps(y1, z2)), _mm_mul_ps(z1, y2));
+        const __m128 y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(w1, y2), _mm_mul_ps(x1, z2)), _mm_mul_ps(y1, w2)), _mm_mul_ps(z1, x2));
+        const __m128 z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(w1, z2), _mm_mul_ps(x1, y2)), _mm_mul_ps(y1, x2)), _mm_mul_ps(z1, w2));
+        const __m128 w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(w1, w2), _mm_mul_ps(x1, x2)), _mm_mul_ps(y1, y2)), _mm_mul_ps(z1, z2));
+        storeQuaternions(x, y, z, w, dst + i * 4);
+    }
+    MathUtilC::multiplyQuaternionBatch(q1 + i * 4, q2 + i * 4, count - i, dst + i * 4);
+}
+
+inline void MathUtilSSE::slerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    if (t == 0.F || t == 1.F)
+    {
+        memmove(dst, t == 0.F ? from : to, sizeof(float) * 4 * count);
+        return;
+    }
+
+    // the terms that only depend on t are shared by all lanes, see MathUtilC::slerpQuaternion for the approximation
+    const float  bisect = t - 0.5F;
+    const float  halfU  = std::abs(bisect);
+    const float  f2a    = halfU - bisect;
+    const float  f2b    = halfU + bisect;
+    const float  u      = halfU + halfU;
+    const float  f1     = 1.F - u;
+    const __m128 sqNotU = _mm_set1_ps(f1 * f1);
+    const __m128 sqU    = _mm_set1_ps(u * u);
+    const __m128 one    = _mm_set1_ps(1.F);
+    uint32_t     i      = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x1, y1, z1, w1, x2, y2, z2, w2;
+        loadQuaternions(from + i * 4, x1, y1, z1, w1);
+        loadQuaternions(to + i * 4, x2, y2, z2, w2);
+        const __m128 cosTheta = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w1, w2), _mm_mul_ps(x1, x2)), _mm_mul_ps(y1, y2)), _mm_mul_ps(z1, z2));
+
+        // fold theta
+        __m128       alpha = select(_mm_cmplt_ps(cosTheta, _mm_setzero_ps()), _mm_set1_ps(-1.F), one);
+        const __m128 halfY = _mm_add_ps(one, _mm_mul_ps(alpha, cosTheta));
+
+        // one iteration of Newton to get 1-cos(theta / 2)
+        __m128 halfSecHalfTheta = _mm_sub_ps(_mm_set1_ps(1.09F), _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(0.476537F), _mm_mul_ps(_mm_set1_ps(0.0903321F), halfY)), halfY));
+        halfSecHalfTheta        = _mm_mul_ps(halfSecHalfTheta, _mm_sub_ps(_mm_set1_ps(1.5F), _mm_mul_ps(_mm_mul_ps(halfY, halfSecHalfTheta), halfSecHalfTheta)));
+        const __m128 vers       = _mm_sub_ps(one, _mm_mul_ps(halfY, halfSecHalfTheta));
+
+        // series expansions of the coefficients
+        const __m128 ratio  = _mm_mul_ps(_mm_set1_ps(0.0000440917108F), vers);
+        __m128       ratio1 = _mm_add_ps(_mm_set1_ps(-0.00158730159F), _mm_mul_ps(_mm_sub_ps(sqNotU, _mm_set1_ps(16.F)), ratio));
+        ratio1              = _mm_add_ps(_mm_set1_ps(0.0333333333F), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(9.F))), vers));
+        ratio1              = _mm_add_ps(_mm_set1_ps(-0.333333333F), _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, _mm_set1_ps(4.F))), vers));
+        ratio1              = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio1, _mm_sub_ps(sqNotU, one)), vers));
+        __m128 ratio2       = _mm_add_ps(_mm_set1_ps(-0.00158730159F), _mm_mul_ps(_mm_sub_ps(sqU, _mm_set1_ps(16.F)), ratio));
+        ratio2              = _mm_add_ps(_mm_set1_ps(0.0333333333F), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(9.F))), vers));
+        ratio2              = _mm_add_ps(_mm_set1_ps(-0.333333333F), _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, _mm_set1_ps(4.F))), vers));
+        ratio2              = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(ratio2, _mm_sub_ps(sqU, one)), vers));
+
+        // bisect and resolve the folding
+        const __m128 c1   = _mm_mul_ps(_mm_set1_ps(f1), _mm_mul_ps(ratio1, halfSecHalfTheta));
+        const __m128 beta = _mm_add_ps(c1, _mm_mul_ps(_mm_set1_ps(f2b), ratio2));
+        alpha             = _mm_mul_ps(alpha, _mm_add_ps(c1, _mm_mul_ps(_mm_set1_ps(f2a), ratio2)));
+
+        __m128 x = _mm_add_ps(_mm_mul_ps(alpha, x1), _mm_mul_ps(beta, x2));
+        __m128 y = _mm_add_ps(_mm_mul_ps(alpha, y1), _mm_mul_ps(beta, y2));
+        __m128 z = _mm_add_ps(_mm_mul_ps(alpha, z1), _mm_mul_ps(beta, z2));
+        __m128 w = _mm_add_ps(_mm_mul_ps(alpha, w1), _mm_mul_ps(beta, w2));
+
+        // correct the length, equal pairs return from like the scalar path
+        const __m128 length = _mm_sub_ps(_mm_set1_ps(1.5F), _mm_mul_ps(_mm_set1_ps(0.5F), _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+        const __m128 equal  = _mm_and_ps(_mm_and_ps(_mm_cmpeq_ps(x1, x2), _mm_cmpeq_ps(y1, y2)), _mm_and_ps(_mm_cmpeq_ps(z1, z2), _mm_cmpeq_ps(w1, w2)));
+        x                   = select(equal, x1, _mm_mul_ps(x, length));
+        y                   = select(equal, y1, _mm_mul_ps(y, length));
+        z                   = select(equal, z1, _mm_mul_ps(z, length));
+        w                   = select(equal, w1, _mm_mul_ps(w, length));
+        storeQuaternions(x, y, z, w, dst + i * 4);
+    }
+    MathUtilC::slerpQuaternionBatch(from + i * 4, to + i * 4, t, count - i, dst + i * 4);
+}
+
+inline void MathUtilSSE::nlerpQuaternionBatch(const float* from, const float* to, float t, uint32_t count, float* dst)
+{
+    const __m128 t1 = _mm_set1_ps(1.F - t);
+    const __m128 t2 = _mm_set1_ps(t);
+    uint32_t     i  = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x1, y1, z1, w1, x2, y2, z2, w2;
+        loadQuaternions(from + i * 4, x1, y1, z1, w1);
+        loadQuaternions(to + i * 4, x2, y2, z2, w2);
+        const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x1, x2), _mm_mul_ps(y1, y2)), _mm_add_ps(_mm_mul_ps(z1, z2), _mm_mul_ps(w1, w2)));
+        // interpolate towards -to when it is the shorter arc
+        const __m128 weight = _mm_xor_ps(t2, _mm_and_ps(dot, _mm_set1_ps(-0.F)));
+        __m128       x      = _mm_add_ps(_mm_mul_ps(t1, x1), _mm_mul_ps(weight, x2));
+        __m128       y      = _mm_add_ps(_mm_mul_ps(t1, y1), _mm_mul_ps(weight, y2));
+        __m128       z      = _mm_add_ps(_mm_mul_ps(t1, z1), _mm_mul_ps(weight, z2));
+        __m128       w      = _mm_add_ps(_mm_mul_ps(t1, w1), _mm_mul_ps(weight, w2));
+        normalizeQuaternions(x, y, z, w);
+        storeQuaternions(x, y, z, w, dst + i * 4);
+    }
+    MathUtilC::nlerpQuaternionBatch(from + i * 4, to + i * 4, t, count - i, dst + i * 4);
+}
+
+inline void MathUtilSSE::normalizeQuaternionBatch(const float* quats, uint32_t count, float* dst)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x, y, z, w;
+        loadQuaternions(quats + i * 4, x, y, z, w);
+        normalizeQuaternions(x, y, z, w);
+        storeQuaternions(x, y, z, w, dst + i * 4);
+    }
+    MathUtilC::normalizeQuaternionBatch(quats + i * 4, count - i, dst + i * 4);
+}
+
+inline void MathUtilSSE::transformVec3QuatBatch(const float* q, const float* vectors, uint32_t count, float* dst)
+{
+    const __m128 qx = _mm_set1_ps(q[0]);
+    const __m128 qy = _mm_set1_ps(q[1]);
+    const __m128 qz = _mm_set1_ps(q[2]);
+    const __m128 qw = _mm_set1_ps(q[3]);
+    alignas(16) float rx[4];
+    alignas(16) float ry[4];
+    alignas(16) float rz[4];
+    uint32_t          i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four vectors per iteration, each lane holds one vector
+        const float* v = vectors + i * 3;
+        const __m128 x = _mm_setr_ps(v[0], v[3], v[6], v[9]);
+        const __m128 y = _mm_setr_ps(v[1], v[4], v[7], v[10]);
+        const __m128 z = _mm_setr_ps(v[2], v[5], v[8], v[11]);
+
+        // calculate quat * vec
+        const __m128 ix = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, x), _mm_mul_ps(qy, z)), _mm_mul_ps(qz, y));
+        const __m128 iy = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, y), _mm_mul_ps(qz, x)), _mm_mul_ps(qx, z));
+        const __m128 iz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, z), _mm_mul_ps(qx, y)), _mm_mul_ps(qy, x));
+        const __m128 iw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, x), _mm_mul_ps(qy, y)), _mm_mul_ps(qz, z));
+
+        // calculate result * inverse quat, iw holds the negated w of the product
+        _mm_store_ps(rx, _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(ix, qw), _mm_mul_ps(iw, qx)), _mm_mul_ps(iy, qz)), _mm_mul_ps(iz, qy)));
+        _mm_store_ps(ry, _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(iy, qw), _mm_mul_ps(iw, qy)), _mm_mul_ps(iz, qx)), _mm_mul_ps(ix, qz)));
+        _mm_store_ps(rz, _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(iz, qw), _mm_mul_ps(iw, qz)), _mm_mul_ps(ix, qy)), _mm_mul_ps(iy, qx)));
+        float* o = dst + i * 3;
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            o[k * 3]     = rx[k];
+            o[k * 3 + 1] = ry[k];
+            o[k * 3 + 2] = rz[k];
+        }
+    }
+    MathUtilC::transformVec3QuatBatch(q, vectors + i * 3, count - i, dst + i * 3);
+}
+
+inline __m128 MathUtilSSE::rayTriangles(const __m128 o[3], const __m128 d[3], const __m128 a[3], const __m128 b[3], const __m128 c[3],
+                                        bool doubleSided)
+{
+    // same as MathUtilC::rayTriangle, the early outs become negated compares and the lanes that miss are masked to 0
+    const __m128 zero   = _mm_setzero_ps();
+    const __m128 one    = _mm_set1_ps(1.F);
+    const __m128 abx    = _mm_sub_ps(b[0], a[0]);
+    const __m128 aby    = _mm_sub_ps(b[1], a[1]);
+    const __m128 abz    = _mm_sub_ps(b[2], a[2]);
+    const __m128 acx    = _mm_sub_ps(c[0], a[0]);
+    const __m128 acy    = _mm_sub_ps(c[1], a[1]);
+    const __m128 acz    = _mm_sub_ps(c[2], a[2]);
+    const __m128 px     = _mm_sub_ps(_mm_mul_ps(d[1], acz), _mm_mul_ps(d[2], acy));
+    const __m128 py     = _mm_sub_ps(_mm_mul_ps(d[2], acx), _mm_mul_ps(d[0], acz));
+    const __m128 pz     = _mm_sub_ps(_mm_mul_ps(d[0], acy), _mm_mul_ps(d[1], acx));
+    const __m128 det    = _mm_add_ps(_mm_add_ps(_mm_mul_ps(abx, px), _mm_mul_ps(aby, py)), _mm_mul_ps(abz, pz));
+    __m128       hit    = _mm_cmpnlt_ps(det, _mm_set1_ps(MATH_EPSILON));
+    if (doubleSided)
+    {
+        hit = _mm_or_ps(hit, _mm_cmpngt_ps(det, _mm_set1_ps(-MATH_EPSILON)));
+    }
+    const __m128 invDet = _mm_div_ps(one, det);
+    const __m128 aox    = _mm_sub_ps(o[0], a[0]);
+    const __m128 aoy    = _mm_sub_ps(o[1], a[1]);
+    const __m128 aoz    = _mm_sub_ps(o[2], a[2]);
+    const __m128 u      = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aox, px), _mm_mul_ps(aoy, py)), _mm_mul_ps(aoz, pz)), invDet);
+    hit                 = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(u, zero), _mm_cmpngt_ps(u, one)));
+    const __m128 qx     = _mm_sub_ps(_mm_mul_ps(aoy, abz), _mm_mul_ps(aoz, aby));
+    const __m128 qy     = _mm_sub_ps(_mm_mul_ps(aoz, abx), _mm_mul_ps(aox, abz));
+    const __m128 qz     = _mm_sub_ps(_mm_mul_ps(aox, aby), _mm_mul_ps(aoy, abx));
+    const __m128 v      = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d[0], qx), _mm_mul_ps(d[1], qy)), _mm_mul_ps(d[2], qz)), invDet);
+    hit                 = _mm_and_ps(hit, _mm_and_ps(_mm_cmpnlt_ps(v, zero), _mm_cmpngt_ps(_mm_add_ps(u, v), one)));
+    const __m128 t      = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(acx, qx), _mm_mul_ps(acy, qy)), _mm_mul_ps(acz, qz)), invDet);
+    return _mm_and_ps(_mm_and_ps(hit, _mm_cmpnlt_ps(t, zero)), t);
+}
+
+inline __m128 MathUtilSSE::rayBoxes(const __m128 o[3], const __m128 invDir[3], const __m128 min[3], const __m128 max[3])
+{
+    // same as MathUtilC::rayAABB, std::min(a, b) is _mm_min_ps(b, a) and std::max(a, b) is _mm_max_ps(b, a) for NaNs too
+    const __m128 tx1  = _mm_mul_ps(_mm_sub_ps(min[0], o[0]), invDir[0]);
+    const __m128 tx2  = _mm_mul_ps(_mm_sub_ps(max[0], o[0]), invDir[0]);
+    const __m128 ty1  = _mm_mul_ps(_mm_sub_ps(min[1], o[1]), invDir[1]);
+    const __m128 ty2  = _mm_mul_ps(_mm_sub_ps(max[1], o[1]), invDir[1]);
+    const __m128 tz1  = _mm_mul_ps(_mm_sub_ps(min[2], o[2]), invDir[2]);
+    const __m128 tz2  = _mm_mul_ps(_mm_sub_ps(max[2], o[2]), invDir[2]);
+    const __m128 tmin = _mm_max_ps(_mm_min_ps(tz2, tz1), _mm_max_ps(_mm_min_ps(ty2, ty1), _mm_min_ps(tx2, tx1)));
+    const __m128 tmax = _mm_min_ps(_mm_max_ps(tz2, tz1), _mm_min_ps(_mm_max_ps(ty2, ty1), _mm_max_ps(tx2, tx1)));
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 hit  = _mm_and_ps(_mm_cmpnlt_ps(tmax, zero), _mm_cmpngt_ps(tmin, tmax));
+    return _mm_and_ps(hit, select(_mm_cmpgt_ps(tmin, zero), tmin, tmax));
+}
+
+inline void MathUtilSSE::rayTriangleBatch(const float* origin, const float* direction, const float* vertices, uint32_t count,
+                                          bool doubleSided, float* dst)
+{
+    const __m128 o[3] = {_mm_set1_ps(origin[0]), _mm_set1_ps(origin[1]), _mm_set1_ps(origin[2])};
+    const __m128 d[3] = {_mm_set1_ps(direction[0]), _mm_set1_ps(direction[1]), _mm_set1_ps(direction[2])};
+    __m128       corners[9];
+    uint32_t     i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four triangles per iteration, each lane holds one triangle
+        const float* v = vertices + i * 9;
+        for (int k = 0; k < 9; ++k)
+        {
+            corners[k] = _mm_setr_ps(v[k], v[9 + k], v[18 + k], v[27 + k]);
+        }
+        _mm_storeu_ps(dst + i, rayTriangles(o, d, corners, corners + 3, corners + 6, doubleSided));
+    }
+    MathUtilC::rayTriangleBatch(origin, direction, vertices + i * 9, count - i, doubleSided, dst + i);
+}
+
+inline void MathUtilSSE::rayAABBBatch(const float* origin, const float* direction, const float* mins, const float* maxs, uint32_t count,
+                                      float* dst)
+{
+    const __m128 o[3]      = {_mm_set1_ps(origin[0]), _mm_set1_ps(origin[1]), _mm_set1_ps(origin[2])};
+    const __m128 invDir[3] = {_mm_set1_ps(1.F / direction[0]), _mm_set1_ps(1.F / direction[1]), _mm_set1_ps(1.F / direction[2])};
+    __m128       min[3];
+    __m128       max[3];
+    uint32_t     i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four boxes per iteration, each lane holds one box
+        const float* lo = mins + i * 3;
+        const float* hi = maxs + i * 3;
+        for (int k = 0; k < 3; ++k)
+        {
+            min[k] = _mm_setr_ps(lo[k], lo[3 + k], lo[6 + k], lo[9 + k]);
+            max[k] = _mm_setr_ps(hi[k], hi[3 + k], hi[6 + k], hi[9 + k]);
+        }
+        _mm_storeu_ps(dst + i, rayBoxes(o, invDir, min, max));
+    }
+    MathUtilC::rayAABBBatch(origin, direction, mins + i * 3, maxs + i * 3, count - i, dst + i);
+}
+
+inline void MathUtilSSE::raysTriangleBatch(const float* origins, const float* directions, uint32_t count, const float* vertices,
+                                           bool doubleSided, float* dst)
+{
+    __m128 corners[9];
+    for (int k = 0; k < 9; ++k)
+    {
+        corners[k] = _mm_set1_ps(vertices[k]);
+    }
+    __m128   o[3];
+    __m128   d[3];
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four rays per iteration, each lane holds one ray
+        const float* ro = origins + i * 3;
+        const float* rd = directions + i * 3;
+        for (int k = 0; k < 3; ++k)
+        {
+            o[k] = _mm_setr_ps(ro[k], ro[3 + k], ro[6 + k], ro[9 + k]);
+            d[k] = _mm_setr_ps(rd[k], rd[3 + k], rd[6 + k], rd[9 + k]);
+        }
+        _mm_storeu_ps(dst + i, rayTriangles(o, d, corners, corners + 3, corners + 6, doubleSided));
+    }
+    MathUtilC::raysTriangleBatch(origins + i * 3, directions + i * 3, count - i, vertices, doubleSided, dst + i);
+}
+
+inline void MathUtilSSE::raysAABBBatch(const float* origins, const float* directions, uint32_t count, const float* min, const float* max,
+                                       float* dst)
+{
+    const __m128 boxMin[3] = {_mm_set1_ps(min[0]), _mm_set1_ps(min[1]), _mm_set1_ps(min[2])};
+    const __m128 boxMax[3] = {_mm_set1_ps(max[0]), _mm_set1_ps(max[1]), _mm_set1_ps(max[2])};
+    const __m128 one       = _mm_set1_ps(1.F);
+    __m128       o[3];
+    __m128       invDir[3];
+    uint32_t     i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // four rays per iteration, each lane holds one ray
+        const float* ro = origins + i * 3;
+        const float* rd = directions + i * 3;
+        for (int k = 0; k < 3; ++k)
+        {
+            o[k]      = _mm_setr_ps(ro[k], ro[3 + k], ro[6 + k], ro[9 + k]);
+            invDir[k] = _mm_div_ps(one, _mm_setr_ps(rd[k], rd[3 + k], rd[6 + k], rd[9 + k]));
+        }
+        _mm_storeu_ps(dst + i, rayBoxes(o, invDir, boxMin, boxMax));
+    }
+    MathUtilC::raysAABBBatch(origins + i * 3, directions + i * 3, count - i, min, max, dst + i);
+}
+
 #endif
 
 
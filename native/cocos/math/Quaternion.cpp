@@ -27,6 +27,7 @@
 #include "base/Macros.h"
 #include "math/Mat3.h"
 #include "math/Math.h"
+#include "math/MathUtil.h"
 #include "math/Utils.h"
 
 NS_CC_MATH_BEGIN
@@ -147,16 +148,7 @@ void Quaternion::multiply(const Quaternion &q) {
 
 void Quaternion::multiply(const Quaternion &q1, const Quaternion &q2, Quaternion *dst) {
     GP_ASSERT(dst);
-
-    float x = q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y;
-    float y = q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x;
-    float z = q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w;
-    float w = q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z;
-
-    dst->x = x;
-    dst->y = y;
-    dst->z = z;
-    dst->w = w;
+    MathUtil::multiplyQuaternion(&q1.x, &q2.x, &dst->x);
 }
 
 void Quaternion::normalize() {
@@ -384,111 +376,17 @@ void Quaternion::fromMat3(const Mat3 &m, Quaternion *out) {
 }
 
 void Quaternion::slerp(float q1x, float q1y, float q1z, float q1w, float q2x, float q2y, float q2z, float q2w, float t, float *dstx, float *dsty, float *dstz, float *dstw) {
-    // Fast slerp implementation by kwhatmough:
-    // It contains no division operations, no trig, no inverse trig
-    // and no sqrt. Not only does this code tolerate small constraint
-    // errors in the input quaternions, it actually corrects for them.
     GP_ASSERT(dstx && dsty && dstz && dstw);
     GP_ASSERT(!(t < 0.F || t > 1.F));
 
-    if (t == 0.F) {
-        *dstx = q1x;
-        *dsty = q1y;
-        *dstz = q1z;
-        *dstw = q1w;
-        return;
-    }
-
-    if (t == 1.F) {
-        *dstx = q2x;
-        *dsty = q2y;
-        *dstz = q2z;
-        *dstw = q2w;
-        return;
-    }
-
-    if (q1x == q2x && q1y == q2y && q1z == q2z && q1w == q2w) {
-        *dstx = q1x;
-        *dsty = q1y;
-        *dstz = q1z;
-        *dstw = q1w;
-        return;
-    }
-
-    float halfY;
-    float alpha;
-    float beta;
-
-    float u;
-    float f1;
-    float f2a;
-    float f2b;
-
-    float ratio1;
-    float ratio2;
-
-    float halfSecHalfTheta;
-    float versHalfTheta;
-
-    float sqNotU;
-    float sqU;
-
-    float cosTheta = q1w * q2w + q1x * q2x + q1y * q2y + q1z * q2z;
-
-    // As usual in all slerp implementations, we fold theta.
-    alpha = cosTheta >= 0 ? 1.F : -1.F;
-    halfY = 1.F + alpha * cosTheta;
-
-    // Here we bisect the interval, so we need to fold t as well.
-    f2b = t - 0.5F;
-    u   = f2b >= 0 ? f2b : -f2b;
-    f2a = u - f2b;
-    f2b += u;
-    u += u;
-    f1 = 1.F - u;
-
-    // One iteration of Newton to get 1-cos(theta / 2) to good accuracy.
-    halfSecHalfTheta = 1.09F - (0.476537F - 0.0903321F * halfY) * halfY;
-    halfSecHalfTheta *= 1.5F - halfY * halfSecHalfTheta * halfSecHalfTheta;
-    versHalfTheta = 1.F - halfY * halfSecHalfTheta;
-
-    // Evaluate series expansions of the coefficients.
-    sqNotU = f1 * f1;
-    ratio2 = 0.0000440917108F * versHalfTheta;
-    ratio1 = -0.00158730159F + (sqNotU - 16.F) * ratio2;
-    ratio1 = 0.0333333333F + ratio1 * (sqNotU - 9.F) * versHalfTheta;
-    ratio1 = -0.333333333F + ratio1 * (sqNotU - 4.F) * versHalfTheta;
-    ratio1 = 1.F + ratio1 * (sqNotU - 1.F) * versHalfTheta;
-
-    sqU    = u * u;
-    ratio2 = -0.00158730159F + (sqU - 16.F) * ratio2;
-    ratio2 = 0.0333333333F + ratio2 * (sqU - 9.F) * versHalfTheta;
-    ratio2 = -0.333333333F + ratio2 * (sqU - 4.F) * versHalfTheta;
-    ratio2 = 1.F + ratio2 * (sqU - 1.F) * versHalfTheta;
-
-    // Perform the bisection and resolve the folding done earlier.
-    f1 *= ratio1 * halfSecHalfTheta;
-    f2a *= ratio2;
-    f2b *= ratio2;
-    alpha *= f1 + f2a;
-    beta = f1 + f2b;
-
-    // Apply final coefficients to a and b as usual.
-    float w = alpha * q1w + beta * q2w;
-    float x = alpha * q1x + beta * q2x;
-    float y = alpha * q1y + beta * q2y;
-    float z = alpha * q1z + beta * q2z;
-
-    // This final adjustment to the quaternion's length corrects for
-    // any small constraint error in the inputs q1 and q2 But as you
-    // can see, it comes at the cost of 9 additional multiplication
-    // operations. If this error-correcting feature is not required,
-    // the following code may be removed.
-    f1    = 1.5F - 0.5F * (w * w + x * x + y * y + z * z);
-    *dstw = w * f1;
-    *dstx = x * f1;
-    *dsty = y * f1;
-    *dstz = z * f1;
+    const float q1[4] = {q1x, q1y, q1z, q1w};
+    const float q2[4] = {q2x, q2y, q2z, q2w};
+    float       dst[4];
+    MathUtil::slerpQuaternion(q1, q2, t, dst);
+    *dstx = dst[0];
+    *dsty = dst[1];
+    *dstz = dst[2];
+    *dstw = dst[3];
 }
 
 void Quaternion::slerpForSquad(const Quaternion &q1, const Quaternion &q2, float t, Quaternion *dst) {
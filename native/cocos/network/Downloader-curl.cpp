@@ -28,10 +28,13 @@
 
 #include <curl/curl.h>
 #include <string.h>
+#include <algorithm>
+#include <chrono>
 #include <thread>
 
 #include "application/ApplicationManager.h"
 #include "base/Scheduler.h"
+#include "base/std/container/array.h"
 #include "base/std/container/deque.h"
 #include "base/std/container/set.h"
 #include "base/std/container/vector.h"
@@ -48,9 +51,44 @@
     #define CC_CURL_POLL_TIMEOUT_MS 50
 #endif
 
+// range requests sent for one task after its transfer broke, before reporting the error
+#ifndef CC_CURL_MAX_RESUME_COUNT
+    #define CC_CURL_MAX_RESUME_COUNT 3
+#endif
+
 namespace cc {
 namespace network {
 
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t PRIORITY_COUNT = DownloadTask::PRIORITY_HIGH + 1;
+
+static float secondsSince(const Clock::time_point &start, const Clock::time_point &end) {
+    return std::chrono::duration<float>(end - start).count();
+}
+
+// scheme://[user@]host[:port]/path, the host with port is used as connection key
+static ccstd::string getHostFromURL(const ccstd::string &url) {
+    size_t begin = url.find("://");
+    begin        = ccstd::string::npos == begin ? 0 : begin + 3;
+    size_t end   = url.find_first_of("/?#", begin);
+    auto   host  = url.substr(begin, ccstd::string::npos == end ? ccstd::string::npos : end - begin);
+    size_t at    = host.find('@');
+    return ccstd::string::npos == at ? host : host.substr(at + 1);
+}
+
+// header names are lower case in HTTP/2
+static bool acceptsRanges(const ccstd::string &header) {
+    ccstd::string lower(header);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    return ccstd::string::npos != lower.find("accept-ranges: bytes");
+}
+
+static bool isResumableError(CURLcode code) {
+    return CURLE_PARTIAL_FILE == code || CURLE_OPERATION_TIMEDOUT == code || CURLE_RECV_ERROR == code ||
+           CURLE_GOT_NOTHING == code || CURLE_SEND_ERROR == code;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //  Implementation DownloadTaskCURL
 
@@ -66,7 +104,8 @@ public:
 
     DownloadTaskCURL()
     : serialId(_sSerialId++),
-      _fp(nullptr) {
+      _fp(nullptr),
+      _queuedTime(Clock::now()) {
         _initInternal();
         DLLOG("Construct DownloadTaskCURL %p", this);
     }
@@ -159,7 +198,14 @@ public:
 
     size_t writeDataProc(unsigned char *buffer, size_t size, size_t count) {
         std::lock_guard<std::mutex> lock(_mutex);
-        size_t                      ret = 0;
+        if (!_responseChecked) {
+            _responseChecked = true;
+            if (!checkResponseProc()) {
+                return 0;
+            }
+        }
+
+        size_t ret = 0;
         if (_fp) {
             ret = fwrite(buffer, size, count, _fp);
         } else {
@@ -178,12 +224,62 @@ public:
         return ret;
     }
 
+    // called with _mutex locked, before the first body bytes of a content request are written
+    bool checkResponseProc() {
+        long httpResponseCode = 0;
+        curl_easy_getinfo(_handle, CURLINFO_RESPONSE_CODE, &httpResponseCode);
+
+        // the server ignored the range, or local data can't be resumed, start over
+        if (_resuming ? 206 != httpResponseCode : _hasLocalData) {
+            _hasLocalData       = false;
+            _totalBytesReceived = 0;
+            _startBytes         = 0;
+            _buf.resize(0);
+            if (_fp) {
+                fclose(_fp);
+                _fp = fopen(FileUtils::getInstance()->getSuitableFOpen(_tempFileName).c_str(), "wb");
+                if (nullptr == _fp) {
+                    _errCode         = DownloadTask::ERROR_FILE_OP_FAILED;
+                    _errCodeInternal = 0;
+                    _errDescription  = "Can't reopen file:";
+                    _errDescription.append(_tempFileName);
+                    return false;
+                }
+            }
+        }
+
+        if (_totalBytesExpected <= 0) {
+            double contentLen = 0;
+            if (CURLE_OK == curl_easy_getinfo(_handle, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &contentLen) && contentLen > 0) {
+                _totalBytesExpected = _totalBytesReceived + static_cast<int64_t>(contentLen);
+            }
+        }
+        return true;
+    }
+
 private:
     friend class DownloaderCURL;
 
     // for lock object instance
     std::mutex _mutex;
 
+    // scheduling, _priority is guarded by the request queue mutex
+    int           _priority{DownloadTask::PRIORITY_NORMAL};
+    ccstd::string _host;
+
+    // content request state, only used in thread proc
+    CURL *   _handle{nullptr};
+    bool     _resuming{false};
+    bool     _hasLocalData{false};
+    bool     _responseChecked{false};
+    uint32_t _resumeCount{0U};
+    int64_t  _startBytes{0};
+
+    // stats
+    Clock::time_point _queuedTime;
+    Clock::time_point _startTime;
+    DownloadTaskStats _stats;
+
     // header info
     bool    _acceptRanges;
     bool    _headerAchieved;
@@ -214,6 +310,11 @@ private:
         _totalBytesExpected = (0);
         _errCode            = (DownloadTask::ERROR_NO_ERROR);
         _errCodeInternal    = (CURLE_OK);
+        _resuming           = false;
+        _hasLocalData       = false;
+        _responseChecked    = false;
+        _resumeCount        = 0U;
+        _startBytes         = 0;
         _header.resize(0);
         _header.reserve(384); // pre alloc header string buffer
     }
@@ -243,7 +344,7 @@ public:
     void addTask(std::shared_ptr<const DownloadTask> task, DownloadTaskCURL *coTask) {
         if (DownloadTask::ERROR_NO_ERROR == coTask->_errCode) {
             std::lock_guard<std::mutex> lock(_requestMutex);
-            _requestQueue.push_back(make_pair(task, coTask));
+            _requestQueues[coTask->_priority].push_back(make_pair(task, coTask));
         } else {
             std::lock_guard<std::mutex> lock(_finishedMutex);
             _finishedQueue.push_back(make_pair(task, coTask));
@@ -276,6 +377,22 @@ public:
         outList.insert(outList.end(), _processSet.begin(), _processSet.end());
     }
 
+    void setPriority(DownloadTaskCURL *coTask, int priority) {
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        if (coTask->_priority == priority) {
+            return;
+        }
+
+        auto &queue = _requestQueues[coTask->_priority];
+        auto  iter  = std::find_if(queue.begin(), queue.end(), [coTask](const TaskWrapper &wrapper) { return wrapper.second == coTask; });
+
+        coTask->_priority = priority;
+        if (queue.end() != iter) {
+            _requestQueues[priority].push_back(*iter);
+            queue.erase(iter);
+        }
+    }
+
     void getFinishedTasks(ccstd::vector<TaskWrapper> &outList) {
         std::lock_guard<std::mutex> lock(_finishedMutex);
         outList.reserve(_finishedQueue.size());
@@ -304,8 +421,8 @@ private:
     // the curl handle destroyed in _threadProc
     // handle inited for get header
     void _initCurlHandleProc(CURL *handle, TaskWrapper &wrapper, bool forContent = false) {
-        const DownloadTask &    task   = *wrapper.first;
-        const DownloadTaskCURL *coTask = wrapper.second;
+        const DownloadTask &task   = *wrapper.first;
+        DownloadTaskCURL *  coTask = wrapper.second;
 
         // set url
         curl_easy_setopt(handle, CURLOPT_URL, task.requestURL.c_str());
@@ -326,9 +443,22 @@ private:
         curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
 
         if (forContent) {
+            // keep headers to find out whether a broken transfer can be resumed
+            curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, DownloaderCURL::Impl::_outputHeaderCallbackProc);
+            curl_easy_setopt(handle, CURLOPT_HEADERDATA, coTask);
+
+            std::lock_guard<std::mutex> lock(coTask->_mutex);
+            coTask->_handle          = handle;
+            coTask->_resuming        = false;
+            coTask->_responseChecked = false;
+            if (0U == coTask->_resumeCount) {
+                coTask->_startBytes = coTask->_totalBytesReceived;
+            }
+
             /** if server acceptRanges and local has part of file, we continue to download **/
             if (coTask->_acceptRanges && coTask->_totalBytesReceived > 0) {
                 curl_easy_setopt(handle, CURLOPT_RESUME_FROM_LARGE, (curl_off_t)coTask->_totalBytesReceived);
+                coTask->_resuming = true;
             }
         } else {
             // get header options
@@ -357,6 +487,82 @@ private:
             curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, true);
             curl_easy_setopt(handle, CURLOPT_MAXREDIRS, MAX_REDIRS);
         }
+
+#if LIBCURL_VERSION_NUM >= 0x072f00
+        if (hints.enableHTTP2) {
+            // wait for a connection that can be multiplexed instead of opening a new one
+            curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+            curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+        }
+#endif
+    }
+
+    // re-request the rest of a broken transfer with a range, returns false if it can't be resumed
+    bool _resumeProc(CURLM *curlmHandle, CURL *handle, TaskWrapper &wrapper, CURLcode errCode) {
+        DownloadTaskCURL &coTask = *wrapper.second;
+        if (!coTask._headerAchieved || coTask._resumeCount >= CC_CURL_MAX_RESUME_COUNT || !isResumableError(errCode)) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(coTask._mutex);
+            coTask._acceptRanges = coTask._acceptRanges || acceptsRanges(coTask._header);
+            if (!coTask._acceptRanges || coTask._totalBytesReceived <= 0) {
+                return false;
+            }
+            ++coTask._resumeCount;
+            coTask._hasLocalData = true;
+            if (coTask._fp) {
+                fflush(coTask._fp);
+            }
+        }
+
+        DLLOG("    _resumeProc task %d from %lld bytes", coTask.serialId, coTask._totalBytesReceived);
+        curl_easy_reset(handle);
+        _initCurlHandleProc(handle, wrapper, true);
+        return CURLM_OK == curl_multi_add_handle(curlmHandle, handle);
+    }
+
+    void _collectStatsProc(CURL *handle, DownloadTaskCURL &coTask) {
+        double firstByteTime = 0;
+        curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &firstByteTime);
+        long httpVersion = 0;
+#if LIBCURL_VERSION_NUM >= 0x073200
+        curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion);
+#endif
+
+        std::lock_guard<std::mutex> lock(coTask._mutex);
+        auto &                      stats = coTask._stats;
+        stats.firstByteTime               = static_cast<float>(firstByteTime);
+        stats.totalTime                   = secondsSince(coTask._startTime, Clock::now());
+        stats.bytesReceived               = coTask._totalBytesReceived - coTask._startBytes;
+        stats.bytesPerSecond              = stats.totalTime > 0.0F ? static_cast<double>(stats.bytesReceived) / stats.totalTime : 0.0;
+        stats.resumeCount                 = coTask._resumeCount;
+#if LIBCURL_VERSION_NUM >= 0x073200
+        stats.http2 = CURL_HTTP_VERSION_2_0 == httpVersion;
+#endif
+    }
+
+    // pops the first task of the highest priority whose host has a free slot
+    bool _popRequestProc(const ccstd::unordered_map<ccstd::string, uint32_t> &hostCounts, TaskWrapper &outWrapper) {
+        const uint32_t              maxPerHost = hints.countOfMaxProcessingTasksPerHost;
+        std::lock_guard<std::mutex> lock(_requestMutex);
+        for (auto priority = PRIORITY_COUNT; priority-- > 0;) {
+            auto &queue = _requestQueues[priority];
+            for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+                if (0 != maxPerHost) {
+                    auto count = hostCounts.find(iter->second->_host);
+                    if (hostCounts.end() != count && count->second >= maxPerHost) {
+                        continue;
+                    }
+                }
+
+                outWrapper = *iter;
+                queue.erase(iter);
+                return true;
+            }
+        }
+        return false;
     }
 
     // get header info, if success set handle to content download state
@@ -383,7 +589,7 @@ private:
                 break;
             }
 
-            bool acceptRanges = (ccstd::string::npos != coTask._header.find("Accept-Ranges")) ? true : false;
+            bool acceptRanges = acceptsRanges(coTask._header);
 
             // get current file size
             int64_t fileSize = 0;
@@ -414,11 +620,19 @@ private:
         auto     thisThreadId              = std::this_thread::get_id();
         uint32_t countOfMaxProcessingTasks = this->hints.countOfMaxProcessingTasks;
         // init curl content
-        CURLM *                                   curlmHandle = curl_multi_init();
-        ccstd::unordered_map<CURL *, TaskWrapper> coTaskMap;
-        int                                       runningHandles = 0;
-        CURLMcode                                 mcode          = CURLM_OK;
-        int                                       rc             = 0; // select return code
+        CURLM *                                       curlmHandle = curl_multi_init();
+        ccstd::unordered_map<CURL *, TaskWrapper>     coTaskMap;
+        ccstd::unordered_map<ccstd::string, uint32_t> hostCounts; // processing tasks per host
+        int                                           runningHandles = 0;
+        CURLMcode                                     mcode          = CURLM_OK;
+        int                                           rc             = 0; // select return code
+
+#ifdef CURLPIPE_MULTIPLEX
+        // transfers to the same host share one HTTP/2 connection and the multi handle's connection cache
+        if (hints.enableHTTP2) {
+            curl_multi_setopt(curlmHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        }
+#endif
 
         do {
             // check the thread should exit or not
@@ -496,6 +710,10 @@ private:
                         bool reinited = false;
                         do {
                             if (CURLE_OK != errCode) {
+                                if (_resumeProc(curlmHandle, curlHandle, wrapper, errCode)) {
+                                    reinited = true;
+                                    break;
+                                }
                                 wrapper.second->setErrorProc(DownloadTask::ERROR_IMPL_INTERNAL, errCode, curl_easy_strerror(errCode));
                                 break;
                             }
@@ -535,11 +753,16 @@ private:
                         if (reinited) {
                             continue;
                         }
+                        _collectStatsProc(curlHandle, *wrapper.second);
                         curl_easy_cleanup(curlHandle);
                         DLLOG("    _threadProc task clean cur handle :%p with errCode:%d", curlHandle, errCode);
 
                         // remove from coTaskMap
                         coTaskMap.erase(curlHandle);
+                        auto hostCount = hostCounts.find(wrapper.second->_host);
+                        if (hostCounts.end() != hostCount && 0 == --hostCount->second) {
+                            hostCounts.erase(hostCount);
+                        }
 
                         // remove from _processSet
                         {
@@ -561,22 +784,26 @@ private:
             // process tasks in _requestList
             auto size = coTaskMap.size();
             while (0 == countOfMaxProcessingTasks || size < countOfMaxProcessingTasks) {
-                // get task wrapper from request queue
+                // get task wrapper from request queue, stop if it's empty or every queued host is busy
                 TaskWrapper wrapper;
-                {
-                    std::lock_guard<std::mutex> lock(_requestMutex);
-                    if (_requestQueue.size()) {
-                        wrapper = _requestQueue.front();
-                        _requestQueue.pop_front();
-                    }
-                }
-
-                // if request queue is empty, the wrapper.first is nullptr
-                if (!wrapper.first) {
+                if (!_popRequestProc(hostCounts, wrapper)) {
                     break;
                 }
 
-                wrapper.second->initProc();
+                DownloadTaskCURL &coTask = *wrapper.second;
+                coTask.initProc();
+
+                // a header request is only needed to resume a partial local file,
+                // otherwise the content is requested directly and its length read from the response
+                bool hasPartialFile = coTask._tempFileName.length() && FileUtils::getInstance()->getFileSize(coTask._tempFileName) > 0;
+                {
+                    std::lock_guard<std::mutex> lock(coTask._mutex);
+                    coTask._startTime       = Clock::now();
+                    coTask._stats           = DownloadTaskStats();
+                    coTask._stats.queueTime = secondsSince(coTask._queuedTime, coTask._startTime);
+                    coTask._hasLocalData    = hasPartialFile;
+                    coTask._headerAchieved  = !hasPartialFile;
+                }
 
                 // create curl handle from task and add into curl multi handle
                 CURL *curlHandle = curl_easy_init();
@@ -588,8 +815,7 @@ private:
                     continue;
                 }
 
-                // init curl handle for get header info
-                _initCurlHandleProc(curlHandle, wrapper);
+                _initCurlHandleProc(curlHandle, wrapper, !hasPartialFile);
 
                 // add curl handle to process list
                 mcode = curl_multi_add_handle(curlmHandle, curlHandle);
@@ -602,6 +828,8 @@ private:
 
                 DLLOG("    _threadProc task create curl handle:%p", curlHandle);
                 coTaskMap[curlHandle] = wrapper;
+                ++hostCounts[coTask._host];
+                ++size;
                 std::lock_guard<std::mutex> lock(_processMutex);
                 _processSet.insert(wrapper);
             }
@@ -612,10 +840,10 @@ private:
         DLLOG("----DownloaderCURL::Impl::_threadProc end");
     }
 
-    std::thread               _thread;
-    ccstd::deque<TaskWrapper> _requestQueue;
-    ccstd::set<TaskWrapper>   _processSet;
-    ccstd::deque<TaskWrapper> _finishedQueue;
+    std::thread                                             _thread;
+    ccstd::array<ccstd::deque<TaskWrapper>, PRIORITY_COUNT> _requestQueues;
+    ccstd::set<TaskWrapper>                                 _processSet;
+    ccstd::deque<TaskWrapper>                               _finishedQueue;
 
     std::mutex _threadMutex;
     std::mutex _requestMutex;
@@ -669,6 +897,7 @@ DownloaderCURL::~DownloaderCURL() {
 IDownloadTask *DownloaderCURL::createCoTask(std::shared_ptr<const DownloadTask> &task) {
     DownloadTaskCURL *coTask = new (std::nothrow) DownloadTaskCURL;
     coTask->init(task->storagePath, _impl->hints.tempFileNameSuffix);
+    coTask->_host = getHostFromURL(task->requestURL);
 
     DLLOG("    DownloaderCURL: createTask: Id(%d)", coTask->serialId);
 
@@ -687,6 +916,24 @@ void DownloaderCURL::abort(const std::unique_ptr<IDownloadTask> &task) {
     DLLOG("%s isn't implemented!\n", __FUNCTION__);
 }
 
+void DownloaderCURL::setPriority(const std::unique_ptr<IDownloadTask> &task, int priority) {
+    auto *coTask = static_cast<DownloadTaskCURL *>(task.get());
+    if (coTask) {
+        _impl->setPriority(coTask, std::min(std::max(priority, DownloadTask::PRIORITY_LOW), DownloadTask::PRIORITY_HIGH));
+    }
+}
+
+bool DownloaderCURL::getTaskStats(const std::unique_ptr<IDownloadTask> &task, DownloadTaskStats *stats) const {
+    auto *coTask = static_cast<DownloadTaskCURL *>(task.get());
+    if (!coTask) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(coTask->_mutex);
+    *stats = coTask->_stats;
+    return true;
+}
+
 void DownloaderCURL::_onSchedule(float) {
     ccstd::vector<TaskWrapper> tasks;
 
@@ -46,6 +46,10 @@ public:
 
     virtual void abort(const std::unique_ptr<IDownloadTask> &task) override;
 
+    virtual void setPriority(const std::unique_ptr<IDownloadTask> &task, int priority) override;
+
+    virtual bool getTaskStats(const std::unique_ptr<IDownloadTask> &task, DownloadTaskStats *stats) const override;
+
 protected:
     class Impl;
     std::shared_ptr<Impl> _impl;
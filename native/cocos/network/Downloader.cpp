@@ -164,6 +164,16 @@ std::shared_ptr<const DownloadTask> Downloader::createDownloadFileTask(const ccs
 void Downloader::abort(const DownloadTask &task) {
     _impl->abort(task._coTask);
 }
+
+void Downloader::setPriority(const DownloadTask &task, int priority) {
+    _impl->setPriority(task._coTask, priority);
+}
+
+DownloadTaskStats Downloader::getTaskStats(const DownloadTask &task) const {
+    DownloadTaskStats stats;
+    _impl->getTaskStats(task._coTask, &stats);
+    return stats;
+}
 //ccstd::string Downloader::getFileNameFromUrl(const ccstd::string& srcUrl)
 //{
 //    // Find file name and file extension
@@ -49,6 +49,10 @@ public:
     const static int ERROR_IMPL_INTERNAL  = -3;
     const static int ERROR_ABORT          = -4;
 
+    const static int PRIORITY_LOW    = 0;
+    const static int PRIORITY_NORMAL = 1;
+    const static int PRIORITY_HIGH   = 2;
+
     ccstd::string                                      identifier;
     ccstd::string                                      requestURL;
     ccstd::string                                      storagePath;
@@ -66,6 +70,18 @@ struct CC_DLL DownloaderHints {
     uint32_t      countOfMaxProcessingTasks;
     uint32_t      timeoutInSeconds;
     ccstd::string tempFileNameSuffix;
+    uint32_t      countOfMaxProcessingTasksPerHost{0U}; // curl only, 0 means no limit
+    bool          enableHTTP2{true};                    // curl only, multiplex requests to the same host over one connection
+};
+
+struct CC_DLL DownloadTaskStats {
+    float    queueTime{0.0F};     // seconds waited before the first request was sent
+    float    firstByteTime{0.0F}; // seconds from sending the content request to its first byte
+    float    totalTime{0.0F};     // seconds from the first request to completion
+    double   bytesPerSecond{0.0};
+    int64_t  bytesReceived{0};    // received in this session, excluding resumed local data
+    uint32_t resumeCount{0U};     // range requests sent after a broken transfer
+    bool     http2{false};
 };
 
 class CC_DLL Downloader final {
@@ -112,6 +128,12 @@ public:
 
     void abort(const DownloadTask &task);
 
+    // only affects tasks still waiting in the queue, see DownloadTask::PRIORITY_*
+    void setPriority(const DownloadTask &task, int priority);
+
+    // filled once the task finishes, empty on implementations that don't record stats
+    DownloadTaskStats getTaskStats(const DownloadTask &task) const;
+
 private:
     std::unique_ptr<IDownloaderImpl> _impl;
 };
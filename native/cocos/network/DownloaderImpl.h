@@ -45,6 +45,7 @@
 namespace cc {
 namespace network {
 class DownloadTask;
+struct DownloadTaskStats;
 
 class CC_DLL IDownloadTask {
 public:
@@ -72,6 +73,9 @@ public:
     virtual IDownloadTask *createCoTask(std::shared_ptr<const DownloadTask> &task) = 0;
 
     virtual void abort(const std::unique_ptr<IDownloadTask> &task) = 0;
+
+    virtual void setPriority(const std::unique_ptr<IDownloadTask> & /*task*/, int /*priority*/) {}
+    virtual bool getTaskStats(const std::unique_ptr<IDownloadTask> & /*task*/, DownloadTaskStats * /*stats*/) const { return false; }
 };
 
 } // namespace network
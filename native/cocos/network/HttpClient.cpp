@@ -30,6 +30,7 @@
 #include <curl/curl.h>
 #include <errno.h>
 #include "application/ApplicationManager.h"
+#include "base/std/container/unordered_map.h"
 #include "base/Log.h"
 #include "base/memory/Memory.h"
 #include "platform/FileUtils.h"
@@ -49,14 +50,12 @@ typedef size_t (*write_callback)(void *ptr, size_t size, size_t nmemb, void *str
 
 // Callback function used by libcurl for collect response data
 static size_t writeData(void *ptr, size_t size, size_t nmemb, void *stream) {
-    ccstd::vector<char> *recvBuffer = (ccstd::vector<char> *)stream;
-    size_t               sizes      = size * nmemb;
+    HttpResponse *response = (HttpResponse *)stream;
+    size_t        sizes    = size * nmemb;
 
-    // add data to the end of recvBuffer
     // write data maybe called more than once in a single request
-    recvBuffer->insert(recvBuffer->end(), (char *)ptr, (char *)ptr + sizes);
-
-    return sizes;
+    // returning less than sizes makes curl abort the transfer
+    return response->appendResponseData((char *)ptr, sizes) ? sizes : 0;
 }
 
 // Callback function used by libcurl for collect header data
@@ -71,63 +70,31 @@ static size_t writeHeaderData(void *ptr, size_t size, size_t nmemb, void *stream
     return sizes;
 }
 
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *errorCode, write_callback headerCallback, void *headerStream, char *errorBuffer);
-// int processDownloadTask(HttpRequest *task, write_callback callback, void *stream, int32_t *errorCode);
-
-// Worker thread
-void HttpClient::networkThread() {
-    increaseThreadCount();
-
-    while (true) {
-        HttpRequest *request;
-
-        // step 1: send http request if the requestQueue isn't empty
-        {
-            std::lock_guard<std::mutex> lock(_requestQueueMutex);
-            while (_requestQueue.empty()) {
-                _sleepCondition.wait(_requestQueueMutex);
-            }
-            request = _requestQueue.at(0);
-            _requestQueue.erase(0);
-        }
-
-        if (request == _requestSentinel) {
-            break;
-        }
+#ifndef CC_HTTP_POLL_TIMEOUT_MS
+    #define CC_HTTP_POLL_TIMEOUT_MS 50
+#endif
 
-        // step 2: libcurl sync access
+constexpr long MAX_HOST_CONNECTIONS      = 6L;
+constexpr long DNS_CACHE_TIMEOUT_SECONDS = 300L;
 
-        // Create a HttpResponse object, the default setting is http access failed
-        HttpResponse *response = new (std::nothrow) HttpResponse(request);
-        response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after new.
+// resolved addresses and tls sessions are shared by the multi handle and immediate requests
+static CURLSH *   _shareHandle = nullptr;
+static std::mutex _shareMutexes[CURL_LOCK_DATA_LAST];
 
-        processResponse(response, _responseMessage);
+static void lockShareData(CURL * /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void * /*userptr*/) {
+    _shareMutexes[data].lock();
+}
 
-        // add response packet into queue
-        _responseQueueMutex.lock();
-        _responseQueue.pushBack(response);
-        _responseQueueMutex.unlock();
+static void unlockShareData(CURL * /*handle*/, curl_lock_data data, void * /*userptr*/) {
+    _shareMutexes[data].unlock();
+}
 
-        _schedulerMutex.lock();
-        if (auto sche = _scheduler.lock()) {
-            sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
-        }
-        _schedulerMutex.unlock();
+static void wakeupMultiHandle(void *multiHandle) {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    if (multiHandle) {
+        curl_multi_wakeup(static_cast<CURLM *>(multiHandle));
     }
-
-    // cleanup: if worker thread received quit signal, clean up un-completed request queue
-    _requestQueueMutex.lock();
-    _requestQueue.clear();
-    _requestQueueMutex.unlock();
-
-    _responseQueueMutex.lock();
-    _responseQueue.clear();
-    _responseQueueMutex.unlock();
-
-    decreaseThreadCountAndMayDeleteThis();
+#endif
 }
 
 // Worker thread
@@ -185,6 +152,13 @@ static bool configureCURL(HttpClient *client, HttpRequest *request, CURL *handle
         curl_easy_setopt(handle, CURLOPT_CAINFO, sslCaFilename.c_str());
     }
 
+    // keep connections alive for reuse, and cache resolved addresses across requests
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, DNS_CACHE_TIMEOUT_SECONDS);
+    if (_shareHandle) {
+        curl_easy_setopt(handle, CURLOPT_SHARE, _shareHandle);
+    }
+
     // FIXED #3224: The subthread of CCHttpClient interrupts main thread if timeout comes.
     // Document is here: http://curl.haxx.se/libcurl/c/curl_easy_setopt.html#CURLOPTNOSIGNAL
     curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
@@ -214,6 +188,10 @@ public:
             curl_slist_free_all(_headers);
     }
 
+    CURL *get() const {
+        return _curl;
+    }
+
     template <class T>
     bool setOption(CURLoption option, T data) {
         return CURLE_OK == curl_easy_setopt(_curl, option, data);
@@ -256,7 +234,13 @@ public:
 
     /// @param responseCode Null not allowed
     bool perform(long *responseCode) {
-        if (CURLE_OK != curl_easy_perform(_curl))
+        return finish(curl_easy_perform(_curl), responseCode);
+    }
+
+    /// @param result the result of a blocking or multi handle transfer
+    /// @param responseCode Null not allowed
+    bool finish(CURLcode result, long *responseCode) {
+        if (CURLE_OK != result)
             return false;
         CURLcode code = curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, responseCode);
         if (code != CURLE_OK || !(*responseCode >= 200 && *responseCode < 300)) {
@@ -269,39 +253,211 @@ public:
     }
 };
 
-//Process Get Request
-static int processGetTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool     ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// Init curl handle with options of the request type, shared by queued and immediate requests
+static bool configureRequest(HttpClient *client, HttpRequest *request, CURLRaii &curl, HttpResponse *response, char *errorBuffer) {
+    if (!curl.init(client, request, writeData, response, writeHeaderData, response->getResponseHeader(), errorBuffer)) {
+        return false;
+    }
+
+    switch (request->getRequestType()) {
+        case HttpRequest::Type::GET: // HTTP GET
+            return curl.setOption(CURLOPT_FOLLOWLOCATION, true);
+
+        case HttpRequest::Type::POST: // HTTP POST
+            return curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+        case HttpRequest::Type::PUT:
+            return curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+        case HttpRequest::Type::HEAD:
+            return curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize());
+
+        case HttpRequest::Type::DELETE:
+            return curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true);
+
+        default:
+            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
+            return false;
+    }
 }
 
-//Process POST Request
-static int processPostTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool     ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_POST, 1) && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// write data to HttpResponse
+static void setResponseResult(HttpResponse *response, bool succeed, long responseCode, const char *errorBuffer) {
+    response->setResponseCode(responseCode);
+    if (!succeed) {
+        response->setSucceed(false);
+        response->setErrorBuffer(errorBuffer);
+    } else {
+        response->setSucceed(true);
+    }
 }
 
-//Process PUT Request
-static int processPutTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool     ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "PUT") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+// the sentinel is taken at once, otherwise the oldest request of the highest priority
+static HttpRequest *popRequest(RefVector<HttpRequest *> &queue, HttpRequest *sentinel) {
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < queue.size(); ++i) {
+        auto *request = queue.at(i);
+        if (request == sentinel) {
+            index = i;
+            break;
+        }
+        if (request->getPriority() > queue.at(index)->getPriority()) {
+            index = i;
+        }
+    }
+
+    auto *request = queue.at(index);
+    queue.erase(index);
+    return request;
 }
 
-//Process HEAD Request
-static int processHeadTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool     ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_NOBODY, "HEAD") && curl.setOption(CURLOPT_POSTFIELDS, request->getRequestData()) && curl.setOption(CURLOPT_POSTFIELDSIZE, request->getRequestDataSize()) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+/**
+ * HttpTransfer: a request in flight on the multi handle
+ */
+struct HttpTransfer {
+    explicit HttpTransfer(HttpResponse *r)
+    : response(r) {
+        memset(errorBuffer, 0, sizeof(errorBuffer));
+    }
+
+    CURLRaii      curl;
+    HttpResponse *response{nullptr};
+    char          errorBuffer[HttpClient::RESPONSE_BUFFER_SIZE];
+};
+
+// Worker thread, requests run concurrently on one curl multi handle which keeps their connections alive for reuse
+void HttpClient::networkThread() {
+    increaseThreadCount();
+
+    CURLM *multiHandle = curl_multi_init();
+    curl_multi_setopt(multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_HOST_CONNECTIONS);
+#ifdef CURLPIPE_MULTIPLEX
+    curl_multi_setopt(multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+    {
+        std::lock_guard<std::mutex> lock(_requestQueueMutex);
+        _multiHandle = multiHandle;
+    }
+
+    ccstd::unordered_map<CURL *, HttpTransfer *> transfers;
+    ccstd::vector<HttpRequest *>                 requests;
+    bool                                         quit = false;
+
+    while (true) {
+        // step 1: take requests while there are free slots, sleep if there is nothing to do
+        {
+            std::lock_guard<std::mutex> lock(_requestQueueMutex);
+            while (transfers.empty() && _requestQueue.empty()) {
+                _sleepCondition.wait(_requestQueueMutex);
+            }
+
+            while (!_requestQueue.empty() && transfers.size() + requests.size() < _maxConcurrentRequests) {
+                HttpRequest *request = popRequest(_requestQueue, _requestSentinel);
+                if (request == _requestSentinel) {
+                    quit = true;
+                    break;
+                }
+                requests.push_back(request);
+            }
+        }
+
+        if (quit) {
+            break;
+        }
+
+        // step 2: add new requests to the multi handle
+        for (auto *request : requests) {
+            // Create a HttpResponse object, the default setting is http access failed
+            HttpResponse *response = new (std::nothrow) HttpResponse(request);
+            response->addRef(); // NOTE: RefCounted object's reference count is changed to 0 now. so needs to addRef after new.
+
+            auto *transfer = new (std::nothrow) HttpTransfer(response);
+            if (configureRequest(this, request, transfer->curl, response, transfer->errorBuffer) &&
+                CURLM_OK == curl_multi_add_handle(multiHandle, transfer->curl.get())) {
+                transfers.emplace(transfer->curl.get(), transfer);
+                continue;
+            }
+
+            setResponseResult(response, false, -1, transfer->errorBuffer);
+            queueResponse(response);
+            delete transfer;
+        }
+        requests.clear();
+
+        // step 3: libcurl async access, dispatch finished transfers
+        int runningHandles = 0;
+        curl_multi_perform(multiHandle, &runningHandles);
+
+        CURLMsg *message      = nullptr;
+        int      messagesLeft = 0;
+        while ((message = curl_multi_info_read(multiHandle, &messagesLeft))) {
+            if (CURLMSG_DONE != message->msg) {
+                continue;
+            }
+
+            auto iter = transfers.find(message->easy_handle);
+            if (iter == transfers.end()) {
+                continue;
+            }
+
+            // the message is freed by curl_multi_remove_handle
+            HttpTransfer *transfer     = iter->second;
+            long          responseCode = -1;
+            bool          succeed      = transfer->curl.finish(message->data.result, &responseCode);
+            transfers.erase(iter);
+            curl_multi_remove_handle(multiHandle, transfer->curl.get());
+
+            setResponseResult(transfer->response, succeed, responseCode, transfer->errorBuffer);
+            queueResponse(transfer->response);
+            delete transfer;
+        }
+
+        // step 4: wait for socket activity, new requests wake up the wait if curl supports it
+        if (!transfers.empty()) {
+#if LIBCURL_VERSION_NUM >= 0x074400
+            curl_multi_poll(multiHandle, nullptr, 0, 1000, nullptr);
+#else
+            int numfds = 0;
+            curl_multi_wait(multiHandle, nullptr, 0, CC_HTTP_POLL_TIMEOUT_MS, &numfds);
+            if (0 == numfds) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(CC_HTTP_POLL_TIMEOUT_MS));
+            }
+#endif
+        }
+    }
+
+    // cleanup: if worker thread received quit signal, drop in-flight and un-completed requests
+    for (auto &iter : transfers) {
+        curl_multi_remove_handle(multiHandle, iter.first);
+        iter.second->response->release();
+        delete iter.second;
+    }
+    transfers.clear();
+
+    _requestQueueMutex.lock();
+    _multiHandle = nullptr;
+    _requestQueue.clear();
+    _requestQueueMutex.unlock();
+    curl_multi_cleanup(multiHandle);
+
+    _responseQueueMutex.lock();
+    _responseQueue.clear();
+    _responseQueueMutex.unlock();
+
+    decreaseThreadCountAndMayDeleteThis();
 }
 
-//Process DELETE Request
-static int processDeleteTask(HttpClient *client, HttpRequest *request, write_callback callback, void *stream, long *responseCode, write_callback headerCallback, void *headerStream, char *errorBuffer) {
-    CURLRaii curl;
-    bool     ok = curl.init(client, request, callback, stream, headerCallback, headerStream, errorBuffer) && curl.setOption(CURLOPT_CUSTOMREQUEST, "DELETE") && curl.setOption(CURLOPT_FOLLOWLOCATION, true) && curl.perform(responseCode);
-    return ok ? 0 : 1;
+void HttpClient::queueResponse(HttpResponse *response) {
+    // add response packet into queue
+    _responseQueueMutex.lock();
+    _responseQueue.pushBack(response);
+    _responseQueueMutex.unlock();
+
+    _schedulerMutex.lock();
+    if (auto sche = _scheduler.lock()) {
+        sche->performFunctionInCocosThread(CC_CALLBACK_0(HttpClient::dispatchResponseCallbacks, this));
+    }
+    _schedulerMutex.unlock();
 }
 
 // HttpClient implementation
@@ -333,6 +489,7 @@ void HttpClient::destroyInstance() {
 
     thiz->_requestQueueMutex.lock();
     thiz->_requestQueue.pushBack(thiz->_requestSentinel);
+    wakeupMultiHandle(thiz->_multiHandle);
     thiz->_requestQueueMutex.unlock();
 
     thiz->_sleepCondition.notify_one();
@@ -366,9 +523,22 @@ HttpClient::HttpClient()
     memset(_responseMessage, 0, RESPONSE_BUFFER_SIZE * sizeof(char));
     _scheduler = CC_CURRENT_ENGINE()->getScheduler();
     increaseThreadCount();
+
+    _shareHandle = curl_share_init();
+    if (_shareHandle) {
+        curl_share_setopt(_shareHandle, CURLSHOPT_LOCKFUNC, lockShareData);
+        curl_share_setopt(_shareHandle, CURLSHOPT_UNLOCKFUNC, unlockShareData);
+        curl_share_setopt(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
 }
 
 HttpClient::~HttpClient() {
+    // every thread has finished when the last reference is gone, no handle uses the share anymore
+    if (_shareHandle) {
+        curl_share_cleanup(_shareHandle);
+        _shareHandle = nullptr;
+    }
     CC_SAFE_RELEASE(_requestSentinel);
     CC_LOG_DEBUG("HttpClient destructor");
 }
@@ -400,6 +570,7 @@ void HttpClient::send(HttpRequest *request) {
 
     _requestQueueMutex.lock();
     _requestQueue.pushBack(request);
+    wakeupMultiHandle(_multiHandle);
     _requestQueueMutex.unlock();
 
     // Notify thread start to work
@@ -449,75 +620,10 @@ void HttpClient::dispatchResponseCallbacks() {
 
 // Process Response
 void HttpClient::processResponse(HttpResponse *response, char *responseMessage) {
-    auto request      = response->getHttpRequest();
-    long responseCode = -1;
-    int  retValue     = 0;
-
-    // Process the request -> get response packet
-    switch (request->getRequestType()) {
-        case HttpRequest::Type::GET: // HTTP GET
-            retValue = processGetTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::POST: // HTTP POST
-            retValue = processPostTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::PUT:
-            retValue = processPutTask(this, request,
-                                      writeData,
-                                      response->getResponseData(),
-                                      &responseCode,
-                                      writeHeaderData,
-                                      response->getResponseHeader(),
-                                      responseMessage);
-            break;
-
-        case HttpRequest::Type::HEAD:
-            retValue = processHeadTask(this, request,
-                                       writeData,
-                                       response->getResponseData(),
-                                       &responseCode,
-                                       writeHeaderData,
-                                       response->getResponseHeader(),
-                                       responseMessage);
-            break;
-
-        case HttpRequest::Type::DELETE:
-            retValue = processDeleteTask(this, request,
-                                         writeData,
-                                         response->getResponseData(),
-                                         &responseCode,
-                                         writeHeaderData,
-                                         response->getResponseHeader(),
-                                         responseMessage);
-            break;
-
-        default:
-            CCASSERT(false, "CCHttpClient: unknown request type, only GET, POST, PUT, HEAD or DELETE is supported");
-            break;
-    }
-
-    // write data to HttpResponse
-    response->setResponseCode(responseCode);
-    if (retValue != 0) {
-        response->setSucceed(false);
-        response->setErrorBuffer(responseMessage);
-    } else {
-        response->setSucceed(true);
-    }
+    CURLRaii curl;
+    long     responseCode = -1;
+    bool     succeed      = configureRequest(this, response->getHttpRequest(), curl, response, responseMessage) && curl.perform(&responseCode);
+    setResponseResult(response, succeed, responseCode, responseMessage);
 }
 
 void HttpClient::increaseThreadCount() {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 #include "base/RefVector.h"
@@ -57,6 +58,11 @@ public:
     */
     static const int RESPONSE_BUFFER_SIZE = 256;
 
+    /**
+     * The default count of requests sent by "send" which are processed at the same time
+     */
+    static const uint32_t DEFAULT_MAX_CONCURRENT_REQUESTS = 6;
+
     /**
      * Get instance of HttpClient.
      *
@@ -145,6 +151,20 @@ public:
      */
     CC_DEPRECATED_ATTRIBUTE int getTimeoutForRead();
 
+    /**
+     * Set how many requests sent by "send" are processed at the same time, the rest wait in queue by priority.
+     *
+     * @param count the count of concurrent requests, at least 1.
+     */
+    inline void setMaxConcurrentRequests(uint32_t count) { _maxConcurrentRequests = count > 0 ? count : 1; }
+
+    /**
+     * Get how many requests sent by "send" are processed at the same time.
+     *
+     * @return uint32_t the count of concurrent requests.
+     */
+    inline uint32_t getMaxConcurrentRequests() const { return _maxConcurrentRequests; }
+
     HttpCookie *getCookie() const { return _cookie; }
 
     std::mutex &getCookieFileMutex() { return _cookieFileMutex; }
@@ -167,6 +187,7 @@ private:
     void dispatchResponseCallbacks();
 
     void processResponse(HttpResponse *response, char *responseMessage);
+    void queueResponse(HttpResponse *response);
     void increaseThreadCount();
     void decreaseThreadCountAndMayDeleteThis();
 
@@ -187,6 +208,8 @@ private: // NOLINT(readability-redundant-access-specifiers)
 
     RefVector<HttpRequest *> _requestQueue;
     std::mutex               _requestQueueMutex;
+    void *                   _multiHandle{nullptr}; // guarded by _requestQueueMutex
+    std::atomic<uint32_t>    _maxConcurrentRequests{DEFAULT_MAX_CONCURRENT_REQUESTS};
 
     RefVector<HttpResponse *> _responseQueue;
     std::mutex                _responseQueueMutex;
@@ -47,6 +47,8 @@ class HttpClient;
 class HttpResponse;
 
 using ccHttpRequestCallback = std::function<void(HttpClient *, HttpResponse *)>;
+// Receives a piece of the response body on the network thread, returning false aborts the transfer.
+using ccHttpResponseDataCallback = std::function<bool(HttpResponse *, const char *, size_t)>;
 
 /**
  * Defines the object which users must packed for HttpClient::send(HttpRequest*) method.
@@ -76,6 +78,16 @@ public:
         UNKNOWN,
     };
 
+    /**
+     * The HttpRequest priority enum used in the HttpRequest::setPriority.
+     * When more requests are queued than HttpClient runs at the same time, higher priorities are sent first.
+     */
+    enum class Priority {
+        LOW,
+        NORMAL,
+        HIGH,
+    };
+
     /**
      *  Constructor.
      *   Because HttpRequest object will be used between UI thread and network thread,
@@ -233,6 +245,26 @@ public:
         return _callback;
     }
 
+    /**
+     * Set the callback which receives the response body while it is downloaded, instead of HttpResponse::getResponseData().
+     * It's invoked on the network thread and taken when the request starts, so changing it doesn't affect transfers in flight.
+     * Only the curl based HttpClient streams the body, other implementations keep delivering it in getResponseData().
+     *
+     * @param callback the ccHttpResponseDataCallback function.
+     */
+    inline void setResponseDataCallback(const ccHttpResponseDataCallback &callback) {
+        _dataCallback = callback;
+    }
+
+    /**
+     * Get the callback which receives the response body while it is downloaded.
+     *
+     * @return const ccHttpResponseDataCallback& the callback, empty if the body is collected in the response.
+     */
+    inline const ccHttpResponseDataCallback &getResponseDataCallback() const {
+        return _dataCallback;
+    }
+
     /**
      * Set custom-defined headers.
      *
@@ -259,6 +291,24 @@ public:
         return _timeoutInSeconds;
     }
 
+    /**
+     * Set the priority of HttpRequest object before being sent.
+     *
+     * @param priority the request priority, HttpRequest::Priority::NORMAL by default.
+     */
+    inline void setPriority(Priority priority) {
+        _priority = priority;
+    }
+
+    /**
+     * Get the priority of HttpRequest object.
+     *
+     * @return HttpRequest::Priority.
+     */
+    inline Priority getPriority() const {
+        return _priority;
+    }
+
 protected:
     // properties
     Type                         _requestType{Type::UNKNOWN}; /// kHttpRequestGet, kHttpRequestPost or other enums
@@ -266,9 +316,11 @@ protected:
     ccstd::vector<char>          _requestData;                /// used for POST
     ccstd::string                _tag;                        /// user defined tag, to identify different requests in response callback
     ccHttpRequestCallback        _callback;                   /// C++11 style callbacks
+    ccHttpResponseDataCallback   _dataCallback;               /// receives the response body while it is downloaded
     void *                       _userData{nullptr};          /// You can add your customed data here
     ccstd::vector<ccstd::string> _headers;                    /// custom http headers
     float                        _timeoutInSeconds{10.F};
+    Priority                     _priority{Priority::NORMAL}; /// order of queued requests
 };
 
 } // namespace network
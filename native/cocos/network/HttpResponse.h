@@ -57,6 +57,7 @@ public:
       _responseDataString("") {
         if (_pHttpRequest) {
             _pHttpRequest->addRef();
+            _dataCallback = _pHttpRequest->getResponseDataCallback();
         }
     }
 
@@ -157,6 +158,21 @@ public:
         _responseData = *data;
     }
 
+    /**
+     * Append received response data, it is used by HttpClient.
+     * The data goes to the data callback of the request if it has one, otherwise to the response data buffer.
+     * @param data the pointer point to the received data.
+     * @param len the size of the received data.
+     * @return bool false if the transfer should be aborted.
+     */
+    inline bool appendResponseData(const char *data, size_t len) {
+        if (_dataCallback) {
+            return _dataCallback(this, data, len);
+        }
+        _responseData.insert(_responseData.end(), data, data + len);
+        return true;
+    }
+
     /**
      * Set the http response headers buffer, it is used by HttpClient.
      * @param data the pointer point to the response headers buffer.
@@ -212,6 +228,8 @@ protected:
     long                _responseCode;       /// the status code returned from libcurl, e.g. 200, 404
     ccstd::string       _errorBuffer;        /// if _responseCode != 200, please read _errorBuffer to find the reason
     ccstd::string       _responseDataString; // the returned raw data. You can also dump it as a string
+
+    ccHttpResponseDataCallback _dataCallback; // copy of the request's data callback taken when the transfer starts
 };
 
 } // namespace network
@@ -70,6 +70,15 @@
 
 #define WS_RX_BUFFER_SIZE              (65536)
 #define WS_RESERVE_RECEIVE_BUFFER_SIZE (4096)
+// Max count of idle message buffers kept for reuse, buffers larger than WS_BUFFER_POOL_MAX_BYTES are freed instead
+#define WS_BUFFER_POOL_CAPACITY  (32)
+#define WS_BUFFER_POOL_MAX_BYTES (WS_RX_BUFFER_SIZE)
+// Max bytes written for one connection in a single writable callback
+#define WS_WRITE_BATCH_BYTES (WS_RX_BUFFER_SIZE)
+
+#ifndef WS_ENABLE_PERMESSAGE_DEFLATE
+    #define WS_ENABLE_PERMESSAGE_DEFLATE 1
+#endif
 
 #if CC_PLATFORM == CC_PLATFORM_ANDROID
     #define WS_ENABLE_LIBUV 1
@@ -201,6 +210,81 @@ static void printWebSocketLog(int level, const char *line) {
 #endif // #if CC_DEBUG > 0
 }
 
+/**
+ *  @brief Recycles message buffers between cocos thread and websocket thread,
+ *  so that high frequency traffic doesn't allocate memory for every message.
+ */
+class WsBufferPool {
+public:
+    ~WsBufferPool() {
+        for (auto *buffer : _buffers) {
+            delete buffer;
+        }
+    }
+
+    ccstd::vector<char> *acquire(size_t capacity) {
+        ccstd::vector<char> *buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(_mutex);
+            if (!_buffers.empty()) {
+                buffer = _buffers.back();
+                _buffers.pop_back();
+            }
+        }
+        if (buffer == nullptr) {
+            buffer = new (std::nothrow) ccstd::vector<char>();
+        }
+        buffer->reserve(capacity);
+        return buffer;
+    }
+
+    void release(ccstd::vector<char> *buffer) {
+        if (buffer == nullptr) {
+            return;
+        }
+        // Don't keep the memory of huge messages alive
+        if (buffer->capacity() <= WS_BUFFER_POOL_MAX_BYTES) {
+            buffer->clear();
+            std::lock_guard<std::mutex> lk(_mutex);
+            if (_buffers.size() < WS_BUFFER_POOL_CAPACITY) {
+                _buffers.push_back(buffer);
+                return;
+            }
+        }
+        delete buffer;
+    }
+
+private:
+    std::mutex                           _mutex;
+    ccstd::vector<ccstd::vector<char> *> _buffers;
+};
+
+static WsBufferPool wsBufferPool;
+
+/**
+ *  @brief Messages received in websocket thread, they are delivered to cocos thread in batches,
+ *  one scheduled function per tick instead of one per message.
+ */
+struct WsInbox {
+    struct Message {
+        ccstd::vector<char> *buffer{nullptr};
+        ssize_t              len{0};
+        bool                 isBinary{false};
+    };
+
+    ~WsInbox() {
+        for (auto &message : messages) {
+            wsBufferPool.release(message.buffer);
+        }
+    }
+
+    std::mutex             mutex;
+    ccstd::vector<Message> messages;
+    bool                   scheduled{false};
+    // Only accessed in cocos thread
+    ccstd::vector<Message> delivering;
+};
+
 class WebSocketImpl {
 public:
     static void closeAllConnections();
@@ -236,13 +320,17 @@ private:
     int onConnectionError();
     int onConnectionClosed();
 
+    void sendMessage(unsigned int what, const char *bytes, size_t len);
+    void deliverReceivedData(bool isBinary);
+
     struct lws_vhost *createVhost(struct lws_protocols *protocols, int *sslConnection);
 
     cc::network::WebSocket *      _ws;
     cc::network::WebSocket::State _readyState;
     std::mutex                    _readyStateMutex;
     ccstd::string                 _url;
-    ccstd::vector<char>           _receivedData;
+    ccstd::vector<char> *         _receivedData{nullptr};
+    std::shared_ptr<WsInbox>      _inbox;
 
     struct lws *          _wsInstance;
     struct lws_protocols *_lwsProtocols;
@@ -298,6 +386,20 @@ static ccstd::string getFileNameForPath(const ccstd::string &filePath) {
 
 static struct lws_protocols defaultProtocols[2];
 
+#if WS_ENABLE_PERMESSAGE_DEFLATE
+static const struct lws_extension wsExtensions[] = {
+    {"permessage-deflate",
+     lws_extension_callback_pm_deflate,
+     // client_no_context_takeover extension is not supported in the current version, it will cause connection fail
+     // It may be a bug of lib websocket build
+     //            "permessage-deflate; client_no_context_takeover; client_max_window_bits"
+     "permessage-deflate; client_max_window_bits"},
+    {"deflate-frame",
+     lws_extension_callback_pm_deflate,
+     "deflate_frame"},
+    {nullptr, nullptr, nullptr /* terminator */}};
+#endif
+
 static lws_context_creation_info convertToContextCreationInfo(const struct lws_protocols *protocols, bool peerServerCert) {
     lws_context_creation_info info;
     memset(&info, 0, sizeof(info));
@@ -312,14 +414,14 @@ static lws_context_creation_info convertToContextCreationInfo(const struct lws_p
     info.port      = CONTEXT_PORT_NO_LISTEN;
     info.protocols = protocols;
 
-    // IDEA: Disable 'permessage-deflate' extension temporarily because of issues:
+    // 'permessage-deflate' was disabled in the past because of issues:
     // https://github.com/cocos2d/cocos2d-x/issues/16045, https://github.com/cocos2d/cocos2d-x/issues/15767
     // libwebsockets issue: https://github.com/warmcat/libwebsockets/issues/593
-    // Currently, we couldn't find out the exact reason.
-    // libwebsockets official said it's probably an issue of user code
-    // since 'libwebsockets' passed AutoBahn stressed Test.
-
-    //    info.extensions = exts;
+    // Define WS_ENABLE_PERMESSAGE_DEFLATE to 0 to turn the negotiation off if a server misbehaves.
+    // Client extensions are read from the vhost, 'client_exts' of connect info is not used by libwebsockets.
+#if WS_ENABLE_PERMESSAGE_DEFLATE
+    info.extensions = wsExtensions;
+#endif
 
     info.gid = -1;
     info.uid = -1;
@@ -343,6 +445,10 @@ public:
     unsigned int                  what{0}; // message type
     cc::network::WebSocket::Data *data{nullptr};
     void *                        user{nullptr};
+    // Pooled storage of data->bytes, with LWS_PRE bytes reserved in front for lws_write
+    ccstd::vector<char> *         buffer{nullptr};
+    // Bytes of the current fragment which were already written
+    ssize_t fragmentIssued{0};
 
 private:
     static unsigned int idCount;
@@ -538,46 +644,11 @@ void WsThreadHelper::joinWebSocketThread() const {
     }
 }
 
-// Define a WebSocket frame
-class WebSocketFrame {
-public:
-    bool init(unsigned char *buf, ssize_t len) {
-        if (buf == nullptr && len > 0) {
-            return false;
-        }
-
-        if (!_data.empty()) {
-            LOGD("WebSocketFrame was initialized, should not init it again!\n");
-            return false;
-        }
-
-        _data.resize(LWS_PRE + len);
-        if (len > 0) {
-            std::copy(buf, buf + len, _data.begin() + LWS_PRE);
-        }
-
-        _payload       = _data.data() + LWS_PRE;
-        _payloadLength = len;
-        _frameLength   = len;
-        return true;
-    }
-
-    void update(ssize_t issued) {
-        _payloadLength -= issued;
-        _payload += issued;
-    }
-
-    unsigned char *getPayload() const { return _payload; }
-    ssize_t        getPayloadLength() const { return _payloadLength; }
-    ssize_t        getFrameLength() const { return _frameLength; }
-
-private:
-    unsigned char *_payload{nullptr};
-    ssize_t        _payloadLength{0};
-
-    ssize_t                      _frameLength{0};
-    ccstd::vector<unsigned char> _data;
-};
+static void destroySendingMessage(WsMessage *msg) {
+    wsBufferPool.release(msg->buffer);
+    CC_SAFE_DELETE(msg->data);
+    delete msg;
+}
 
 //
 
@@ -603,10 +674,8 @@ WebSocketImpl::WebSocketImpl(cc::network::WebSocket *ws)
   _lwsProtocols(nullptr),
   _isDestroyed(std::make_shared<std::atomic<bool>>(false)),
   _delegate(nullptr),
+  _inbox(std::make_shared<WsInbox>()),
   _closeState(CloseState::NONE) {
-    // reserve data buffer to avoid allocate memory frequently
-    _receivedData.reserve(WS_RESERVE_RECEIVE_BUFFER_SIZE);
-
     {
         std::lock_guard<std::recursive_mutex> lk(instanceMutex);
         if (websocketInstances == nullptr) {
@@ -655,6 +724,9 @@ WebSocketImpl::~WebSocketImpl() {
     // NOTE: Refer to the comment in constructor!!!
     //    cc::Director::getInstance()->getEventDispatcher()->removeEventListener(_resetDirectorListener);
 
+    wsBufferPool.release(_receivedData);
+    _receivedData = nullptr;
+
     *_isDestroyed = true;
 }
 
@@ -739,21 +811,31 @@ ccstd::string WebSocketImpl::getExtensions() const {
     return ret;
 }
 
+void WebSocketImpl::sendMessage(unsigned int what, const char *bytes, size_t len) {
+    // In main thread
+    // The payload is copied once into a pooled buffer, lws_write sends it from there directly.
+    auto *buffer = wsBufferPool.acquire(LWS_PRE + len);
+    buffer->resize(LWS_PRE + len);
+    if (len > 0) {
+        memcpy(buffer->data() + LWS_PRE, bytes, len);
+    }
+
+    auto *data     = new (std::nothrow) cc::network::WebSocket::Data();
+    data->bytes    = buffer->data() + LWS_PRE;
+    data->len      = static_cast<ssize_t>(len);
+    data->isBinary = what == WS_MSG_TO_SUBTRHEAD_SENDING_BINARY;
+
+    auto *msg   = new (std::nothrow) WsMessage();
+    msg->what   = what;
+    msg->data   = data;
+    msg->user   = this;
+    msg->buffer = buffer;
+    wsHelper->sendMessageToWebSocketThread(msg);
+}
+
 void WebSocketImpl::send(const ccstd::string &message) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
-        // In main thread
-        auto *data  = new (std::nothrow) cc::network::WebSocket::Data();
-        data->bytes = static_cast<char *>(malloc(message.length() + 1));
-        // Make sure the last byte is '\0'
-        data->bytes[message.length()] = '\0';
-        strcpy(data->bytes, message.c_str());
-        data->len = static_cast<ssize_t>(message.length());
-
-        auto *msg = new (std::nothrow) WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_STRING;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        sendMessage(WS_MSG_TO_SUBTRHEAD_SENDING_STRING, message.c_str(), message.length());
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
@@ -761,23 +843,7 @@ void WebSocketImpl::send(const ccstd::string &message) {
 
 void WebSocketImpl::send(const unsigned char *binaryMsg, unsigned int len) {
     if (_readyState == cc::network::WebSocket::State::OPEN) {
-        // In main thread
-        auto *data = new (std::nothrow) cc::network::WebSocket::Data();
-        if (len == 0) {
-            // If data length is zero, allocate 1 byte for safe.
-            data->bytes    = static_cast<char *>(malloc(1));
-            data->bytes[0] = '\0';
-        } else {
-            data->bytes = static_cast<char *>(malloc(len));
-            memcpy(data->bytes, binaryMsg, len);
-        }
-        data->len = len;
-
-        auto *msg = new (std::nothrow) WsMessage();
-        msg->what = WS_MSG_TO_SUBTRHEAD_SENDING_BINARY;
-        msg->data = data;
-        msg->user = this;
-        wsHelper->sendMessageToWebSocketThread(msg);
+        sendMessage(WS_MSG_TO_SUBTRHEAD_SENDING_BINARY, reinterpret_cast<const char *>(binaryMsg), len);
     } else {
         LOGD("Couldn't send message since websocket wasn't opened!\n");
     }
@@ -925,18 +991,6 @@ struct lws_vhost *WebSocketImpl::createVhost(struct lws_protocols *protocols, in
 
 void WebSocketImpl::onClientOpenConnectionRequest() {
     if (nullptr != wsContext) {
-        static const struct lws_extension EXTS[] = {
-            {"permessage-deflate",
-             lws_extension_callback_pm_deflate,
-             // client_no_context_takeover extension is not supported in the current version, it will cause connection fail
-             // It may be a bug of lib websocket build
-             //            "permessage-deflate; client_no_context_takeover; client_max_window_bits"
-             "permessage-deflate; client_max_window_bits"},
-            {"deflate-frame",
-             lws_extension_callback_pm_deflate,
-             "deflate_frame"},
-            {nullptr, nullptr, nullptr /* terminator */}};
-
         _readyStateMutex.lock();
         _readyState = cc::network::WebSocket::State::CONNECTING;
         _readyStateMutex.unlock();
@@ -980,7 +1034,6 @@ void WebSocketImpl::onClientOpenConnectionRequest() {
         connectInfo.protocol                  = _clientSupportedProtocols.empty() ? nullptr : _clientSupportedProtocols.c_str();
         connectInfo.ietf_version_or_minus_one = -1;
         connectInfo.userdata                  = this;
-        connectInfo.client_exts               = EXTS;
         connectInfo.vhost                     = vhost;
 
         _wsInstance = lws_client_connect_via_info(&connectInfo);
@@ -1004,54 +1057,30 @@ int WebSocketImpl::onClientWritable() {
         }
     }
 
-    do {
+    {
         std::lock_guard<std::mutex> lk(wsHelper->_subThreadWsMessageQueueMutex);
-
-        if (wsHelper->_subThreadWsMessageQueue->empty()) {
-            break;
-        }
-
-        auto iter = wsHelper->_subThreadWsMessageQueue->begin();
-
-        while (iter != wsHelper->_subThreadWsMessageQueue->end()) {
-            WsMessage *msg = *iter;
-            if (msg->user == this) {
+        auto &                      queue = *wsHelper->_subThreadWsMessageQueue;
+
+        const ssize_t cBufferSize = WS_RX_BUFFER_SIZE;
+
+        // Coalesce writes: keep writing the queued messages of this connection until the socket
+        // is choked or the batch budget is used up, rather than one message per writable callback.
+        ssize_t batchBytes = 0;
+        auto    iter       = queue.begin();
+        while (batchBytes < WS_WRITE_BATCH_BYTES && !lws_send_pipe_choked(_wsInstance)) {
+            iter = std::find_if(iter, queue.end(), [this](const WsMessage *msg) {
+                return msg->user == this && msg->data != nullptr;
+            });
+            if (iter == queue.end()) {
                 break;
             }
-            ++iter;
-        }
 
-        ssize_t bytesWrite = 0;
-        if (iter != wsHelper->_subThreadWsMessageQueue->end()) {
             WsMessage *subThreadMsg = *iter;
+            auto *     data         = subThreadMsg->data;
 
-            auto *data = subThreadMsg->data;
-
-            const ssize_t cBufferSize = WS_RX_BUFFER_SIZE;
-
-            const ssize_t remaining = data->len - data->issued;
-            const ssize_t n         = std::min(remaining, cBufferSize);
-
-            WebSocketFrame *frame = nullptr;
-
-            if (data->ext) {
-                frame = static_cast<WebSocketFrame *>(data->ext);
-            } else {
-                frame        = new (std::nothrow) WebSocketFrame();
-                bool success = frame && frame->init(reinterpret_cast<unsigned char *>(data->bytes + data->issued), n);
-                if (success) {
-                    data->ext = frame;
-                } else { // If frame initialization failed, delete the frame and drop the sending data
-                         // These codes should never be called.
-                    LOGD("WebSocketFrame initialization failed, drop the sending data, msg(%d)\n", (int)subThreadMsg->id);
-                    delete frame;
-                    CC_SAFE_FREE(data->bytes);
-                    CC_SAFE_DELETE(data);
-                    wsHelper->_subThreadWsMessageQueue->erase(iter);
-                    CC_SAFE_DELETE(subThreadMsg);
-                    break;
-                }
-            }
+            const ssize_t remaining      = data->len - data->issued;
+            const ssize_t fragmentLength = std::min(remaining, cBufferSize);
+            const ssize_t n              = fragmentLength - subThreadMsg->fragmentIssued;
 
             int writeProtocol;
 
@@ -1070,62 +1099,47 @@ int WebSocketImpl::onClientWritable() {
                 // we are in the middle of fragments
                 writeProtocol = LWS_WRITE_CONTINUATION;
                 // and if not in the last fragment
-                if (remaining != n) {
+                if (remaining != fragmentLength) {
                     writeProtocol |= LWS_WRITE_NO_FIN;
                 }
             }
 
-            bytesWrite = lws_write(_wsInstance, frame->getPayload(), frame->getPayloadLength(), static_cast<lws_write_protocol>(writeProtocol));
+            // The LWS_PRE bytes before the payload are either reserved by sendMessage or belong to
+            // the fragments which were sent already, so lws_write is free to use them for the header.
+            auto *payload = reinterpret_cast<unsigned char *>(data->bytes + data->issued + subThreadMsg->fragmentIssued);
+
+            ssize_t bytesWrite = lws_write(_wsInstance, payload, n, static_cast<lws_write_protocol>(writeProtocol));
 
             // Handle the result of lws_write
             // Buffer overrun?
             if (bytesWrite < 0) {
                 LOGD("ERROR: msg(%u), lws_write return: %d, but it should be %d, drop this message.\n", subThreadMsg->id, (int)bytesWrite, (int)n);
                 // socket error, we need to close the socket connection
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
+                queue.erase(iter);
+                destroySendingMessage(subThreadMsg);
 
                 closeAsync();
-            } else if (bytesWrite < frame->getPayloadLength()) {
-                frame->update(bytesWrite);
-                LOGD("frame wasn't sent completely, bytesWrite: %d, remain: %d\n", (int)bytesWrite, (int)frame->getPayloadLength());
+                break;
             }
-            // Do we have another fragments to send?
-            else if (remaining > frame->getFrameLength() && bytesWrite == frame->getPayloadLength()) {
-                // A frame was totally sent, plus data->issued to send next frame
-                LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                data->issued += frame->getFrameLength();
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
+
+            if (bytesWrite < n) {
+                subThreadMsg->fragmentIssued += bytesWrite;
+                LOGD("frame wasn't sent completely, bytesWrite: %d, remain: %d\n", (int)bytesWrite, (int)(n - bytesWrite));
+                break;
             }
-            // Safely done!
-            else {
-                LOGD("Safely done, msg(%d)!\n", subThreadMsg->id);
-                if (remaining == frame->getFrameLength()) {
-                    LOGD("msg(%u) append: %d + %d = %d\n", subThreadMsg->id, (int)data->issued, (int)frame->getFrameLength(), (int)(data->issued + frame->getFrameLength()));
-                    LOGD("msg(%u) was totally sent!\n", subThreadMsg->id);
-                } else {
-                    LOGD("ERROR: msg(%u), remaining(%d) < bytesWrite(%d)\n", subThreadMsg->id, (int)remaining, (int)frame->getFrameLength());
-                    LOGD("Drop the msg(%u)\n", subThreadMsg->id);
-                    closeAsync();
-                }
 
-                CC_SAFE_FREE(data->bytes);
-                delete (static_cast<WebSocketFrame *>(data->ext));
-                data->ext = nullptr;
-                CC_SAFE_DELETE(data);
-                wsHelper->_subThreadWsMessageQueue->erase(iter);
-                CC_SAFE_DELETE(subThreadMsg);
+            // A fragment was totally sent
+            data->issued += fragmentLength;
+            subThreadMsg->fragmentIssued = 0;
+            batchBytes += n;
 
-                LOGD("-----------------------------------------------------------\n");
+            if (data->issued >= data->len) {
+                LOGD("msg(%u) was totally sent!\n", subThreadMsg->id);
+                iter = queue.erase(iter);
+                destroySendingMessage(subThreadMsg);
             }
         }
-
-    } while (false);
+    }
 
     if (_wsInstance != nullptr) {
         lws_callback_on_writable(_wsInstance);
@@ -1138,11 +1152,15 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
     // In websocket thread
     static int packageIndex = 0;
     packageIndex++;
+    if (_receivedData == nullptr) {
+        _receivedData = wsBufferPool.acquire(WS_RESERVE_RECEIVE_BUFFER_SIZE);
+    }
+
     if (in != nullptr && len > 0) {
         LOGD("Receiving data:index:%d, len=%d\n", packageIndex, (int)len);
 
         auto *inData = static_cast<unsigned char *>(in);
-        _receivedData.insert(_receivedData.end(), inData, inData + len);
+        _receivedData->insert(_receivedData->end(), inData, inData + len);
     } else {
         LOGD("Empty message received, index=%d!\n", packageIndex);
     }
@@ -1153,40 +1171,63 @@ int WebSocketImpl::onClientReceivedData(void *in, ssize_t len) {
     //    LOGD("remainingSize: %d, isFinalFragment: %d\n", (int)remainingSize, isFinalFragment);
 
     if (remainingSize == 0 && isFinalFragment) {
-        auto *frameData = new (std::nothrow) ccstd::vector<char>(std::move(_receivedData));
+        deliverReceivedData(lws_frame_is_binary(_wsInstance) != 0);
+    }
 
-        // reset capacity of received data buffer
-        _receivedData.reserve(WS_RESERVE_RECEIVE_BUFFER_SIZE);
+    return 0;
+}
 
-        ssize_t frameSize = frameData->size();
+void WebSocketImpl::deliverReceivedData(bool isBinary) {
+    // In websocket thread
+    WsInbox::Message message;
+    message.buffer   = _receivedData;
+    message.len      = static_cast<ssize_t>(_receivedData->size());
+    message.isBinary = isBinary;
+    if (!isBinary) {
+        _receivedData->push_back('\0');
+    }
+    _receivedData = nullptr;
 
-        bool isBinary = (lws_frame_is_binary(_wsInstance) != 0);
+    std::shared_ptr<WsInbox> inbox        = _inbox;
+    bool                     needSchedule = false;
+    {
+        std::lock_guard<std::mutex> lk(inbox->mutex);
+        inbox->messages.push_back(message);
+        needSchedule     = !inbox->scheduled;
+        inbox->scheduled = true;
+    }
 
-        if (!isBinary) {
-            frameData->push_back('\0');
-        }
+    // Messages arriving before the scheduled function runs join the same batch
+    if (!needSchedule) {
+        return;
+    }
 
-        std::shared_ptr<std::atomic<bool>> isDestroyed = _isDestroyed;
-        wsHelper->sendMessageToCocosThread([this, frameData, frameSize, isBinary, isDestroyed]() {
-            // In UI thread
-            LOGD("Notify data len %d to Cocos thread.\n", (int)frameSize);
+    std::shared_ptr<std::atomic<bool>> isDestroyed = _isDestroyed;
+    wsHelper->sendMessageToCocosThread([this, inbox, isDestroyed]() {
+        // In UI thread
+        {
+            std::lock_guard<std::mutex> lk(inbox->mutex);
+            inbox->delivering.swap(inbox->messages);
+            inbox->scheduled = false;
+        }
 
-            cc::network::WebSocket::Data data;
-            data.isBinary = isBinary;
-            data.bytes    = static_cast<char *>(frameData->data());
-            data.len      = frameSize;
+        LOGD("Notify %d messages to Cocos thread.\n", (int)inbox->delivering.size());
 
+        for (auto &received : inbox->delivering) {
+            // onMessage may close and destroy the websocket, check it for every message
             if (*isDestroyed) {
                 LOGD("WebSocket instance was destroyed!\n");
             } else {
+                cc::network::WebSocket::Data data;
+                data.isBinary = received.isBinary;
+                data.bytes    = received.buffer->data();
+                data.len      = received.len;
                 _delegate->onMessage(_ws, data);
             }
-
-            delete frameData;
-        });
-    }
-
-    return 0;
+            wsBufferPool.release(received.buffer);
+        }
+        inbox->delivering.clear();
+    });
 }
 
 int WebSocketImpl::onConnectionOpened() {
@@ -0,0 +1,182 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "physics/physx/PhysXCookingCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "base/Log.h"
+#include "boost/functional/hash.hpp"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace physics {
+
+namespace {
+
+constexpr uint32_t COOKED_MAGIC = 0x4b434350; // "PCCK"
+
+struct CookedHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pointCount;
+    uint32_t indexCount;
+    uint64_t hash;
+};
+
+CookedHeader makeHeader(size_t hash, uint32_t pointCount, uint32_t indexCount) {
+    return CookedHeader{COOKED_MAGIC, PX_PHYSICS_VERSION, pointCount, indexCount, static_cast<uint64_t>(hash)};
+}
+
+void hashBoundedData(size_t &seed, const physx::PxBoundedData &data) {
+    if (data.data == nullptr || data.count == 0) return;
+    const auto * bytes = static_cast<const uint8_t *>(data.data);
+    const size_t size  = static_cast<size_t>(data.count) * data.stride;
+    const size_t words = size / sizeof(uint32_t);
+    uint32_t     word;
+    for (size_t i = 0; i < words; ++i) {
+        memcpy(&word, bytes + i * sizeof(uint32_t), sizeof(uint32_t));
+        boost::hash_combine(seed, word);
+    }
+    for (size_t i = words * sizeof(uint32_t); i < size; ++i) {
+        boost::hash_combine(seed, bytes[i]);
+    }
+}
+
+} // namespace
+
+PhysXCookingCache::PhysXCookingCache(physx::PxCooking &cooking) : _cooking(cooking) {
+}
+
+physx::PxTriangleMesh *PhysXCookingCache::createTriangleMesh(const physx::PxTriangleMeshDesc &desc) {
+    physx::PxPhysics &physics = PxGetPhysics();
+    if (!_enabled) return _cooking.createTriangleMesh(desc, physics.getPhysicsInsertionCallback());
+
+    const EntryKey      key      = getKey(desc.points, desc.triangles, static_cast<physx::PxU32>(desc.flags));
+    const ccstd::string fileName = getFileName(key, "tri");
+    Data                data;
+    if (load(fileName, key, data)) {
+        physx::PxDefaultMemoryInputData input(data.getBytes() + sizeof(CookedHeader), static_cast<physx::PxU32>(data.getSize() - sizeof(CookedHeader)));
+        physx::PxTriangleMesh *         mesh = physics.createTriangleMesh(input);
+        if (mesh != nullptr) return mesh;
+    }
+
+    physx::PxDefaultMemoryOutputStream cooked;
+    if (!_cooking.cookTriangleMesh(desc, cooked)) return nullptr;
+    store(fileName, key, cooked);
+    physx::PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+    return physics.createTriangleMesh(input);
+}
+
+physx::PxConvexMesh *PhysXCookingCache::createConvexMesh(const physx::PxConvexMeshDesc &desc) {
+    physx::PxPhysics &physics = PxGetPhysics();
+    if (!_enabled) return _cooking.createConvexMesh(desc, physics.getPhysicsInsertionCallback());
+
+    const EntryKey      key      = getKey(desc.points, desc.indices, static_cast<physx::PxU32>(desc.flags));
+    const ccstd::string fileName = getFileName(key, "cvx");
+    Data                data;
+    if (load(fileName, key, data)) {
+        physx::PxDefaultMemoryInputData input(data.getBytes() + sizeof(CookedHeader), static_cast<physx::PxU32>(data.getSize() - sizeof(CookedHeader)));
+        physx::PxConvexMesh *           mesh = physics.createConvexMesh(input);
+        if (mesh != nullptr) return mesh;
+    }
+
+    physx::PxDefaultMemoryOutputStream cooked;
+    if (!_cooking.cookConvexMesh(desc, cooked)) return nullptr;
+    store(fileName, key, cooked);
+    physx::PxDefaultMemoryInputData input(cooked.getData(), cooked.getSize());
+    return physics.createConvexMesh(input);
+}
+
+PhysXCookingCache::EntryKey PhysXCookingCache::getKey(const physx::PxBoundedData &points, const physx::PxBoundedData &indices, uint32_t flags) const {
+    // everything that changes the cooked output is part of the key
+    const physx::PxCookingParams &params = _cooking.getParams();
+    size_t                        seed   = 0;
+    boost::hash_combine(seed, params.scale.length);
+    boost::hash_combine(seed, params.scale.speed);
+    boost::hash_combine(seed, params.meshWeldTolerance);
+    boost::hash_combine(seed, params.areaTestEpsilon);
+    boost::hash_combine(seed, params.planeTolerance);
+    boost::hash_combine(seed, params.gaussMapLimit);
+    boost::hash_combine(seed, static_cast<physx::PxU32>(params.meshPreprocessParams));
+    boost::hash_combine(seed, static_cast<uint32_t>(params.midphaseDesc.getType()));
+    boost::hash_combine(seed, static_cast<uint32_t>(params.convexMeshCookingType));
+    boost::hash_combine(seed, params.buildTriangleAdjacencies);
+    boost::hash_combine(seed, params.suppressTriangleMeshRemapTable);
+    boost::hash_combine(seed, flags);
+    boost::hash_combine(seed, points.stride);
+    boost::hash_combine(seed, indices.stride);
+    hashBoundedData(seed, points);
+    hashBoundedData(seed, indices);
+    return EntryKey{seed, points.count, indices.count};
+}
+
+ccstd::string PhysXCookingCache::getFileName(const EntryKey &key, const char *extension) const {
+    char name[64];
+    snprintf(name, sizeof(name), "%016llx-%x-%x.%s", static_cast<unsigned long long>(key.hash), key.pointCount, key.indexCount, extension);
+    return name;
+}
+
+bool PhysXCookingCache::load(const ccstd::string &fileName, const EntryKey &key, Data &data) const {
+    auto *fileUtils = FileUtils::getInstance();
+    // prebaked entries are found through the search paths, runtime entries in the writable path
+    ccstd::string path = _directory + fileName;
+    if (!fileUtils->isFileExist(path)) {
+        path = fileUtils->getWritablePath() + path;
+        if (!fileUtils->isFileExist(path)) return false;
+    }
+
+    data = fileUtils->getDataFromFile(path);
+    if (data.getSize() <= static_cast<ssize_t>(sizeof(CookedHeader))) return false;
+
+    CookedHeader       header;
+    const CookedHeader expected = makeHeader(key.hash, key.pointCount, key.indexCount);
+    memcpy(&header, data.getBytes(), sizeof(CookedHeader));
+    // entries of another PhysX version or a hash collision are cooked again and overwritten
+    return header.magic == expected.magic && header.version == expected.version && header.hash == expected.hash &&
+           header.pointCount == expected.pointCount && header.indexCount == expected.indexCount;
+}
+
+void PhysXCookingCache::store(const ccstd::string &fileName, const EntryKey &key, const physx::PxDefaultMemoryOutputStream &cooked) const {
+    auto *              fileUtils = FileUtils::getInstance();
+    const ccstd::string dir       = fileUtils->getWritablePath() + _directory;
+    if (!fileUtils->isDirectoryExist(dir) && !fileUtils->createDirectory(dir)) return;
+
+    const size_t size  = sizeof(CookedHeader) + cooked.getSize();
+    auto *       bytes = static_cast<unsigned char *>(malloc(size));
+    if (bytes == nullptr) return;
+    const CookedHeader header = makeHeader(key.hash, key.pointCount, key.indexCount);
+    memcpy(bytes, &header, sizeof(CookedHeader));
+    memcpy(bytes + sizeof(CookedHeader), cooked.getData(), cooked.getSize());
+
+    Data data;
+    data.fastSet(bytes, static_cast<ssize_t>(size));
+    if (!fileUtils->writeDataToFile(data, dir + fileName)) {
+        CC_LOG_WARNING("PhysXCookingCache: failed to write %s", (dir + fileName).c_str());
+    }
+}
+
+} // namespace physics
+} // namespace cc
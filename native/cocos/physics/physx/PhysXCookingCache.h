@@ -0,0 +1,77 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "physics/physx/PhysXInc.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * Keeps cooked triangle and convex meshes on disk, keyed by a hash of the mesh data and the cooking parameters,
+ * so loading a level deserializes them instead of cooking them again. Prebaked entries are looked up in the
+ * search paths before the writable path, entries cooked at runtime are written to the writable path.
+ */
+class PhysXCookingCache final {
+public:
+    explicit PhysXCookingCache(physx::PxCooking &cooking);
+    ~PhysXCookingCache() = default;
+
+    physx::PxTriangleMesh *createTriangleMesh(const physx::PxTriangleMeshDesc &desc);
+    physx::PxConvexMesh *  createConvexMesh(const physx::PxConvexMeshDesc &desc);
+
+    // disabled, meshes are cooked in memory and nothing is read or written
+    inline void setEnabled(bool v) { _enabled = v; }
+    inline bool isEnabled() const { return _enabled; }
+    // relative to the search paths and the writable path
+    inline void                 setDirectory(const ccstd::string &dir) { _directory = dir; }
+    inline const ccstd::string &getDirectory() const { return _directory; }
+
+private:
+    struct EntryKey {
+        size_t   hash{0};
+        uint32_t pointCount{0};
+        uint32_t indexCount{0};
+    };
+
+    EntryKey      getKey(const physx::PxBoundedData &points, const physx::PxBoundedData &indices, uint32_t flags) const;
+    ccstd::string getFileName(const EntryKey &key, const char *extension) const;
+    // data keeps the whole file, the cooked mesh follows the header
+    bool          load(const ccstd::string &fileName, const EntryKey &key, Data &data) const;
+    void          store(const ccstd::string &fileName, const EntryKey &key, const physx::PxDefaultMemoryOutputStream &cooked) const;
+
+    physx::PxCooking &_cooking;
+    ccstd::string     _directory{"physx-cooked/"};
+    bool              _enabled{true};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PhysXCookingCache);
+};
+
+} // namespace physics
+} // namespace cc
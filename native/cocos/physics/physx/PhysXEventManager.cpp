@@ -25,6 +25,7 @@
 
 #include "physics/physx/PhysXEventManager.h"
 #include <algorithm>
+#include <cstring>
 #include "physics/physx/PhysXInc.h"
 #include "physics/physx/PhysXUtils.h"
 #include "physics/physx/shapes/PhysXShape.h"
@@ -33,6 +34,27 @@
 namespace cc {
 namespace physics {
 
+namespace {
+
+constexpr uint32_t INITIAL_STREAM_PAIRS  = 64;
+constexpr uint32_t INITIAL_STREAM_POINTS = 256;
+
+template <typename T>
+inline T *streamData(const TypedArrayTemp<T> &stream) {
+    return reinterpret_cast<T *>(stream.buffer()->getData() + stream.byteOffset());
+}
+
+// grows geometrically and keeps the used elements, so the buffers stop reallocating once the scene settles
+template <typename T>
+void reserveStream(TypedArrayTemp<T> &stream, uint32_t used, uint32_t required) {
+    if (required <= stream.length()) return;
+    TypedArrayTemp<T> grown(std::max(required, stream.length() * 2));
+    if (used > 0) memcpy(streamData(grown), streamData(stream), used * sizeof(T));
+    stream = std::move(grown);
+}
+
+} // namespace
+
 void PhysXEventManager::SimulationEventCallback::onTrigger(physx::PxTriggerPair *pairs, physx::PxU32 count) {
     for (physx::PxU32 i = 0; i < count; i++) {
         const physx::PxTriggerPair &tp = pairs[i];
@@ -75,7 +97,18 @@ void PhysXEventManager::SimulationEventCallback::onContact(const physx::PxContac
 
         const auto &self  = selfIter->second;
         const auto &other = otherIter->second;
-        auto &      pairs = mManager->getConatctPairs();
+        if (mManager->isContactStreamEnabled()) {
+            ETouchState state = ETouchState::ENTER;
+            if (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS) {
+                state = ETouchState::STAY;
+            } else if (!(cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND) && (cp.events & physx::PxPairFlag::eNOTIFY_TOUCH_LOST)) {
+                state = ETouchState::EXIT;
+            }
+            mManager->writeContactStream(self, other, state, cp);
+            continue;
+        }
+
+        auto &pairs = mManager->getConatctPairs();
         auto        iter  = std::find_if(pairs.begin(), pairs.end(), [self, other](std::shared_ptr<ContactEventPair> &pair) {
             return (pair->shapeA == self || pair->shapeA == other) && (pair->shapeB == self || pair->shapeB == other);
         });
@@ -101,6 +134,45 @@ void PhysXEventManager::SimulationEventCallback::onContact(const physx::PxContac
     }
 }
 
+void PhysXEventManager::setContactStreamEnabled(bool v) {
+    _mContactStreamEnabled = v;
+    // allocated up front so that the views handed to the script are never empty
+    if (v) {
+        reserveStream(_mStreamHeaders, 0, INITIAL_STREAM_PAIRS * CONTACT_STREAM_HEADER_STRIDE);
+        reserveStream(_mStreamPoints, 0, INITIAL_STREAM_POINTS * CONTACT_STREAM_POINT_STRIDE);
+    }
+}
+
+void PhysXEventManager::writeContactStream(uintptr_t shapeA, uintptr_t shapeB, ETouchState state, const physx::PxContactPair &cp) {
+    const auto key  = shapeA < shapeB ? std::make_pair(shapeA, shapeB) : std::make_pair(shapeB, shapeA);
+    auto       iter = _mStreamPairIndices.find(key);
+    uint32_t   pairIndex;
+    if (iter == _mStreamPairIndices.end()) {
+        pairIndex = _mStreamPairCount++;
+        reserveStream(_mStreamHeaders, pairIndex * CONTACT_STREAM_HEADER_STRIDE, _mStreamPairCount * CONTACT_STREAM_HEADER_STRIDE);
+        _mStreamPairIndices.emplace(key, pairIndex);
+    } else {
+        pairIndex = iter->second;
+    }
+
+    // the stream points share the layout of PxContactPairPoint, so contacts are extracted in place
+    const uint32_t contactCount = cp.contactCount;
+    physx::PxU32   pointCount   = 0;
+    if (contactCount > 0) {
+        reserveStream(_mStreamPoints, _mStreamPointCount * CONTACT_STREAM_POINT_STRIDE, (_mStreamPointCount + contactCount) * CONTACT_STREAM_POINT_STRIDE);
+        auto *points = reinterpret_cast<physx::PxContactPairPoint *>(streamData(_mStreamPoints)) + _mStreamPointCount;
+        pointCount   = cp.extractContacts(points, contactCount);
+    }
+
+    double *header = streamData(_mStreamHeaders) + pairIndex * CONTACT_STREAM_HEADER_STRIDE;
+    header[0]      = static_cast<double>(shapeA);
+    header[1]      = static_cast<double>(shapeB);
+    header[2]      = static_cast<double>(state);
+    header[3]      = static_cast<double>(_mStreamPointCount);
+    header[4]      = static_cast<double>(pointCount);
+    _mStreamPointCount += pointCount;
+}
+
 void PhysXEventManager::refreshPairs() {
     for (auto iter = getTriggerPairs().begin(); iter != getTriggerPairs().end();) {
         const auto &selfIter  = getPxShapeMap().find(reinterpret_cast<uintptr_t>(&(reinterpret_cast<PhysXShape *>(iter->get()->shapeA)->getShape())));
@@ -116,6 +188,9 @@ void PhysXEventManager::refreshPairs() {
     }
 
     getConatctPairs().clear();
+    _mStreamPairCount  = 0;
+    _mStreamPointCount = 0;
+    _mStreamPairIndices.clear();
 }
 
 } // namespace physics
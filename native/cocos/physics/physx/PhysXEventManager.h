@@ -27,7 +27,9 @@
 
 #include <memory>
 #include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
 #include "base/std/container/vector.h"
+#include "core/TypedArray.h"
 #include "physics/physx/PhysXInc.h"
 #include "physics/spec/IWorld.h"
 
@@ -62,10 +64,32 @@ public:
     inline ccstd::vector<std::shared_ptr<ContactEventPair>> &getConatctPairs() { return _mConatctPairs; }
     void                                                     refreshPairs();
 
+    // contacts go to the flat stream instead of the contact pairs when enabled, see CONTACT_STREAM_HEADER_STRIDE
+    void                       setContactStreamEnabled(bool v);
+    inline bool                isContactStreamEnabled() const { return _mContactStreamEnabled; }
+    inline uint32_t            getContactStreamCount() const { return _mStreamPairCount; }
+    inline const Float64Array &getContactStreamHeaders() const { return _mStreamHeaders; }
+    inline const Float32Array &getContactStreamPoints() const { return _mStreamPoints; }
+    void                       writeContactStream(uintptr_t shapeA, uintptr_t shapeB, ETouchState state, const physx::PxContactPair &cp);
+
 private:
+    struct ShapePairHash {
+        size_t operator()(const std::pair<uintptr_t, uintptr_t> &pair) const {
+            return std::hash<uintptr_t>()(pair.first) ^ (std::hash<uintptr_t>()(pair.second) * 31);
+        }
+    };
+
     ccstd::vector<std::shared_ptr<TriggerEventPair>> _mTriggerPairs;
     ccstd::vector<std::shared_ptr<ContactEventPair>> _mConatctPairs;
     SimulationEventCallback *                        _mCallback;
+
+    bool         _mContactStreamEnabled{false};
+    uint32_t     _mStreamPairCount{0};
+    uint32_t     _mStreamPointCount{0};
+    Float64Array _mStreamHeaders;
+    Float32Array _mStreamPoints;
+    // substeps report a pair again before the stream is consumed, the later report overwrites the header
+    ccstd::unordered_map<std::pair<uintptr_t, uintptr_t>, uint32_t, ShapePairHash> _mStreamPairIndices;
 };
 
 } // namespace physics
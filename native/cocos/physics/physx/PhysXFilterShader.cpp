@@ -40,16 +40,26 @@ physx::PxFilterFlags simpleFilterShader(
         return physx::PxFilterFlag::eSUPPRESS;
     }
 
+    // events requested by either shape, see PhysXShape::updateEventListener
+    const physx::PxU32 detectFlags = fd0.word3 | fd1.word3;
+
     if (physx::PxFilterObjectIsTrigger(attributes0) || physx::PxFilterObjectIsTrigger(attributes1)) {
+        if (!(detectFlags & DETECT_TRIGGER_EVENT)) {
+            return physx::PxFilterFlag::eSUPPRESS;
+        }
         pairFlags |= physx::PxPairFlag::eTRIGGER_DEFAULT | physx::PxPairFlag::eNOTIFY_TOUCH_CCD;
         return physx::PxFilterFlag::eDEFAULT;
     }
     if (!physx::PxFilterObjectIsKinematic(attributes0) || !physx::PxFilterObjectIsKinematic(attributes1)) {
         pairFlags |= physx::PxPairFlag::eSOLVE_CONTACT;
     }
-    pairFlags |= physx::PxPairFlag::eDETECT_DISCRETE_CONTACT |
-                 physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_LOST | physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS |
-                 physx::PxPairFlag::eDETECT_CCD_CONTACT | physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
+    pairFlags |= physx::PxPairFlag::eDETECT_DISCRETE_CONTACT | physx::PxPairFlag::eDETECT_CCD_CONTACT;
+    if (detectFlags & DETECT_CONTACT_EVENT) {
+        pairFlags |= physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_LOST | physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS;
+    }
+    if (detectFlags & DETECT_CONTACT_POINT) {
+        pairFlags |= physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
+    }
     return physx::PxFilterFlag::eDEFAULT;
 }
 
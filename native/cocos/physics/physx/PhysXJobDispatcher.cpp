@@ -0,0 +1,100 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "physics/physx/PhysXJobDispatcher.h"
+#include <algorithm>
+#include <thread>
+#include "base/job-system/JobSystem.h"
+
+namespace cc {
+namespace physics {
+
+PhysXJobDispatcher::PhysXJobDispatcher(uint32_t workerCount) {
+    setWorkerCount(workerCount);
+}
+
+void PhysXJobDispatcher::setWorkerCount(uint32_t workerCount) {
+    CC_ASSERT(!_stepping.load(std::memory_order_relaxed));
+    const uint32_t threadCount = JobSystem::getInstance()->threadCount();
+    // with a single job thread the calling thread alone is as fast and spins less
+    _workerCount = threadCount > 1 ? std::min(workerCount, threadCount) : 0;
+}
+
+void PhysXJobDispatcher::submitTask(physx::PxBaseTask &task) {
+    if (_workerCount == 0 || !_stepping.load(std::memory_order_acquire)) {
+        task.run();
+        task.release();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.push_back(&task);
+}
+
+physx::PxBaseTask *PhysXJobDispatcher::popTask() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_tasks.empty()) {
+        return nullptr;
+    }
+    auto *task = _tasks.front();
+    _tasks.pop_front();
+    return task;
+}
+
+void PhysXJobDispatcher::runTasks() {
+    while (!_stepDone.load(std::memory_order_acquire)) {
+        auto *task = popTask();
+        if (task) {
+            task->run();
+            task->release();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void PhysXJobDispatcher::simulate(physx::PxScene &scene, float dt) {
+    _stepDone.store(false, std::memory_order_relaxed);
+    _stepping.store(true, std::memory_order_release);
+
+    // the scene holds a reference to the completion task until the step is complete, then the task gets submitted
+    _completionTask.setContinuation(*scene.getTaskManager(), nullptr);
+    scene.simulate(dt, &_completionTask);
+    _completionTask.removeReference();
+
+    if (_workerCount > 0) {
+        JobGraph graph(JobSystem::getInstance());
+        graph.createForEachIndexJob(1, _workerCount, 1, [this](uint /*index*/) { runTasks(); });
+        graph.run();
+        runTasks();
+        graph.waitForAll();
+    }
+    CC_ASSERT(_stepDone.load(std::memory_order_relaxed));
+
+    _stepping.store(false, std::memory_order_release);
+}
+
+} // namespace physics
+} // namespace cc
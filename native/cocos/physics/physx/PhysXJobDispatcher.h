@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/deque.h"
+#include "physics/physx/PhysXInc.h"
+
+namespace cc {
+namespace physics {
+
+/**
+ * Runs the PhysX tasks of a simulation step on the job system workers and the thread calling simulate(),
+ * instead of on worker threads owned by PhysX.
+ */
+class PhysXJobDispatcher final : public physx::PxCpuDispatcher {
+public:
+    // workerCount includes the calling thread and is clamped to the job system thread count, 0 runs every task on the submitting thread
+    explicit PhysXJobDispatcher(uint32_t workerCount);
+    ~PhysXJobDispatcher() override = default;
+
+    void     submitTask(physx::PxBaseTask &task) override;
+    uint32_t getWorkerCount() const override { return _workerCount; }
+
+    void setWorkerCount(uint32_t workerCount);
+
+    // simulates one step of the scene, returns when fetchResults() no longer has to wait
+    void simulate(physx::PxScene &scene, float dt);
+
+private:
+    class CompletionTask final : public physx::PxLightCpuTask {
+    public:
+        explicit CompletionTask(std::atomic<bool> &done) : _done(done) {}
+        void        run() override { _done.store(true, std::memory_order_release); }
+        const char *getName() const override { return "cc::PhysXJobDispatcher::CompletionTask"; }
+
+    private:
+        std::atomic<bool> &_done;
+    };
+
+    physx::PxBaseTask *popTask();
+    // runs queued tasks until the step is complete, called on every thread taking part in the step
+    void runTasks();
+
+    std::mutex                        _mutex;
+    ccstd::deque<physx::PxBaseTask *> _tasks;
+    std::atomic<bool>                 _stepping{false};
+    std::atomic<bool>                 _stepDone{false};
+    CompletionTask                    _completionTask{_stepDone};
+    uint32_t                          _workerCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PhysXJobDispatcher);
+};
+
+} // namespace physics
+} // namespace cc
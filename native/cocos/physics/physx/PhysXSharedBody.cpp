@@ -177,8 +177,9 @@ void PhysXSharedBody::initStaticActor() {
         pxSetQuatExt(transform.q, getNode()->getWorldRotation());
         if (!transform.p.isFinite()) transform.p = PxVec3{PxIdentity};
         if (!transform.q.isUnit()) transform.q = PxQuat{PxIdentity};
-        PxPhysics &phy = PxGetPhysics();
-        _mStaticActor  = phy.createRigidStatic(transform);
+        PxPhysics &phy          = PxGetPhysics();
+        _mStaticActor           = phy.createRigidStatic(transform);
+        _mStaticActor->userData = this;
     }
 }
 
@@ -190,9 +191,11 @@ void PhysXSharedBody::initDynamicActor() {
         pxSetQuatExt(transform.q, getNode()->getWorldRotation());
         if (!transform.p.isFinite()) transform.p = PxVec3{PxIdentity};
         if (!transform.q.isUnit()) transform.q = PxQuat{PxIdentity};
-        PxPhysics &phy = PxGetPhysics();
-        _mDynamicActor = phy.createRigidDynamic(transform);
+        PxPhysics &phy           = PxGetPhysics();
+        _mDynamicActor           = phy.createRigidDynamic(transform);
+        _mDynamicActor->userData = this;
         _mDynamicActor->setRigidBodyFlag(PxRigidBodyFlag::eKINEMATIC, isKinematic());
+        resetSimulatedPose(transform);
     }
 }
 
@@ -220,47 +223,101 @@ void PhysXSharedBody::syncScale() {
     }
 }
 
+bool PhysXSharedBody::getChangedScenePose(PxTransform &pose) {
+    const uint32_t changedFlags = getNode()->getChangedFlags();
+    if (!changedFlags) return false;
+
+    if (changedFlags & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
+    const bool positionChanged = changedFlags & static_cast<uint32_t>(TransformBit::POSITION);
+    const bool rotationChanged = changedFlags & static_cast<uint32_t>(TransformBit::ROTATION);
+    if (!positionChanged || !rotationChanged) {
+        pose = getImpl().rigidActor->getGlobalPose();
+    }
+    if (positionChanged || rotationChanged) {
+        getNode()->updateWorldTransform();
+    }
+    if (positionChanged) {
+        pxSetVec3Ext(pose.p, getNode()->getWorldPosition());
+    }
+    if (rotationChanged) {
+        pxSetQuatExt(pose.q, getNode()->getWorldRotation());
+    }
+    return true;
+}
+
 void PhysXSharedBody::syncSceneToPhysics() {
-    uint32_t getChangedFlags = getNode()->getChangedFlags();
-    if (getChangedFlags) {
-        if (getChangedFlags & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
-        auto wp = getImpl().rigidActor->getGlobalPose();
-        if (getChangedFlags & static_cast<uint32_t>(TransformBit::POSITION)) {
-            getNode()->updateWorldTransform();
-            pxSetVec3Ext(wp.p, getNode()->getWorldPosition());
-        }
-        if (getChangedFlags & static_cast<uint32_t>(TransformBit::ROTATION)) {
-            getNode()->updateWorldTransform();
-            pxSetQuatExt(wp.q, getNode()->getWorldRotation());
-        }
+    PxTransform wp;
+    if (!getChangedScenePose(wp)) return;
 
-        if (isKinematic()) {
-            getImpl().rigidDynamic->setKinematicTarget(wp);
-        } else {
-            getImpl().rigidActor->setGlobalPose(wp, true);
-        }
+    if (isKinematic()) {
+        getImpl().rigidDynamic->setKinematicTarget(wp);
+    } else {
+        getImpl().rigidActor->setGlobalPose(wp, true);
+        resetSimulatedPose(wp);
     }
 }
 
 void PhysXSharedBody::syncSceneWithCheck() {
-    if (getNode()->getChangedFlags() & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
+    // a node which did not change this frame matches its actor already
+    const uint32_t changedFlags = getNode()->getChangedFlags();
+    if (!changedFlags) return;
+    if (changedFlags & static_cast<uint32_t>(TransformBit::SCALE)) syncScale();
+    getNode()->updateWorldTransform();
+    if (_mHasInterpolatedPose && isInterpolatedPose(getNode()->getWorldPosition(), getNode()->getWorldRotation())) {
+        // the node is only rendered between two simulated poses, the actor is where it should be
+        return;
+    }
     auto wp         = getImpl().rigidActor->getGlobalPose();
     bool needUpdate = false;
-    getNode()->updateWorldTransform();
     if (wp.p != getNode()->getWorldPosition()) {
         pxSetVec3Ext(wp.p, getNode()->getWorldPosition());
         needUpdate = true;
     }
     const auto nr = getNode()->getWorldRotation();
-    if (wp.q.x != nr.x && wp.q.y != nr.y && wp.q.z != nr.z) {
+    if (wp.q.x != nr.x || wp.q.y != nr.y || wp.q.z != nr.z || wp.q.w != nr.w) {
         pxSetQuatExt(wp.q, getNode()->getWorldRotation());
         needUpdate = true;
     }
     if (needUpdate) {
         getImpl().rigidActor->setGlobalPose(wp, true);
+        resetSimulatedPose(wp);
     }
 }
 
+void PhysXSharedBody::recordSimulatedPose() {
+    _mPrevPose = _mCurrPose;
+    _mCurrPose = getImpl().rigidActor->getGlobalPose();
+}
+
+bool PhysXSharedBody::isInterpolatedPose(const Vec3 &position, const Quaternion &rotation) const {
+    // the world transform is recomputed from the local one, so it only comes back close to what was set
+    constexpr float POSITION_TOLERANCE_SQ = 1e-8F;
+    constexpr float ROTATION_TOLERANCE    = 1e-6F;
+    const auto &    p                     = _mInterpolatedPose.p;
+    const auto &    q                     = _mInterpolatedPose.q;
+    const PxVec3    dp                    = p - PxVec3{position.x, position.y, position.z};
+    const float     dot                   = q.x * rotation.x + q.y * rotation.y + q.z * rotation.z + q.w * rotation.w;
+    return dp.magnitudeSquared() <= POSITION_TOLERANCE_SQ && std::fabs(dot) >= 1.F - ROTATION_TOLERANCE;
+}
+
+void PhysXSharedBody::resetSimulatedPose() {
+    if (getImpl().ptr) {
+        resetSimulatedPose(getImpl().rigidActor->getGlobalPose());
+    }
+}
+
+void PhysXSharedBody::interpolatePose(float alpha) {
+    const PxVec3 p = _mPrevPose.p + (_mCurrPose.p - _mPrevPose.p) * alpha;
+    Quaternion   q;
+    Quaternion::slerp(Quaternion{_mPrevPose.q.x, _mPrevPose.q.y, _mPrevPose.q.z, _mPrevPose.q.w},
+                      Quaternion{_mCurrPose.q.x, _mCurrPose.q.y, _mCurrPose.q.z, _mCurrPose.q.w}, alpha, &q);
+    getNode()->setWorldPosition(p.x, p.y, p.z);
+    getNode()->setWorldRotation(q.x, q.y, q.z, q.w);
+    getNode()->setChangedFlags(getNode()->getChangedFlags() | static_cast<uint32_t>(TransformBit::POSITION) | static_cast<uint32_t>(TransformBit::ROTATION));
+    _mInterpolatedPose    = PxTransform{p, PxQuat{q.x, q.y, q.z, q.w}};
+    _mHasInterpolatedPose = true;
+}
+
 void PhysXSharedBody::syncPhysicsToScene() {
     if (isStaticOrKinematic()) return;
     if (_mDynamicActor->isSleeping()) return;
@@ -275,7 +332,7 @@ void PhysXSharedBody::addShape(const PhysXShape &shape) {
     auto end  = _mWrappedShapes.end();
     auto iter = find(beg, end, &shape);
     if (iter == end) {
-        shape.getShape().setSimulationFilterData(_mFilterData);
+        const_cast<PhysXShape &>(shape).updateFilterData(_mFilterData);
         shape.getShape().setQueryFilterData(_mFilterData);
         getImpl().rigidActor->attachShape(shape.getShape());
         _mWrappedShapes.push_back(&const_cast<PhysXShape &>(shape));
@@ -348,7 +405,7 @@ void PhysXSharedBody::setCollisionFilter(const PxFilterData &data) {
     if (isDynamic()) _mDynamicActor->wakeUp();
     for (auto const &ws : _mWrappedShapes) {
         ws->getShape().setQueryFilterData(data);
-        ws->getShape().setSimulationFilterData(data);
+        ws->updateFilterData(data);
     }
 }
 
@@ -66,6 +66,19 @@ public:
     void            setMass(float v);
     void            syncScale();
     void            syncSceneToPhysics();
+    // pose of the node if it changed this frame, false if there is nothing to push to the actor
+    bool            getChangedScenePose(physx::PxTransform &pose);
+    // poses of the last two simulation steps, the node is placed between them for render interpolation
+    void            recordSimulatedPose();
+    inline void     holdSimulatedPose() { _mPrevPose = _mCurrPose; }
+    void            resetSimulatedPose();
+    inline void     resetSimulatedPose(const physx::PxTransform &pose) {
+        _mPrevPose            = pose;
+        _mCurrPose            = pose;
+        _mHasInterpolatedPose = false;
+    }
+    void            interpolatePose(float alpha);
+    bool            isInterpolatedPose(const Vec3 &position, const Quaternion &rotation) const;
     void            syncSceneWithCheck();
     void            syncPhysicsToScene();
     void            updateCenterOfMass();
@@ -80,6 +93,7 @@ public:
     void            setMask(uint32_t v);
     inline uint32_t getGroup() const { return _mFilterData.word0; }
     inline uint32_t getMask() const { return _mFilterData.word1; }
+    inline const physx::PxFilterData &getFilterData() const { return _mFilterData; }
 
 private:
     static ccstd::unordered_map<Node *, PhysXSharedBody *> sharedBodesMap;
@@ -99,6 +113,10 @@ private:
     ccstd::vector<PhysXShape *>                            _mWrappedShapes;
     ccstd::vector<PhysXJoint *>                            _mWrappedJoints0;
     ccstd::vector<PhysXJoint *>                            _mWrappedJoints1;
+    physx::PxTransform                                     _mPrevPose{physx::PxIdentity};
+    physx::PxTransform                                     _mCurrPose{physx::PxIdentity};
+    physx::PxTransform                                     _mInterpolatedPose{physx::PxIdentity};
+    bool                                                   _mHasInterpolatedPose{false};
     PhysXSharedBody(Node *node, PhysXWorld *world, PhysXRigidBody *body);
     ~PhysXSharedBody();
     void initActor();
@@ -24,15 +24,91 @@
 ****************************************************************************/
 
 #include "physics/physx/PhysXWorld.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
 #include "physics/physx/PhysXUtils.h"
 #include "physics/physx/joints/PhysXJoint.h"
 #include "physics/spec/IWorld.h"
+#include "profiler/Profiler.h"
+#include "profiler/StartupTimer.h"
 
 namespace cc {
 namespace physics {
 
+namespace {
+constexpr uint32_t BATCH_QUERY_CHUNK_SIZE = 64; // queries per job
+
+template <typename T>
+T *typedArrayData(const TypedArrayTemp<T> &array) {
+    return reinterpret_cast<T *>(array.buffer()->getData() + array.byteOffset());
+}
+
+physx::PxSceneQueryFilterData batchQueryFilterData(uint32_t mask, bool queryTrigger, physx::PxU32 extraFlags) {
+    physx::PxSceneQueryFilterData filterData;
+    filterData.data.word0 = mask;
+    filterData.data.word3 = QUERY_FILTER | (queryTrigger ? 0 : QUERY_CHECK_TRIGGER) | extraFlags;
+    filterData.flags      = physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC | physx::PxQueryFlag::ePREFILTER;
+    return filterData;
+}
+
+uintptr_t findShapeHandle(const physx::PxShape *shape) {
+    const auto &shapeIter = getPxShapeMap().find(reinterpret_cast<uintptr_t>(shape));
+    return shapeIter != getPxShapeMap().end() ? shapeIter->second : 0;
+}
+
+// writes the hit and returns true if the shape is known, a miss otherwise
+bool writeBatchHit(const physx::PxLocationHit &hit, bool hasHit, float *outHit, double *outShape) {
+    const uintptr_t shape = hasHit ? findShapeHandle(hit.shape) : 0;
+    *outShape             = static_cast<double>(shape);
+    if (!shape) {
+        outHit[6] = -1.F;
+        return false;
+    }
+    outHit[0] = hit.position.x;
+    outHit[1] = hit.position.y;
+    outHit[2] = hit.position.z;
+    outHit[3] = hit.normal.x;
+    outHit[4] = hit.normal.y;
+    outHit[5] = hit.normal.z;
+    outHit[6] = hit.distance;
+    return true;
+}
+
+// scene queries only read the scene, so chunks of them run concurrently while the scene is not simulating
+template <typename Fn>
+uint32_t runBatchQueries(uint32_t count, Fn &&query) {
+    std::atomic<uint32_t> hitCount{0};
+    const uint32_t        chunkCount = (count + BATCH_QUERY_CHUNK_SIZE - 1) / BATCH_QUERY_CHUNK_SIZE;
+    auto                  job        = [&](uint32_t chunk) {
+        const uint32_t end  = std::min(count, (chunk + 1) * BATCH_QUERY_CHUNK_SIZE);
+        uint32_t       hits = 0;
+        for (uint32_t i = chunk * BATCH_QUERY_CHUNK_SIZE; i < end; ++i) {
+            hits += query(i) ? 1 : 0;
+        }
+        hitCount.fetch_add(hits, std::memory_order_relaxed);
+    };
+
+    if (chunkCount < 2 || JobSystem::getInstance()->threadCount() < 2) {
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            job(chunk);
+        }
+        return hitCount.load(std::memory_order_relaxed);
+    }
+
+    JobGraph graph(JobSystem::getInstance());
+    graph.createForEachIndexJob(1, chunkCount, 1, job);
+    graph.run();
+    job(0);
+    graph.waitForAll();
+    return hitCount.load(std::memory_order_relaxed);
+}
+} // namespace
+
 PhysXWorld *PhysXWorld::instance = nullptr;
 PhysXWorld &PhysXWorld::getInstance() {
     return *instance;
@@ -51,12 +127,14 @@ physx::PxPhysics &PhysXWorld::getPhysics() {
 }
 
 PhysXWorld::PhysXWorld() {
+    CC_STARTUP_PHASE(physics);
     instance = this;
     static physx::PxDefaultAllocator     gAllocator;
     static physx::PxDefaultErrorCallback gErrorCallback;
     _mFoundation = PxCreateFoundation(PX_PHYSICS_VERSION, gAllocator, gErrorCallback);
     physx::PxTolerancesScale scale{};
-    _mCooking = PxCreateCooking(PX_PHYSICS_VERSION, *_mFoundation, physx::PxCookingParams(scale));
+    _mCooking      = PxCreateCooking(PX_PHYSICS_VERSION, *_mFoundation, physx::PxCookingParams(scale));
+    _mCookingCache = new PhysXCookingCache(*_mCooking);
 
     physx::PxPvd *pvd = nullptr;
 #ifdef CC_DEBUG
@@ -66,19 +144,11 @@ PhysXWorld::PhysXWorld() {
 #endif
     _mPhysics = PxCreatePhysics(PX_PHYSICS_VERSION, *_mFoundation, scale, true, pvd);
     PxInitExtensions(*_mPhysics, pvd);
-    _mDispatcher = physx::PxDefaultCpuDispatcherCreate(0);
+    _mDispatcher = new PhysXJobDispatcher(JobSystem::getInstance()->threadCount());
 
     _mEventMgr = new PhysXEventManager();
 
-    physx::PxSceneDesc sceneDesc(_mPhysics->getTolerancesScale());
-    sceneDesc.gravity                 = physx::PxVec3(0.0F, -10.0F, 0.0F);
-    sceneDesc.cpuDispatcher           = _mDispatcher;
-    sceneDesc.kineKineFilteringMode   = physx::PxPairFilteringMode::eKEEP;
-    sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
-    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
-    sceneDesc.filterShader            = simpleFilterShader;
-    sceneDesc.simulationEventCallback = &_mEventMgr->getEventCallback();
-    _mScene                           = _mPhysics->createScene(sceneDesc);
+    createScene(physx::PxVec3(0.0F, -10.0F, 0.0F));
 
     _mCollisionMatrix[0] = 1;
 
@@ -92,7 +162,7 @@ PhysXWorld::~PhysXWorld() {
     delete _mEventMgr;
     PhysXJoint::releaseTempRigidActor();
     PX_RELEASE(_mScene);
-    PX_RELEASE(_mDispatcher);
+    CC_SAFE_DELETE(_mDispatcher);
     PX_RELEASE(_mPhysics);
 #ifdef CC_DEBUG
     physx::PxPvdTransport *transport = _mPvd->getTransport();
@@ -100,15 +170,147 @@ PhysXWorld::~PhysXWorld() {
     PX_RELEASE(transport);
 #endif
     // release cooking before foundation
+    CC_SAFE_DELETE(_mCookingCache);
     PX_RELEASE(_mCooking);
     PxCloseExtensions();
     PX_RELEASE(_mFoundation);
 }
 
+void PhysXWorld::createScene(const physx::PxVec3 &gravity) {
+    physx::PxSceneDesc sceneDesc(_mPhysics->getTolerancesScale());
+    sceneDesc.gravity                 = gravity;
+    sceneDesc.cpuDispatcher           = _mDispatcher;
+    sceneDesc.kineKineFilteringMode   = physx::PxPairFilteringMode::eKEEP;
+    sceneDesc.staticKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_CCD;
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_ACTIVE_ACTORS;
+    sceneDesc.filterShader               = simpleFilterShader;
+    sceneDesc.simulationEventCallback    = &_mEventMgr->getEventCallback();
+    sceneDesc.broadPhaseType             = _mSceneConfig.broadPhaseType;
+    sceneDesc.staticStructure            = _mSceneConfig.staticStructure;
+    sceneDesc.dynamicStructure           = _mSceneConfig.dynamicStructure;
+    sceneDesc.dynamicTreeRebuildRateHint = _mSceneConfig.dynamicTreeRebuildRateHint;
+    _mScene                              = _mPhysics->createScene(sceneDesc);
+
+    if (_mSceneConfig.broadPhaseType == physx::PxBroadPhaseType::eMBP) {
+        // objects outside every region are not collided, so the regions cover the whole world
+        const physx::PxU32              subdivisions = std::max(_mSceneConfig.regionSubdivisions, 1U);
+        ccstd::vector<physx::PxBounds3> regionBounds(subdivisions * subdivisions);
+        const physx::PxU32              regionCount = physx::PxBroadPhaseExt::createRegionsFromWorldBounds(
+            regionBounds.data(), _mSceneConfig.worldBounds, subdivisions);
+        for (physx::PxU32 i = 0; i < regionCount; ++i) {
+            physx::PxBroadPhaseRegion region;
+            region.bounds   = regionBounds[i];
+            region.userData = nullptr;
+            _mScene->addBroadPhaseRegion(region);
+        }
+    }
+}
+
+bool PhysXWorld::setSceneConfig(const PhysXSceneConfig &config) {
+    if (!_mSharedBodies.empty()) {
+        CC_LOG_WARNING("PhysXWorld: the scene config can only be changed before any body is added");
+        return false;
+    }
+
+    const physx::PxVec3 gravity = _mScene->getGravity();
+    PX_RELEASE(_mScene);
+    _mSceneConfig = config;
+    createScene(gravity);
+    return true;
+}
+
+void PhysXWorld::setDynamicTreeRebuildRateHint(uint32_t frames) {
+    _mSceneConfig.dynamicTreeRebuildRateHint = frames;
+    _mScene->setDynamicTreeRebuildRateHint(frames);
+}
+
+void PhysXWorld::rebuildQueryTrees() {
+    CC_PROFILE(PhysXRebuildQueryTrees);
+    _mScene->forceDynamicTreeRebuild(true, true);
+}
+
 void PhysXWorld::step(float fixedTimeStep) {
-    _mScene->simulate(fixedTimeStep);
-    _mScene->fetchResults(true);
-    syncPhysicsToScene();
+    simulateStep(fixedTimeStep, true);
+}
+
+void PhysXWorld::simulateStep(float fixedTimeStep, bool syncScene) {
+    {
+        CC_PROFILE(PhysXSimulate);
+        _mDispatcher->simulate(*_mScene, fixedTimeStep);
+    }
+    {
+        // the scene query trees are refit and their incremental rebuild is committed here
+        CC_PROFILE(PhysXFetchResults);
+        _mScene->fetchResults(true);
+    }
+#if CC_USE_PROFILER
+    physx::PxSimulationStatistics stats;
+    _mScene->getSimulationStatistics(stats);
+    CC_PROFILE_OBJECT_UPDATE(PhysXActiveDynamicBodies, stats.nbActiveDynamicBodies);
+    CC_PROFILE_OBJECT_UPDATE(PhysXBroadPhaseAdds, stats.getNbBroadPhaseAdds());
+    CC_PROFILE_OBJECT_UPDATE(PhysXBroadPhaseRemoves, stats.getNbBroadPhaseRemoves());
+#endif
+
+    if (_mInterpolationEnabled) {
+        // a body left out of this step rests at its last pose
+        for (auto *sb : _mInterpolatedBodies) {
+            sb->holdSimulatedPose();
+        }
+        _mInterpolatedBodies.clear();
+    }
+
+    // only the actors whose pose was simulated in the last step, sleeping ones are left out
+    physx::PxU32     activeCount  = 0;
+    physx::PxActor **activeActors = _mScene->getActiveActors(activeCount);
+    for (physx::PxU32 i = 0; i < activeCount; ++i) {
+        auto *sb = static_cast<PhysXSharedBody *>(activeActors[i]->userData);
+        if (!sb) continue;
+        if (_mInterpolationEnabled && sb->isDynamic()) {
+            sb->recordSimulatedPose();
+            _mInterpolatedBodies.push_back(sb);
+        }
+        if (syncScene) {
+            sb->syncPhysicsToScene();
+        }
+    }
+}
+
+uint32_t PhysXWorld::stepWithSubsteps(float deltaTime, float fixedTimeStep, uint32_t maxSubSteps) {
+    if (fixedTimeStep <= 0.F) return 0;
+
+    _mAccumulator += deltaTime;
+    uint32_t steps = 0;
+    while (_mAccumulator >= fixedTimeStep && steps < maxSubSteps) {
+        simulateStep(fixedTimeStep, !_mInterpolationEnabled);
+        _mAccumulator -= fixedTimeStep;
+        ++steps;
+    }
+    // catching up on the clamped steps over the next frames would only keep the frames slow
+    if (_mAccumulator >= fixedTimeStep) {
+        _mAccumulator = std::fmod(_mAccumulator, fixedTimeStep);
+    }
+
+    if (_mInterpolationEnabled) {
+        interpolateBodies(_mAccumulator / fixedTimeStep);
+    }
+    return steps;
+}
+
+void PhysXWorld::setInterpolationEnabled(bool v) {
+    if (_mInterpolationEnabled == v) return;
+    _mInterpolationEnabled = v;
+    // the recorded poses are stale once interpolation was off
+    for (auto *sb : _mSharedBodies) {
+        sb->resetSimulatedPose();
+    }
+    _mInterpolatedBodies.clear();
+}
+
+void PhysXWorld::interpolateBodies(float alpha) {
+    for (auto *sb : _mInterpolatedBodies) {
+        sb->interpolatePose(alpha);
+    }
 }
 
 void PhysXWorld::setGravity(float x, float y, float z) {
@@ -129,7 +331,7 @@ uintptr_t PhysXWorld::createConvex(ConvexDesc &desc) {
     convexDesc.points.stride        = sizeof(physx::PxVec3);
     convexDesc.points.data          = static_cast<physx::PxVec3 *>(desc.positions);
     convexDesc.flags                = physx::PxConvexFlag::eCOMPUTE_CONVEX;
-    physx::PxConvexMesh *convexMesh = getCooking().createConvexMesh(convexDesc, PxGetPhysics().getPhysicsInsertionCallback());
+    physx::PxConvexMesh *convexMesh = _mCookingCache->createConvexMesh(convexDesc);
     return reinterpret_cast<uintptr_t>(convexMesh);
 }
 
@@ -147,7 +349,7 @@ uintptr_t PhysXWorld::createTrimesh(TrimeshDesc &desc) {
         meshDesc.triangles.stride = 3 * sizeof(physx::PxU32);
         meshDesc.triangles.data   = static_cast<physx::PxU32 *>(desc.triangles);
     }
-    physx::PxTriangleMesh *triangleMesh = getCooking().createTriangleMesh(meshDesc, PxGetPhysics().getPhysicsInsertionCallback());
+    physx::PxTriangleMesh *triangleMesh = _mCookingCache->createTriangleMesh(meshDesc);
     return reinterpret_cast<uintptr_t>(triangleMesh);
 }
 
@@ -200,8 +402,25 @@ void PhysXWorld::emitEvents() {
 }
 
 void PhysXWorld::syncSceneToPhysics() {
+    _mKinematicTargets.clear();
+    _mGlobalPoses.clear();
+    physx::PxTransform pose;
     for (auto const &sb : _mSharedBodies) {
-        sb->syncSceneToPhysics();
+        if (!sb->getChangedScenePose(pose)) continue;
+        if (sb->isKinematic()) {
+            _mKinematicTargets.emplace_back(sb->getImpl().rigidDynamic, pose);
+        } else {
+            _mGlobalPoses.emplace_back(sb->getImpl().rigidActor, pose);
+            // a moved body jumps, it is not interpolated from where it was
+            sb->resetSimulatedPose(pose);
+        }
+    }
+
+    for (auto const &target : _mKinematicTargets) {
+        target.first->setKinematicTarget(target.second);
+    }
+    for (auto const &globalPose : _mGlobalPoses) {
+        globalPose.first->setGlobalPose(globalPose.second, true);
     }
 }
 
@@ -211,8 +430,13 @@ uint32_t PhysXWorld::getMaskByIndex(uint32_t i) {
 }
 
 void PhysXWorld::syncPhysicsToScene() {
-    for (auto const &sb : _mSharedBodies) {
-        sb->syncPhysicsToScene();
+    physx::PxU32     activeCount  = 0;
+    physx::PxActor **activeActors = _mScene->getActiveActors(activeCount);
+    for (physx::PxU32 i = 0; i < activeCount; ++i) {
+        auto *sb = static_cast<PhysXSharedBody *>(activeActors[i]->userData);
+        if (sb) {
+            sb->syncPhysicsToScene();
+        }
     }
 }
 
@@ -242,6 +466,10 @@ void PhysXWorld::removeActor(const PhysXSharedBody &sb) {
     if (iter != end) {
         _mScene->removeActor(*(const_cast<PhysXSharedBody &>(sb).getImpl().rigidActor), true);
         _mSharedBodies.erase(iter);
+        auto interpolatedIter = std::find(_mInterpolatedBodies.begin(), _mInterpolatedBodies.end(), &sb);
+        if (interpolatedIter != _mInterpolatedBodies.end()) {
+            _mInterpolatedBodies.erase(interpolatedIter);
+        }
     }
 }
 
@@ -276,6 +504,81 @@ bool PhysXWorld::raycast(RaycastOptions &opt) {
     return true;
 }
 
+uint32_t PhysXWorld::raycastClosestBatch(const Float32Array &rays, uint32_t mask, bool queryTrigger, Float32Array &hits, Float64Array &shapes) {
+    const uint32_t count = std::min({rays.length() / BATCH_RAYCAST_STRIDE, hits.length() / BATCH_HIT_STRIDE, shapes.length()});
+    CC_ASSERT(count * BATCH_RAYCAST_STRIDE == rays.length());
+
+    const float *                       rayData    = typedArrayData(rays);
+    float *                             hitData    = typedArrayData(hits);
+    double *                            shapeData  = typedArrayData(shapes);
+    const physx::PxSceneQueryFilterData filterData = batchQueryFilterData(mask, queryTrigger, QUERY_SINGLE_HIT);
+    return runBatchQueries(count, [&](uint32_t i) {
+        const float *       ray = rayData + i * BATCH_RAYCAST_STRIDE;
+        physx::PxVec3       unitDir{ray[3], ray[4], ray[5]};
+        physx::PxRaycastHit hit;
+        unitDir.normalize();
+        const bool result = physx::PxSceneQueryExt::raycastSingle(
+            getScene(), physx::PxVec3{ray[0], ray[1], ray[2]}, unitDir, ray[6],
+            physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL, hit, filterData, &getQueryFilterShader(), nullptr);
+        return writeBatchHit(hit, result, hitData + i * BATCH_HIT_STRIDE, shapeData + i);
+    });
+}
+
+uint32_t PhysXWorld::sweepSphereClosestBatch(const Float32Array &sweeps, uint32_t mask, bool queryTrigger, Float32Array &hits, Float64Array &shapes) {
+    const uint32_t count = std::min({sweeps.length() / BATCH_SWEEP_STRIDE, hits.length() / BATCH_HIT_STRIDE, shapes.length()});
+    CC_ASSERT(count * BATCH_SWEEP_STRIDE == sweeps.length());
+
+    const float *                       sweepData  = typedArrayData(sweeps);
+    float *                             hitData    = typedArrayData(hits);
+    double *                            shapeData  = typedArrayData(shapes);
+    const physx::PxSceneQueryFilterData filterData = batchQueryFilterData(mask, queryTrigger, QUERY_SINGLE_HIT);
+    return runBatchQueries(count, [&](uint32_t i) {
+        const float *     sweep = sweepData + i * BATCH_SWEEP_STRIDE;
+        physx::PxVec3     unitDir{sweep[3], sweep[4], sweep[5]};
+        physx::PxSweepHit hit;
+        unitDir.normalize();
+        const bool result = physx::PxSceneQueryExt::sweepSingle(
+            getScene(), physx::PxSphereGeometry{sweep[7]}, physx::PxTransform{physx::PxVec3{sweep[0], sweep[1], sweep[2]}},
+            unitDir, sweep[6], physx::PxHitFlag::ePOSITION | physx::PxHitFlag::eNORMAL, hit, filterData, &getQueryFilterShader(), nullptr);
+        return writeBatchHit(hit, result, hitData + i * BATCH_HIT_STRIDE, shapeData + i);
+    });
+}
+
+uint32_t PhysXWorld::overlapSphereBatch(const Float32Array &spheres, uint32_t mask, bool queryTrigger,
+                                        uint32_t maxShapesPerQuery, Float64Array &shapes, Uint32Array &counts) {
+    if (maxShapesPerQuery == 0) return 0;
+    const uint32_t count = std::min({spheres.length() / BATCH_OVERLAP_STRIDE, shapes.length() / maxShapesPerQuery, counts.length()});
+    CC_ASSERT(count * BATCH_OVERLAP_STRIDE == spheres.length());
+
+    const float *                       sphereData = typedArrayData(spheres);
+    double *                            shapeData  = typedArrayData(shapes);
+    uint32_t *                          countData  = typedArrayData(counts);
+    const physx::PxSceneQueryFilterData filterData = batchQueryFilterData(mask, queryTrigger, 0);
+    return runBatchQueries(count, [&](uint32_t i) {
+        // a touch buffer per thread, reused across batches
+        thread_local ccstd::vector<physx::PxOverlapHit> overlaps;
+        overlaps.resize(maxShapesPerQuery);
+
+        const float *sphere  = sphereData + i * BATCH_OVERLAP_STRIDE;
+        const auto   touches = physx::PxSceneQueryExt::overlapMultiple(
+            getScene(), physx::PxSphereGeometry{sphere[3]}, physx::PxTransform{physx::PxVec3{sphere[0], sphere[1], sphere[2]}},
+            overlaps.data(), maxShapesPerQuery, filterData, &getQueryFilterShader());
+
+        // -1 means the buffer overflowed, it is full then
+        const uint32_t touchCount = touches < 0 ? maxShapesPerQuery : static_cast<uint32_t>(touches);
+        double *       outShapes  = shapeData + i * maxShapesPerQuery;
+        uint32_t       written    = 0;
+        for (uint32_t j = 0; j < touchCount; ++j) {
+            const uintptr_t shape = findShapeHandle(overlaps[j].shape);
+            if (shape) {
+                outShapes[written++] = static_cast<double>(shape);
+            }
+        }
+        countData[i] = written;
+        return written > 0;
+    });
+}
+
 ccstd::vector<RaycastResult> &PhysXWorld::raycastResult() {
     static ccstd::vector<RaycastResult> hits;
     return hits;
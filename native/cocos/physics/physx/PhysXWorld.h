@@ -26,12 +26,15 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include "base/Macros.h"
 #include "base/std/container/vector.h"
 #include "core/scene-graph/Node.h"
+#include "physics/physx/PhysXCookingCache.h"
 #include "physics/physx/PhysXEventManager.h"
 #include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXInc.h"
+#include "physics/physx/PhysXJobDispatcher.h"
 #include "physics/physx/PhysXRigidBody.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/spec/IWorld.h"
@@ -39,6 +42,21 @@
 namespace cc {
 namespace physics {
 
+/**
+ * Broadphase and scene query structures of the PhysX scene, the defaults are those of PxSceneDesc.
+ */
+struct PhysXSceneConfig {
+    physx::PxBroadPhaseType::Enum broadPhaseType{physx::PxBroadPhaseType::eABP};
+    // eMBP only, the world bounds are split regionSubdivisions times along both horizontal axes
+    physx::PxBounds3 worldBounds{physx::PxVec3{-1000.F}, physx::PxVec3{1000.F}};
+    uint32_t         regionSubdivisions{4};
+
+    physx::PxPruningStructureType::Enum staticStructure{physx::PxPruningStructureType::eDYNAMIC_AABB_TREE};
+    physx::PxPruningStructureType::Enum dynamicStructure{physx::PxPruningStructureType::eDYNAMIC_AABB_TREE};
+    // frames over which a dynamic AABB tree is rebuilt in the background, fewer frames cost more per frame
+    uint32_t dynamicTreeRebuildRateHint{100};
+};
+
 class PhysXWorld final : virtual public IPhysicsWorld {
 public:
     static PhysXWorld &         getInstance();
@@ -48,6 +66,13 @@ public:
     PhysXWorld();
     ~PhysXWorld() override;
     void                                                     step(float fixedTimeStep) override;
+    /**
+     * Steps as many fixed steps as deltaTime and the time left over from the last calls add up to, at most maxSubSteps,
+     * and drops the rest of the time when clamped. With interpolation enabled the dynamic bodies are then placed between
+     * the poses of the last two steps, so rendering stays smooth when physics runs at a lower rate.
+     */
+    uint32_t                                                 stepWithSubsteps(float deltaTime, float fixedTimeStep, uint32_t maxSubSteps) override;
+    void                                                     setInterpolationEnabled(bool v) override;
     void                                                     setGravity(float x, float y, float z) override;
     void                                                     setAllowSleep(bool v) override;
     void                                                     emitEvents() override;
@@ -56,6 +81,12 @@ public:
     bool                                                     raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &                           raycastResult() override;
     RaycastResult &                                          raycastClosestResult() override;
+    uint32_t                                                 raycastClosestBatch(const Float32Array &rays, uint32_t mask, bool queryTrigger,
+                                                                                 Float32Array &hits, Float64Array &shapes) override;
+    uint32_t                                                 sweepSphereClosestBatch(const Float32Array &sweeps, uint32_t mask, bool queryTrigger,
+                                                                                     Float32Array &hits, Float64Array &shapes) override;
+    uint32_t                                                 overlapSphereBatch(const Float32Array &spheres, uint32_t mask, bool queryTrigger,
+                                                                                uint32_t maxShapesPerQuery, Float64Array &shapes, Uint32Array &counts) override;
     uintptr_t                                                createConvex(ConvexDesc &desc) override;
     uintptr_t                                                createTrimesh(TrimeshDesc &desc) override;
     uintptr_t                                                createHeightField(HeightFieldDesc &desc) override;
@@ -67,6 +98,18 @@ public:
     inline ccstd::vector<std::shared_ptr<ContactEventPair>> &getContactEventPairs() override {
         return _mEventMgr->getConatctPairs();
     }
+    inline void setContactEventStreamEnabled(bool v) override {
+        _mEventMgr->setContactStreamEnabled(v);
+    }
+    inline uint32_t getContactEventStreamCount() override {
+        return _mEventMgr->getContactStreamCount();
+    }
+    inline const Float64Array &getContactEventStreamHeaders() override {
+        return _mEventMgr->getContactStreamHeaders();
+    }
+    inline const Float32Array &getContactEventStreamPoints() override {
+        return _mEventMgr->getContactStreamPoints();
+    }
     void syncSceneToPhysics() override;
     void syncSceneWithCheck() override;
     void destroy() override;
@@ -83,19 +126,48 @@ public:
     void                   addActor(const PhysXSharedBody &sb);
     void                   removeActor(const PhysXSharedBody &sb);
 
+    // recreates the scene, only possible before any body is added
+    bool                           setSceneConfig(const PhysXSceneConfig &config);
+    inline const PhysXSceneConfig &getSceneConfig() const { return _mSceneConfig; }
+    void                           setDynamicTreeRebuildRateHint(uint32_t frames);
+    // rebuilds the query trees at once, e.g. after streaming in many static colliders
+    void rebuildQueryTrees();
+
+    // number of threads simulating a step, including the thread calling step(), 0 simulates on that thread only
+    inline uint32_t getWorkerCount() const { return _mDispatcher->getWorkerCount(); }
+    inline void     setWorkerCount(uint32_t count) { _mDispatcher->setWorkerCount(count); }
+
+    // cooked convex and triangle meshes are cached on disk, see PhysXCookingCache
+    inline PhysXCookingCache &getCookingCache() const { return *_mCookingCache; }
+
 private:
+    void createScene(const physx::PxVec3 &gravity);
+    void simulateStep(float fixedTimeStep, bool syncScene);
+    void interpolateBodies(float alpha);
+
     static PhysXWorld *  instance;
     physx::PxFoundation *_mFoundation;
     physx::PxCooking *   _mCooking;
+    PhysXCookingCache *  _mCookingCache;
     physx::PxPhysics *   _mPhysics;
 #ifdef CC_DEBUG
     physx::PxPvd *_mPvd;
 #endif
-    physx::PxDefaultCpuDispatcher *  _mDispatcher;
+    PhysXJobDispatcher *             _mDispatcher;
     physx::PxScene *                 _mScene;
     PhysXEventManager *              _mEventMgr;
+    PhysXSceneConfig                 _mSceneConfig;
     uint32_t                         _mCollisionMatrix[31];
     ccstd::vector<PhysXSharedBody *> _mSharedBodies;
+
+    // poses gathered by syncSceneToPhysics(), written to the actors after all bodies are visited
+    ccstd::vector<std::pair<physx::PxRigidDynamic *, physx::PxTransform>> _mKinematicTargets;
+    ccstd::vector<std::pair<physx::PxRigidActor *, physx::PxTransform>>   _mGlobalPoses;
+
+    // dynamic bodies simulated in the last step, their nodes are interpolated
+    ccstd::vector<PhysXSharedBody *> _mInterpolatedBodies;
+    float                            _mAccumulator{0.F};
+    bool                             _mInterpolationEnabled{false};
 };
 
 } // namespace physics
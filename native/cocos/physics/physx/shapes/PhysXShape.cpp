@@ -25,6 +25,7 @@
 
 #include "physics/physx/shapes/PhysXShape.h"
 #include "base/std/container/unordered_map.h"
+#include "physics/physx/PhysXFilterShader.h"
 #include "physics/physx/PhysXSharedBody.h"
 #include "physics/physx/PhysXUtils.h"
 #include "physics/physx/PhysXWorld.h"
@@ -100,6 +101,8 @@ void PhysXShape::setMask(uint32_t m) {
 }
 
 void PhysXShape::updateEventListener(EShapeFilterFlag flag) {
+    _mFlag = static_cast<uint8_t>(flag);
+    if (_mShape) updateFilterData(getSharedBody().getFilterData());
 }
 
 geometry::AABB &PhysXShape::getAABB() {
@@ -119,6 +122,13 @@ geometry::Sphere &PhysXShape::getBoundingSphere() {
 }
 
 void PhysXShape::updateFilterData(const physx::PxFilterData &data) {
+    if (!_mShape) return;
+    // word3 carries the events this shape listens to, the filter shader skips the details nobody asked for
+    physx::PxFilterData simulationData = data;
+    simulationData.word3               = 0;
+    if (_mFlag & static_cast<uint8_t>(EShapeFilterFlag::NEED_EVENT)) simulationData.word3 |= DETECT_TRIGGER_EVENT | DETECT_CONTACT_EVENT;
+    if (_mFlag & static_cast<uint8_t>(EShapeFilterFlag::NEED_CONTACT_DATA)) simulationData.word3 |= DETECT_CONTACT_POINT;
+    getShape().setSimulationFilterData(simulationData);
 }
 
 void PhysXShape::updateCenter() {
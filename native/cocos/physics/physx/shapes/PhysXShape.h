@@ -77,7 +77,8 @@ protected:
     physx::PxShape * _mShape{nullptr};
     physx::PxVec3    _mCenter;
     physx::PxQuat    _mRotation;
-    uint8_t          _mFlag{0};
+    // events are reported until the component narrows them down through updateEventListener
+    uint8_t          _mFlag{static_cast<uint8_t>(EShapeFilterFlag::NEED_EVENT) | static_cast<uint8_t>(EShapeFilterFlag::NEED_CONTACT_DATA)};
     bool             _mEnabled{false};
     virtual void     updateCenter();
     virtual void     onComponentSet() = 0;
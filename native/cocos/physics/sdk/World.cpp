@@ -46,6 +46,14 @@ void World::step(float fixedTimeStep) {
     _impl->step(fixedTimeStep);
 }
 
+uint32_t World::stepWithSubsteps(float deltaTime, float fixedTimeStep, uint32_t maxSubSteps) {
+    return _impl->stepWithSubsteps(deltaTime, fixedTimeStep, maxSubSteps);
+}
+
+void World::setInterpolationEnabled(bool v) {
+    _impl->setInterpolationEnabled(v);
+}
+
 void World::setAllowSleep(bool v) {
     _impl->setAllowSleep(v);
 }
@@ -79,6 +87,22 @@ ccstd::vector<std::shared_ptr<ContactEventPair>> &World::getContactEventPairs()
     return _impl->getContactEventPairs();
 }
 
+void World::setContactEventStreamEnabled(bool v) {
+    _impl->setContactEventStreamEnabled(v);
+}
+
+uint32_t World::getContactEventStreamCount() {
+    return _impl->getContactEventStreamCount();
+}
+
+const Float64Array &World::getContactEventStreamHeaders() {
+    return _impl->getContactEventStreamHeaders();
+}
+
+const Float32Array &World::getContactEventStreamPoints() {
+    return _impl->getContactEventStreamPoints();
+}
+
 void World::setCollisionMatrix(uint32_t i, uint32_t m) {
     _impl->setCollisionMatrix(i, m);
 }
@@ -111,5 +135,18 @@ RaycastResult &World::raycastClosestResult() {
     return _impl->raycastClosestResult();
 }
 
+uint32_t World::raycastClosestBatch(const Float32Array &rays, uint32_t mask, bool queryTrigger, Float32Array &hits, Float64Array &shapes) {
+    return _impl->raycastClosestBatch(rays, mask, queryTrigger, hits, shapes);
+}
+
+uint32_t World::sweepSphereClosestBatch(const Float32Array &sweeps, uint32_t mask, bool queryTrigger, Float32Array &hits, Float64Array &shapes) {
+    return _impl->sweepSphereClosestBatch(sweeps, mask, queryTrigger, hits, shapes);
+}
+
+uint32_t World::overlapSphereBatch(const Float32Array &spheres, uint32_t mask, bool queryTrigger,
+                                   uint32_t maxShapesPerQuery, Float64Array &shapes, Uint32Array &counts) {
+    return _impl->overlapSphereBatch(spheres, mask, queryTrigger, maxShapesPerQuery, shapes, counts);
+}
+
 } // namespace physics
 } // namespace cc
@@ -38,16 +38,28 @@ public:
     void                                              setGravity(float x, float y, float z) override;
     void                                              setAllowSleep(bool v) override;
     void                                              step(float fixedTimeStep) override;
+    uint32_t                                          stepWithSubsteps(float deltaTime, float fixedTimeStep, uint32_t maxSubSteps) override;
+    void                                              setInterpolationEnabled(bool v) override;
     void                                              emitEvents() override;
     void                                              syncSceneToPhysics() override;
     void                                              syncSceneWithCheck() override;
     void                                              setCollisionMatrix(uint32_t i, uint32_t m) override;
     ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerEventPairs() override;
     ccstd::vector<std::shared_ptr<ContactEventPair>> &getContactEventPairs() override;
+    void                                              setContactEventStreamEnabled(bool v) override;
+    uint32_t                                          getContactEventStreamCount() override;
+    const Float64Array &                              getContactEventStreamHeaders() override;
+    const Float32Array &                              getContactEventStreamPoints() override;
     bool                                              raycast(RaycastOptions &opt) override;
     bool                                              raycastClosest(RaycastOptions &opt) override;
     ccstd::vector<RaycastResult> &                    raycastResult() override;
     RaycastResult &                                   raycastClosestResult() override;
+    uint32_t                                          raycastClosestBatch(const Float32Array &rays, uint32_t mask, bool queryTrigger,
+                                                                          Float32Array &hits, Float64Array &shapes) override;
+    uint32_t                                          sweepSphereClosestBatch(const Float32Array &sweeps, uint32_t mask, bool queryTrigger,
+                                                                              Float32Array &hits, Float64Array &shapes) override;
+    uint32_t                                          overlapSphereBatch(const Float32Array &spheres, uint32_t mask, bool queryTrigger,
+                                                                         uint32_t maxShapesPerQuery, Float64Array &shapes, Uint32Array &counts) override;
     uintptr_t                                         createConvex(ConvexDesc &desc) override;
     uintptr_t                                         createTrimesh(TrimeshDesc &desc) override;
     uintptr_t                                         createHeightField(HeightFieldDesc &desc) override;
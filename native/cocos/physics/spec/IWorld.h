@@ -29,6 +29,7 @@
 #include <memory>
 #include "base/TypeDef.h"
 #include "base/std/container/vector.h"
+#include "core/TypedArray.h"
 #include "math/Vec3.h"
 
 namespace cc {
@@ -106,6 +107,18 @@ struct RaycastResult {
     RaycastResult() = default;
 };
 
+// floats per element of the packed buffers of the batched queries
+constexpr uint32_t BATCH_RAYCAST_STRIDE = 7; // origin xyz, unit direction xyz, distance
+constexpr uint32_t BATCH_SWEEP_STRIDE   = 8; // origin xyz, unit direction xyz, distance, sphere radius
+constexpr uint32_t BATCH_OVERLAP_STRIDE = 4; // sphere center xyz, radius
+constexpr uint32_t BATCH_HIT_STRIDE     = 7; // hit point xyz, hit normal xyz, distance, -1 if nothing is hit
+
+// doubles per pair of the contact event stream: shape A, shape B, touch state, first point, point count
+constexpr uint32_t CONTACT_STREAM_HEADER_STRIDE = 5;
+// floats per point of the contact event stream: position xyz, separation, normal xyz, face index 0,
+// impulse xyz, face index 1, the face indices are uint32 bits to be read through a Uint32Array view
+constexpr uint32_t CONTACT_STREAM_POINT_STRIDE = ContactPoint::COUNT;
+
 class IPhysicsWorld {
 public:
     virtual ~IPhysicsWorld() = default;
@@ -113,6 +126,9 @@ public:
     virtual void                                              setGravity(float x, float y, float z)      = 0;
     virtual void                                              setAllowSleep(bool v)                      = 0;
     virtual void                                              step(float s)                              = 0;
+    virtual uint32_t                                          stepWithSubsteps(float deltaTime, float fixedTimeStep,
+                                                                               uint32_t maxSubSteps)     = 0;
+    virtual void                                              setInterpolationEnabled(bool v)            = 0;
     virtual void                                              emitEvents()                               = 0;
     virtual void                                              syncSceneToPhysics()                       = 0;
     virtual void                                              syncSceneWithCheck()                       = 0;
@@ -120,10 +136,33 @@ public:
     virtual void                                              setCollisionMatrix(uint32_t i, uint32_t m) = 0;
     virtual ccstd::vector<std::shared_ptr<TriggerEventPair>> &getTriggerEventPairs()                     = 0;
     virtual ccstd::vector<std::shared_ptr<ContactEventPair>> &getContactEventPairs()                     = 0;
+
+    /**
+     * The contact event stream replaces getContactEventPairs() when enabled. Its buffers are reused across steps
+     * and only reallocated when they grow, they are valid until emitEvents() and may be replaced by the next step.
+     */
+    virtual void                setContactEventStreamEnabled(bool v) = 0;
+    virtual uint32_t            getContactEventStreamCount()         = 0;
+    virtual const Float64Array &getContactEventStreamHeaders()       = 0;
+    virtual const Float32Array &getContactEventStreamPoints()        = 0;
+
     virtual bool                                              raycast(RaycastOptions &opt)               = 0;
     virtual bool                                              raycastClosest(RaycastOptions &opt)        = 0;
     virtual ccstd::vector<RaycastResult> &                    raycastResult()                            = 0;
     virtual RaycastResult &                                   raycastClosestResult()                     = 0;
+
+    /**
+     * The batched queries run on the job system and return the number of queries which hit anything.
+     * Shapes are written as the shape handles known from raycastResult(), 0 for a miss.
+     */
+    virtual uint32_t raycastClosestBatch(const Float32Array &rays, uint32_t mask, bool queryTrigger,
+                                         Float32Array &hits, Float64Array &shapes) = 0;
+    virtual uint32_t sweepSphereClosestBatch(const Float32Array &sweeps, uint32_t mask, bool queryTrigger,
+                                             Float32Array &hits, Float64Array &shapes) = 0;
+    // query i writes counts[i] shapes from shapes[i * maxShapesPerQuery]
+    virtual uint32_t overlapSphereBatch(const Float32Array &spheres, uint32_t mask, bool queryTrigger,
+                                        uint32_t maxShapesPerQuery, Float64Array &shapes, Uint32Array &counts) = 0;
+
     virtual uintptr_t                                         createConvex(ConvexDesc &desc)             = 0;
     virtual uintptr_t                                         createTrimesh(TrimeshDesc &desc)           = 0;
     virtual uintptr_t                                         createHeightField(HeightFieldDesc &desc)   = 0;
@@ -0,0 +1,239 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "platform/AsyncFileReader.h"
+#include <algorithm>
+#include "base/Log.h"
+#include "base/memory/Memory.h"
+#include "base/threading/ThreadAffinity.h"
+
+namespace cc {
+
+struct AsyncFileReader::Request {
+    RequestId             id{INVALID_REQUEST};
+    ccstd::vector<Result> results;
+    BatchCallback         callback;
+    std::atomic<uint32_t> remaining{0};
+    std::atomic<bool>     cancelled{false};
+};
+
+namespace {
+AsyncFileReader *instance = nullptr;
+} // namespace
+
+AsyncFileReader *AsyncFileReader::getInstance() {
+    if (!instance) {
+        instance = new (std::nothrow) AsyncFileReader();
+    }
+    return instance;
+}
+
+void AsyncFileReader::destroyInstance() {
+    CC_SAFE_DELETE(instance);
+}
+
+AsyncFileReader::AsyncFileReader(uint32_t threadCount) {
+    threadCount = std::max(threadCount, 1U);
+    _workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&AsyncFileReader::workerLoop, this);
+    }
+}
+
+AsyncFileReader::~AsyncFileReader() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+        for (auto &queue : _queues) {
+            queue.clear();
+        }
+        // requests in flight finish their current file but are never dispatched
+        for (auto &it : _requests) {
+            it.second->cancelled = true;
+        }
+        _requests.clear();
+    }
+    _condition.notify_all();
+
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+void AsyncFileReader::setDispatcher(Dispatcher dispatcher) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _dispatcher = std::move(dispatcher);
+}
+
+AsyncFileReader::RequestId AsyncFileReader::read(const ccstd::string &filename, Callback callback, Priority priority) {
+    auto request      = std::make_shared<Request>();
+    request->callback = [callback = std::move(callback)](ccstd::vector<Result> &results) {
+        if (callback) {
+            callback(results[0]);
+        }
+    };
+    return submit({filename}, std::move(request), priority);
+}
+
+AsyncFileReader::RequestId AsyncFileReader::readBatch(const ccstd::vector<ccstd::string> &filenames, BatchCallback callback, Priority priority) {
+    auto request      = std::make_shared<Request>();
+    request->callback = std::move(callback);
+    return submit(filenames, std::move(request), priority);
+}
+
+AsyncFileReader::RequestId AsyncFileReader::submit(const ccstd::vector<ccstd::string> &filenames, std::shared_ptr<Request> &&request, Priority priority) {
+    auto *fileUtils = FileUtils::getInstance();
+    if (!fileUtils) {
+        CC_LOG_ERROR("AsyncFileReader: FileUtils is not initialized");
+        return INVALID_REQUEST;
+    }
+
+    // fullPathForFilename isn't thread safe, resolve on the calling thread and hand absolute paths to the workers
+    const auto count = static_cast<uint32_t>(filenames.size());
+    request->results.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        request->results[i].filename = fileUtils->fullPathForFilename(filenames[i]);
+        if (request->results[i].filename.empty()) {
+            request->results[i].filename = filenames[i];
+            request->results[i].status   = FileUtils::Status::NOT_EXISTS;
+        }
+    }
+    request->remaining = count;
+
+    RequestId id = INVALID_REQUEST;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopped) {
+            return INVALID_REQUEST;
+        }
+        if (++_nextId == INVALID_REQUEST) {
+            ++_nextId;
+        }
+        id          = _nextId;
+        request->id = id;
+        _requests.emplace(id, request);
+
+        auto &queue = _queues[static_cast<uint32_t>(priority)];
+        for (uint32_t i = 0; i < count; ++i) {
+            queue.push_back({request, i});
+        }
+    }
+
+    if (count == 0) {
+        complete(request);
+    } else if (count == 1) {
+        _condition.notify_one();
+    } else {
+        _condition.notify_all();
+    }
+    return id;
+}
+
+bool AsyncFileReader::cancel(RequestId id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _requests.find(id);
+    if (iter == _requests.end()) {
+        return false;
+    }
+    // queued jobs of a cancelled request are dropped when a worker pops them
+    iter->second->cancelled = true;
+    _requests.erase(iter);
+    return true;
+}
+
+void AsyncFileReader::cancelAll() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &queue : _queues) {
+        queue.clear();
+    }
+    for (auto &it : _requests) {
+        it.second->cancelled = true;
+    }
+    _requests.clear();
+}
+
+uint32_t AsyncFileReader::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(_requests.size());
+}
+
+bool AsyncFileReader::popJob(Job *job) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        if (_stopped) {
+            return false;
+        }
+        for (auto i = static_cast<int32_t>(Priority::COUNT) - 1; i >= 0; --i) {
+            auto &queue = _queues[i];
+            while (!queue.empty()) {
+                *job = std::move(queue.front());
+                queue.pop_front();
+                if (!job->request->cancelled) {
+                    return true;
+                }
+            }
+        }
+        _condition.wait(lock);
+    }
+}
+
+void AsyncFileReader::workerLoop() {
+    ThreadAffinity::setCurrentThread("FileReader", ThreadQoS::BACKGROUND);
+    Job job;
+    while (popJob(&job)) {
+        auto &result = job.request->results[job.index];
+        if (result.status == FileUtils::Status::OK) {
+            result.status = FileUtils::getInstance()->getContents(result.filename, &result.data);
+        }
+        if (--job.request->remaining == 0) {
+            complete(job.request);
+        }
+        job.request.reset();
+    }
+}
+
+void AsyncFileReader::complete(const std::shared_ptr<Request> &request) {
+    Dispatcher dispatcher;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (request->cancelled || _requests.erase(request->id) == 0) {
+            return;
+        }
+        dispatcher = _dispatcher;
+    }
+
+    auto task = [request]() {
+        if (request->callback) {
+            request->callback(request->results);
+        }
+    };
+    if (dispatcher) {
+        dispatcher(std::move(task));
+    } else {
+        task();
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,143 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+/**
+ * @en Reads files on a small, bounded pool of I/O threads so the caller never blocks on storage.
+ * Requests are served by priority, then in submission order. Completion callbacks are handed to
+ * the dispatcher, the engine routes them to the cocos thread.
+ * @zh 在固定数量的 I/O 线程上读取文件，调用线程不会因为存储读取而阻塞。
+ * 请求按优先级、再按提交顺序处理。完成回调交给派发器执行，引擎会将其派发到 cocos 线程。
+ */
+class CC_DLL AsyncFileReader final {
+public:
+    using RequestId = uint32_t;
+    static constexpr RequestId INVALID_REQUEST{0};
+
+    enum class Priority : uint8_t {
+        LOW,
+        NORMAL,
+        HIGH,
+        COUNT,
+    };
+
+    struct Result {
+        ccstd::string     filename;
+        FileUtils::Status status{FileUtils::Status::OK};
+        Data              data;
+    };
+
+    using Callback      = std::function<void(Result &result)>;
+    using BatchCallback = std::function<void(ccstd::vector<Result> &results)>;
+    using Dispatcher    = std::function<void(std::function<void()> &&task)>;
+
+    static constexpr uint32_t DEFAULT_THREAD_COUNT{2};
+
+    static AsyncFileReader *getInstance();
+    static void destroyInstance();
+
+    explicit AsyncFileReader(uint32_t threadCount = DEFAULT_THREAD_COUNT);
+    ~AsyncFileReader();
+    AsyncFileReader(const AsyncFileReader &) = delete;
+    AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+
+    /**
+     * @en Sets how completion callbacks are run. Without a dispatcher they run on the I/O thread.
+     * @zh 设置完成回调的执行方式。未设置时回调在 I/O 线程上执行。
+     */
+    void setDispatcher(Dispatcher dispatcher);
+
+    /**
+     * @en Reads a whole file asynchronously. The path is resolved on the calling thread,
+     * so this should be called from the thread that owns FileUtils search paths.
+     * @zh 异步读取整个文件。路径在调用线程上解析，因此应在维护 FileUtils 搜索路径的线程上调用。
+     * @return @en Id that can be passed to cancel. @zh 可用于 cancel 的请求 id。
+     */
+    RequestId read(const ccstd::string &filename, Callback callback, Priority priority = Priority::NORMAL);
+
+    /**
+     * @en Reads several files in parallel, the callback runs once after all of them finished,
+     * with results in the order of filenames. A failed file doesn't fail the others.
+     * @zh 并行读取多个文件，全部完成后回调一次，结果顺序与 filenames 一致。单个文件失败不影响其他文件。
+     */
+    RequestId readBatch(const ccstd::vector<ccstd::string> &filenames, BatchCallback callback, Priority priority = Priority::NORMAL);
+
+    /**
+     * @en Cancels a request. Files not read yet are skipped and the callback is never invoked.
+     * @zh 取消请求。尚未读取的文件会被跳过，回调不会被调用。
+     * @return @en False if the request already completed or doesn't exist. @zh 请求已完成或不存在时返回 false。
+     */
+    bool cancel(RequestId id);
+
+    /**
+     * @en Cancels everything pending, used when the engine restarts or closes.
+     * @zh 取消所有未完成的请求，在引擎重启或关闭时使用。
+     */
+    void cancelAll();
+
+    uint32_t getPendingCount() const;
+    inline uint32_t getThreadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+    struct Request;
+
+    struct Job {
+        std::shared_ptr<Request> request;
+        uint32_t                 index{0};
+    };
+
+    RequestId submit(const ccstd::vector<ccstd::string> &filenames, std::shared_ptr<Request> &&request, Priority priority);
+    bool popJob(Job *job);
+    void workerLoop();
+    void complete(const std::shared_ptr<Request> &request);
+
+    ccstd::vector<std::thread>                                _workers;
+    ccstd::deque<Job>                                         _queues[static_cast<uint32_t>(Priority::COUNT)];
+    ccstd::unordered_map<RequestId, std::shared_ptr<Request>> _requests;
+    Dispatcher                                                _dispatcher;
+    mutable std::mutex                                        _mutex;
+    std::condition_variable                                   _condition;
+    RequestId                                                 _nextId{INVALID_REQUEST};
+    bool                                                      _stopped{false};
+};
+
+} // namespace cc
@@ -32,16 +32,17 @@
 #include <cstring>
 #include <iostream>
 
-#ifdef MINIZIP_FROM_SYSTEM
-    #include <minizip/unzip.h>
-#else // from our embedded sources
-    #include "unzip/unzip.h"
-#endif
 #include <sys/stat.h>
 #include <regex>
+#if CC_PLATFORM != CC_PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 #include "base/Data.h"
 #include "base/Log.h"
+#include "base/ZipUtils.h"
 #include "base/memory/Memory.h"
 #include "platform/SAXParser.h"
 
@@ -478,6 +479,7 @@ bool        FileUtils::writeToFile(const ValueMap &dict, const ccstd::string &fu
 FileUtils *FileUtils::sharedFileUtils = nullptr;
 
 void FileUtils::destroyInstance() {
+    ZipArchive::purgeArchives();
     CC_SAFE_DELETE(FileUtils::sharedFileUtils);
 }
 
@@ -546,6 +548,77 @@ Data FileUtils::getDataFromFile(const ccstd::string &filename) {
     return d;
 }
 
+MappedFile::MappedFile(const unsigned char *bytes, size_t size, void *handle, Unmapper unmapper)
+: _bytes(bytes), _size(size), _handle(handle), _unmapper(unmapper) {}
+
+MappedFile::MappedFile(Data &&data) : _data(std::move(data)) {
+    _bytes = _data.getBytes();
+    _size  = static_cast<size_t>(_data.getSize());
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        reset();
+        // the bytes of a moved Data stay at the same address
+        _bytes    = other._bytes;
+        _size     = other._size;
+        _handle   = other._handle;
+        _unmapper = other._unmapper;
+        _data     = std::move(other._data);
+
+        other._bytes    = nullptr;
+        other._size     = 0;
+        other._handle   = nullptr;
+        other._unmapper = nullptr;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    reset();
+}
+
+void MappedFile::reset() {
+    if (_unmapper) {
+        _unmapper(_handle, _bytes, _size);
+    }
+    _bytes    = nullptr;
+    _size     = 0;
+    _handle   = nullptr;
+    _unmapper = nullptr;
+    _data.clear();
+}
+
+MappedFile FileUtils::mapFile(const ccstd::string &filename) {
+#if CC_PLATFORM != CC_PLATFORM_WINDOWS
+    const ccstd::string fullPath = fullPathForFilename(filename);
+    if (!fullPath.empty()) {
+        int fd = open(getSuitableFOpen(fullPath).c_str(), O_RDONLY);
+        if (fd != -1) {
+            struct stat statBuf;
+            void *      bytes = MAP_FAILED;
+            size_t      size  = 0;
+            if (fstat(fd, &statBuf) == 0 && statBuf.st_size > 0) {
+                size  = static_cast<size_t>(statBuf.st_size);
+                bytes = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            // the mapping stays valid after the descriptor is closed
+            close(fd);
+            if (bytes != MAP_FAILED) {
+                return MappedFile(static_cast<const unsigned char *>(bytes), size, nullptr, [](void * /*handle*/, const unsigned char *bytes, size_t size) {
+                    munmap(const_cast<unsigned char *>(bytes), size);
+                });
+            }
+        }
+    }
+#endif
+    return MappedFile(getDataFromFile(filename));
+}
+
 FileUtils::Status FileUtils::getContents(const ccstd::string &filename, ResizableBuffer *buffer) {
     if (filename.empty()) {
         return Status::NOT_EXISTS;
@@ -588,41 +661,19 @@ FileUtils::Status FileUtils::getContents(const ccstd::string &filename, Resizabl
 }
 
 unsigned char *FileUtils::getFileDataFromZip(const ccstd::string &zipFilePath, const ccstd::string &filename, ssize_t *size) {
-    unsigned char *buffer = nullptr;
-    unzFile        file   = nullptr;
-    *size                 = 0;
-
-    do {
-        CC_BREAK_IF(zipFilePath.empty());
-
-        file = unzOpen(FileUtils::getInstance()->getSuitableFOpen(zipFilePath).c_str());
-        CC_BREAK_IF(!file);
-
-        // minizip 1.2.0 is same with other platforms
-        int ret = unzLocateFile(file, filename.c_str(), nullptr);
-        CC_BREAK_IF(UNZ_OK != ret);
-
-        char          filePathA[260];
-        unz_file_info fileInfo;
-        ret = unzGetCurrentFileInfo(file, &fileInfo, filePathA, sizeof(filePathA), nullptr, 0, nullptr, 0);
-        CC_BREAK_IF(UNZ_OK != ret);
-
-        ret = unzOpenCurrentFile(file);
-        CC_BREAK_IF(UNZ_OK != ret);
-
-        buffer                   = static_cast<unsigned char *>(malloc(fileInfo.uncompressed_size));
-        int CC_UNUSED readedSize = unzReadCurrentFile(file, buffer, static_cast<unsigned>(fileInfo.uncompressed_size));
-        CCASSERT(readedSize == 0 || readedSize == (int)fileInfo.uncompressed_size, "the file size is wrong");
-
-        *size = fileInfo.uncompressed_size;
-        unzCloseCurrentFile(file);
-    } while (false);
-
-    if (file) {
-        unzClose(file);
+    *size = 0;
+    // archives are indexed once and stay mapped, repeated reads skip reopening and scanning the archive
+    auto archive = ZipArchive::getArchive(zipFilePath);
+    if (!archive) {
+        return nullptr;
     }
 
-    return buffer;
+    Data                         data;
+    ResizableBufferAdapter<Data> buffer(&data);
+    if (!archive->getFileData(filename, &buffer)) {
+        return nullptr;
+    }
+    return data.takeBuffer(size);
 }
 
 ccstd::string FileUtils::getPathForFilename(const ccstd::string &filename, const ccstd::string &searchPath) const {
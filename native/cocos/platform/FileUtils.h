@@ -105,6 +105,40 @@ public:
     }
 };
 
+/**
+ * Read only view of a file mapped into memory, the mapping is released with the object.
+ * When the file can't be mapped its content is read into an owned buffer instead,
+ * so getBytes is valid for getSize bytes either way.
+ */
+class CC_DLL MappedFile final {
+public:
+    using Unmapper = void (*)(void *handle, const unsigned char *bytes, size_t size);
+
+    MappedFile() = default;
+    MappedFile(const unsigned char *bytes, size_t size, void *handle, Unmapper unmapper);
+    explicit MappedFile(Data &&data);
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    inline const unsigned char *getBytes() const { return _bytes; }
+    inline size_t               getSize() const { return _size; }
+    inline bool                 isNull() const { return _bytes == nullptr; }
+    // false when the content was copied to the heap
+    inline bool isMapped() const { return _unmapper != nullptr; }
+
+    void reset();
+
+private:
+    const unsigned char *_bytes{nullptr};
+    size_t               _size{0};
+    void *               _handle{nullptr};
+    Unmapper             _unmapper{nullptr};
+    Data                 _data;
+};
+
 /** Helper class to handle file operations. */
 class CC_DLL FileUtils {
 public:
@@ -231,6 +265,14 @@ public:
     }
     virtual Status getContents(const ccstd::string &filename, ResizableBuffer *buffer);
 
+    /**
+     *  Maps a file into memory read only instead of copying it to the heap, falls back to getDataFromFile
+     *  when the file can't be mapped, e.g. compressed package entries.
+     *  Delegates that transform file contents must override this as well.
+     *  @return A view that keeps the mapping alive, null if the file can't be read.
+     */
+    virtual MappedFile mapFile(const ccstd::string &filename);
+
     /**
      *  Gets resource file data from a zip file.
      *
@@ -55,11 +55,17 @@ extern "C" {
 }
 
 #include "base/astc.h"
+#include "base/job-system/JobSystem.h"
+#include "gfx-base/GFXDevice.h"
 
 #if CC_USE_WEBP
     #include "webp/decode.h"
 #endif // CC_USE_WEBP
 
+#if CC_USE_BASISU
+    #include "basisu/transcoder/basisu_transcoder.h"
+#endif // CC_USE_BASISU
+
 #include "base/ZipUtils.h"
 #include "platform/FileUtils.h"
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
@@ -240,6 +246,184 @@ using PVRv3TexHeader = struct {
 } // namespace
 //pvr structure end
 
+//////////////////////////////////////////////////////////////////////////
+//struct and data for ktx2 structure
+
+namespace {
+const unsigned char KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+enum class KTX2Supercompression : uint32_t {
+    NONE    = 0,
+    BASISLZ = 1,
+    ZSTD    = 2,
+    ZLIB    = 3,
+};
+
+struct KTX2Header {
+    unsigned char identifier[12];
+    uint32_t      vkFormat;
+    uint32_t      typeSize;
+    uint32_t      pixelWidth;
+    uint32_t      pixelHeight;
+    uint32_t      pixelDepth;
+    uint32_t      layerCount;
+    uint32_t      faceCount;
+    uint32_t      levelCount;
+    uint32_t      supercompressionScheme;
+    uint32_t      dfdByteOffset;
+    uint32_t      dfdByteLength;
+    uint32_t      kvdByteOffset;
+    uint32_t      kvdByteLength;
+    uint64_t      sgdByteOffset;
+    uint64_t      sgdByteLength;
+};
+
+struct KTX2LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+// Basis Universal payloads leave the format undefined
+const uint32_t KTX2_VK_FORMAT_UNDEFINED = 0;
+
+// VkFormat values of the payloads which can be uploaded as they are
+const ccstd::unordered_map<uint32_t, gfx::Format> KTX2_VK_FORMATHASH = {
+    // uncompressed images are RGBA8 in sRGB too, like the other containers
+    {37, gfx::Format::RGBA8},
+    {43, gfx::Format::RGBA8},
+
+    {131, gfx::Format::BC1},
+    {132, gfx::Format::BC1_SRGB},
+    {133, gfx::Format::BC1_ALPHA},
+    {134, gfx::Format::BC1_SRGB_ALPHA},
+    {137, gfx::Format::BC3},
+    {138, gfx::Format::BC3_SRGB},
+    {145, gfx::Format::BC7},
+    {146, gfx::Format::BC7_SRGB},
+
+    {147, gfx::Format::ETC2_RGB8},
+    {148, gfx::Format::ETC2_SRGB8},
+    {149, gfx::Format::ETC2_RGB8_A1},
+    {150, gfx::Format::ETC2_SRGB8_A1},
+    {151, gfx::Format::ETC2_RGBA8},
+    {152, gfx::Format::ETC2_SRGB8_A8},
+
+    {157, gfx::Format::ASTC_RGBA_4X4},
+    {158, gfx::Format::ASTC_SRGBA_4X4},
+    {159, gfx::Format::ASTC_RGBA_5X4},
+    {160, gfx::Format::ASTC_SRGBA_5X4},
+    {161, gfx::Format::ASTC_RGBA_5X5},
+    {162, gfx::Format::ASTC_SRGBA_5X5},
+    {163, gfx::Format::ASTC_RGBA_6X5},
+    {164, gfx::Format::ASTC_SRGBA_6X5},
+    {165, gfx::Format::ASTC_RGBA_6X6},
+    {166, gfx::Format::ASTC_SRGBA_6X6},
+    {167, gfx::Format::ASTC_RGBA_8X5},
+    {168, gfx::Format::ASTC_SRGBA_8X5},
+    {169, gfx::Format::ASTC_RGBA_8X6},
+    {170, gfx::Format::ASTC_SRGBA_8X6},
+    {171, gfx::Format::ASTC_RGBA_8X8},
+    {172, gfx::Format::ASTC_SRGBA_8X8},
+    {173, gfx::Format::ASTC_RGBA_10X5},
+    {174, gfx::Format::ASTC_SRGBA_10X5},
+    {175, gfx::Format::ASTC_RGBA_10X6},
+    {176, gfx::Format::ASTC_SRGBA_10X6},
+    {177, gfx::Format::ASTC_RGBA_10X8},
+    {178, gfx::Format::ASTC_SRGBA_10X8},
+    {179, gfx::Format::ASTC_RGBA_10X10},
+    {180, gfx::Format::ASTC_SRGBA_10X10},
+    {181, gfx::Format::ASTC_RGBA_12X10},
+    {182, gfx::Format::ASTC_SRGBA_12X10},
+    {183, gfx::Format::ASTC_RGBA_12X12},
+    {184, gfx::Format::ASTC_SRGBA_12X12},
+
+    {1000054000, gfx::Format::PVRTC_RGBA2},
+    {1000054001, gfx::Format::PVRTC_RGBA4},
+};
+
+bool isSampleable(const gfx::Device *device, gfx::Format format) {
+    return device && hasFlag(device->getFormatFeatures(format), gfx::FormatFeatureBit::SAMPLED_TEXTURE);
+}
+
+#if CC_USE_BASISU
+struct BasisTarget {
+    basist::transcoder_texture_format transcodeFormat;
+    gfx::Format                       renderFormat;
+};
+
+// picks the best block compressed format the device can sample, falls back to RGBA8
+BasisTarget getBasisTarget(bool hasAlpha, uint32_t width, uint32_t height) {
+    const auto *device = gfx::Device::getInstance();
+
+    if (isSampleable(device, gfx::Format::ASTC_RGBA_4X4)) {
+        return {basist::transcoder_texture_format::cTFASTC_4x4_RGBA, gfx::Format::ASTC_RGBA_4X4};
+    }
+    if (isSampleable(device, gfx::Format::BC7)) {
+        return {basist::transcoder_texture_format::cTFBC7_RGBA, gfx::Format::BC7};
+    }
+    if (isSampleable(device, gfx::Format::ETC2_RGBA8)) {
+        // ETC1 blocks are valid ETC2 RGB blocks
+        return hasAlpha ? BasisTarget{basist::transcoder_texture_format::cTFETC2_RGBA, gfx::Format::ETC2_RGBA8}
+                        : BasisTarget{basist::transcoder_texture_format::cTFETC1_RGB, gfx::Format::ETC2_RGB8};
+    }
+    // PVRTC1 needs square power of two sizes
+    if (width == height && (width & (width - 1)) == 0 && isSampleable(device, gfx::Format::PVRTC_RGBA4)) {
+        return hasAlpha ? BasisTarget{basist::transcoder_texture_format::cTFPVRTC1_4_RGBA, gfx::Format::PVRTC_RGBA4}
+                        : BasisTarget{basist::transcoder_texture_format::cTFPVRTC1_4_RGB, gfx::Format::PVRTC_RGB4};
+    }
+    if (isSampleable(device, gfx::Format::BC3)) {
+        return hasAlpha ? BasisTarget{basist::transcoder_texture_format::cTFBC3_RGBA, gfx::Format::BC3}
+                        : BasisTarget{basist::transcoder_texture_format::cTFBC1_RGB, gfx::Format::BC1};
+    }
+    if (!hasAlpha && isSampleable(device, gfx::Format::ETC_RGB8)) {
+        return {basist::transcoder_texture_format::cTFETC1_RGB, gfx::Format::ETC_RGB8};
+    }
+    return {basist::transcoder_texture_format::cTFRGBA32, gfx::Format::RGBA8};
+}
+#endif // CC_USE_BASISU
+} // namespace
+//ktx2 structure end
+
+namespace {
+// block rows decoded by each job at least, smaller images are decoded on the loading thread
+const uint32_t ETC_MIN_ROWS_PER_JOB = 16;
+
+// returns the PKM format the ETC decoder takes, 0 for the formats it can't decode
+etc2_uint32 getETCDecodeFormat(gfx::Format format) {
+    switch (format) {
+        case gfx::Format::ETC_RGB8: // ETC1 is a subset of ETC2 RGB8
+        case gfx::Format::ETC2_RGB8:
+        case gfx::Format::ETC2_SRGB8:
+            return ETC2_RGB_NO_MIPMAPS;
+        case gfx::Format::ETC2_RGBA8:
+        case gfx::Format::ETC2_SRGB8_A8:
+            return ETC2_RGBA_NO_MIPMAPS;
+        default:
+            return 0;
+    }
+}
+
+void decodeETC(const unsigned char *blocks, etc2_uint32 format, uint32_t width, uint32_t height, unsigned char *pixels) {
+    const uint32_t blockRows = (height + 3) / 4;
+    auto *         jobSystem = JobSystem::getInstance();
+    const uint32_t jobCount  = std::min(jobSystem->threadCount(), blockRows / ETC_MIN_ROWS_PER_JOB);
+    if (jobCount < 2) {
+        etc2_decode_block_rows(blocks, format, width, height, 0, blockRows, pixels);
+        return;
+    }
+
+    // block rows are independent, split them evenly across the workers
+    const uint32_t rowsPerJob = (blockRows + jobCount - 1) / jobCount;
+    JobGraph       graph(jobSystem);
+    graph.createForEachIndexJob(0U, jobCount, 1U, [&](uint32_t job) {
+        etc2_decode_block_rows(blocks, format, width, height, job * rowsPerJob, rowsPerJob, pixels);
+    });
+    graph.run();
+    graph.waitForAll();
+}
+} // namespace
+
 namespace {
 using tImageSource = struct {
     const unsigned char *data;
@@ -278,10 +462,11 @@ bool Image::initWithImageFile(const ccstd::string &path) {
     //    _filePath = FileUtils::getInstance()->fullPathForFilename(path);
     _filePath = path;
 
-    Data data = FileUtils::getInstance()->getDataFromFile(_filePath);
+    // decoders copy or unpack the pixels, the file content itself is only read once
+    const MappedFile file = FileUtils::getInstance()->mapFile(_filePath);
 
-    if (!data.isNull()) {
-        ret = initWithImageData(data.getBytes(), data.getSize());
+    if (!file.isNull()) {
+        ret = initWithImageData(file.getBytes(), static_cast<ssize_t>(file.getSize()));
     }
 
     return ret;
@@ -330,6 +515,9 @@ bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
             case Format::ASTC:
                 ret = initWithASTCData(unpackedData, unpackedLen);
                 break;
+            case Format::KTX2:
+                ret = initWithKTX2Data(unpackedData, unpackedLen);
+                break;
             default:
                 break;
         }
@@ -337,11 +525,43 @@ bool Image::initWithImageData(const unsigned char *data, ssize_t dataLen) {
         if (unpackedData != data) {
             free(unpackedData);
         }
+
+        if (ret && _isCompressed) {
+            decodeUnsupportedFormat();
+        }
     } while (false);
 
     return ret;
 }
 
+void Image::decodeUnsupportedFormat() {
+    const auto *device = gfx::Device::getInstance();
+    if (!device || isSampleable(device, _renderFormat)) {
+        return;
+    }
+
+    // only ETC has a software decoder, the device is expected to support one of the other formats it is shipped with
+    const etc2_uint32 format = getETCDecodeFormat(_renderFormat);
+    if (!format) {
+        return;
+    }
+
+    const auto width  = static_cast<uint32_t>(_width);
+    const auto height = static_cast<uint32_t>(_height);
+    if (static_cast<size_t>(_dataLen) < static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * etc2_get_block_size(format)) {
+        return;
+    }
+
+    auto *pixels = static_cast<unsigned char *>(malloc(width * height * 4));
+    decodeETC(_data, format, width, height, pixels);
+
+    free(_data);
+    _data         = pixels;
+    _dataLen      = width * height * 4;
+    _renderFormat = gfx::Format::RGBA8;
+    _isCompressed = false;
+}
+
 bool Image::isPng(const unsigned char *data, ssize_t dataLen) {
     if (dataLen <= 8) {
         return false;
@@ -364,6 +584,14 @@ bool Image::isASTC(const unsigned char *data, ssize_t /*dataLen*/) {
     return astcIsValid(const_cast<astc_byte *>(data));
 }
 
+bool Image::isKTX2(const unsigned char *data, ssize_t dataLen) {
+    if (static_cast<size_t>(dataLen) < sizeof(KTX2Header)) {
+        return false;
+    }
+
+    return memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0;
+}
+
 bool Image::isJpg(const unsigned char *data, ssize_t dataLen) {
     if (dataLen <= 4) {
         return false;
@@ -418,6 +646,9 @@ Image::Format Image::detectFormat(const unsigned char *data, ssize_t dataLen) {
     if (isASTC(data, dataLen)) {
         return Format::ASTC;
     }
+    if (isKTX2(data, dataLen)) {
+        return Format::KTX2;
+    }
     return Format::UNKNOWN;
 }
 
@@ -881,6 +1112,98 @@ bool Image::initWithASTCData(const unsigned char *data, ssize_t dataLen) {
     return true;
 }
 
+bool Image::initWithKTX2Data(const unsigned char *data, ssize_t dataLen) {
+    if (static_cast<size_t>(dataLen) < sizeof(KTX2Header) + sizeof(KTX2LevelIndex)) {
+        return false;
+    }
+
+    const auto *header = static_cast<const KTX2Header *>(static_cast<const void *>(data));
+    if (0 == header->pixelWidth || 0 == header->pixelHeight) {
+        return false;
+    }
+
+    if (header->vkFormat == KTX2_VK_FORMAT_UNDEFINED) {
+        return initWithBasisData(data, dataLen);
+    }
+
+    if (header->supercompressionScheme != static_cast<uint32_t>(KTX2Supercompression::NONE)) {
+        CC_LOG_DEBUG("initWithKTX2Data: WARNING: Unsupported KTX2 supercompression scheme: %u", header->supercompressionScheme);
+        return false;
+    }
+
+    auto it = KTX2_VK_FORMATHASH.find(header->vkFormat);
+    if (it == KTX2_VK_FORMATHASH.end()) {
+        CC_LOG_DEBUG("initWithKTX2Data: WARNING: Unsupported KTX2 vkFormat: %u", header->vkFormat);
+        return false;
+    }
+
+    // the level index starts with the base level, which is the only one used like the other containers
+    const auto *level = static_cast<const KTX2LevelIndex *>(static_cast<const void *>(data + sizeof(KTX2Header)));
+    if (level->byteOffset + level->byteLength > static_cast<uint64_t>(dataLen)) {
+        return false;
+    }
+
+    // layers, faces and depth slices of a level are stored one after another, keep the first image
+    const uint64_t imageCount = std::max(header->layerCount, 1U) * std::max(header->faceCount, 1U) * std::max(header->pixelDepth, 1U);
+
+    _renderFormat = it->second;
+    _width        = static_cast<int>(header->pixelWidth);
+    _height       = static_cast<int>(header->pixelHeight);
+    _isCompressed = _renderFormat != gfx::Format::RGBA8;
+
+    _dataLen = static_cast<ssize_t>(level->byteLength / imageCount);
+    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
+    memcpy(_data, data + level->byteOffset, _dataLen);
+
+    return true;
+}
+
+bool Image::initWithBasisData(const unsigned char *data, ssize_t dataLen) {
+#if CC_USE_BASISU
+    // thread safe, images are decoded on worker threads
+    static const bool TRANSCODER_INITIALIZED = (basist::basisu_transcoder_init(), true);
+    CC_UNUSED_PARAM(TRANSCODER_INITIALIZED);
+
+    // each image has its own transcoder so that images can be transcoded in parallel
+    basist::ktx2_transcoder transcoder;
+    if (!transcoder.init(data, static_cast<uint32_t>(dataLen)) || !transcoder.start_transcoding()) {
+        CC_LOG_DEBUG("initWithBasisData: WARNING: Invalid Basis Universal payload");
+        return false;
+    }
+
+    basist::ktx2_image_level_info levelInfo;
+    if (!transcoder.get_image_level_info(levelInfo, 0, 0, 0)) {
+        return false;
+    }
+
+    const BasisTarget target       = getBasisTarget(levelInfo.m_alpha_flag, levelInfo.m_orig_width, levelInfo.m_orig_height);
+    const bool        uncompressed = basist::basis_transcoder_format_is_uncompressed(target.transcodeFormat);
+    // uncompressed targets are sized in pixels, the others in blocks
+    const uint32_t outputSize = uncompressed ? levelInfo.m_orig_width * levelInfo.m_orig_height : levelInfo.m_total_blocks;
+
+    _dataLen = static_cast<ssize_t>(outputSize) * basist::basis_get_bytes_per_block_or_pixel(target.transcodeFormat);
+    _data    = static_cast<unsigned char *>(malloc(_dataLen * sizeof(unsigned char)));
+    if (!transcoder.transcode_image_level(0, 0, 0, _data, outputSize, target.transcodeFormat)) {
+        CC_LOG_DEBUG("initWithBasisData: WARNING: Failed to transcode Basis Universal payload");
+        CC_SAFE_FREE(_data);
+        _dataLen = 0;
+        return false;
+    }
+
+    _renderFormat = target.renderFormat;
+    _width        = static_cast<int>(levelInfo.m_orig_width);
+    _height       = static_cast<int>(levelInfo.m_orig_height);
+    _isCompressed = !uncompressed;
+
+    return true;
+#else
+    CC_UNUSED_PARAM(data);
+    CC_UNUSED_PARAM(dataLen);
+    CC_LOG_DEBUG("initWithBasisData: WARNING: Basis Universal textures need the engine built with USE_BASISU");
+    return false;
+#endif // CC_USE_BASISU
+}
+
 bool Image::initWithPVRData(const unsigned char *data, ssize_t dataLen) {
     return initWithPVRv2Data(data, dataLen) || initWithPVRv3Data(data, dataLen);
 }
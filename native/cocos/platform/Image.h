@@ -54,6 +54,8 @@ public:
         ETC2,
         //! ASTC
         ASTC,
+        //! KTX2, with block compressed or Basis Universal payloads
+        KTX2,
         //! Raw Data
         RAW_DATA,
         //! Unknown format
@@ -93,6 +95,11 @@ protected:
     bool initWithETCData(const unsigned char *data, ssize_t dataLen);
     bool initWithETC2Data(const unsigned char *data, ssize_t dataLen);
     bool initWithASTCData(const unsigned char *data, ssize_t dataLen);
+    bool initWithKTX2Data(const unsigned char *data, ssize_t dataLen);
+    bool initWithBasisData(const unsigned char *data, ssize_t dataLen);
+
+    // decodes compressed data the device can't sample to RGBA8 when there is a software decoder for it
+    void decodeUnsupportedFormat();
 
     unsigned char *_data     = nullptr;
     ssize_t        _dataLen  = 0;
@@ -111,6 +118,7 @@ protected:
     static bool   isEtc(const unsigned char *data, ssize_t dataLen);
     static bool   isEtc2(const unsigned char *data, ssize_t dataLen);
     static bool   isASTC(const unsigned char *data, ssize_t detaLen);
+    static bool   isKTX2(const unsigned char *data, ssize_t dataLen);
 
     static gfx::Format getASTCFormat(const unsigned char *pHeader);
 
@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "platform/ImageDecodeQueue.h"
+#include <algorithm>
+#include "core/utils/ImageUtils.h"
+
+namespace cc {
+
+uint32_t ImageDecodeQueue::getDefaultThreadCount() {
+    // leave one core to the cocos thread, decoding more than 4 images at once only adds memory pressure
+    const uint32_t cores = std::thread::hardware_concurrency();
+    return std::min(4U, std::max(1U, cores > 1 ? cores - 1 : 1U));
+}
+
+ImageDecodeQueue::ImageDecodeQueue(uint32_t threadCount, uint32_t capacity)
+: _capacity(std::max(capacity, 1U)) {
+    threadCount = std::max(threadCount, 1U);
+    _workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _workers.emplace_back(&ImageDecodeQueue::workerLoop, this);
+    }
+}
+
+ImageDecodeQueue::~ImageDecodeQueue() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+        _tasks.clear();
+    }
+    _taskCondition.notify_all();
+    _spaceCondition.notify_all();
+
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+bool ImageDecodeQueue::decode(Data &&data, const Options &options, Callback callback) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _spaceCondition.wait(lock, [this]() { return _stopped || _tasks.size() < _capacity; });
+        if (_stopped) {
+            return false;
+        }
+        _tasks.push_back({std::move(data), options, std::move(callback)});
+    }
+    _taskCondition.notify_one();
+    return true;
+}
+
+uint32_t ImageDecodeQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(_tasks.size());
+}
+
+void ImageDecodeQueue::workerLoop() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _taskCondition.wait(lock, [this]() { return _stopped || !_tasks.empty(); });
+            if (_stopped) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        _spaceCondition.notify_one();
+
+        IntrusivePtr<Image> image = new (std::nothrow) Image();
+        if (image && image->initWithImageData(task.data.getBytes(), task.data.getSize())) {
+            // release the encoded bytes before the conversions allocate the expanded copy
+            task.data.clear();
+            if (task.options.convertToRGBA) {
+                ImageUtils::convert2RGBA(image);
+            }
+            if (task.options.premultiplyAlpha) {
+                ImageUtils::premultiplyAlpha(image);
+            }
+        } else {
+            image = nullptr;
+        }
+
+        if (task.callback) {
+            task.callback(std::move(image));
+        }
+    }
+}
+
+} // namespace cc
@@ -0,0 +1,101 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "base/Data.h"
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/deque.h"
+#include "base/std/container/vector.h"
+#include "platform/Image.h"
+
+namespace cc {
+
+/**
+ * @en Decodes encoded images (PNG, JPEG, WebP, ...) on a fixed set of worker threads.
+ * The queue is bounded, decode blocks the caller once it is full so memory of pending
+ * encoded data stays capped.
+ * @zh 在固定数量的工作线程上解码图片（PNG、JPEG、WebP 等）。
+ * 队列有容量上限，满时 decode 会阻塞调用者，从而限制待解码数据占用的内存。
+ */
+class CC_DLL ImageDecodeQueue final {
+public:
+    struct Options {
+        // expand L8, LA8 and RGB8 results to RGBA8
+        bool convertToRGBA{false};
+        // premultiply color by alpha of RGBA8 results
+        bool premultiplyAlpha{false};
+    };
+
+    /**
+     * @en Invoked on the worker thread, image is null if decoding failed.
+     * @zh 在工作线程上调用，解码失败时 image 为空。
+     */
+    using Callback = std::function<void(IntrusivePtr<Image> &&image)>;
+
+    static constexpr uint32_t DEFAULT_CAPACITY{64};
+
+    explicit ImageDecodeQueue(uint32_t threadCount = getDefaultThreadCount(), uint32_t capacity = DEFAULT_CAPACITY);
+    ~ImageDecodeQueue();
+    ImageDecodeQueue(const ImageDecodeQueue &) = delete;
+    ImageDecodeQueue &operator=(const ImageDecodeQueue &) = delete;
+
+    /**
+     * @en Queues encoded image bytes for decoding, blocks while the queue is full.
+     * Pending requests are dropped without callback when the queue is destroyed.
+     * @zh 将图片数据加入解码队列，队列已满时阻塞。队列销毁时未处理的请求会被丢弃，不会回调。
+     * @return @en False if the queue is shutting down. @zh 队列正在关闭时返回 false。
+     */
+    bool decode(Data &&data, const Options &options, Callback callback);
+
+    uint32_t getPendingCount() const;
+    inline uint32_t getThreadCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+    static uint32_t getDefaultThreadCount();
+
+private:
+    struct Task {
+        Data     data;
+        Options  options;
+        Callback callback;
+    };
+
+    void workerLoop();
+
+    ccstd::vector<std::thread> _workers;
+    ccstd::deque<Task>         _tasks;
+    mutable std::mutex         _mutex;
+    std::condition_variable    _taskCondition;
+    std::condition_variable    _spaceCondition;
+    uint32_t                   _capacity{DEFAULT_CAPACITY};
+    bool                       _stopped{false};
+};
+
+} // namespace cc
@@ -48,8 +48,8 @@
 
 namespace cc {
 
-AAssetManager *FileUtilsAndroid::assetmanager = nullptr;
-ZipFile *      FileUtilsAndroid::obbfile      = nullptr;
+AAssetManager *             FileUtilsAndroid::assetmanager = nullptr;
+std::shared_ptr<ZipArchive> FileUtilsAndroid::obbfile;
 
 void FileUtilsAndroid::setassetmanager(AAssetManager *a) {
     if (nullptr == a) {
@@ -75,10 +75,7 @@ FileUtils *FileUtils::getInstance() {
 FileUtilsAndroid::FileUtilsAndroid() = default;
 
 FileUtilsAndroid::~FileUtilsAndroid() {
-    if (obbfile) {
-        delete obbfile;
-        obbfile = nullptr;
-    }
+    obbfile.reset();
 }
 
 bool FileUtilsAndroid::init() {
@@ -86,7 +83,7 @@ bool FileUtilsAndroid::init() {
 
     ccstd::string assetsPath(getObbFilePathJNI());
     if (assetsPath.find("/obb/") != ccstd::string::npos) {
-        obbfile = new ZipFile(assetsPath);
+        obbfile = ZipArchive::open(assetsPath);
     }
 
     return FileUtils::init();
@@ -227,6 +224,48 @@ FileUtils::Status FileUtilsAndroid::getContents(const ccstd::string &filename, R
     return FileUtils::Status::OK;
 }
 
+MappedFile FileUtilsAndroid::mapFile(const ccstd::string &filename) {
+    const ccstd::string fullPath = filename.empty() ? "" : fullPathForFilename(filename);
+    if (fullPath.empty()) {
+        return {};
+    }
+
+    if (fullPath[0] == '/') {
+        return FileUtils::mapFile(fullPath);
+    }
+
+    ccstd::string relativePath;
+    size_t        position = fullPath.find(ASSETS_FOLDER_NAME);
+    if (0 == position) {
+        relativePath += fullPath.substr(strlen(ASSETS_FOLDER_NAME));
+    } else {
+        relativePath = fullPath;
+    }
+
+    // stored entries of the expansion file are served from its mapping
+    if (obbfile && obbfile->fileExists(relativePath)) {
+        return obbfile->mapFileData(relativePath);
+    }
+
+    if (nullptr == assetmanager) {
+        return MappedFile(getDataFromFile(fullPath));
+    }
+
+    // uncompressed entries are mapped from the apk, compressed ones are inflated by the asset itself
+    AAsset *asset = AAssetManager_open(assetmanager, relativePath.data(), AASSET_MODE_BUFFER);
+    if (nullptr == asset) {
+        return {};
+    }
+    const void *bytes = AAsset_getBuffer(asset);
+    if (nullptr == bytes) {
+        AAsset_close(asset);
+        return MappedFile(getDataFromFile(fullPath));
+    }
+    return MappedFile(static_cast<const unsigned char *>(bytes), static_cast<size_t>(AAsset_getLength(asset)), asset, [](void *handle, const unsigned char * /*bytes*/, size_t /*size*/) {
+        AAsset_close(static_cast<AAsset *>(handle));
+    });
+}
+
 ccstd::string FileUtilsAndroid::getWritablePath() const {
     // Fix for Nexus 10 (Android 4.2 multi-user environment)
     // the path is retrieved through Java Context.getCacheDir() method
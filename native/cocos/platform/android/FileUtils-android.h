@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <memory>
 #include "android/asset_manager.h"
 #include "base/Macros.h"
 #include "base/std/container/string.h"
@@ -35,7 +36,7 @@
 
 namespace cc {
 
-class ZipFile;
+class ZipArchive;
 
 /**
  * @addtogroup platform
@@ -56,11 +57,12 @@ public:
 
     static void           setassetmanager(AAssetManager *a);
     static AAssetManager *getAssetManager() { return assetmanager; }
-    static ZipFile *      getObbFile() { return obbfile; }
+    static ZipArchive *   getObbFile() { return obbfile.get(); }
 
     /* override functions */
     bool              init() override;
     FileUtils::Status getContents(const ccstd::string &filename, ResizableBuffer *buffer) override;
+    MappedFile        mapFile(const ccstd::string &filename) override;
 
     ccstd::string getWritablePath() const override;
     bool          isAbsolutePath(const ccstd::string &strPath) const override;
@@ -69,8 +71,8 @@ private:
     bool isFileExistInternal(const ccstd::string &strFilePath) const override;
     bool isDirectoryExistInternal(const ccstd::string &dirPath) const override;
 
-    static AAssetManager *assetmanager;
-    static ZipFile *      obbfile;
+    static AAssetManager *             assetmanager;
+    static std::shared_ptr<ZipArchive> obbfile;
 };
 
 // end of platform group
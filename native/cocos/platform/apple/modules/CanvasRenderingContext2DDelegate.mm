@@ -26,6 +26,7 @@
 #include "platform/apple/modules/CanvasRenderingContext2DDelegate.h"
 #include "base/UTF8.h"
 #include "base/csscolorparser.h"
+#include "core/utils/ImageUtils.h"
 #include "math/Math.h"
 
 
@@ -631,17 +632,8 @@ void CanvasRenderingContext2DDelegate::fillImageData(const Data &imageData, floa
 void CanvasRenderingContext2DDelegate::fillData() {
 }
 
-#define CLAMP(V, HI) std::min((V), (HI))
 void CanvasRenderingContext2DDelegate::unMultiplyAlpha(unsigned char *ptr, ssize_t size) const {
-    float alpha;
-    for (int i = 0; i < size; i += 4) {
-        alpha = (float)ptr[i + 3];
-        if (alpha > 0) {
-            ptr[i]     = CLAMP((int)((float)ptr[i] / alpha * 255), 255);
-            ptr[i + 1] = CLAMP((int)((float)ptr[i + 1] / alpha * 255), 255);
-            ptr[i + 2] = CLAMP((int)((float)ptr[i + 2] / alpha * 255), 255);
-        }
-    }
+    ImageUtils::unpremultiplyAlpha(ptr, static_cast<uint32_t>(size / 4));
 }
 
 } // namespace cc
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "platform/java/modules/CanvasRenderingContext2DDelegate.h"
+#include "core/utils/ImageUtils.h"
 
 #if (CC_PLATFORM == CC_PLATFORM_ANDROID)
     #include <android/bitmap.h>
@@ -35,8 +36,6 @@ namespace {
 
 } // namespace
 
-#define CLAMP(V, HI) std::min((V), (HI))
-
 namespace cc {
 CanvasRenderingContext2DDelegate::CanvasRenderingContext2DDelegate() {
     jobject obj = JniHelper::newObject(JCLS_CANVASIMPL);
@@ -286,14 +285,6 @@ void CanvasRenderingContext2DDelegate::unMultiplyAlpha(unsigned char *ptr, ssize
     //        if (getAndroidSDKInt() >= 19)
     //            return;
 
-    float alpha;
-    for (int i = 0; i < size; i += 4) {
-        alpha = static_cast<float>(ptr[i + 3]);
-        if (alpha > 0) {
-            ptr[i]     = CLAMP((int)((float)ptr[i] / alpha * 255), 255);
-            ptr[i + 1] = CLAMP((int)((float)ptr[i + 1] / alpha * 255), 255);
-            ptr[i + 2] = CLAMP((int)((float)ptr[i + 2] / alpha * 255), 255);
-        }
-    }
+    ImageUtils::unpremultiplyAlpha(ptr, static_cast<uint32_t>(size / 4));
 }
 } // namespace cc
@@ -176,6 +176,39 @@ FileUtils::Status FileUtilsWin32::getContents(const ccstd::string &filename, Res
     return FileUtils::Status::OK;
 }
 
+MappedFile FileUtilsWin32::mapFile(const ccstd::string &filename) {
+    const ccstd::string fullPath = filename.empty() ? "" : FileUtils::getInstance()->fullPathForFilename(filename);
+    if (fullPath.empty()) {
+        return {};
+    }
+
+    HANDLE fileHandle = ::CreateFile(StringUtf8ToWideChar(fullPath).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return {};
+    }
+
+    LARGE_INTEGER size;
+    HANDLE        mapping = nullptr;
+    if (::GetFileSizeEx(fileHandle, &size) && size.QuadPart > 0) {
+        mapping = ::CreateFileMapping(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    // the mapping object keeps the file open
+    ::CloseHandle(fileHandle);
+    if (!mapping) {
+        return MappedFile(getDataFromFile(filename));
+    }
+
+    const void *bytes = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!bytes) {
+        ::CloseHandle(mapping);
+        return MappedFile(getDataFromFile(filename));
+    }
+    return MappedFile(static_cast<const unsigned char *>(bytes), static_cast<size_t>(size.QuadPart), mapping, [](void *handle, const unsigned char *bytes, size_t /*size*/) {
+        ::UnmapViewOfFile(bytes);
+        ::CloseHandle(handle);
+    });
+}
+
 ccstd::string FileUtilsWin32::getPathForFilename(const ccstd::string &filename, const ccstd::string &searchPath) const {
     ccstd::string unixFileName   = convertPathFormatToUnixStyle(filename);
     ccstd::string unixSearchPath = convertPathFormatToUnixStyle(searchPath);
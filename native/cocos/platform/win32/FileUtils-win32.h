@@ -109,6 +109,8 @@ protected:
 
     virtual FileUtils::Status getContents(const ccstd::string &filename, ResizableBuffer *buffer) override;
 
+    virtual MappedFile mapFile(const ccstd::string &filename) override;
+
     /**
      *  Gets full path for filename, resolution directory and search path.
      *
@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "primitive/PrimitiveMeshCache.h"
+#include "3d/misc/CreateMesh.h"
+
+namespace cc {
+
+namespace {
+
+// the raw bytes of every option field, optional fields are prefixed with whether they are set
+class KeyWriter {
+public:
+    template <typename T>
+    void write(const T &value) {
+        _key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void write(const cc::optional<T> &value) {
+        write(value.has_value());
+        if (value.has_value()) {
+            write(value.value());
+        }
+    }
+
+    void write(const IGeometryOptions &options) {
+        write(options.includeNormal);
+        write(options.includeUV);
+    }
+
+    void write(const IBoxOptions &options) {
+        write(static_cast<const IGeometryOptions &>(options));
+        write(options.width);
+        write(options.height);
+        write(options.length);
+        write(options.widthSegments);
+        write(options.heightSegments);
+        write(options.lengthSegments);
+    }
+
+    void write(const ICapsuleOptions &options) {
+        write(options.sides);
+        write(options.heightSegments);
+        write(options.capped);
+        write(options.arc);
+    }
+
+    void write(const ICircleOptions &options) {
+        write(static_cast<const IGeometryOptions &>(options));
+        write(options.segments);
+    }
+
+    void write(const ICylinderOptions &options) {
+        write(static_cast<const IGeometryOptions &>(options));
+        write(options.radialSegments);
+        write(options.heightSegments);
+        write(options.capped);
+        write(options.arc);
+    }
+
+    void write(const IPlaneOptions &options) {
+        write(static_cast<const IGeometryOptions &>(options));
+        write(options.width);
+        write(options.length);
+        write(options.widthSegments);
+        write(options.lengthSegments);
+    }
+
+    void write(const ISphereOptions &options) {
+        write(static_cast<const IGeometryOptions &>(options));
+        write(options.segments);
+    }
+
+    void write(const ITorusOptions &options) {
+        write(options.radialSegments);
+        write(options.tubularSegments);
+        write(options.arc);
+    }
+
+    inline const ccstd::string &getKey() const { return _key; }
+
+private:
+    ccstd::string _key;
+};
+
+ccstd::string makeKey(PrimitiveType type, const cc::optional<PrimitiveOptions> &options) {
+    KeyWriter writer;
+    writer.write(type);
+    writer.write(options.has_value());
+    if (options.has_value()) {
+        // cones and cylinders share their option type, they are told apart by the alternative index
+        writer.write(static_cast<uint32_t>(options->index()));
+        cc::visit([&](const auto &alternative) { writer.write(alternative); }, options.value());
+    }
+    return writer.getKey();
+}
+
+} // namespace
+
+PrimitiveMeshCache *PrimitiveMeshCache::instance = nullptr;
+
+PrimitiveMeshCache *PrimitiveMeshCache::getInstance() {
+    if (!PrimitiveMeshCache::instance) {
+        PrimitiveMeshCache::instance = new PrimitiveMeshCache();
+    }
+    return PrimitiveMeshCache::instance;
+}
+
+void PrimitiveMeshCache::destroyInstance() {
+    CC_SAFE_DELETE(PrimitiveMeshCache::instance);
+}
+
+Mesh *PrimitiveMeshCache::getMesh(PrimitiveType type, const cc::optional<PrimitiveOptions> &options) {
+    auto key  = makeKey(type, options);
+    auto iter = _meshes.find(key);
+    if (iter != _meshes.end()) {
+        return iter->second.get();
+    }
+
+    Mesh *mesh = MeshUtils::createMesh(createGeometry(type, options));
+    _meshes.emplace(std::move(key), mesh);
+    return mesh;
+}
+
+void PrimitiveMeshCache::releaseUnused() {
+    for (auto iter = _meshes.begin(); iter != _meshes.end();) {
+        if (iter->second->getRefCount() == 1) {
+            iter = _meshes.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void PrimitiveMeshCache::clear() {
+    _meshes.clear();
+}
+
+} // namespace cc
@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "primitive/Primitive.h"
+
+namespace cc {
+
+/**
+ * @en
+ * Shared meshes of procedural primitives, keyed by the type and the options they are built from.
+ * Primitives created with the same parameters get the same mesh and the same sub meshes, so their models can
+ * be batched and instanced together. The returned meshes must not be modified, build a mesh with createGeometry
+ * and MeshUtils::createMesh to get one that can be.
+ * @zh
+ * 程序化基础图形的共享网格，以图形类型和构建参数为键。以相同参数创建的图形获得相同的网格及子网格，
+ * 因此它们的模型可以合批与实例化。返回的网格不可修改，如需修改请使用 createGeometry 与 MeshUtils::createMesh 构建网格。
+ */
+class CC_DLL PrimitiveMeshCache final {
+public:
+    static PrimitiveMeshCache *getInstance();
+    static void                destroyInstance();
+
+    /**
+     * @en Get the shared mesh of a primitive, it is built on first use.
+     * @zh 获取基础图形的共享网格，首次使用时构建。
+     */
+    Mesh *getMesh(PrimitiveType type, const cc::optional<PrimitiveOptions> &options = cc::nullopt);
+
+    // releases the meshes that nothing but the cache references
+    void releaseUnused();
+    void clear();
+
+    inline uint32_t getMeshCount() const { return static_cast<uint32_t>(_meshes.size()); }
+
+private:
+    PrimitiveMeshCache()  = default;
+    ~PrimitiveMeshCache() = default;
+
+    static PrimitiveMeshCache *instance;
+
+    ccstd::unordered_map<ccstd::string, IntrusivePtr<Mesh>> _meshes;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PrimitiveMeshCache);
+};
+
+} // namespace cc
@@ -32,6 +32,7 @@
 #include "base/memory/Memory.h"
 #include "core/assets/BitmapFont.h"
 #include "core/assets/FreeTypeFont.h"
+#include "core/assets/TextLayoutCache.h"
 #include "math/Vec2.h"
 #include "platform/interfaces/modules/Device.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
@@ -48,6 +49,8 @@ namespace cc {
 constexpr uint32_t DEBUG_FONT_SIZE         = 10U;
 constexpr uint32_t DEBUG_MAX_CHARACTERS    = 10000U;
 constexpr uint32_t DEBUG_VERTICES_PER_CHAR = 6U;
+// the shader skips the font texture for negative texture coordinates
+const Vec4 DEBUG_SOLID_UV{-1.0F, -1.0F, 0.0F, 0.0F};
 
 inline uint32_t getFontIndex(bool bold, bool italic) {
     /**
@@ -148,20 +151,23 @@ public:
             return;
         }
 
-        std::vector<DebugVertex> vertices;
+        // kept across frames, so gathering the batches doesn't allocate
+        _vertices.clear();
         for (auto *batch : _batches) {
-            vertices.insert(vertices.end(), batch->vertices.begin(), batch->vertices.end());
+            _vertices.insert(_vertices.end(), batch->vertices.begin(), batch->vertices.end());
         }
 
-        const auto count = std::min(static_cast<uint32_t>(vertices.size()), _maxVertices);
+        const auto count = std::min(static_cast<uint32_t>(_vertices.size()), _maxVertices);
         const auto size  = static_cast<uint32_t>(count * sizeof(DebugVertex));
-        _buffer->update(&vertices[0], size);
+        _buffer->update(&_vertices[0], size);
     }
 
     inline void destroy() {
         for (auto *batch : _batches) {
             CC_SAFE_DELETE(batch);
         }
+        _batches.clear();
+        _lastBatch = nullptr;
 
         CC_SAFE_DESTROY_AND_DELETE(_buffer);
         CC_SAFE_DESTROY_AND_DELETE(_inputAssembler);
@@ -169,14 +175,21 @@ public:
     }
 
     DebugBatch &getOrCreateBatch(gfx::Device *device, bool bold, bool italic, gfx::Texture *texture) {
+        // consecutive quads mostly go to the same batch
+        if (_lastBatch && _lastBatch->match(bold, italic, texture)) {
+            return *_lastBatch;
+        }
+
         for (auto *batch : _batches) {
             if (batch->match(bold, italic, texture)) {
+                _lastBatch = batch;
                 return *batch;
             }
         }
 
         auto *batch = new DebugBatch(device, bold, italic, texture);
         _batches.push_back(batch);
+        _lastBatch = batch;
 
         return *batch;
     }
@@ -195,6 +208,8 @@ public:
 private:
     uint32_t                  _maxVertices{0U};
     std::vector<DebugBatch *> _batches;
+    DebugBatch *              _lastBatch{nullptr};
+    std::vector<DebugVertex>  _vertices;
     gfx::Buffer *             _buffer{nullptr};
     gfx::InputAssembler *     _inputAssembler{nullptr};
 
@@ -250,6 +265,12 @@ void DebugRenderer::render(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdB
         return;
     }
 
+    for (auto &font : _fonts) {
+        if (font.face) {
+            font.face->flush();
+        }
+    }
+
     _buffer->update();
 
     const auto &pass   = sceneData->getDebugRendererPass();
@@ -283,6 +304,7 @@ void DebugRenderer::render(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdB
 void DebugRenderer::destroy() {
     CC_SAFE_DESTROY_AND_DELETE(_buffer);
 
+    _layoutCache.clear();
     for (auto &iter : _fonts) {
         CC_SAFE_DELETE(iter.font);
     }
@@ -297,66 +319,40 @@ void DebugRenderer::addText(const ccstd::string &text, const Vec2 &screenPos, co
         return;
     }
 
-    std::u32string unicodeText;
-    bool           success = StringUtils::UTF8ToUTF32(text, unicodeText);
-    if (!success) {
-        return;
-    }
-
-    auto        offsetX        = screenPos.x;
-    auto        offsetY        = screenPos.y;
-    const auto  scale          = info.scale;
-    const auto  lineHeight     = face->getLineHeight() * scale;
-    const auto &invTextureSize = fontInfo.invTextureSize;
-
-    for (char32_t code : unicodeText) {
-        if (code == '\r') {
-            continue;
-        }
-
-        if (code == '\n') {
-            offsetX = screenPos.x;
-            offsetY += lineHeight;
-            continue;
-        }
-
-        const auto *glyph = face->getGlyph(code);
-        if (!glyph) {
-            continue;
-        }
-
-        if (glyph->width > 0U && glyph->height > 0U) {
-            auto &batch = _buffer->getOrCreateBatch(_device, info.bold, info.italic, face->getTexture(glyph->page));
-
-            Vec4 rect{offsetX + static_cast<float>(glyph->bearingX) * scale,
-                      offsetY - static_cast<float>(glyph->bearingY) * scale,
-                      static_cast<float>(glyph->width) * scale,
-                      static_cast<float>(glyph->height) * scale};
-            Vec4 uv{static_cast<float>(glyph->x) * invTextureSize.x,
-                    static_cast<float>(glyph->y) * invTextureSize.y,
-                    static_cast<float>(glyph->width) * invTextureSize.x,
-                    static_cast<float>(glyph->height) * invTextureSize.y};
-
-            if (info.shadow) {
-                for (auto x = 1U; x <= info.shadowThickness; x++) {
-                    for (auto y = 1U; y <= info.shadowThickness; y++) {
-                        Vec4 shadowRect(rect.x + x, rect.y + y, rect.z, rect.w);
-                        addQuad(batch, shadowRect, uv, info.shadowColor);
-                    }
+#ifdef USE_KERNING
+    const TextLayoutParams params{info.scale, true};
+#else
+    const TextLayoutParams params{info.scale, false};
+#endif
+    // profiler text mostly repeats from frame to frame, only the quads are rebuilt
+    const auto layout = _layoutCache.getLayout(face, text, params);
+
+    for (const auto &quad : layout->quads) {
+        auto &batch = _buffer->getOrCreateBatch(_device, info.bold, info.italic, face->getTexture(quad.page));
+        Vec4  rect{screenPos.x + quad.rect.x, screenPos.y + quad.rect.y, quad.rect.z, quad.rect.w};
+
+        if (info.shadow) {
+            for (auto x = 1U; x <= info.shadowThickness; x++) {
+                for (auto y = 1U; y <= info.shadowThickness; y++) {
+                    Vec4 shadowRect(rect.x + x, rect.y + y, rect.z, rect.w);
+                    addQuad(batch, shadowRect, quad.uv, info.shadowColor);
                 }
             }
-
-            addQuad(batch, rect, uv, info.color);
         }
 
-        offsetX += glyph->advance * scale;
+        addQuad(batch, rect, quad.uv, info.color);
+    }
+}
 
-#ifdef USE_KERNING
-        if (i < unicodeText.size() - 1) {
-            offsetX += face->getKerning(code, unicodeText[i + 1]) * scale;
-        }
-#endif
+void DebugRenderer::addRect(const Vec4 &rect, gfx::Color color) {
+    auto *face = _fonts[getFontIndex(false, false)].face;
+    if (!_buffer || !face || face->getTextures().empty()) {
+        return;
     }
+
+    // same batch as the regular text, so the rectangles don't add a draw
+    auto &batch = _buffer->getOrCreateBatch(_device, false, false, face->getTexture(0));
+    addQuad(batch, rect, DEBUG_SOLID_UV, color);
 }
 
 uint32_t DebugRenderer::getLineHeight(bool bold, bool italic) {
@@ -28,6 +28,7 @@
 #include <math/Vec4.h>
 #include "base/std/container/array.h"
 #include "base/std/container/string.h"
+#include "core/assets/TextLayoutCache.h"
 #include "gfx-base/GFXDef-common.h"
 
 namespace cc {
@@ -90,6 +91,8 @@ public:
     void destroy();
 
     void addText(const ccstd::string &text, const Vec2 &screenPos, const DebugTextInfo &info = DebugTextInfo());
+    // solid rectangle of [x, y, width, height] in screen pixels, drawn with the regular text
+    void addRect(const Vec4 &rect, gfx::Color color);
 
 private:
     DebugRenderer()  = default;
@@ -102,6 +105,7 @@ private:
     gfx::Device *         _device{nullptr};
     DebugVertexBuffer *   _buffer{nullptr};
     DebugFontArray        _fonts;
+    TextLayoutCache       _layoutCache;
 
     friend class Profiler;
 };
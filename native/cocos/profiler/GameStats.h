@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #pragma once
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <mutex>
@@ -32,6 +33,7 @@
 #include "base/StringUtil.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
@@ -67,6 +69,13 @@ struct TimeCounter {
         count++;
     }
 
+    // merges what another thread measured during the frame
+    inline void add(uint64_t value, uint32_t calls, uint64_t maxValue) {
+        max = std::max(max, maxValue);
+        time += value;
+        count += calls;
+    }
+
     inline void onFrameBegin() {
         // reset current frame
         max   = 0U;
@@ -168,6 +177,84 @@ struct CoreStats {
     uint32_t      screenHeight{0U};
 };
 
+// assume update in main thread only.
+struct GPUStats {
+    float                                          frameTime{0.0F}; // milliseconds
+    ccstd::vector<std::pair<ccstd::string, float>> passes;          // GPU time of each pass in milliseconds
+};
+
+struct BindingStats {
+    struct Item {
+        const char *name{nullptr};
+        uint32_t    count{0U};
+        float       totalTime{0.0F};   // milliseconds
+        float       convertTime{0.0F}; // milliseconds spent converting arguments
+    };
+    ccstd::vector<Item> items; // the bindings with the most cumulative time since the last clear
+};
+
+// what a single frame took and did, times are in milliseconds.
+struct FrameSample {
+    float    mainTime{0.0F};   // main thread, excluding the sleep of the frame rate limit
+    float    renderTime{0.0F}; // render thread
+    float    gpuTime{0.0F};    // GPU time of the legacy pipeline, 0 while its GPU timing is disabled
+    uint32_t drawCalls{0U};
+    uint32_t pipelineStateBinds{0U};
+    uint32_t descriptorSetUpdates{0U};
+    uint32_t uploads{0U};
+    uint64_t uploadBytes{0U};
+    uint32_t allocations{0U}; // needs USE_MEMORY_LEAK_DETECTOR
+};
+
+// assume update in main thread only.
+struct FrameHistory {
+    static constexpr uint32_t SIZE = 240U;
+
+    ccstd::vector<FrameSample> samples = ccstd::vector<FrameSample>(SIZE);
+    uint32_t                   next{0U};
+    uint32_t                   count{0U};
+
+    inline void push(const FrameSample &sample) {
+        samples[next] = sample;
+        next          = (next + 1U) % SIZE;
+        count         = std::min(count + 1U, SIZE);
+    }
+
+    // 0 is the oldest sample
+    inline const FrameSample &at(uint32_t index) const {
+        return samples[(next + SIZE - count + index) % SIZE];
+    }
+
+    inline const FrameSample &back() const { return at(count - 1U); }
+};
+
+// percentiles of the frame history, refreshed every interval
+struct FramePercentiles {
+    float p50{0.0F};
+    float p95{0.0F};
+    float p99{0.0F};
+};
+
+struct FrameStats {
+    FramePercentiles mainTime;
+    FramePercentiles renderTime;
+    FramePercentiles gpuTime;
+};
+
+// the main thread blocks of a frame over budget, in the order they are displayed
+struct HitchRecord {
+    struct Block {
+        ccstd::string name;
+        uint32_t      depth{0U};
+        float         time{0.0F}; // milliseconds
+        uint32_t      count{0U};
+    };
+
+    uint32_t             frame{0U};
+    FrameSample          sample;
+    ccstd::vector<Block> blocks;
+};
+
 struct MemoryStats {
     // memory stats
     std::mutex                                         mutex;
@@ -24,11 +24,17 @@
  ****************************************************************************/
 
 #include "Profiler.h"
+#include <algorithm>
+#include <cstring>
 #include "DebugRenderer.h"
 #include "application/ApplicationManager.h"
 #include "base/Log.h"
 #include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/threading/ThreadAffinity.h"
+#include "base/memory/MemoryAccounting.h"
 #include "base/memory/MemoryHook.h"
+#include "bindings/jswrapper/SeApi.h"
 #include "core/Root.h"
 #include "core/assets/Font.h"
 #include "gfx-base/GFXDevice.h"
@@ -36,7 +42,9 @@
 #include "platform/interfaces/modules/Device.h"
 #include "platform/interfaces/modules/ISystemWindow.h"
 #include "renderer/GFXDeviceManager.h"
+#include "renderer/gfx-agent/DeviceAgent.h"
 #include "renderer/pipeline/PipelineSceneData.h"
+#include "renderer/pipeline/RenderPipeline.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "scene/Shadow.h"
 
@@ -53,7 +61,9 @@ public:
 
     inline void    begin() { _timer.reset(); }
     inline void    end() { _item += _timer.getMicroseconds(); }
-    ProfilerBlock *getOrCreateChild(const ccstd::string &name);
+    inline void    merge(uint64_t time, uint32_t count, uint64_t max) { _item.add(time, count, max); }
+    ProfilerBlock *getOrCreateChild(const char *name);
+    ProfilerBlock *findChild(const char *name) const;
     void           onFrameBegin();
     void           onFrameEnd();
     void           doIntervalUpdate();
@@ -76,7 +86,7 @@ ProfilerBlock::~ProfilerBlock() {
     _children.clear();
 }
 
-ProfilerBlock *ProfilerBlock::getOrCreateChild(const ccstd::string &name) {
+ProfilerBlock *ProfilerBlock::getOrCreateChild(const char *name) {
     for (auto *child : _children) {
         if (child->_name == name) {
             return child;
@@ -89,6 +99,16 @@ ProfilerBlock *ProfilerBlock::getOrCreateChild(const ccstd::string &name) {
     return child;
 }
 
+ProfilerBlock *ProfilerBlock::findChild(const char *name) const {
+    for (auto *child : _children) {
+        if (child->_name == name) {
+            return child;
+        }
+    }
+
+    return nullptr;
+}
+
 void ProfilerBlock::onFrameBegin() { //NOLINT(misc-no-recursion)
     _item.onFrameBegin();
 
@@ -113,11 +133,132 @@ void ProfilerBlock::doIntervalUpdate() { //NOLINT(misc-no-recursion)
     }
 }
 
+constexpr uint32_t MAX_BINDING_STATS     = 10U;
+constexpr uint32_t MAX_HITCH_BLOCK_LINES = 16U; // the whole tree is in the log
+
 struct ProfilerBlockDepth {
     ProfilerBlock *block{nullptr};
     uint32_t       depth{0U};
 };
 
+/**
+ * Storage of the blocks and counters of a thread other than the main one. Only the owner thread writes it, so plain
+ * relaxed loads and stores are enough there; the main thread reads the slot of the previous frame while the owner
+ * records into the other one, and new nodes are published with release stores.
+ */
+constexpr uint32_t MAX_THREAD_COUNTERS = 64U;
+
+template <typename T>
+inline void relaxedAdd(std::atomic<T> &value, T delta) {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+struct ThreadFrameSlot {
+    std::atomic<uint64_t> time{0U};
+    std::atomic<uint64_t> max{0U};
+    std::atomic<uint32_t> count{0U};
+};
+
+struct ThreadBlock {
+    ThreadBlock(ThreadBlock *parent, const char *name)
+    : parent(parent), name(name) {}
+
+    ~ThreadBlock() {
+        auto *child = firstChild.load(std::memory_order_acquire);
+        while (child) {
+            auto *next = child->next.load(std::memory_order_acquire);
+            delete child;
+            child = next;
+        }
+    }
+
+    ThreadBlock *getOrCreateChild(const char *childName) {
+        for (auto *child = firstChild.load(std::memory_order_relaxed); child; child = child->next.load(std::memory_order_relaxed)) {
+            if (child->name == childName || strcmp(child->name, childName) == 0) {
+                return child;
+            }
+        }
+
+        auto *child = new ThreadBlock(this, childName);
+        if (lastChild) {
+            lastChild->next.store(child, std::memory_order_release);
+        } else {
+            firstChild.store(child, std::memory_order_release);
+        }
+        lastChild = child;
+
+        return child;
+    }
+
+    ThreadBlock *              parent{nullptr};
+    const char *               name{nullptr};
+    std::atomic<ThreadBlock *> firstChild{nullptr};
+    std::atomic<ThreadBlock *> next{nullptr};
+    ThreadBlock *              lastChild{nullptr};
+    utils::Timer               timer;
+    ThreadFrameSlot            slots[2];
+};
+
+struct ThreadCounter {
+    const char *          name{nullptr};
+    ObjectStatsType       type{ObjectStatsType::RENDER};
+    bool                  replace{false};
+    std::atomic<int64_t>  values[2]{};
+    std::atomic<uint32_t> written[2]{};
+};
+
+struct ThreadProfile {
+    explicit ThreadProfile(const char *name)
+    : name(name), root(nullptr, name), current(&root) {}
+
+    const char *                                     name{nullptr};
+    ThreadBlock                                      root;
+    ThreadBlock *                                    current{nullptr};
+    ccstd::array<ThreadCounter, MAX_THREAD_COUNTERS> counters;
+    std::atomic<uint32_t>                            counterCount{0U};
+};
+
+namespace {
+
+// tells profiles of a destroyed Profiler apart from those of the current one
+std::atomic<uint32_t> profilerSerial{0U};
+
+struct ThreadProfileRef {
+    ThreadProfile *profile{nullptr};
+    uint32_t       serial{0U};
+};
+
+thread_local ThreadProfileRef threadProfileRef;
+
+void mergeThreadBlock(ThreadBlock *block, ProfilerBlock *target, uint32_t slot) { //NOLINT(misc-no-recursion)
+    auto &frame = block->slots[slot];
+    target->merge(frame.time.exchange(0U, std::memory_order_relaxed),
+                  frame.count.exchange(0U, std::memory_order_relaxed),
+                  frame.max.exchange(0U, std::memory_order_relaxed));
+
+    for (auto *child = block->firstChild.load(std::memory_order_acquire); child; child = child->next.load(std::memory_order_acquire)) {
+        mergeThreadBlock(child, target->getOrCreateChild(child->name), slot);
+    }
+}
+
+FramePercentiles computePercentiles(const FrameHistory &history, float FrameSample::*member, ccstd::vector<float> &values) {
+    values.clear();
+    for (uint32_t i = 0; i < history.count; ++i) {
+        values.push_back(history.at(i).*member);
+    }
+    if (values.empty()) {
+        return {};
+    }
+
+    std::sort(values.begin(), values.end());
+    const auto percentile = [&](float p) {
+        return values[std::min(static_cast<size_t>(p * static_cast<float>(values.size())), values.size() - 1)];
+    };
+    return {percentile(0.5F), percentile(0.95F), percentile(0.99F)};
+}
+
+} // namespace
+
 /**
  * Profiler
  */
@@ -141,11 +282,19 @@ Profiler::Profiler() {
     _mainThreadId = std::this_thread::get_id();
     _root         = new ProfilerBlock(nullptr, "MainThread");
     _current      = _root;
+    _threadsRoot  = new ProfilerBlock(nullptr, "Threads");
+    _serial       = ++profilerSerial;
 }
 
 Profiler::~Profiler() {
     CC_SAFE_DELETE(_root);
     _current = nullptr;
+
+    CC_SAFE_DELETE(_threadsRoot);
+    for (auto *profile : _threadProfiles) {
+        delete profile;
+    }
+    _threadProfiles.clear();
 }
 
 void Profiler::setEnable(ShowOption option, bool b) {
@@ -163,11 +312,13 @@ bool Profiler::isEnabled(ShowOption option) const {
 }
 
 void Profiler::beginFrame() {
+    _traceRecorder.onFrameBegin();
     _objectStats.onFrameBegin();
 
     _current = _root;
     _root->onFrameBegin();
     _root->begin();
+    _threadsRoot->onFrameBegin();
 }
 
 void Profiler::endFrame() {
@@ -176,7 +327,83 @@ void Profiler::endFrame() {
     _root->end();
     _root->onFrameEnd();
 
+    mergeThreadProfiles();
+    _threadsRoot->onFrameEnd();
+
     _objectStats.onFrameEnd();
+    _traceRecorder.onFrameEnd();
+
+    recordFrame();
+}
+
+void Profiler::recordFrame() {
+    FrameSample sample;
+
+    // the sleep of the frame rate limit is part of the tick, but not work of the frame
+    uint64_t mainTime = _root->_item.time;
+    if (const auto *tick = _root->findChild("EngineTick")) {
+        if (const auto *sleep = tick->findChild("EngineSleep")) {
+            mainTime -= std::min(mainTime, sleep->_item.time);
+        }
+    }
+    sample.mainTime = static_cast<float>(mainTime) / 1000.0F;
+
+    if (const auto *agent = gfx::DeviceAgent::getInstance()) {
+        const auto &counters        = agent->getFrameCounters();
+        sample.renderTime           = agent->getFrameTimings().lastRenderTime;
+        sample.pipelineStateBinds   = counters.pipelineStateBinds;
+        sample.descriptorSetUpdates = counters.descriptorSetUpdates;
+        sample.uploads              = counters.uploads;
+        sample.uploadBytes          = counters.uploadBytes;
+    }
+    if (const auto *device = gfx::Device::getInstance()) {
+        sample.drawCalls = device->getNumDrawCalls();
+    }
+    auto *legacyPipeline = pipeline::RenderPipeline::getInstance();
+    if (legacyPipeline && legacyPipeline->isGPUTimingEnabled()) {
+        sample.gpuTime = legacyPipeline->getGPUTimer().getFrameTime();
+    }
+#if USE_MEMORY_LEAK_DETECTOR
+    const auto allocationCount = GMemoryHook.getAllocationCount();
+    sample.allocations         = static_cast<uint32_t>(allocationCount - _allocationCount);
+    _allocationCount           = allocationCount;
+#endif
+
+    _frameHistory.push(sample);
+
+    // the first frame loads the scene, it is not a hitch
+    if (_frameIndex > 0U && _frameBudget > 0.0F && sample.mainTime > _frameBudget) {
+        recordHitch(sample);
+    }
+    _frameIndex++;
+}
+
+void Profiler::recordHitch(const FrameSample &sample) {
+    HitchRecord record;
+    record.frame  = _frameIndex;
+    record.sample = sample;
+
+    std::vector<ProfilerBlockDepth> blocks;
+    for (auto *child : _root->_children) {
+        gatherBlocks(child, 0U, blocks);
+    }
+
+    ccstd::string tree;
+    for (const auto &iter : blocks) {
+        const auto &item = iter.block->_item;
+        if (item.count == 0U) { // not run in this frame
+            continue;
+        }
+
+        record.blocks.push_back({iter.block->_name, iter.depth, static_cast<float>(item.time) / 1000.0F, item.count});
+        tree += StringUtil::format("\n%s %.3fms x%u", StatsUtil::formatName(iter.depth, iter.block->_name).c_str(), static_cast<float>(item.time) / 1000.0F, item.count);
+    }
+    CC_LOG_WARNING("Profiler: frame %u took %.3fms, over the budget of %.3fms%s", record.frame, sample.mainTime, _frameBudget, tree.c_str());
+
+    if (_hitchRecords.size() >= MAX_HITCH_RECORDS) {
+        _hitchRecords.erase(_hitchRecords.begin());
+    }
+    _hitchRecords.push_back(std::move(record));
 }
 
 void Profiler::update() {
@@ -189,6 +416,7 @@ void Profiler::update() {
 
         doIntervalUpdate();
         _root->doIntervalUpdate();
+        _threadsRoot->doIntervalUpdate();
     }
 
     doFrameUpdate();
@@ -212,6 +440,31 @@ void Profiler::doIntervalUpdate() {
     _coreStats.shadowMap      = shadows != nullptr && shadows->isEnabled() && shadows->getType() == scene::ShadowType::SHADOW_MAP;
     _coreStats.screenWidth    = static_cast<uint32_t>(viewSize.x);
     _coreStats.screenHeight   = static_cast<uint32_t>(viewSize.y);
+
+    _gpuStats.frameTime = 0.0F;
+    _gpuStats.passes.clear();
+    auto *legacyPipeline = pipeline::RenderPipeline::getInstance();
+    if (legacyPipeline && legacyPipeline->isGPUTimingEnabled()) {
+        const auto &gpuTimer = legacyPipeline->getGPUTimer();
+        _gpuStats.frameTime  = gpuTimer.getFrameTime();
+        for (const auto &timing : gpuTimer.getTimings()) {
+            _gpuStats.passes.emplace_back(timing.name, timing.time);
+        }
+    }
+
+    ccstd::vector<float> values;
+    _frameStats.mainTime   = computePercentiles(_frameHistory, &FrameSample::mainTime, values);
+    _frameStats.renderTime = computePercentiles(_frameHistory, &FrameSample::renderTime, values);
+    _frameStats.gpuTime    = computePercentiles(_frameHistory, &FrameSample::gpuTime, values);
+
+    _bindingStats.items.clear();
+#if SCRIPT_ENGINE_TYPE == SCRIPT_ENGINE_V8
+    if (isEnabled(ShowOption::BINDING_STATS)) {
+        for (const auto &stat : getJSBInvokeStats(MAX_BINDING_STATS)) {
+            _bindingStats.items.push_back({stat.functionName, stat.count, stat.totalNs / 1000000.0F, stat.convertNs / 1000000.0F});
+        }
+    }
+#endif
 }
 
 void Profiler::doFrameUpdate() {
@@ -220,6 +473,10 @@ void Profiler::doFrameUpdate() {
     CC_PROFILE_RENDER_UPDATE(DrawCalls, device->getNumDrawCalls());
     CC_PROFILE_RENDER_UPDATE(Instances, device->getNumInstances());
     CC_PROFILE_RENDER_UPDATE(Triangles, device->getNumTris());
+    if (device->getNumStateCalls() || device->getNumSkippedStateCalls()) {
+        CC_PROFILE_RENDER_UPDATE(StateCalls, device->getNumStateCalls());
+        CC_PROFILE_RENDER_UPDATE(SkippedStateCalls, device->getNumSkippedStateCalls());
+    }
 
 #if USE_MEMORY_LEAK_DETECTOR
     CC_PROFILE_MEMORY_UPDATE(HeapMemory, GMemoryHook.getTotalSize());
@@ -336,6 +593,34 @@ void Profiler::printStats() {
             rightLines++;
         }
 
+#if CC_USE_MEMORY_ACCOUNTING
+        rightLines += 0.5F;
+        yOffset = lineHeight * rightLines;
+        renderer->addText("Subsystems", {memoryOffset, yOffset}, titleInfo);
+        renderer->addText("Current", {totalOffset, yOffset}, titleInfo);
+        renderer->addText("Peak", {countOffset, yOffset}, titleInfo);
+        renderer->addText("Budget", {totalMaxOffset, yOffset}, titleInfo);
+        rightLines++;
+
+        const auto &accounting = MemoryAccounting::getInstance();
+        for (uint32_t i = 0; i < MemoryAccounting::TAG_COUNT; ++i) {
+            const auto tag   = static_cast<MemoryTag>(i);
+            const auto usage = accounting.getUsage(tag);
+            if (!usage.peak && !usage.budget) {
+                continue;
+            }
+
+            const auto &info = usage.budget && usage.current > usage.budget ? coreInfo : textInfos[0];
+            yOffset          = lineHeight * rightLines;
+
+            renderer->addText(MemoryAccounting::getTagName(tag), {memoryOffset, yOffset}, info);
+            renderer->addText(StatsUtil::formatBytes(usage.current), {totalOffset, yOffset}, info);
+            renderer->addText(StatsUtil::formatBytes(usage.peak), {countOffset, yOffset}, info);
+            renderer->addText(usage.budget ? StatsUtil::formatBytes(usage.budget) : "-", {totalMaxOffset, yOffset}, info);
+            rightLines++;
+        }
+#endif
+
         rightLines += 0.5F;
     }
 
@@ -366,6 +651,9 @@ void Profiler::printStats() {
         for (auto *child : _root->_children) {
             gatherBlocks(child, 0U, blocks);
         }
+        for (auto *child : _threadsRoot->_children) {
+            gatherBlocks(child, 0U, blocks);
+        }
 
         uint32_t colorIndex = 0;
         for (auto &iter : blocks) {
@@ -391,12 +679,213 @@ void Profiler::printStats() {
 
         lines += 0.5F;
     }
+
+    if (isEnabled(ShowOption::GPU_STATS) && !_gpuStats.passes.empty()) {
+        float yOffset    = lineHeight * lines;
+        float timeOffset = columnWidth * 4;
+
+        renderer->addText("GPUStats", {leftOffset, yOffset}, titleInfo);
+        renderer->addText(StringUtil::format("%.3fms", _gpuStats.frameTime), {timeOffset, yOffset}, titleInfo);
+        lines++;
+
+        uint32_t colorIndex = 0;
+        for (auto &iter : _gpuStats.passes) {
+            yOffset = lineHeight * lines;
+
+            renderer->addText(StatsUtil::formatName(1U, iter.first), {leftOffset, yOffset}, textInfos[colorIndex]);
+            renderer->addText(StringUtil::format("%.3fms", iter.second), {timeOffset, yOffset}, textInfos[colorIndex]);
+            colorIndex = (colorIndex + 1) & 0x01;
+            lines++;
+        }
+
+        lines += 0.5F;
+    }
+
+    if (isEnabled(ShowOption::BINDING_STATS) && !_bindingStats.items.empty()) {
+        float yOffset       = lineHeight * lines;
+        float totalOffset   = columnWidth * 4;
+        float convertOffset = columnWidth * 5;
+        float countOffset   = columnWidth * 6;
+        float averageOffset = columnWidth * 7;
+
+        renderer->addText("BindingStats", {leftOffset, yOffset}, titleInfo);
+        renderer->addText("WholeTime", {totalOffset, yOffset}, titleInfo);
+        renderer->addText("ArgsTime", {convertOffset, yOffset}, titleInfo);
+        renderer->addText("Count", {countOffset, yOffset}, titleInfo);
+        renderer->addText("Average", {averageOffset, yOffset}, titleInfo);
+        lines++;
+
+        uint32_t colorIndex = 0;
+        for (const auto &item : _bindingStats.items) {
+            yOffset = lineHeight * lines;
+
+            renderer->addText(StatsUtil::formatName(1U, item.name), {leftOffset, yOffset}, textInfos[colorIndex]);
+            renderer->addText(StringUtil::format("%.3fms", item.totalTime), {totalOffset, yOffset}, textInfos[colorIndex]);
+            renderer->addText(StringUtil::format("%.3fms", item.convertTime), {convertOffset, yOffset}, textInfos[colorIndex]);
+            renderer->addText(StringUtil::format("%u", item.count), {countOffset, yOffset}, textInfos[colorIndex]);
+            renderer->addText(StringUtil::format("%.2fus", item.totalTime * 1000.0F / static_cast<float>(item.count)), {averageOffset, yOffset}, textInfos[colorIndex]);
+            colorIndex = (colorIndex + 1) & 0x01;
+            lines++;
+        }
+
+        lines += 0.5F;
+    }
+
+    if (isEnabled(ShowOption::FRAME_STATS) && _frameHistory.count > 0U) {
+        printFrameStats(lines);
+    }
 }
 
-void Profiler::beginBlock(const ccstd::string &name) {
+void Profiler::printFrameStats(float &lines) {
+    auto *      renderer    = CC_DEBUG_RENDERER;
+    const auto *window      = CC_CURRENT_ENGINE()->getInterface<ISystemWindow>();
+    const auto  viewSize    = window->getViewSize() * Device::getDevicePixelRatio();
+    const auto  width       = viewSize.x;
+    const auto  lineHeight  = static_cast<float>(renderer->getLineHeight());
+    const auto  columnWidth = width / 12.0F;
+    const auto  leftOffset  = width * 0.01F;
+
+    const gfx::Color mainColor{0.2F, 0.9F, 0.2F, 1.0F};
+    const gfx::Color renderColor{0.3F, 0.6F, 1.0F, 1.0F};
+    const gfx::Color gpuColor{1.0F, 0.6F, 0.1F, 1.0F};
+    const gfx::Color hitchColor{1.0F, 0.1F, 0.1F, 1.0F};
+
+    const DebugTextInfo titleInfo = {{1.0F, 1.0F, 0.0F, 1.0F}, true, false, true, 1U, {0.0F, 0.0F, 0.0F, 1.0F}, 1.0F};
+    const DebugTextInfo textInfo  = {{1.0F, 1.0F, 1.0F, 1.0F}, false, false, true, 1U, {0.0F, 0.0F, 0.0F, 1.0F}, 1.0F};
+    const auto          colored   = [&](const gfx::Color &color) {
+        DebugTextInfo info = textInfo;
+        info.color         = color;
+        return info;
+    };
+
+    // percentiles and the last frame of each timeline
+    float yOffset    = lineHeight * lines;
+    float p50Offset  = columnWidth * 4;
+    float p95Offset  = columnWidth * 5;
+    float p99Offset  = columnWidth * 6;
+    float lastOffset = columnWidth * 7;
+
+    renderer->addText("FrameStats", {leftOffset, yOffset}, titleInfo);
+    renderer->addText("P50", {p50Offset, yOffset}, titleInfo);
+    renderer->addText("P95", {p95Offset, yOffset}, titleInfo);
+    renderer->addText("P99", {p99Offset, yOffset}, titleInfo);
+    renderer->addText("Last", {lastOffset, yOffset}, titleInfo);
+    lines++;
+
+    const auto &last = _frameHistory.back();
+    const struct {
+        const char *            name;
+        const FramePercentiles &percentiles;
+        float                   lastTime;
+        gfx::Color              color;
+    } timelines[] = {
+        {"MainThread", _frameStats.mainTime, last.mainTime, mainColor},
+        {"RenderThread", _frameStats.renderTime, last.renderTime, renderColor},
+        {"GPU", _frameStats.gpuTime, last.gpuTime, gpuColor},
+    };
+    for (const auto &timeline : timelines) {
+        const auto info = colored(timeline.color);
+        yOffset         = lineHeight * lines;
+
+        renderer->addText(StatsUtil::formatName(1U, timeline.name), {leftOffset, yOffset}, info);
+        renderer->addText(StringUtil::format("%.2fms", timeline.percentiles.p50), {p50Offset, yOffset}, info);
+        renderer->addText(StringUtil::format("%.2fms", timeline.percentiles.p95), {p95Offset, yOffset}, info);
+        renderer->addText(StringUtil::format("%.2fms", timeline.percentiles.p99), {p99Offset, yOffset}, info);
+        renderer->addText(StringUtil::format("%.2fms", timeline.lastTime), {lastOffset, yOffset}, info);
+        lines++;
+    }
+
+    // counters of the last frame
+    yOffset = lineHeight * lines;
+    renderer->addText(StringUtil::format("DrawCalls: %u    "
+                                         "PipelineStateBinds: %u    "
+                                         "DescriptorSetUpdates: %u    "
+                                         "Uploads: %u (%s)    "
+                                         "Allocations: %u",
+                                         last.drawCalls,
+                                         last.pipelineStateBinds,
+                                         last.descriptorSetUpdates,
+                                         last.uploads,
+                                         StatsUtil::formatBytes(last.uploadBytes).c_str(),
+                                         last.allocations),
+                      {leftOffset, yOffset}, textInfo);
+    lines += 1.5F;
+
+    // frame time graph, the newest frame on the right, main thread bars are red when over budget
+    const Vec4 graph{leftOffset, lineHeight * lines, columnWidth * 6, lineHeight * 6};
+    float      scale = _frameBudget * 1.5F;
+    for (uint32_t i = 0; i < _frameHistory.count; ++i) {
+        const auto &sample = _frameHistory.at(i);
+        scale              = std::max(scale, std::max(sample.mainTime, std::max(sample.renderTime, sample.gpuTime)));
+    }
+    const auto heightOf = [&](float time) { return scale > 0.0F ? graph.w * std::min(time / scale, 1.0F) : 0.0F; };
+    const auto barWidth = graph.z / static_cast<float>(FrameHistory::SIZE);
+    const auto bottom   = graph.y + graph.w;
+
+    renderer->addRect(graph, {0.0F, 0.0F, 0.0F, 0.5F});
+    for (uint32_t i = 0; i < _frameHistory.count; ++i) {
+        const auto &sample = _frameHistory.at(i);
+        const auto  x      = graph.x + graph.z - static_cast<float>(_frameHistory.count - i) * barWidth;
+        const auto  height = heightOf(sample.mainTime);
+
+        renderer->addRect({x, bottom - height, barWidth, height}, sample.mainTime > _frameBudget ? hitchColor : mainColor);
+        if (sample.renderTime > 0.0F) {
+            renderer->addRect({x, bottom - heightOf(sample.renderTime) - 1.0F, barWidth, 2.0F}, renderColor);
+        }
+        if (sample.gpuTime > 0.0F) {
+            renderer->addRect({x, bottom - heightOf(sample.gpuTime) - 1.0F, barWidth, 2.0F}, gpuColor);
+        }
+    }
+    if (_frameBudget > 0.0F) {
+        renderer->addRect({graph.x, bottom - heightOf(_frameBudget), graph.z, 1.0F}, {1.0F, 1.0F, 1.0F, 0.8F});
+        renderer->addText(StringUtil::format("%.1fms", _frameBudget), {graph.x + graph.z + 4.0F, bottom - heightOf(_frameBudget) - lineHeight * 0.5F}, textInfo);
+    }
+    renderer->addText(StringUtil::format("%.1fms", scale), {graph.x + graph.z + 4.0F, graph.y}, textInfo);
+    lines += 6.5F;
+
+    if (_hitchRecords.empty()) {
+        return;
+    }
+
+    // the frames over budget, and the blocks of the latest one
+    yOffset = lineHeight * lines;
+    renderer->addText("Hitches", {leftOffset, yOffset}, titleInfo);
+    renderer->addText("Main", {p50Offset, yOffset}, titleInfo);
+    renderer->addText("Render", {p95Offset, yOffset}, titleInfo);
+    renderer->addText("GPU", {p99Offset, yOffset}, titleInfo);
+    lines++;
+
+    for (const auto &record : _hitchRecords) {
+        yOffset = lineHeight * lines;
+
+        renderer->addText(StatsUtil::formatName(1U, StringUtil::format("Frame %u", record.frame)), {leftOffset, yOffset}, textInfo);
+        renderer->addText(StringUtil::format("%.2fms", record.sample.mainTime), {p50Offset, yOffset}, colored(hitchColor));
+        renderer->addText(StringUtil::format("%.2fms", record.sample.renderTime), {p95Offset, yOffset}, textInfo);
+        renderer->addText(StringUtil::format("%.2fms", record.sample.gpuTime), {p99Offset, yOffset}, textInfo);
+        lines++;
+    }
+
+    const auto &blocks = _hitchRecords.back().blocks;
+    for (uint32_t i = 0; i < blocks.size() && i < MAX_HITCH_BLOCK_LINES; ++i) {
+        const auto &block = blocks[i];
+        yOffset           = lineHeight * lines;
+
+        renderer->addText(StatsUtil::formatName(block.depth + 2U, block.name), {leftOffset, yOffset}, textInfo);
+        renderer->addText(StringUtil::format("%.3fms", block.time), {p50Offset, yOffset}, textInfo);
+        renderer->addText(StringUtil::format("%u", block.count), {p95Offset, yOffset}, textInfo);
+        lines++;
+    }
+
+    lines += 0.5F;
+}
+
+void Profiler::beginBlock(const char *name) {
+    _traceRecorder.begin(name);
     if (isMainThread()) {
         _current = _current->getOrCreateChild(name);
         _current->begin();
+    } else {
+        beginThreadBlock(name);
     }
 }
 
@@ -404,6 +893,117 @@ void Profiler::endBlock() {
     if (isMainThread()) {
         _current->end();
         _current = _current->_parent;
+    } else {
+        endThreadBlock();
+    }
+    _traceRecorder.end();
+}
+
+ThreadProfile *Profiler::getThreadProfile() {
+    auto &ref = threadProfileRef;
+    if (ref.profile && ref.serial == _serial) {
+        return ref.profile;
+    }
+
+    const char *name = ThreadAffinity::getCurrentThreadName();
+    auto *      profile = new ThreadProfile(name && name[0] != '\0' ? name : "Workers");
+    {
+        std::lock_guard<std::mutex> lock(_threadProfilesMutex);
+        _threadProfiles.push_back(profile);
+    }
+
+    ref.profile = profile;
+    ref.serial  = _serial;
+    return profile;
+}
+
+void Profiler::beginThreadBlock(const char *name) {
+    auto *profile    = getThreadProfile();
+    profile->current = profile->current->getOrCreateChild(name);
+    profile->current->timer.reset();
+}
+
+void Profiler::endThreadBlock() {
+    auto *profile = getThreadProfile();
+    auto *block   = profile->current;
+    if (!block->parent) {
+        return;
+    }
+
+    const auto elapsed = static_cast<uint64_t>(block->timer.getMicroseconds());
+    auto &     frame   = block->slots[_frameParity.load(std::memory_order_relaxed)];
+    relaxedAdd(frame.time, elapsed);
+    relaxedAdd(frame.count, 1U);
+    if (elapsed > frame.max.load(std::memory_order_relaxed)) {
+        frame.max.store(elapsed, std::memory_order_relaxed);
+    }
+
+    profile->current = block->parent;
+}
+
+void Profiler::addThreadCounter(ObjectStatsType type, const char *name, int64_t value, bool replace) {
+    auto *         profile = getThreadProfile();
+    ThreadCounter *counter = nullptr;
+
+    const auto count = profile->counterCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto &item = profile->counters[i];
+        if (item.type == type && strcmp(item.name, name) == 0) {
+            counter = &item;
+            break;
+        }
+    }
+
+    if (!counter) {
+        if (count >= MAX_THREAD_COUNTERS) {
+            return;
+        }
+        counter          = &profile->counters[count];
+        counter->name    = name;
+        counter->type    = type;
+        counter->replace = replace;
+        profile->counterCount.store(count + 1U, std::memory_order_release);
+    }
+
+    const auto slot = _frameParity.load(std::memory_order_relaxed);
+    if (replace) {
+        counter->values[slot].store(value, std::memory_order_relaxed);
+    } else {
+        relaxedAdd(counter->values[slot], value);
+    }
+    counter->written[slot].store(1U, std::memory_order_release);
+}
+
+void Profiler::mergeThreadProfiles() {
+    // the other threads move on to the other slot, what they recorded during this frame can be read now
+    const auto slot = _frameParity.load(std::memory_order_relaxed);
+    _frameParity.store(slot ^ 1U, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(_threadProfilesMutex);
+    for (auto *profile : _threadProfiles) {
+        auto *target = _threadsRoot->getOrCreateChild(profile->name);
+        for (auto *child = profile->root.firstChild.load(std::memory_order_acquire); child; child = child->next.load(std::memory_order_acquire)) {
+            mergeThreadBlock(child, target->getOrCreateChild(child->name), slot);
+        }
+
+        const auto count = profile->counterCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto &counter = profile->counters[i];
+            if (!counter.written[slot].exchange(0U, std::memory_order_acquire)) {
+                continue;
+            }
+
+            const auto value = counter.values[slot].exchange(0, std::memory_order_relaxed);
+            auto &     stats = counter.type == ObjectStatsType::RENDER ? _objectStats.renders : _objectStats.objects;
+            auto &     item  = stats[counter.name];
+            if (counter.replace) {
+                item = static_cast<uint32_t>(value);
+            } else if (value >= 0) {
+                item += static_cast<uint32_t>(value);
+            } else {
+                item -= static_cast<uint32_t>(-value);
+            }
+        }
     }
 }
 
@@ -24,8 +24,11 @@
  ****************************************************************************/
 
 #pragma once
+#include <atomic>
+#include <mutex>
 #include <thread>
 #include "GameStats.h"
+#include "TraceRecorder.h"
 #include "base/Config.h"
 #include "base/Timer.h"
 #include "gfx-base/GFXDef-common.h"
@@ -34,17 +37,29 @@ namespace cc {
 
 class ProfilerBlock;
 struct ProfilerBlockDepth;
+struct ThreadProfile;
 
 enum class ShowOption : uint32_t {
     CORE_STATS        = 0x01,
     MEMORY_STATS      = 0x02,
     OBJECT_STATS      = 0x04,
     PERFORMANCE_STATS = 0x08,
-    ALL               = CORE_STATS | MEMORY_STATS | OBJECT_STATS | PERFORMANCE_STATS,
+    GPU_STATS         = 0x10,
+    BINDING_STATS     = 0x20, // needs RECORD_JSB_INVOKING in jswrapper/v8/HelperMacros.h
+    FRAME_STATS       = 0x40, // frame time graph, percentiles, per frame counters and hitches
+    ALL               = CORE_STATS | MEMORY_STATS | OBJECT_STATS | PERFORMANCE_STATS | GPU_STATS | BINDING_STATS | FRAME_STATS,
+};
+
+enum class ObjectStatsType : uint8_t {
+    RENDER,
+    OBJECT,
 };
 
 /**
  * Profiler
+ * CC_PROFILE blocks and render/object counters can be used on any thread. Threads other than the main one record into
+ * their own storage without locks or atomic read-modify-writes, which is merged into the stats at the end of each frame
+ * under the name the thread got from ThreadAffinity.
  */
 class Profiler {
 public:
@@ -66,6 +81,29 @@ public:
     inline bool         isMainThread() const { return _mainThreadId == std::this_thread::get_id(); }
     inline MemoryStats &getMemoryStats() { return _memoryStats; }
     inline ObjectStats &getObjectStats() { return _objectStats; }
+    // GPU timings of the legacy pipeline, refreshed every interval while its GPU timing is enabled
+    inline const GPUStats &getGPUStats() const { return _gpuStats; }
+    // script binding call stats, refreshed every interval while BINDING_STATS is enabled
+    inline const BindingStats &getBindingStats() const { return _bindingStats; }
+    // timeline capture of the CC_PROFILE blocks of all threads
+    inline TraceRecorder &getTraceRecorder() { return _traceRecorder; }
+    // samples of the last FrameHistory::SIZE frames, and their percentiles refreshed every interval
+    inline const FrameHistory &getFrameHistory() const { return _frameHistory; }
+    inline const FrameStats &  getFrameStats() const { return _frameStats; }
+    // the last MAX_HITCH_RECORDS frames whose main thread time went over the frame budget, oldest first
+    inline const ccstd::vector<HitchRecord> &getHitchRecords() const { return _hitchRecords; }
+
+    /**
+     * @en Main thread time in milliseconds above which a frame is logged as a hitch with its profiler blocks, 0 disables it.
+     * @zh 主线程耗时超过该值（毫秒）的帧会连同其 profiler 块一起记录为卡顿，0 表示禁用。
+     */
+    inline void  setFrameBudget(float milliseconds) { _frameBudget = milliseconds; }
+    inline float getFrameBudget() const { return _frameBudget; }
+
+    static constexpr uint32_t MAX_HITCH_RECORDS = 8U;
+
+    // counters of threads other than the main one, added to the object stats at frame end
+    void addThreadCounter(ObjectStatsType type, const char *name, int64_t value, bool replace);
 
 private:
     Profiler();
@@ -74,21 +112,48 @@ private:
     void        doIntervalUpdate();
     static void doFrameUpdate();
     void        printStats();
+    void        printFrameStats(float &lines);
+
+    void recordFrame();
+    void recordHitch(const FrameSample &sample);
 
-    void beginBlock(const ccstd::string &name);
+    void beginBlock(const char *name);
     void endBlock();
     void gatherBlocks(ProfilerBlock *parent, uint32_t depth, std::vector<ProfilerBlockDepth> &outBlocks);
 
+    ThreadProfile *getThreadProfile();
+    void           beginThreadBlock(const char *name);
+    void           endThreadBlock();
+    void           mergeThreadProfiles();
+
     static Profiler *instance;
     uint32_t         _options{static_cast<uint32_t>(ShowOption::ALL)};
     utils::Timer     _timer;
     CoreStats        _coreStats;
     MemoryStats      _memoryStats;
     ObjectStats      _objectStats;
+    GPUStats         _gpuStats;
+    BindingStats     _bindingStats;
+    TraceRecorder    _traceRecorder;
+    FrameHistory     _frameHistory;
+    FrameStats       _frameStats;
     ProfilerBlock *  _root{nullptr};
     ProfilerBlock *  _current{nullptr};
     std::thread::id  _mainThreadId;
 
+    // merged blocks of the other threads, one child per thread name
+    ProfilerBlock *               _threadsRoot{nullptr};
+    ccstd::vector<ThreadProfile *> _threadProfiles;
+    std::mutex                    _threadProfilesMutex;
+    // which of the two frame slots the other threads record into
+    std::atomic<uint32_t> _frameParity{0};
+    uint32_t              _serial{0};
+
+    ccstd::vector<HitchRecord> _hitchRecords;
+    float                      _frameBudget{1000.0F / 30.0F};
+    uint32_t                   _frameIndex{0U};
+    uint64_t                   _allocationCount{0U}; // allocation count of the memory hook at the last frame end
+
     friend class AutoProfiler;
 };
 
@@ -97,7 +162,7 @@ private:
  */
 class AutoProfiler {
 public:
-    AutoProfiler(Profiler *profiler, const ccstd::string &name)
+    AutoProfiler(Profiler *profiler, const char *name)
     : _profiler(profiler) {
         _profiler->beginBlock(name);
     }
@@ -123,33 +188,46 @@ private:
     #define CC_PROFILER_UPDATE                    CC_PROFILER->update()
     #define CC_PROFILER_BEGIN_FRAME               CC_PROFILER->beginFrame()
     #define CC_PROFILER_END_FRAME                 CC_PROFILER->endFrame()
+    #define CC_PROFILER_TRACE(frames, path)       CC_PROFILER->getTraceRecorder().startCapture((frames), (path))
     #define CC_PROFILE(name)                      cc::AutoProfiler auto_profiler_##name(CC_PROFILER, #name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count) CC_PROFILER->getMemoryStats().update(#name, (count))
     #define CC_PROFILE_MEMORY_INC(name, count)    CC_PROFILER->getMemoryStats().inc(#name, (count))
     #define CC_PROFILE_MEMORY_DEC(name, count)    CC_PROFILER->getMemoryStats().dec(#name, (count))
-    #define CC_PROFILE_RENDER_UPDATE(name, count)                   \
-        if (CC_PROFILER->isMainThread()) {                          \
-            CC_PROFILER->getObjectStats().renders[#name] = (count); \
+    #define CC_PROFILE_RENDER_UPDATE(name, count)                                                                 \
+        if (CC_PROFILER->isMainThread()) {                                                                        \
+            CC_PROFILER->getObjectStats().renders[#name] = (count);                                               \
+        } else {                                                                                                  \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::RENDER, #name, static_cast<int64_t>(count), true); \
         }
-    #define CC_PROFILE_RENDER_INC(name, count)                       \
-        if (CC_PROFILER->isMainThread()) {                           \
-            CC_PROFILER->getObjectStats().renders[#name] += (count); \
+    #define CC_PROFILE_RENDER_INC(name, count)                                                                     \
+        if (CC_PROFILER->isMainThread()) {                                                                         \
+            CC_PROFILER->getObjectStats().renders[#name] += (count);                                               \
+        } else {                                                                                                   \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::RENDER, #name, static_cast<int64_t>(count), false); \
         }
-    #define CC_PROFILE_RENDER_DEC(name, count)                       \
-        if (CC_PROFILER->isMainThread()) {                           \
-            CC_PROFILER->getObjectStats().renders[#name] -= (count); \
+    #define CC_PROFILE_RENDER_DEC(name, count)                                                                      \
+        if (CC_PROFILER->isMainThread()) {                                                                          \
+            CC_PROFILER->getObjectStats().renders[#name] -= (count);                                                \
+        } else {                                                                                                    \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::RENDER, #name, -static_cast<int64_t>(count), false); \
         }
-    #define CC_PROFILE_OBJECT_UPDATE(name, count)                   \
-        if (CC_PROFILER->isMainThread()) {                          \
-            CC_PROFILER->getObjectStats().objects[#name] = (count); \
+    #define CC_PROFILE_OBJECT_UPDATE(name, count)                                                                 \
+        if (CC_PROFILER->isMainThread()) {                                                                        \
+            CC_PROFILER->getObjectStats().objects[#name] = (count);                                               \
+        } else {                                                                                                  \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::OBJECT, #name, static_cast<int64_t>(count), true); \
         }
-    #define CC_PROFILE_OBJECT_INC(name, count)                      \
-        if (CC_PROFILER->isMainThread()) {                          \
-            C_PROFILER->getObjectStats().objects[#name] += (count); \
+    #define CC_PROFILE_OBJECT_INC(name, count)                                                                     \
+        if (CC_PROFILER->isMainThread()) {                                                                         \
+            CC_PROFILER->getObjectStats().objects[#name] += (count);                                               \
+        } else {                                                                                                   \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::OBJECT, #name, static_cast<int64_t>(count), false); \
         }
-    #define CC_PROFILE_OBJECT_DEC(name, count)                       \
-        if (CC_PROFILER->isMainThread()) {                           \
-            CC_PROFILER->getObjectStats().objects[#name] -= (count); \
+    #define CC_PROFILE_OBJECT_DEC(name, count)                                                                      \
+        if (CC_PROFILER->isMainThread()) {                                                                          \
+            CC_PROFILER->getObjectStats().objects[#name] -= (count);                                                \
+        } else {                                                                                                    \
+            CC_PROFILER->addThreadCounter(cc::ObjectStatsType::OBJECT, #name, -static_cast<int64_t>(count), false); \
         }
 #else
     #define CC_PROFILER
@@ -159,6 +237,7 @@ private:
     #define CC_PROFILER_UPDATE
     #define CC_PROFILER_BEGIN_FRAME
     #define CC_PROFILER_END_FRAME
+    #define CC_PROFILER_TRACE(frames, path)
     #define CC_PROFILE(name)
     #define CC_PROFILE_MEMORY_UPDATE(name, count)
     #define CC_PROFILE_MEMORY_INC(name, count)
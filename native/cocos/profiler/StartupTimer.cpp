@@ -0,0 +1,125 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "profiler/StartupTimer.h"
+#include <chrono>
+#include <mutex>
+#include "base/StringUtil.h"
+
+namespace cc {
+
+namespace {
+
+struct StartupState {
+    std::mutex                  mutex;
+    ccstd::vector<StartupPhase> phases;
+    ccstd::vector<size_t>       open; // indices of the phases which haven't ended
+    uint64_t                    firstFrameNS{0};
+};
+
+StartupState &getState() {
+    static StartupState state;
+    return state;
+}
+
+std::chrono::steady_clock::time_point getLoadTime() {
+    static const auto LOAD_TIME = std::chrono::steady_clock::now();
+    return LOAD_TIME;
+}
+
+// takes the load time during static initialization instead of at the first phase
+const auto LOAD_TIME_INIT = getLoadTime();
+
+float toMS(uint64_t ns) {
+    return static_cast<float>(ns) / 1e6F;
+}
+
+} // namespace
+
+uint64_t StartupTimer::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - getLoadTime()).count());
+}
+
+void StartupTimer::begin(const char *name) {
+    auto &state = getState();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    StartupPhase phase;
+    phase.name    = name;
+    phase.depth   = static_cast<uint32_t>(state.open.size());
+    phase.beginNS = now();
+    state.open.push_back(state.phases.size());
+    state.phases.push_back(phase);
+}
+
+void StartupTimer::end() {
+    auto &state = getState();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    CC_ASSERT(!state.open.empty());
+    if (state.open.empty()) {
+        return;
+    }
+    auto &phase      = state.phases[state.open.back()];
+    phase.durationNS = now() - phase.beginNS;
+    state.open.pop_back();
+}
+
+void StartupTimer::markFirstFrame() {
+    auto &state = getState();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.firstFrameNS) {
+        state.firstFrameNS = now();
+    }
+}
+
+uint64_t StartupTimer::getFirstFrameNS() {
+    auto &state = getState();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.firstFrameNS;
+}
+
+ccstd::vector<StartupPhase> StartupTimer::getPhases() {
+    auto &state = getState();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.phases;
+}
+
+ccstd::string StartupTimer::toJSON() {
+    const auto    phases = getPhases();
+    ccstd::string out    = StringUtil::format(R"({"firstFrame":%.3f,"phases":[)", toMS(getFirstFrameNS()));
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const auto &phase = phases[i];
+        out += StringUtil::format(R"(%s{"name":"%s","depth":%u,"begin":%.3f,"duration":%.3f})",
+                                  i ? "," : "", phase.name, phase.depth, toMS(phase.beginNS), toMS(phase.durationNS));
+    }
+    out += "]}";
+    return out;
+}
+
+} // namespace cc
@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+struct StartupPhase {
+    const char *name{nullptr};
+    uint32_t    depth{0};   // count of the phases still open when it began
+    uint64_t    beginNS{0}; // since the engine library was loaded
+    uint64_t    durationNS{0};
+};
+
+/**
+ * Times the phases of the engine startup up to the first frame, to break the cold start time down.
+ * Subsystems which initialize on first use record their phase when that happens, which may be after the first frame.
+ * Phases are recorded on the main thread.
+ */
+class CC_DLL StartupTimer final {
+public:
+    // names are not copied and must stay valid
+    static void begin(const char *name);
+    static void end();
+    // called by the engine at the end of its first frame, only the first call counts
+    static void markFirstFrame();
+
+    static uint64_t                    getFirstFrameNS(); // 0 before the first frame
+    static ccstd::vector<StartupPhase> getPhases();
+    // {"firstFrame":<ms>,"phases":[{"name":<name>,"depth":<depth>,"begin":<ms>,"duration":<ms>}, ...]}
+    static ccstd::string toJSON();
+
+private:
+    static uint64_t now();
+};
+
+class StartupPhaseScope final {
+public:
+    explicit StartupPhaseScope(const char *name) { StartupTimer::begin(name); }
+    ~StartupPhaseScope() { StartupTimer::end(); }
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(StartupPhaseScope)
+};
+
+} // namespace cc
+
+#define CC_STARTUP_PHASE(name) cc::StartupPhaseScope startup_phase_##name(#name)
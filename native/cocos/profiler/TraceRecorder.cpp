@@ -0,0 +1,266 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "base/Log.h"
+#include "base/StringUtil.h"
+#include "base/std/container/array.h"
+#include "base/threading/ThreadAffinity.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+
+class TraceTrack final {
+public:
+    TraceTrack(ccstd::string name, uint32_t id)
+    : _name(std::move(name)), _id(id), _events(TraceRecorder::EVENTS_PER_THREAD) {}
+
+    // only called by the thread the track belongs to
+    inline void push(const TraceEvent &event) {
+        const uint64_t written                  = _written.load(std::memory_order_relaxed);
+        _events[written & (_events.size() - 1)] = event;
+        _written.store(written + 1, std::memory_order_release);
+    }
+
+    inline void reset() { _written.store(0, std::memory_order_relaxed); }
+
+private:
+    ccstd::string             _name;
+    uint32_t                  _id{0};
+    ccstd::vector<TraceEvent> _events;
+    std::atomic<uint64_t>     _written{0};
+
+    friend class TraceRecorder;
+};
+
+namespace {
+
+static_assert((TraceRecorder::EVENTS_PER_THREAD & (TraceRecorder::EVENTS_PER_THREAD - 1)) == 0, "the ring size must be a power of two");
+
+std::atomic<uint32_t> recorderSerial{0};
+
+struct OpenBlock {
+    const char *name{nullptr};
+    uint64_t    beginNS{0};
+    // the capture the block began in, 0 if none was running
+    uint32_t capture{0};
+};
+
+// blocks are tracked even while not capturing, so a capture starting or stopping in the middle of a block never mismatches them
+struct ThreadState {
+    ccstd::array<OpenBlock, TraceRecorder::MAX_DEPTH> blocks;
+    uint32_t                                          depth{0};
+    TraceTrack *                                      track{nullptr};
+    uint32_t                                          serial{0};
+};
+
+thread_local ThreadState threadState;
+
+void appendJsonString(ccstd::string &out, const char *str) {
+    out += '"';
+    for (const char *c = str; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if (static_cast<unsigned char>(*c) >= 0x20) {
+            out += *c;
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+TraceRecorder::TraceRecorder()
+: _serial(++recorderSerial) {}
+
+TraceRecorder::~TraceRecorder() = default;
+
+uint64_t TraceRecorder::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void TraceRecorder::startCapture(uint32_t frameCount, const ccstd::string &outputPath) {
+    stopCapture();
+    _frameCount   = frameCount;
+    _outputPath   = outputPath;
+    _startPending = true;
+}
+
+void TraceRecorder::stopCapture() {
+    _startPending = false;
+    if (!isCapturing()) {
+        return;
+    }
+
+    _capturing.store(false, std::memory_order_release);
+    _captureEndNS = now();
+    CC_LOG_INFO("Trace captured: %u frames, %.3f ms", _capturedFrames, static_cast<double>(_captureEndNS - _captureBeginNS) / 1e6);
+    if (!_outputPath.empty()) {
+        writeChromeTrace(_outputPath);
+    }
+}
+
+void TraceRecorder::onFrameBegin() {
+    if (_startPending) {
+        _startPending = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto &track : _tracks) {
+                track->reset();
+            }
+        }
+        _capturedFrames = 0;
+        _captureBeginNS = now();
+        _captureEndNS   = 0;
+        _capture.fetch_add(1, std::memory_order_relaxed);
+        _capturing.store(true, std::memory_order_release);
+    }
+    begin("Frame");
+}
+
+void TraceRecorder::onFrameEnd() {
+    end();
+    if (isCapturing() && ++_capturedFrames == _frameCount) {
+        stopCapture();
+    }
+}
+
+void TraceRecorder::begin(const char *name) {
+    auto &state = threadState;
+    if (state.depth < MAX_DEPTH) {
+        auto &block   = state.blocks[state.depth];
+        block.name    = name;
+        block.capture = isCapturing() ? _capture.load(std::memory_order_relaxed) : 0;
+        block.beginNS = block.capture ? now() : 0;
+    }
+    ++state.depth;
+}
+
+void TraceRecorder::end() {
+    auto &state = threadState;
+    if (state.depth == 0) {
+        return;
+    }
+
+    --state.depth;
+    if (state.depth >= MAX_DEPTH) {
+        return;
+    }
+    const auto &block = state.blocks[state.depth];
+    if (block.capture == 0 || !isCapturing() || block.capture != _capture.load(std::memory_order_relaxed)) {
+        return;
+    }
+    getTrack()->push({block.name, block.beginNS, now() - block.beginNS});
+}
+
+void TraceRecorder::addGPUEvent(const char *name, uint64_t beginNS, uint64_t durationNS) {
+    // frames recorded before the capture began are still read back during its first frames
+    if (!isCapturing() || beginNS < _captureBeginNS) {
+        return;
+    }
+
+    if (!_gpuTrack) {
+        _gpuTrack = createTrack("GPU");
+    }
+    _gpuTrack->push({name, beginNS, durationNS});
+}
+
+TraceTrack *TraceRecorder::getTrack() {
+    auto &state = threadState;
+    if (state.serial != _serial) {
+        const char *name = ThreadAffinity::getCurrentThreadName();
+        state.track      = createTrack(name ? name : "");
+        state.serial     = _serial;
+    }
+    return state.track;
+}
+
+TraceTrack *TraceRecorder::createTrack(const char *name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto id = static_cast<uint32_t>(_tracks.size()) + 1;
+    if (*name) {
+        _tracks.push_back(std::make_unique<TraceTrack>(name, id));
+    } else {
+        _tracks.push_back(std::make_unique<TraceTrack>(StringUtil::format("Thread %u", id), id));
+    }
+    return _tracks.back().get();
+}
+
+ccstd::string TraceRecorder::toChromeTrace() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ccstd::string out;
+    out.reserve(1024 * 1024);
+    out += R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+    char buffer[160];
+    bool first = true;
+    for (const auto &track : _tracks) {
+        snprintf(buffer, sizeof(buffer), R"(%s{"name":"thread_name","ph":"M","pid":1,"tid":%u,"args":{"name":)", first ? "" : ",", track->_id);
+        out += buffer;
+        appendJsonString(out, track->_name.c_str());
+        snprintf(buffer, sizeof(buffer), R"(}},{"name":"thread_sort_index","ph":"M","pid":1,"tid":%u,"args":{"sort_index":%u}})", track->_id, track->_id);
+        out += buffer;
+        first = false;
+
+        // when the ring wrapped around, a write that began before the capture stopped may still be replacing the oldest event
+        const uint64_t written = track->_written.load(std::memory_order_acquire);
+        const uint64_t size    = track->_events.size();
+        const uint64_t oldest  = written > size ? written - size + 1 : 0;
+        for (uint64_t i = oldest; i < written; ++i) {
+            const auto &event = track->_events[i & (size - 1)];
+            if (event.beginNS < _captureBeginNS) {
+                continue;
+            }
+            out += R"(,{"name":)";
+            appendJsonString(out, event.name);
+            snprintf(buffer, sizeof(buffer), R"(,"ph":"X","pid":1,"tid":%u,"ts":%.3f,"dur":%.3f})",
+                     track->_id, static_cast<double>(event.beginNS - _captureBeginNS) / 1e3, static_cast<double>(event.durationNS) / 1e3);
+            out += buffer;
+        }
+    }
+
+    out += "]}";
+    return out;
+}
+
+bool TraceRecorder::writeChromeTrace(const ccstd::string &path) const {
+    auto *     fileUtils = FileUtils::getInstance();
+    const auto fullPath  = fileUtils->isAbsolutePath(path) ? path : fileUtils->getWritablePath() + path;
+    const bool succeeded = fileUtils->writeStringToFile(toChromeTrace(), fullPath);
+    if (succeeded) {
+        CC_LOG_INFO("Trace written to %s", fullPath.c_str());
+    } else {
+        CC_LOG_ERROR("Failed to write the trace to %s", fullPath.c_str());
+    }
+    return succeeded;
+}
+
+} // namespace cc
@@ -0,0 +1,104 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+
+struct TraceEvent {
+    const char *name{nullptr};
+    uint64_t    beginNS{0};
+    uint64_t    durationNS{0};
+};
+
+class TraceTrack;
+
+/**
+ * Records the CC_PROFILE blocks of every thread on one timeline, together with the GPU timings of the legacy pipeline,
+ * and writes them as Chrome trace JSON, which chrome://tracing and ui.perfetto.dev open.
+ * Each thread writes into its own ring buffer without taking a lock, once it is full the oldest events are overwritten.
+ */
+class CC_DLL TraceRecorder final {
+public:
+    static constexpr uint32_t EVENTS_PER_THREAD{1U << 16U};
+    static constexpr uint32_t MAX_DEPTH{64};
+
+    TraceRecorder();
+    ~TraceRecorder();
+    TraceRecorder(const TraceRecorder &) = delete;
+    TraceRecorder(TraceRecorder &&)      = delete;
+    TraceRecorder &operator=(const TraceRecorder &) = delete;
+    TraceRecorder &operator=(TraceRecorder &&) = delete;
+
+    // starts with the next frame and stops by itself after frameCount frames, 0 records until stopCapture,
+    // the capture is written to outputPath when it stops if one is given
+    void        startCapture(uint32_t frameCount = 0, const ccstd::string &outputPath = "");
+    void        stopCapture();
+    inline bool isCapturing() const { return _capturing.load(std::memory_order_relaxed); }
+
+    // called on the main thread by the profiler
+    void onFrameBegin();
+    void onFrameEnd();
+
+    // names are not copied and must stay valid until the capture is written
+    void begin(const char *name);
+    void end();
+    // a GPU scope that is read back frames later, placed at the CPU time its frame was recorded, main thread only
+    void addGPUEvent(const char *name, uint64_t beginNS, uint64_t durationNS);
+
+    // nanoseconds on the clock events are recorded with
+    static uint64_t now();
+
+    ccstd::string toChromeTrace() const;
+    // relative paths are put in the writable path
+    bool writeChromeTrace(const ccstd::string &path) const;
+
+private:
+    TraceTrack *getTrack();
+    TraceTrack *createTrack(const char *name);
+
+    mutable std::mutex                         _mutex;
+    ccstd::vector<std::unique_ptr<TraceTrack>> _tracks;
+    TraceTrack *                               _gpuTrack{nullptr};
+    ccstd::string                              _outputPath;
+    uint64_t                                   _captureBeginNS{0};
+    uint64_t                                   _captureEndNS{0};
+    uint32_t                                   _serial{0};
+    uint32_t                                   _frameCount{0};
+    uint32_t                                   _capturedFrames{0};
+    std::atomic<uint32_t>                      _capture{0};
+    std::atomic<bool>                          _capturing{false};
+    bool                                       _startPending{false};
+};
+
+} // namespace cc
@@ -30,6 +30,7 @@
 
 #include "gfx-agent/DeviceAgent.h"
 #include "gfx-validator/DeviceValidator.h"
+#include "profiler/StartupTimer.h"
 
 //#undef CC_USE_NVN
 //#undef CC_USE_VULKAN
@@ -70,27 +71,28 @@ class CC_DLL DeviceManager final {
 public:
     static Device *create(const DeviceInfo &info) {
         if (Device::instance) return Device::instance;
+        CC_STARTUP_PHASE(gfx_device);
 
         Device *device = nullptr;
 
 #ifdef CC_USE_NVN
-        if (tryCreate<CCNVNDevice>(info, &device)) return device;
+        if (isBackendAllowed("NVN") && tryCreate<CCNVNDevice>(info, &device)) return device;
 #endif
 
 #ifdef CC_USE_VULKAN
-        if (tryCreate<CCVKDevice>(info, &device)) return device;
+        if (isBackendAllowed("Vulkan") && tryCreate<CCVKDevice>(info, &device)) return device;
 #endif
 
 #ifdef CC_USE_METAL
-        if (tryCreate<CCMTLDevice>(info, &device)) return device;
+        if (isBackendAllowed("Metal") && tryCreate<CCMTLDevice>(info, &device)) return device;
 #endif
 
 #ifdef CC_USE_GLES3
-        if (tryCreate<GLES3Device>(info, &device)) return device;
+        if (isBackendAllowed("GLES3") && tryCreate<GLES3Device>(info, &device)) return device;
 #endif
 
 #ifdef CC_USE_GLES2
-        if (tryCreate<GLES2Device>(info, &device)) return device;
+        if (isBackendAllowed("GLES2") && tryCreate<GLES2Device>(info, &device)) return device;
 #endif
 
         if (tryCreate<EmptyDevice>(info, &device)) return device;
@@ -98,6 +100,32 @@ public:
         return nullptr;
     }
 
+    // skips the native backends, used to measure the CPU side of the renderer in isolation
+    static Device *createEmpty(const DeviceInfo &info) {
+        if (Device::instance) return Device::instance;
+
+        Device *device = nullptr;
+        if (tryCreate<EmptyDevice>(info, &device)) return device;
+
+        return nullptr;
+    }
+
+    /**
+     * @en Restricts create() to one backend by the name getGFXName() reports, "Empty" for gfx-empty, and makes the
+     * swapchains run without vsync. Both only apply to devices created afterwards, the benchmark mode uses them.
+     * @zh 限制 create() 只创建指定名称的后端（名称同 getGFXName()，gfx-empty 为 "Empty"），并使交换链关闭垂直同步。
+     * 两者均只对之后创建的设备生效，供性能测试模式使用。
+     */
+    static void setBackend(const ccstd::string &name) { getOverrides().backend = name; }
+    static void setVsyncDisabled(bool disabled) { getOverrides().vsyncDisabled = disabled; }
+
+    /**
+     * @en Makes devices created afterwards keep what DeviceAgent::startCapture() needs to capture frames at any time,
+     * at the cost of a copy of all buffer and texture uploads.
+     * @zh 使之后创建的设备保存 DeviceAgent::startCapture() 随时捕获帧所需的数据，代价是保留所有缓冲与纹理上传数据的副本。
+     */
+    static void setCaptureEnabled(bool enabled) { getOverrides().captureEnabled = enabled; }
+
     static void destroy() {
         CC_SAFE_DESTROY_AND_DELETE(Device::instance);
     }
@@ -118,6 +146,9 @@ public:
     }
 
     static ccstd::string getGFXName() {
+        if (!getOverrides().backend.empty()) {
+            return getOverrides().backend;
+        }
         ccstd::string gfx = "unknown";
 #ifdef CC_USE_NVN
         gfx = "NVN";
@@ -137,6 +168,22 @@ public:
     }
 
 private:
+    struct Overrides {
+        ccstd::string backend;
+        bool          vsyncDisabled{false};
+        bool          captureEnabled{false};
+    };
+
+    static Overrides &getOverrides() {
+        static Overrides overrides;
+        return overrides;
+    }
+
+    static bool isBackendAllowed(const char *name) {
+        const auto &backend = getOverrides().backend;
+        return backend.empty() || backend == name;
+    }
+
     template <typename DeviceCtor, typename Enable = std::enable_if_t<std::is_base_of<Device, DeviceCtor>::value>>
     static bool tryCreate(const DeviceInfo &info, Device **pDevice) {
         Device *device = CC_NEW(DeviceCtor);
@@ -156,6 +203,10 @@ private:
             return false;
         }
 
+        device->_vsyncDisabled = getOverrides().vsyncDisabled;
+        if (getOverrides().captureEnabled && DeviceAgent::getInstance()) {
+            DeviceAgent::getInstance()->enableCapture();
+        }
         addSurfaceEventListener();
         *pDevice = device;
 
@@ -0,0 +1,116 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/core/DefineSet.h"
+#include <algorithm>
+#include "renderer/core/ProgramLib.h"
+
+namespace cc {
+
+uint64_t DefineSet::contribution(uint32_t index, int32_t mapped) {
+    // a define mapped to 0 builds the same variant as an unset one
+    if (mapped == 0) {
+        return 0;
+    }
+    // splitmix64 finalizer, so that the xor of contributions does not cancel out for nearby values
+    uint64_t x = (static_cast<uint64_t>(index) << 32) | static_cast<uint32_t>(mapped);
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void DefineSet::reset(const IProgramInfo *program, uint64_t seed) {
+    const auto count = static_cast<uint32_t>(program->defines.size());
+    _program         = program;
+    _bits.assign((count + 63) / 64, 0);
+    _values.assign(count, 0);
+    _hash = seed;
+}
+
+void DefineSet::clear() {
+    _program = nullptr;
+    _bits.clear();
+    _values.clear();
+    _hash = 0;
+}
+
+int32_t DefineSet::indexOf(const ccstd::string &name) const {
+    if (!_program) {
+        return -1;
+    }
+    const auto iter = _program->defineIndices.find(name);
+    // the template may have been redefined since the set was built
+    if (iter == _program->defineIndices.end() || iter->second >= _values.size()) {
+        return -1;
+    }
+    return static_cast<int32_t>(iter->second);
+}
+
+int32_t DefineSet::map(uint32_t index, const MacroValue &value) const {
+    return _program->defines[index].map(value);
+}
+
+bool DefineSet::set(const ccstd::string &name, const MacroValue &value) {
+    const int32_t index = indexOf(name);
+    if (index < 0) {
+        return false;
+    }
+    const auto    i      = static_cast<uint32_t>(index);
+    const int32_t mapped = map(i, value);
+    _hash ^= contribution(i, _values[i]) ^ contribution(i, mapped);
+    _bits[i >> 6] |= 1ULL << (i & 63);
+    _values[i] = mapped;
+    return true;
+}
+
+bool DefineSet::unset(const ccstd::string &name) {
+    const int32_t index = indexOf(name);
+    if (index < 0) {
+        return false;
+    }
+    const auto i = static_cast<uint32_t>(index);
+    _hash ^= contribution(i, _values[i]);
+    _bits[i >> 6] &= ~(1ULL << (i & 63));
+    _values[i] = 0;
+    return true;
+}
+
+uint64_t DefineSet::getPatchedHash(const ccstd::vector<scene::IMacroPatch> &patches) const {
+    uint64_t hash = _hash;
+    for (auto iter = patches.begin(); iter != patches.end(); ++iter) {
+        // the last patch of a macro wins
+        const auto    overridden = std::any_of(iter + 1, patches.end(), [&](const scene::IMacroPatch &patch) { return patch.name == iter->name; });
+        const int32_t index      = overridden ? -1 : indexOf(iter->name);
+        if (index < 0) {
+            continue;
+        }
+        const auto i = static_cast<uint32_t>(index);
+        hash ^= contribution(i, _values[i]) ^ contribution(i, map(i, iter->value));
+    }
+    return hash;
+}
+
+} // namespace cc
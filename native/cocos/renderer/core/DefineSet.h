@@ -0,0 +1,78 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "renderer/core/PassUtils.h"
+#include "scene/Define.h"
+
+namespace cc {
+
+struct IProgramInfo;
+
+/**
+ * @en The defines of a pass mapped onto the defines of its shader template, see ProgramLib::initDefineSet.
+ * Every template define owns a bit and a slot for its mapped value, and the variant hash is the xor of the
+ * contributions of the set defines, so changing a define costs O(1) instead of serializing the whole MacroRecord.
+ * Defines which are not used by the template are ignored, like in ProgramLib::getKey.
+ * @zh Pass 的宏定义在其 shader 模板宏列表上的映射，见 ProgramLib::initDefineSet。
+ * 模板的每个宏占一位并缓存其映射值，变体哈希为已设置宏贡献值的异或，因此修改一个宏的开销为 O(1)，无需序列化整个 MacroRecord。
+ */
+class CC_DLL DefineSet final {
+public:
+    void reset(const IProgramInfo *program, uint64_t seed);
+    void clear();
+
+    // returns false if the template does not use the macro
+    bool set(const ccstd::string &name, const MacroValue &value);
+    bool unset(const ccstd::string &name);
+
+    // hash of the define set with the patches applied, the set itself is left untouched
+    uint64_t getPatchedHash(const ccstd::vector<scene::IMacroPatch> &patches) const;
+
+    inline bool     empty() const { return _program == nullptr; }
+    inline uint64_t getHash() const { return _hash; }
+    inline uint32_t getDefineCount() const { return static_cast<uint32_t>(_values.size()); }
+    inline bool     test(uint32_t index) const { return (_bits[index >> 6] >> (index & 63)) & 1; }
+    inline int32_t  getValue(uint32_t index) const { return _values[index]; }
+
+private:
+    static uint64_t contribution(uint32_t index, int32_t mapped);
+
+    // index of the template define or -1 if the macro is not used by the template
+    int32_t indexOf(const ccstd::string &name) const;
+    int32_t map(uint32_t index, const MacroValue &value) const;
+
+    const IProgramInfo *    _program{nullptr};
+    ccstd::vector<uint64_t> _bits;
+    ccstd::vector<int32_t>  _values;
+    uint64_t                _hash{0};
+};
+
+} // namespace cc
@@ -33,29 +33,44 @@
 namespace cc {
 
 PassInstance::PassInstance(scene::Pass *parent, MaterialInstance *owner) : Super(parent->getRoot()), _parent(parent), _owner(owner) {
+    // the uniforms and textures are shared with the parent until one of them is overridden, see detach
+    shareResources(_parent);
     doInit(_parent->getPassInfoFull());
+    Super::tryCompile();
+}
+
+PassInstance::~PassInstance() {
+    stopSharingResources();
+}
+
+void PassInstance::detach() {
+    // the source is the owner of the shared resources, which may be an ancestor of the parent
+    scene::Pass *source = _sharedParent;
+    stopSharingResources();
+    createResources();
     for (const auto &b : _shaderInfo->blocks) {
         scene::IBlockRef &      block       = _blocks[b.binding];
-        const scene::IBlockRef &parentBlock = _parent->getBlocks()[b.binding];
-        assert(block.count == parentBlock.count);
-        memcpy(block.data, parentBlock.data, parentBlock.count * 4);
+        const scene::IBlockRef &sourceBlock = source->getBlocks()[b.binding];
+        assert(block.count == sourceBlock.count);
+        memcpy(block.data, sourceBlock.data, sourceBlock.count * 4);
     }
 
     _rootBufferDirty                        = true;
-    gfx::DescriptorSet *parentDescriptorSet = _parent->getDescriptorSet();
+    gfx::DescriptorSet *sourceDescriptorSet = source->getDescriptorSet();
     for (const auto &samplerTexture : _shaderInfo->samplerTextures) {
         for (uint32_t i = 0; i < samplerTexture.count; ++i) {
-            auto *sampler = parentDescriptorSet->getSampler(samplerTexture.binding, i);
-            auto *texture = parentDescriptorSet->getTexture(samplerTexture.binding, i);
+            auto *sampler = sourceDescriptorSet->getSampler(samplerTexture.binding, i);
+            auto *texture = sourceDescriptorSet->getTexture(samplerTexture.binding, i);
             _descriptorSet->bindSampler(samplerTexture.binding, sampler, i);
             _descriptorSet->bindTexture(samplerTexture.binding, texture, i);
         }
     }
+
+    // an instance with its own properties is never merged with other passes, the owner rebuilds its pipeline states
     Super::tryCompile();
+    onStateChange();
 }
 
-PassInstance::~PassInstance() = default;
-
 scene::Pass *PassInstance::getParent() const {
     return _parent.get();
 }
@@ -88,6 +103,11 @@ void PassInstance::endChangeStatesSilently() {
 }
 
 void PassInstance::syncBatchingScheme() {
+    // while sharing the resources of the parent, the instance is merged into the buffers of the parent
+    if (isSharingResources()) {
+        Super::syncBatchingScheme();
+        return;
+    }
     _defines["USE_INSTANCING"] = false;
     _defines["USE_BATCHING"]   = false;
     _batchingScheme            = scene::BatchingSchemes::NONE;
@@ -71,6 +71,7 @@ public:
 
 protected:
     void syncBatchingScheme() override;
+    void detach() override;
 
     void onStateChange();
 
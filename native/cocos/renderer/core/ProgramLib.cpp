@@ -30,8 +30,10 @@
 #include <ostream>
 #include "base/Log.h"
 #include "core/assets/EffectAsset.h"
+#include "core/builtin/ShaderSourceAssembly.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/PipelineStateManifest.h"
 #include "renderer/pipeline/RenderPipeline.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 
@@ -318,9 +320,12 @@ IProgramInfo *ProgramLib::define(IShaderInfo &shader) {
 
     IProgramInfo &tmpl = _templates[shader.name];
     tmpl.copyFrom(shader);
+    // builtin effects are registered without sources
+    ShaderSourceAssembly::resolve(&tmpl);
 
     // calculate option mask offset
     int32_t offset = 0;
+    tmpl.defineIndices.clear();
     for (auto &def : tmpl.defines) {
         int32_t cnt = 1;
         if (def.type == "number") {
@@ -365,6 +370,9 @@ IProgramInfo *ProgramLib::define(IShaderInfo &shader) {
         }
         def.offset = offset;
         offset += cnt;
+        if (def.map) {
+            tmpl.defineIndices[def.name] = static_cast<uint32_t>(&def - tmpl.defines.data());
+        }
     }
     if (offset > 31) {
         tmpl.uber = true;
@@ -623,6 +631,29 @@ ccstd::string ProgramLib::getKey(const ccstd::string &name, const MacroRecord &d
     return ret;
 }
 
+void ProgramLib::initDefineSet(const ccstd::string &name, const MacroRecord &defines, DefineSet &out) {
+    auto itTpl = _templates.find(name);
+    assert(itTpl != _templates.end());
+    const auto &tmpl = itTpl->second;
+    out.reset(&tmpl, tmpl.hash);
+    for (const auto &def : defines) {
+        out.set(def.first, def.second);
+    }
+}
+
+gfx::Shader *ProgramLib::getVariant(uint64_t hash) const {
+    // the manifest records the variants by key, which is only known to getGFXShader
+    if (_recordingManifest) {
+        return nullptr;
+    }
+    auto iter = _variants.find(hash);
+    return iter != _variants.end() ? iter->second : nullptr;
+}
+
+void ProgramLib::addVariant(uint64_t hash, gfx::Shader *shader) {
+    _variants[hash] = shader;
+}
+
 void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
     if (defines.empty()) return;
     ccstd::vector<ccstd::string> defineValues;
@@ -642,6 +673,9 @@ void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
             matchedKeys.emplace_back(i.first);
         }
     }
+    if (!matchedKeys.empty()) {
+        _variants.clear();
+    }
     for (const auto &key : matchedKeys) {
         CC_LOG_DEBUG("destroyed shader %s", key.c_str());
         _cache[key]->destroy();
@@ -650,7 +684,7 @@ void ProgramLib::destroyShaderByDefines(const MacroRecord &defines) {
 }
 
 gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
-                                      render::PipelineRuntime *pipeline, ccstd::string *keyOut) {
+                                      render::PipelineRuntime *pipeline, ccstd::string *keyOut, bool *pending) {
     for (const auto &it : pipeline->getMacros()) {
         defines[it.first] = it.second;
     }
@@ -661,12 +695,97 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
     } else {
         key = *keyOut;
     }
+    if (pending) {
+        *pending = false;
+    }
     auto itRes = _cache.find(key);
     if (itRes != _cache.end()) {
         //        CC_LOG_DEBUG("Found ProgramLib::_cache[%s]=%p, defines: %d", key.c_str(), itRes->second, defines.size());
+        if (_recordingManifest) {
+            _recordingManifest->addShader(itRes->second, key, name, defines);
+        }
+        return itRes->second;
+    }
+
+    if (!_asyncCompileEnabled) {
+        return createShader(device, name, defines, pipeline, key);
+    }
+
+    if (!_pendingShaders.count(key)) {
+        _pendingShaders.emplace(key, PendingShader{device, name, defines, pipeline});
+        _pendingQueue.emplace_back(key);
+    }
+    if (pending) {
+        *pending = true;
+    }
+    return getFallbackShader(device, name, pipeline, key);
+}
+
+gfx::Shader *ProgramLib::compileGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines, render::PipelineRuntime *pipeline) {
+    for (const auto &it : pipeline->getMacros()) {
+        defines[it.first] = it.second;
+    }
+    const ccstd::string key   = getKey(name, defines);
+    auto                itRes = _cache.find(key);
+    if (itRes != _cache.end()) {
         return itRes->second;
     }
 
+    auto *shader = createShader(device, name, defines, pipeline, key);
+    if (_pendingShaders.erase(key)) {
+        // the stale queue entry is skipped in update
+        ++_compiledVersion;
+    }
+    return shader;
+}
+
+gfx::Shader *ProgramLib::getFallbackShader(gfx::Device *device, const ccstd::string &name, render::PipelineRuntime *pipeline, const ccstd::string &key) {
+    if (_asyncCompileFallback == AsyncCompileFallback::SKIP_DRAW) {
+        return nullptr;
+    }
+
+    MacroRecord defaultDefines;
+    for (const auto &it : pipeline->getMacros()) {
+        defaultDefines[it.first] = it.second;
+    }
+    const ccstd::string defaultKey = getKey(name, defaultDefines);
+    if (defaultKey == key) {
+        // nothing cheaper to fall back to
+        return nullptr;
+    }
+    auto itRes = _cache.find(defaultKey);
+    if (itRes != _cache.end()) {
+        return itRes->second;
+    }
+    // compiled once per template at most, so that the variants behind it never stall
+    return createShader(device, name, defaultDefines, pipeline, defaultKey);
+}
+
+void ProgramLib::update() {
+    uint32_t compiled = 0;
+    while (!_pendingQueue.empty() && compiled < _maxCompilesPerFrame) {
+        const ccstd::string key = std::move(_pendingQueue.front());
+        _pendingQueue.pop_front();
+
+        auto it = _pendingShaders.find(key);
+        if (it == _pendingShaders.end()) {
+            continue;
+        }
+        const PendingShader info = std::move(it->second);
+        _pendingShaders.erase(it);
+        if (!_cache.count(key) && _templates.count(info.name)) {
+            createShader(info.device, info.name, info.defines, info.pipeline, key);
+            ++compiled;
+        }
+    }
+
+    if (compiled) {
+        ++_compiledVersion;
+    }
+}
+
+gfx::Shader *ProgramLib::createShader(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                                      render::PipelineRuntime *pipeline, const ccstd::string &key) {
     auto itTpl = _templates.find(name);
     assert(itTpl != _templates.end());
 
@@ -707,6 +826,9 @@ gfx::Shader *ProgramLib::getGFXShader(gfx::Device *device, const ccstd::string &
 
     auto *shader = device->createShader(tmplInfo.shaderInfo);
     _cache[key]  = shader;
+    if (_recordingManifest) {
+        _recordingManifest->addShader(shader, key, name, defines);
+    }
     CC_LOG_DEBUG("ProgramLib::_cache[%s]=%p, defines: %d", key.c_str(), shader, defines.size());
     return shader;
 }
@@ -29,11 +29,13 @@
 #include <numeric>
 #include <sstream>
 #include "base/RefVector.h"
+#include "base/std/container/deque.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "cocos/base/Optional.h"
 #include "core/Types.h"
 #include "core/assets/EffectAsset.h"
+#include "renderer/core/DefineSet.h"
 #include "renderer/gfx-base/GFXDef-common.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/RenderPipeline.h"
@@ -44,6 +46,9 @@ class EffectAsset;
 namespace render {
 class PipelineRuntime;
 } // namespace render
+namespace pipeline {
+class PipelineStateManifest;
+} // namespace pipeline
 
 struct IDefineRecord : public IDefineInfo {
     std::function<int32_t(const MacroValue &)> map{nullptr};
@@ -67,16 +72,26 @@ struct ITemplateInfo {
 };
 
 struct IProgramInfo : public IShaderInfo {
-    ccstd::string                effectName;
-    ccstd::vector<IDefineRecord> defines;
-    ccstd::string                constantMacros;
-    bool                         uber{false}; // macro number exceeds default limits, will fallback to string hash
+    ccstd::string                   effectName;
+    ccstd::vector<IDefineRecord>    defines;
+    ccstd::string                   constantMacros;
+    bool                            uber{false};   // macro number exceeds default limits, will fallback to string hash
+    Record<ccstd::string, uint32_t> defineIndices; // index in defines of the macros with a map, by name
 
     void copyFrom(const IShaderInfo &o);
 };
 
 const char *getDeviceShaderVersion(const gfx::Device *device);
 
+/**
+ * @en What is returned in place of a shader variant which is still waiting to be compiled in the async compile mode.
+ * @zh 异步编译模式下，着色器变体编译完成之前的替代方式。
+ */
+enum class AsyncCompileFallback {
+    SKIP_DRAW,       // nullptr, the pass is not drawn
+    DEFAULT_VARIANT, // the variant of the shader template with only the pipeline macros
+};
+
 /**
  * @en The global maintainer of all shader resources.
  * @zh 维护 shader 资源实例的全局管理器。
@@ -136,6 +151,28 @@ public:
      */
     ccstd::string getKey(const ccstd::string &name, const MacroRecord &defines);
 
+    /**
+     * @en Build the define set of a macro combination, which can be updated per macro afterwards
+     * @zh 构建宏组合对应的 DefineSet，之后可按单个宏增量更新。
+     * @param name Target shader name
+     * @param defines The combination of preprocess macros
+     * @param out The define set to build
+     */
+    void initDefineSet(const ccstd::string &name, const MacroRecord &defines, DefineSet &out);
+
+    /**
+     * @en Gets the shader variant registered for a define set hash, nullptr if it has not been resolved by getGFXShader yet
+     * @zh 获取 DefineSet 哈希对应的已注册 shader 变体，尚未经 getGFXShader 获取过时返回 nullptr。
+     * @param hash The hash of the define set, see DefineSet::getHash
+     */
+    gfx::Shader *getVariant(uint64_t hash) const;
+
+    /**
+     * @en Register the shader returned by getGFXShader for a define set hash, fallback shaders of pending variants must not be registered
+     * @zh 为 DefineSet 哈希注册 getGFXShader 返回的 shader，等待编译的变体的替代 shader 不可注册。
+     */
+    void addVariant(uint64_t hash, gfx::Shader *shader);
+
     /**
      * @en Destroy all shader instance match the preprocess macros
      * @zh 销毁所有完全满足指定预处理宏特征的 shader 实例。
@@ -153,17 +190,71 @@ public:
      * @param key The shader cache key, if already known
      */
     gfx::Shader *getGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines,
-                              render::PipelineRuntime *pipeline, ccstd::string *key = nullptr);
+                              render::PipelineRuntime *pipeline, ccstd::string *key = nullptr, bool *pending = nullptr);
+
+    /**
+     * @en In the async compile mode new shader variants are queued instead of compiled on request, getGFXShader
+     * returns the fallback for them and reports them as pending, users should request them again once
+     * getCompiledVersion changes. At most maxCompilesPerFrame queued variants are compiled in each update.
+     * @zh 异步编译模式下，新的着色器变体在请求时只会加入队列而不会立即编译，getGFXShader 返回替代结果并将其标记为待编译，
+     * 使用者应在 getCompiledVersion 变化后重新请求。每次 update 最多编译 maxCompilesPerFrame 个排队中的变体。
+     */
+    inline void setAsyncCompileEnabled(bool enabled) { _asyncCompileEnabled = enabled; }
+    inline bool isAsyncCompileEnabled() const { return _asyncCompileEnabled; }
+    inline void setAsyncCompileFallback(AsyncCompileFallback fallback) { _asyncCompileFallback = fallback; }
+    inline void setMaxCompilesPerFrame(uint32_t count) { _maxCompilesPerFrame = std::max(count, 1U); }
+    // increased whenever queued variants are compiled
+    inline uint32_t getCompiledVersion() const { return _compiledVersion; }
+    inline uint32_t getPendingCount() const { return static_cast<uint32_t>(_pendingQueue.size()); }
+
+    /**
+     * @en Gets the shader resource instance like getGFXShader, but always compiles it right away even in the async compile mode.
+     * @zh 与 getGFXShader 相同地获取 shader 资源实例，但即使在异步编译模式下也会立即编译。
+     */
+    gfx::Shader *compileGFXShader(gfx::Device *device, const ccstd::string &name, MacroRecord &defines, render::PipelineRuntime *pipeline);
+
+    /**
+     * @en All shader variants requested while a manifest is set are recorded into it, see pipeline::PipelineStateManifest.
+     * @zh 设置清单后请求的所有着色器变体都会被记录到清单中，参见 pipeline::PipelineStateManifest。
+     */
+    inline void                             setRecordingManifest(pipeline::PipelineStateManifest *manifest) { _recordingManifest = manifest; }
+    inline pipeline::PipelineStateManifest *getRecordingManifest() const { return _recordingManifest; }
+
+    /**
+     * @en Compile the queued shader variants within the budget of a frame, called once per frame by Root.
+     * @zh 在单帧预算内编译排队中的着色器变体，由 Root 每帧调用一次。
+     */
+    void update();
 
 private:
+    struct PendingShader {
+        gfx::Device *            device{nullptr};
+        ccstd::string            name;
+        MacroRecord              defines;
+        render::PipelineRuntime *pipeline{nullptr};
+    };
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(ProgramLib);
     ProgramLib();
     ~ProgramLib();
 
+    gfx::Shader *createShader(gfx::Device *device, const ccstd::string &name, const MacroRecord &defines,
+                              render::PipelineRuntime *pipeline, const ccstd::string &key);
+    gfx::Shader *getFallbackShader(gfx::Device *device, const ccstd::string &name, render::PipelineRuntime *pipeline, const ccstd::string &key);
+
     static ProgramLib *                              instance;
     Record<ccstd::string, IProgramInfo>              _templates; // per shader
     Record<ccstd::string, IntrusivePtr<gfx::Shader>> _cache;
     Record<uint64_t, ITemplateInfo>                  _templateInfos;
+    Record<uint64_t, gfx::Shader *>                  _variants; // by define set hash, the shaders are owned by _cache
+
+    bool                                 _asyncCompileEnabled{false};
+    AsyncCompileFallback                 _asyncCompileFallback{AsyncCompileFallback::DEFAULT_VARIANT};
+    uint32_t                             _maxCompilesPerFrame{1};
+    uint32_t                             _compiledVersion{0};
+    ccstd::deque<ccstd::string>          _pendingQueue;
+    Record<ccstd::string, PendingShader> _pendingShaders;
+    pipeline::PipelineStateManifest *    _recordingManifest{nullptr};
 };
 
 } // namespace cc
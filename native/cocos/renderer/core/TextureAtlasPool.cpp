@@ -0,0 +1,292 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/core/TextureAtlasPool.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Utils.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXTexture.h"
+
+namespace cc {
+
+TextureAtlasPool::TextureAtlasPool(gfx::Device *device)
+: _device(device) {
+}
+
+TextureAtlasPool::~TextureAtlasPool() {
+    destroy();
+}
+
+void TextureAtlasPool::initialize(const ITextureAtlasPoolInfo &info) {
+    _format     = info.format;
+    _formatSize = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(info.format)].size;
+    _pageSize   = utils::nextPOT(std::max(info.pageSize, 1U));
+    _padding    = info.padding;
+}
+
+void TextureAtlasPool::destroy() {
+    for (auto &page : _pages) {
+        CC_SAFE_DESTROY_AND_DELETE(page.texture);
+    }
+    _pages.clear();
+    _allocations.clear();
+}
+
+ITextureAtlasHandle TextureAtlasPool::alloc(uint32_t width, uint32_t height) {
+    ITextureAtlasHandle handle;
+    if (width == 0 || height == 0) {
+        return handle;
+    }
+
+    Allocation allocation;
+    allocation.region.width  = width;
+    allocation.region.height = height;
+    allocate(allocation);
+
+    handle.id = _nextId++;
+    _allocations.emplace(handle.id, std::move(allocation));
+    return handle;
+}
+
+void TextureAtlasPool::free(const ITextureAtlasHandle &handle) {
+    auto iter = _allocations.find(handle.id);
+    if (iter == _allocations.end()) {
+        return;
+    }
+
+    // skyline can't reclaim the space of a single allocation, only that of an emptied page
+    auto &page = _pages[iter->second.page];
+    if (--page.allocationCount == 0) {
+        resetPage(page);
+    }
+    _allocations.erase(iter);
+}
+
+void TextureAtlasPool::update(const ITextureAtlasHandle &handle, const uint8_t *data) {
+    auto iter = _allocations.find(handle.id);
+    if (iter == _allocations.end() || !data) {
+        return;
+    }
+
+    auto &allocation = iter->second;
+    allocation.data.resize(allocation.region.width * allocation.region.height * _formatSize);
+    memcpy(allocation.data.data(), data, allocation.data.size());
+    upload(allocation, data);
+}
+
+void TextureAtlasPool::compact() {
+    if (_allocations.empty()) {
+        destroy();
+        return;
+    }
+
+    // the tallest first packs tighter with a skyline
+    ccstd::vector<Allocation *> allocations;
+    allocations.reserve(_allocations.size());
+    for (auto &pair : _allocations) {
+        allocations.emplace_back(&pair.second);
+    }
+    std::sort(allocations.begin(), allocations.end(), [](const Allocation *lhs, const Allocation *rhs) {
+        if (lhs->region.height != rhs->region.height) {
+            return lhs->region.height > rhs->region.height;
+        }
+        return lhs->region.width > rhs->region.width;
+    });
+
+    for (auto &page : _pages) {
+        resetPage(page);
+    }
+    for (auto *allocation : allocations) {
+        allocate(*allocation);
+    }
+
+    // release the pages left empty and remap the page indices of the allocations
+    ccstd::vector<uint32_t> remap(_pages.size());
+    uint32_t                count = 0;
+    for (uint32_t i = 0; i < _pages.size(); ++i) {
+        if (_pages[i].allocationCount == 0) {
+            CC_SAFE_DESTROY_AND_DELETE(_pages[i].texture);
+            continue;
+        }
+        remap[i] = count;
+        if (count != i) {
+            _pages[count] = std::move(_pages[i]);
+        }
+        ++count;
+    }
+    _pages.resize(count);
+
+    for (auto *allocation : allocations) {
+        allocation->page = remap[allocation->page];
+        if (!allocation->data.empty()) {
+            upload(*allocation, allocation->data.data());
+        }
+    }
+    ++_version;
+}
+
+const ITextureAtlasRegion *TextureAtlasPool::getRegion(const ITextureAtlasHandle &handle) const {
+    auto iter = _allocations.find(handle.id);
+    return iter != _allocations.end() ? &iter->second.region : nullptr;
+}
+
+bool TextureAtlasPool::place(uint32_t pageIndex, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y) {
+    auto &     page    = _pages[pageIndex];
+    auto &     skyline = page.skyline;
+    const auto count   = static_cast<uint32_t>(skyline.size());
+
+    // bottom left: the lowest fitting position, then the narrowest node
+    uint32_t bestIndex = count;
+    uint32_t bestY     = page.size;
+    uint32_t bestWidth = page.size;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t left = skyline[i].x;
+        if (left + width > page.size) {
+            break;
+        }
+
+        uint32_t top       = 0;
+        uint32_t remaining = width;
+        for (uint32_t j = i; remaining > 0 && j < count; ++j) {
+            top = std::max(top, skyline[j].y);
+            remaining -= std::min(remaining, skyline[j].width);
+        }
+        if (top + height > page.size) {
+            continue;
+        }
+        if (top < bestY || (top == bestY && skyline[i].width < bestWidth)) {
+            bestIndex = i;
+            bestY     = top;
+            bestWidth = skyline[i].width;
+        }
+    }
+    if (bestIndex == count) {
+        return false;
+    }
+
+    *x = skyline[bestIndex].x;
+    *y = bestY;
+
+    SkylineNode node;
+    node.x     = *x;
+    node.y     = bestY + height;
+    node.width = width;
+    skyline.insert(skyline.begin() + bestIndex, node);
+
+    // shrink or remove the nodes now covered by the new one
+    for (auto i = bestIndex + 1; i < skyline.size();) {
+        const auto &prev  = skyline[i - 1];
+        auto &      cur   = skyline[i];
+        const auto  right = prev.x + prev.width;
+        if (cur.x >= right) {
+            break;
+        }
+        const auto shrink = right - cur.x;
+        if (cur.width <= shrink) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        cur.x += shrink;
+        cur.width -= shrink;
+        break;
+    }
+
+    // merge neighbors at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+    return true;
+}
+
+uint32_t TextureAtlasPool::createPage(uint32_t size) {
+    Page page;
+    page.size    = size;
+    page.texture = _device->createTexture({gfx::TextureType::TEX2D,
+                                           gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_DST,
+                                           _format,
+                                           size,
+                                           size});
+    resetPage(page);
+    _pages.emplace_back(std::move(page));
+    return static_cast<uint32_t>(_pages.size() - 1);
+}
+
+void TextureAtlasPool::resetPage(Page &page) const {
+    page.allocationCount = 0;
+    page.skyline.clear();
+    page.skyline.push_back({0, 0, page.size});
+}
+
+void TextureAtlasPool::assign(Allocation &allocation, uint32_t pageIndex, uint32_t x, uint32_t y) {
+    auto &page = _pages[pageIndex];
+    ++page.allocationCount;
+
+    auto &      region = allocation.region;
+    const float size   = static_cast<float>(page.size);
+    region.texture     = page.texture;
+    region.x           = x + _padding;
+    region.y           = y + _padding;
+    region.uvScaleOffset.set(static_cast<float>(region.width) / size, static_cast<float>(region.height) / size,
+                             static_cast<float>(region.x) / size, static_cast<float>(region.y) / size);
+    allocation.page = pageIndex;
+}
+
+void TextureAtlasPool::upload(const Allocation &allocation, const uint8_t *data) {
+    const auto &           region = allocation.region;
+    gfx::BufferTextureCopy copy;
+    copy.texOffset.x      = static_cast<int32_t>(region.x);
+    copy.texOffset.y      = static_cast<int32_t>(region.y);
+    copy.texExtent.width  = region.width;
+    copy.texExtent.height = region.height;
+
+    const uint8_t *buffers[1]{data};
+    _device->copyBuffersToTexture(buffers, region.texture, &copy, 1);
+}
+
+void TextureAtlasPool::allocate(Allocation &allocation) {
+    const uint32_t width  = allocation.region.width + _padding * 2;
+    const uint32_t height = allocation.region.height + _padding * 2;
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    for (uint32_t i = 0; i < _pages.size(); ++i) {
+        if (place(i, width, height, &x, &y)) {
+            assign(allocation, i, x, y);
+            return;
+        }
+    }
+
+    const auto index = createPage(std::max(_pageSize, utils::nextPOT(std::max(width, height))));
+    place(index, width, height, &x, &y);
+    assign(allocation, index, x, y);
+}
+
+} // namespace cc
@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/RefCounted.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "math/Vec4.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+
+struct ITextureAtlasPoolInfo {
+    gfx::Format format{gfx::Format::RGBA8}; // target texture format
+    uint32_t    pageSize{1024};             // width and height of each atlas page, larger allocations get a page of their own
+    uint32_t    padding{1};                 // texels kept free around each allocation to avoid bleeding when filtering
+};
+
+// Stable handle of an atlas allocation, its region may move when the pool is compacted.
+struct ITextureAtlasHandle {
+    uint32_t id{0};
+
+    inline bool isValid() const { return id != 0; }
+    bool        operator==(const ITextureAtlasHandle &handle) const { return id == handle.id; }
+};
+
+struct ITextureAtlasRegion {
+    gfx::Texture *texture{nullptr};
+    uint32_t      x{0};
+    uint32_t      y{0};
+    uint32_t      width{0};
+    uint32_t      height{0};
+    // uv in the atlas = uv in the image * (x, y) + (z, w)
+    Vec4 uvScaleOffset;
+};
+
+/**
+ * @en Packs small dynamically created images into shared atlas textures with a skyline allocator,
+ * so that sprites and UI using them share a texture and can be batched together.
+ * The image data of each allocation is kept to move it when the pool is compacted.
+ * @zh 使用天际线算法将动态创建的小图打包到共享的图集贴图中，使用它们的精灵和 UI 可以共用贴图并合批。
+ * 每个分配的图像数据会被保留，以便在整理图集时移动它。
+ */
+class TextureAtlasPool : public RefCounted {
+public:
+    explicit TextureAtlasPool(gfx::Device *device);
+    ~TextureAtlasPool() override;
+
+    void initialize(const ITextureAtlasPoolInfo &info);
+    void destroy();
+
+    ITextureAtlasHandle alloc(uint32_t width, uint32_t height);
+    void                free(const ITextureAtlasHandle &handle);
+
+    // data holds width * height texels of the allocation, tightly packed
+    void update(const ITextureAtlasHandle &handle, const uint8_t *data);
+
+    /**
+     * @en Repacks the live allocations into as few pages as possible and releases the empty pages.
+     * Regions of the handles change, users should query them again after getVersion() changes.
+     * @zh 将仍在使用的分配重新打包到尽量少的页面中，并释放空页面。
+     * 句柄对应的区域会改变，getVersion() 变化后使用者应重新查询。
+     */
+    void compact();
+
+    // nullptr if the handle is freed or invalid
+    const ITextureAtlasRegion *getRegion(const ITextureAtlasHandle &handle) const;
+
+    // increased whenever a region moves
+    inline uint32_t getVersion() const { return _version; }
+    inline uint32_t getPageCount() const { return static_cast<uint32_t>(_pages.size()); }
+
+private:
+    struct SkylineNode {
+        uint32_t x{0};
+        uint32_t y{0};
+        uint32_t width{0};
+    };
+
+    struct Page {
+        gfx::Texture *             texture{nullptr};
+        uint32_t                   size{0};
+        uint32_t                   allocationCount{0};
+        ccstd::vector<SkylineNode> skyline;
+    };
+
+    struct Allocation {
+        ITextureAtlasRegion    region;
+        uint32_t               page{0};
+        ccstd::vector<uint8_t> data;
+    };
+
+    bool     place(uint32_t pageIndex, uint32_t width, uint32_t height, uint32_t *x, uint32_t *y);
+    uint32_t createPage(uint32_t size);
+    void     resetPage(Page &page) const;
+    void     assign(Allocation &allocation, uint32_t pageIndex, uint32_t x, uint32_t y);
+    void     upload(const Allocation &allocation, const uint8_t *data);
+    void     allocate(Allocation &allocation);
+
+    gfx::Device *                              _device{nullptr};
+    gfx::Format                                _format{gfx::Format::RGBA8};
+    uint32_t                                   _formatSize{4};
+    uint32_t                                   _pageSize{1024};
+    uint32_t                                   _padding{1};
+    uint32_t                                   _nextId{1};
+    uint32_t                                   _version{0};
+    ccstd::vector<Page>                        _pages;
+    ccstd::unordered_map<uint32_t, Allocation> _allocations;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(TextureAtlasPool);
+};
+
+} // namespace cc
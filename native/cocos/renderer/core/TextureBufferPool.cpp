@@ -81,7 +81,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -95,7 +95,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size) {
     // create a new one
     auto     targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength  = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto     newChunk   = _chunks[createChunk(texLength)];
+    auto &   newChunk   = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -121,7 +121,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     }
 
     if (start >= 0) {
-        auto chunk = _chunks[index];
+        auto &chunk = _chunks[index];
         chunk.start += static_cast<index_t>(size);
         ITextureBufferHandle handle;
         handle.chunkIdx = index;
@@ -135,7 +135,7 @@ ITextureBufferHandle TextureBufferPool::alloc(uint32_t size, index_t chunkIdx) {
     // create a new one
     auto     targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength  = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto     newChunk   = _chunks[createChunk(texLength)];
+    auto &   newChunk   = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
@@ -165,11 +165,11 @@ uint32_t TextureBufferPool::createChunk(uint32_t length) {
                                             length});
 
     ITextureBuffer chunk;
-    chunk.texture        = texture;
-    chunk.size           = texSize;
-    chunk.start          = 0;
-    chunk.end            = static_cast<index_t>(texSize);
-    _chunks[_chunkCount] = chunk;
+    chunk.texture = texture;
+    chunk.size    = texSize;
+    chunk.start   = 0;
+    chunk.end     = static_cast<index_t>(texSize);
+    _chunks.emplace_back(chunk);
     return _chunkCount++;
 }
 
@@ -247,7 +247,7 @@ index_t TextureBufferPool::findAvailableSpace(uint32_t size, index_t chunkIdx) c
                 handles.emplace_back(h);
             }
         }
-        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start - b.start; });
+        std::sort(handles.begin(), handles.end(), [](const ITextureBufferHandle &a, const ITextureBufferHandle &b) { return a.start < b.start; });
         for (auto handle : handles) {
             if ((start + size) <= handle.start) {
                 isFound = true;
@@ -265,7 +265,7 @@ index_t TextureBufferPool::findAvailableSpace(uint32_t size, index_t chunkIdx) c
 ITextureBufferHandle TextureBufferPool::mcDonaldAlloc(uint32_t size) {
     size = roundUp(size, _alignment);
     for (index_t i = 0; i < _chunkCount; ++i) {
-        auto    chunk   = _chunks[i];
+        auto &  chunk   = _chunks[i];
         bool    isFound = false;
         index_t start   = chunk.start;
         if ((start + size) <= chunk.end) {
@@ -302,11 +302,11 @@ ITextureBufferHandle TextureBufferPool::mcDonaldAlloc(uint32_t size) {
     // create a new one
     auto     targetSize = static_cast<int32_t>(std::sqrt(size / _formatSize));
     uint32_t texLength  = _roundUpFn ? _roundUpFn(targetSize, _formatSize) : std::max(1024, static_cast<int>(utils::nextPOT(targetSize)));
-    auto     newChunk   = _chunks[createChunk(texLength)];
+    auto &   newChunk   = _chunks[createChunk(texLength)];
 
     newChunk.start += static_cast<index_t>(size);
     ITextureBufferHandle texHandle;
-    texHandle.chunkIdx = static_cast<index_t>(_chunkCount);
+    texHandle.chunkIdx = static_cast<index_t>(_chunkCount - 1);
     texHandle.start    = 0;
     texHandle.end      = static_cast<index_t>(size),
     texHandle.texture  = newChunk.texture;
@@ -39,10 +39,14 @@
 namespace cc {
 namespace framegraph {
 
-DevicePass::DevicePass(const FrameGraph &graph, ccstd::vector<PassNode *> const &subpassNodes) {
+DevicePass::DevicePass(const FrameGraph &graph, ccstd::vector<PassNode *> const &subpassNodes)
+: _name(subpassNodes.front()->_name),
+  _viewCount(subpassNodes.front()->_viewCount) {
     ccstd::vector<RenderTargetAttachment> attachments;
 
     for (const PassNode *passNode : subpassNodes) {
+        // the view mask applies to every subpass of a render pass
+        CC_ASSERT(passNode->_viewCount == _viewCount);
         append(graph, passNode, &attachments);
     }
 
@@ -65,10 +69,16 @@ DevicePass::DevicePass(const FrameGraph &graph, ccstd::vector<PassNode *> const
     for (PassNode *const passNode : subpassNodes) {
         _resourceTable.extract(graph, passNode, renderTargets);
     }
+
+    // other logic passes would record inline, which is not allowed in a render pass begun with secondary command buffers
+    if (subpassNodes.size() == 1 && !subpassNodes[0]->_next) {
+        _resourceTable._secondaryCmdBuffs = subpassNodes[0]->_secondaryCmdBuffs;
+    }
 }
 
 void DevicePass::execute() {
-    auto *cmdBuff = gfx::Device::getInstance()->getCommandBuffer();
+    auto *      cmdBuff           = gfx::Device::getInstance()->getCommandBuffer();
+    const auto &secondaryCmdBuffs = _resourceTable._secondaryCmdBuffs;
 
     begin(cmdBuff);
 
@@ -77,6 +87,13 @@ void DevicePass::execute() {
         _resourceTable._subpassIndex = i;
 
         for (LogicPass &pass : subpass.logicPasses) {
+            if (!secondaryCmdBuffs.empty()) {
+                // secondary command buffers set their own dynamic states
+                pass.pass->execute(_resourceTable);
+                cmdBuff->execute(secondaryCmdBuffs.data(), utils::toUint(secondaryCmdBuffs.size()));
+                continue;
+            }
+
             gfx::Viewport &viewport = pass.customViewport ? pass.viewport : _viewport;
             gfx::Rect &    scissor  = pass.customViewport ? pass.scissor : _scissor;
 
@@ -267,6 +284,7 @@ void DevicePass::begin(gfx::CommandBuffer *cmdBuff) {
     for (auto &subpass : _subpasses) {
         rpInfo.subpasses.emplace_back(subpass.desc);
     }
+    rpInfo.viewCount = _viewCount;
 
     _renderPass = RenderPass(rpInfo);
     _renderPass.createTransient();
@@ -276,7 +294,11 @@ void DevicePass::begin(gfx::CommandBuffer *cmdBuff) {
     _fbo               = Framebuffer(fboInfo);
     _fbo.createTransient();
 
-    cmdBuff->beginRenderPass(_renderPass.get(), _fbo.get(), _scissor, clearColors.data(), clearDepth, clearStencil);
+    _resourceTable._framebuffer = _fbo.get();
+
+    const auto &secondaryCmdBuffs = _resourceTable._secondaryCmdBuffs;
+    cmdBuff->beginRenderPass(_renderPass.get(), _fbo.get(), _scissor, clearColors.data(), clearDepth, clearStencil,
+                             secondaryCmdBuffs.data(), utils::toUint(secondaryCmdBuffs.size()));
     _curViewport = _viewport;
     _curScissor  = _scissor;
 }
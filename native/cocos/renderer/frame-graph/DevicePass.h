@@ -45,6 +45,9 @@ public:
 
     void execute();
 
+    // name of the first pass node merged into this device pass
+    inline const StringHandle &getName() const noexcept { return _name; }
+
 private:
     struct LogicPass final {
         Executable *  pass{nullptr};
@@ -70,9 +73,11 @@ private:
     void next(gfx::CommandBuffer *cmdBuff) noexcept;
     void end(gfx::CommandBuffer *cmdBuff);
 
+    StringHandle              _name;
     ccstd::vector<Subpass>    _subpasses{};
     ccstd::vector<Attachment> _attachments{};
     uint16_t                  _usedRenderTargetSlotMask{0};
+    uint32_t                  _viewCount{1U};
     DevicePassResourceTable   _resourceTable;
 
     gfx::Viewport _viewport;
@@ -54,8 +54,17 @@ public:
     std::enable_if_t<std::is_base_of<gfx::GFXObject, typename Type::DeviceResource>::value, typename Type::DeviceResource *>
     getWrite(TypedHandle<Type> handle) const noexcept;
 
-    gfx::RenderPass *getRenderPass() const { return _renderPass; }
-    uint32_t         getSubpassIndex() const { return _subpassIndex; }
+    gfx::RenderPass * getRenderPass() const { return _renderPass; }
+    gfx::Framebuffer *getFramebuffer() const { return _framebuffer; }
+    uint32_t          getSubpassIndex() const { return _subpassIndex; }
+
+    /**
+     * @en The secondary command buffers of the pass if the render pass is begun with them, the pass must then record everything into them,
+     * begun with the render pass, subpass and framebuffer of this table, and is executed in their order. Empty if the pass records inline.
+     * @zh 若渲染通道以次级命令缓冲开启，返回该通道的次级命令缓冲，此时通道须以本表的渲染通道、子通道和帧缓冲开启它们并录制全部命令，
+     * 执行顺序即其顺序。通道直接录制到主命令缓冲时为空。
+     */
+    const ccstd::vector<gfx::CommandBuffer *> &getSecondaryCommandBuffers() const { return _secondaryCmdBuffs; }
 
 private:
     using ResourceDictionary = ccstd::unordered_map<Handle, gfx::GFXObject *, Handle::Hasher>;
@@ -67,8 +76,10 @@ private:
     ResourceDictionary _reads{};
     ResourceDictionary _writes{};
 
-    gfx::RenderPass *_renderPass{nullptr};
-    uint32_t         _subpassIndex{0U};
+    gfx::RenderPass *                   _renderPass{nullptr};
+    gfx::Framebuffer *                  _framebuffer{nullptr};
+    uint32_t                            _subpassIndex{0U};
+    ccstd::vector<gfx::CommandBuffer *> _secondaryCmdBuffs{};
 
     friend class DevicePass;
 };
@@ -96,6 +96,8 @@ void FrameGraph::present(const TextureHandle &input, gfx::Texture *target, bool
                 region.srcExtent.height = input->getHeight();
                 region.dstExtent.width  = target->getWidth();
                 region.dstExtent.height = target->getHeight();
+                // every view of multiview targets
+                region.srcSubres.layerCount = region.dstSubres.layerCount = std::min(input->getInfo().layerCount, target->getInfo().layerCount);
                 cmdBuff->blitTexture(input, target, &region, 1, gfx::Filter::POINT);
             }
         });
@@ -131,7 +133,13 @@ void FrameGraph::compile() {
 void FrameGraph::execute() noexcept {
     if (_passNodes.empty()) return;
     for (auto &pass : _devicePasses) {
+        if (_passExecutionListener) {
+            _passExecutionListener->onPassBegin(pass->getName());
+        }
         pass->execute();
+        if (_passExecutionListener) {
+            _passExecutionListener->onPassEnd();
+        }
     }
 }
 
@@ -428,6 +436,11 @@ void FrameGraph::computeStoreActionAndMemoryless() {
 
         renderTarget->_memoryless     = renderTarget->_neverLoaded && renderTarget->_neverStored;
         renderTarget->_memorylessMSAA = textureDesc.samples != gfx::SampleCount::ONE && renderTarget->_writerCount < 2;
+
+        // transients are allocated after this, let the backends keep memoryless ones in tile memory
+        if (renderTarget->_memoryless && !renderTarget->isImported()) {
+            static_cast<ResourceEntry<Texture> *>(renderTarget)->get()._desc.flags |= gfx::TextureFlagBit::LAZILY_ALLOCATED;
+        }
     }
 }
 
@@ -442,6 +455,9 @@ void FrameGraph::generateDevicePasses() {
     static ccstd::vector<PassNode *> subpassNodes;
     subpassNodes.clear();
 
+    _transientMemoryStatus = {};
+    _liveTransientSize     = 0;
+
     for (const auto &passNode : _passNodes) {
         if (passNode->_refCount == 0) {
             continue;
@@ -449,24 +465,53 @@ void FrameGraph::generateDevicePasses() {
 
         if (passId != passNode->_devicePassId) {
             _devicePasses.emplace_back(new DevicePass(*this, subpassNodes));
-
-            for (PassNode *const p : subpassNodes) {
-                p->releaseTransientResources();
-            }
+            releaseTransientResources(subpassNodes);
 
             subpassNodes.clear();
             passId = passNode->_devicePassId;
         }
 
-        passNode->requestTransientResources();
+        requestTransientResources(passNode.get());
         subpassNodes.emplace_back(passNode.get());
     }
 
     CC_ASSERT(subpassNodes.size() == 1);
 
     _devicePasses.emplace_back(new DevicePass(*this, subpassNodes));
+    releaseTransientResources(subpassNodes);
+
+    _transientMemoryStatus.allocatedCount = static_cast<uint32_t>(_allocatedTransients.size());
+    _allocatedTransients.clear();
+}
+
+void FrameGraph::requestTransientResources(PassNode *passNode) {
+    passNode->requestTransientResources();
 
-    for (PassNode *const p : subpassNodes) {
+    auto &status = _transientMemoryStatus;
+    for (PassNode *it = passNode; it; it = it->_next) {
+        for (const VirtualResource *resource : it->_resourceRequestArray) {
+            const uint64_t size = resource->isImported() ? 0 : resource->getMemorySize();
+            if (!size) {
+                continue;
+            }
+            status.naiveSize += size;
+            ++status.textureCount;
+            _liveTransientSize += size;
+            if (_allocatedTransients.insert(resource->getDeviceResource()).second) {
+                status.allocatedSize += size;
+            }
+        }
+    }
+    status.peakSize = std::max(status.peakSize, _liveTransientSize);
+}
+
+void FrameGraph::releaseTransientResources(const ccstd::vector<PassNode *> &passNodes) {
+    for (PassNode *const p : passNodes) {
+        for (PassNode *it = p; it; it = it->_next) {
+            for (const VirtualResource *resource : it->_resourceReleaseArray) {
+                _liveTransientSize -= resource->isImported() ? 0 : resource->getMemorySize();
+            }
+        }
         p->releaseTransientResources();
     }
 }
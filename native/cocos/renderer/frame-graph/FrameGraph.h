@@ -34,10 +34,28 @@
 #include "ResourceEntry.h"
 #include "ResourceNode.h"
 #include "base/std/container/string.h"
+#include "base/std/container/unordered_set.h"
 
 namespace cc {
 namespace framegraph {
 
+// Estimated device memory of the transient textures in the last compiled frame
+struct TransientMemoryStatus {
+    uint64_t naiveSize{0};     // every transient texture in its own allocation
+    uint64_t peakSize{0};      // the most memory alive at the same time, the lower bound of any aliasing
+    uint64_t allocatedSize{0}; // the distinct textures actually used after the allocator reused them
+    uint32_t textureCount{0};
+    uint32_t allocatedCount{0};
+};
+
+// Notified around the execution of every device pass, e.g. to write GPU timestamps
+class PassExecutionListener {
+public:
+    virtual ~PassExecutionListener()                   = default;
+    virtual void onPassBegin(const StringHandle &name) = 0;
+    virtual void onPassEnd()                           = 0;
+};
+
 class FrameGraph final {
 public:
     using ResourceHandleBlackboard = Blackboard<StringHandle, Handle::IndexType, Handle::UNINITIALIZED>;
@@ -77,6 +95,9 @@ public:
     inline void enableMerge(bool enable) noexcept;
     bool        hasPass(StringHandle handle);
 
+    inline const TransientMemoryStatus &getTransientMemoryStatus() const noexcept { return _transientMemoryStatus; }
+    inline void                         setPassExecutionListener(PassExecutionListener *listener) noexcept { _passExecutionListener = listener; }
+
 private:
     Handle        create(VirtualResource *virtualResource);
     PassNode &    createPassNode(PassInsertPoint insertPoint, const StringHandle &name, Executable *pass);
@@ -87,6 +108,8 @@ private:
     void          mergePassNodes() noexcept;
     void          computeStoreActionAndMemoryless();
     void          generateDevicePasses();
+    void          requestTransientResources(PassNode *passNode);
+    void          releaseTransientResources(const ccstd::vector<PassNode *> &passNodes);
     ResourceNode *getResourceNode(const VirtualResource *virtualResource, uint8_t version) noexcept;
 
     ccstd::vector<std::unique_ptr<PassNode>>        _passNodes{};
@@ -94,7 +117,12 @@ private:
     ccstd::vector<std::unique_ptr<VirtualResource>> _virtualResources{};
     ccstd::vector<std::unique_ptr<DevicePass>>      _devicePasses{};
     ResourceHandleBlackboard                        _blackboard;
+    TransientMemoryStatus                           _transientMemoryStatus;
+    uint64_t                                        _liveTransientSize{0};
+    // device objects handed out while generating the device passes, counted once however many resources they serve
+    ccstd::unordered_set<const gfx::GFXObject *>    _allocatedTransients;
     bool                                            _merge{true};
+    PassExecutionListener *                         _passExecutionListener{nullptr};
 
     friend class PassNode;
     friend class PassNodeBuilder;
@@ -99,7 +99,7 @@ void PassNode::createRenderTargetAttachment(RenderTargetAttachment &&attachment)
 bool PassNode::canMerge(const FrameGraph &graph, const PassNode &passNode) const {
     const size_t attachmentCount = _attachments.size();
 
-    if (passNode._hasClearedAttachment || attachmentCount != passNode._attachments.size()) {
+    if (passNode._hasClearedAttachment || attachmentCount != passNode._attachments.size() || _viewCount != passNode._viewCount) {
         return false;
     }
 
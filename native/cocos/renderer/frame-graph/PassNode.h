@@ -53,6 +53,8 @@ public:
     inline void sideEffect();
     inline void subpass(bool end, bool clearActionIgnorable);
     inline void setViewport(const gfx::Viewport &viewport, const gfx::Rect &scissor);
+    inline void setViewCount(uint32_t viewCount);
+    inline void setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs);
 
 private:
     bool                    canMerge(const FrameGraph &graph, const PassNode &passNode) const;
@@ -87,6 +89,9 @@ private:
     bool          _customViewport{false};
     gfx::Viewport _viewport;
     gfx::Rect     _scissor;
+    uint32_t      _viewCount{1U};
+
+    ccstd::vector<gfx::CommandBuffer *> _secondaryCmdBuffs{};
 
     friend class FrameGraph;
     friend class DevicePass;
@@ -111,5 +116,13 @@ void PassNode::setViewport(const gfx::Viewport &viewport, const gfx::Rect &sciss
     _scissor        = scissor;
 }
 
+void PassNode::setViewCount(uint32_t viewCount) {
+    _viewCount = viewCount;
+}
+
+void PassNode::setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) {
+    _secondaryCmdBuffs = cmdBuffs;
+}
+
 } // namespace framegraph
 } // namespace cc
@@ -55,6 +55,11 @@ public:
     inline void subpass(bool end = false, bool clearActionIgnorable = true) const noexcept;
     inline void setViewport(const gfx::Rect &scissor) noexcept;
     inline void setViewport(const gfx::Viewport &viewport, const gfx::Rect &scissor) noexcept;
+    // render every draw of the pass to this many layers of the attachments, see gfx::Feature::MULTIVIEW
+    inline void setViewCount(uint32_t viewCount) noexcept;
+    // record the pass into these secondary command buffers if it is not merged with other passes,
+    // see DevicePassResourceTable::getSecondaryCommandBuffers
+    inline void setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) noexcept;
 
     void   writeToBlackboard(const StringHandle &name, const Handle &handle) const noexcept;
     Handle readFromBlackboard(const StringHandle &name) const noexcept;
@@ -95,5 +100,13 @@ void PassNodeBuilder::setViewport(const gfx::Viewport &viewport, const gfx::Rect
     _passNode.setViewport(viewport, scissor);
 }
 
+void PassNodeBuilder::setViewCount(uint32_t viewCount) noexcept {
+    _passNode.setViewCount(viewCount);
+}
+
+void PassNodeBuilder::setSecondaryCommandBuffers(const ccstd::vector<gfx::CommandBuffer *> &cmdBuffs) noexcept {
+    _passNode.setSecondaryCommandBuffers(cmdBuffs);
+}
+
 } // namespace framegraph
 } // namespace cc
@@ -27,12 +27,52 @@
 
 #include <algorithm>
 #include "base/memory/Memory.h"
+#include "base/memory/MemoryAccounting.h"
 #include "base/std/container/unordered_map.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
 namespace framegraph {
 
+// Whether a free pooled resource may serve a request with a different descriptor, tried when no exact match is free
+template <typename DescriptorType>
+struct DescriptorCompatibility final {
+    static constexpr bool ENABLED = false;
+    static bool           isCompatible(const DescriptorType & /*pooled*/, const DescriptorType & /*requested*/) { return false; }
+};
+
+// Textures differing only in usage share the pool when the pooled usage covers the requested one
+template <>
+struct DescriptorCompatibility<gfx::TextureInfo> final {
+    static constexpr bool ENABLED = true;
+    static bool           isCompatible(const gfx::TextureInfo &pooled, const gfx::TextureInfo &requested) {
+        return pooled.type == requested.type && pooled.format == requested.format &&
+               pooled.width == requested.width && pooled.height == requested.height && pooled.depth == requested.depth &&
+               pooled.flags == requested.flags && pooled.layerCount == requested.layerCount &&
+               pooled.levelCount == requested.levelCount && pooled.samples == requested.samples &&
+               !pooled.externalRes && !requested.externalRes && hasAllFlags(pooled.usage, requested.usage);
+    }
+};
+
+template <typename DescriptorType>
+inline uint64_t getDescriptorMemorySize(const DescriptorType & /*desc*/) noexcept {
+    return 0;
+}
+
+inline uint64_t getDescriptorMemorySize(const gfx::TextureInfo &desc) noexcept {
+    uint64_t size = 0;
+    for (uint32_t level = 0; level < desc.levelCount; ++level) {
+        size += gfx::formatSize(desc.format, std::max(desc.width >> level, 1U), std::max(desc.height >> level, 1U), std::max(desc.depth >> level, 1U));
+    }
+    // the actual sample count of the multisample modes is up to the backends, 4 is the common pick
+    const uint64_t samples = desc.samples == gfx::SampleCount::ONE ? 1 : 4;
+    return size * desc.layerCount * samples;
+}
+
+inline uint64_t getDescriptorMemorySize(const gfx::BufferInfo &desc) noexcept {
+    return desc.size;
+}
+
 template <typename DeviceResourceType, typename DescriptorType, typename DeviceResourceCreatorType>
 class ResourceAllocator final {
 public:
@@ -80,10 +120,27 @@ DeviceResourceType *ResourceAllocator<DeviceResourceType, DescriptorType, Device
             break;
         }
     }
+    if (!resource && DescriptorCompatibility<DescriptorType>::ENABLED) {
+        for (auto &pair : _pool) {
+            if (!DescriptorCompatibility<DescriptorType>::isCompatible(pair.first, desc)) {
+                continue;
+            }
+            for (DeviceResourceType *res : pair.second) {
+                if (_ages[res] >= 0) {
+                    resource = res;
+                    break;
+                }
+            }
+            if (resource) {
+                break;
+            }
+        }
+    }
     if (!resource) {
         DeviceResourceCreator creator;
         resource = creator(desc);
         pool.push_back(resource);
+        CC_MEMORY_ACCOUNT_ALLOC(FRAME_GRAPH, getDescriptorMemorySize(desc));
     }
 
     _ages[resource] = -1;
@@ -105,6 +162,7 @@ template <typename DeviceResourceType, typename DescriptorType, typename DeviceR
 void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreatorType>::gc(uint32_t const unusedFrameCount) noexcept {
     for (auto &pair : _pool) {
         DeviceResourcePool &pool = pair.second;
+        const uint64_t      size = getDescriptorMemorySize(pair.first);
 
         auto count = static_cast<int>(pool.size());
 
@@ -142,6 +200,7 @@ void ResourceAllocator<DeviceResourceType, DescriptorType, DeviceResourceCreator
 
         while (++destroyBegin < count) {
             auto *resource = pool.back();
+            CC_MEMORY_ACCOUNT_FREE(FRAME_GRAPH, size);
             CC_DELETE(resource);
             _ages.erase(resource);
             pool.pop_back();
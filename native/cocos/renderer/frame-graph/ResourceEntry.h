@@ -45,8 +45,10 @@ public:
     void                                   request() noexcept override;
     void                                   release() noexcept override;
     typename ResourceType::DeviceResource *getDeviceResource() const noexcept override;
+    uint64_t                               getMemorySize() const noexcept override;
 
     inline const ResourceType &get() const noexcept { return _resource; }
+    inline ResourceType &      get() noexcept { return _resource; }
 
 private:
     ResourceType _resource;
@@ -81,5 +83,10 @@ typename ResourceType::DeviceResource *ResourceEntry<ResourceType, Enable>::getD
     return _resource.get();
 }
 
+template <typename ResourceType, typename Enable>
+uint64_t ResourceEntry<ResourceType, Enable>::getMemorySize() const noexcept {
+    return getDescriptorMemorySize(_resource.getDesc());
+}
+
 } // namespace framegraph
 } // namespace cc
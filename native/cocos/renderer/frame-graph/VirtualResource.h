@@ -52,6 +52,8 @@ public:
     void         newVersion() noexcept { ++_version; }
 
     virtual gfx::GFXObject *getDeviceResource() const noexcept = 0;
+    // estimated device memory, only counted for textures
+    virtual uint64_t getMemorySize() const noexcept = 0;
 
 private:
     PassNode *         _firstUsePass{nullptr};
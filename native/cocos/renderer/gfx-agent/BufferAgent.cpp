@@ -27,6 +27,7 @@
 
 #include <cstring>
 #include "BufferAgent.h"
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 
 namespace cc {
@@ -38,6 +39,7 @@ BufferAgent::BufferAgent(Buffer *actor)
 }
 
 BufferAgent::~BufferAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         BufferDestruct,
@@ -48,6 +50,10 @@ BufferAgent::~BufferAgent() {
 }
 
 void BufferAgent::doInit(const BufferInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) {
+        capture->create(CaptureOp::CREATE_BUFFER, this, info);
+        capture->bufferResized(this, info.size);
+    }
     uint32_t size = getSize();
     if (size > STAGING_BUFFER_THRESHOLD && hasFlag(_memUsage, MemoryUsageBit::HOST)) {
         for (size_t i = 0; i < DeviceAgent::MAX_FRAME_INDEX; ++i) {
@@ -66,6 +72,7 @@ void BufferAgent::doInit(const BufferInfo &info) {
 }
 
 void BufferAgent::doInit(const BufferViewInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_BUFFER_VIEW, this, info);
     BufferViewInfo actorInfo = info;
     actorInfo.buffer         = static_cast<BufferAgent *>(info.buffer)->getActor();
 
@@ -82,6 +89,10 @@ void BufferAgent::doInit(const BufferViewInfo &info) {
 }
 
 void BufferAgent::doResize(uint32_t size, uint32_t /*count*/) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) {
+        capture->resize(CaptureOp::BUFFER_RESIZE, this, size);
+        capture->bufferResized(this, size);
+    }
     auto *mq = DeviceAgent::getInstance()->getMessageQueue();
 
     if (!_stagingBuffers.empty()) {
@@ -116,6 +127,7 @@ void BufferAgent::doResize(uint32_t size, uint32_t /*count*/) {
 }
 
 void BufferAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     auto *    mq = DeviceAgent::getInstance()->getMessageQueue();
     uint8_t **oldStagingBuffers{nullptr};
     if (!_stagingBuffers.empty()) {
@@ -141,6 +153,8 @@ void BufferAgent::doDestroy() {
 }
 
 void BufferAgent::update(const void *buffer, uint32_t size) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->updateBuffer(this, buffer, size, nullptr);
+    DeviceAgent::getInstance()->countUpload(size);
     uint8_t *actorBuffer{nullptr};
     bool     needFreeing{false};
     auto *   mq{DeviceAgent::getInstance()->getMessageQueue()};
@@ -0,0 +1,402 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <type_traits>
+#include "base/Utils.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+// Binary format shared by CommandCapture and CommandReplayer. A capture is a CaptureHeader, the DeviceInfo of the
+// captured device, which the replaying device should be created with, and a stream of ops, each one the op code, the object ID of the agent it applies to and its serialized arguments. The ops recreating the
+// objects alive when the capture started come first, then the ops of the captured frames, each from ACQUIRE to PRESENT.
+// Object IDs increase in creation order, so the objects an op refers to always have lower IDs than the ones it creates.
+constexpr uint32_t CAPTURE_MAGIC   = 0x43474343; // "CCGC"
+constexpr uint32_t CAPTURE_VERSION = 1;
+
+struct CaptureHeader {
+    uint32_t magic{CAPTURE_MAGIC};
+    uint32_t version{CAPTURE_VERSION};
+    uint32_t frameCount{0};
+    // the objects owned by the device
+    uint32_t queueID{0};
+    uint32_t cmdBuffID{0};
+    uint32_t queryPoolID{0};
+};
+
+enum class CaptureOp : uint32_t {
+    CREATE_BUFFER,
+    CREATE_BUFFER_VIEW,
+    CREATE_TEXTURE,
+    CREATE_TEXTURE_VIEW,
+    CREATE_SWAPCHAIN,
+    CREATE_SHADER,
+    CREATE_INPUT_ASSEMBLER,
+    CREATE_RENDER_PASS,
+    CREATE_FRAMEBUFFER,
+    CREATE_DESCRIPTOR_SET_LAYOUT,
+    CREATE_PIPELINE_LAYOUT,
+    CREATE_PIPELINE_STATE,
+    CREATE_DESCRIPTOR_SET,
+    CREATE_COMMAND_BUFFER,
+    CREATE_QUERY_POOL,
+    DESTROY,
+
+    BUFFER_UPDATE,
+    BUFFER_RESIZE,
+    TEXTURE_RESIZE,
+    SWAPCHAIN_RESIZE,
+    TEXTURE_UPLOAD,
+    DESCRIPTOR_SET_BIND_BUFFER,
+    DESCRIPTOR_SET_BIND_TEXTURE,
+    DESCRIPTOR_SET_BIND_SAMPLER,
+    DESCRIPTOR_SET_UPDATE,
+
+    CMD_BEGIN,
+    CMD_END,
+    CMD_BEGIN_RENDER_PASS,
+    CMD_END_RENDER_PASS,
+    CMD_NEXT_SUBPASS,
+    CMD_BIND_PIPELINE_STATE,
+    CMD_BIND_DESCRIPTOR_SET,
+    CMD_BIND_INPUT_ASSEMBLER,
+    CMD_SET_VIEWPORT,
+    CMD_SET_SCISSOR,
+    CMD_SET_LINE_WIDTH,
+    CMD_SET_DEPTH_BIAS,
+    CMD_SET_BLEND_CONSTANTS,
+    CMD_SET_DEPTH_BOUND,
+    CMD_SET_STENCIL_WRITE_MASK,
+    CMD_SET_STENCIL_COMPARE_MASK,
+    CMD_DRAW,
+    CMD_DRAW_INDIRECT,
+    CMD_UPDATE_BUFFER,
+    CMD_COPY_BUFFERS_TO_TEXTURE,
+    CMD_BLIT_TEXTURE,
+    CMD_EXECUTE,
+    CMD_DISPATCH,
+    CMD_PIPELINE_BARRIER,
+    CMD_BEGIN_QUERY,
+    CMD_END_QUERY,
+    CMD_RESET_QUERY_POOL,
+    CMD_COMPLETE_QUERY_POOL,
+    CMD_WRITE_TIMESTAMP,
+
+    QUEUE_SUBMIT,
+    ACQUIRE,
+    PRESENT,
+    COUNT,
+};
+
+// a borrowed array, serialized as its length followed by the elements
+template <typename T>
+struct CaptureSpan {
+    T *      data{nullptr};
+    uint32_t count{0};
+};
+
+// a borrowed block of bytes
+struct CaptureBlob {
+    const uint8_t *data{nullptr};
+    uint32_t       size{0};
+};
+
+// One function describes the layout of each type for both directions: the writer serializes what it is given, the
+// reader fills what it is given, resizing containers before their elements and resolving object IDs to objects.
+// Structs of fixed-size fields are stored as they are, the others field by field, so that captures don't depend on
+// the pointer size or padding of the platform they come from.
+template <typename T>
+struct IsCaptureRaw : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value> {};
+
+#define CC_CAPTURE_RAW(T) \
+    template <>           \
+    struct IsCaptureRaw<T> : std::true_type {};
+
+CC_CAPTURE_RAW(Offset)
+CC_CAPTURE_RAW(Rect)
+CC_CAPTURE_RAW(Extent)
+CC_CAPTURE_RAW(TextureSubresLayers)
+CC_CAPTURE_RAW(TextureCopy)
+CC_CAPTURE_RAW(TextureBlit)
+CC_CAPTURE_RAW(BufferTextureCopy)
+CC_CAPTURE_RAW(Viewport)
+CC_CAPTURE_RAW(Color)
+CC_CAPTURE_RAW(DrawInfo)
+CC_CAPTURE_RAW(BufferInfo)
+CC_CAPTURE_RAW(SamplerInfo)
+CC_CAPTURE_RAW(GeneralBarrierInfo)
+CC_CAPTURE_RAW(RasterizerState)
+CC_CAPTURE_RAW(DepthStencilState)
+CC_CAPTURE_RAW(BlendTarget)
+
+#undef CC_CAPTURE_RAW
+
+template <typename Archive, typename T>
+std::enable_if_t<IsCaptureRaw<T>::value> serialize(Archive &ar, T &value) {
+    ar.raw(&value, sizeof(T));
+}
+
+template <typename Archive>
+void serialize(Archive &ar, ccstd::string &value) {
+    auto size = utils::toUint(value.size());
+    ar.raw(&size, sizeof(size));
+    if (Archive::READING) value.resize(ar.clampCount(size));
+    ar.raw(&value[0], utils::toUint(value.size()));
+}
+
+template <typename Archive, typename T>
+void serialize(Archive &ar, ccstd::vector<T> &values) {
+    auto size = utils::toUint(values.size());
+    ar.raw(&size, sizeof(size));
+    if (Archive::READING) values.resize(ar.clampCount(size));
+    for (auto &value : values) {
+        serialize(ar, value);
+    }
+}
+
+template <typename Archive, typename T>
+void serialize(Archive &ar, CaptureSpan<T> &span) {
+    ar.raw(&span.count, sizeof(span.count));
+    if (Archive::READING) span.data = ar.template allocate<std::remove_const_t<T>>(span.count);
+    for (uint32_t i = 0; i < span.count; ++i) {
+        serialize(ar, const_cast<std::remove_const_t<T> &>(span.data[i]));
+    }
+}
+
+// the reader points blobs into the capture instead of copying them
+template <typename Archive>
+void serialize(Archive &ar, CaptureBlob &blob) {
+    ar.blob(blob);
+}
+
+// objects are written as their IDs, 0 for nullptr
+template <typename Archive, typename T>
+std::enable_if_t<std::is_base_of<GFXObject, T>::value> serialize(Archive &ar, T *&object) {
+    ar.object(object);
+}
+
+// cached states are recreated from their infos
+template <typename Archive>
+void serialize(Archive &ar, Sampler *&sampler) { ar.sampler(sampler); }
+template <typename Archive>
+void serialize(Archive &ar, GeneralBarrier *&barrier) { ar.generalBarrier(barrier); }
+template <typename Archive>
+void serialize(Archive &ar, TextureBarrier *&barrier) { ar.textureBarrier(barrier); }
+template <typename Archive>
+void serialize(Archive &ar, const GeneralBarrier *&barrier) { ar.generalBarrier(const_cast<GeneralBarrier *&>(barrier)); }
+template <typename Archive>
+void serialize(Archive &ar, const TextureBarrier *&barrier) { ar.textureBarrier(const_cast<TextureBarrier *&>(barrier)); }
+
+template <typename Archive>
+void serializeFields(Archive & /*ar*/) {}
+
+template <typename Archive, typename T, typename... Ts>
+void serializeFields(Archive &ar, T &value, Ts &...values) {
+    serialize(ar, value);
+    serializeFields(ar, values...);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DeviceInfo &info) {
+    auto &mapping = info.bindingMappingInfo;
+    serializeFields(ar, mapping.maxBlockCounts, mapping.maxSamplerTextureCounts, mapping.maxSamplerCounts, mapping.maxTextureCounts,
+                    mapping.maxBufferCounts, mapping.maxImageCounts, mapping.maxSubpassInputCounts, mapping.setIndices);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, TextureInfo &info) {
+    // externalRes can't be captured, such textures are replayed as plain ones
+    serializeFields(ar, info.type, info.usage, info.format, info.width, info.height, info.flags, info.layerCount, info.levelCount, info.samples, info.depth);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, TextureViewInfo &info) {
+    serializeFields(ar, info.texture, info.type, info.format, info.baseLevel, info.levelCount, info.baseLayer, info.layerCount);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, BufferViewInfo &info) {
+    serializeFields(ar, info.buffer, info.offset, info.range);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, SwapchainInfo &info) {
+    serializeFields(ar, info.vsyncMode, info.width, info.height);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, Uniform &info) {
+    serializeFields(ar, info.name, info.type, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformBlock &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.members, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformSamplerTexture &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.type, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformSampler &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformTexture &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.type, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformStorageImage &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.type, info.count, info.memoryAccess);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformStorageBuffer &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.count, info.memoryAccess);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, UniformInputAttachment &info) {
+    serializeFields(ar, info.set, info.binding, info.name, info.count);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, ShaderStage &info) {
+    serializeFields(ar, info.stage, info.source);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, Attribute &info) {
+    serializeFields(ar, info.name, info.format, info.isNormalized, info.stream, info.isInstanced, info.location);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, ShaderInfo &info) {
+    serializeFields(ar, info.name, info.stages, info.attributes, info.blocks, info.buffers, info.samplerTextures, info.samplers,
+                    info.textures, info.images, info.subpassInputs);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, InputAssemblerInfo &info) {
+    serializeFields(ar, info.attributes, info.vertexBuffers, info.indexBuffer, info.indirectBuffer);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, ColorAttachment &info) {
+    serializeFields(ar, info.format, info.sampleCount, info.loadOp, info.storeOp, info.barrier, info.isGeneralLayout);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DepthStencilAttachment &info) {
+    serializeFields(ar, info.format, info.sampleCount, info.depthLoadOp, info.depthStoreOp, info.stencilLoadOp, info.stencilStoreOp,
+                    info.barrier, info.isGeneralLayout);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, SubpassInfo &info) {
+    serializeFields(ar, info.inputs, info.colors, info.resolves, info.preserves, info.depthStencil, info.depthStencilResolve,
+                    info.depthResolveMode, info.stencilResolveMode);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, SubpassDependency &info) {
+    serializeFields(ar, info.srcSubpass, info.dstSubpass, info.barrier);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, RenderPassInfo &info) {
+    serializeFields(ar, info.colorAttachments, info.depthStencilAttachment, info.subpasses, info.dependencies);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, TextureBarrierInfo &info) {
+    serializeFields(ar, info.prevAccesses, info.nextAccesses, info.discardContents, info.srcQueue, info.dstQueue);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, FramebufferInfo &info) {
+    serializeFields(ar, info.renderPass, info.colorTextures, info.depthStencilTexture);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DescriptorSetLayoutBinding &info) {
+    serializeFields(ar, info.binding, info.descriptorType, info.count, info.stageFlags, info.immutableSamplers);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DescriptorSetLayoutInfo &info) {
+    serializeFields(ar, info.bindings);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DescriptorSetInfo &info) {
+    serializeFields(ar, info.layout);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, PipelineLayoutInfo &info) {
+    serializeFields(ar, info.setLayouts);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, BlendState &info) {
+    serializeFields(ar, info.isA2C, info.isIndepend, info.blendColor, info.targets);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, PipelineStateInfo &info) {
+    serializeFields(ar, info.shader, info.pipelineLayout, info.renderPass, info.inputState.attributes, info.rasterizerState,
+                    info.depthStencilState, info.blendState, info.primitive, info.dynamicStates, info.bindPoint, info.subpass);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, CommandBufferInfo &info) {
+    serializeFields(ar, info.queue, info.type);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, QueryPoolInfo &info) {
+    serializeFields(ar, info.type, info.maxQueryObjects, info.forceWait);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DispatchInfo &info) {
+    serializeFields(ar, info.groupCountX, info.groupCountY, info.groupCountZ, info.indirectBuffer, info.indirectOffset);
+}
+
+template <typename Archive>
+void serialize(Archive &ar, DrawIndirectInfo &info) {
+    serializeFields(ar, info.buffer, info.offset, info.drawCount, info.stride, info.countBuffer, info.countOffset);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -26,6 +26,7 @@
 #include "CommandBufferAgent.h"
 #include <cstring>
 #include "BufferAgent.h"
+#include "CommandCapture.h"
 #include "DescriptorSetAgent.h"
 #include "DeviceAgent.h"
 #include "FramebufferAgent.h"
@@ -77,6 +78,7 @@ void CommandBufferAgent::flushCommands(uint32_t count, CommandBufferAgent *const
 }
 
 CommandBufferAgent::~CommandBufferAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     destroyMessageQueue();
 
     ENQUEUE_MESSAGE_1(
@@ -114,6 +116,7 @@ void CommandBufferAgent::destroyAgent() {
 }
 
 void CommandBufferAgent::doInit(const CommandBufferInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_COMMAND_BUFFER, this, info);
     initMessageQueue();
 
     CommandBufferInfo actorInfo = info;
@@ -129,6 +132,7 @@ void CommandBufferAgent::doInit(const CommandBufferInfo &info) {
 }
 
 void CommandBufferAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     destroyMessageQueue();
 
     ENQUEUE_MESSAGE_1(
@@ -140,19 +144,23 @@ void CommandBufferAgent::doDestroy() {
 }
 
 void CommandBufferAgent::begin(RenderPass *renderPass, uint32_t subpass, Framebuffer *frameBuffer) {
-    ENQUEUE_MESSAGE_4(
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BEGIN, this, renderPass, subpass, frameBuffer);
+    ENQUEUE_MESSAGE_5(
         _messageQueue,
         CommandBufferBegin,
         actor, getActor(),
         renderPass, renderPass ? static_cast<RenderPassAgent *>(renderPass)->getActor() : nullptr,
         subpass, subpass,
         frameBuffer, frameBuffer ? static_cast<FramebufferAgent *>(frameBuffer)->getActor() : nullptr,
+        agent, this,
         {
+            agent->_skipDraws = false;
             actor->begin(renderPass, subpass, frameBuffer);
         });
 }
 
 void CommandBufferAgent::end() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_END, this);
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEnd,
         actor, getActor(),
@@ -163,6 +171,10 @@ void CommandBufferAgent::end() {
 
 void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors, float depth, uint32_t stencil, CommandBuffer *const *secondaryCBs, uint32_t secondaryCBCount) {
     auto   attachmentCount = utils::toUint(renderPass->getColorAttachments().size());
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) {
+        capture->record(CaptureOp::CMD_BEGIN_RENDER_PASS, this, renderPass, fbo, renderArea, CaptureSpan<const Color>{colors, attachmentCount}, depth, stencil,
+                        CaptureSpan<CommandBuffer *const>{secondaryCBs, secondaryCBCount});
+    }
     Color *actorColors     = nullptr;
     if (attachmentCount) {
         actorColors = _messageQueue->allocate<Color>(attachmentCount);
@@ -194,6 +206,7 @@ void CommandBufferAgent::beginRenderPass(RenderPass *renderPass, Framebuffer *fb
 }
 
 void CommandBufferAgent::endRenderPass() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_END_RENDER_PASS, this);
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferEndRenderPass,
         actor, getActor(),
@@ -204,33 +217,65 @@ void CommandBufferAgent::endRenderPass() {
 
 void CommandBufferAgent::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_EXECUTE, this, CaptureSpan<CommandBuffer *const>{cmdBuffs, count});
 
-    auto **actorCmdBuffs = _messageQueue->allocate<CommandBuffer *>(count);
+    // secondary command buffers are never submitted, their commands are replayed right before they are executed
+    const bool multithreaded = DeviceAgent::getInstance()->_multithreaded;
+    auto **    actorCmdBuffs = _messageQueue->allocate<CommandBuffer *>(count);
+    auto **    agentCmdBuffs = _messageQueue->allocate<CommandBufferAgent *>(count);
     for (uint32_t i = 0; i < count; ++i) {
-        actorCmdBuffs[i] = static_cast<CommandBufferAgent *>(cmdBuffs[i])->getActor();
+        auto *agentCmdBuff = static_cast<CommandBufferAgent *>(cmdBuffs[i]);
+        actorCmdBuffs[i]   = agentCmdBuff->getActor();
+        agentCmdBuffs[i]   = agentCmdBuff;
+        if (multithreaded) {
+            MessageQueue::freeChunksInFreeQueue(agentCmdBuff->_messageQueue);
+            agentCmdBuff->_messageQueue->finishWriting();
+        }
     }
 
-    ENQUEUE_MESSAGE_3(
+    ENQUEUE_MESSAGE_5(
         _messageQueue, CommandBufferExecute,
         actor, getActor(),
         cmdBuffs, actorCmdBuffs,
+        agentCmdBuffs, agentCmdBuffs,
         count, count,
+        multithreaded, multithreaded,
         {
+            if (multithreaded) {
+                // this may already run on a job thread, don't spawn nested jobs
+                CommandBufferAgent::flushCommands(count, agentCmdBuffs, false);
+            }
             actor->execute(cmdBuffs, count);
         });
 }
 
 void CommandBufferAgent::bindPipelineState(PipelineState *pso) {
-    ENQUEUE_MESSAGE_2(
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BIND_PIPELINE_STATE, this, pso);
+    DeviceAgent::getInstance()->countPipelineStateBind();
+    auto *psoAgent = static_cast<PipelineStateAgent *>(pso);
+
+    ENQUEUE_MESSAGE_5(
         _messageQueue, CommandBufferBindPipelineState,
         actor, getActor(),
-        pso, static_cast<PipelineStateAgent *>(pso)->getActor(),
+        pso, psoAgent->getActor(),
+        compilation, psoAgent->getCompilation(),
+        skipIfCompiling, DeviceAgent::getInstance()->getAsyncPipelineStatePolicy() == AsyncPipelineStatePolicy::SKIP,
+        agent, this,
         {
+            if (compilation && !compilation->ready) {
+                if (skipIfCompiling) {
+                    agent->_skipDraws = true;
+                    return;
+                }
+                compilation->future.wait();
+            }
+            agent->_skipDraws = false;
             actor->bindPipelineState(pso);
         });
 }
 
 void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descriptorSet, uint32_t dynamicOffsetCount, const uint32_t *dynamicOffsets) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BIND_DESCRIPTOR_SET, this, set, descriptorSet, CaptureSpan<const uint32_t>{dynamicOffsets, dynamicOffsetCount});
     uint32_t *actorDynamicOffsets = nullptr;
     if (dynamicOffsetCount) {
         actorDynamicOffsets = _messageQueue->allocate<uint32_t>(dynamicOffsetCount);
@@ -250,6 +295,7 @@ void CommandBufferAgent::bindDescriptorSet(uint32_t set, DescriptorSet *descript
 }
 
 void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BIND_INPUT_ASSEMBLER, this, ia);
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferBindInputAssembler,
         actor, getActor(),
@@ -260,6 +306,7 @@ void CommandBufferAgent::bindInputAssembler(InputAssembler *ia) {
 }
 
 void CommandBufferAgent::setViewport(const Viewport &vp) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_VIEWPORT, this, vp);
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetViewport,
         actor, getActor(),
@@ -270,6 +317,7 @@ void CommandBufferAgent::setViewport(const Viewport &vp) {
 }
 
 void CommandBufferAgent::setScissor(const Rect &rect) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_SCISSOR, this, rect);
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetScissor,
         actor, getActor(),
@@ -280,6 +328,7 @@ void CommandBufferAgent::setScissor(const Rect &rect) {
 }
 
 void CommandBufferAgent::setLineWidth(float width) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_LINE_WIDTH, this, width);
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetLineWidth,
         actor, getActor(),
@@ -290,6 +339,7 @@ void CommandBufferAgent::setLineWidth(float width) {
 }
 
 void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_DEPTH_BIAS, this, constant, clamp, slope);
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetDepthBias,
         actor, getActor(),
@@ -302,6 +352,7 @@ void CommandBufferAgent::setDepthBias(float constant, float clamp, float slope)
 }
 
 void CommandBufferAgent::setBlendConstants(const Color &constants) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_BLEND_CONSTANTS, this, constants);
     ENQUEUE_MESSAGE_2(
         _messageQueue, CommandBufferSetBlendConstants,
         actor, getActor(),
@@ -312,6 +363,7 @@ void CommandBufferAgent::setBlendConstants(const Color &constants) {
 }
 
 void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_DEPTH_BOUND, this, minBounds, maxBounds);
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetDepthBound,
         actor, getActor(),
@@ -323,6 +375,7 @@ void CommandBufferAgent::setDepthBound(float minBounds, float maxBounds) {
 }
 
 void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_STENCIL_WRITE_MASK, this, face, mask);
     ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferSetStencilWriteMask,
         actor, getActor(),
@@ -334,6 +387,7 @@ void CommandBufferAgent::setStencilWriteMask(StencilFace face, uint32_t mask) {
 }
 
 void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_SET_STENCIL_COMPARE_MASK, this, face, ref, mask);
     ENQUEUE_MESSAGE_4(
         _messageQueue, CommandBufferSetStencilCompareMask,
         actor, getActor(),
@@ -346,6 +400,7 @@ void CommandBufferAgent::setStencilCompareMask(StencilFace face, uint32_t ref, u
 }
 
 void CommandBufferAgent::nextSubpass() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_NEXT_SUBPASS, this);
     ENQUEUE_MESSAGE_1(
         _messageQueue, CommandBufferNextSubpass,
         actor, getActor(),
@@ -355,16 +410,36 @@ void CommandBufferAgent::nextSubpass() {
 }
 
 void CommandBufferAgent::draw(const DrawInfo &info) {
-    ENQUEUE_MESSAGE_2(
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_DRAW, this, info);
+    ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferDraw,
         actor, getActor(),
         info, info,
+        agent, this,
         {
-            actor->draw(info);
+            if (!agent->_skipDraws) actor->draw(info);
+        });
+}
+
+void CommandBufferAgent::drawIndirect(const DrawIndirectInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_DRAW_INDIRECT, this, info);
+    DrawIndirectInfo actorInfo = info;
+    actorInfo.buffer           = static_cast<BufferAgent *>(info.buffer)->getActor();
+    if (info.countBuffer) actorInfo.countBuffer = static_cast<BufferAgent *>(info.countBuffer)->getActor();
+
+    ENQUEUE_MESSAGE_3(
+        _messageQueue, CommandBufferDrawIndirect,
+        actor, getActor(),
+        info, actorInfo,
+        agent, this,
+        {
+            if (!agent->_skipDraws) actor->drawIndirect(info);
         });
 }
 
 void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->updateBuffer(buff, data, size, this);
+    DeviceAgent::getInstance()->countUpload(size);
     auto *bufferAgent = static_cast<BufferAgent *>(buff);
 
     uint8_t *actorBuffer{nullptr};
@@ -387,6 +462,7 @@ void CommandBufferAgent::updateBuffer(Buffer *buff, const void *data, uint32_t s
 }
 
 void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BLIT_TEXTURE, this, srcTexture, dstTexture, CaptureSpan<const TextureBlit>{regions, count}, filter);
     Texture *actorSrcTexture = nullptr;
     Texture *actorDstTexture = nullptr;
     if (srcTexture) actorSrcTexture = static_cast<TextureAgent *>(srcTexture)->getActor();
@@ -409,19 +485,22 @@ void CommandBufferAgent::blitTexture(Texture *srcTexture, Texture *dstTexture, c
 }
 
 void CommandBufferAgent::dispatch(const DispatchInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_DISPATCH, this, info);
     DispatchInfo actorInfo = info;
     if (info.indirectBuffer) actorInfo.indirectBuffer = static_cast<BufferAgent *>(info.indirectBuffer)->getActor();
 
-    ENQUEUE_MESSAGE_2(
+    ENQUEUE_MESSAGE_3(
         _messageQueue, CommandBufferDispatch,
         actor, getActor(),
         info, actorInfo,
+        agent, this,
         {
-            actor->dispatch(info);
+            if (!agent->_skipDraws) actor->dispatch(info);
         });
 }
 
 void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint32_t textureBarrierCount) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_PIPELINE_BARRIER, this, barrier, CaptureSpan<const TextureBarrier *const>{textureBarriers, textureBarrierCount}, CaptureSpan<const Texture *const>{textures, textureBarrierCount});
     TextureBarrier **actorTextureBarriers = nullptr;
     Texture **       actorTextures        = nullptr;
 
@@ -448,6 +527,7 @@ void CommandBufferAgent::pipelineBarrier(const GeneralBarrier *barrier, const Te
 }
 
 void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_BEGIN_QUERY, this, queryPool, id);
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -461,6 +541,7 @@ void CommandBufferAgent::beginQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_END_QUERY, this, queryPool, id);
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_3(
@@ -474,6 +555,7 @@ void CommandBufferAgent::endQuery(QueryPool *queryPool, uint32_t id) {
 }
 
 void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_RESET_QUERY_POOL, this, queryPool);
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
@@ -486,6 +568,7 @@ void CommandBufferAgent::resetQueryPool(QueryPool *queryPool) {
 }
 
 void CommandBufferAgent::completeQueryPool(QueryPool *queryPool) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_COMPLETE_QUERY_POOL, this, queryPool);
     auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
 
     ENQUEUE_MESSAGE_2(
@@ -497,5 +580,19 @@ void CommandBufferAgent::completeQueryPool(QueryPool *queryPool) {
         });
 }
 
+void CommandBufferAgent::writeTimestamp(QueryPool *queryPool, uint32_t id) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::CMD_WRITE_TIMESTAMP, this, queryPool, id);
+    auto *actorQueryPool = static_cast<QueryPoolAgent *>(queryPool)->getActor();
+
+    ENQUEUE_MESSAGE_3(
+        _messageQueue, CommandBufferWriteTimestamp,
+        actor, getActor(),
+        queryPool, actorQueryPool,
+        id, id,
+        {
+            actor->writeTimestamp(queryPool, id);
+        });
+}
+
 } // namespace gfx
 } // namespace cc
@@ -58,6 +58,7 @@ public:
     void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask) override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
+    void drawIndirect(const DrawIndirectInfo &info) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
@@ -68,6 +69,7 @@ public:
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
     void completeQueryPool(QueryPool *queryPool) override;
+    void writeTimestamp(QueryPool *queryPool, uint32_t id) override;
 
     uint32_t getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t getNumInstances() const override { return _actor->getNumInstances(); }
@@ -87,6 +89,9 @@ protected:
     void          initMessageQueue();
     void          destroyMessageQueue();
     MessageQueue *_messageQueue = nullptr;
+
+    // render thread only, set while the bound pipeline state is still compiling under AsyncPipelineStatePolicy::SKIP
+    bool _skipDraws{false};
 };
 
 } // namespace gfx
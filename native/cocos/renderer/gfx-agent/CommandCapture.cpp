@@ -0,0 +1,238 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CommandCapture.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Data.h"
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+// whether region a overwrites all of region b
+bool covers(const BufferTextureCopy &a, const BufferTextureCopy &b) {
+    const auto &subresA = a.texSubres;
+    const auto &subresB = b.texSubres;
+    return subresA.mipLevel == subresB.mipLevel &&
+           subresA.baseArrayLayer <= subresB.baseArrayLayer && subresA.baseArrayLayer + subresA.layerCount >= subresB.baseArrayLayer + subresB.layerCount &&
+           a.texOffset.x <= b.texOffset.x && a.texOffset.x + a.texExtent.width >= b.texOffset.x + b.texExtent.width &&
+           a.texOffset.y <= b.texOffset.y && a.texOffset.y + a.texExtent.height >= b.texOffset.y + b.texExtent.height &&
+           a.texOffset.z <= b.texOffset.z && a.texOffset.z + a.texExtent.depth >= b.texOffset.z + b.texExtent.depth;
+}
+} // namespace
+
+void CommandCapture::Writer::blob(const CaptureBlob &blob) {
+    raw(&blob.size, sizeof(blob.size));
+    raw(blob.data, blob.size);
+}
+
+void CommandCapture::Writer::sampler(const Sampler *sampler) {
+    uint8_t valid = sampler ? 1 : 0;
+    raw(&valid, sizeof(valid));
+    if (sampler) raw(&sampler->getInfo(), sizeof(SamplerInfo));
+}
+
+void CommandCapture::Writer::generalBarrier(const GeneralBarrier *barrier) {
+    uint8_t valid = barrier ? 1 : 0;
+    raw(&valid, sizeof(valid));
+    if (barrier) raw(&barrier->getInfo(), sizeof(GeneralBarrierInfo));
+}
+
+void CommandCapture::Writer::textureBarrier(const TextureBarrier *barrier) {
+    uint8_t valid = barrier ? 1 : 0;
+    raw(&valid, sizeof(valid));
+    if (barrier) serialize(*this, const_cast<TextureBarrierInfo &>(barrier->getInfo()));
+}
+
+CommandCapture::CommandCapture(const DeviceInfo &deviceInfo, const GFXObject *queue, const GFXObject *cmdBuff, const GFXObject *queryPool) {
+    _header.queueID     = queue->getObjectID();
+    _header.cmdBuffID   = cmdBuff->getObjectID();
+    _header.queryPoolID = queryPool->getObjectID();
+
+    Writer writer(_deviceInfo);
+    serialize(writer, const_cast<DeviceInfo &>(deviceInfo));
+}
+
+bool CommandCapture::start(const ccstd::string &path, uint32_t frames) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending || _recording || !frames) {
+        return false;
+    }
+
+    auto *fileUtils    = FileUtils::getInstance();
+    _path              = fileUtils->isAbsolutePath(path) ? path : fileUtils->getWritablePath() + path;
+    _framesLeft        = frames;
+    _header.frameCount = frames;
+    _pending           = true;
+    return true;
+}
+
+bool CommandCapture::isCapturing() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pending || _recording;
+}
+
+void CommandCapture::destroy(const GFXObject *object) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // destroy() of an agent which has already been destroyed
+    if (!_objects.erase(object->getObjectID())) return;
+    if (_recording) encode(_stream, CaptureOp::DESTROY, object);
+}
+
+void CommandCapture::bufferResized(const GFXObject *buffer, uint32_t size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _objects[buffer->getObjectID()].contents.resize(size);
+}
+
+void CommandCapture::updateBuffer(const Buffer *buffer, const void *data, uint32_t size, CommandBuffer *cmdBuff) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &contents = _objects[buffer->getObjectID()].contents;
+    if (contents.size() < size) contents.resize(size);
+    memcpy(contents.data(), data, size);
+
+    if (!_recording) return;
+    CaptureBlob blob{static_cast<const uint8_t *>(data), size};
+    if (cmdBuff) {
+        encode(_stream, CaptureOp::CMD_UPDATE_BUFFER, cmdBuff, buffer, blob);
+    } else {
+        encode(_stream, CaptureOp::BUFFER_UPDATE, buffer, blob);
+    }
+}
+
+void CommandCapture::uploadTexture(const Texture *texture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count, CommandBuffer *cmdBuff) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto &uploads = _objects[texture->getObjectID()].uploads;
+
+    // one upload per region, with one buffer per layer like the agents copy them
+    ccstd::vector<CaptureBlob> layers;
+    for (uint32_t i = 0U, n = 0U; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+
+        uint32_t size = formatSize(texture->getFormat(), region.texExtent.width, region.texExtent.height, 1);
+        layers.resize(region.texSubres.layerCount);
+        for (auto &layer : layers) {
+            layer = {buffers[n++], size};
+        }
+
+        uploads.erase(std::remove_if(uploads.begin(), uploads.end(), [&](const TextureUpload &upload) { return covers(region, upload.region); }), uploads.end());
+        uploads.emplace_back();
+        uploads.back().region = region;
+        encode(uploads.back().bytes, CaptureOp::TEXTURE_UPLOAD, texture, region, layers);
+
+        if (!_recording) continue;
+        if (cmdBuff) {
+            encode(_stream, CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE, cmdBuff, texture, region, layers);
+        } else {
+            _stream.insert(_stream.end(), uploads.back().bytes.begin(), uploads.back().bytes.end());
+        }
+    }
+}
+
+void CommandCapture::updateDescriptorSet(const GFXObject *descriptorSet) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _objects[descriptorSet->getObjectID()].updated = true;
+    if (_recording) encode(_stream, CaptureOp::DESCRIPTOR_SET_UPDATE, descriptorSet);
+}
+
+void CommandCapture::acquire(Swapchain *const *swapchains, uint32_t count) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending) {
+        _pending   = false;
+        _recording = true;
+        writeState();
+    }
+    if (_recording) encode(_stream, CaptureOp::ACQUIRE, nullptr, CaptureSpan<Swapchain *const>{swapchains, count});
+}
+
+void CommandCapture::present() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_recording) return;
+
+    encode(_stream, CaptureOp::PRESENT, nullptr);
+    if (--_framesLeft == 0) finish();
+}
+
+void CommandCapture::writeState() {
+    _stream.clear();
+
+    // creations first, the contents and bindings may refer to objects created after their owners
+    for (const auto &entry : _objects) {
+        const ObjectState &state = entry.second;
+        if (state.creation.empty()) continue;
+        _stream.insert(_stream.end(), state.creation.begin(), state.creation.end());
+        _stream.insert(_stream.end(), state.resize.begin(), state.resize.end());
+    }
+
+    CaptureBlob contents;
+    for (const auto &entry : _objects) {
+        const ObjectState &state = entry.second;
+        if (state.creation.empty()) continue;
+
+        if (!state.contents.empty()) {
+            contents = {state.contents.data(), utils::toUint(state.contents.size())};
+            Writer writer(_stream);
+            auto   op = CaptureOp::BUFFER_UPDATE;
+            writer.raw(&op, sizeof(op));
+            writer.raw(&entry.first, sizeof(entry.first));
+            writer.blob(contents);
+        }
+        for (const auto &upload : state.uploads) {
+            _stream.insert(_stream.end(), upload.bytes.begin(), upload.bytes.end());
+        }
+        for (const auto &binding : state.bindings) {
+            _stream.insert(_stream.end(), binding.second.begin(), binding.second.end());
+        }
+        if (state.updated) {
+            Writer writer(_stream);
+            auto   op = CaptureOp::DESCRIPTOR_SET_UPDATE;
+            writer.raw(&op, sizeof(op));
+            writer.raw(&entry.first, sizeof(entry.first));
+        }
+    }
+}
+
+void CommandCapture::finish() {
+    _recording = false;
+
+    Data file;
+    file.resize(static_cast<ssize_t>(sizeof(_header) + _deviceInfo.size() + _stream.size()));
+    auto *bytes = file.getBytes();
+    memcpy(bytes, &_header, sizeof(_header));
+    memcpy(bytes + sizeof(_header), _deviceInfo.data(), _deviceInfo.size());
+    memcpy(bytes + sizeof(_header) + _deviceInfo.size(), _stream.data(), _stream.size());
+    ccstd::vector<uint8_t>().swap(_stream);
+
+    if (FileUtils::getInstance()->writeDataToFile(file, _path)) {
+        CC_LOG_INFO("CommandCapture: %u frames written to %s", _header.frameCount, _path.c_str());
+    } else {
+        CC_LOG_ERROR("CommandCapture: failed to write %s", _path.c_str());
+    }
+}
+
+} // namespace gfx
+} // namespace cc
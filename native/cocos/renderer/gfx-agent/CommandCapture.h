@@ -0,0 +1,160 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include "CaptureFormat.h"
+#include "base/std/container/map.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+// Records the calls made to the agents. While armed it keeps what is needed to recreate the objects alive at any time,
+// their creation infos, the last contents of the buffers, the texture uploads and the descriptor set bindings, so that
+// a capture can start at any frame. Render targets are recreated empty, their contents come from the captured frames.
+// All methods are thread safe, secondary command buffers may be recorded on any thread.
+class CC_DLL CommandCapture final {
+public:
+    CommandCapture(const DeviceInfo &deviceInfo, const GFXObject *queue, const GFXObject *cmdBuff, const GFXObject *queryPool);
+
+    // records the calls of the next frames, from the next acquire to the frames-th present after it
+    bool start(const ccstd::string &path, uint32_t frames);
+    bool isCapturing() const;
+
+    template <typename... Args>
+    void create(CaptureOp op, const GFXObject *object, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // objects initialized again start over
+        auto &state = _objects[object->getObjectID()];
+        state       = {};
+        encode(state.creation, op, object, args...);
+        if (_recording) _stream.insert(_stream.end(), state.creation.begin(), state.creation.end());
+    }
+
+    // frame commands, dropped unless a capture is recording
+    template <typename... Args>
+    void record(CaptureOp op, const GFXObject *object, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_recording) encode(_stream, op, object, args...);
+    }
+
+    // resizes of buffers, textures and swapchains, the last one is kept
+    template <typename... Args>
+    void resize(CaptureOp op, const GFXObject *object, const Args &...args) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto &state = _objects[object->getObjectID()];
+        state.resize.clear();
+        encode(state.resize, op, object, args...);
+        if (_recording) _stream.insert(_stream.end(), state.resize.begin(), state.resize.end());
+    }
+
+    // a descriptor set binding, the last one of each binding and index is kept
+    template <typename T>
+    void bind(CaptureOp op, const GFXObject *descriptorSet, uint32_t binding, uint32_t index, T *object) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto &bytes = _objects[descriptorSet->getObjectID()].bindings[(binding << 16) | index];
+        bytes.clear();
+        encode(bytes, op, descriptorSet, binding, index, object);
+        if (_recording) _stream.insert(_stream.end(), bytes.begin(), bytes.end());
+    }
+
+    void destroy(const GFXObject *object);
+    void bufferResized(const GFXObject *buffer, uint32_t size);
+    void updateBuffer(const Buffer *buffer, const void *data, uint32_t size, CommandBuffer *cmdBuff);
+    void uploadTexture(const Texture *texture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count, CommandBuffer *cmdBuff);
+    void updateDescriptorSet(const GFXObject *descriptorSet);
+    void acquire(Swapchain *const *swapchains, uint32_t count);
+    void present();
+
+private:
+    struct TextureUpload {
+        BufferTextureCopy      region;
+        ccstd::vector<uint8_t> bytes; // the encoded TEXTURE_UPLOAD op
+    };
+
+    struct ObjectState {
+        ccstd::vector<uint8_t>                       creation;
+        ccstd::vector<uint8_t>                       resize;
+        ccstd::vector<uint8_t>                       contents; // of buffers
+        ccstd::vector<TextureUpload>                 uploads;  // in upload order, the last one of each region only
+        ccstd::map<uint32_t, ccstd::vector<uint8_t>> bindings;
+        bool                                         updated{false};
+    };
+
+    struct Writer {
+        static constexpr bool READING = false;
+
+        explicit Writer(ccstd::vector<uint8_t> &out) : bytes(out) {}
+
+        void raw(const void *data, uint32_t size) {
+            const auto *begin = static_cast<const uint8_t *>(data);
+            bytes.insert(bytes.end(), begin, begin + size);
+        }
+        void     blob(const CaptureBlob &blob);
+        void     sampler(const Sampler *sampler);
+        void     generalBarrier(const GeneralBarrier *barrier);
+        void     textureBarrier(const TextureBarrier *barrier);
+        uint32_t clampCount(uint32_t count) const { return count; }
+
+        template <typename T>
+        void object(T *object) {
+            uint32_t id = object ? object->getObjectID() : 0U;
+            raw(&id, sizeof(id));
+        }
+        template <typename T>
+        T *allocate(uint32_t /*count*/) { return nullptr; }
+
+        ccstd::vector<uint8_t> &bytes;
+    };
+
+    template <typename... Args>
+    static void encode(ccstd::vector<uint8_t> &out, CaptureOp op, const GFXObject *object, const Args &...args) {
+        Writer   writer(out);
+        uint32_t id = object ? object->getObjectID() : 0U;
+        writer.raw(&op, sizeof(op));
+        writer.raw(&id, sizeof(id));
+        serializeFields(writer, const_cast<Args &>(args)...);
+    }
+
+    void writeState();
+    void finish();
+
+    mutable std::mutex _mutex;
+
+    CaptureHeader                     _header;
+    ccstd::vector<uint8_t>            _deviceInfo;
+    ccstd::map<uint32_t, ObjectState> _objects; // by ID, so in creation order
+    ccstd::vector<uint8_t>            _stream;
+    ccstd::string                     _path;
+    uint32_t                          _framesLeft{0};
+    bool                              _pending{false};
+    bool                              _recording{false};
+};
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,686 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "CommandReplayer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "base/Log.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+template <typename T>
+std::enable_if_t<std::is_base_of<RefCounted, T>::value> releaseObject(GFXObject *object) {
+    auto *typed = static_cast<T *>(object);
+    typed->destroy();
+    typed->release();
+}
+
+template <typename T>
+std::enable_if_t<!std::is_base_of<RefCounted, T>::value> releaseObject(GFXObject *object) {
+    auto *typed = static_cast<T *>(object);
+    typed->destroy();
+    CC_DELETE(typed);
+}
+
+template <typename T>
+std::enable_if_t<std::is_base_of<RefCounted, T>::value> retainObject(T *object) {
+    object->addRef();
+}
+
+template <typename T>
+std::enable_if_t<!std::is_base_of<RefCounted, T>::value> retainObject(T * /*object*/) {}
+} // namespace
+
+struct CommandReplayer::Reader {
+    static constexpr bool READING = true;
+
+    Reader(const CommandReplayer *replayer, const uint8_t *data, uint32_t size, uint32_t offset)
+    : replayer(replayer), data(data), size(size), offset(offset) {}
+
+    void raw(void *dst, uint32_t count) {
+        if (failed || count > size - offset) {
+            failed = true;
+            if (count) memset(dst, 0, count);
+            return;
+        }
+        memcpy(dst, data + offset, count);
+        offset += count;
+    }
+
+    void blob(CaptureBlob &blob) {
+        raw(&blob.size, sizeof(blob.size));
+        if (failed || blob.size > size - offset) {
+            failed = true;
+            blob   = {};
+            return;
+        }
+        blob.data = data + offset;
+        offset += blob.size;
+    }
+
+    // elements take a byte at least, so a corrupted count can't allocate more than the capture size
+    uint32_t clampCount(uint32_t count) const { return failed ? 0U : std::min(count, size - offset); }
+
+    template <typename T>
+    T *allocate(uint32_t count) {
+        if (!count || failed) return nullptr;
+        scratch.emplace_back((count * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        return reinterpret_cast<T *>(scratch.back().data());
+    }
+
+    template <typename T>
+    void object(T *&object) {
+        uint32_t id{0};
+        raw(&id, sizeof(id));
+        object = replayer->get<T>(id);
+    }
+
+    void sampler(Sampler *&sampler) {
+        uint8_t valid{0};
+        raw(&valid, sizeof(valid));
+        sampler = nullptr;
+        if (!valid) return;
+        SamplerInfo info;
+        raw(&info, sizeof(info));
+        if (!failed) sampler = replayer->_device->getSampler(info);
+    }
+
+    void generalBarrier(GeneralBarrier *&barrier) {
+        uint8_t valid{0};
+        raw(&valid, sizeof(valid));
+        barrier = nullptr;
+        if (!valid) return;
+        GeneralBarrierInfo info;
+        raw(&info, sizeof(info));
+        if (!failed) barrier = replayer->_device->getGeneralBarrier(info);
+    }
+
+    void textureBarrier(TextureBarrier *&barrier) {
+        uint8_t valid{0};
+        raw(&valid, sizeof(valid));
+        barrier = nullptr;
+        if (!valid) return;
+        TextureBarrierInfo info;
+        serialize(*this, info);
+        if (!failed) barrier = replayer->_device->getTextureBarrier(info);
+    }
+
+    CaptureOp peek() const {
+        CaptureOp op{CaptureOp::COUNT};
+        if (sizeof(op) <= size - offset) memcpy(&op, data + offset, sizeof(op));
+        return op;
+    }
+
+    const CommandReplayer *                 replayer{nullptr};
+    const uint8_t *                         data{nullptr};
+    uint32_t                                size{0};
+    uint32_t                                offset{0};
+    bool                                    failed{false};
+    ccstd::vector<ccstd::vector<uint64_t>> scratch; // arrays of the current op
+};
+
+bool CommandReplayer::mapCapture(const ccstd::string &path, MappedFile *outFile, CaptureHeader *outHeader) {
+    auto *fileUtils = FileUtils::getInstance();
+    *outFile        = fileUtils->mapFile(fileUtils->isAbsolutePath(path) ? path : fileUtils->getWritablePath() + path);
+    if (outFile->getSize() < sizeof(CaptureHeader)) {
+        CC_LOG_ERROR("CommandReplayer: failed to load %s", path.c_str());
+        return false;
+    }
+    memcpy(outHeader, outFile->getBytes(), sizeof(CaptureHeader));
+    if (outHeader->magic != CAPTURE_MAGIC || outHeader->version != CAPTURE_VERSION || !outHeader->frameCount) {
+        CC_LOG_ERROR("CommandReplayer: %s is not a capture of version %u", path.c_str(), CAPTURE_VERSION);
+        return false;
+    }
+    return true;
+}
+
+bool CommandReplayer::loadDeviceInfo(const ccstd::string &path, DeviceInfo *outInfo) {
+    MappedFile    file;
+    CaptureHeader header;
+    if (!mapCapture(path, &file, &header)) {
+        return false;
+    }
+
+    Reader reader(nullptr, file.getBytes(), utils::toUint(file.getSize()), sizeof(header));
+    serialize(reader, *outInfo);
+    return !reader.failed;
+}
+
+CommandReplayer::CommandReplayer(Device *device) : _device(device) {}
+
+CommandReplayer::~CommandReplayer() {
+    destroy();
+}
+
+bool CommandReplayer::load(const ccstd::string &path, Swapchain *swapchain) {
+    destroy();
+
+    if (!mapCapture(path, &_file, &_header)) {
+        destroy();
+        return false;
+    }
+
+    _swapchain = swapchain;
+    alias(_header.queueID, _device->getQueue());
+    alias(_header.cmdBuffID, _device->getCommandBuffer());
+    alias(_header.queryPoolID, _device->getQueryPool());
+
+    // the objects alive when the capture started, up to the first frame
+    Reader     reader(this, _file.getBytes(), utils::toUint(_file.getSize()), sizeof(_header));
+    DeviceInfo deviceInfo;
+    serialize(reader, deviceInfo);
+    while (reader.peek() != CaptureOp::ACQUIRE) {
+        if (execute(reader) != Result::CONTINUE) {
+            CC_LOG_ERROR("CommandReplayer: %s is corrupted at offset %u", path.c_str(), reader.offset);
+            destroy();
+            return false;
+        }
+        reader.scratch.clear();
+    }
+    _firstFrameOffset = _offset = reader.offset;
+    _frameIndex                 = 0;
+    return true;
+}
+
+void CommandReplayer::destroy() {
+    // in reverse creation order, objects are released before the ones they refer to
+    ccstd::vector<uint32_t> ids;
+    ids.reserve(_objects.size());
+    for (const auto &entry : _objects) {
+        ids.push_back(entry.first);
+    }
+    std::sort(ids.begin(), ids.end(), std::greater<uint32_t>());
+    for (uint32_t id : ids) {
+        remove(id);
+    }
+
+    _offscreenSwapchains.clear();
+    _file.reset();
+    _header      = {};
+    _swapchain   = nullptr;
+    _swapchainID = 0;
+    _offset = _firstFrameOffset = _frameIndex = 0;
+}
+
+float CommandReplayer::replayFrame() {
+    if (!_header.frameCount) {
+        return -1.F;
+    }
+
+    auto   start = std::chrono::steady_clock::now();
+    Reader reader(this, _file.getBytes(), utils::toUint(_file.getSize()), _offset);
+    Result result = Result::CONTINUE;
+    while (result == Result::CONTINUE) {
+        result = execute(reader);
+        reader.scratch.clear();
+    }
+    if (result == Result::FAILED) {
+        CC_LOG_ERROR("CommandReplayer: the capture is corrupted at offset %u", reader.offset);
+        return -1.F;
+    }
+
+    _offset = reader.offset;
+    if (++_frameIndex == _header.frameCount) {
+        _frameIndex = 0;
+        _offset     = _firstFrameOffset;
+    }
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+T *CommandReplayer::get(uint32_t id) const {
+    auto iter = _objects.find(id);
+    return iter != _objects.end() ? static_cast<T *>(iter->second.object) : nullptr;
+}
+
+template <typename T>
+void CommandReplayer::add(uint32_t id, T *object) {
+    // frames replayed again create their objects again
+    remove(id);
+    if (!object) return;
+    retainObject(object);
+    _objects[id] = {object, &releaseObject<T>};
+}
+
+void CommandReplayer::alias(uint32_t id, GFXObject *object) {
+    remove(id);
+    _objects[id] = {object, nullptr};
+}
+
+void CommandReplayer::remove(uint32_t id) {
+    auto iter = _objects.find(id);
+    if (iter == _objects.end()) return;
+    if (iter->second.release && iter->second.object) iter->second.release(iter->second.object);
+    _objects.erase(iter);
+}
+
+void CommandReplayer::createSwapchain(uint32_t id, const SwapchainInfo &info, uint32_t colorTextureID, uint32_t depthStencilTextureID, Format colorFormat, Format depthStencilFormat) {
+    if (_swapchain && !_swapchainID && _swapchain->getColorTexture()->getFormat() == colorFormat &&
+        _swapchain->getDepthStencilTexture()->getFormat() == depthStencilFormat) {
+        _swapchainID = id;
+        alias(id, _swapchain);
+        alias(colorTextureID, _swapchain->getColorTexture());
+        alias(depthStencilTextureID, _swapchain->getDepthStencilTexture());
+        return;
+    }
+    if (_swapchain && !_swapchainID) {
+        CC_LOG_WARNING("CommandReplayer: the swapchain formats differ from the captured ones, replaying offscreen");
+    }
+
+    // acquire and present skip offscreen swapchains
+    alias(id, nullptr);
+    _offscreenSwapchains[id] = {colorTextureID, depthStencilTextureID};
+
+    TextureInfo textureInfo;
+    textureInfo.usage  = TextureUsageBit::COLOR_ATTACHMENT | TextureUsageBit::SAMPLED | TextureUsageBit::TRANSFER_SRC;
+    textureInfo.format = colorFormat;
+    textureInfo.width  = info.width;
+    textureInfo.height = info.height;
+    add(colorTextureID, _device->createTexture(textureInfo));
+
+    textureInfo.usage  = TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | TextureUsageBit::SAMPLED;
+    textureInfo.format = depthStencilFormat;
+    add(depthStencilTextureID, _device->createTexture(textureInfo));
+}
+
+CommandReplayer::Result CommandReplayer::execute(Reader &reader) {
+    CaptureOp op{CaptureOp::COUNT};
+    uint32_t  id{0};
+    reader.raw(&op, sizeof(op));
+    reader.raw(&id, sizeof(id));
+    if (reader.failed || op >= CaptureOp::COUNT) {
+        return Result::FAILED;
+    }
+
+    CommandBuffer *cmdBuff{nullptr};
+    if (op >= CaptureOp::CMD_BEGIN && op <= CaptureOp::CMD_WRITE_TIMESTAMP) {
+        cmdBuff = get<CommandBuffer>(id);
+        if (!cmdBuff) return Result::FAILED;
+    }
+
+    switch (op) {
+        case CaptureOp::CREATE_BUFFER: {
+            BufferInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createBuffer(info));
+        } break;
+        case CaptureOp::CREATE_BUFFER_VIEW: {
+            BufferViewInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.buffer) add(id, _device->createBuffer(info));
+        } break;
+        case CaptureOp::CREATE_TEXTURE: {
+            TextureInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createTexture(info));
+        } break;
+        case CaptureOp::CREATE_TEXTURE_VIEW: {
+            TextureViewInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.texture) add(id, _device->createTexture(info));
+        } break;
+        case CaptureOp::CREATE_SWAPCHAIN: {
+            SwapchainInfo info;
+            uint32_t      colorTextureID{0};
+            uint32_t      depthStencilTextureID{0};
+            Format        colorFormat{Format::UNKNOWN};
+            Format        depthStencilFormat{Format::UNKNOWN};
+            serializeFields(reader, info, colorTextureID, depthStencilTextureID, colorFormat, depthStencilFormat);
+            if (!reader.failed) createSwapchain(id, info, colorTextureID, depthStencilTextureID, colorFormat, depthStencilFormat);
+        } break;
+        case CaptureOp::CREATE_SHADER: {
+            ShaderInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createShader(info));
+        } break;
+        case CaptureOp::CREATE_INPUT_ASSEMBLER: {
+            InputAssemblerInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createInputAssembler(info));
+        } break;
+        case CaptureOp::CREATE_RENDER_PASS: {
+            RenderPassInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createRenderPass(info));
+        } break;
+        case CaptureOp::CREATE_FRAMEBUFFER: {
+            FramebufferInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.renderPass) add(id, _device->createFramebuffer(info));
+        } break;
+        case CaptureOp::CREATE_DESCRIPTOR_SET_LAYOUT: {
+            DescriptorSetLayoutInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createDescriptorSetLayout(info));
+        } break;
+        case CaptureOp::CREATE_PIPELINE_LAYOUT: {
+            PipelineLayoutInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createPipelineLayout(info));
+        } break;
+        case CaptureOp::CREATE_PIPELINE_STATE: {
+            PipelineStateInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.shader && info.pipelineLayout) add(id, _device->createPipelineState(info));
+        } break;
+        case CaptureOp::CREATE_DESCRIPTOR_SET: {
+            DescriptorSetInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.layout) add(id, _device->createDescriptorSet(info));
+        } break;
+        case CaptureOp::CREATE_COMMAND_BUFFER: {
+            CommandBufferInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.queue) add(id, _device->createCommandBuffer(info));
+        } break;
+        case CaptureOp::CREATE_QUERY_POOL: {
+            QueryPoolInfo info;
+            serialize(reader, info);
+            if (!reader.failed) add(id, _device->createQueryPool(info));
+        } break;
+        case CaptureOp::DESTROY: {
+            auto iter = _offscreenSwapchains.find(id);
+            if (iter != _offscreenSwapchains.end()) {
+                remove(iter->second.color);
+                remove(iter->second.depthStencil);
+                _offscreenSwapchains.erase(iter);
+            }
+            if (id == _swapchainID) _swapchainID = 0;
+            remove(id);
+        } break;
+
+        case CaptureOp::BUFFER_UPDATE: {
+            CaptureBlob contents;
+            serialize(reader, contents);
+            auto *buffer = get<Buffer>(id);
+            if (!reader.failed && buffer) buffer->update(contents.data, std::min(contents.size, buffer->getSize()));
+        } break;
+        case CaptureOp::BUFFER_RESIZE: {
+            uint32_t size{0};
+            serialize(reader, size);
+            auto *buffer = get<Buffer>(id);
+            if (!reader.failed && buffer) buffer->resize(size);
+        } break;
+        case CaptureOp::TEXTURE_RESIZE: {
+            uint32_t width{0};
+            uint32_t height{0};
+            serializeFields(reader, width, height);
+            auto *texture = get<Texture>(id);
+            if (!reader.failed && texture) texture->resize(width, height);
+        } break;
+        case CaptureOp::SWAPCHAIN_RESIZE: {
+            uint32_t         width{0};
+            uint32_t         height{0};
+            SurfaceTransform transform{SurfaceTransform::IDENTITY};
+            serializeFields(reader, width, height, transform);
+            // the swapchain replayed into follows its window
+            auto iter = _offscreenSwapchains.find(id);
+            if (reader.failed || iter == _offscreenSwapchains.end()) break;
+            if (auto *color = get<Texture>(iter->second.color)) color->resize(width, height);
+            if (auto *depthStencil = get<Texture>(iter->second.depthStencil)) depthStencil->resize(width, height);
+        } break;
+        case CaptureOp::TEXTURE_UPLOAD: {
+            BufferTextureCopy        region;
+            CaptureSpan<CaptureBlob> layers;
+            serializeFields(reader, region, layers);
+            auto *texture = get<Texture>(id);
+            if (reader.failed || !texture) break;
+            auto **buffers = reader.allocate<const uint8_t *>(layers.count);
+            for (uint32_t i = 0; i < layers.count; ++i) {
+                buffers[i] = layers.data[i].data;
+            }
+            _device->copyBuffersToTexture(buffers, texture, &region, 1);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_BUFFER: {
+            uint32_t binding{0};
+            uint32_t index{0};
+            Buffer * buffer{nullptr};
+            serializeFields(reader, binding, index, buffer);
+            auto *descriptorSet = get<DescriptorSet>(id);
+            if (!reader.failed && descriptorSet && buffer) descriptorSet->bindBuffer(binding, buffer, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_TEXTURE: {
+            uint32_t  binding{0};
+            uint32_t  index{0};
+            Texture * texture{nullptr};
+            serializeFields(reader, binding, index, texture);
+            auto *descriptorSet = get<DescriptorSet>(id);
+            if (!reader.failed && descriptorSet && texture) descriptorSet->bindTexture(binding, texture, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_BIND_SAMPLER: {
+            uint32_t binding{0};
+            uint32_t index{0};
+            Sampler *sampler{nullptr};
+            serializeFields(reader, binding, index, sampler);
+            auto *descriptorSet = get<DescriptorSet>(id);
+            if (!reader.failed && descriptorSet && sampler) descriptorSet->bindSampler(binding, sampler, index);
+        } break;
+        case CaptureOp::DESCRIPTOR_SET_UPDATE: {
+            if (auto *descriptorSet = get<DescriptorSet>(id)) descriptorSet->update();
+        } break;
+
+        case CaptureOp::CMD_BEGIN: {
+            RenderPass * renderPass{nullptr};
+            uint32_t     subpass{0};
+            Framebuffer *framebuffer{nullptr};
+            serializeFields(reader, renderPass, subpass, framebuffer);
+            if (!reader.failed) cmdBuff->begin(renderPass, subpass, framebuffer);
+        } break;
+        case CaptureOp::CMD_END: {
+            cmdBuff->end();
+        } break;
+        case CaptureOp::CMD_BEGIN_RENDER_PASS: {
+            RenderPass *                      renderPass{nullptr};
+            Framebuffer *                     framebuffer{nullptr};
+            Rect                              renderArea;
+            CaptureSpan<const Color>          colors;
+            float                             depth{1.F};
+            uint32_t                          stencil{0};
+            CaptureSpan<CommandBuffer *const> secondaryCBs;
+            serializeFields(reader, renderPass, framebuffer, renderArea, colors, depth, stencil, secondaryCBs);
+            if (reader.failed || !renderPass || !framebuffer) return Result::FAILED;
+            cmdBuff->beginRenderPass(renderPass, framebuffer, renderArea, colors.data, depth, stencil, secondaryCBs.data, secondaryCBs.count);
+        } break;
+        case CaptureOp::CMD_END_RENDER_PASS: {
+            cmdBuff->endRenderPass();
+        } break;
+        case CaptureOp::CMD_NEXT_SUBPASS: {
+            cmdBuff->nextSubpass();
+        } break;
+        case CaptureOp::CMD_BIND_PIPELINE_STATE: {
+            PipelineState *pso{nullptr};
+            serialize(reader, pso);
+            if (!reader.failed && pso) cmdBuff->bindPipelineState(pso);
+        } break;
+        case CaptureOp::CMD_BIND_DESCRIPTOR_SET: {
+            uint32_t                    set{0};
+            DescriptorSet *             descriptorSet{nullptr};
+            CaptureSpan<const uint32_t> dynamicOffsets;
+            serializeFields(reader, set, descriptorSet, dynamicOffsets);
+            if (!reader.failed && descriptorSet) cmdBuff->bindDescriptorSet(set, descriptorSet, dynamicOffsets.count, dynamicOffsets.data);
+        } break;
+        case CaptureOp::CMD_BIND_INPUT_ASSEMBLER: {
+            InputAssembler *ia{nullptr};
+            serialize(reader, ia);
+            if (!reader.failed && ia) cmdBuff->bindInputAssembler(ia);
+        } break;
+        case CaptureOp::CMD_SET_VIEWPORT: {
+            Viewport viewport;
+            serialize(reader, viewport);
+            if (!reader.failed) cmdBuff->setViewport(viewport);
+        } break;
+        case CaptureOp::CMD_SET_SCISSOR: {
+            Rect rect;
+            serialize(reader, rect);
+            if (!reader.failed) cmdBuff->setScissor(rect);
+        } break;
+        case CaptureOp::CMD_SET_LINE_WIDTH: {
+            float width{1.F};
+            serialize(reader, width);
+            if (!reader.failed) cmdBuff->setLineWidth(width);
+        } break;
+        case CaptureOp::CMD_SET_DEPTH_BIAS: {
+            float constant{0.F};
+            float clamp{0.F};
+            float slope{0.F};
+            serializeFields(reader, constant, clamp, slope);
+            if (!reader.failed) cmdBuff->setDepthBias(constant, clamp, slope);
+        } break;
+        case CaptureOp::CMD_SET_BLEND_CONSTANTS: {
+            Color constants;
+            serialize(reader, constants);
+            if (!reader.failed) cmdBuff->setBlendConstants(constants);
+        } break;
+        case CaptureOp::CMD_SET_DEPTH_BOUND: {
+            float minBounds{0.F};
+            float maxBounds{1.F};
+            serializeFields(reader, minBounds, maxBounds);
+            if (!reader.failed) cmdBuff->setDepthBound(minBounds, maxBounds);
+        } break;
+        case CaptureOp::CMD_SET_STENCIL_WRITE_MASK: {
+            StencilFace face{StencilFace::ALL};
+            uint32_t    mask{0};
+            serializeFields(reader, face, mask);
+            if (!reader.failed) cmdBuff->setStencilWriteMask(face, mask);
+        } break;
+        case CaptureOp::CMD_SET_STENCIL_COMPARE_MASK: {
+            StencilFace face{StencilFace::ALL};
+            uint32_t    ref{0};
+            uint32_t    mask{0};
+            serializeFields(reader, face, ref, mask);
+            if (!reader.failed) cmdBuff->setStencilCompareMask(face, ref, mask);
+        } break;
+        case CaptureOp::CMD_DRAW: {
+            DrawInfo info;
+            serialize(reader, info);
+            if (!reader.failed) cmdBuff->draw(info);
+        } break;
+        case CaptureOp::CMD_DRAW_INDIRECT: {
+            DrawIndirectInfo info;
+            serialize(reader, info);
+            if (!reader.failed && info.buffer) cmdBuff->drawIndirect(info);
+        } break;
+        case CaptureOp::CMD_UPDATE_BUFFER: {
+            Buffer *    buffer{nullptr};
+            CaptureBlob contents;
+            serializeFields(reader, buffer, contents);
+            if (!reader.failed && buffer) cmdBuff->updateBuffer(buffer, contents.data, std::min(contents.size, buffer->getSize()));
+        } break;
+        case CaptureOp::CMD_COPY_BUFFERS_TO_TEXTURE: {
+            Texture *                texture{nullptr};
+            BufferTextureCopy        region;
+            CaptureSpan<CaptureBlob> layers;
+            serializeFields(reader, texture, region, layers);
+            if (reader.failed || !texture) break;
+            auto **buffers = reader.allocate<const uint8_t *>(layers.count);
+            for (uint32_t i = 0; i < layers.count; ++i) {
+                buffers[i] = layers.data[i].data;
+            }
+            cmdBuff->copyBuffersToTexture(buffers, texture, &region, 1);
+        } break;
+        case CaptureOp::CMD_BLIT_TEXTURE: {
+            Texture *                      srcTexture{nullptr};
+            Texture *                      dstTexture{nullptr};
+            CaptureSpan<const TextureBlit> regions;
+            Filter                         filter{Filter::LINEAR};
+            serializeFields(reader, srcTexture, dstTexture, regions, filter);
+            if (!reader.failed && srcTexture && dstTexture) cmdBuff->blitTexture(srcTexture, dstTexture, regions.data, regions.count, filter);
+        } break;
+        case CaptureOp::CMD_EXECUTE: {
+            CaptureSpan<CommandBuffer *const> cmdBuffs;
+            serialize(reader, cmdBuffs);
+            if (!reader.failed) cmdBuff->execute(cmdBuffs.data, cmdBuffs.count);
+        } break;
+        case CaptureOp::CMD_DISPATCH: {
+            DispatchInfo info;
+            serialize(reader, info);
+            if (!reader.failed) cmdBuff->dispatch(info);
+        } break;
+        case CaptureOp::CMD_PIPELINE_BARRIER: {
+            const GeneralBarrier *                   barrier{nullptr};
+            CaptureSpan<const TextureBarrier *const> textureBarriers;
+            CaptureSpan<const Texture *const>        textures;
+            serializeFields(reader, barrier, textureBarriers, textures);
+            if (!reader.failed) cmdBuff->pipelineBarrier(barrier, textureBarriers.data, textures.data, std::min(textureBarriers.count, textures.count));
+        } break;
+        case CaptureOp::CMD_BEGIN_QUERY:
+        case CaptureOp::CMD_END_QUERY:
+        case CaptureOp::CMD_WRITE_TIMESTAMP: {
+            QueryPool *queryPool{nullptr};
+            uint32_t   queryID{0};
+            serializeFields(reader, queryPool, queryID);
+            if (reader.failed || !queryPool) break;
+            if (op == CaptureOp::CMD_BEGIN_QUERY) {
+                cmdBuff->beginQuery(queryPool, queryID);
+            } else if (op == CaptureOp::CMD_END_QUERY) {
+                cmdBuff->endQuery(queryPool, queryID);
+            } else {
+                cmdBuff->writeTimestamp(queryPool, queryID);
+            }
+        } break;
+        case CaptureOp::CMD_RESET_QUERY_POOL:
+        case CaptureOp::CMD_COMPLETE_QUERY_POOL: {
+            QueryPool *queryPool{nullptr};
+            serialize(reader, queryPool);
+            if (reader.failed || !queryPool) break;
+            if (op == CaptureOp::CMD_RESET_QUERY_POOL) {
+                cmdBuff->resetQueryPool(queryPool);
+            } else {
+                cmdBuff->completeQueryPool(queryPool);
+            }
+        } break;
+
+        case CaptureOp::QUEUE_SUBMIT: {
+            CaptureSpan<CommandBuffer *const> cmdBuffs;
+            serialize(reader, cmdBuffs);
+            auto *queue = get<Queue>(id);
+            if (!reader.failed && queue) queue->submit(cmdBuffs.data, cmdBuffs.count);
+        } break;
+        case CaptureOp::ACQUIRE: {
+            CaptureSpan<Swapchain *const> swapchains;
+            serialize(reader, swapchains);
+            if (reader.failed) break;
+            // offscreen swapchains resolve to nullptr
+            ccstd::vector<Swapchain *> acquired;
+            for (uint32_t i = 0; i < swapchains.count; ++i) {
+                if (swapchains.data[i]) acquired.push_back(swapchains.data[i]);
+            }
+            _device->acquire(acquired);
+        } break;
+        case CaptureOp::PRESENT: {
+            _device->present();
+            return Result::PRESENTED;
+        }
+        default: return Result::FAILED;
+    }
+
+    return reader.failed ? Result::FAILED : Result::CONTINUE;
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "CaptureFormat.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+// Replays a capture written by CommandCapture on any device, to time the captured frames on other backends or after
+// changes to them. The frames are replayed into the given swapchain if its formats match the captured one, into
+// offscreen textures otherwise, and loop once the last one has been replayed.
+class CC_DLL CommandReplayer final {
+public:
+    // the info the captured device was created with, the replaying device should be created with it as well
+    static bool loadDeviceInfo(const ccstd::string &path, DeviceInfo *outInfo);
+
+    explicit CommandReplayer(Device *device);
+    ~CommandReplayer();
+
+    // maps the capture and recreates the objects alive when it started, the file stays mapped until destroy()
+    bool load(const ccstd::string &path, Swapchain *swapchain = nullptr);
+    void destroy();
+
+    // replays the next frame, returns its CPU time in milliseconds or a negative value if the capture is corrupted
+    float replayFrame();
+
+    inline uint32_t getFrameCount() const { return _header.frameCount; }
+    inline uint32_t getFrameIndex() const { return _frameIndex; }
+
+private:
+    struct Reader;
+
+    struct Object {
+        GFXObject *object{nullptr};
+        void (*release)(GFXObject *object){nullptr}; // nullptr if not owned by the replayer
+    };
+
+    struct SwapchainTextures {
+        uint32_t color{0};
+        uint32_t depthStencil{0};
+    };
+
+    enum class Result {
+        CONTINUE,
+        PRESENTED,
+        FAILED,
+    };
+
+    template <typename T>
+    T *get(uint32_t id) const;
+    template <typename T>
+    void add(uint32_t id, T *object);
+    void alias(uint32_t id, GFXObject *object);
+    void remove(uint32_t id);
+
+    static bool mapCapture(const ccstd::string &path, MappedFile *outFile, CaptureHeader *outHeader);
+
+    Result execute(Reader &reader);
+    void   createSwapchain(uint32_t id, const SwapchainInfo &info, uint32_t colorTextureID, uint32_t depthStencilTextureID, Format colorFormat, Format depthStencilFormat);
+
+    Device *                                          _device{nullptr};
+    Swapchain *                                       _swapchain{nullptr};
+    MappedFile                                        _file;
+    CaptureHeader                                     _header;
+    ccstd::unordered_map<uint32_t, Object>            _objects;
+    uint32_t                                          _swapchainID{0}; // the captured swapchain replayed into _swapchain
+    ccstd::unordered_map<uint32_t, SwapchainTextures> _offscreenSwapchains;
+    uint32_t                                          _firstFrameOffset{0};
+    uint32_t                                          _offset{0};
+    uint32_t                                          _frameIndex{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(CommandReplayer)
+};
+
+} // namespace gfx
+} // namespace cc
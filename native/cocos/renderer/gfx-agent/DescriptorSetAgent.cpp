@@ -26,6 +26,7 @@
 #include "base/threading/MessageQueue.h"
 
 #include "BufferAgent.h"
+#include "CommandCapture.h"
 #include "DescriptorSetAgent.h"
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
@@ -40,6 +41,7 @@ DescriptorSetAgent::DescriptorSetAgent(DescriptorSet *actor)
 }
 
 DescriptorSetAgent::~DescriptorSetAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetDestruct,
@@ -50,6 +52,7 @@ DescriptorSetAgent::~DescriptorSetAgent() {
 }
 
 void DescriptorSetAgent::doInit(const DescriptorSetInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_DESCRIPTOR_SET, this, info);
     DescriptorSetInfo actorInfo;
     actorInfo.layout = static_cast<DescriptorSetLayoutAgent *>(info.layout)->getActor();
 
@@ -64,6 +67,7 @@ void DescriptorSetAgent::doInit(const DescriptorSetInfo &info) {
 }
 
 void DescriptorSetAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetDestroy,
@@ -78,6 +82,8 @@ void DescriptorSetAgent::update() {
     if (!_isDirty) return;
 
     _isDirty = false;
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->updateDescriptorSet(this);
+    DeviceAgent::getInstance()->countDescriptorSetUpdate();
 
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -89,7 +95,10 @@ void DescriptorSetAgent::update() {
 }
 
 void DescriptorSetAgent::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t index) {
+    const auto version = _bindingVersion;
     DescriptorSet::bindBuffer(binding, buffer, index);
+    if (version == _bindingVersion) return; // unchanged, no need to notify the actor
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->bind(CaptureOp::DESCRIPTOR_SET_BIND_BUFFER, this, binding, index, buffer);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -104,7 +113,10 @@ void DescriptorSetAgent::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t i
 }
 
 void DescriptorSetAgent::bindTexture(uint32_t binding, Texture *texture, uint32_t index) {
+    const auto version = _bindingVersion;
     DescriptorSet::bindTexture(binding, texture, index);
+    if (version == _bindingVersion) return; // unchanged, no need to notify the actor
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->bind(CaptureOp::DESCRIPTOR_SET_BIND_TEXTURE, this, binding, index, texture);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -119,7 +131,10 @@ void DescriptorSetAgent::bindTexture(uint32_t binding, Texture *texture, uint32_
 }
 
 void DescriptorSetAgent::bindSampler(uint32_t binding, Sampler *sampler, uint32_t index) {
+    const auto version = _bindingVersion;
     DescriptorSet::bindSampler(binding, sampler, index);
+    if (version == _bindingVersion) return; // unchanged, no need to notify the actor
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->bind(CaptureOp::DESCRIPTOR_SET_BIND_SAMPLER, this, binding, index, sampler);
 
     ENQUEUE_MESSAGE_4(
         DeviceAgent::getInstance()->getMessageQueue(),
@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
 
@@ -37,6 +38,7 @@ DescriptorSetLayoutAgent::DescriptorSetLayoutAgent(DescriptorSetLayout *actor)
 }
 
 DescriptorSetLayoutAgent::~DescriptorSetLayoutAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetLayoutDestruct,
@@ -47,6 +49,7 @@ DescriptorSetLayoutAgent::~DescriptorSetLayoutAgent() {
 }
 
 void DescriptorSetLayoutAgent::doInit(const DescriptorSetLayoutInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_DESCRIPTOR_SET_LAYOUT, this, info);
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetLayoutInit,
@@ -58,6 +61,7 @@ void DescriptorSetLayoutAgent::doInit(const DescriptorSetLayoutInfo &info) {
 }
 
 void DescriptorSetLayoutAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         DescriptorSetLayoutDestroy,
@@ -23,13 +23,18 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include <cstring>
+#include <thread>
 #include "base/Log.h"
 #include "base/threading/MessageQueue.h"
+#include "base/threading/ThreadAffinity.h"
+#include "base/threading/ThreadPool.h"
 #include "base/threading/ThreadSafeLinearAllocator.h"
 
 #include "BufferAgent.h"
 #include "CommandBufferAgent.h"
+#include "CommandCapture.h"
 #include "DescriptorSetAgent.h"
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
@@ -47,6 +52,16 @@
 namespace cc {
 namespace gfx {
 
+namespace {
+// render thread time is smoothed over frames, the pacing delay keeps a margin for its variance
+constexpr float RENDER_TIME_SMOOTHING = 0.1F;
+constexpr float PACING_MARGIN         = 0.15F;
+
+float elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<float, std::milli>(to - from).count();
+}
+} // namespace
+
 DeviceAgent *DeviceAgent::instance = nullptr;
 
 DeviceAgent *DeviceAgent::getInstance() {
@@ -91,10 +106,13 @@ bool DeviceAgent::doInit(const DeviceInfo &info) {
 }
 
 void DeviceAgent::doDestroy() {
-    ENQUEUE_MESSAGE_1(
+    ENQUEUE_MESSAGE_2(
         _mainMessageQueue, DeviceDestroy,
         actor, _actor,
+        compilePool, _pipelineStateCompilePool,
         {
+            // pipeline states are all destroyed by now, so are their compilations
+            if (compilePool) compilePool->stop();
             actor->destroy();
         });
 
@@ -121,9 +139,31 @@ void DeviceAgent::doDestroy() {
     // TODO(PatriceJiang): replace with: CC_SAFE_DELETE(_mainMessageQueue);
     CC_DELETE_ALIGN(_mainMessageQueue, MessageQueue, alignof(MessageQueue)); // NOLINT
     _mainMessageQueue = nullptr;
+
+    CC_SAFE_DELETE(_pipelineStateCompilePool);
+    _asyncPipelineStatePolicy = AsyncPipelineStatePolicy::DISABLED;
+
+    CC_SAFE_DELETE(_capture);
+}
+
+void DeviceAgent::enableCapture() {
+    if (_capture) return;
+
+    DeviceInfo info;
+    info.bindingMappingInfo = _bindingMappingInfo;
+    _capture                = CC_NEW(CommandCapture(info, _queue, _cmdBuff, _queryPool));
+}
+
+bool DeviceAgent::startCapture(const ccstd::string &path, uint32_t frames) {
+    if (!_capture) {
+        CC_LOG_WARNING("DeviceAgent: captures need DeviceManager::setCaptureEnabled(true) before the device is created");
+        return false;
+    }
+    return _capture->start(path, frames);
 }
 
 void DeviceAgent::acquire(Swapchain *const *swapchains, uint32_t count) {
+    if (_capture) _capture->acquire(swapchains, count);
     auto *actorSwapchains = _mainMessageQueue->allocate<Swapchain *>(count);
     for (uint32_t i = 0; i < count; ++i) {
         actorSwapchains[i] = static_cast<SwapchainAgent *>(swapchains[i])->getActor();
@@ -136,25 +176,87 @@ void DeviceAgent::acquire(Swapchain *const *swapchains, uint32_t count) {
         swapchains, actorSwapchains,
         count, count,
         {
+            device->_renderFrameStart = std::chrono::steady_clock::now();
             if (device->_onAcquire) device->_onAcquire->execute();
             actor->acquire(swapchains, count);
         });
 }
 
 void DeviceAgent::present() {
-    ENQUEUE_MESSAGE_2(
+    if (_capture) _capture->present();
+    ENQUEUE_MESSAGE_3(
         _mainMessageQueue, DevicePresent,
+        device, this,
         actor, _actor,
         frameBoundarySemaphore, &_frameBoundarySemaphore,
         {
             actor->present();
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - device->_renderFrameStart);
+            device->_renderFrameTime.store(static_cast<uint32_t>(elapsed.count()), std::memory_order_relaxed);
             frameBoundarySemaphore->signal();
         });
 
+    auto now               = std::chrono::steady_clock::now();
+    _frameTimings.mainTime = elapsedMs(_mainFrameStart, now);
+
+    _frameCounters.pipelineStateBinds   = _pipelineStateBinds.exchange(0U, std::memory_order_relaxed);
+    _frameCounters.descriptorSetUpdates = _descriptorSetUpdates.exchange(0U, std::memory_order_relaxed);
+    _frameCounters.uploads              = _uploads.exchange(0U, std::memory_order_relaxed);
+    _frameCounters.uploadBytes          = _uploadBytes.exchange(0U, std::memory_order_relaxed);
+
     MessageQueue::freeChunksInFreeQueue(_mainMessageQueue);
     _mainMessageQueue->finishWriting();
+    // the staging buffer ring is sized for the max latency, so the index always wraps at MAX_FRAME_INDEX
     _currentIndex = (_currentIndex + 1) % MAX_FRAME_INDEX;
     _frameBoundarySemaphore.wait();
+
+    auto waitEnd           = std::chrono::steady_clock::now();
+    _frameTimings.waitTime = elapsedMs(now, waitEnd);
+    _mainFrameStart        = waitEnd;
+
+    paceFrame();
+}
+
+void DeviceAgent::paceFrame() {
+    float renderTime             = static_cast<float>(_renderFrameTime.load(std::memory_order_relaxed)) * 0.001F;
+    _frameTimings.lastRenderTime = renderTime;
+    _frameTimings.renderTime     = _frameTimings.renderTime + (renderTime - _frameTimings.renderTime) * RENDER_TIME_SMOOTHING;
+    _frameTimings.pacingDelay    = 0.F;
+    if (!_framePacingEnabled || !_multithreaded) return;
+
+    // the main thread time excludes the last delay and wait, so the delay converges instead of accumulating
+    float delay = _frameTimings.renderTime * (1.F - PACING_MARGIN) - _frameTimings.mainTime;
+    delay       = std::min(delay, _frameTimings.renderTime);
+    if (delay <= 0.F) return;
+
+    std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(delay));
+    auto now                  = std::chrono::steady_clock::now();
+    _frameTimings.pacingDelay = elapsedMs(_mainFrameStart, now);
+    _mainFrameStart           = now;
+}
+
+void DeviceAgent::setFrameLatency(uint32_t frames) {
+    frames = std::max(1U, std::min(frames, MAX_CPU_FRAME_AHEAD));
+    if (frames > _frameLatency) {
+        _frameBoundarySemaphore.signal(static_cast<int>(frames - _frameLatency));
+    } else {
+        // take back the extra frames once the render thread has finished them
+        for (uint32_t i = frames; i < _frameLatency; ++i) {
+            _frameBoundarySemaphore.wait();
+        }
+    }
+    _frameLatency = frames;
+}
+
+void DeviceAgent::setAsyncPipelineStatePolicy(AsyncPipelineStatePolicy policy) {
+    if (!_actor->hasFeature(Feature::ASYNC_PIPELINE_STATE)) {
+        policy = AsyncPipelineStatePolicy::DISABLED;
+    }
+    if (policy != AsyncPipelineStatePolicy::DISABLED && !_pipelineStateCompilePool) {
+        _pipelineStateCompilePool = CC_NEW(ThreadPool(ThreadQoS::BACKGROUND));
+        _pipelineStateCompilePool->start();
+    }
+    _asyncPipelineStatePolicy = policy;
 }
 
 void DeviceAgent::setMultithreaded(bool multithreaded) {
@@ -169,6 +271,7 @@ void DeviceAgent::setMultithreaded(bool multithreaded) {
             _mainMessageQueue, DeviceMakeCurrentTrue,
             actor, _actor,
             {
+                ThreadAffinity::setCurrentThread("Render", ThreadQoS::CRITICAL);
                 actor->bindContext(true);
                 CC_LOG_INFO("Device thread detached.");
             });
@@ -287,6 +390,7 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
         uint32_t size = formatSize(texture->getFormat(), region.texExtent.width, region.texExtent.height, 1);
         totalSize += size * region.texSubres.layerCount;
     }
+    DeviceAgent::getInstance()->countUpload(totalSize);
 
     //TODO(PatriceJiang): in C++17 replace with:*allocator = CC_NEW(ThreadSafeLinearAllocator(totalSize));
     auto *allocator = CC_NEW_ALIGN(ThreadSafeLinearAllocator(totalSize), alignof(ThreadSafeLinearAllocator));
@@ -322,10 +426,12 @@ void doBufferTextureCopy(const uint8_t *const *buffers, Texture *texture, const
 }
 
 void DeviceAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) {
+    if (_capture) _capture->uploadTexture(dst, buffers, regions, count, nullptr);
     doBufferTextureCopy(buffers, dst, regions, count, _mainMessageQueue, _actor);
 }
 
 void CommandBufferAgent::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->uploadTexture(texture, buffers, regions, count, this);
     doBufferTextureCopy(buffers, texture, regions, count, _messageQueue, _actor);
 }
 
@@ -345,6 +451,27 @@ void DeviceAgent::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buff
     _mainMessageQueue->kickAndWait();
 }
 
+uint32_t DeviceAgent::requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    // the handle is allocated here, the queries are answered by the actor directly
+    uint32_t handle       = _actor->createTextureReadback(src->getFormat(), regions, count);
+    auto *   actorRegions = _mainMessageQueue->allocate<BufferTextureCopy>(count);
+    memcpy(actorRegions, regions, count * sizeof(BufferTextureCopy));
+
+    ENQUEUE_MESSAGE_5(
+        _mainMessageQueue,
+        DeviceRequestTextureReadback,
+        actor, getActor(),
+        handle, handle,
+        src, static_cast<TextureAgent *>(src)->getActor(),
+        regions, actorRegions,
+        count, count,
+        {
+            actor->doTextureReadback(handle, src, regions, count);
+        });
+
+    return handle;
+}
+
 void DeviceAgent::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!_multithreaded) return; // all command buffers are immediately executed
 
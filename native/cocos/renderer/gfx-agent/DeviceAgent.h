@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include "base/Agent.h"
 #include "base/std/container/unordered_set.h"
 #include "base/threading/Semaphore.h"
@@ -33,17 +35,44 @@
 namespace cc {
 
 class MessageQueue;
+class ThreadPool;
 
 namespace gfx {
 
 class CommandBuffer;
 class CommandBufferAgent;
+class CommandCapture;
+
+// Timings of the last frame, in milliseconds.
+struct DeviceAgentFrameTimings {
+    float mainTime{0.F};       // main thread time from the end of the last present to the current one
+    float renderTime{0.F};     // render thread time from acquire to the end of present, smoothed
+    float waitTime{0.F};       // main thread time blocked at the frame boundary
+    float pacingDelay{0.F};    // main thread time delayed by frame pacing
+    float lastRenderTime{0.F}; // render thread time of the last finished frame, not smoothed
+};
+
+// Calls made to the agents during the last frame.
+struct DeviceAgentFrameCounters {
+    uint32_t pipelineStateBinds{0U};
+    uint32_t descriptorSetUpdates{0U};
+    uint32_t uploads{0U};     // buffer updates and buffer to texture copies
+    uint64_t uploadBytes{0U}; // data copied for the render thread by these uploads
+};
+
+// How pipeline states are created, and how the render thread handles draws whose pipeline state is still compiling.
+enum class AsyncPipelineStatePolicy : uint32_t {
+    DISABLED, // pipeline states are created in order on the render thread
+    WAIT,     // created on the compile threads, binding them waits for the compilation
+    SKIP,     // created on the compile threads, draws are skipped until the pipeline state is ready
+};
 
 class CC_DLL DeviceAgent final : public Agent<Device> {
 public:
     static DeviceAgent *      getInstance();
-    static constexpr uint32_t MAX_CPU_FRAME_AHEAD = 1;
-    static constexpr uint32_t MAX_FRAME_INDEX     = MAX_CPU_FRAME_AHEAD + 1;
+    static constexpr uint32_t MAX_CPU_FRAME_AHEAD     = 3;
+    static constexpr uint32_t MAX_FRAME_INDEX         = MAX_CPU_FRAME_AHEAD + 1;
+    static constexpr uint32_t DEFAULT_CPU_FRAME_AHEAD = 1;
 
     ~DeviceAgent() override;
 
@@ -91,21 +120,82 @@ public:
     void          copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void          flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     void          getQueryPoolResults(QueryPool *queryPool) override;
+    uint32_t      requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count) override;
+    bool          isTextureReadbackReady(uint32_t handle) override { return _actor->isTextureReadbackReady(handle); }
+    bool          getTextureReadbackData(uint32_t handle, uint8_t *const *buffers) override { return _actor->getTextureReadbackData(handle, buffers); }
+    void          releaseTextureReadback(uint32_t handle) override { _actor->releaseTextureReadback(handle); }
     MemoryStatus &getMemoryStatus() override { return _actor->getMemoryStatus(); }
     uint32_t      getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t      getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t      getNumTris() const override { return _actor->getNumTris(); }
+    uint32_t      getNumStateCalls() const override { return _actor->getNumStateCalls(); }
+    uint32_t      getNumSkippedStateCalls() const override { return _actor->getNumSkippedStateCalls(); }
+
+    PipelineCacheStatus &getPipelineCacheStatus() override { return _actor->getPipelineCacheStatus(); }
 
     uint32_t getCurrentIndex() const { return _currentIndex; }
     void     setMultithreaded(bool multithreaded);
 
+    /**
+     * @en Number of frames the main thread may run ahead of the render thread, in [1, MAX_CPU_FRAME_AHEAD].
+     * 1 gives the lowest input latency, 2 or 3 give more throughput when the render thread time varies.
+     * Lowering it waits for the render thread to catch up. Must be called from the main thread.
+     * @zh 主线程最多可以领先渲染线程的帧数，取值范围 [1, MAX_CPU_FRAME_AHEAD]。
+     * 1 的输入延迟最低，2 或 3 在渲染线程耗时波动时吞吐更高。调小时会等待渲染线程追上。必须在主线程调用。
+     */
+    void            setFrameLatency(uint32_t frames);
+    inline uint32_t getFrameLatency() const { return _frameLatency; }
+
+    /**
+     * @en Delay the start of the next main thread frame by the measured render thread time minus the main thread time,
+     * so that the simulation, and the input it reads, starts as late as possible without stalling the render thread.
+     * @zh 按照测得的渲染线程耗时减去主线程耗时来推迟下一帧主线程的开始，
+     * 使逻辑更新（以及它读取的输入）在不让渲染线程空等的前提下尽量晚地开始。
+     */
+    inline void setFramePacingEnabled(bool enabled) { _framePacingEnabled = enabled; }
+    inline bool isFramePacingEnabled() const { return _framePacingEnabled; }
+
+    inline const DeviceAgentFrameTimings & getFrameTimings() const { return _frameTimings; }
+    inline const DeviceAgentFrameCounters &getFrameCounters() const { return _frameCounters; }
+
+    // called by the agents, may be called from any thread that records commands
+    inline void countPipelineStateBind() { _pipelineStateBinds.fetch_add(1U, std::memory_order_relaxed); }
+    inline void countDescriptorSetUpdate() { _descriptorSetUpdates.fetch_add(1U, std::memory_order_relaxed); }
+    inline void countUpload(uint64_t bytes) {
+        _uploads.fetch_add(1U, std::memory_order_relaxed);
+        _uploadBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @en Create pipeline states on a pool of compile threads instead of the render thread, so that slow compilations
+     * don't hold back the commands behind them. Ignored if the device doesn't support Feature::ASYNC_PIPELINE_STATE.
+     * The objects a pipeline state is created from must outlive its compilation. Must be called from the main thread.
+     * @zh 在编译线程池而不是渲染线程上创建管线状态，避免耗时的编译阻塞其后的命令。
+     * 设备不支持 Feature::ASYNC_PIPELINE_STATE 时忽略。管线状态引用的对象必须在其编译完成后才能销毁。必须在主线程调用。
+     */
+    void                            setAsyncPipelineStatePolicy(AsyncPipelineStatePolicy policy);
+    inline AsyncPipelineStatePolicy getAsyncPipelineStatePolicy() const { return _asyncPipelineStatePolicy; }
+
     inline MessageQueue *getMessageQueue() const { return _mainMessageQueue; }
 
+    /**
+     * @en Write the calls of the next frames, from the next acquire on, with the objects and data they use into a file
+     * CommandReplayer can replay on any backend. Relative paths are under the writable path. Returns false unless
+     * DeviceManager::setCaptureEnabled(true) was called before the device was created, or if a capture is in progress.
+     * @zh 将接下来 frames 帧（从下一次 acquire 开始）的调用及其使用的对象与数据写入文件，可用 CommandReplayer 在任意后端回放。
+     * 相对路径位于可写目录下。若创建设备前未调用 DeviceManager::setCaptureEnabled(true)，或已有捕获在进行，则返回 false。
+     */
+    bool startCapture(const ccstd::string &path, uint32_t frames);
+
+    // set if captures are enabled, records the calls made to the agents
+    inline CommandCapture *getCapture() const { return _capture; }
+
 protected:
     static DeviceAgent *instance;
 
     friend class DeviceManager;
     friend class CommandBufferAgent;
+    friend class PipelineStateAgent;
 
     explicit DeviceAgent(Device *device);
 
@@ -115,10 +205,33 @@ protected:
     bool          _multithreaded{false};
     MessageQueue *_mainMessageQueue{nullptr};
 
+    void paceFrame();
+
     uint32_t  _currentIndex = 0U;
-    Semaphore _frameBoundarySemaphore{MAX_CPU_FRAME_AHEAD};
+    uint32_t  _frameLatency{DEFAULT_CPU_FRAME_AHEAD};
+    Semaphore _frameBoundarySemaphore{DEFAULT_CPU_FRAME_AHEAD};
+
+    bool                                  _framePacingEnabled{false};
+    DeviceAgentFrameTimings               _frameTimings;
+    std::chrono::steady_clock::time_point _mainFrameStart;
+    // written by the render thread, the frame time is in microseconds
+    std::chrono::steady_clock::time_point _renderFrameStart;
+    std::atomic<uint32_t>                 _renderFrameTime{0U};
+
+    // counted during the current frame, published to _frameCounters at present
+    std::atomic<uint32_t>    _pipelineStateBinds{0U};
+    std::atomic<uint32_t>    _descriptorSetUpdates{0U};
+    std::atomic<uint32_t>    _uploads{0U};
+    std::atomic<uint64_t>    _uploadBytes{0U};
+    DeviceAgentFrameCounters _frameCounters;
 
     ccstd::unordered_set<CommandBufferAgent *> _cmdBuffRefs;
+
+    AsyncPipelineStatePolicy _asyncPipelineStatePolicy{AsyncPipelineStatePolicy::DISABLED};
+    ThreadPool *             _pipelineStateCompilePool{nullptr}; // kept once created, for the compilations in flight
+
+    void            enableCapture();
+    CommandCapture *_capture{nullptr};
 };
 
 } // namespace gfx
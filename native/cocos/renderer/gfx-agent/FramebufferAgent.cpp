@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "FramebufferAgent.h"
 #include "RenderPassAgent.h"
@@ -39,6 +40,7 @@ FramebufferAgent::FramebufferAgent(Framebuffer *actor)
 }
 
 FramebufferAgent::~FramebufferAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         FramebufferDestruct,
@@ -49,6 +51,7 @@ FramebufferAgent::~FramebufferAgent() {
 }
 
 void FramebufferAgent::doInit(const FramebufferInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_FRAMEBUFFER, this, info);
     FramebufferInfo actorInfo = info;
     for (uint32_t i = 0U; i < info.colorTextures.size(); ++i) {
         if (info.colorTextures[i]) {
@@ -71,6 +74,7 @@ void FramebufferAgent::doInit(const FramebufferInfo &info) {
 }
 
 void FramebufferAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         FramebufferDestroy,
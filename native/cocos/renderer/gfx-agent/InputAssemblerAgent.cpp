@@ -26,6 +26,7 @@
 #include "base/threading/MessageQueue.h"
 
 #include "BufferAgent.h"
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "InputAssemblerAgent.h"
 
@@ -38,6 +39,7 @@ InputAssemblerAgent::InputAssemblerAgent(InputAssembler *actor)
 }
 
 InputAssemblerAgent::~InputAssemblerAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         InputAssemblerDestruct,
@@ -48,6 +50,7 @@ InputAssemblerAgent::~InputAssemblerAgent() {
 }
 
 void InputAssemblerAgent::doInit(const InputAssemblerInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_INPUT_ASSEMBLER, this, info);
     InputAssemblerInfo actorInfo = info;
     for (auto &vertexBuffer : actorInfo.vertexBuffers) {
         vertexBuffer = static_cast<BufferAgent *>(vertexBuffer)->getActor();
@@ -70,6 +73,7 @@ void InputAssemblerAgent::doInit(const InputAssemblerInfo &info) {
 }
 
 void InputAssemblerAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         InputAssemblerDestroy,
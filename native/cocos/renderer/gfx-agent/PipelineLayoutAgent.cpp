@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DescriptorSetLayoutAgent.h"
 #include "DeviceAgent.h"
 #include "PipelineLayoutAgent.h"
@@ -38,6 +39,7 @@ PipelineLayoutAgent::PipelineLayoutAgent(PipelineLayout *actor)
 }
 
 PipelineLayoutAgent::~PipelineLayoutAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineLayoutDestruct,
@@ -48,6 +50,7 @@ PipelineLayoutAgent::~PipelineLayoutAgent() {
 }
 
 void PipelineLayoutAgent::doInit(const PipelineLayoutInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_PIPELINE_LAYOUT, this, info);
     PipelineLayoutInfo actorInfo;
     actorInfo.setLayouts.resize(info.setLayouts.size());
     for (uint32_t i = 0U; i < info.setLayouts.size(); i++) {
@@ -65,6 +68,7 @@ void PipelineLayoutAgent::doInit(const PipelineLayoutInfo &info) {
 }
 
 void PipelineLayoutAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineLayoutDestroy,
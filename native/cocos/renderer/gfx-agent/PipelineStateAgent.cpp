@@ -24,7 +24,9 @@
 ****************************************************************************/
 
 #include "base/threading/MessageQueue.h"
+#include "base/threading/ThreadPool.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "PipelineLayoutAgent.h"
 #include "PipelineStateAgent.h"
@@ -40,21 +42,51 @@ PipelineStateAgent::PipelineStateAgent(PipelineState *actor)
 }
 
 PipelineStateAgent::~PipelineStateAgent() {
-    ENQUEUE_MESSAGE_1(
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
+    ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineStateDestruct,
         actor, _actor,
+        compilation, _compilation,
         {
+            if (compilation) {
+                compilation->future.wait();
+                CC_DELETE(compilation);
+            }
             CC_SAFE_DELETE(actor);
         });
 }
 
 void PipelineStateAgent::doInit(const PipelineStateInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_PIPELINE_STATE, this, info);
     PipelineStateInfo actorInfo = info;
     actorInfo.shader            = static_cast<ShaderAgent *>(info.shader)->getActor();
     actorInfo.pipelineLayout    = static_cast<PipelineLayoutAgent *>(info.pipelineLayout)->getActor();
     if (info.renderPass) actorInfo.renderPass = static_cast<RenderPassAgent *>(info.renderPass)->getActor();
 
+    ThreadPool *compilePool = DeviceAgent::getInstance()->_pipelineStateCompilePool;
+    if (compilePool) {
+        _compilation = CC_NEW(PipelineStateCompilation);
+
+        ENQUEUE_MESSAGE_4(
+            DeviceAgent::getInstance()->getMessageQueue(),
+            PipelineStateInitAsync,
+            actor, getActor(),
+            info, actorInfo,
+            compilation, _compilation,
+            compilePool, compilePool,
+            {
+                // the shader, pipeline layout and render pass are initialized by now,
+                // the compile threads only read them.
+                auto future = compilePool->dispatchTask([actor = actor, info = info, compilation = compilation]() {
+                    actor->initialize(info);
+                    compilation->ready = true;
+                });
+                compilation->future = future.share();
+            });
+        return;
+    }
+
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineStateInit,
@@ -66,13 +98,20 @@ void PipelineStateAgent::doInit(const PipelineStateInfo &info) {
 }
 
 void PipelineStateAgent::doDestroy() {
-    ENQUEUE_MESSAGE_1(
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
+    ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         PipelineStateDestroy,
         actor, getActor(),
+        compilation, _compilation,
         {
+            if (compilation) {
+                compilation->future.wait();
+                CC_DELETE(compilation);
+            }
             actor->destroy();
         });
+    _compilation = nullptr;
 }
 
 } // namespace gfx
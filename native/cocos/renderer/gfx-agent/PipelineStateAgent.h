@@ -25,20 +25,34 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include "base/Agent.h"
 #include "gfx-base/GFXPipelineState.h"
 
 namespace cc {
 namespace gfx {
 
+// Actor initialization running on the pipeline state compile threads.
+// Created on the main thread, the future is set and waited on the render thread.
+struct PipelineStateCompilation {
+    std::shared_future<void> future;
+    std::atomic<bool>        ready{false};
+};
+
 class CC_DLL PipelineStateAgent final : public Agent<PipelineState> {
 public:
     explicit PipelineStateAgent(PipelineState *actor);
     ~PipelineStateAgent() override;
 
+    // null if the actor is initialized in order on the render thread
+    inline PipelineStateCompilation *getCompilation() const { return _compilation; }
+
 protected:
     void doInit(const PipelineStateInfo &info) override;
     void doDestroy() override;
+
+    PipelineStateCompilation *_compilation{nullptr};
 };
 
 } // namespace gfx
@@ -27,6 +27,7 @@
 #include "base/threading/MessageQueue.h"
 
 #include "CommandBufferAgent.h"
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "QueryPoolAgent.h"
 
@@ -41,6 +42,7 @@ QueryPoolAgent::QueryPoolAgent(QueryPool *actor)
 }
 
 QueryPoolAgent::~QueryPoolAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         QueryDestruct,
@@ -51,6 +53,7 @@ QueryPoolAgent::~QueryPoolAgent() {
 }
 
 void QueryPoolAgent::doInit(const QueryPoolInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_QUERY_POOL, this, info);
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         QueryInit,
@@ -62,6 +65,7 @@ void QueryPoolAgent::doInit(const QueryPoolInfo &info) {
 }
 
 void QueryPoolAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         QueryDestroy,
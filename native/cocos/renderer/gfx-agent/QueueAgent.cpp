@@ -27,6 +27,7 @@
 #include "base/threading/MessageQueue.h"
 
 #include "CommandBufferAgent.h"
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "QueueAgent.h"
 
@@ -71,6 +72,7 @@ void QueueAgent::doDestroy() {
 
 void QueueAgent::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->record(CaptureOp::QUEUE_SUBMIT, this, CaptureSpan<CommandBuffer *const>{cmdBuffs, count});
 
     MessageQueue *msgQ          = DeviceAgent::getInstance()->getMessageQueue();
     auto **       actorCmdBuffs = msgQ->allocate<CommandBuffer *>(count);
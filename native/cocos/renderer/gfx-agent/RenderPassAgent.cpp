@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "RenderPassAgent.h"
 
@@ -37,6 +38,7 @@ RenderPassAgent::RenderPassAgent(RenderPass *actor)
 }
 
 RenderPassAgent::~RenderPassAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         RenderPassDestruct,
@@ -47,6 +49,7 @@ RenderPassAgent::~RenderPassAgent() {
 }
 
 void RenderPassAgent::doInit(const RenderPassInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_RENDER_PASS, this, info);
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         RenderPassInit,
@@ -58,6 +61,7 @@ void RenderPassAgent::doInit(const RenderPassInfo &info) {
 }
 
 void RenderPassAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         RenderPassDestroy,
@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "ShaderAgent.h"
 
@@ -37,6 +38,7 @@ ShaderAgent::ShaderAgent(Shader *actor)
 }
 
 ShaderAgent::~ShaderAgent() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         ShaderDestruct,
@@ -47,6 +49,7 @@ ShaderAgent::~ShaderAgent() {
 }
 
 void ShaderAgent::doInit(const ShaderInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_SHADER, this, info);
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         ShaderInit,
@@ -58,6 +61,7 @@ void ShaderAgent::doInit(const ShaderInfo &info) {
 }
 
 void ShaderAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         ShaderDestroy,
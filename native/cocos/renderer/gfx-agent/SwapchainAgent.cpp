@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "SwapchainAgent.h"
 #include "gfx-agent/TextureAgent.h"
@@ -77,9 +78,16 @@ void SwapchainAgent::doInit(const SwapchainInfo &info) {
     initTexture(textureInfo, _depthStencilTexture);
 
     _transform = _actor->getSurfaceTransform();
+
+    // the textures are recreated with the swapchain
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) {
+        capture->create(CaptureOp::CREATE_SWAPCHAIN, this, info, _colorTexture->getObjectID(), _depthStencilTexture->getObjectID(),
+                        _colorTexture->getFormat(), _depthStencilTexture->getFormat());
+    }
 }
 
 void SwapchainAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     _depthStencilTexture = nullptr;
     _colorTexture        = nullptr;
 
@@ -92,6 +100,7 @@ void SwapchainAgent::doDestroy() {
 }
 
 void SwapchainAgent::doResize(uint32_t width, uint32_t height, SurfaceTransform transform) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->resize(CaptureOp::SWAPCHAIN_RESIZE, this, width, height, transform);
     auto *mq = DeviceAgent::getInstance()->getMessageQueue();
 
     ENQUEUE_MESSAGE_4(
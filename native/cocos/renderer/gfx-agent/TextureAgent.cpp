@@ -25,6 +25,7 @@
 
 #include "base/threading/MessageQueue.h"
 
+#include "CommandCapture.h"
 #include "DeviceAgent.h"
 #include "TextureAgent.h"
 #include "gfx-agent/SwapchainAgent.h"
@@ -40,6 +41,7 @@ TextureAgent::TextureAgent(Texture *actor)
 
 TextureAgent::~TextureAgent() {
     if (_ownTheActor) {
+        if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
         ENQUEUE_MESSAGE_1(
             DeviceAgent::getInstance()->getMessageQueue(),
             TextureDestruct,
@@ -51,6 +53,7 @@ TextureAgent::~TextureAgent() {
 }
 
 void TextureAgent::doInit(const TextureInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_TEXTURE, this, info);
     ENQUEUE_MESSAGE_2(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureInit,
@@ -62,6 +65,7 @@ void TextureAgent::doInit(const TextureInfo &info) {
 }
 
 void TextureAgent::doInit(const TextureViewInfo &info) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->create(CaptureOp::CREATE_TEXTURE_VIEW, this, info);
     TextureViewInfo actorInfo = info;
     actorInfo.texture         = static_cast<TextureAgent *>(info.texture)->getActor();
 
@@ -80,6 +84,7 @@ void TextureAgent::doInit(const SwapchainTextureInfo &info) {
 }
 
 void TextureAgent::doDestroy() {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->destroy(this);
     ENQUEUE_MESSAGE_1(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureDestroy,
@@ -90,6 +95,7 @@ void TextureAgent::doDestroy() {
 }
 
 void TextureAgent::doResize(uint32_t width, uint32_t height, uint32_t /*size*/) {
+    if (auto *capture = DeviceAgent::getInstance()->getCapture()) capture->resize(CaptureOp::TEXTURE_RESIZE, this, width, height);
     ENQUEUE_MESSAGE_3(
         DeviceAgent::getInstance()->getMessageQueue(),
         TextureResize,
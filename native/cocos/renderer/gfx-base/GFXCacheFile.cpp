@@ -0,0 +1,103 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "GFXCacheFile.h"
+#include <cstring>
+#include "base/Data.h"
+#include "base/Log.h"
+#include "platform/FileUtils.h"
+
+namespace cc {
+namespace gfx {
+
+namespace {
+constexpr uint32_t CACHE_FILE_MAGIC   = 0x43434743; // CCGC
+constexpr uint32_t CACHE_FILE_VERSION = 1;
+constexpr char     CACHE_FILE_DIR[]   = "gfx-cache/";
+
+struct CacheFileHeader {
+    uint32_t magic{CACHE_FILE_MAGIC};
+    uint32_t version{CACHE_FILE_VERSION};
+    uint32_t keySize{0};
+    uint32_t dataSize{0};
+};
+} // namespace
+
+ccstd::string CacheFile::getPath(const ccstd::string &name) {
+    return FileUtils::getInstance()->getWritablePath() + CACHE_FILE_DIR + name;
+}
+
+bool CacheFile::load(const ccstd::string &name, const void *key, uint32_t keySize, ccstd::vector<uint8_t> &data) {
+    auto *const         fileUtils = FileUtils::getInstance();
+    const ccstd::string path      = getPath(name);
+    if (!fileUtils->isFileExist(path)) {
+        return false;
+    }
+
+    MappedFile      file  = fileUtils->mapFile(path);
+    const auto *    bytes = file.getBytes();
+    const auto      size  = file.getSize();
+    CacheFileHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, bytes, sizeof(header));
+    if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION || header.keySize != keySize ||
+        size != sizeof(header) + header.keySize + header.dataSize || memcmp(bytes + sizeof(header), key, keySize) != 0) {
+        CC_LOG_INFO("Discard outdated gfx cache %s", name.c_str());
+        file.reset(); // a mapped file can't be removed on windows
+        fileUtils->removeFile(path);
+        return false;
+    }
+
+    const auto *payload = bytes + sizeof(header) + keySize;
+    data.assign(payload, payload + header.dataSize);
+    return true;
+}
+
+bool CacheFile::save(const ccstd::string &name, const void *key, uint32_t keySize, const void *data, uint32_t size) {
+    auto *const fileUtils = FileUtils::getInstance();
+    const auto  dir       = fileUtils->getWritablePath() + CACHE_FILE_DIR;
+    if (!fileUtils->isDirectoryExist(dir) && !fileUtils->createDirectory(dir)) {
+        return false;
+    }
+
+    CacheFileHeader header;
+    header.keySize  = keySize;
+    header.dataSize = size;
+
+    Data file;
+    file.resize(static_cast<ssize_t>(sizeof(header) + keySize + size));
+    auto *bytes = file.getBytes();
+    memcpy(bytes, &header, sizeof(header));
+    memcpy(bytes + sizeof(header), key, keySize);
+    if (size) {
+        memcpy(bytes + sizeof(header) + keySize, data, size);
+    }
+    return fileUtils->writeDataToFile(file, dir + name);
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,50 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * @en Binary blobs persisted in the writable path across launches, used by the backends to keep driver caches.
+ * Each blob is tagged with a key, e.g. the device and driver identifiers, and is discarded if the key doesn't match.
+ * @zh 持久化保存在可写路径中的二进制数据，供各后端跨启动保存驱动缓存。
+ * 每份数据都带有一个键，例如设备和驱动的标识，键不匹配时数据会被丢弃。
+ */
+class CC_DLL CacheFile final {
+public:
+    static ccstd::string getPath(const ccstd::string &name);
+
+    static bool load(const ccstd::string &name, const void *key, uint32_t keySize, ccstd::vector<uint8_t> &data);
+    static bool save(const ccstd::string &name, const void *key, uint32_t keySize, const void *data, uint32_t size);
+};
+
+} // namespace gfx
+} // namespace cc
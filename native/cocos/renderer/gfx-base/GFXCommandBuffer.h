@@ -60,6 +60,7 @@ public:
     virtual void setStencilCompareMask(StencilFace face, uint32_t ref, uint32_t mask)                                                                                                                                 = 0;
     virtual void nextSubpass()                                                                                                                                                                                        = 0;
     virtual void draw(const DrawInfo &info)                                                                                                                                                                           = 0;
+    virtual void drawIndirect(const DrawIndirectInfo &info)                                                                                                                                                           = 0;
     virtual void updateBuffer(Buffer *buff, const void *data, uint32_t size)                                                                                                                                          = 0;
     virtual void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count)                                                                              = 0;
     virtual void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter)                                                                                     = 0;
@@ -70,6 +71,8 @@ public:
     virtual void endQuery(QueryPool *queryPool, uint32_t id)                                                                                                                                                          = 0;
     virtual void resetQueryPool(QueryPool *queryPool)                                                                                                                                                                 = 0;
     virtual void completeQueryPool(QueryPool *queryPool) {}
+    // writes the GPU timestamp into a TIMESTAMP query pool once all previous commands are completed
+    virtual void writeTimestamp(QueryPool *queryPool, uint32_t id) {}
 
     inline void begin();
     inline void begin(RenderPass *renderPass);
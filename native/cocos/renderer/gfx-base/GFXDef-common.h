@@ -93,6 +93,12 @@ constexpr uint32_t SUBPASS_EXTERNAL = ~0U;
 // Although the standard is not limited, some devices do not support up to 65536 queries
 constexpr uint32_t DEFAULT_MAX_QUERY_OBJECTS = 32767;
 
+// size of the sampler texture arrays guaranteed by Feature::BINDLESS_TEXTURE
+constexpr uint32_t MAX_BINDLESS_TEXTURES = 256U;
+
+// number of views guaranteed by Feature::MULTIVIEW, enough for stereo rendering
+constexpr uint32_t MAX_VIEW_COUNT = 2U;
+
 using BufferList              = ccstd::vector<Buffer *>;
 using TextureList             = ccstd::vector<Texture *>;
 using SamplerList             = ccstd::vector<Sampler *>;
@@ -172,6 +178,19 @@ enum class Feature : uint32_t {
     // the max number of attachment limit(4) situation for many devices, and shader
     // sources inside this kind of subpass must match this behavior.
     INPUT_ATTACHMENT_BENEFIT,
+    // Several indirect draws are submitted in a single call, otherwise CommandBuffer::drawIndirect loops over the commands.
+    MULTI_DRAW_INDIRECT,
+    // DrawIndirectInfo::countBuffer is supported.
+    DRAW_INDIRECT_COUNT,
+    // Sampler texture arrays of MAX_BINDLESS_TEXTURES elements can be bound and indexed
+    // with values varying within a draw, e.g. read from an instance attribute.
+    BINDLESS_TEXTURE,
+    // PipelineState::initialize can be called from other threads, concurrently with
+    // command recording and the creation of other pipeline states.
+    ASYNC_PIPELINE_STATE,
+    // Render passes with RenderPassInfo::viewCount up to MAX_VIEW_COUNT broadcast each draw to the
+    // layers of their array attachments, the shaders read the index of the view being rendered.
+    MULTIVIEW,
     COUNT,
 };
 CC_ENUM_CONVERSION_OPERATOR(Feature);
@@ -462,9 +481,10 @@ using TextureUsage = TextureUsageBit;
 CC_ENUM_BITWISE_OPERATORS(TextureUsageBit);
 
 enum class TextureFlagBit : uint32_t {
-    NONE           = 0,
-    GEN_MIPMAP     = 0x1, // Generate mipmaps using bilinear filter
-    GENERAL_LAYOUT = 0x2, // For inout framebuffer attachments
+    NONE             = 0,
+    GEN_MIPMAP       = 0x1, // Generate mipmaps using bilinear filter
+    GENERAL_LAYOUT   = 0x2, // For inout framebuffer attachments
+    LAZILY_ALLOCATED = 0x4, // Contents never leave the render pass, backends may keep them in tile memory only
 };
 using TextureFlags = TextureFlagBit;
 CC_ENUM_BITWISE_OPERATORS(TextureFlagBit);
@@ -810,7 +830,9 @@ struct DeviceCaps {
     Size     maxComputeWorkGroupSize;
     Size     maxComputeWorkGroupCount;
 
-    bool supportQuery{false};
+    bool  supportQuery{false};
+    bool  supportTimestampQuery{false};
+    float timestampPeriod{1.F}; // nanoseconds per timestamp tick
 
     float clipSpaceMinZ{-1.F};
     float screenSpaceSignY{1.F};
@@ -1012,6 +1034,36 @@ struct IndirectBuffer {
     EXPOSE_COPY_FN(IndirectBuffer)
 };
 
+// Layouts of the commands read by CommandBuffer::drawIndirect from buffers written on the GPU, same as the native APIs.
+// Buffers filled by Buffer::update hold DrawInfos instead, which are translated by the backends.
+struct DrawIndirectCommand {
+    uint32_t vertexCount{0};
+    uint32_t instanceCount{0};
+    uint32_t firstVertex{0};
+    uint32_t firstInstance{0};
+};
+
+struct DrawIndexedIndirectCommand {
+    uint32_t indexCount{0};
+    uint32_t instanceCount{0};
+    uint32_t firstIndex{0};
+    int32_t  vertexOffset{0};
+    uint32_t firstInstance{0};
+};
+
+// Draws are indexed if the bound input assembler has an index buffer.
+struct DrawIndirectInfo {
+    Buffer * buffer{nullptr};
+    uint32_t offset{0};    // in bytes, of the first command
+    uint32_t drawCount{0}; // the maximum draw count if countBuffer is set
+    uint32_t stride{0};    // in bytes, 0 for tightly packed commands
+
+    Buffer * countBuffer{nullptr}; // @ts-nullable
+    uint32_t countOffset{0};
+
+    EXPOSE_COPY_FN(DrawIndirectInfo)
+};
+
 struct ALIGNAS(8) TextureInfo {
     TextureType  type{TextureType::TEX2D};
     TextureUsage usage{TextureUsageBit::NONE};
@@ -1285,6 +1337,8 @@ struct RenderPassInfo {
     DepthStencilAttachment depthStencilAttachment;
     SubpassInfoList        subpasses;
     SubpassDependencyList  dependencies;
+    // more than one needs Feature::MULTIVIEW, the attachments are arrays of at least as many layers
+    uint32_t               viewCount{1U};
 
     EXPOSE_COPY_FN(RenderPassInfo)
 };
@@ -1501,6 +1555,15 @@ struct MemoryStatus {
     EXPOSE_COPY_FN(MemoryStatus)
 };
 
+// Accumulated since the device is initialized, hits and misses are only counted by backends which can tell them apart.
+struct PipelineCacheStatus {
+    uint32_t hits{0};           // pipelines served from the cache persisted by previous launches
+    uint32_t misses{0};         // pipelines compiled from scratch
+    float    creationTime{0.F}; // total pipeline creation time in milliseconds
+
+    EXPOSE_COPY_FN(PipelineCacheStatus)
+};
+
 struct DynamicStencilStates {
     uint32_t writeMask{0};
     uint32_t compareMask{0};
@@ -99,6 +99,7 @@ size_t Hasher<RenderPassInfo>::operator()(const RenderPassInfo &info) const {
     boost::hash_combine(seed, info.depthStencilAttachment);
     boost::hash_combine(seed, info.subpasses);
     boost::hash_combine(seed, info.dependencies);
+    boost::hash_combine(seed, info.viewCount);
     return seed;
 }
 
@@ -106,7 +107,8 @@ bool operator==(const RenderPassInfo &lhs, const RenderPassInfo &rhs) {
     return lhs.colorAttachments == rhs.colorAttachments &&
            lhs.depthStencilAttachment == rhs.depthStencilAttachment &&
            lhs.subpasses == rhs.subpasses &&
-           lhs.dependencies == rhs.dependencies;
+           lhs.dependencies == rhs.dependencies &&
+           lhs.viewCount == rhs.viewCount;
 }
 
 template <>
@@ -63,6 +63,7 @@ void DescriptorSet::bindBuffer(uint32_t binding, Buffer *buffer, uint32_t index)
     if (_buffers[descriptorIndex + index] != buffer) {
         _buffers[descriptorIndex + index] = buffer;
         _isDirty                          = true;
+        ++_bindingVersion;
     }
 }
 
@@ -71,6 +72,7 @@ void DescriptorSet::bindTexture(uint32_t binding, Texture *texture, uint32_t ind
     if (_textures[descriptorIndex + index] != texture) {
         _textures[descriptorIndex + index] = texture;
         _isDirty                           = true;
+        ++_bindingVersion;
     }
 }
 
@@ -79,6 +81,7 @@ void DescriptorSet::bindSampler(uint32_t binding, Sampler *sampler, uint32_t ind
     if (_samplers[descriptorIndex + index] != sampler) {
         _samplers[descriptorIndex + index] = sampler;
         _isDirty                           = true;
+        ++_bindingVersion;
     }
 }
 
@@ -54,7 +54,10 @@ public:
     Texture *getTexture(uint32_t binding, uint32_t index) const;
     Sampler *getSampler(uint32_t binding, uint32_t index) const;
 
-    inline DescriptorSetLayout *getLayout() { return _layout; }
+    inline DescriptorSetLayout *      getLayout() { return _layout; }
+    inline const DescriptorSetLayout *getLayout() const { return _layout; }
+    // increased whenever a binding changes
+    inline uint32_t getBindingVersion() const { return _bindingVersion; }
 
     inline void     bindBuffer(uint32_t binding, Buffer *buffer) { bindBuffer(binding, buffer, 0U); }
     inline void     bindTexture(uint32_t binding, Texture *texture) { bindTexture(binding, texture, 0U); }
@@ -72,7 +75,8 @@ protected:
     TextureList          _textures;
     SamplerList          _samplers;
 
-    bool _isDirty = false;
+    bool     _isDirty        = false;
+    uint32_t _bindingVersion = 0;
 };
 
 } // namespace gfx
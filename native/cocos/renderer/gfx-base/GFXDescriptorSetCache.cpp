@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <boost/functional/hash.hpp>
+
+#include "GFXDescriptorSet.h"
+#include "GFXDescriptorSetCache.h"
+#include "GFXDescriptorSetLayout.h"
+#include "GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+DescriptorSetCache::DescriptorSetCache(Device *device) : _device(device) {}
+
+DescriptorSetCache::~DescriptorSetCache() {
+    destroy();
+}
+
+size_t DescriptorSetCache::computeHash(const DescriptorSet *source) {
+    const auto *layout = source->getLayout();
+    size_t      seed   = 0;
+    boost::hash_combine(seed, layout);
+    for (const auto &binding : layout->getBindings()) {
+        for (uint32_t i = 0; i < binding.count; ++i) {
+            boost::hash_combine(seed, source->getBuffer(binding.binding, i));
+            boost::hash_combine(seed, source->getTexture(binding.binding, i));
+            boost::hash_combine(seed, source->getSampler(binding.binding, i));
+        }
+    }
+    return seed;
+}
+
+bool DescriptorSetCache::isEqual(const DescriptorSet *lhs, const DescriptorSet *rhs) {
+    const auto *layout = lhs->getLayout();
+    if (layout != rhs->getLayout()) {
+        return false;
+    }
+    for (const auto &binding : layout->getBindings()) {
+        for (uint32_t i = 0; i < binding.count; ++i) {
+            if (lhs->getBuffer(binding.binding, i) != rhs->getBuffer(binding.binding, i) ||
+                lhs->getTexture(binding.binding, i) != rhs->getTexture(binding.binding, i) ||
+                lhs->getSampler(binding.binding, i) != rhs->getSampler(binding.binding, i)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+DescriptorSet *DescriptorSetCache::acquire(const DescriptorSet *source) {
+    if (!source || !source->getLayout()) {
+        return nullptr;
+    }
+
+    const size_t hash  = computeHash(source);
+    auto &       entry = _entries[hash];
+    if (entry.set) {
+        if (!isEqual(entry.set, source)) {
+            return nullptr; // hash collision, rare enough to not be worth sharing
+        }
+        ++entry.refCount;
+        ++_status.hits;
+        return entry.set;
+    }
+
+    auto *layout = const_cast<DescriptorSetLayout *>(source->getLayout());
+    auto *set    = _device->createDescriptorSet({layout});
+    for (const auto &binding : layout->getBindings()) {
+        for (uint32_t i = 0; i < binding.count; ++i) {
+            if (auto *buffer = source->getBuffer(binding.binding, i)) set->bindBuffer(binding.binding, buffer, i);
+            if (auto *texture = source->getTexture(binding.binding, i)) set->bindTexture(binding.binding, texture, i);
+            if (auto *sampler = source->getSampler(binding.binding, i)) set->bindSampler(binding.binding, sampler, i);
+        }
+    }
+    set->update();
+
+    entry.set      = set;
+    entry.refCount = 1;
+    _hashes[set]   = hash;
+    ++_status.allocations;
+    return set;
+}
+
+void DescriptorSetCache::release(DescriptorSet *set) {
+    const auto it = _hashes.find(set);
+    if (it == _hashes.end()) {
+        return;
+    }
+
+    auto &entry = _entries[it->second];
+    if (--entry.refCount == 0) {
+        CC_SAFE_DESTROY_NULL(entry.set);
+        _entries.erase(it->second);
+        _hashes.erase(it);
+    }
+}
+
+void DescriptorSetCache::destroy() {
+    for (auto &pair : _entries) {
+        CC_SAFE_DESTROY_NULL(pair.second.set);
+    }
+    _entries.clear();
+    _hashes.clear();
+}
+
+void DescriptorSetCache::nextFrame() {
+    _status.liveSets = static_cast<uint32_t>(_entries.size());
+    _lastStatus      = _status;
+    _status          = {};
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/unordered_map.h"
+#include "gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+
+struct DescriptorSetCacheStatus {
+    uint32_t allocations{0}; // shared sets created in the last frame
+    uint32_t hits{0};        // requests served by an existing shared set in the last frame
+    uint32_t liveSets{0};
+};
+
+/**
+ * @en Content hashed descriptor sets shared among users binding exactly the same buffers, textures and samplers,
+ * e.g. the submodels of a model. Users keep binding into their own set as the source and acquire the shared set
+ * holding the same descriptors, which is written only once when created and never changed afterwards.
+ * The shared sets are reference counted and destroyed once the last user releases them. Not thread safe.
+ * @zh 基于内容哈希的描述符集缓存，绑定完全相同的缓冲、纹理和采样器的使用者（例如同一模型的各个子模型）共享同一个描述符集。
+ * 使用者仍然绑定到其自身的描述符集作为源，并获取持有相同描述符的共享描述符集，共享描述符集只在创建时写入一次，之后不再修改。
+ * 共享描述符集带有引用计数，最后一个使用者释放时销毁。非线程安全。
+ */
+class CC_DLL DescriptorSetCache final {
+public:
+    explicit DescriptorSetCache(Device *device);
+    ~DescriptorSetCache();
+
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+    inline bool isEnabled() const { return _enabled; }
+
+    // returns nullptr if the source can't be shared, in which case the source itself should be used
+    DescriptorSet *acquire(const DescriptorSet *source);
+    void           release(DescriptorSet *set);
+    void           destroy();
+
+    // stats of the frame which just ended, to be called once per frame
+    void                                   nextFrame();
+    inline const DescriptorSetCacheStatus &getStatus() const { return _lastStatus; }
+
+private:
+    struct Entry {
+        IntrusivePtr<DescriptorSet> set;
+        uint32_t                    refCount{0};
+    };
+
+    static size_t computeHash(const DescriptorSet *source);
+    static bool   isEqual(const DescriptorSet *lhs, const DescriptorSet *rhs);
+
+    Device *                                            _device{nullptr};
+    bool                                                _enabled{false};
+    ccstd::unordered_map<size_t, Entry>                 _entries;
+    ccstd::unordered_map<const DescriptorSet *, size_t> _hashes;
+    DescriptorSetCacheStatus                            _status;
+    DescriptorSetCacheStatus                            _lastStatus;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(DescriptorSetCache);
+};
+
+} // namespace gfx
+} // namespace cc
@@ -27,6 +27,8 @@
 #include "GFXObject.h"
 #include "base/memory/Memory.h"
 
+#include <cstring>
+
 namespace cc {
 namespace gfx {
 
@@ -69,19 +71,8 @@ bool Device::initialize(const DeviceInfo &info) {
 }
 
 void Device::destroy() {
-    for (auto pair : _samplers) {
-        CC_SAFE_DELETE(pair.second);
-    }
     _samplers.clear();
-
-    for (auto pair : _generalBarriers) {
-        CC_SAFE_DELETE(pair.second);
-    }
     _generalBarriers.clear();
-
-    for (auto pair : _textureBarriers) {
-        CC_SAFE_DELETE(pair.second);
-    }
     _textureBarriers.clear();
 
     doDestroy();
@@ -110,24 +101,95 @@ void Device::createSurface(void *windowHandle) {
 }
 
 Sampler *Device::getSampler(const SamplerInfo &info) {
-    if (!_samplers.count(info)) {
-        _samplers[info] = createSampler(info);
-    }
-    return _samplers[info];
+    return _samplers.get(info, [this](const SamplerInfo &key) { return createSampler(key); });
 }
 
 GeneralBarrier *Device::getGeneralBarrier(const GeneralBarrierInfo &info) {
-    if (!_generalBarriers.count(info)) {
-        _generalBarriers[info] = createGeneralBarrier(info);
-    }
-    return _generalBarriers[info];
+    return _generalBarriers.get(info, [this](const GeneralBarrierInfo &key) { return createGeneralBarrier(key); });
 }
 
 TextureBarrier *Device::getTextureBarrier(const TextureBarrierInfo &info) {
-    if (!_textureBarriers.count(info)) {
-        _textureBarriers[info] = createTextureBarrier(info);
+    return _textureBarriers.get(info, [this](const TextureBarrierInfo &key) { return createTextureBarrier(key); });
+}
+
+uint32_t Device::requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    uint32_t handle = createTextureReadback(src->getFormat(), regions, count);
+    doTextureReadback(handle, src, regions, count);
+    return handle;
+}
+
+bool Device::isTextureReadbackReady(uint32_t handle) {
+    std::lock_guard<std::mutex> lock(_readbackMutex);
+    auto                        iter = _readbacks.find(handle);
+    return iter != _readbacks.end() && iter->second.ready;
+}
+
+bool Device::getTextureReadbackData(uint32_t handle, uint8_t *const *buffers) {
+    std::lock_guard<std::mutex> lock(_readbackMutex);
+    auto                        iter = _readbacks.find(handle);
+    if (iter == _readbacks.end() || !iter->second.ready) {
+        return false;
+    }
+    const TextureReadback &readback = iter->second;
+    for (size_t i = 0U; i + 1 < readback.regionOffsets.size(); ++i) {
+        const uint32_t offset = readback.regionOffsets[i];
+        memcpy(buffers[i], readback.data.data() + offset, readback.regionOffsets[i + 1] - offset);
+    }
+    _readbacks.erase(iter);
+    return true;
+}
+
+void Device::releaseTextureReadback(uint32_t handle) {
+    std::lock_guard<std::mutex> lock(_readbackMutex);
+    // the data still in flight is dropped on arrival
+    _readbacks.erase(handle);
+}
+
+uint32_t Device::getReadbackRegionSize(Format format, const BufferTextureCopy &region) {
+    uint32_t w = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+    uint32_t h = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+    return formatSize(format, w, h, region.texExtent.depth);
+}
+
+uint32_t Device::createTextureReadback(Format format, const BufferTextureCopy *regions, uint32_t count) {
+    std::lock_guard<std::mutex> lock(_readbackMutex);
+    if (!++_readbackHandle) ++_readbackHandle; // 0 is never a valid handle
+
+    TextureReadback &readback = _readbacks[_readbackHandle];
+    readback.regionOffsets.resize(count + 1);
+    uint32_t totalSize = 0U;
+    for (uint32_t i = 0U; i < count; ++i) {
+        readback.regionOffsets[i] = totalSize;
+        totalSize += getReadbackRegionSize(format, regions[i]);
+    }
+    readback.regionOffsets[count] = totalSize;
+    return _readbackHandle;
+}
+
+void Device::doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    // backends without asynchronous readback copy synchronously
+    ccstd::vector<uint32_t> offsets(count + 1);
+    for (uint32_t i = 0U; i < count; ++i) {
+        offsets[i + 1] = offsets[i] + getReadbackRegionSize(src->getFormat(), regions[i]);
+    }
+    ccstd::vector<uint8_t>   data(offsets[count]);
+    ccstd::vector<uint8_t *> buffers(count);
+    for (uint32_t i = 0U; i < count; ++i) {
+        buffers[i] = data.data() + offsets[i];
+    }
+    copyTextureToBuffers(src, buffers.data(), regions, count);
+    finishTextureReadback(handle, data.data());
+}
+
+void Device::finishTextureReadback(uint32_t handle, const uint8_t *data) {
+    std::lock_guard<std::mutex> lock(_readbackMutex);
+    auto                        iter = _readbacks.find(handle);
+    if (iter == _readbacks.end()) {
+        return; // released before arrival
     }
-    return _textureBarriers[info];
+    TextureReadback &readback = iter->second;
+    readback.data.assign(data, data + readback.regionOffsets.back());
+    readback.ready = true;
 }
 
 } // namespace gfx
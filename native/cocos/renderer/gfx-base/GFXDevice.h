@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "GFXBuffer.h"
 #include "GFXCommandBuffer.h"
 #include "GFXDescriptorSet.h"
@@ -32,6 +33,7 @@
 #include "GFXFramebuffer.h"
 #include "GFXInputAssembler.h"
 #include "GFXObject.h"
+#include "GFXObjectCache.h"
 #include "GFXPipelineLayout.h"
 #include "GFXPipelineState.h"
 #include "GFXQueryPool.h"
@@ -42,6 +44,7 @@
 #include "GFXTexture.h"
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
+#include "base/std/container/unordered_map.h"
 #include "states/GFXGeneralBarrier.h"
 #include "states/GFXSampler.h"
 #include "states/GFXTextureBarrier.h"
@@ -67,6 +70,11 @@ public:
     virtual uint32_t      getNumDrawCalls() const { return _numDrawCalls; }
     virtual uint32_t      getNumInstances() const { return _numInstances; }
     virtual uint32_t      getNumTris() const { return _numTriangles; }
+    // GL state calls issued and skipped by the backend state cache in the last frame
+    virtual uint32_t      getNumStateCalls() const { return _numStateCalls; }
+    virtual uint32_t      getNumSkippedStateCalls() const { return _numSkippedStateCalls; }
+
+    virtual PipelineCacheStatus &getPipelineCacheStatus() { return _pipelineCacheStatus; }
 
     inline CommandBuffer *      createCommandBuffer(const CommandBufferInfo &info);
     inline Queue *              createQueue(const QueueInfo &info);
@@ -94,6 +102,23 @@ public:
     virtual void getQueryPoolResults(QueryPool *queryPool)                                                                           = 0;
 
     inline void copyTextureToBuffers(Texture *src, BufferSrcList &buffers, const BufferTextureCopyList &regions);
+
+    /**
+     * @en Copy the regions of a texture to host memory without waiting for the GPU. The data can be fetched
+     * once the returned handle is ready, usually a few frames later. Each handle is released by
+     * getTextureReadbackData or releaseTextureReadback.
+     * @zh 不等待 GPU 地将纹理的若干区域拷贝到内存。返回的句柄就绪后（通常在几帧之后）即可获取数据。
+     * 每个句柄需通过 getTextureReadbackData 或 releaseTextureReadback 释放。
+     * @param src The texture to read.
+     * @param regions The regions to read, the data of each region is packed like copyTextureToBuffers does.
+     * @param count The number of regions.
+     * @return The handle of the readback.
+     */
+    virtual uint32_t requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count);
+    virtual bool     isTextureReadbackReady(uint32_t handle);
+    // copies the data of each region to buffers and releases the handle, fails if the readback is not ready
+    virtual bool getTextureReadbackData(uint32_t handle, uint8_t *const *buffers);
+    virtual void releaseTextureReadback(uint32_t handle);
     inline void copyBuffersToTexture(const BufferDataList &buffers, Texture *dst, const BufferTextureCopyList &regions);
     inline void flushCommands(const ccstd::vector<CommandBuffer *> &cmdBuffs);
     inline void acquire(const ccstd::vector<Swapchain *> &swapchains);
@@ -157,6 +182,13 @@ protected:
     // For context switching between threads
     virtual void bindContext(bool bound) {}
 
+    // thread safe, the backend calls finishTextureReadback with the packed data of all regions when it arrives
+    uint32_t     createTextureReadback(Format format, const BufferTextureCopy *regions, uint32_t count);
+    virtual void doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count);
+    void         finishTextureReadback(uint32_t handle, const uint8_t *data);
+
+    static uint32_t getReadbackRegionSize(Format format, const BufferTextureCopy &region);
+
     ccstd::string      _deviceName;
     ccstd::string      _renderer;
     ccstd::string      _vendor;
@@ -178,15 +210,31 @@ protected:
     uint32_t     _numDrawCalls{0U};
     uint32_t     _numInstances{0U};
     uint32_t     _numTriangles{0U};
+    uint32_t     _numStateCalls{0U};
+    uint32_t     _numSkippedStateCalls{0U};
     MemoryStatus _memoryStatus;
 
-    ccstd::unordered_map<SamplerInfo, Sampler *, Hasher<SamplerInfo>>                      _samplers;
-    ccstd::unordered_map<GeneralBarrierInfo, GeneralBarrier *, Hasher<GeneralBarrierInfo>> _generalBarriers;
-    ccstd::unordered_map<TextureBarrierInfo, TextureBarrier *, Hasher<TextureBarrierInfo>> _textureBarriers;
+    PipelineCacheStatus _pipelineCacheStatus;
+
+    // safe to be queried from parallel command recording threads
+    ConcurrentObjectCache<SamplerInfo, Sampler>               _samplers;
+    ConcurrentObjectCache<GeneralBarrierInfo, GeneralBarrier> _generalBarriers;
+    ConcurrentObjectCache<TextureBarrierInfo, TextureBarrier> _textureBarriers;
 
 private:
+    struct TextureReadback {
+        ccstd::vector<uint8_t>  data;
+        ccstd::vector<uint32_t> regionOffsets; // one more than the regions, the last one is the total size
+        bool                    ready{false};
+    };
+
     ccstd::vector<Swapchain *> _swapchains; // weak reference
     bool                       _rendererAvailable{false};
+    bool                       _vsyncDisabled{false}; // swapchains ignore the vsync mode asked for, set by DeviceManager
+
+    std::mutex                                      _readbackMutex;
+    ccstd::unordered_map<uint32_t, TextureReadback> _readbacks;
+    uint32_t                                        _readbackHandle{0U};
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -211,7 +259,13 @@ QueryPool *Device::createQueryPool(const QueryPoolInfo &info) {
 
 Swapchain *Device::createSwapchain(const SwapchainInfo &info) {
     Swapchain *res = createSwapchain();
-    res->initialize(info);
+    if (_vsyncDisabled) {
+        SwapchainInfo unsynced = info;
+        unsynced.vsyncMode     = VsyncMode::OFF;
+        res->initialize(unsynced);
+    } else {
+        res->initialize(info);
+    }
     _swapchains.push_back(res);
 #if CC_PLATFORM == CC_PLATFORM_ANDROID || CC_PLATFORM == CC_PLATFORM_OHOS
     if (res->getWindowHandle()) {
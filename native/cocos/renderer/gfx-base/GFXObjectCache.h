@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/unordered_map.h"
+#include "base/threading/ReadWriteLock.h"
+#include "gfx-base/GFXDef.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * @en Thread safe cache of immutable device objects created from plain info structs, e.g. samplers and barriers.
+ * The cache is split into shards each guarded by its own read-write lock, so lookups from parallel command
+ * recording threads only take a shared lock on one shard and rarely contend. The hash of the info is computed
+ * once per lookup and used both to pick the shard and as the key inside it.
+ * Cached objects are owned by the cache and live until clear is called.
+ * @zh 线程安全的设备对象缓存，用于由简单描述结构体创建的不可变对象，例如采样器和屏障。
+ * 缓存被划分为多个分片，每个分片由独立的读写锁保护，并行录制命令的线程查询时只需获取单个分片的共享锁，很少发生竞争。
+ * 描述结构体的哈希值在每次查询时只计算一次，同时用于选择分片和作为分片内的键。
+ * 缓存的对象由缓存持有，直到调用 clear 时销毁。
+ */
+template <typename Info, typename Object>
+class ConcurrentObjectCache final {
+public:
+    ConcurrentObjectCache() = default;
+    ~ConcurrentObjectCache() { clear(); }
+
+    template <typename Creator>
+    Object *get(const Info &info, Creator &&creator);
+    void    clear();
+
+private:
+    static constexpr uint32_t SHARD_COUNT = 16U;
+
+    struct Key {
+        Info   info;
+        size_t hash{0};
+
+        bool operator==(const Key &rhs) const { return hash == rhs.hash && info == rhs.info; }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key &key) const { return key.hash; }
+    };
+
+    struct Shard {
+        ccstd::unordered_map<Key, Object *, KeyHasher> objects;
+        ReadWriteLock                                  lock;
+    };
+
+    // some hashers only fill the low bits (e.g. the bit-packed sampler hash),
+    // so spread them with a fibonacci multiply and take the shard from the top bits
+    static uint32_t shardIndex(size_t hash) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 60U) % SHARD_COUNT;
+    }
+
+    ccstd::array<Shard, SHARD_COUNT> _shards;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ConcurrentObjectCache);
+};
+
+template <typename Info, typename Object>
+template <typename Creator>
+Object *ConcurrentObjectCache<Info, Object>::get(const Info &info, Creator &&creator) {
+    const Key key{info, Hasher<Info>()(info)};
+    Shard &   shard = _shards[shardIndex(key.hash)];
+
+    Object *object = shard.lock.lockRead([&shard, &key]() -> Object * {
+        const auto iter = shard.objects.find(key);
+        return iter != shard.objects.end() ? iter->second : nullptr;
+    });
+    if (object) return object;
+
+    return shard.lock.lockWrite([&shard, &key, &creator]() -> Object * {
+        // another thread may have created it between the two locks
+        auto &cached = shard.objects[key];
+        if (!cached) cached = creator(key.info);
+        return cached;
+    });
+}
+
+template <typename Info, typename Object>
+void ConcurrentObjectCache<Info, Object>::clear() {
+    for (auto &shard : _shards) {
+        shard.lock.lockWrite([&shard]() {
+            for (auto &pair : shard.objects) {
+                CC_SAFE_DELETE(pair.second);
+            }
+            shard.objects.clear();
+        });
+    }
+}
+
+} // namespace gfx
+} // namespace cc
@@ -51,6 +51,7 @@ size_t RenderPass::computeHash() {
     boost::hash_combine(seed, ds.sampleCount);
 
     boost::hash_combine(seed, _subpasses);
+    boost::hash_combine(seed, _viewCount);
     return seed;
 }
 
@@ -63,6 +64,7 @@ void RenderPass::initialize(const RenderPassInfo &info) {
     _depthStencilAttachment = info.depthStencilAttachment;
     _subpasses              = info.subpasses;
     _dependencies           = info.dependencies;
+    _viewCount              = info.viewCount;
     _hash                   = computeHash();
 
     doInit(info);
@@ -45,6 +45,7 @@ public:
     inline const DepthStencilAttachment &getDepthStencilAttachment() const { return _depthStencilAttachment; }
     inline const SubpassInfoList &       getSubpasses() const { return _subpasses; }
     inline const SubpassDependencyList & getDependencies() const { return _dependencies; }
+    inline uint32_t                      getViewCount() const { return _viewCount; }
     inline size_t                        getHash() const { return _hash; }
 
 protected:
@@ -57,7 +58,8 @@ protected:
     DepthStencilAttachment _depthStencilAttachment;
     SubpassInfoList        _subpasses;
     SubpassDependencyList  _dependencies;
-    size_t                 _hash = 0;
+    uint32_t               _viewCount = 1U;
+    size_t                 _hash      = 0;
 };
 
 } // namespace gfx
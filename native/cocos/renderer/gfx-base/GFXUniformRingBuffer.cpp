@@ -0,0 +1,73 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "GFXUniformRingBuffer.h"
+#include <algorithm>
+#include "GFXBuffer.h"
+#include "GFXDevice.h"
+
+namespace cc {
+namespace gfx {
+
+UniformRingBuffer::UniformRingBuffer(Device *device, uint32_t size)
+: _alignment(std::max(device->getCapabilities().uboOffsetAlignment, 1U)) {
+    _data.resize(std::max(size, _alignment));
+    _buffer = device->createBuffer({
+        BufferUsageBit::UNIFORM | BufferUsageBit::TRANSFER_DST,
+        MemoryUsageBit::HOST | MemoryUsageBit::DEVICE,
+        static_cast<uint32_t>(_data.size()),
+        _alignment,
+    });
+}
+
+UniformRingBuffer::~UniformRingBuffer() {
+    CC_SAFE_DESTROY_AND_DELETE(_buffer);
+}
+
+UniformRingBuffer::Allocation UniformRingBuffer::allocate(uint32_t size) {
+    const uint32_t offset = (_usedSize + _alignment - 1) / _alignment * _alignment;
+    const uint32_t end    = offset + size;
+    if (end > _data.size()) {
+        _data.resize(std::max(end, static_cast<uint32_t>(_data.size()) * 2));
+    }
+    _usedSize = end;
+    return {_data.data() + offset, offset};
+}
+
+void UniformRingBuffer::flush() {
+    if (!_usedSize) return;
+    // resizing keeps the buffer object, so descriptor sets and buffer views stay valid
+    if (_buffer->getSize() < _data.size()) {
+        _buffer->resize(static_cast<uint32_t>(_data.size()));
+    }
+    _buffer->update(_data.data(), _usedSize);
+}
+
+void UniformRingBuffer::reset() {
+    _usedSize = 0;
+}
+
+} // namespace gfx
+} // namespace cc
@@ -0,0 +1,74 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "GFXDef.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+
+/**
+ * @en Per-frame uniform allocator, slices are suballocated from one uniform buffer and bound with their offsets as dynamic offsets.
+ * The slices are written in place and uploaded with a single update per frame, which is a single copy into the persistently
+ * mapped memory of host visible buffers on Vulkan and a single message through the device agent instead of one per uniform block.
+ * @zh 每帧的 uniform 分配器，从同一个 uniform 缓冲中分配切片，并以其偏移作为动态偏移绑定。
+ * 切片原地写入，每帧只上传一次：在 Vulkan 上只拷贝一次到主机可见缓冲的常驻映射内存，经过设备代理时也只产生一条消息。
+ *
+ * Usage:
+ *  reset at the beginning of the frame
+ *  allocate and write the slices
+ *  flush before the slices are read by the GPU
+ */
+class CC_DLL UniformRingBuffer final {
+public:
+    struct Allocation {
+        uint8_t *data{nullptr}; // valid until the next allocation
+        uint32_t offset{0};     // dynamic offset of the slice
+    };
+
+    UniformRingBuffer(Device *device, uint32_t size);
+    ~UniformRingBuffer();
+
+    Allocation allocate(uint32_t size);
+    void       flush();
+    void       reset();
+
+    inline Buffer * getBuffer() const { return _buffer; }
+    inline uint32_t getAlignment() const { return _alignment; }
+    inline uint32_t getUsedSize() const { return _usedSize; }
+
+private:
+    Buffer *               _buffer{nullptr};
+    ccstd::vector<uint8_t> _data;
+    uint32_t               _alignment{1};
+    uint32_t               _usedSize{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(UniformRingBuffer);
+};
+
+} // namespace gfx
+} // namespace cc
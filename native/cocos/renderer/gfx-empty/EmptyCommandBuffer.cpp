@@ -88,6 +88,9 @@ void EmptyCommandBuffer::nextSubpass() {
 void EmptyCommandBuffer::draw(const DrawInfo &info) {
 }
 
+void EmptyCommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+}
+
 void EmptyCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
 }
 
@@ -52,6 +52,7 @@ enum class GLESCmdType : uint8_t {
     END_RENDER_PASS,
     BIND_STATES,
     DRAW,
+    DRAW_INDIRECT,
     UPDATE_BUFFER,
     COPY_BUFFER_TO_TEXTURE,
     BLIT_TEXTURE,
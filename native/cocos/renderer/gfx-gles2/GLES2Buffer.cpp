@@ -28,6 +28,7 @@
 #include "GLES2Buffer.h"
 #include "GLES2Commands.h"
 #include "GLES2Device.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -55,6 +56,7 @@ void GLES2Buffer::doInit(const BufferInfo & /*info*/) {
 
     cmdFuncGLES2CreateBuffer(GLES2Device::getInstance(), _gpuBuffer);
     GLES2Device::getInstance()->getMemoryStatus().bufferSize += _size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, _size);
     CC_PROFILE_MEMORY_INC(Buffer, _size);
 }
 
@@ -69,6 +71,7 @@ void GLES2Buffer::doInit(const BufferViewInfo &info) {
 void GLES2Buffer::doDestroy() {
     if (_gpuBuffer) {
         GLES2Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+        CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
         CC_PROFILE_MEMORY_DEC(Buffer, _size);
         cmdFuncGLES2DestroyBuffer(GLES2Device::getInstance(), _gpuBuffer);
         CC_DELETE(_gpuBuffer);
@@ -80,11 +83,13 @@ void GLES2Buffer::doDestroy() {
 
 void GLES2Buffer::doResize(uint32_t size, uint32_t count) {
     GLES2Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
     CC_PROFILE_MEMORY_DEC(Buffer, _size);
     _gpuBuffer->size  = size;
     _gpuBuffer->count = count;
     cmdFuncGLES2ResizeBuffer(GLES2Device::getInstance(), _gpuBuffer);
     GLES2Device::getInstance()->getMemoryStatus().bufferSize += size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, size);
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
@@ -286,6 +286,17 @@ void GLES2CommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void GLES2CommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    // no indirect draws in ES 2.0, the draw infos kept on the CPU are expanded into plain draws
+    const GLES2GPUBuffer *gpuBuffer     = static_cast<GLES2Buffer *>(info.buffer)->gpuBuffer();
+    const bool            indexed       = _curGPUInputAssember && _curGPUInputAssember->gpuIndexBuffer;
+    const uint32_t        commandStride = indexed ? sizeof(DrawIndexedIndirectCommand) : sizeof(DrawIndirectCommand);
+    const uint32_t        step          = std::max((info.stride ? info.stride : commandStride) / commandStride, 1U);
+    for (uint32_t i = 0, j = info.offset / commandStride; i < info.drawCount && j < gpuBuffer->indirects.size(); ++i, j += step) {
+        draw(gpuBuffer->indirects[j]);
+    }
+}
+
 void GLES2CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     GLES2GPUBuffer *gpuBuffer = static_cast<GLES2Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
@@ -1080,6 +1080,7 @@ void cmdFuncGLES2CreateShader(GLES2Device *device, GLES2GPUShader *gpuShader) {
             gpuUniform.offset = gpuBlock.size;
             gpuBlock.size += gpuUniform.size;
         }
+        gpuBlock.buff.resize(gpuBlock.size);
         for (uint32_t i = 0; i < gpuBlock.glActiveUniforms.size(); ++i) {
             auto &   activeUniform = gpuBlock.glActiveUniforms[i];
             uint32_t index         = gpuBlock.activeUniformIndices[i];
@@ -2070,11 +2071,25 @@ void cmdFuncGLES2BindState(GLES2Device *device, GLES2GPUPipelineState *gpuPipeli
                 if (dynamicOffsetIndex >= 0) offset = dynamicOffsets[dynamicOffsetIndex];
             }
 
+            uint32_t bufferSize = 0U;
             if (gpuDescriptor.gpuBufferView) {
                 uniformBuffBase = gpuDescriptor.gpuBufferView->gpuBuffer->buffer +
                                   gpuDescriptor.gpuBufferView->offset + offset;
+                bufferSize      = gpuDescriptor.gpuBufferView->range;
             } else if (gpuDescriptor.gpuBuffer) {
                 uniformBuffBase = gpuDescriptor.gpuBuffer->buffer + offset;
+                bufferSize      = gpuDescriptor.gpuBuffer->size - offset;
+            }
+
+            // one compare against the shadow copy skips every uniform of a block the program already holds
+            if (bufferSize >= glBlock.size) {
+                if (glBlock.buffValid && memcmp(glBlock.buff.data(), uniformBuffBase, glBlock.size) == 0) {
+                    continue;
+                }
+                memcpy(glBlock.buff.data(), uniformBuffBase, glBlock.size);
+                glBlock.buffValid = true;
+            } else {
+                glBlock.buffValid = false;
             }
 
             for (auto &gpuUniform : glBlock.glActiveUniforms) {
@@ -2502,6 +2517,21 @@ void cmdFuncGLES2Draw(GLES2Device *device, const DrawInfo &drawInfo) {
     }
 }
 
+static void uploadBufferData(GLES2Device *device, const GLES2GPUBuffer *gpuBuffer, GLenum target, uint32_t offset, uint32_t size, const void *buffer) {
+    if (device->constantRegistry()->useMapBufferRange) {
+        // invalidating lets the driver hand out fresh memory instead of waiting for the draws still reading the old data
+        const GLbitfield invalidate = offset == 0 && size == gpuBuffer->size ? GL_MAP_INVALIDATE_BUFFER_BIT_EXT : GL_MAP_INVALIDATE_RANGE_BIT_EXT;
+        void *           dst{nullptr};
+        GL_CHECK(dst = glMapBufferRangeEXT(target, offset, size, GL_MAP_WRITE_BIT_EXT | invalidate));
+        if (dst) {
+            memcpy(dst, buffer, size);
+            GL_CHECK(glUnmapBufferOES(target));
+            return;
+        }
+    }
+    GL_CHECK(glBufferSubData(target, offset, size, buffer));
+}
+
 void cmdFuncGLES2UpdateBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer, const void *buffer, uint32_t offset, uint32_t size) {
     GLES2ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
     CCASSERT(buffer, "Buffer should not be nullptr");
@@ -2524,7 +2554,7 @@ void cmdFuncGLES2UpdateBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glArrayBuffer = gpuBuffer->glBuffer;
                 }
-                GL_CHECK(glBufferSubData(GL_ARRAY_BUFFER, offset, size, buffer));
+                uploadBufferData(device, gpuBuffer, GL_ARRAY_BUFFER, offset, size, buffer);
                 break;
             }
             case GL_ELEMENT_ARRAY_BUFFER: {
@@ -2539,7 +2569,7 @@ void cmdFuncGLES2UpdateBuffer(GLES2Device *device, GLES2GPUBuffer *gpuBuffer, co
                     GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuBuffer->glBuffer));
                     device->stateCache()->glElementArrayBuffer = gpuBuffer->glBuffer;
                 }
-                GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, buffer));
+                uploadBufferData(device, gpuBuffer, GL_ELEMENT_ARRAY_BUFFER, offset, size, buffer);
                 break;
             }
             default:
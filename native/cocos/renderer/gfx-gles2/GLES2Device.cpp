@@ -123,6 +123,8 @@ bool GLES2Device::doInit(const DeviceInfo & /*info*/) {
     _gpuConstantRegistry->useDrawInstanced      = checkExtension("draw_instanced");
     _gpuConstantRegistry->useInstancedArrays    = checkExtension("instanced_arrays");
     _gpuConstantRegistry->useDiscardFramebuffer = checkExtension("discard_framebuffer");
+    // unmapping is part of OES_mapbuffer
+    _gpuConstantRegistry->useMapBufferRange = checkExtension("map_buffer_range") && glMapBufferRangeEXT && glUnmapBufferOES;
 
     _features[toNumber(Feature::INSTANCED_ARRAYS)] = _gpuConstantRegistry->useInstancedArrays;
 
@@ -210,6 +212,8 @@ bool GLES2Device::doInit(const DeviceInfo & /*info*/) {
     CC_LOG_INFO("VERSION: %s", _version.c_str());
     CC_LOG_INFO("COMPRESSED_FORMATS: %s", compressedFmts.c_str());
     CC_LOG_INFO("USE_VAO: %s", _gpuConstantRegistry->useVAO ? "true" : "false");
+    CC_LOG_INFO("USE_INSTANCED_ARRAYS: %s", _gpuConstantRegistry->useInstancedArrays ? "true" : "false");
+    CC_LOG_INFO("USE_MAP_BUFFER_RANGE: %s", _gpuConstantRegistry->useMapBufferRange ? "true" : "false");
     CC_LOG_INFO("FRAMEBUFFER_FETCH: %s", fbfLevelStr.c_str());
 
     return true;
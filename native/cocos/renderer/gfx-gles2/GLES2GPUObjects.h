@@ -40,6 +40,7 @@ struct GLES2GPUConstantRegistry {
     bool useDrawInstanced      = false;
     bool useInstancedArrays    = false;
     bool useDiscardFramebuffer = false;
+    bool useMapBufferRange     = false;
 };
 
 class GLES2GPUStateCache;
@@ -196,6 +197,8 @@ struct GLES2GPUUniformBlock {
     GLES2GPUUniformList     glUniforms;
     GLES2GPUUniformList     glActiveUniforms;
     ccstd::vector<uint32_t> activeUniformIndices;
+    ccstd::vector<uint8_t>  buff;              // the block data last uploaded to the program
+    bool                    buffValid = false; // false when the program was last updated from a partial block
 };
 using GLES2GPUUniformBlockList = ccstd::vector<GLES2GPUUniformBlock>;
 
@@ -29,6 +29,7 @@
 #include "GLES2Commands.h"
 #include "GLES2Device.h"
 #include "GLES2Queue.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 namespace gfx {
@@ -48,6 +49,7 @@ void GLES2Queue::doDestroy() {
 }
 
 void GLES2Queue::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    CC_PROFILE(GLES2QueueSubmit);
     for (uint32_t i = 0; i < count; ++i) {
         auto *cmdBuff = static_cast<GLES2CommandBuffer *>(cmdBuffs[i]);
 
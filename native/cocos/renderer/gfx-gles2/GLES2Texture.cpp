@@ -29,6 +29,7 @@
 #include "GLES2Device.h"
 #include "GLES2Swapchain.h"
 #include "GLES2Texture.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -62,6 +63,7 @@ void GLES2Texture::doInit(const TextureInfo & /*info*/) {
 
     if (!_gpuTexture->memoryless) {
         GLES2Device::getInstance()->getMemoryStatus().textureSize += _size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, _size);
         CC_PROFILE_MEMORY_INC(Texture, _size);
     }
 }
@@ -75,6 +77,7 @@ void GLES2Texture::doDestroy() {
         if (!_isTextureView) {
             if (!_gpuTexture->memoryless) {
                 GLES2Device::getInstance()->getMemoryStatus().textureSize -= _size;
+                CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
                 CC_PROFILE_MEMORY_DEC(Texture, _size);
             }
             cmdFuncGLES2DestroyTexture(GLES2Device::getInstance(), _gpuTexture);
@@ -88,6 +91,7 @@ void GLES2Texture::doDestroy() {
 void GLES2Texture::doResize(uint32_t width, uint32_t height, uint32_t size) {
     if (!_gpuTexture->memoryless) {
         GLES2Device::getInstance()->getMemoryStatus().textureSize -= _size;
+        CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
         CC_PROFILE_MEMORY_DEC(Texture, _size);
     }
     _gpuTexture->width    = width;
@@ -100,6 +104,7 @@ void GLES2Texture::doResize(uint32_t width, uint32_t height, uint32_t size) {
 
     if (!_gpuTexture->memoryless) {
         GLES2Device::getInstance()->getMemoryStatus().textureSize += size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, size);
         CC_PROFILE_MEMORY_INC(Texture, size);
     }
 }
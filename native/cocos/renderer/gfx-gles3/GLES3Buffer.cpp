@@ -28,6 +28,7 @@
 #include "GLES3Buffer.h"
 #include "GLES3Commands.h"
 #include "GLES3Device.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -49,12 +50,14 @@ void GLES3Buffer::doInit(const BufferInfo & /*info*/) {
     _gpuBuffer->stride   = _stride;
     _gpuBuffer->count    = _count;
 
-    if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
+    // storage backed indirect buffers keep the commands on the GPU
+    if (hasFlag(_usage, BufferUsageBit::INDIRECT) && !hasFlag(_usage, BufferUsageBit::STORAGE)) {
         _gpuBuffer->indirects.resize(_count);
     }
 
     cmdFuncGLES3CreateBuffer(GLES3Device::getInstance(), _gpuBuffer);
     GLES3Device::getInstance()->getMemoryStatus().bufferSize += _size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, _size);
     CC_PROFILE_MEMORY_INC(Buffer, _size);
 }
 
@@ -78,6 +81,7 @@ void GLES3Buffer::doDestroy() {
         if (!_isBufferView) {
             cmdFuncGLES3DestroyBuffer(GLES3Device::getInstance(), _gpuBuffer);
             GLES3Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+            CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
             CC_PROFILE_MEMORY_DEC(Buffer, _size);
         }
         CC_DELETE(_gpuBuffer);
@@ -87,6 +91,7 @@ void GLES3Buffer::doDestroy() {
 
 void GLES3Buffer::doResize(uint32_t size, uint32_t count) {
     GLES3Device::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
     CC_PROFILE_MEMORY_DEC(Buffer, _size);
 
     _gpuBuffer->size  = size;
@@ -94,6 +99,7 @@ void GLES3Buffer::doResize(uint32_t size, uint32_t count) {
     cmdFuncGLES3ResizeBuffer(GLES3Device::getInstance(), _gpuBuffer);
 
     GLES3Device::getInstance()->getMemoryStatus().bufferSize += size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, size);
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
@@ -287,6 +287,23 @@ void GLES3CommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void GLES3CommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    CC_PROFILE(GLES3CommandBufferDrawIndirect);
+    if (_isStateInvalid) {
+        bindStates();
+    }
+
+    GLES3CmdDrawIndirect *cmd       = _cmdAllocator->drawIndirectCmdPool.alloc();
+    cmd->drawIndirectInfo.gpuBuffer = static_cast<GLES3Buffer *>(info.buffer)->gpuBuffer();
+    cmd->drawIndirectInfo.offset    = info.offset;
+    cmd->drawIndirectInfo.drawCount = info.drawCount;
+    cmd->drawIndirectInfo.stride    = info.stride;
+    _curCmdPackage->drawIndirectCmds.push(cmd);
+    _curCmdPackage->cmds.push(GLESCmdType::DRAW_INDIRECT);
+
+    _numDrawCalls += info.drawCount;
+}
+
 void GLES3CommandBuffer::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     GLES3GPUBuffer *gpuBuffer = static_cast<GLES3Buffer *>(buff)->gpuBuffer();
     if (gpuBuffer) {
@@ -348,6 +365,11 @@ void GLES3CommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
             ++cmd->refCount;
             _curCmdPackage->drawCmds.push(cmd);
         }
+        for (uint32_t j = 0; j < cmdPackage->drawIndirectCmds.size(); ++j) {
+            GLES3CmdDrawIndirect *cmd = cmdPackage->drawIndirectCmds[j];
+            ++cmd->refCount;
+            _curCmdPackage->drawIndirectCmds.push(cmd);
+        }
         for (uint32_t j = 0; j < cmdPackage->dispatchCmds.size(); ++j) {
             GLES3CmdDispatch *cmd = cmdPackage->dispatchCmds[j];
             ++cmd->refCount;
@@ -24,10 +24,12 @@
 ****************************************************************************/
 
 #include "GLES3Commands.h"
+#include <boost/functional/hash.hpp>
 #include "GLES3Device.h"
 #include "GLES3QueryPool.h"
 #include "GLES3Std.h"
 #include "base/StringUtil.h"
+#include "gfx-base/GFXCacheFile.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-gles-common/GLESCommandPool.h"
 #include "gfx-gles3/GLES3GPUObjects.h"
@@ -683,6 +685,12 @@ void cmdFuncGLES3DestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
                 GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, 0));
                 device->stateCache()->glArrayBuffer = 0;
             }
+            // deleting the buffer detaches it from the default vertex array object
+            for (auto &attribPointer : device->stateCache()->glAttribPointers) {
+                if (attribPointer.glBuffer == gpuBuffer->glBuffer) {
+                    attribPointer = GLES3GPUVertexAttribPointer();
+                }
+            }
         } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDEX)) {
             if (USE_VAO) {
                 if (device->stateCache()->glVAO) {
@@ -713,7 +721,7 @@ void cmdFuncGLES3DestroyBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer) {
             ccstd::vector<GLuint> &ssbo = device->stateCache()->glBindSSBOs;
             for (GLuint i = 0; i < ssbo.size(); i++) {
                 if (ssbo[i] == gpuBuffer->glBuffer) {
-                    GL_CHECK(glBindBufferBase(GL_UNIFORM_BUFFER, i, 0));
+                    GL_CHECK(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, i, 0));
                     device->stateCache()->glShaderStorageBuffer = 0;
                     ssbo[i]                                     = 0;
                 }
@@ -903,6 +911,11 @@ void cmdFuncGLES3DestroyTexture(GLES3Device *device, GLES3GPUTexture *gpuTexture
                 glTexture = 0;
             }
         }
+        for (GLuint &glImage : device->stateCache()->glImages) {
+            if (glImage == gpuTexture->glTexture) {
+                glImage = 0;
+            }
+        }
         if (gpuTexture->glTarget != GL_TEXTURE_EXTERNAL_OES) {
             GL_CHECK(glDeleteTextures(1, &gpuTexture->glTexture));
         }
@@ -1003,88 +1016,117 @@ void cmdFuncGLES3CreateShader(GLES3Device *device, GLES3GPUShader *gpuShader) {
     ccstd::string shaderStageStr;
     GLint         status;
 
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-
-        switch (gpuStage.type) {
-            case ShaderStageFlagBit::VERTEX: {
-                glShaderStage  = GL_VERTEX_SHADER;
-                shaderStageStr = "Vertex Shader";
-                break;
-            }
-            case ShaderStageFlagBit::FRAGMENT: {
-                glShaderStage  = GL_FRAGMENT_SHADER;
-                shaderStageStr = "Fragment Shader";
-                break;
-            }
-            case ShaderStageFlagBit::COMPUTE: {
-                glShaderStage  = GL_COMPUTE_SHADER;
-                shaderStageStr = "Compute Shader";
-                break;
-            }
-            default: {
-                CCASSERT(false, "Unsupported ShaderStageFlagBit");
-                return;
+    uint32_t                     version = device->constantRegistry()->glMinorVersion ? 310 : 300;
+    ccstd::vector<ccstd::string> shaderSources;
+    size_t                       sourceHash = 0;
+    for (const auto &gpuStage : gpuShader->gpuStages) {
+        ccstd::string header = StringUtil::format("#version %u es\n", version);
+#if defined(GL_OVR_multiview)
+        // stages of multiview passes index their per-view data with gl_ViewID_OVR
+        if (gpuStage.source.find("gl_ViewID_OVR") != ccstd::string::npos) {
+            header += "#extension GL_OVR_multiview2 : require\n";
+            if (gpuStage.type == ShaderStageFlagBit::VERTEX) {
+                header += StringUtil::format("layout(num_views = %u) in;\n", MAX_VIEW_COUNT);
             }
         }
-        GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
-        uint32_t      version      = device->constantRegistry()->glMinorVersion ? 310 : 300;
-        ccstd::string shaderSource = StringUtil::format("#version %u es\n", version) + gpuStage.source;
-        const char *  source       = shaderSource.c_str();
-        GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&source, nullptr));
-        GL_CHECK(glCompileShader(gpuStage.glShader));
-
-        GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
-        if (status != GL_TRUE) {
-            GLint logSize = 0;
-            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
-
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
-
-            CC_LOG_ERROR("%s in %s compilation failed.", shaderStageStr.c_str(), gpuShader->name.c_str());
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
-            return;
-        }
+#endif
+        shaderSources.emplace_back(header + gpuStage.source);
+        boost::hash_combine(sourceHash, toNumber(gpuStage.type));
+        boost::hash_combine(sourceHash, shaderSources.back());
     }
 
     GL_CHECK(gpuShader->glProgram = glCreateProgram());
 
-    // link program
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
-    }
+    GLES3GPUProgramCache *programCache = device->programCache();
+    if (programCache && programCache->loadProgram(sourceHash, gpuShader->glProgram)) {
+        CC_LOG_DEBUG("Shader '%s' loaded from program cache.", gpuShader->name.c_str());
+    } else {
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+
+            switch (gpuStage.type) {
+                case ShaderStageFlagBit::VERTEX: {
+                    glShaderStage  = GL_VERTEX_SHADER;
+                    shaderStageStr = "Vertex Shader";
+                    break;
+                }
+                case ShaderStageFlagBit::FRAGMENT: {
+                    glShaderStage  = GL_FRAGMENT_SHADER;
+                    shaderStageStr = "Fragment Shader";
+                    break;
+                }
+                case ShaderStageFlagBit::COMPUTE: {
+                    glShaderStage  = GL_COMPUTE_SHADER;
+                    shaderStageStr = "Compute Shader";
+                    break;
+                }
+                default: {
+                    CCASSERT(false, "Unsupported ShaderStageFlagBit");
+                    return;
+                }
+            }
+            GL_CHECK(gpuStage.glShader = glCreateShader(glShaderStage));
+            const char *source = shaderSources[i].c_str();
+            GL_CHECK(glShaderSource(gpuStage.glShader, 1, (const GLchar **)&source, nullptr));
+            GL_CHECK(glCompileShader(gpuStage.glShader));
+
+            GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_COMPILE_STATUS, &status));
+            if (status != GL_TRUE) {
+                GLint logSize = 0;
+                GL_CHECK(glGetShaderiv(gpuStage.glShader, GL_INFO_LOG_LENGTH, &logSize));
+
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetShaderInfoLog(gpuStage.glShader, logSize, nullptr, logs));
+
+                CC_LOG_ERROR("%s in %s compilation failed.", shaderStageStr.c_str(), gpuShader->name.c_str());
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+                GL_CHECK(glDeleteProgram(gpuShader->glProgram));
+                gpuShader->glProgram = 0;
+                return;
+            }
+        }
 
-    GL_CHECK(glLinkProgram(gpuShader->glProgram));
+        // link program
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            GL_CHECK(glAttachShader(gpuShader->glProgram, gpuStage.glShader));
+        }
 
-    // detach & delete immediately
-    for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
-        GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
-        if (gpuStage.glShader) {
-            GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
-            GL_CHECK(glDeleteShader(gpuStage.glShader));
-            gpuStage.glShader = 0;
+        if (programCache) {
+            GL_CHECK(glProgramParameteri(gpuShader->glProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
         }
-    }
+        GL_CHECK(glLinkProgram(gpuShader->glProgram));
 
-    GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
-    if (status != 1) {
-        CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
-        GLint logSize = 0;
-        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
-        if (logSize) {
-            ++logSize;
-            auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
-            GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
+        // detach & delete immediately
+        for (size_t i = 0; i < gpuShader->gpuStages.size(); ++i) {
+            GLES3GPUShaderStage &gpuStage = gpuShader->gpuStages[i];
+            if (gpuStage.glShader) {
+                GL_CHECK(glDetachShader(gpuShader->glProgram, gpuStage.glShader));
+                GL_CHECK(glDeleteShader(gpuStage.glShader));
+                gpuStage.glShader = 0;
+            }
+        }
 
-            CC_LOG_ERROR(logs);
-            CC_FREE(logs);
-            return;
+        GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_LINK_STATUS, &status));
+        if (status != 1) {
+            CC_LOG_ERROR("Failed to link Shader [%s].", gpuShader->name.c_str());
+            GLint logSize = 0;
+            GL_CHECK(glGetProgramiv(gpuShader->glProgram, GL_INFO_LOG_LENGTH, &logSize));
+            if (logSize) {
+                ++logSize;
+                auto *logs = static_cast<GLchar *>(CC_MALLOC(logSize));
+                GL_CHECK(glGetProgramInfoLog(gpuShader->glProgram, logSize, nullptr, logs));
+
+                CC_LOG_ERROR(logs);
+                CC_FREE(logs);
+                return;
+            }
+        } else if (programCache) {
+            programCache->storeProgram(sourceHash, gpuShader->glProgram);
         }
     }
 
@@ -1441,7 +1483,8 @@ static GLES3GPUFramebuffer::GLFramebufferInfo doCreateFramebuffer(GLES3Device *
                                                                   const GLES3GPUTextureView *depthStencilView,
                                                                   const uint32_t *           resolves                = nullptr,
                                                                   const GLES3GPUTextureView *depthStencilResolveView = nullptr,
-                                                                  GLbitfield *               resolveMask             = nullptr) {
+                                                                  GLbitfield *               resolveMask             = nullptr,
+                                                                  uint32_t                   viewCount               = 1U) {
     static ccstd::vector<GLenum>           drawBuffers;
     GLES3GPUStateCache *                   cache = device->stateCache();
     GLES3GPUFramebuffer::GLFramebufferInfo res;
@@ -1475,7 +1518,14 @@ static GLES3GPUFramebuffer::GLFramebufferInfo doCreateFramebuffer(GLES3Device *
             *resolveMask |= GL_COLOR_BUFFER_BIT; // fallback to blit-based manual resolve
         }
         if (gpuColorTexture) {
-            if (gpuColorTexture->glTexture) {
+#if defined(GL_OVR_multiview)
+            if (viewCount > 1) {
+                // one array layer per view
+                GL_CHECK(glFramebufferTextureMultiviewOVR(GL_DRAW_FRAMEBUFFER, static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + j),
+                                                          gpuColorTexture->glTexture, gpuColorTextureView->baseLevel, 0, static_cast<GLsizei>(viewCount)));
+            } else
+#endif
+                if (gpuColorTexture->glTexture) {
                 GL_CHECK(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, static_cast<GLenum>(GL_COLOR_ATTACHMENT0 + j),
                                                 gpuColorTexture->glTarget, gpuColorTexture->glTexture, gpuColorTextureView->baseLevel));
             } else {
@@ -1492,7 +1542,12 @@ static GLES3GPUFramebuffer::GLFramebufferInfo doCreateFramebuffer(GLES3Device *
     if (depthStencil) {
         bool   hasStencil   = GFX_FORMAT_INFOS[static_cast<int>(depthStencil->format)].hasStencil;
         GLenum glAttachment = hasStencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
-        if (depthStencil->glTexture) {
+#if defined(GL_OVR_multiview)
+        if (viewCount > 1) {
+            GL_CHECK(glFramebufferTextureMultiviewOVR(GL_DRAW_FRAMEBUFFER, glAttachment, depthStencil->glTexture, depthStencilView->baseLevel, 0, static_cast<GLsizei>(viewCount)));
+        } else
+#endif
+            if (depthStencil->glTexture) {
             GL_CHECK(glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, glAttachment, depthStencil->glTarget, depthStencil->glTexture, depthStencilView->baseLevel));
         } else if (depthStencil->glRenderbuffer) {
             GL_CHECK(glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, glAttachment, depthStencil->glTarget, depthStencil->glRenderbuffer));
@@ -1574,12 +1629,14 @@ static void doCreateFramebufferInstance(GLES3Device *device, GLES3GPUFramebuffer
         }
 
         outFBO->framebuffer.initialize(doCreateFramebuffer(device, gpuFBO->gpuColorViews, colors.data(), utils::toUint(colors.size()),
-                                                           depthStencilTextureView, resolves, depthStencilResolveTextureView, &outFBO->resolveMask));
+                                                           depthStencilTextureView, resolves, depthStencilResolveTextureView, &outFBO->resolveMask,
+                                                           gpuFBO->gpuRenderPass->viewCount));
         if (outFBO->resolveMask) {
             size_t             resolveCount = outFBO->resolveMask & GL_COLOR_BUFFER_BIT ? utils::toUint(colors.size()) : 0U;
             GLES3GPUSwapchain *resolveSwapchain{getSwapchainIfExists(gpuFBO->gpuColorViews, resolves, resolveCount)};
             if (!resolveSwapchain) {
-                outFBO->resolveFramebuffer.initialize(doCreateFramebuffer(device, gpuFBO->gpuColorViews, resolves, resolveCount, depthStencilResolveTextureView));
+                outFBO->resolveFramebuffer.initialize(doCreateFramebuffer(device, gpuFBO->gpuColorViews, resolves, resolveCount, depthStencilResolveTextureView,
+                                                                          nullptr, nullptr, nullptr, gpuFBO->gpuRenderPass->viewCount));
             } else {
                 outFBO->resolveFramebuffer.initialize(resolveSwapchain);
             }
@@ -2171,7 +2228,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
         gfxStateCache.glPrimitive      = gpuPipelineState->glPrimitive;
 
         if (gpuPipelineState->gpuShader) {
-            if (cache->glProgram != gpuPipelineState->gpuShader->glProgram) {
+            if (cache->checkDirty(cache->glProgram != gpuPipelineState->gpuShader->glProgram)) {
                 GL_CHECK(glUseProgram(gpuPipelineState->gpuShader->glProgram));
                 cache->glProgram = gpuPipelineState->gpuShader->glProgram;
                 isShaderChanged  = true;
@@ -2212,7 +2269,8 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
         }
         if ((cache->rs.depthBias != gpuPipelineState->rs.depthBias) ||
             (cache->rs.depthBiasSlop != gpuPipelineState->rs.depthBiasSlop)) {
-            GL_CHECK(glPolygonOffset(cache->rs.depthBias, cache->rs.depthBiasSlop));
+            GL_CHECK(glPolygonOffset(gpuPipelineState->rs.depthBias, gpuPipelineState->rs.depthBiasSlop));
+            cache->rs.depthBias     = gpuPipelineState->rs.depthBias;
             cache->rs.depthBiasSlop = gpuPipelineState->rs.depthBiasSlop;
         }
         if (cache->rs.lineWidth != gpuPipelineState->rs.lineWidth) {
@@ -2307,7 +2365,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
 
         // bind blend state
         if (cache->bs.isA2C != gpuPipelineState->bs.isA2C) {
-            if (cache->bs.isA2C) {
+            if (gpuPipelineState->bs.isA2C) {
                 GL_CHECK(glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE));
             } else {
                 GL_CHECK(glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE));
@@ -2391,8 +2449,8 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
             if (dynamicOffsetIndex >= 0) offset += dynamicOffsets[dynamicOffsetIndex];
 
             if (glBuffer.isStorage) {
-                if (cache->glBindSSBOs[glBuffer.glBinding] != gpuDescriptor.gpuBuffer->glBuffer ||
-                    cache->glBindSSBOOffsets[glBuffer.glBinding] != offset) {
+                if (cache->checkDirty(cache->glBindSSBOs[glBuffer.glBinding] != gpuDescriptor.gpuBuffer->glBuffer ||
+                                      cache->glBindSSBOOffsets[glBuffer.glBinding] != offset)) {
                     if (offset) {
                         GL_CHECK(glBindBufferRange(GL_SHADER_STORAGE_BUFFER, glBuffer.glBinding, gpuDescriptor.gpuBuffer->glBuffer,
                                                    offset, gpuDescriptor.gpuBuffer->size));
@@ -2403,8 +2461,8 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                     cache->glBindSSBOOffsets[glBuffer.glBinding]                          = offset;
                 }
             } else {
-                if (cache->glBindUBOs[glBuffer.glBinding] != gpuDescriptor.gpuBuffer->glBuffer ||
-                    cache->glBindUBOOffsets[glBuffer.glBinding] != offset) {
+                if (cache->checkDirty(cache->glBindUBOs[glBuffer.glBinding] != gpuDescriptor.gpuBuffer->glBuffer ||
+                                      cache->glBindUBOOffsets[glBuffer.glBinding] != offset)) {
                     if (offset) {
                         GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, glBuffer.glBinding, gpuDescriptor.gpuBuffer->glBuffer,
                                                    offset, gpuDescriptor.gpuBuffer->size));
@@ -2448,7 +2506,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 if (gpuTexture->size > 0) {
                     GLuint glTexture = gpuTexture->glTexture;
 
-                    if (cache->glTextures[unit] != glTexture) {
+                    if (cache->checkDirty(cache->glTextures[unit] != glTexture)) {
                         if (cache->texUint != unit) {
                             GL_CHECK(glActiveTexture(GL_TEXTURE0 + unit));
                             cache->texUint = unit;
@@ -2458,7 +2516,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                     }
 
                     GLuint glSampler = gpuDescriptor->gpuSampler->getGLSampler(minLod, maxLod);
-                    if (cache->glSamplers[unit] != glSampler) {
+                    if (cache->checkDirty(cache->glSamplers[unit] != glSampler)) {
                         GL_CHECK(glBindSampler(unit, glSampler));
                         cache->glSamplers[unit] = glSampler;
                     }
@@ -2490,8 +2548,10 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 if (gpuTexture->size > 0) {
                     GLuint glTexture = gpuTexture->glTexture;
 
-                    if (cache->glImages[unit] != glTexture) {
+                    if (cache->checkDirty(cache->glImages[unit] != glTexture || cache->glImageAccesses[unit] != glImage.glMemoryAccess)) {
                         GL_CHECK(glBindImageTexture(unit, glTexture, 0, GL_TRUE, 0, glImage.glMemoryAccess, gpuTexture->glInternalFmt));
+                        cache->glImages[unit]        = glTexture;
+                        cache->glImageAccesses[unit] = glImage.glMemoryAccess;
                     }
                 }
             }
@@ -2544,7 +2604,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 cache->glElementArrayBuffer = 0;
             }
 
-            if (cache->glVAO != glVAO) {
+            if (cache->checkDirty(cache->glVAO != glVAO)) {
                 GL_CHECK(glBindVertexArray(glVAO));
                 cache->glVAO = glVAO;
             }
@@ -2557,19 +2617,32 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
                 for (size_t a = 0; a < gpuInputAssembler->attributes.size(); ++a) {
                     const GLES3GPUAttribute &gpuAttribute = gpuInputAssembler->glAttribs[a];
                     if (gpuAttribute.name == gpuInput.name) {
-                        if (cache->glArrayBuffer != gpuAttribute.glBuffer) {
-                            GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, gpuAttribute.glBuffer));
-                            cache->glArrayBuffer = gpuAttribute.glBuffer;
-                        }
-
                         for (uint32_t c = 0; c < gpuAttribute.componentCount; ++c) {
                             GLuint   glLoc        = gpuInput.glLoc + c;
                             uint32_t attribOffset = gpuAttribute.offset + gpuAttribute.size * c;
-                            GL_CHECK(glEnableVertexAttribArray(glLoc));
+                            if (cache->checkDirty(!cache->glEnabledAttribLocs[glLoc])) {
+                                GL_CHECK(glEnableVertexAttribArray(glLoc));
+                                cache->glEnabledAttribLocs[glLoc] = true;
+                            }
                             cache->glCurrentAttribLocs[glLoc] = true;
-                            cache->glEnabledAttribLocs[glLoc] = true;
-                            GL_CHECK(glVertexAttribPointer(glLoc, gpuAttribute.count, gpuAttribute.glType, gpuAttribute.isNormalized, gpuAttribute.stride, BUFFER_OFFSET(attribOffset)));
-                            GL_CHECK(glVertexAttribDivisor(glLoc, gpuAttribute.isInstanced ? 1 : 0));
+
+                            // the pointer captures the array buffer binding, so only bind it when the pointer changes
+                            GLES3GPUVertexAttribPointer attribPointer{gpuAttribute.glBuffer, gpuAttribute.glType, gpuAttribute.count,
+                                                                      gpuAttribute.stride, attribOffset, gpuAttribute.isNormalized};
+                            if (cache->checkDirty(cache->glAttribPointers[glLoc] != attribPointer)) {
+                                if (cache->glArrayBuffer != gpuAttribute.glBuffer) {
+                                    GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, gpuAttribute.glBuffer));
+                                    cache->glArrayBuffer = gpuAttribute.glBuffer;
+                                }
+                                GL_CHECK(glVertexAttribPointer(glLoc, gpuAttribute.count, gpuAttribute.glType, gpuAttribute.isNormalized, gpuAttribute.stride, BUFFER_OFFSET(attribOffset)));
+                                cache->glAttribPointers[glLoc] = attribPointer;
+                            }
+
+                            GLuint divisor = gpuAttribute.isInstanced ? 1 : 0;
+                            if (cache->checkDirty(cache->glAttribDivisors[glLoc] != divisor)) {
+                                GL_CHECK(glVertexAttribDivisor(glLoc, divisor));
+                                cache->glAttribDivisors[glLoc] = divisor;
+                            }
                         }
                         break;
                     }
@@ -2577,7 +2650,7 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
             }
 
             if (gpuInputAssembler->gpuIndexBuffer) {
-                if (cache->glElementArrayBuffer != gpuInputAssembler->gpuIndexBuffer->glBuffer) {
+                if (cache->checkDirty(cache->glElementArrayBuffer != gpuInputAssembler->gpuIndexBuffer->glBuffer)) {
                     GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuInputAssembler->gpuIndexBuffer->glBuffer));
                     cache->glElementArrayBuffer = gpuInputAssembler->gpuIndexBuffer->glBuffer;
                 }
@@ -2663,6 +2736,26 @@ void cmdFuncGLES3BindState(GLES3Device *device, GLES3GPUPipelineState *gpuPipeli
     }
 }
 
+static void drawGLES3(const GLES3GPUInputAssembler *gpuInputAssembler, GLenum glPrimitive, const DrawInfo &drawInfo) {
+    if (gpuInputAssembler->gpuIndexBuffer) {
+        if (drawInfo.indexCount > 0) {
+            uint8_t *offset = nullptr;
+            offset += drawInfo.firstIndex * gpuInputAssembler->gpuIndexBuffer->stride;
+            if (drawInfo.instanceCount == 0) {
+                GL_CHECK(glDrawElements(glPrimitive, drawInfo.indexCount, gpuInputAssembler->glIndexType, offset));
+            } else {
+                GL_CHECK(glDrawElementsInstanced(glPrimitive, drawInfo.indexCount, gpuInputAssembler->glIndexType, offset, drawInfo.instanceCount));
+            }
+        }
+    } else if (drawInfo.vertexCount > 0) {
+        if (drawInfo.instanceCount == 0) {
+            GL_CHECK(glDrawArrays(glPrimitive, drawInfo.firstVertex, drawInfo.vertexCount));
+        } else {
+            GL_CHECK(glDrawArraysInstanced(glPrimitive, drawInfo.firstVertex, drawInfo.vertexCount, drawInfo.instanceCount));
+        }
+    }
+}
+
 void cmdFuncGLES3Draw(GLES3Device *device, const DrawInfo &drawInfo) {
     GLES3ObjectCache &      gfxStateCache     = device->stateCache()->gfxStateCache;
     GLES3GPUPipelineState * gpuPipelineState  = gfxStateCache.gpuPipelineState;
@@ -2671,48 +2764,52 @@ void cmdFuncGLES3Draw(GLES3Device *device, const DrawInfo &drawInfo) {
 
     if (gpuInputAssembler && gpuPipelineState) {
         if (!gpuInputAssembler->gpuIndirectBuffer) {
-            if (gpuInputAssembler->gpuIndexBuffer) {
-                if (drawInfo.indexCount > 0) {
-                    uint8_t *offset = nullptr;
-                    offset += drawInfo.firstIndex * gpuInputAssembler->gpuIndexBuffer->stride;
-                    if (drawInfo.instanceCount == 0) {
-                        GL_CHECK(glDrawElements(glPrimitive, drawInfo.indexCount, gpuInputAssembler->glIndexType, offset));
-                    } else {
-                        GL_CHECK(glDrawElementsInstanced(glPrimitive, drawInfo.indexCount, gpuInputAssembler->glIndexType, offset, drawInfo.instanceCount));
-                    }
-                }
-            } else if (drawInfo.vertexCount > 0) {
-                if (drawInfo.instanceCount == 0) {
-                    GL_CHECK(glDrawArrays(glPrimitive, drawInfo.firstVertex, drawInfo.vertexCount));
-                } else {
-                    GL_CHECK(glDrawArraysInstanced(glPrimitive, drawInfo.firstVertex, drawInfo.vertexCount, drawInfo.instanceCount));
-                }
-            }
+            drawGLES3(gpuInputAssembler, glPrimitive, drawInfo);
         } else {
-            for (size_t j = 0; j < gpuInputAssembler->gpuIndirectBuffer->indirects.size(); ++j) {
-                const DrawInfo &draw = gpuInputAssembler->gpuIndirectBuffer->indirects[j];
-                if (gpuInputAssembler->gpuIndexBuffer) {
-                    if (draw.indexCount > 0) {
-                        uint8_t *offset = nullptr;
-                        offset += draw.firstIndex * gpuInputAssembler->gpuIndexBuffer->stride;
-                        if (draw.instanceCount == 0) {
-                            GL_CHECK(glDrawElements(glPrimitive, draw.indexCount, gpuInputAssembler->glIndexType, offset));
-                        } else {
-                            GL_CHECK(glDrawElementsInstanced(glPrimitive, draw.indexCount, gpuInputAssembler->glIndexType, offset, draw.instanceCount));
-                        }
-                    }
-                } else if (draw.vertexCount > 0) {
-                    if (draw.instanceCount == 0) {
-                        GL_CHECK(glDrawArrays(glPrimitive, draw.firstVertex, draw.vertexCount));
-                    } else {
-                        GL_CHECK(glDrawArraysInstanced(glPrimitive, draw.firstVertex, draw.vertexCount, draw.instanceCount));
-                    }
-                }
+            for (const auto &draw : gpuInputAssembler->gpuIndirectBuffer->indirects) {
+                drawGLES3(gpuInputAssembler, glPrimitive, draw);
             }
         }
     }
 }
 
+void cmdFuncGLES3DrawIndirect(GLES3Device *device, const GLES3GPUDrawIndirectInfo &info) {
+    GLES3GPUStateCache *    cache             = device->stateCache();
+    GLES3ObjectCache &      gfxStateCache     = cache->gfxStateCache;
+    GLES3GPUInputAssembler *gpuInputAssembler = gfxStateCache.gpuInputAssembler;
+    GLenum                  glPrimitive       = gfxStateCache.glPrimitive;
+    const GLES3GPUBuffer *  gpuBuffer         = info.gpuBuffer;
+
+    if (!gpuInputAssembler || !gfxStateCache.gpuPipelineState || !gpuBuffer) return;
+
+    const bool     indexed       = gpuInputAssembler->gpuIndexBuffer != nullptr;
+    const uint32_t commandStride = indexed ? sizeof(DrawIndexedIndirectCommand) : sizeof(DrawIndirectCommand);
+    const uint32_t stride        = info.stride ? info.stride : commandStride;
+
+    if (gpuBuffer->glBuffer) {
+        // ES 3.1, the commands live in a GL buffer
+        if (cache->glDrawIndirectBuffer != gpuBuffer->glBuffer) {
+            GL_CHECK(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, gpuBuffer->glBuffer));
+            cache->glDrawIndirectBuffer = gpuBuffer->glBuffer;
+        }
+        for (uint32_t i = 0; i < info.drawCount; ++i) {
+            const auto *offset = reinterpret_cast<const void *>(static_cast<uintptr_t>(gpuBuffer->glOffset + info.offset + i * stride));
+            if (indexed) {
+                GL_CHECK(glDrawElementsIndirect(glPrimitive, gpuInputAssembler->glIndexType, offset));
+            } else {
+                GL_CHECK(glDrawArraysIndirect(glPrimitive, offset));
+            }
+        }
+    } else {
+        // emulated with the draw infos kept on the CPU
+        const uint32_t first = info.offset / commandStride;
+        const uint32_t step  = std::max(stride / commandStride, 1U);
+        for (uint32_t i = 0, j = first; i < info.drawCount && j < gpuBuffer->indirects.size(); ++i, j += step) {
+            drawGLES3(gpuInputAssembler, glPrimitive, gpuBuffer->indirects[j]);
+        }
+    }
+}
+
 void cmdFuncGLES3Dispatch(GLES3Device *device, const GLES3GPUDispatchInfo &info) {
     GLES3GPUStateCache *cache = device->stateCache();
     if (info.indirectBuffer) {
@@ -2746,10 +2843,46 @@ static void uploadBufferData(GLenum target, GLintptr offset, GLsizeiptr length,
 #endif
 }
 
+static void updateIndirectCommands(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const DrawInfo *drawInfos, uint32_t first, uint32_t count) {
+    if (!count) return;
+
+    ccstd::vector<uint8_t> commands;
+    if (drawInfos->indexCount) {
+        commands.resize(count * sizeof(DrawIndexedIndirectCommand));
+        auto *command = reinterpret_cast<DrawIndexedIndirectCommand *>(commands.data());
+        for (uint32_t i = 0; i < count; ++i, ++command) {
+            command->indexCount    = drawInfos[i].indexCount;
+            command->instanceCount = std::max(drawInfos[i].instanceCount, 1U);
+            command->firstIndex    = drawInfos[i].firstIndex;
+            command->vertexOffset  = drawInfos[i].vertexOffset;
+            command->firstInstance = 0; // must be zero in ES 3.1
+        }
+    } else {
+        commands.resize(count * sizeof(DrawIndirectCommand));
+        auto *command = reinterpret_cast<DrawIndirectCommand *>(commands.data());
+        for (uint32_t i = 0; i < count; ++i, ++command) {
+            command->vertexCount   = drawInfos[i].vertexCount;
+            command->instanceCount = std::max(drawInfos[i].instanceCount, 1U);
+            command->firstVertex   = drawInfos[i].firstVertex;
+            command->firstInstance = 0;
+        }
+    }
+
+    const auto stride = static_cast<uint32_t>(commands.size() / count);
+    if (device->stateCache()->glShaderStorageBuffer != gpuBuffer->glBuffer) {
+        GL_CHECK(glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpuBuffer->glBuffer));
+        device->stateCache()->glShaderStorageBuffer = gpuBuffer->glBuffer;
+    }
+    uploadBufferData(GL_SHADER_STORAGE_BUFFER, first * stride, static_cast<GLsizeiptr>(commands.size()), commands.data());
+}
+
 void cmdFuncGLES3UpdateBuffer(GLES3Device *device, GLES3GPUBuffer *gpuBuffer, const void *buffer, uint32_t offset, uint32_t size) {
     GLES3ObjectCache &gfxStateCache = device->stateCache()->gfxStateCache;
-    if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
+    if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT) && !gpuBuffer->glBuffer) {
         memcpy(reinterpret_cast<uint8_t *>(gpuBuffer->indirects.data()) + offset, buffer, size);
+    } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::INDIRECT)) {
+        // storage backed indirect buffers hold the native commands read by glDraw*Indirect
+        updateIndirectCommands(device, gpuBuffer, static_cast<const DrawInfo *>(buffer), offset / sizeof(DrawInfo), size / sizeof(DrawInfo));
     } else if (hasFlag(gpuBuffer->usage, BufferUsageBit::TRANSFER_SRC)) {
         memcpy(gpuBuffer->buffer + offset, buffer, size);
     } else {
@@ -2962,7 +3095,6 @@ void cmdFuncGLES3CopyBuffersToTexture(GLES3Device *device, const uint8_t *const
     }
 
     if (!isCompressed && hasFlag(gpuTexture->flags, TextureFlagBit::GEN_MIPMAP)) {
-        GL_CHECK(glBindTexture(gpuTexture->glTarget, gpuTexture->glTexture));
         GL_CHECK(glGenerateMipmap(gpuTexture->glTarget));
     }
 }
@@ -2983,6 +3115,70 @@ void cmdFuncGLES3CopyTextureToBuffers(GLES3Device *device, GLES3GPUTexture *gpuT
     }
 }
 
+void cmdFuncGLES3ReadbackTexture(GLES3Device *device, GLES3GPUTexture *gpuTexture, GLES3GPUReadback *readback, const BufferTextureCopy *regions, uint32_t count) {
+    auto glFormat = gpuTexture->glFormat;
+    auto glType   = gpuTexture->glType;
+
+    if (!readback->glBuffer) {
+        GL_CHECK(glGenBuffers(1, &readback->glBuffer));
+    }
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->glBuffer));
+    if (readback->capacity < readback->size) {
+        GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, readback->size, nullptr, GL_STREAM_READ));
+        readback->capacity = readback->size;
+    }
+
+    uint32_t offset = 0U;
+    for (uint32_t i = 0; i < count; ++i) {
+        const BufferTextureCopy &region      = regions[i];
+        auto                     framebuffer = device->framebufferCacheMap()->getFramebufferFromTexture(gpuTexture, region.texSubres);
+        if (device->stateCache()->glReadFramebuffer != framebuffer) {
+            GL_CHECK(glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer));
+            device->stateCache()->glReadFramebuffer = framebuffer;
+        }
+        // the pointer is an offset into the bound pack buffer, the driver copies without stalling
+        GL_CHECK(glReadPixels(region.texOffset.x, region.texOffset.y, region.texExtent.width, region.texExtent.height, glFormat, glType,
+                              reinterpret_cast<GLvoid *>(static_cast<uintptr_t>(offset))));
+        uint32_t w = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+        uint32_t h = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+        offset += formatSize(gpuTexture->format, w, h, region.texExtent.depth);
+    }
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    GL_CHECK(readback->glSync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+}
+
+const uint8_t *cmdFuncGLES3MapReadback(GLES3Device * /*device*/, GLES3GPUReadback *readback) {
+    GLenum status = GL_WAIT_FAILED;
+    GL_CHECK(status = glClientWaitSync(readback->glSync, 0, 0));
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return nullptr;
+    }
+    GL_CHECK(glDeleteSync(readback->glSync));
+    readback->glSync = nullptr;
+
+    void *data = nullptr;
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->glBuffer));
+    GL_CHECK(data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback->size, GL_MAP_READ_BIT));
+    return static_cast<const uint8_t *>(data);
+}
+
+void cmdFuncGLES3UnmapReadback(GLES3Device * /*device*/, GLES3GPUReadback * /*readback*/) {
+    GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+}
+
+void cmdFuncGLES3DestroyReadback(GLES3Device * /*device*/, GLES3GPUReadback *readback) {
+    if (readback->glSync) {
+        GL_CHECK(glDeleteSync(readback->glSync));
+        readback->glSync = nullptr;
+    }
+    if (readback->glBuffer) {
+        GL_CHECK(glDeleteBuffers(1, &readback->glBuffer));
+        readback->glBuffer = 0U;
+    }
+}
+
 void cmdFuncGLES3BlitTexture(GLES3Device *device, GLES3GPUTexture *gpuTextureSrc, GLES3GPUTexture *gpuTextureDst,
                              const TextureBlit *regions, uint32_t count, Filter filter) {
     GLES3GPUStateCache *cache = device->stateCache();
@@ -3069,6 +3265,11 @@ void cmdFuncGLES3ExecuteCmds(GLES3Device *device, GLES3CmdPackage *cmdPackage) {
                 cmdFuncGLES3Draw(device, cmd->drawInfo);
                 break;
             }
+            case GLESCmdType::DRAW_INDIRECT: {
+                GLES3CmdDrawIndirect *cmd = cmdPackage->drawIndirectCmds[cmdIdx];
+                cmdFuncGLES3DrawIndirect(device, cmd->drawIndirectInfo);
+                break;
+            }
             case GLESCmdType::DISPATCH: {
                 GLES3CmdDispatch *cmd = cmdPackage->dispatchCmds[cmdIdx];
                 cmdFuncGLES3Dispatch(device, cmd->dispatchInfo);
@@ -3114,5 +3315,130 @@ void GLES3GPUFramebufferHub::update(GLES3GPUTexture *texture) {
     }
 }
 
+namespace {
+constexpr char     PROGRAM_CACHE_FILE[]        = "gles3_program_cache.bin";
+constexpr uint32_t PROGRAM_CACHE_MAX_SIZE      = 16 * 1024 * 1024;
+constexpr auto     PROGRAM_CACHE_SAVE_INTERVAL = std::chrono::seconds(30);
+
+struct ProgramCacheEntryHeader {
+    uint64_t sourceHash{0};
+    uint32_t glFormat{0};
+    uint32_t size{0};
+};
+} // namespace
+
+void GLES3GPUProgramCache::load() {
+    _saveTime = std::chrono::steady_clock::now();
+
+    ccstd::vector<uint8_t> data;
+    if (!CacheFile::load(PROGRAM_CACHE_FILE, _driverKey.data(), utils::toUint(_driverKey.size()), data)) {
+        return;
+    }
+
+    // entries are saved from the most recently used one
+    ccstd::vector<std::pair<size_t, Entry>> entries;
+    size_t                                  offset = 0;
+    ProgramCacheEntryHeader                 header;
+    while (offset + sizeof(header) <= data.size()) {
+        memcpy(&header, data.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        if (offset + header.size > data.size()) {
+            break;
+        }
+        Entry entry;
+        entry.glFormat = header.glFormat;
+        entry.binary.assign(data.data() + offset, data.data() + offset + header.size);
+        entries.emplace_back(static_cast<size_t>(header.sourceHash), std::move(entry));
+        offset += header.size;
+    }
+
+    _stamp = utils::toUint(entries.size());
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        entries[i].second.stamp = _stamp - i;
+        _entries.emplace(entries[i].first, std::move(entries[i].second));
+    }
+    CC_LOG_INFO("GLES3 program cache loaded: %u programs", _stamp);
+}
+
+void GLES3GPUProgramCache::save() {
+    if (!_dirty) {
+        return;
+    }
+
+    ccstd::vector<const std::pair<const size_t, Entry> *> entries;
+    entries.reserve(_entries.size());
+    for (const auto &pair : _entries) {
+        entries.emplace_back(&pair);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto *lhs, const auto *rhs) {
+        return lhs->second.stamp > rhs->second.stamp;
+    });
+
+    // evict the least recently used programs beyond the size limit
+    ccstd::vector<uint8_t> data;
+    for (const auto *pair : entries) {
+        const Entry &entry = pair->second;
+        const size_t size  = sizeof(ProgramCacheEntryHeader) + entry.binary.size();
+        if (data.size() + size > PROGRAM_CACHE_MAX_SIZE) {
+            break;
+        }
+        ProgramCacheEntryHeader header{static_cast<uint64_t>(pair->first), entry.glFormat, utils::toUint(entry.binary.size())};
+        const size_t            offset = data.size();
+        data.resize(offset + size);
+        memcpy(data.data() + offset, &header, sizeof(header));
+        memcpy(data.data() + offset + sizeof(header), entry.binary.data(), entry.binary.size());
+    }
+
+    if (CacheFile::save(PROGRAM_CACHE_FILE, _driverKey.data(), utils::toUint(_driverKey.size()), data.data(), utils::toUint(data.size()))) {
+        _dirty = false;
+    }
+}
+
+void GLES3GPUProgramCache::update() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _saveTime > PROGRAM_CACHE_SAVE_INTERVAL) {
+        save();
+        _saveTime = now;
+    }
+}
+
+bool GLES3GPUProgramCache::loadProgram(size_t sourceHash, GLuint glProgram) {
+    auto iter = _entries.find(sourceHash);
+    if (iter == _entries.end()) {
+        return false;
+    }
+
+    Entry &entry = iter->second;
+    glProgramBinary(glProgram, entry.glFormat, entry.binary.data(), static_cast<GLsizei>(entry.binary.size()));
+    // an unknown binary format is reported as a GL error, consume it since the sources are compiled instead
+    glGetError();
+
+    GLint status = GL_FALSE;
+    GL_CHECK(glGetProgramiv(glProgram, GL_LINK_STATUS, &status));
+    if (status != GL_TRUE) {
+        _entries.erase(iter);
+        _dirty = true;
+        return false;
+    }
+
+    entry.stamp = ++_stamp;
+    return true;
+}
+
+void GLES3GPUProgramCache::storeProgram(size_t sourceHash, GLuint glProgram) {
+    GLint size = 0;
+    GL_CHECK(glGetProgramiv(glProgram, GL_PROGRAM_BINARY_LENGTH, &size));
+    if (size <= 0) {
+        return;
+    }
+
+    Entry entry;
+    entry.binary.resize(size);
+    GL_CHECK(glGetProgramBinary(glProgram, size, nullptr, &entry.glFormat, entry.binary.data()));
+    entry.stamp          = ++_stamp;
+    _entries[sourceHash] = std::move(entry);
+    _dirty               = true;
+}
+
 } // namespace gfx
 } // namespace cc
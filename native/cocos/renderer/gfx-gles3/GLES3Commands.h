@@ -77,6 +77,16 @@ public:
     void clear() override {}
 };
 
+class GLES3CmdDrawIndirect final : public GLESCmd {
+public:
+    GLES3GPUDrawIndirectInfo drawIndirectInfo;
+
+    GLES3CmdDrawIndirect() : GLESCmd(GLESCmdType::DRAW_INDIRECT) {}
+    void clear() override {
+        drawIndirectInfo.gpuBuffer = nullptr;
+    }
+};
+
 class GLES3CmdDispatch final : public GLESCmd {
 public:
     GLES3GPUDispatchInfo dispatchInfo;
@@ -177,6 +187,7 @@ struct GLES3CmdPackage {
     CachedArray<GLES3CmdBeginRenderPass *>     beginRenderPassCmds;
     CachedArray<GLES3CmdBindStates *>          bindStatesCmds;
     CachedArray<GLES3CmdDraw *>                drawCmds;
+    CachedArray<GLES3CmdDrawIndirect *>        drawIndirectCmds;
     CachedArray<GLES3CmdDispatch *>            dispatchCmds;
     CachedArray<GLES3CmdBarrier *>             barrierCmds;
     CachedArray<GLES3CmdUpdateBuffer *>        updateBufferCmds;
@@ -190,6 +201,7 @@ public:
     CommandPool<GLES3CmdBeginRenderPass>     beginRenderPassCmdPool;
     CommandPool<GLES3CmdBindStates>          bindStatesCmdPool;
     CommandPool<GLES3CmdDraw>                drawCmdPool;
+    CommandPool<GLES3CmdDrawIndirect>        drawIndirectCmdPool;
     CommandPool<GLES3CmdDispatch>            dispatchCmdPool;
     CommandPool<GLES3CmdBarrier>             barrierCmdPool;
     CommandPool<GLES3CmdUpdateBuffer>        updateBufferCmdPool;
@@ -207,6 +219,9 @@ public:
         if (cmdPackage->drawCmds.size()) {
             drawCmdPool.freeCmds(cmdPackage->drawCmds);
         }
+        if (cmdPackage->drawIndirectCmds.size()) {
+            drawIndirectCmdPool.freeCmds(cmdPackage->drawIndirectCmds);
+        }
         if (cmdPackage->dispatchCmds.size()) {
             dispatchCmdPool.freeCmds(cmdPackage->dispatchCmds);
         }
@@ -233,6 +248,7 @@ public:
         beginRenderPassCmdPool.release();
         bindStatesCmdPool.release();
         drawCmdPool.release();
+        drawIndirectCmdPool.release();
         dispatchCmdPool.release();
         barrierCmdPool.release();
         updateBufferCmdPool.release();
@@ -280,6 +296,7 @@ void cmdFuncGLES3BindState(GLES3Device *                       device,
                            const DynamicStates *               dynamicStates  = nullptr);
 
 void cmdFuncGLES3Draw(GLES3Device *device, const DrawInfo &drawInfo);
+void cmdFuncGLES3DrawIndirect(GLES3Device *device, const GLES3GPUDrawIndirectInfo &info);
 
 void cmdFuncGLES3UpdateBuffer(GLES3Device *   device,
                               GLES3GPUBuffer *gpuBuffer,
@@ -298,6 +315,16 @@ void cmdFuncGLES3CopyTextureToBuffers(GLES3Device *            device,
                                       const BufferTextureCopy *regions,
                                       uint32_t                 count);
 
+// asynchronous readback through the pixel pack buffer, map returns null before the fence is signaled
+void           cmdFuncGLES3ReadbackTexture(GLES3Device *            device,
+                                           GLES3GPUTexture *        gpuTexture,
+                                           GLES3GPUReadback *       readback,
+                                           const BufferTextureCopy *regions,
+                                           uint32_t                 count);
+const uint8_t *cmdFuncGLES3MapReadback(GLES3Device *device, GLES3GPUReadback *readback);
+void           cmdFuncGLES3UnmapReadback(GLES3Device *device, GLES3GPUReadback *readback);
+void           cmdFuncGLES3DestroyReadback(GLES3Device *device, GLES3GPUReadback *readback);
+
 void cmdFuncGLES3BlitTexture(GLES3Device *      device,
                              GLES3GPUTexture *  gpuTextureSrc,
                              GLES3GPUTexture *  gpuTextureDst,
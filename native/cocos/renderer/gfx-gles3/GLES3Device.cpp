@@ -142,6 +142,11 @@ bool GLES3Device::doInit(const DeviceInfo & /*info*/) {
     }
 #endif
 
+#if defined(GL_OVR_multiview)
+    // the second revision lifts the restriction of gl_ViewID_OVR to gl_Position
+    _features[toNumber(Feature::MULTIVIEW)] = checkExtension("OVR_multiview2") && glFramebufferTextureMultiviewOVR != nullptr;
+#endif
+
 #if CC_PLATFORM != CC_PLATFORM_WINDOWS || ALLOW_MULTISAMPLED_RENDER_TO_TEXTURE_ON_DESKTOP
     if (checkExtension("multisampled_render_to_texture")) {
         if (checkExtension("multisampled_render_to_texture2")) {
@@ -216,6 +221,13 @@ bool GLES3Device::doInit(const DeviceInfo & /*info*/) {
 
     _gpuStateCache->initialize(_caps.maxTextureUnits, _caps.maxImageUnits, _caps.maxUniformBufferBindings, _caps.maxShaderStorageBufferBindings, _caps.maxVertexAttributes);
 
+    GLint programBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &programBinaryFormats);
+    if (programBinaryFormats > 0) {
+        _gpuProgramCache = CC_NEW(GLES3GPUProgramCache(_vendor + '|' + _renderer + '|' + _version));
+        _gpuProgramCache->load();
+    }
+
     CC_LOG_INFO("GLES3 device initialized.");
     CC_LOG_INFO("RENDERER: %s", _renderer.c_str());
     CC_LOG_INFO("VENDOR: %s", _vendor.c_str());
@@ -227,6 +239,19 @@ bool GLES3Device::doInit(const DeviceInfo & /*info*/) {
 }
 
 void GLES3Device::doDestroy() {
+    for (auto &readback : _gpuReadbacks) {
+        cmdFuncGLES3DestroyReadback(this, &readback);
+    }
+    for (auto &readback : _gpuReadbackBuffers) {
+        cmdFuncGLES3DestroyReadback(this, &readback);
+    }
+    _gpuReadbacks.clear();
+    _gpuReadbackBuffers.clear();
+
+    if (_gpuProgramCache) {
+        _gpuProgramCache->save();
+        CC_SAFE_DELETE(_gpuProgramCache)
+    }
     CC_SAFE_DELETE(_gpuFramebufferCacheMap)
     CC_SAFE_DELETE(_gpuConstantRegistry)
     CC_SAFE_DELETE(_gpuFramebufferHub)
@@ -257,10 +282,32 @@ void GLES3Device::present() {
     _numInstances = queue->_numInstances;
     _numTriangles = queue->_numTriangles;
 
+    GLES3GPUStateStats &stateStats = _gpuStateCache->stats;
+    _numStateCalls                 = stateStats.issuedCalls;
+    _numSkippedStateCalls          = stateStats.skippedCalls;
+    stateStats                     = GLES3GPUStateStats();
+
+    if (_gpuProgramCache) {
+        _gpuProgramCache->update();
+    }
+
     for (auto *swapchain : _swapchains) {
         _gpuContext->present(swapchain);
     }
 
+    size_t pendingCount = 0U;
+    for (auto &readback : _gpuReadbacks) {
+        const uint8_t *data = cmdFuncGLES3MapReadback(this, &readback);
+        if (!data) {
+            _gpuReadbacks[pendingCount++] = readback;
+            continue;
+        }
+        finishTextureReadback(readback.handle, data);
+        cmdFuncGLES3UnmapReadback(this, &readback);
+        _gpuReadbackBuffers.push_back(readback);
+    }
+    _gpuReadbacks.resize(pendingCount);
+
     // Clear queue stats
     queue->_numDrawCalls = 0;
     queue->_numInstances = 0;
@@ -550,6 +597,34 @@ void GLES3Device::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buff
     cmdFuncGLES3CopyTextureToBuffers(this, static_cast<GLES3Texture *>(srcTexture)->gpuTexture(), buffers, regions, count);
 }
 
+void GLES3Device::doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    CC_PROFILE(GLES3DeviceDoTextureReadback);
+    uint32_t size = 0U;
+    for (uint32_t i = 0U; i < count; ++i) {
+        size += getReadbackRegionSize(src->getFormat(), regions[i]);
+    }
+
+    // reuse the smallest retired buffer that fits, or the largest one to be grown
+    GLES3GPUReadback readback;
+    if (!_gpuReadbackBuffers.empty()) {
+        size_t bestIdx = 0U;
+        for (size_t i = 1U; i < _gpuReadbackBuffers.size(); ++i) {
+            const uint32_t capacity = _gpuReadbackBuffers[i].capacity;
+            const uint32_t best     = _gpuReadbackBuffers[bestIdx].capacity;
+            if (best < size ? capacity > best : (capacity >= size && capacity < best)) {
+                bestIdx = i;
+            }
+        }
+        readback                     = _gpuReadbackBuffers[bestIdx];
+        _gpuReadbackBuffers[bestIdx] = _gpuReadbackBuffers.back();
+        _gpuReadbackBuffers.pop_back();
+    }
+    readback.handle = handle;
+    readback.size   = size;
+    cmdFuncGLES3ReadbackTexture(this, static_cast<GLES3Texture *>(src)->gpuTexture(), &readback, regions, count);
+    _gpuReadbacks.push_back(readback);
+}
+
 void GLES3Device::getQueryPoolResults(QueryPool *queryPool) {
     CC_PROFILE(GLES3DeviceGetQueryPoolResults);
     auto *cmdBuff = static_cast<GLES3CommandBuffer *>(getCommandBuffer());
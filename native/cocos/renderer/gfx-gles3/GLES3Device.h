@@ -39,6 +39,7 @@ class GLES3GPUStateCache;
 class GLES3GPUFramebufferHub;
 struct GLES3GPUConstantRegistry;
 class GLES3GPUFramebufferCacheMap;
+class GLES3GPUProgramCache;
 
 class CC_GLES3_API GLES3Device final : public Device {
 public:
@@ -75,6 +76,7 @@ public:
     inline GLES3GPUFramebufferHub *     framebufferHub() const { return _gpuFramebufferHub; }
     inline GLES3GPUConstantRegistry *   constantRegistry() const { return _gpuConstantRegistry; }
     inline GLES3GPUFramebufferCacheMap *framebufferCacheMap() const { return _gpuFramebufferCacheMap; }
+    inline GLES3GPUProgramCache *       programCache() const { return _gpuProgramCache; }
 
     inline bool checkExtension(const ccstd::string &extension) const {
         return std::any_of(_extensions.begin(), _extensions.end(), [&extension](auto &ext) {
@@ -114,6 +116,7 @@ protected:
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
+    void doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) override;
 
     void bindContext(bool bound) override;
 
@@ -124,9 +127,13 @@ protected:
     GLES3GPUFramebufferHub *     _gpuFramebufferHub{nullptr};
     GLES3GPUConstantRegistry *   _gpuConstantRegistry{nullptr};
     GLES3GPUFramebufferCacheMap *_gpuFramebufferCacheMap{nullptr};
+    GLES3GPUProgramCache *       _gpuProgramCache{nullptr}; // null if the driver supports no binary formats
 
     ccstd::vector<GLES3GPUSwapchain *> _swapchains;
 
+    ccstd::vector<GLES3GPUReadback> _gpuReadbacks;       // in flight
+    ccstd::vector<GLES3GPUReadback> _gpuReadbackBuffers; // retired, reused by the next readbacks
+
     GLESBindingMapping _bindingMappings;
 
     ccstd::vector<ccstd::string> _extensions;
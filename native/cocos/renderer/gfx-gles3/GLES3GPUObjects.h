@@ -23,6 +23,7 @@
 
 #include <algorithm>
 
+#include <chrono>
 #include "base/Macros.h"
 #include "base/std/container/unordered_map.h"
 #include "gfx-base/GFXDef-common.h"
@@ -103,6 +104,15 @@ public:
     }
 };
 
+// a pixel pack buffer the texture readback is copied to, with the fence to poll for its completion
+struct GLES3GPUReadback {
+    uint32_t handle   = 0U;
+    GLuint   glBuffer = 0U;
+    uint32_t capacity = 0U;
+    uint32_t size     = 0U;
+    GLsync   glSync   = nullptr;
+};
+
 struct GLES3GPUBuffer {
     BufferUsage  usage    = BufferUsage::NONE;
     MemoryUsage  memUsage = MemoryUsage::NONE;
@@ -325,6 +335,7 @@ struct GLES3GPURenderPass {
     ColorAttachmentList    colorAttachments;
     DepthStencilAttachment depthStencilAttachment;
     SubpassInfoList        subpasses;
+    uint32_t               viewCount{1U};
 
     ccstd::vector<AttachmentStatistics> statistics; // per attachment
 
@@ -440,6 +451,13 @@ struct GLES3GPUDispatchInfo {
     uint32_t        indirectOffset = 0;
 };
 
+struct GLES3GPUDrawIndirectInfo {
+    GLES3GPUBuffer *gpuBuffer = nullptr;
+    uint32_t        offset    = 0;
+    uint32_t        drawCount = 0;
+    uint32_t        stride    = 0;
+};
+
 struct GLES3ObjectCache {
     uint32_t                subpassIdx        = 0U;
     GLES3GPURenderPass *    gpuRenderPass     = nullptr;
@@ -453,6 +471,28 @@ struct GLES3ObjectCache {
     uint32_t                clearStencil = 0U;
 };
 
+// GL calls issued versus skipped by the state cache within a frame
+struct GLES3GPUStateStats {
+    uint32_t issuedCalls{0U};
+    uint32_t skippedCalls{0U};
+};
+
+// vertex attribute pointer state of the default vertex array object
+struct GLES3GPUVertexAttribPointer {
+    GLuint   glBuffer     = 0;
+    GLenum   glType       = 0;
+    uint32_t count        = 0;
+    uint32_t stride       = 0;
+    uint32_t offset       = 0;
+    bool     isNormalized = false;
+
+    bool operator==(const GLES3GPUVertexAttribPointer &rhs) const {
+        return glBuffer == rhs.glBuffer && glType == rhs.glType && count == rhs.count &&
+               stride == rhs.stride && offset == rhs.offset && isNormalized == rhs.isNormalized;
+    }
+    bool operator!=(const GLES3GPUVertexAttribPointer &rhs) const { return !(*this == rhs); }
+};
+
 class GLES3GPUStateCache final {
 public:
     GLuint                                        glArrayBuffer        = 0;
@@ -464,14 +504,18 @@ public:
     ccstd::vector<GLuint>                         glBindSSBOs;
     ccstd::vector<GLuint>                         glBindSSBOOffsets;
     GLuint                                        glDispatchIndirectBuffer = 0;
+    GLuint                                        glDrawIndirectBuffer     = 0;
     GLuint                                        glVAO                    = 0;
     uint32_t                                      texUint                  = 0;
     ccstd::vector<GLuint>                         glTextures;
     ccstd::vector<GLuint>                         glImages;
+    ccstd::vector<GLenum>                         glImageAccesses;
     ccstd::vector<GLuint>                         glSamplers;
     GLuint                                        glProgram = 0;
     ccstd::vector<bool>                           glEnabledAttribLocs;
     ccstd::vector<bool>                           glCurrentAttribLocs;
+    ccstd::vector<GLES3GPUVertexAttribPointer>    glAttribPointers;
+    ccstd::vector<GLuint>                         glAttribDivisors;
     GLuint                                        glReadFramebuffer = 0;
     GLuint                                        glDrawFramebuffer = 0;
     GLuint                                        glRenderbuffer    = 0;
@@ -484,6 +528,17 @@ public:
     bool                                          isStencilTestEnabled = false;
     ccstd::unordered_map<ccstd::string, uint32_t> texUnitCacheMap;
     GLES3ObjectCache                              gfxStateCache;
+    GLES3GPUStateStats                            stats;
+
+    // records whether a shadowed GL call is issued or skipped, returns dirty
+    inline bool checkDirty(bool dirty) {
+        if (dirty) {
+            ++stats.issuedCalls;
+        } else {
+            ++stats.skippedCalls;
+        }
+        return dirty;
+    }
 
     void initialize(size_t texUnits, size_t imageUnits, size_t uboBindings, size_t ssboBindings, size_t vertexAttributes) {
         glBindUBOs.resize(uboBindings, 0U);
@@ -493,8 +548,11 @@ public:
         glTextures.resize(texUnits, 0U);
         glSamplers.resize(texUnits, 0U);
         glImages.resize(imageUnits, 0U);
+        glImageAccesses.resize(imageUnits, 0U);
         glEnabledAttribLocs.resize(vertexAttributes, false);
         glCurrentAttribLocs.resize(vertexAttributes, false);
+        glAttribPointers.resize(vertexAttributes);
+        glAttribDivisors.resize(vertexAttributes, 0U);
         _initialized = true;
     }
 
@@ -510,14 +568,18 @@ public:
         glBindSSBOs.assign(glBindSSBOs.size(), 0U);
         glBindSSBOOffsets.assign(glBindSSBOOffsets.size(), 0U);
         glDispatchIndirectBuffer = 0;
+        glDrawIndirectBuffer     = 0;
         glVAO                    = 0;
         texUint                  = 0;
         glTextures.assign(glTextures.size(), 0U);
         glImages.assign(glImages.size(), 0U);
+        glImageAccesses.assign(glImageAccesses.size(), 0U);
         glSamplers.assign(glSamplers.size(), 0U);
         glProgram = 0;
         glEnabledAttribLocs.assign(glEnabledAttribLocs.size(), false);
         glCurrentAttribLocs.assign(glCurrentAttribLocs.size(), false);
+        glAttribPointers.assign(glAttribPointers.size(), GLES3GPUVertexAttribPointer());
+        glAttribDivisors.assign(glAttribDivisors.size(), 0U);
         glReadFramebuffer    = 0;
         glDrawFramebuffer    = 0;
         glRenderbuffer       = 0;
@@ -670,5 +732,32 @@ private:
     ccstd::unordered_map<GLES3GPUTexture *, ccstd::vector<GLES3GPUFramebuffer *>> _framebuffers;
 };
 
+// linked program binaries persisted across launches, the whole cache is dropped when the driver changes
+class GLES3GPUProgramCache final {
+public:
+    explicit GLES3GPUProgramCache(ccstd::string driverKey) : _driverKey(std::move(driverKey)) {}
+
+    void load();
+    void save();
+    void update(); // saves from time to time in case the app gets killed
+
+    // returns false if there is no binary for the sources or the driver rejects it
+    bool loadProgram(size_t sourceHash, GLuint glProgram);
+    void storeProgram(size_t sourceHash, GLuint glProgram);
+
+private:
+    struct Entry {
+        GLenum                 glFormat{0};
+        uint32_t               stamp{0}; // recently used entries survive the eviction
+        ccstd::vector<uint8_t> binary;
+    };
+
+    ccstd::string                         _driverKey;
+    ccstd::unordered_map<size_t, Entry>   _entries;
+    uint32_t                              _stamp{0};
+    bool                                  _dirty{false};
+    std::chrono::steady_clock::time_point _saveTime;
+};
+
 } // namespace gfx
 } // namespace cc
@@ -112,6 +112,22 @@ void GLES3PrimaryCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void GLES3PrimaryCommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    CC_PROFILE(GLES3PrimaryCommandBufferDrawIndirect);
+    if (_isStateInvalid) {
+        bindStates();
+    }
+
+    GLES3GPUDrawIndirectInfo gpuInfo;
+    gpuInfo.gpuBuffer = static_cast<GLES3Buffer *>(info.buffer)->gpuBuffer();
+    gpuInfo.offset    = info.offset;
+    gpuInfo.drawCount = info.drawCount;
+    gpuInfo.stride    = info.stride;
+    cmdFuncGLES3DrawIndirect(GLES3Device::getInstance(), gpuInfo);
+
+    _numDrawCalls += info.drawCount;
+}
+
 void GLES3PrimaryCommandBuffer::setViewport(const Viewport &vp) {
     auto *cache = GLES3Device::getInstance()->stateCache();
     if (cache->viewport != vp) {
@@ -41,6 +41,7 @@ public:
     void endRenderPass() override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
+    void drawIndirect(const DrawIndirectInfo &info) override;
     void setViewport(const Viewport &vp) override;
     void setScissor(const Rect &rect) override;
     void updateBuffer(Buffer *buff, const void *data, uint32_t size) override;
@@ -29,6 +29,7 @@
 #include "GLES3Commands.h"
 #include "GLES3Device.h"
 #include "GLES3Queue.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 namespace gfx {
@@ -48,6 +49,7 @@ void GLES3Queue::doDestroy() {
 }
 
 void GLES3Queue::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    CC_PROFILE(GLES3QueueSubmit);
     for (uint32_t i = 0; i < count; ++i) {
         auto *cmdBuff = static_cast<GLES3CommandBuffer *>(cmdBuffs[i]);
 
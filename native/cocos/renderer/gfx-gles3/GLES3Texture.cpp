@@ -30,6 +30,7 @@
 #include "GLES3Swapchain.h"
 #include "GLES3Texture.h"
 #include "base/Macros.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -63,6 +64,7 @@ void GLES3Texture::doInit(const TextureInfo & /*info*/) {
 
     if (!_gpuTexture->memoryless) {
         GLES3Device::getInstance()->getMemoryStatus().textureSize += _size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, _size);
         CC_PROFILE_MEMORY_INC(Texture, _size);
     }
 
@@ -96,6 +98,7 @@ void GLES3Texture::doDestroy() {
         if (!_isTextureView) {
             if (!_gpuTexture->memoryless) {
                 GLES3Device::getInstance()->getMemoryStatus().textureSize -= _size;
+                CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
                 CC_PROFILE_MEMORY_DEC(Texture, _size);
             }
 
@@ -110,6 +113,7 @@ void GLES3Texture::doDestroy() {
 void GLES3Texture::doResize(uint32_t width, uint32_t height, uint32_t size) {
     if (!_isTextureView && !_gpuTexture->memoryless) {
         GLES3Device::getInstance()->getMemoryStatus().textureSize -= _size;
+        CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
         CC_PROFILE_MEMORY_DEC(Texture, _size);
     }
 
@@ -124,6 +128,7 @@ void GLES3Texture::doResize(uint32_t width, uint32_t height, uint32_t size) {
 
     if (!_isTextureView && !_gpuTexture->memoryless) {
         GLES3Device::getInstance()->getMemoryStatus().textureSize += size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, size);
         CC_PROFILE_MEMORY_INC(Texture, size);
     }
 }
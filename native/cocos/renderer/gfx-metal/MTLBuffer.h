@@ -51,6 +51,7 @@ public:
     void encodeBuffer(CCMTLCommandEncoder &encoder, uint offset, uint binding, ShaderStageFlags stages);
 
     id<MTLBuffer> getMTLBuffer() const;
+    inline uint   getBufferViewOffset() const { return _isBufferView ? _bufferViewOffset : 0; }
 
     inline CCMTLGPUBuffer *    gpuBuffer() { return _gpuBuffer; }
     inline MTLIndexType        getIndexType() const { return _indexType; }
@@ -32,6 +32,7 @@
 #include "MTLRenderCommandEncoder.h"
 #include "MTLUtils.h"
 #include "MTLGPUObjects.h"
+#import "base/memory/MemoryAccounting.h"
 #import "profiler/Profiler.h"
 #import "base/Log.h"
 
@@ -79,6 +80,7 @@ void CCMTLBuffer::doInit(const BufferInfo &info) {
         }
     }
     CCMTLDevice::getInstance()->getMemoryStatus().bufferSize += _size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, _size);
     CC_PROFILE_MEMORY_INC(Buffer, _size);
 }
 
@@ -131,6 +133,7 @@ void CCMTLBuffer::doDestroy() {
     }
 
     CCMTLDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
     CC_PROFILE_MEMORY_DEC(Buffer, _size);
 
     if (!_indexedPrimitivesIndirectArguments.empty()) {
@@ -171,7 +174,9 @@ void CCMTLBuffer::doResize(uint size, uint count) {
     }
 
     CCMTLDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
     CCMTLDevice::getInstance()->getMemoryStatus().bufferSize += size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, size);
     CC_PROFILE_MEMORY_DEC(Buffer, _size);
     CC_PROFILE_MEMORY_INC(Buffer, size);
 
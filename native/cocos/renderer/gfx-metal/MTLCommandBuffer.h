@@ -30,6 +30,7 @@
 #import <Metal/MTLCommandQueue.h>
 #import <MetalKit/MTKView.h>
 #include <bitset>
+#include <functional>
 #include "MTLComputeCommandEncoder.h"
 #include "MTLGPUObjects.h"
 #include "MTLRenderCommandEncoder.h"
@@ -70,6 +71,7 @@ public:
     void                                setStencilCompareMask(StencilFace face, uint ref, uint mask) override;
     void                                nextSubpass() override;
     void                                draw(const DrawInfo &info) override;
+    void                                drawIndirect(const DrawIndirectInfo &info) override;
     void                                updateBuffer(Buffer *buff, const void *data, uint size) override;
     void                                copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint count) override;
     void                                blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint count, Filter filter) override;
@@ -77,6 +79,8 @@ public:
     void                                dispatch(const DispatchInfo &info) override;
     void                                pipelineBarrier(const GeneralBarrier *barrier, const TextureBarrier *const *textureBarriers, const Texture *const *textures, uint textureBarrierCount) override;
     void                                copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *regions, uint count);
+    // encoded into the current command buffer, onCompleted is called with the packed data of all regions when the GPU is done
+    void                                copyTextureToBuffersAsync(Texture *src, const BufferTextureCopy *regions, uint count, std::function<void(const uint8_t *)> onCompleted);
     void                                beginQuery(QueryPool *queryPool, uint32_t id) override;
     void                                endQuery(QueryPool *queryPool, uint32_t id) override;
     void                                resetQueryPool(QueryPool *queryPool) override;
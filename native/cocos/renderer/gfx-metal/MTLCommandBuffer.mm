@@ -639,6 +639,47 @@ void CCMTLCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void CCMTLCommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    CC_PROFILE(CCMTLCommandBufferDrawIndirect);
+    const auto *indirectBuffer = static_cast<CCMTLBuffer *>(info.buffer);
+    const auto *indexBuffer    = static_cast<CCMTLBuffer *>(_gpuCommandBufferObj->inputAssembler->getIndexBuffer());
+    const uint  commandStride  = indexBuffer ? sizeof(MTLDrawIndexedPrimitivesIndirectArguments) : sizeof(MTLDrawPrimitivesIndirectArguments);
+    const uint  stride         = info.stride ? info.stride : commandStride;
+
+    if (!_indirectDrawSuppotred) {
+        // emulated with the draw infos kept on the CPU
+        const auto &drawInfos = indirectBuffer->getDrawInfos();
+        const uint  step      = std::max(stride / commandStride, 1U);
+        for (uint i = 0, j = info.offset / commandStride; i < info.drawCount && j < drawInfos.size(); ++i, j += step) {
+            draw(drawInfos[j]);
+        }
+        return;
+    }
+
+    if (_firstDirtyDescriptorSet < _GPUDescriptorSets.size()) {
+        bindDescriptorSets();
+    }
+
+    auto          mtlEncoder        = _renderEncoder.getMTLEncoder();
+    id<MTLBuffer> indirectMTLBuffer = indirectBuffer->getMTLBuffer();
+    for (uint i = 0; i < info.drawCount; ++i) {
+        const NSUInteger offset = info.offset + i * stride;
+        if (indexBuffer) {
+            [mtlEncoder drawIndexedPrimitives:_mtlPrimitiveType
+                                    indexType:indexBuffer->getIndexType()
+                                  indexBuffer:indexBuffer->getMTLBuffer()
+                            indexBufferOffset:0
+                               indirectBuffer:indirectMTLBuffer
+                         indirectBufferOffset:offset];
+        } else {
+            [mtlEncoder drawPrimitives:_mtlPrimitiveType
+                        indirectBuffer:indirectMTLBuffer
+                  indirectBufferOffset:offset];
+        }
+    }
+    _numDrawCalls += info.drawCount;
+}
+
 void CCMTLCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint size) {
     CC_PROFILE(CCMTLCmdBufUpdateBuffer);
     if (!buff) {
@@ -796,6 +837,23 @@ void CCMTLCommandBuffer::bindDescriptorSets() {
             _computeEncoder.setTexture(gpuDescriptor.texture->getMTLTexture(), sampler.textureBinding);
         }
     }
+
+    for (const auto &argumentBuffer : pipelineStateObj->gpuShader->argumentBuffers) {
+        auto *gpuDescriptorSet = _GPUDescriptorSets[argumentBuffer.set];
+        if (!gpuDescriptorSet) {
+            CC_LOG_ERROR("Argument buffer at set %d is not bounded.", argumentBuffer.set);
+            continue;
+        }
+
+        bool        isEncoded = false;
+        const auto &encoded   = gpuDescriptorSet->encodeArguments(argumentBuffer, isEncoded);
+        _renderEncoder.useResources(&encoded, encoded.residentResources, isEncoded);
+        if (argumentBuffer.stage == ShaderStageFlagBit::VERTEX) {
+            _renderEncoder.setVertexBuffer(encoded.buffer, encoded.offset, argumentBuffer.index);
+        } else {
+            _renderEncoder.setFragmentBuffer(encoded.buffer, encoded.offset, argumentBuffer.index);
+        }
+    }
 }
 
 void CCMTLCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint count, Filter filter) {
@@ -974,6 +1032,57 @@ void CCMTLCommandBuffer::copyTextureToBuffers(Texture *src, uint8_t *const *buff
     }
 }
 
+void CCMTLCommandBuffer::copyTextureToBuffersAsync(Texture *src, const BufferTextureCopy *regions, uint count, std::function<void(const uint8_t *)> onCompleted) {
+    auto *               ccMTLTexture     = static_cast<CCMTLTexture *>(src);
+    Format               convertedFormat  = ccMTLTexture->getConvertedFormat();
+    id<MTLTexture>       mtlTexture       = ccMTLTexture->getMTLTexture();
+    id<MTLCommandBuffer> mtlCommandBuffer = getMTLCommandBuffer();
+
+    // staging addresses with the sizes to copy, and the offsets in the packed layout of the device readback
+    ccstd::vector<std::pair<uint8_t *, uint32_t>> stagingAddrs(count);
+    ccstd::vector<uint32_t>                       regionOffsets(count);
+    uint32_t                                      totalSize = 0U;
+    id<MTLBlitCommandEncoder>                     encoder   = [mtlCommandBuffer blitCommandEncoder];
+    for (size_t i = 0; i < count; ++i) {
+        const BufferTextureCopy &region        = regions[i];
+        uint32_t                 width         = region.texExtent.width;
+        uint32_t                 height        = region.texExtent.height;
+        uint32_t                 depth         = region.texExtent.depth;
+        uint32_t                 bytesPerRow   = mu::getBytesPerRow(convertedFormat, width);
+        uint32_t                 bytesPerImage = formatSize(convertedFormat, width, height, depth);
+        uint32_t                 w             = region.buffStride > 0 ? region.buffStride : width;
+        uint32_t                 h             = region.buffTexHeight > 0 ? region.buffTexHeight : height;
+        uint32_t                 regionSize    = formatSize(src->getFormat(), w, h, depth);
+        const Offset &           origin        = region.texOffset;
+
+        CCMTLGPUBuffer stagingBuffer;
+        stagingBuffer.size = bytesPerImage;
+        _mtlDevice->gpuStagingBufferPool()->alloc(&stagingBuffer);
+        [encoder copyFromTexture:mtlTexture
+                     sourceSlice:region.texSubres.baseArrayLayer
+                     sourceLevel:region.texSubres.mipLevel
+                    sourceOrigin:MTLOriginMake(origin.x, origin.y, origin.z)
+                      sourceSize:MTLSizeMake(width, height, depth)
+                        toBuffer:stagingBuffer.mtlBuffer
+               destinationOffset:stagingBuffer.startOffset
+          destinationBytesPerRow:bytesPerRow
+        destinationBytesPerImage:bytesPerImage];
+        stagingAddrs[i]  = {stagingBuffer.mappedData, std::min(regionSize, bytesPerImage)};
+        regionOffsets[i] = totalSize;
+        totalSize += regionSize;
+    }
+    [encoder endEncoding];
+
+    // the staging buffers of this frame are not reused before the command buffer completes
+    [mtlCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> commandBuffer) {
+        ccstd::vector<uint8_t> data(totalSize);
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(data.data() + regionOffsets[i], stagingAddrs[i].first, stagingAddrs[i].second);
+        }
+        onCompleted(data.data());
+    }];
+}
+
 void CCMTLCommandBuffer::beginQuery(QueryPool *queryPool, uint32_t id) {
     auto *mtlQueryPool = static_cast<CCMTLQueryPool *>(queryPool);
     auto  queryId      = static_cast<uint32_t>(mtlQueryPool->_ids.size());
@@ -27,3 +27,8 @@
 
 #define MAX_FRAMES_IN_FLIGHT     3
 #define MAX_COMMAND_BUFFER_COUNT 256
+// descriptor set encoded into an argument buffer when argument buffers tier 2 is supported, the material set of the render pipeline
+#define ARGUMENT_BUFFER_SET 1
+// descriptor set holding the bindless texture table, the global set of the render pipeline, encoded into an argument buffer
+// by the stages sampling an array too large for the sampler argument table
+#define BINDLESS_ARGUMENT_BUFFER_SET 0
@@ -26,6 +26,7 @@
 #include "MTLBuffer.h"
 #include "MTLDescriptorSet.h"
 #include "MTLDescriptorSetLayout.h"
+#include "MTLDevice.h"
 #include "MTLGPUObjects.h"
 #include "MTLSampler.h"
 #include "MTLTexture.h"
@@ -57,6 +58,16 @@ CCMTLDescriptorSet::~CCMTLDescriptorSet() {
 }
 
 void CCMTLDescriptorSet::doDestroy() {
+    if (_gpuDescriptorSet) {
+        for (auto &iter : _gpuDescriptorSet->encodedArguments) {
+            id<MTLBuffer> buffer = iter.second.buffer;
+            if (buffer) {
+                CCMTLGPUGarbageCollectionPool::getInstance()->collect([buffer]() {
+                    [buffer release];
+                });
+            }
+        }
+    }
     CC_SAFE_DELETE(_gpuDescriptorSet);
 }
 
@@ -87,5 +98,85 @@ void CCMTLDescriptorSet::update() {
         _isDirty = false;
     }
 }
+
+const CCMTLGPUEncodedArguments &CCMTLGPUDescriptorSet::encodeArguments(const CCMTLGPUArgumentBuffer &argumentBuffer, bool &isEncoded) {
+    auto &encoded = encodedArguments[argumentBuffer.id];
+
+    // scratch contents, swapped into the encoded ones when they differ
+    static ccstd::vector<id<MTLResource>>     resources;
+    static ccstd::vector<uint>                offsets;
+    static ccstd::vector<id<MTLSamplerState>> samplers;
+    resources.clear();
+    offsets.clear();
+    samplers.clear();
+
+    // unbound textures read the default ones like discrete bindings
+    for (const auto &argument : argumentBuffer.arguments) {
+        const auto descriptorIndex = descriptorIndices->at(argument.binding);
+        for (uint i = 0; i < argument.count; ++i) {
+            const auto &gpuDescriptor = gpuDescriptors[descriptorIndex + i];
+            if (argument.isBuffer) {
+                resources.push_back(gpuDescriptor.buffer ? gpuDescriptor.buffer->getMTLBuffer() : nil);
+                offsets.push_back(gpuDescriptor.buffer ? gpuDescriptor.buffer->getBufferViewOffset() : 0);
+            } else {
+                const auto *texture = gpuDescriptor.texture ? gpuDescriptor.texture : CCMTLTexture::getDefaultTexture();
+                const auto *sampler = gpuDescriptor.sampler ? gpuDescriptor.sampler : CCMTLSampler::getDefaultSampler();
+                resources.push_back(texture->getMTLTexture());
+                samplers.push_back(sampler->getMTLSamplerState());
+            }
+        }
+    }
+
+    isEncoded = !encoded.buffer || resources != encoded.resources || offsets != encoded.offsets || samplers != encoded.samplers;
+    if (!isEncoded) {
+        return encoded;
+    }
+
+    id<MTLArgumentEncoder> encoder = argumentBuffer.encoder;
+    const auto             stride  = mu::alignUp(static_cast<uint>(encoder.encodedLength), static_cast<uint>(encoder.alignment));
+    // slots are never rewritten, work in flight may still read them
+    if (!encoded.buffer || encoded.stride != stride || encoded.slot + 1 >= MAX_FRAMES_IN_FLIGHT) {
+        id<MTLBuffer> buffer = encoded.buffer;
+        if (buffer) {
+            CCMTLGPUGarbageCollectionPool::getInstance()->collect([buffer]() {
+                [buffer release];
+            });
+        }
+        id<MTLDevice> mtlDevice = static_cast<id<MTLDevice>>(CCMTLDevice::getInstance()->getMTLDevice());
+        encoded.buffer          = [mtlDevice newBufferWithLength:stride * MAX_FRAMES_IN_FLIGHT options:MTLResourceStorageModeShared];
+        encoded.stride          = stride;
+        encoded.slot            = 0;
+    } else {
+        ++encoded.slot;
+    }
+    encoded.offset = encoded.slot * stride;
+
+    [encoder setArgumentBuffer:encoded.buffer offset:encoded.offset];
+    uint resourceIndex = 0;
+    uint samplerIndex  = 0;
+    for (const auto &argument : argumentBuffer.arguments) {
+        for (uint i = 0; i < argument.count; ++i) {
+            if (argument.isBuffer) {
+                [encoder setBuffer:static_cast<id<MTLBuffer>>(resources[resourceIndex]) offset:offsets[resourceIndex] atIndex:mu::getArgumentBufferID(argument.binding, i, false)];
+            } else {
+                [encoder setTexture:static_cast<id<MTLTexture>>(resources[resourceIndex]) atIndex:mu::getArgumentBufferID(argument.binding, i, false)];
+                [encoder setSamplerState:samplers[samplerIndex++] atIndex:mu::getArgumentBufferID(argument.binding, i, true)];
+            }
+            ++resourceIndex;
+        }
+    }
+
+    encoded.resources.swap(resources);
+    encoded.offsets.swap(offsets);
+    encoded.samplers.swap(samplers);
+    encoded.residentResources.clear();
+    for (id<MTLResource> resource : encoded.resources) {
+        if (resource) {
+            encoded.residentResources.push_back(resource);
+        }
+    }
+    return encoded;
+}
+
 }
 }
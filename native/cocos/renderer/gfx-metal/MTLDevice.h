@@ -34,6 +34,7 @@ namespace gfx {
 struct CCMTLGPUDeviceObject;
 
 class CCMTLGPUStagingBufferPool;
+class CCMTLGPUTextureHeapPool;
 class CCMTLSemaphore;
 class CCMTLSwapchain;
 
@@ -76,9 +77,14 @@ public:
     inline uint                       getMaximumBufferBindingIndex() const { return _maxBufferBindingIndex; }
     inline bool                       isIndirectCommandBufferSupported() const { return _icbSuppored; }
     inline bool                       isIndirectDrawSupported() const { return _indirectDrawSupported; }
+    inline bool                       isArgumentBufferSupported() const { return _argumentBufferSupported; }
     inline CCMTLGPUStagingBufferPool *gpuStagingBufferPool() const { return _gpuStagingBufferPools[_currentFrameIndex]; }
+    inline CCMTLGPUTextureHeapPool *  gpuTextureHeapPool() const { return _gpuTextureHeapPool; }
     inline bool                       isSamplerDescriptorCompareFunctionSupported() const { return _isSamplerDescriptorCompareFunctionSupported; }
     inline uint                       currentFrameIndex() const { return _currentFrameIndex; }
+    // id<MTLBinaryArchive> persisted across launches, nullptr before iOS 14 and macOS 11
+    inline void *                     getMTLBinaryArchive() const { return _mtlBinaryArchive; }
+    inline void                       markBinaryArchiveDirty() { _binaryArchiveDirty = true; }
 
     inline void registerSwapchain(CCMTLSwapchain *swapchain) { _swapchains.push_back(swapchain); }
     inline void unRegisterSwapchain(CCMTLSwapchain *swapchain) {
@@ -113,9 +119,12 @@ protected:
     void                 copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint count) override;
     void                 copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint count) override;
     void                 getQueryPoolResults(QueryPool *queryPool) override;
+    void                 doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) override;
 
     void onMemoryWarning();
     void initFormatFeatures(uint family);
+    void loadBinaryArchive();
+    void saveBinaryArchive();
 
     void *                     _mtlCommandQueue                             = nullptr;
     void *                     _mtlDevice                                   = nullptr;
@@ -125,12 +134,17 @@ protected:
     uint                       _maxBufferBindingIndex                       = 0;
     bool                       _icbSuppored                                 = false;
     bool                       _indirectDrawSupported                       = false;
+    bool                       _argumentBufferSupported                     = false;
     bool                       _isSamplerDescriptorCompareFunctionSupported = false;
     CCMTLGPUStagingBufferPool *_gpuStagingBufferPools[MAX_FRAMES_IN_FLIGHT] = {nullptr};
+    CCMTLGPUTextureHeapPool *  _gpuTextureHeapPool                          = nullptr;
     uint                       _currentBufferPoolId                         = 0;
     uint                       _currentFrameIndex                           = 0;
     CCMTLSemaphore *           _inFlightSemaphore                           = nullptr;
     CC_UNUSED uint32_t         _memoryAlarmListenerId                       = 0;
+    void *                     _mtlBinaryArchive                            = nullptr;
+    bool                       _binaryArchiveDirty                          = false;
+    uint                       _framesSinceArchiveSaved                     = 0;
 
     ccstd::vector<CCMTLSwapchain *> _swapchains;
 
@@ -46,10 +46,24 @@
 #import "cocos/bindings/event/EventDispatcher.h"
 #import "profiler/Profiler.h"
 #import "base/Log.h"
+#import "base/Utils.h"
+#import "gfx-base/GFXCacheFile.h"
 
 namespace cc {
 namespace gfx {
 
+namespace {
+constexpr char BINARY_ARCHIVE_FILE[]     = "mtl_binary_archive.bin";
+constexpr char BINARY_ARCHIVE_KEY_FILE[] = "mtl_binary_archive.key";
+// about 30 seconds at 60 fps
+constexpr uint BINARY_ARCHIVE_SAVE_INTERVAL = 1800;
+
+// the archive is only reused on the same GPU and OS build
+ccstd::string getBinaryArchiveKey(id<MTLDevice> mtlDevice) {
+    return ccstd::string([mtlDevice.name UTF8String]) + "|" + [[NSProcessInfo processInfo].operatingSystemVersionString UTF8String];
+}
+} // namespace
+
 CCMTLDevice *CCMTLDevice::_instance = nullptr;
 
 CCMTLDevice *CCMTLDevice::getInstance() {
@@ -95,12 +109,15 @@ bool CCMTLDevice::doInit(const DeviceInfo &info) {
     _maxBufferBindingIndex                              = mu::getMaxEntriesInBufferArgumentTable(gpuFamily);
     _icbSuppored                                        = mu::isIndirectCommandBufferSupported(MTLFeatureSet(_mtlFeatureSet));
     _isSamplerDescriptorCompareFunctionSupported        = mu::isSamplerDescriptorCompareFunctionSupported(gpuFamily);
+    _argumentBufferSupported                            = mu::isArgumentBuffersTier2Supported(mtlDevice);
 
     for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         _gpuStagingBufferPools[i] = CC_NEW(CCMTLGPUStagingBufferPool(mtlDevice));
     }
+    _gpuTextureHeapPool = CC_NEW(CCMTLGPUTextureHeapPool(mtlDevice));
 
     initFormatFeatures(gpuFamily);
+    loadBinaryArchive();
 
     ccstd::string compressedFormats;
 
@@ -126,6 +143,8 @@ bool CCMTLDevice::doInit(const DeviceInfo &info) {
     _features[toNumber(Feature::ELEMENT_INDEX_UINT)]       = true;
     _features[toNumber(Feature::COMPUTE_SHADER)]           = true;
     _features[toNumber(Feature::INPUT_ATTACHMENT_BENEFIT)] = true;
+    // sampler texture arrays of BINDLESS_ARGUMENT_BUFFER_SET are read through argument buffers
+    _features[toNumber(Feature::BINDLESS_TEXTURE)] = _argumentBufferSupported;
 
     QueueInfo queueInfo;
     queueInfo.type = QueueType::GRAPHICS;
@@ -155,6 +174,12 @@ void CCMTLDevice::doDestroy() {
     //    }
 
     CC_DELETE(_gpuDeviceObj);
+
+    saveBinaryArchive();
+    if (_mtlBinaryArchive) {
+        [id(_mtlBinaryArchive) release];
+        _mtlBinaryArchive = nullptr;
+    }
     
     CC_SAFE_DESTROY_AND_DELETE(_queryPool)
     CC_SAFE_DESTROY_AND_DELETE(_queue);
@@ -173,6 +198,7 @@ void CCMTLDevice::doDestroy() {
         CC_SAFE_DELETE(_gpuStagingBufferPools[i]);
         _gpuStagingBufferPools[i] = nullptr;
     }
+    CC_SAFE_DELETE(_gpuTextureHeapPool);
 
     cc::gfx::mu::clearUtilResource();
 
@@ -233,6 +259,62 @@ void CCMTLDevice::present() {
         }];
         [cmdBuffer commit];
     }
+
+    if (++_framesSinceArchiveSaved >= BINARY_ARCHIVE_SAVE_INTERVAL) {
+        saveBinaryArchive();
+        _framesSinceArchiveSaved = 0;
+    }
+}
+
+void CCMTLDevice::loadBinaryArchive() {
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+        id<MTLDevice>       mtlDevice = id<MTLDevice>(_mtlDevice);
+        const ccstd::string key       = getBinaryArchiveKey(mtlDevice);
+        const ccstd::string path      = CacheFile::getPath(BINARY_ARCHIVE_FILE);
+
+        ccstd::vector<uint8_t> unused;
+        const bool             valid = CacheFile::load(BINARY_ARCHIVE_KEY_FILE, key.data(), utils::toUint(key.size()), unused);
+
+        MTLBinaryArchiveDescriptor *descriptor = [[MTLBinaryArchiveDescriptor alloc] init];
+        if (valid) {
+            descriptor.url = [NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]];
+        }
+        NSError *nsError   = nil;
+        _mtlBinaryArchive = [mtlDevice newBinaryArchiveWithDescriptor:descriptor error:&nsError];
+        if (!_mtlBinaryArchive && valid) {
+            // outdated or corrupted, start over with an empty archive
+            descriptor.url    = nil;
+            _mtlBinaryArchive = [mtlDevice newBinaryArchiveWithDescriptor:descriptor error:&nsError];
+        }
+        [descriptor release];
+
+        if (!_mtlBinaryArchive) {
+            CC_LOG_ERROR("Failed to create MTLBinaryArchive: %s", [nsError.localizedDescription UTF8String]);
+        }
+    }
+}
+
+void CCMTLDevice::saveBinaryArchive() {
+    if (!_mtlBinaryArchive || !_binaryArchiveDirty) {
+        return;
+    }
+
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+        id<MTLBinaryArchive> archive = id<MTLBinaryArchive>(_mtlBinaryArchive);
+        const ccstd::string  key     = getBinaryArchiveKey(id<MTLDevice>(_mtlDevice));
+        // written first to create the cache directory
+        if (!CacheFile::save(BINARY_ARCHIVE_KEY_FILE, key.data(), utils::toUint(key.size()), nullptr, 0)) {
+            return;
+        }
+
+        const ccstd::string path    = CacheFile::getPath(BINARY_ARCHIVE_FILE);
+        NSError *           nsError = nil;
+        if ([archive serializeToURL:[NSURL fileURLWithPath:[NSString stringWithUTF8String:path.c_str()]] error:&nsError]) {
+            _binaryArchiveDirty = false;
+        } else {
+            CC_LOG_ERROR("Failed to serialize MTLBinaryArchive: %s", [nsError.localizedDescription UTF8String]);
+        }
+    }
 }
 
 void CCMTLDevice::onPresentCompleted() {
@@ -321,6 +403,19 @@ void CCMTLDevice::copyTextureToBuffers(Texture *src, uint8_t *const *buffers, co
     static_cast<CCMTLCommandBuffer *>(_cmdBuff)->copyTextureToBuffers(src, buffers, region, count);
 }
 
+void CCMTLDevice::doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    CC_PROFILE(CCMTLDeviceDoTextureReadback);
+    id<MTLTexture> mtlTexture = static_cast<CCMTLTexture *>(src)->getMTLTexture();
+    if ([mtlTexture storageMode] == MTLStorageModeShared) {
+        // read by the CPU directly
+        Device::doTextureReadback(handle, src, regions, count);
+        return;
+    }
+    static_cast<CCMTLCommandBuffer *>(_cmdBuff)->copyTextureToBuffersAsync(src, regions, count, [this, handle](const uint8_t *data) {
+        finishTextureReadback(handle, data);
+    });
+}
+
 void CCMTLDevice::getQueryPoolResults(QueryPool *queryPool) {
     CC_PROFILE(CCMTLDeviceGetQueryPoolResults);
     auto *             mtlQueryPool = static_cast<CCMTLQueryPool *>(queryPool);
@@ -352,6 +447,7 @@ void CCMTLDevice::onMemoryWarning() {
     for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
         _gpuStagingBufferPools[i]->shrinkSize();
     }
+    _gpuTextureHeapPool->shrinkSize();
 }
 void CCMTLDevice::initFormatFeatures(uint gpuFamily) {
     const FormatFeature completeFeature = FormatFeature::RENDER_TARGET | FormatFeature::SAMPLED_TEXTURE | FormatFeature::LINEAR_FILTER | FormatFeature::STORAGE_TEXTURE;
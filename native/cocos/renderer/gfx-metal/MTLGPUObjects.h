@@ -25,8 +25,10 @@
 
 #pragma once
 
+#import <Metal/MTLArgumentEncoder.h>
 #import <Metal/MTLBuffer.h>
 #import <Metal/MTLCommandQueue.h>
+#import <Metal/MTLHeap.h>
 #import <Metal/MTLRenderCommandEncoder.h>
 #import <Metal/MTLSampler.h>
 #import <QuartzCore/CAMetalLayer.h>
@@ -34,6 +36,7 @@
 #import "MTLConfig.h"
 #import "MTLDevice.h"
 #import "MTLUtils.h"
+#include <mutex>
 #include "base/std/container/queue.h"
 
 namespace cc {
@@ -96,6 +99,23 @@ struct CCMTLGPUSubpassAttachment {
     uint          binding = INVALID_BINDING;
 };
 
+// uniform blocks and sampler textures of ARGUMENT_BUFFER_SET or BINDLESS_ARGUMENT_BUFFER_SET read by one shader stage
+// through an argument buffer
+struct CCMTLGPUArgumentBuffer {
+    struct Argument {
+        uint binding  = INVALID_BINDING;
+        uint count    = 1;
+        bool isBuffer = false;
+    };
+
+    uint                    id    = 0; // unique, keys the encoded contents in the descriptor sets
+    uint                    set   = ARGUMENT_BUFFER_SET;
+    ShaderStageFlagBit      stage = ShaderStageFlagBit::NONE;
+    uint                    index = INVALID_BINDING; // buffer binding index in the argument table of the stage
+    ccstd::vector<Argument> arguments;
+    id<MTLArgumentEncoder>  encoder = nil;
+};
+
 struct CCMTLGPUShader {
     ccstd::unordered_map<uint, CCMTLGPUUniformBlock> blocks;
     ccstd::unordered_map<uint, CCMTLGPUSamplerBlock> samplers;
@@ -108,6 +128,9 @@ struct CCMTLGPUShader {
 
     uint32_t bufferIndex  = 0;
     uint32_t samplerIndex = 0;
+
+    // stages without an argument buffer bind the set discretely
+    ccstd::vector<CCMTLGPUArgumentBuffer> argumentBuffers;
 };
 
 struct CCMTLGPUPipelineState {
@@ -159,9 +182,27 @@ struct CCMTLGPUDescriptor {
 };
 typedef ccstd::vector<CCMTLGPUDescriptor> MTLGPUDescriptorList;
 
+// argument buffer contents of a descriptor set for one shader stage, re-encoded into the next slot whenever
+// a bound resource changes, the buffer is replaced once all slots are used so work in flight keeps its copy
+struct CCMTLGPUEncodedArguments {
+    id<MTLBuffer>                      buffer = nil;
+    uint                               offset = 0;
+    uint                               stride = 0;
+    uint                               slot   = 0;
+    ccstd::vector<id<MTLResource>>     resources;
+    ccstd::vector<uint>                offsets;
+    ccstd::vector<id<MTLSamplerState>> samplers;
+    ccstd::vector<id<MTLResource>>     residentResources; // made resident for the render passes using the arguments
+};
+
 struct CCMTLGPUDescriptorSet {
     MTLGPUDescriptorList       gpuDescriptors;
     const ccstd::vector<uint> *descriptorIndices = nullptr;
+
+    ccstd::unordered_map<uint, CCMTLGPUEncodedArguments> encodedArguments; // by CCMTLGPUArgumentBuffer::id
+
+    // isEncoded is set if the contents changed since the last call
+    const CCMTLGPUEncodedArguments &encodeArguments(const CCMTLGPUArgumentBuffer &argumentBuffer, bool &isEncoded);
 };
 
 class CCMTLGPUStagingBufferPool final {
@@ -273,6 +314,71 @@ protected:
     ccstd::vector<Buffer> _pool;
 };
 
+// sub-allocates private render targets from heaps, released textures hand their memory back to the heap
+// so later render targets alias it. Heaps track hazards themselves, aliased accesses need no extra fences.
+class CCMTLGPUTextureHeapPool final {
+public:
+    explicit CCMTLGPUTextureHeapPool(id<MTLDevice> device)
+    : _device(device) {}
+
+    ~CCMTLGPUTextureHeapPool() {
+        for (id<MTLHeap> heap : _heaps) {
+            [heap release];
+        }
+        _heaps.clear();
+    }
+
+    // nil if heaps are not supported or exhausted, allocate from the device then
+    id<MTLTexture> alloc(MTLTextureDescriptor *descriptor) {
+        if (@available(iOS 13.0, macOS 10.15, *)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            const MTLSizeAndAlign sizeAndAlign = [_device heapTextureSizeAndAlignWithDescriptor:descriptor];
+            for (id<MTLHeap> heap : _heaps) {
+                if ([heap maxAvailableSizeWithAlignment:sizeAndAlign.align] >= sizeAndAlign.size) {
+                    id<MTLTexture> texture = [heap newTextureWithDescriptor:descriptor];
+                    if (texture) {
+                        return texture;
+                    }
+                }
+            }
+
+            MTLHeapDescriptor *heapDescriptor = [[MTLHeapDescriptor alloc] init];
+            heapDescriptor.storageMode        = MTLStorageModePrivate;
+            heapDescriptor.hazardTrackingMode = MTLHazardTrackingModeTracked;
+            heapDescriptor.size               = std::max<NSUInteger>(HEAP_SIZE, sizeAndAlign.size + sizeAndAlign.align);
+            id<MTLHeap> heap                  = [_device newHeapWithDescriptor:heapDescriptor];
+            [heapDescriptor release];
+            if (!heap) {
+                return nil;
+            }
+
+            _heaps.push_back(heap);
+            return [heap newTextureWithDescriptor:descriptor];
+        }
+        return nil;
+    }
+
+    void shrinkSize() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto iter = _heaps.begin(); iter != _heaps.end();) {
+            if ([*iter usedSize] == 0) {
+                [*iter release];
+                iter = _heaps.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+protected:
+    static constexpr NSUInteger HEAP_SIZE = 32 * MegaBytesToBytes;
+
+    id<MTLDevice>              _device = nil;
+    ccstd::vector<id<MTLHeap>> _heaps;
+    std::mutex                 _mutex;
+};
+
 struct CCMTLGPUBufferImageCopy {
     NSUInteger sourceBytesPerRow   = 0;
     NSUInteger sourceBytesPerImage = 0;
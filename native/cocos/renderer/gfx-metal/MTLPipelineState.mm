@@ -36,6 +36,7 @@
 #import "MTLUtils.h"
 
 #import <Metal/MTLComputePipeline.h>
+#include <chrono>
 #import <Metal/MTLDevice.h>
 #import <Metal/MTLVertexDescriptor.h>
 
@@ -361,9 +362,37 @@ void CCMTLPipelineState::setBlendStates(MTLRenderPipelineDescriptor *descriptor)
 }
 
 bool CCMTLPipelineState::createMTLRenderPipeline(MTLRenderPipelineDescriptor *descriptor) {
-    id<MTLDevice> mtlDevice = id<MTLDevice>(CCMTLDevice::getInstance()->getMTLDevice());
+    auto *        device    = CCMTLDevice::getInstance();
+    id<MTLDevice> mtlDevice = id<MTLDevice>(device->getMTLDevice());
     NSError *     nsError   = nil;
-    _mtlRenderPipelineState = [mtlDevice newRenderPipelineStateWithDescriptor:descriptor error:&nsError];
+    auto &        status    = device->getPipelineCacheStatus();
+    const auto    start     = std::chrono::steady_clock::now();
+
+    if (@available(iOS 14.0, macOS 11.0, *)) {
+        id<MTLBinaryArchive> archive = id<MTLBinaryArchive>(device->getMTLBinaryArchive());
+        if (archive) {
+            descriptor.binaryArchives = @[archive];
+            _mtlRenderPipelineState   = [mtlDevice newRenderPipelineStateWithDescriptor:descriptor
+                                                                              options:MTLPipelineOptionFailOnBinaryArchiveMiss
+                                                                           reflection:nil
+                                                                                error:&nsError];
+            if (_mtlRenderPipelineState) {
+                ++status.hits;
+            } else {
+                ++status.misses;
+                // compiled below, stored for the next launch
+                if ([archive addRenderPipelineFunctionsWithDescriptor:descriptor error:&nsError]) {
+                    device->markBinaryArchiveDirty();
+                }
+                nsError = nil;
+            }
+        }
+    }
+
+    if (!_mtlRenderPipelineState) {
+        _mtlRenderPipelineState = [mtlDevice newRenderPipelineStateWithDescriptor:descriptor error:&nsError];
+    }
+    status.creationTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
     if (!_mtlRenderPipelineState) {
         CC_LOG_ERROR("Failed to create MTLRenderPipelineState: %s", [nsError.localizedDescription UTF8String]);
         return false;
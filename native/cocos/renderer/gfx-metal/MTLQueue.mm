@@ -29,6 +29,7 @@
 #import "MTLGPUObjects.h"
 #import "MTLFramebuffer.h"
 #import "MTLSwapchain.h"
+#import "profiler/Profiler.h"
 namespace cc {
 namespace gfx {
 
@@ -64,6 +65,7 @@ void CCMTLQueue::doDestroy() {
 }
 
 void CCMTLQueue::submit(CommandBuffer *const *cmdBuffs, uint count) {
+    CC_PROFILE(CCMTLQueueSubmit);
     for (uint i = 0u; i < count; ++i) {
         CCMTLCommandBuffer *cmdBuffer = static_cast<CCMTLCommandBuffer*>(cmdBuffs[i]);
         _gpuQueueObj->numDrawCalls += cmdBuffer->getNumDrawCalls();
@@ -32,6 +32,8 @@
 #include "MTLUtils.h"
 #include "base/Macros.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 #include "math/Math.h"
 
 namespace cc {
@@ -84,6 +86,7 @@ public:
         _fragmentTextureMap.clear();
         _vertexSamplerMap.clear();
         _fragmentSamplerMap.clear();
+        _residentResourceOwners.clear();
     }
 
     inline void setViewport(const Rect &rect) {
@@ -264,6 +267,22 @@ public:
         [_mtlEncoder setFragmentSamplerState:sampler atIndex:index];
     }
 
+    // resources referenced by argument buffers have to be made resident explicitly,
+    // once per encoder for each owner unless its argument buffer was re-encoded
+    inline void useResources(const void *owner, const ccstd::vector<id<MTLResource>> &resources, bool isEncoded) {
+        if (!_residentResourceOwners.insert(owner).second && !isEncoded) {
+            return;
+        }
+
+        if (resources.empty()) {
+            return;
+        }
+
+        if (@available(iOS 11.0, macOS 10.13, *)) {
+            [_mtlEncoder useResources:resources.data() count:resources.size() usage:MTLResourceUsageRead];
+        }
+    }
+
     inline void endEncoding() {
         [_mtlEncoder endEncoding];
         [_mtlEncoder release];
@@ -304,6 +323,7 @@ protected:
     ccstd::unordered_map<uint, id<MTLTexture>>      _fragmentTextureMap;
     ccstd::unordered_map<uint, id<MTLSamplerState>> _vertexSamplerMap;
     ccstd::unordered_map<uint, id<MTLSamplerState>> _fragmentSamplerMap;
+    ccstd::unordered_set<const void *>              _residentResourceOwners;
 };
 
 } // namespace gfx
@@ -51,6 +51,11 @@ CCMTLSampler::CCMTLSampler(const SamplerInfo& info) : Sampler(info) {
     if (CCMTLDevice::getInstance()->isSamplerDescriptorCompareFunctionSupported()) {
         descriptor.compareFunction = mu::toMTLCompareFunction(info.cmpFunc);
     }
+    if (CCMTLDevice::getInstance()->isArgumentBufferSupported()) {
+        if (@available(iOS 11.0, macOS 10.13, *)) {
+            descriptor.supportArgumentBuffers = YES;
+        }
+    }
 
     id<MTLDevice> mtlDevice = id<MTLDevice>(CCMTLDevice::getInstance()->getMTLDevice());
     _mtlSamplerState = [mtlDevice newSamplerStateWithDescriptor:descriptor];
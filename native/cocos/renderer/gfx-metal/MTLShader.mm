@@ -74,7 +74,13 @@ void CCMTLShader::doDestroy() {
     id<MTLFunction> cmptFunc = _cmptFunction;
     _cmptFunction      = nil;
     
+    ccstd::vector<id<MTLArgumentEncoder>> argumentEncoders;
     if(_gpuShader) {
+        for (const auto &argumentBuffer : _gpuShader->argumentBuffers) {
+            if (argumentBuffer.encoder) {
+                argumentEncoders.push_back(argumentBuffer.encoder);
+            }
+        }
         [_gpuShader->shaderSrc release];
         CC_SAFE_DELETE(_gpuShader);
     }
@@ -113,6 +119,10 @@ void CCMTLShader::doDestroy() {
         if(cmptLib) {
             [cmptLib release];
         }
+
+        for (id<MTLArgumentEncoder> encoder : argumentEncoders) {
+            [encoder release];
+        }
     };
     CCMTLGPUGarbageCollectionPool::getInstance()->collect(destroyFunc);
 }
@@ -204,6 +214,20 @@ bool CCMTLShader::createMTLFunction(const ShaderStage &stage) {
         return false;
     }
 
+    id<MTLFunction> function = isVertexShader ? _vertFunction : isFragmentShader ? _fragFunction : _cmptFunction;
+    for (auto &argumentBuffer : _gpuShader->argumentBuffers) {
+        if (argumentBuffer.stage != stage.stage) {
+            continue;
+        }
+        if (@available(iOS 11.0, macOS 10.13, *)) {
+            argumentBuffer.encoder = [function newArgumentEncoderWithBufferIndex:argumentBuffer.index];
+        }
+        if (!argumentBuffer.encoder) {
+            CC_LOG_ERROR("Can not create argument encoder of %s shader at buffer %d", shaderStage.c_str(), argumentBuffer.index);
+            return false;
+        }
+    }
+
 #ifdef DEBUG_SHADER
     if (isVertexShader) {
         _vertGlslShader = stage.source;
@@ -301,6 +325,16 @@ void CCMTLShader::setAvailableBufferBindingIndex() {
             usedFragmentBufferBindingIndexes |= 1 << block.second.mappedBinding;
         }
     }
+    for (const auto &argumentBuffer : _gpuShader->argumentBuffers) {
+        if (argumentBuffer.stage == ShaderStageFlagBit::VERTEX) {
+            vertexBindingCount++;
+            usedVertexBufferBindingIndexes |= 1 << argumentBuffer.index;
+        }
+        if (argumentBuffer.stage == ShaderStageFlagBit::FRAGMENT) {
+            fragmentBindingCount++;
+            usedFragmentBufferBindingIndexes |= 1 << argumentBuffer.index;
+        }
+    }
 
     auto maxBufferBindingIndex = CCMTLDevice::getInstance()->getMaximumBufferBindingIndex();
     _availableVertexBufferBindingIndex.resize(maxBufferBindingIndex - vertexBindingCount);
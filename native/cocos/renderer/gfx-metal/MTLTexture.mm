@@ -28,6 +28,7 @@
 #import "MTLTexture.h"
 #import "MTLUtils.h"
 #import "MTLSwapchain.h"
+#import "base/memory/MemoryAccounting.h"
 #import "profiler/Profiler.h"
 #include "base/Log.h"
 #import <CoreVideo/CVPixelBuffer.h>
@@ -106,6 +107,7 @@ void CCMTLTexture::doInit(const TextureInfo &info) {
     }
 
     CCMTLDevice::getInstance()->getMemoryStatus().textureSize += _size;
+    CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, _size);
     CC_PROFILE_MEMORY_INC(Texture, _size);
 }
 
@@ -184,7 +186,19 @@ bool CCMTLTexture::createMTLTexture() {
     descriptor.mipmapLevelCount = _info.levelCount;
     descriptor.arrayLength = _info.type == TextureType::CUBE ? 1 : _info.layerCount;
 
-    if(hasAllFlags(TextureUsage::COLOR_ATTACHMENT | TextureUsage::INPUT_ATTACHMENT, _info.usage) && mu::isImageBlockSupported()) {
+    if (hasFlag(_info.flags, TextureFlagBit::LAZILY_ALLOCATED) && mu::isImageBlockSupported()) {
+        // contents stay in tile memory, never sampled or copied
+#if MAC_MEMORY_LESS_TEXTURE_SUPPORT || CC_PLATFORM == CC_PLATFORM_MAC_IOS
+        if (@available(macOS 11.0, *)) {
+            descriptor.storageMode = MTLStorageModeMemoryless;
+            descriptor.usage       = MTLTextureUsageRenderTarget;
+        } else {
+            descriptor.storageMode = MTLStorageModePrivate;
+        }
+#else
+        descriptor.storageMode = MTLStorageModePrivate;
+#endif
+    } else if(hasAllFlags(TextureUsage::COLOR_ATTACHMENT | TextureUsage::INPUT_ATTACHMENT, _info.usage) && mu::isImageBlockSupported()) {
 #if MEMLESS_ON
         // mac SDK mem_less unavailable before 11.0
 #if MAC_MEMORY_LESS_TEXTURE_SUPPORT || CC_PLATFORM == CC_PLATFORM_MAC_IOS
@@ -204,8 +218,16 @@ bool CCMTLTexture::createMTLTexture() {
         descriptor.storageMode = MTLStorageModePrivate;
     }
 
-    id<MTLDevice> mtlDevice = id<MTLDevice>(CCMTLDevice::getInstance()->getMTLDevice());
-    _mtlTexture = [mtlDevice newTextureWithDescriptor:descriptor];
+    // render targets are placed in heaps, memoryless ones need no memory at all
+    id<MTLTexture> mtlTexture = nil;
+    if (descriptor.storageMode == MTLStorageModePrivate) {
+        mtlTexture = CCMTLDevice::getInstance()->gpuTextureHeapPool()->alloc(descriptor);
+    }
+    if (!mtlTexture) {
+        id<MTLDevice> mtlDevice = id<MTLDevice>(CCMTLDevice::getInstance()->getMTLDevice());
+        mtlTexture = [mtlDevice newTextureWithDescriptor:descriptor];
+    }
+    _mtlTexture = mtlTexture;
 
     return _mtlTexture != nil;
 }
@@ -237,6 +259,7 @@ void CCMTLTexture::doDestroy() {
     }
 
     CCMTLDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
     CC_PROFILE_MEMORY_DEC(Texture, _size);
 
     std::function<void(void)> destroyFunc = [mtlTexure]() {
@@ -277,7 +300,9 @@ void CCMTLTexture::doResize(uint width, uint height, uint size) {
     // but the system so skip here.
     if(!_swapchain) {
         CCMTLDevice::getInstance()->getMemoryStatus().textureSize -= oldSize;
+        CC_MEMORY_ACCOUNT_FREE(TEXTURE, oldSize);
         CCMTLDevice::getInstance()->getMemoryStatus().textureSize += size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, size);
         CC_PROFILE_MEMORY_DEC(Texture, oldSize);
         CC_PROFILE_MEMORY_INC(Texture, size);
     }
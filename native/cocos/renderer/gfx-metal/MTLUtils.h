@@ -100,6 +100,7 @@ bool                   isIndirectCommandBufferSupported(MTLFeatureSet featureSet
 bool                   isDepthStencilFormatSupported(id<MTLDevice> device, Format format, uint family);
 MTLPixelFormat         getSupportedDepthStencilFormat(id<MTLDevice> device, uint family, uint &depthBits);
 bool                   isIndirectDrawSupported(uint family);
+bool                   isArgumentBuffersTier2Supported(id<MTLDevice> device);
 bool                   isImageBlockSupported();
 bool                   isFramebufferFetchSupported();
 ccstd::string          featureSetToString(MTLFeatureSet featureSet);
@@ -112,6 +113,8 @@ void                   clearRenderArea(CCMTLDevice *device, id<MTLRenderCommandE
 inline uint            alignUp(uint inSize, uint align) { return ((inSize + align - 1) / align) * align; }
 void                   clearUtilResource();
 inline uint            roundUp(uint dividend, uint divisor) { return (dividend - 1) / divisor + 1; }
+// [[id(n)]] of a descriptor inside its argument buffer, array elements take consecutive ids
+inline uint getArgumentBufferID(uint binding, uint element, bool isSampler) { return binding * 512 + (isSampler ? 256 : 0) + element; }
 } // namespace mu
 
 } // namespace gfx
@@ -25,6 +25,8 @@
 
 #include "MTLUtils.h"
 
+#include <algorithm>
+#include <atomic>
 #include "MTLDevice.h"
 #include "MTLGPUObjects.h"
 #include "MTLPipelineState.h"
@@ -944,6 +946,38 @@ ccstd::string mu::spirv2MSL(const uint32_t *ir, size_t word_count,
     spirv_cross::ShaderResources resources = msl.get_shader_resources(active);
     msl.set_enabled_interface_variables(std::move(active));
 
+    // ARGUMENT_BUFFER_SET goes through an argument buffer if the stage reads only uniform blocks and sampler textures from it,
+    // so does BINDLESS_ARGUMENT_BUFFER_SET if the stage samples an array from it too large for the sampler argument table
+    const bool argumentBufferSupported = device->isArgumentBufferSupported() && executionModel != spv::ExecutionModelGLCompute;
+    const auto readsOnlyBlocksAndSamplers = [&msl, &resources](uint32_t set) {
+        const auto isInSet = [&msl, set](const spirv_cross::Resource &resource) {
+            return msl.get_decoration(resource.id, spv::DecorationDescriptorSet) == set;
+        };
+        for (const auto *list : {&resources.storage_buffers, &resources.storage_images, &resources.separate_images,
+                                 &resources.separate_samplers, &resources.subpass_inputs}) {
+            if (std::any_of(list->begin(), list->end(), isInSet)) return false;
+        }
+        return true;
+    };
+    const auto hasBindlessArray = std::any_of(resources.sampled_images.begin(), resources.sampled_images.end(), [&](const spirv_cross::Resource &sampler) {
+        const spirv_cross::SPIRType &type = msl.get_type(sampler.type_id);
+        return msl.get_decoration(sampler.id, spv::DecorationDescriptorSet) == BINDLESS_ARGUMENT_BUFFER_SET &&
+               !type.array.empty() && type.array_size_literal[0] && type.array[0] > device->getMaximumSamplerUnits();
+    });
+    ccstd::vector<CCMTLGPUArgumentBuffer> argumentBuffers;
+    if (argumentBufferSupported && readsOnlyBlocksAndSamplers(ARGUMENT_BUFFER_SET)) {
+        argumentBuffers.emplace_back().set = ARGUMENT_BUFFER_SET;
+    }
+    if (argumentBufferSupported && hasBindlessArray && readsOnlyBlocksAndSamplers(BINDLESS_ARGUMENT_BUFFER_SET)) {
+        argumentBuffers.emplace_back().set = BINDLESS_ARGUMENT_BUFFER_SET;
+    }
+    const auto findArgumentBuffer = [&argumentBuffers](uint32_t set) -> CCMTLGPUArgumentBuffer * {
+        for (auto &argumentBuffer : argumentBuffers) {
+            if (argumentBuffer.set == set) return &argumentBuffer;
+        }
+        return nullptr;
+    };
+
     // Set some options.
     spirv_cross::CompilerMSL::Options options;
     options.enable_decoration_binding = true;
@@ -960,6 +994,17 @@ ccstd::string mu::spirv2MSL(const uint32_t *ir, size_t word_count,
         options.set_msl_version(2, 3, 0);
 #endif
     }
+    if (!argumentBuffers.empty()) {
+        options.argument_buffers = true;
+        if (!options.supports_msl_version(2)) {
+            options.set_msl_version(2);
+        }
+        for (uint32_t set = 0; set < spirv_cross::kMaxArgumentBuffers; ++set) {
+            if (!findArgumentBuffer(set)) {
+                msl.add_discrete_descriptor_set(set);
+            }
+        }
+    }
     msl.set_msl_options(options);
 
     // TODO: bindings from shader just kind of validation, cannot be directly input
@@ -970,6 +1015,15 @@ ccstd::string mu::spirv2MSL(const uint32_t *ir, size_t word_count,
         auto binding = msl.get_decoration(ubo.id, spv::DecorationBinding);
         auto size = msl.get_declared_struct_size(msl.get_type(ubo.base_type_id));
 
+        if (auto *argumentBuffer = findArgumentBuffer(set)) {
+            newBinding.desc_set = set;
+            newBinding.binding = binding;
+            newBinding.msl_buffer = getArgumentBufferID(binding, 0, false);
+            msl.add_msl_resource_binding(newBinding);
+            argumentBuffer->arguments.push_back({binding, 1, true});
+            continue;
+        }
+
         if (binding >= maxBufferBindingIndex) {
             CC_LOG_ERROR("Implementation limits: %s binding at %d, should not use more than %d entries in the buffer argument table", ubo.name.c_str(), binding, maxBufferBindingIndex);
         }
@@ -1040,6 +1094,17 @@ ccstd::string mu::spirv2MSL(const uint32_t *ir, size_t word_count,
             size = type.array[0];
         }
 
+        if (auto *argumentBuffer = findArgumentBuffer(set)) {
+            // array elements take the consecutive ids
+            newBinding.desc_set = set;
+            newBinding.binding = binding;
+            newBinding.msl_texture = getArgumentBufferID(binding, 0, false);
+            newBinding.msl_sampler = getArgumentBufferID(binding, 0, true);
+            msl.add_msl_resource_binding(newBinding);
+            argumentBuffer->arguments.push_back({binding, static_cast<uint>(size), false});
+            continue;
+        }
+
         for (int i = 0; i < size; ++i) {
             auto mappedBinding = gpuShader->samplerIndex + rtOffsets;
             newBinding.desc_set = set;
@@ -1057,6 +1122,20 @@ ccstd::string mu::spirv2MSL(const uint32_t *ir, size_t word_count,
         }
     }
 
+    static std::atomic<uint> argumentBufferID{0};
+    for (auto &argumentBuffer : argumentBuffers) {
+        if (argumentBuffer.arguments.empty()) continue;
+        argumentBuffer.id = ++argumentBufferID;
+        argumentBuffer.stage = shaderType;
+        argumentBuffer.index = gpuShader->bufferIndex++;
+
+        newBinding.desc_set = argumentBuffer.set;
+        newBinding.binding = spirv_cross::kArgumentBufferBinding;
+        newBinding.msl_buffer = argumentBuffer.index;
+        msl.add_msl_resource_binding(newBinding);
+        gpuShader->argumentBuffers.push_back(std::move(argumentBuffer));
+    }
+
     if(executionModel == spv::ExecutionModelFragment) {
         gpuShader->outputs.resize(resources.stage_outputs.size());
         for(size_t i = 0; i < resources.stage_outputs.size(); i++) {
@@ -1536,6 +1615,13 @@ bool mu::isIndirectDrawSupported(uint family) {
 #endif
 }
 
+bool mu::isArgumentBuffersTier2Supported(id<MTLDevice> device) {
+    if (@available(iOS 11.0, macOS 10.13, *)) {
+        return device.argumentBuffersSupport >= MTLArgumentBuffersTier2;
+    }
+    return false;
+}
+
 MTLPixelFormat mu::getSupportedDepthStencilFormat(id<MTLDevice> device, uint family, uint &depthBits) {
 #if CC_PLATFORM == CC_PLATFORM_MAC_OSX
     return MTLPixelFormatDepth24Unorm_Stencil8;
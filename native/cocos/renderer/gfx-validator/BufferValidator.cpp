@@ -43,7 +43,8 @@ BufferValidator::~BufferValidator() {
 
     uint64_t lifeTime = DeviceValidator::getInstance()->currentFrame() - _creationFrame;
     // skip those that have never been updated
-    if (!_isBufferView && hasFlag(_memUsage, MemoryUsageBit::HOST) && _totalUpdateTimes && _totalUpdateTimes < lifeTime / 3) {
+    if (!_isBufferView && hasFlag(_memUsage, MemoryUsageBit::HOST) && _totalUpdateTimes && _totalUpdateTimes < lifeTime / 3 &&
+        DeviceValidator::getInstance()->isValidating()) {
         CC_LOG_WARNING("Triple buffer enabled for infrequently-updated buffer, consider using MemoryUsageBit::DEVICE instead");
         CC_LOG_DEBUG("Init Stacktrace: %s", _initStack.c_str());
     }
@@ -53,17 +54,20 @@ void BufferValidator::doInit(const BufferInfo &info) {
     CCASSERT(!isInited(), "initializing twice?");
     _inited = true;
 
-    CCASSERT(info.usage != BufferUsageBit::NONE, "invalid buffer param");
-    CCASSERT(info.memUsage != MemoryUsageBit::NONE, "invalid buffer param");
-    CCASSERT(info.size, "zero-sized buffer?");
-    CCASSERT(info.size / info.stride * info.stride == info.size, "size is not multiple of stride?");
+    CC_VALIDATE(info.usage != BufferUsageBit::NONE, "invalid buffer param");
+    CC_VALIDATE(info.memUsage != MemoryUsageBit::NONE, "invalid buffer param");
+    CC_VALIDATE(info.size, "zero-sized buffer?");
+    CC_VALIDATE(info.size / info.stride * info.stride == info.size, "size is not multiple of stride?");
 
-    _initStack        = utils::getStacktraceJS();
+    // capturing stacktraces is expensive
+    if (DeviceValidator::getInstance()->isValidating()) {
+        _initStack = utils::getStacktraceJS();
+    }
     _creationFrame    = DeviceValidator::getInstance()->currentFrame();
     _totalUpdateTimes = 0U;
 
     if (hasFlag(info.usage, BufferUsageBit::VERTEX) && !info.stride) {
-        CCASSERT(false, "invalid stride for vertex buffer");
+        CC_VALIDATE(false, "invalid stride for vertex buffer");
     }
 
     /////////// execute ///////////
@@ -76,11 +80,11 @@ void BufferValidator::doInit(const BufferViewInfo &info) {
     _inited = true;
 
     CCASSERT(info.buffer && static_cast<BufferValidator *>(info.buffer)->isInited(), "already destroyed?");
-    CCASSERT(info.offset + info.range <= info.buffer->getSize(), "invalid range");
-    CCASSERT(info.range, "zero-sized buffer?");
+    CC_VALIDATE(info.offset + info.range <= info.buffer->getSize(), "invalid range");
+    CC_VALIDATE(info.range, "zero-sized buffer?");
 
     uint32_t stride = info.buffer->getStride();
-    CCASSERT(info.offset / stride * stride == info.offset, "offset is not multiple of stride?");
+    CC_VALIDATE(info.offset / stride * stride == info.offset, "offset is not multiple of stride?");
 
     /////////// execute ///////////
 
@@ -93,8 +97,8 @@ void BufferValidator::doInit(const BufferViewInfo &info) {
 void BufferValidator::doResize(uint32_t size, uint32_t /*count*/) {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(!_isBufferView, "cannot resize through buffer views");
-    CCASSERT(size, "invalid size");
+    CC_VALIDATE(!_isBufferView, "cannot resize through buffer views");
+    CC_VALIDATE(size, "invalid size");
 
     /////////// execute ///////////
 
@@ -113,11 +117,11 @@ void BufferValidator::doDestroy() {
 void BufferValidator::update(const void *buffer, uint32_t size) {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(!_isBufferView, "cannot update through buffer views");
-    CCASSERT(size && size <= _size, "invalid size");
-    CCASSERT(buffer, "invalid buffer data");
+    CC_VALIDATE(!_isBufferView, "cannot update through buffer views");
+    CC_VALIDATE(size && size <= _size, "invalid size");
+    CC_VALIDATE(buffer, "invalid buffer data");
 
-    if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
+    if (hasFlag(_usage, BufferUsageBit::INDIRECT) && DeviceValidator::getInstance()->isValidating()) {
         const auto * drawInfo      = static_cast<const DrawInfo *>(buffer);
         const size_t drawInfoCount = size / sizeof(DrawInfo);
         const bool   isIndexed     = drawInfoCount > 0 && drawInfo->indexCount > 0;
@@ -92,8 +92,8 @@ void CommandBufferValidator::begin(RenderPass *renderPass, uint32_t subpass, Fra
     CCASSERT(!renderPass || static_cast<RenderPassValidator *>(renderPass)->isInited(), "already destroyed?");
     CCASSERT(!framebuffer || static_cast<FramebufferValidator *>(framebuffer)->isInited(), "already destroyed?");
 
-    CCASSERT(!_insideRenderPass, "Already inside a render pass?");
-    CCASSERT(_type != CommandBufferType::PRIMARY || !renderPass, "Primary command buffer cannot inherit render passes");
+    CC_VALIDATE(!_insideRenderPass, "Already inside a render pass?");
+    CC_VALIDATE(_type != CommandBufferType::PRIMARY || !renderPass, "Primary command buffer cannot inherit render passes");
 
     // secondary command buffers enter the render pass right here
     _insideRenderPass = !!renderPass;
@@ -113,7 +113,7 @@ void CommandBufferValidator::begin(RenderPass *renderPass, uint32_t subpass, Fra
 void CommandBufferValidator::end() {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(_type != CommandBufferType::PRIMARY || !_insideRenderPass, "Still inside a render pass?");
+    CC_VALIDATE(_type != CommandBufferType::PRIMARY || !_insideRenderPass, "Still inside a render pass?");
     _insideRenderPass = false;
 
     /////////// execute ///////////
@@ -126,16 +126,18 @@ void CommandBufferValidator::beginRenderPass(RenderPass *renderPass, Framebuffer
     CCASSERT(renderPass && static_cast<RenderPassValidator *>(renderPass)->isInited(), "already destroyed?");
     CCASSERT(fbo && static_cast<FramebufferValidator *>(fbo)->isInited(), "already destroyed?");
 
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Already inside a render pass?");
+    CC_VALIDATE(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
+    CC_VALIDATE(!_insideRenderPass, "Already inside a render pass?");
 
-    for (size_t i = 0; i < renderPass->getColorAttachments().size(); ++i) {
-        const auto &desc = renderPass->getColorAttachments()[i];
-        const auto *tex  = fbo->getColorTextures()[i];
-        CCASSERT(tex->getFormat() == desc.format, "attachment format mismatch");
-    }
-    if (fbo->getDepthStencilTexture()) {
-        CCASSERT(fbo->getDepthStencilTexture()->getFormat() == renderPass->getDepthStencilAttachment().format, "attachment format mismatch");
+    if (DeviceValidator::getInstance()->isValidating()) {
+        for (size_t i = 0; i < renderPass->getColorAttachments().size(); ++i) {
+            const auto &desc = renderPass->getColorAttachments()[i];
+            const auto *tex  = fbo->getColorTextures()[i];
+            CCASSERT(tex->getFormat() == desc.format, "attachment format mismatch");
+        }
+        if (fbo->getDepthStencilTexture()) {
+            CCASSERT(fbo->getDepthStencilTexture()->getFormat() == renderPass->getDepthStencilAttachment().format, "attachment format mismatch");
+        }
     }
 
     _insideRenderPass = true;
@@ -187,8 +189,8 @@ void CommandBufferValidator::nextSubpass() {
 void CommandBufferValidator::endRenderPass() {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
-    CCASSERT(_insideRenderPass, "No render pass to end?");
+    CC_VALIDATE(_type == CommandBufferType::PRIMARY, "Command 'endRenderPass' must be recorded in primary command buffers.");
+    CC_VALIDATE(_insideRenderPass, "No render pass to end?");
     _insideRenderPass = false;
 
     if (DeviceValidator::getInstance()->isRecording()) {
@@ -204,7 +206,7 @@ void CommandBufferValidator::execute(CommandBuffer *const *cmdBuffs, uint32_t co
     CCASSERT(isInited(), "alread destroyed?");
 
     if (!count) return; // be more lenient on this for now
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'execute' must be recorded in primary command buffers.");
+    CC_VALIDATE(_type == CommandBufferType::PRIMARY, "Command 'execute' must be recorded in primary command buffers.");
 
     for (uint32_t i = 0U; i < count; ++i) {
         CCASSERT(cmdBuffs[i] && static_cast<CommandBufferValidator *>(cmdBuffs[i])->isInited(), "already destroyed?");
@@ -237,7 +239,7 @@ void CommandBufferValidator::bindDescriptorSet(uint32_t set, DescriptorSet *desc
     CCASSERT(isInited(), "alread destroyed?");
     CCASSERT(descriptorSet && static_cast<DescriptorSetValidator *>(descriptorSet)->isInited(), "already destroyed?");
 
-    CCASSERT(set < DeviceValidator::getInstance()->bindingMappingInfo().setIndices.size(), "invalid set index");
+    CC_VALIDATE(set < DeviceValidator::getInstance()->bindingMappingInfo().setIndices.size(), "invalid set index");
     //CCASSERT(descriptorSet->getLayout()->getDynamicBindings().size() == dynamicOffsetCount, "wrong number of dynamic offsets"); // be more lenient on this
 
     _curStates.descriptorSets[set] = descriptorSet;
@@ -357,18 +359,20 @@ void CommandBufferValidator::setStencilCompareMask(StencilFace face, uint32_t re
 void CommandBufferValidator::draw(const DrawInfo &info) {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(_insideRenderPass, "Command 'draw' must be recorded inside render passes.");
+    CC_VALIDATE(_insideRenderPass, "Command 'draw' must be recorded inside render passes.");
 
     if (DeviceValidator::getInstance()->isRecording()) {
         _recorder.recordDrawcall(_curStates);
     }
 
-    const auto &psoLayouts = _curStates.pipelineState->getPipelineLayout()->getSetLayouts();
-    for (size_t i = 0; i < psoLayouts.size(); ++i) {
-        if (!_curStates.descriptorSets[i]) continue; // there may be inactive sets
-        const auto &dsBindings  = _curStates.descriptorSets[i]->getLayout()->getBindings();
-        const auto &psoBindings = psoLayouts[i]->getBindings();
-        CCASSERT(psoBindings.size() == dsBindings.size(), "Descriptor set layout mismatch");
+    if (DeviceValidator::getInstance()->isValidating()) {
+        const auto &psoLayouts = _curStates.pipelineState->getPipelineLayout()->getSetLayouts();
+        for (size_t i = 0; i < psoLayouts.size(); ++i) {
+            if (!_curStates.descriptorSets[i]) continue; // there may be inactive sets
+            const auto &dsBindings  = _curStates.descriptorSets[i]->getLayout()->getBindings();
+            const auto &psoBindings = psoLayouts[i]->getBindings();
+            CCASSERT(psoBindings.size() == dsBindings.size(), "Descriptor set layout mismatch");
+        }
     }
 
     /////////// execute ///////////
@@ -376,12 +380,33 @@ void CommandBufferValidator::draw(const DrawInfo &info) {
     _actor->draw(info);
 }
 
+void CommandBufferValidator::drawIndirect(const DrawIndirectInfo &info) {
+    CCASSERT(isInited(), "alread destroyed?");
+    CCASSERT(info.buffer && static_cast<BufferValidator *>(info.buffer)->isInited(), "already destroyed?");
+
+    CC_VALIDATE(_insideRenderPass, "Command 'drawIndirect' must be recorded inside render passes.");
+    CC_VALIDATE(hasFlag(info.buffer->getUsage(), BufferUsageBit::INDIRECT), "Indirect draws must read from indirect buffers.");
+    CC_VALIDATE(!info.countBuffer || DeviceValidator::getInstance()->hasFeature(Feature::DRAW_INDIRECT_COUNT), "Indirect draw counts are not supported.");
+
+    if (DeviceValidator::getInstance()->isRecording()) {
+        _recorder.recordDrawcall(_curStates);
+    }
+
+    /////////// execute ///////////
+
+    DrawIndirectInfo actorInfo = info;
+    actorInfo.buffer           = static_cast<BufferValidator *>(info.buffer)->getActor();
+    if (info.countBuffer) actorInfo.countBuffer = static_cast<BufferValidator *>(info.countBuffer)->getActor();
+
+    _actor->drawIndirect(actorInfo);
+}
+
 void CommandBufferValidator::updateBuffer(Buffer *buff, const void *data, uint32_t size) {
     CCASSERT(isInited(), "alread destroyed?");
     CCASSERT(buff && static_cast<BufferValidator *>(buff)->isInited(), "already destroyed?");
 
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'updateBuffer' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Command 'updateBuffer' must be recorded outside render passes.");
+    CC_VALIDATE(_type == CommandBufferType::PRIMARY, "Command 'updateBuffer' must be recorded in primary command buffers.");
+    CC_VALIDATE(!_insideRenderPass, "Command 'updateBuffer' must be recorded outside render passes.");
 
     auto *bufferValidator = static_cast<BufferValidator *>(buff);
     bufferValidator->sanityCheck(data, size);
@@ -395,8 +420,8 @@ void CommandBufferValidator::copyBuffersToTexture(const uint8_t *const *buffers,
     CCASSERT(isInited(), "alread destroyed?");
     CCASSERT(texture && static_cast<TextureValidator *>(texture)->isInited(), "already destroyed?");
 
-    CCASSERT(_type == CommandBufferType::PRIMARY, "Command 'copyBuffersToTexture' must be recorded in primary command buffers.");
-    CCASSERT(!_insideRenderPass, "Command 'copyBuffersToTexture' must be recorded outside render passes.");
+    CC_VALIDATE(_type == CommandBufferType::PRIMARY, "Command 'copyBuffersToTexture' must be recorded in primary command buffers.");
+    CC_VALIDATE(!_insideRenderPass, "Command 'copyBuffersToTexture' must be recorded outside render passes.");
 
     auto *textureValidator = static_cast<TextureValidator *>(texture);
     textureValidator->sanityCheck();
@@ -411,20 +436,20 @@ void CommandBufferValidator::blitTexture(Texture *srcTexture, Texture *dstTextur
     CCASSERT(srcTexture && static_cast<TextureValidator *>(srcTexture)->isInited(), "already destroyed?");
     CCASSERT(dstTexture && static_cast<TextureValidator *>(dstTexture)->isInited(), "already destroyed?");
 
-    CCASSERT(srcTexture->getInfo().samples == SampleCount::ONE, "blit on multisampled texture is not allowed");
-    CCASSERT(dstTexture->getInfo().samples == SampleCount::ONE, "blit on multisampled texture is not allowed");
+    CC_VALIDATE(srcTexture->getInfo().samples == SampleCount::ONE, "blit on multisampled texture is not allowed");
+    CC_VALIDATE(dstTexture->getInfo().samples == SampleCount::ONE, "blit on multisampled texture is not allowed");
 
-    CCASSERT(!_insideRenderPass, "Command 'blitTexture' must be recorded outside render passes.");
+    CC_VALIDATE(!_insideRenderPass, "Command 'blitTexture' must be recorded outside render passes.");
 
     for (uint32_t i = 0; i < count; ++i) {
         const auto &region = regions[i];
-        CCASSERT(region.srcOffset.x + region.srcExtent.width <= srcTexture->getInfo().width, "Invalid src region");
-        CCASSERT(region.srcOffset.y + region.srcExtent.height <= srcTexture->getInfo().height, "Invalid src region");
-        CCASSERT(region.srcOffset.z + region.srcExtent.depth <= srcTexture->getInfo().depth, "Invalid src region");
+        CC_VALIDATE(region.srcOffset.x + region.srcExtent.width <= srcTexture->getInfo().width, "Invalid src region");
+        CC_VALIDATE(region.srcOffset.y + region.srcExtent.height <= srcTexture->getInfo().height, "Invalid src region");
+        CC_VALIDATE(region.srcOffset.z + region.srcExtent.depth <= srcTexture->getInfo().depth, "Invalid src region");
 
-        CCASSERT(region.dstOffset.x + region.dstExtent.width <= dstTexture->getInfo().width, "Invalid dst region");
-        CCASSERT(region.dstOffset.y + region.dstExtent.height <= dstTexture->getInfo().height, "Invalid dst region");
-        CCASSERT(region.dstOffset.z + region.dstExtent.depth <= dstTexture->getInfo().depth, "Invalid dst region");
+        CC_VALIDATE(region.dstOffset.x + region.dstExtent.width <= dstTexture->getInfo().width, "Invalid dst region");
+        CC_VALIDATE(region.dstOffset.y + region.dstExtent.height <= dstTexture->getInfo().height, "Invalid dst region");
+        CC_VALIDATE(region.dstOffset.z + region.dstExtent.depth <= dstTexture->getInfo().depth, "Invalid dst region");
     }
 
     /////////// execute ///////////
@@ -440,7 +465,7 @@ void CommandBufferValidator::blitTexture(Texture *srcTexture, Texture *dstTextur
 void CommandBufferValidator::dispatch(const DispatchInfo &info) {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(!_insideRenderPass, "Command 'dispatch' must be recorded outside render passes.");
+    CC_VALIDATE(!_insideRenderPass, "Command 'dispatch' must be recorded outside render passes.");
 
     /////////// execute ///////////
 
@@ -505,5 +530,14 @@ void CommandBufferValidator::completeQueryPool(QueryPool *queryPool) {
     _actor->completeQueryPool(actorQueryPool);
 }
 
+void CommandBufferValidator::writeTimestamp(QueryPool *queryPool, uint32_t id) {
+    CCASSERT(isInited(), "already destroyed?");
+    CCASSERT(static_cast<QueryPoolValidator *>(queryPool)->isInited(), "already destroyed?");
+    CC_VALIDATE(queryPool->getType() == QueryType::TIMESTAMP, "timestamps can only be written to timestamp query pools");
+
+    QueryPool *actorQueryPool = static_cast<QueryPoolValidator *>(queryPool)->getActor();
+    _actor->writeTimestamp(actorQueryPool, id);
+}
+
 } // namespace gfx
 } // namespace cc
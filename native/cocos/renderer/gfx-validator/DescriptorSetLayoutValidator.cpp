@@ -68,13 +68,13 @@ void DescriptorSetLayoutValidator::doInit(const DescriptorSetLayoutInfo &info) {
     _typeCounts.resize(DESCRIPTOR_TYPE_ORDERS[utils::getBitPosition(toNumber(DescriptorType::INPUT_ATTACHMENT))] + 1);
     uint32_t lastType{0};
     for (const auto &binding : bindings) {
-        CCASSERT(binding.binding != INVALID_BINDING, "Invalid binding");
-        CCASSERT(binding.descriptorType != DescriptorType::UNKNOWN, "Invalid binding type");
-        CCASSERT(math::IsPowerOfTwo(toNumber(binding.descriptorType)), "Invalid binding type");
-        CCASSERT(binding.count, "Invalid binding count");
-        CCASSERT(binding.stageFlags != ShaderStageFlagBit::NONE, "Invalid binding stage flags");
+        CC_VALIDATE(binding.binding != INVALID_BINDING, "Invalid binding");
+        CC_VALIDATE(binding.descriptorType != DescriptorType::UNKNOWN, "Invalid binding type");
+        CC_VALIDATE(math::IsPowerOfTwo(toNumber(binding.descriptorType)), "Invalid binding type");
+        CC_VALIDATE(binding.count, "Invalid binding count");
+        CC_VALIDATE(binding.stageFlags != ShaderStageFlagBit::NONE, "Invalid binding stage flags");
         for (const Sampler *sampler : binding.immutableSamplers) {
-            CCASSERT(sampler, "Invalid immutable sampler");
+            CC_VALIDATE(sampler, "Invalid immutable sampler");
         }
         /**
          * Descriptors should be defined strictly in the following order,
@@ -88,7 +88,7 @@ void DescriptorSetLayoutValidator::doInit(const DescriptorSetLayoutInfo &info) {
          * * SubpassInput
          */
         uint32_t type{DESCRIPTOR_TYPE_ORDERS[utils::getBitPosition(toNumber(binding.descriptorType))]};
-        CCASSERT(lastType <= type, "Illegal binding order");
+        CC_VALIDATE(lastType <= type, "Illegal binding order");
         lastType = type;
         ++_typeCounts[type];
     }
@@ -77,7 +77,7 @@ void DescriptorSetValidator::update() {
     Sampler *sampler = nullptr;
     Format   format  = {};
 
-    for (size_t i = 0; i < descriptorCount; ++i) {
+    for (size_t i = 0; i < descriptorCount && DeviceValidator::getInstance()->isValidating(); ++i) {
         texture = _textures[i];
         sampler = _samplers[i];
         if (texture == nullptr || sampler == nullptr) continue;
@@ -92,8 +92,8 @@ void DescriptorSetValidator::update() {
         }
     }
 
-    CCASSERT(_referenceStamp < DeviceValidator::getInstance()->currentFrame(),
-             "DescriptorSet can not be updated after bound to CommandBuffer");
+    CC_VALIDATE(_referenceStamp < DeviceValidator::getInstance()->currentFrame(),
+                "DescriptorSet can not be updated after bound to CommandBuffer");
 
     /////////// execute ///////////
 
@@ -113,19 +113,19 @@ void DescriptorSetValidator::bindBuffer(uint32_t binding, Buffer *buffer, uint32
 
     const ccstd::vector<uint32_t> &       bindingIndices = _layout->getBindingIndices();
     const DescriptorSetLayoutBindingList &bindings       = _layout->getBindings();
-    CCASSERT(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
+    CC_VALIDATE(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
 
     const DescriptorSetLayoutBinding &info = bindings[bindingIndices[binding]];
-    CCASSERT(hasAnyFlags(info.descriptorType, DESCRIPTOR_BUFFER_TYPE), "Setting binding is not DESCRIPTOR_BUFFER_TYPE");
+    CC_VALIDATE(hasAnyFlags(info.descriptorType, DESCRIPTOR_BUFFER_TYPE), "Setting binding is not DESCRIPTOR_BUFFER_TYPE");
 
     if (hasAnyFlags(info.descriptorType, DESCRIPTOR_DYNAMIC_TYPE)) {
-        CCASSERT(buffer->isBufferView(), "Should bind buffer views for dynamic descriptors");
+        CC_VALIDATE(buffer->isBufferView(), "Should bind buffer views for dynamic descriptors");
     }
 
     if (hasAnyFlags(info.descriptorType, DescriptorType::UNIFORM_BUFFER | DescriptorType::DYNAMIC_UNIFORM_BUFFER)) {
-        CCASSERT(hasFlag(buffer->getUsage(), BufferUsageBit::UNIFORM), "Input is not a uniform buffer");
+        CC_VALIDATE(hasFlag(buffer->getUsage(), BufferUsageBit::UNIFORM), "Input is not a uniform buffer");
     } else if (hasAnyFlags(info.descriptorType, DescriptorType::STORAGE_BUFFER | DescriptorType::DYNAMIC_STORAGE_BUFFER)) {
-        CCASSERT(hasFlag(buffer->getUsage(), BufferUsageBit::STORAGE), "Input is not a storage buffer");
+        CC_VALIDATE(hasFlag(buffer->getUsage(), BufferUsageBit::STORAGE), "Input is not a storage buffer");
     }
 
     /////////// execute ///////////
@@ -141,17 +141,17 @@ void DescriptorSetValidator::bindTexture(uint32_t binding, Texture *texture, uin
 
     const ccstd::vector<uint32_t> &       bindingIndices = _layout->getBindingIndices();
     const DescriptorSetLayoutBindingList &bindings       = _layout->getBindings();
-    CCASSERT(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
+    CC_VALIDATE(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
 
     const DescriptorSetLayoutBinding &info = bindings[bindingIndices[binding]];
-    CCASSERT(hasAnyFlags(info.descriptorType, DESCRIPTOR_TEXTURE_TYPE), "Setting binding is not DESCRIPTOR_TEXTURE_TYPE");
+    CC_VALIDATE(hasAnyFlags(info.descriptorType, DESCRIPTOR_TEXTURE_TYPE), "Setting binding is not DESCRIPTOR_TEXTURE_TYPE");
 
     if (hasFlag(info.descriptorType, DescriptorType::INPUT_ATTACHMENT)) {
-        CCASSERT(hasFlag(texture->getInfo().usage, TextureUsageBit::INPUT_ATTACHMENT), "Input is not an input attachment");
+        CC_VALIDATE(hasFlag(texture->getInfo().usage, TextureUsageBit::INPUT_ATTACHMENT), "Input is not an input attachment");
     } else if (hasFlag(info.descriptorType, DescriptorType::STORAGE_IMAGE)) {
-        CCASSERT(hasFlag(texture->getInfo().usage, TextureUsageBit::STORAGE), "Input is not a storage image");
+        CC_VALIDATE(hasFlag(texture->getInfo().usage, TextureUsageBit::STORAGE), "Input is not a storage image");
     } else {
-        CCASSERT(hasFlag(texture->getInfo().usage, TextureUsageBit::SAMPLED), "Input is not a sampled texture");
+        CC_VALIDATE(hasFlag(texture->getInfo().usage, TextureUsageBit::SAMPLED), "Input is not a sampled texture");
     }
 
     /////////// execute ///////////
@@ -166,10 +166,10 @@ void DescriptorSetValidator::bindSampler(uint32_t binding, Sampler *sampler, uin
 
     const ccstd::vector<uint32_t> &       bindingIndices = _layout->getBindingIndices();
     const DescriptorSetLayoutBindingList &bindings       = _layout->getBindings();
-    CCASSERT(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
+    CC_VALIDATE(binding < bindingIndices.size() && bindingIndices[binding] < bindings.size(), "Illegal binding");
 
     const DescriptorSetLayoutBinding &info = bindings[bindingIndices[binding]];
-    CCASSERT(hasAnyFlags(info.descriptorType, DESCRIPTOR_TEXTURE_TYPE), "Setting binding is not DESCRIPTOR_TEXTURE_TYPE");
+    CC_VALIDATE(hasAnyFlags(info.descriptorType, DESCRIPTOR_TEXTURE_TYPE), "Setting binding is not DESCRIPTOR_TEXTURE_TYPE");
 
     /////////// execute ///////////
 
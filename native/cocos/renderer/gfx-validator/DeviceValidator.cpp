@@ -66,13 +66,13 @@ DeviceValidator::~DeviceValidator() {
 
 bool DeviceValidator::doInit(const DeviceInfo &info) {
     uint32_t flexibleSet{info.bindingMappingInfo.setIndices.back()};
-    CCASSERT(!info.bindingMappingInfo.maxBlockCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxSamplerTextureCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxSamplerCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxTextureCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxBufferCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxImageCounts[flexibleSet], "flexible set limits should be zero");
-    CCASSERT(!info.bindingMappingInfo.maxSubpassInputCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxBlockCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxSamplerTextureCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxSamplerCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxTextureCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxBufferCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxImageCounts[flexibleSet], "flexible set limits should be zero");
+    CC_VALIDATE(!info.bindingMappingInfo.maxSubpassInputCounts[flexibleSet], "flexible set limits should be zero");
 
     if (!_actor->initialize(info)) {
         return false;
@@ -157,6 +157,23 @@ void DeviceValidator::present() {
     _actor->present();
 
     ++_currentFrame;
+    updateValidating();
+}
+
+void DeviceValidator::setValidationMode(ValidationMode mode, uint32_t sampleInterval) {
+    CCASSERT(sampleInterval, "invalid sample interval");
+
+    _mode           = mode;
+    _sampleInterval = std::max(sampleInterval, 1U);
+    updateValidating();
+}
+
+void DeviceValidator::updateValidating() {
+    switch (_mode) {
+        case ValidationMode::FULL: _validating = true; break;
+        case ValidationMode::SAMPLED: _validating = _currentFrame % _sampleInterval == 0; break;
+        case ValidationMode::COUNTERS_ONLY: _validating = false; break;
+    }
 }
 
 CommandBuffer *DeviceValidator::createCommandBuffer(const CommandBufferInfo &info, bool hasAgent) {
@@ -258,7 +275,7 @@ PipelineState *DeviceValidator::createPipelineState() {
 }
 
 Sampler *DeviceValidator::getSampler(const SamplerInfo &info) {
-    if (info.addressU != info.addressV || info.addressV != info.addressW) {
+    if (_validating && (info.addressU != info.addressV || info.addressV != info.addressW)) {
         CC_LOG_WARNING("Samplers with different wrapping modes may case reduced performance");
     }
 
@@ -269,10 +286,10 @@ Sampler *DeviceValidator::getSampler(const SamplerInfo &info) {
 
 GeneralBarrier *DeviceValidator::getGeneralBarrier(const GeneralBarrierInfo &info) {
     if (info.prevAccesses > AccessFlagBit::PRESENT) {
-        CCASSERT(math::IsPowerOfTwo(toNumber(info.prevAccesses)), "Write access should appear on its own");
+        CC_VALIDATE(math::IsPowerOfTwo(toNumber(info.prevAccesses)), "Write access should appear on its own");
     }
     if (info.nextAccesses > AccessFlagBit::PRESENT) {
-        CCASSERT(math::IsPowerOfTwo(toNumber(info.nextAccesses)), "Write access should appear on its own");
+        CC_VALIDATE(math::IsPowerOfTwo(toNumber(info.nextAccesses)), "Write access should appear on its own");
     }
 
     /////////// execute ///////////
@@ -282,10 +299,10 @@ GeneralBarrier *DeviceValidator::getGeneralBarrier(const GeneralBarrierInfo &inf
 
 TextureBarrier *DeviceValidator::getTextureBarrier(const TextureBarrierInfo &info) {
     if (info.prevAccesses > AccessFlagBit::PRESENT) {
-        CCASSERT(math::IsPowerOfTwo(toNumber(info.prevAccesses)), "Write access should appear on its own");
+        CC_VALIDATE(math::IsPowerOfTwo(toNumber(info.prevAccesses)), "Write access should appear on its own");
     }
     if (info.nextAccesses > AccessFlagBit::PRESENT) {
-        CCASSERT(math::IsPowerOfTwo(toNumber(info.nextAccesses)), "Write access should appear on its own");
+        CC_VALIDATE(math::IsPowerOfTwo(toNumber(info.nextAccesses)), "Write access should appear on its own");
     }
 
     /////////// execute ///////////
@@ -310,6 +327,16 @@ void DeviceValidator::copyTextureToBuffers(Texture *src, uint8_t *const *buffers
     _actor->copyTextureToBuffers(textureValidator->getActor(), buffers, regions, count);
 }
 
+uint32_t DeviceValidator::requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    auto *textureValidator = static_cast<TextureValidator *>(src);
+    CCASSERT(count, "no region to read back");
+    textureValidator->sanityCheck();
+
+    /////////// execute ///////////
+
+    return _actor->requestTextureReadback(textureValidator->getActor(), regions, count);
+}
+
 void DeviceValidator::flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
 
@@ -31,6 +31,12 @@
 namespace cc {
 namespace gfx {
 
+enum class ValidationMode {
+    FULL,          // validate every call
+    SAMPLED,       // validate the calls within 1 of every N frames
+    COUNTERS_ONLY, // only track object lifetimes to detect leaks
+};
+
 class CC_DLL DeviceValidator final : public Agent<Device> {
 public:
     static DeviceValidator *getInstance();
@@ -82,16 +88,39 @@ public:
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
 
+    uint32_t requestTextureReadback(Texture *src, const BufferTextureCopy *regions, uint32_t count) override;
+    bool     isTextureReadbackReady(uint32_t handle) override { return _actor->isTextureReadbackReady(handle); }
+    bool     getTextureReadbackData(uint32_t handle, uint8_t *const *buffers) override { return _actor->getTextureReadbackData(handle, buffers); }
+    void     releaseTextureReadback(uint32_t handle) override { _actor->releaseTextureReadback(handle); }
+
     void          flushCommands(CommandBuffer *const *cmdBuffs, uint32_t count) override;
     MemoryStatus &getMemoryStatus() override { return _actor->getMemoryStatus(); }
     uint32_t      getNumDrawCalls() const override { return _actor->getNumDrawCalls(); }
     uint32_t      getNumInstances() const override { return _actor->getNumInstances(); }
     uint32_t      getNumTris() const override { return _actor->getNumTris(); }
+    uint32_t      getNumStateCalls() const override { return _actor->getNumStateCalls(); }
+    uint32_t      getNumSkippedStateCalls() const override { return _actor->getNumSkippedStateCalls(); }
+
+    PipelineCacheStatus &getPipelineCacheStatus() override { return _actor->getPipelineCacheStatus(); }
 
     inline void     enableRecording(bool recording) { _recording = recording; }
     inline bool     isRecording() const { return _recording; }
     inline uint64_t currentFrame() const { return _currentFrame; }
 
+    /**
+     * @en Reduce the validation overhead for long running tests, errors are reported the same way in all modes.
+     * In SAMPLED mode only the frames whose index is a multiple of sampleInterval are validated.
+     * Object lifetimes are tracked in all modes, COUNTERS_ONLY keeps a count per object type instead of a record per object.
+     * @zh 降低长时间运行测试中的验证开销，所有模式下错误的报告方式相同。
+     * SAMPLED 模式下只验证帧序号为 sampleInterval 倍数的帧。
+     * 所有模式都会追踪对象生命周期，COUNTERS_ONLY 模式下只按类型计数而不为每个对象保留记录。
+     */
+    void                  setValidationMode(ValidationMode mode, uint32_t sampleInterval = 1U);
+    inline ValidationMode getValidationMode() const { return _mode; }
+    inline uint32_t       getSampleInterval() const { return _sampleInterval; }
+    // whether the calls within the current frame are validated
+    inline bool isValidating() const { return _validating; }
+
 protected:
     static DeviceValidator *instance;
 
@@ -104,8 +133,13 @@ protected:
 
     void bindContext(bool bound) override { _actor->bindContext(bound); }
 
-    bool     _recording{false};
-    uint64_t _currentFrame{1U};
+    void updateValidating();
+
+    bool           _recording{false};
+    uint64_t       _currentFrame{1U};
+    ValidationMode _mode{ValidationMode::FULL};
+    uint32_t       _sampleInterval{1U};
+    bool           _validating{true};
 };
 
 } // namespace gfx
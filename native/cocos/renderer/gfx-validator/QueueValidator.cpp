@@ -66,7 +66,7 @@ void QueueValidator::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
     for (uint32_t i = 0U; i < count; ++i) {
         auto *cmdBuff = static_cast<CommandBufferValidator *>(cmdBuffs[i]);
         CCASSERT(cmdBuff && cmdBuff->isInited(), "alread destroyed?");
-        CCASSERT(cmdBuff->isCommandsFlushed(), "command buffers must be flushed before submit");
+        CC_VALIDATE(cmdBuff->isCommandsFlushed(), "command buffers must be flushed before submit");
     }
 
     /////////// execute ///////////
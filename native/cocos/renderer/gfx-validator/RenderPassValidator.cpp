@@ -49,18 +49,21 @@ void RenderPassValidator::doInit(const RenderPassInfo &info) {
     bool hasDepth = info.depthStencilAttachment.format != Format::UNKNOWN;
     if (!hasDepth) {
         for (const auto &subpass : info.subpasses) {
-            CCASSERT(subpass.depthStencil == INVALID_BINDING || subpass.depthStencil < info.colorAttachments.size(),
-                     "Invalid depth stencil attachment index");
+            CC_VALIDATE(subpass.depthStencil == INVALID_BINDING || subpass.depthStencil < info.colorAttachments.size(),
+                        "Invalid depth stencil attachment index");
         }
     }
 
+    CC_VALIDATE(info.viewCount > 0 && info.viewCount <= MAX_VIEW_COUNT, "Invalid view count");
+    CC_VALIDATE(info.viewCount == 1 || DeviceValidator::getInstance()->hasFeature(Feature::MULTIVIEW), "Multiview not supported");
+
     for (auto &attachment : _colorAttachments) {
         if (attachment.loadOp == LoadOp::LOAD && attachment.barrier->getInfo().prevAccesses == AccessFlagBit::NONE) {
-            CCASSERT(false, "Attachment missing beginAccesses for LoadOp::LOAD");
+            CC_VALIDATE(false, "Attachment missing beginAccesses for LoadOp::LOAD");
         }
     }
     if ((_depthStencilAttachment.depthLoadOp == LoadOp::LOAD || _depthStencilAttachment.stencilLoadOp == LoadOp::LOAD) && _depthStencilAttachment.barrier->getInfo().prevAccesses == AccessFlagBit::NONE) {
-        CCASSERT(false, "Attachment missing beginAccesses for LoadOp::LOAD");
+        CC_VALIDATE(false, "Attachment missing beginAccesses for LoadOp::LOAD");
     }
 
     /////////// execute ///////////
@@ -57,21 +57,21 @@ void TextureValidator::doInit(const TextureInfo &info) {
     CCASSERT(!isInited(), "initializing twice?");
     _inited = true;
 
-    CCASSERT(info.width && info.height && info.depth, "zero-sized texture?");
+    CC_VALIDATE(info.width && info.height && info.depth, "zero-sized texture?");
 
     FormatFeature ff = FormatFeature::NONE;
     if (hasAnyFlags(info.usage, TextureUsageBit::COLOR_ATTACHMENT | TextureUsageBit::DEPTH_STENCIL_ATTACHMENT)) ff |= FormatFeature::RENDER_TARGET;
     if (hasAnyFlags(info.usage, TextureUsageBit::SAMPLED)) ff |= FormatFeature::SAMPLED_TEXTURE;
     if (hasAnyFlags(info.usage, TextureUsageBit::STORAGE)) ff |= FormatFeature::STORAGE_TEXTURE;
     if (ff != FormatFeature::NONE) {
-        CCASSERT(hasAllFlags(DeviceValidator::getInstance()->getFormatFeatures(info.format), ff), "Format not supported for the specified features");
+        CC_VALIDATE(hasAllFlags(DeviceValidator::getInstance()->getFormatFeatures(info.format), ff), "Format not supported for the specified features");
     }
 
     if (hasFlag(info.flags, TextureFlagBit::GEN_MIPMAP)) {
-        CCASSERT(info.levelCount > 1, "Generating mipmaps with level count 1?");
+        CC_VALIDATE(info.levelCount > 1, "Generating mipmaps with level count 1?");
 
         bool isCompressed = GFX_FORMAT_INFOS[static_cast<int>(info.format)].isCompressed;
-        CCASSERT(!isCompressed, "Generating mipmaps for compressed image?");
+        CC_VALIDATE(!isCompressed, "Generating mipmaps for compressed image?");
     }
 
     /////////// execute ///////////
@@ -114,7 +114,7 @@ void TextureValidator::doDestroy() {
 void TextureValidator::doResize(uint32_t width, uint32_t height, uint32_t /*size*/) {
     CCASSERT(isInited(), "alread destroyed?");
 
-    CCASSERT(!_isTextureView, "Cannot resize texture views");
+    CC_VALIDATE(!_isTextureView, "Cannot resize texture views");
 
     /////////// execute ///////////
 
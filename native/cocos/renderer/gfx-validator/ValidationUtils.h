@@ -26,10 +26,14 @@
 #pragma once
 
 #include <algorithm>
+#include "DeviceValidator.h"
 #include "base/Utils.h"
 #include "base/std/container/array.h"
 #include "gfx-base/GFXDef.h"
 
+// checks skipped within the frames not validated, see DeviceValidator::setValidationMode
+#define CC_VALIDATE(cond, msg) CCASSERT(!cc::gfx::DeviceValidator::getInstance()->isValidating() || (cond), msg)
+
 namespace cc {
 
 namespace utils {
@@ -135,32 +139,48 @@ private:
         ccstd::string initStack;
     };
 
+    // records are skipped in ValidationMode::COUNTERS_ONLY, the count is always exact
+    static bool shouldRecord() { return DeviceValidator::getInstance()->getValidationMode() != ValidationMode::COUNTERS_ONLY; }
+
     static ccstd::vector<ResourceRecord> resources;
+    static uint32_t                      count;
 };
 
 template <typename Resource, typename Enable>
 ccstd::vector<typename DeviceResourceTracker<Resource, Enable>::ResourceRecord> DeviceResourceTracker<Resource, Enable>::resources;
 
+template <typename Resource, typename Enable>
+uint32_t DeviceResourceTracker<Resource, Enable>::count{0U};
+
 template <typename Resource, typename Enable>
 template <typename T, typename EnableFn>
 std::enable_if_t<RecordStacktrace<T>::value, void>
 DeviceResourceTracker<Resource, Enable>::push(T *resource) {
-    resources.emplace_back(ResourceRecord{resource, utils::getStacktrace(6, 10)});
+    ++count;
+    if (shouldRecord()) {
+        resources.emplace_back(ResourceRecord{resource, utils::getStacktrace(6, 10)});
+    }
 }
 
 template <typename Resource, typename Enable>
 template <typename T, typename EnableFn>
 std::enable_if_t<!RecordStacktrace<T>::value, void>
 DeviceResourceTracker<Resource, Enable>::push(T *resource) {
-    resources.emplace_back(ResourceRecord{resource, {}});
+    ++count;
+    if (shouldRecord()) {
+        resources.emplace_back(ResourceRecord{resource, {}});
+    }
 }
 
 template <typename Resource, typename Enable>
 void DeviceResourceTracker<Resource, Enable>::erase(Resource *resource) {
-    CCASSERT(!resources.empty(), "Deleted twice?");
+    CCASSERT(count, "Deleted twice?");
+    --count;
 
+    // resources created in ValidationMode::COUNTERS_ONLY have no record
     resources.erase(std::remove_if(resources.begin(), resources.end(),
-                                   [resource](const auto &record) { return record.resource == resource; }));
+                                   [resource](const auto &record) { return record.resource == resource; }),
+                    resources.end());
 }
 
 template <typename Resource, typename Enable>
@@ -170,7 +190,7 @@ void DeviceResourceTracker<Resource, Enable>::checkEmpty() {
     // and look up the resource initialization stacktrace in `resources[i].initStack`.
     // Note: capturing stacktrace is a painfully time-consuming process,
     // so better to uncomment the exact type of resource that is leaking rather than toggle them all at once.
-    CCASSERT(resources.empty(), "Resource leaked");
+    CCASSERT(!count, "Resource leaked");
 }
 
 //template <> struct RecordStacktrace<CommandBuffer> : std::true_type {};
@@ -27,6 +27,7 @@
 #include "VKCommandBuffer.h"
 #include "VKCommands.h"
 #include "VKDevice.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -55,7 +56,9 @@ void CCVKBuffer::doInit(const BufferInfo & /*info*/) {
     }
 
     cmdFuncCCVKCreateBuffer(CCVKDevice::getInstance(), _gpuBuffer);
+    CCVKDevice::getInstance()->gpuMemoryHub()->add(_gpuBuffer);
     CCVKDevice::getInstance()->getMemoryStatus().bufferSize += _size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, _size);
     CC_PROFILE_MEMORY_INC(Buffer, _size);
 
     _gpuBufferView = CC_NEW(CCVKGPUBufferView);
@@ -88,10 +91,13 @@ void CCVKBuffer::doDestroy() {
     if (_gpuBuffer) {
         if (!_isBufferView) {
             CCVKDevice::getInstance()->gpuBufferHub()->erase(_gpuBuffer);
+            CCVKDevice::getInstance()->gpuMemoryHub()->erase(_gpuBuffer);
+            CCVKDevice::getInstance()->gpuAsyncTransferHub()->cancel(_gpuBuffer);
             CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuBuffer);
             CCVKDevice::getInstance()->gpuBarrierManager()->cancel(_gpuBuffer);
             CC_DELETE(_gpuBuffer);
             CCVKDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+            CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
             CC_PROFILE_MEMORY_DEC(Buffer, _size);
         }
         _gpuBuffer = nullptr;
@@ -100,7 +106,9 @@ void CCVKBuffer::doDestroy() {
 
 void CCVKBuffer::doResize(uint32_t size, uint32_t count) {
     CCVKDevice::getInstance()->getMemoryStatus().bufferSize -= _size;
+    CC_MEMORY_ACCOUNT_FREE(BUFFER, _size);
     CC_PROFILE_MEMORY_DEC(Buffer, _size);
+    CCVKDevice::getInstance()->gpuAsyncTransferHub()->cancel(_gpuBuffer);
     CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuBuffer);
 
     _gpuBuffer->size  = size;
@@ -116,11 +124,13 @@ void CCVKBuffer::doResize(uint32_t size, uint32_t count) {
         _gpuBuffer->indirectCmds.resize(drawInfoCount);
     }
     CCVKDevice::getInstance()->getMemoryStatus().bufferSize += size;
+    CC_MEMORY_ACCOUNT_ALLOC(BUFFER, size);
     CC_PROFILE_MEMORY_INC(Buffer, size);
 }
 
 void CCVKBuffer::update(const void *buffer, uint32_t size) {
     CC_PROFILE(CCVKBufferUpdate);
+    CCVKDevice::getInstance()->gpuAsyncTransferHub()->finish(_gpuBuffer);
     cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), _gpuBuffer, buffer, size, nullptr);
 }
 
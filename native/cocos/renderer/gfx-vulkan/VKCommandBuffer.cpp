@@ -83,14 +83,34 @@ void CCVKCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuf
     _numInstances = 0;
     _numTriangles = 0;
 
+    // uploads of the transport hub are submitted right before
+    _pendingTransferWrites  = true;
+    _pendingRenderPassReads = 0U;
+
     VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     VkCommandBufferInheritanceInfo inheritanceInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
 
+#if defined(VK_KHR_dynamic_rendering)
+    VkCommandBufferInheritanceRenderingInfoKHR renderingInheritanceInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO_KHR};
+#endif
+
     if (renderPass) {
-        inheritanceInfo.renderPass = static_cast<CCVKRenderPass *>(renderPass)->gpuRenderPass()->vkRenderPass;
-        inheritanceInfo.subpass    = subpass;
-        if (frameBuffer) {
+        const CCVKGPURenderPass *gpuRenderPass = static_cast<CCVKRenderPass *>(renderPass)->gpuRenderPass();
+        inheritanceInfo.renderPass             = gpuRenderPass->vkRenderPass;
+        inheritanceInfo.subpass                = subpass;
+#if defined(VK_KHR_dynamic_rendering)
+        if (gpuRenderPass->useDynamicRendering) {
+            renderingInheritanceInfo.colorAttachmentCount    = utils::toUint(gpuRenderPass->colorFormats.size());
+            renderingInheritanceInfo.pColorAttachmentFormats = gpuRenderPass->colorFormats.data();
+            renderingInheritanceInfo.depthAttachmentFormat   = gpuRenderPass->depthFormat;
+            renderingInheritanceInfo.stencilAttachmentFormat = gpuRenderPass->stencilFormat;
+            renderingInheritanceInfo.rasterizationSamples    = gpuRenderPass->sampleCounts[0];
+            renderingInheritanceInfo.viewMask                = gpuRenderPass->viewMask;
+            inheritanceInfo.pNext                            = &renderingInheritanceInfo;
+        }
+#endif
+        if (frameBuffer && !gpuRenderPass->useDynamicRendering) {
             CCVKGPUFramebuffer *gpuFBO = static_cast<CCVKFramebuffer *>(frameBuffer)->gpuFBO();
             if (gpuFBO->isOffscreen) {
                 inheritanceInfo.framebuffer = gpuFBO->vkFramebuffer;
@@ -111,6 +131,9 @@ void CCVKCommandBuffer::begin(RenderPass *renderPass, uint32_t subpass, Framebuf
 void CCVKCommandBuffer::end() {
     if (!_gpuCommandBuffer->began) return;
 
+    // transfers in the command buffers submitted afterwards
+    guardRenderPassReads();
+
     _curGPUFBO                       = nullptr;
     _curGPUInputAssember             = nullptr;
     _curDynamicStates.viewport.width = _curDynamicStates.viewport.height = _curDynamicStates.scissor.width = _curDynamicStates.scissor.height = 0U;
@@ -124,22 +147,25 @@ void CCVKCommandBuffer::end() {
 void CCVKCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo, const Rect &renderArea, const Color *colors,
                                         float depth, uint32_t stencil, CommandBuffer *const * /*secondaryCBs*/, uint32_t secondaryCBCount) {
 #if BARRIER_DEDUCTION_LEVEL >= BARRIER_DEDUCTION_LEVEL_BASIC
-    // guard against RAW hazard
-    VkMemoryBarrier vkBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
-    vkBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    vkBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-    vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer,
-                         VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                         0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+    // guard against RAW hazard, only needed once until something else is transferred
+    CCVKGPUBarrierStats &stats = CCVKDevice::getInstance()->gpuDevice()->barrierStats;
+    if (_pendingTransferWrites) {
+        VkMemoryBarrier vkBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        vkBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkBarrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+        _pendingTransferWrites = false;
+        ++stats.issued;
+    } else {
+        ++stats.elided;
+    }
 #endif
 
     _curGPUFBO        = static_cast<CCVKFramebuffer *>(fbo)->gpuFBO();
     _curGPURenderPass = static_cast<CCVKRenderPass *>(renderPass)->gpuRenderPass();
-    VkFramebuffer framebuffer{_curGPUFBO->vkFramebuffer};
-    if (!_curGPUFBO->isOffscreen) {
-        framebuffer = _curGPUFBO->swapchain->vkSwapchainFramebufferListMap[_curGPUFBO][_curGPUFBO->swapchain->curImageIndex];
-    }
 
     ccstd::vector<VkClearValue> &clearValues     = _curGPURenderPass->clearValues;
     bool                         depthEnabled    = _curGPURenderPass->depthStencilAttachment.format != Format::UNKNOWN;
@@ -161,14 +187,21 @@ void CCVKCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo
 
     VkRenderPassBeginInfo passBeginInfo{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
     passBeginInfo.renderPass        = _curGPURenderPass->vkRenderPass;
-    passBeginInfo.framebuffer       = framebuffer;
     passBeginInfo.clearValueCount   = utils::toUint(clearValues.size());
     passBeginInfo.pClearValues      = clearValues.data();
     passBeginInfo.renderArea.offset = {safeArea.x, safeArea.y};
     passBeginInfo.renderArea.extent = {safeArea.width, safeArea.height};
 
-    vkCmdBeginRenderPass(_gpuCommandBuffer->vkCommandBuffer, &passBeginInfo,
-                         secondaryCBCount ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    if (_curGPURenderPass->useDynamicRendering) {
+        beginDynamicRendering(passBeginInfo.renderArea, secondaryCBCount);
+    } else {
+        passBeginInfo.framebuffer = _curGPUFBO->vkFramebuffer;
+        if (!_curGPUFBO->isOffscreen) {
+            passBeginInfo.framebuffer = _curGPUFBO->swapchain->vkSwapchainFramebufferListMap[_curGPUFBO][_curGPUFBO->swapchain->curImageIndex];
+        }
+        vkCmdBeginRenderPass(_gpuCommandBuffer->vkCommandBuffer, &passBeginInfo,
+                             secondaryCBCount ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+    }
 
     _secondaryRP = secondaryCBCount;
 
@@ -183,7 +216,11 @@ void CCVKCommandBuffer::beginRenderPass(RenderPass *renderPass, Framebuffer *fbo
 }
 
 void CCVKCommandBuffer::endRenderPass() {
-    vkCmdEndRenderPass(_gpuCommandBuffer->vkCommandBuffer);
+    if (_curGPURenderPass->useDynamicRendering) {
+        endDynamicRendering();
+    } else {
+        vkCmdEndRenderPass(_gpuCommandBuffer->vkCommandBuffer);
+    }
 
     CCVKGPUDevice *gpuDevice            = CCVKDevice::getInstance()->gpuDevice();
     size_t         colorAttachmentCount = _curGPURenderPass->colorAttachments.size();
@@ -197,12 +234,115 @@ void CCVKCommandBuffer::endRenderPass() {
 
     _curGPUFBO = nullptr;
 
+    // the guard against WAR hazard is deferred to the next transfer
+    ++_pendingRenderPassReads;
+}
+
+void CCVKCommandBuffer::issueAttachmentBarriers(const ccstd::vector<ThsvsImageBarrier> &barriers) {
+    CCVKGPUBarrierStats &stats = CCVKDevice::getInstance()->gpuDevice()->barrierStats;
+
+    VkPipelineStageFlags srcStageMask     = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkPipelineStageFlags dstStageMask     = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    VkPipelineStageFlags tempSrcStageMask = 0;
+    VkPipelineStageFlags tempDstStageMask = 0;
+    const size_t         colorCount       = _curGPUFBO->gpuColorViews.size();
+    _imageMemoryBarriers.clear();
+    for (size_t i = 0U; i < barriers.size(); ++i) {
+        if (CCVKGPUBarrierBatch::isRedundant(barriers[i])) {
+            ++stats.elided;
+            continue;
+        }
+
+        const CCVKGPUTextureView *gpuTextureView = i < colorCount ? _curGPUFBO->gpuColorViews[i] : _curGPUFBO->gpuDepthStencilView;
+        const CCVKGPUTexture *    gpuTexture     = gpuTextureView->gpuTexture;
+        ThsvsImageBarrier         imageBarrier{barriers[i]};
+        imageBarrier.image            = gpuTexture->swapchain ? gpuTexture->swapchainVkImages[gpuTexture->swapchain->curImageIndex] : gpuTexture->vkImage;
+        imageBarrier.subresourceRange = {gpuTexture->aspectMask, gpuTextureView->baseLevel, gpuTextureView->levelCount,
+                                         gpuTextureView->baseLayer, gpuTextureView->layerCount};
+
+        _imageMemoryBarriers.emplace_back();
+        thsvsGetVulkanImageMemoryBarrier(imageBarrier, &tempSrcStageMask, &tempDstStageMask, &_imageMemoryBarriers.back());
+        srcStageMask |= tempSrcStageMask;
+        dstStageMask |= tempDstStageMask;
+    }
+    if (_imageMemoryBarriers.empty()) return;
+
+    vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr,
+                         utils::toUint(_imageMemoryBarriers.size()), _imageMemoryBarriers.data());
+    ++stats.issued;
+    stats.merged += utils::toUint(_imageMemoryBarriers.size()) - 1;
+}
+
+void CCVKCommandBuffer::beginDynamicRendering(const VkRect2D &renderArea, bool secondaryContents) {
+#if defined(VK_KHR_dynamic_rendering)
+    // the layout transitions a render pass would do at its beginning
+    issueAttachmentBarriers(_curGPURenderPass->beginBarriers);
+
+    const size_t colorCount      = _curGPURenderPass->colorAttachments.size();
+    const size_t attachmentCount = _curGPURenderPass->attachmentDescriptions.size();
+    _renderingAttachments.assign(attachmentCount, {VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR});
+    for (size_t i = 0U; i < attachmentCount; ++i) {
+        const CCVKGPUTextureView *      gpuTextureView = i < colorCount ? _curGPUFBO->gpuColorViews[i] : _curGPUFBO->gpuDepthStencilView;
+        const CCVKGPUTexture *          gpuTexture     = gpuTextureView->gpuTexture;
+        const VkAttachmentDescription2 &desc           = _curGPURenderPass->attachmentDescriptions[i];
+
+        VkRenderingAttachmentInfoKHR &attachment = _renderingAttachments[i];
+        attachment.imageView                     = gpuTexture->swapchain ? gpuTextureView->swapchainVkImageViews[gpuTexture->swapchain->curImageIndex] : gpuTextureView->vkImageView;
+        attachment.imageLayout                   = _curGPURenderPass->attachmentLayouts[i];
+        attachment.loadOp                        = desc.loadOp;
+        attachment.storeOp                       = desc.storeOp;
+        attachment.clearValue                    = _curGPURenderPass->clearValues[i];
+    }
+
+    VkRenderingInfoKHR renderingInfo{VK_STRUCTURE_TYPE_RENDERING_INFO_KHR};
+    renderingInfo.flags                = secondaryContents ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT_KHR : 0;
+    renderingInfo.renderArea           = renderArea;
+    renderingInfo.layerCount           = 1; // ignored when multiview is on
+    renderingInfo.viewMask             = _curGPURenderPass->viewMask;
+    renderingInfo.colorAttachmentCount = utils::toUint(colorCount);
+    renderingInfo.pColorAttachments    = _renderingAttachments.data();
+
+    // depth and stencil share the view, only the ops differ
+    VkRenderingAttachmentInfoKHR stencilAttachment{VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+    if (attachmentCount > colorCount) {
+        const VkRenderingAttachmentInfoKHR &depthAttachment = _renderingAttachments[colorCount];
+        if (_curGPURenderPass->depthFormat != VK_FORMAT_UNDEFINED) {
+            renderingInfo.pDepthAttachment = &depthAttachment;
+        }
+        if (_curGPURenderPass->stencilFormat != VK_FORMAT_UNDEFINED) {
+            stencilAttachment                = depthAttachment;
+            stencilAttachment.loadOp         = _curGPURenderPass->attachmentDescriptions[colorCount].stencilLoadOp;
+            stencilAttachment.storeOp        = _curGPURenderPass->attachmentDescriptions[colorCount].stencilStoreOp;
+            renderingInfo.pStencilAttachment = &stencilAttachment;
+        }
+    }
+
+    CCVKDevice::getInstance()->gpuDevice()->cmdBeginRendering(_gpuCommandBuffer->vkCommandBuffer, &renderingInfo);
+#endif
+}
+
+void CCVKCommandBuffer::endDynamicRendering() {
+#if defined(VK_KHR_dynamic_rendering)
+    CCVKDevice::getInstance()->gpuDevice()->cmdEndRendering(_gpuCommandBuffer->vkCommandBuffer);
+
+    // and the ones at its end
+    issueAttachmentBarriers(_curGPURenderPass->endBarriers);
+#endif
+}
+
+void CCVKCommandBuffer::guardRenderPassReads() {
+    if (!_pendingRenderPassReads) return;
+
 #if BARRIER_DEDUCTION_LEVEL >= BARRIER_DEDUCTION_LEVEL_BASIC
-    // guard against WAR hazard
+    // one execution barrier covers all the render passes since the last transfer
     vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer,
                          VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
                          VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    CCVKGPUBarrierStats &stats = CCVKDevice::getInstance()->gpuDevice()->barrierStats;
+    ++stats.issued;
+    stats.merged += _pendingRenderPassReads - 1;
 #endif
+    _pendingRenderPassReads = 0U;
 }
 
 void CCVKCommandBuffer::bindPipelineState(PipelineState *pso) {
@@ -442,6 +582,9 @@ void CCVKCommandBuffer::draw(const DrawInfo &info) {
 
 void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count) {
     if (!count) return;
+    // secondary command buffers may transfer anything
+    guardRenderPassReads();
+    _pendingTransferWrites = true;
     _vkCommandBuffers.resize(count);
 
     uint32_t validCount = 0U;
@@ -462,14 +605,65 @@ void CCVKCommandBuffer::execute(CommandBuffer *const *cmdBuffs, uint32_t count)
     }
 }
 
+void CCVKCommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    CC_PROFILE(CCVKCmdBufDrawIndirect);
+    if (_firstDirtyDescriptorSet < _curGPUDescriptorSets.size()) {
+        bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS);
+    }
+
+    CCVKGPUDevice *gpuDevice      = CCVKDevice::getInstance()->gpuDevice();
+    auto *         indirectBuffer = static_cast<CCVKBuffer *>(info.buffer);
+    const bool     indexed        = _curGPUInputAssember->gpuIndexBuffer != nullptr;
+    const uint32_t stride         = info.stride ? info.stride : (indexed ? sizeof(VkDrawIndexedIndirectCommand) : sizeof(VkDrawIndirectCommand));
+    VkBuffer       vkBuffer       = indirectBuffer->gpuBuffer()->vkBuffer;
+    VkDeviceSize   offset         = indirectBuffer->gpuBufferView()->getStartOffset(gpuDevice->curBackBufferIndex) + info.offset;
+
+    if (info.countBuffer) {
+        CC_ASSERT(gpuDevice->cmdDrawIndirectCount);
+        auto *       countBuffer = static_cast<CCVKBuffer *>(info.countBuffer);
+        VkDeviceSize countOffset = countBuffer->gpuBufferView()->getStartOffset(gpuDevice->curBackBufferIndex) + info.countOffset;
+        if (indexed) {
+            gpuDevice->cmdDrawIndexedIndirectCount(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset,
+                                                   countBuffer->gpuBuffer()->vkBuffer, countOffset, info.drawCount, stride);
+        } else {
+            gpuDevice->cmdDrawIndirectCount(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset,
+                                            countBuffer->gpuBuffer()->vkBuffer, countOffset, info.drawCount, stride);
+        }
+        ++_numDrawCalls;
+        return;
+    }
+
+    if (gpuDevice->useMultiDrawIndirect) {
+        if (indexed) {
+            vkCmdDrawIndexedIndirect(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset, info.drawCount, stride);
+        } else {
+            vkCmdDrawIndirect(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset, info.drawCount, stride);
+        }
+        ++_numDrawCalls;
+    } else {
+        for (uint32_t i = 0U; i < info.drawCount; ++i) {
+            if (indexed) {
+                vkCmdDrawIndexedIndirect(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset + i * stride, 1, stride);
+            } else {
+                vkCmdDrawIndirect(_gpuCommandBuffer->vkCommandBuffer, vkBuffer, offset + i * stride, 1, stride);
+            }
+        }
+        _numDrawCalls += info.drawCount;
+    }
+}
+
 void CCVKCommandBuffer::updateBuffer(Buffer *buffer, const void *data, uint32_t size) {
     CC_PROFILE(CCVKCmdBufUpdateBuffer);
     CCVKGPUBuffer *gpuBuffer = static_cast<CCVKBuffer *>(buffer)->gpuBuffer();
+    guardRenderPassReads();
     cmdFuncCCVKUpdateBuffer(CCVKDevice::getInstance(), gpuBuffer, data, size, _gpuCommandBuffer);
+    _pendingTransferWrites = true;
 }
 
 void CCVKCommandBuffer::copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) {
+    guardRenderPassReads();
     cmdFuncCCVKCopyBuffersToTexture(CCVKDevice::getInstance(), buffers, static_cast<CCVKTexture *>(texture)->gpuTexture(), regions, count, _gpuCommandBuffer);
+    _pendingTransferWrites = true;
 }
 
 void CCVKCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) {
@@ -480,6 +674,8 @@ void CCVKCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, co
     VkImageLayout      srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
     VkImageLayout      dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 
+    guardRenderPassReads();
+
     CCVKGPUTexture *gpuTextureSrc = static_cast<CCVKTexture *>(srcTexture)->gpuTexture();
     srcAspectMask                 = gpuTextureSrc->aspectMask;
     if (gpuTextureSrc->swapchain) {
@@ -539,6 +735,7 @@ void CCVKCommandBuffer::blitTexture(Texture *srcTexture, Texture *dstTexture, co
                    srcImage, srcImageLayout,
                    dstImage, dstImageLayout,
                    count, _blitRegions.data(), VK_FILTERS[toNumber(filter)]);
+    _pendingTransferWrites = true;
 
     if (gpuTextureDst->swapchain) {
         VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
@@ -622,31 +819,47 @@ void CCVKCommandBuffer::pipelineBarrier(const GeneralBarrier *barrier, const Tex
         memoryBarrierCount = 1U;
     }
 
+    CCVKGPUBarrierStats &stats                   = CCVKDevice::getInstance()->gpuDevice()->barrierStats;
+    uint32_t             imageMemoryBarrierCount = 0U;
     if (textureBarrierCount > 0) {
         _imageMemoryBarriers.resize(textureBarrierCount);
         pImageMemoryBarriers = _imageMemoryBarriers.data();
 
         for (uint32_t i = 0U; i < textureBarrierCount; ++i) {
-            const auto *gpuBarrier = static_cast<const CCVKTextureBarrier *const>(textureBarriers[i])->gpuBarrier();
-            auto *      gpuTexture = static_cast<const CCVKTexture *const>(textures[i])->gpuTexture();
+            const auto *             gpuBarrier = static_cast<const CCVKTextureBarrier *const>(textureBarriers[i])->gpuBarrier();
+            auto *                   gpuTexture = static_cast<const CCVKTexture *const>(textures[i])->gpuTexture();
+            const ThsvsImageBarrier &barrier    = gpuBarrier->barrier;
+
+            // no-op transitions, or read only ones the tracked state already matches, swapchain images are not tracked per image
+            auto &     current   = gpuTexture->currentAccessTypes;
+            const bool redundant = CCVKGPUBarrierBatch::isRedundant(barrier) ||
+                                   (!gpuTexture->swapchain && CCVKGPUBarrierBatch::isSatisfied(barrier, current.data(), utils::toUint(current.size())));
+            current.assign(barrier.pNextAccesses, barrier.pNextAccesses + barrier.nextAccessCount);
+            if (redundant) {
+                ++stats.elided;
+                continue;
+            }
 
-            _imageMemoryBarriers[i]                             = gpuBarrier->vkBarrier;
-            _imageMemoryBarriers[i].subresourceRange.aspectMask = gpuTexture->aspectMask;
+            VkImageMemoryBarrier &vkBarrier       = _imageMemoryBarriers[imageMemoryBarrierCount++];
+            vkBarrier                             = gpuBarrier->vkBarrier;
+            vkBarrier.subresourceRange.aspectMask = gpuTexture->aspectMask;
             if (gpuTexture->swapchain) {
-                _imageMemoryBarriers[i].image = gpuTexture->swapchainVkImages[gpuTexture->swapchain->curImageIndex];
+                vkBarrier.image = gpuTexture->swapchainVkImages[gpuTexture->swapchain->curImageIndex];
             } else {
-                _imageMemoryBarriers[i].image = gpuTexture->vkImage;
+                vkBarrier.image = gpuTexture->vkImage;
             }
 
             srcStageMask |= gpuBarrier->srcStageMask;
             dstStageMask |= gpuBarrier->dstStageMask;
-
-            gpuTexture->currentAccessTypes.assign(gpuBarrier->barrier.pNextAccesses, gpuBarrier->barrier.pNextAccesses + gpuBarrier->barrier.nextAccessCount);
         }
     }
 
+    if (!memoryBarrierCount && !imageMemoryBarrierCount) return;
+
     vkCmdPipelineBarrier(_gpuCommandBuffer->vkCommandBuffer, srcStageMask, dstStageMask, 0, memoryBarrierCount, pMemoryBarrier,
-                         0, nullptr, textureBarrierCount, pImageMemoryBarriers);
+                         0, nullptr, imageMemoryBarrierCount, pImageMemoryBarriers);
+    ++stats.issued;
+    stats.merged += memoryBarrierCount + imageMemoryBarrierCount - 1;
 }
 
 void CCVKCommandBuffer::beginQuery(QueryPool *queryPool, uint32_t /*id*/) {
@@ -678,5 +891,16 @@ void CCVKCommandBuffer::resetQueryPool(QueryPool *queryPool) {
     vkQueryPool->_ids.clear();
 }
 
+void CCVKCommandBuffer::writeTimestamp(QueryPool *queryPool, uint32_t id) {
+    auto *            vkQueryPool  = static_cast<CCVKQueryPool *>(queryPool);
+    CCVKGPUQueryPool *gpuQueryPool = vkQueryPool->gpuQueryPool();
+    auto              queryId      = static_cast<uint32_t>(vkQueryPool->_ids.size());
+
+    if (queryId < queryPool->getMaxQueryObjects()) {
+        vkCmdWriteTimestamp(_gpuCommandBuffer->vkCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, gpuQueryPool->vkPool, queryId);
+        vkQueryPool->_ids.push_back(id);
+    }
+}
+
 } // namespace gfx
 } // namespace cc
@@ -55,6 +55,7 @@ public:
     void setStencilCompareMask(StencilFace face, uint32_t reference, uint32_t mask) override;
     void nextSubpass() override;
     void draw(const DrawInfo &info) override;
+    void drawIndirect(const DrawIndirectInfo &info) override;
     void updateBuffer(Buffer *buffer, const void *data, uint32_t size) override;
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *texture, const BufferTextureCopy *regions, uint32_t count) override;
     void blitTexture(Texture *srcTexture, Texture *dstTexture, const TextureBlit *regions, uint32_t count, Filter filter) override;
@@ -64,6 +65,7 @@ public:
     void beginQuery(QueryPool *queryPool, uint32_t id) override;
     void endQuery(QueryPool *queryPool, uint32_t id) override;
     void resetQueryPool(QueryPool *queryPool) override;
+    void writeTimestamp(QueryPool *queryPool, uint32_t id) override;
 
     CCVKGPUCommandBuffer *gpuCommandBuffer() const { return _gpuCommandBuffer; }
 
@@ -74,6 +76,10 @@ protected:
     void doDestroy() override;
 
     void bindDescriptorSets(VkPipelineBindPoint bindPoint);
+    void guardRenderPassReads();
+    void beginDynamicRendering(const VkRect2D &renderArea, bool secondaryContents);
+    void endDynamicRendering();
+    void issueAttachmentBarriers(const ccstd::vector<ThsvsImageBarrier> &barriers);
 
     CCVKGPUCommandBuffer *_gpuCommandBuffer = nullptr;
 
@@ -90,12 +96,19 @@ protected:
 
     bool _secondaryRP = false;
 
+    // barriers deferred or skipped until they are actually needed
+    bool     _pendingTransferWrites  = false; // transfers since the last guard against RAW hazard
+    uint32_t _pendingRenderPassReads = 0U;    // render passes since the last guard against WAR hazard
+
     DynamicStates _curDynamicStates;
 
     // temp storage
     ccstd::vector<VkImageBlit>          _blitRegions;
     ccstd::vector<VkImageMemoryBarrier> _imageMemoryBarriers;
     ccstd::vector<VkCommandBuffer>      _vkCommandBuffers;
+#if defined(VK_KHR_dynamic_rendering)
+    ccstd::vector<VkRenderingAttachmentInfoKHR> _renderingAttachments;
+#endif
 
     ccstd::queue<VkCommandBuffer> _pendingQueue;
 };
@@ -24,6 +24,8 @@
 ****************************************************************************/
 
 #include <boost/functional/hash.hpp>
+#include <chrono>
+#include <mutex>
 #include <thread>
 #include "VKStd.h"
 #include "base/std/container/map.h"
@@ -42,6 +44,103 @@ namespace gfx {
 
 namespace {
 constexpr bool ENABLE_LAZY_ALLOCATION = true;
+
+// defragment only when this much of the allocated blocks is unused
+constexpr float        DEFRAGMENTATION_UNUSED_RATIO = 0.25F;
+constexpr VkDeviceSize DEFRAGMENTATION_UNUSED_BYTES = 16 * 1024 * 1024;
+
+void fillBufferCreateInfo(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, VkBufferCreateInfo *bufferInfo, VmaAllocationCreateInfo *allocInfo) {
+    bufferInfo->size  = gpuBuffer->size;
+    bufferInfo->usage = mapVkBufferUsageFlagBits(gpuBuffer->usage);
+
+    if (gpuBuffer->memUsage == MemoryUsage::HOST) {
+        bufferInfo->usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        allocInfo->flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo->usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    } else if (gpuBuffer->memUsage == MemoryUsage::DEVICE) {
+        bufferInfo->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        allocInfo->usage = VMA_MEMORY_USAGE_GPU_ONLY;
+    } else if (gpuBuffer->memUsage == (MemoryUsage::HOST | MemoryUsage::DEVICE)) {
+        gpuBuffer->instanceSize = roundUp(gpuBuffer->size, device->getCapabilities().uboOffsetAlignment);
+        bufferInfo->size        = gpuBuffer->instanceSize * device->gpuDevice()->backBufferCount;
+        allocInfo->flags        = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocInfo->usage        = VMA_MEMORY_USAGE_CPU_TO_GPU;
+        bufferInfo->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    }
+}
+
+// Accumulates the pipeline creation time in the device pipeline cache status, and whether the pipeline cache
+// was hit if VK_EXT_pipeline_creation_feedback is available. Needs to outlive the creation call.
+class PipelineCreationFeedback final {
+public:
+    template <typename CreateInfo>
+    PipelineCreationFeedback(CCVKDevice *device, CreateInfo *createInfo, uint32_t stageCount)
+    : _device(device), _start(std::chrono::steady_clock::now()) {
+#if defined(VK_EXT_pipeline_creation_feedback)
+        if (device->gpuDevice()->usePipelineCreationFeedback) {
+            _stageFeedbacks.resize(stageCount);
+            _feedbackInfo.pNext                              = createInfo->pNext;
+            _feedbackInfo.pPipelineCreationFeedback          = &_feedback;
+            _feedbackInfo.pipelineStageCreationFeedbackCount = stageCount;
+            _feedbackInfo.pPipelineStageCreationFeedbacks    = _stageFeedbacks.data();
+            createInfo->pNext                                = &_feedbackInfo;
+        }
+#endif
+    }
+
+    ~PipelineCreationFeedback() {
+        // pipelines may be created on several threads
+        static std::mutex           statusMutex;
+        std::lock_guard<std::mutex> lock(statusMutex);
+
+        auto &status = _device->getPipelineCacheStatus();
+        status.creationTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - _start).count();
+#if defined(VK_EXT_pipeline_creation_feedback)
+        if (isSet(_feedback.flags, VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT)) {
+            if (isSet(_feedback.flags, VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT)) {
+                ++status.hits;
+            } else {
+                ++status.misses;
+            }
+        }
+#endif
+    }
+
+    PipelineCreationFeedback(const PipelineCreationFeedback &) = delete;
+    PipelineCreationFeedback &operator=(const PipelineCreationFeedback &) = delete;
+
+private:
+    static bool isSet(VkFlags flags, VkFlags bit) { return (flags & bit) != 0; }
+
+    CCVKDevice *                          _device{nullptr};
+    std::chrono::steady_clock::time_point _start;
+#if defined(VK_EXT_pipeline_creation_feedback)
+    VkPipelineCreationFeedbackEXT                _feedback{};
+    ccstd::vector<VkPipelineCreationFeedbackEXT> _stageFeedbacks;
+    VkPipelineCreationFeedbackCreateInfoEXT      _feedbackInfo{VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT};
+#endif
+};
+
+bool isReadOnly(const ThsvsAccessType *accesses, uint32_t count) {
+    for (uint32_t i = 0U; i < count; ++i) {
+        if (accesses[i] == THSVS_ACCESS_NONE || accesses[i] > THSVS_END_OF_READ_ACCESS) return false;
+    }
+    return count > 0;
+}
+
+// the layouts are deduced from the accesses, so the same accesses also keep the same layout
+bool isSameAccesses(const ThsvsAccessType *accesses, uint32_t count, const ThsvsAccessType *otherAccesses, uint32_t otherCount) {
+    if (count != otherCount) return false;
+    for (uint32_t i = 0U; i < otherCount; ++i) {
+        if (std::find(accesses, accesses + count, otherAccesses[i]) == accesses + count) return false;
+    }
+    return true;
+}
+
+bool isKeepingContents(const ThsvsImageBarrier &barrier) {
+    return !barrier.discardContents && barrier.prevLayout == barrier.nextLayout && barrier.srcQueueFamilyIndex == barrier.dstQueueFamilyIndex;
+}
+
 } // namespace
 
 CCVKGPUCommandBufferPool *CCVKGPUDevice::getCommandBufferPool() {
@@ -59,6 +158,25 @@ CCVKGPUDescriptorSetPool *CCVKGPUDevice::getDescriptorSetPool(uint32_t layoutID)
     return _descriptorSetPools[layoutID].get();
 }
 
+void CCVKGPUDevice::trackAllocation(VmaAllocation allocation, CCVKMemoryCategory category) {
+    if (!allocation) return;
+    // the category is kept in the user data, offset by one to tell tracked allocations apart
+    vmaSetAllocationUserData(memoryAllocator, allocation, reinterpret_cast<void *>(static_cast<uintptr_t>(category) + 1));
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(memoryAllocator, allocation, &info);
+    memoryCategorySizes[static_cast<size_t>(category)] += info.size;
+}
+
+void CCVKGPUDevice::untrackAllocation(VmaAllocation allocation) {
+    if (!allocation) return;
+    VmaAllocationInfo info;
+    vmaGetAllocationInfo(memoryAllocator, allocation, &info);
+    const auto tag = reinterpret_cast<uintptr_t>(info.pUserData);
+    if (!tag) return;
+    memoryCategorySizes[tag - 1] -= info.size;
+    vmaSetAllocationUserData(memoryAllocator, allocation, nullptr);
+}
+
 void insertVkDynamicStates(ccstd::vector<VkDynamicState> *out, const ccstd::vector<DynamicStateFlagBit> &dynamicStates) {
     for (DynamicStateFlagBit dynamicState : dynamicStates) {
         switch (dynamicState) {
@@ -151,6 +269,9 @@ void cmdFuncCCVKCreateTexture(CCVKDevice *device, CCVKGPUTexture *gpuTexture) {
         VmaAllocationCreateInfo allocInfo{};
         allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
+        const bool               isRenderTarget = hasAnyFlags(gpuTexture->usage, TextureUsageBit::COLOR_ATTACHMENT | TextureUsageBit::DEPTH_STENCIL_ATTACHMENT);
+        const CCVKMemoryCategory category       = isRenderTarget ? CCVKMemoryCategory::RENDER_TARGET : CCVKMemoryCategory::TEXTURE;
+
         VmaAllocationInfo res;
 
         if (ENABLE_LAZY_ALLOCATION && hasAllFlags(TEXTURE_USAGE_TRANSIENT, gpuTexture->usage)) {
@@ -160,6 +281,7 @@ void cmdFuncCCVKCreateTexture(CCVKDevice *device, CCVKGPUTexture *gpuTexture) {
                                              pVkImage, pVmaAllocation, &res);
             if (!result) {
                 gpuTexture->memoryless = true;
+                device->gpuDevice()->trackAllocation(*pVmaAllocation, category);
                 return;
             }
 
@@ -171,6 +293,7 @@ void cmdFuncCCVKCreateTexture(CCVKDevice *device, CCVKGPUTexture *gpuTexture) {
         gpuTexture->memoryless = false;
         VK_CHECK(vmaCreateImage(device->gpuDevice()->memoryAllocator, &createInfo, &allocInfo,
                                 pVkImage, pVmaAllocation, &res));
+        device->gpuDevice()->trackAllocation(*pVmaAllocation, category);
     };
 
     if (gpuTexture->swapchain) {
@@ -255,30 +378,14 @@ void cmdFuncCCVKCreateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer) {
 
     gpuBuffer->instanceSize = 0U;
 
-    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
-    bufferInfo.size  = gpuBuffer->size;
-    bufferInfo.usage = mapVkBufferUsageFlagBits(gpuBuffer->usage);
-
+    VkBufferCreateInfo      bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
     VmaAllocationCreateInfo allocInfo{};
-
-    if (gpuBuffer->memUsage == MemoryUsage::HOST) {
-        bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-        allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-    } else if (gpuBuffer->memUsage == MemoryUsage::DEVICE) {
-        bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    } else if (gpuBuffer->memUsage == (MemoryUsage::HOST | MemoryUsage::DEVICE)) {
-        gpuBuffer->instanceSize = roundUp(gpuBuffer->size, device->getCapabilities().uboOffsetAlignment);
-        bufferInfo.size         = gpuBuffer->instanceSize * device->gpuDevice()->backBufferCount;
-        allocInfo.flags         = VMA_ALLOCATION_CREATE_MAPPED_BIT;
-        allocInfo.usage         = VMA_MEMORY_USAGE_CPU_TO_GPU;
-        bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    }
+    fillBufferCreateInfo(device, gpuBuffer, &bufferInfo, &allocInfo);
 
     VmaAllocationInfo res;
     VK_CHECK(vmaCreateBuffer(device->gpuDevice()->memoryAllocator, &bufferInfo, &allocInfo,
                              &gpuBuffer->vkBuffer, &gpuBuffer->vmaAllocation, &res));
+    device->gpuDevice()->trackAllocation(gpuBuffer->vmaAllocation, CCVKMemoryCategory::BUFFER);
 
     gpuBuffer->mappedData  = reinterpret_cast<uint8_t *>(res.pMappedData);
     gpuBuffer->startOffset = 0; // we are creating one VkBuffer each for now
@@ -347,6 +454,89 @@ private:
     ccstd::unordered_set<VkSubpassDependency2, DependencyHasher, DependencyComparer> _hashes;
 };
 
+namespace {
+
+constexpr ThsvsAccessType COLOR_ATTACHMENT_ACCESS{THSVS_ACCESS_COLOR_ATTACHMENT_READ_WRITE};
+constexpr ThsvsAccessType DEPTH_STENCIL_ATTACHMENT_ACCESS{THSVS_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE};
+
+// a single subpass writing every attachment in order, what dynamic rendering covers without extra extensions
+bool isDynamicRenderingCompatible(const CCVKGPURenderPass *gpuRenderPass) {
+    if (gpuRenderPass->subpasses.size() != 1 || !gpuRenderPass->dependencies.empty()) return false;
+
+    const SubpassInfo &subpass    = gpuRenderPass->subpasses[0];
+    const auto         colorCount = utils::toUint(gpuRenderPass->colorAttachments.size());
+    const bool         hasDepth   = gpuRenderPass->depthStencilAttachment.format != Format::UNKNOWN;
+    if (!subpass.inputs.empty() || !subpass.resolves.empty() || !subpass.preserves.empty() ||
+        subpass.depthStencilResolve != INVALID_BINDING || subpass.colors.size() != colorCount) {
+        return false;
+    }
+    for (uint32_t i = 0U; i < colorCount; ++i) {
+        if (subpass.colors[i] != i) return false;
+    }
+    return hasDepth ? subpass.depthStencil == colorCount : subpass.depthStencil == INVALID_BINDING;
+}
+
+// the layout transitions of the render pass become explicit barriers around the rendering scope
+void initDynamicRendering(CCVKGPURenderPass *gpuRenderPass, CCVKGPUDevice *gpuDevice) {
+    const size_t colorCount      = gpuRenderPass->colorAttachments.size();
+    const size_t attachmentCount = gpuRenderPass->attachmentDescriptions.size();
+    gpuRenderPass->attachmentLayouts.resize(attachmentCount);
+    gpuRenderPass->beginBarriers.resize(attachmentCount);
+    gpuRenderPass->endBarriers.resize(attachmentCount);
+
+    for (size_t i = 0U; i < attachmentCount; ++i) {
+        const bool                   isDepth         = i >= colorCount;
+        const bool                   isGeneralLayout = isDepth ? gpuRenderPass->depthStencilAttachment.isGeneralLayout : gpuRenderPass->colorAttachments[i].isGeneralLayout;
+        const ThsvsAccessType *      access          = isDepth ? &DEPTH_STENCIL_ATTACHMENT_ACCESS : &COLOR_ATTACHMENT_ACCESS;
+        const CCVKGPUGeneralBarrier *gpuBarrier      = gpuRenderPass->getBarrier(i, gpuDevice);
+
+        if (isGeneralLayout) {
+            gpuRenderPass->attachmentLayouts[i] = VK_IMAGE_LAYOUT_GENERAL;
+        } else {
+            gpuRenderPass->attachmentLayouts[i] = isDepth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        }
+
+        ThsvsImageBarrier &beginBarrier  = gpuRenderPass->beginBarriers[i];
+        beginBarrier                     = {};
+        beginBarrier.prevAccessCount     = utils::toUint(gpuBarrier->prevAccesses.size());
+        beginBarrier.pPrevAccesses       = gpuBarrier->prevAccesses.data();
+        beginBarrier.nextAccessCount     = 1;
+        beginBarrier.pNextAccesses       = access;
+        beginBarrier.prevLayout          = THSVS_IMAGE_LAYOUT_OPTIMAL;
+        beginBarrier.nextLayout          = isGeneralLayout ? THSVS_IMAGE_LAYOUT_GENERAL : THSVS_IMAGE_LAYOUT_OPTIMAL;
+        beginBarrier.discardContents     = gpuRenderPass->attachmentDescriptions[i].initialLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+        beginBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        beginBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+        ThsvsImageBarrier &endBarrier = gpuRenderPass->endBarriers[i];
+        endBarrier                    = beginBarrier;
+        endBarrier.prevAccessCount    = 1;
+        endBarrier.pPrevAccesses      = access;
+        endBarrier.nextAccessCount    = utils::toUint(gpuBarrier->nextAccesses.size());
+        endBarrier.pNextAccesses      = gpuBarrier->nextAccesses.data();
+        endBarrier.prevLayout         = beginBarrier.nextLayout;
+        endBarrier.nextLayout         = THSVS_IMAGE_LAYOUT_OPTIMAL;
+        endBarrier.discardContents    = VK_FALSE;
+    }
+
+    gpuRenderPass->colorFormats.resize(colorCount);
+    for (size_t i = 0U; i < colorCount; ++i) {
+        gpuRenderPass->colorFormats[i] = gpuRenderPass->attachmentDescriptions[i].format;
+    }
+    if (attachmentCount > colorCount) {
+        const FormatInfo &info     = GFX_FORMAT_INFOS[toNumber(gpuRenderPass->depthStencilAttachment.format)];
+        const VkFormat    vkFormat = gpuRenderPass->attachmentDescriptions.back().format;
+
+        gpuRenderPass->depthFormat   = info.hasDepth ? vkFormat : VK_FORMAT_UNDEFINED;
+        gpuRenderPass->stencilFormat = info.hasStencil ? vkFormat : VK_FORMAT_UNDEFINED;
+    }
+
+    gpuRenderPass->vkRenderPass        = VK_NULL_HANDLE;
+    gpuRenderPass->useDynamicRendering = true;
+}
+
+} // namespace
+
 void cmdFuncCCVKCreateRenderPass(CCVKDevice *device, CCVKGPURenderPass *gpuRenderPass) {
     static ccstd::vector<VkSubpassDescriptionDepthStencilResolve> depthStencilResolves;
     static ccstd::vector<VkAttachmentDescription2>                attachmentDescriptions;
@@ -483,6 +673,12 @@ void cmdFuncCCVKCreateRenderPass(CCVKDevice *device, CCVKGPURenderPass *gpuRende
         gpuRenderPass->sampleCounts.push_back(sampleCount);
     }
 
+    if (device->gpuDevice()->useDynamicRendering && isDynamicRenderingCompatible(gpuRenderPass)) {
+        gpuRenderPass->attachmentDescriptions = attachmentDescriptions;
+        initDynamicRendering(gpuRenderPass, device->gpuDevice());
+        return;
+    }
+
     size_t offset{0U};
     subpassDescriptions.assign(subpassCount, {VK_STRUCTURE_TYPE_SUBPASS_DESCRIPTION_2}); // init to zeros first
     depthStencilResolves.resize(subpassCount, {VK_STRUCTURE_TYPE_SUBPASS_DESCRIPTION_DEPTH_STENCIL_RESOLVE});
@@ -492,6 +688,7 @@ void cmdFuncCCVKCreateRenderPass(CCVKDevice *device, CCVKGPURenderPass *gpuRende
 
         VkSubpassDescription2 &desc = subpassDescriptions[i];
         desc.pipelineBindPoint      = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        desc.viewMask               = gpuRenderPass->viewMask;
 
         if (!subpassInfo.inputs.empty()) {
             desc.inputAttachmentCount = utils::toUint(subpassInfo.inputs.size());
@@ -730,6 +927,11 @@ void cmdFuncCCVKCreateRenderPass(CCVKDevice *device, CCVKGPURenderPass *gpuRende
     renderPassCreateInfo.pSubpasses      = subpassDescriptions.data();
     renderPassCreateInfo.dependencyCount = utils::toUint(dependencyManager.subpassDependencies.size());
     renderPassCreateInfo.pDependencies   = dependencyManager.subpassDependencies.data();
+    if (gpuRenderPass->viewMask) {
+        // the views of a stereo pair see nearly the same geometry
+        renderPassCreateInfo.correlatedViewMaskCount = 1;
+        renderPassCreateInfo.pCorrelatedViewMasks    = &gpuRenderPass->viewMask;
+    }
 
     VK_CHECK(device->gpuDevice()->createRenderPass2(device->gpuDevice()->vkDevice, &renderPassCreateInfo,
                                                     nullptr, &gpuRenderPass->vkRenderPass));
@@ -768,6 +970,11 @@ void cmdFuncCCVKCreateFramebuffer(CCVKDevice *device, CCVKGPUFramebuffer *gpuFra
     gpuFramebuffer->width       = createInfo.width;
     gpuFramebuffer->height      = createInfo.height;
 
+    if (gpuFramebuffer->gpuRenderPass->useDynamicRendering) {
+        // the views are bound when the pass begins, resizing an attachment creates nothing
+        return;
+    }
+
     if (gpuFramebuffer->isOffscreen) {
         createInfo.renderPass      = gpuFramebuffer->gpuRenderPass->vkRenderPass;
         createInfo.attachmentCount = utils::toUint(attachments.size());
@@ -908,17 +1115,19 @@ void cmdFuncCCVKCreateComputePipelineState(CCVKDevice *device, CCVKGPUPipelineSt
 
     ///////////////////// Creation /////////////////////
 
+    PipelineCreationFeedback feedback(device, &createInfo, 1);
     VK_CHECK(vkCreateComputePipelines(device->gpuDevice()->vkDevice, device->gpuDevice()->vkPipelineCache,
                                       1, &createInfo, nullptr, &gpuPipelineState->vkPipeline));
 }
 
 void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineState *gpuPipelineState) {
-    static ccstd::vector<VkPipelineShaderStageCreateInfo>     stageInfos;
-    static ccstd::vector<VkVertexInputBindingDescription>     bindingDescriptions;
-    static ccstd::vector<VkVertexInputAttributeDescription>   attributeDescriptions;
-    static ccstd::vector<uint32_t>                            offsets;
-    static ccstd::vector<VkDynamicState>                      dynamicStates;
-    static ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
+    // pipelines may be created on several threads
+    static thread_local ccstd::vector<VkPipelineShaderStageCreateInfo>     stageInfos;
+    static thread_local ccstd::vector<VkVertexInputBindingDescription>     bindingDescriptions;
+    static thread_local ccstd::vector<VkVertexInputAttributeDescription>   attributeDescriptions;
+    static thread_local ccstd::vector<uint32_t>                            offsets;
+    static thread_local ccstd::vector<VkDynamicState>                      dynamicStates;
+    static thread_local ccstd::vector<VkPipelineColorBlendAttachmentState> blendTargets;
 
     VkGraphicsPipelineCreateInfo createInfo{VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO};
 
@@ -1112,8 +1321,24 @@ void cmdFuncCCVKCreateGraphicsPipelineState(CCVKDevice *device, CCVKGPUPipelineS
     createInfo.renderPass = gpuPipelineState->gpuRenderPass->vkRenderPass;
     createInfo.subpass    = gpuPipelineState->subpass;
 
+#if defined(VK_KHR_dynamic_rendering)
+    // created against the attachment formats, independent of any framebuffer
+    const CCVKGPURenderPass *        gpuRenderPass = gpuPipelineState->gpuRenderPass;
+    VkPipelineRenderingCreateInfoKHR renderingInfo{VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR};
+    if (gpuRenderPass->useDynamicRendering) {
+        renderingInfo.colorAttachmentCount    = utils::toUint(gpuRenderPass->colorFormats.size());
+        renderingInfo.pColorAttachmentFormats = gpuRenderPass->colorFormats.data();
+        renderingInfo.depthAttachmentFormat   = gpuRenderPass->depthFormat;
+        renderingInfo.stencilAttachmentFormat = gpuRenderPass->stencilFormat;
+        renderingInfo.viewMask                = gpuRenderPass->viewMask;
+        renderingInfo.pNext                   = createInfo.pNext;
+        createInfo.pNext                      = &renderingInfo;
+    }
+#endif
+
     ///////////////////// Creation /////////////////////
 
+    PipelineCreationFeedback feedback(device, &createInfo, createInfo.stageCount);
     VK_CHECK(vkCreateGraphicsPipelines(device->gpuDevice()->vkDevice, device->gpuDevice()->vkPipelineCache,
                                        1, &createInfo, nullptr, &gpuPipelineState->vkPipeline));
 }
@@ -1199,6 +1424,7 @@ void cmdFuncCCVKUpdateBuffer(CCVKDevice *device, CCVKGPUBuffer *gpuBuffer, const
                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
                                  0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+            ++device->gpuDevice()->barrierStats.issued;
         }
 #endif
         vkCmdCopyBuffer(gpuCommandBuffer->vkCommandBuffer, stagingBuffer.vkBuffer, gpuBuffer->vkBuffer, 1, &region);
@@ -1242,6 +1468,7 @@ void cmdFuncCCVKCopyBuffersToTexture(CCVKDevice *device, const uint8_t *const *b
                              VK_PIPELINE_STAGE_TRANSFER_BIT,
                              VK_PIPELINE_STAGE_TRANSFER_BIT,
                              0, 1, &vkBarrier, 0, nullptr, 0, nullptr);
+        ++device->gpuDevice()->barrierStats.issued;
     }
 
     for (size_t i = 0U; i < count; ++i) {
@@ -1447,6 +1674,12 @@ void cmdFuncCCVKDestroyPipelineState(CCVKGPUDevice *gpuDevice, CCVKGPUPipelineSt
 }
 
 void cmdFuncCCVKImageMemoryBarrier(const CCVKGPUCommandBuffer *gpuCommandBuffer, const ThsvsImageBarrier &imageBarrier) {
+    CCVKGPUBarrierStats &stats = CCVKDevice::getInstance()->gpuDevice()->barrierStats;
+    if (CCVKGPUBarrierBatch::isRedundant(imageBarrier)) {
+        ++stats.elided;
+        return;
+    }
+
     VkPipelineStageFlags srcStageMask     = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
     VkPipelineStageFlags dstStageMask     = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
     VkPipelineStageFlags tempSrcStageMask = 0;
@@ -1456,6 +1689,7 @@ void cmdFuncCCVKImageMemoryBarrier(const CCVKGPUCommandBuffer *gpuCommandBuffer,
     srcStageMask |= tempSrcStageMask;
     dstStageMask |= tempDstStageMask;
     vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &vkBarrier);
+    ++stats.issued;
 }
 
 const CCVKGPUGeneralBarrier *CCVKGPURenderPass::getBarrier(size_t index, CCVKGPUDevice *gpuDevice) const {
@@ -1471,6 +1705,7 @@ void CCVKGPURecycleBin::clear() {
         switch (res.type) {
             case RecycledType::BUFFER:
                 if (res.buffer.vkBuffer) {
+                    _device->untrackAllocation(res.buffer.vmaAllocation);
                     vmaDestroyBuffer(_device->memoryAllocator, res.buffer.vkBuffer, res.buffer.vmaAllocation);
                     res.buffer.vkBuffer      = VK_NULL_HANDLE;
                     res.buffer.vmaAllocation = VK_NULL_HANDLE;
@@ -1478,6 +1713,7 @@ void CCVKGPURecycleBin::clear() {
                 break;
             case RecycledType::TEXTURE:
                 if (res.image.vkImage) {
+                    _device->untrackAllocation(res.image.vmaAllocation);
                     vmaDestroyImage(_device->memoryAllocator, res.image.vkImage, res.image.vmaAllocation);
                     res.image.vkImage       = VK_NULL_HANDLE;
                     res.image.vmaAllocation = VK_NULL_HANDLE;
@@ -1551,6 +1787,119 @@ void CCVKGPURecycleBin::clear() {
     _count = 0;
 }
 
+void CCVKGPUMemoryHub::update(CCVKDevice *device) {
+    vmaSetCurrentFrameIndex(_device->memoryAllocator, ++_frameIndex);
+    updateBudgets();
+
+    if (!_defragmentationEnabled || _frameIndex < _nextDefragmentationFrame) return;
+    _nextDefragmentationFrame = _frameIndex + _defragmentationInterval;
+    if (isFragmented()) {
+        defragment(device);
+    }
+}
+
+void CCVKGPUMemoryHub::updateBudgets() {
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+    vmaGetMemoryProperties(_device->memoryAllocator, &memoryProperties);
+    ccstd::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetBudget(_device->memoryAllocator, budgets.data());
+
+    _heapBudgets.resize(memoryProperties->memoryHeapCount);
+    for (uint32_t i = 0U; i < memoryProperties->memoryHeapCount; ++i) {
+        auto &heapBudget           = _heapBudgets[i];
+        heapBudget.usage           = budgets[i].usage;
+        heapBudget.budget          = budgets[i].budget;
+        heapBudget.blockBytes      = budgets[i].blockBytes;
+        heapBudget.allocationBytes = budgets[i].allocationBytes;
+
+        uint32_t level = 0U;
+        if (heapBudget.budget) {
+            const float ratio = static_cast<float>(heapBudget.usage) / static_cast<float>(heapBudget.budget);
+            while (level < _thresholds.size() && ratio >= _thresholds[level]) ++level;
+        }
+        if (level != heapBudget.thresholdLevel) {
+            heapBudget.thresholdLevel = level;
+            if (_budgetCallback) _budgetCallback(i, heapBudget);
+        }
+    }
+}
+
+bool CCVKGPUMemoryHub::isFragmented() const {
+    VkDeviceSize blockBytes  = 0U;
+    VkDeviceSize unusedBytes = 0U;
+    for (const auto &heapBudget : _heapBudgets) {
+        blockBytes += heapBudget.blockBytes;
+        if (heapBudget.blockBytes > heapBudget.allocationBytes) {
+            unusedBytes += heapBudget.blockBytes - heapBudget.allocationBytes;
+        }
+    }
+    return unusedBytes > DEFRAGMENTATION_UNUSED_BYTES &&
+           static_cast<float>(unusedBytes) > static_cast<float>(blockBytes) * DEFRAGMENTATION_UNUSED_RATIO;
+}
+
+void CCVKGPUMemoryHub::defragment(CCVKDevice *device) {
+    _defragmentationBuffers.clear();
+    _defragmentationAllocationList.clear();
+    for (auto *gpuBuffer : _buffers) {
+        if (!gpuBuffer->vmaAllocation) continue;
+        _defragmentationBuffers.push_back(gpuBuffer);
+        _defragmentationAllocationList.push_back(gpuBuffer->vmaAllocation);
+    }
+    if (_defragmentationBuffers.empty()) return;
+    _defragmentationChanged.assign(_defragmentationBuffers.size(), VK_FALSE);
+
+    // allocations may be moved into ranges still read by the frames in flight
+    device->waitAllFences();
+
+    VmaDefragmentationInfo2 info{};
+    info.allocationCount         = utils::toUint(_defragmentationAllocationList.size());
+    info.pAllocations            = _defragmentationAllocationList.data();
+    info.pAllocationsChanged     = _defragmentationChanged.data();
+    info.maxCpuBytesToMove       = _defragmentationBytes;
+    info.maxCpuAllocationsToMove = _defragmentationAllocations;
+    info.maxGpuBytesToMove       = _defragmentationBytes;
+    info.maxGpuAllocationsToMove = _defragmentationAllocations;
+
+    VmaDefragmentationStats   stats{};
+    VmaDefragmentationContext context = VK_NULL_HANDLE;
+    device->gpuTransportHub()->checkIn(
+        [&](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+            info.commandBuffer = gpuCommandBuffer->vkCommandBuffer;
+            vmaDefragmentationBegin(_device->memoryAllocator, &info, &stats, &context);
+
+            VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+            vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        },
+        true);
+    vmaDefragmentationEnd(_device->memoryAllocator, context);
+
+    // buffers are bound to their memory for life, recreate the moved ones in place
+    for (size_t i = 0U; i < _defragmentationBuffers.size(); ++i) {
+        if (!_defragmentationChanged[i]) continue;
+        CCVKGPUBuffer *gpuBuffer = _defragmentationBuffers[i];
+        vkDestroyBuffer(_device->vkDevice, gpuBuffer->vkBuffer, nullptr);
+
+        VkBufferCreateInfo      bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+        VmaAllocationCreateInfo allocInfo{};
+        fillBufferCreateInfo(device, gpuBuffer, &bufferInfo, &allocInfo);
+        VK_CHECK(vkCreateBuffer(_device->vkDevice, &bufferInfo, nullptr, &gpuBuffer->vkBuffer));
+        VK_CHECK(vmaBindBufferMemory(_device->memoryAllocator, gpuBuffer->vmaAllocation, gpuBuffer->vkBuffer));
+
+        VmaAllocationInfo res;
+        vmaGetAllocationInfo(_device->memoryAllocator, gpuBuffer->vmaAllocation, &res);
+        gpuBuffer->mappedData = reinterpret_cast<uint8_t *>(res.pMappedData);
+        device->gpuDescriptorHub()->update(gpuBuffer);
+    }
+
+    if (!stats.allocationsMoved) {
+        // nothing left to compact within the limits, back off for a while
+        _nextDefragmentationFrame = _frameIndex + _defragmentationInterval * 10;
+    }
+}
+
 VkSampleCountFlagBits CCVKGPUContext::getSampleCountForAttachments(Format format, VkFormat vkFormat, SampleCount sampleCount) const {
     if (sampleCount <= SampleCount::ONE) return VK_SAMPLE_COUNT_1_BIT;
 
@@ -1578,6 +1927,406 @@ VkSampleCountFlagBits CCVKGPUContext::getSampleCountForAttachments(Format format
     return VK_SAMPLE_COUNT_1_BIT;
 }
 
+CCVKGPUTimeline::CCVKGPUTimeline(CCVKGPUDevice *device)
+: _device(device) {
+    VkSemaphoreTypeCreateInfo typeInfo{VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue  = 0U;
+    VkSemaphoreCreateInfo semaphoreInfo{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    semaphoreInfo.pNext = &typeInfo;
+    VK_CHECK(vkCreateSemaphore(_device->vkDevice, &semaphoreInfo, nullptr, &_vkSemaphore));
+}
+
+CCVKGPUTimeline::~CCVKGPUTimeline() {
+    if (_vkSemaphore) {
+        vkDestroySemaphore(_device->vkDevice, _vkSemaphore, nullptr);
+        _vkSemaphore = VK_NULL_HANDLE;
+    }
+}
+
+uint64_t CCVKGPUTimeline::poll() {
+    if (_completedValue < _signaledValue) {
+        VK_CHECK(_device->getSemaphoreCounterValue(_device->vkDevice, _vkSemaphore, &_completedValue));
+    }
+    return _completedValue;
+}
+
+bool CCVKGPUTimeline::isComplete(uint64_t value) {
+    return value <= _completedValue || value <= poll();
+}
+
+void CCVKGPUTimeline::wait(uint64_t value) {
+    if (value <= _completedValue) return;
+
+    VkSemaphoreWaitInfo waitInfo{VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+    waitInfo.semaphoreCount = 1U;
+    waitInfo.pSemaphores    = &_vkSemaphore;
+    waitInfo.pValues        = &value;
+    VK_CHECK(_device->waitSemaphores(_device->vkDevice, &waitInfo, DEFAULT_TIMEOUT));
+    _completedValue = std::max(_completedValue, value);
+}
+
+CCVKGPUAsyncTransferHub::CCVKGPUAsyncTransferHub(CCVKDevice *device, CCVKGPUQueue *graphicsQueue)
+: _device(device),
+  _gpuDevice(device->gpuDevice()),
+  _graphicsQueueFamilyIndex(graphicsQueue->queueFamilyIndex),
+  _acquireBarriers(device->gpuDevice()) {
+    // only a family without graphics and compute capabilities runs on a separate copy engine
+    const auto &families = device->gpuContext()->queueFamilyProperties;
+    for (uint32_t i = 0U; i < utils::toUint(families.size()); ++i) {
+        const VkQueueFlags flags = families[i].queueFlags;
+        if (families[i].queueCount && (flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            _queue.type             = QueueType::TRANSFER;
+            _queue.queueFamilyIndex = i;
+            vkGetDeviceQueue(_gpuDevice->vkDevice, i, 0, &_queue.vkQueue);
+            break;
+        }
+    }
+    if (!isSupported()) return;
+
+    VkCommandPoolCreateInfo poolInfo{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.queueFamilyIndex = _queue.queueFamilyIndex;
+    poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    VK_CHECK(vkCreateCommandPool(_gpuDevice->vkDevice, &poolInfo, nullptr, &_vkCommandPool));
+
+    if (_gpuDevice->useTimelineSemaphore) {
+        _timeline = CC_NEW(CCVKGPUTimeline(_gpuDevice));
+    }
+}
+
+CCVKGPUAsyncTransferHub::~CCVKGPUAsyncTransferHub() {
+    if (!isSupported()) return;
+
+    vkQueueWaitIdle(_queue.vkQueue);
+    for (auto &submission : _submissions) {
+        release(&submission);
+    }
+    _submissions.clear();
+
+    CC_SAFE_DELETE(_timeline)
+    vkDestroyCommandPool(_gpuDevice->vkDevice, _vkCommandPool, nullptr);
+    _vkCommandPool = VK_NULL_HANDLE;
+}
+
+uint8_t *CCVKGPUAsyncTransferHub::beginSubmission(Submission *submission, VkDeviceSize stagingSize) {
+    // staging memory outlives the frame, so it can't come from the per frame staging buffer pool
+    VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size  = stagingSize;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+    VmaAllocationInfo res;
+    VK_CHECK(vmaCreateBuffer(_gpuDevice->memoryAllocator, &bufferInfo, &allocInfo, &submission->stagingBuffer, &submission->stagingAllocation, &res));
+    _gpuDevice->trackAllocation(submission->stagingAllocation, CCVKMemoryCategory::STAGING);
+
+    VkCommandBufferAllocateInfo cmdBuffInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    cmdBuffInfo.commandPool        = _vkCommandPool;
+    cmdBuffInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdBuffInfo.commandBufferCount = 1U;
+    VK_CHECK(vkAllocateCommandBuffers(_gpuDevice->vkDevice, &cmdBuffInfo, &submission->vkCommandBuffer));
+
+    VkCommandBufferBeginInfo beginInfo{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(submission->vkCommandBuffer, &beginInfo));
+
+    return reinterpret_cast<uint8_t *>(res.pMappedData);
+}
+
+uint64_t CCVKGPUAsyncTransferHub::endSubmission(Submission *submission) {
+    VK_CHECK(vkEndCommandBuffer(submission->vkCommandBuffer));
+    submission->value = _timeline ? _timeline->signal() : ++_submittedValue;
+
+    VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submitInfo.commandBufferCount = 1U;
+    submitInfo.pCommandBuffers    = &submission->vkCommandBuffer;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+    VkSemaphore                   timelineSemaphore = VK_NULL_HANDLE;
+    if (_timeline) {
+        timelineSemaphore                      = _timeline->getSemaphore();
+        timelineInfo.signalSemaphoreValueCount = 1U;
+        timelineInfo.pSignalSemaphoreValues    = &submission->value;
+        submitInfo.pNext                       = &timelineInfo;
+        submitInfo.signalSemaphoreCount        = 1U;
+        submitInfo.pSignalSemaphores           = &timelineSemaphore;
+    } else {
+        VkFenceCreateInfo fenceInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        VK_CHECK(vkCreateFence(_gpuDevice->vkDevice, &fenceInfo, nullptr, &submission->vkFence));
+    }
+    VK_CHECK(vkQueueSubmit(_queue.vkQueue, 1, &submitInfo, submission->vkFence));
+
+    const uint64_t value = submission->value;
+    _submissions.push_back(std::move(*submission));
+    return value;
+}
+
+uint64_t CCVKGPUAsyncTransferHub::uploadBuffer(CCVKGPUBuffer *gpuBuffer, const void *data, uint32_t size, const Callback &callback) {
+    // back buffer instances are updated through mapped memory, and partial updates would need
+    // the ownership of the preserved contents released by the graphics queue first
+    if (!isSupported() || gpuBuffer->instanceSize || gpuBuffer->memUsage != MemoryUsage::DEVICE || size != gpuBuffer->size || isPending(gpuBuffer)) {
+        return 0U;
+    }
+
+    Submission submission;
+    submission.gpuBuffer = gpuBuffer;
+    submission.callback  = callback;
+    memcpy(beginSubmission(&submission, size), data, size);
+
+    VkBufferCopy region{0U, gpuBuffer->startOffset, size};
+    vkCmdCopyBuffer(submission.vkCommandBuffer, submission.stagingBuffer, gpuBuffer->vkBuffer, 1, &region);
+
+    VkBufferMemoryBarrier releaseBarrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+    releaseBarrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    releaseBarrier.srcQueueFamilyIndex = _queue.queueFamilyIndex;
+    releaseBarrier.dstQueueFamilyIndex = _graphicsQueueFamilyIndex;
+    releaseBarrier.buffer              = gpuBuffer->vkBuffer;
+    releaseBarrier.offset              = gpuBuffer->startOffset;
+    releaseBarrier.size                = size;
+    vkCmdPipelineBarrier(submission.vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 1, &releaseBarrier, 0, nullptr);
+
+    return endSubmission(&submission);
+}
+
+uint64_t CCVKGPUAsyncTransferHub::uploadTexture(CCVKGPUTexture *gpuTexture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count,
+                                                const Callback &callback) {
+    // only textures never used by the graphics queue can be written without a release from it first,
+    // mipmap generation needs blits, which the transfer queue can't do
+    if (!isSupported() || !gpuTexture->vkImage || !gpuTexture->currentAccessTypes.empty() || hasFlag(gpuTexture->flags, TextureFlags::GEN_MIPMAP) ||
+        isPending(gpuTexture)) {
+        return 0U;
+    }
+
+    ccstd::vector<VkDeviceSize> regionSizes(count);
+    VkDeviceSize                stagingSize = 0U;
+    const VkDeviceSize          alignment   = GFX_FORMAT_INFOS[toNumber(gpuTexture->format)].size;
+    for (uint32_t i = 0U; i < count; ++i) {
+        const BufferTextureCopy &region       = regions[i];
+        uint32_t                 regionWidth  = region.buffStride > 0 ? region.buffStride : region.texExtent.width;
+        uint32_t                 regionHeight = region.buffTexHeight > 0 ? region.buffTexHeight : region.texExtent.height;
+        regionSizes[i]                        = formatSize(gpuTexture->format, regionWidth, regionHeight, region.texExtent.depth);
+        stagingSize                           = roundUp(stagingSize, alignment) + regionSizes[i];
+    }
+    if (!stagingSize) return 0U;
+
+    Submission submission;
+    submission.gpuTexture = gpuTexture;
+    submission.callback   = callback;
+    uint8_t *mappedData   = beginSubmission(&submission, stagingSize);
+
+    VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image               = gpuTexture->vkImage;
+    barrier.subresourceRange    = {gpuTexture->aspectMask, 0U, VK_REMAINING_MIP_LEVELS, 0U, VK_REMAINING_ARRAY_LAYERS};
+    vkCmdPipelineBarrier(submission.vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    ccstd::vector<VkBufferImageCopy> copies(count);
+    VkDeviceSize                     offset = 0U;
+    for (uint32_t i = 0U; i < count; ++i) {
+        const BufferTextureCopy &region = regions[i];
+        offset                          = roundUp(offset, alignment);
+        memcpy(mappedData + offset, buffers[i], regionSizes[i]);
+
+        VkBufferImageCopy &copy = copies[i];
+        copy.bufferOffset       = offset;
+        copy.bufferRowLength    = region.buffStride;
+        copy.bufferImageHeight  = region.buffTexHeight;
+        copy.imageSubresource   = {gpuTexture->aspectMask, region.texSubres.mipLevel, region.texSubres.baseArrayLayer, region.texSubres.layerCount};
+        copy.imageOffset        = {region.texOffset.x, region.texOffset.y, region.texOffset.z};
+        copy.imageExtent        = {region.texExtent.width, region.texExtent.height, region.texExtent.depth};
+        offset += regionSizes[i];
+    }
+    vkCmdCopyBufferToImage(submission.vkCommandBuffer, submission.stagingBuffer, gpuTexture->vkImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, count, copies.data());
+
+    // the layout stays the same, the graphics queue acquires it as a transfer destination
+    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask       = 0U;
+    barrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = _queue.queueFamilyIndex;
+    barrier.dstQueueFamilyIndex = _graphicsQueueFamilyIndex;
+    vkCmdPipelineBarrier(submission.vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    return endSubmission(&submission);
+}
+
+void CCVKGPUAsyncTransferHub::poll() {
+    if (_timeline) {
+        _completedValue = _timeline->poll();
+    } else {
+        // submissions on the same queue complete in order
+        for (const auto &submission : _submissions) {
+            if (vkGetFenceStatus(_gpuDevice->vkDevice, submission.vkFence) != VK_SUCCESS) break;
+            _completedValue = submission.value;
+        }
+    }
+}
+
+void CCVKGPUAsyncTransferHub::wait(uint64_t value) {
+    if (value <= _completedValue) return;
+    if (_timeline) {
+        _timeline->wait(value);
+    } else {
+        for (const auto &submission : _submissions) {
+            if (submission.value == value) {
+                VK_CHECK(vkWaitForFences(_gpuDevice->vkDevice, 1, &submission.vkFence, VK_TRUE, DEFAULT_TIMEOUT));
+                break;
+            }
+        }
+    }
+    poll();
+}
+
+void CCVKGPUAsyncTransferHub::release(Submission *submission) {
+    _gpuDevice->untrackAllocation(submission->stagingAllocation);
+    vmaDestroyBuffer(_gpuDevice->memoryAllocator, submission->stagingBuffer, submission->stagingAllocation);
+    vkFreeCommandBuffers(_gpuDevice->vkDevice, _vkCommandPool, 1, &submission->vkCommandBuffer);
+    if (submission->vkFence) {
+        vkDestroyFence(_gpuDevice->vkDevice, submission->vkFence, nullptr);
+    }
+    *submission = Submission();
+}
+
+void CCVKGPUAsyncTransferHub::update() {
+    if (_submissions.empty()) return;
+
+    poll();
+    _completed.clear();
+    while (!_submissions.empty() && _submissions.front().value <= _completedValue) {
+        _completed.push_back(std::move(_submissions.front()));
+        _submissions.pop_front();
+    }
+    if (_completed.empty()) return;
+
+    // the upload is complete on the host side, so acquiring it doesn't need to wait on a semaphore
+    _device->gpuTransportHub()->checkIn([this](const CCVKGPUCommandBuffer *gpuCommandBuffer) {
+        for (const auto &submission : _completed) {
+            if (submission.gpuBuffer) {
+                VkBufferMemoryBarrier acquireBarrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+                acquireBarrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+                acquireBarrier.srcQueueFamilyIndex = _queue.queueFamilyIndex;
+                acquireBarrier.dstQueueFamilyIndex = _graphicsQueueFamilyIndex;
+                acquireBarrier.buffer              = submission.gpuBuffer->vkBuffer;
+                acquireBarrier.offset              = submission.gpuBuffer->startOffset;
+                acquireBarrier.size                = submission.gpuBuffer->size;
+                _acquireBarriers.add(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, acquireBarrier);
+            } else if (submission.gpuTexture) {
+                VkImageMemoryBarrier acquireBarrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+                acquireBarrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+                acquireBarrier.oldLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                acquireBarrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                acquireBarrier.srcQueueFamilyIndex = _queue.queueFamilyIndex;
+                acquireBarrier.dstQueueFamilyIndex = _graphicsQueueFamilyIndex;
+                acquireBarrier.image               = submission.gpuTexture->vkImage;
+                acquireBarrier.subresourceRange    = {submission.gpuTexture->aspectMask, 0U, VK_REMAINING_MIP_LEVELS, 0U, VK_REMAINING_ARRAY_LAYERS};
+                _acquireBarriers.add(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, acquireBarrier);
+            }
+        }
+        _acquireBarriers.flush(gpuCommandBuffer->vkCommandBuffer);
+    });
+
+    // from here on the resources are in the same state as after a synchronous upload
+    for (auto &submission : _completed) {
+        if (submission.gpuBuffer) {
+            submission.gpuBuffer->transferAccess = THSVS_ACCESS_TRANSFER_WRITE;
+            _device->gpuBarrierManager()->checkIn(submission.gpuBuffer);
+        } else if (submission.gpuTexture) {
+            submission.gpuTexture->currentAccessTypes.assign({THSVS_ACCESS_TRANSFER_WRITE});
+            submission.gpuTexture->transferAccess = THSVS_ACCESS_TRANSFER_WRITE;
+            _device->gpuBarrierManager()->checkIn(submission.gpuTexture);
+        }
+        Callback callback = std::move(submission.callback);
+        release(&submission);
+        if (callback) callback();
+    }
+    _completed.clear();
+}
+
+template <typename T>
+bool CCVKGPUAsyncTransferHub::isPending(const T *resource) const {
+    return std::any_of(_submissions.begin(), _submissions.end(), [resource](const Submission &submission) {
+        return submission.gpuBuffer == static_cast<const void *>(resource) || submission.gpuTexture == static_cast<const void *>(resource);
+    });
+}
+
+template <typename T>
+bool CCVKGPUAsyncTransferHub::waitFor(const T *resource, bool detach) {
+    bool pending = false;
+    for (auto &submission : _submissions) {
+        if (submission.gpuBuffer != static_cast<const void *>(resource) && submission.gpuTexture != static_cast<const void *>(resource)) continue;
+        wait(submission.value);
+        if (detach) {
+            submission.gpuBuffer  = nullptr;
+            submission.gpuTexture = nullptr;
+        }
+        pending = true;
+    }
+    return pending;
+}
+
+void CCVKGPUAsyncTransferHub::finish(const CCVKGPUBuffer *gpuBuffer) {
+    if (waitFor(gpuBuffer, false)) update();
+}
+
+void CCVKGPUAsyncTransferHub::finish(const CCVKGPUTexture *gpuTexture) {
+    if (waitFor(gpuTexture, false)) update();
+}
+
+void CCVKGPUAsyncTransferHub::cancel(const CCVKGPUBuffer *gpuBuffer) {
+    waitFor(gpuBuffer, true);
+}
+
+void CCVKGPUAsyncTransferHub::cancel(const CCVKGPUTexture *gpuTexture) {
+    waitFor(gpuTexture, true);
+}
+
+void CCVKGPUBarrierBatch::add(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, const VkBufferMemoryBarrier &barrier) {
+    _srcStageMask |= srcStageMask;
+    _dstStageMask |= dstStageMask;
+    _bufferBarriers.push_back(barrier);
+    ++_count;
+}
+
+void CCVKGPUBarrierBatch::add(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, const VkImageMemoryBarrier &barrier) {
+    _srcStageMask |= srcStageMask;
+    _dstStageMask |= dstStageMask;
+    _imageBarriers.push_back(barrier);
+    ++_count;
+}
+
+void CCVKGPUBarrierBatch::flush(VkCommandBuffer vkCommandBuffer) {
+    if (!_count) return;
+
+    vkCmdPipelineBarrier(vkCommandBuffer, _srcStageMask, _dstStageMask, 0, 0, nullptr,
+                         utils::toUint(_bufferBarriers.size()), _bufferBarriers.data(),
+                         utils::toUint(_imageBarriers.size()), _imageBarriers.data());
+    ++_device->barrierStats.issued;
+    _device->barrierStats.merged += _count - 1;
+
+    _srcStageMask = 0U;
+    _dstStageMask = 0U;
+    _bufferBarriers.clear();
+    _imageBarriers.clear();
+    _count = 0U;
+}
+
+bool CCVKGPUBarrierBatch::isRedundant(const ThsvsImageBarrier &barrier) {
+    return isKeepingContents(barrier) && isReadOnly(barrier.pPrevAccesses, barrier.prevAccessCount) &&
+           isSameAccesses(barrier.pPrevAccesses, barrier.prevAccessCount, barrier.pNextAccesses, barrier.nextAccessCount);
+}
+
+bool CCVKGPUBarrierBatch::isSatisfied(const ThsvsImageBarrier &barrier, const ThsvsAccessType *currentAccesses, uint32_t currentAccessCount) {
+    return isKeepingContents(barrier) && isReadOnly(barrier.pPrevAccesses, barrier.prevAccessCount) && isReadOnly(currentAccesses, currentAccessCount) &&
+           isSameAccesses(currentAccesses, currentAccessCount, barrier.pNextAccesses, barrier.nextAccessCount);
+}
+
 void CCVKGPUBarrierManager::update(CCVKGPUTransportHub *transportHub) {
     if (_buffersToBeChecked.empty() && _texturesToBeChecked.empty()) return;
 
@@ -1590,9 +2339,11 @@ void CCVKGPUBarrierManager::update(CCVKGPUTransportHub *transportHub) {
     prevAccesses.clear();
     nextAccesses.clear();
 
+    uint32_t barrierCount = 0U;
     for (CCVKGPUBuffer *gpuBuffer : _buffersToBeChecked) {
         ccstd::vector<ThsvsAccessType> &render = gpuBuffer->renderAccessTypes;
         if (gpuBuffer->transferAccess == THSVS_ACCESS_NONE) continue;
+        ++barrierCount;
         if (std::find(prevAccesses.begin(), prevAccesses.end(), gpuBuffer->transferAccess) == prevAccesses.end()) {
             prevAccesses.push_back(gpuBuffer->transferAccess);
         }
@@ -1629,6 +2380,7 @@ void CCVKGPUBarrierManager::update(CCVKGPUTransportHub *transportHub) {
     for (CCVKGPUTexture *gpuTexture : _texturesToBeChecked) {
         ccstd::vector<ThsvsAccessType> &render = gpuTexture->renderAccessTypes;
         if (gpuTexture->transferAccess == THSVS_ACCESS_NONE || render.empty()) continue;
+        ++barrierCount;
         ccstd::vector<ThsvsAccessType> &current  = gpuTexture->currentAccessTypes;
         imageBarrier.pPrevAccesses               = &gpuTexture->transferAccess;
         imageBarrier.nextAccessCount             = utils::toUint(render.size());
@@ -1655,6 +2407,8 @@ void CCVKGPUBarrierManager::update(CCVKGPUTransportHub *transportHub) {
             vkCmdPipelineBarrier(gpuCommandBuffer->vkCommandBuffer, srcStageMask, dstStageMask, 0,
                                  pVkBarrier ? 1 : 0, pVkBarrier, 0, nullptr, utils::toUint(vkImageBarriers.size()), vkImageBarriers.data());
         });
+        ++_device->barrierStats.issued;
+        _device->barrierStats.merged += barrierCount - 1;
     }
 
     _buffersToBeChecked.clear();
@@ -47,6 +47,7 @@
 #include "states/VKSampler.h"
 #include "states/VKTextureBarrier.h"
 
+#include "gfx-base/GFXCacheFile.h"
 #include "gfx-base/SPIRVUtils.h"
 #include "profiler/Profiler.h"
 
@@ -73,6 +74,25 @@ static VkResult VKAPI_PTR vkCreateRenderPass2KHRFallback(
     const VkAllocationCallbacks *  pAllocator,
     VkRenderPass *                 pRenderPass);
 
+namespace {
+constexpr char PIPELINE_CACHE_FILE[]        = "vk_pipeline_cache.bin";
+constexpr auto PIPELINE_CACHE_SAVE_INTERVAL = std::chrono::seconds(30);
+
+// the cache data is only valid for the exact same device and driver
+struct PipelineCacheKey {
+    uint32_t vendorID{0};
+    uint32_t deviceID{0};
+    uint32_t driverVersion{0};
+    uint8_t  uuid[VK_UUID_SIZE]{};
+};
+
+PipelineCacheKey getPipelineCacheKey(const VkPhysicalDeviceProperties &props) {
+    PipelineCacheKey key{props.vendorID, props.deviceID, props.driverVersion};
+    memcpy(key.uuid, props.pipelineCacheUUID, VK_UUID_SIZE);
+    return key;
+}
+} // namespace
+
 CCVKDevice *CCVKDevice::instance = nullptr;
 
 CCVKDevice *CCVKDevice::getInstance() {
@@ -118,12 +138,29 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     };
     if (_gpuDevice->minorVersion < 2) {
         requestedExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+        requestedExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
     }
     if (_gpuDevice->minorVersion < 1) {
         requestedExtensions.push_back(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
         requestedExtensions.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
         requestedExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
     }
+#if defined(VK_EXT_pipeline_creation_feedback)
+    // only used to report pipeline cache hits
+    requestedExtensions.push_back(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+#endif
+    // per heap budget tracking
+    requestedExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (_gpuDevice->minorVersion == 1) {
+        // core in 1.2
+        requestedExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+    }
+#if defined(VK_KHR_dynamic_rendering)
+    if (_gpuDevice->minorVersion >= 2) {
+        // depends on VK_KHR_depth_stencil_resolve, which is core in 1.2
+        requestedExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+    }
+#endif
 
     VkPhysicalDeviceFeatures2        requestedFeatures2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
     VkPhysicalDeviceVulkan11Features requestedVulkan11Features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES};
@@ -135,6 +172,12 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     requestedFeatures2.features.samplerAnisotropy          = deviceFeatures.samplerAnisotropy;
     requestedFeatures2.features.depthBounds                = deviceFeatures.depthBounds;
     requestedFeatures2.features.multiDrawIndirect          = deviceFeatures.multiDrawIndirect;
+    requestedVulkan12Features.drawIndirectCount            = _gpuContext->physicalDeviceVulkan12Features.drawIndirectCount;
+    requestedVulkan12Features.timelineSemaphore            = _gpuContext->physicalDeviceVulkan12Features.timelineSemaphore;
+    requestedVulkan11Features.multiview                    = _gpuContext->physicalDeviceVulkan11Features.multiview;
+
+    // bindless texture tables indexed by instance attributes
+    requestedVulkan12Features.shaderSampledImageArrayNonUniformIndexing = _gpuContext->physicalDeviceVulkan12Features.shaderSampledImageArrayNonUniformIndexing;
 
     if (_gpuContext->validationEnabled) {
         requestedLayers.push_back("VK_LAYER_KHRONOS_validation");
@@ -182,6 +225,27 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
         }
     }
 
+    // the context only queries the 1.2 feature structs, which are not available on 1.1
+    VkPhysicalDeviceTimelineSemaphoreFeatures requestedTimelineSemaphoreFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
+    if (_gpuDevice->minorVersion == 1 && isExtensionSupported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, _gpuDevice->extensions)) {
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES};
+        VkPhysicalDeviceFeatures2                 features2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        features2.pNext = &timelineSemaphoreFeatures;
+        vkGetPhysicalDeviceFeatures2(_gpuContext->physicalDevice, &features2);
+        requestedTimelineSemaphoreFeatures.timelineSemaphore = timelineSemaphoreFeatures.timelineSemaphore;
+    }
+
+#if defined(VK_KHR_dynamic_rendering)
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR requestedDynamicRenderingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR};
+    if (_gpuDevice->minorVersion >= 2 && isExtensionSupported(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, _gpuDevice->extensions)) {
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR};
+        VkPhysicalDeviceFeatures2                   features2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        features2.pNext = &dynamicRenderingFeatures;
+        vkGetPhysicalDeviceFeatures2(_gpuContext->physicalDevice, &features2);
+        requestedDynamicRenderingFeatures.dynamicRendering = dynamicRenderingFeatures.dynamicRendering;
+    }
+#endif
+
     // prepare the device queues
     uint32_t                               queueFamilyPropertiesCount = utils::toUint(_gpuContext->queueFamilyProperties.size());
     ccstd::vector<VkDeviceQueueCreateInfo> queueCreateInfos(queueFamilyPropertiesCount, {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO});
@@ -214,7 +278,15 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
         if (_gpuDevice->minorVersion >= 2) {
             requestedFeatures2.pNext        = &requestedVulkan11Features;
             requestedVulkan11Features.pNext = &requestedVulkan12Features;
+        } else if (requestedTimelineSemaphoreFeatures.timelineSemaphore) {
+            requestedFeatures2.pNext = &requestedTimelineSemaphoreFeatures;
         }
+#if defined(VK_KHR_dynamic_rendering)
+        if (requestedDynamicRenderingFeatures.dynamicRendering) {
+            requestedDynamicRenderingFeatures.pNext = requestedFeatures2.pNext;
+            requestedFeatures2.pNext                = &requestedDynamicRenderingFeatures;
+        }
+#endif
     }
 
     VK_CHECK(vkCreateDevice(_gpuContext->physicalDevice, &deviceCreateInfo, nullptr, &_gpuDevice->vkDevice));
@@ -283,6 +355,9 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
 
     _gpuDevice->useMultiDrawIndirect        = deviceFeatures.multiDrawIndirect;
     _gpuDevice->useDescriptorUpdateTemplate = _gpuDevice->minorVersion > 0 || checkExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+#if defined(VK_EXT_pipeline_creation_feedback)
+    _gpuDevice->usePipelineCreationFeedback = checkExtension(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+#endif
 
     if (_gpuDevice->minorVersion > 1) {
         _gpuDevice->createRenderPass2 = vkCreateRenderPass2;
@@ -292,6 +367,40 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
         _gpuDevice->createRenderPass2 = vkCreateRenderPass2KHRFallback;
     }
 
+    if (_gpuDevice->minorVersion > 1) {
+        if (_gpuContext->physicalDeviceVulkan12Features.timelineSemaphore) {
+            _gpuDevice->waitSemaphores           = vkWaitSemaphores;
+            _gpuDevice->getSemaphoreCounterValue = vkGetSemaphoreCounterValue;
+        }
+    } else if (requestedTimelineSemaphoreFeatures.timelineSemaphore) {
+        _gpuDevice->waitSemaphores           = vkWaitSemaphoresKHR;
+        _gpuDevice->getSemaphoreCounterValue = vkGetSemaphoreCounterValueKHR;
+    }
+    _gpuDevice->useTimelineSemaphore = _gpuDevice->waitSemaphores != nullptr;
+
+#if defined(VK_KHR_dynamic_rendering)
+    // not known to the bundled volk, so loaded here
+    if (requestedDynamicRenderingFeatures.dynamicRendering && checkExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)) {
+        _gpuDevice->cmdBeginRendering = reinterpret_cast<PFN_vkCmdBeginRenderingKHR>(vkGetDeviceProcAddr(_gpuDevice->vkDevice, "vkCmdBeginRenderingKHR"));
+        _gpuDevice->cmdEndRendering   = reinterpret_cast<PFN_vkCmdEndRenderingKHR>(vkGetDeviceProcAddr(_gpuDevice->vkDevice, "vkCmdEndRenderingKHR"));
+    }
+    _gpuDevice->useDynamicRendering = _gpuDevice->cmdBeginRendering && _gpuDevice->cmdEndRendering;
+#endif
+
+    if (_gpuDevice->minorVersion > 1) {
+        if (_gpuContext->physicalDeviceVulkan12Features.drawIndirectCount) {
+            _gpuDevice->cmdDrawIndirectCount        = vkCmdDrawIndirectCount;
+            _gpuDevice->cmdDrawIndexedIndirectCount = vkCmdDrawIndexedIndirectCount;
+        }
+    } else if (checkExtension(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME)) {
+        _gpuDevice->cmdDrawIndirectCount        = vkCmdDrawIndirectCountKHR;
+        _gpuDevice->cmdDrawIndexedIndirectCount = vkCmdDrawIndexedIndirectCountKHR;
+    }
+
+    _features[toNumber(Feature::MULTI_DRAW_INDIRECT)]  = _gpuDevice->useMultiDrawIndirect;
+    _features[toNumber(Feature::DRAW_INDIRECT_COUNT)]  = _gpuDevice->cmdDrawIndirectCount != nullptr;
+    _features[toNumber(Feature::ASYNC_PIPELINE_STATE)] = true;
+
     const VkPhysicalDeviceLimits &limits = _gpuContext->physicalDeviceProperties.limits;
     _caps.maxVertexAttributes            = limits.maxVertexInputAttributes;
     _caps.maxVertexUniformVectors        = limits.maxUniformBufferRange / 16;
@@ -305,6 +414,16 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     _caps.maxTextureSize                 = limits.maxImageDimension2D;
     _caps.maxCubeMapTextureSize          = limits.maxImageDimensionCube;
     _caps.uboOffsetAlignment             = utils::toUint(limits.minUniformBufferOffsetAlignment);
+
+    // leaves room for the regular bindings of a stage next to a full table
+    const uint32_t bindlessTextureLimit            = std::min(limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages);
+    _features[toNumber(Feature::BINDLESS_TEXTURE)] = _gpuDevice->minorVersion > 1 &&
+                                                     requestedVulkan12Features.shaderSampledImageArrayNonUniformIndexing &&
+                                                     bindlessTextureLimit >= 2 * MAX_BINDLESS_TEXTURES;
+
+    // core since 1.1, every implementation supporting it renders at least six views
+    _features[toNumber(Feature::MULTIVIEW)] = _gpuDevice->minorVersion > 1 && requestedVulkan11Features.multiview;
+
     // compute shaders
     _caps.maxComputeSharedMemorySize     = limits.maxComputeSharedMemorySize;
     _caps.maxComputeWorkGroupInvocations = limits.maxComputeWorkGroupInvocations;
@@ -314,6 +433,9 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     // UNASSIGNED-BestPractices-vkCreateComputePipelines-compute-work-group-size
     _caps.maxComputeWorkGroupInvocations = std::min(_caps.maxComputeWorkGroupInvocations, 64U);
 #endif // defined(VK_USE_PLATFORM_ANDROID_KHR)
+    // timestamps on all graphics and compute queues
+    _caps.supportTimestampQuery = limits.timestampComputeAndGraphics == VK_TRUE;
+    _caps.timestampPeriod       = limits.timestampPeriod;
 
     ///////////////////// Resource Initialization /////////////////////
 
@@ -377,6 +499,9 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
         } else if (checkExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
             vmaVulkanFunc.vkGetPhysicalDeviceMemoryProperties2KHR = vkGetPhysicalDeviceMemoryProperties2KHR;
         }
+        if (vmaVulkanFunc.vkGetPhysicalDeviceMemoryProperties2KHR) {
+            allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
     }
 
     allocatorInfo.pVulkanFunctions = &vmaVulkanFunc;
@@ -389,14 +514,23 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
         _gpuRecycleBins.push_back(CC_NEW(CCVKGPURecycleBin(_gpuDevice)));
         _gpuStagingBufferPools.push_back(CC_NEW(CCVKGPUStagingBufferPool(_gpuDevice)));
     }
+    _frameTimelineValues.assign(backBufferCount, 0U);
+
+    if (_gpuDevice->useTimelineSemaphore) {
+        _gpuTimeline = CC_NEW(CCVKGPUTimeline(_gpuDevice));
+    }
 
     _gpuBufferHub        = CC_NEW(CCVKGPUBufferHub(_gpuDevice));
-    _gpuTransportHub     = CC_NEW(CCVKGPUTransportHub(_gpuDevice, static_cast<CCVKQueue *>(_queue)->gpuQueue()));
+    _gpuTransportHub     = CC_NEW(CCVKGPUTransportHub(_gpuDevice, static_cast<CCVKQueue *>(_queue)->gpuQueue(), _gpuTimeline));
     _gpuDescriptorHub    = CC_NEW(CCVKGPUDescriptorHub(_gpuDevice));
     _gpuSemaphorePool    = CC_NEW(CCVKGPUSemaphorePool(_gpuDevice));
     _gpuBarrierManager   = CC_NEW(CCVKGPUBarrierManager(_gpuDevice));
     _gpuFramebufferHub   = CC_NEW(CCVKGPUFramebufferHub);
     _gpuDescriptorSetHub = CC_NEW(CCVKGPUDescriptorSetHub(_gpuDevice));
+    _gpuMemoryHub        = CC_NEW(CCVKGPUMemoryHub(_gpuDevice));
+
+    _gpuAsyncTransferHub = CC_NEW(CCVKGPUAsyncTransferHub(this, static_cast<CCVKQueue *>(_queue)->gpuQueue()));
+    _gpuReadbackHub      = CC_NEW(CCVKGPUReadbackHub(_gpuDevice));
 
     _gpuDescriptorHub->link(_gpuDescriptorSetHub);
 
@@ -439,8 +573,7 @@ bool CCVKDevice::doInit(const DeviceInfo & /*info*/) {
     getAccessTypes(AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE, _gpuDevice->defaultDepthStencilBarrier.nextAccesses);
     cmdFuncCCVKCreateGeneralBarrier(this, &_gpuDevice->defaultDepthStencilBarrier);
 
-    VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
-    VK_CHECK(vkCreatePipelineCache(_gpuDevice->vkDevice, &pipelineCacheInfo, nullptr, &_gpuDevice->vkPipelineCache));
+    loadPipelineCache();
 
     ///////////////////// Print Debug Info /////////////////////
 
@@ -494,6 +627,8 @@ void CCVKDevice::doDestroy() {
     CC_SAFE_DESTROY_AND_DELETE(_queue)
     CC_SAFE_DESTROY_AND_DELETE(_cmdBuff)
 
+    CC_SAFE_DELETE(_gpuAsyncTransferHub)
+    CC_SAFE_DELETE(_gpuReadbackHub)
     CC_SAFE_DELETE(_gpuBufferHub)
     CC_SAFE_DELETE(_gpuTransportHub)
     CC_SAFE_DELETE(_gpuSemaphorePool)
@@ -501,6 +636,8 @@ void CCVKDevice::doDestroy() {
     CC_SAFE_DELETE(_gpuBarrierManager)
     CC_SAFE_DELETE(_gpuFramebufferHub)
     CC_SAFE_DELETE(_gpuDescriptorSetHub)
+    CC_SAFE_DELETE(_gpuMemoryHub)
+    CC_SAFE_DELETE(_gpuTimeline)
 
     uint32_t backBufferCount = _gpuDevice->backBufferCount;
     for (uint32_t i = 0U; i < backBufferCount; i++) {
@@ -513,14 +650,17 @@ void CCVKDevice::doDestroy() {
     _gpuStagingBufferPools.clear();
     _gpuRecycleBins.clear();
     _gpuFencePools.clear();
+    _frameTimelineValues.clear();
 
     if (_gpuDevice) {
         if (_gpuDevice->vkPipelineCache) {
+            savePipelineCache();
             vkDestroyPipelineCache(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, nullptr);
             _gpuDevice->vkPipelineCache = VK_NULL_HANDLE;
         }
 
         if (_gpuDevice->defaultBuffer.vkBuffer) {
+            _gpuDevice->untrackAllocation(_gpuDevice->defaultBuffer.vmaAllocation);
             vmaDestroyBuffer(_gpuDevice->memoryAllocator, _gpuDevice->defaultBuffer.vkBuffer, _gpuDevice->defaultBuffer.vmaAllocation);
             _gpuDevice->defaultBuffer.vkBuffer      = VK_NULL_HANDLE;
             _gpuDevice->defaultBuffer.vmaAllocation = VK_NULL_HANDLE;
@@ -530,6 +670,7 @@ void CCVKDevice::doDestroy() {
             _gpuDevice->defaultTextureView.vkImageView = VK_NULL_HANDLE;
         }
         if (_gpuDevice->defaultTexture.vkImage) {
+            _gpuDevice->untrackAllocation(_gpuDevice->defaultTexture.vmaAllocation);
             vmaDestroyImage(_gpuDevice->memoryAllocator, _gpuDevice->defaultTexture.vkImage, _gpuDevice->defaultTexture.vmaAllocation);
             _gpuDevice->defaultTexture.vkImage       = VK_NULL_HANDLE;
             _gpuDevice->defaultTexture.vmaAllocation = VK_NULL_HANDLE;
@@ -601,6 +742,8 @@ VkImageMemoryBarrier presentBarrier{
 void CCVKDevice::acquire(Swapchain *const *swapchains, uint32_t count) {
     if (_onAcquire) _onAcquire->execute();
 
+    _gpuAsyncTransferHub->update();
+
     auto *queue = static_cast<CCVKQueue *>(_queue);
     queue->gpuQueue()->lastSignaledSemaphores.clear();
     vkSwapchainIndices.clear();
@@ -686,24 +829,91 @@ void CCVKDevice::present() {
         }
     }
 
+    if (_gpuTimeline) {
+        _frameTimelineValues[_gpuDevice->curBackBufferIndex] = _gpuTimeline->getSignaledValue();
+    }
+    _gpuDevice->lastBarrierStats = _gpuDevice->barrierStats;
+    _gpuDevice->barrierStats     = {};
+
     _gpuDevice->curBackBufferIndex = (_gpuDevice->curBackBufferIndex + 1) % _gpuDevice->backBufferCount;
 
-    uint32_t fenceCount = gpuFencePool()->size();
-    if (fenceCount) {
-        VK_CHECK(vkWaitForFences(_gpuDevice->vkDevice, fenceCount,
-                                 gpuFencePool()->data(), VK_TRUE, DEFAULT_TIMEOUT));
+    if (_gpuTimeline) {
+        // everything submitted in the frame that last used this back buffer is done
+        _gpuTimeline->wait(_frameTimelineValues[_gpuDevice->curBackBufferIndex]);
+    } else {
+        uint32_t fenceCount = gpuFencePool()->size();
+        if (fenceCount) {
+            VK_CHECK(vkWaitForFences(_gpuDevice->vkDevice, fenceCount,
+                                     gpuFencePool()->data(), VK_TRUE, DEFAULT_TIMEOUT));
+        }
     }
 
     gpuFencePool()->reset();
     gpuRecycleBin()->clear();
     gpuStagingBufferPool()->reset();
+    _gpuMemoryHub->update(this);
+
+    _gpuReadbackHub->update([this](uint32_t handle, const uint8_t *data) {
+        finishTextureReadback(handle, data);
+    });
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _pipelineCacheSaveTime > PIPELINE_CACHE_SAVE_INTERVAL) {
+        savePipelineCache();
+        _pipelineCacheSaveTime = now;
+    }
+}
+
+void CCVKDevice::loadPipelineCache() {
+    const PipelineCacheKey key = getPipelineCacheKey(_gpuContext->physicalDeviceProperties);
+    ccstd::vector<uint8_t> data;
+    CacheFile::load(PIPELINE_CACHE_FILE, &key, sizeof(key), data);
+
+    VkPipelineCacheCreateInfo pipelineCacheInfo{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    pipelineCacheInfo.initialDataSize = data.size();
+    pipelineCacheInfo.pInitialData    = data.data();
+    if (vkCreatePipelineCache(_gpuDevice->vkDevice, &pipelineCacheInfo, nullptr, &_gpuDevice->vkPipelineCache) != VK_SUCCESS) {
+        // the driver may still reject the data, start over with an empty cache
+        pipelineCacheInfo.initialDataSize = 0;
+        pipelineCacheInfo.pInitialData    = nullptr;
+        VK_CHECK(vkCreatePipelineCache(_gpuDevice->vkDevice, &pipelineCacheInfo, nullptr, &_gpuDevice->vkPipelineCache));
+        data.clear();
+    }
+
+    _pipelineCacheSize     = data.size();
+    _pipelineCacheSaveTime = std::chrono::steady_clock::now();
+    CC_LOG_INFO("Vulkan pipeline cache loaded: %u bytes", utils::toUint(data.size()));
+}
+
+void CCVKDevice::savePipelineCache() {
+    size_t size = 0;
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, nullptr));
+    // the cache only grows, nothing new to save if the size stays the same
+    if (size == _pipelineCacheSize) {
+        return;
+    }
+
+    ccstd::vector<uint8_t> data(size);
+    VK_CHECK(vkGetPipelineCacheData(_gpuDevice->vkDevice, _gpuDevice->vkPipelineCache, &size, data.data()));
+
+    const PipelineCacheKey key = getPipelineCacheKey(_gpuContext->physicalDeviceProperties);
+    if (CacheFile::save(PIPELINE_CACHE_FILE, &key, sizeof(key), data.data(), utils::toUint(size))) {
+        _pipelineCacheSize = size;
+    }
 }
 
+const CCVKGPUBarrierStats &CCVKDevice::getBarrierStats() const { return _gpuDevice->lastBarrierStats; }
+
 CCVKGPUFencePool *        CCVKDevice::gpuFencePool() { return _gpuFencePools[_gpuDevice->curBackBufferIndex]; }
 CCVKGPURecycleBin *       CCVKDevice::gpuRecycleBin() { return _gpuRecycleBins[_gpuDevice->curBackBufferIndex]; }
 CCVKGPUStagingBufferPool *CCVKDevice::gpuStagingBufferPool() { return _gpuStagingBufferPools[_gpuDevice->curBackBufferIndex]; }
 
 void CCVKDevice::waitAllFences() {
+    if (_gpuTimeline) {
+        _gpuTimeline->wait(_gpuTimeline->getSignaledValue());
+        return;
+    }
+
     static ccstd::vector<VkFence> fences;
     fences.clear();
 
@@ -727,6 +937,7 @@ void CCVKDevice::updateBackBufferCount(uint32_t backBufferCount) {
         _gpuRecycleBins.push_back(CC_NEW(CCVKGPURecycleBin(_gpuDevice)));
         _gpuStagingBufferPools.push_back(CC_NEW(CCVKGPUStagingBufferPool(_gpuDevice)));
     }
+    _frameTimelineValues.resize(backBufferCount, 0U);
     _gpuBufferHub->updateBackBufferCount(backBufferCount);
     _gpuDescriptorSetHub->updateBackBufferCount(backBufferCount);
     _gpuDevice->backBufferCount = backBufferCount;
@@ -838,8 +1049,34 @@ TextureBarrier *CCVKDevice::createTextureBarrier(const TextureBarrierInfo &info)
     return CC_NEW(CCVKTextureBarrier(info));
 }
 
+uint64_t CCVKDevice::copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count,
+                                               const std::function<void()> &callback) {
+    CC_PROFILE(CCVKDeviceCopyBuffersToTextureAsync);
+    uint64_t handle = _gpuAsyncTransferHub->uploadTexture(static_cast<CCVKTexture *>(dst)->gpuTexture(), buffers, regions, count, callback);
+    if (!handle) {
+        copyBuffersToTexture(buffers, dst, regions, count);
+        if (callback) callback();
+    }
+    return handle;
+}
+
+uint64_t CCVKDevice::updateBufferAsync(Buffer *dst, const void *data, uint32_t size, const std::function<void()> &callback) {
+    CC_PROFILE(CCVKDeviceUpdateBufferAsync);
+    uint64_t handle = _gpuAsyncTransferHub->uploadBuffer(static_cast<CCVKBuffer *>(dst)->gpuBuffer(), data, size, callback);
+    if (!handle) {
+        dst->update(data, size);
+        if (callback) callback();
+    }
+    return handle;
+}
+
+bool CCVKDevice::isUploadComplete(uint64_t handle) const {
+    return _gpuAsyncTransferHub->isComplete(handle);
+}
+
 void CCVKDevice::copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) {
     CC_PROFILE(CCVKDeviceCopyBuffersToTexture);
+    _gpuAsyncTransferHub->finish(static_cast<CCVKTexture *>(dst)->gpuTexture());
     gpuTransportHub()->checkIn([this, buffers, dst, regions, count](CCVKGPUCommandBuffer *gpuCommandBuffer) {
         cmdFuncCCVKCopyBuffersToTexture(this, buffers, static_cast<CCVKTexture *>(dst)->gpuTexture(), regions, count, gpuCommandBuffer);
     });
@@ -881,6 +1118,29 @@ void CCVKDevice::copyTextureToBuffers(Texture *srcTexture, uint8_t *const *buffe
     }
 }
 
+void CCVKDevice::doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) {
+    CC_PROFILE(CCVKDeviceDoTextureReadback);
+    CCVKGPUBuffer readbackBuffer;
+    for (uint32_t i = 0U; i < count; ++i) {
+        readbackBuffer.size += getReadbackRegionSize(src->getFormat(), regions[i]);
+    }
+    // the copy may be submitted in the next frame, in which case it takes one more frame to finish
+    _gpuReadbackHub->request(handle, &readbackBuffer, _gpuDevice->backBufferCount + 1);
+
+    // recorded after the commands of the frame, so the texture is read with its content of this frame
+    _gpuTransportHub->checkIn(
+        [&](CCVKGPUCommandBuffer *cmdBuffer) {
+            cmdFuncCCVKCopyTextureToBuffers(this, static_cast<CCVKTexture *>(src)->gpuTexture(), &readbackBuffer, regions, count, cmdBuffer);
+
+            VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+            vkCmdPipelineBarrier(cmdBuffer->vkCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                                 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        },
+        false, true);
+}
+
 void CCVKDevice::getQueryPoolResults(QueryPool *queryPool) {
     CC_PROFILE(CCVKDeviceGetQueryPoolResults);
     auto *vkQueryPool = static_cast<CCVKQueryPool *>(queryPool);
@@ -25,7 +25,9 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include "VKStd.h"
 #include "gfx-base/GFXDevice.h"
 
@@ -44,6 +46,11 @@ class CCVKGPUSemaphorePool;
 class CCVKGPUBarrierManager;
 class CCVKGPUFramebufferHub;
 class CCVKGPUDescriptorSetHub;
+class CCVKGPUMemoryHub;
+class CCVKGPUAsyncTransferHub;
+class CCVKGPUReadbackHub;
+class CCVKGPUTimeline;
+struct CCVKGPUBarrierStats;
 
 class CCVKGPUFencePool;
 class CCVKGPURecycleBin;
@@ -93,6 +100,12 @@ public:
     inline CCVKGPUBarrierManager *  gpuBarrierManager() { return _gpuBarrierManager; }
     inline CCVKGPUFramebufferHub *  gpuFramebufferHub() { return _gpuFramebufferHub; }
     inline CCVKGPUDescriptorSetHub *gpuDescriptorSetHub() { return _gpuDescriptorSetHub; }
+    // per heap budgets, per category accounting and defragmentation of the device memory
+    inline CCVKGPUMemoryHub *       gpuMemoryHub() { return _gpuMemoryHub; }
+    inline CCVKGPUAsyncTransferHub *gpuAsyncTransferHub() { return _gpuAsyncTransferHub; }
+    inline CCVKGPUReadbackHub *     gpuReadbackHub() { return _gpuReadbackHub; }
+    // signaled by all the submissions on the graphics queue, null without timeline semaphores
+    inline CCVKGPUTimeline *        gpuTimeline() { return _gpuTimeline; }
 
     CCVKGPUFencePool *        gpuFencePool();
     CCVKGPURecycleBin *       gpuRecycleBin();
@@ -101,6 +114,18 @@ public:
 
     void updateBackBufferCount(uint32_t backBufferCount);
 
+    // barriers recorded in the last presented frame
+    const CCVKGPUBarrierStats &getBarrierStats() const;
+
+    // Uploads on a dedicated transfer queue family without stalling rendering, the data is copied before returning.
+    // The callback is invoked on the device thread at the beginning of the first frame that can use the resource,
+    // which must not be used before. Returns the handle to poll with isUploadComplete, or 0 if there is no transfer
+    // queue family or the resource can't be written from it, in which case the upload is done synchronously.
+    uint64_t copyBuffersToTextureAsync(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count,
+                                       const std::function<void()> &callback = nullptr);
+    uint64_t updateBufferAsync(Buffer *dst, const void *data, uint32_t size, const std::function<void()> &callback = nullptr);
+    bool     isUploadComplete(uint64_t handle) const;
+
 protected:
     static CCVKDevice *instance;
 
@@ -132,8 +157,12 @@ protected:
     void copyBuffersToTexture(const uint8_t *const *buffers, Texture *dst, const BufferTextureCopy *regions, uint32_t count) override;
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint32_t count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
+    void doTextureReadback(uint32_t handle, Texture *src, const BufferTextureCopy *regions, uint32_t count) override;
 
     void initFormatFeature();
+    // persisted in the writable path, loaded at init and saved periodically and at destroy
+    void loadPipelineCache();
+    void savePipelineCache();
 
     CCVKGPUDevice *              _gpuDevice  = nullptr;
     CCVKGPUContext *             _gpuContext = nullptr;
@@ -142,6 +171,7 @@ protected:
     ccstd::vector<CCVKGPUFencePool *>         _gpuFencePools;
     ccstd::vector<CCVKGPURecycleBin *>        _gpuRecycleBins;
     ccstd::vector<CCVKGPUStagingBufferPool *> _gpuStagingBufferPools;
+    ccstd::vector<uint64_t>                   _frameTimelineValues; // last value signaled in each back buffer
 
     CCVKGPUBufferHub *       _gpuBufferHub{nullptr};
     CCVKGPUTransportHub *    _gpuTransportHub{nullptr};
@@ -150,9 +180,16 @@ protected:
     CCVKGPUBarrierManager *  _gpuBarrierManager{nullptr};
     CCVKGPUFramebufferHub *  _gpuFramebufferHub{nullptr};
     CCVKGPUDescriptorSetHub *_gpuDescriptorSetHub{nullptr};
+    CCVKGPUMemoryHub *       _gpuMemoryHub{nullptr};
+    CCVKGPUAsyncTransferHub *_gpuAsyncTransferHub{nullptr};
+    CCVKGPUReadbackHub *     _gpuReadbackHub{nullptr};
+    CCVKGPUTimeline *        _gpuTimeline{nullptr};
 
     ccstd::vector<const char *> _layers;
     ccstd::vector<const char *> _extensions;
+
+    size_t                                _pipelineCacheSize{0};
+    std::chrono::steady_clock::time_point _pipelineCacheSaveTime;
 };
 
 } // namespace gfx
@@ -25,10 +25,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include "VKStd.h"
 #include "VKUtils.h"
 #include "base/CachedArray.h"
 #include "base/Log.h"
+#include "base/std/container/array.h"
+#include "base/std/container/deque.h"
 #include "base/std/container/unordered_set.h"
 
 #define TBB_USE_EXCEPTIONS 0 // no-rtti for now
@@ -101,10 +105,24 @@ public:
 
     VkRenderPass vkRenderPass;
 
+    // one bit per view broadcast by every subpass, zero for regular passes
+    uint32_t viewMask{0U};
+
     // helper storage
     ccstd::vector<VkClearValue>          clearValues;
     ccstd::vector<VkSampleCountFlagBits> sampleCounts; // per subpass
 
+    // begun with dynamic rendering instead, without render pass and framebuffer objects
+    bool useDynamicRendering{false};
+    // one per attachment, depth stencil last, the images are filled in on begin
+    ccstd::vector<VkAttachmentDescription2> attachmentDescriptions;
+    ccstd::vector<VkImageLayout>            attachmentLayouts; // inside the pass
+    ccstd::vector<ThsvsImageBarrier>        beginBarriers;
+    ccstd::vector<ThsvsImageBarrier>        endBarriers;
+    ccstd::vector<VkFormat>                 colorFormats;
+    VkFormat                                depthFormat{VK_FORMAT_UNDEFINED};
+    VkFormat                                stencilFormat{VK_FORMAT_UNDEFINED};
+
     const CCVKGPUGeneralBarrier *getBarrier(size_t index, CCVKGPUDevice *gpuDevice) const;
 };
 
@@ -353,6 +371,21 @@ struct CCVKGPUTextureBarrier {
     ThsvsImageBarrier barrier{};
 };
 
+struct CCVKGPUBarrierStats {
+    uint32_t issued{0U}; // vkCmdPipelineBarrier calls
+    uint32_t merged{0U}; // barriers folded into a call issued for another one
+    uint32_t elided{0U}; // barriers dropped because the tracked state already satisfies them
+};
+
+enum class CCVKMemoryCategory : uint32_t {
+    RENDER_TARGET,
+    TEXTURE,
+    BUFFER,
+    STAGING,
+    COUNT,
+};
+
+class CCVKDevice;
 class CCVKGPUCommandBufferPool;
 class CCVKGPUDescriptorSetPool;
 class CCVKGPUDevice final {
@@ -372,9 +405,26 @@ public:
 
     bool useDescriptorUpdateTemplate{false};
     bool useMultiDrawIndirect{false};
+    bool usePipelineCreationFeedback{false};
+    bool useTimelineSemaphore{false};
+    bool useDynamicRendering{false};
 
     PFN_vkCreateRenderPass2 createRenderPass2{nullptr};
 
+#if defined(VK_KHR_dynamic_rendering)
+    // VK_KHR_dynamic_rendering, null if not supported
+    PFN_vkCmdBeginRenderingKHR cmdBeginRendering{nullptr};
+    PFN_vkCmdEndRenderingKHR   cmdEndRendering{nullptr};
+#endif
+
+    // core in 1.2, VK_KHR_draw_indirect_count before, null if not supported
+    PFN_vkCmdDrawIndirectCount        cmdDrawIndirectCount{nullptr};
+    PFN_vkCmdDrawIndexedIndirectCount cmdDrawIndexedIndirectCount{nullptr};
+
+    // core in 1.2, VK_KHR_timeline_semaphore before, null if not supported
+    PFN_vkWaitSemaphores            waitSemaphores{nullptr};
+    PFN_vkGetSemaphoreCounterValue getSemaphoreCounterValue{nullptr};
+
     // for default backup usages
     CCVKGPUSampler     defaultSampler;
     CCVKGPUTexture     defaultTexture;
@@ -386,9 +436,18 @@ public:
 
     ccstd::unordered_set<CCVKGPUSwapchain *> swapchains;
 
+    // allocated bytes of each memory category, tracked allocations have to be untracked before being destroyed
+    ccstd::array<VkDeviceSize, static_cast<size_t>(CCVKMemoryCategory::COUNT)> memoryCategorySizes{};
+
+    CCVKGPUBarrierStats barrierStats;     // of the frame being recorded
+    CCVKGPUBarrierStats lastBarrierStats; // of the last presented frame
+
     CCVKGPUCommandBufferPool *getCommandBufferPool();
     CCVKGPUDescriptorSetPool *getDescriptorSetPool(uint32_t layoutID);
 
+    void trackAllocation(VmaAllocation allocation, CCVKMemoryCategory category);
+    void untrackAllocation(VmaAllocation allocation);
+
 private:
     friend class CCVKDevice;
 
@@ -751,6 +810,7 @@ public:
 
     ~CCVKGPUStagingBufferPool() {
         for (Buffer &buffer : _pool) {
+            _device->untrackAllocation(buffer.vmaAllocation);
             vmaDestroyBuffer(_device->memoryAllocator, buffer.vkBuffer, buffer.vmaAllocation);
         }
         _pool.clear();
@@ -782,6 +842,7 @@ public:
             allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
             VmaAllocationInfo res;
             VK_CHECK(vmaCreateBuffer(_device->memoryAllocator, &bufferInfo, &allocInfo, &buffer->vkBuffer, &buffer->vmaAllocation, &res));
+            _device->trackAllocation(buffer->vmaAllocation, CCVKMemoryCategory::STAGING);
             buffer->mappedData = reinterpret_cast<uint8_t *>(res.pMappedData);
             offset             = 0U;
         }
@@ -810,6 +871,171 @@ private:
     ccstd::vector<Buffer> _pool;
 };
 
+/**
+ * Persistent host visible buffers the texture readbacks are copied to, each one retires
+ * after enough frames for the copy recorded in its frame to be finished on the GPU.
+ */
+class CCVKGPUReadbackHub final {
+public:
+    explicit CCVKGPUReadbackHub(CCVKGPUDevice *device)
+    : _device(device) {
+    }
+
+    ~CCVKGPUReadbackHub() {
+        for (Readback &readback : _readbacks) {
+            destroyBuffer(readback.buffer);
+        }
+        for (Buffer &buffer : _freeBuffers) {
+            destroyBuffer(buffer);
+        }
+        _readbacks.clear();
+        _freeBuffers.clear();
+    }
+
+    // the buffer is reused from the retired ones if possible
+    void request(uint32_t handle, CCVKGPUBuffer *gpuBuffer, uint32_t frameCount) {
+        size_t bestIdx = _freeBuffers.size();
+        for (size_t idx = 0U; idx < _freeBuffers.size(); idx++) {
+            if (_freeBuffers[idx].size >= gpuBuffer->size && (bestIdx == _freeBuffers.size() || _freeBuffers[idx].size < _freeBuffers[bestIdx].size)) {
+                bestIdx = idx;
+            }
+        }
+
+        Readback readback;
+        readback.handle     = handle;
+        readback.framesLeft = frameCount;
+        if (bestIdx < _freeBuffers.size()) {
+            readback.buffer       = _freeBuffers[bestIdx];
+            _freeBuffers[bestIdx] = _freeBuffers.back();
+            _freeBuffers.pop_back();
+        } else {
+            VkBufferCreateInfo bufferInfo{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+            bufferInfo.size  = gpuBuffer->size;
+            bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            VmaAllocationCreateInfo allocInfo{};
+            allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            allocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+            VmaAllocationInfo res;
+            VK_CHECK(vmaCreateBuffer(_device->memoryAllocator, &bufferInfo, &allocInfo, &readback.buffer.vkBuffer, &readback.buffer.vmaAllocation, &res));
+            _device->trackAllocation(readback.buffer.vmaAllocation, CCVKMemoryCategory::STAGING);
+            readback.buffer.mappedData = reinterpret_cast<uint8_t *>(res.pMappedData);
+            readback.buffer.size       = gpuBuffer->size;
+        }
+        gpuBuffer->vkBuffer    = readback.buffer.vkBuffer;
+        gpuBuffer->startOffset = 0U;
+        gpuBuffer->mappedData  = readback.buffer.mappedData;
+        _readbacks.push_back(readback);
+    }
+
+    // called once per frame after the fences of the oldest frame in flight are waited
+    template <typename TFunc>
+    void update(const TFunc &onReady) {
+        size_t count = 0U;
+        for (Readback &readback : _readbacks) {
+            if (--readback.framesLeft) {
+                _readbacks[count++] = readback;
+                continue;
+            }
+            // the memory may not be host coherent
+            vmaInvalidateAllocation(_device->memoryAllocator, readback.buffer.vmaAllocation, 0, VK_WHOLE_SIZE);
+            onReady(readback.handle, readback.buffer.mappedData);
+            _freeBuffers.push_back(readback.buffer);
+        }
+        _readbacks.resize(count);
+    }
+
+private:
+    struct Buffer {
+        VkBuffer      vkBuffer      = VK_NULL_HANDLE;
+        uint8_t *     mappedData    = nullptr;
+        VmaAllocation vmaAllocation = VK_NULL_HANDLE;
+        VkDeviceSize  size          = 0U;
+    };
+
+    struct Readback {
+        uint32_t handle     = 0U;
+        uint32_t framesLeft = 0U;
+        Buffer   buffer;
+    };
+
+    void destroyBuffer(Buffer &buffer) {
+        _device->untrackAllocation(buffer.vmaAllocation);
+        vmaDestroyBuffer(_device->memoryAllocator, buffer.vkBuffer, buffer.vmaAllocation);
+    }
+
+    CCVKGPUDevice *         _device = nullptr;
+    ccstd::vector<Readback> _readbacks;
+    ccstd::vector<Buffer>   _freeBuffers;
+};
+
+struct CCVKMemoryHeapBudget {
+    VkDeviceSize usage{0U};           // reported by VK_EXT_memory_budget, or estimated by the allocated blocks
+    VkDeviceSize budget{0U};          // reported by VK_EXT_memory_budget, or estimated by the heap size
+    VkDeviceSize blockBytes{0U};      // allocated VkDeviceMemory blocks
+    VkDeviceSize allocationBytes{0U}; // occupied by allocations in the blocks
+    uint32_t     thresholdLevel{0U};  // number of thresholds below usage / budget
+};
+
+/**
+ * Per heap budget tracking and incremental defragmentation of the device memory.
+ * Only buffers are defragmented, as VMA can't move images with optimal tiling.
+ */
+class CCVKGPUMemoryHub final {
+public:
+    // invoked on the device thread when the threshold level of a heap changes
+    using BudgetCallback = std::function<void(uint32_t heapIndex, const CCVKMemoryHeapBudget &budget)>;
+
+    static constexpr VkDeviceSize DEFAULT_DEFRAGMENTATION_BYTES      = 8 * 1024 * 1024;
+    static constexpr uint32_t     DEFAULT_DEFRAGMENTATION_ALLOCATIONS = 64U;
+
+    explicit CCVKGPUMemoryHub(CCVKGPUDevice *device)
+    : _device(device) {
+    }
+
+    void add(CCVKGPUBuffer *gpuBuffer) { _buffers.insert(gpuBuffer); }
+    void erase(CCVKGPUBuffer *gpuBuffer) { _buffers.erase(gpuBuffer); }
+
+    // the fractions of the budget that trigger the callback when crossed, in ascending order
+    void setBudgetThresholds(const ccstd::vector<float> &thresholds) { _thresholds = thresholds; }
+    void setBudgetCallback(const BudgetCallback &callback) { _budgetCallback = callback; }
+
+    // bounds of the memory moved by each defragmentation pass, one pass runs every interval frames while fragmented
+    void setDefragmentationEnabled(bool enabled) { _defragmentationEnabled = enabled; }
+    void setDefragmentationLimits(VkDeviceSize bytesPerPass, uint32_t allocationsPerPass, uint32_t interval) {
+        _defragmentationBytes       = bytesPerPass;
+        _defragmentationAllocations = allocationsPerPass;
+        _defragmentationInterval    = std::max(interval, 1U);
+    }
+
+    inline const ccstd::vector<CCVKMemoryHeapBudget> &getHeapBudgets() const { return _heapBudgets; }
+    inline VkDeviceSize                               getCategorySize(CCVKMemoryCategory category) const {
+        return _device->memoryCategorySizes[static_cast<size_t>(category)];
+    }
+
+    // called once per frame after the fences of the frame are waited
+    void update(CCVKDevice *device);
+
+private:
+    void updateBudgets();
+    bool isFragmented() const;
+    void defragment(CCVKDevice *device);
+
+    CCVKGPUDevice *                       _device = nullptr;
+    ccstd::unordered_set<CCVKGPUBuffer *> _buffers;
+    ccstd::vector<CCVKMemoryHeapBudget>   _heapBudgets;
+    ccstd::vector<float>                  _thresholds{0.8F, 0.95F};
+    BudgetCallback                        _budgetCallback;
+    uint32_t                              _frameIndex{0U};
+    bool                                  _defragmentationEnabled{false};
+    VkDeviceSize                          _defragmentationBytes{DEFAULT_DEFRAGMENTATION_BYTES};
+    uint32_t                              _defragmentationAllocations{DEFAULT_DEFRAGMENTATION_ALLOCATIONS};
+    uint32_t                              _defragmentationInterval{30U};
+    uint32_t                              _nextDefragmentationFrame{0U};
+    ccstd::vector<CCVKGPUBuffer *>        _defragmentationBuffers;
+    ccstd::vector<VmaAllocation>          _defragmentationAllocationList;
+    ccstd::vector<VkBool32>               _defragmentationChanged;
+};
+
 /**
  * Manages descriptor set update events, across all back buffer instances.
  */
@@ -1196,6 +1422,32 @@ private:
     size_t                  _count = 0U;
 };
 
+/**
+ * A timeline semaphore signaled with monotonically increasing values by the submissions on a queue.
+ * Host waits and deferred releases are expressed in these values instead of binary fences.
+ */
+class CCVKGPUTimeline final {
+public:
+    explicit CCVKGPUTimeline(CCVKGPUDevice *device);
+    ~CCVKGPUTimeline();
+
+    inline VkSemaphore getSemaphore() const { return _vkSemaphore; }
+    inline uint64_t    getSignaledValue() const { return _signaledValue; }
+    // the value to be signaled by the submission about to be made
+    inline uint64_t signal() { return ++_signaledValue; }
+
+    // query the latest value reached on the device
+    uint64_t poll();
+    bool     isComplete(uint64_t value);
+    void     wait(uint64_t value);
+
+private:
+    CCVKGPUDevice *_device = nullptr;
+    VkSemaphore    _vkSemaphore{VK_NULL_HANDLE};
+    uint64_t       _signaledValue{0U};
+    uint64_t       _completedValue{0U};
+};
+
 /**
  * Transport hub for data traveling between host and devices.
  * Record all transfer commands until batched submission.
@@ -1203,17 +1455,20 @@ private:
 //#define ASYNC_BUFFER_UPDATE
 class CCVKGPUTransportHub final {
 public:
-    CCVKGPUTransportHub(CCVKGPUDevice *device, CCVKGPUQueue *queue)
+    CCVKGPUTransportHub(CCVKGPUDevice *device, CCVKGPUQueue *queue, CCVKGPUTimeline *timeline)
     : _device(device),
-      _queue(queue) {
+      _queue(queue),
+      _timeline(timeline) {
         _earlyCmdBuff.level            = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         _earlyCmdBuff.queueFamilyIndex = _queue->queueFamilyIndex;
 
         _lateCmdBuff.level            = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
         _lateCmdBuff.queueFamilyIndex = _queue->queueFamilyIndex;
 
-        VkFenceCreateInfo createInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
-        VK_CHECK(vkCreateFence(_device->vkDevice, &createInfo, nullptr, &_fence));
+        if (!_timeline) {
+            VkFenceCreateInfo createInfo{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+            VK_CHECK(vkCreateFence(_device->vkDevice, &createInfo, nullptr, &_fence));
+        }
     }
 
     ~CCVKGPUTransportHub() {
@@ -1248,9 +1503,23 @@ public:
             VkSubmitInfo submitInfo{VK_STRUCTURE_TYPE_SUBMIT_INFO};
             submitInfo.commandBufferCount = 1;
             submitInfo.pCommandBuffers    = &cmdBuff->vkCommandBuffer;
-            VK_CHECK(vkQueueSubmit(_queue->vkQueue, 1, &submitInfo, _fence));
-            VK_CHECK(vkWaitForFences(_device->vkDevice, 1, &_fence, VK_TRUE, DEFAULT_TIMEOUT));
-            vkResetFences(_device->vkDevice, 1, &_fence);
+            if (_timeline) {
+                VkSemaphore semaphore = _timeline->getSemaphore();
+                uint64_t    value     = _timeline->signal();
+
+                VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+                timelineInfo.signalSemaphoreValueCount = 1;
+                timelineInfo.pSignalSemaphoreValues    = &value;
+                submitInfo.pNext                       = &timelineInfo;
+                submitInfo.signalSemaphoreCount        = 1;
+                submitInfo.pSignalSemaphores           = &semaphore;
+                VK_CHECK(vkQueueSubmit(_queue->vkQueue, 1, &submitInfo, VK_NULL_HANDLE));
+                _timeline->wait(value);
+            } else {
+                VK_CHECK(vkQueueSubmit(_queue->vkQueue, 1, &submitInfo, _fence));
+                VK_CHECK(vkWaitForFences(_device->vkDevice, 1, &_fence, VK_TRUE, DEFAULT_TIMEOUT));
+                vkResetFences(_device->vkDevice, 1, &_fence);
+            }
             commandBufferPool->yield(cmdBuff);
             cmdBuff->vkCommandBuffer = VK_NULL_HANDLE;
         }
@@ -1273,7 +1542,101 @@ private:
     CCVKGPUQueue *       _queue = nullptr;
     CCVKGPUCommandBuffer _earlyCmdBuff;
     CCVKGPUCommandBuffer _lateCmdBuff;
-    VkFence              _fence = VK_NULL_HANDLE;
+    CCVKGPUTimeline *    _timeline = nullptr;
+    VkFence              _fence    = VK_NULL_HANDLE; // without timeline semaphores
+};
+
+/**
+ * Accumulates barriers and records them with a single vkCmdPipelineBarrier at the flush point.
+ */
+class CCVKGPUBarrierBatch final {
+public:
+    explicit CCVKGPUBarrierBatch(CCVKGPUDevice *device)
+    : _device(device) {}
+
+    void add(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, const VkBufferMemoryBarrier &barrier);
+    void add(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, const VkImageMemoryBarrier &barrier);
+
+    inline bool empty() const { return !_count; }
+    void        flush(VkCommandBuffer vkCommandBuffer);
+
+    // the same read only accesses before and after, without layout change or ownership transfer
+    static bool isRedundant(const ThsvsImageBarrier &barrier);
+    // only reads before, and the tracked accesses of the image are already the ones after
+    static bool isSatisfied(const ThsvsImageBarrier &barrier, const ThsvsAccessType *currentAccesses, uint32_t currentAccessCount);
+
+private:
+    CCVKGPUDevice *                      _device = nullptr;
+    VkPipelineStageFlags                 _srcStageMask{0U};
+    VkPipelineStageFlags                 _dstStageMask{0U};
+    ccstd::vector<VkBufferMemoryBarrier> _bufferBarriers;
+    ccstd::vector<VkImageMemoryBarrier>  _imageBarriers;
+    uint32_t                             _count{0U};
+};
+
+/**
+ * Uploads through a dedicated transfer queue family without stalling the graphics queue.
+ * Completed uploads are acquired by the graphics queue at the beginning of the next frame.
+ */
+class CCVKGPUAsyncTransferHub final {
+public:
+    using Callback = std::function<void()>;
+
+    CCVKGPUAsyncTransferHub(CCVKDevice *device, CCVKGPUQueue *graphicsQueue);
+    ~CCVKGPUAsyncTransferHub();
+
+    // false if there is no dedicated transfer queue family
+    inline bool isSupported() const { return _queue.vkQueue != VK_NULL_HANDLE; }
+    inline bool isComplete(uint64_t handle) const { return handle <= _completedValue; }
+
+    // return 0 if the upload can't be done asynchronously and should go through the transport hub
+    uint64_t uploadBuffer(CCVKGPUBuffer *gpuBuffer, const void *data, uint32_t size, const Callback &callback);
+    uint64_t uploadTexture(CCVKGPUTexture *gpuTexture, const uint8_t *const *buffers, const BufferTextureCopy *regions, uint32_t count, const Callback &callback);
+
+    // acquire the completed uploads on the graphics queue and invoke their callbacks
+    void update();
+
+    // wait for the pending uploads to the resource and acquire them, before it is written by the graphics queue
+    void finish(const CCVKGPUBuffer *gpuBuffer);
+    void finish(const CCVKGPUTexture *gpuTexture);
+    // wait for the pending uploads to the resource and drop them, before it is destroyed or recreated
+    void cancel(const CCVKGPUBuffer *gpuBuffer);
+    void cancel(const CCVKGPUTexture *gpuTexture);
+
+private:
+    struct Submission {
+        uint64_t        value{0U};
+        VkCommandBuffer vkCommandBuffer{VK_NULL_HANDLE};
+        VkFence         vkFence{VK_NULL_HANDLE}; // without timeline semaphores
+        VkBuffer        stagingBuffer{VK_NULL_HANDLE};
+        VmaAllocation   stagingAllocation{VK_NULL_HANDLE};
+        CCVKGPUBuffer * gpuBuffer{nullptr};
+        CCVKGPUTexture *gpuTexture{nullptr};
+        Callback        callback;
+    };
+
+    template <typename T>
+    bool isPending(const T *resource) const;
+    template <typename T>
+    bool waitFor(const T *resource, bool detach);
+
+    uint8_t *beginSubmission(Submission *submission, VkDeviceSize stagingSize);
+    uint64_t endSubmission(Submission *submission);
+    void     poll();
+    void     wait(uint64_t value);
+    void     release(Submission *submission);
+
+    CCVKDevice *              _device    = nullptr;
+    CCVKGPUDevice *           _gpuDevice = nullptr;
+    CCVKGPUQueue              _queue;
+    uint32_t                  _graphicsQueueFamilyIndex{0U};
+    VkCommandPool             _vkCommandPool{VK_NULL_HANDLE};
+    CCVKGPUTimeline *         _timeline{nullptr};
+    uint64_t                  _submittedValue{0U};
+    uint64_t                  _completedValue{0U};
+    ccstd::deque<Submission>  _submissions;
+    ccstd::vector<Submission> _completed;
+    CCVKGPUBarrierBatch       _acquireBarriers;
 };
 
 class CCVKGPUBarrierManager final {
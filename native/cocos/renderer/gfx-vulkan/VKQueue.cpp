@@ -29,6 +29,7 @@
 #include "VKCommands.h"
 #include "VKDevice.h"
 #include "VKQueue.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 namespace gfx {
@@ -56,6 +57,7 @@ void CCVKQueue::doDestroy() {
 }
 
 void CCVKQueue::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
+    CC_PROFILE(CCVKQueueSubmit);
     CCVKDevice *device = CCVKDevice::getInstance();
     _gpuQueue->commandBuffers.clear();
 
@@ -97,7 +99,24 @@ void CCVKQueue::submit(CommandBuffer *const *cmdBuffs, uint32_t count) {
     submitInfo.signalSemaphoreCount = waitSemaphoreCount ? 1 : 0;
     submitInfo.pSignalSemaphores    = &signal;
 
-    VkFence vkFence = device->gpuFencePool()->alloc();
+    // host waits go through the timeline if possible, so no fence is needed
+    CCVKGPUTimeline *             timeline = device->gpuTimeline();
+    VkSemaphore                   signalSemaphores[2]{signal, VK_NULL_HANDLE};
+    uint64_t                      signalValues[2]{0U, 0U}; // ignored for binary semaphores
+    VkTimelineSemaphoreSubmitInfo timelineInfo{VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO};
+    VkFence                       vkFence = VK_NULL_HANDLE;
+    if (timeline) {
+        signalSemaphores[submitInfo.signalSemaphoreCount] = timeline->getSemaphore();
+        signalValues[submitInfo.signalSemaphoreCount]     = timeline->signal();
+        ++submitInfo.signalSemaphoreCount;
+
+        timelineInfo.signalSemaphoreValueCount = submitInfo.signalSemaphoreCount;
+        timelineInfo.pSignalSemaphoreValues    = signalValues;
+        submitInfo.pNext                       = &timelineInfo;
+        submitInfo.pSignalSemaphores           = signalSemaphores;
+    } else {
+        vkFence = device->gpuFencePool()->alloc();
+    }
     VK_CHECK(vkQueueSubmit(_gpuQueue->vkQueue, 1, &submitInfo, vkFence));
 
     _gpuQueue->lastSignaledSemaphores.assign(1, signal);
@@ -44,6 +44,7 @@ void CCVKRenderPass::doInit(const RenderPassInfo & /*info*/) {
     _gpuRenderPass->depthStencilAttachment = _depthStencilAttachment;
     _gpuRenderPass->subpasses              = _subpasses;
     _gpuRenderPass->dependencies           = _dependencies;
+    _gpuRenderPass->viewMask               = _viewCount > 1 ? (1U << _viewCount) - 1U : 0U;
 
     // assign a dummy subpass if not specified
     uint32_t colorCount = utils::toUint(_gpuRenderPass->colorAttachments.size());
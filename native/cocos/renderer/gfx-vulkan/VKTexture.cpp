@@ -28,6 +28,7 @@
 #include "VKCommands.h"
 #include "VKDevice.h"
 #include "VKSwapchain.h"
+#include "base/memory/MemoryAccounting.h"
 #include "profiler/Profiler.h"
 
 namespace cc {
@@ -59,6 +60,7 @@ void CCVKTexture::doInit(const TextureInfo & /*info*/) {
 
     if (!_gpuTexture->memoryless) {
         CCVKDevice::getInstance()->getMemoryStatus().textureSize += _size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, _size);
         CC_PROFILE_MEMORY_INC(Texture, _size);
     }
 
@@ -96,8 +98,10 @@ void CCVKTexture::doDestroy() {
         if (!_isTextureView) {
             if (!_gpuTexture->memoryless) {
                 CCVKDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+                CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
                 CC_PROFILE_MEMORY_DEC(Texture, _size);
             }
+            CCVKDevice::getInstance()->gpuAsyncTransferHub()->cancel(_gpuTexture);
             CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTexture);
             CCVKDevice::getInstance()->gpuBarrierManager()->cancel(_gpuTexture);
             CCVKDevice::getInstance()->gpuFramebufferHub()->disengage(_gpuTexture);
@@ -112,9 +116,11 @@ void CCVKTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
 
     if (!_gpuTexture->memoryless) {
         CCVKDevice::getInstance()->getMemoryStatus().textureSize -= _size;
+        CC_MEMORY_ACCOUNT_FREE(TEXTURE, _size);
         CC_PROFILE_MEMORY_DEC(Texture, _size);
     }
 
+    CCVKDevice::getInstance()->gpuAsyncTransferHub()->cancel(_gpuTexture);
     CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTextureView);
     CCVKDevice::getInstance()->gpuRecycleBin()->collect(_gpuTexture);
 
@@ -126,6 +132,7 @@ void CCVKTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
 
     if (!_gpuTexture->memoryless) {
         CCVKDevice::getInstance()->getMemoryStatus().textureSize += size;
+        CC_MEMORY_ACCOUNT_ALLOC(TEXTURE, size);
         CC_PROFILE_MEMORY_INC(Texture, size);
     }
 
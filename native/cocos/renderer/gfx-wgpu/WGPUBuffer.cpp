@@ -72,19 +72,24 @@ void CCWGPUBuffer::doInit(const BufferInfo &info) {
     }
 
     _gpuBufferObject->wgpuBuffer = wgpuDeviceCreateBuffer(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &descriptor);
+    _generation                  = CCWGPUDevice::getInstance()->newGeneration();
     _internalChanged             = true;
 } // namespace gfx
 
 void CCWGPUBuffer::doInit(const BufferViewInfo &info) {
+    auto *buffer                 = static_cast<CCWGPUBuffer *>(info.buffer);
     _gpuBufferObject             = CC_NEW(CCWGPUBufferObject);
-    _gpuBufferObject->wgpuBuffer = static_cast<CCWGPUBuffer *>(info.buffer)->gpuBufferObject()->wgpuBuffer;
+    _gpuBufferObject->wgpuBuffer = buffer->gpuBufferObject()->wgpuBuffer;
+    _generation                  = buffer->generation();
     _internalChanged             = true;
 }
 
 void CCWGPUBuffer::doDestroy() {
     if (_gpuBufferObject) {
-        if (_gpuBufferObject->wgpuBuffer) {
+        // views share the handler of the source buffer
+        if (_gpuBufferObject->wgpuBuffer && !_isBufferView) {
             wgpuBufferDestroy(_gpuBufferObject->wgpuBuffer);
+            CCWGPUDevice::getInstance()->retireGeneration(_generation);
         }
         CC_DELETE(_gpuBufferObject);
     }
@@ -98,6 +103,7 @@ void CCWGPUBuffer::doResize(uint size, uint count) {
     }
     if (_gpuBufferObject->wgpuBuffer) {
         wgpuBufferDestroy(_gpuBufferObject->wgpuBuffer);
+        CCWGPUDevice::getInstance()->retireGeneration(_generation);
     }
 
     if (hasFlag(_usage, BufferUsageBit::INDIRECT)) {
@@ -116,6 +122,7 @@ void CCWGPUBuffer::doResize(uint size, uint count) {
         .mappedAtCreation = false, //hasFlag(_memUsage, MemoryUsageBit::DEVICE),
     };
     _gpuBufferObject->wgpuBuffer = wgpuDeviceCreateBuffer(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &descriptor);
+    _generation                  = CCWGPUDevice::getInstance()->newGeneration();
 
     _internalChanged = true;
 } // namespace gfx
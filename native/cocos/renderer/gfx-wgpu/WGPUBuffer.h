@@ -66,6 +66,9 @@ public:
     // resource handler changed?
     inline bool internalChanged() const { return _internalChanged; }
 
+    // identifies the resource handler in the object caches
+    inline uint32_t generation() const { return _generation; }
+
 protected:
     void doInit(const BufferInfo &info) override;
     void doInit(const BufferViewInfo &info) override;
@@ -74,7 +77,8 @@ protected:
 
     CCWGPUBufferObject *_gpuBufferObject = nullptr;
 
-    bool _internalChanged = false;
+    uint32_t _generation      = 0;
+    bool     _internalChanged = false;
 };
 
 } // namespace gfx
@@ -445,6 +445,7 @@ void CCWGPUCommandBuffer::bindStates() {
         //bindgroup & descriptorset
         const auto &descriptorSets = _gpuCommandBufferObj->stateCache.descriptorSets;
         for (size_t i = 0; i < descriptorSets.size(); i++) {
+            descriptorSets[i].descriptorSet->prepare();
             if (descriptorSets[i].descriptorSet->gpuBindGroupObject()->bindgroup) {
                 wgpuComputePassEncoderSetBindGroup(_gpuCommandBufferObj->wgpuComputeEncoder,
                                                    descriptorSets[i].index,
@@ -525,6 +526,29 @@ void CCWGPUCommandBuffer::draw(const DrawInfo &info) {
     }
 }
 
+void CCWGPUCommandBuffer::drawIndirect(const DrawIndirectInfo &info) {
+    bindStates();
+
+    auto *     ia             = static_cast<CCWGPUInputAssembler *>(_gpuCommandBufferObj->stateCache.inputAssembler);
+    auto *     indirectBuffer = static_cast<CCWGPUBuffer *>(info.buffer);
+    const bool drawIndexed    = ia->getIndexBuffer() != nullptr;
+    const uint stride         = info.stride ? info.stride : (drawIndexed ? sizeof(CCWGPUDrawIndexedIndirectObject) : sizeof(CCWGPUDrawIndirectObject));
+
+    // no multi draw indirect in webgpu, one call per command
+    for (uint i = 0; i < info.drawCount; i++) {
+        const uint64_t offset = indirectBuffer->getOffset() + info.offset + i * stride;
+        if (drawIndexed) {
+            wgpuRenderPassEncoderDrawIndexedIndirect(_gpuCommandBufferObj->wgpuRenderPassEncoder,
+                                                     indirectBuffer->gpuBufferObject()->wgpuBuffer,
+                                                     offset);
+        } else {
+            wgpuRenderPassEncoderDrawIndirect(_gpuCommandBufferObj->wgpuRenderPassEncoder,
+                                              indirectBuffer->gpuBufferObject()->wgpuBuffer,
+                                              offset);
+        }
+    }
+}
+
 void CCWGPUCommandBuffer::updateBuffer(Buffer *buff, const void *data, uint size) {
     uint32_t alignedSize = ceil(size / 4.0) * 4;
     size_t   buffSize    = alignedSize;
@@ -26,6 +26,7 @@
 #include "WGPUDescriptorSet.h"
 #include <emscripten/html5_webgpu.h>
 #include <algorithm>
+#include <boost/functional/hash.hpp>
 #include "WGPUBuffer.h"
 #include "WGPUDescriptorSetLayout.h"
 #include "WGPUDevice.h"
@@ -38,7 +39,20 @@ namespace gfx {
 
 namespace anoymous {
 WGPUBindGroup defaultBindGroup = wgpuDefaultHandle;
+
+// resources are identified by generation since handlers could be recycled after released
+size_t hashBindGroup(WGPUBindGroupLayout layout, const ccstd::vector<WGPUBindGroupEntry> &entries, const ccstd::vector<uint32_t> &generations) {
+    size_t seed = entries.size();
+    boost::hash_combine(seed, reinterpret_cast<uintptr_t>(layout));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        boost::hash_combine(seed, entries[i].binding);
+        boost::hash_combine(seed, generations[i]);
+        boost::hash_combine(seed, entries[i].offset);
+        boost::hash_combine(seed, entries[i].size);
+    }
+    return seed;
 }
+} // namespace anoymous
 
 using namespace emscripten;
 
@@ -47,6 +61,8 @@ CCWGPUDescriptorSet::CCWGPUDescriptorSet() : wrapper<DescriptorSet>(val::object(
 
 void CCWGPUDescriptorSet::doInit(const DescriptorSetInfo &info) {
     _gpuBindGroupObj = CC_NEW(CCWGPUBindGroupObject);
+    _bufferGenerations.resize(_buffers.size());
+    _textureGenerations.resize(_textures.size());
 
     auto *                       dsLayout      = static_cast<CCWGPUDescriptorSetLayout *>(_layout);
     CCWGPUBindGroupLayoutObject *layoutEntries = dsLayout->gpuLayoutEntryObject();
@@ -62,6 +78,7 @@ void CCWGPUDescriptorSet::doInit(const DescriptorSetInfo &info) {
                 .textureView = texture->gpuTextureObject()->selfView,
             };
             _gpuBindGroupObj->bindGroupEntries.push_back(texEntry);
+            _gpuBindGroupObj->generations.push_back(texture->generation());
             _textureIdxMap.insert(std::make_pair<uint8_t, uint8_t>(bindings[i].binding, _gpuBindGroupObj->bindGroupEntries.size() - 1));
             dsLayout->updateLayout(texEntry.binding, nullptr, texture);
 
@@ -72,6 +89,7 @@ void CCWGPUDescriptorSet::doInit(const DescriptorSetInfo &info) {
                 .sampler = sampler->gpuSampler(),
             };
             _gpuBindGroupObj->bindGroupEntries.push_back(smpEntry);
+            _gpuBindGroupObj->generations.push_back(sampler->generation());
             _samplerIdxMap.insert(std::make_pair<uint8_t, uint8_t>(bindings[i].binding, _gpuBindGroupObj->bindGroupEntries.size() - 1));
             dsLayout->updateLayout(smpEntry.binding, nullptr, nullptr, sampler);
         } else if (hasFlag(DESCRIPTOR_BUFFER_TYPE, bindings[i].descriptorType)) {
@@ -89,6 +107,7 @@ void CCWGPUDescriptorSet::doInit(const DescriptorSetInfo &info) {
                 _dynamicOffsets.push_back({bindings[i].binding, 0});
             }
             _gpuBindGroupObj->bindGroupEntries.push_back(bufferEntry);
+            _gpuBindGroupObj->generations.push_back(buffer->generation());
         } else if (bindings[i].descriptorType == DescriptorType::STORAGE_IMAGE) {
             CCWGPUTexture *    texture  = deviceObj->defaultResources.storageTexture;
             WGPUBindGroupEntry texEntry = {
@@ -96,12 +115,14 @@ void CCWGPUDescriptorSet::doInit(const DescriptorSetInfo &info) {
                 .textureView = texture->gpuTextureObject()->selfView,
             };
             _gpuBindGroupObj->bindGroupEntries.push_back(texEntry);
+            _gpuBindGroupObj->generations.push_back(texture->generation());
             dsLayout->updateLayout(texEntry.binding, nullptr, texture);
         } else {
             WGPUBindGroupEntry texEntry = {
                 .binding = bindings[i].binding,
             };
             _gpuBindGroupObj->bindGroupEntries.push_back(texEntry);
+            _gpuBindGroupObj->generations.push_back(0);
         }
     }
 
@@ -119,6 +140,13 @@ void CCWGPUDescriptorSet::update() {
     auto *      dsLayout = static_cast<CCWGPUDescriptorSetLayout *>(_layout);
     const auto &bindings = dsLayout->getBindings();
 
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        _bufferGenerations[i] = _buffers[i] ? static_cast<CCWGPUBuffer *>(_buffers[i])->generation() : 0;
+    }
+    for (size_t i = 0; i < _textures.size(); ++i) {
+        _textureGenerations[i] = _textures[i] ? static_cast<CCWGPUTexture *>(_textures[i])->generation() : 0;
+    }
+
     for (size_t i = 0; i < bindings.size(); i++) {
         const auto &binding       = bindings[i];
         uint8_t     resourceIndex = _layout->getDescriptorIndices()[i];
@@ -132,6 +160,7 @@ void CCWGPUDescriptorSet::update() {
                 bindGroupEntry.offset  = buffer->getOffset();
                 bindGroupEntry.size    = buffer->getSize();
                 dsLayout->updateLayout(bindGroupEntry.binding, buffer);
+                _gpuBindGroupObj->generations[i] = buffer->generation();
                 uint8_t bindIndex = binding.binding;
                 if (hasAnyFlags(binding.descriptorType, DescriptorType::DYNAMIC_STORAGE_BUFFER | DescriptorType::DYNAMIC_UNIFORM_BUFFER)) {
                     auto iter = std::find_if(_dynamicOffsets.begin(), _dynamicOffsets.end(), [bindIndex](const std::pair<uint8_t, uint8_t> dynIndex) {
@@ -154,6 +183,7 @@ void CCWGPUDescriptorSet::update() {
                 bindGroupEntry.textureView = texture->gpuTextureObject()->selfView;
                 dsLayout->updateLayout(bindGroupEntry.binding, nullptr, texture);
                 _gpuBindGroupObj->bindingSet.insert(binding.binding);
+                _gpuBindGroupObj->generations[textureIdx] = texture->generation();
             }
             if (samplerIdx != 255 && _samplers[resourceIndex]) {
                 auto &bindGroupEntry   = _gpuBindGroupObj->bindGroupEntries[samplerIdx];
@@ -162,6 +192,7 @@ void CCWGPUDescriptorSet::update() {
                 bindGroupEntry.sampler = sampler->gpuSampler();
                 dsLayout->updateLayout(bindGroupEntry.binding, nullptr, nullptr, sampler);
                 _gpuBindGroupObj->bindingSet.insert(binding.binding + CC_WGPU_MAX_ATTACHMENTS);
+                _gpuBindGroupObj->generations[samplerIdx] = sampler->generation();
             }
         } else if (DescriptorType::STORAGE_IMAGE == bindings[i].descriptorType) {
             if (_textures[resourceIndex]) {
@@ -170,78 +201,92 @@ void CCWGPUDescriptorSet::update() {
                 bindGroupEntry.binding     = binding.binding;
                 bindGroupEntry.textureView = texture->gpuTextureObject()->selfView;
                 dsLayout->updateLayout(bindGroupEntry.binding, nullptr, texture);
+                _gpuBindGroupObj->generations[resourceIndex] = texture->generation();
             }
         }
     }
 }
 
 void CCWGPUDescriptorSet::prepare() {
-    auto buffIter = std::find_if(_buffers.begin(), _buffers.end(), [](const Buffer *buffer) {
-        return buffer ? static_cast<const CCWGPUBuffer *>(buffer)->internalChanged() : false;
-    });
-    auto texIter  = std::find_if(_textures.begin(), _textures.end(), [](const Texture *texture) {
-        return texture ? static_cast<const CCWGPUTexture *>(texture)->internalChanged() : false;
-    });
-
-    bool forceUpdate = buffIter != _buffers.end() || texIter != _textures.end();
+    // compared against the generations seen by this set, resources may be shared by many sets
+    bool forceUpdate = false;
+    for (size_t i = 0; i < _buffers.size() && !forceUpdate; ++i) {
+        forceUpdate = _buffers[i] && static_cast<CCWGPUBuffer *>(_buffers[i])->generation() != _bufferGenerations[i];
+    }
+    for (size_t i = 0; i < _textures.size() && !forceUpdate; ++i) {
+        forceUpdate = _textures[i] && static_cast<CCWGPUTexture *>(_textures[i])->generation() != _textureGenerations[i];
+    }
     if (forceUpdate) {
         _isDirty = true;
         update();
     }
 
-    if (_isDirty || forceUpdate || !_gpuBindGroupObj->bindgroup) {
-        auto *dsLayout = static_cast<CCWGPUDescriptorSetLayout *>(_layout);
-        dsLayout->prepare(forceUpdate);
-        // ccstd::vector<WGPUBindGroupEntry>
-        //     bindGroupEntries;
-        // bindGroupEntries.assign(_gpuBindGroupObj->bindGroupEntries.begin(), _gpuBindGroupObj->bindGroupEntries.end());
-        // bindGroupEntries.erase(std::remove_if(
-        //                            bindGroupEntries.begin(), bindGroupEntries.end(), [this, &bindGroupEntries](const WGPUBindGroupEntry& entry) {
-        //                                return _gpuBindGroupObj->bindingSet.find(entry.binding) == _gpuBindGroupObj->bindingSet.end();
-        //                            }),
-        //                        bindGroupEntries.end());
-
-        const auto &entries = _gpuBindGroupObj->bindGroupEntries;
-
-        // for (size_t j = 0; j < entries.size(); j++) {
-        //     const auto& entry = entries[j];
-        //     if ((entry.buffer != 0) + (entry.textureView != 0) + (entry.sampler != 0) != 1) {
-        //         printf("***************missing binding, b, t, s %d,  %p, %p, %p\n", entry.binding, entry.buffer, entry.textureView, entry.sampler);
-        //     }
-        // }
-
-        CCWGPUDeviceObject *deviceObj = CCWGPUDevice::getInstance()->gpuDeviceObject();
-        if (_gpuBindGroupObj->bindgroup && _gpuBindGroupObj->bindgroup != anoymous::defaultBindGroup) {
-            wgpuBindGroupRelease(_gpuBindGroupObj->bindgroup);
+    CCWGPUObjectCaches &caches = CCWGPUDevice::getInstance()->gpuDeviceObject()->caches;
+    if (!_isDirty && _gpuBindGroupObj->bindgroup) {
+        if (_gpuBindGroupObj->bindgroup == anoymous::defaultBindGroup) {
+            return;
+        }
+        // the cached bind group may have been purged at present
+        auto iter = caches.bindGroups.find(_gpuBindGroupObj->hash);
+        if (iter != caches.bindGroups.end()) {
+            iter->second.lastFrame = caches.frame;
+            return;
         }
+    }
 
-        if (entries.empty()) {
-            _gpuBindGroupObj->bindgroup = anoymous::defaultBindGroup;
-            // _bgl = CCWGPUDescriptorSetLayout::defaultBindGroupLayout();
-        } else {
+    auto *dsLayout = static_cast<CCWGPUDescriptorSetLayout *>(_layout);
+    dsLayout->prepare(forceUpdate);
+    // ccstd::vector<WGPUBindGroupEntry>
+    //     bindGroupEntries;
+    // bindGroupEntries.assign(_gpuBindGroupObj->bindGroupEntries.begin(), _gpuBindGroupObj->bindGroupEntries.end());
+    // bindGroupEntries.erase(std::remove_if(
+    //                            bindGroupEntries.begin(), bindGroupEntries.end(), [this, &bindGroupEntries](const WGPUBindGroupEntry& entry) {
+    //                                return _gpuBindGroupObj->bindingSet.find(entry.binding) == _gpuBindGroupObj->bindingSet.end();
+    //                            }),
+    //                        bindGroupEntries.end());
+
+    const auto &entries = _gpuBindGroupObj->bindGroupEntries;
+
+    // for (size_t j = 0; j < entries.size(); j++) {
+    //     const auto& entry = entries[j];
+    //     if ((entry.buffer != 0) + (entry.textureView != 0) + (entry.sampler != 0) != 1) {
+    //         printf("***************missing binding, b, t, s %d,  %p, %p, %p\n", entry.binding, entry.buffer, entry.textureView, entry.sampler);
+    //     }
+    // }
+
+    if (entries.empty()) {
+        _gpuBindGroupObj->bindgroup = anoymous::defaultBindGroup;
+        _gpuBindGroupObj->hash      = 0;
+        // _bgl = CCWGPUDescriptorSetLayout::defaultBindGroupLayout();
+    } else {
+        WGPUBindGroupLayout layout = dsLayout->gpuLayoutEntryObject()->bindGroupLayout;
+        size_t              hash   = anoymous::hashBindGroup(layout, entries, _gpuBindGroupObj->generations);
+
+        auto iter = caches.bindGroups.find(hash);
+        if (iter == caches.bindGroups.end()) {
             WGPUBindGroupDescriptor bindGroupDesc = {
                 .nextInChain = nullptr,
                 .label       = nullptr,
-                .layout      = dsLayout->gpuLayoutEntryObject()->bindGroupLayout,
+                .layout      = layout,
                 .entryCount  = entries.size(),
                 .entries     = entries.data(),
             };
-            _gpuBindGroupObj->bindgroup = wgpuDeviceCreateBindGroup(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &bindGroupDesc);
-            // _bgl = dsLayout->gpuLayoutEntryObject()->bindGroupLayout;
-            // _local = dsLayout;
+            CCWGPUCacheEntry<WGPUBindGroup> cacheEntry;
+            cacheEntry.handle      = wgpuDeviceCreateBindGroup(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &bindGroupDesc);
+            cacheEntry.generations = _gpuBindGroupObj->generations;
+
+            iter = caches.bindGroups.emplace(hash, std::move(cacheEntry)).first;
+            ++caches.stats.bindGroups.misses;
+        } else {
+            ++caches.stats.bindGroups.hits;
         }
-        _isDirty = false;
-        if (buffIter != _buffers.end())
-            std::for_each(_buffers.begin(), _buffers.end(), [](Buffer *buffer) {
-                if (buffer)
-                    static_cast<CCWGPUBuffer *>(buffer)->stamp();
-            });
-        if (texIter != _textures.end())
-            std::for_each(_textures.begin(), _textures.end(), [](Texture *texture) {
-                if (texture)
-                    static_cast<CCWGPUTexture *>(texture)->stamp();
-            });
+        iter->second.lastFrame      = caches.frame;
+        _gpuBindGroupObj->bindgroup = iter->second.handle;
+        _gpuBindGroupObj->hash      = hash;
+        // _bgl = dsLayout->gpuLayoutEntryObject()->bindGroupLayout;
+        // _local = dsLayout;
     }
+    _isDirty = false;
 }
 
 uint8_t CCWGPUDescriptorSet::dynamicOffsetCount() const {
@@ -71,6 +71,10 @@ protected:
     // dynamic offsets, inuse ? 1 : 0;
     Pairs _dynamicOffsets;
 
+    // generations of bound buffers and textures at last update, differs from the current one if the handler is recreated
+    ccstd::vector<uint32_t> _bufferGenerations;
+    ccstd::vector<uint32_t> _textureGenerations;
+
     // void* _bgl = nullptr;
 
     // DescriptorSetLayout* _local = nullptr;
@@ -165,45 +165,31 @@ void CCWGPUDescriptorSetLayout::updateLayout(uint8_t binding, const CCWGPUBuffer
 
 size_t CCWGPUDescriptorSetLayout::hash() const {
     const auto &entries = _gpuLayoutEntryObj->bindGroupLayoutEntries;
-    // size_t seed = 129;
-    // boost::hash_combine(seed, entries.size());
-    // for(size_t i = 0; i < entries.size(); i++) {
-    //     boost::hash_combine(seed, i);
-    //     boost::hash_combine(seed, entries[i].binding);
-    //     boost::hash_combine(seed, entries[i].buffer.type);
-    //     boost::hash_combine(seed, entries[i].sampler.type);
-    //     boost::hash_combine(seed, entries[i].texture.sampleType);
-    //     boost::hash_combine(seed, entries[i].storageTexture.access);
-    // }
-
-    ccstd::string hashStr = "";
 
-    std::size_t seed = entries.size();
-    for (size_t i = 0; i < entries.size(); i++) {
-        const auto &entry = entries[i];
-        hashStr += std::to_string(entry.binding);
-        hashStr += std::to_string(entry.visibility);
+    size_t seed = entries.size();
+    for (const auto &entry : entries) {
+        boost::hash_combine(seed, entry.binding);
+        boost::hash_combine(seed, static_cast<uint32_t>(entry.visibility));
         if (entry.buffer.type != WGPUBufferBindingType_Undefined) {
-            hashStr += std::to_string(entry.buffer.type);
-            hashStr += std::to_string(entry.buffer.hasDynamicOffset ? 1 : 0);
-            hashStr += std::to_string(entry.buffer.minBindingSize);
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.buffer.type));
+            boost::hash_combine(seed, entry.buffer.hasDynamicOffset);
+            boost::hash_combine(seed, entry.buffer.minBindingSize);
         }
-        if (entry.sampler.type == WGPUSamplerBindingType_Undefined) {
-            hashStr += std::to_string(entry.sampler.type);
+        if (entry.sampler.type != WGPUSamplerBindingType_Undefined) {
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.sampler.type));
         }
         if (entry.texture.sampleType != WGPUTextureSampleType_Undefined) {
-            hashStr += std::to_string(entry.texture.sampleType);
-            hashStr += std::to_string(entry.texture.viewDimension);
-            hashStr += std::to_string(entry.texture.multisampled ? 1 : 0);
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.texture.sampleType));
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.texture.viewDimension));
+            boost::hash_combine(seed, entry.texture.multisampled);
         }
         if (entry.storageTexture.access != WGPUStorageTextureAccess_Undefined) {
-            hashStr += std::to_string(entry.storageTexture.access);
-            hashStr += std::to_string(entry.storageTexture.format);
-            hashStr += std::to_string(entry.storageTexture.viewDimension);
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.storageTexture.access));
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.storageTexture.format));
+            boost::hash_combine(seed, static_cast<uint32_t>(entry.storageTexture.viewDimension));
         }
     }
-
-    return std::hash<ccstd::string>{}(hashStr);
+    return seed;
 }
 
 void CCWGPUDescriptorSetLayout::print() const {
@@ -247,12 +233,15 @@ void CCWGPUDescriptorSetLayout::prepare(bool forceUpdate) {
     //                                  }),
     //                              bindGroupLayoutEntries.end());
 
-    size_t hashVal = hash();
-    auto   iter    = layoutPool.find(hashVal);
+    CCWGPUCacheStats &stats   = CCWGPUDevice::getInstance()->gpuDeviceObject()->caches.stats;
+    size_t            hashVal = hash();
+    auto              iter    = layoutPool.find(hashVal);
     if (iter != layoutPool.end()) {
         _gpuLayoutEntryObj->bindGroupLayout = iter->second;
+        ++stats.bindGroupLayouts.hits;
         return;
     }
+    ++stats.bindGroupLayouts.misses;
     const auto &entries = _gpuLayoutEntryObj->bindGroupLayoutEntries;
 
     // for (size_t j = 0; j < entries.size(); j++) {
@@ -282,6 +271,10 @@ void CCWGPUDescriptorSetLayout::prepare(bool forceUpdate) {
     layoutPool.insert({hashVal, _gpuLayoutEntryObj->bindGroupLayout});
 }
 
+size_t CCWGPUDescriptorSetLayout::pooledLayoutCount() {
+    return layoutPool.size();
+}
+
 void *CCWGPUDescriptorSetLayout::defaultBindGroupLayout() {
     if (!anoymous::defaultBindgroupLayout) {
         // default bindgroupLayout: for empty set
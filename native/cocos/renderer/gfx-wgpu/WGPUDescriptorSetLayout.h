@@ -53,6 +53,9 @@ public:
 
     static void *defaultBindGroupLayout();
 
+    // bind group layouts are shared by content and live as long as the device
+    static size_t pooledLayoutCount();
+
     void print() const;
 
 protected:
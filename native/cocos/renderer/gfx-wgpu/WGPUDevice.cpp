@@ -25,6 +25,7 @@
 
 #include "WGPUDevice.h"
 #include <emscripten/val.h>
+#include <algorithm>
 #include <numeric>
 #include "../../base/threading/Semaphore.h"
 #include "WGPUBuffer.h"
@@ -57,6 +58,28 @@ struct BufferMapData {
     bool             finished  = false;
 };
 
+namespace {
+// frames a cached object could stay unused before released
+constexpr uint32_t CACHE_EXPIRED_FRAMES = 300;
+
+template <typename T, typename Release>
+void purgeCache(ccstd::unordered_map<size_t, CCWGPUCacheEntry<T>> &cache, const CCWGPUObjectCaches &caches, bool all, Release release) {
+    for (auto iter = cache.begin(); iter != cache.end();) {
+        const auto &entry   = iter->second;
+        bool        expired = all || caches.frame - entry.lastFrame > CACHE_EXPIRED_FRAMES ||
+                       std::any_of(entry.generations.begin(), entry.generations.end(), [&caches](uint32_t generation) {
+                           return caches.retiredGenerations.count(generation) != 0;
+                       });
+        if (expired) {
+            release(entry.handle);
+            iter = cache.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+} // namespace
+
 CCWGPUDevice *CCWGPUDevice::instance = nullptr;
 
 CCWGPUDevice *CCWGPUDevice::getInstance() {
@@ -79,6 +102,12 @@ CCWGPUDevice::CCWGPUDevice() : wrapper<Device>(val::object()) {
 
 CCWGPUDevice::~CCWGPUDevice() {
     instance = nullptr;
+    if (_gpuDeviceObj) {
+        auto &caches = _gpuDeviceObj->caches;
+        purgeCache(caches.bindGroups, caches, true, wgpuBindGroupRelease);
+        purgeCache(caches.pipelineLayouts, caches, true, wgpuPipelineLayoutRelease);
+        purgeCache(caches.renderPipelines, caches, true, wgpuRenderPipelineRelease);
+    }
     CC_DELETE(_gpuDeviceObj);
     delete this;
 }
@@ -329,6 +358,52 @@ Sampler *CCWGPUDevice::createSampler(const SamplerInfo &info) {
 }
 
 void CCWGPUDevice::present() {
+    auto &caches          = _gpuDeviceObj->caches;
+    caches.lastFrameStats = caches.stats;
+    caches.stats          = CCWGPUCacheStats();
+    purgeCaches();
+    ++caches.frame;
+}
+
+uint32_t CCWGPUDevice::newGeneration() {
+    return ++_gpuDeviceObj->caches.generation;
+}
+
+void CCWGPUDevice::retireGeneration(uint32_t generation) {
+    // resources may outlive the device in JS
+    if (_gpuDeviceObj && generation) {
+        _gpuDeviceObj->caches.retiredGenerations.insert(generation);
+    }
+}
+
+void CCWGPUDevice::purgeCaches() {
+    auto &caches = _gpuDeviceObj->caches;
+    purgeCache(caches.bindGroups, caches, false, wgpuBindGroupRelease);
+    purgeCache(caches.pipelineLayouts, caches, false, wgpuPipelineLayoutRelease);
+    purgeCache(caches.renderPipelines, caches, false, wgpuRenderPipelineRelease);
+    caches.retiredGenerations.clear();
+}
+
+emscripten::val CCWGPUDevice::getCacheStats() const {
+    const auto &caches = _gpuDeviceObj->caches;
+    const auto &stats  = caches.lastFrameStats;
+
+    auto counterToVal = [](const CCWGPUCacheCounter &counter, size_t size) {
+        uint32_t total = counter.hits + counter.misses;
+        val      obj   = val::object();
+        obj.set("hits", counter.hits);
+        obj.set("misses", counter.misses);
+        obj.set("hitRate", total ? static_cast<float>(counter.hits) / static_cast<float>(total) : 1.0F);
+        obj.set("size", static_cast<uint32_t>(size));
+        return obj;
+    };
+
+    val obj = val::object();
+    obj.set("bindGroup", counterToVal(stats.bindGroups, caches.bindGroups.size()));
+    obj.set("bindGroupLayout", counterToVal(stats.bindGroupLayouts, CCWGPUDescriptorSetLayout::pooledLayoutCount()));
+    obj.set("pipelineLayout", counterToVal(stats.pipelineLayouts, caches.pipelineLayouts.size()));
+    obj.set("renderPipeline", counterToVal(stats.renderPipelines, caches.renderPipelines.size()));
+    return obj;
 }
 
 void CCWGPUDevice::getQueryPoolResults(QueryPool *queryPool) {
@@ -59,6 +59,11 @@ public:
 
     inline CCWGPUDeviceObject *gpuDeviceObject() { return _gpuDeviceObj; }
 
+    // generation of a newly created resource handler, see CCWGPUObjectCaches
+    uint32_t newGeneration();
+    // release the cached objects referencing the handler at next present
+    void retireGeneration(uint32_t generation);
+
     inline void registerSwapchain(CCWGPUSwapchain *swapchain) { _swapchains.push_back(swapchain); }
     inline void unRegisterSwapchain(CCWGPUSwapchain *swapchain) {
         auto iter = std::find(_swapchains.begin(), _swapchains.end(), swapchain);
@@ -130,6 +135,9 @@ public:
 
     void debug();
 
+    // cache hits and misses of bind groups, bind group layouts, pipeline layouts and render pipelines in the last frame
+    emscripten::val getCacheStats() const;
+
 protected:
     static CCWGPUDevice *instance;
 
@@ -157,6 +165,8 @@ protected:
     void copyTextureToBuffers(Texture *src, uint8_t *const *buffers, const BufferTextureCopy *region, uint count) override;
     void getQueryPoolResults(QueryPool *queryPool) override;
 
+    void purgeCaches();
+
     CCWGPUDeviceObject *             _gpuDeviceObj = nullptr;
     ccstd::vector<CCWGPUSwapchain *> _swapchains;
 };
@@ -224,7 +224,8 @@ EMSCRIPTEN_BINDINGS(WEBGPU_DEVICE_WASM_EXPORT) {
     enum_<TextureFlags>("TextureFlags")
         .value("NONE", TextureFlagBit::NONE)
         .value("GEN_MIPMAP", TextureFlagBit::GEN_MIPMAP)
-        .value("GENERAL_LAYOUT", TextureFlagBit::GENERAL_LAYOUT);
+        .value("GENERAL_LAYOUT", TextureFlagBit::GENERAL_LAYOUT)
+        .value("LAZILY_ALLOCATED", TextureFlagBit::LAZILY_ALLOCATED);
 
     enum_<SurfaceTransform>("SurfaceTransform")
         .value("IDENTITY", SurfaceTransform::IDENTITY)
@@ -900,6 +901,7 @@ EMSCRIPTEN_BINDINGS(WEBGPU_DEVICE_WASM_EXPORT) {
     class_<CCWGPUDevice, base<Device>>("CCWGPUDevice")
         .class_function("getInstance", &CCWGPUDevice::getInstance, allow_raw_pointer<arg<0>>())
         .function("debug", &CCWGPUDevice::debug)
+        .function("getCacheStats", &CCWGPUDevice::getCacheStats)
         .function("createSwapchain", select_overload<Swapchain *(const SwapchainInfoInstance &)>(&CCWGPUDevice::createSwapchain),
                   /* pure_virtual(), */ allow_raw_pointers())
         .function("createCommandBuffer", select_overload<CommandBuffer *(const CommandBufferInfoInstance &)>(&CCWGPUDevice::createCommandBuffer),
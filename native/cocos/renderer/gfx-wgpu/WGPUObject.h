@@ -30,6 +30,7 @@
 #include "base/Utils.h"
 #include "base/std/container/map.h"
 #include "base/std/container/unordered_map.h"
+#include "base/std/container/unordered_set.h"
 #include "base/std/container/vector.h"
 #include "gfx-base/GFXDef.h"
 
@@ -66,11 +67,48 @@ struct CCWGPUResource {
     CCWGPUSampler *sampler = nullptr;
 };
 
+struct CCWGPUCacheCounter {
+    uint32_t hits   = 0;
+    uint32_t misses = 0;
+};
+
+// lookups of the content hashed caches within a frame
+struct CCWGPUCacheStats {
+    CCWGPUCacheCounter bindGroups;
+    CCWGPUCacheCounter bindGroupLayouts;
+    CCWGPUCacheCounter pipelineLayouts;
+    CCWGPUCacheCounter renderPipelines;
+};
+
+template <typename T>
+struct CCWGPUCacheEntry {
+    T                       handle    = wgpuDefaultHandle;
+    uint32_t                lastFrame = 0;
+    ccstd::vector<uint32_t> generations; // of the resources referenced by handle
+};
+
+// Objects shared by descriptor sets and pipeline states, keyed by the hash of their descriptors.
+// Resources get a new generation whenever their handle is recreated, entries referencing a retired
+// generation, or unused for a while, are released at present.
+struct CCWGPUObjectCaches {
+    ccstd::unordered_map<size_t, CCWGPUCacheEntry<WGPUBindGroup>>      bindGroups;
+    ccstd::unordered_map<size_t, CCWGPUCacheEntry<WGPUPipelineLayout>> pipelineLayouts;
+    ccstd::unordered_map<size_t, CCWGPUCacheEntry<WGPURenderPipeline>> renderPipelines;
+
+    ccstd::unordered_set<uint32_t> retiredGenerations;
+    uint32_t                       generation = 0;
+    uint32_t                       frame      = 0;
+
+    CCWGPUCacheStats stats;
+    CCWGPUCacheStats lastFrameStats;
+};
+
 struct CCWGPUDeviceObject {
     WGPUDevice wgpuDevice = wgpuDefaultHandle;
     WGPUQueue  wgpuQueue  = wgpuDefaultHandle;
 
-    CCWGPUResource defaultResources;
+    CCWGPUResource     defaultResources;
+    CCWGPUObjectCaches caches;
 };
 
 struct CCWGPUSwapchainObject {
@@ -158,7 +196,9 @@ struct CCWGPUBindGroupLayoutObject {
 
 struct CCWGPUBindGroupObject {
     WGPUBindGroup                     bindgroup = wgpuDefaultHandle;
+    size_t                            hash      = 0;
     ccstd::vector<WGPUBindGroupEntry> bindGroupEntries;
+    ccstd::vector<uint32_t>           generations; // of the resource in bindGroupEntries[i]
     ccstd::set<uint8_t>               bindingSet;
 };
 
@@ -169,6 +209,7 @@ struct CCWGPUPipelineLayoutObject {
 struct CCWGPUPipelineStateObject {
     WGPURenderPipeline  wgpuRenderPipeline  = wgpuDefaultHandle;
     WGPUComputePipeline wgpuComputePipeline = wgpuDefaultHandle;
+    size_t              renderPipelineHash  = 0;
 
     ccstd::vector<WGPUVertexAttribute> redundantAttr;
     uint32_t                           maxAttrLength = 0;
@@ -179,6 +220,7 @@ struct CCWGPUShaderObject {
     WGPUShaderModule wgpuShaderVertexModule   = wgpuDefaultHandle;
     WGPUShaderModule wgpuShaderFragmentModule = wgpuDefaultHandle;
     WGPUShaderModule wgpuShaderComputeModule  = wgpuDefaultHandle;
+    uint32_t         generation               = 0;
 };
 
 struct CCWGPUInputAssemblerObject {
@@ -25,6 +25,7 @@
 
 #include "WGPUPipelineLayout.h"
 #include <emscripten/html5_webgpu.h>
+#include <boost/functional/hash.hpp>
 #include "WGPUDescriptorSetLayout.h"
 #include "WGPUDevice.h"
 #include "WGPUObject.h"
@@ -60,23 +61,38 @@ void CCWGPUPipelineLayout::prepare(const ccstd::set<uint8_t> &setInUse) {
         }
     }
 
-    WGPUPipelineLayoutDescriptor descriptor = {
-        .nextInChain          = nullptr,
-        .label                = nullptr,
-        .bindGroupLayoutCount = layouts.size(),
-        .bindGroupLayouts     = layouts.data(),
-    };
+    // bind group layouts are pooled and never released, so their handlers are stable keys
+    size_t seed = layouts.size();
+    for (WGPUBindGroupLayout layout : layouts) {
+        boost::hash_combine(seed, reinterpret_cast<uintptr_t>(layout));
+    }
+
+    CCWGPUObjectCaches &caches = CCWGPUDevice::getInstance()->gpuDeviceObject()->caches;
 
-    _gpuPipelineLayoutObj->wgpuPipelineLayout = wgpuDeviceCreatePipelineLayout(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &descriptor);
+    auto iter = caches.pipelineLayouts.find(seed);
+    if (iter == caches.pipelineLayouts.end()) {
+        WGPUPipelineLayoutDescriptor descriptor = {
+            .nextInChain          = nullptr,
+            .label                = nullptr,
+            .bindGroupLayoutCount = layouts.size(),
+            .bindGroupLayouts     = layouts.data(),
+        };
+        CCWGPUCacheEntry<WGPUPipelineLayout> cacheEntry;
+        cacheEntry.handle = wgpuDeviceCreatePipelineLayout(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &descriptor);
+
+        iter = caches.pipelineLayouts.emplace(seed, std::move(cacheEntry)).first;
+        ++caches.stats.pipelineLayouts.misses;
+    } else {
+        ++caches.stats.pipelineLayouts.hits;
+    }
+    iter->second.lastFrame = caches.frame;
+
+    // owned by the cache
+    _gpuPipelineLayoutObj->wgpuPipelineLayout = iter->second.handle;
 }
 
 void CCWGPUPipelineLayout::doDestroy() {
-    if (_gpuPipelineLayoutObj) {
-        if (_gpuPipelineLayoutObj->wgpuPipelineLayout) {
-            wgpuPipelineLayoutRelease(_gpuPipelineLayoutObj->wgpuPipelineLayout);
-        }
-        CC_DELETE(_gpuPipelineLayoutObj);
-    }
+    CC_DELETE(_gpuPipelineLayoutObj);
 }
 
 } // namespace gfx
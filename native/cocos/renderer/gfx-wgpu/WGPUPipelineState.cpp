@@ -25,6 +25,7 @@
 
 #include "WGPUPipelineState.h"
 #include <emscripten/html5_webgpu.h>
+#include <boost/functional/hash.hpp>
 #include <numeric>
 #include "WGPUDescriptorSetLayout.h"
 #include "WGPUDevice.h"
@@ -40,6 +41,69 @@ namespace gfx {
 
 using namespace emscripten;
 
+namespace anoymous {
+// shader modules are identified by the generation of the shader
+size_t hashRenderPipeline(const WGPURenderPipelineDescriptor &desc, uint32_t shaderGeneration) {
+    size_t seed = shaderGeneration;
+    boost::hash_combine(seed, reinterpret_cast<uintptr_t>(desc.layout));
+
+    for (size_t i = 0; i < desc.vertex.bufferCount; ++i) {
+        const auto &buffer = desc.vertex.buffers[i];
+        boost::hash_combine(seed, buffer.arrayStride);
+        boost::hash_combine(seed, static_cast<uint32_t>(buffer.stepMode));
+        for (size_t j = 0; j < buffer.attributeCount; ++j) {
+            boost::hash_combine(seed, static_cast<uint32_t>(buffer.attributes[j].format));
+            boost::hash_combine(seed, buffer.attributes[j].offset);
+            boost::hash_combine(seed, buffer.attributes[j].shaderLocation);
+        }
+    }
+
+    boost::hash_combine(seed, static_cast<uint32_t>(desc.primitive.topology));
+    boost::hash_combine(seed, static_cast<uint32_t>(desc.primitive.stripIndexFormat));
+    boost::hash_combine(seed, static_cast<uint32_t>(desc.primitive.frontFace));
+    boost::hash_combine(seed, static_cast<uint32_t>(desc.primitive.cullMode));
+
+    if (desc.depthStencil) {
+        const auto &ds          = *desc.depthStencil;
+        auto        hashStencil = [&seed](const WGPUStencilFaceState &face) {
+            boost::hash_combine(seed, static_cast<uint32_t>(face.compare));
+            boost::hash_combine(seed, static_cast<uint32_t>(face.failOp));
+            boost::hash_combine(seed, static_cast<uint32_t>(face.depthFailOp));
+            boost::hash_combine(seed, static_cast<uint32_t>(face.passOp));
+        };
+        boost::hash_combine(seed, static_cast<uint32_t>(ds.format));
+        boost::hash_combine(seed, ds.depthWriteEnabled);
+        boost::hash_combine(seed, static_cast<uint32_t>(ds.depthCompare));
+        hashStencil(ds.stencilFront);
+        hashStencil(ds.stencilBack);
+        boost::hash_combine(seed, ds.stencilReadMask);
+        boost::hash_combine(seed, ds.stencilWriteMask);
+        boost::hash_combine(seed, ds.depthBias);
+        boost::hash_combine(seed, ds.depthBiasSlopeScale);
+        boost::hash_combine(seed, ds.depthBiasClamp);
+    }
+
+    boost::hash_combine(seed, desc.multisample.count);
+    boost::hash_combine(seed, desc.multisample.mask);
+    boost::hash_combine(seed, desc.multisample.alphaToCoverageEnabled);
+
+    for (size_t i = 0; i < desc.fragment->targetCount; ++i) {
+        const auto &target = desc.fragment->targets[i];
+        boost::hash_combine(seed, static_cast<uint32_t>(target.format));
+        boost::hash_combine(seed, static_cast<uint32_t>(target.writeMask));
+        if (target.blend) {
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->color.operation));
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->color.srcFactor));
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->color.dstFactor));
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->alpha.operation));
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->alpha.srcFactor));
+            boost::hash_combine(seed, static_cast<uint32_t>(target.blend->alpha.dstFactor));
+        }
+    }
+    return seed;
+}
+} // namespace anoymous
+
 CCWGPUPipelineState::CCWGPUPipelineState() : wrapper<PipelineState>(val::object()) {
 }
 
@@ -59,10 +123,20 @@ void CCWGPUPipelineState::prepare(const ccstd::set<uint8_t> &setInUse) {
 
     const DepthStencilAttachment &dsAttachment = _renderPass->getDepthStencilAttachment();
     if (_bindPoint == PipelineBindPoint::GRAPHICS) {
+        CCWGPUObjectCaches &caches = CCWGPUDevice::getInstance()->gpuDeviceObject()->caches;
         if (_gpuPipelineStateObj->wgpuRenderPipeline && !_forceUpdate) {
-            return;
+            // the cached pipeline may have been purged at present
+            auto iter = caches.renderPipelines.find(_gpuPipelineStateObj->renderPipelineHash);
+            if (iter != caches.renderPipelines.end()) {
+                iter->second.lastFrame = caches.frame;
+                return;
+            }
         }
 
+        // collected again below
+        _gpuPipelineStateObj->redundantAttr.clear();
+        _gpuPipelineStateObj->maxAttrLength = 0;
+
         auto maxStreamAttr = std::max_element(_inputState.attributes.begin(), _inputState.attributes.end(), [&](const Attribute &lhs, const Attribute &rhs) {
             return lhs.stream < rhs.stream;
         });
@@ -260,7 +334,25 @@ void CCWGPUPipelineState::prepare(const ccstd::set<uint8_t> &setInUse) {
             .multisample  = msState,
             .fragment     = &fragmentState,
         };
-        _gpuPipelineStateObj->wgpuRenderPipeline = wgpuDeviceCreateRenderPipeline(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &piplineDesc);
+        const uint32_t shaderGeneration = static_cast<CCWGPUShader *>(_shader)->gpuShaderObject()->generation;
+        const size_t   hash             = anoymous::hashRenderPipeline(piplineDesc, shaderGeneration);
+
+        auto iter = caches.renderPipelines.find(hash);
+        if (iter == caches.renderPipelines.end()) {
+            CCWGPUCacheEntry<WGPURenderPipeline> cacheEntry;
+            cacheEntry.handle      = wgpuDeviceCreateRenderPipeline(CCWGPUDevice::getInstance()->gpuDeviceObject()->wgpuDevice, &piplineDesc);
+            cacheEntry.generations = {shaderGeneration};
+
+            iter = caches.renderPipelines.emplace(hash, std::move(cacheEntry)).first;
+            ++caches.stats.renderPipelines.misses;
+        } else {
+            ++caches.stats.renderPipelines.hits;
+        }
+        iter->second.lastFrame = caches.frame;
+
+        // owned by the cache
+        _gpuPipelineStateObj->wgpuRenderPipeline = iter->second.handle;
+        _gpuPipelineStateObj->renderPipelineHash = hash;
         _ppl                                     = pipelineLayout;
         _forceUpdate                             = false;
     } else if (_bindPoint == PipelineBindPoint::COMPUTE) {
@@ -283,9 +375,6 @@ void CCWGPUPipelineState::prepare(const ccstd::set<uint8_t> &setInUse) {
 
 void CCWGPUPipelineState::doDestroy() {
     if (_gpuPipelineStateObj) {
-        if (_gpuPipelineStateObj->wgpuRenderPipeline) {
-            wgpuRenderPipelineRelease(_gpuPipelineStateObj->wgpuRenderPipeline);
-        }
         if (_gpuPipelineStateObj->wgpuComputePipeline) {
             wgpuComputePipelineRelease(_gpuPipelineStateObj->wgpuComputePipeline);
         }
@@ -56,10 +56,12 @@ CCWGPUSampler::CCWGPUSampler(const SamplerInfo &info) : wrapper<Sampler>(val::ob
 
     auto *device = CCWGPUDevice::getInstance();
     _wgpuSampler = wgpuDeviceCreateSampler(device->gpuDeviceObject()->wgpuDevice, &descriptor);
+    _generation  = device->newGeneration();
 }
 
 CCWGPUSampler::~CCWGPUSampler() {
     wgpuSamplerRelease(_wgpuSampler);
+    CCWGPUDevice::getInstance()->retireGeneration(_generation);
 }
 
 CCWGPUSampler *CCWGPUSampler::defaultSampler() {
@@ -47,8 +47,12 @@ public:
 
     bool internalChanged() const { return false; }
 
+    // identifies the resource handler in the object caches
+    inline uint32_t generation() const { return _generation; }
+
 protected:
     WGPUSampler _wgpuSampler = wgpuDefaultHandle;
+    uint32_t    _generation  = 0;
 };
 
 } // namespace gfx
@@ -75,6 +75,7 @@ void CCWGPUShader::initialize(const SPVShaderInfoInstance &spvInfo) {
             printf("unsupport shader stage.");
         }
     }
+    _gpuShaderObject->generation = CCWGPUDevice::getInstance()->newGeneration();
 }
 
 void CCWGPUShader::doInit(const ShaderInfo &info) {
@@ -91,6 +92,7 @@ void CCWGPUShader::doDestroy() {
         if (_gpuShaderObject->wgpuShaderComputeModule) {
             wgpuShaderModuleRelease(_gpuShaderObject->wgpuShaderComputeModule);
         }
+        CCWGPUDevice::getInstance()->retireGeneration(_gpuShaderObject->generation);
         CC_DELETE(_gpuShaderObject);
     }
 }
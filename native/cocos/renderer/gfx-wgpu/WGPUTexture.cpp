@@ -74,6 +74,7 @@ void CCWGPUTexture::doInit(const TextureInfo &info) {
         .aspect          = WGPUTextureAspect_All,
     };
     _gpuTextureObj->selfView = wgpuTextureCreateView(_gpuTextureObj->wgpuTexture, &texViewDesc);
+    _generation              = CCWGPUDevice::getInstance()->newGeneration();
 
     _internalChanged = true;
 } // namespace gfx
@@ -94,6 +95,7 @@ void CCWGPUTexture::doInit(const TextureViewInfo &info) {
     auto *      ccTexture    = static_cast<CCWGPUTexture *>(info.texture);
     WGPUTexture wgpuTexture  = ccTexture->gpuTextureObject()->wgpuTexture;
     _gpuTextureObj->selfView = _gpuTextureObj->wgpuTextureView = wgpuTextureCreateView(wgpuTexture, &descriptor);
+    _generation                                                = CCWGPUDevice::getInstance()->newGeneration();
     _internalChanged                                           = true;
 }
 
@@ -129,6 +131,7 @@ void CCWGPUTexture::doInit(const SwapchainTextureInfo &info) {
         } else {
             _gpuTextureObj->selfView = wgpuSwapChainGetCurrentTextureView(swapchain->gpuSwapchainObject()->wgpuSwapChain);
         }
+        _generation      = CCWGPUDevice::getInstance()->newGeneration();
         _internalChanged = true;
     }
 }
@@ -146,6 +149,7 @@ void CCWGPUTexture::doDestroy() {
             wgpuTextureViewRelease(_gpuTextureObj->selfView);
         }
         CC_DELETE(_gpuTextureObj);
+        CCWGPUDevice::getInstance()->retireGeneration(_generation);
     }
     _internalChanged = true;
 }
@@ -166,6 +170,7 @@ void CCWGPUTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
     if (_gpuTextureObj->selfView) {
         wgpuTextureViewRelease(_gpuTextureObj->selfView);
     }
+    CCWGPUDevice::getInstance()->retireGeneration(_generation);
 
     uint8_t depthOrArrayLayers = _info.depth;
     if (_info.type == TextureType::CUBE) {
@@ -195,6 +200,7 @@ void CCWGPUTexture::doResize(uint32_t width, uint32_t height, uint32_t size) {
         .aspect          = WGPUTextureAspect_All,
     };
     _gpuTextureObj->selfView = wgpuTextureCreateView(_gpuTextureObj->wgpuTexture, &texViewDesc);
+    _generation              = CCWGPUDevice::getInstance()->newGeneration();
 
     _internalChanged = true;
 }
@@ -53,6 +53,9 @@ public:
     // resource handler changed?
     inline bool internalChanged() const { return _internalChanged; }
 
+    // identifies the resource handler in the object caches
+    inline uint32_t generation() const { return _generation; }
+
 protected:
     void doInit(const TextureInfo &info) override;
     void doInit(const TextureViewInfo &info) override;
@@ -63,7 +66,8 @@ protected:
 
     CCWGPUTextureObject *_gpuTextureObj = nullptr;
 
-    bool _internalChanged = false;
+    uint32_t _generation      = 0;
+    bool     _internalChanged = false;
 };
 
 } // namespace gfx
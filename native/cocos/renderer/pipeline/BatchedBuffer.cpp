@@ -25,6 +25,7 @@
 
 #include "BatchedBuffer.h"
 #include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXInputAssembler.h"
@@ -39,6 +40,7 @@ BatchedBuffer *
     return BatchedBuffer::get(pass, 0);
 }
 BatchedBuffer *BatchedBuffer::get(scene::Pass *pass, uint extraKey) {
+    pass = pass->getBatchingPass();
     auto &record = BatchedBuffer::buffers[pass];
     auto &buffer = record[extraKey];
     if (buffer == nullptr) buffer = CC_NEW(BatchedBuffer(pass));
@@ -82,6 +84,7 @@ void BatchedBuffer::destroy() {
         CC_FREE(batch.indexData);
     }
     _batches.clear();
+    _slotIndices.clear();
 }
 
 void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const scene::Model *model) {
@@ -96,13 +99,35 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
     uint              vbSize        = 0;
     uint              indexSize     = 0;
     const auto        vbCount       = flatBuffer.count;
+    const auto *const meshData      = flatBuffer.buffer.buffer()->getData();
     const auto *const pass          = subModel->getPass(passIdx);
     auto *const       shader        = subModel->getShader(passIdx);
-    auto *const       descriptorSet = subModel->getDescriptorSet();
+    auto *const       descriptorSet = subModel->getDrawDescriptorSet();
     bool              isBatchExist  = false;
 
-    for (auto &batch : _batches) {
-        if (batch.vbs.size() == flatBuffersCount && batch.mergeCount < UBOLocalBatched::BATCHING_COUNT) {
+    if (!shader) { // not compiled yet
+        return;
+    }
+
+    auto iter = _slotIndices.find(subModel);
+    if (iter != _slotIndices.end()) {
+        auto &batch = _batches[iter->second.first];
+        auto &slot  = batch.slots[iter->second.second];
+        if (slot.vbData == meshData && slot.vbCount == vbCount) {
+            // the vertices are still resident, only the world matrix may change
+            if (!slot.merged) {
+                mergeSlot(batch, iter->second.second, model, pass, shader, descriptorSet);
+            }
+            return;
+        }
+        // the mesh data changed, leave a hole to be compacted later
+        slot.subModel = nullptr;
+        _slotIndices.erase(iter);
+    }
+
+    for (uint b = 0; b < _batches.size(); ++b) {
+        auto &batch = _batches[b];
+        if (batch.vbs.size() == flatBuffersCount && batch.slots.size() < UBOLocalBatched::BATCHING_COUNT) {
             isBatchExist = true;
             for (uint j = 0; j < flatBuffersCount; ++j) {
                 auto *const vb = batch.vbs[j];
@@ -143,32 +168,19 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
                     batch.indexBuffer->resize(indexSize);
                 }
 
-                const auto start      = batch.vbCount;
-                const auto end        = start + vbCount;
-                const auto mergeCount = batch.mergeCount;
-                if (indexData[start] != static_cast<float>(mergeCount) || indexData[end - 1] != static_cast<float>(mergeCount)) {
-                    for (auto j = start; j < end; j++) {
-                        indexData[j] = static_cast<float>(mergeCount) + 0.1F; // guard against underflow
-                    }
-                }
-
-                // update world matrix
-                const auto  offset      = UBOLocalBatched::MAT_WORLDS_OFFSET + batch.mergeCount * 16;
-                const auto &worldMatrix = model->getTransform()->getWorldMatrix();
-                memcpy(batch.uboData.data() + offset, worldMatrix.m, sizeof(worldMatrix));
-
-                if (!batch.mergeCount) {
-                    descriptorSet->bindBuffer(UBOLocalBatched::BINDING, batch.ubo);
-                    descriptorSet->update();
-                    batch.pass          = pass;
-                    batch.shader        = shader;
-                    batch.descriptorSet = descriptorSet;
+                const auto start   = batch.vbCount;
+                const auto end     = start + vbCount;
+                const auto slotIdx = static_cast<uint>(batch.slots.size());
+                for (auto j = start; j < end; j++) {
+                    indexData[j] = static_cast<float>(slotIdx) + 0.1F; // guard against underflow
                 }
 
-                ++batch.mergeCount;
+                batch.slots.push_back({subModel, meshData, start, vbCount, false});
+                _slotIndices[subModel] = {b, slotIdx};
                 batch.vbCount += vbCount;
-                auto prevCount = batch.ia->getDrawInfo().vertexCount;
-                batch.ia->setVertexCount(prevCount + vbCount);
+                batch.ia->setVertexCount(batch.vbCount);
+                batch.vbDirty = true;
+                mergeSlot(batch, slotIdx, model, pass, shader, descriptorSet);
                 return;
             }
         }
@@ -187,12 +199,12 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
             flatBuffer.count * flatBuffer.stride,
             flatBuffer.stride,
         });
-        auto        size       = 0U;
         newVB->update(flatBuffer.buffer.buffer()->getData(), flatBuffer.buffer.buffer()->byteLength());
 
         vbs[i]     = newVB;
         vbDatas[i] = static_cast<uint8_t *>(CC_MALLOC(newVB->getSize()));
-        memset(vbDatas[i], 0, newVB->getSize());
+        // the first slot stays resident, so keep its vertices for later uploads
+        memcpy(vbDatas[i], flatBuffer.buffer.buffer()->getData(), newVB->getSize());
         totalVBs[i] = newVB;
     }
 
@@ -218,6 +230,7 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
     attributes.emplace_back(std::move(attrib));
 
     auto *ia = _device->createInputAssembler({std::move(attributes), std::move(totalVBs)});
+    ia->setVertexCount(vbCount);
 
     auto *ubo = _device->createBuffer({
         gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
@@ -226,19 +239,14 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
         UBOLocalBatched::SIZE,
     });
 
-    descriptorSet->bindBuffer(UBOLocalBatched::BINDING, ubo);
-    descriptorSet->update();
-
-    ccstd::array<float, UBOLocalBatched::COUNT> uboData;
-    const auto &                                worldMatrix = model->getTransform()->getWorldMatrix();
-    memcpy(uboData.data() + UBOLocalBatched::MAT_WORLDS_OFFSET, worldMatrix.m, sizeof(worldMatrix));
-    BatchedItem item = {
+    ccstd::array<float, UBOLocalBatched::COUNT> uboData{};
+    BatchedItem                                 item = {
         std::move(vbs),                  //vbs
         std::move(vbDatas),              //vbDatas
         indexBuffer,                     //indexBuffer
         static_cast<float *>(indexData), //indexData
         vbCount,                         //vbCount
-        1,                               //mergeCount
+        0,                               //mergeCount
         ia,                              //ia
         ubo,                             //ubo
         uboData,                         //uboData
@@ -246,14 +254,122 @@ void BatchedBuffer::merge(const scene::SubModel *subModel, uint passIdx, const s
         pass,                            //pass
         shader,                          //shader
     };
+    item.slots.push_back({subModel, meshData, 0, vbCount, false});
+    _slotIndices[subModel] = {static_cast<uint>(_batches.size()), 0};
     _batches.emplace_back(std::move(item));
+    mergeSlot(_batches.back(), 0, model, pass, shader, descriptorSet);
+}
+
+void BatchedBuffer::mergeSlot(BatchedItem &batch, uint slotIdx, const scene::Model *model, const scene::Pass *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet) {
+    // update world matrix
+    auto *      world       = batch.uboData.data() + UBOLocalBatched::MAT_WORLDS_OFFSET + slotIdx * 16;
+    const auto &worldMatrix = model->getTransform()->getWorldMatrix();
+    if (memcmp(world, worldMatrix.m, sizeof(worldMatrix)) != 0) {
+        memcpy(world, worldMatrix.m, sizeof(worldMatrix));
+        batch.uboDirty = true;
+    }
+
+    if (!batch.mergeCount) {
+        descriptorSet->bindBuffer(UBOLocalBatched::BINDING, batch.ubo);
+        descriptorSet->update();
+        batch.pass          = pass;
+        batch.shader        = shader;
+        batch.descriptorSet = descriptorSet;
+    }
+
+    batch.slots[slotIdx].merged = true;
+    ++batch.mergeCount;
+}
+
+void BatchedBuffer::compact(uint batchIdx) {
+    auto & batch   = _batches[batchIdx];
+    float *worlds  = batch.uboData.data() + UBOLocalBatched::MAT_WORLDS_OFFSET;
+    uint   vbCount = 0;
+    uint   slotIdx = 0;
+    for (uint i = 0; i < batch.slots.size(); ++i) {
+        const auto slot = batch.slots[i];
+        if (!slot.merged || !slot.subModel) {
+            if (slot.subModel) {
+                _slotIndices.erase(slot.subModel);
+            }
+            continue;
+        }
+
+        if (slot.vbOffset != vbCount) {
+            for (uint j = 0; j < batch.vbs.size(); ++j) {
+                const uint stride = batch.vbs[j]->getStride();
+                memmove(batch.vbDatas[j] + vbCount * stride, batch.vbDatas[j] + slot.vbOffset * stride, slot.vbCount * stride);
+            }
+        }
+        if (slotIdx != i) {
+            for (auto j = vbCount; j < vbCount + slot.vbCount; j++) {
+                batch.indexData[j] = static_cast<float>(slotIdx) + 0.1F;
+            }
+            memcpy(worlds + slotIdx * 16, worlds + i * 16, 16 * sizeof(float));
+            _slotIndices[slot.subModel].second = slotIdx;
+        }
+
+        batch.slots[slotIdx]          = slot;
+        batch.slots[slotIdx].vbOffset = vbCount;
+        vbCount += slot.vbCount;
+        ++slotIdx;
+    }
+
+    batch.slots.resize(slotIdx);
+    batch.vbCount = vbCount;
+    batch.ia->setVertexCount(vbCount);
+    batch.vbDirty  = true;
+    batch.uboDirty = true;
 }
 
 void BatchedBuffer::clear() {
-    for (auto &batch : _batches) {
-        batch.vbCount    = 0;
+    // merged vertices stay resident, the slots not merged again are holes until the batch is compacted
+    for (uint b = 0; b < _batches.size(); ++b) {
+        auto &batch     = _batches[b];
+        uint  holeCount = 0;
+        for (const auto &slot : batch.slots) {
+            if (!slot.merged || !slot.subModel) {
+                holeCount += slot.vbCount;
+            }
+        }
+        // compact lazily, once the holes take half of the vertices or the slots run out
+        if (holeCount && (holeCount * 2 > batch.vbCount || batch.slots.size() >= UBOLocalBatched::BATCHING_COUNT)) {
+            compact(b);
+        }
+
+        for (auto &slot : batch.slots) {
+            slot.merged = false;
+        }
         batch.mergeCount = 0;
-        batch.ia->setVertexCount(0);
+    }
+}
+
+void BatchedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+    for (auto &batch : _batches) {
+        if (!batch.mergeCount) continue;
+
+        // collapse the holes, a real world matrix never has a zero w scale
+        float *worlds = batch.uboData.data() + UBOLocalBatched::MAT_WORLDS_OFFSET;
+        for (uint i = 0; i < batch.slots.size(); ++i) {
+            float *world = worlds + i * 16;
+            if (!batch.slots[i].merged && world[15] != 0.F) {
+                memset(world, 0, 16 * sizeof(float));
+                batch.uboDirty = true;
+            }
+        }
+
+        if (batch.vbDirty) {
+            auto i = 0U;
+            for (auto *vb : batch.vbs) {
+                cmdBuffer->updateBuffer(vb, batch.vbDatas[i++], vb->getSize());
+            }
+            cmdBuffer->updateBuffer(batch.indexBuffer, batch.indexData, batch.indexBuffer->getSize());
+            batch.vbDirty = false;
+        }
+        if (batch.uboDirty) {
+            cmdBuffer->updateBuffer(batch.ubo, batch.uboData.data(), batch.ubo->getSize());
+            batch.uboDirty = false;
+        }
     }
 }
 
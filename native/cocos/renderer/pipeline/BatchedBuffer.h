@@ -38,6 +38,15 @@ class SubModel;
 } // namespace scene
 namespace pipeline {
 
+struct CC_DLL BatchedSlot {
+    const scene::SubModel *subModel = nullptr; // only compared, the submodel may have been destroyed
+    const uint8_t *        vbData   = nullptr; // the flat vertex data the slot was filled from
+    uint                   vbOffset = 0;
+    uint                   vbCount  = 0;
+    bool                   merged   = false; // merged since the last clear
+};
+
+// vbCount counts the resident vertices, holes included, mergeCount the slots merged since the last clear
 struct CC_DLL BatchedItem {
     gfx::BufferList                             vbs;
     ccstd::vector<uint8_t *>                    vbDatas;
@@ -51,6 +60,9 @@ struct CC_DLL BatchedItem {
     gfx::DescriptorSet *                        descriptorSet = nullptr;
     const scene::Pass *                         pass          = nullptr;
     gfx::Shader *                               shader        = nullptr;
+    ccstd::vector<BatchedSlot>                  slots;
+    bool                                        vbDirty  = true;
+    bool                                        uboDirty = true;
 };
 using BatchedItemList   = ccstd::vector<BatchedItem>;
 using DynamicOffsetList = ccstd::vector<uint>;
@@ -67,6 +79,7 @@ public:
     void destroy();
     void merge(const scene::SubModel *, uint passIdx, const scene::Model *);
     void clear();
+    void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
     void setDynamicOffset(uint idx, uint value);
 
     inline const BatchedItemList &  getBatches() const { return _batches; }
@@ -74,11 +87,17 @@ public:
     inline const DynamicOffsetList &getDynamicOffset() const { return _dynamicOffsets; }
 
 private:
+    void mergeSlot(BatchedItem &batch, uint slotIdx, const scene::Model *model, const scene::Pass *pass, gfx::Shader *shader, gfx::DescriptorSet *descriptorSet);
+    void compact(uint batchIdx);
+
     static ccstd::unordered_map<scene::Pass *, ccstd::unordered_map<uint, BatchedBuffer *>> buffers;
     DynamicOffsetList                                                                       _dynamicOffsets;
     BatchedItemList                                                                         _batches;
     const scene::Pass *                                                                     _pass   = nullptr;
     gfx::Device *                                                                           _device = nullptr;
+
+    // batch and slot index of every resident submodel
+    ccstd::unordered_map<const scene::SubModel *, std::pair<uint, uint>> _slotIndices;
 };
 
 } // namespace pipeline
@@ -0,0 +1,120 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "BindlessTextureTable.h"
+#include <boost/functional/hash.hpp>
+#include "Define.h"
+#include "GlobalDescriptorSetManager.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace pipeline {
+
+size_t BindlessTextureTable::KeyHasher::operator()(const Key &key) const {
+    size_t seed = 0;
+    boost::hash_combine(seed, key.texture);
+    boost::hash_combine(seed, key.sampler);
+    return seed;
+}
+
+bool BindlessTextureTable::isSupported(const gfx::Device *device) {
+    return device->hasFeature(gfx::Feature::BINDLESS_TEXTURE);
+}
+
+BindlessTextureTable::BindlessTextureTable(GlobalDSManager *manager)
+: _manager(manager) {
+    _entries.reserve(gfx::MAX_BINDLESS_TEXTURES);
+}
+
+uint32_t BindlessTextureTable::getIndex(gfx::Texture *texture, gfx::Sampler *sampler) {
+    const Key key{texture, sampler};
+    auto      iter = _indices.find(key);
+    if (iter != _indices.end()) {
+        _entries[iter->second].lastFrame = _frame;
+        return iter->second;
+    }
+
+    const uint32_t index = allocate();
+    if (index == INVALID_INDEX) return INVALID_INDEX;
+
+    auto &entry = _entries[index];
+    if (entry.texture) {
+        _indices.erase({entry.texture, entry.sampler});
+    }
+    // the previous texture is released only after the slot is rebound
+    _manager->bindTexture(BINDLESSTEXTURES::BINDING, texture, index);
+    _manager->bindSampler(BINDLESSTEXTURES::BINDING, sampler, index);
+    entry.texture   = texture;
+    entry.sampler   = sampler;
+    entry.lastFrame = _frame;
+    _indices.emplace(key, index);
+    _dirty = true;
+    return index;
+}
+
+uint32_t BindlessTextureTable::allocate() {
+    if (_entries.size() < gfx::MAX_BINDLESS_TEXTURES) {
+        _entries.emplace_back();
+        return static_cast<uint32_t>(_entries.size() - 1);
+    }
+
+    // reuse the slot unused for the longest time
+    uint32_t oldest = INVALID_INDEX;
+    for (uint32_t i = 0; i < _entries.size(); ++i) {
+        if (_entries[i].lastFrame + RETENTION_FRAMES > _frame) continue;
+        if (oldest == INVALID_INDEX || _entries[i].lastFrame < _entries[oldest].lastFrame) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+void BindlessTextureTable::nextFrame() {
+    ++_frame;
+}
+
+void BindlessTextureTable::flush() {
+    if (!_dirty) return;
+    _manager->update();
+    _dirty = false;
+}
+
+void BindlessTextureTable::bindTo(gfx::DescriptorSet *set) const {
+    for (uint32_t i = 0; i < _entries.size(); ++i) {
+        if (!_entries[i].texture) continue;
+        set->bindTexture(BINDLESSTEXTURES::BINDING, _entries[i].texture, i);
+        set->bindSampler(BINDLESSTEXTURES::BINDING, _entries[i].sampler, i);
+    }
+}
+
+void BindlessTextureTable::clear() {
+    _entries.clear();
+    _indices.clear();
+    _dirty = false;
+}
+
+} // namespace pipeline
+} // namespace cc
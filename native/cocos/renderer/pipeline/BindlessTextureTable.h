@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+namespace gfx {
+class DescriptorSet;
+class Device;
+class Sampler;
+class Texture;
+} // namespace gfx
+namespace pipeline {
+class GlobalDSManager;
+
+/**
+ * @en Global table of the textures sampled by bindless materials, bound to the cc_bindlessTextures array of the global
+ * descriptor set. Materials defining CC_USE_BINDLESS_TEXTURES read their textures from the table by the indices of the
+ * a_bindlessTextureIndices instance attribute, so submodels differing only in textures can be drawn in one instanced draw.
+ * Entries are created on demand and their slots reused once unused for RETENTION_FRAMES frames, the textures are kept
+ * alive until then. Only takes effect on devices with gfx::Feature::BINDLESS_TEXTURE.
+ * @zh 无绑定材质所采样纹理的全局表，绑定到全局描述符集的 cc_bindlessTextures 数组。定义了 CC_USE_BINDLESS_TEXTURES 的材质
+ * 通过实例属性 a_bindlessTextureIndices 中的索引从表中读取纹理，因此仅纹理不同的子模型可以在一次实例化绘制中完成。
+ * 表项按需创建，连续 RETENTION_FRAMES 帧未被使用后其槽位可被复用，在此之前纹理会一直被持有。
+ * 仅在支持 gfx::Feature::BINDLESS_TEXTURE 的设备上生效。
+ */
+class CC_DLL BindlessTextureTable final {
+public:
+    static constexpr uint32_t INVALID_INDEX{~0U};
+    // work in flight may still sample an entry for this many frames after its last use
+    static constexpr uint32_t RETENTION_FRAMES{3};
+
+    static bool isSupported(const gfx::Device *device);
+
+    explicit BindlessTextureTable(GlobalDSManager *manager);
+    ~BindlessTextureTable() = default;
+
+    // INVALID_INDEX if all the slots are in use
+    uint32_t getIndex(gfx::Texture *texture, gfx::Sampler *sampler);
+    // to be called once per frame before any index is requested
+    void nextFrame();
+    // updates the global descriptor sets if entries were added, to be called before recording the draws reading them
+    void flush();
+    // writes the whole table into a descriptor set created from the global layout
+    void bindTo(gfx::DescriptorSet *set) const;
+    void clear();
+
+    inline uint32_t getEntryCount() const { return static_cast<uint32_t>(_indices.size()); }
+    inline uint32_t getFrame() const { return _frame; }
+
+private:
+    struct Key {
+        gfx::Texture *texture{nullptr};
+        gfx::Sampler *sampler{nullptr};
+
+        bool operator==(const Key &rhs) const { return texture == rhs.texture && sampler == rhs.sampler; }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        IntrusivePtr<gfx::Texture> texture; // null if the slot was never used
+        gfx::Sampler *             sampler{nullptr};
+        uint32_t                   lastFrame{0};
+    };
+
+    uint32_t allocate();
+
+    GlobalDSManager *                              _manager{nullptr};
+    ccstd::vector<Entry>                           _entries; // by index
+    ccstd::unordered_map<Key, uint32_t, KeyHasher> _indices;
+    uint32_t                                       _frame{0};
+    bool                                           _dirty{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(BindlessTextureTable);
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -28,8 +28,10 @@
 #include "PipelineSceneData.h"
 #include "PipelineUBO.h"
 #include "base/StringUtil.h"
+#include "base/job-system/JobSystem.h"
 #include "deferred/DeferredPipeline.h"
 #include "frame-graph/FrameGraph.h"
+#include "profiler/Profiler.h"
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/RenderPipeline.h"
 #include "scene/Camera.h"
@@ -44,9 +46,38 @@ framegraph::StringHandle fgStrHandleClusterGlobalIndexBuffer = framegraph::Frame
 framegraph::StringHandle fgStrHandleClusterLightBuffer       = framegraph::FrameGraph::stringToHandle("clusterLightBuffer");
 framegraph::StringHandle fgStrHandleClusterLightIndexBuffer  = framegraph::FrameGraph::stringToHandle("lightIndexBuffer");
 framegraph::StringHandle fgStrHandleClusterLightGridBuffer   = framegraph::FrameGraph::stringToHandle("lightGridBuffer");
+framegraph::StringHandle fgStrHandleClusterTileDepthBuffer   = framegraph::FrameGraph::stringToHandle("tileDepthBuffer");
+
+framegraph::StringHandle fgStrHandleClusterBuildPass     = framegraph::FrameGraph::stringToHandle("clusterBuildPass");
+framegraph::StringHandle fgStrHandleClusterCullingPass   = framegraph::FrameGraph::stringToHandle("clusterCullingPass");
+framegraph::StringHandle fgStrHandleClusterUploadPass    = framegraph::FrameGraph::stringToHandle("clusterUploadPass");
+framegraph::StringHandle fgStrHandleClusterTileDepthPass = framegraph::FrameGraph::stringToHandle("clusterTileDepthPass");
+
+namespace {
+// same test as ccLightIntersectsCluster of the culling shader, everything is in view space
+bool lightIntersectsCluster(const Vec4 &position, const Vec3 &direction, float range, float cosAngle, const Vec3 &minBounds, const Vec3 &maxBounds) {
+    if (position.w > 0.0F) {
+        const Vec3  halfExtents          = (maxBounds - minBounds) * 0.5F;
+        const Vec3  center               = (minBounds + maxBounds) * 0.5F;
+        const float sphereRadius         = halfExtents.length();
+        const Vec3  v                    = center - Vec3(position.x, position.y, position.z);
+        const float lenSq                = v.lengthSquared();
+        const float v1Len                = v.dot(direction);
+        const float sinAngle             = std::sqrt(std::max(0.0F, 1.0F - cosAngle * cosAngle));
+        const float distanceClosestPoint = cosAngle * std::sqrt(std::max(0.0F, lenSq - v1Len * v1Len)) - v1Len * sinAngle;
+        const bool  angleCull            = distanceClosestPoint > sphereRadius;
+        const bool  frontCull            = v1Len > sphereRadius + range;
+        const bool  backCull             = v1Len < -sphereRadius;
+        return !(angleCull || frontCull || backCull);
+    }
 
-framegraph::StringHandle fgStrHandleClusterBuildPass   = framegraph::FrameGraph::stringToHandle("clusterBuildPass");
-framegraph::StringHandle fgStrHandleClusterCullingPass = framegraph::FrameGraph::stringToHandle("clusterCullingPass");
+    const Vec3 closest(std::max(minBounds.x, std::min(position.x, maxBounds.x)),
+                       std::max(minBounds.y, std::min(position.y, maxBounds.y)),
+                       std::max(minBounds.z, std::min(position.z, maxBounds.z)));
+    const Vec3 dist = closest - Vec3(position.x, position.y, position.z);
+    return dist.lengthSquared() <= range * range;
+}
+} // namespace
 
 ClusterLightCulling::~ClusterLightCulling() {
     CC_SAFE_DESTROY_AND_DELETE(_buildingShader);
@@ -61,18 +92,28 @@ ClusterLightCulling::~ClusterLightCulling() {
     CC_SAFE_DESTROY_AND_DELETE(_resetCounterPipelineState);
     CC_SAFE_DESTROY_AND_DELETE(_resetCounterDescriptorSet);
 
-    CC_SAFE_DESTROY_AND_DELETE(_cullingShader);
-    CC_SAFE_DESTROY_AND_DELETE(_cullingDescriptorSetLayout);
-    CC_SAFE_DESTROY_AND_DELETE(_cullingPipelineLayout);
-    CC_SAFE_DESTROY_AND_DELETE(_cullingPipelineState);
-    CC_SAFE_DESTROY_AND_DELETE(_cullingDescriptorSet);
+    destroyCullingStage();
+
+    CC_SAFE_DESTROY_AND_DELETE(_tileDepthShader);
+    CC_SAFE_DESTROY_AND_DELETE(_tileDepthDescriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_tileDepthPipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_tileDepthPipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_tileDepthDescriptorSet);
 
     CC_SAFE_DESTROY_AND_DELETE(_constantsBuffer);
 }
 
 void ClusterLightCulling::initialize(gfx::Device *dev) {
-    _device = dev;
-    if (!_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) return;
+    _device     = dev;
+    _cpuCulling = _cpuCullingEnabled || !_device->hasFeature(gfx::Feature::COMPUTE_SHADER);
+    if (_cpuCulling) {
+        _lightBufferStride = 4 * sizeof(Vec4);
+        _clusterBounds.resize(CLUSTER_COUNT);
+        _sliceLights.resize(CLUSTERS_Z);
+        _lightGridData.resize(CLUSTER_COUNT * 4);
+        _initialized = true;
+        return;
+    }
 
     uint maxInvocations = _device->getCapabilities().maxComputeWorkGroupInvocations;
     if (CLUSTERS_X_THREADS * CLUSTERS_Y_THREADS * 4 <= maxInvocations) {
@@ -97,6 +138,8 @@ void ClusterLightCulling::initialize(gfx::Device *dev) {
     _buildingDispatchInfo = {CLUSTERS_X / CLUSTERS_X_THREADS, CLUSTERS_Y / CLUSTERS_Y_THREADS, CLUSTERS_Z / clusterZThreads};
     _resetDispatchInfo    = {1, 1, 1};
     _cullingDispatchInfo  = {CLUSTERS_X / CLUSTERS_X_THREADS, CLUSTERS_Y / CLUSTERS_Y_THREADS, CLUSTERS_Z / clusterZThreads};
+    // one work group per screen tile
+    _tileDepthDispatchInfo = {CLUSTERS_X, CLUSTERS_Y, 1};
 
     _resetBarrier = _device->getGeneralBarrier({
         gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
@@ -117,6 +160,7 @@ void ClusterLightCulling::update() {
 
     _constants[NEAR_FAR_OFFSET + 0]  = static_cast<float>(_camera->getNearClip());
     _constants[NEAR_FAR_OFFSET + 1]  = static_cast<float>(_camera->getFarClip());
+    _constants[NEAR_FAR_OFFSET + 2]  = _device->getCapabilities().clipSpaceMinZ;
     const auto &viewport             = _camera->getViewport();
     _constants[VIEW_PORT_OFFSET + 0] = viewport.x * static_cast<float>(_camera->getWidth()) * sceneData->getShadingScale();
     _constants[VIEW_PORT_OFFSET + 1] = viewport.y * static_cast<float>(_camera->getHeight()) * sceneData->getShadingScale();
@@ -126,7 +170,9 @@ void ClusterLightCulling::update() {
     memcpy(_constants.data() + MAT_VIEW_OFFSET, _camera->getMatView().m, sizeof(cc::Mat4));
     memcpy(_constants.data() + MAT_PROJ_INV_OFFSET, _camera->getMatProjInv().m, sizeof(cc::Mat4));
 
-    _constantsBuffer->update(_constants.data(), 2 * sizeof(Vec4) + 2 * sizeof(Mat4));
+    if (_constantsBuffer) {
+        _constantsBuffer->update(_constants.data(), 2 * sizeof(Vec4) + 2 * sizeof(Mat4));
+    }
     updateLights();
 
     uint cameraIndex = _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset();
@@ -412,6 +458,7 @@ void ClusterLightCulling::initCullingStage() {
     ShaderStrings sources;
     sources.glsl4 = StringUtil::format(
         R"(
+		#define CC_DEPTH_BOUNDS %d
 		layout(set=0, binding=0, std140) uniform CCConst {
 		  vec4 cc_nearFar;
 		  vec4 cc_viewPort;
@@ -423,6 +470,9 @@ void ClusterLightCulling::initCullingStage() {
 		layout(set=0, binding=3, std430) buffer b_clusterLightGridBuffer { uvec4 b_clusterLightGrid[]; };
 		layout(set=0, binding=4, std430) buffer b_clustersBuffer { vec4 b_clusters[]; };
 		layout(set=0, binding=5, std430) buffer b_globalIndexBuffer { uint b_globalIndex[]; };
+		#if CC_DEPTH_BOUNDS
+		layout(set=0, binding=6, std430) readonly buffer b_tileDepthBuffer { vec4 b_tileDepth[]; };
+		#endif
 		struct CCLight {
 			vec4 cc_lightPos;
 			vec4 cc_lightColor;
@@ -490,6 +540,11 @@ void ClusterLightCulling::initCullingStage() {
 			uint clusterIndex = gl_GlobalInvocationID.z * uvec3(16, 8, %d).x * uvec3(16, 8, %d).y +
 				gl_GlobalInvocationID.y * uvec3(16, 8, %d).x + gl_GlobalInvocationID.x;
 			Cluster cluster = getCluster(clusterIndex);
+			bool clusterVisible = true;
+		#if CC_DEPTH_BOUNDS
+			vec2 tileDepth = b_tileDepth[gl_GlobalInvocationID.y * 16u + gl_GlobalInvocationID.x].xy;
+			clusterVisible = cluster.maxBounds.z >= tileDepth.x && cluster.minBounds.z <= tileDepth.y;
+		#endif
 			uint lightCount = ccLightCount();
 			uint lightOffset = 0u;
 			while (lightOffset < lightCount) {
@@ -502,7 +557,7 @@ void ClusterLightCulling::initCullingStage() {
 				}
 				barrier();
 				for (uint i = 0u; i < batchSize; i++) {
-					if (visibleCount < 100u && ccLightIntersectsCluster(lights[i], cluster)) {
+					if (clusterVisible && visibleCount < 100u && ccLightIntersectsCluster(lights[i], cluster)) {
 						visibleLights[visibleCount] = lightOffset + i;
 						visibleCount++;
 					}
@@ -517,9 +572,10 @@ void ClusterLightCulling::initCullingStage() {
 			}
 			b_clusterLightGrid[clusterIndex] = uvec4(offset, visibleCount, 0, 0);
 		})",
-        clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads);
+        _depthBoundsCulling, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads);
     sources.glsl3 = StringUtil::format(
         R"(
+		#define CC_DEPTH_BOUNDS %d
 		layout(std140) uniform CCConst {
 		  vec4 cc_nearFar;
 		  vec4 cc_viewPort;
@@ -531,6 +587,9 @@ void ClusterLightCulling::initCullingStage() {
 		layout(std430, binding=3) buffer b_clusterLightGridBuffer { uvec4 b_clusterLightGrid[]; };
 		layout(std430, binding=4) buffer b_clustersBuffer { vec4 b_clusters[]; };
 		layout(std430, binding=5) buffer b_globalIndexBuffer { uint b_globalIndex[]; };
+		#if CC_DEPTH_BOUNDS
+		layout(std430, binding=6) readonly buffer b_tileDepthBuffer { vec4 b_tileDepth[]; };
+		#endif
 		struct CCLight {
 			vec4 cc_lightPos;
 			vec4 cc_lightColor;
@@ -598,6 +657,11 @@ void ClusterLightCulling::initCullingStage() {
 			uint clusterIndex = gl_GlobalInvocationID.z * uvec3(16, 8, %d).x * uvec3(16, 8, %d).y +
 				gl_GlobalInvocationID.y * uvec3(16, 8, %d).x + gl_GlobalInvocationID.x;
 			Cluster cluster = getCluster(clusterIndex);
+			bool clusterVisible = true;
+		#if CC_DEPTH_BOUNDS
+			vec2 tileDepth = b_tileDepth[gl_GlobalInvocationID.y * 16u + gl_GlobalInvocationID.x].xy;
+			clusterVisible = cluster.maxBounds.z >= tileDepth.x && cluster.minBounds.z <= tileDepth.y;
+		#endif
 			uint lightCount = ccLightCount();
 			uint lightOffset = 0u;
 			while (lightOffset < lightCount) {
@@ -610,7 +674,7 @@ void ClusterLightCulling::initCullingStage() {
 				}
 				barrier();
 				for (uint i = 0u; i < batchSize; i++) {
-					if (visibleCount < 100u && ccLightIntersectsCluster(lights[i], cluster)) {
+					if (clusterVisible && visibleCount < 100u && ccLightIntersectsCluster(lights[i], cluster)) {
 						visibleLights[visibleCount] = lightOffset + i;
 						visibleCount++;
 					}
@@ -625,7 +689,7 @@ void ClusterLightCulling::initCullingStage() {
 			}
 			b_clusterLightGrid[clusterIndex] = uvec4(offset, visibleCount, 0, 0);
 		})",
-        clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads);
+        _depthBoundsCulling, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads, clusterZThreads);
     // no compute support in GLES2
 
     gfx::ShaderInfo shaderInfo;
@@ -639,7 +703,10 @@ void ClusterLightCulling::initCullingStage() {
                           {0, 3, "b_clusterLightGridBuffer", 1, gfx::MemoryAccessBit::WRITE_ONLY},
                           {0, 4, "b_clustersBuffer", 1, gfx::MemoryAccessBit::READ_ONLY},
                           {0, 5, "b_globalIndexBuffer", 1, gfx::MemoryAccessBit::READ_WRITE}};
-    _cullingShader     = _device->createShader(shaderInfo);
+    if (_depthBoundsCulling) {
+        shaderInfo.buffers.push_back({0, 6, "b_tileDepthBuffer", 1, gfx::MemoryAccessBit::READ_ONLY});
+    }
+    _cullingShader = _device->createShader(shaderInfo);
 
     gfx::DescriptorSetLayoutInfo dslInfo;
     dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
@@ -648,6 +715,9 @@ void ClusterLightCulling::initCullingStage() {
     dslInfo.bindings.push_back({3, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
     dslInfo.bindings.push_back({4, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
     dslInfo.bindings.push_back({5, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    if (_depthBoundsCulling) {
+        dslInfo.bindings.push_back({6, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    }
 
     _cullingDescriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
     _cullingDescriptorSet       = _device->createDescriptorSet({_cullingDescriptorSetLayout});
@@ -662,12 +732,168 @@ void ClusterLightCulling::initCullingStage() {
     _cullingPipelineState = _device->createPipelineState(pipelineInfo);
 }
 
+void ClusterLightCulling::destroyCullingStage() {
+    CC_SAFE_DESTROY_AND_DELETE(_cullingShader);
+    CC_SAFE_DESTROY_AND_DELETE(_cullingDescriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_cullingPipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_cullingPipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_cullingDescriptorSet);
+}
+
+void ClusterLightCulling::initTileDepthStage() {
+    // view space depth range of each screen tile, x is the farthest and y the nearest
+    ShaderStrings sources;
+    sources.glsl4 = R"(
+		layout(set=0, binding=0, std140) uniform CCConst {
+		  vec4 cc_nearFar;
+		  vec4 cc_viewPort;
+		  mat4 cc_matView;
+		  mat4 cc_matProjInv;
+		};
+		layout(set=0, binding=1, std430) buffer b_tileDepthBuffer { vec4 b_tileDepth[]; };
+		layout(set=0, binding=2) uniform sampler2D cc_depthMap;
+		shared uint tileMinDepth;
+		shared uint tileMaxDepth;
+		float depthToEye(float depth)
+		{
+			vec4 eye = ((cc_matProjInv) * (vec4(0.0, 0.0, cc_nearFar.z + depth * (1.0 - cc_nearFar.z), 1.0)));
+			return eye.z / eye.w;
+		}
+		layout(local_size_x = 16, local_size_y = 8, local_size_z = 1) in;
+		void main()
+		{
+			if (gl_LocalInvocationIndex == 0u) {
+				tileMinDepth = 0xFFFFFFFFu;
+				tileMaxDepth = 0u;
+			}
+			barrier();
+			vec2 tileSize = ceil(cc_viewPort.zw / vec2(16.0, 8.0));
+			uvec2 tileBegin = uvec2(cc_viewPort.xy + vec2(gl_WorkGroupID.xy) * tileSize);
+			uvec2 tileEnd = uvec2(min(cc_viewPort.xy + vec2(gl_WorkGroupID.xy + 1u) * tileSize, cc_viewPort.xy + cc_viewPort.zw));
+			// depth is never negative, its bits sort the same way as the values
+			uint minDepth = 0xFFFFFFFFu;
+			uint maxDepth = 0u;
+			for (uint y = tileBegin.y + gl_LocalInvocationID.y; y < tileEnd.y; y += 8u) {
+				for (uint x = tileBegin.x + gl_LocalInvocationID.x; x < tileEnd.x; x += 16u) {
+					uint depth = floatBitsToUint(texelFetch(cc_depthMap, ivec2(x, y), 0).r);
+					minDepth = min(minDepth, depth);
+					maxDepth = max(maxDepth, depth);
+				}
+			}
+			atomicMin(tileMinDepth, minDepth);
+			atomicMax(tileMaxDepth, maxDepth);
+			barrier();
+			if (gl_LocalInvocationIndex == 0u) {
+				float nearZ = depthToEye(uintBitsToFloat(min(tileMinDepth, tileMaxDepth)));
+				float farZ = depthToEye(uintBitsToFloat(tileMaxDepth));
+				b_tileDepth[gl_WorkGroupID.y * 16u + gl_WorkGroupID.x] = vec4(min(nearZ, farZ), max(nearZ, farZ), 0.0, 0.0);
+			}
+		})";
+    sources.glsl3 = R"(
+		layout(std140) uniform CCConst {
+		  vec4 cc_nearFar;
+		  vec4 cc_viewPort;
+		  mat4 cc_matView;
+		  mat4 cc_matProjInv;
+		};
+		layout(std430, binding=1) buffer b_tileDepthBuffer { vec4 b_tileDepth[]; };
+		uniform highp sampler2D cc_depthMap;
+		shared uint tileMinDepth;
+		shared uint tileMaxDepth;
+		float depthToEye(float depth)
+		{
+			vec4 eye = ((cc_matProjInv) * (vec4(0.0, 0.0, cc_nearFar.z + depth * (1.0 - cc_nearFar.z), 1.0)));
+			return eye.z / eye.w;
+		}
+		layout(local_size_x = 16, local_size_y = 8, local_size_z = 1) in;
+		void main()
+		{
+			if (gl_LocalInvocationIndex == 0u) {
+				tileMinDepth = 0xFFFFFFFFu;
+				tileMaxDepth = 0u;
+			}
+			barrier();
+			vec2 tileSize = ceil(cc_viewPort.zw / vec2(16.0, 8.0));
+			uvec2 tileBegin = uvec2(cc_viewPort.xy + vec2(gl_WorkGroupID.xy) * tileSize);
+			uvec2 tileEnd = uvec2(min(cc_viewPort.xy + vec2(gl_WorkGroupID.xy + 1u) * tileSize, cc_viewPort.xy + cc_viewPort.zw));
+			// depth is never negative, its bits sort the same way as the values
+			uint minDepth = 0xFFFFFFFFu;
+			uint maxDepth = 0u;
+			for (uint y = tileBegin.y + gl_LocalInvocationID.y; y < tileEnd.y; y += 8u) {
+				for (uint x = tileBegin.x + gl_LocalInvocationID.x; x < tileEnd.x; x += 16u) {
+					uint depth = floatBitsToUint(texelFetch(cc_depthMap, ivec2(x, y), 0).r);
+					minDepth = min(minDepth, depth);
+					maxDepth = max(maxDepth, depth);
+				}
+			}
+			atomicMin(tileMinDepth, minDepth);
+			atomicMax(tileMaxDepth, maxDepth);
+			barrier();
+			if (gl_LocalInvocationIndex == 0u) {
+				float nearZ = depthToEye(uintBitsToFloat(min(tileMinDepth, tileMaxDepth)));
+				float farZ = depthToEye(uintBitsToFloat(tileMaxDepth));
+				b_tileDepth[gl_WorkGroupID.y * 16u + gl_WorkGroupID.x] = vec4(min(nearZ, farZ), max(nearZ, farZ), 0.0, 0.0);
+			}
+		})";
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name   = "Compute ";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, getShaderSource(sources)}};
+    shaderInfo.blocks = {
+        {0, 0, "CCConst", {{"cc_nearFar", gfx::Type::FLOAT4, 1}, {"cc_viewPort", gfx::Type::FLOAT4, 1}, {"cc_matView", gfx::Type::MAT4, 1}, {"cc_matProjInv", gfx::Type::MAT4, 1}}, 1},
+    };
+    shaderInfo.buffers        = {{0, 1, "b_tileDepthBuffer", 1, gfx::MemoryAccessBit::WRITE_ONLY}};
+    shaderInfo.samplerTextures = {{0, 2, "cc_depthMap", gfx::Type::SAMPLER2D, 1}};
+    _tileDepthShader           = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({1, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({2, gfx::DescriptorType::SAMPLER_TEXTURE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+
+    _tileDepthDescriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _tileDepthDescriptorSet       = _device->createDescriptorSet({_tileDepthDescriptorSetLayout});
+
+    _tileDepthPipelineLayout = _device->createPipelineLayout({{_tileDepthDescriptorSetLayout}});
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.shader         = _tileDepthShader;
+    pipelineInfo.pipelineLayout = _tileDepthPipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+
+    _tileDepthPipelineState = _device->createPipelineState(pipelineInfo);
+
+    gfx::SamplerInfo samplerInfo;
+    samplerInfo.minFilter = gfx::Filter::POINT;
+    samplerInfo.magFilter = gfx::Filter::POINT;
+    samplerInfo.mipFilter = gfx::Filter::NONE;
+    _tileDepthSampler     = _device->getSampler(samplerInfo);
+}
+
 void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
     if (!_initialized || _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset() != 0) return;
     _camera = camera;
     update(); // update ubo and light data
     if (_validLights.empty()) return;
 
+    if (_cpuCulling) {
+        if (_rebuildClusters) {
+            buildClustersCPU();
+        }
+        cullLightsCPU();
+        addCPUCullingPass();
+        return;
+    }
+
+    if (_depthBoundsCullingEnabled != _depthBoundsCulling) {
+        destroyCullingStage();
+        _depthBoundsCulling = _depthBoundsCullingEnabled;
+        initCullingStage();
+        if (_depthBoundsCulling && !_tileDepthPipelineState) {
+            initTileDepthStage();
+        }
+    }
+
     struct DataClusterBuild {
         framegraph::BufferHandle clusterBuffer;     // cluster build storage buffer
         framegraph::BufferHandle globalIndexBuffer; // global light index storage buffer
@@ -733,12 +959,84 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
         cmdBuff->pipelineBarrier(_resetBarrier);
     };
 
+    // DIP_CLUSTER precedes both the G-buffer and the forward pass
+    uint insertPoint = static_cast<uint>(DeferredInsertPoint::DIP_CLUSTER);
+    _pipeline->getFrameGraph().addPass<DataClusterBuild>(insertPoint++, fgStrHandleClusterBuildPass, clusterBuildSetup, clusterBuildExec);
+    if (_depthBoundsCulling) {
+        // the G-buffer depth isn't set up yet
+        _depthBoundsCullingPending = true;
+        return;
+    }
+    addCullingPass(insertPoint);
+}
+
+void ClusterLightCulling::addDepthBoundsCullingPasses() {
+    if (!_depthBoundsCullingPending) return;
+    _depthBoundsCullingPending = false;
+
+    uint insertPoint = static_cast<uint>(DeferredInsertPoint::DIP_CLUSTER_TILE);
+    addTileDepthPass(insertPoint++);
+    addCullingPass(insertPoint);
+}
+
+void ClusterLightCulling::addTileDepthPass(uint insertPoint) {
+    struct DataTileDepth {
+        framegraph::TextureHandle depth;           // gbuffer depth texture
+        framegraph::BufferHandle  tileDepthBuffer; // depth range storage buffer
+    };
+
+    auto tileDepthSetup = [&](framegraph::PassNodeBuilder &builder, DataTileDepth &data) {
+        data.depth = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(RenderPipeline::fgStrHandleOutDepthTexture)));
+        builder.writeToBlackboard(RenderPipeline::fgStrHandleOutDepthTexture, data.depth);
+
+        data.tileDepthBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterTileDepthBuffer));
+        if (!data.tileDepthBuffer.isValid()) {
+            // each tile has 1 vec4, far and near view space depth
+            uint tileDepthBufferSize = sizeof(Vec4) * CLUSTERS_X * CLUSTERS_Y;
+
+            framegraph::Buffer::Descriptor bufferInfo;
+            bufferInfo.usage     = gfx::BufferUsageBit::STORAGE;
+            bufferInfo.memUsage  = gfx::MemoryUsageBit::DEVICE;
+            bufferInfo.size      = tileDepthBufferSize;
+            bufferInfo.stride    = tileDepthBufferSize;
+            bufferInfo.flags     = gfx::BufferFlagBit::NONE;
+            data.tileDepthBuffer = builder.create(fgStrHandleClusterTileDepthBuffer, bufferInfo);
+        }
+        data.tileDepthBuffer = builder.write(data.tileDepthBuffer);
+        builder.writeToBlackboard(fgStrHandleClusterTileDepthBuffer, data.tileDepthBuffer);
+    };
+
+    auto tileDepthExec = [&](DataTileDepth const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBuff  = _pipeline->getCommandBuffers()[0];
+        auto *texDepth = static_cast<gfx::Texture *>(table.getRead(data.depth));
+
+        auto *textureBarrier{_device->getTextureBarrier({
+            gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE,
+            gfx::AccessFlagBit::COMPUTE_SHADER_READ_TEXTURE,
+        })};
+        cmdBuff->pipelineBarrier(nullptr, &textureBarrier, &texDepth, 1);
+
+        _tileDepthDescriptorSet->bindBuffer(0, _constantsBuffer);
+        _tileDepthDescriptorSet->bindBuffer(1, table.getWrite(data.tileDepthBuffer));
+        _tileDepthDescriptorSet->bindTexture(2, texDepth);
+        _tileDepthDescriptorSet->bindSampler(2, _tileDepthSampler);
+        _tileDepthDescriptorSet->update();
+        cmdBuff->bindPipelineState(const_cast<gfx::PipelineState *>(_tileDepthPipelineState));
+        cmdBuff->bindDescriptorSet(0, const_cast<gfx::DescriptorSet *>(_tileDepthDescriptorSet));
+        cmdBuff->dispatch(_tileDepthDispatchInfo);
+    };
+
+    _pipeline->getFrameGraph().addPass<DataTileDepth>(insertPoint, fgStrHandleClusterTileDepthPass, tileDepthSetup, tileDepthExec);
+}
+
+void ClusterLightCulling::addCullingPass(uint insertPoint) {
     struct DataLightCulling {
         framegraph::BufferHandle lightBuffer;       // light storage buffer
         framegraph::BufferHandle lightIndexBuffer;  // light index storage buffer
         framegraph::BufferHandle lightGridBuffer;   // light grid storage buffer
         framegraph::BufferHandle clusterBuffer;     // cluster storage buffer
         framegraph::BufferHandle globalIndexBuffer; // global light index storage buffer
+        framegraph::BufferHandle tileDepthBuffer;   // tile depth range storage buffer
     };
 
     auto lightCullingSetup = [&](framegraph::PassNodeBuilder &builder, DataLightCulling &data) {
@@ -799,6 +1097,11 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
         // atomic read and write in a pass
         data.globalIndexBuffer = builder.read(data.globalIndexBuffer);
         builder.writeToBlackboard(fgStrHandleClusterGlobalIndexBuffer, data.globalIndexBuffer);
+
+        if (_depthBoundsCulling) {
+            data.tileDepthBuffer = builder.read(framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterTileDepthBuffer)));
+            builder.writeToBlackboard(fgStrHandleClusterTileDepthBuffer, data.tileDepthBuffer);
+        }
     };
 
     auto lightCullingExec = [&](DataLightCulling const &data, const framegraph::DevicePassResourceTable &table) {
@@ -812,6 +1115,9 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
         _cullingDescriptorSet->bindBuffer(3, table.getWrite(data.lightGridBuffer));
         _cullingDescriptorSet->bindBuffer(4, table.getRead(data.clusterBuffer));
         _cullingDescriptorSet->bindBuffer(5, table.getRead(data.globalIndexBuffer));
+        if (_depthBoundsCulling) {
+            _cullingDescriptorSet->bindBuffer(6, table.getRead(data.tileDepthBuffer));
+        }
         _cullingDescriptorSet->update();
         // light culling
         cmdBuff->bindPipelineState(const_cast<gfx::PipelineState *>(_cullingPipelineState));
@@ -819,10 +1125,169 @@ void ClusterLightCulling::clusterLightCulling(scene::Camera *camera) {
         cmdBuff->dispatch(_cullingDispatchInfo);
     };
 
-    auto *pipeline    = static_cast<DeferredPipeline *>(_pipeline);
-    uint  insertPoint = static_cast<uint>(DeferredInsertPoint::DIP_CLUSTER);
-    pipeline->getFrameGraph().addPass<DataClusterBuild>(insertPoint++, fgStrHandleClusterBuildPass, clusterBuildSetup, clusterBuildExec);
-    pipeline->getFrameGraph().addPass<DataLightCulling>(insertPoint++, fgStrHandleClusterCullingPass, lightCullingSetup, lightCullingExec);
+    _pipeline->getFrameGraph().addPass<DataLightCulling>(insertPoint, fgStrHandleClusterCullingPass, lightCullingSetup, lightCullingExec);
+}
+
+void ClusterLightCulling::buildClustersCPU() {
+    // same math as the building shader
+    const float nearClip     = _constants[NEAR_FAR_OFFSET + 0];
+    const float farClip      = _constants[NEAR_FAR_OFFSET + 1];
+    const float viewportX    = _constants[VIEW_PORT_OFFSET + 0];
+    const float viewportY    = _constants[VIEW_PORT_OFFSET + 1];
+    const float viewportW    = _constants[VIEW_PORT_OFFSET + 2];
+    const float viewportH    = _constants[VIEW_PORT_OFFSET + 3];
+    const Mat4 &matProjInv   = _camera->getMatProjInv();
+    const float clusterSizeX = std::ceil(viewportW / static_cast<float>(CLUSTERS_X));
+    const float clusterSizeY = std::ceil(viewportH / static_cast<float>(CLUSTERS_Y));
+
+    const auto screenToEye = [&](float x, float y) {
+        Vec4 eye{2.0F * (x - viewportX) / viewportW - 1.0F, 2.0F * (y - viewportY) / viewportH - 1.0F, 1.0F, 1.0F};
+        matProjInv.transformVector(&eye);
+        return Vec3(eye.x / eye.w, eye.y / eye.w, eye.z / eye.w);
+    };
+
+    for (uint z = 0; z < CLUSTERS_Z; ++z) {
+        const float clusterNear = -nearClip * std::pow(farClip / nearClip, static_cast<float>(z) / static_cast<float>(CLUSTERS_Z));
+        const float clusterFar  = -nearClip * std::pow(farClip / nearClip, static_cast<float>(z + 1) / static_cast<float>(CLUSTERS_Z));
+        for (uint y = 0; y < CLUSTERS_Y; ++y) {
+            for (uint x = 0; x < CLUSTERS_X; ++x) {
+                const Vec3 minEye  = screenToEye(static_cast<float>(x) * clusterSizeX, static_cast<float>(y) * clusterSizeY);
+                const Vec3 maxEye  = screenToEye(static_cast<float>(x + 1) * clusterSizeX, static_cast<float>(y + 1) * clusterSizeY);
+                const Vec3 minNear = minEye * (clusterNear / minEye.z);
+                const Vec3 minFar  = minEye * (clusterFar / minEye.z);
+                const Vec3 maxNear = maxEye * (clusterNear / maxEye.z);
+                const Vec3 maxFar  = maxEye * (clusterFar / maxEye.z);
+
+                auto &bounds = _clusterBounds[z * CLUSTERS_X * CLUSTERS_Y + y * CLUSTERS_X + x];
+                Vec3::min(minNear, minFar, &bounds.minBounds);
+                Vec3::min(bounds.minBounds, maxNear, &bounds.minBounds);
+                Vec3::min(bounds.minBounds, maxFar, &bounds.minBounds);
+                Vec3::max(minNear, minFar, &bounds.maxBounds);
+                Vec3::max(bounds.maxBounds, maxNear, &bounds.maxBounds);
+                Vec3::max(bounds.maxBounds, maxFar, &bounds.maxBounds);
+            }
+        }
+    }
+}
+
+void ClusterLightCulling::cullLightsCPU() {
+    CC_PROFILE(ClusterLightCullingCPU);
+    const auto  lightCount = static_cast<uint>(_validLights.size());
+    const Mat4 &matView    = _camera->getMatView();
+
+    // lights are moved to view space once, spot lights keep their flag in w
+    _viewLightPositions.resize(lightCount);
+    _viewLightDirections.resize(lightCount);
+    for (uint l = 0; l < lightCount; ++l) {
+        const float *light    = _lightBufferData.data() + l * 16;
+        const float *position = light + UBOForwardLight::LIGHT_POS_OFFSET;
+        Vec3         viewPosition(position[0], position[1], position[2]);
+        matView.transformPoint(&viewPosition);
+        _viewLightPositions[l].set(viewPosition.x, viewPosition.y, viewPosition.z, position[3]);
+
+        const float *direction = light + UBOForwardLight::LIGHT_DIR_OFFSET;
+        Vec3         viewDirection(direction[0], direction[1], direction[2]);
+        matView.transformVector(&viewDirection);
+        viewDirection.normalize();
+        _viewLightDirections[l] = viewDirection;
+    }
+
+    // one job per depth slice, each one only writes to its own light list
+    constexpr uint CLUSTERS_PER_SLICE = CLUSTERS_X * CLUSTERS_Y;
+    auto           sliceJob           = [&](uint z) {
+        auto &slice = _sliceLights[z];
+        slice.indices.clear();
+        slice.counts.assign(CLUSTERS_PER_SLICE, 0);
+        for (uint c = 0; c < CLUSTERS_PER_SLICE; ++c) {
+            const auto &bounds = _clusterBounds[z * CLUSTERS_PER_SLICE + c];
+            uint        count  = 0;
+            for (uint l = 0; l < lightCount && count < MAX_LIGHTS_PER_CLUSTER; ++l) {
+                const float *sizeRangeAngle = _lightBufferData.data() + l * 16 + UBOForwardLight::LIGHT_SIZE_RANGE_ANGLE_OFFSET;
+                if (lightIntersectsCluster(_viewLightPositions[l], _viewLightDirections[l], sizeRangeAngle[1], sizeRangeAngle[2],
+                                           bounds.minBounds, bounds.maxBounds)) {
+                    slice.indices.emplace_back(l);
+                    ++count;
+                }
+            }
+            slice.counts[c] = count;
+        }
+    };
+
+    JobGraph graph(JobSystem::getInstance());
+    graph.createForEachIndexJob(0U, CLUSTERS_Z, 1U, sliceJob);
+    graph.run();
+    graph.waitForAll();
+
+    // compact the lists in cluster order, as (offset, count, 0, 0) entries of the light grid
+    _lightIndexData.clear();
+    for (uint z = 0; z < CLUSTERS_Z; ++z) {
+        const auto &slice = _sliceLights[z];
+        auto        next  = static_cast<uint>(_lightIndexData.size());
+        for (uint c = 0; c < CLUSTERS_PER_SLICE; ++c) {
+            uint *grid = _lightGridData.data() + (z * CLUSTERS_PER_SLICE + c) * 4;
+            grid[0]    = next;
+            grid[1]    = slice.counts[c];
+            grid[2]    = 0;
+            grid[3]    = 0;
+            next += slice.counts[c];
+        }
+        _lightIndexData.insert(_lightIndexData.end(), slice.indices.begin(), slice.indices.end());
+    }
+    if (_lightIndexData.empty()) {
+        _lightIndexData.emplace_back(0);
+    }
+}
+
+void ClusterLightCulling::addCPUCullingPass() {
+    struct DataLightUpload {
+        framegraph::BufferHandle lightBuffer;      // light storage buffer
+        framegraph::BufferHandle lightIndexBuffer; // light index storage buffer
+        framegraph::BufferHandle lightGridBuffer;  // light grid storage buffer
+    };
+
+    auto lightUploadSetup = [&](framegraph::PassNodeBuilder &builder, DataLightUpload &data) {
+        const auto getOrCreate = [&](framegraph::StringHandle name, uint size, uint stride, gfx::MemoryUsageBit memUsage, bool recreate) {
+            auto handle = framegraph::BufferHandle(builder.readFromBlackboard(name));
+            if (!handle.isValid() || recreate) {
+                framegraph::Buffer::Descriptor bufferInfo;
+                bufferInfo.usage    = gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST;
+                bufferInfo.memUsage = memUsage;
+                bufferInfo.size     = size;
+                bufferInfo.stride   = stride;
+                bufferInfo.flags    = gfx::BufferFlagBit::NONE;
+                handle              = builder.create(name, bufferInfo);
+            }
+            handle = builder.write(handle);
+            builder.writeToBlackboard(name, handle);
+            return handle;
+        };
+
+        data.lightBuffer = getOrCreate(fgStrHandleClusterLightBuffer, _lightBufferStride * _lightBufferCount, _lightBufferStride,
+                                       gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE, _lightBufferResized);
+        _lightBufferResized = false;
+
+        const uint lightIndicesBufferSize = MAX_LIGHTS_PER_CLUSTER * CLUSTER_COUNT * sizeof(int);
+        data.lightIndexBuffer             = getOrCreate(fgStrHandleClusterLightIndexBuffer, lightIndicesBufferSize, lightIndicesBufferSize,
+                                            gfx::MemoryUsageBit::DEVICE, false);
+
+        const uint lightGridBufferSize = CLUSTER_COUNT * 4 * sizeof(uint);
+        data.lightGridBuffer           = getOrCreate(fgStrHandleClusterLightGridBuffer, lightGridBufferSize, lightGridBufferSize,
+                                           gfx::MemoryUsageBit::DEVICE, false);
+    };
+
+    auto lightUploadExec = [&](DataLightUpload const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+        cmdBuff->updateBuffer(table.getWrite(data.lightBuffer), _lightBufferData.data(),
+                              static_cast<uint>(_lightBufferData.size() * sizeof(float)));
+        // only the used part of the index list
+        cmdBuff->updateBuffer(table.getWrite(data.lightIndexBuffer), _lightIndexData.data(),
+                              static_cast<uint>(_lightIndexData.size() * sizeof(uint)));
+        cmdBuff->updateBuffer(table.getWrite(data.lightGridBuffer), _lightGridData.data(),
+                              static_cast<uint>(_lightGridData.size() * sizeof(uint)));
+    };
+
+    uint insertPoint = static_cast<uint>(DeferredInsertPoint::DIP_CLUSTER);
+    _pipeline->getFrameGraph().addPass<DataLightUpload>(insertPoint, fgStrHandleClusterUploadPass, lightUploadSetup, lightUploadExec);
 }
 
 ccstd::string &ClusterLightCulling::getShaderSource(ShaderStrings &sources) {
@@ -78,6 +78,28 @@ public:
 
     inline bool isInitialized() const { return _initialized; }
 
+    /**
+     * @en Build the clusters and the light lists on the job system and upload them to the buffers read by the lighting pass
+     * instead of dispatching the compute shaders, always used if the device has no compute shader. Must be set before initialize.
+     * @zh 使用 JobSystem 在 CPU 上构建分簇与光源列表并上传到光照阶段读取的缓冲，替代计算着色器，设备不支持计算着色器时总是启用。
+     * 必须在 initialize 之前设置。
+     */
+    inline void setCPUCullingEnabled(bool val) { _cpuCullingEnabled = val; }
+    inline bool isCPUCulling() const { return _cpuCulling; }
+
+    /**
+     * @en Skip the clusters out of the depth range of their screen tile, the depth range is reduced from the G-buffer depth by compute.
+     * The light culling then runs after the G-buffer pass, which splits the G-buffer and lighting render pass, so it only pays off with many lights.
+     * Ignored with CPU culling. Deferred pipeline only.
+     * @zh 跳过不在所属屏幕分块深度范围内的分簇，深度范围由计算着色器从 G-buffer 深度归约得到。
+     * 此时光源剔除在 G-buffer 之后进行，会拆分 G-buffer 与光照的渲染通道，因此只在光源较多时有收益。使用 CPU 剔除时忽略。仅用于延迟管线。
+     */
+    inline void setDepthBoundsCullingEnabled(bool val) { _depthBoundsCullingEnabled = val; }
+    inline bool isDepthBoundsCulling() const { return _depthBoundsCulling; }
+
+    // adds the depth bounds and light culling passes deferred by clusterLightCulling, between the G-buffer and lighting setups
+    void addDepthBoundsCullingPasses();
+
 private:
     ccstd::string &getShaderSource(ShaderStrings &sources);
 
@@ -86,11 +108,21 @@ private:
     void initResetStage();
 
     void initCullingStage();
+    void destroyCullingStage();
+
+    void initTileDepthStage();
+
+    void addTileDepthPass(uint insertPoint);
+    void addCullingPass(uint insertPoint);
 
     void update();
 
     void updateLights();
 
+    void buildClustersCPU();
+    void cullLightsCPU();
+    void addCPUCullingPass();
+
     static bool isProjMatChange(const Mat4 &curProj, const Mat4 &oldProj) {
         for (uint i = 0; i < sizeof(curProj.m) / sizeof(float); i++) {
             if (math::IsNotEqualF(curProj.m[i], oldProj.m[i])) {
@@ -122,6 +154,13 @@ private:
     gfx::PipelineState *      _cullingPipelineState{nullptr};
     gfx::DescriptorSet *      _cullingDescriptorSet{nullptr};
 
+    gfx::Shader *             _tileDepthShader{nullptr};
+    gfx::DescriptorSetLayout *_tileDepthDescriptorSetLayout{nullptr};
+    gfx::PipelineLayout *     _tileDepthPipelineLayout{nullptr};
+    gfx::PipelineState *      _tileDepthPipelineState{nullptr};
+    gfx::DescriptorSet *      _tileDepthDescriptorSet{nullptr};
+    gfx::Sampler *            _tileDepthSampler{nullptr};
+
     static constexpr uint NEAR_FAR_OFFSET     = 0;
     static constexpr uint VIEW_PORT_OFFSET    = 4;
     static constexpr uint MAT_VIEW_OFFSET     = 8;
@@ -138,6 +177,7 @@ private:
     gfx::DispatchInfo _buildingDispatchInfo;
     gfx::DispatchInfo _resetDispatchInfo;
     gfx::DispatchInfo _cullingDispatchInfo;
+    gfx::DispatchInfo _tileDepthDispatchInfo;
 
     bool  _lightBufferResized{false};
     uint  _lightBufferStride{0};
@@ -149,6 +189,27 @@ private:
     ccstd::vector<Mat4> _oldCamProjMats;
 
     bool _initialized{false};
+    bool _cpuCullingEnabled{false};
+    bool _cpuCulling{false};
+    bool _depthBoundsCullingEnabled{false};
+    bool _depthBoundsCulling{false};
+    bool _depthBoundsCullingPending{false};
+
+    // cpu culling data, laid out the same way as the storage buffers written by the compute shaders
+    struct ClusterBounds {
+        Vec3 minBounds;
+        Vec3 maxBounds;
+    };
+    struct ClusterSliceLights {
+        ccstd::vector<uint> indices;
+        ccstd::vector<uint> counts;
+    };
+    ccstd::vector<ClusterBounds>      _clusterBounds;
+    ccstd::vector<Vec4>               _viewLightPositions;
+    ccstd::vector<Vec3>               _viewLightDirections;
+    ccstd::vector<ClusterSliceLights> _sliceLights;
+    ccstd::vector<uint>               _lightIndexData;
+    ccstd::vector<uint>               _lightGridData;
 };
 
 } // namespace pipeline
@@ -0,0 +1,271 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ComputeMorphing.h"
+#include <algorithm>
+#include "ClusterLightCulling.h"
+#include "base/StringUtil.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXPipelineLayout.h"
+#include "gfx-base/GFXPipelineState.h"
+#include "gfx-base/GFXShader.h"
+#include "gfx-base/GFXTexture.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+struct MorphingParams {
+    uint32_t vertexCount{0};
+    uint32_t width{0};
+    uint32_t padding[2]{0};
+};
+
+constexpr const char *MORPHING_SHADER_BODY = R"(
+    layout(local_size_x = %u, local_size_y = 1, local_size_z = 1) in;
+
+    void main() {
+        uint vertex = gl_GlobalInvocationID.x;
+        if (vertex >= cc_morphingParams.x) {
+            return;
+        }
+        vec3 displacement = vec3(0.0);
+        for (uint i = b_ranges[vertex]; i < b_ranges[vertex + 1u]; ++i) {
+            uvec4 delta  = b_deltas[i];
+            float weight = b_weights[delta.w];
+            if (weight != 0.0) {
+                displacement += vec3(uintBitsToFloat(delta.x), uintBitsToFloat(delta.y), uintBitsToFloat(delta.z)) * weight;
+            }
+        }
+        uint width = cc_morphingParams.y;
+        imageStore(cc_displacements, ivec2(int(vertex % width), int(vertex / width)), vec4(displacement, 1.0));
+    })";
+
+ccstd::string &getShaderSource(gfx::Device *device, ShaderStrings &sources) {
+    switch (device->getGfxAPI()) {
+        case gfx::API::GLES2:
+            return sources.glsl1;
+        case gfx::API::GLES3:
+            return sources.glsl3;
+        default: break;
+    }
+    return sources.glsl4;
+}
+} // namespace
+
+ComputeMorphingTarget::~ComputeMorphingTarget() {
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSet);
+    CC_SAFE_DESTROY_AND_DELETE(_paramsBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(_outputTexture);
+}
+
+bool ComputeMorphing::isSupported(const gfx::Device *device) {
+    const auto features = device->getFormatFeatures(gfx::Format::RGBA32F);
+    return device->hasFeature(gfx::Feature::COMPUTE_SHADER) &&
+           hasAllFlags(features, gfx::FormatFeature::SAMPLED_TEXTURE | gfx::FormatFeature::STORAGE_TEXTURE);
+}
+
+bool ComputeMorphing::isAvailable() {
+    return _enabled && initialize();
+}
+
+bool ComputeMorphing::initialize() {
+    if (_initialized) {
+        return _pipelineState != nullptr;
+    }
+    _initialized = true;
+    _device      = gfx::Device::getInstance();
+    if (!_device || !isSupported(_device) || _device->getCapabilities().maxComputeWorkGroupInvocations < WORK_GROUP_SIZE) {
+        return false;
+    }
+
+    const ccstd::string body = StringUtil::format(MORPHING_SHADER_BODY, WORK_GROUP_SIZE);
+    ShaderStrings       sources;
+    sources.glsl4 = R"(
+        layout(set = 0, binding = 0, std140) uniform CCMorphingParams {
+            uvec4 cc_morphingParams; // vertex count, texture width
+        };
+        layout(set = 0, binding = 1, std430) readonly buffer b_morphRanges { uint b_ranges[]; };
+        layout(set = 0, binding = 2, std430) readonly buffer b_morphDeltas { uvec4 b_deltas[]; };
+        layout(set = 0, binding = 3, std430) readonly buffer b_morphWeights { float b_weights[]; };
+        layout(set = 0, binding = 4, rgba32f) writeonly uniform highp image2D cc_displacements;
+        )";
+    sources.glsl4 += body;
+    sources.glsl3 = R"(
+        layout(std140) uniform CCMorphingParams {
+            uvec4 cc_morphingParams; // vertex count, texture width
+        };
+        layout(std430, binding = 1) readonly buffer b_morphRanges { uint b_ranges[]; };
+        layout(std430, binding = 2) readonly buffer b_morphDeltas { uvec4 b_deltas[]; };
+        layout(std430, binding = 3) readonly buffer b_morphWeights { float b_weights[]; };
+        layout(rgba32f, binding = 4) writeonly uniform highp image2D cc_displacements;
+        )";
+    sources.glsl3 += body;
+    // no compute support in GLES2
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name   = "Compute Morphing";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, getShaderSource(_device, sources)}};
+    shaderInfo.blocks = {
+        {0, 0, "CCMorphingParams", {{"cc_morphingParams", gfx::Type::UINT4, 1}}, 1},
+    };
+    shaderInfo.buffers = {
+        {0, 1, "b_morphRanges", 1, gfx::MemoryAccessBit::READ_ONLY},
+        {0, 2, "b_morphDeltas", 1, gfx::MemoryAccessBit::READ_ONLY},
+        {0, 3, "b_morphWeights", 1, gfx::MemoryAccessBit::READ_ONLY},
+    };
+    shaderInfo.images = {
+        {0, 4, "cc_displacements", gfx::Type::IMAGE2D, 1, gfx::MemoryAccessBit::WRITE_ONLY},
+    };
+    _shader = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({1, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({2, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({3, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({4, gfx::DescriptorType::STORAGE_IMAGE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+
+    _descriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _pipelineLayout      = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.shader         = _shader;
+    pipelineInfo.pipelineLayout = _pipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+
+    _pipelineState = _device->createPipelineState(pipelineInfo);
+
+    // the displacements of the last frame are overwritten as a whole
+    gfx::TextureBarrierInfo beginInfo;
+    beginInfo.prevAccesses    = gfx::AccessFlagBit::VERTEX_SHADER_READ_TEXTURE;
+    beginInfo.nextAccesses    = gfx::AccessFlagBit::COMPUTE_SHADER_WRITE;
+    beginInfo.discardContents = 1;
+    _beginBarrier             = _device->getTextureBarrier(beginInfo);
+    _endBarrier               = _device->getTextureBarrier({
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+        gfx::AccessFlagBit::VERTEX_SHADER_READ_TEXTURE,
+    });
+    return true;
+}
+
+ComputeMorphingTarget *ComputeMorphing::createTarget(gfx::Buffer *rangeBuffer, gfx::Buffer *deltaBuffer, gfx::Buffer *weightBuffer, uint32_t vertexCount, uint32_t width, uint32_t height) {
+    if (!isAvailable() || vertexCount == 0 || width * height < vertexCount) {
+        return nullptr;
+    }
+
+    auto *target           = new (std::nothrow) ComputeMorphingTarget();
+    target->_outputTexture = _device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::STORAGE,
+        gfx::Format::RGBA32F,
+        width,
+        height,
+    });
+
+    MorphingParams params;
+    params.vertexCount    = vertexCount;
+    params.width          = width;
+    target->_paramsBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(MorphingParams),
+        sizeof(MorphingParams),
+    });
+    target->_paramsBuffer->update(&params, sizeof(MorphingParams));
+
+    target->_descriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+    target->_descriptorSet->bindBuffer(0, target->_paramsBuffer);
+    target->_descriptorSet->bindBuffer(1, rangeBuffer);
+    target->_descriptorSet->bindBuffer(2, deltaBuffer);
+    target->_descriptorSet->bindBuffer(3, weightBuffer);
+    target->_descriptorSet->bindTexture(4, target->_outputTexture);
+    target->_descriptorSet->update();
+
+    target->_dispatchInfo.groupCountX = (vertexCount + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+    return target;
+}
+
+void ComputeMorphing::enqueue(ComputeMorphingTarget *target) {
+    if (!target->_queued) {
+        target->_queued = true;
+        _queue.emplace_back(target);
+    }
+}
+
+void ComputeMorphing::cancel(ComputeMorphingTarget *target) {
+    if (target->_queued) {
+        target->_queued = false;
+        _queue.erase(std::remove(_queue.begin(), _queue.end(), target), _queue.end());
+    }
+}
+
+void ComputeMorphing::dispatch(gfx::CommandBuffer *cmdBuff) {
+    if (_queue.empty()) {
+        return;
+    }
+
+    _textures.clear();
+    for (auto *target : _queue) {
+        _textures.emplace_back(target->_outputTexture);
+    }
+    _beginBarriers.assign(_textures.size(), _beginBarrier);
+    _endBarriers.assign(_textures.size(), _endBarrier);
+
+    cmdBuff->pipelineBarrier(nullptr, _beginBarriers, _textures);
+    cmdBuff->bindPipelineState(_pipelineState);
+    for (auto *target : _queue) {
+        cmdBuff->bindDescriptorSet(0, target->_descriptorSet);
+        cmdBuff->dispatch(target->_dispatchInfo);
+        target->_queued = false;
+    }
+    cmdBuff->pipelineBarrier(nullptr, _endBarriers, _textures);
+    _queue.clear();
+}
+
+void ComputeMorphing::destroy() {
+    for (auto *target : _queue) {
+        target->_queued = false;
+    }
+    _queue.clear();
+    _textures.clear();
+    _beginBarriers.clear();
+    _endBarriers.clear();
+
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_shader);
+    _beginBarrier = nullptr;
+    _endBarrier   = nullptr;
+    _device       = nullptr;
+    _initialized  = false;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,128 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+class Buffer;
+class CommandBuffer;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class PipelineLayout;
+class PipelineState;
+class Shader;
+class Texture;
+class TextureBarrier;
+} // namespace gfx
+namespace pipeline {
+
+/**
+ * @en Displacement texture of one morph attribute of a sub model, one texel per vertex. It is written by compute shaders and sampled
+ * as precomputed morph displacements by every pass.
+ * @zh 子模型单个变形属性的位移贴图，每个顶点一个像素。由计算着色器写入，所有渲染通道将其作为预计算的变形位移采样。
+ */
+class CC_DLL ComputeMorphingTarget final {
+public:
+    ~ComputeMorphingTarget();
+    ComputeMorphingTarget(const ComputeMorphingTarget &) = delete;
+    ComputeMorphingTarget(ComputeMorphingTarget &&)      = delete;
+    ComputeMorphingTarget &operator=(const ComputeMorphingTarget &) = delete;
+    ComputeMorphingTarget &operator=(ComputeMorphingTarget &&) = delete;
+
+    inline gfx::Texture *getOutputTexture() const { return _outputTexture; }
+
+private:
+    friend class ComputeMorphing;
+    ComputeMorphingTarget() = default;
+
+    gfx::Texture *      _outputTexture{nullptr};
+    gfx::Buffer *       _paramsBuffer{nullptr};
+    gfx::DescriptorSet *_descriptorSet{nullptr};
+    gfx::DispatchInfo   _dispatchInfo;
+    bool                _queued{false};
+};
+
+/**
+ * @en Accumulates the sparse morph target displacements of each vertex with compute shaders, skipping the targets of zero weights.
+ * The deltas are sorted by vertex: the deltas of vertex i are in the range [ranges[i], ranges[i + 1]) of the delta buffer, each one
+ * is a uvec4 of the float bits of the displacement and the index of its target. Requires compute shaders and RGBA32F storage textures.
+ * @zh 使用计算着色器累加每个顶点的稀疏变形目标位移，跳过权重为零的目标。位移按顶点排序：顶点 i 的位移位于位移缓冲的
+ * [ranges[i], ranges[i + 1]) 区间，每个位移为一个 uvec4，存储位移的浮点位与所属目标的索引。需要设备支持计算着色器与 RGBA32F 存储贴图。
+ */
+class CC_DLL ComputeMorphing final {
+public:
+    static constexpr uint32_t WORK_GROUP_SIZE{64};
+
+    ComputeMorphing()                        = default;
+    ~ComputeMorphing()                       = default;
+    ComputeMorphing(const ComputeMorphing &) = delete;
+    ComputeMorphing(ComputeMorphing &&)      = delete;
+    ComputeMorphing &operator=(const ComputeMorphing &) = delete;
+    ComputeMorphing &operator=(ComputeMorphing &&) = delete;
+
+    static bool isSupported(const gfx::Device *device);
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+    // false if disabled or unsupported, creates the shared resources on first call
+    bool isAvailable();
+
+    // the weight buffer holds one float per target, the output texture is width x height, with at least vertexCount texels
+    ComputeMorphingTarget *createTarget(gfx::Buffer *rangeBuffer, gfx::Buffer *deltaBuffer, gfx::Buffer *weightBuffer, uint32_t vertexCount, uint32_t width, uint32_t height);
+    // accumulates the displacements of the target with the current weights in the next dispatch
+    void enqueue(ComputeMorphingTarget *target);
+    // must be called before a queued target is deleted
+    void cancel(ComputeMorphingTarget *target);
+
+    // called right after the command buffer begins, before any pass samples the displacements
+    void dispatch(gfx::CommandBuffer *cmdBuff);
+    void destroy();
+
+private:
+    bool initialize();
+
+    gfx::Device *                          _device{nullptr};
+    gfx::Shader *                          _shader{nullptr};
+    gfx::DescriptorSetLayout *             _descriptorSetLayout{nullptr};
+    gfx::PipelineLayout *                  _pipelineLayout{nullptr};
+    gfx::PipelineState *                   _pipelineState{nullptr};
+    gfx::TextureBarrier *                  _beginBarrier{nullptr};
+    gfx::TextureBarrier *                  _endBarrier{nullptr};
+    ccstd::vector<ComputeMorphingTarget *> _queue;
+    gfx::TextureBarrierList                _beginBarriers;
+    gfx::TextureBarrierList                _endBarriers;
+    gfx::TextureList                       _textures;
+    bool                                   _enabled{true};
+    bool                                   _initialized{false};
+};
+
+} // namespace pipeline
+} // namespace cc
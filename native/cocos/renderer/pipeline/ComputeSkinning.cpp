@@ -0,0 +1,385 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ComputeSkinning.h"
+#include <algorithm>
+#include "ClusterLightCulling.h"
+#include "Define.h"
+#include "base/StringUtil.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXPipelineLayout.h"
+#include "gfx-base/GFXPipelineState.h"
+#include "gfx-base/GFXShader.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+constexpr uint32_t NO_ATTRIBUTE = UINT32_MAX;
+
+enum class JointFormat : uint32_t {
+    UINT8,
+    UINT16,
+    UINT32,
+    FLOAT,
+};
+
+// same order as cc_skinningLayout0 and cc_skinningLayout1 of the shader, offsets are in 4 bytes relative to the vertex except the joints
+struct SkinningLayout {
+    uint32_t vertexCount{0};
+    uint32_t stride{0};
+    uint32_t position{NO_ATTRIBUTE};
+    uint32_t normal{NO_ATTRIBUTE};
+    uint32_t tangent{NO_ATTRIBUTE};
+    uint32_t joints{NO_ATTRIBUTE}; // in bytes
+    uint32_t weights{NO_ATTRIBUTE};
+    uint32_t jointFormat{0};
+};
+
+// the attributes being skinned have to be floats in the stream of the joints, the others are copied over
+bool getSkinningLayout(const gfx::AttributeList &attributes, uint32_t *outStream, SkinningLayout *outLayout) {
+    const auto position = std::find_if(attributes.begin(), attributes.end(), [](const gfx::Attribute &attr) { return attr.name == gfx::ATTR_NAME_POSITION; });
+    if (position == attributes.end() || position->isInstanced) {
+        return false;
+    }
+
+    SkinningLayout layout;
+    uint32_t       offset = 0;
+    for (const auto &attr : attributes) {
+        if (attr.stream != position->stream) {
+            if (attr.name == gfx::ATTR_NAME_NORMAL || attr.name == gfx::ATTR_NAME_TANGENT || attr.name == gfx::ATTR_NAME_JOINTS || attr.name == gfx::ATTR_NAME_WEIGHTS) {
+                return false;
+            }
+            continue;
+        }
+
+        const uint32_t size    = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attr.format)].size;
+        const bool     aligned = offset % 4 == 0;
+        if (attr.name == gfx::ATTR_NAME_POSITION) {
+            if (attr.format != gfx::Format::RGB32F || !aligned) return false;
+            layout.position = offset / 4;
+        } else if (attr.name == gfx::ATTR_NAME_NORMAL) {
+            if (attr.format != gfx::Format::RGB32F || !aligned) return false;
+            layout.normal = offset / 4;
+        } else if (attr.name == gfx::ATTR_NAME_TANGENT) {
+            if (attr.format != gfx::Format::RGBA32F || !aligned) return false;
+            layout.tangent = offset / 4;
+        } else if (attr.name == gfx::ATTR_NAME_WEIGHTS) {
+            if (attr.format != gfx::Format::RGBA32F || !aligned) return false;
+            layout.weights = offset / 4;
+        } else if (attr.name == gfx::ATTR_NAME_JOINTS) {
+            switch (attr.format) {
+                case gfx::Format::RGBA8UI: layout.jointFormat = static_cast<uint32_t>(JointFormat::UINT8); break;
+                case gfx::Format::RGBA16UI: layout.jointFormat = static_cast<uint32_t>(JointFormat::UINT16); break;
+                case gfx::Format::RGBA32UI: layout.jointFormat = static_cast<uint32_t>(JointFormat::UINT32); break;
+                case gfx::Format::RGBA32F: layout.jointFormat = static_cast<uint32_t>(JointFormat::FLOAT); break;
+                default: return false;
+            }
+            // components are read as whole words or from within a single word
+            if (offset % (size / 4) != 0) return false;
+            layout.joints = offset;
+        }
+        offset += size;
+    }
+    if (layout.joints == NO_ATTRIBUTE || layout.weights == NO_ATTRIBUTE) {
+        return false;
+    }
+
+    *outStream = position->stream;
+    *outLayout = layout;
+    return true;
+}
+
+constexpr const char *SKINNING_SHADER_BODY = R"(
+    #define NO_ATTRIBUTE 0xffffffffu
+
+    layout(local_size_x = %u, local_size_y = 1, local_size_z = 1) in;
+
+    float readJoint(uint vertexOffset, uint i) {
+        uint format = cc_skinningLayout1.w;
+        if (format < 2u) {
+            uint size   = format + 1u;
+            uint offset = vertexOffset * 4u + cc_skinningLayout1.y + i * size;
+            uint word   = b_src[offset >> 2u] >> ((offset & 3u) * 8u);
+            return float(word & ((1u << (size * 8u)) - 1u));
+        }
+        uint word = b_src[vertexOffset + (cc_skinningLayout1.y >> 2u) + i];
+        return format == 2u ? float(word) : uintBitsToFloat(word);
+    }
+
+    vec4 readVec4(uint offset) {
+        return vec4(uintBitsToFloat(b_src[offset]), uintBitsToFloat(b_src[offset + 1u]), uintBitsToFloat(b_src[offset + 2u]), uintBitsToFloat(b_src[offset + 3u]));
+    }
+
+    vec3 readVec3(uint offset) {
+        return vec3(uintBitsToFloat(b_src[offset]), uintBitsToFloat(b_src[offset + 1u]), uintBitsToFloat(b_src[offset + 2u]));
+    }
+
+    void writeVec3(uint offset, vec3 v) {
+        b_dst[offset]      = floatBitsToUint(v.x);
+        b_dst[offset + 1u] = floatBitsToUint(v.y);
+        b_dst[offset + 2u] = floatBitsToUint(v.z);
+    }
+
+    // same as the vertex shader skinning with uniform buffers
+    mat4 getJointMatrix(float i) {
+        int  idx = int(i);
+        vec4 v1  = cc_joints[idx * 3];
+        vec4 v2  = cc_joints[idx * 3 + 1];
+        vec4 v3  = cc_joints[idx * 3 + 2];
+        return mat4(vec4(v1.xyz, 0.0), vec4(v2.xyz, 0.0), vec4(v3.xyz, 0.0), vec4(v1.w, v2.w, v3.w, 1.0));
+    }
+
+    void main() {
+        uint vertex = gl_GlobalInvocationID.x;
+        if (vertex >= cc_skinningLayout0.x) {
+            return;
+        }
+        uint stride       = cc_skinningLayout0.y;
+        uint vertexOffset = vertex * stride;
+        for (uint i = 0u; i < stride; ++i) {
+            b_dst[vertexOffset + i] = b_src[vertexOffset + i];
+        }
+
+        vec4 weights = readVec4(vertexOffset + cc_skinningLayout1.z);
+        mat4 m       = getJointMatrix(readJoint(vertexOffset, 0u)) * weights.x +
+                       getJointMatrix(readJoint(vertexOffset, 1u)) * weights.y +
+                       getJointMatrix(readJoint(vertexOffset, 2u)) * weights.z +
+                       getJointMatrix(readJoint(vertexOffset, 3u)) * weights.w;
+
+        uint position = vertexOffset + cc_skinningLayout0.z;
+        writeVec3(position, (m * vec4(readVec3(position), 1.0)).xyz);
+        if (cc_skinningLayout0.w != NO_ATTRIBUTE) {
+            uint normal = vertexOffset + cc_skinningLayout0.w;
+            writeVec3(normal, (m * vec4(readVec3(normal), 0.0)).xyz);
+        }
+        if (cc_skinningLayout1.x != NO_ATTRIBUTE) {
+            uint tangent = vertexOffset + cc_skinningLayout1.x;
+            writeVec3(tangent, (m * vec4(readVec3(tangent), 0.0)).xyz);
+        }
+    })";
+
+ccstd::string &getShaderSource(gfx::Device *device, ShaderStrings &sources) {
+    switch (device->getGfxAPI()) {
+        case gfx::API::GLES2:
+            return sources.glsl1;
+        case gfx::API::GLES3:
+            return sources.glsl3;
+        default: break;
+    }
+    return sources.glsl4;
+}
+} // namespace
+
+ComputeSkinningTarget::~ComputeSkinningTarget() {
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSet);
+    CC_SAFE_DESTROY_AND_DELETE(_layoutBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(_outputBuffer);
+}
+
+bool ComputeSkinning::isSupported(const gfx::Device *device) {
+    return device->hasFeature(gfx::Feature::COMPUTE_SHADER);
+}
+
+bool ComputeSkinning::initialize() {
+    if (_initialized) {
+        return _pipelineState != nullptr;
+    }
+    _initialized = true;
+    _device      = gfx::Device::getInstance();
+    if (!_device || !isSupported(_device) || _device->getCapabilities().maxComputeWorkGroupInvocations < WORK_GROUP_SIZE) {
+        return false;
+    }
+
+    const ccstd::string body = StringUtil::format(SKINNING_SHADER_BODY, WORK_GROUP_SIZE);
+    ShaderStrings       sources;
+    sources.glsl4 = StringUtil::format(
+        R"(
+        layout(set = 0, binding = 0, std140) uniform CCSkinningLayout {
+            uvec4 cc_skinningLayout0; // vertex count, stride, position, normal
+            uvec4 cc_skinningLayout1; // tangent, joints, weights, joint format
+        };
+        layout(set = 0, binding = 1, std140) uniform CCSkinning {
+            vec4 cc_joints[%u];
+        };
+        layout(set = 0, binding = 2, std430) readonly buffer b_srcVertices { uint b_src[]; };
+        layout(set = 0, binding = 3, std430) writeonly buffer b_dstVertices { uint b_dst[]; };
+        )",
+        JOINT_UNIFORM_CAPACITY * 3);
+    sources.glsl4 += body;
+    sources.glsl3 = StringUtil::format(
+        R"(
+        layout(std140) uniform CCSkinningLayout {
+            uvec4 cc_skinningLayout0; // vertex count, stride, position, normal
+            uvec4 cc_skinningLayout1; // tangent, joints, weights, joint format
+        };
+        layout(std140) uniform CCSkinning {
+            vec4 cc_joints[%u];
+        };
+        layout(std430, binding = 2) readonly buffer b_srcVertices { uint b_src[]; };
+        layout(std430, binding = 3) writeonly buffer b_dstVertices { uint b_dst[]; };
+        )",
+        JOINT_UNIFORM_CAPACITY * 3);
+    sources.glsl3 += body;
+    // no compute support in GLES2
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name   = "Compute Skinning";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, getShaderSource(_device, sources)}};
+    shaderInfo.blocks = {
+        {0, 0, "CCSkinningLayout", {{"cc_skinningLayout0", gfx::Type::UINT4, 1}, {"cc_skinningLayout1", gfx::Type::UINT4, 1}}, 1},
+        {0, 1, UBOSkinning::NAME, {{"cc_joints", gfx::Type::FLOAT4, JOINT_UNIFORM_CAPACITY * 3}}, 1},
+    };
+    shaderInfo.buffers = {
+        {0, 2, "b_srcVertices", 1, gfx::MemoryAccessBit::READ_ONLY},
+        {0, 3, "b_dstVertices", 1, gfx::MemoryAccessBit::WRITE_ONLY},
+    };
+    _shader = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({1, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({2, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({3, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+
+    _descriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _pipelineLayout      = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.shader         = _shader;
+    pipelineInfo.pipelineLayout = _pipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+
+    _pipelineState = _device->createPipelineState(pipelineInfo);
+
+    // the draws of the last frame may still read the vertices being written
+    _beginBarrier = _device->getGeneralBarrier({
+        gfx::AccessFlagBit::VERTEX_BUFFER,
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+    });
+    _endBarrier = _device->getGeneralBarrier({
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+        gfx::AccessFlagBit::VERTEX_BUFFER,
+    });
+    return true;
+}
+
+ComputeSkinningTarget *ComputeSkinning::createTarget(RenderingSubMesh *subMesh) {
+    if (!_enabled || !initialize()) {
+        return nullptr;
+    }
+
+    uint32_t       stream = 0;
+    SkinningLayout layout;
+    if (!getSkinningLayout(subMesh->getAttributes(), &stream, &layout)) {
+        return nullptr;
+    }
+    gfx::Buffer *source = subMesh->getSkinningSourceBuffer(stream);
+    if (!source || source->getStride() == 0 || source->getStride() % 4 != 0) {
+        return nullptr;
+    }
+    layout.stride      = source->getStride() / 4;
+    layout.vertexCount = source->getSize() / source->getStride();
+
+    auto *target          = new (std::nothrow) ComputeSkinningTarget();
+    target->_sourceBuffer = source;
+    target->_stream       = stream;
+    target->_outputBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::STORAGE,
+        gfx::MemoryUsageBit::DEVICE,
+        source->getSize(),
+        source->getStride(),
+    });
+    target->_layoutBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(SkinningLayout),
+        sizeof(SkinningLayout),
+    });
+    target->_layoutBuffer->update(&layout, sizeof(SkinningLayout));
+
+    target->_descriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+    target->_descriptorSet->bindBuffer(0, target->_layoutBuffer);
+    target->_descriptorSet->bindBuffer(2, target->_sourceBuffer);
+    target->_descriptorSet->bindBuffer(3, target->_outputBuffer);
+
+    target->_dispatchInfo.groupCountX = (layout.vertexCount + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+    return target;
+}
+
+void ComputeSkinning::enqueue(ComputeSkinningTarget *target, gfx::Buffer *jointBuffer) {
+    target->_descriptorSet->bindBuffer(1, jointBuffer);
+    if (!target->_queued) {
+        target->_queued = true;
+        _queue.emplace_back(target);
+    }
+}
+
+void ComputeSkinning::cancel(ComputeSkinningTarget *target) {
+    if (target->_queued) {
+        target->_queued = false;
+        _queue.erase(std::remove(_queue.begin(), _queue.end(), target), _queue.end());
+    }
+}
+
+void ComputeSkinning::dispatch(gfx::CommandBuffer *cmdBuff) {
+    if (_queue.empty()) {
+        return;
+    }
+
+    cmdBuff->pipelineBarrier(_beginBarrier);
+    cmdBuff->bindPipelineState(_pipelineState);
+    for (auto *target : _queue) {
+        target->_descriptorSet->update();
+        cmdBuff->bindDescriptorSet(0, target->_descriptorSet);
+        cmdBuff->dispatch(target->_dispatchInfo);
+        target->_queued = false;
+    }
+    cmdBuff->pipelineBarrier(_endBarrier);
+    _queue.clear();
+}
+
+void ComputeSkinning::destroy() {
+    for (auto *target : _queue) {
+        target->_queued = false;
+    }
+    _queue.clear();
+
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_shader);
+    _beginBarrier = nullptr;
+    _endBarrier   = nullptr;
+    _device       = nullptr;
+    _initialized  = false;
+}
+
+} // namespace pipeline
+} // namespace cc
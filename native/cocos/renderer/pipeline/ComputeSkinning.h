@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+class RenderingSubMesh;
+namespace gfx {
+class Buffer;
+class CommandBuffer;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class GeneralBarrier;
+class PipelineLayout;
+class PipelineState;
+class Shader;
+} // namespace gfx
+namespace pipeline {
+
+/**
+ * @en Skinned copy of one vertex stream of a sub model. It is written by compute shaders and drawn as static geometry by every pass.
+ * @zh 子模型单个顶点流的蒙皮结果副本，由计算着色器写入，所有渲染通道都将其作为静态几何体绘制。
+ */
+class CC_DLL ComputeSkinningTarget final {
+public:
+    ~ComputeSkinningTarget();
+    ComputeSkinningTarget(const ComputeSkinningTarget &) = delete;
+    ComputeSkinningTarget(ComputeSkinningTarget &&)      = delete;
+    ComputeSkinningTarget &operator=(const ComputeSkinningTarget &) = delete;
+    ComputeSkinningTarget &operator=(ComputeSkinningTarget &&) = delete;
+
+    // replaces the vertex buffer of the stream in the input assembler, has the same layout
+    inline gfx::Buffer *getOutputBuffer() const { return _outputBuffer; }
+    inline uint32_t     getStream() const { return _stream; }
+
+private:
+    friend class ComputeSkinning;
+    ComputeSkinningTarget() = default;
+
+    gfx::Buffer *       _sourceBuffer{nullptr}; // owned by the sub mesh
+    gfx::Buffer *       _outputBuffer{nullptr};
+    gfx::Buffer *       _layoutBuffer{nullptr};
+    gfx::DescriptorSet *_descriptorSet{nullptr};
+    gfx::DispatchInfo   _dispatchInfo;
+    uint32_t            _stream{0};
+    bool                _queued{false};
+};
+
+/**
+ * @en Skins the vertices of skinning models with compute shaders once per frame, before any pass reads them, instead of in the
+ * vertex shader of every pass. Only the models initialized while enabled use it. The others, and the sub meshes it doesn't support,
+ * keep skinning in the vertex shader. Requires compute shader support.
+ * @zh 每帧在所有渲染通道读取顶点之前，使用计算着色器对蒙皮模型的顶点进行一次蒙皮，替代在每个通道的顶点着色器中蒙皮。
+ * 只作用于启用后初始化的模型，其他模型以及不支持的子网格仍在顶点着色器中蒙皮。需要设备支持计算着色器。
+ */
+class CC_DLL ComputeSkinning final {
+public:
+    static constexpr uint32_t WORK_GROUP_SIZE{64};
+
+    ComputeSkinning()                        = default;
+    ~ComputeSkinning()                       = default;
+    ComputeSkinning(const ComputeSkinning &) = delete;
+    ComputeSkinning(ComputeSkinning &&)      = delete;
+    ComputeSkinning &operator=(const ComputeSkinning &) = delete;
+    ComputeSkinning &operator=(ComputeSkinning &&) = delete;
+
+    static bool isSupported(const gfx::Device *device);
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+
+    // nullptr if disabled, unsupported or the vertex layout of the sub mesh can't be skinned by compute
+    ComputeSkinningTarget *createTarget(RenderingSubMesh *subMesh);
+    // skins the target with the joints of the skinning uniform buffer in the next dispatch
+    void enqueue(ComputeSkinningTarget *target, gfx::Buffer *jointBuffer);
+    // must be called before a queued target is deleted
+    void cancel(ComputeSkinningTarget *target);
+
+    // called right after the command buffer begins, before any pass reads the skinned vertices
+    void dispatch(gfx::CommandBuffer *cmdBuff);
+    void destroy();
+
+private:
+    bool initialize();
+
+    gfx::Device *                          _device{nullptr};
+    gfx::Shader *                          _shader{nullptr};
+    gfx::DescriptorSetLayout *             _descriptorSetLayout{nullptr};
+    gfx::PipelineLayout *                  _pipelineLayout{nullptr};
+    gfx::PipelineState *                   _pipelineState{nullptr};
+    gfx::GeneralBarrier *                  _beginBarrier{nullptr};
+    gfx::GeneralBarrier *                  _endBarrier{nullptr};
+    ccstd::vector<ComputeSkinningTarget *> _queue;
+    bool                                   _enabled{true};
+    bool                                   _initialized{false};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "Define.h"
+#include "base/StringPool.h"
 #include "bindings/jswrapper/SeApi.h"
 #include "gfx-base/GFXDevice.h"
 #include "scene/Light.h"
@@ -125,6 +126,10 @@ const gfx::UniformBlock UBOCamera::LAYOUT = {
         {"cc_fogAdd", gfx::Type::FLOAT4, 1},
         {"cc_nearFar", gfx::Type::FLOAT4, 1},
         {"cc_viewPort", gfx::Type::FLOAT4, 1},
+        {"cc_matViews", gfx::Type::MAT4, gfx::MAX_VIEW_COUNT},
+        {"cc_matProjs", gfx::Type::MAT4, gfx::MAX_VIEW_COUNT},
+        {"cc_matViewProjs", gfx::Type::MAT4, gfx::MAX_VIEW_COUNT},
+        {"cc_cameraPositions", gfx::Type::FLOAT4, gfx::MAX_VIEW_COUNT},
     },
     1,
 };
@@ -153,6 +158,7 @@ const gfx::UniformBlock UBOShadow::LAYOUT = {
         {"cc_shadowLPNNInfo", gfx::Type::FLOAT4, 1},
         {"cc_shadowColor", gfx::Type::FLOAT4, 1},
         {"cc_planarNDInfo", gfx::Type::FLOAT4, 1},
+        {"cc_shadowAtlasTileInfo", gfx::Type::FLOAT4, 1},
     },
     1,
 };
@@ -374,6 +380,22 @@ const gfx::UniformSamplerTexture DIFFUSEMAP::LAYOUT = {
     1,
 };
 
+const ccstd::string                   BINDLESSTEXTURES::NAME       = "cc_bindlessTextures";
+const gfx::DescriptorSetLayoutBinding BINDLESSTEXTURES::DESCRIPTOR = {
+    BINDLESSTEXTURES::BINDING,
+    gfx::DescriptorType::SAMPLER_TEXTURE,
+    gfx::MAX_BINDLESS_TEXTURES,
+    gfx::ShaderStageFlagBit::FRAGMENT,
+    {},
+};
+const gfx::UniformSamplerTexture BINDLESSTEXTURES::LAYOUT = {
+    globalSet,
+    BINDLESSTEXTURES::BINDING,
+    BINDLESSTEXTURES::NAME,
+    gfx::Type::SAMPLER2D,
+    gfx::MAX_BINDLESS_TEXTURES,
+};
+
 const ccstd::string                   JOINTTEXTURE::NAME       = "cc_jointTexture";
 const gfx::DescriptorSetLayoutBinding JOINTTEXTURE::DESCRIPTOR = {
     JOINTTEXTURE::BINDING,
@@ -523,16 +545,18 @@ bool supportsR32FloatTexture(gfx::Device *device) {
     return hasAllFlags(device->getFormatFeatures(gfx::Format::R32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE);
 }
 
-static ccstd::unordered_map<ccstd::string, uint32_t> phases; //cjh how to clear this global variable when exiting game?
-static uint32_t                                      phaseNum = 0;
+// keyed by interned phase name, so repeated queries only compare integers
+static ccstd::unordered_map<StringHandle, uint32_t, StringHandle::Hasher> phases; //cjh how to clear this global variable when exiting game?
+static uint32_t                                                            phaseNum = 0;
 
 uint getPhaseID(const ccstd::string &phaseName) {
-    auto iter = phases.find(phaseName);
+    const StringHandle name = internString(phaseName.c_str());
+    auto               iter = phases.find(name);
     if (iter == phases.end()) {
-        phases.emplace(phaseName, 1 << phaseNum);
+        iter = phases.emplace(name, 1 << phaseNum).first;
         ++phaseNum;
     }
-    return phases.at(phaseName);
+    return iter->second;
 }
 
 } // namespace pipeline
@@ -73,6 +73,7 @@ struct CC_DLL RenderPass {
     uint                   shaderID  = 0;
     uint                   passIndex = 0;
     const scene::SubModel *subModel  = nullptr;
+    uint64_t               sortKey   = 0; // hash and depth bits, filled by RenderQueue::sort
 };
 using RenderPassList = ccstd::vector<RenderPass>;
 
@@ -137,10 +138,19 @@ struct CC_DLL InternalBindingInst : public InternalBindingDesc {
     gfx::Texture *texture = nullptr;
 };
 
+enum class CC_DLL RenderQueueSortMode {
+    FRONT_TO_BACK,
+    BACK_TO_FRONT,
+};
+CC_ENUM_CONVERSION_OPERATOR(RenderQueueSortMode)
+
 struct CC_DLL RenderQueueCreateInfo {
     bool                                                          isTransparent = false;
     uint                                                          phases        = 0;
     std::function<bool(const RenderPass &a, const RenderPass &b)> sortFunc;
+    // radix sort the packed sort keys in the order of the compare function of sortMode instead of calling sortFunc
+    bool                sortByKey = false;
+    RenderQueueSortMode sortMode  = RenderQueueSortMode::FRONT_TO_BACK;
 };
 
 enum class CC_DLL RenderPriority {
@@ -150,12 +160,6 @@ enum class CC_DLL RenderPriority {
 };
 CC_ENUM_CONVERSION_OPERATOR(RenderPriority)
 
-enum class CC_DLL RenderQueueSortMode {
-    FRONT_TO_BACK,
-    BACK_TO_FRONT,
-};
-CC_ENUM_CONVERSION_OPERATOR(RenderQueueSortMode)
-
 struct CC_DLL RenderQueueDesc {
     bool                         isTransparent = false;
     RenderQueueSortMode          sortMode      = RenderQueueSortMode::FRONT_TO_BACK;
@@ -437,7 +441,12 @@ struct CC_DLL UBOCamera {
     static constexpr uint                        GLOBAL_FOG_ADD_OFFSET    = UBOCamera::GLOBAL_FOG_BASE_OFFSET + 4;
     static constexpr uint                        GLOBAL_NEAR_FAR_OFFSET   = UBOCamera::GLOBAL_FOG_ADD_OFFSET + 4;
     static constexpr uint                        GLOBAL_VIEW_PORT_OFFSET  = UBOCamera::GLOBAL_NEAR_FAR_OFFSET + 4;
-    static constexpr uint                        COUNT                    = UBOCamera::GLOBAL_VIEW_PORT_OFFSET + 4;
+    // per-view data of multiview cameras, view 0 repeats the camera data otherwise
+    static constexpr uint                        MAT_VIEWS_OFFSET         = UBOCamera::GLOBAL_VIEW_PORT_OFFSET + 4;
+    static constexpr uint                        MAT_PROJS_OFFSET         = UBOCamera::MAT_VIEWS_OFFSET + 16 * gfx::MAX_VIEW_COUNT;
+    static constexpr uint                        MAT_VIEW_PROJS_OFFSET    = UBOCamera::MAT_PROJS_OFFSET + 16 * gfx::MAX_VIEW_COUNT;
+    static constexpr uint                        CAMERA_POSITIONS_OFFSET  = UBOCamera::MAT_VIEW_PROJS_OFFSET + 16 * gfx::MAX_VIEW_COUNT;
+    static constexpr uint                        COUNT                    = UBOCamera::CAMERA_POSITIONS_OFFSET + 4 * gfx::MAX_VIEW_COUNT;
     static constexpr uint                        SIZE                     = UBOCamera::COUNT * 4;
     static constexpr uint                        BINDING                  = static_cast<uint>(PipelineGlobalBindings::UBO_CAMERA);
     static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
@@ -457,7 +466,8 @@ struct CC_DLL UBOShadow {
     static constexpr uint                        SHADOW_LIGHT_PACKING_NBIAS_NULL_INFO_OFFSET   = UBOShadow::SHADOW_WIDTH_HEIGHT_PCF_BIAS_INFO_OFFSET + 4;
     static constexpr uint                        SHADOW_COLOR_OFFSET                           = UBOShadow::SHADOW_LIGHT_PACKING_NBIAS_NULL_INFO_OFFSET + 4;
     static constexpr uint                        PLANAR_NORMAL_DISTANCE_INFO_OFFSET            = UBOShadow::SHADOW_COLOR_OFFSET + 4;
-    static constexpr uint                        COUNT                                         = UBOShadow::PLANAR_NORMAL_DISTANCE_INFO_OFFSET + 4;
+    static constexpr uint                        SHADOW_ATLAS_TILE_INFO_OFFSET                 = UBOShadow::PLANAR_NORMAL_DISTANCE_INFO_OFFSET + 4;
+    static constexpr uint                        COUNT                                         = UBOShadow::SHADOW_ATLAS_TILE_INFO_OFFSET + 4;
     static constexpr uint                        SIZE                                          = UBOShadow::COUNT * 4;
     static constexpr uint                        BINDING                                       = static_cast<uint>(PipelineGlobalBindings::UBO_SHADOW);
     static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
@@ -529,6 +539,14 @@ struct CC_DLL DIFFUSEMAP {
     static const ccstd::string                   NAME;
 };
 
+// appended to the global bindings on devices with gfx::Feature::BINDLESS_TEXTURE, see BindlessTextureTable
+struct CC_DLL BINDLESSTEXTURES {
+    static constexpr uint                        BINDING = static_cast<uint>(PipelineGlobalBindings::COUNT);
+    static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
+    static const gfx::UniformSamplerTexture      LAYOUT;
+    static const ccstd::string                   NAME;
+};
+
 struct CC_DLL JOINTTEXTURE {
     static constexpr uint                        BINDING = static_cast<uint>(ModelLocalBindings::SAMPLER_JOINTS);
     static const gfx::DescriptorSetLayoutBinding DESCRIPTOR;
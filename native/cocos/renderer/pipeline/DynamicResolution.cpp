@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+namespace cc {
+namespace pipeline {
+namespace {
+// frames for the filtered frame time to follow a scale change before judging it
+constexpr uint32_t SETTLE_FRAMES = 15;
+// frame times within this ratio above the target still count as on target, which absorbs vsync jitter
+constexpr float TOLERANCE    = 0.1F;
+constexpr float FILTER_ALPHA = 0.1F;
+} // namespace
+
+void DynamicResolution::setScaleRange(float minScale, float maxScale) {
+    _maxScale = std::max(maxScale, 0.01F);
+    _minScale = std::min(std::max(minScale, 0.01F), _maxScale);
+}
+
+void DynamicResolution::setScaleStep(float step) {
+    _scaleStep = std::max(step, 0.01F);
+}
+
+float DynamicResolution::snap(float scale) const {
+    // round down to max - k * step
+    const float steps = std::ceil((_maxScale - scale) / _scaleStep - 1e-4F);
+    return std::max(_maxScale - std::max(steps, 0.F) * _scaleStep, _minScale);
+}
+
+float DynamicResolution::update(float frameTime, float currentScale) {
+    _frameTime = _frameTime > 0.F ? _frameTime + (frameTime - _frameTime) * FILTER_ALPHA : frameTime;
+
+    const float scale = snap(currentScale);
+    if (++_framesSinceChange < SETTLE_FRAMES) {
+        return scale;
+    }
+
+    float      next       = scale;
+    const bool overBudget = _frameTime > _targetFrameTime * (1.F + TOLERANCE);
+    if (overBudget && scale > _minScale) {
+        // the shading cost is about proportional to the pixel count
+        next = std::min(snap(scale * std::sqrt(_targetFrameTime / _frameTime)), scale - _scaleStep);
+        if (_lastChangeRaised && _framesSinceChange < _raiseDelay) {
+            _raiseDelay = std::min(_raiseDelay * 2, MAX_RAISE_DELAY);
+        }
+    } else if (!overBudget && _framesSinceChange >= _raiseDelay && scale < _maxScale) {
+        next = snap(std::min(scale + _scaleStep, _maxScale));
+        if (_lastChangeRaised) {
+            // the last raise held, probe faster again
+            _raiseDelay = std::max(_raiseDelay / 2, MIN_RAISE_DELAY);
+        }
+    }
+
+    next = std::max(next, _minScale);
+    if (next != scale) {
+        _lastChangeRaised  = next > scale;
+        _framesSinceChange = 0;
+    }
+    return next;
+}
+
+} // namespace pipeline
+} // namespace cc
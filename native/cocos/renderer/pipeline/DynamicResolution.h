@@ -0,0 +1,82 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include "base/Macros.h"
+
+namespace cc {
+namespace pipeline {
+
+/**
+ * @en Controller of the shading scale driven by frame timings. The scale is lowered when the frame time exceeds the target
+ * and raised one step at a time after the frame time stays within the target for a while. Scales are snapped to steps down
+ * from the max scale, so the frame graph keeps reusing the transient textures of the few sizes in use.
+ * @zh 由帧耗时驱动的着色缩放控制器。帧耗时超过目标时降低缩放，帧耗时持续满足目标一段时间后逐级提升。
+ * 缩放值对齐到自最大值向下的固定步长，使帧图能持续复用少数几种尺寸的临时纹理。
+ */
+class CC_DLL DynamicResolution final {
+public:
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+
+    // target frame time in seconds
+    inline float getTargetFrameTime() const { return _targetFrameTime; }
+    inline void  setTargetFrameTime(float seconds) { _targetFrameTime = seconds; }
+
+    inline float getMinScale() const { return _minScale; }
+    inline float getMaxScale() const { return _maxScale; }
+    void         setScaleRange(float minScale, float maxScale);
+
+    inline float getScaleStep() const { return _scaleStep; }
+    void         setScaleStep(float step);
+
+    // filtered frame time in seconds
+    inline float getFrameTime() const { return _frameTime; }
+
+    // feed the duration of the last frame in seconds, returns the shading scale to render the next frame with
+    float update(float frameTime, float currentScale);
+
+private:
+    // frames within the target before trying a higher scale, doubled each time a raise misses the target
+    static constexpr uint32_t MIN_RAISE_DELAY{60};
+    static constexpr uint32_t MAX_RAISE_DELAY{960};
+
+    float snap(float scale) const;
+
+    bool     _enabled{false};
+    float    _targetFrameTime{1.F / 60.F};
+    float    _minScale{0.5F};
+    float    _maxScale{1.F};
+    float    _scaleStep{0.125F};
+    float    _frameTime{0.F};
+    uint32_t _framesSinceChange{0};
+    uint32_t _raiseDelay{MIN_RAISE_DELAY};
+    bool     _lastChangeRaised{false};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -31,11 +31,12 @@ enum class CommonInsertPoint {
 };
 
 enum class DeferredInsertPoint {
-    DIP_CLUSTER     = 80,
-    DIP_GBUFFER     = 100,
-    DIP_LIGHTING    = 200,
-    DIP_TRANSPARENT = 220,
-    DIP_SSPR        = 300,
+    DIP_CLUSTER      = 80,
+    DIP_GBUFFER      = 100,
+    DIP_CLUSTER_TILE = 150,
+    DIP_LIGHTING     = 200,
+    DIP_TRANSPARENT  = 220,
+    DIP_SSPR         = 300,
     DIP_INVALID
 };
 
@@ -0,0 +1,465 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "EnvironmentPrefilter.h"
+#include <cmath>
+#include <cstring>
+#include "ClusterLightCulling.h"
+#include "GPUTimer.h"
+#include "base/StringUtil.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXPipelineLayout.h"
+#include "gfx-base/GFXPipelineState.h"
+#include "gfx-base/GFXShader.h"
+#include "gfx-base/GFXTexture.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+struct PrefilterParams {
+    float size{0.F};
+    float firstRow{0.F};
+    float roughness{0.F};
+    float sampleCount{0.F};
+    float sourceSize{0.F};
+    float sourceMipCount{0.F};
+    float isRGBE{0.F};
+    float isDiffuse{0.F};
+};
+
+constexpr const char *PREFILTER_SHADER_BODY = R"(
+    layout(local_size_x = %u, local_size_y = %u, local_size_z = 1) in;
+
+    const float PI = 3.14159265359;
+
+    vec3 decode(vec4 color) {
+        return cc_prefilterSourceInfo.z > 0.5 ? color.rgb * pow(1.1, color.a * 255.0 - 128.0) : color.rgb * color.rgb;
+    }
+
+    vec4 encode(vec3 color) {
+        if (cc_prefilterSourceInfo.z > 0.5) {
+            float maxComp  = max(max(color.r, color.g), max(color.b, 1e-6));
+            float exponent = clamp(ceil(log(maxComp) / log(1.1)), -128.0, 127.0);
+            return vec4(color / pow(1.1, exponent), (exponent + 128.0) / 255.0);
+        }
+        return vec4(sqrt(color), 1.0);
+    }
+
+    vec3 faceDirection(uint face, vec2 uv) {
+        if (face == 0u) return vec3(1.0, -uv.y, -uv.x);
+        if (face == 1u) return vec3(-1.0, -uv.y, uv.x);
+        if (face == 2u) return vec3(uv.x, 1.0, uv.y);
+        if (face == 3u) return vec3(uv.x, -1.0, -uv.y);
+        if (face == 4u) return vec3(uv.x, -uv.y, 1.0);
+        return vec3(-uv.x, -uv.y, -1.0);
+    }
+
+    vec2 hammersley(uint i, uint count) {
+        uint bits = (i << 16u) | (i >> 16u);
+        bits      = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+        bits      = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+        bits      = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+        bits      = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+        return vec2(float(i) / float(count), float(bits) * 2.3283064365386963e-10);
+    }
+
+    // mip of the source whose texels cover the solid angle of one sample of the given pdf
+    float sourceLod(float pdf, float count) {
+        float texelSolidAngle  = 4.0 * PI / (6.0 * cc_prefilterSourceInfo.x * cc_prefilterSourceInfo.x);
+        float sampleSolidAngle = 1.0 / (count * pdf + 1e-6);
+        return clamp(0.5 * log2(sampleSolidAngle / texelSolidAngle) + 1.0, 0.0, cc_prefilterSourceInfo.y - 1.0);
+    }
+
+    void main() {
+        uint  size = uint(cc_prefilterParams.x);
+        uvec3 id   = gl_GlobalInvocationID;
+        uint  row  = id.y + uint(cc_prefilterParams.y);
+        if (id.x >= size || row >= size) {
+            return;
+        }
+        vec2 uv = (vec2(float(id.x), float(row)) + 0.5) / float(size) * 2.0 - 1.0;
+        vec3 N  = normalize(faceDirection(id.z, uv));
+        vec3 up = abs(N.y) < 0.999 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0);
+        vec3 T  = normalize(cross(up, N));
+        vec3 B  = cross(N, T);
+
+        uint  count     = uint(cc_prefilterParams.w);
+        float roughness = cc_prefilterParams.z;
+        vec3  result    = vec3(0.0);
+        if (cc_prefilterSourceInfo.w > 0.5) {
+            // cosine weighted irradiance, the pdf is cos / pi
+            for (uint i = 0u; i < count; ++i) {
+                vec2  xi       = hammersley(i, count);
+                float phi      = 2.0 * PI * xi.x;
+                float cosTheta = sqrt(1.0 - xi.y);
+                float sinTheta = sqrt(xi.y);
+                vec3  L        = T * (cos(phi) * sinTheta) + B * (sin(phi) * sinTheta) + N * cosTheta;
+                result += decode(textureLod(cc_prefilterSource, L, sourceLod(cosTheta / PI, float(count))));
+            }
+            result /= float(count);
+        } else if (roughness <= 0.0) {
+            result = decode(textureLod(cc_prefilterSource, N, 0.0));
+        } else {
+            // GGX importance sampling with N = V = R
+            float a      = roughness * roughness;
+            float weight = 0.0;
+            for (uint i = 0u; i < count; ++i) {
+                vec2  xi       = hammersley(i, count);
+                float phi      = 2.0 * PI * xi.x;
+                float cosTheta = sqrt((1.0 - xi.y) / (1.0 + (a * a - 1.0) * xi.y));
+                float sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+                vec3  H        = T * (cos(phi) * sinTheta) + B * (sin(phi) * sinTheta) + N * cosTheta;
+                vec3  L        = 2.0 * dot(N, H) * H - N;
+                float NoL      = dot(N, L);
+                if (NoL > 0.0) {
+                    float d   = (cosTheta * cosTheta) * (a * a - 1.0) + 1.0;
+                    float D   = a * a / (PI * d * d);
+                    float pdf = D * 0.25;
+                    result += decode(textureLod(cc_prefilterSource, L, sourceLod(pdf, float(count)))) * NoL;
+                    weight += NoL;
+                }
+            }
+            result /= max(weight, 1e-6);
+        }
+        imageStore(cc_prefilterOutput, ivec3(int(id.x), int(row), int(id.z)), encode(result));
+    })";
+
+ccstd::string &getShaderSource(gfx::Device *device, ShaderStrings &sources) {
+    switch (device->getGfxAPI()) {
+        case gfx::API::GLES2:
+            return sources.glsl1;
+        case gfx::API::GLES3:
+            return sources.glsl3;
+        default: break;
+    }
+    return sources.glsl4;
+}
+
+uint32_t getMipmapCount(uint32_t size) {
+    uint32_t count = 1;
+    while (size > 1) {
+        size >>= 1U;
+        ++count;
+    }
+    return count;
+}
+} // namespace
+
+EnvironmentPrefilterTarget::~EnvironmentPrefilterTarget() {
+    for (auto &tile : _tiles) {
+        CC_SAFE_DESTROY_AND_DELETE(tile.descriptorSet);
+        CC_SAFE_DESTROY_AND_DELETE(tile.paramsBuffer);
+        CC_SAFE_DESTROY_AND_DELETE(tile.view);
+    }
+    CC_SAFE_DESTROY_AND_DELETE(_diffuseTexture);
+    CC_SAFE_DESTROY_AND_DELETE(_specularTexture);
+}
+
+bool EnvironmentPrefilter::isSupported(const gfx::Device *device) {
+    const auto features = device->getFormatFeatures(gfx::Format::RGBA8);
+    return device->hasFeature(gfx::Feature::COMPUTE_SHADER) &&
+           hasAllFlags(features, gfx::FormatFeature::SAMPLED_TEXTURE | gfx::FormatFeature::STORAGE_TEXTURE);
+}
+
+bool EnvironmentPrefilter::isAvailable() {
+    return _enabled && initialize();
+}
+
+bool EnvironmentPrefilter::initialize() {
+    if (_initialized) {
+        return _pipelineState != nullptr;
+    }
+    _initialized = true;
+    _device      = gfx::Device::getInstance();
+    if (!_device || !isSupported(_device) || _device->getCapabilities().maxComputeWorkGroupInvocations < WORK_GROUP_SIZE * WORK_GROUP_SIZE) {
+        return false;
+    }
+
+    const ccstd::string body = StringUtil::format(PREFILTER_SHADER_BODY, WORK_GROUP_SIZE, WORK_GROUP_SIZE);
+    ShaderStrings       sources;
+    sources.glsl4 = R"(
+        layout(set = 0, binding = 0, std140) uniform CCPrefilterParams {
+            vec4 cc_prefilterParams; // size, first row, roughness, sample count
+            vec4 cc_prefilterSourceInfo; // source size, source mip count, rgbe, diffuse
+        };
+        layout(set = 0, binding = 1) uniform samplerCube cc_prefilterSource;
+        layout(set = 0, binding = 2, rgba8) writeonly uniform highp image2DArray cc_prefilterOutput;
+        )";
+    sources.glsl4 += body;
+    sources.glsl3 = R"(
+        layout(std140) uniform CCPrefilterParams {
+            vec4 cc_prefilterParams; // size, first row, roughness, sample count
+            vec4 cc_prefilterSourceInfo; // source size, source mip count, rgbe, diffuse
+        };
+        uniform samplerCube cc_prefilterSource;
+        layout(rgba8, binding = 2) writeonly uniform highp image2DArray cc_prefilterOutput;
+        )";
+    sources.glsl3 += body;
+    // no compute support in GLES2
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name   = "Environment Prefilter";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, getShaderSource(_device, sources)}};
+    shaderInfo.blocks = {
+        {0, 0, "CCPrefilterParams", {{"cc_prefilterParams", gfx::Type::FLOAT4, 1}, {"cc_prefilterSourceInfo", gfx::Type::FLOAT4, 1}}, 1},
+    };
+    shaderInfo.samplerTextures = {{0, 1, "cc_prefilterSource", gfx::Type::SAMPLER_CUBE, 1}};
+    shaderInfo.images          = {
+        {0, 2, "cc_prefilterOutput", gfx::Type::IMAGE2D_ARRAY, 1, gfx::MemoryAccessBit::WRITE_ONLY},
+    };
+    _shader = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({1, gfx::DescriptorType::SAMPLER_TEXTURE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({2, gfx::DescriptorType::STORAGE_IMAGE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+
+    _descriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _pipelineLayout      = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.shader         = _shader;
+    pipelineInfo.pipelineLayout = _pipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+
+    _pipelineState = _device->createPipelineState(pipelineInfo);
+
+    gfx::SamplerInfo samplerInfo;
+    samplerInfo.mipFilter = gfx::Filter::LINEAR;
+    samplerInfo.addressU  = gfx::Address::CLAMP;
+    samplerInfo.addressV  = gfx::Address::CLAMP;
+    samplerInfo.addressW  = gfx::Address::CLAMP;
+    _sampler              = _device->getSampler(samplerInfo);
+
+    // the tiles not recorded yet keep the contents of the earlier frames
+    _beginBarrier = _device->getTextureBarrier({
+        gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE,
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+    });
+    _endBarrier = _device->getTextureBarrier({
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+        gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE,
+    });
+    return true;
+}
+
+EnvironmentPrefilterTarget *EnvironmentPrefilter::createTarget(gfx::Texture *source, bool isRGBE) {
+    if (!isAvailable() || source == nullptr || source->getInfo().type != gfx::TextureType::CUBE || source->getWidth() == 0) {
+        return nullptr;
+    }
+
+    const uint32_t size  = source->getWidth();
+    const auto     usage = gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::STORAGE;
+
+    auto *target             = new (std::nothrow) EnvironmentPrefilterTarget();
+    target->_mipmapCount     = getMipmapCount(size);
+    target->_specularTexture = _device->createTexture({
+        gfx::TextureType::CUBE,
+        usage,
+        gfx::Format::RGBA8,
+        size,
+        size,
+        gfx::TextureFlagBit::NONE,
+        6,
+        target->_mipmapCount,
+    });
+    target->_diffuseTexture = _device->createTexture({
+        gfx::TextureType::CUBE,
+        usage,
+        gfx::Format::RGBA8,
+        DIFFUSE_SIZE,
+        DIFFUSE_SIZE,
+        gfx::TextureFlagBit::NONE,
+        6,
+        1,
+    });
+
+    // the smallest levels first, so the maps converge quickly
+    addTiles(target, source, target->_diffuseTexture, 0, DIFFUSE_SIZE, 1.F, DIFFUSE_SAMPLES, isRGBE, true);
+    for (uint32_t level = target->_mipmapCount; level-- > 0;) {
+        const float roughness = static_cast<float>(level) / static_cast<float>(target->_mipmapCount);
+        addTiles(target, source, target->_specularTexture, level, std::max(size >> level, 1U), roughness, level == 0 ? 1 : SPECULAR_SAMPLES, isRGBE, false);
+    }
+    return target;
+}
+
+void EnvironmentPrefilter::addTiles(EnvironmentPrefilterTarget *target, gfx::Texture *source, gfx::Texture *output, uint32_t level, uint32_t size, float roughness, uint32_t samples, bool isRGBE, bool diffuse) {
+    gfx::TextureViewInfo viewInfo;
+    viewInfo.type       = gfx::TextureType::TEX2D_ARRAY;
+    viewInfo.format     = gfx::Format::RGBA8;
+    viewInfo.baseLevel  = level;
+    viewInfo.levelCount = 1;
+    viewInfo.layerCount = 6;
+
+    // whole work group rows, at least one per tile
+    const uint32_t rowSamples = size * 6 * samples;
+    uint32_t       rows       = std::max(TILE_SAMPLES / rowSamples / WORK_GROUP_SIZE, 1U) * WORK_GROUP_SIZE;
+    rows                      = std::min(rows, size);
+    for (uint32_t row = 0; row < size; row += rows) {
+        EnvironmentPrefilterTarget::Tile tile;
+        viewInfo.texture = output;
+        tile.view        = _device->createTexture(viewInfo);
+
+        PrefilterParams params;
+        params.size           = static_cast<float>(size);
+        params.firstRow       = static_cast<float>(row);
+        params.roughness      = roughness;
+        params.sampleCount    = static_cast<float>(samples);
+        params.sourceSize     = static_cast<float>(source->getWidth());
+        params.sourceMipCount = static_cast<float>(source->getInfo().levelCount);
+        params.isRGBE         = isRGBE ? 1.F : 0.F;
+        params.isDiffuse      = diffuse ? 1.F : 0.F;
+        tile.paramsBuffer     = _device->createBuffer({
+            gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+            gfx::MemoryUsageBit::DEVICE,
+            sizeof(PrefilterParams),
+            sizeof(PrefilterParams),
+        });
+        tile.paramsBuffer->update(&params, sizeof(PrefilterParams));
+
+        tile.descriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+        tile.descriptorSet->bindBuffer(0, tile.paramsBuffer);
+        tile.descriptorSet->bindTexture(1, source);
+        tile.descriptorSet->bindSampler(1, _sampler);
+        tile.descriptorSet->bindTexture(2, tile.view);
+        tile.descriptorSet->update();
+
+        const uint32_t tileRows       = std::min(rows, size - row);
+        tile.dispatchInfo.groupCountX = (size + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+        tile.dispatchInfo.groupCountY = (tileRows + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE;
+        tile.dispatchInfo.groupCountZ = 6;
+        tile.samples                  = size * tileRows * 6 * samples;
+        target->_tiles.emplace_back(tile);
+    }
+}
+
+void EnvironmentPrefilter::enqueue(EnvironmentPrefilterTarget *target) {
+    target->_nextTile = 0;
+    if (!target->_queued) {
+        target->_queued = true;
+        _queue.emplace_back(target);
+    }
+}
+
+void EnvironmentPrefilter::cancel(EnvironmentPrefilterTarget *target) {
+    if (target->_queued) {
+        target->_queued = false;
+        _queue.erase(std::remove(_queue.begin(), _queue.end(), target), _queue.end());
+    }
+}
+
+void EnvironmentPrefilter::updateSampleBudget(const GPUTimer *timer) {
+    if (timer == nullptr || !timer->isEnabled() || _frameBudget <= 0.F) {
+        return;
+    }
+    for (const auto &timing : timer->getTimings()) {
+        if (timing.time > 0.F && std::strcmp(timing.name, SCOPE_NAME) == 0) {
+            // the timing is a few frames old, so the budget moves by at most a factor of two per frame
+            const float scale = std::min(std::max(_frameBudget / timing.time, 0.5F), 2.F);
+            _sampleBudget     = static_cast<uint32_t>(std::min(static_cast<float>(_sampleBudget) * scale, static_cast<float>(1U << 30U)));
+            _sampleBudget     = std::max(_sampleBudget, TILE_SAMPLES);
+            break;
+        }
+    }
+}
+
+void EnvironmentPrefilter::dispatch(gfx::CommandBuffer *cmdBuff, GPUTimer *timer) {
+    if (_queue.empty()) {
+        return;
+    }
+    updateSampleBudget(timer);
+
+    _textures.clear();
+    for (auto *target : _queue) {
+        _textures.emplace_back(target->_specularTexture);
+        _textures.emplace_back(target->_diffuseTexture);
+    }
+    _beginBarriers.assign(_textures.size(), _beginBarrier);
+    _endBarriers.assign(_textures.size(), _endBarrier);
+
+    const bool timed = timer != nullptr && timer->isEnabled();
+    if (timed) {
+        timer->beginScope(SCOPE_NAME);
+    }
+    cmdBuff->pipelineBarrier(nullptr, _beginBarriers, _textures);
+    cmdBuff->bindPipelineState(_pipelineState);
+    // the oldest requests first, always at least one tile so every target completes
+    _recordedSamples = 0;
+    for (auto *target : _queue) {
+        while (!target->isComplete()) {
+            const auto &tile = target->_tiles[target->_nextTile];
+            if (_recordedSamples > 0 && _recordedSamples + tile.samples > _sampleBudget) {
+                break;
+            }
+            cmdBuff->bindDescriptorSet(0, tile.descriptorSet);
+            cmdBuff->dispatch(tile.dispatchInfo);
+            _recordedSamples += tile.samples;
+            ++target->_nextTile;
+        }
+    }
+    cmdBuff->pipelineBarrier(nullptr, _endBarriers, _textures);
+    if (timed) {
+        timer->endScope();
+    }
+
+    // callbacks may enqueue targets again
+    auto queue = _queue;
+    _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [](EnvironmentPrefilterTarget *target) { return target->isComplete(); }), _queue.end());
+    for (auto *target : queue) {
+        if (target->isComplete()) {
+            target->_queued = false;
+            if (target->_completeCallback) {
+                target->_completeCallback();
+            }
+        }
+    }
+}
+
+void EnvironmentPrefilter::destroy() {
+    for (auto *target : _queue) {
+        target->_queued = false;
+    }
+    _queue.clear();
+    _textures.clear();
+    _beginBarriers.clear();
+    _endBarriers.clear();
+
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_shader);
+    _sampler      = nullptr;
+    _beginBarrier = nullptr;
+    _endBarrier   = nullptr;
+    _device       = nullptr;
+    _initialized  = false;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,174 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+
+namespace cc {
+namespace gfx {
+class Buffer;
+class CommandBuffer;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class PipelineLayout;
+class PipelineState;
+class Sampler;
+class Shader;
+class Texture;
+class TextureBarrier;
+} // namespace gfx
+namespace pipeline {
+
+class GPUTimer;
+
+/**
+ * @en The prefiltered specular and diffuse irradiance cube maps of one environment map. Each mip of the specular map holds the
+ * radiance convolved with the GGX lobe of roughness mip / mip count, the diffuse map holds the cosine weighted irradiance.
+ * Both keep the encoding of the source, RGBE or sRGB, so they can replace the baked maps without changing the shaders.
+ * @zh 单张环境贴图预过滤后的镜面与漫反射辐照度立方体贴图。镜面贴图的每级 mip 存储以粗糙度 mip / mip 数量的 GGX 波瓣卷积后的辐射度，
+ * 漫反射贴图存储余弦加权的辐照度。两者保持源贴图的编码（RGBE 或 sRGB），可以在不修改着色器的情况下替换离线烘焙的贴图。
+ */
+class CC_DLL EnvironmentPrefilterTarget final {
+public:
+    ~EnvironmentPrefilterTarget();
+    EnvironmentPrefilterTarget(const EnvironmentPrefilterTarget &) = delete;
+    EnvironmentPrefilterTarget(EnvironmentPrefilterTarget &&)      = delete;
+    EnvironmentPrefilterTarget &operator=(const EnvironmentPrefilterTarget &) = delete;
+    EnvironmentPrefilterTarget &operator=(EnvironmentPrefilterTarget &&) = delete;
+
+    inline gfx::Texture *getSpecularTexture() const { return _specularTexture; }
+    inline gfx::Texture *getDiffuseTexture() const { return _diffuseTexture; }
+    inline uint32_t      getMipmapCount() const { return _mipmapCount; }
+    // true once every tile has been recorded, the maps can be sampled by the passes recorded afterwards
+    inline bool isComplete() const { return _nextTile >= static_cast<uint32_t>(_tiles.size()); }
+
+    // called in dispatch when the last tile has been recorded
+    inline void setCompleteCallback(std::function<void()> &&callback) { _completeCallback = std::move(callback); }
+
+private:
+    friend class EnvironmentPrefilter;
+    EnvironmentPrefilterTarget() = default;
+
+    // rows [y, y + rows) of all the faces of one level of one of the maps
+    struct Tile {
+        gfx::Texture *      view{nullptr};
+        gfx::Buffer *       paramsBuffer{nullptr};
+        gfx::DescriptorSet *descriptorSet{nullptr};
+        gfx::DispatchInfo   dispatchInfo;
+        uint32_t            samples{0};
+    };
+
+    gfx::Texture *        _specularTexture{nullptr};
+    gfx::Texture *        _diffuseTexture{nullptr};
+    ccstd::vector<Tile>   _tiles;
+    std::function<void()> _completeCallback;
+    uint32_t              _mipmapCount{0};
+    uint32_t              _nextTile{0};
+    bool                  _queued{false};
+};
+
+/**
+ * @en Prefilters environment maps at runtime with compute shaders, so that cube maps changed or captured at runtime can be used for
+ * image based lighting. The work is split into tiles and amortized across frames: each frame records tiles until the sample budget
+ * is spent, and the budget is steered toward the frame time budget when GPU timing is enabled. Requires compute shaders and RGBA8
+ * storage textures.
+ * @zh 使用计算着色器在运行时预过滤环境贴图，使运行时修改或捕获的立方体贴图可用于基于图像的光照。工作被拆分为分块并分摊到多帧：
+ * 每帧录制分块直至用完采样预算，开启 GPU 计时后预算会向每帧耗时预算调整。需要设备支持计算着色器与 RGBA8 存储贴图。
+ */
+class CC_DLL EnvironmentPrefilter final {
+public:
+    static constexpr uint32_t WORK_GROUP_SIZE{8};
+    static constexpr uint32_t SPECULAR_SAMPLES{64};
+    static constexpr uint32_t DIFFUSE_SAMPLES{256};
+    static constexpr uint32_t DIFFUSE_SIZE{32};
+    // upper bound of the samples of one tile, the smallest unit of work
+    static constexpr uint32_t TILE_SAMPLES{1U << 20U};
+    // name of the GPU timing scope of the recorded tiles
+    static constexpr const char *SCOPE_NAME{"EnvironmentPrefilter"};
+
+    EnvironmentPrefilter()                             = default;
+    ~EnvironmentPrefilter()                            = default;
+    EnvironmentPrefilter(const EnvironmentPrefilter &) = delete;
+    EnvironmentPrefilter(EnvironmentPrefilter &&)      = delete;
+    EnvironmentPrefilter &operator=(const EnvironmentPrefilter &) = delete;
+    EnvironmentPrefilter &operator=(EnvironmentPrefilter &&) = delete;
+
+    static bool isSupported(const gfx::Device *device);
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+    // false if disabled or unsupported, creates the shared resources on first call
+    bool isAvailable();
+
+    // samples recorded per frame, adjusted at runtime when GPU timing is enabled
+    inline uint32_t getSampleBudget() const { return _sampleBudget; }
+    inline void     setSampleBudget(uint32_t samples) { _sampleBudget = std::max(samples, 1U); }
+    // milliseconds of GPU time per frame the sample budget is steered toward
+    inline float getFrameBudget() const { return _frameBudget; }
+    inline void  setFrameBudget(float ms) { _frameBudget = ms; }
+
+    // the source is a cube map sampled with its mips, the specular map has the size of the source and a full mip chain
+    EnvironmentPrefilterTarget *createTarget(gfx::Texture *source, bool isRGBE);
+    // restarts the prefiltering of the target from its first tile
+    void enqueue(EnvironmentPrefilterTarget *target);
+    // must be called before a queued target is deleted
+    void cancel(EnvironmentPrefilterTarget *target);
+
+    // called right after the command buffer begins, before any pass samples the environment
+    void dispatch(gfx::CommandBuffer *cmdBuff, GPUTimer *timer = nullptr);
+    void destroy();
+
+private:
+    bool initialize();
+    void updateSampleBudget(const GPUTimer *timer);
+    void addTiles(EnvironmentPrefilterTarget *target, gfx::Texture *source, gfx::Texture *output, uint32_t level, uint32_t size, float roughness, uint32_t samples, bool isRGBE, bool diffuse);
+
+    gfx::Device *                               _device{nullptr};
+    gfx::Shader *                               _shader{nullptr};
+    gfx::DescriptorSetLayout *                  _descriptorSetLayout{nullptr};
+    gfx::PipelineLayout *                       _pipelineLayout{nullptr};
+    gfx::PipelineState *                        _pipelineState{nullptr};
+    gfx::Sampler *                              _sampler{nullptr};
+    gfx::TextureBarrier *                       _beginBarrier{nullptr};
+    gfx::TextureBarrier *                       _endBarrier{nullptr};
+    ccstd::vector<EnvironmentPrefilterTarget *> _queue;
+    gfx::TextureBarrierList                     _beginBarriers;
+    gfx::TextureBarrierList                     _endBarriers;
+    gfx::TextureList                            _textures;
+    uint32_t                                    _sampleBudget{1U << 22U};
+    uint32_t                                    _recordedSamples{0};
+    float                                       _frameBudget{1.F};
+    bool                                        _enabled{true};
+    bool                                        _initialized{false};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,193 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "GPUTimer.h"
+#include <algorithm>
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXQueryPool.h"
+#include "profiler/Profiler.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+constexpr uint32_t INVALID_SCOPE = UINT32_MAX;
+
+// every use of a pool writes its own range of ids, so the results tell which use they come from
+inline uint32_t getQueryId(uint32_t parity, uint32_t scope, bool end) {
+    return parity * GPUTimer::MAX_SCOPES * 2 + scope * 2 + (end ? 1 : 0);
+}
+} // namespace
+
+bool GPUTimer::isSupported(const gfx::Device *device) {
+    return device->getCapabilities().supportTimestampQuery;
+}
+
+void GPUTimer::beginFrame(gfx::Device *device, gfx::CommandBuffer *cmdBuff) {
+    _current = nullptr;
+    _openScopes.clear();
+    if (!_enabled || !isSupported(device)) {
+        return;
+    }
+
+    _device          = device;
+    _cmdBuff         = cmdBuff;
+    _timestampPeriod = device->getCapabilities().timestampPeriod;
+
+    auto &frame = _frames[_frameIndex];
+    _frameIndex = (_frameIndex + 1) % FRAME_LATENCY;
+    if (frame.pool) {
+        resolve(frame);
+    } else {
+        frame.pool = device->createQueryPool({gfx::QueryType::TIMESTAMP, MAX_SCOPES * 2, false});
+    }
+
+    cmdBuff->resetQueryPool(frame.pool);
+    ++frame.uses;
+    frame.scopes[frame.uses & 1U].clear();
+    frame.recordedNS[frame.uses & 1U] = TraceRecorder::now();
+    _current = &frame;
+}
+
+void GPUTimer::endFrame() {
+    while (!_openScopes.empty()) {
+        endScope();
+    }
+    _current = nullptr;
+    _cmdBuff = nullptr;
+}
+
+void GPUTimer::destroy() {
+    for (auto &frame : _frames) {
+        CC_SAFE_DESTROY_AND_DELETE(frame.pool);
+        frame.scopes[0].clear();
+        frame.scopes[1].clear();
+        frame.uses = 0;
+    }
+    _timings.clear();
+    _openScopes.clear();
+    _current    = nullptr;
+    _cmdBuff    = nullptr;
+    _device     = nullptr;
+    _frameIndex = 0;
+    _frameTime  = 0.F;
+}
+
+void GPUTimer::beginScope(const char *name) {
+    if (!_current) {
+        return;
+    }
+
+    const uint32_t parity = _current->uses & 1U;
+    auto &         scopes = _current->scopes[parity];
+    const auto     scope  = static_cast<uint32_t>(scopes.size());
+    if (scope >= MAX_SCOPES) {
+        _openScopes.push_back(INVALID_SCOPE);
+        return;
+    }
+
+    scopes.push_back(name);
+    _cmdBuff->writeTimestamp(_current->pool, getQueryId(parity, scope, false));
+    _openScopes.push_back(scope);
+}
+
+void GPUTimer::endScope() {
+    if (!_current || _openScopes.empty()) {
+        return;
+    }
+
+    const uint32_t scope = _openScopes.back();
+    _openScopes.pop_back();
+    if (scope != INVALID_SCOPE) {
+        _cmdBuff->writeTimestamp(_current->pool, getQueryId(_current->uses & 1U, scope, true));
+    }
+}
+
+void GPUTimer::onPassBegin(const framegraph::StringHandle &name) {
+    beginScope(framegraph::FrameGraph::handleToString(name));
+}
+
+void GPUTimer::onPassEnd() {
+    endScope();
+}
+
+void GPUTimer::resolve(FrameQueries &frame) {
+    _device->getQueryPoolResults(frame.pool);
+
+    // the results are of the last use of the pool, or of the one before when
+    // they are fetched on the device thread after this call returns
+    const uint32_t parity = frame.uses & 1U;
+    if (!resolve(frame, parity)) {
+        resolve(frame, parity ^ 1U);
+    }
+}
+
+bool GPUTimer::resolve(FrameQueries &frame, uint32_t parity) {
+    const auto &scopes = frame.scopes[parity];
+    const auto  count  = static_cast<uint32_t>(scopes.size());
+    if (count == 0) {
+        return false;
+    }
+
+    // only publish frames whose queries are all available
+    auto *pool = frame.pool;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!pool->hasResult(getQueryId(parity, i, false)) || !pool->hasResult(getQueryId(parity, i, true))) {
+            return false;
+        }
+    }
+
+    const float toMilliseconds = _timestampPeriod * 1e-6F;
+    uint64_t    frameBegin     = UINT64_MAX;
+    uint64_t    frameEnd       = 0;
+    _timings.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t begin = pool->getResult(getQueryId(parity, i, false));
+        const uint64_t end   = pool->getResult(getQueryId(parity, i, true));
+        _timings[i].name     = scopes[i];
+        _timings[i].time     = end > begin ? static_cast<float>(end - begin) * toMilliseconds : 0.F;
+        frameBegin           = std::min(frameBegin, begin);
+        frameEnd             = std::max(frameEnd, end);
+    }
+    _frameTime = frameEnd > frameBegin ? static_cast<float>(frameEnd - frameBegin) * toMilliseconds : 0.F;
+
+#if CC_USE_PROFILER
+    auto &trace = CC_PROFILER->getTraceRecorder();
+    if (trace.isCapturing()) {
+        // the GPU clock isn't synchronized with the CPU one, scopes are laid out from the time the frame was recorded
+        const double toNanoseconds = _timestampPeriod;
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint64_t begin = pool->getResult(getQueryId(parity, i, false));
+            const uint64_t end   = pool->getResult(getQueryId(parity, i, true));
+            const auto     start = frame.recordedNS[parity] + static_cast<uint64_t>(static_cast<double>(begin - frameBegin) * toNanoseconds);
+            trace.addGPUEvent(scopes[i], start, end > begin ? static_cast<uint64_t>(static_cast<double>(end - begin) * toNanoseconds) : 0U);
+        }
+    }
+#endif
+    return true;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,113 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+#include "frame-graph/FrameGraph.h"
+
+namespace cc {
+namespace gfx {
+class CommandBuffer;
+class Device;
+class QueryPool;
+} // namespace gfx
+namespace pipeline {
+
+struct GPUTiming {
+    const char *name{nullptr};
+    float       time{0.F}; // milliseconds
+};
+
+/**
+ * @en Measures the GPU time of the frame graph passes and other scopes with timestamp queries. Queries of a frame are read back
+ * FRAME_LATENCY frames later without waiting for the GPU, so the timings lag behind the rendered frames. Only takes effect when
+ * the device supports timestamp queries.
+ * @zh 通过时间戳查询统计帧图通道及其他范围的 GPU 耗时。每帧的查询结果在 FRAME_LATENCY 帧之后读取且不等待 GPU，因此统计结果滞后于当前渲染帧。
+ * 仅在设备支持时间戳查询时生效。
+ */
+class CC_DLL GPUTimer final : public framegraph::PassExecutionListener {
+public:
+    static constexpr uint32_t FRAME_LATENCY{3};
+    static constexpr uint32_t MAX_SCOPES{64};
+
+    GPUTimer()                 = default;
+    ~GPUTimer() override       = default;
+    GPUTimer(const GPUTimer &) = delete;
+    GPUTimer(GPUTimer &&)      = delete;
+    GPUTimer &operator=(const GPUTimer &) = delete;
+    GPUTimer &operator=(GPUTimer &&) = delete;
+
+    static bool isSupported(const gfx::Device *device);
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool enabled) { _enabled = enabled; }
+
+    // called right after the command buffer begins and before it ends, scopes can only be recorded in between
+    void beginFrame(gfx::Device *device, gfx::CommandBuffer *cmdBuff);
+    void endFrame();
+    void destroy();
+
+    // scopes must not be recorded inside a render pass, the name is not copied and must stay valid
+    void beginScope(const char *name);
+    void endScope();
+
+    void onPassBegin(const framegraph::StringHandle &name) override;
+    void onPassEnd() override;
+
+    // timings of the latest frame read back, in the order the scopes began
+    inline const ccstd::vector<GPUTiming> &getTimings() const { return _timings; }
+    // milliseconds from the first scope began to the last scope ended of the latest frame read back
+    inline float getFrameTime() const { return _frameTime; }
+
+private:
+    struct FrameQueries {
+        gfx::QueryPool *pool{nullptr};
+        // names of the scopes written in the last two uses of the pool, indexed by the parity of the use
+        ccstd::array<ccstd::vector<const char *>, 2> scopes;
+        // CPU time each use began recording, to place its scopes in traces
+        ccstd::array<uint64_t, 2> recordedNS{};
+        uint32_t                  uses{0};
+    };
+
+    void resolve(FrameQueries &frame);
+    bool resolve(FrameQueries &frame, uint32_t parity);
+
+    ccstd::array<FrameQueries, FRAME_LATENCY> _frames;
+    ccstd::vector<GPUTiming>                  _timings;
+    ccstd::vector<uint32_t>                   _openScopes;
+    gfx::Device *                             _device{nullptr};
+    gfx::CommandBuffer *                      _cmdBuff{nullptr};
+    FrameQueries *                            _current{nullptr};
+    uint32_t                                  _frameIndex{0};
+    float                                     _timestampPeriod{1.F};
+    float                                     _frameTime{0.F};
+    bool                                      _enabled{false};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -26,12 +26,15 @@
 #include "GeometryRenderer.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include "Define.h"
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
 #include "base/Log.h"
+#include "base/Utils.h"
 #include "base/std/container/array.h"
+#include "base/std/container/unordered_map.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
 #include "math/Mat4.h"
@@ -100,20 +103,42 @@ private:
         CC_PROFILE_MEMORY_INC(GeometryVertexBuffer, static_cast<uint32_t>(_maxVertices * sizeof(T)));
     }
 
-    inline uint32_t getCount() const { return std::min(static_cast<uint32_t>(_vertices.size()), _maxVertices); }
+    inline uint32_t getCount() const { return static_cast<uint32_t>(_vertices.size()); }
     inline bool     empty() const { return _vertices.empty(); }
-    inline void     reset() { _vertices.clear(); }
+
+    // keep the submitted vertices of this frame to detect unchanged geometry in the next one
+    inline void reset() {
+        _vertices.swap(_lastVertices);
+        _vertices.clear();
+    }
 
     inline void update() {
-        if (!empty()) {
-            const auto count = getCount();
-            const auto size  = static_cast<uint32_t>(count * sizeof(T));
-            _buffer->update(&_vertices[0], size);
+        if (empty()) {
+            return;
+        }
+
+        const auto count = getCount();
+        if (count > _maxVertices) {
+            const auto maxVertices = utils::nextPOT(count);
+            CC_PROFILE_MEMORY_DEC(GeometryVertexBuffer, static_cast<uint32_t>(_maxVertices * sizeof(T)));
+            _buffer->resize(static_cast<uint32_t>(maxVertices * sizeof(T)));
+            CC_PROFILE_MEMORY_INC(GeometryVertexBuffer, static_cast<uint32_t>(maxVertices * sizeof(T)));
+            _maxVertices = maxVertices;
+            _lastVertices.clear();
+        }
+
+        // persistent debug geometry is usually submitted unchanged every frame, reuse the uploaded data
+        const auto size = static_cast<uint32_t>(count * sizeof(T));
+        if (_lastVertices.size() == _vertices.size() && memcmp(_lastVertices.data(), _vertices.data(), size) == 0) {
+            return;
         }
+
+        _buffer->update(_vertices.data(), size);
     }
 
     inline void destroy() {
         _vertices.clear();
+        _lastVertices.clear();
         CC_SAFE_DESTROY_AND_DELETE(_buffer);
         CC_SAFE_DESTROY_AND_DELETE(_inputAssembler);
         CC_PROFILE_MEMORY_DEC(GeometryVertexBuffer, static_cast<uint32_t>(_maxVertices * sizeof(T)));
@@ -121,6 +146,7 @@ private:
 
     uint32_t             _maxVertices{0};
     ccstd::vector<T>     _vertices;
+    ccstd::vector<T>     _lastVertices;
     gfx::Buffer *        _buffer{nullptr};
     gfx::InputAssembler *_inputAssembler{nullptr};
 
@@ -131,6 +157,26 @@ struct GeometryVertexBuffers {
     ccstd::array<GeometryVertexBuffer<PosColorVertex>, GEOMETRY_DEPTH_TYPE_COUNT>     lines;
     ccstd::array<GeometryVertexBuffer<PosColorVertex>, GEOMETRY_DEPTH_TYPE_COUNT>     dashedLines;
     ccstd::array<GeometryVertexBuffer<PosNormColorVertex>, GEOMETRY_DEPTH_TYPE_COUNT> triangles;
+
+    // (cos, sin) of i * 2PI / segments for i in [0, segments], shared by all primitives of the same tessellation
+    ccstd::unordered_map<uint32_t, ccstd::vector<Vec2>> unitCircles;
+
+    const ccstd::vector<Vec2> &getUnitCircle(uint32_t segments) {
+        auto iter = unitCircles.find(segments);
+        if (iter != unitCircles.end()) {
+            return iter->second;
+        }
+
+        auto &circle = unitCircles[segments];
+        circle.resize(segments + 1);
+        const auto delta = math::PI_2 / static_cast<float>(segments);
+        for (auto i = 0U; i < segments; i++) {
+            const float angle = static_cast<float>(i) * delta;
+            circle[i].set(cosf(angle), sinf(angle));
+        }
+        circle[segments] = circle[0];
+        return circle;
+    }
 };
 
 GeometryRendererInfo::GeometryRendererInfo()
@@ -273,22 +319,12 @@ void GeometryRenderer::reset() {
 
 void GeometryRenderer::addDashedLine(const Vec3 &v0, const Vec3 &v1, gfx::Color color, bool depthTest) {
     auto &dashedLines = _buffers->dashedLines[depthTest ? 1 : 0];
-    if (dashedLines._vertices.size() + GEOMETRY_VERTICES_PER_LINE > dashedLines._maxVertices) {
-        CC_LOG_WARNING("GeometryRenderer: too many lines.");
-        return;
-    }
-
     dashedLines._vertices.emplace_back(v0, color);
     dashedLines._vertices.emplace_back(v1, color);
 }
 
 void GeometryRenderer::addLine(const Vec3 &v0, const Vec3 &v1, gfx::Color color, bool depthTest) {
     auto &lines = _buffers->lines[depthTest ? 1 : 0];
-    if (lines._vertices.size() + GEOMETRY_VERTICES_PER_LINE > lines._maxVertices) {
-        CC_LOG_WARNING("GeometryRenderer: too many lines.");
-        return;
-    }
-
     lines._vertices.emplace_back(v0, color);
     lines._vertices.emplace_back(v1, color);
 }
@@ -302,11 +338,6 @@ void GeometryRenderer::addTriangle(const Vec3 &v0, const Vec3 &v1, const Vec3 &v
     }
 
     auto &triangles = _buffers->triangles[depthTest ? 1 : 0];
-    if (triangles._vertices.size() + GEOMETRY_VERTICES_PER_TRIANGLE > triangles._maxVertices) {
-        CC_LOG_WARNING("GeometryRenderer: too many triangles.");
-        return;
-    }
-
     Vec4 normal{0.0F, 0.0F, 0.0F, 0.0F};
     if (!unlit) {
         const Vec3 dist1 = v1 - v0;
@@ -425,10 +456,11 @@ void GeometryRenderer::addFrustum(const geometry::Frustum &frustum, gfx::Color c
 }
 
 void GeometryRenderer::addCapsule(const Vec3 &center, float radius, float height, gfx::Color color, uint32_t segmentsU, uint32_t hemiSegmentsV, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto deltaPhi   = math::PI_2 / static_cast<float>(segmentsU);
-    const auto deltaTheta = math::PI_DIV2 / static_cast<float>(hemiSegmentsV);
-    Vec3       bottomCenter{center.x, center.y - height / 2.0F, center.z};
-    Vec3       topCenter{center.x, center.y + height / 2.0F, center.z};
+    // a quarter of the circle with 4 * hemiSegmentsV segments covers the hemisphere
+    const auto &circleU = _buffers->getUnitCircle(segmentsU);
+    const auto &circleV = _buffers->getUnitCircle(hemiSegmentsV * 4);
+    Vec3        bottomCenter{center.x, center.y - height / 2.0F, center.z};
+    Vec3        topCenter{center.x, center.y + height / 2.0F, center.z};
 
     using CircleList = ccstd::vector<Vec3>;
     ccstd::vector<CircleList> bottomPoints;
@@ -438,14 +470,12 @@ void GeometryRenderer::addCapsule(const Vec3 &center, float radius, float height
         CircleList bottomList;
         CircleList topList;
 
-        float theta    = static_cast<float>(i) * deltaTheta;
-        float sinTheta = sinf(theta);
-        float cosTheta = cosf(theta);
+        float sinTheta = circleV[i].y;
+        float cosTheta = circleV[i].x;
 
         for (auto j = 0U; j < segmentsU + 1; j++) {
-            float phi    = static_cast<float>(j) * deltaPhi;
-            float sinPhi = sinf(phi);
-            float cosPhi = cosf(phi);
+            float sinPhi = circleU[j].y;
+            float cosPhi = circleU[j].x;
             Vec3  p{radius * sinTheta * cosPhi, radius * cosTheta, radius * sinTheta * sinPhi};
 
             bottomList.emplace_back(bottomCenter + Vec3(p.x, -p.y, p.z));
@@ -484,15 +514,14 @@ void GeometryRenderer::addCapsule(const Vec3 &center, float radius, float height
 }
 
 void GeometryRenderer::addCylinder(const Vec3 &center, float radius, float height, gfx::Color color, uint32_t segments, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto          deltaPhi = math::PI_2 / static_cast<float>(segments);
+    const auto &        circle = _buffers->getUnitCircle(segments);
     Vec3                bottomCenter{center.x, center.y - height / 2.0F, center.z};
     Vec3                topCenter{center.x, center.y + height / 2.0F, center.z};
     ccstd::vector<Vec3> bottomPoints;
     ccstd::vector<Vec3> topPoints;
 
     for (auto i = 0U; i < segments + 1; i++) {
-        float phi = static_cast<float>(i) * deltaPhi;
-        Vec3  p{radius * cosf(phi), 0.0F, radius * sinf(phi)};
+        Vec3 p{radius * circle[i].x, 0.0F, radius * circle[i].y};
         bottomPoints.emplace_back(p + bottomCenter);
         topPoints.emplace_back(p + topCenter);
     }
@@ -517,13 +546,13 @@ void GeometryRenderer::addCylinder(const Vec3 &center, float radius, float heigh
 }
 
 void GeometryRenderer::addCone(const Vec3 &center, float radius, float height, gfx::Color color, uint32_t segments, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto          deltaPhi = math::PI_2 / static_cast<float>(segments);
+    const auto &        circle = _buffers->getUnitCircle(segments);
     Vec3                bottomCenter{center.x, center.y - height / 2.0F, center.z};
     Vec3                topCenter{center.x, center.y + height / 2.0F, center.z};
     ccstd::vector<Vec3> bottomPoints;
 
     for (auto i = 0U; i < segments + 1; i++) {
-        Vec3 point{radius * cosf(static_cast<float>(i) * deltaPhi), 0.0F, radius * sinf(static_cast<float>(i) * deltaPhi)};
+        Vec3 point{radius * circle[i].x, 0.0F, radius * circle[i].y};
         bottomPoints.emplace_back(point + bottomCenter);
     }
 
@@ -543,11 +572,11 @@ void GeometryRenderer::addCone(const Vec3 &center, float radius, float height, g
 }
 
 void GeometryRenderer::addCircle(const Vec3 &center, float radius, gfx::Color color, uint32_t segments, bool depthTest, bool useTransform, const Mat4 &transform) {
-    const auto          deltaPhi = math::PI_2 / static_cast<float>(segments);
+    const auto &        circle = _buffers->getUnitCircle(segments);
     ccstd::vector<Vec3> points;
 
     for (auto i = 0U; i < segments + 1; i++) {
-        Vec3 point{radius * cosf(static_cast<float>(i) * deltaPhi), 0.0F, radius * sinf(static_cast<float>(i) * deltaPhi)};
+        Vec3 point{radius * circle[i].x, 0.0F, radius * circle[i].y};
         points.emplace_back(point + center);
     }
 
@@ -593,12 +622,12 @@ void GeometryRenderer::addPolygon(const Vec3 &center, float radius, gfx::Color c
 }
 
 void GeometryRenderer::addDisc(const Vec3 &center, float radius, gfx::Color color, uint32_t segments, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto          deltaPhi = math::PI_2 / static_cast<float>(segments);
+    const auto &        circle = _buffers->getUnitCircle(segments);
     ccstd::vector<Vec3> points;
     Vec3                newCenter = center;
 
     for (auto i = 0U; i < segments + 1; i++) {
-        Vec3 point{radius * cosf(static_cast<float>(i) * deltaPhi), 0.0F, radius * sinf(static_cast<float>(i) * deltaPhi)};
+        Vec3 point{radius * circle[i].x, 0.0F, radius * circle[i].y};
         points.emplace_back(point + newCenter);
     }
 
@@ -655,22 +684,21 @@ void GeometryRenderer::addSector(const Vec3 &center, float radius, gfx::Color co
 }
 
 void GeometryRenderer::addSphere(const Vec3 &center, float radius, gfx::Color color, uint32_t segmentsU, uint32_t segmentsV, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto deltaPhi   = math::PI_2 / static_cast<float>(segmentsU);
-    const auto deltaTheta = math::PI / static_cast<float>(segmentsV);
+    // half of the circle with 2 * segmentsV segments covers the meridian
+    const auto &circleU = _buffers->getUnitCircle(segmentsU);
+    const auto &circleV = _buffers->getUnitCircle(segmentsV * 2);
 
     using CircleList = ccstd::vector<Vec3>;
     ccstd::vector<CircleList> points;
 
     for (auto i = 0U; i < segmentsV + 1; i++) {
         CircleList list;
-        float      theta    = static_cast<float>(i) * deltaTheta;
-        float      sinTheta = sinf(theta);
-        float      cosTheta = cosf(theta);
+        float      sinTheta = circleV[i].y;
+        float      cosTheta = circleV[i].x;
 
         for (auto j = 0U; j < segmentsU + 1; j++) {
-            float phi    = static_cast<float>(j) * deltaPhi;
-            float sinPhi = sinf(phi);
-            float cosPhi = cosf(phi);
+            float sinPhi = circleU[j].y;
+            float cosPhi = circleU[j].x;
             Vec3  p{radius * sinTheta * cosPhi, radius * cosTheta, radius * sinTheta * sinPhi};
 
             list.emplace_back(center + p);
@@ -696,22 +724,20 @@ void GeometryRenderer::addSphere(const Vec3 &center, float radius, gfx::Color co
 }
 
 void GeometryRenderer::addTorus(const Vec3 &center, float bigRadius, float radius, gfx::Color color, uint32_t segmentsU, uint32_t segmentsV, bool wireframe, bool depthTest, bool unlit, bool useTransform, const Mat4 &transform) {
-    const auto deltaPhi   = math::PI_2 / static_cast<float>(segmentsU);
-    const auto deltaTheta = math::PI_2 / static_cast<float>(segmentsV);
+    const auto &circleU = _buffers->getUnitCircle(segmentsU);
+    const auto &circleV = _buffers->getUnitCircle(segmentsV);
 
     using CircleList = ccstd::vector<Vec3>;
     ccstd::vector<CircleList> points;
 
     for (auto i = 0U; i < segmentsU + 1; i++) {
         CircleList list;
-        float      phi    = static_cast<float>(i) * deltaPhi;
-        float      sinPhi = sinf(phi);
-        float      cosPhi = cosf(phi);
+        float      sinPhi = circleU[i].y;
+        float      cosPhi = circleU[i].x;
 
         for (auto j = 0U; j < segmentsV + 1; j++) {
-            float theta    = static_cast<float>(j) * deltaTheta;
-            float sinTheta = sinf(theta);
-            float cosTheta = cosf(theta);
+            float sinTheta = circleV[j].y;
+            float cosTheta = circleV[j].x;
             Vec3  p{(bigRadius + radius * cosTheta) * cosPhi, radius * sinTheta, (bigRadius + radius * cosTheta) * sinPhi};
 
             list.emplace_back(center + p);
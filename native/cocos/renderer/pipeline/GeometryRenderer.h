@@ -54,6 +54,7 @@ namespace pipeline {
 class PipelineSceneData;
 struct GeometryVertexBuffers;
 
+// Initial capacities, the vertex buffers grow on demand when more primitives are added in a frame.
 struct GeometryRendererInfo {
     GeometryRendererInfo();
 
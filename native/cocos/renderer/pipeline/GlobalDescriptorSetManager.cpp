@@ -25,8 +25,10 @@
 
 #include "GlobalDescriptorSetManager.h"
 
+#include "BindlessTextureTable.h"
 #include "Define.h"
 #include "RenderInstancedQueue.h"
+#include "gfx-base/GFXDescriptorSetCache.h"
 #include "gfx-base/GFXDevice.h"
 
 namespace cc {
@@ -60,6 +62,15 @@ void GlobalDSManager::activate(gfx::Device *device) {
     });
 
     setDescriptorSetLayout();
+    if (BindlessTextureTable::isSupported(device)) {
+        globalDescriptorSetLayout.samplers[BINDLESSTEXTURES::NAME] = BINDLESSTEXTURES::LAYOUT;
+        globalDescriptorSetLayout.bindings.push_back(BINDLESSTEXTURES::DESCRIPTOR);
+        if (!_bindlessTextureTable) {
+            _bindlessTextureTable = CC_NEW(BindlessTextureTable(this));
+        }
+    } else {
+        globalDescriptorSetLayout.samplers.erase(BINDLESSTEXTURES::NAME);
+    }
     CC_SAFE_DESTROY_NULL(_descriptorSetLayout);
     _descriptorSetLayout = device->createDescriptorSetLayout({globalDescriptorSetLayout.bindings});
 
@@ -68,6 +79,13 @@ void GlobalDSManager::activate(gfx::Device *device) {
         CC_DELETE(_globalDescriptorSet);
     }
     _globalDescriptorSet = device->createDescriptorSet({_descriptorSetLayout});
+    if (_bindlessTextureTable) {
+        _bindlessTextureTable->bindTo(_globalDescriptorSet);
+    }
+
+    if (!_descriptorSetCache) {
+        _descriptorSetCache = CC_NEW(gfx::DescriptorSetCache(device));
+    }
 }
 
 void GlobalDSManager::bindBuffer(uint32_t binding, gfx::Buffer *buffer) {
@@ -80,23 +98,23 @@ void GlobalDSManager::bindBuffer(uint32_t binding, gfx::Buffer *buffer) {
     }
 }
 
-void GlobalDSManager::bindSampler(uint32_t binding, gfx::Sampler *sampler) {
+void GlobalDSManager::bindSampler(uint32_t binding, gfx::Sampler *sampler, uint32_t index) {
     if (_globalDescriptorSet) {
-        _globalDescriptorSet->bindSampler(binding, sampler);
+        _globalDescriptorSet->bindSampler(binding, sampler, index);
     }
 
     for (auto &pair : _descriptorSetMap) {
-        if (pair.second) pair.second->bindSampler(binding, sampler);
+        if (pair.second) pair.second->bindSampler(binding, sampler, index);
     }
 }
 
-void GlobalDSManager::bindTexture(uint32_t binding, gfx::Texture *texture) {
+void GlobalDSManager::bindTexture(uint32_t binding, gfx::Texture *texture, uint32_t index) {
     if (_globalDescriptorSet) {
-        _globalDescriptorSet->bindTexture(binding, texture);
+        _globalDescriptorSet->bindTexture(binding, texture, index);
     }
 
     for (auto &pair : _descriptorSetMap) {
-        if (pair.second) pair.second->bindTexture(binding, texture);
+        if (pair.second) pair.second->bindTexture(binding, texture, index);
     }
 }
 
@@ -126,6 +144,9 @@ gfx::DescriptorSet *GlobalDSManager::getOrCreateDescriptorSet(uint32_t idx) {
             auto *const texture = _globalDescriptorSet->getTexture(i);
             if (texture) descriptorSet->bindTexture(i, texture);
         }
+        if (_bindlessTextureTable) {
+            _bindlessTextureTable->bindTo(descriptorSet);
+        }
 
         auto *shadowUBO = _device->createBuffer({
             gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
@@ -151,9 +172,12 @@ void GlobalDSManager::destroy() {
         CC_SAFE_DELETE(pair.second);
     }
     _descriptorSetMap.clear();
+    CC_SAFE_DELETE(_descriptorSetCache);
 
     CC_SAFE_DESTROY_NULL(_descriptorSetLayout);
     CC_SAFE_DELETE(_globalDescriptorSet);
+    // the textures are released after the sets referring to them
+    CC_SAFE_DELETE(_bindlessTextureTable);
 }
 
 void GlobalDSManager::setDescriptorSetLayout() {
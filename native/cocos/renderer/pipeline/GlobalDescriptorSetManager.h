@@ -38,8 +38,10 @@ class Sampler;
 class Buffer;
 class Texture;
 class Device;
+class DescriptorSetCache;
 } // namespace gfx
 namespace pipeline {
+class BindlessTextureTable;
 
 class GlobalDSManager final {
 public:
@@ -51,11 +53,15 @@ public:
     inline gfx::Sampler *                                       getPointSampler() const { return _pointSampler; }
     inline gfx::DescriptorSetLayout *                           getDescriptorSetLayout() const { return _descriptorSetLayout; }
     inline gfx::DescriptorSet *                                 getGlobalDescriptorSet() const { return _globalDescriptorSet; }
+    // shared by the local descriptor sets of submodels with identical bindings, disabled by default
+    inline gfx::DescriptorSetCache *getDescriptorSetCache() const { return _descriptorSetCache; }
+    // null if the device doesn't support bindless textures
+    inline BindlessTextureTable *getBindlessTextureTable() const { return _bindlessTextureTable; }
 
     void                activate(gfx::Device *device);
     void                bindBuffer(uint32_t binding, gfx::Buffer *buffer);
-    void                bindTexture(uint32_t binding, gfx::Texture *texture);
-    void                bindSampler(uint32_t binding, gfx::Sampler *sampler);
+    void                bindTexture(uint32_t binding, gfx::Texture *texture, uint32_t index = 0);
+    void                bindSampler(uint32_t binding, gfx::Sampler *sampler, uint32_t index = 0);
     void                update();
     gfx::DescriptorSet *getOrCreateDescriptorSet(uint32_t idx);
     void                destroy();
@@ -70,6 +76,8 @@ private:
     gfx::DescriptorSet *                                 _globalDescriptorSet = nullptr;
     ccstd::unordered_map<uint32_t, gfx::DescriptorSet *> _descriptorSetMap{};
     ccstd::vector<gfx::Buffer *>                         _shadowUBOs;
+    gfx::DescriptorSetCache *                            _descriptorSetCache{nullptr};
+    BindlessTextureTable *                               _bindlessTextureTable{nullptr};
 };
 
 } // namespace pipeline
@@ -0,0 +1,274 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "HiZCulling.h"
+#include <algorithm>
+#include <cmath>
+#include "core/geometry/AABB.h"
+#include "profiler/Profiler.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+// clear depth is the far plane for both [-1, 1] and [0, 1] clip space depth range
+constexpr float    FAR_DEPTH{1.0F};
+// vertices closer than this are treated as crossing the near plane
+constexpr float    MIN_CLIP_W{1e-4F};
+// occludee rectangles are tested on the level where they span at most this many texels
+constexpr uint32_t MAX_TEST_TEXELS{4};
+
+// box corners are indexed as (x, y, z) bits, 1 for the max side
+constexpr uint32_t BOX_INDICES[36] = {
+    0, 2, 3, 0, 3, 1, // -z
+    4, 5, 7, 4, 7, 6, // +z
+    0, 4, 6, 0, 6, 2, // -x
+    1, 3, 7, 1, 7, 5, // +x
+    0, 1, 5, 0, 5, 4, // -y
+    2, 6, 7, 2, 7, 3, // +y
+};
+
+void getBoxCorners(const Vec3 &center, const Vec3 &halfExtents, Vec3 *corners) {
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i].set(center.x + ((i & 1) ? halfExtents.x : -halfExtents.x),
+                       center.y + ((i & 2) ? halfExtents.y : -halfExtents.y),
+                       center.z + ((i & 4) ? halfExtents.z : -halfExtents.z));
+    }
+}
+
+inline float edgeFunction(float ax, float ay, float bx, float by, float px, float py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+} // namespace
+
+HiZCulling::HiZCulling() {
+    setResolution(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+}
+
+void HiZCulling::setResolution(uint32_t width, uint32_t height) {
+    _width  = std::max(width, 1U);
+    _height = std::max(height, 1U);
+
+    _levels.clear();
+    uint32_t w = _width;
+    uint32_t h = _height;
+    while (true) {
+        _levels.emplace_back(static_cast<size_t>(w) * h, FAR_DEPTH);
+        if (w == 1 && h == 1) {
+            break;
+        }
+        w = std::max(w / 2, 1U);
+        h = std::max(h / 2, 1U);
+    }
+}
+
+void HiZCulling::cull(const scene::Camera *camera, RenderObjectList &objects) {
+    CC_PROFILE(HiZCulling);
+    _matViewProj   = camera->getMatViewProj();
+    _culledCount   = 0;
+    _visibleCount  = static_cast<uint32_t>(objects.size());
+    _occluderCount = 0;
+
+    std::fill(_levels[0].begin(), _levels[0].end(), FAR_DEPTH);
+    for (const auto &ro : objects) {
+        if (ro.model->isOccluder()) {
+            rasterizeOccluder(ro.model);
+            ++_occluderCount;
+        }
+    }
+
+    if (_occluderCount > 0) {
+        buildPyramid();
+        auto iter = std::remove_if(objects.begin(), objects.end(), [this](const RenderObject &ro) {
+            const auto *worldBounds = ro.model->getWorldBounds();
+            return worldBounds && isOccluded(*worldBounds);
+        });
+        _culledCount = static_cast<uint32_t>(objects.end() - iter);
+        objects.erase(iter, objects.end());
+        _visibleCount = static_cast<uint32_t>(objects.size());
+    }
+
+    CC_PROFILE_RENDER_UPDATE(OcclusionCulled, _culledCount);
+    CC_PROFILE_RENDER_UPDATE(OcclusionVisible, _visibleCount);
+}
+
+void HiZCulling::rasterizeOccluder(const scene::Model *model) {
+    const auto *modelBounds = model->getModelBounds();
+    if (!modelBounds || !modelBounds->isValid() || !model->getTransform()) {
+        return;
+    }
+
+    Vec3 corners[8];
+    getBoxCorners(modelBounds->getCenter(), modelBounds->getHalfExtents(), corners);
+
+    const Mat4 matMVP = _matViewProj * model->getTransform()->getWorldMatrix();
+    Vec4       clip[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        clip[i].set(corners[i].x, corners[i].y, corners[i].z, 1.0F);
+        matMVP.transformVector(&clip[i]);
+    }
+
+    for (uint32_t i = 0; i < 36; i += 3) {
+        rasterizeTriangle(clip[BOX_INDICES[i]], clip[BOX_INDICES[i + 1]], clip[BOX_INDICES[i + 2]]);
+    }
+}
+
+void HiZCulling::rasterizeTriangle(const Vec4 &v0, const Vec4 &v1, const Vec4 &v2) {
+    // skipping triangles crossing the near plane only loses occlusion, never visibility
+    if (v0.w < MIN_CLIP_W || v1.w < MIN_CLIP_W || v2.w < MIN_CLIP_W) {
+        return;
+    }
+
+    const auto  width  = static_cast<float>(_width);
+    const auto  height = static_cast<float>(_height);
+    const float x0     = (v0.x / v0.w * 0.5F + 0.5F) * width;
+    const float y0     = (v0.y / v0.w * 0.5F + 0.5F) * height;
+    const float z0     = v0.z / v0.w;
+    const float x1     = (v1.x / v1.w * 0.5F + 0.5F) * width;
+    const float y1     = (v1.y / v1.w * 0.5F + 0.5F) * height;
+    const float z1     = v1.z / v1.w;
+    const float x2     = (v2.x / v2.w * 0.5F + 0.5F) * width;
+    const float y2     = (v2.y / v2.w * 0.5F + 0.5F) * height;
+    const float z2     = v2.z / v2.w;
+
+    const float area = edgeFunction(x0, y0, x1, y1, x2, y2);
+    if (std::abs(area) < 1e-8F) {
+        return;
+    }
+    const float invArea = 1.0F / area;
+
+    const auto minX = static_cast<int32_t>(std::max(std::floor(std::min({x0, x1, x2})), 0.0F));
+    const auto minY = static_cast<int32_t>(std::max(std::floor(std::min({y0, y1, y2})), 0.0F));
+    const auto maxX = static_cast<int32_t>(std::min(std::ceil(std::max({x0, x1, x2})), width - 1.0F));
+    const auto maxY = static_cast<int32_t>(std::min(std::ceil(std::max({y0, y1, y2})), height - 1.0F));
+
+    auto &depth = _levels[0];
+    for (int32_t y = minY; y <= maxY; ++y) {
+        const float py = static_cast<float>(y) + 0.5F;
+        for (int32_t x = minX; x <= maxX; ++x) {
+            const float px = static_cast<float>(x) + 0.5F;
+            // normalized barycentric weights are all positive inside for either winding
+            const float w0 = edgeFunction(x1, y1, x2, y2, px, py) * invArea;
+            const float w1 = edgeFunction(x2, y2, x0, y0, px, py) * invArea;
+            const float w2 = edgeFunction(x0, y0, x1, y1, px, py) * invArea;
+            if (w0 < 0.0F || w1 < 0.0F || w2 < 0.0F) {
+                continue;
+            }
+
+            const float z   = w0 * z0 + w1 * z1 + w2 * z2;
+            float &     dst = depth[static_cast<size_t>(y) * _width + x];
+            dst             = std::min(dst, z);
+        }
+    }
+}
+
+void HiZCulling::buildPyramid() {
+    uint32_t srcWidth  = _width;
+    uint32_t srcHeight = _height;
+    for (size_t level = 1; level < _levels.size(); ++level) {
+        const auto &   src       = _levels[level - 1];
+        auto &         dst       = _levels[level];
+        const uint32_t dstWidth  = std::max(srcWidth / 2, 1U);
+        const uint32_t dstHeight = std::max(srcHeight / 2, 1U);
+        for (uint32_t y = 0; y < dstHeight; ++y) {
+            // odd sizes fold the last row and column into the last texel
+            const uint32_t sy0 = std::min(y * 2, srcHeight - 1);
+            const uint32_t sy1 = (y == dstHeight - 1) ? srcHeight - 1 : std::min(y * 2 + 1, srcHeight - 1);
+            for (uint32_t x = 0; x < dstWidth; ++x) {
+                const uint32_t sx0      = std::min(x * 2, srcWidth - 1);
+                const uint32_t sx1      = (x == dstWidth - 1) ? srcWidth - 1 : std::min(x * 2 + 1, srcWidth - 1);
+                float          maxDepth = 0.0F;
+                for (uint32_t sy = sy0; sy <= sy1; ++sy) {
+                    for (uint32_t sx = sx0; sx <= sx1; ++sx) {
+                        maxDepth = std::max(maxDepth, src[sy * srcWidth + sx]);
+                    }
+                }
+                dst[y * dstWidth + x] = maxDepth;
+            }
+        }
+        srcWidth  = dstWidth;
+        srcHeight = dstHeight;
+    }
+}
+
+bool HiZCulling::isOccluded(const geometry::AABB &worldBounds) const {
+    Vec3 corners[8];
+    getBoxCorners(worldBounds.getCenter(), worldBounds.getHalfExtents(), corners);
+
+    float minX     = static_cast<float>(_width);
+    float minY     = static_cast<float>(_height);
+    float maxX     = 0.0F;
+    float maxY     = 0.0F;
+    float minDepth = FAR_DEPTH;
+    for (const auto &corner : corners) {
+        Vec4 clip{corner.x, corner.y, corner.z, 1.0F};
+        _matViewProj.transformVector(&clip);
+        if (clip.w < MIN_CLIP_W) {
+            return false; // crossing the near plane
+        }
+        const float x = (clip.x / clip.w * 0.5F + 0.5F) * static_cast<float>(_width);
+        const float y = (clip.y / clip.w * 0.5F + 0.5F) * static_cast<float>(_height);
+        minX          = std::min(minX, x);
+        minY          = std::min(minY, y);
+        maxX          = std::max(maxX, x);
+        maxY          = std::max(maxY, y);
+        minDepth      = std::min(minDepth, clip.z / clip.w);
+    }
+
+    const auto x0 = static_cast<int32_t>(std::max(std::floor(minX), 0.0F));
+    const auto y0 = static_cast<int32_t>(std::max(std::floor(minY), 0.0F));
+    const auto x1 = static_cast<int32_t>(std::min(std::ceil(maxX), static_cast<float>(_width) - 1.0F));
+    const auto y1 = static_cast<int32_t>(std::min(std::ceil(maxY), static_cast<float>(_height) - 1.0F));
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    // pick the level where the rectangle spans only a few texels
+    uint32_t level = 0;
+    auto     span  = static_cast<uint32_t>(std::max(x1 - x0, y1 - y0) + 1);
+    while (span > MAX_TEST_TEXELS && level + 1 < _levels.size()) {
+        span = (span + 1) / 2;
+        ++level;
+    }
+
+    const uint32_t levelWidth  = std::max(_width >> level, 1U);
+    const uint32_t levelHeight = std::max(_height >> level, 1U);
+    const auto &   depth       = _levels[level];
+    const uint32_t lx1         = std::min(static_cast<uint32_t>(x1) >> level, levelWidth - 1);
+    const uint32_t ly1         = std::min(static_cast<uint32_t>(y1) >> level, levelHeight - 1);
+    for (uint32_t y = std::min(static_cast<uint32_t>(y0) >> level, levelHeight - 1); y <= ly1; ++y) {
+        for (uint32_t x = std::min(static_cast<uint32_t>(x0) >> level, levelWidth - 1); x <= lx1; ++x) {
+            if (depth[y * levelWidth + x] >= minDepth) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,91 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Vec4.h"
+#include "pipeline/Define.h"
+
+namespace cc {
+namespace geometry {
+class AABB;
+} // namespace geometry
+namespace scene {
+class Camera;
+class Model;
+} // namespace scene
+namespace pipeline {
+
+/**
+ * @en CPU hierarchical-Z occlusion culling. Models marked as occluders are rasterized as their
+ * oriented model bounds into a small depth buffer, merged into a max-depth pyramid, and render
+ * objects whose world bounds lie completely behind it are rejected. Only boxes which are solid,
+ * like buildings and walls, should be marked as occluders.
+ * @zh CPU 层级深度遮挡剔除。标记为遮挡体的模型以其朝向包围盒光栅化到低分辨率深度缓冲中，
+ * 生成最大深度金字塔，并剔除世界包围盒完全位于其后的渲染对象。只应将实心的盒状物体，如建筑和墙体，标记为遮挡体。
+ */
+class CC_DLL HiZCulling final {
+public:
+    static constexpr uint32_t DEFAULT_WIDTH{256};
+    static constexpr uint32_t DEFAULT_HEIGHT{128};
+
+    HiZCulling();
+    ~HiZCulling() = default;
+
+    void                   setResolution(uint32_t width, uint32_t height);
+    inline uint32_t        getWidth() const { return _width; }
+    inline uint32_t        getHeight() const { return _height; }
+    inline uint32_t        getCulledCount() const { return _culledCount; }
+    inline uint32_t        getVisibleCount() const { return _visibleCount; }
+    inline uint32_t        getOccluderCount() const { return _occluderCount; }
+
+    // rasterize the occluders among the frustum culled objects and remove the occluded ones
+    void cull(const scene::Camera *camera, RenderObjectList &objects);
+
+    // valid after the occluders are rasterized
+    bool isOccluded(const geometry::AABB &worldBounds) const;
+
+private:
+    void rasterizeOccluder(const scene::Model *model);
+    void rasterizeTriangle(const Vec4 &v0, const Vec4 &v1, const Vec4 &v2);
+    void buildPyramid();
+
+    uint32_t                           _width{DEFAULT_WIDTH};
+    uint32_t                           _height{DEFAULT_HEIGHT};
+    Mat4                               _matViewProj;
+    // level 0 holds the nearest occluder depth per pixel, each following level the farthest of 2x2 texels
+    ccstd::vector<ccstd::vector<float>> _levels;
+    uint32_t                           _culledCount{0};
+    uint32_t                           _visibleCount{0};
+    uint32_t                           _occluderCount{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(HiZCulling);
+};
+
+} // namespace pipeline
+} // namespace cc
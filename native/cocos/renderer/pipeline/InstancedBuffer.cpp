@@ -24,20 +24,126 @@
 ****************************************************************************/
 
 #include "InstancedBuffer.h"
+#include <boost/functional/hash.hpp>
+#include <cfloat>
+#include "BindlessTextureTable.h"
 #include "Define.h"
+#include "GlobalDescriptorSetManager.h"
+#include "InstancedGPUCulling.h"
+#include "RenderPipeline.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
 #include "gfx-base/GFXDevice.h"
 #include "gfx-base/GFXInputAssembler.h"
 
 namespace cc {
 namespace pipeline {
+namespace {
+uint32_t addSlot(InstancedGPUItem *item, const scene::SubModel *subModel) {
+    const auto slot       = static_cast<uint32_t>(item->subModels.size());
+    item->slots[subModel] = slot;
+    item->subModels.emplace_back(subModel);
+    item->stamps.emplace_back(0);
+    if (item->data.size() < (slot + 1) * item->stride) {
+        item->data.resize((slot + 1) * item->stride);
+        item->bounds.resize(2 * (slot + 1));
+    }
+    return slot;
+}
+
+// moves the last slot into the removed one
+void removeSlot(InstancedGPUItem *item, uint32_t slot) {
+    const auto last = static_cast<uint32_t>(item->subModels.size()) - 1;
+    item->slots.erase(item->subModels[slot]);
+    if (slot != last) {
+        memcpy(item->data.data() + slot * item->stride, item->data.data() + last * item->stride, item->stride);
+        item->subModels[slot]              = item->subModels[last];
+        item->stamps[slot]                 = item->stamps[last];
+        item->bounds[2 * slot]             = item->bounds[2 * last];
+        item->bounds[2 * slot + 1]         = item->bounds[2 * last + 1];
+        item->slots[item->subModels[slot]] = slot;
+        item->dirtyEnd                     = std::max(item->dirtyEnd, slot + 1);
+    }
+    item->subModels.pop_back();
+    item->stamps.pop_back();
+}
+
+void evictStaleSlots(InstancedGPUItem *item, uint32_t stamp) {
+    for (auto slot = static_cast<uint32_t>(item->subModels.size()); slot-- > 0;) {
+        if (item->stamps[slot] != stamp) {
+            removeSlot(item, slot);
+        }
+    }
+}
+
+const char *const  BINDLESS_DEFINE       = "CC_USE_BINDLESS_TEXTURES";
+const char *const  BINDLESS_INDICES_ATTR = "a_bindlessTextureIndices";
+constexpr uint32_t MAX_BINDLESS_INDICES  = 4; // the first sampler textures of the material set in binding order
+// uniforms of the passes may change, buffers of the previous values are destroyed once not merged into for this many frames
+constexpr uint32_t BINDLESS_BUFFER_IDLE_FRAMES = 120;
+
+BindlessTextureTable *getBindlessTextureTable() {
+    auto *pipeline = RenderPipeline::getInstance();
+    return pipeline ? pipeline->getGlobalDSManager()->getBindlessTextureTable() : nullptr;
+}
+
+bool isBindless(const scene::Pass *pass) {
+    const auto &defines = pass->getDefines();
+    auto        iter    = defines.find(BINDLESS_DEFINE);
+    if (iter == defines.end()) return false;
+    if (const auto *value = cc::get_if<bool>(&iter->second)) return *value;
+    if (const auto *value = cc::get_if<int32_t>(&iter->second)) return *value != 0;
+    return false;
+}
+
+// passes with equal hashes only differ in the textures of their material sets
+size_t getBindlessHash(scene::Pass *pass, uint extraKey) {
+    size_t seed = 0;
+    boost::hash_combine(seed, pass->getHash());
+    boost::hash_combine(seed, pass->getPhase());
+    boost::hash_combine(seed, extraKey);
+    if (auto *rootBlock = pass->getRootBlock()) {
+        boost::hash_range(seed, rootBlock->getData(), rootBlock->getData() + rootBlock->byteLength());
+    }
+    return seed;
+}
+} // namespace
+
 ccstd::unordered_map<scene::Pass *, ccstd::unordered_map<uint, InstancedBuffer *>> InstancedBuffer::buffers;
+ccstd::unordered_map<size_t, InstancedBuffer *>                                    InstancedBuffer::bindlessBuffers;
+InstancedGPUCulling *                                                              InstancedBuffer::gpuCulling        = nullptr;
+bool                                                                               InstancedBuffer::gpuCullingEnabled = false;
 InstancedBuffer *                                                                  InstancedBuffer::get(scene::Pass *pass) {
     return InstancedBuffer::get(pass, 0);
 }
 InstancedBuffer *InstancedBuffer::get(scene::Pass *pass, uint extraKey) {
+    // pass instances which have not overridden anything are drawn together with their parent
+    pass = pass->getBatchingPass();
+    auto *bindlessTextureTable = isBindless(pass) ? getBindlessTextureTable() : nullptr;
+    if (bindlessTextureTable) {
+        const uint32_t frame = bindlessTextureTable->getFrame();
+        const size_t   hash  = getBindlessHash(pass, extraKey);
+        auto           iter  = bindlessBuffers.find(hash);
+        if (iter == bindlessBuffers.end()) {
+            for (auto it = bindlessBuffers.begin(); it != bindlessBuffers.end();) {
+                if (it->second->_bindlessFrame + BINDLESS_BUFFER_IDLE_FRAMES < frame) {
+                    it->second->destroy();
+                    CC_SAFE_DELETE(it->second);
+                    it = bindlessBuffers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            auto *buffer        = CC_NEW(InstancedBuffer(pass));
+            buffer->_sharedPass = pass;
+            iter                = bindlessBuffers.emplace(hash, buffer).first;
+        }
+        iter->second->_bindlessFrame = frame;
+        return iter->second;
+    }
+
     auto &record = buffers[pass];
     auto &buffer = record[extraKey];
     if (buffer == nullptr) buffer = CC_NEW(InstancedBuffer(pass));
@@ -56,6 +162,28 @@ void InstancedBuffer::destroyInstancedBuffer() {
         }
     }
     InstancedBuffer::buffers.clear();
+    for (auto &pair : InstancedBuffer::bindlessBuffers) {
+        pair.second->destroy();
+        CC_SAFE_DELETE(pair.second);
+    }
+    InstancedBuffer::bindlessBuffers.clear();
+    CC_SAFE_DELETE(gpuCulling);
+}
+
+void InstancedBuffer::setGPUCullingEnabled(bool enabled) {
+    if (gpuCullingEnabled == enabled) return;
+    gpuCullingEnabled = enabled;
+    // instances are recreated in the other mode on the next merge
+    for (auto &pair : InstancedBuffer::buffers) {
+        for (const auto &item : pair.second) {
+            if (item.second) {
+                item.second->destroy();
+            }
+        }
+    }
+    for (auto &pair : InstancedBuffer::bindlessBuffers) {
+        pair.second->destroy();
+    }
 }
 
 InstancedBuffer::InstancedBuffer(const scene::Pass *pass)
@@ -67,6 +195,10 @@ InstancedBuffer::~InstancedBuffer() = default;
 
 void InstancedBuffer::destroy() {
     for (auto &instance : _instances) {
+        if (instance.gpuItem) {
+            gpuCulling->destroyItem(instance.gpuItem);
+            CC_SAFE_DELETE(instance.gpuItem);
+        }
         CC_SAFE_DESTROY_AND_DELETE(instance.vb);
         CC_SAFE_DESTROY_AND_DELETE(instance.ia);
         CC_FREE(instance.data);
@@ -83,21 +215,70 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
     const auto *instancedBuffer = model->getInstancedBuffer();
 
     if (!stride) return; // we assume per-instance attributes are always present
+    if (!shaderImplant && !subModel->getShader(passIdx)) return; // not compiled yet
+    if (_sharedPass) {
+        instancedBuffer = writeBindlessTextureIndices(model, subModel->getPass(passIdx));
+    }
+    if (gpuCullingEnabled && stride % sizeof(uint32_t) == 0 && InstancedGPUCulling::isSupported(_device)) {
+        mergeGPU(model, subModel, instancedBuffer, shaderImplant ? shaderImplant : subModel->getShader(passIdx));
+        return;
+    }
+    merge(subModel, model->getInstanceAttributes(), instancedBuffer, stride, shaderImplant ? shaderImplant : subModel->getShader(passIdx));
+}
+
+const uint8_t *InstancedBuffer::writeBindlessTextureIndices(const scene::Model *model, const scene::Pass *pass) {
+    const auto  stride     = model->getInstancedBufferSize();
+    const auto &attributes = model->getInstanceAttributes();
+    _bindlessInstanceData.assign(model->getInstancedBuffer(), model->getInstancedBuffer() + stride);
+
+    uint32_t offset = 0;
+    for (const auto &attribute : attributes) {
+        const auto &info = gfx::GFX_FORMAT_INFOS[static_cast<uint32_t>(attribute.format)];
+        if (attribute.name != BINDLESS_INDICES_ATTR) {
+            offset += info.size;
+            continue;
+        }
+
+        auto *         table         = getBindlessTextureTable();
+        const auto *   descriptorSet = pass->getDescriptorSet();
+        uint8_t *      data          = _bindlessInstanceData.data() + offset;
+        const uint32_t count         = std::min(info.count, MAX_BINDLESS_INDICES);
+        uint32_t       written       = 0;
+        for (const auto &binding : descriptorSet->getLayout()->getBindings()) {
+            if (written >= count) break;
+            if (binding.descriptorType != gfx::DescriptorType::SAMPLER_TEXTURE) continue;
+            auto *   texture = descriptorSet->getTexture(binding.binding);
+            auto *   sampler = descriptorSet->getSampler(binding.binding);
+            uint32_t index   = texture && sampler ? table->getIndex(texture, sampler) : BindlessTextureTable::INVALID_INDEX;
+            // the first slot is sampled instead if unbound or the table is full
+            if (index == BindlessTextureTable::INVALID_INDEX) index = 0;
+            if (info.type == gfx::FormatType::FLOAT) {
+                const auto value = static_cast<float>(index);
+                memcpy(data + written * sizeof(float), &value, sizeof(float));
+            } else {
+                memcpy(data + written * sizeof(uint32_t), &index, sizeof(uint32_t));
+            }
+            ++written;
+        }
+        break;
+    }
+    return _bindlessInstanceData.data();
+}
+
+void InstancedBuffer::merge(const scene::SubModel *subModel, const ccstd::vector<gfx::Attribute> &instanceAttributes, const uint8_t *instancedBuffer, uint stride, gfx::Shader *shader) {
+    if (!stride || !shader) return;
     auto *sourceIA      = subModel->getInputAssembler();
-    auto *descriptorSet = subModel->getDescriptorSet();
+    auto *descriptorSet = subModel->getDrawDescriptorSet();
     auto *lightingMap   = descriptorSet->getTexture(LIGHTMAPTEXTURE::BINDING);
-    auto *shader        = shaderImplant;
-    if (!shader) {
-        shader = subModel->getShader(passIdx);
-    }
+    auto *jointTexture  = descriptorSet->getTexture(JOINTTEXTURE::BINDING);
 
     for (auto &instance : _instances) {
-        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.count >= MAX_CAPACITY) {
+        if (instance.gpuItem || instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.count >= MAX_CAPACITY) {
             continue;
         }
 
         // check same binding
-        if (instance.lightingMap != lightingMap) {
+        if (instance.lightingMap != lightingMap || instance.jointTexture != jointTexture) {
             continue;
         }
 
@@ -134,7 +315,7 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
     auto  attributes    = sourceIA->getAttributes();
     auto *indexBuffer   = sourceIA->getIndexBuffer();
 
-    for (const auto &attribute : model->getInstanceAttributes()) {
+    for (const auto &attribute : instanceAttributes) {
         attributes.emplace_back(gfx::Attribute{
             attribute.name,
             attribute.format,
@@ -149,15 +330,122 @@ void InstancedBuffer::merge(const scene::Model *model, const scene::SubModel *su
     vertexBuffers.emplace_back(vb);
     gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, indexBuffer};
     auto *                  ia     = _device->createInputAssembler(iaInfo);
-    InstancedItem           item   = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap};
+    InstancedItem           item   = {1, INITIAL_CAPACITY, vb, data, ia, stride, shader, descriptorSet, lightingMap, jointTexture};
     _instances.emplace_back(item);
     _hasPendingModels = true;
 }
 
-void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff) {
+void InstancedBuffer::mergeGPU(const scene::Model *model, const scene::SubModel *subModel, const uint8_t *instancedBuffer, gfx::Shader *shader) {
+    auto  stride        = model->getInstancedBufferSize();
+    auto *sourceIA      = subModel->getInputAssembler();
+    auto *descriptorSet = subModel->getDrawDescriptorSet();
+    auto *lightingMap   = descriptorSet->getTexture(LIGHTMAPTEXTURE::BINDING);
+    auto *jointTexture  = descriptorSet->getTexture(JOINTTEXTURE::BINDING);
+
+    Vec4 bounds[2];
+    if (const auto *worldBounds = model->getWorldBounds()) {
+        bounds[0].set(worldBounds->center.x, worldBounds->center.y, worldBounds->center.z, 0.F);
+        bounds[1].set(worldBounds->halfExtents.x, worldBounds->halfExtents.y, worldBounds->halfExtents.z, 0.F);
+    } else {
+        bounds[1].set(FLT_MAX, FLT_MAX, FLT_MAX, 0.F); // never culled
+    }
+
+    InstancedItem *target = nullptr;
+    uint32_t       slot   = 0;
+    bool           dirty  = false;
+    for (auto &instance : _instances) {
+        auto *gpuItem = instance.gpuItem;
+        if (!gpuItem) continue;
+        auto iter = gpuItem->slots.find(subModel);
+        if (iter == gpuItem->slots.end()) continue;
+        // the sub model no longer fits its item
+        if (instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() || instance.lightingMap != lightingMap ||
+            instance.jointTexture != jointTexture || instance.stride != stride) {
+            removeSlot(gpuItem, iter->second);
+            break;
+        }
+        target = &instance;
+        slot   = iter->second;
+        break;
+    }
+
+    if (!target) {
+        for (auto &instance : _instances) {
+            if (!instance.gpuItem || instance.ia->getIndexBuffer() != sourceIA->getIndexBuffer() ||
+                instance.lightingMap != lightingMap || instance.jointTexture != jointTexture || instance.stride != stride ||
+                instance.gpuItem->subModels.size() >= MAX_GPU_CAPACITY) {
+                continue;
+            }
+            target = &instance;
+            break;
+        }
+    }
+
+    if (!target) {
+        // written by the culling pass only
+        auto *vb = _device->createBuffer({
+            gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::STORAGE,
+            gfx::MemoryUsageBit::DEVICE,
+            static_cast<uint>(stride * INITIAL_CAPACITY),
+            static_cast<uint>(stride),
+        });
+
+        auto vertexBuffers = sourceIA->getVertexBuffers();
+        auto attributes    = sourceIA->getAttributes();
+        for (const auto &attribute : model->getInstanceAttributes()) {
+            attributes.emplace_back(gfx::Attribute{
+                attribute.name,
+                attribute.format,
+                attribute.isNormalized,
+                static_cast<uint>(vertexBuffers.size()), // stream
+                true,
+                attribute.location});
+        }
+        vertexBuffers.emplace_back(vb);
+        gfx::InputAssemblerInfo iaInfo = {attributes, vertexBuffers, sourceIA->getIndexBuffer()};
+        auto *                  ia     = _device->createInputAssembler(iaInfo);
+
+        if (!gpuCulling) gpuCulling = CC_NEW(InstancedGPUCulling(_device));
+        auto *gpuItem = CC_NEW(InstancedGPUItem);
+        gpuCulling->initItem(gpuItem, ia, vb, stride, INITIAL_CAPACITY);
+        _instances.emplace_back(InstancedItem{0, INITIAL_CAPACITY, vb, nullptr, ia, stride, shader, descriptorSet, lightingMap, jointTexture, gpuItem});
+        target = &_instances.back();
+    }
+
+    auto *gpuItem = target->gpuItem;
+    if (gpuItem->slots.count(subModel) == 0) {
+        slot  = addSlot(gpuItem, subModel);
+        dirty = true;
+    }
+    uint8_t *slotData   = gpuItem->data.data() + slot * stride;
+    Vec4 *   slotBounds = gpuItem->bounds.data() + 2 * slot;
+    if (dirty || memcmp(slotData, instancedBuffer, stride) != 0 || memcmp(slotBounds, bounds, sizeof(bounds)) != 0) {
+        memcpy(slotData, instancedBuffer, stride);
+        memcpy(slotBounds, bounds, sizeof(bounds));
+        gpuItem->dirtyEnd = std::max(gpuItem->dirtyEnd, slot + 1);
+    }
+    gpuItem->stamps[slot] = _stamp;
+
+    target->shader        = shader;
+    target->descriptorSet = descriptorSet;
+    ++target->count;
+    _hasPendingModels = true;
+}
+
+void InstancedBuffer::uploadBuffers(gfx::CommandBuffer *cmdBuff, const geometry::Frustum *frustum) {
+    if (_sharedPass) {
+        // entries added by the merges are sampled by the coming draws
+        getBindlessTextureTable()->flush();
+    }
     for (auto &instance : _instances) {
         if (!instance.count) continue;
 
+        if (instance.gpuItem) {
+            evictStaleSlots(instance.gpuItem, _stamp);
+            gpuCulling->cull(cmdBuff, instance.gpuItem, frustum);
+            continue;
+        }
+
         cmdBuff->updateBuffer(instance.vb, instance.data, instance.vb->getSize());
         instance.ia->setInstanceCount(instance.count);
     }
@@ -168,6 +456,7 @@ void InstancedBuffer::clear() {
         instance.count = 0;
     }
     _hasPendingModels = false;
+    ++_stamp;
 }
 
 void InstancedBuffer::setDynamicOffset(uint idx, uint value) {
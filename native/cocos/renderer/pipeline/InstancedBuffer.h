@@ -35,8 +35,13 @@ namespace cc {
 namespace gfx {
 class Device;
 }
+namespace geometry {
+class Frustum;
+}
 namespace pipeline {
 struct PSOInfo;
+struct InstancedGPUItem;
+class InstancedGPUCulling;
 
 #if defined(INITIAL_CAPACITY)
     #undef INITIAL_CAPACITY
@@ -52,6 +57,8 @@ struct CC_DLL InstancedItem {
     gfx::Shader *        shader        = nullptr;
     gfx::DescriptorSet * descriptorSet = nullptr;
     gfx::Texture *       lightingMap   = nullptr;
+    gfx::Texture *       jointTexture  = nullptr; // baked skinning instances must share their animation atlas
+    InstancedGPUItem *   gpuItem       = nullptr; // persistent instances culled on the GPU, data is unused
 };
 using InstancedItemList = ccstd::vector<InstancedItem>;
 using DynamicOffsetList = ccstd::vector<uint>;
@@ -60,17 +67,37 @@ class InstancedBuffer : public RefCounted {
 public:
     static constexpr uint   INITIAL_CAPACITY = 32;
     static constexpr uint   MAX_CAPACITY     = 1024;
+    static constexpr uint   MAX_GPU_CAPACITY = 16384;
     static InstancedBuffer *get(scene::Pass *pass);
+    /**
+     * @en Passes defining CC_USE_BINDLESS_TEXTURES share the buffer with the passes differing only in textures on devices
+     * supporting bindless textures, the textures of the instances are read from the BindlessTextureTable by the indices
+     * written into their a_bindlessTextureIndices attribute.
+     * @zh 在支持无绑定纹理的设备上，定义了 CC_USE_BINDLESS_TEXTURES 的 Pass 与仅纹理不同的 Pass 共享同一个缓冲，
+     * 实例的纹理通过写入其 a_bindlessTextureIndices 属性的索引从 BindlessTextureTable 中读取。
+     */
     static InstancedBuffer *get(scene::Pass *, uint extraKey);
     static void             destroyInstancedBuffer();
 
+    /**
+     * @en Keep the instances persistent on the GPU, only changed instances are uploaded and a compute pass culls and compacts them
+     * before an indirect draw. Takes effect on devices with compute shaders, for instances whose attributes are 4 byte aligned.
+     * @zh 将实例常驻在 GPU 上，只上传发生变化的实例，并在间接绘制前由计算通道剔除和压缩。
+     * 只在支持计算着色器的设备上、对属性 4 字节对齐的实例生效。
+     */
+    static void setGPUCullingEnabled(bool enabled);
+    static bool isGPUCullingEnabled() { return gpuCullingEnabled; }
+
     explicit InstancedBuffer(const scene::Pass *pass);
     ~InstancedBuffer() override;
 
     void destroy();
     void merge(const scene::Model *, const scene::SubModel *, uint);
     void merge(const scene::Model *, const scene::SubModel *, uint, gfx::Shader *);
-    void uploadBuffers(gfx::CommandBuffer *cmdBuff);
+    // merges per-instance data provided by the caller, for models whose own shaders aren't instanced
+    void merge(const scene::SubModel *subModel, const ccstd::vector<gfx::Attribute> &instanceAttributes, const uint8_t *instancedBuffer, uint stride, gfx::Shader *shader);
+    // frustum only applies to GPU culled instances, which are compacted without culling if it is null
+    void uploadBuffers(gfx::CommandBuffer *cmdBuff, const geometry::Frustum *frustum = nullptr);
     void clear();
     void setDynamicOffset(uint idx, uint value);
 
@@ -80,12 +107,22 @@ public:
     inline const DynamicOffsetList &dynamicOffsets() const { return _dynamicOffsets; }
 
 private:
+    void           mergeGPU(const scene::Model *, const scene::SubModel *, const uint8_t *instancedBuffer, gfx::Shader *);
+    const uint8_t *writeBindlessTextureIndices(const scene::Model *, const scene::Pass *);
+
     static ccstd::unordered_map<scene::Pass *, ccstd::unordered_map<uint, InstancedBuffer *>> buffers;
+    static ccstd::unordered_map<size_t, InstancedBuffer *>                                    bindlessBuffers; // by the hash of the pass states and uniforms
+    static InstancedGPUCulling *                                                              gpuCulling;
+    static bool                                                                               gpuCullingEnabled;
     InstancedItemList                                                                         _instances;
     const scene::Pass *                                                                       _pass             = nullptr;
     bool                                                                                      _hasPendingModels = false;
     DynamicOffsetList                                                                         _dynamicOffsets;
     gfx::Device *                                                                             _device = nullptr;
+    uint                                                                                      _stamp  = 0; // slots not merged since the last clear are evicted
+    IntrusivePtr<scene::Pass>                                                                 _sharedPass; // kept alive for the other passes merging into a bindless buffer
+    ccstd::vector<uint8_t>                                                                    _bindlessInstanceData;
+    uint32_t                                                                                  _bindlessFrame{0}; // of the last merge, idle bindless buffers are destroyed
 };
 
 } // namespace pipeline
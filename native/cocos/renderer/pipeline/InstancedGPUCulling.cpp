@@ -0,0 +1,316 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "InstancedGPUCulling.h"
+#include "base/StringUtil.h"
+#include "core/geometry/Frustum.h"
+#include "gfx-base/GFXBuffer.h"
+#include "gfx-base/GFXCommandBuffer.h"
+#include "gfx-base/GFXDescriptorSet.h"
+#include "gfx-base/GFXDescriptorSetLayout.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXInputAssembler.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+// std140 layout of CCInstanceCulling
+struct CullingConstants {
+    Vec4     planes[6];
+    uint32_t instanceInfo[4]{0}; // slot count, words per instance, plane count, indexed
+    uint32_t drawInfo[4]{0};     // index or vertex count, first index or first vertex, vertex offset
+};
+
+constexpr uint32_t DRAW_COMMAND_SIZE = sizeof(gfx::DrawIndexedIndirectCommand);
+
+const char *const CULLING_SHADER_GLSL4 = R"(
+    layout(set=0, binding=0, std140) uniform CCInstanceCulling {
+        vec4  cc_planes[6];
+        uvec4 cc_instanceInfo;
+        uvec4 cc_drawInfo;
+    };
+    layout(set=0, binding=1, std430) readonly buffer b_instanceBoundsBuffer { vec4 b_instanceBounds[]; };
+    layout(set=0, binding=2, std430) readonly buffer b_instanceSourceBuffer { uint b_instanceSource[]; };
+    layout(set=0, binding=3, std430) buffer b_instanceOutputBuffer { uint b_instanceOutput[]; };
+    layout(set=0, binding=4, std430) buffer b_instanceCounterBuffer { uint b_instanceCounter[]; };
+    layout(set=0, binding=5, std430) buffer b_drawCommandBuffer { uint b_drawCommand[]; };
+)";
+
+const char *const CULLING_SHADER_GLSL3 = R"(
+    layout(std140) uniform CCInstanceCulling {
+        vec4  cc_planes[6];
+        uvec4 cc_instanceInfo;
+        uvec4 cc_drawInfo;
+    };
+    layout(std430, binding=1) readonly buffer b_instanceBoundsBuffer { vec4 b_instanceBounds[]; };
+    layout(std430, binding=2) readonly buffer b_instanceSourceBuffer { uint b_instanceSource[]; };
+    layout(std430, binding=3) buffer b_instanceOutputBuffer { uint b_instanceOutput[]; };
+    layout(std430, binding=4) buffer b_instanceCounterBuffer { uint b_instanceCounter[]; };
+    layout(std430, binding=5) buffer b_drawCommandBuffer { uint b_drawCommand[]; };
+)";
+
+// same test as ModelBoundsArray::cull, the box is outside once it is fully behind any plane
+const char *const CULLING_MAIN = R"(
+    layout(local_size_x=%u, local_size_y=1, local_size_z=1) in;
+    void main() {
+        uint slot = gl_GlobalInvocationID.x;
+        if (slot >= cc_instanceInfo.x) {
+            return;
+        }
+        vec3 center      = b_instanceBounds[2u * slot].xyz;
+        vec3 halfExtents = b_instanceBounds[2u * slot + 1u].xyz;
+        for (uint i = 0u; i < cc_instanceInfo.z; ++i) {
+            vec4 plane = cc_planes[i];
+            if (dot(plane.xyz, center) + dot(halfExtents, abs(plane.xyz)) < plane.w) {
+                return;
+            }
+        }
+        uint words = cc_instanceInfo.y;
+        uint dst   = atomicAdd(b_instanceCounter[0], 1u) * words;
+        uint src   = slot * words;
+        for (uint i = 0u; i < words; ++i) {
+            b_instanceOutput[dst + i] = b_instanceSource[src + i];
+        }
+    }
+)";
+
+// writes DrawIndexedIndirectCommand or DrawIndirectCommand
+const char *const FINALIZING_MAIN = R"(
+    layout(local_size_x=1, local_size_y=1, local_size_z=1) in;
+    void main() {
+        uint count           = b_instanceCounter[0];
+        b_instanceCounter[0] = 0u;
+        b_drawCommand[0]     = cc_drawInfo.x;
+        b_drawCommand[1]     = count;
+        b_drawCommand[2]     = cc_drawInfo.y;
+        if (cc_instanceInfo.w != 0u) {
+            b_drawCommand[3] = cc_drawInfo.z;
+            b_drawCommand[4] = 0u;
+        } else {
+            b_drawCommand[3] = 0u;
+        }
+    }
+)";
+
+} // namespace
+
+bool InstancedGPUCulling::isSupported(gfx::Device *device) {
+    return device->hasFeature(gfx::Feature::COMPUTE_SHADER) && device->getGfxAPI() != gfx::API::GLES2;
+}
+
+InstancedGPUCulling::InstancedGPUCulling(gfx::Device *device)
+: _device(device) {
+    const char *header = _device->getGfxAPI() == gfx::API::GLES3 ? CULLING_SHADER_GLSL3 : CULLING_SHADER_GLSL4;
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.blocks = {
+        {0, 0, "CCInstanceCulling", {{"cc_planes", gfx::Type::FLOAT4, 6}, {"cc_instanceInfo", gfx::Type::UINT4, 1}, {"cc_drawInfo", gfx::Type::UINT4, 1}}, 1},
+    };
+    shaderInfo.buffers = {
+        {0, 1, "b_instanceBoundsBuffer", 1, gfx::MemoryAccessBit::READ_ONLY},
+        {0, 2, "b_instanceSourceBuffer", 1, gfx::MemoryAccessBit::READ_ONLY},
+        {0, 3, "b_instanceOutputBuffer", 1, gfx::MemoryAccessBit::READ_WRITE},
+        {0, 4, "b_instanceCounterBuffer", 1, gfx::MemoryAccessBit::READ_WRITE},
+        {0, 5, "b_drawCommandBuffer", 1, gfx::MemoryAccessBit::READ_WRITE},
+    };
+
+    shaderInfo.name   = "InstancedCulling";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, header + StringUtil::format(CULLING_MAIN, WORK_GROUP_SIZE)}};
+    _cullingShader    = _device->createShader(shaderInfo);
+
+    shaderInfo.name   = "InstancedCullingFinalize";
+    shaderInfo.stages = {{gfx::ShaderStageFlagBit::COMPUTE, header + ccstd::string(FINALIZING_MAIN)}};
+    _finalizingShader = _device->createShader(shaderInfo);
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::UNIFORM_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    for (uint32_t binding = 1; binding <= 5; ++binding) {
+        dslInfo.bindings.push_back({binding, gfx::DescriptorType::STORAGE_BUFFER, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    }
+    _descriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _pipelineLayout      = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.pipelineLayout = _pipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+
+    pipelineInfo.shader   = _cullingShader;
+    _cullingPipelineState = _device->createPipelineState(pipelineInfo);
+
+    pipelineInfo.shader      = _finalizingShader;
+    _finalizingPipelineState = _device->createPipelineState(pipelineInfo);
+
+    _uploadBarrier = _device->getGeneralBarrier({
+        gfx::AccessFlagBit::TRANSFER_WRITE,
+        gfx::AccessFlagBit::COMPUTE_SHADER_READ_UNIFORM_BUFFER | gfx::AccessFlagBit::COMPUTE_SHADER_READ_OTHER,
+    });
+    _cullingBarrier = _device->getGeneralBarrier({
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+        gfx::AccessFlagBit::COMPUTE_SHADER_READ_OTHER,
+    });
+    _drawBarrier = _device->getGeneralBarrier({
+        gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
+        gfx::AccessFlagBit::INDIRECT_BUFFER | gfx::AccessFlagBit::VERTEX_BUFFER,
+    });
+}
+
+InstancedGPUCulling::~InstancedGPUCulling() {
+    CC_SAFE_DESTROY_AND_DELETE(_cullingPipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_finalizingPipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSetLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_cullingShader);
+    CC_SAFE_DESTROY_AND_DELETE(_finalizingShader);
+}
+
+void InstancedGPUCulling::initItem(InstancedGPUItem *item, const gfx::InputAssembler *ia, gfx::Buffer *instanceBuffer, uint32_t stride, uint32_t capacity) {
+    CC_ASSERT(stride % sizeof(uint32_t) == 0);
+    item->inputAssembler = ia;
+    item->instanceBuffer = instanceBuffer;
+    item->stride         = stride;
+    item->capacity       = capacity;
+    item->data.resize(stride * capacity);
+    item->bounds.resize(2 * capacity);
+
+    item->sourceBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        stride * capacity,
+        stride,
+    });
+    item->boundsBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        static_cast<uint32_t>(2 * sizeof(Vec4) * capacity),
+        static_cast<uint32_t>(2 * sizeof(Vec4)),
+    });
+    item->counterBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE,
+        sizeof(uint32_t),
+        sizeof(uint32_t),
+    });
+    // never updated from the CPU, Buffer::update of indirect buffers takes DrawInfos instead of native commands
+    item->drawBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::STORAGE | gfx::BufferUsageBit::INDIRECT,
+        gfx::MemoryUsageBit::DEVICE,
+        DRAW_COMMAND_SIZE,
+        DRAW_COMMAND_SIZE,
+    });
+    item->uniformBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
+        sizeof(CullingConstants),
+        sizeof(CullingConstants),
+    });
+
+    // the finalizing pass resets the counter after each culling
+    const uint32_t zero = 0;
+    item->counterBuffer->update(&zero, sizeof(zero));
+
+    item->descriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+    item->descriptorSet->bindBuffer(0, item->uniformBuffer);
+    item->descriptorSet->bindBuffer(1, item->boundsBuffer);
+    item->descriptorSet->bindBuffer(2, item->sourceBuffer);
+    item->descriptorSet->bindBuffer(3, item->instanceBuffer);
+    item->descriptorSet->bindBuffer(4, item->counterBuffer);
+    item->descriptorSet->bindBuffer(5, item->drawBuffer);
+    item->descriptorSet->update();
+}
+
+void InstancedGPUCulling::destroyItem(InstancedGPUItem *item) {
+    CC_SAFE_DESTROY_AND_DELETE(item->descriptorSet);
+    CC_SAFE_DESTROY_AND_DELETE(item->sourceBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(item->boundsBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(item->counterBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(item->drawBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(item->uniformBuffer);
+    item->inputAssembler = nullptr;
+    item->instanceBuffer = nullptr;
+}
+
+void InstancedGPUCulling::reserve(InstancedGPUItem *item, uint32_t capacity) {
+    if (capacity <= item->capacity) {
+        return;
+    }
+    while (item->capacity < capacity) {
+        item->capacity <<= 1;
+    }
+    item->data.resize(item->stride * item->capacity);
+    item->bounds.resize(2 * item->capacity);
+    // resizing keeps the buffer objects, so the descriptor set stays valid
+    item->sourceBuffer->resize(item->stride * item->capacity);
+    item->boundsBuffer->resize(static_cast<uint32_t>(2 * sizeof(Vec4) * item->capacity));
+    item->instanceBuffer->resize(item->stride * item->capacity);
+    // resized buffers lose their contents
+    item->dirtyEnd = static_cast<uint32_t>(item->subModels.size());
+}
+
+void InstancedGPUCulling::cull(gfx::CommandBuffer *cmdBuff, InstancedGPUItem *item, const geometry::Frustum *frustum) {
+    const auto slotCount = static_cast<uint32_t>(item->subModels.size());
+    reserve(item, slotCount);
+
+    if (item->dirtyEnd) {
+        // updateBuffer always writes from the beginning, so the dirty prefix is uploaded
+        cmdBuff->updateBuffer(item->sourceBuffer, item->data.data(), item->stride * item->dirtyEnd);
+        cmdBuff->updateBuffer(item->boundsBuffer, item->bounds.data(), static_cast<uint32_t>(2 * sizeof(Vec4) * item->dirtyEnd));
+        item->dirtyEnd = 0;
+    }
+
+    CullingConstants constants;
+    uint32_t         planeCount = 0;
+    if (frustum) {
+        for (const auto *plane : frustum->planes) {
+            constants.planes[planeCount++].set(plane->n.x, plane->n.y, plane->n.z, plane->d);
+        }
+    }
+    const auto *ia           = item->inputAssembler;
+    const bool  indexed      = ia->getIndexBuffer() != nullptr;
+    constants.instanceInfo[0] = slotCount;
+    constants.instanceInfo[1] = item->stride / static_cast<uint32_t>(sizeof(uint32_t));
+    constants.instanceInfo[2] = planeCount;
+    constants.instanceInfo[3] = indexed ? 1 : 0;
+    constants.drawInfo[0]     = indexed ? ia->getIndexCount() : ia->getVertexCount();
+    constants.drawInfo[1]     = indexed ? ia->getFirstIndex() : ia->getFirstVertex();
+    constants.drawInfo[2]     = ia->getVertexOffset();
+    cmdBuff->updateBuffer(item->uniformBuffer, &constants, sizeof(constants));
+    cmdBuff->pipelineBarrier(_uploadBarrier);
+
+    if (slotCount) {
+        cmdBuff->bindPipelineState(_cullingPipelineState);
+        cmdBuff->bindDescriptorSet(0, item->descriptorSet);
+        cmdBuff->dispatch({(slotCount + WORK_GROUP_SIZE - 1) / WORK_GROUP_SIZE, 1, 1});
+        cmdBuff->pipelineBarrier(_cullingBarrier);
+    }
+
+    cmdBuff->bindPipelineState(_finalizingPipelineState);
+    cmdBuff->bindDescriptorSet(0, item->descriptorSet);
+    cmdBuff->dispatch({1, 1, 1});
+    cmdBuff->pipelineBarrier(_drawBarrier);
+}
+
+} // namespace pipeline
+} // namespace cc
@@ -0,0 +1,109 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "math/Vec4.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+namespace geometry {
+class Frustum;
+} // namespace geometry
+namespace scene {
+class SubModel;
+} // namespace scene
+namespace pipeline {
+
+/**
+ * @en Persistent instances of an instanced item, culled and compacted into its instance buffer on the GPU.
+ * Each slot keeps the instanced attributes and the world bounds of a sub model, and is only uploaded again when they change.
+ * @zh 实例化条目的常驻实例，在 GPU 上剔除并压缩到其实例缓冲中。
+ * 每个槽位保存一个子模型的实例化属性和世界包围盒，只在其变化时重新上传。
+ */
+struct CC_DLL InstancedGPUItem {
+    ccstd::unordered_map<const scene::SubModel *, uint32_t> slots;
+    ccstd::vector<const scene::SubModel *>                  subModels;
+    ccstd::vector<uint32_t>                                 stamps; // merge stamp per slot, stale slots are evicted before culling
+    ccstd::vector<uint8_t>                                  data;   // instanced attributes per slot
+    ccstd::vector<Vec4>                                     bounds; // world bounds per slot, center and half extents
+    uint32_t                                                stride{0};
+    uint32_t                                                capacity{0};
+    uint32_t                                                dirtyEnd{0}; // slots before it are uploaded before culling
+
+    const gfx::InputAssembler *inputAssembler{nullptr}; // draws the compacted instances, not owned
+    gfx::Buffer *              instanceBuffer{nullptr}; // compacted instances, not owned
+    gfx::Buffer *              sourceBuffer{nullptr};
+    gfx::Buffer *              boundsBuffer{nullptr};
+    gfx::Buffer *              counterBuffer{nullptr};
+    gfx::Buffer *              drawBuffer{nullptr}; // draw command read by drawIndirect
+    gfx::Buffer *              uniformBuffer{nullptr};
+    gfx::DescriptorSet *       descriptorSet{nullptr};
+};
+
+/**
+ * @en Compute passes shared by all GPU culled instanced items, the culling pass frustum culls the slots and appends the visible ones
+ * to the instance buffer, the finalizing pass writes the visible count into the indirect draw command and resets the counter.
+ * @zh 所有 GPU 剔除的实例化条目共享的计算通道。剔除通道对槽位进行视锥剔除并将可见实例追加到实例缓冲，
+ * 收尾通道将可见数量写入间接绘制命令并重置计数器。
+ */
+class CC_DLL InstancedGPUCulling final {
+public:
+    static constexpr uint32_t WORK_GROUP_SIZE{64};
+
+    static bool isSupported(gfx::Device *device);
+
+    explicit InstancedGPUCulling(gfx::Device *device);
+    ~InstancedGPUCulling();
+
+    // instanceBuffer must be created with the STORAGE usage, it is resized along with the slots
+    void initItem(InstancedGPUItem *item, const gfx::InputAssembler *ia, gfx::Buffer *instanceBuffer, uint32_t stride, uint32_t capacity);
+    void destroyItem(InstancedGPUItem *item);
+
+    // must be recorded outside render passes, frustum can be null to only compact the instances
+    void cull(gfx::CommandBuffer *cmdBuff, InstancedGPUItem *item, const geometry::Frustum *frustum);
+
+private:
+    void reserve(InstancedGPUItem *item, uint32_t capacity);
+
+    gfx::Device *             _device{nullptr};
+    gfx::Shader *             _cullingShader{nullptr};
+    gfx::Shader *             _finalizingShader{nullptr};
+    gfx::DescriptorSetLayout *_descriptorSetLayout{nullptr};
+    gfx::PipelineLayout *     _pipelineLayout{nullptr};
+    gfx::PipelineState *      _cullingPipelineState{nullptr};
+    gfx::PipelineState *      _finalizingPipelineState{nullptr};
+    gfx::GeneralBarrier *     _uploadBarrier{nullptr};
+    gfx::GeneralBarrier *     _cullingBarrier{nullptr};
+    gfx::GeneralBarrier *     _drawBarrier{nullptr};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(InstancedGPUCulling);
+};
+
+} // namespace pipeline
+} // namespace cc
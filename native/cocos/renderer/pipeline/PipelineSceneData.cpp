@@ -25,6 +25,7 @@
 
 #include "PipelineSceneData.h"
 #include <sstream>
+#include "HiZCulling.h"
 #include "core/ArrayBuffer.h"
 #include "core/assets/Material.h"
 #include "gfx-base/GFXDef-common.h"
@@ -54,6 +55,24 @@ PipelineSceneData::~PipelineSceneData() {
     CC_SAFE_DELETE(_skybox);
     CC_SAFE_DELETE(_shadow);
     CC_SAFE_DELETE(_octree);
+    CC_SAFE_DELETE(_hiZCulling);
+}
+
+const RenderObjectList *PipelineSceneData::getSpotShadowObjects(const scene::Light *light) const {
+    for (const auto &entry : _spotShadowObjects) {
+        if (entry.first == light) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void PipelineSceneData::setHiZCullingEnabled(bool val) {
+    if (val && !_hiZCulling) {
+        _hiZCulling = new HiZCulling();
+    } else if (!val) {
+        CC_SAFE_DELETE(_hiZCulling);
+    }
 }
 
 void PipelineSceneData::activate(gfx::Device *device) {
@@ -46,6 +46,9 @@ class Light;
 } // namespace scene
 namespace pipeline {
 
+class HiZCulling;
+class ShadowAtlas;
+
 class CC_DLL PipelineSceneData : public RefCounted {
 public:
     PipelineSceneData();
@@ -58,13 +61,20 @@ public:
     inline void                                                                  setShadowFramebuffer(const scene::Light *light, gfx::Framebuffer *framebuffer) { _shadowFrameBufferMap.emplace(light, framebuffer); }
     inline const ccstd::unordered_map<const scene::Light *, gfx::Framebuffer *> &getShadowFramebufferMap() const { return _shadowFrameBufferMap; }
     inline const RenderObjectList &                                              getRenderObjects() const { return _renderObjects; }
+    inline RenderObjectList &                                                    getRenderObjects() { return _renderObjects; }
     inline const RenderObjectList &                                              getDirShadowObjects() const { return _dirShadowObjects; }
     inline void                                                                  setRenderObjects(RenderObjectList &&ro) { _renderObjects = std::forward<RenderObjectList>(ro); }
-    inline void                                                                  setDirShadowObjects(RenderObjectList &&ro) { _dirShadowObjects = std::forward<RenderObjectList>(ro); }
+    // the setters below swap, the given list gets the previous one back so the culling can reuse its capacity
+    inline void                                                                  setDirShadowObjects(RenderObjectList &&ro) { _dirShadowObjects.swap(ro); }
     inline const RenderObjectList &                                              isCastShadowObjects() const { return _castShadowObjects; }
-    inline void                                                                  setCastShadowObjects(RenderObjectList &&ro) { _castShadowObjects = std::forward<RenderObjectList>(ro); }
+    inline void                                                                  setCastShadowObjects(RenderObjectList &&ro) { _castShadowObjects.swap(ro); }
+    // Shadow casters of spot lights gathered ahead by parallel culling, see sceneCullingParallel.
+    inline void                                                                  setSpotShadowObjects(ccstd::vector<std::pair<const scene::Light *, RenderObjectList>> &&objects) { _spotShadowObjects = std::move(objects); }
+    inline void                                                                  clearSpotShadowObjects() { _spotShadowObjects.clear(); }
+    inline void                                                                  addSpotShadowObjects(const scene::Light *light, RenderObjectList &&objects) { _spotShadowObjects.emplace_back(light, std::move(objects)); }
+    const RenderObjectList *                                                     getSpotShadowObjects(const scene::Light *light) const;
     inline const ccstd::vector<const scene::Light *> &                           getValidPunctualLights() const { return _validPunctualLights; }
-    inline void                                                                  setValidPunctualLights(ccstd::vector<const scene::Light *> &&validPunctualLights) { _validPunctualLights = std::forward<ccstd::vector<const scene::Light *>>(validPunctualLights); }
+    inline void                                                                  setValidPunctualLights(ccstd::vector<const scene::Light *> &&validPunctualLights) { _validPunctualLights.swap(validPunctualLights); }
     inline bool                                                                  isHDR() const { return _isHDR; }
     inline void                                                                  setHDR(bool val) { _isHDR = val; }
     inline scene::Shadows *                                                      getShadows() const { return _shadow; }
@@ -72,6 +82,16 @@ public:
     inline scene::Skybox *                                                       getSkybox() const { return _skybox; }
     inline scene::Fog *                                                          getFog() const { return _fog; }
     inline scene::Octree *                                                       getOctree() const { return _octree; }
+    // Shared shadow map of the spot lights, owned by the shadow flow, nullptr if every light has its own shadow map.
+    inline ShadowAtlas *                                                         getShadowAtlas() const { return _shadowAtlas; }
+    inline void                                                                  setShadowAtlas(ShadowAtlas *atlas) { _shadowAtlas = atlas; }
+    inline HiZCulling *                                                          getHiZCulling() const { return _hiZCulling; }
+    inline bool                                                                  isHiZCullingEnabled() const { return _hiZCulling != nullptr; }
+    // CPU occlusion culling of the frustum culled render objects, see HiZCulling.
+    void                                                                         setHiZCullingEnabled(bool val);
+    // Reuse the culling result of cameras whose view and scene did not change since their last frame, see SceneCullingCache.
+    inline bool                                                                  isCullingCacheEnabled() const { return _cullingCacheEnabled; }
+    inline void                                                                  setCullingCacheEnabled(bool val) { _cullingCacheEnabled = val; }
     inline gfx::InputAssembler *                                                 getOcclusionQueryInputAssembler() const { return _occlusionQueryInputAssembler; }
     inline scene::Pass *                                                         getOcclusionQueryPass() const { return _occlusionQueryPass; }
     inline gfx::Shader *                                                         getOcclusionQueryShader() const { return _occlusionQueryShader; }
@@ -100,6 +120,7 @@ protected:
     RenderObjectList                    _renderObjects;
     RenderObjectList                    _dirShadowObjects;
     RenderObjectList                    _castShadowObjects;
+    ccstd::vector<std::pair<const scene::Light *, RenderObjectList>> _spotShadowObjects;
     ccstd::vector<const scene::Light *> _validPunctualLights;
     gfx::Buffer *                       _occlusionQueryVertexBuffer{nullptr};
     gfx::Buffer *                       _occlusionQueryIndicesBuffer{nullptr};
@@ -123,7 +144,10 @@ protected:
     scene::Skybox * _skybox{nullptr};
     scene::Shadows *_shadow{nullptr};
     scene::Octree * _octree{nullptr};
+    HiZCulling *    _hiZCulling{nullptr};
+    ShadowAtlas *   _shadowAtlas{nullptr};
     bool            _isHDR{true};
+    bool            _cullingCacheEnabled{false};
     float           _shadingScale{1.0F};
 
     ccstd::unordered_map<const scene::Light *, gfx::Framebuffer *> _shadowFrameBufferMap;
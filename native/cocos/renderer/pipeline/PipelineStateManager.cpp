@@ -24,30 +24,36 @@
 ****************************************************************************/
 
 #include "PipelineStateManager.h"
+#include "PipelineStateManifest.h"
 #include "gfx-base/GFXDef-common.h"
 #include "gfx-base/GFXDevice.h"
+#include "renderer/core/ProgramLib.h"
 #include "scene/Pass.h"
 
 namespace cc {
 namespace pipeline {
 
 ccstd::unordered_map<size_t, IntrusivePtr<gfx::PipelineState>> PipelineStateManager::psoHashMap;
+ccstd::unordered_map<size_t, IntrusivePtr<gfx::RenderPass>>    PipelineStateManager::prewarmRenderPasses;
+std::mutex                                                     PipelineStateManager::mutex;
+
+uint64_t PipelineStateManager::computeHash(uint64_t passHash, size_t renderPassHash, size_t attributesHash, uint32_t shaderID, uint subpass) {
+    auto hash = passHash ^ renderPassHash ^ attributesHash ^ shaderID;
+    if (subpass != 0) {
+        hash = hash << subpass;
+    }
+    return hash;
+}
 
 gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::Pass *  pass,
                                                                    gfx::Shader *        shader,
                                                                    gfx::InputAssembler *inputAssembler,
                                                                    gfx::RenderPass *    renderPass,
                                                                    uint                 subpass) {
-    const auto passHash       = pass->getHash();
-    const auto renderPassHash = renderPass->getHash();
-    const auto iaHash         = inputAssembler->getAttributesHash();
-    const auto shaderID       = shader->getTypedID();
-    auto       hash           = passHash ^ renderPassHash ^ iaHash ^ shaderID;
-    if (subpass != 0) {
-        hash = hash << subpass;
-    }
+    const auto hash = computeHash(pass->getHash(), renderPass->getHash(), inputAssembler->getAttributesHash(), shader->getTypedID(), subpass);
 
-    auto *pso = psoHashMap[static_cast<size_t>(hash)].get();
+    std::lock_guard<std::mutex> lock(mutex);
+    auto *                      pso = psoHashMap[static_cast<size_t>(hash)].get();
     if (!pso) {
         auto *pipelineLayout = pass->getPipelineLayout();
 
@@ -64,16 +70,56 @@ gfx::PipelineState *PipelineStateManager::getOrCreatePipelineState(const scene::
                                                                subpass});
 
         psoHashMap[static_cast<size_t>(hash)] = pso;
+
+        if (auto *manifest = ProgramLib::getInstance()->getRecordingManifest()) {
+            manifest->addPipelineState(pass, shader, inputAssembler, renderPass, subpass);
+        }
     }
 
     return pso;
 }
 
+gfx::PipelineState *PipelineStateManager::prewarmPipelineState(const PipelineStateRecord &record, gfx::Shader *shader, gfx::PipelineLayout *pipelineLayout) {
+    gfx::RenderPassInfo renderPassInfo;
+    renderPassInfo.colorAttachments       = record.colorAttachments;
+    renderPassInfo.depthStencilAttachment = record.depthStencilAttachment;
+    renderPassInfo.subpasses              = record.subpasses;
+    const auto renderPassInfoHash         = gfx::RenderPass::computeHash(renderPassInfo);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &                      renderPass = prewarmRenderPasses[renderPassInfoHash];
+    if (!renderPass) {
+        renderPass = gfx::Device::getInstance()->createRenderPass(renderPassInfo);
+    }
+
+    const auto hash = computeHash(record.passHash, renderPass->getHash(), record.attributesHash, shader->getTypedID(), record.subpass);
+    auto &     pso  = psoHashMap[static_cast<size_t>(hash)];
+    if (!pso) {
+        pso = gfx::Device::getInstance()->createPipelineState({shader,
+                                                               pipelineLayout,
+                                                               renderPass,
+                                                               {record.attributes},
+                                                               record.rasterizerState,
+                                                               record.depthStencilState,
+                                                               record.blendState,
+                                                               record.primitive,
+                                                               record.dynamicStates,
+                                                               gfx::PipelineBindPoint::GRAPHICS,
+                                                               record.subpass});
+    }
+    return pso;
+}
+
 void PipelineStateManager::destroyAll() {
+    std::lock_guard<std::mutex> lock(mutex);
     for (auto &pair : psoHashMap) {
         CC_SAFE_DESTROY_NULL(pair.second);
     }
     psoHashMap.clear();
+    for (auto &pair : prewarmRenderPasses) {
+        CC_SAFE_DESTROY_NULL(pair.second);
+    }
+    prewarmRenderPasses.clear();
 }
 
 } // namespace pipeline
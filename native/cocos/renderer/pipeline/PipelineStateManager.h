@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <mutex>
 #include "cocos/base/Ptr.h"
 #include "gfx-base/GFXDef.h"
 
@@ -34,6 +35,9 @@ class Pass;
 }
 namespace pipeline {
 
+struct PipelineStateRecord;
+
+// Thread safe, pipeline states may be requested while render queues are recorded on job threads.
 class CC_DLL PipelineStateManager {
 public:
     static gfx::PipelineState *getOrCreatePipelineState(const scene::Pass *  pass,
@@ -41,10 +45,17 @@ public:
                                                         gfx::InputAssembler *inputAssembler,
                                                         gfx::RenderPass *    renderPass,
                                                         uint                 subpass = 0);
+    // Creates the pipeline state of a manifest entry ahead of time, it is picked up by the matching getOrCreatePipelineState
+    static gfx::PipelineState *prewarmPipelineState(const PipelineStateRecord &record, gfx::Shader *shader, gfx::PipelineLayout *pipelineLayout);
     static void                destroyAll();
 
+    static uint64_t computeHash(uint64_t passHash, size_t renderPassHash, size_t attributesHash, uint32_t shaderID, uint subpass);
+
 private:
     static ccstd::unordered_map<size_t, IntrusivePtr<gfx::PipelineState>> psoHashMap;
+    // render passes recreated from manifests, kept alive for the prewarmed pipeline states
+    static ccstd::unordered_map<size_t, IntrusivePtr<gfx::RenderPass>> prewarmRenderPasses;
+    static std::mutex                                                  mutex;
 };
 
 } // namespace pipeline
@@ -0,0 +1,453 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "PipelineStateManifest.h"
+#include <cstring>
+#include <type_traits>
+#include "PipelineStateManager.h"
+#include "base/Data.h"
+#include "base/Log.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXInputAssembler.h"
+#include "gfx-base/GFXRenderPass.h"
+#include "gfx-base/GFXShader.h"
+#include "platform/FileUtils.h"
+#include "renderer/core/ProgramLib.h"
+#include "scene/Pass.h"
+
+namespace cc {
+namespace pipeline {
+
+namespace {
+constexpr uint32_t MANIFEST_MAGIC   = 0x4D504343; // CCPM
+constexpr uint32_t MANIFEST_VERSION = 1;
+
+enum class MacroType : uint8_t {
+    INT32,
+    BOOL,
+    STRING,
+};
+
+class ManifestWriter {
+public:
+    explicit ManifestWriter(ccstd::vector<uint8_t> &data) : _data(data) {}
+
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be written directly");
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void write(const ccstd::string &str) {
+        write(static_cast<uint32_t>(str.size()));
+        _data.insert(_data.end(), str.begin(), str.end());
+    }
+
+    void write(const gfx::IndexList &list) {
+        write(static_cast<uint32_t>(list.size()));
+        for (const auto index : list) {
+            write(index);
+        }
+    }
+
+private:
+    ccstd::vector<uint8_t> &_data;
+};
+
+class ManifestReader {
+public:
+    ManifestReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T>
+    bool read(T &value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only plain data can be read directly");
+        if (_offset + sizeof(T) > _size) {
+            return false;
+        }
+        memcpy(&value, _data + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    bool read(ccstd::string &str) {
+        uint32_t size = 0;
+        if (!read(size) || _offset + size > _size) {
+            return false;
+        }
+        str.assign(reinterpret_cast<const char *>(_data + _offset), size);
+        _offset += size;
+        return true;
+    }
+
+    bool read(gfx::IndexList &list) {
+        uint32_t count = 0;
+        if (!read(count) || _offset + count * sizeof(uint32_t) > _size) {
+            return false;
+        }
+        list.resize(count);
+        for (auto &index : list) {
+            read(index);
+        }
+        return true;
+    }
+
+    // guards the element counts against corrupted files
+    bool readCount(uint32_t &count, size_t minElementSize) {
+        return read(count) && _offset + count * minElementSize <= _size;
+    }
+
+    inline bool isEnd() const { return _offset == _size; }
+
+private:
+    const uint8_t *_data{nullptr};
+    size_t         _size{0};
+    size_t         _offset{0};
+};
+
+void writeShader(ManifestWriter &writer, const ShaderVariantRecord &shader) {
+    writer.write(shader.program);
+    writer.write(static_cast<uint32_t>(shader.defines.size()));
+    for (const auto &define : shader.defines) {
+        writer.write(define.first);
+        const auto &value = define.second;
+        if (cc::holds_alternative<int32_t>(value)) {
+            writer.write(MacroType::INT32);
+            writer.write(cc::get<int32_t>(value));
+        } else if (cc::holds_alternative<bool>(value)) {
+            writer.write(MacroType::BOOL);
+            writer.write(static_cast<uint8_t>(cc::get<bool>(value)));
+        } else {
+            writer.write(MacroType::STRING);
+            writer.write(cc::get<ccstd::string>(value));
+        }
+    }
+}
+
+bool readShader(ManifestReader &reader, ShaderVariantRecord &shader) {
+    uint32_t defineCount = 0;
+    if (!reader.read(shader.program) || !reader.readCount(defineCount, sizeof(uint32_t) + sizeof(MacroType))) {
+        return false;
+    }
+    for (uint32_t i = 0; i < defineCount; ++i) {
+        ccstd::string name;
+        MacroType     type{MacroType::INT32};
+        if (!reader.read(name) || !reader.read(type)) {
+            return false;
+        }
+        switch (type) {
+            case MacroType::INT32: {
+                int32_t value = 0;
+                if (!reader.read(value)) return false;
+                shader.defines[name] = value;
+                break;
+            }
+            case MacroType::BOOL: {
+                uint8_t value = 0;
+                if (!reader.read(value)) return false;
+                shader.defines[name] = value != 0;
+                break;
+            }
+            case MacroType::STRING: {
+                ccstd::string value;
+                if (!reader.read(value)) return false;
+                shader.defines[name] = value;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+void writePipelineState(ManifestWriter &writer, const PipelineStateRecord &pso) {
+    writer.write(pso.shader);
+    writer.write(pso.subpass);
+    writer.write(pso.passHash);
+    writer.write(pso.attributesHash);
+
+    writer.write(static_cast<uint32_t>(pso.attributes.size()));
+    for (const auto &attribute : pso.attributes) {
+        writer.write(attribute.name);
+        writer.write(attribute.format);
+        writer.write(static_cast<uint8_t>(attribute.isNormalized));
+        writer.write(attribute.stream);
+        writer.write(static_cast<uint8_t>(attribute.isInstanced));
+        writer.write(attribute.location);
+    }
+
+    // barriers are runtime objects and are left out, they don't take part in pipeline compatibility
+    writer.write(static_cast<uint32_t>(pso.colorAttachments.size()));
+    for (const auto &attachment : pso.colorAttachments) {
+        writer.write(attachment.format);
+        writer.write(attachment.sampleCount);
+        writer.write(attachment.loadOp);
+        writer.write(attachment.storeOp);
+        writer.write(attachment.isGeneralLayout);
+    }
+    const auto &ds = pso.depthStencilAttachment;
+    writer.write(ds.format);
+    writer.write(ds.sampleCount);
+    writer.write(ds.depthLoadOp);
+    writer.write(ds.depthStoreOp);
+    writer.write(ds.stencilLoadOp);
+    writer.write(ds.stencilStoreOp);
+    writer.write(ds.isGeneralLayout);
+
+    writer.write(static_cast<uint32_t>(pso.subpasses.size()));
+    for (const auto &subpass : pso.subpasses) {
+        writer.write(subpass.inputs);
+        writer.write(subpass.colors);
+        writer.write(subpass.resolves);
+        writer.write(subpass.preserves);
+        writer.write(subpass.depthStencil);
+        writer.write(subpass.depthStencilResolve);
+        writer.write(subpass.depthResolveMode);
+        writer.write(subpass.stencilResolveMode);
+    }
+
+    writer.write(pso.rasterizerState);
+    writer.write(pso.depthStencilState);
+    writer.write(pso.blendState.isA2C);
+    writer.write(pso.blendState.isIndepend);
+    writer.write(pso.blendState.blendColor);
+    writer.write(static_cast<uint32_t>(pso.blendState.targets.size()));
+    for (const auto &target : pso.blendState.targets) {
+        writer.write(target);
+    }
+    writer.write(pso.primitive);
+    writer.write(pso.dynamicStates);
+}
+
+bool readPipelineState(ManifestReader &reader, PipelineStateRecord &pso) {
+    uint32_t count = 0;
+    if (!reader.read(pso.shader) || !reader.read(pso.subpass) || !reader.read(pso.passHash) || !reader.read(pso.attributesHash)) {
+        return false;
+    }
+
+    if (!reader.readCount(count, sizeof(uint32_t) * 4)) return false;
+    pso.attributes.resize(count);
+    for (auto &attribute : pso.attributes) {
+        uint8_t isNormalized = 0;
+        uint8_t isInstanced  = 0;
+        if (!reader.read(attribute.name) || !reader.read(attribute.format) || !reader.read(isNormalized) ||
+            !reader.read(attribute.stream) || !reader.read(isInstanced) || !reader.read(attribute.location)) {
+            return false;
+        }
+        attribute.isNormalized = isNormalized != 0;
+        attribute.isInstanced  = isInstanced != 0;
+    }
+
+    if (!reader.readCount(count, sizeof(uint32_t) * 5)) return false;
+    pso.colorAttachments.resize(count);
+    for (auto &attachment : pso.colorAttachments) {
+        if (!reader.read(attachment.format) || !reader.read(attachment.sampleCount) || !reader.read(attachment.loadOp) ||
+            !reader.read(attachment.storeOp) || !reader.read(attachment.isGeneralLayout)) {
+            return false;
+        }
+    }
+    auto &ds = pso.depthStencilAttachment;
+    if (!reader.read(ds.format) || !reader.read(ds.sampleCount) || !reader.read(ds.depthLoadOp) || !reader.read(ds.depthStoreOp) ||
+        !reader.read(ds.stencilLoadOp) || !reader.read(ds.stencilStoreOp) || !reader.read(ds.isGeneralLayout)) {
+        return false;
+    }
+
+    if (!reader.readCount(count, sizeof(uint32_t) * 8)) return false;
+    pso.subpasses.resize(count);
+    for (auto &subpass : pso.subpasses) {
+        if (!reader.read(subpass.inputs) || !reader.read(subpass.colors) || !reader.read(subpass.resolves) ||
+            !reader.read(subpass.preserves) || !reader.read(subpass.depthStencil) || !reader.read(subpass.depthStencilResolve) ||
+            !reader.read(subpass.depthResolveMode) || !reader.read(subpass.stencilResolveMode)) {
+            return false;
+        }
+    }
+
+    if (!reader.read(pso.rasterizerState) || !reader.read(pso.depthStencilState) || !reader.read(pso.blendState.isA2C) ||
+        !reader.read(pso.blendState.isIndepend) || !reader.read(pso.blendState.blendColor) ||
+        !reader.readCount(count, sizeof(gfx::BlendTarget))) {
+        return false;
+    }
+    pso.blendState.targets.resize(count);
+    for (auto &target : pso.blendState.targets) {
+        if (!reader.read(target)) return false;
+    }
+    return reader.read(pso.primitive) && reader.read(pso.dynamicStates);
+}
+} // namespace
+
+void PipelineStateManifest::addShader(const gfx::Shader *shader, const ccstd::string &key, const ccstd::string &program, const MacroRecord &defines) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto                        it = _shaderKeys.find(key);
+    if (it == _shaderKeys.end()) {
+        it = _shaderKeys.emplace(key, static_cast<uint32_t>(_shaders.size())).first;
+        _shaders.push_back({program, defines});
+    }
+    // shader objects may be recycled, the latest request wins
+    _shaderIndices[shader] = it->second;
+}
+
+void PipelineStateManifest::addPipelineState(const scene::Pass *pass, const gfx::Shader *shader, const gfx::InputAssembler *inputAssembler,
+                                             const gfx::RenderPass *renderPass, uint32_t subpass) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto                  itShader = _shaderIndices.find(shader);
+    if (itShader == _shaderIndices.end()) {
+        return; // requested before recording started
+    }
+
+    PipelineStateRecord pso;
+    pso.shader                 = itShader->second;
+    pso.subpass                = subpass;
+    pso.passHash               = pass->getHash();
+    pso.attributesHash         = inputAssembler->getAttributesHash();
+    pso.attributes             = inputAssembler->getAttributes();
+    pso.colorAttachments       = renderPass->getColorAttachments();
+    pso.depthStencilAttachment = renderPass->getDepthStencilAttachment();
+    pso.subpasses              = renderPass->getSubpasses();
+    pso.rasterizerState        = *pass->getRasterizerState();
+    pso.depthStencilState      = *pass->getDepthStencilState();
+    pso.blendState             = *pass->getBlendState();
+    pso.primitive              = pass->getPrimitive();
+    pso.dynamicStates          = pass->getDynamicStates();
+
+    const uint64_t hash = PipelineStateManager::computeHash(pso.passHash, renderPass->getHash(), pso.attributesHash, pso.shader, subpass);
+    if (_pipelineStateHashes.emplace(hash, static_cast<uint32_t>(_pipelineStates.size())).second) {
+        _pipelineStates.emplace_back(std::move(pso));
+    }
+}
+
+void PipelineStateManifest::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shaders.clear();
+    _pipelineStates.clear();
+    _shaderKeys.clear();
+    _shaderIndices.clear();
+    _pipelineStateHashes.clear();
+}
+
+void PipelineStateManifest::serialize(ccstd::vector<uint8_t> &data) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ManifestWriter              writer(data);
+    writer.write(MANIFEST_MAGIC);
+    writer.write(MANIFEST_VERSION);
+    writer.write(static_cast<uint32_t>(_shaders.size()));
+    for (const auto &shader : _shaders) {
+        writeShader(writer, shader);
+    }
+    writer.write(static_cast<uint32_t>(_pipelineStates.size()));
+    for (const auto &pso : _pipelineStates) {
+        writePipelineState(writer, pso);
+    }
+}
+
+bool PipelineStateManifest::deserialize(const uint8_t *data, size_t size) {
+    clear();
+
+    ManifestReader reader(data, size);
+    uint32_t       magic   = 0;
+    uint32_t       version = 0;
+    uint32_t       count   = 0;
+    if (!reader.read(magic) || !reader.read(version) || magic != MANIFEST_MAGIC || version != MANIFEST_VERSION) {
+        CC_LOG_WARNING("Invalid or outdated pipeline state manifest");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    bool                        succeeded = reader.readCount(count, sizeof(uint32_t) * 2);
+    _shaders.resize(succeeded ? count : 0);
+    for (uint32_t i = 0; succeeded && i < count; ++i) {
+        succeeded = readShader(reader, _shaders[i]);
+    }
+    succeeded = succeeded && reader.readCount(count, sizeof(uint32_t) * 8);
+    _pipelineStates.resize(succeeded ? count : 0);
+    for (uint32_t i = 0; succeeded && i < count; ++i) {
+        succeeded = readPipelineState(reader, _pipelineStates[i]) && _pipelineStates[i].shader < _shaders.size();
+    }
+
+    if (!succeeded || !reader.isEnd()) {
+        CC_LOG_WARNING("Corrupted pipeline state manifest");
+        _shaders.clear();
+        _pipelineStates.clear();
+        return false;
+    }
+    return true;
+}
+
+bool PipelineStateManifest::save(const ccstd::string &path) const {
+    ccstd::vector<uint8_t> bytes;
+    serialize(bytes);
+
+    Data data;
+    data.copy(bytes.data(), static_cast<ssize_t>(bytes.size()));
+    return FileUtils::getInstance()->writeDataToFile(data, path);
+}
+
+bool PipelineStateManifest::load(const ccstd::string &path) {
+    const Data data = FileUtils::getInstance()->getDataFromFile(path);
+    if (data.isNull()) {
+        return false;
+    }
+    return deserialize(data.getBytes(), static_cast<size_t>(data.getSize()));
+}
+
+PipelineStatePrewarmer::PipelineStatePrewarmer(const PipelineStateManifest &manifest, render::PipelineRuntime *pipeline, ProgressCallback callback)
+: _shaders(manifest.getShaders()),
+  _pipelineStates(manifest.getPipelineStates()),
+  _pipeline(pipeline),
+  _callback(std::move(callback)) {
+    _compiledShaders.resize(_shaders.size(), nullptr);
+}
+
+bool PipelineStatePrewarmer::update(uint32_t maxCount) {
+    auto *const device      = gfx::Device::getInstance();
+    auto *const programLib  = ProgramLib::getInstance();
+    const auto  total       = getTotal();
+    const auto  shaderCount = static_cast<uint32_t>(_shaders.size());
+
+    for (uint32_t count = 0; count < maxCount && _done < total; ++count, ++_done) {
+        if (_done < shaderCount) {
+            auto &shader = _shaders[_done];
+            if (programLib->hasProgram(shader.program)) {
+                _compiledShaders[_done] = programLib->compileGFXShader(device, shader.program, shader.defines, _pipeline);
+            }
+            continue;
+        }
+
+        const auto &pso    = _pipelineStates[_done - shaderCount];
+        auto *      shader = _compiledShaders[pso.shader];
+        if (shader) {
+            auto *pipelineLayout = programLib->getTemplateInfo(_shaders[pso.shader].program)->pipelineLayout.get();
+            PipelineStateManager::prewarmPipelineState(pso, shader, pipelineLayout);
+        }
+    }
+
+    if (_callback) {
+        _callback(_done, total);
+    }
+    return isFinished();
+}
+
+} // namespace pipeline
+} // namespace cc
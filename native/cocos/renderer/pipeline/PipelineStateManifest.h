@@ -0,0 +1,141 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include "base/Macros.h"
+#include "base/std/container/string.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "gfx-base/GFXDef-common.h"
+#include "renderer/core/PassUtils.h"
+
+namespace cc {
+namespace scene {
+class Pass;
+}
+namespace render {
+class PipelineRuntime;
+}
+namespace pipeline {
+
+struct ShaderVariantRecord {
+    ccstd::string program;
+    MacroRecord   defines;
+};
+
+struct PipelineStateRecord {
+    uint32_t                    shader{0}; // index of the shader variant in the manifest
+    uint32_t                    subpass{0};
+    uint64_t                    passHash{0};
+    uint64_t                    attributesHash{0};
+    gfx::AttributeList          attributes;
+    gfx::ColorAttachmentList    colorAttachments;
+    gfx::DepthStencilAttachment depthStencilAttachment;
+    gfx::SubpassInfoList        subpasses;
+    gfx::RasterizerState        rasterizerState;
+    gfx::DepthStencilState      depthStencilState;
+    gfx::BlendState             blendState;
+    gfx::PrimitiveMode          primitive{gfx::PrimitiveMode::TRIANGLE_LIST};
+    gfx::DynamicStateFlags      dynamicStates{gfx::DynamicStateFlagBit::NONE};
+};
+
+/**
+ * @en The shader variants and pipeline states used in a session, recorded by ProgramLib and PipelineStateManager
+ * while the manifest is set as the recording target, see ProgramLib::setRecordingManifest.
+ * Recording should start before any content is loaded, states created before that are not recorded.
+ * The manifest is saved in a compact binary format and consumed by PipelineStatePrewarmer.
+ * @zh 一次运行中用到的着色器变体和管线状态，清单被设为记录目标期间由 ProgramLib 和 PipelineStateManager 记录，
+ * 参见 ProgramLib::setRecordingManifest。应当在加载任何内容之前开始记录，在此之前创建的状态不会被记录。
+ * 清单以紧凑的二进制格式保存，由 PipelineStatePrewarmer 使用。
+ */
+class CC_DLL PipelineStateManifest final {
+public:
+    PipelineStateManifest()  = default;
+    ~PipelineStateManifest() = default;
+
+    // thread safe, pipeline states may be created while render queues are recorded on job threads
+    void addShader(const gfx::Shader *shader, const ccstd::string &key, const ccstd::string &program, const MacroRecord &defines);
+    void addPipelineState(const scene::Pass *pass, const gfx::Shader *shader, const gfx::InputAssembler *inputAssembler,
+                          const gfx::RenderPass *renderPass, uint32_t subpass);
+    void clear();
+
+    inline const ccstd::vector<ShaderVariantRecord> &getShaders() const { return _shaders; }
+    inline const ccstd::vector<PipelineStateRecord> &getPipelineStates() const { return _pipelineStates; }
+
+    void serialize(ccstd::vector<uint8_t> &data) const;
+    bool deserialize(const uint8_t *data, size_t size);
+
+    bool save(const ccstd::string &path) const;
+    bool load(const ccstd::string &path);
+
+private:
+    ccstd::vector<ShaderVariantRecord>                  _shaders;
+    ccstd::vector<PipelineStateRecord>                  _pipelineStates;
+    ccstd::unordered_map<ccstd::string, uint32_t>       _shaderKeys;
+    ccstd::unordered_map<const gfx::Shader *, uint32_t> _shaderIndices;
+    ccstd::unordered_map<uint64_t, uint32_t>            _pipelineStateHashes;
+    mutable std::mutex                                  _mutex;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PipelineStateManifest);
+};
+
+/**
+ * @en Compiles the shader variants and creates the pipeline states of a manifest ahead of time, e.g. during a loading screen.
+ * The work is spread over frames: each update creates at most maxCount objects, the device thread compiles them
+ * in the background when the device runs in multithreaded mode. Entries of effects which are not registered are skipped.
+ * @zh 提前编译清单中的着色器变体并创建管线状态，例如在加载界面期间。
+ * 工作分散在多帧中完成：每次 update 最多创建 maxCount 个对象，设备以多线程模式运行时由设备线程在后台编译。
+ * 未注册的 effect 对应的条目会被跳过。
+ */
+class CC_DLL PipelineStatePrewarmer final {
+public:
+    using ProgressCallback = std::function<void(uint32_t done, uint32_t total)>;
+
+    PipelineStatePrewarmer(const PipelineStateManifest &manifest, render::PipelineRuntime *pipeline, ProgressCallback callback = nullptr);
+    ~PipelineStatePrewarmer() = default;
+
+    // returns true once all entries are done
+    bool update(uint32_t maxCount = 8);
+
+    inline bool     isFinished() const { return _done == getTotal(); }
+    inline uint32_t getDone() const { return _done; }
+    inline uint32_t getTotal() const { return static_cast<uint32_t>(_shaders.size() + _pipelineStates.size()); }
+
+private:
+    ccstd::vector<ShaderVariantRecord> _shaders;
+    ccstd::vector<PipelineStateRecord> _pipelineStates;
+    ccstd::vector<gfx::Shader *>       _compiledShaders;
+    render::PipelineRuntime *          _pipeline{nullptr};
+    ProgressCallback                   _callback;
+    uint32_t                           _done{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(PipelineStatePrewarmer);
+};
+
+} // namespace pipeline
+} // namespace cc
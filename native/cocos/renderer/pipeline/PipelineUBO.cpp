@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "PipelineUBO.h"
+#include "BindlessTextureTable.h"
 #include "GlobalDescriptorSetManager.h"
 #include "PipelineSceneData.h"
 #include "RenderPipeline.h"
@@ -32,6 +33,8 @@
 #include "core/Root.h"
 #include "forward/ForwardPipeline.h"
 #include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXUniformRingBuffer.h"
+#include "scene/Ambient.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/Fog.h"
@@ -164,6 +167,14 @@ void PipelineUBO::updateCameraUBOView(const RenderPipeline *pipeline, float *out
 
     output[UBOCamera::SURFACE_TRANSFORM_OFFSET + 0] = static_cast<float>(camera->getSurfaceTransform());
 
+    // indexed by the view being rendered in multiview passes
+    for (uint32_t i = 0; i < camera->getViewCount(); ++i) {
+        memcpy(output + UBOCamera::MAT_VIEWS_OFFSET + i * 16, camera->getViewMatView(i).m, sizeof(cc::Mat4));
+        memcpy(output + UBOCamera::MAT_PROJS_OFFSET + i * 16, camera->getViewMatProj(i).m, sizeof(cc::Mat4));
+        memcpy(output + UBOCamera::MAT_VIEW_PROJS_OFFSET + i * 16, camera->getViewMatViewProj(i).m, sizeof(cc::Mat4));
+        TO_VEC3(output, camera->getViewPosition(i), UBOCamera::CAMERA_POSITIONS_OFFSET + i * 4);
+    }
+
     if (fog != nullptr) {
         const auto &colorTempRGB                       = fog->getColorArray();
         output[UBOCamera::GLOBAL_FOG_COLOR_OFFSET]     = colorTempRGB.x;
@@ -346,17 +357,10 @@ void PipelineUBO::activate(gfx::Device *device, RenderPipeline *pipeline) {
 
     _alignedCameraUBOSize = utils::alignTo(UBOCamera::SIZE, _device->getCapabilities().uboOffsetAlignment);
 
-    _cameraBuffer = _device->createBuffer({
-        gfx::BufferUsageBit::UNIFORM | gfx::BufferUsageBit::TRANSFER_DST,
-        gfx::MemoryUsageBit::HOST | gfx::MemoryUsageBit::DEVICE,
-        _alignedCameraUBOSize,
-        _alignedCameraUBOSize,
-    });
-    _ubos.push_back(_cameraBuffer);
-    _cameraUBOs.resize(_alignedCameraUBOSize / sizeof(float));
+    _cameraUBORing = CC_NEW(gfx::UniformRingBuffer(_device, _alignedCameraUBOSize));
 
     auto *cameraUBO = _device->createBuffer({
-        _cameraBuffer,
+        _cameraUBORing->getBuffer(),
         0,
         UBOCamera::SIZE,
     });
@@ -379,6 +383,7 @@ void PipelineUBO::destroy() {
         CC_SAFE_DESTROY_AND_DELETE(ubo)
     }
     _ubos.clear();
+    CC_SAFE_DELETE(_cameraUBORing);
 }
 
 void PipelineUBO::updateGlobalUBO(const scene::Camera *camera) {
@@ -390,29 +395,74 @@ void PipelineUBO::updateGlobalUBO(const scene::Camera *camera) {
 
     globalDSManager->bindBuffer(UBOGlobal::BINDING, ds->getBuffer(UBOGlobal::BINDING));
     globalDSManager->update();
+    if (auto *bindlessTextureTable = globalDSManager->getBindlessTextureTable()) {
+        bindlessTextureTable->nextFrame();
+    }
 }
 
-void PipelineUBO::updateCameraUBO(const scene::Camera *camera) {
-    auto *const cmdBuffer = _pipeline->getCommandBuffers()[0];
-    PipelineUBO::updateCameraUBOView(_pipeline, _cameraUBOs.data(), camera);
-    cmdBuffer->updateBuffer(_cameraBuffer, _cameraUBOs.data());
+bool PipelineUBO::CameraUBOKey::operator==(const CameraUBOKey &rhs) const {
+    return camera == rhs.camera && mainLight == rhs.mainLight &&
+           cameraVersion == rhs.cameraVersion && mainLightVersion == rhs.mainLightVersion &&
+           ambientVersion == rhs.ambientVersion && fogVersion == rhs.fogVersion &&
+           shadowsVersion == rhs.shadowsVersion && shadingScale == rhs.shadingScale && isHDR == rhs.isHDR;
 }
 
-void PipelineUBO::updateMultiCameraUBO(const ccstd::vector<scene::Camera *> &cameras) {
-    const auto cameraCount  = cameras.size();
-    const auto totalUboSize = static_cast<uint>(_alignedCameraUBOSize * cameraCount);
+bool PipelineUBO::ShadowUBOKey::operator==(const ShadowUBOKey &rhs) const {
+    return valid && rhs.valid && mainLight == rhs.mainLight &&
+           mainLightVersion == rhs.mainLightVersion && shadowsVersion == rhs.shadowsVersion;
+}
 
-    if (_cameraBuffer->getSize() < totalUboSize) {
-        _cameraBuffer->resize(totalUboSize);
-        _cameraUBOs.resize(totalUboSize / sizeof(float));
+PipelineUBO::CameraUBOKey PipelineUBO::getCameraUBOKey(const scene::Camera *camera) const {
+    const auto *sceneData = _pipeline->getPipelineSceneData();
+    const auto *ambient   = sceneData->getAmbient();
+    const auto *fog       = sceneData->getFog();
+    const auto *shadows   = sceneData->getShadows();
+
+    CameraUBOKey key;
+    key.camera           = camera;
+    key.mainLight        = camera->getScene()->getMainLight();
+    key.cameraVersion    = camera->getVersion();
+    key.mainLightVersion = key.mainLight ? key.mainLight->getVersion() : 0;
+    key.ambientVersion   = ambient ? ambient->getVersion() : 0;
+    key.fogVersion       = fog ? fog->getVersion() : 0;
+    key.shadowsVersion   = shadows ? shadows->getVersion() : 0;
+    key.shadingScale     = sceneData->getShadingScale();
+    key.isHDR            = sceneData->isHDR();
+    return key;
+}
+
+bool PipelineUBO::updateCameraUBOSlot(uint32_t slot, const scene::Camera *camera) {
+    // the ring keeps its data across frames and hands out the same offsets in the same order,
+    // so a slot built from the same inputs last frame is still valid
+    const auto slice = _cameraUBORing->allocate(UBOCamera::SIZE);
+    const auto key   = getCameraUBOKey(camera);
+    if (slot >= _cameraUBOKeys.size()) {
+        _cameraUBOKeys.resize(slot + 1);
+    } else if (_cameraUBOKeys[slot] == key) {
+        return false;
     }
+    _cameraUBOKeys[slot] = key;
+    PipelineUBO::updateCameraUBOView(_pipeline, reinterpret_cast<float *>(slice.data), camera);
+    return true;
+}
 
-    for (uint cameraIdx = 0; cameraIdx < cameraCount; ++cameraIdx) {
-        const auto *camera = cameras[cameraIdx];
-        const auto  offset = cameraIdx * _alignedCameraUBOSize / sizeof(float);
-        PipelineUBO::updateCameraUBOView(_pipeline, &_cameraUBOs[offset], camera);
+void PipelineUBO::updateCameraUBO(const scene::Camera *camera) {
+    _cameraUBORing->reset();
+    if (updateCameraUBOSlot(0, camera)) {
+        _cameraUBORing->flush();
+    }
+}
+
+void PipelineUBO::updateMultiCameraUBO(const ccstd::vector<scene::Camera *> &cameras) {
+    // slices are aligned the same way as _alignedCameraUBOSize, so the offset of each camera matches incCameraUBOOffset
+    _cameraUBORing->reset();
+    bool dirty = false;
+    for (uint32_t i = 0; i < cameras.size(); ++i) {
+        dirty |= updateCameraUBOSlot(i, cameras[i]);
+    }
+    if (dirty) {
+        _cameraUBORing->flush();
     }
-    _cameraBuffer->update(_cameraUBOs.data());
 
     _currentCameraUBOOffset = 0;
 }
@@ -437,19 +487,34 @@ void PipelineUBO::updateShadowUBO(const scene::Camera *camera) {
             }
         }
     }
-    PipelineUBO::updateShadowUBOView(_pipeline, &_shadowUBO, camera);
     ds->update();
+
+    ShadowUBOKey key;
+    key.mainLight        = mainLight;
+    key.mainLightVersion = mainLight ? mainLight->getVersion() : 0;
+    key.shadowsVersion   = shadowInfo->getVersion();
+    key.valid            = true;
+    if (_shadowUBOKey == key) {
+        return;
+    }
+    _shadowUBOKey = key;
+    PipelineUBO::updateShadowUBOView(_pipeline, &_shadowUBO, camera);
     cmdBuffer->updateBuffer(ds->getBuffer(UBOShadow::BINDING), _shadowUBO.data(), UBOShadow::SIZE);
 }
 
 void PipelineUBO::updateShadowUBOLight(gfx::DescriptorSet *globalDS, const scene::Light *light) {
     auto *const cmdBuffer = _pipeline->getCommandBuffers()[0];
+    if (globalDS->getBuffer(UBOShadow::BINDING) == _pipeline->getDescriptorSet()->getBuffer(UBOShadow::BINDING)) {
+        // the buffer no longer holds the data of updateShadowUBO
+        _shadowUBOKey.valid = false;
+    }
     PipelineUBO::updateShadowUBOLightView(_pipeline, &_shadowUBO, light);
     globalDS->update();
     cmdBuffer->updateBuffer(globalDS->getBuffer(UBOShadow::BINDING), _shadowUBO.data(), UBOShadow::SIZE);
 }
 
 void PipelineUBO::updateShadowUBORange(uint offset, const Mat4 *data) {
+    _shadowUBOKey.valid = false;
     memcpy(_shadowUBO.data() + offset, data->m, sizeof(*data));
 }
 
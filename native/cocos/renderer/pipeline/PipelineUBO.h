@@ -27,11 +27,16 @@
 
 #include "Define.h"
 #include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 class Mat4;
 namespace scene {
 class Camera;
+class DirectionalLight;
+} // namespace scene
+namespace gfx {
+class UniformRingBuffer;
 }
 namespace pipeline {
 class RenderPipeline;
@@ -58,6 +63,34 @@ public:
     void incCameraUBOOffset();
 
 private:
+    // versions of the inputs a uniform block was last built from, the block is rebuilt only when one of them changes
+    struct CameraUBOKey {
+        const scene::Camera *          camera{nullptr};
+        const scene::DirectionalLight *mainLight{nullptr};
+        uint32_t                       cameraVersion{0};
+        uint32_t                       mainLightVersion{0};
+        uint32_t                       ambientVersion{0};
+        uint32_t                       fogVersion{0};
+        uint32_t                       shadowsVersion{0};
+        float                          shadingScale{0.F};
+        bool                           isHDR{false};
+
+        bool operator==(const CameraUBOKey &rhs) const;
+        bool operator!=(const CameraUBOKey &rhs) const { return !(*this == rhs); }
+    };
+    struct ShadowUBOKey {
+        const scene::DirectionalLight *mainLight{nullptr};
+        uint32_t                       mainLightVersion{0};
+        uint32_t                       shadowsVersion{0};
+        bool                           valid{false};
+
+        bool operator==(const ShadowUBOKey &rhs) const;
+        bool operator!=(const ShadowUBOKey &rhs) const { return !(*this == rhs); }
+    };
+
+    CameraUBOKey getCameraUBOKey(const scene::Camera *camera) const;
+    bool         updateCameraUBOSlot(uint32_t slot, const scene::Camera *camera);
+
     RenderPipeline *_pipeline = nullptr;
     gfx::Device *   _device   = nullptr;
 
@@ -66,10 +99,11 @@ private:
 
     ccstd::vector<gfx::Buffer *> _ubos;
     void                         initCombineSignY();
-    ccstd::vector<float>         _cameraUBOs;
-    gfx::Buffer *                _cameraBuffer{nullptr};
+    gfx::UniformRingBuffer *     _cameraUBORing{nullptr}; // one slice per camera, see incCameraUBOOffset
     uint                         _currentCameraUBOOffset{0};
     uint                         _alignedCameraUBOSize{0};
+    ccstd::vector<CameraUBOKey>  _cameraUBOKeys; // one per ring slice
+    ShadowUBOKey                 _shadowUBOKey;
 };
 
 } // namespace pipeline
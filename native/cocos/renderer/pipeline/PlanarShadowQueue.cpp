@@ -34,6 +34,7 @@
 #include "RenderPipeline.h"
 #include "core/geometry/AABB.h"
 #include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXShader.h"
 #include "scene/Camera.h"
 #include "scene/Model.h"
 #include "scene/RenderScene.h"
@@ -41,6 +42,23 @@
 
 namespace cc {
 namespace pipeline {
+namespace {
+const ccstd::array<ccstd::string, 3> INST_MAT_WORLD = {"a_matWorld0", "a_matWorld1", "a_matWorld2"};
+
+// true if the world matrix rows are the only per-instance attributes of the shader
+bool getWorldMatrixAttributes(const gfx::Shader *shader, ccstd::vector<gfx::Attribute> &attributes) {
+    attributes.clear();
+    if (!shader) return false;
+    for (const auto &attribute : shader->getAttributes()) {
+        if (!attribute.isInstanced) continue;
+        if (attributes.size() == INST_MAT_WORLD.size() || attribute.name != INST_MAT_WORLD[attributes.size()] || attribute.format != gfx::Format::RGBA32F) {
+            return false;
+        }
+        attributes.emplace_back(attribute);
+    }
+    return attributes.size() == INST_MAT_WORLD.size();
+}
+} // namespace
 
 PlanarShadowQueue::PlanarShadowQueue(RenderPipeline *pipeline)
 : _pipeline(pipeline) {
@@ -93,7 +111,7 @@ void PlanarShadowQueue::gatherShadowPasses(scene::Camera *camera, gfx::CommandBu
                 _instancedQueue->add(instancedBuffer);
                 ++i;
             }
-        } else {
+        } else if (!mergeWorldMatrixInstances(model, instancedBuffer)) {
             _pendingModels.emplace_back(model);
         }
     }
@@ -101,6 +119,27 @@ void PlanarShadowQueue::gatherShadowPasses(scene::Camera *camera, gfx::CommandBu
     _instancedQueue->uploadBuffers(cmdBuffer);
 }
 
+bool PlanarShadowQueue::mergeWorldMatrixInstances(const scene::Model *model, InstancedBuffer *instancedBuffer) {
+    // skinned models keep their joints in the local descriptor set, which can't be shared between instances
+    if (model->getType() != scene::Model::Type::DEFAULT) return false;
+
+    const auto &subModels = model->getSubModels();
+    for (const auto &subModel : subModels) {
+        if (!getWorldMatrixAttributes(subModel->getPlanarInstanceShader(), _worldMatrixAttributes)) return false;
+    }
+
+    // same layout as Model::uploadMat4AsVec4x3
+    const auto &                  m    = model->getTransform()->getWorldMatrix().m;
+    const ccstd::array<float, 12> data = {m[0], m[1], m[2], m[12], m[4], m[5], m[6], m[13], m[8], m[9], m[10], m[14]};
+    for (const auto &subModel : subModels) {
+        auto *shader = subModel->getPlanarInstanceShader();
+        getWorldMatrixAttributes(shader, _worldMatrixAttributes);
+        instancedBuffer->merge(subModel, _worldMatrixAttributes, reinterpret_cast<const uint8_t *>(data.data()), sizeof(data), shader);
+        _instancedQueue->add(instancedBuffer);
+    }
+    return true;
+}
+
 void PlanarShadowQueue::clear() {
     _castModels.clear();
     _pendingModels.clear();
@@ -130,7 +169,7 @@ void PlanarShadowQueue::recordCommandBuffer(gfx::Device *device, gfx::RenderPass
             auto *const pso    = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
 
             cmdBuffer->bindPipelineState(pso);
-            cmdBuffer->bindDescriptorSet(localSet, subModel->getDescriptorSet());
+            cmdBuffer->bindDescriptorSet(localSet, subModel->getDrawDescriptorSet());
             cmdBuffer->bindInputAssembler(ia);
             cmdBuffer->draw(ia);
         }
@@ -38,7 +38,7 @@ class Shader;
 } // namespace gfx
 namespace pipeline {
 class RenderPipeline;
-class InstanceBuffer;
+class InstancedBuffer;
 class RenderInstancedQueue;
 class RenderBatchedQueue;
 
@@ -53,10 +53,13 @@ public:
     void destroy();
 
 private:
+    bool mergeWorldMatrixInstances(const scene::Model *model, InstancedBuffer *instancedBuffer);
+
     RenderPipeline *                    _pipeline       = nullptr;
     RenderInstancedQueue *              _instancedQueue = nullptr;
     ccstd::vector<const scene::Model *> _castModels;
     ccstd::vector<const scene::Model *> _pendingModels;
+    ccstd::vector<gfx::Attribute>       _worldMatrixAttributes;
 };
 } // namespace pipeline
 } // namespace cc
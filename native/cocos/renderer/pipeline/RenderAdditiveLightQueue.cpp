@@ -23,6 +23,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <algorithm>
 #include "base/std/container/array.h"
 
 #include "BatchedBuffer.h"
@@ -36,10 +37,13 @@
 #include "RenderBatchedQueue.h"
 #include "RenderInstancedQueue.h"
 #include "SceneCulling.h"
+#include "shadow/ShadowAtlas.h"
 #include "base/Utils.h"
 #include "core/geometry/Sphere.h"
 #include "forward/ForwardPipeline.h"
 #include "gfx-base/GFXDevice.h"
+#include "profiler/Profiler.h"
+#include "renderer/core/ProgramLib.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/Light.h"
@@ -80,27 +84,40 @@ RenderAdditiveLightQueue ::~RenderAdditiveLightQueue() {
 }
 
 void RenderAdditiveLightQueue::recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
+    const bool clustered = _pipeline->isClusterEnabled();
+    if (clustered && !_clusterBuffersBound) return;
+
     _instancedQueue->recordCommandBuffer(device, renderPass, cmdBuffer);
     _batchedQueue->recordCommandBuffer(device, renderPass, cmdBuffer);
     const bool enableOcclusionQuery = _pipeline->isOcclusionQueryEnabled();
     const auto offset               = _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset();
 
-    for (const auto &lightPass : _lightPasses) {
-        const auto *const subModel = lightPass.subModel;
+    for (uint32_t passIdx = 0; passIdx < _lightPassCount; ++passIdx) {
+        const auto &      lightPass = _lightPasses[passIdx];
+        const auto *const subModel  = lightPass.subModel;
 
         if (!enableOcclusionQuery || !_pipeline->isOccluded(camera, subModel)) {
             const auto *pass           = lightPass.pass;
             const auto &dynamicOffsets = lightPass.dynamicOffsets;
             auto *      shader         = lightPass.shader;
-            const auto  lights         = lightPass.lights;
+            const auto &lights         = lightPass.lights;
             auto *      ia             = subModel->getInputAssembler();
             auto *      pso            = PipelineStateManager::getOrCreatePipelineState(pass, shader, ia, renderPass);
-            auto *      descriptorSet  = subModel->getDescriptorSet();
+            auto *      descriptorSet  = subModel->getDrawDescriptorSet();
 
             cmdBuffer->bindPipelineState(pso);
             cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
             cmdBuffer->bindInputAssembler(ia);
 
+            if (clustered) {
+                // all the lights of the fragment's cluster are shaded in one draw
+                _dynamicOffsets[0] = 0;
+                cmdBuffer->bindDescriptorSet(globalSet, _pipeline->getDescriptorSet(), 1, &offset);
+                cmdBuffer->bindDescriptorSet(localSet, descriptorSet, _dynamicOffsets);
+                cmdBuffer->draw(ia);
+                continue;
+            }
+
             for (size_t i = 0; i < dynamicOffsets.size(); ++i) {
                 const auto light               = lights[i];
                 auto *     globalDescriptorSet = _pipeline->getGlobalDSManager()->getOrCreateDescriptorSet(light);
@@ -122,8 +139,13 @@ void RenderAdditiveLightQueue::gatherLightPasses(const scene::Camera *camera, gf
 
     if (_validPunctualLights.empty()) return;
 
-    updateUBOs(camera, cmdBuffer);
-    updateLightDescriptorSet(camera, cmdBuffer);
+    // forward+ reads the light lists uploaded once by ClusterLightCulling, models are still culled to skip the unlit ones
+    const bool clustered = _pipeline->isClusterEnabled();
+    if (!clustered) {
+        updateUBOs(camera, cmdBuffer);
+        updateLightDescriptorSet(camera, cmdBuffer);
+    }
+    mapLightGridSlots(camera);
 
     const auto &renderObjects = _pipeline->getPipelineSceneData()->getRenderObjects();
     for (const auto &renderObject : renderObjects) {
@@ -148,24 +170,61 @@ void RenderAdditiveLightQueue::gatherLightPasses(const scene::Camera *camera, gf
             descriptorSet->bindBuffer(UBOForwardLight::BINDING, _firstLightBufferView);
             descriptorSet->update();
 
-            addRenderQueue(pass, subModel, model, lightPassIdx);
+            if (clustered) {
+                addClusterRenderQueue(pass, subModel, model, lightPassIdx);
+            } else {
+                addRenderQueue(pass, subModel, model, lightPassIdx);
+            }
 
             ++i;
         }
     }
     _instancedQueue->uploadBuffers(cmdBuffer);
     _batchedQueue->uploadBuffers(cmdBuffer);
+    CC_PROFILE_RENDER_UPDATE(AdditiveLightTests, _lightTestCount);
+}
+
+void RenderAdditiveLightQueue::bindClusterBuffers(gfx::Buffer *lightBuffer, gfx::Buffer *lightIndexBuffer, gfx::Buffer *lightGridBuffer) {
+    _clusterBuffersBound = lightBuffer && lightIndexBuffer && lightGridBuffer;
+    if (!_clusterBuffersBound) return;
+
+    // binding numbers differ between effects, look them up by name
+    for (const auto *pass : _clusterPasses) {
+        auto *descriptorSet = pass->getDescriptorSet();
+        for (const auto &buffer : pass->getShaderInfo()->buffers) {
+            if (buffer.name == "b_ccLightsBuffer") {
+                descriptorSet->bindBuffer(buffer.binding, lightBuffer);
+            } else if (buffer.name == "b_clusterLightIndicesBuffer") {
+                descriptorSet->bindBuffer(buffer.binding, lightIndexBuffer);
+            } else if (buffer.name == "b_clusterLightGridBuffer") {
+                descriptorSet->bindBuffer(buffer.binding, lightGridBuffer);
+            }
+        }
+        descriptorSet->update();
+    }
 }
 
 void RenderAdditiveLightQueue::clear() {
     _instancedQueue->clear();
     _batchedQueue->clear();
+    _clusterPasses.clear();
+    _clusterBuffersBound = false;
 
-    for (auto lightPass : _lightPasses) {
-        lightPass.dynamicOffsets.clear();
-        lightPass.lights.clear();
+    // the passes are kept with the capacity of their vectors, see addLightPass
+    _lightPassCount = 0;
+}
+
+AdditiveLightPass &RenderAdditiveLightQueue::addLightPass(const scene::Pass *pass, const scene::SubModel *subModel, gfx::Shader *shader) {
+    if (_lightPassCount == _lightPasses.size()) {
+        _lightPasses.emplace_back();
     }
-    _lightPasses.clear();
+    auto &lightPass    = _lightPasses[_lightPassCount++];
+    lightPass.subModel = subModel;
+    lightPass.pass     = pass;
+    lightPass.shader   = shader;
+    lightPass.dynamicOffsets.clear();
+    lightPass.lights.clear();
+    return lightPass;
 }
 
 bool RenderAdditiveLightQueue::cullSphereLight(const scene::SphereLight *light, const scene::Model *model) {
@@ -192,20 +251,38 @@ void RenderAdditiveLightQueue::addRenderQueue(const scene::Pass *pass, const sce
             buffer->setDynamicOffset(0, _lightBufferStride * idx);
             _batchedQueue->add(buffer);
         }
-    } else { // standard draw
-        const auto        count = _lightIndices.size();
-        AdditiveLightPass lightPass;
-        lightPass.subModel = subModel;
-        lightPass.pass     = pass;
-        lightPass.shader   = subModel->getShader(lightPassIdx);
+    } else if (subModel->getShader(lightPassIdx)) { // standard draw, skipped until compiled
+        const auto count     = _lightIndices.size();
+        auto &     lightPass = addLightPass(pass, subModel, subModel->getShader(lightPassIdx));
         lightPass.dynamicOffsets.resize(count);
         for (unsigned idx = 0; idx < count; idx++) {
             const auto lightIdx = _lightIndices[idx];
             lightPass.lights.emplace_back(lightIdx);
             lightPass.dynamicOffsets[idx] = _lightBufferStride * lightIdx;
         }
+    }
+}
 
-        _lightPasses.emplace_back(std::move(lightPass));
+void RenderAdditiveLightQueue::addClusterRenderQueue(const scene::Pass *pass, const scene::SubModel *subModel, const scene::Model *model, uint lightPassIdx) {
+    const auto batchingScheme = pass->getBatchingScheme();
+    if (batchingScheme == scene::BatchingSchemes::INSTANCING) { // instancing
+        auto *buffer = InstancedBuffer::get(subModel->getPass(lightPassIdx));
+        buffer->merge(model, subModel, lightPassIdx);
+        buffer->setDynamicOffset(0, 0);
+        _instancedQueue->add(buffer);
+    } else if (batchingScheme == scene::BatchingSchemes::VB_MERGING) { // vb-merging
+        auto *buffer = BatchedBuffer::get(subModel->getPass(lightPassIdx));
+        buffer->merge(subModel, lightPassIdx, model);
+        buffer->setDynamicOffset(0, 0);
+        _batchedQueue->add(buffer);
+    } else if (subModel->getShader(lightPassIdx)) { // standard draw, skipped until compiled
+        addLightPass(pass, subModel, subModel->getShader(lightPassIdx));
+    } else {
+        return;
+    }
+
+    if (std::find(_clusterPasses.begin(), _clusterPasses.end(), pass) == _clusterPasses.end()) {
+        _clusterPasses.emplace_back(pass);
     }
 }
 
@@ -348,8 +425,12 @@ void RenderAdditiveLightQueue::updateLightDescriptorSet(const scene::Camera *cam
                 float shadowNFLSInfos[4] = {0.1F, spotLight->getRange(), linear, 0.0F};
                 memcpy(_shadowUBO.data() + UBOShadow::SHADOW_NEAR_FAR_LINEAR_SATURATION_INFO_OFFSET, &shadowNFLSInfos, sizeof(shadowNFLSInfos));
 
+                // the pcf taps of a tile step in texels of the whole atlas
+                const auto *shadowAtlas        = sceneData->getShadowAtlas();
+                const bool  inAtlas            = shadowAtlas && shadowAtlas->getFramebuffer();
                 const auto &shadowSize         = shadowInfo->getSize();
-                float       shadowWHPBInfos[4] = {shadowSize.x, shadowSize.y, spotLight->getShadowPcf(), spotLight->getShadowBias()};
+                const float atlasSize          = inAtlas ? static_cast<float>(shadowAtlas->getSize()) : 0.0F;
+                float       shadowWHPBInfos[4] = {inAtlas ? atlasSize : shadowSize.x, inAtlas ? atlasSize : shadowSize.y, spotLight->getShadowPcf(), spotLight->getShadowBias()};
                 memcpy(_shadowUBO.data() + UBOShadow::SHADOW_WIDTH_HEIGHT_PCF_BIAS_INFO_OFFSET, &shadowWHPBInfos, sizeof(shadowWHPBInfos));
 
                 float shadowLPNNInfos[4] = {1.0F, packing, spotLight->getShadowNormalBias(), 0.0F};
@@ -366,7 +447,11 @@ void RenderAdditiveLightQueue::updateLightDescriptorSet(const scene::Camera *cam
 
                 // Spot light sampler binding
                 const auto &shadowFramebufferMap = sceneData->getShadowFramebufferMap();
-                if (shadowFramebufferMap.count(light) > 0) {
+                if (inAtlas) {
+                    const Vec4 tileInfo = shadowAtlas->getTileInfo(light);
+                    memcpy(_shadowUBO.data() + UBOShadow::SHADOW_ATLAS_TILE_INFO_OFFSET, &tileInfo.x, sizeof(float) * 4);
+                    descriptorSet->bindTexture(SPOTLIGHTINGMAP::BINDING, shadowAtlas->getTexture());
+                } else if (shadowFramebufferMap.count(light) > 0) {
                     auto *texture = shadowFramebufferMap.at(light)->getColorTextures()[0];
                     if (texture) {
                         descriptorSet->bindTexture(SPOTLIGHTINGMAP::BINDING, texture);
@@ -404,10 +489,25 @@ bool RenderAdditiveLightQueue::getLightPassIndex(const scene::Model *model, ccst
     return hasValidLightPass;
 }
 
-void RenderAdditiveLightQueue::lightCulling(const scene::Model *model) {
-    bool isCulled = false;
+void RenderAdditiveLightQueue::mapLightGridSlots(const scene::Camera *camera) {
+    _lightTestCount = 0;
+    _lightGrid      = &camera->getScene()->getLightGrid();
+    _validIndexOfSlot.assign(_lightGrid->getLightCount(), -1);
+    _ungriddedLightIndices.clear();
     for (size_t i = 0; i < _validPunctualLights.size(); i++) {
-        const auto *const light = _validPunctualLights[i];
+        const int32_t slot = _lightGrid->getSlot(_validPunctualLights[i]);
+        if (slot >= 0) {
+            _validIndexOfSlot[slot] = static_cast<int32_t>(i);
+        } else {
+            _ungriddedLightIndices.emplace_back(utils::toUint(i));
+        }
+    }
+}
+
+void RenderAdditiveLightQueue::lightCulling(const scene::Model *model) {
+    const auto testLight = [&](uint i) {
+        const auto *const light    = _validPunctualLights[i];
+        bool              isCulled = false;
         switch (light->getType()) {
             case scene::LightType::SPHERE:
                 isCulled = cullSphereLight(static_cast<const scene::SphereLight *>(light), model);
@@ -419,10 +519,34 @@ void RenderAdditiveLightQueue::lightCulling(const scene::Model *model) {
                 isCulled = false;
                 break;
         }
+        ++_lightTestCount;
         if (!isCulled) {
+            _lightIndices.emplace_back(i);
+        }
+    };
+
+    // models without bounds are lit by every light
+    if (!model->getWorldBounds()) {
+        for (size_t i = 0; i < _validPunctualLights.size(); i++) {
             _lightIndices.emplace_back(utils::toUint(i));
         }
+        return;
+    }
+
+    // only the lights sharing a grid cell with the model are tested
+    _gridSlots.clear();
+    _lightGrid->query(*model->getWorldBounds(), _gridSlots);
+    for (const auto slot : _gridSlots) {
+        const int32_t validIndex = _validIndexOfSlot[slot];
+        if (validIndex >= 0) {
+            testLight(static_cast<uint>(validIndex));
+        }
+    }
+    for (const auto i : _ungriddedLightIndices) {
+        testLight(i);
     }
+    // keep the order of the valid lights
+    std::sort(_lightIndices.begin(), _lightIndices.end());
 }
 
 } // namespace pipeline
@@ -27,6 +27,7 @@
 
 #include "Define.h"
 #include "base/std/container/array.h"
+#include "base/std/container/small_vector.h"
 
 namespace cc {
 namespace scene {
@@ -35,6 +36,7 @@ class Pass;
 class Light;
 class SpotLight;
 class SphereLight;
+class LightGrid;
 } // namespace scene
 namespace pipeline {
 struct RenderObject;
@@ -43,12 +45,15 @@ class RenderInstancedQueue;
 class RenderBatchedQueue;
 class ForwardPipeline;
 
+// most models are lit by a few lights only
+constexpr uint32_t ADDITIVE_LIGHTS_INLINE_CAPACITY{4};
+
 struct AdditiveLightPass {
-    const scene::SubModel *subModel = nullptr;
-    const scene::Pass *    pass     = nullptr;
-    gfx::Shader *          shader   = nullptr;
-    ccstd::vector<uint>    dynamicOffsets;
-    ccstd::vector<uint>    lights;
+    const scene::SubModel *                                    subModel = nullptr;
+    const scene::Pass *                                        pass     = nullptr;
+    gfx::Shader *                                              shader   = nullptr;
+    ccstd::small_vector<uint, ADDITIVE_LIGHTS_INLINE_CAPACITY> dynamicOffsets;
+    ccstd::small_vector<uint, ADDITIVE_LIGHTS_INLINE_CAPACITY> lights;
 };
 
 class RenderAdditiveLightQueue final {
@@ -58,6 +63,8 @@ public:
 
     void recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer);
     void gatherLightPasses(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
+    // forward+: binds the light lists built by ClusterLightCulling to the gathered passes, nothing is drawn unless all are valid
+    void bindClusterBuffers(gfx::Buffer *lightBuffer, gfx::Buffer *lightIndexBuffer, gfx::Buffer *lightGridBuffer);
 
 private:
     static bool cullSphereLight(const scene::SphereLight *light, const scene::Model *model);
@@ -65,17 +72,31 @@ private:
 
     void clear();
     void addRenderQueue(const scene::Pass *pass, const scene::SubModel *subModel, const scene::Model *model, uint lightPassIdx);
+    void addClusterRenderQueue(const scene::Pass *pass, const scene::SubModel *subModel, const scene::Model *model, uint lightPassIdx);
+    AdditiveLightPass &addLightPass(const scene::Pass *pass, const scene::SubModel *subModel, gfx::Shader *shader);
     void updateUBOs(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
     void updateLightDescriptorSet(const scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
     bool getLightPassIndex(const scene::Model *model, ccstd::vector<uint> *lightPassIndices) const;
     void lightCulling(const scene::Model *model);
+    void mapLightGridSlots(const scene::Camera *camera);
 
     RenderPipeline *                                _pipeline = nullptr;
     ccstd::vector<ccstd::vector<scene::SubModel *>> _sortedSubModelsArray;
     ccstd::vector<ccstd::vector<uint>>              _sortedPSOCIArray;
     ccstd::vector<const scene::Light *>             _validPunctualLights;
     ccstd::vector<uint>                             _lightIndices;
+    // candidates of each model are looked up in the light grid, see mapLightGridSlots
+    const scene::LightGrid *                        _lightGrid{nullptr};
+    ccstd::vector<int32_t>                          _validIndexOfSlot;
+    ccstd::vector<uint>                             _ungriddedLightIndices;
+    ccstd::vector<uint32_t>                         _gridSlots;
+    uint32_t                                        _lightTestCount{0};
+    // only the first _lightPassCount passes are used in the current frame
     ccstd::vector<AdditiveLightPass>                _lightPasses;
+    uint32_t                                        _lightPassCount{0};
+    // forward+: passes drawn once for all the lights of their clusters
+    ccstd::vector<const scene::Pass *>              _clusterPasses;
+    bool                                            _clusterBuffersBound{false};
     ccstd::vector<uint>                             _dynamicOffsets;
     ccstd::vector<float>                            _lightBufferData;
     RenderInstancedQueue *                          _instancedQueue       = nullptr;
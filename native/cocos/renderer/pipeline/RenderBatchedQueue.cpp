@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "RenderBatchedQueue.h"
+#include <algorithm>
 #include "BatchedBuffer.h"
 #include "PipelineStateManager.h"
 #include "gfx-base/GFXCommandBuffer.h"
@@ -34,7 +35,15 @@
 namespace cc {
 namespace pipeline {
 
+void RenderBatchedQueue::removeDuplicates() {
+    if (_unique) return;
+    std::sort(_queues.begin(), _queues.end());
+    _queues.erase(std::unique(_queues.begin(), _queues.end()), _queues.end());
+    _unique = true;
+}
+
 void RenderBatchedQueue::clear() {
+    removeDuplicates();
     for (auto *it : _queues) {
         it->clear();
     }
@@ -42,22 +51,14 @@ void RenderBatchedQueue::clear() {
 }
 
 void RenderBatchedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+    removeDuplicates();
     for (auto *batchedBuffer : _queues) {
-        const auto &batches = batchedBuffer->getBatches();
-        for (const auto &batch : batches) {
-            if (!batch.mergeCount) continue;
-
-            auto i = 0U;
-            for (auto *vb : batch.vbs) {
-                cmdBuffer->updateBuffer(vb, batch.vbDatas[i++], vb->getSize());
-            }
-            cmdBuffer->updateBuffer(batch.indexBuffer, batch.indexData, batch.indexBuffer->getSize());
-            cmdBuffer->updateBuffer(batch.ubo, batch.uboData.data(), batch.ubo->getSize());
-        }
+        batchedBuffer->uploadBuffers(cmdBuffer);
     }
 }
 
 void RenderBatchedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
+    removeDuplicates();
     for (auto *batchedBuffer : _queues) {
         bool        boundPSO = false;
         const auto &batches  = batchedBuffer->getBatches();
@@ -78,7 +79,9 @@ void RenderBatchedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Rend
 }
 
 void RenderBatchedQueue::add(BatchedBuffer *batchedBuffer) {
-    _queues.emplace(batchedBuffer);
+    if (!_queues.empty() && _queues.back() == batchedBuffer) return;
+    _queues.emplace_back(batchedBuffer);
+    _unique = false;
 }
 
 } // namespace pipeline
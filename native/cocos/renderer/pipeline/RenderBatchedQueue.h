@@ -25,7 +25,7 @@
 
 #pragma once
 
-#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 #include "gfx-base/GFXDef.h"
 
 namespace cc {
@@ -45,7 +45,12 @@ public:
     bool empty() { return _queues.empty(); }
 
 private:
-    ccstd::unordered_set<BatchedBuffer *> _queues;
+    // a buffer is added once per merged model, the duplicates are removed lazily
+    void removeDuplicates();
+
+    // unlike a node based set, the vector keeps its capacity between frames
+    ccstd::vector<BatchedBuffer *> _queues;
+    bool                           _unique{true};
 };
 
 } // namespace pipeline
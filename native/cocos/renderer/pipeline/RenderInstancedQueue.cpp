@@ -24,29 +24,43 @@
 ****************************************************************************/
 
 #include "RenderInstancedQueue.h"
+#include <algorithm>
 #include "InstancedBuffer.h"
 #include "PipelineStateManager.h"
+#include "InstancedGPUCulling.h"
 #include "gfx-base/GFXCommandBuffer.h"
+#include "scene/Camera.h"
 
 namespace cc {
 namespace pipeline {
 
+void RenderInstancedQueue::removeDuplicates() {
+    if (_unique) return;
+    std::sort(_queues.begin(), _queues.end());
+    _queues.erase(std::unique(_queues.begin(), _queues.end()), _queues.end());
+    _unique = true;
+}
+
 void RenderInstancedQueue::clear() {
+    removeDuplicates();
     for (auto *it : _queues) {
         it->clear();
     }
     _queues.clear();
 }
 
-void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer) {
+void RenderInstancedQueue::uploadBuffers(gfx::CommandBuffer *cmdBuffer, const scene::Camera *camera) {
+    const geometry::Frustum *frustum = camera ? &camera->getFrustum() : nullptr;
+    removeDuplicates();
     for (auto *instanceBuffer : _queues) {
         if (instanceBuffer->hasPendingModels()) {
-            instanceBuffer->uploadBuffers(cmdBuffer);
+            instanceBuffer->uploadBuffers(cmdBuffer, frustum);
         }
     }
 }
 
 void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer) {
+    removeDuplicates();
     for (auto *instanceBuffer : _queues) {
         if (!instanceBuffer->hasPendingModels()) continue;
 
@@ -65,13 +79,22 @@ void RenderInstancedQueue::recordCommandBuffer(gfx::Device * /*device*/, gfx::Re
             }
             cmdBuffer->bindDescriptorSet(localSet, instance.descriptorSet, instanceBuffer->dynamicOffsets());
             cmdBuffer->bindInputAssembler(instance.ia);
-            cmdBuffer->draw(instance.ia);
+            if (instance.gpuItem) {
+                gfx::DrawIndirectInfo drawInfo;
+                drawInfo.buffer    = instance.gpuItem->drawBuffer;
+                drawInfo.drawCount = 1;
+                cmdBuffer->drawIndirect(drawInfo);
+            } else {
+                cmdBuffer->draw(instance.ia);
+            }
         }
     }
 }
 
 void RenderInstancedQueue::add(InstancedBuffer *instancedBuffer) {
-    _queues.emplace(instancedBuffer);
+    if (!_queues.empty() && _queues.back() == instancedBuffer) return;
+    _queues.emplace_back(instancedBuffer);
+    _unique = false;
 }
 
 } // namespace pipeline
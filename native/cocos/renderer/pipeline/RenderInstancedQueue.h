@@ -26,7 +26,7 @@
 #pragma once
 
 #include "base/Macros.h"
-#include "base/std/container/unordered_set.h"
+#include "base/std/container/vector.h"
 
 namespace cc {
 
@@ -36,6 +36,10 @@ class RenderPass;
 class CommandBuffer;
 } // namespace gfx
 
+namespace scene {
+class Camera;
+} // namespace scene
+
 namespace pipeline {
 
 class InstancedBuffer;
@@ -47,12 +51,18 @@ public:
 
     void recordCommandBuffer(gfx::Device *device, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuffer);
     void add(InstancedBuffer *instancedBuffer);
-    void uploadBuffers(gfx::CommandBuffer *cmdBuffer);
+    // GPU culled instances are culled by the frustum of camera if it is set
+    void uploadBuffers(gfx::CommandBuffer *cmdBuffer, const scene::Camera *camera = nullptr);
     void clear();
     bool empty() { return _queues.empty(); }
 
 private:
-    ccstd::unordered_set<InstancedBuffer *> _queues;
+    // a buffer is added once per merged model, the duplicates are removed lazily
+    void removeDuplicates();
+
+    // unlike a node based set, the vector keeps its capacity between frames
+    ccstd::vector<InstancedBuffer *> _queues;
+    bool                             _unique{true};
 };
 
 } // namespace pipeline
@@ -32,8 +32,10 @@
 #include "PipelineStateManager.h"
 #include "PipelineUBO.h"
 #include "RenderFlow.h"
+#include "SceneCulling.h"
 #include "RenderPipeline.h"
 #include "base/StringUtil.h"
+#include "base/job-system/JobSystem.h"
 #include "frame-graph/FrameGraph.h"
 #include "gfx-base/GFXDevice.h"
 #include "helper/Utils.h"
@@ -88,6 +90,7 @@ bool RenderPipeline::activate(gfx::Swapchain * /*swapchain*/) {
     // switch may be changed in root.ts setRenderPipeline() function which is after
     // pipeline construct.
     generateConstantMacros();
+    _fg.setPassExecutionListener(&_gpuTimer);
 
     for (auto *const flow : _flows) {
         flow->activate(this);
@@ -140,12 +143,21 @@ bool RenderPipeline::destroy() {
         queryPool->destroy();
     }
     _queryPools.clear();
+    _gpuTimer.destroy();
+    _computeSkinning.destroy();
+    _computeMorphing.destroy();
+    _environmentPrefilter.destroy();
 
     for (auto *const cmdBuffer : _commandBuffers) {
         cmdBuffer->destroy();
     }
     _commandBuffers.clear();
 
+    for (auto *result : _sceneCullingResults) {
+        delete result;
+    }
+    _sceneCullingResults.clear();
+
     PipelineStateManager::destroyAll();
     BatchedBuffer::destroyBatchedBuffer();
     InstancedBuffer::destroyInstancedBuffer();
@@ -354,5 +366,18 @@ void RenderPipeline::framegraphGC() {
     }
 }
 
+bool RenderPipeline::useParallelCulling(const ccstd::vector<scene::Camera *> &cameras) const {
+    return _parallelCullingEnabled && cameras.size() > 1 && JobSystem::getInstance()->threadCount() > 1;
+}
+
+bool RenderPipeline::useParallelRecording() const {
+    if (!_parallelRecordingEnabled || isOcclusionQueryEnabled() || JobSystem::getInstance()->threadCount() < 2) {
+        return false;
+    }
+    // other backends replay secondary command buffers inline, recording them in parallel gains nothing
+    const auto api = _device->getGfxAPI();
+    return api == gfx::API::VULKAN || api == gfx::API::METAL;
+}
+
 } // namespace pipeline
 } // namespace cc
@@ -26,6 +26,11 @@
 #pragma once
 
 #include "Define.h"
+#include "DynamicResolution.h"
+#include "ComputeMorphing.h"
+#include "EnvironmentPrefilter.h"
+#include "ComputeSkinning.h"
+#include "GPUTimer.h"
 #include "base/std/container/string.h"
 #include "base/std/container/unordered_map.h"
 #include "core/assets/Asset.h"
@@ -50,6 +55,7 @@ class PipelineUBO;
 class PipelineSceneData;
 class GlobalDSManager;
 class RenderStage;
+struct SceneCullingResult;
 struct CC_DLL RenderPipelineInfo {
     uint           tag = 0;
     RenderFlowList flows;
@@ -111,6 +117,44 @@ public:
     float getShadingScale() const;
     void  setShadingScale(float scale);
 
+    /**
+     * @en Adjusts the shading scale from frame timings each frame when enabled, only used by the deferred pipeline.
+     * @zh 启用后每帧根据帧耗时调整着色缩放，仅延迟管线使用。
+     */
+    inline DynamicResolution &getDynamicResolution() { return _dynamicResolution; }
+
+    /**
+     * @en GPU time of the frame graph passes and the shadow stage measured with timestamp queries, read back a few frames later.
+     * Shown in the profiler stats when enabled, only supported on Vulkan for now.
+     * @zh 以时间戳查询统计的帧图通道及阴影阶段的 GPU 耗时，结果在数帧之后读回。启用后显示在性能统计中，目前仅支持 Vulkan。
+     */
+    inline GPUTimer &getGPUTimer() { return _gpuTimer; }
+    inline bool      isGPUTimingEnabled() const { return _gpuTimer.isEnabled(); }
+    inline void      setGPUTimingEnabled(bool enable) { _gpuTimer.setEnabled(enable); }
+
+    /**
+     * @en Skins the vertices of skinning models with compute shaders once per frame, shared by every pass, when the device supports it.
+     * Enabled by default, only affects the models initialized afterwards.
+     * @zh 设备支持时，使用计算着色器每帧对蒙皮模型的顶点蒙皮一次，供所有渲染通道共用。默认启用，只影响之后初始化的模型。
+     */
+    inline ComputeSkinning &getComputeSkinning() { return _computeSkinning; }
+
+    /**
+     * @en Accumulates the morph targets of non-zero weights with compute shaders when the weights change, instead of blending all
+     * the targets in the vertex shader of every pass. Enabled by default when the device supports it, only affects the meshes
+     * whose morph rendering is created afterwards.
+     * @zh 权重变化时使用计算着色器累加权重不为零的变形目标，替代在每个渲染通道的顶点着色器中混合所有目标。
+     * 设备支持时默认启用，只影响之后创建变形渲染的网格。
+     */
+    inline ComputeMorphing &getComputeMorphing() { return _computeMorphing; }
+
+    /**
+     * @en Prefilters the environment maps changed at runtime into specular and diffuse irradiance maps with compute shaders,
+     * spread over several frames within a time budget. Enabled by default when the device supports it.
+     * @zh 使用计算着色器将运行时修改的环境贴图预过滤为镜面与漫反射辐照度贴图，在耗时预算内分摊到多帧完成。设备支持时默认启用。
+     */
+    inline EnvironmentPrefilter &getEnvironmentPrefilter() { return _environmentPrefilter; }
+
     inline scene::Model *getProfiler() const { return _profiler; }
     inline void          setProfiler(scene::Model *value) { _profiler = value; }
 
@@ -120,6 +164,19 @@ public:
     inline bool isBloomEnabled() const { return _bloomEnabled; }
     inline void setBloomEnabled(bool enable) { _bloomEnabled = enable; }
 
+    // Cull all cameras of a frame as parallel jobs before rendering the first one, only used with more than one camera.
+    inline bool isParallelCullingEnabled() const { return _parallelCullingEnabled; }
+    inline void setParallelCullingEnabled(bool enable) { _parallelCullingEnabled = enable; }
+
+    /**
+     * @en Record the render queues of the main forward pass into secondary command buffers on job threads.
+     * Only takes effect on Vulkan and Metal with more than one job thread and occlusion query disabled.
+     * @zh 在工作线程中将主前向通道的渲染队列录制到次级命令缓冲。仅在 Vulkan 和 Metal 上、工作线程多于一个且未开启遮挡查询时生效。
+     */
+    inline bool isParallelRecordingEnabled() const { return _parallelRecordingEnabled; }
+    inline void setParallelRecordingEnabled(bool enable) { _parallelRecordingEnabled = enable; }
+    bool        useParallelRecording() const;
+
 protected:
     static RenderPipeline *instance;
 
@@ -128,6 +185,8 @@ protected:
 
     static void framegraphGC();
 
+    bool useParallelCulling(const ccstd::vector<scene::Camera *> &cameras) const;
+
     gfx::CommandBufferList                                   _commandBuffers;
     gfx::QueryPoolList                                       _queryPools;
     RenderFlowList                                           _flows;
@@ -153,11 +212,20 @@ protected:
 
     framegraph::FrameGraph                                   _fg;
     ccstd::unordered_map<gfx::ClearFlags, gfx::RenderPass *> _renderPasses;
+    DynamicResolution                                        _dynamicResolution;
+    GPUTimer                                                 _gpuTimer;
+    ComputeSkinning                                          _computeSkinning;
+    ComputeMorphing                                          _computeMorphing;
+    EnvironmentPrefilter                                     _environmentPrefilter;
 
     // use cluster culling or not
     bool _clusterEnabled{false};
     bool _bloomEnabled{false};
     bool _occlusionQueryEnabled{false};
+    bool _parallelCullingEnabled{false};
+    bool _parallelRecordingEnabled{false};
+
+    ccstd::vector<SceneCullingResult *> _sceneCullingResults;
 };
 
 } // namespace pipeline
@@ -25,7 +25,9 @@
 
 #include "RenderQueue.h"
 
+#include <cstring>
 #include <utility>
+#include "base/std/container/array.h"
 #include "PipelineSceneData.h"
 #include "PipelineStateManager.h"
 #include "RenderPipeline.h"
@@ -39,6 +41,38 @@
 namespace cc {
 namespace pipeline {
 
+namespace {
+// order preserving bits of a float, -0 sorts as +0 like operator<
+uint32_t depthSortBits(float depth) {
+    if (depth == 0.F) depth = 0.F;
+    uint32_t bits = 0;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits & 0x80000000U) ? ~bits : bits | 0x80000000U;
+}
+
+// stable counting sort on one byte, returns false without touching dst if all items share the byte
+template <typename Digit>
+bool radixPass(const RenderPassList &src, RenderPassList &dst, const Digit &digit) {
+    ccstd::array<uint32_t, 256> offsets{};
+    for (const auto &item : src) {
+        ++offsets[digit(item)];
+    }
+    if (offsets[digit(src.front())] == src.size()) {
+        return false;
+    }
+    uint32_t offset = 0;
+    for (auto &count : offsets) {
+        const uint32_t bucketSize = count;
+        count                     = offset;
+        offset += bucketSize;
+    }
+    for (const auto &item : src) {
+        dst[offsets[digit(item)]++] = item;
+    }
+    return true;
+}
+} // namespace
+
 RenderQueue::RenderQueue(RenderPipeline *pipeline, RenderQueueCreateInfo desc, bool useOcclusionQuery)
 : _pipeline(pipeline), _passDesc(std::move(desc)), _useOcclusionQuery(useOcclusionQuery) {
 }
@@ -56,9 +90,14 @@ bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint subModelI
         return false;
     }
 
+    const auto *shader = subModel->getShader(passIdx);
+    if (!shader) { // not compiled yet
+        return false;
+    }
+
     auto       passPriority  = static_cast<uint32_t>(pass->getPriority());
     auto       modelPriority = static_cast<uint32_t>(subModel->getPriority());
-    auto       shaderId      = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(subModel->getShader(passIdx)));
+    auto       shaderId      = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(shader));
     const auto hash          = (0 << 30) | (passPriority << 16) | (modelPriority << 8) | passIdx;
     RenderPass renderPass    = {hash, renderObj.depth, shaderId, passIdx, subModel};
     _queue.emplace_back(renderPass);
@@ -67,6 +106,10 @@ bool RenderQueue::insertRenderPass(const RenderObject &renderObj, uint subModelI
 }
 
 void RenderQueue::sort() {
+    if (_passDesc.sortByKey) {
+        sortByKey();
+        return;
+    }
 #if CC_PLATFORM != CC_PLATFORM_LINUX && CC_PLATFORM != CC_PLATFORM_QNX
     std::sort(_queue.begin(), _queue.end(), _passDesc.sortFunc);
 #else
@@ -77,6 +120,32 @@ void RenderQueue::sort() {
 #endif
 }
 
+void RenderQueue::sortByKey() {
+    if (_queue.size() < 2) {
+        return;
+    }
+
+    // same order as opaqueCompareFn and transparentCompareFn, except that depths are compared exactly
+    const bool backToFront = _passDesc.sortMode == RenderQueueSortMode::BACK_TO_FRONT;
+    for (auto &item : _queue) {
+        const uint32_t depthBits = depthSortBits(item.depth);
+        item.sortKey             = (static_cast<uint64_t>(item.hash) << 32) | (backToFront ? ~depthBits : depthBits);
+    }
+
+    // least significant digits first, shader id breaks the ties of the sort key
+    _sortBuffer.resize(_queue.size());
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        if (radixPass(_queue, _sortBuffer, [shift](const RenderPass &item) { return (item.shaderID >> shift) & 0xFFU; })) {
+            _queue.swap(_sortBuffer);
+        }
+    }
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        if (radixPass(_queue, _sortBuffer, [shift](const RenderPass &item) { return static_cast<uint32_t>(item.sortKey >> shift) & 0xFFU; })) {
+            _queue.swap(_sortBuffer);
+        }
+    }
+}
+
 void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex) {
     PipelineSceneData *const sceneData            = _pipeline->getPipelineSceneData();
     bool                     enableOcclusionQuery = _pipeline->isOcclusionQueryEnabled() && _useOcclusionQuery;
@@ -107,7 +176,7 @@ void RenderQueue::recordCommandBuffer(gfx::Device * /*device*/, scene::Camera *c
 
             cmdBuff->bindPipelineState(pso);
             cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-            cmdBuff->bindDescriptorSet(localSet, subModel->getDescriptorSet());
+            cmdBuff->bindDescriptorSet(localSet, subModel->getDrawDescriptorSet());
             cmdBuff->bindInputAssembler(inputAssembler);
             cmdBuff->draw(inputAssembler);
         }
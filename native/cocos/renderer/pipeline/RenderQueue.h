@@ -41,13 +41,18 @@ public:
 
     void clear();
     bool insertRenderPass(const RenderObject &renderObj, uint subModelIdx, uint passIdx);
+    // append a prepared render pass without the phase and shader checks, used by the benchmarks
+    void insertRenderPass(const RenderPass &renderPass) { _queue.emplace_back(renderPass); }
     void recordCommandBuffer(gfx::Device *device, scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, uint32_t subpassIndex = 0);
     void sort();
     bool empty() { return _queue.empty(); }
 
 private:
+    void sortByKey();
+
     RenderPipeline *      _pipeline = nullptr;
     RenderPassList        _queue;
+    RenderPassList        _sortBuffer;
     RenderQueueCreateInfo _passDesc;
     bool                  _useOcclusionQuery{false};
 };
@@ -24,7 +24,10 @@
 ****************************************************************************/
 
 #include "RenderStage.h"
+#include "RenderPipeline.h"
 #include "RenderQueue.h"
+#include "base/job-system/JobSystem.h"
+#include "frame-graph/DevicePassResourceTable.h"
 #include "gfx-base/GFXDevice.h"
 namespace cc {
 namespace pipeline {
@@ -53,6 +56,49 @@ void RenderStage::destroy() {
     }
     _renderQueues.clear();
     _renderQueueDescriptors.clear();
+
+    for (auto *cmdBuff : _secondaryCmdBuffs) {
+        CC_SAFE_DESTROY_AND_DELETE(cmdBuff);
+    }
+    _secondaryCmdBuffs.clear();
+}
+
+const gfx::CommandBufferList &RenderStage::getSecondaryCommandBuffers(uint count) {
+    while (_secondaryCmdBuffs.size() < count) {
+        _secondaryCmdBuffs.emplace_back(_device->createCommandBuffer({_device->getQueue(), gfx::CommandBufferType::SECONDARY}));
+    }
+    return _secondaryCmdBuffs;
+}
+
+void RenderStage::recordSecondaryCommandBuffers(const framegraph::DevicePassResourceTable &table, scene::Camera *camera,
+                                                uint cameraUBOOffset, const ccstd::vector<SecondaryRecorder> &recorders) const {
+    const auto &cmdBuffs = table.getSecondaryCommandBuffers();
+    CC_ASSERT(cmdBuffs.size() >= recorders.size());
+
+    const gfx::Viewport viewport = _pipeline->getViewport(camera);
+    const gfx::Rect     scissor  = _pipeline->getScissor(camera);
+    auto                record   = [&](uint idx) {
+        gfx::CommandBuffer *cmdBuff = cmdBuffs[idx];
+        cmdBuff->begin(table.getRenderPass(), table.getSubpassIndex(), table.getFramebuffer());
+        cmdBuff->setViewport(viewport);
+        cmdBuff->setScissor(scissor);
+        cmdBuff->bindDescriptorSet(globalSet, _pipeline->getDescriptorSet(), 1, &cameraUBOOffset);
+        recorders[idx](cmdBuff);
+        cmdBuff->end();
+    };
+
+    const auto last = static_cast<uint>(recorders.size()) - 1;
+    JobGraph   graph(JobSystem::getInstance());
+    graph.createForEachIndexJob(0U, last, 1U, record);
+    graph.run();
+    record(last);
+    graph.waitForAll();
+
+    // unused ones still have to be valid when executed
+    for (auto i = static_cast<uint>(recorders.size()); i < cmdBuffs.size(); ++i) {
+        cmdBuffs[i]->begin(table.getRenderPass(), table.getSubpassIndex(), table.getFramebuffer());
+        cmdBuffs[i]->end();
+    }
 }
 } // namespace pipeline
 } // namespace cc
@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <functional>
 #include "Define.h"
 
 namespace cc {
@@ -34,6 +35,9 @@ class Camera;
 namespace gfx {
 class Framebuffer;
 } // namespace gfx
+namespace framegraph {
+class DevicePassResourceTable;
+} // namespace framegraph
 
 namespace pipeline {
 
@@ -65,6 +69,15 @@ public:
     inline RenderFlow *         getFlow() const { return _flow; }
 
 protected:
+    using SecondaryRecorder = std::function<void(gfx::CommandBuffer *)>;
+
+    // Secondary command buffers shared by all cameras rendered by the stage, created on first use.
+    const gfx::CommandBufferList &getSecondaryCommandBuffers(uint count);
+    // Begins the secondary command buffers of the table with the camera viewport and global descriptor set bound,
+    // then runs recorders[i] into the i-th one. All but the last recorder run as jobs, the last one runs on the calling thread.
+    void recordSecondaryCommandBuffers(const framegraph::DevicePassResourceTable &table, scene::Camera *camera,
+                                       uint cameraUBOOffset, const ccstd::vector<SecondaryRecorder> &recorders) const;
+
     gfx::Rect _renderArea;
     // Generate quad ia, cannot be updated inside renderpass
     gfx::InputAssembler *        _inputAssembler{nullptr};
@@ -76,6 +89,7 @@ protected:
     ccstd::string                _name;
     uint                         _priority    = 0;
     uint                         _tag         = 0;
+    gfx::CommandBufferList       _secondaryCmdBuffs;
     gfx::ColorList               _clearColors = {{0.0F, 0.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 0.0F, 0.0F}, {0.0F, 0.0F, 0.0F, 0.0F}};
 };
 
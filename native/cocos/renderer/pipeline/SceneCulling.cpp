@@ -23,12 +23,18 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <cstring>
 #include "base/std/container/array.h"
+#include "base/job-system/JobSystem.h"
+#include "base/threading/FrameArena.h"
 
 #include "Define.h"
+#include "HiZCulling.h"
 #include "PipelineSceneData.h"
 #include "RenderPipeline.h"
 #include "SceneCulling.h"
+#include "core/Root.h"
+#include "core/assets/TextureStreaming.h"
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
 #include "core/geometry/Sphere.h"
@@ -38,16 +44,26 @@
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
+#include "scene/LODGroup.h"
 #include "scene/Light.h"
 #include "scene/Octree.h"
+#include "scene/Pass.h"
 #include "scene/RenderScene.h"
 #include "scene/Shadow.h"
 #include "scene/Skybox.h"
 #include "scene/SpotLight.h"
+#include "scene/SubModel.h"
 
 namespace cc {
 namespace pipeline {
 
+bool SceneCullingCache::Key::operator==(const Key &rhs) const {
+    return scene == rhs.scene && skyboxModel == rhs.skyboxModel && cameraVersion == rhs.cameraVersion &&
+           visibility == rhs.visibility && modelsVersion == rhs.modelsVersion && boundsLayoutVersion == rhs.boundsLayoutVersion &&
+           isShadowMap == rhs.isShadowMap && octreeEnabled == rhs.octreeEnabled &&
+           memcmp(dirLightVertices.data(), rhs.dirLightVertices.data(), sizeof(Vec3) * dirLightVertices.size()) == 0;
+}
+
 RenderObject genRenderObject(const scene::Model *model, const scene::Camera *camera) {
     float depth = 0;
     if (model->getNode()) {
@@ -153,10 +169,8 @@ void updatePlanarNormalAndDistance(scene::Shadows *shadowInfo, ccstd::array<floa
     memcpy(shadowUBO->data() + UBOShadow::PLANAR_NORMAL_DISTANCE_INFO_OFFSET, &planarNDInfo, sizeof(planarNDInfo));
 }
 
-void validPunctualLightsCulling(RenderPipeline *pipeline, scene::Camera *camera) {
-    const auto *const  scene     = camera->getScene();
-    PipelineSceneData *sceneData = pipeline->getPipelineSceneData();
-    sceneData->clearValidPunctualLights();
+void validPunctualLightsCulling(const scene::Camera *camera, ccstd::vector<const scene::Light *> &validPunctualLights) {
+    const auto *const scene = camera->getScene();
 
     geometry::Sphere sphere;
     for (const auto &light : scene->getSpotLights()) {
@@ -168,7 +182,7 @@ void validPunctualLightsCulling(RenderPipeline *pipeline, scene::Camera *camera)
         sphere.setRadius(light->getRange());
 
         if (sphere.sphereFrustum(camera->getFrustum())) {
-            sceneData->addValidPunctualLight(static_cast<scene::Light *>(light));
+            validPunctualLights.emplace_back(static_cast<scene::Light *>(light));
         }
     }
 
@@ -180,11 +194,19 @@ void validPunctualLightsCulling(RenderPipeline *pipeline, scene::Camera *camera)
         sphere.setCenter(light->getPosition());
         sphere.setRadius(light->getRange());
         if (sphere.sphereFrustum(camera->getFrustum())) {
-            sceneData->addValidPunctualLight(static_cast<scene::Light *>(light));
+            validPunctualLights.emplace_back(static_cast<scene::Light *>(light));
         }
     }
 }
 
+void validPunctualLightsCulling(RenderPipeline *pipeline, scene::Camera *camera) {
+    // swapped with the lights of the last culling, which keeps the capacity of both
+    static ccstd::vector<const scene::Light *> validPunctualLights;
+    validPunctualLights.clear();
+    validPunctualLightsCulling(camera, validPunctualLights);
+    pipeline->getPipelineSceneData()->setValidPunctualLights(std::move(validPunctualLights));
+}
+
 Mat4 getCameraWorldMatrix(const scene::Camera *camera) {
     Mat4 out;
     if (!camera || !camera->getNode()) {
@@ -329,44 +351,131 @@ void quantizeDirLightShadowCamera(RenderPipeline *pipeline, const scene::Camera
         shadowInfo->setMatShadowViewProj(matShadowViewProj);
     }
 }
-void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
-    CC_PROFILE(SceneCulling);
-    PipelineSceneData *const        sceneData  = pipeline->getPipelineSceneData();
-    const scene::Shadows *          shadowInfo = sceneData->getShadows();
-    const scene::Skybox *           skyBox     = sceneData->getSkybox();
-    const scene::RenderScene *const scene      = camera->getScene();
-    const scene::DirectionalLight * mainLight  = scene->getMainLight();
-    geometry::Frustum               dirLightFrustum;
-
-    RenderObjectList dirShadowObjects;
-    bool             isShadowMap = false;
-    if (shadowInfo != nullptr && shadowInfo->isEnabled() && shadowInfo->getType() == scene::ShadowType::SHADOW_MAP) {
-        isShadowMap = true;
-
-        // update dirLightFrustum
-        if (mainLight && mainLight->getNode()) {
-            quantizeDirLightShadowCamera(pipeline, camera, &dirLightFrustum);
-        } else {
-            for (Vec3 &vertex : dirLightFrustum.vertices) {
-                vertex.setZero();
+namespace {
+SceneCullingCache *getCullingCache(const PipelineSceneData *sceneData, scene::Camera *camera) {
+    return sceneData->isCullingCacheEnabled() ? camera->getCullingCache() : nullptr;
+}
+
+bool prepareDirLightFrustum(RenderPipeline *pipeline, const scene::Camera *camera, geometry::Frustum *dirLightFrustum) {
+    const scene::Shadows *shadowInfo = pipeline->getPipelineSceneData()->getShadows();
+    if (shadowInfo == nullptr || !shadowInfo->isEnabled() || shadowInfo->getType() != scene::ShadowType::SHADOW_MAP) {
+        return false;
+    }
+
+    // update dirLightFrustum
+    const scene::DirectionalLight *mainLight = camera->getScene()->getMainLight();
+    if (mainLight && mainLight->getNode()) {
+        quantizeDirLightShadowCamera(pipeline, camera, dirLightFrustum);
+    } else {
+        for (Vec3 &vertex : dirLightFrustum->vertices) {
+            vertex.setZero();
+        }
+        dirLightFrustum->updatePlanes();
+    }
+    return true;
+}
+
+// only reads the scene, safe to run for several cameras at the same time
+// lodCulled[i] is set to 1 if the i-th model of the scene belongs only to LOD levels not picked for the camera,
+// left empty if the scene has no LOD group
+void lodCulling(const scene::RenderScene *scene, const scene::Camera *camera, ccstd::pmr::vector<uint8_t> &lodCulled) {
+    const auto &groups = scene->getLODGroups();
+    if (groups.empty()) {
+        return;
+    }
+
+    lodCulled.assign(scene->getModels().size(), 0);
+    const auto markLevel = [&](const scene::LODData *lod, uint8_t culled) {
+        for (const auto &model : lod->getModels()) {
+            const int32_t index = model->getSceneBoundsIndex();
+            if (index >= 0) {
+                lodCulled[index] = culled;
             }
-            dirLightFrustum.updatePlanes();
+        }
+    };
+
+    for (const auto &group : groups) {
+        if (!group->isEnabled()) {
+            continue;
+        }
+
+        const scene::LODSelection selection = group->selectLOD(camera, scene->getLODBias());
+        const auto &              lods      = group->getLODs();
+        for (const auto &lod : lods) {
+            markLevel(lod, 1);
+        }
+        // models shared between levels stay visible if any of their levels is picked
+        if (selection.level >= 0) {
+            markLevel(lods[selection.level], 0);
+        }
+        if (selection.fadeLevel >= 0) {
+            markLevel(lods[selection.fadeLevel], 0);
         }
     }
+}
 
-    sceneData->clearRenderObjects();
+void cullModels(const PipelineSceneData *sceneData, scene::Camera *camera, bool isShadowMap, const geometry::Frustum &dirLightFrustum,
+                RenderObjectList &renderObjects, RenderObjectList &dirShadowObjects, RenderObjectList &castShadowObject,
+                SceneCullingCache *cache = nullptr) {
+    const scene::Skybox *           skyBox = sceneData->getSkybox();
+    const scene::RenderScene *const scene  = camera->getScene();
+    const scene::Octree *           octree = scene->getOctree();
+    const auto &                    models = scene->getModels();
+    const auto &                    bounds = scene->getModelBounds();
+
+    const bool drawSkybox    = skyBox != nullptr && skyBox->isEnabled() && skyBox->getModel() && (static_cast<uint32_t>(camera->getClearFlag()) & skyboxFlag);
+    const bool octreeEnabled = octree && octree->isEnabled();
+
+    // models whose bounds changed since the cached frame are the only ones to test again
+    auto *                       arena = FrameArena::getInstance();
+    ccstd::pmr::vector<uint32_t> changedModels(arena);
+    bool                         partial = false;
+    if (cache) {
+        SceneCullingCache::Key key;
+        key.scene               = scene;
+        key.skyboxModel         = drawSkybox ? skyBox->getModel() : nullptr;
+        key.cameraVersion       = camera->getVersion();
+        key.visibility          = camera->getVisibility();
+        key.modelsVersion       = scene->getModelsVersion();
+        key.boundsLayoutVersion = bounds.getLayoutVersion();
+        key.isShadowMap         = isShadowMap;
+        key.octreeEnabled       = octreeEnabled;
+        if (isShadowMap) {
+            key.dirLightVertices = dirLightFrustum.vertices;
+        }
+
+        if (cache->valid && cache->key == key) {
+            if (cache->boundsVersion == bounds.getVersion()) {
+                renderObjects    = cache->renderObjects;
+                dirShadowObjects = cache->dirShadowObjects;
+                castShadowObject = cache->castShadowObjects;
+                return;
+            }
+            // the octree is queried as a whole
+            if (!octreeEnabled) {
+                bounds.getChangedSince(cache->boundsVersion, changedModels);
+                partial = true;
+            }
+        }
+        cache->key           = key;
+        cache->boundsVersion = bounds.getVersion();
+        cache->valid         = true;
+    }
 
-    RenderObjectList castShadowObject;
+    ccstd::pmr::vector<uint8_t> lodCulled(arena);
+    lodCulling(scene, camera, lodCulled);
+    const auto isLODCulled = [&](const scene::Model *model) {
+        return !lodCulled.empty() && model->getSceneBoundsIndex() >= 0 && lodCulled[model->getSceneBoundsIndex()];
+    };
 
-    if (skyBox != nullptr && skyBox->isEnabled() && skyBox->getModel() && (static_cast<uint32_t>(camera->getClearFlag()) & skyboxFlag)) {
-        sceneData->addRenderObject(genRenderObject(skyBox->getModel(), camera));
+    if (drawSkybox) {
+        renderObjects.emplace_back(genRenderObject(skyBox->getModel(), camera));
     }
 
-    const scene::Octree *octree = scene->getOctree();
-    if (octree && octree->isEnabled()) {
-        for (const auto &model : scene->getModels()) {
+    if (octreeEnabled) {
+        for (const auto &model : models) {
             // filter model by view visibility
-            if (model->isEnabled()) {
+            if (model->isEnabled() && !isLODCulled(model)) {
                 if (model->isCastShadow()) {
                     castShadowObject.emplace_back(genRenderObject(model, camera));
                 }
@@ -379,7 +488,7 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
                     const auto *modelWorldBounds = model->getWorldBounds();
 
                     if (!modelWorldBounds && skyBox->getModel() != model) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
+                        renderObjects.emplace_back(genRenderObject(model, camera));
                     }
                 }
             }
@@ -387,25 +496,48 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
 
         if (isShadowMap) {
             ccstd::vector<scene::Model *> casters;
-            casters.reserve(scene->getModels().size() / 4);
+            casters.reserve(models.size() / 4);
             octree->queryVisibility(camera, dirLightFrustum, true, casters);
 
             for (const auto *model : casters) {
-                dirShadowObjects.emplace_back(genRenderObject(model, camera));
+                if (!isLODCulled(model)) {
+                    dirShadowObjects.emplace_back(genRenderObject(model, camera));
+                }
             }
         }
 
-        ccstd::vector<scene::Model *> models;
-        models.reserve(scene->getModels().size() / 4);
-        octree->queryVisibility(camera, camera->getFrustum(), false, models);
-        for (const auto *model : models) {
-            sceneData->addRenderObject(genRenderObject(model, camera));
+        ccstd::vector<scene::Model *> visibleModels;
+        visibleModels.reserve(models.size() / 4);
+        octree->queryVisibility(camera, camera->getFrustum(), false, visibleModels);
+        for (const auto *model : visibleModels) {
+            if (!isLODCulled(model)) {
+                renderObjects.emplace_back(genRenderObject(model, camera));
+            }
         }
     } else {
-        geometry::AABB ab;
-        for (const auto &model : scene->getModels()) {
+        CC_ASSERT(bounds.size() == models.size());
+
+        // frustum test all world bounds in batch, the results are indexed in the same order as models
+        ccstd::pmr::vector<uint8_t> localCameraVisibility(arena);
+        ccstd::pmr::vector<uint8_t> localDirShadowVisibility(arena);
+        auto &                      cameraVisibility    = cache ? cache->cameraVisibility : localCameraVisibility;
+        auto &                      dirShadowVisibility = cache ? cache->dirShadowVisibility : localDirShadowVisibility;
+        if (partial) {
+            bounds.cull(camera->getFrustum(), changedModels, cameraVisibility);
+            if (isShadowMap) {
+                bounds.cull(dirLightFrustum, changedModels, dirShadowVisibility);
+            }
+        } else {
+            bounds.cull(camera->getFrustum(), cameraVisibility);
+            if (isShadowMap) {
+                bounds.cull(dirLightFrustum, dirShadowVisibility);
+            }
+        }
+
+        for (size_t i = 0; i < models.size(); ++i) {
+            const auto &model = models[i];
             // filter model by view visibility
-            if (model->isEnabled()) {
+            if (model->isEnabled() && (lodCulled.empty() || !lodCulled[i])) {
                 const auto        visibility = camera->getVisibility();
                 const auto *const node       = model->getNode();
 
@@ -418,31 +550,204 @@ void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
                     (visibility & static_cast<uint32_t>(model->getVisFlags()))) {
                     const auto *modelWorldBounds = model->getWorldBounds();
                     if (!modelWorldBounds) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
+                        renderObjects.emplace_back(genRenderObject(model, camera));
                         continue;
                     }
 
                     // dir shadow render Object
                     if (isShadowMap && model->isCastShadow()) {
-                        if (modelWorldBounds->aabbFrustum(dirLightFrustum)) {
+                        if (dirShadowVisibility[i]) {
                             dirShadowObjects.emplace_back(genRenderObject(model, camera));
                         }
                     }
 
                     // frustum culling
-                    if (modelWorldBounds->aabbFrustum(camera->getFrustum())) {
-                        sceneData->addRenderObject(genRenderObject(model, camera));
+                    if (cameraVisibility[i]) {
+                        renderObjects.emplace_back(genRenderObject(model, camera));
                     }
                 }
             }
         }
     }
 
+    if (cache) {
+        cache->renderObjects     = renderObjects;
+        cache->dirShadowObjects  = dirShadowObjects;
+        cache->castShadowObjects = castShadowObject;
+    }
+}
+// the screen size of each visible model picks the mipmaps of the streamed textures of its passes
+void requestStreamedMips(const scene::Camera *camera, const RenderObjectList &renderObjects) {
+    auto *root      = Root::getInstance();
+    auto *streaming = root ? root->getTextureStreaming() : nullptr;
+    if (!streaming || !streaming->isEnabled()) {
+        return;
+    }
+
+    const auto height = static_cast<float>(camera->getHeight());
+    for (const auto &ro : renderObjects) {
+        const auto *bounds = ro.model->getWorldBounds();
+        // unbounded models such as the skybox cover the screen
+        float screenSize = height;
+        if (bounds) {
+            const float diameter = bounds->getHalfExtents().length() * 2.F;
+            screenSize           = scene::computeScreenUsagePercentage(bounds->getCenter(), diameter, camera) * height;
+        }
+        for (const auto &subModel : ro.model->getSubModels()) {
+            for (const auto &pass : subModel->getPasses()) {
+                streaming->requestMipLevels(pass->getDescriptorSet(), screenSize);
+            }
+        }
+    }
+}
+} // namespace
+
+void sceneCulling(RenderPipeline *pipeline, scene::Camera *camera) {
+    CC_PROFILE(SceneCulling);
+    PipelineSceneData *const sceneData = pipeline->getPipelineSceneData();
+    geometry::Frustum        dirLightFrustum;
+    const bool               isShadowMap = prepareDirLightFrustum(pipeline, camera, &dirLightFrustum);
+
+    // swapped with the lists of the last culling, which keeps the capacity of both
+    static RenderObjectList dirShadowObjects;
+    static RenderObjectList castShadowObject;
+    dirShadowObjects.clear();
+    castShadowObject.clear();
+    sceneData->clearRenderObjects();
+    sceneData->clearSpotShadowObjects();
+    cullModels(sceneData, camera, isShadowMap, dirLightFrustum, sceneData->getRenderObjects(), dirShadowObjects, castShadowObject,
+               getCullingCache(sceneData, camera));
+
+    if (sceneData->isHiZCullingEnabled()) {
+        sceneData->getHiZCulling()->cull(camera, sceneData->getRenderObjects());
+    }
+
+    requestStreamedMips(camera, sceneData->getRenderObjects());
+
     if (isShadowMap) {
         sceneData->setDirShadowObjects(std::move(dirShadowObjects));
         sceneData->setCastShadowObjects(std::move(castShadowObject));
     }
 }
 
+void spotLightShadowCulling(const scene::SpotLight *light, const scene::ModelBoundsArray &modelBounds, const RenderObjectList &castShadowObjects,
+                            ccstd::pmr::vector<uint8_t> &visibility, RenderObjectList &out) {
+    // batched test of the scene's world bounds against the light frustum
+    modelBounds.cull(light->getFrustum(), visibility);
+    for (const auto &ro : castShadowObjects) {
+        const auto *model = ro.model;
+        if (!model->isEnabled() || !model->isCastShadow() || !model->getNode()) {
+            continue;
+        }
+
+        const int32_t boundsIndex = model->getSceneBoundsIndex();
+        if (model->getWorldBounds() && boundsIndex >= 0 && visibility[boundsIndex]) {
+            out.emplace_back(ro);
+        }
+    }
+}
+
+void sceneCullingParallel(RenderPipeline *pipeline, const ccstd::vector<scene::Camera *> &cameras, bool cullPunctualLights,
+                          ccstd::vector<SceneCullingResult *> &results) {
+    CC_PROFILE(SceneCullingParallel);
+    const PipelineSceneData *sceneData = pipeline->getPipelineSceneData();
+    while (results.size() < cameras.size()) {
+        results.emplace_back(new SceneCullingResult());
+    }
+
+    // the shadow camera of each view updates the shared shadow info, so it is computed serially up front
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        auto *result        = results[i];
+        result->isShadowMap = prepareDirLightFrustum(pipeline, cameras[i], &result->dirLightFrustum);
+        result->renderObjects.clear();
+        result->dirShadowObjects.clear();
+        result->castShadowObjects.clear();
+        result->validPunctualLights.clear();
+        result->spotShadowObjects.clear();
+    }
+
+    // looked up ahead as the caches are created on first use
+    auto *                                  arena = FrameArena::getInstance();
+    ccstd::pmr::vector<SceneCullingCache *> caches(cameras.size(), arena);
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        caches[i] = getCullingCache(sceneData, cameras[i]);
+    }
+
+    // one job per camera, each one writes only to its own result
+    auto cameraJob = [&](uint idx) {
+        scene::Camera *camera = cameras[idx];
+        auto *         result = results[idx];
+        if (cullPunctualLights) {
+            validPunctualLightsCulling(camera, result->validPunctualLights);
+        }
+        cullModels(sceneData, camera, result->isShadowMap, result->dirLightFrustum,
+                   result->renderObjects, result->dirShadowObjects, result->castShadowObjects, caches[idx]);
+    };
+
+    JobGraph cameraGraph(JobSystem::getInstance());
+    cameraGraph.createForEachIndexJob(0U, static_cast<uint>(cameras.size()), 1U, cameraJob);
+    cameraGraph.run();
+    cameraGraph.waitForAll();
+
+    // then one job per visible spot light of each camera to gather its shadow casters
+    ccstd::pmr::vector<std::pair<uint32_t, uint32_t>> spotJobs(arena);
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        auto *result = results[i];
+        if (!result->isShadowMap) {
+            continue;
+        }
+        for (const auto *light : result->validPunctualLights) {
+            if (light->getType() == scene::LightType::SPOT) {
+                spotJobs.emplace_back(static_cast<uint32_t>(i), static_cast<uint32_t>(result->spotShadowObjects.size()));
+                result->spotShadowObjects.emplace_back(light, RenderObjectList{});
+            }
+        }
+    }
+
+    if (!spotJobs.empty()) {
+        auto spotJob = [&](uint idx) {
+            auto *      result = results[spotJobs[idx].first];
+            auto &      entry  = result->spotShadowObjects[spotJobs[idx].second];
+            const auto *light  = static_cast<const scene::SpotLight *>(entry.first);
+
+            // allocated from the arena of the job thread
+            ccstd::pmr::vector<uint8_t> visibility(FrameArena::getInstance());
+            spotLightShadowCulling(light, cameras[spotJobs[idx].first]->getScene()->getModelBounds(), result->castShadowObjects, visibility, entry.second);
+        };
+
+        JobGraph spotGraph(JobSystem::getInstance());
+        spotGraph.createForEachIndexJob(0U, static_cast<uint>(spotJobs.size()), 1U, spotJob);
+        spotGraph.run();
+        spotGraph.waitForAll();
+    }
+}
+
+void applySceneCullingResult(RenderPipeline *pipeline, scene::Camera *camera, bool cullPunctualLights, SceneCullingResult *result) {
+    PipelineSceneData *const sceneData = pipeline->getPipelineSceneData();
+    // restore the shadow info of this camera, the frustum itself was already used for culling
+    if (result->isShadowMap) {
+        geometry::Frustum dirLightFrustum;
+        prepareDirLightFrustum(pipeline, camera, &dirLightFrustum);
+    }
+
+    // swap to keep the capacity of both sides for the next frame
+    sceneData->getRenderObjects().swap(result->renderObjects);
+    if (sceneData->isHiZCullingEnabled()) {
+        sceneData->getHiZCulling()->cull(camera, sceneData->getRenderObjects());
+    }
+
+    requestStreamedMips(camera, sceneData->getRenderObjects());
+
+    if (cullPunctualLights) {
+        sceneData->setValidPunctualLights(std::move(result->validPunctualLights));
+    }
+    sceneData->setSpotShadowObjects(std::move(result->spotShadowObjects));
+
+    if (result->isShadowMap) {
+        sceneData->setDirShadowObjects(std::move(result->dirShadowObjects));
+        sceneData->setCastShadowObjects(std::move(result->castShadowObjects));
+    }
+}
+
 } // namespace pipeline
 } // namespace cc
@@ -27,6 +27,7 @@
 
 #include "core/geometry/Frustum.h"
 #include "core/geometry/Sphere.h"
+#include "math/Mat4.h"
 #include "pipeline/Define.h"
 #include "scene/Define.h"
 
@@ -38,16 +39,86 @@ namespace scene {
 class Camera;
 class Shadows;
 class Light;
+class SpotLight;
+class ModelBoundsArray;
+class Model;
+class RenderScene;
 } // namespace scene
 namespace pipeline {
 
 struct RenderObject;
 class RenderPipeline;
 
+using SpotShadowObjectList = ccstd::vector<std::pair<const scene::Light *, RenderObjectList>>;
+
+// Culling output of one camera, filled by a culling job and handed to PipelineSceneData before the camera renders.
+struct CC_DLL SceneCullingResult {
+    SceneCullingResult() = default;
+
+    RenderObjectList                    renderObjects;
+    RenderObjectList                    dirShadowObjects;
+    RenderObjectList                    castShadowObjects;
+    ccstd::vector<const scene::Light *> validPunctualLights;
+    SpotShadowObjectList                spotShadowObjects;
+    geometry::Frustum                   dirLightFrustum;
+    bool                                isShadowMap{false};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(SceneCullingResult);
+};
+
+/**
+ * @en Culling result of a camera kept from its last culled frame. The result is reused as is while the camera view, the shadow camera
+ * and the scene model states do not change, and only the moved models are tested again while just model bounds changed.
+ * Node layer changes are not tracked, call invalidate after changing the layer of a model node in a cached view.
+ * @zh 相机上一次剔除的结果。相机视图、阴影相机与场景模型状态均未变化时直接复用结果，仅模型包围盒变化时只重新测试移动过的模型。
+ * 节点层级的变化不会被追踪，修改模型节点层级后需调用 invalidate。
+ */
+struct CC_DLL SceneCullingCache {
+    // states the culling result depends on, besides the model bounds
+    struct Key {
+        const scene::RenderScene *scene{nullptr};
+        const scene::Model *      skyboxModel{nullptr};
+        // the directional shadow frustum, only set if isShadowMap
+        ccstd::array<Vec3, 8>     dirLightVertices;
+        uint32_t                  cameraVersion{0};
+        uint32_t                  visibility{0};
+        uint32_t                  modelsVersion{0};
+        uint32_t                  boundsLayoutVersion{0};
+        bool                      isShadowMap{false};
+        bool                      octreeEnabled{false};
+
+        bool operator==(const Key &rhs) const;
+        inline bool operator!=(const Key &rhs) const { return !(*this == rhs); }
+    };
+
+    SceneCullingCache() = default;
+
+    inline void invalidate() { valid = false; }
+
+    Key                         key;
+    uint32_t                    boundsVersion{0};
+    bool                        valid{false};
+    ccstd::pmr::vector<uint8_t> cameraVisibility;
+    ccstd::pmr::vector<uint8_t> dirShadowVisibility;
+    RenderObjectList            renderObjects;
+    RenderObjectList            dirShadowObjects;
+    RenderObjectList            castShadowObjects;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(SceneCullingCache);
+};
+
 RenderObject genRenderObject(const scene::Model *, const scene::Camera *);
 void         quantizeDirLightShadowCamera(RenderPipeline *pipeline, const scene::Camera *camera, geometry::Frustum *out);
 void         validPunctualLightsCulling(RenderPipeline *pipeline, scene::Camera *camera);
+void         validPunctualLightsCulling(const scene::Camera *camera, ccstd::vector<const scene::Light *> &validPunctualLights);
 void         sceneCulling(RenderPipeline *, scene::Camera *);
+void         spotLightShadowCulling(const scene::SpotLight *light, const scene::ModelBoundsArray &modelBounds, const RenderObjectList &castShadowObjects,
+                                    ccstd::pmr::vector<uint8_t> &visibility, RenderObjectList &out);
+// Cull every camera, and the shadow casters of its visible spot lights, as parallel jobs, results[i] belongs to cameras[i].
+void sceneCullingParallel(RenderPipeline *pipeline, const ccstd::vector<scene::Camera *> &cameras, bool cullPunctualLights,
+                          ccstd::vector<SceneCullingResult *> &results);
+// Hand the result of a camera culled by sceneCullingParallel to the pipeline scene data, right before the camera renders.
+void applySceneCullingResult(RenderPipeline *pipeline, scene::Camera *camera, bool cullPunctualLights, SceneCullingResult *result);
 void         updateSphereLight(scene::Shadows *shadowInfo, const scene::Light *light, ccstd::array<float, UBOShadow::COUNT> *);
 void         updateDirLight(scene::Shadows *shadowInfo, const scene::Light *light, ccstd::array<float, UBOShadow::COUNT> *);
 void         updatePlanarNormalAndDistance(scene::Shadows *shadowInfo, ccstd::array<float, UBOShadow::COUNT> *shadowUBO);
@@ -32,11 +32,13 @@
 #include "PipelineUBO.h"
 #include "RenderBatchedQueue.h"
 #include "RenderInstancedQueue.h"
+#include "SceneCulling.h"
 #include "forward/ForwardPipeline.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDescriptorSet.h"
 #include "gfx-base/GFXDevice.h"
 #include "scene/Camera.h"
+#include "scene/RenderScene.h"
 #include "scene/Shadow.h"
 #include "scene/SpotLight.h"
 
@@ -53,7 +55,7 @@ ShadowMapBatchedQueue::ShadowMapBatchedQueue(RenderPipeline *pipeline)
 
 ShadowMapBatchedQueue::~ShadowMapBatchedQueue() = default;
 
-void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const scene::Light *light, gfx::CommandBuffer *cmdBuffer) {
+void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const scene::Light *light, gfx::CommandBuffer *cmdBuffer, ShadowCasterFilter filter) {
     clear();
 
     const PipelineSceneData *sceneData  = _pipeline->getPipelineSceneData();
@@ -65,29 +67,24 @@ void ShadowMapBatchedQueue::gatherLightPasses(const scene::Camera *camera, const
             case scene::LightType::DIRECTIONAL: {
                 for (const auto ro : dirShadowObjects) {
                     const auto *model = ro.model;
+                    if (filter != ShadowCasterFilter::ALL && model->isStaticShadowCaster() != (filter == ShadowCasterFilter::STATIC)) {
+                        continue;
+                    }
                     add(model);
                 }
             } break;
 
             case scene::LightType::SPOT: {
-                const auto *spotLight     = static_cast<const scene::SpotLight *>(light);
-                const Mat4  matShadowView = light->getNode()->getWorldMatrix().getInversed();
-                Mat4        matShadowProj;
-                Mat4::createPerspective(spotLight->getSpotAngle(), spotLight->getAspect(), 0.001F, spotLight->getRange(), &matShadowProj);
-                const Mat4     matShadowViewProj = matShadowProj * matShadowView;
-                geometry::AABB ab;
-                for (const auto ro : castShadowObjects) {
-                    const auto *model = ro.model;
-                    if (!model->isEnabled() || !model->isCastShadow() || !model->getNode()) {
-                        continue;
-                    }
-
-                    if (model->getWorldBounds()) {
-                        model->getWorldBounds()->transform(matShadowViewProj, &ab);
-                        if (ab.aabbFrustum(camera->getFrustum())) {
-                            add(model);
-                        }
-                    }
+                // casters may have been gathered ahead by the parallel culling jobs
+                const RenderObjectList *casters = sceneData->getSpotShadowObjects(light);
+                if (!casters) {
+                    const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+                    _spotShadowObjects.clear();
+                    spotLightShadowCulling(spotLight, camera->getScene()->getModelBounds(), castShadowObjects, _casterVisibility, _spotShadowObjects);
+                    casters = &_spotShadowObjects;
+                }
+                for (const auto ro : *casters) {
+                    add(ro.model);
                 }
             } break;
 
@@ -133,7 +130,7 @@ void ShadowMapBatchedQueue::add(const scene::Model *model) {
             auto *batchedBuffer = BatchedBuffer::get(subModel->getPass(shadowPassIdx));
             batchedBuffer->merge(subModel, shadowPassIdx, model);
             _batchedQueue->add(batchedBuffer);
-        } else { // standard draw
+        } else if (subModel->getShader(shadowPassIdx)) { // standard draw, skipped until compiled
             _subModels.emplace_back(subModel);
             _shaders.emplace_back(subModel->getShader(shadowPassIdx));
             _passes.emplace_back(pass);
@@ -154,7 +151,7 @@ void ShadowMapBatchedQueue::recordCommandBuffer(gfx::Device *device, gfx::Render
 
         cmdBuffer->bindPipelineState(pso);
         cmdBuffer->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-        cmdBuffer->bindDescriptorSet(localSet, subModel->getDescriptorSet());
+        cmdBuffer->bindDescriptorSet(localSet, subModel->getDrawDescriptorSet());
         cmdBuffer->bindInputAssembler(ia);
         cmdBuffer->draw(ia);
     }
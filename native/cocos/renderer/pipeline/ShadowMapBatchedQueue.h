@@ -40,6 +40,13 @@ class RenderPipeline;
 
 //const uint phaseID(PassPhase::getPhaseID("shadow-caster"));
 
+// Selects the directional shadow casters to gather, static casters can be cached in a separate shadow map layer
+enum class ShadowCasterFilter {
+    ALL,
+    STATIC,
+    DYNAMIC,
+};
+
 class CC_DLL ShadowMapBatchedQueue final {
 public:
     explicit ShadowMapBatchedQueue(RenderPipeline *);
@@ -47,7 +54,7 @@ public:
     void destroy();
 
     void clear();
-    void gatherLightPasses(const scene::Camera *, const scene::Light *, gfx::CommandBuffer *);
+    void gatherLightPasses(const scene::Camera *, const scene::Light *, gfx::CommandBuffer *, ShadowCasterFilter filter = ShadowCasterFilter::ALL);
     void add(const scene::Model *);
     void recordCommandBuffer(gfx::Device *, gfx::RenderPass *, gfx::CommandBuffer *) const;
 
@@ -62,6 +69,8 @@ private:
     RenderBatchedQueue *                   _batchedQueue   = nullptr;
     gfx::Buffer *                          _buffer         = nullptr;
     uint                                   _phaseID        = 0;
+    ccstd::pmr::vector<uint8_t>            _casterVisibility;
+    RenderObjectList                       _spotShadowObjects;
 };
 
 } // namespace pipeline
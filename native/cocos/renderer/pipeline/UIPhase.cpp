@@ -41,8 +41,10 @@ void UIPhase::activate(RenderPipeline *pipeline) {
     _phaseID  = getPhaseID("default");
 };
 
-void UIPhase::render(scene::Camera *camera, gfx::RenderPass *renderPass) {
-    auto *cmdBuff = _pipeline->getCommandBuffers()[0];
+void UIPhase::render(scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff) {
+    if (!cmdBuff) {
+        cmdBuff = _pipeline->getCommandBuffers()[0];
+    }
 
     const auto &batches = camera->getScene()->getDrawBatch2Ds();
     // Notice: The batches[0] is batchCount
@@ -33,6 +33,7 @@ class Camera;
 }
 namespace gfx {
 class RenderPass;
+class CommandBuffer;
 }
 namespace pipeline {
 class RenderPipeline;
@@ -41,7 +42,8 @@ class CC_DLL UIPhase {
 public:
     UIPhase() = default;
     void activate(RenderPipeline *pipeline);
-    void render(scene::Camera *camera, gfx::RenderPass *renderPass);
+    // records into the primary command buffer of the pipeline if cmdBuff is nullptr
+    void render(scene::Camera *camera, gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff = nullptr);
 
 protected:
     RenderPipeline *_pipeline = nullptr;
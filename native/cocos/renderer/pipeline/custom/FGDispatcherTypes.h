@@ -213,6 +213,20 @@ struct BarrierNode {
     std::vector<Barrier> rearBarriers;
 };
 
+struct MergedRenderPass {
+    std::vector<RenderGraph::vertex_descriptor>   passes;
+    std::vector<ResourceGraph::vertex_descriptor> colors;
+    ResourceGraph::vertex_descriptor              depthStencil{0xFFFFFFFF};
+    gfx::RenderPassInfo                           rpInfo;
+};
+
+struct QueueSyncPoint {
+    RenderGraph::vertex_descriptor signalPass{0xFFFFFFFF};
+    RenderGraph::vertex_descriptor waitPass{0xFFFFFFFF};
+    gfx::QueueType                 signalQueue{gfx::QueueType::COMPUTE};
+    gfx::QueueType                 waitQueue{gfx::QueueType::GRAPHICS};
+};
+
 struct FrameGraphDispatcher {
     FrameGraphDispatcher(ResourceGraph& resourceGraphIn, RenderGraph& graphIn, LayoutGraphData& layoutGraphIn, boost::container::pmr::memory_resource* scratchIn) noexcept
     : resourceGraph(resourceGraphIn),
@@ -224,12 +238,23 @@ struct FrameGraphDispatcher {
     FrameGraphDispatcher& operator=(FrameGraphDispatcher&& rhs) = delete;
     FrameGraphDispatcher& operator=(FrameGraphDispatcher const& rhs) = delete;
 
-    void buildBarriers() const;
-
-    ResourceGraph&                          resourceGraph;
-    RenderGraph&                            graph;
-    LayoutGraphData&                        layoutGraph;
-    boost::container::pmr::memory_resource* scratch{nullptr};
+    void compile();
+    void buildBarriers();
+    void buildRenderPasses();
+    void buildQueueSchedule();
+
+    ResourceGraph&                                               resourceGraph;
+    RenderGraph&                                                 graph;
+    LayoutGraphData&                                             layoutGraph;
+    boost::container::pmr::memory_resource*                      scratch{nullptr};
+    FlatMap<ResourceAccessGraph::vertex_descriptor, BarrierNode> barrierMap;
+    bool                                                         enableSubpassMerge{true};
+    std::vector<MergedRenderPass>                                renderPasses;
+    bool                                                         enableAsyncCompute{false};
+    std::vector<RenderGraph::vertex_descriptor>                  asyncComputePasses;
+    std::vector<QueueSyncPoint>                                  queueSyncPoints;
+    size_t                                                       graphHash{0};
+    bool                                                         graphStable{false};
 };
 
 } // namespace render
@@ -23,6 +23,7 @@
  THE SOFTWARE.
 ****************************************************************************/
 
+#include <boost/functional/hash.hpp>
 #include <boost/graph/breadth_first_search.hpp>
 #include <boost/range/algorithm.hpp>
 #include "FGDispatcherGraphs.h"
@@ -32,6 +33,7 @@
 #include "Range.h"
 #include "RenderGraphGraphs.h"
 #include "boost/lexical_cast.hpp"
+#include "profiler/Profiler.h"
 
 namespace cc {
 
@@ -87,6 +89,19 @@ void processPresentPass(RAG &rag, const LGD &lgd, const ResourceGraph &rescGraph
 bool isPassExecAdjecent(uint32_t passL, uint32_t passR) { return (passL ^ passR) == 1; }
 bool isStatusDependent(const AccessStatus &lhs, const AccessStatus &rhs);
 
+// subpasses merged into one render pass, see FrameGraphDispatcher::buildRenderPasses
+struct SubpassMergeContext {
+    ccstd::vector<ResourceHandle> written; // attachments written by the merged subpasses
+    ccstd::vector<ResourceHandle> sampled; // resources read through compute views by the merged subpasses
+    const ResourceDesc *          area{nullptr};
+    bool                          closed{false};
+};
+
+bool canMergeRasterPass(const ResourceGraph &rescGraph, const SubpassMergeContext &ctx, const MergedRenderPass &rp, const RasterPass &pass);
+void appendSubpass(const ResourceGraph &rescGraph, SubpassMergeContext &ctx, MergedRenderPass &rp, RenderGraph::vertex_descriptor passID, const RasterPass &pass);
+void optimizeLoadStoreOps(const RAG &rag, const ResourceGraph &rescGraph, MergedRenderPass &rp);
+size_t computeGraphHash(const RenderGraph &renderGraph, const ResourceGraph &rescGraph);
+
 #pragma endregion predefine
 
 #pragma region graphProcess
@@ -411,7 +426,25 @@ struct BarrierVisitor : public boost::bfs_visitor<> {
     PmrFlatSet<PmrString> externalResNames; //first meet in this frame
 };
 
-void FrameGraphDispatcher::buildBarriers() const {
+void FrameGraphDispatcher::compile() {
+    CC_PROFILE(RenderGraphCompile);
+
+    // the compiled results only depend on the graph structure, per frame data (cameras, buffers)
+    // is read when the passes execute. The barriers of external resources also depend on the
+    // last frame, so a graph is compiled twice before its results are reused.
+    const size_t hash = computeGraphHash(graph, resourceGraph);
+    if (hash == graphHash && graphStable) {
+        return;
+    }
+    graphStable = hash == graphHash;
+    graphHash   = hash;
+
+    buildBarriers();
+    buildRenderPasses();
+    buildQueueSchedule();
+}
+
+void FrameGraphDispatcher::buildBarriers() {
     {
         // record resource current in-access and out-access for every single node
         ResourceAccessGraph rag(scratch);
@@ -420,12 +453,12 @@ void FrameGraphDispatcher::buildBarriers() const {
 
         // found pass id in this map ? barriers you should commit when run into this pass
         // : or no extra barrier needed.
-        BarrierMap batchedBarriers;
+        barrierMap.clear();
 
         static ExternalResMap externalMap;
 
         {
-            BarrierVisitor             visitor(resourceGraph, batchedBarriers, externalMap);
+            BarrierVisitor             visitor(resourceGraph, barrierMap, externalMap);
             auto                       colors = rag.colors(scratch);
             boost::queue<AccessVertex> q;
 
@@ -438,6 +471,100 @@ void FrameGraphDispatcher::buildBarriers() const {
         }
     }
 }
+
+void FrameGraphDispatcher::buildRenderPasses() {
+    renderPasses.clear();
+
+    ResourceAccessGraph rag(scratch);
+    buildAccessGraph(graph, layoutGraph, resourceGraph, rag);
+
+    // rag vertices follow the execution order, adjacent raster passes are merged as subpasses
+    // as long as every pixel only reads what the earlier subpasses wrote at the same location.
+    SubpassMergeContext ctx;
+    MergedRenderPass *  current = nullptr;
+    for (AccessVertex vertID = EXPECT_START_ID + 1; vertID < num_vertices(rag); ++vertID) {
+        const auto passID = get(RAG::PassID, rag, vertID);
+        if (!holds<RasterTag>(passID, graph)) {
+            current = nullptr;
+            continue;
+        }
+        const auto &pass = get(RasterTag{}, passID, graph);
+        if (!current || !enableSubpassMerge || !canMergeRasterPass(resourceGraph, ctx, *current, pass)) {
+            renderPasses.emplace_back();
+            current = &renderPasses.back();
+            ctx     = {};
+        }
+        appendSubpass(resourceGraph, ctx, *current, passID, pass);
+    }
+
+    for (auto &rp : renderPasses) {
+        optimizeLoadStoreOps(rag, resourceGraph, rp);
+    }
+}
+
+void FrameGraphDispatcher::buildQueueSchedule() {
+    asyncComputePasses.clear();
+    queueSyncPoints.clear();
+    if (!enableAsyncCompute) {
+        return;
+    }
+
+    ResourceAccessGraph rag(scratch);
+    buildAccessGraph(graph, layoutGraph, resourceGraph, rag);
+
+    // compute passes only depending on other async compute passes leave the graphics queue,
+    // rag vertices follow the execution order so producers are always decided first.
+    const auto          numVertices = num_vertices(rag);
+    ccstd::vector<bool> isAsync(numVertices, false);
+    for (AccessVertex vertID = EXPECT_START_ID + 1; vertID < numVertices; ++vertID) {
+        if (!holds<ComputeTag>(get(RAG::PassID, rag, vertID), graph)) {
+            continue;
+        }
+        bool independent = true;
+        for (const auto e : makeRange(in_edges(vertID, rag))) {
+            const auto from = source(e, rag);
+            if (from != EXPECT_START_ID && !isAsync[from]) {
+                independent = false;
+                break;
+            }
+        }
+        isAsync[vertID] = independent;
+    }
+
+    // graphics passes waiting on async compute results, one wait per graphics pass on its latest producer
+    ccstd::vector<std::pair<AccessVertex /*signal*/, AccessVertex /*wait*/>> syncs;
+    for (AccessVertex vertID = EXPECT_START_ID + 1; vertID < numVertices; ++vertID) {
+        if (isAsync[vertID]) {
+            asyncComputePasses.emplace_back(get(RAG::PassID, rag, vertID));
+            continue;
+        }
+        AccessVertex producer = INVALID_ID;
+        for (const auto e : makeRange(in_edges(vertID, rag))) {
+            const auto from = source(e, rag);
+            if (isAsync[from] && (producer == INVALID_ID || from > producer)) {
+                producer = from;
+            }
+        }
+        if (producer != INVALID_ID) {
+            syncs.emplace_back(producer, vertID);
+        }
+    }
+
+    // both queues execute in order, a wait already covered by an earlier wait on a later signal is dropped
+    AccessVertex lastSignal = INVALID_ID;
+    for (const auto &sync : syncs) {
+        if (lastSignal != INVALID_ID && sync.first <= lastSignal) {
+            continue;
+        }
+        lastSignal = sync.first;
+        queueSyncPoints.emplace_back(QueueSyncPoint{
+            get(RAG::PassID, rag, sync.first),
+            get(RAG::PassID, rag, sync.second),
+            gfx::QueueType::COMPUTE,
+            gfx::QueueType::GRAPHICS,
+        });
+    }
+}
 #pragma endregion graphProcess
 
 #pragma region assisstantFuncDefinition
@@ -696,6 +823,246 @@ void processPresentPass(RAG &rag, const LGD &lgd, const ResourceGraph &rescGraph
     }
 }
 
+// depth stencil index of the subpasses, rebased once all color attachments are known
+constexpr uint32_t DEPTH_STENCIL_PLACEHOLDER = gfx::INVALID_BINDING - 1;
+
+bool hasResource(const ccstd::vector<ResourceHandle> &handles, ResourceHandle rescID) {
+    return std::find(handles.begin(), handles.end(), rescID) != handles.end();
+}
+
+bool canMergeRasterPass(const ResourceGraph &rescGraph, const SubpassMergeContext &ctx, const MergedRenderPass &rp, const RasterPass &pass) {
+    // passes with their own subpasses are built as they are
+    if (ctx.closed || !ctx.area || !pass.subpassGraph.subpasses.empty()) {
+        return false;
+    }
+    for (const auto &pair : pass.rasterViews) {
+        const auto &rasterView = pair.second;
+        const auto  rescID     = rescGraph.valueIndex.at(rasterView.slotName);
+        const auto &desc       = get(ResourceGraph::Desc, rescGraph, rescID);
+        // subpasses share the render area and sample count
+        if (desc.width != ctx.area->width || desc.height != ctx.area->height || desc.sampleCount != ctx.area->sampleCount) {
+            return false;
+        }
+        const bool isDepthStencil = rasterView.attachmentType == AttachmentType::DEPTH_STENCIL;
+        if (isDepthStencil && rp.depthStencil != INVALID_ID && rp.depthStencil != rescID) {
+            return false;
+        }
+        // attachments are only cleared when the render pass begins
+        const bool isAttachment = isDepthStencil ? rp.depthStencil == rescID : hasResource(rp.colors, rescID);
+        if (isAttachment && rasterView.loadOp == gfx::LoadOp::CLEAR) {
+            return false;
+        }
+        if (rasterView.accessType != AccessType::READ && hasResource(ctx.sampled, rescID)) {
+            return false;
+        }
+    }
+    for (const auto &pair : pass.computeViews) {
+        for (const auto &computeView : pair.second) {
+            // sampled at arbitrary texels, the attachment has to be stored first
+            if (hasResource(ctx.written, rescGraph.valueIndex.at(computeView.name))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void appendSubpass(const ResourceGraph &rescGraph, SubpassMergeContext &ctx, MergedRenderPass &rp, RenderGraph::vertex_descriptor passID, const RasterPass &pass) {
+    rp.passes.emplace_back(passID);
+    if (!pass.subpassGraph.subpasses.empty()) {
+        ctx.closed = true;
+        return;
+    }
+
+    gfx::SubpassInfo subpass;
+    for (const auto &pair : pass.rasterViews) {
+        const auto &rasterView = pair.second;
+        const auto  rescID     = rescGraph.valueIndex.at(rasterView.slotName);
+        const auto &desc       = get(ResourceGraph::Desc, rescGraph, rescID);
+        if (!ctx.area) {
+            ctx.area = &desc;
+        }
+        if (rasterView.accessType != AccessType::READ && !hasResource(ctx.written, rescID)) {
+            ctx.written.emplace_back(rescID);
+        }
+
+        uint32_t index = DEPTH_STENCIL_PLACEHOLDER;
+        if (rasterView.attachmentType == AttachmentType::DEPTH_STENCIL) {
+            auto &depthStencil = rp.rpInfo.depthStencilAttachment;
+            if (rp.depthStencil == INVALID_ID) {
+                rp.depthStencil            = rescID;
+                depthStencil.format        = desc.format;
+                depthStencil.sampleCount   = desc.sampleCount;
+                depthStencil.depthLoadOp   = rasterView.loadOp;
+                depthStencil.stencilLoadOp = rasterView.loadOp;
+            }
+            depthStencil.depthStoreOp   = rasterView.storeOp;
+            depthStencil.stencilStoreOp = rasterView.storeOp;
+            subpass.depthStencil        = DEPTH_STENCIL_PLACEHOLDER;
+        } else {
+            index = static_cast<uint32_t>(std::find(rp.colors.begin(), rp.colors.end(), rescID) - rp.colors.begin());
+            if (index == rp.colors.size()) {
+                rp.colors.emplace_back(rescID);
+                gfx::ColorAttachment color;
+                color.format      = desc.format;
+                color.sampleCount = desc.sampleCount;
+                color.loadOp      = rasterView.loadOp;
+                rp.rpInfo.colorAttachments.emplace_back(color);
+            }
+            rp.rpInfo.colorAttachments[index].storeOp = rasterView.storeOp;
+            if (rasterView.accessType != AccessType::READ) {
+                subpass.colors.emplace_back(index);
+            }
+        }
+        // read in place, as input attachment or through framebuffer fetch depending on the backend
+        if (rasterView.accessType != AccessType::WRITE) {
+            subpass.inputs.emplace_back(index);
+        }
+    }
+    for (const auto &pair : pass.computeViews) {
+        for (const auto &computeView : pair.second) {
+            const auto rescID = rescGraph.valueIndex.at(computeView.name);
+            if (!hasResource(ctx.sampled, rescID)) {
+                ctx.sampled.emplace_back(rescID);
+            }
+        }
+    }
+    rp.rpInfo.subpasses.emplace_back(std::move(subpass));
+}
+
+bool isAccessedBetween(const RAG &rag, ResourceHandle rescID, AccessVertex first, AccessVertex last) {
+    for (AccessVertex vertID = first; vertID < last; ++vertID) {
+        const auto &status = get(RAG::AccessNode, rag, vertID).attachemntStatus;
+        if (std::any_of(status.begin(), status.end(), [rescID](const AccessStatus &access) { return access.vertID == rescID; })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void optimizeLoadStoreOps(const RAG &rag, const ResourceGraph &rescGraph, MergedRenderPass &rp) {
+    if (rp.rpInfo.subpasses.empty()) {
+        return;
+    }
+
+    const auto depthStencilIndex = static_cast<uint32_t>(rp.colors.size());
+    for (auto &subpass : rp.rpInfo.subpasses) {
+        if (subpass.depthStencil == DEPTH_STENCIL_PLACEHOLDER) {
+            subpass.depthStencil = depthStencilIndex;
+        }
+        std::replace(subpass.inputs.begin(), subpass.inputs.end(), DEPTH_STENCIL_PLACEHOLDER, depthStencilIndex);
+    }
+
+    // contents of transient attachments never leave the tile memory unless another pass of this frame accesses them
+    const AccessVertex first = vertex(rp.passes.front(), rag);
+    const AccessVertex last  = vertex(rp.passes.back(), rag) + 1;
+    auto               needs = [&](ResourceHandle rescID, bool before) {
+        const auto &traits = get(ResourceGraph::Traits, rescGraph, rescID);
+        if (traits.residency == ResourceResidency::MEMORYLESS) {
+            return false;
+        }
+        if (traits.hasSideEffects()) {
+            return true;
+        }
+        return before ? isAccessedBetween(rag, rescID, EXPECT_START_ID + 1, first) : isAccessedBetween(rag, rescID, last, num_vertices(rag));
+    };
+
+    for (uint32_t i = 0; i < rp.colors.size(); ++i) {
+        auto &color = rp.rpInfo.colorAttachments[i];
+        if (color.loadOp == gfx::LoadOp::LOAD && !needs(rp.colors[i], true)) {
+            color.loadOp = gfx::LoadOp::DISCARD;
+        }
+        color.storeOp = needs(rp.colors[i], false) ? gfx::StoreOp::STORE : gfx::StoreOp::DISCARD;
+    }
+    if (rp.depthStencil != INVALID_ID) {
+        auto &depthStencil = rp.rpInfo.depthStencilAttachment;
+        if (depthStencil.depthLoadOp == gfx::LoadOp::LOAD && !needs(rp.depthStencil, true)) {
+            depthStencil.depthLoadOp   = gfx::LoadOp::DISCARD;
+            depthStencil.stencilLoadOp = gfx::LoadOp::DISCARD;
+        }
+        depthStencil.depthStoreOp   = needs(rp.depthStencil, false) ? gfx::StoreOp::STORE : gfx::StoreOp::DISCARD;
+        depthStencil.stencilStoreOp = depthStencil.depthStoreOp;
+    }
+}
+
+void hashResource(size_t &seed, const ResourceGraph &rescGraph, const PmrString &name) {
+    const auto  rescID = rescGraph.valueIndex.at(name);
+    const auto &desc   = get(ResourceGraph::Desc, rescGraph, rescID);
+    boost::hash_combine(seed, rescID);
+    boost::hash_combine(seed, desc.width);
+    boost::hash_combine(seed, desc.height);
+    boost::hash_combine(seed, desc.format);
+    boost::hash_combine(seed, desc.sampleCount);
+    boost::hash_combine(seed, get(ResourceGraph::Traits, rescGraph, rescID).residency);
+}
+
+void hashComputeViews(size_t &seed, const ResourceGraph &rescGraph, const PmrTransparentMap<PmrString, ccstd::pmr::vector<ComputeView>> &computeViews) {
+    for (const auto &pair : computeViews) {
+        boost::hash_range(seed, pair.first.begin(), pair.first.end());
+        for (const auto &computeView : pair.second) {
+            hashResource(seed, rescGraph, computeView.name);
+            boost::hash_combine(seed, computeView.accessType);
+        }
+    }
+}
+
+// everything the access graph, barriers and render passes are built from
+size_t computeGraphHash(const RenderGraph &renderGraph, const ResourceGraph &rescGraph) {
+    size_t seed = 0;
+    for (const auto passID : makeRange(vertices(renderGraph))) {
+        boost::hash_combine(seed, passID);
+        visitObject(
+            passID, renderGraph,
+            [&](const RasterPass &pass) {
+                boost::hash_combine(seed, PassType::RASTER);
+                for (const auto &pair : pass.rasterViews) {
+                    const auto &rasterView = pair.second;
+                    boost::hash_range(seed, pair.first.begin(), pair.first.end());
+                    hashResource(seed, rescGraph, rasterView.slotName);
+                    boost::hash_combine(seed, rasterView.accessType);
+                    boost::hash_combine(seed, rasterView.attachmentType);
+                    boost::hash_combine(seed, rasterView.loadOp);
+                    boost::hash_combine(seed, rasterView.storeOp);
+                }
+                hashComputeViews(seed, rescGraph, pass.computeViews);
+                boost::hash_combine(seed, pass.subpassGraph.subpasses.size());
+            },
+            [&](const ComputePass &pass) {
+                boost::hash_combine(seed, PassType::COMPUTE);
+                hashComputeViews(seed, rescGraph, pass.computeViews);
+            },
+            [&](const CopyPass &pass) {
+                boost::hash_combine(seed, PassType::COPY);
+                for (const auto &pair : pass.copyPairs) {
+                    hashResource(seed, rescGraph, pair.source);
+                    hashResource(seed, rescGraph, pair.target);
+                    boost::hash_combine(seed, pair.mipLevels);
+                    boost::hash_combine(seed, pair.numSlices);
+                    boost::hash_combine(seed, pair.sourceMostDetailedMip);
+                    boost::hash_combine(seed, pair.sourceFirstSlice);
+                    boost::hash_combine(seed, pair.sourcePlaneSlice);
+                    boost::hash_combine(seed, pair.targetMostDetailedMip);
+                    boost::hash_combine(seed, pair.targetFirstSlice);
+                    boost::hash_combine(seed, pair.targetPlaneSlice);
+                }
+            },
+            [&](const RaytracePass &pass) {
+                boost::hash_combine(seed, PassType::RAYTRACE);
+                hashComputeViews(seed, rescGraph, pass.computeViews);
+            },
+            [&](const PresentPass &pass) {
+                boost::hash_combine(seed, PassType::PRESENT);
+                for (const auto &pair : pass.presents) {
+                    hashResource(seed, rescGraph, pair.first);
+                }
+            },
+            [&](const auto & /*pass*/) {
+                boost::hash_combine(seed, PassType::MOVE);
+            });
+    }
+    return seed;
+}
+
 #pragma endregion assisstantFuncDefinition
 
 } // namespace render
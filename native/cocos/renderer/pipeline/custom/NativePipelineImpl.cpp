@@ -38,6 +38,7 @@
 #include "cocos/scene/RenderWindow.h"
 #include "gfx-base/GFXDevice.h"
 #include "profiler/DebugRenderer.h"
+#include "profiler/Profiler.h"
 
 namespace cc {
 
@@ -256,7 +257,10 @@ void NativePipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
         frameGraph.presentFromBlackboard(colorHandle,
                                          camera->getWindow()->getFramebuffer()->getColorTextures()[0], true);
     }
-    frameGraph.compile();
+    {
+        CC_PROFILE(NativePipelineCompileGraph);
+        frameGraph.compile();
+    }
     frameGraph.execute();
     frameGraph.reset();
 
@@ -0,0 +1,283 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "BloomComp.h"
+#include "base/StringUtil.h"
+#include "gfx-base/GFXDevice.h"
+
+namespace cc {
+namespace pipeline {
+namespace {
+// every downsample group covers a 32x32 tile of the first level with 8x8 threads
+constexpr uint DOWNSAMPLE_TILE_SIZE  = 32;
+constexpr uint DOWNSAMPLE_GROUP_SIDE = 8;
+// every upsample thread writes 2x2 output texels
+constexpr uint UPSAMPLE_GROUP_SIZE  = 8;
+constexpr uint UPSAMPLE_TEXELS_SIDE = 2;
+
+const char *downsampleShaderBody = R"(
+    // first level texels of the tile packed as half floats, rg in x and b in y
+    shared uvec2 tile[1024];
+
+    vec3 reduced[4];
+
+    vec3 loadTile(ivec2 p) {
+        uvec2 v = tile[p.y * 32 + p.x];
+        return vec3(unpackHalf2x16(v.x), unpackHalf2x16(v.y).x);
+    }
+
+    void storeTile(ivec2 p, vec3 c) {
+        tile[p.y * 32 + p.x] = uvec2(packHalf2x16(c.rg), packHalf2x16(vec2(c.b, 0.0)));
+    }
+
+    vec3 downsample4taps(vec2 uv, vec2 halfpixel) {
+        vec3 sum = textureLod(inputTex, uv + vec2(-halfpixel.x, halfpixel.y), 0.0).rgb;
+        sum += textureLod(inputTex, uv + vec2(halfpixel.x, halfpixel.y), 0.0).rgb;
+        sum += textureLod(inputTex, uv + vec2(halfpixel.x, -halfpixel.y), 0.0).rgb;
+        sum += textureLod(inputTex, uv + vec2(-halfpixel.x, -halfpixel.y), 0.0).rgb;
+        return sum * 0.25;
+    }
+
+    // the next level has size x size texels, each thread averages up to 4 of them
+    void reduceLoad(uint size) {
+        for (uint i = 0u; i < 4u; ++i) {
+            uint index = gl_LocalInvocationIndex + i * 64u;
+            if (index < size * size) {
+                ivec2 p    = ivec2(index % size, index / size) * 2;
+                reduced[i] = (loadTile(p) + loadTile(p + ivec2(1, 0)) + loadTile(p + ivec2(0, 1)) + loadTile(p + ivec2(1, 1))) * 0.25;
+            }
+        }
+    }
+
+    void reduceStore(uint size) {
+        for (uint i = 0u; i < 4u; ++i) {
+            uint index = gl_LocalInvocationIndex + i * 64u;
+            if (index < size * size) {
+                storeTile(ivec2(index % size, index / size), reduced[i]);
+            }
+        }
+    }
+
+    void main() {
+        ivec2 inputSize = textureSize(inputTex, 0);
+        vec2  halfpixel = 1.0 / vec2(inputSize);
+        vec2  levelSize = vec2(max(inputSize / 2, ivec2(1)));
+        ivec2 local     = ivec2(gl_LocalInvocationID.xy) * 4;
+        ivec2 origin    = ivec2(gl_WorkGroupID.xy) * 32 + local;
+        for (int j = 0; j < 4; ++j) {
+            for (int i = 0; i < 4; ++i) {
+                vec2 uv = (vec2(origin + ivec2(i, j)) + 0.5) / levelSize;
+                storeTile(local + ivec2(i, j), downsample4taps(uv, halfpixel));
+            }
+        }
+        barrier();
+
+        // barriers are not allowed in control flow, so the levels are unrolled
+    #if BLOOM_LEVELS > 1
+        reduceLoad(16u);
+        barrier();
+        reduceStore(16u);
+        barrier();
+    #endif
+    #if BLOOM_LEVELS > 2
+        reduceLoad(8u);
+        barrier();
+        reduceStore(8u);
+        barrier();
+    #endif
+    #if BLOOM_LEVELS > 3
+        reduceLoad(4u);
+        barrier();
+        reduceStore(4u);
+        barrier();
+    #endif
+    #if BLOOM_LEVELS > 4
+        reduceLoad(2u);
+        barrier();
+        reduceStore(2u);
+        barrier();
+    #endif
+    #if BLOOM_LEVELS > 5
+        reduceLoad(1u);
+        barrier();
+        reduceStore(1u);
+        barrier();
+    #endif
+
+        uint  size       = uint(BLOOM_TILE_SIZE);
+        ivec2 outputSize = imageSize(outputTex);
+        for (uint i = 0u; i < 4u; ++i) {
+            uint index = gl_LocalInvocationIndex + i * 64u;
+            if (index < size * size) {
+                ivec2 p   = ivec2(index % size, index / size);
+                ivec2 dst = ivec2(gl_WorkGroupID.xy) * int(size) + p;
+                if (all(lessThan(dst, outputSize))) {
+                    imageStore(outputTex, dst, vec4(loadTile(p), 1.0));
+                }
+            }
+        }
+    })";
+
+// same weights as the 4 taps upsample fragment shader, evaluated from the 3x3 texels around one input texel
+const char *upsampleShaderBody = R"(
+    void main() {
+        ivec2 q          = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 outputSize = imageSize(outputTex);
+        if (any(greaterThanEqual(q * 2, outputSize))) return;
+
+        ivec2 inputSize = textureSize(inputTex, 0);
+        vec3  texels[9];
+        for (int y = 0; y < 3; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                ivec2 p           = clamp(q + ivec2(x - 1, y - 1), ivec2(0), inputSize - 1);
+                texels[y * 3 + x] = texelFetch(inputTex, p, 0).rgb;
+            }
+        }
+
+        // 1D weights of the even and odd output texels
+        vec3 weights[2];
+        weights[0] = vec3(0.375, 0.5, 0.125);
+        weights[1] = vec3(0.125, 0.5, 0.375);
+        for (int j = 0; j < 2; ++j) {
+            for (int i = 0; i < 2; ++i) {
+                ivec2 dst = q * 2 + ivec2(i, j);
+                if (any(greaterThanEqual(dst, outputSize))) continue;
+
+                vec3 sum = vec3(0.0);
+                for (int y = 0; y < 3; ++y) {
+                    for (int x = 0; x < 3; ++x) {
+                        sum += texels[y * 3 + x] * (weights[i][x] * weights[j][y]);
+                    }
+                }
+                imageStore(outputTex, dst, vec4(sum, 1.0));
+            }
+        }
+    })";
+
+const char *glsl4Header = R"(
+    layout(local_size_x = %d, local_size_y = %d, local_size_z = 1) in;
+    layout(set = 0, binding = 0) uniform sampler2D inputTex;
+    layout(set = 0, binding = 1, rgba16f) writeonly uniform mediump image2D outputTex;
+)";
+
+const char *glsl3Header = R"(
+    layout(local_size_x = %d, local_size_y = %d, local_size_z = 1) in;
+    uniform sampler2D inputTex;
+    layout(rgba16f) writeonly uniform mediump image2D outputTex;
+)";
+
+gfx::Shader *createShader(gfx::Device *device, const ccstd::string &name, const ccstd::string &defines, uint groupSize, const char *body) {
+    const char *header = device->getGfxAPI() == gfx::API::GLES3 ? glsl3Header : glsl4Header;
+
+    gfx::ShaderInfo shaderInfo;
+    shaderInfo.name            = name;
+    shaderInfo.stages          = {{gfx::ShaderStageFlagBit::COMPUTE, defines + StringUtil::format(header, groupSize, groupSize) + body}};
+    shaderInfo.samplerTextures = {{0, 0, "inputTex", gfx::Type::SAMPLER2D, 1}};
+    shaderInfo.images          = {{0, 1, "outputTex", gfx::Type::IMAGE2D, 1, gfx::MemoryAccessBit::WRITE_ONLY}};
+    return device->createShader(shaderInfo);
+}
+} // namespace
+
+BloomComp::~BloomComp() {
+    for (uint i = 0; i < MAX_BLOOM_FILTER_PASS_NUM; ++i) {
+        CC_SAFE_DESTROY_AND_DELETE(_downsamplePipelineStates[i]);
+        CC_SAFE_DESTROY_AND_DELETE(_downsampleShaders[i]);
+        CC_SAFE_DESTROY_AND_DELETE(_upsampleDescriptorSets[i]);
+    }
+    CC_SAFE_DESTROY_AND_DELETE(_downsampleDescriptorSet);
+    CC_SAFE_DESTROY_AND_DELETE(_upsamplePipelineState);
+    CC_SAFE_DESTROY_AND_DELETE(_upsampleShader);
+    CC_SAFE_DESTROY_AND_DELETE(_pipelineLayout);
+    CC_SAFE_DESTROY_AND_DELETE(_descriptorSetLayout);
+}
+
+bool BloomComp::isSupported(const gfx::Device *device) {
+    const auto api = device->getGfxAPI();
+    if (api != gfx::API::GLES3 && api != gfx::API::VULKAN && api != gfx::API::METAL) return false;
+    if (!device->hasFeature(gfx::Feature::COMPUTE_SHADER)) return false;
+
+    const auto &caps = device->getCapabilities();
+    return hasFlag(device->getFormatFeatures(gfx::Format::RGBA16F), gfx::FormatFeature::STORAGE_TEXTURE) &&
+           caps.maxComputeWorkGroupInvocations >= DOWNSAMPLE_GROUP_SIDE * DOWNSAMPLE_GROUP_SIDE;
+}
+
+void BloomComp::init(gfx::Device *device) {
+    _device = device;
+
+    gfx::DescriptorSetLayoutInfo dslInfo;
+    dslInfo.bindings.push_back({0, gfx::DescriptorType::SAMPLER_TEXTURE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    dslInfo.bindings.push_back({1, gfx::DescriptorType::STORAGE_IMAGE, 1, gfx::ShaderStageFlagBit::COMPUTE});
+    _descriptorSetLayout = _device->createDescriptorSetLayout(dslInfo);
+    _pipelineLayout      = _device->createPipelineLayout({{_descriptorSetLayout}});
+
+    _downsampleDescriptorSet = _device->createDescriptorSet({_descriptorSetLayout});
+    for (auto &set : _upsampleDescriptorSets) {
+        set = _device->createDescriptorSet({_descriptorSetLayout});
+    }
+
+    _upsampleShader = createShader(_device, "Compute BloomUpsample", "", UPSAMPLE_GROUP_SIZE, upsampleShaderBody);
+
+    gfx::PipelineStateInfo pipelineInfo;
+    pipelineInfo.shader         = _upsampleShader;
+    pipelineInfo.pipelineLayout = _pipelineLayout;
+    pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+    _upsamplePipelineState      = _device->createPipelineState(pipelineInfo);
+
+    _barrierBeforeWrite   = _device->getTextureBarrier({gfx::AccessFlagBit::NONE, gfx::AccessFlagBit::COMPUTE_SHADER_WRITE});
+    _barrierAfterWrite    = _device->getTextureBarrier({gfx::AccessFlagBit::COMPUTE_SHADER_WRITE, gfx::AccessFlagBit::COMPUTE_SHADER_READ_TEXTURE});
+    _barrierBeforeCombine = _device->getTextureBarrier({gfx::AccessFlagBit::COMPUTE_SHADER_WRITE, gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE});
+}
+
+const gfx::PipelineState *BloomComp::getDownsamplePipelineState(uint levels) {
+    CC_ASSERT(levels > 0 && levels <= MAX_BLOOM_FILTER_PASS_NUM);
+    auto *&pso = _downsamplePipelineStates[levels - 1];
+    if (!pso) {
+        const ccstd::string defines = StringUtil::format("#define BLOOM_LEVELS %d\n#define BLOOM_TILE_SIZE %d\n",
+                                                         levels, DOWNSAMPLE_TILE_SIZE >> (levels - 1));
+        auto *&shader = _downsampleShaders[levels - 1];
+        shader        = createShader(_device, "Compute BloomDownsample", defines, DOWNSAMPLE_GROUP_SIDE, downsampleShaderBody);
+
+        gfx::PipelineStateInfo pipelineInfo;
+        pipelineInfo.shader         = shader;
+        pipelineInfo.pipelineLayout = _pipelineLayout;
+        pipelineInfo.bindPoint      = gfx::PipelineBindPoint::COMPUTE;
+        pso                         = _device->createPipelineState(pipelineInfo);
+    }
+    return pso;
+}
+
+gfx::DispatchInfo BloomComp::getDownsampleDispatchInfo(uint inputWidth, uint inputHeight) {
+    const uint levelWidth  = std::max(inputWidth >> 1, 1U);
+    const uint levelHeight = std::max(inputHeight >> 1, 1U);
+    return {(levelWidth - 1) / DOWNSAMPLE_TILE_SIZE + 1, (levelHeight - 1) / DOWNSAMPLE_TILE_SIZE + 1, 1};
+}
+
+gfx::DispatchInfo BloomComp::getUpsampleDispatchInfo(uint outputWidth, uint outputHeight) {
+    const uint groupTexels = UPSAMPLE_GROUP_SIZE * UPSAMPLE_TEXELS_SIDE;
+    return {(outputWidth - 1) / groupTexels + 1, (outputHeight - 1) / groupTexels + 1, 1};
+}
+
+} // namespace pipeline
+} // namespace cc
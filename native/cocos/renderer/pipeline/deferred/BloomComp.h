@@ -0,0 +1,93 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "BloomStage.h"
+#include "base/std/container/array.h"
+#include "renderer/gfx-base/GFXDef.h"
+
+namespace cc {
+namespace gfx {
+class Device;
+class Shader;
+class DescriptorSetLayout;
+class PipelineLayout;
+class PipelineState;
+class DescriptorSet;
+} // namespace gfx
+
+namespace pipeline {
+
+/**
+ * @en Compute shader resources of the bloom blur chain. The whole downsample chain is reduced in a single dispatch
+ * through group shared memory, and every upsample level is a tent filtered dispatch without render pass setup.
+ * @zh 泛光模糊链的计算着色器资源。整个降采样链通过组共享内存在一次 dispatch 中完成，每一级升采样都是无需渲染通道的帐篷滤波 dispatch。
+ */
+class BloomComp {
+public:
+    BloomComp() = default;
+    ~BloomComp();
+
+    static bool isSupported(const gfx::Device *device);
+
+    void init(gfx::Device *device);
+
+    // levels is the number of times the input is halved, the pipeline is created on first use
+    const gfx::PipelineState *getDownsamplePipelineState(uint levels);
+    inline const gfx::PipelineState *getUpsamplePipelineState() const { return _upsamplePipelineState; }
+    inline gfx::DescriptorSet *      getDownsampleDescriptorSet() const { return _downsampleDescriptorSet; }
+    inline gfx::DescriptorSet *      getUpsampleDescriptorSet(uint index) const { return _upsampleDescriptorSets[index]; }
+
+    inline gfx::TextureBarrier *getBarrierBeforeWrite() const { return _barrierBeforeWrite; }
+    inline gfx::TextureBarrier *getBarrierAfterWrite() const { return _barrierAfterWrite; }
+    inline gfx::TextureBarrier *getBarrierBeforeCombine() const { return _barrierBeforeCombine; }
+
+    // inputWidth and inputHeight are the size of the texture fed to the downsample chain
+    static gfx::DispatchInfo getDownsampleDispatchInfo(uint inputWidth, uint inputHeight);
+    // outputWidth and outputHeight are the size of the upsampled texture
+    static gfx::DispatchInfo getUpsampleDispatchInfo(uint outputWidth, uint outputHeight);
+
+private:
+    gfx::Device *_device{nullptr};
+
+    gfx::DescriptorSetLayout *_descriptorSetLayout{nullptr};
+    gfx::PipelineLayout *     _pipelineLayout{nullptr};
+
+    ccstd::array<gfx::Shader *, MAX_BLOOM_FILTER_PASS_NUM>        _downsampleShaders{};
+    ccstd::array<gfx::PipelineState *, MAX_BLOOM_FILTER_PASS_NUM> _downsamplePipelineStates{};
+    gfx::DescriptorSet *                                          _downsampleDescriptorSet{nullptr};
+
+    gfx::Shader *                                                 _upsampleShader{nullptr};
+    gfx::PipelineState *                                          _upsamplePipelineState{nullptr};
+    ccstd::array<gfx::DescriptorSet *, MAX_BLOOM_FILTER_PASS_NUM> _upsampleDescriptorSets{};
+
+    gfx::TextureBarrier *_barrierBeforeWrite{nullptr};
+    gfx::TextureBarrier *_barrierAfterWrite{nullptr};
+    gfx::TextureBarrier *_barrierBeforeCombine{nullptr};
+};
+
+} // namespace pipeline
+} // namespace cc
@@ -25,6 +25,7 @@
  ****************************************************************************/
 
 #include "BloomStage.h"
+#include "BloomComp.h"
 #include "../PipelineStateManager.h"
 #include "../PipelineUBO.h"
 #include "../RenderPipeline.h"
@@ -106,6 +107,7 @@ void BloomStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
 }
 
 void BloomStage::destroy() {
+    CC_SAFE_DELETE(_bloomComp);
     CC_SAFE_DELETE(_prefilterUBO);
     CC_SAFE_DELETE(_combineUBO);
     for (int i = 0; i < MAX_BLOOM_FILTER_PASS_NUM; ++i) {
@@ -153,6 +155,18 @@ void BloomStage::render(scene::Camera *camera) {
     colorAttachmentInfo.clearColor  = _clearColors[0];
     colorAttachmentInfo.endAccesses = gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE;
 
+    const bool useCompute = _computeEnabled && BloomComp::isSupported(_device);
+    if (useCompute && !_bloomComp) {
+        _bloomComp = CC_NEW(BloomComp);
+        _bloomComp->init(_device);
+    }
+
+    // the prefilter texture is read by the compute chain
+    framegraph::RenderTargetAttachment::Descriptor prefilterAttachmentInfo = colorAttachmentInfo;
+    if (useCompute) {
+        prefilterAttachmentInfo.endAccesses = gfx::AccessFlagBit::COMPUTE_SHADER_READ_TEXTURE;
+    }
+
     uint insertPoint = static_cast<uint>(CommonInsertPoint::DIP_BLOOM);
 
     // prefilter pass
@@ -172,8 +186,10 @@ void BloomStage::render(scene::Camera *camera) {
 
     _renderArea     = RenderPipeline::getRenderArea(camera);
     _inputAssembler = pipeline->getIAByRenderArea(_renderArea);
-    _renderArea.width >>= 1;
-    _renderArea.height >>= 1;
+    // shift from the render area to the prefilter texture
+    const uint resolutionShift = stage->getResolution() == BloomResolution::QUARTER ? 2 : 1;
+    _renderArea.width >>= resolutionShift;
+    _renderArea.height >>= resolutionShift;
     float shadingScale{_pipeline->getPipelineSceneData()->getShadingScale()};
     auto  prefilterSetup = [&](framegraph::PassNodeBuilder &builder, PrefilterRenderData &data) {
         data.sampler = _sampler;
@@ -205,7 +221,7 @@ void BloomStage::render(scene::Camera *camera) {
 
             data.outputTexHandle = builder.create(prefilterTexHandle, colorTexInfo);
         }
-        data.outputTexHandle = builder.write(data.outputTexHandle, colorAttachmentInfo);
+        data.outputTexHandle = builder.write(data.outputTexHandle, prefilterAttachmentInfo);
         builder.writeToBlackboard(prefilterTexHandle, data.outputTexHandle);
 
         // Update threshold
@@ -243,6 +259,10 @@ void BloomStage::render(scene::Camera *camera) {
 
     pipeline->getFrameGraph().addPass<PrefilterRenderData>(insertPoint, prefilterPassHandle, prefilterSetup, prefilterExec);
 
+    if (useCompute) {
+        fgComputeBlur(insertPoint, shadingScale);
+    }
+
     struct ScalingSampleRenderData {
         framegraph::TextureHandle inputTexHandle;
         framegraph::TextureHandle outputTexHandle;
@@ -252,7 +272,7 @@ void BloomStage::render(scene::Camera *camera) {
         int                       index;
     };
     // downsample pass
-    for (int i = 0; i < iterations; ++i) {
+    for (int i = 0; i < iterations && !useCompute; ++i) {
         _renderArea.width >>= 1;
         _renderArea.height >>= 1;
 
@@ -323,7 +343,7 @@ void BloomStage::render(scene::Camera *camera) {
     }
 
     // upsample pass
-    for (int i = 0; i < iterations; ++i) {
+    for (int i = 0; i < iterations && !useCompute; ++i) {
         _renderArea.width <<= 1;
         _renderArea.height <<= 1;
 
@@ -404,8 +424,8 @@ void BloomStage::render(scene::Camera *camera) {
         float                     textureSize[4];
     };
 
-    _renderArea.width <<= 1;
-    _renderArea.height <<= 1;
+    _renderArea.width <<= resolutionShift;
+    _renderArea.height <<= resolutionShift;
 
     auto combineSetup = [&](framegraph::PassNodeBuilder &builder, CombineRenderData &data) {
         data.sampler = _sampler;
@@ -472,5 +492,103 @@ void BloomStage::render(scene::Camera *camera) {
 
     pipeline->getFrameGraph().addPass<CombineRenderData>(++insertPoint, combinePassHandle, combineSetup, combineExec);
 }
+
+void BloomStage::fgComputeBlur(uint &insertPoint, float shadingScale) {
+    struct ComputeBlurData {
+        framegraph::TextureHandle                                          inputTexHandle;
+        ccstd::array<framegraph::TextureHandle, MAX_BLOOM_FILTER_PASS_NUM> outputTexHandles;
+    };
+
+    const auto iterations = static_cast<uint>(_iterations);
+    const uint width      = std::max(static_cast<uint>(static_cast<float>(_renderArea.width) * shadingScale), 1U);
+    const uint height     = std::max(static_cast<uint>(static_cast<float>(_renderArea.height) * shadingScale), 1U);
+
+    auto writeStorageTexture = [](framegraph::PassNodeBuilder &builder, framegraph::StringHandle name, uint shift, uint width, uint height) {
+        auto handle = framegraph::TextureHandle(builder.readFromBlackboard(name));
+        if (!handle.isValid()) {
+            framegraph::Texture::Descriptor colorTexInfo;
+            colorTexInfo.format = gfx::Format::RGBA16F;
+            colorTexInfo.usage  = gfx::TextureUsageBit::STORAGE | gfx::TextureUsageBit::SAMPLED;
+            colorTexInfo.width  = std::max(width >> shift, 1U);
+            colorTexInfo.height = std::max(height >> shift, 1U);
+
+            handle = builder.create(name, colorTexInfo);
+        }
+        handle = builder.write(handle);
+        builder.writeToBlackboard(name, handle);
+        return handle;
+    };
+
+    // downsample pass, reduce the prefilter texture to the last level directly
+    auto downsampleSetup = [&](framegraph::PassNodeBuilder &builder, ComputeBlurData &data) {
+        data.inputTexHandle = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(prefilterTexHandle)));
+        builder.writeToBlackboard(prefilterTexHandle, data.inputTexHandle);
+
+        data.outputTexHandles[0] = writeStorageTexture(builder, downsampleTexHandles[iterations - 1], iterations, width, height);
+    };
+
+    auto downsampleExec = [this, iterations](ComputeBlurData const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBf  = _pipeline->getCommandBuffers()[0];
+        auto *input  = static_cast<gfx::Texture *>(table.getRead(data.inputTexHandle));
+        auto *output = static_cast<gfx::Texture *>(table.getWrite(data.outputTexHandles[0]));
+
+        gfx::TextureBarrier *barrier = _bloomComp->getBarrierBeforeWrite();
+        cmdBf->pipelineBarrier(nullptr, &barrier, &output, 1);
+
+        gfx::DescriptorSet *set = _bloomComp->getDownsampleDescriptorSet();
+        set->bindTexture(0, input);
+        set->bindSampler(0, _sampler);
+        set->bindTexture(1, output);
+        set->update();
+
+        cmdBf->bindPipelineState(const_cast<gfx::PipelineState *>(_bloomComp->getDownsamplePipelineState(iterations)));
+        cmdBf->bindDescriptorSet(globalSet, set);
+        cmdBf->dispatch(BloomComp::getDownsampleDispatchInfo(input->getWidth(), input->getHeight()));
+
+        barrier = _bloomComp->getBarrierAfterWrite();
+        cmdBf->pipelineBarrier(nullptr, &barrier, &output, 1);
+    };
+
+    _pipeline->getFrameGraph().addPass<ComputeBlurData>(++insertPoint, downsamplePassHandles[0], downsampleSetup, downsampleExec);
+
+    // upsample pass, all levels in one pass node
+    auto upsampleSetup = [&](framegraph::PassNodeBuilder &builder, ComputeBlurData &data) {
+        data.inputTexHandle = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(downsampleTexHandles[iterations - 1])));
+        builder.writeToBlackboard(downsampleTexHandles[iterations - 1], data.inputTexHandle);
+
+        for (uint i = 0; i < iterations; ++i) {
+            data.outputTexHandles[i] = writeStorageTexture(builder, upsampleTexHandles[i], iterations - 1 - i, width, height);
+        }
+    };
+
+    auto upsampleExec = [this, iterations](ComputeBlurData const &data, const framegraph::DevicePassResourceTable &table) {
+        auto *cmdBf = _pipeline->getCommandBuffers()[0];
+        auto *input = static_cast<gfx::Texture *>(table.getRead(data.inputTexHandle));
+
+        cmdBf->bindPipelineState(const_cast<gfx::PipelineState *>(_bloomComp->getUpsamplePipelineState()));
+        for (uint i = 0; i < iterations; ++i) {
+            auto *output = static_cast<gfx::Texture *>(table.getWrite(data.outputTexHandles[i]));
+
+            gfx::TextureBarrier *barrier = _bloomComp->getBarrierBeforeWrite();
+            cmdBf->pipelineBarrier(nullptr, &barrier, &output, 1);
+
+            gfx::DescriptorSet *set = _bloomComp->getUpsampleDescriptorSet(i);
+            set->bindTexture(0, input);
+            set->bindSampler(0, _sampler);
+            set->bindTexture(1, output);
+            set->update();
+
+            cmdBf->bindDescriptorSet(globalSet, set);
+            cmdBf->dispatch(BloomComp::getUpsampleDispatchInfo(output->getWidth(), output->getHeight()));
+
+            // the last level is read by the combine pass
+            barrier = i + 1 == iterations ? _bloomComp->getBarrierBeforeCombine() : _bloomComp->getBarrierAfterWrite();
+            cmdBf->pipelineBarrier(nullptr, &barrier, &output, 1);
+            input = output;
+        }
+    };
+
+    _pipeline->getFrameGraph().addPass<ComputeBlurData>(++insertPoint, upsamplePassHandles[0], upsampleSetup, upsampleExec);
+}
 } // namespace pipeline
 } // namespace cc
@@ -35,6 +35,17 @@
 namespace cc {
 namespace pipeline {
 
+class BloomComp;
+
+/**
+ * @en Resolution of the bloom prefilter texture relative to the render area, the blur chain starts from it.
+ * @zh 泛光预过滤纹理相对渲染区域的分辨率，模糊链从该纹理开始。
+ */
+enum class BloomResolution {
+    HALF,
+    QUARTER,
+};
+
 struct CC_DLL UBOBloom {
     static constexpr uint TEXTURE_SIZE_OFFSET = 0;
     static constexpr uint COUNT               = UBOBloom::TEXTURE_SIZE_OFFSET + 4;
@@ -66,8 +77,21 @@ public:
     inline void  setIterations(int value) {
         _iterations = std::max(1, std::min(value, MAX_BLOOM_FILTER_PASS_NUM));
     }
+    inline BloomResolution getResolution() const { return _resolution; }
+    inline void            setResolution(BloomResolution value) { _resolution = value; }
+
+    /**
+     * @en Run the downsample chain in a single compute dispatch and the upsample chain as compute dispatches,
+     * instead of one render pass per level. Ignored on devices without compute shaders or RGBA16F storage images.
+     * @zh 使用一次计算着色器 dispatch 完成降采样链，升采样链也使用 dispatch，而不是每一级一个渲染通道。
+     * 设备不支持计算着色器或 RGBA16F 存储图像时忽略。
+     */
+    inline bool isComputeEnabled() const { return _computeEnabled; }
+    inline void setComputeEnabled(bool value) { _computeEnabled = value; }
 
 private:
+    void fgComputeBlur(uint &insertPoint, float shadingScale);
+
     uint _phaseID = 0;
 
     static RenderStageInfo initInfo;
@@ -79,7 +103,10 @@ private:
     gfx::Buffer *                                          _prefilterUBO = nullptr;
     ccstd::array<gfx::Buffer *, MAX_BLOOM_FILTER_PASS_NUM> _downsampleUBO{};
     ccstd::array<gfx::Buffer *, MAX_BLOOM_FILTER_PASS_NUM> _upsampleUBO{};
-    gfx::Buffer *                                          _combineUBO = nullptr;
+    gfx::Buffer *                                          _combineUBO     = nullptr;
+    BloomResolution                                        _resolution     = BloomResolution::HALF;
+    bool                                                   _computeEnabled = false;
+    BloomComp *                                            _bloomComp      = nullptr;
     framegraph::StringHandle                               _fgStrHandleBloomOut;
 };
 } // namespace pipeline
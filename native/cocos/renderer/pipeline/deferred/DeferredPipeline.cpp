@@ -32,6 +32,7 @@
 #include "../shadow/ShadowFlow.h"
 #include "DeferredPipelineSceneData.h"
 #include "MainFlow.h"
+#include "core/Root.h"
 #include "gfx-base/GFXBuffer.h"
 #include "gfx-base/GFXCommandBuffer.h"
 #include "gfx-base/GFXDef.h"
@@ -88,7 +89,8 @@ bool DeferredPipeline::initialize(const RenderPipelineInfo &info) {
 }
 
 bool DeferredPipeline::activate(gfx::Swapchain *swapchain) {
-    _macros["CC_PIPELINE_TYPE"] = 1;
+    _macros["CC_PIPELINE_TYPE"]            = 1;
+    _macros["CC_DEFERRED_COMPACT_GBUFFER"] = _compactGbuffer;
 
     if (!RenderPipeline::activate(swapchain)) {
         CC_LOG_ERROR("RenderPipeline active failed.");
@@ -105,6 +107,11 @@ bool DeferredPipeline::activate(gfx::Swapchain *swapchain) {
 
 void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     CC_PROFILE(DeferredPipelineRender);
+    if (_dynamicResolution.isEnabled()) {
+        // wall clock frame time, GPU timings are only available on some backends and lag a few frames behind
+        setShadingScale(_dynamicResolution.update(Root::getInstance()->getFrameTime(), getShadingScale()));
+    }
+
     auto *device               = gfx::Device::getInstance();
     bool  enableOcclusionQuery = isOcclusionQueryEnabled();
     if (enableOcclusionQuery) {
@@ -112,6 +119,10 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     }
 
     _commandBuffers[0]->begin();
+    _gpuTimer.beginFrame(device, _commandBuffers[0]);
+    _computeMorphing.dispatch(_commandBuffers[0]);
+    _computeSkinning.dispatch(_commandBuffers[0]);
+    _environmentPrefilter.dispatch(_commandBuffers[0], &_gpuTimer);
 
     if (enableOcclusionQuery) {
         _commandBuffers[0]->resetQueryPool(_queryPools[0]);
@@ -122,8 +133,18 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     ensureEnoughSize(cameras);
     decideProfilerCamera(cameras);
 
-    for (auto *camera : cameras) {
-        sceneCulling(this, camera);
+    const bool parallelCulling = useParallelCulling(cameras);
+    if (parallelCulling) {
+        sceneCullingParallel(this, cameras, false, _sceneCullingResults);
+    }
+
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        auto *camera = cameras[i];
+        if (parallelCulling) {
+            applySceneCullingResult(this, camera, false, _sceneCullingResults[i]);
+        } else {
+            sceneCulling(this, camera);
+        }
 
         if (_clusterEnabled) {
             _clusterComp->clusterLightCulling(camera);
@@ -143,6 +164,7 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
         _commandBuffers[0]->completeQueryPool(_queryPools[0]);
     }
 
+    _gpuTimer.endFrame();
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -150,6 +172,19 @@ void DeferredPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     RenderPipeline::framegraphGC();
 }
 
+void DeferredPipeline::setCompactGbufferEnabled(bool enabled) {
+    if (_compactGbuffer == enabled) {
+        return;
+    }
+
+    _compactGbuffer                        = enabled;
+    _macros["CC_DEFERRED_COMPACT_GBUFFER"] = enabled;
+    // the surface shaders and the lighting pass encode and decode the layout, recompile them once activated
+    if (_descriptorSet) {
+        Root::getInstance()->onGlobalPipelineStateChanged();
+    }
+}
+
 void DeferredPipeline::onGlobalPipelineStateChanged() {
     _pipelineSceneData->updatePipelineSceneData();
 }
@@ -166,8 +201,9 @@ bool DeferredPipeline::activeRenderer(gfx::Swapchain *swapchain) {
     _descriptorSet->update();
 
     // update global defines when all states initialized.
-    _macros["CC_USE_HDR"]               = static_cast<bool>(_pipelineSceneData->isHDR());
-    _macros["CC_SUPPORT_FLOAT_TEXTURE"] = hasAnyFlags(_device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE);
+    _macros["CC_USE_HDR"]                   = static_cast<bool>(_pipelineSceneData->isHDR());
+    _macros["CC_SUPPORT_FLOAT_TEXTURE"]     = hasAnyFlags(_device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE);
+    _macros["CC_SUPPORT_BINDLESS_TEXTURES"] = getGlobalDSManager()->getBindlessTextureTable() != nullptr;
 
     // step 2 create index buffer
     uint ibStride = 4;
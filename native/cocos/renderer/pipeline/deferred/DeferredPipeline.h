@@ -55,6 +55,17 @@ public:
     inline const gfx::BufferList &getLightBuffers() const { return _lightBuffers; }
     inline const UintList &       getLightIndexOffsets() const { return _lightIndexOffsets; }
     inline const UintList &       getLightIndices() const { return _lightIndices; }
+    inline ClusterLightCulling *  getClusterLightCulling() const { return _clusterComp; }
+
+    /**
+     * @en Use a compact G-buffer layout: albedo and occlusion, the octahedral normal packed into 24 bits and the roughness,
+     * emissive and metallic. The normal target shrinks from 64 to 32 bits per pixel, the default layout keeps the normal,
+     * roughness and metallic in a half float target.
+     * @zh 使用紧凑的 G-buffer 布局：反照率与遮蔽、压缩为 24 位的八面体法线与粗糙度、自发光与金属度。
+     * 法线目标由每像素 64 位减少到 32 位，默认布局将法线、粗糙度和金属度保存在半精度浮点目标中。
+     */
+    void        setCompactGbufferEnabled(bool enabled);
+    inline bool isCompactGbufferEnabled() const { return _compactGbuffer; }
 
 private:
     bool activeRenderer(gfx::Swapchain *swapchain);
@@ -67,6 +78,8 @@ private:
 
     ClusterLightCulling *_clusterComp{nullptr};
 
+    bool _compactGbuffer{false};
+
 public:
     static constexpr uint GBUFFER_COUNT = 3;
 
@@ -71,7 +71,7 @@ void GbufferStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint                  phase    = convertPhase(descriptor.stages);
         RenderQueueSortFunc   sortFunc = convertQueueSortFunc(descriptor.sortMode);
-        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc, true, descriptor.sortMode};
         _renderQueues.emplace_back(CC_NEW(RenderQueue(_pipeline, std::move(info), true)));
     }
     _planarShadowQueue = CC_NEW(PlanarShadowQueue(_pipeline));
@@ -170,8 +170,10 @@ void GbufferStage::render(scene::Camera *camera) {
             static_cast<uint>(static_cast<float>(pipeline->getWidth()) * shadingScale),
             static_cast<uint>(static_cast<float>(pipeline->getHeight()) * shadingScale),
         };
+        // the compact layout packs the normals into 24 bits and moves the metallic to the emissive target
+        const bool compact = pipeline->isCompactGbufferEnabled();
         for (int i = 0; i < DeferredPipeline::GBUFFER_COUNT - 1; ++i) {
-            if (i != 0) { // normals need more precision
+            if (i != 0 && !compact) { // normals need more precision
                 data.gbuffer[i] = builder.create(DeferredPipeline::fgStrHandleGbufferTexture[i], gbufferInfoFloat);
             } else {
                 data.gbuffer[i] = builder.create(DeferredPipeline::fgStrHandleGbufferTexture[i], gbufferInfo);
@@ -229,7 +231,7 @@ void GbufferStage::render(scene::Camera *camera) {
     // Command 'updateBuffer' must be recorded outside render passes, cannot put them in execute lambda
     dispenseRenderObject2Queues();
     auto *cmdBuff = pipeline->getCommandBuffers()[0];
-    _instancedQueue->uploadBuffers(cmdBuff);
+    _instancedQueue->uploadBuffers(cmdBuff, camera);
     _batchedQueue->uploadBuffers(cmdBuff);
 
     // if empty == true, gbuffer and lightig passes will be ignored
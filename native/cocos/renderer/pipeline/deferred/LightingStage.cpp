@@ -24,7 +24,10 @@
 ****************************************************************************/
 
 #include "LightingStage.h"
+#include <cmath>
+#include <cstring>
 #include "../BatchedBuffer.h"
+#include "../ClusterLightCulling.h"
 #include "../Define.h"
 #include "../GeometryRenderer.h"
 #include "../GlobalDescriptorSetManager.h"
@@ -43,6 +46,7 @@
 #include "gfx-base/GFXDevice.h"
 #include "pipeline/Define.h"
 #include "profiler/Profiler.h"
+#include "scene/Model.h"
 #include "scene/RenderScene.h"
 #include "scene/SphereLight.h"
 #include "scene/SpotLight.h"
@@ -54,7 +58,6 @@ namespace {
 const ccstd::string      STAGE_NAME         = "LightingStage";
 const uint               MAX_REFLECTOR_SIZE = 5;
 framegraph::StringHandle reflectTexHandle   = framegraph::FrameGraph::stringToHandle("reflectionTex");
-framegraph::StringHandle denoiseTexHandle[MAX_REFLECTOR_SIZE];
 framegraph::StringHandle ssprClearPass[MAX_REFLECTOR_SIZE];
 framegraph::StringHandle ssprCompReflectPass[MAX_REFLECTOR_SIZE];
 framegraph::StringHandle ssprCompDenoisePass[MAX_REFLECTOR_SIZE];
@@ -67,9 +70,6 @@ framegraph::StringHandle fgStrHandleClusterLightGridBuffer  = framegraph::FrameG
 void initStrHandle() {
     ccstd::string tmp;
     for (int i = 0; i < MAX_REFLECTOR_SIZE; ++i) {
-        tmp                 = ccstd::string("denoiseTexureHandle") + std::to_string(i);
-        denoiseTexHandle[i] = framegraph::FrameGraph::stringToHandle(tmp.c_str());
-
         tmp              = ccstd::string("ssprClearPss") + std::to_string(i);
         ssprClearPass[i] = framegraph::FrameGraph::stringToHandle(tmp.c_str());
 
@@ -83,6 +83,41 @@ void initStrHandle() {
         ssprRenderPass[i] = framegraph::FrameGraph::stringToHandle(tmp.c_str());
     }
 }
+
+// average GPU time of the clear, reflection and denoise passes of one reflector, 0 if not measured
+float getReflectionUpdateTime(const GPUTimer &timer) {
+    if (!timer.isEnabled()) {
+        return 0.F;
+    }
+    float time    = 0.F;
+    uint  updates = 0;
+    for (const auto &timing : timer.getTimings()) {
+        if (std::strncmp(timing.name, "ssprRenderPass", 14) == 0 || std::strncmp(timing.name, "sspr", 4) != 0) {
+            continue;
+        }
+        time += timing.time;
+        updates += std::strncmp(timing.name, "ssprReflectPass", 15) == 0 ? 1 : 0;
+    }
+    return updates > 0 ? time / static_cast<float>(updates) : 0.F;
+}
+
+// fraction of the screen covered by the bounding sphere of the model
+float getScreenCoverage(const scene::Camera *camera, const scene::Model *model, float *distance) {
+    const auto *bounds = model->getWorldBounds();
+    if (bounds == nullptr) {
+        *distance = 0.F;
+        return 1.F;
+    }
+    const float radius = bounds->getHalfExtents().length();
+    *distance          = bounds->getCenter().distance(camera->getPosition());
+    const float extent = camera->getProjectionType() == scene::CameraProjection::ORTHO
+                             ? camera->getOrthoHeight()
+                             : *distance * std::tan(camera->getFov() * 0.5F);
+    if (*distance <= radius || extent <= 0.F) {
+        return 1.F;
+    }
+    return std::min(radius * radius / (extent * extent), 1.F);
+}
 } // namespace
 
 RenderStageInfo LightingStage::initInfo = {
@@ -270,7 +305,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint                  phase    = convertPhase(descriptor.stages);
         RenderQueueSortFunc   sortFunc = convertQueueSortFunc(descriptor.sortMode);
-        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc, true, descriptor.sortMode};
         _renderQueues.emplace_back(CC_NEW(RenderQueue(_pipeline, std::move(info), true)));
     }
 
@@ -290,7 +325,7 @@ void LightingStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     _planarShadowQueue = CC_NEW(PlanarShadowQueue(_pipeline));
 
     // create reflection resource
-    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn};
+    RenderQueueCreateInfo info = {true, _reflectionPhaseID, transparentCompareFn, true, RenderQueueSortMode::BACK_TO_FRONT};
     _reflectionComp            = new ReflectionComp();
     _reflectionComp->init(_device, 8, 8);
 
@@ -307,6 +342,7 @@ void LightingStage::destroy() {
     RenderStage::destroy();
 
     CC_SAFE_DELETE(_reflectionComp);
+    _reflectionScheduler.clear();
 }
 
 void LightingStage::fgLightingPass(scene::Camera *camera) {
@@ -390,8 +426,8 @@ void LightingStage::fgLightingPass(scene::Camera *camera) {
 
         // no need to bind localSet in cluster
         if (!_pipeline->isClusterEnabled()) {
-            ccstd::vector<uint> dynamicOffsets = {0};
-            cmdBuff->bindDescriptorSet(localSet, _descriptorSet, dynamicOffsets);
+            const ccstd::array<uint, 1> dynamicOffsets = {0};
+            cmdBuff->bindDescriptorSet(localSet, _descriptorSet, utils::toUint(dynamicOffsets.size()), dynamicOffsets.data());
         }
 
         const ccstd::array<uint, 1> globalOffsets = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
@@ -431,6 +467,11 @@ void LightingStage::fgLightingPass(scene::Camera *camera) {
         if (_isTransparentQueueEmpty) _planarShadowQueue->recordCommandBuffer(_device, table.getRenderPass(), cmdBuff);
     };
 
+    // depth bounds light culling reads the gbuffer depth, it must be set up after the gbuffer pass
+    if (pipeline->isClusterEnabled() && pipeline->getClusterLightCulling()) {
+        pipeline->getClusterLightCulling()->addDepthBoundsCullingPasses();
+    }
+
     pipeline->getFrameGraph().addPass<RenderData>(static_cast<uint>(DeferredInsertPoint::DIP_LIGHTING), DeferredPipeline::fgStrHandleLightingPass, lightingSetup, lightingExec);
 }
 
@@ -500,8 +541,8 @@ void LightingStage::fgTransparent(scene::Camera *camera) {
 
         // no need to bind localSet in cluster
         if (!_pipeline->isClusterEnabled()) {
-            ccstd::vector<uint> dynamicOffsets = {0};
-            cmdBuff->bindDescriptorSet(localSet, _descriptorSet, dynamicOffsets);
+            const ccstd::array<uint, 1> dynamicOffsets = {0};
+            cmdBuff->bindDescriptorSet(localSet, _descriptorSet, utils::toUint(dynamicOffsets.size()), dynamicOffsets.data());
         }
 
         const ccstd::array<uint, 1> globalOffsets = {pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
@@ -555,9 +596,10 @@ void LightingStage::putTransparentObj2Queue() {
 void LightingStage::fgSsprPass(scene::Camera *camera) {
     // The max reflector objects is 5.
     // for each reflector, there are 4 pass, clear pass/reflection pass/denoise pass/render pass
-    // each reflector has its own denoise texture, and will be used in render pass
+    // each reflector has its own denoise texture kept by the scheduler across frames, and will be used in render pass
     // All the reflectors use the same reflect texture which is temp resource for the reflectors, and the reflect texture should be cleared for each reflector
-    // we first calculate denoise textures of all reflectors one by one, the first 3 pass will be executed
+    // we first calculate denoise textures of the reflectors picked by the scheduler one by one, the first 3 pass will be executed
+    // the other reflectors reuse the denoise texture of an earlier frame
     // then we render all reflectors one by one, the last render pass will be executed
 
     if (!_device->hasFeature(gfx::Feature::COMPUTE_SHADER)) {
@@ -565,8 +607,7 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
     }
     auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
 
-    _denoiseIndex = 0;
-    _matViewProj  = camera->getMatViewProj();
+    _matViewProj = camera->getMatViewProj();
     _reflectionElems.clear();
 
     // step 1 prepare clear model's reflection texture pass. should switch to image clear command after available
@@ -611,8 +652,10 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
         framegraph::TextureHandle reflection;  // compute result texture
         framegraph::TextureHandle lightingOut; // read from lighting pass output texture
         framegraph::TextureHandle depth;       // read from gbuffer.depth texture
+        uint                      elemIndex{0};
     };
 
+    uint elemIndex       = 0;
     auto compReflectSetup = [&](framegraph::PassNodeBuilder &builder, DataCompReflect &data) {
         // if there is no attachment in the pass, render pass will not be created
         // read lighting out as input
@@ -638,6 +681,7 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
 
         data.reflection = builder.write(data.reflection);
         builder.writeToBlackboard(reflectTexHandle, data.reflection);
+        data.elemIndex = elemIndex;
     };
 
     auto compReflectExec = [this, camera](DataCompReflect const &data, const framegraph::DevicePassResourceTable &table) {
@@ -674,7 +718,7 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
         reflectDesc->bindSampler(2, sampler);
         reflectDesc->bindTexture(2, texDepth);
         reflectDesc->bindTexture(3, texReflection);
-        reflectDesc->bindBuffer(4, _reflectionElems[_denoiseIndex].set->getBuffer(0));
+        reflectDesc->bindBuffer(4, _reflectionElems[data.elemIndex].set->getBuffer(0));
         reflectDesc->update();
 
         // set 1, subModel->getDescriptorSet(0)
@@ -685,9 +729,9 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
 
     // step 3 prepare compute the denoise pass, contain 1 dispatch commands, compute pipeline
     struct DataCompDenoise {
-        framegraph::TextureHandle denoise;    // each reflector has its own denoise texture
         framegraph::TextureHandle reflection; // the texture from last pass
         framegraph::TextureHandle depth;      // each reflector has its own denoise texture
+        uint                      elemIndex{0};
     };
 
     auto compDenoiseSetup = [&](framegraph::PassNodeBuilder &builder, DataCompDenoise &data) {
@@ -696,28 +740,21 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
         data.reflection = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(reflectTexHandle)));
         builder.writeToBlackboard(reflectTexHandle, data.reflection);
 
-        // write to reflection
-        framegraph::Texture::Descriptor colorTexInfo;
-        colorTexInfo.format = gfx::Format::RGBA8;
-        colorTexInfo.usage  = gfx::TextureUsageBit::STORAGE | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_SRC;
-        colorTexInfo.width  = _ssprTexWidth;
-        colorTexInfo.height = _ssprTexHeight;
-        data.denoise        = builder.create(denoiseTexHandle[_denoiseIndex], colorTexInfo);
-
         data.depth = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(RenderPipeline::fgStrHandleOutDepthTexture)));
         builder.writeToBlackboard(RenderPipeline::fgStrHandleOutDepthTexture, data.depth);
 
-        data.denoise = builder.write(data.denoise);
-        builder.writeToBlackboard(denoiseTexHandle[_denoiseIndex], data.denoise);
+        // writes the denoise texture of the reflector, which lives outside the frame graph
+        data.elemIndex = elemIndex;
+        builder.sideEffect();
     };
 
     auto compDenoiseExec = [this](DataCompDenoise const &data, const framegraph::DevicePassResourceTable &table) {
         auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
 
-        auto *denoiseTex    = static_cast<gfx::Texture *>(table.getWrite(data.denoise));
+        auto &elem          = _reflectionElems[data.elemIndex];
+        auto *denoiseTex    = _reflectionScheduler.getResult(elem.set);
         auto *reflectionTex = static_cast<gfx::Texture *>(table.getRead(data.reflection));
         auto *depth         = static_cast<gfx::Texture *>(table.getRead(data.depth));
-        auto &elem          = _reflectionElems[_denoiseIndex];
 
         // pipeline barrier
         auto *cmdBuff = pipeline->getCommandBuffers()[0];
@@ -754,20 +791,18 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
         // pipeline barrier
         // dispatch -> fragment
         cmdBuff->pipelineBarrier(nullptr, _reflectionComp->getBarrierAfterDenoise(), {denoiseTex});
-
-        _denoiseIndex = (_denoiseIndex + 1) % _reflectionElems.size();
     };
 
     // step 4 prepare render reflector objects pass, graphics pipeline
     struct DataRender {
-        framegraph::TextureHandle denoise;     // input texture
         framegraph::TextureHandle lightingOut; // attachment, load and write
         framegraph::TextureHandle depth;       // attachment, load and write
+        uint                      elemIndex{0};
     };
 
     auto renderSetup = [&](framegraph::PassNodeBuilder &builder, DataRender &data) {
-        data.denoise = builder.read(framegraph::TextureHandle(builder.readFromBlackboard(denoiseTexHandle[_denoiseIndex])));
-        builder.writeToBlackboard(denoiseTexHandle[_denoiseIndex], data.denoise);
+        // the denoise texture of the reflector is read from outside the frame graph
+        data.elemIndex = elemIndex;
 
         // write lighting out, as an attachment
         framegraph::RenderTargetAttachment::Descriptor colorAttachmentInfo;
@@ -797,13 +832,13 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
     auto renderExec = [this, camera](DataRender const &data, const framegraph::DevicePassResourceTable &table) {
         auto *pipeline = static_cast<DeferredPipeline *>(_pipeline);
         auto *cmdBuff  = pipeline->getCommandBuffers()[0];
-        auto &elem     = _reflectionElems[_denoiseIndex];
+        auto &elem     = _reflectionElems[data.elemIndex];
 
         // bind descriptor
         cmdBuff->bindDescriptorSet(globalSet, pipeline->getDescriptorSet());
 
         gfx::DescriptorSet *descLocal  = elem.set; // sub model descriptor set
-        auto *              denoiseTex = static_cast<gfx::Texture *>(table.getRead(data.denoise));
+        auto *              denoiseTex = _reflectionScheduler.getResult(elem.set);
 
         descLocal->bindTexture(static_cast<uint>(ModelLocalBindings::SAMPLER_REFLECTION), denoiseTex);
         descLocal->bindSampler(static_cast<uint>(ModelLocalBindings::SAMPLER_REFLECTION), _defaultSampler);
@@ -833,24 +868,60 @@ void LightingStage::fgSsprPass(scene::Camera *camera) {
             for (p = 0; p < passCount; ++p) {
                 const auto &pass = passes[p];
                 if (pass->getPhase() == _reflectionPhaseID) {
-                    RenderElem elem = {ro, subModel->getDescriptorSet(), m, p};
+                    RenderElem elem = {ro, subModel->getDrawDescriptorSet(), m, p};
                     _reflectionElems.push_back(elem);
                 }
             }
         }
     }
 
+    _reflectionCandidates.clear();
+    for (const auto &elem : _reflectionElems) {
+        ReflectionScheduler::Candidate candidate;
+        candidate.key      = elem.set;
+        candidate.coverage = getScreenCoverage(camera, elem.renderObject.model, &candidate.distance);
+        candidate.stamp    = elem.renderObject.model->getUpdateStamp();
+        _reflectionCandidates.emplace_back(candidate);
+    }
+    // only the reflectors covering most of the screen are rendered when there are too many
+    if (_reflectionElems.size() > MAX_REFLECTOR_SIZE) {
+        ccstd::vector<uint> order(_reflectionElems.size());
+        for (uint i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](uint lhs, uint rhs) {
+            return _reflectionCandidates[lhs].coverage > _reflectionCandidates[rhs].coverage;
+        });
+        ccstd::vector<RenderElem>                     elems;
+        ccstd::vector<ReflectionScheduler::Candidate> candidates;
+        for (uint i = 0; i < MAX_REFLECTOR_SIZE; ++i) {
+            elems.emplace_back(_reflectionElems[order[i]]);
+            candidates.emplace_back(_reflectionCandidates[order[i]]);
+        }
+        _reflectionElems.swap(elems);
+        _reflectionCandidates.swap(candidates);
+    }
+
+    _reflectionScheduler.schedule(_device, _ssprTexWidth, _ssprTexHeight, _matViewProj, _reflectionCandidates,
+                                  getReflectionUpdateTime(pipeline->getGPUTimer()), _reflectionUpdates);
+
     uint insertPoint = static_cast<uint>(DeferredInsertPoint::DIP_SSPR);
-    for (uint i = 0; i < _reflectionElems.size(); ++i) {
+    for (uint i = 0; i < _reflectionUpdates.size(); ++i) {
         // add clear and comp passes here
+        elemIndex = _reflectionUpdates[i];
         pipeline->getFrameGraph().addPass<DataClear>(insertPoint++, ssprClearPass[i], clearSetup, clearExec);
         pipeline->getFrameGraph().addPass<DataCompReflect>(insertPoint++, ssprCompReflectPass[i], compReflectSetup, compReflectExec);
         pipeline->getFrameGraph().addPass<DataCompDenoise>(insertPoint++, ssprCompDenoisePass[i], compDenoiseSetup, compDenoiseExec);
     }
 
+    uint renderCount = 0;
     for (uint i = 0; i < _reflectionElems.size(); ++i) {
-        // add graphic pass here
-        pipeline->getFrameGraph().addPass<DataRender>(insertPoint++, ssprRenderPass[i], renderSetup, renderExec);
+        // add graphic pass here, the reflectors never updated have nothing to show yet
+        if (_reflectionScheduler.getResult(_reflectionElems[i].set) == nullptr) {
+            continue;
+        }
+        elemIndex = i;
+        pipeline->getFrameGraph().addPass<DataRender>(insertPoint++, ssprRenderPass[renderCount++], renderSetup, renderExec);
     }
 }
 
@@ -59,6 +59,12 @@ public:
     void destroy() override;
     void render(scene::Camera *camera) override;
 
+    /**
+     * @en Picks the reflectors whose screen space reflection is updated each frame, the others reuse an earlier result.
+     * @zh 选取每帧更新屏幕空间反射的反射体，其余反射体复用之前的结果。
+     */
+    inline ReflectionScheduler &getReflectionScheduler() { return _reflectionScheduler; }
+
 private:
     void gatherLights(scene::Camera *camera);
     void initLightingBuffer();
@@ -87,8 +93,10 @@ private:
     RenderQueue *   _reflectionRenderQueue{nullptr};
     uint            _reflectionPhaseID{0};
 
-    ccstd::vector<RenderElem> _reflectionElems;
-    uint                      _denoiseIndex = 0; // use to get corrrect texture string handle
+    ccstd::vector<RenderElem>                     _reflectionElems;
+    ccstd::vector<ReflectionScheduler::Candidate> _reflectionCandidates;
+    ccstd::vector<uint32_t>                       _reflectionUpdates; // indices of the elems updated this frame
+    ReflectionScheduler                           _reflectionScheduler;
 
     gfx::Sampler *_defaultSampler{nullptr};
 
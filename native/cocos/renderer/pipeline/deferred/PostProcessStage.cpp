@@ -49,7 +49,9 @@ namespace cc {
 namespace pipeline {
 namespace {
 const ccstd::string STAGE_NAME = "PostProcessStage";
-}
+
+framegraph::StringHandle upscaleDepthTexHandle = framegraph::FrameGraph::stringToHandle("postProcessUpscaleDepthTex");
+} // namespace
 
 RenderStageInfo PostProcessStage::initInfo = {
     STAGE_NAME,
@@ -92,7 +94,7 @@ void PostProcessStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
                 break;
         }
 
-        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info = {descriptor.isTransparent, phase, sortFunc, true, descriptor.sortMode};
         _renderQueues.emplace_back(CC_NEW(RenderQueue(_pipeline, std::move(info))));
     }
 }
@@ -120,7 +122,10 @@ void PostProcessStage::render(scene::Camera *camera) {
     _inputAssembler   = _pipeline->getIAByRenderArea(_renderArea);
     auto *pipeline    = _pipeline;
     float shadingScale{_pipeline->getPipelineSceneData()->getShadingScale()};
-    auto  postSetup = [&](framegraph::PassNodeBuilder &builder, RenderData &data) {
+    // with dynamic resolution the scaled result is upscaled by the post process pass, and UI renders at full resolution
+    const bool  upscale{_pipeline->getDynamicResolution().isEnabled()};
+    const float outputScale{upscale ? 1.F : shadingScale};
+    auto        postSetup = [&](framegraph::PassNodeBuilder &builder, RenderData &data) {
         if (pipeline->isBloomEnabled()) {
             data.outColorTex = framegraph::TextureHandle(builder.readFromBlackboard(RenderPipeline::fgStrHandleBloomOutTexture));
         } else {
@@ -163,10 +168,10 @@ void PostProcessStage::render(scene::Camera *camera) {
             gfx::TextureType::TEX2D,
             gfx::TextureUsageBit::COLOR_ATTACHMENT,
             gfx::Format::RGBA8,
-            static_cast<uint>(static_cast<float>(camera->getWindow()->getWidth()) * shadingScale),
-            static_cast<uint>(static_cast<float>(camera->getWindow()->getHeight()) * shadingScale),
+            static_cast<uint>(static_cast<float>(camera->getWindow()->getWidth()) * outputScale),
+            static_cast<uint>(static_cast<float>(camera->getWindow()->getHeight()) * outputScale),
         };
-        if (shadingScale != 1.F) {
+        if (outputScale != 1.F) {
             textureInfo.usage |= gfx::TextureUsageBit::TRANSFER_SRC;
         }
         data.backBuffer = builder.create(fgStrHandlePostProcessOutTexture, textureInfo);
@@ -179,6 +184,23 @@ void PostProcessStage::render(scene::Camera *camera) {
         depthAttachmentInfo.loadOp        = gfx::LoadOp::CLEAR;
         depthAttachmentInfo.beginAccesses = depthAttachmentInfo.endAccesses = gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE;
 
+        if (upscale) {
+            // the scaled depth doesn't match the full resolution back buffer, its content is cleared anyway
+            gfx::TextureInfo depthTexInfo{
+                gfx::TextureType::TEX2D,
+                gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT,
+                gfx::Format::DEPTH_STENCIL,
+                camera->getWindow()->getWidth(),
+                camera->getWindow()->getHeight(),
+            };
+            data.depth = builder.create(upscaleDepthTexHandle, depthTexInfo);
+            data.depth = builder.write(data.depth, depthAttachmentInfo);
+
+            const gfx::Rect renderArea = RenderPipeline::getRenderArea(camera);
+            builder.setViewport({renderArea.x, renderArea.y, renderArea.width, renderArea.height}, renderArea);
+            return;
+        }
+
         data.depth = framegraph::TextureHandle(builder.readFromBlackboard(RenderPipeline::fgStrHandleOutDepthTexture));
         if (!data.depth.isValid()) {
             gfx::TextureInfo depthTexInfo{
@@ -196,7 +218,7 @@ void PostProcessStage::render(scene::Camera *camera) {
         builder.setViewport(pipeline->getViewport(camera), pipeline->getScissor(camera));
     };
 
-    auto postExec = [this, camera](RenderData const &data, const framegraph::DevicePassResourceTable &table) {
+    auto postExec = [this, camera, upscale](RenderData const &data, const framegraph::DevicePassResourceTable &table) {
         auto *           pipeline   = _pipeline;
         gfx::RenderPass *renderPass = table.getRenderPass();
 
@@ -213,7 +235,7 @@ void PostProcessStage::render(scene::Camera *camera) {
             // get pso and draw quad
             gfx::PipelineState *       pso      = PipelineStateManager::getOrCreatePipelineState(pv, sd, _inputAssembler, renderPass);
             pipeline::GlobalDSManager *globalDS = pipeline->getGlobalDSManager();
-            gfx::Sampler *             sampler  = shadingScale < 1.F ? globalDS->getPointSampler() : globalDS->getLinearSampler();
+            gfx::Sampler *             sampler  = shadingScale < 1.F && !upscale ? globalDS->getPointSampler() : globalDS->getLinearSampler();
 
             pv->getDescriptorSet()->bindTexture(0, table.getRead(data.outColorTex));
             pv->getDescriptorSet()->bindSampler(0, sampler);
@@ -232,7 +254,7 @@ void PostProcessStage::render(scene::Camera *camera) {
 
     // add pass
     pipeline->getFrameGraph().addPass<RenderData>(static_cast<uint>(CommonInsertPoint::DIP_POSTPROCESS), RenderPipeline::fgStrHandlePostprocessPass, postSetup, postExec);
-    pipeline->getFrameGraph().presentFromBlackboard(fgStrHandlePostProcessOutTexture, camera->getWindow()->getFramebuffer()->getColorTextures()[0], shadingScale == 1.F);
+    pipeline->getFrameGraph().presentFromBlackboard(fgStrHandlePostProcessOutTexture, camera->getWindow()->getFramebuffer()->getColorTextures()[0], outputScale == 1.F);
 }
 
 } // namespace pipeline
@@ -1,4 +1,6 @@
 #include "ReflectionComp.h"
+#include <cfloat>
+#include <cstring>
 #include "../Define.h"
 #include "base/Log.h"
 #include "base/StringUtil.h"
@@ -93,10 +95,12 @@ void ReflectionComp::init(gfx::Device *dev, uint groupSizeX, uint groupSizeY) {
         gfx::AccessFlagBit::COMPUTE_SHADER_READ_TEXTURE,
     };
 
+    // the denoised result is kept across frames and overwritten as a whole
     gfx::TextureBarrierInfo infoBeforeDenoise2 = {
-        gfx::AccessFlagBit::NONE,
+        gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE,
         gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
     };
+    infoBeforeDenoise2.discardContents = 1;
 
     gfx::TextureBarrierInfo infoAfterDenoise = {
         gfx::AccessFlagBit::COMPUTE_SHADER_WRITE,
@@ -566,4 +570,89 @@ T &ReflectionComp::getAppropriateShaderSource(ShaderSources<T> &sources) {
     return sources.glsl4;
 }
 
+ReflectionScheduler::~ReflectionScheduler() {
+    clear();
+}
+
+void ReflectionScheduler::clear() {
+    for (auto &entry : _entries) {
+        CC_SAFE_DESTROY_AND_DELETE(entry.second.texture);
+    }
+    _entries.clear();
+}
+
+gfx::Texture *ReflectionScheduler::getResult(const void *key) const {
+    auto iter = _entries.find(key);
+    return iter != _entries.end() && iter->second.valid ? iter->second.texture : nullptr;
+}
+
+void ReflectionScheduler::schedule(gfx::Device *device, uint32_t width, uint32_t height, const Mat4 &viewProj, const ccstd::vector<Candidate> &candidates, float updateTime, ccstd::vector<uint32_t> &updates) {
+    updates.clear();
+    ++_frame;
+    if (width != _width || height != _height) {
+        clear();
+        _width  = width;
+        _height = height;
+    }
+    if (updateTime > 0.F) {
+        _updateTime = _updateTime > 0.F ? _updateTime * 0.9F + updateTime * 0.1F : updateTime;
+    }
+
+    _priorities.clear();
+    for (uint32_t i = 0; i < candidates.size(); ++i) {
+        const auto &candidate = candidates[i];
+        auto &      entry     = _entries[candidate.key];
+        entry.lastSeen        = _frame;
+        if (!entry.texture) {
+            entry.texture = device->createTexture({
+                gfx::TextureType::TEX2D,
+                gfx::TextureUsageBit::STORAGE | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_SRC,
+                gfx::Format::RGBA8,
+                width,
+                height,
+            });
+        }
+        if (!entry.valid) {
+            _priorities.emplace_back(FLT_MAX, i);
+            continue;
+        }
+
+        const uint32_t age      = _frame - entry.lastUpdate;
+        const bool     isStatic = entry.stamp == candidate.stamp && std::memcmp(entry.viewProj.m, viewProj.m, sizeof(viewProj.m)) == 0;
+        if (isStatic && (_staticRefreshInterval == 0 || age < _staticRefreshInterval)) {
+            continue;
+        }
+        // larger and nearer first, the stale ones catch up by age
+        _priorities.emplace_back((candidate.coverage + 1e-3F) * static_cast<float>(age) / (1.F + candidate.distance), i);
+    }
+
+    std::stable_sort(_priorities.begin(), _priorities.end(), [](const std::pair<float, uint32_t> &lhs, const std::pair<float, uint32_t> &rhs) {
+        return lhs.first > rhs.first;
+    });
+    uint32_t count = _maxUpdatesPerFrame;
+    if (_updateTime > 0.F && _frameBudget > 0.F) {
+        count = std::min(count, std::max(static_cast<uint32_t>(_frameBudget / _updateTime), 1U));
+    }
+    count = std::min(count, static_cast<uint32_t>(_priorities.size()));
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t index = _priorities[i].second;
+        auto &         entry = _entries[candidates[index].key];
+        entry.viewProj       = viewProj;
+        entry.stamp          = candidates[index].stamp;
+        entry.lastUpdate     = _frame;
+        entry.valid          = true;
+        updates.emplace_back(index);
+    }
+
+    // the reflectors not seen this frame are gone or culled, their results are out of date anyway
+    for (auto iter = _entries.begin(); iter != _entries.end();) {
+        if (iter->second.lastSeen != _frame) {
+            CC_SAFE_DESTROY_AND_DELETE(iter->second.texture);
+            iter = _entries.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 } // namespace cc
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include "base/TypeDef.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
 #include "math/Mat4.h"
 #include "math/Vec2.h"
 #include "math/Vec4.h"
@@ -18,6 +21,68 @@ struct ShaderSources {
     T glsl1;
 };
 
+/**
+ * @en Decides which reflectors refresh their screen space reflection each frame, and keeps the result of every reflector so the
+ * others reuse the one of an earlier frame. Reflectors are picked by coverage, distance and the frames since their last update,
+ * so the stale ones are refreshed round-robin. A reflector that has not moved under an unchanged camera is cached as static and
+ * only refreshed every few frames. The number of updates per frame follows the measured GPU time of an update when available.
+ * @zh 决定每帧刷新哪些反射体的屏幕空间反射，并保存每个反射体的结果，未刷新的反射体复用之前帧的结果。按屏幕覆盖率、距离与距上次刷新的帧数
+ * 选取反射体，过期的反射体轮流刷新。相机不变且自身未移动的反射体作为静态反射缓存，每隔若干帧才刷新。有 GPU 计时数据时每帧刷新数量根据单次刷新耗时确定。
+ */
+class ReflectionScheduler {
+public:
+    struct Candidate {
+        const void *key{nullptr};  // stable identity of the reflector
+        float       coverage{0.F}; // estimated fraction of the screen, in [0, 1]
+        float       distance{0.F};
+        uint32_t    stamp{0}; // changes whenever the reflector moves
+    };
+
+    ReflectionScheduler() = default;
+    ~ReflectionScheduler();
+
+    // milliseconds of GPU time per frame spent on reflection updates
+    inline float getFrameBudget() const { return _frameBudget; }
+    inline void  setFrameBudget(float ms) { _frameBudget = ms; }
+    // upper bound of the updates per frame, the only bound while no timing is measured
+    inline uint32_t getMaxUpdatesPerFrame() const { return _maxUpdatesPerFrame; }
+    inline void     setMaxUpdatesPerFrame(uint32_t count) { _maxUpdatesPerFrame = std::max(count, 1U); }
+    // frames a static reflection is reused before it is refreshed, 0 to never refresh it
+    inline uint32_t getStaticRefreshInterval() const { return _staticRefreshInterval; }
+    inline void     setStaticRefreshInterval(uint32_t frames) { _staticRefreshInterval = frames; }
+
+    /**
+     * @en Pick the candidates to update this frame, their indices are written to updates in priority order. updateTime is the
+     * measured GPU time of one update in milliseconds, 0 if unknown. The results are recreated when the size changes.
+     * @zh 选取本帧需要刷新的候选反射体，按优先级将其索引写入 updates。updateTime 为测得的单次刷新 GPU 耗时（毫秒），未知时为 0。尺寸变化时重新创建结果贴图。
+     */
+    void schedule(gfx::Device *device, uint32_t width, uint32_t height, const Mat4 &viewProj, const ccstd::vector<Candidate> &candidates, float updateTime, ccstd::vector<uint32_t> &updates);
+
+    // the result texture of a scheduled reflector, nullptr if it has never been updated
+    gfx::Texture *getResult(const void *key) const;
+    void          clear();
+
+private:
+    struct Entry {
+        gfx::Texture *texture{nullptr};
+        Mat4          viewProj;
+        uint32_t      stamp{0};
+        uint32_t      lastUpdate{0};
+        uint32_t      lastSeen{0};
+        bool          valid{false};
+    };
+
+    ccstd::unordered_map<const void *, Entry> _entries;
+    ccstd::vector<std::pair<float, uint32_t>> _priorities;
+    uint32_t                                  _frame{0};
+    uint32_t                                  _width{0};
+    uint32_t                                  _height{0};
+    uint32_t                                  _maxUpdatesPerFrame{5};
+    uint32_t                                  _staticRefreshInterval{30};
+    float                                     _frameBudget{1.F};
+    float                                     _updateTime{0.F};
+};
+
 class ReflectionComp {
 public:
     ReflectionComp() = default;
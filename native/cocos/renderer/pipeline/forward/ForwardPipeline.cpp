@@ -24,6 +24,7 @@
 ****************************************************************************/
 
 #include "ForwardPipeline.h"
+#include "../ClusterLightCulling.h"
 #include "../GlobalDescriptorSetManager.h"
 #include "../PipelineSceneData.h"
 #include "../PipelineUBO.h"
@@ -98,6 +99,10 @@ void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     }
 
     _commandBuffers[0]->begin();
+    _gpuTimer.beginFrame(device, _commandBuffers[0]);
+    _computeMorphing.dispatch(_commandBuffers[0]);
+    _computeSkinning.dispatch(_commandBuffers[0]);
+    _environmentPrefilter.dispatch(_commandBuffers[0], &_gpuTimer);
 
     if (enableOcclusionQuery) {
         _commandBuffers[0]->resetQueryPool(_queryPools[0]);
@@ -108,9 +113,24 @@ void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
     ensureEnoughSize(cameras);
     decideProfilerCamera(cameras);
 
-    for (auto *camera : cameras) {
-        validPunctualLightsCulling(this, camera);
-        sceneCulling(this, camera);
+    const bool parallelCulling = useParallelCulling(cameras);
+    if (parallelCulling) {
+        sceneCullingParallel(this, cameras, true, _sceneCullingResults);
+    }
+
+    for (size_t i = 0; i < cameras.size(); ++i) {
+        auto *camera = cameras[i];
+        if (parallelCulling) {
+            applySceneCullingResult(this, camera, true, _sceneCullingResults[i]);
+        } else {
+            validPunctualLightsCulling(this, camera);
+            sceneCulling(this, camera);
+        }
+
+        if (_clusterEnabled) {
+            _clusterComp->clusterLightCulling(camera);
+        }
+
         for (auto *const flow : _flows) {
             flow->render(camera);
         }
@@ -124,6 +144,7 @@ void ForwardPipeline::render(const ccstd::vector<scene::Camera *> &cameras) {
         _commandBuffers[0]->completeQueryPool(_queryPools[0]);
     }
 
+    _gpuTimer.endFrame();
     _commandBuffers[0]->end();
     _device->flushCommands(_commandBuffers);
     _device->getQueue()->submit(_commandBuffers);
@@ -143,8 +164,9 @@ bool ForwardPipeline::activeRenderer(gfx::Swapchain *swapchain) {
     _descriptorSet->update();
 
     // update global defines when all states initialized.
-    _macros["CC_USE_HDR"]               = static_cast<bool>(_pipelineSceneData->isHDR());
-    _macros["CC_SUPPORT_FLOAT_TEXTURE"] = hasAnyFlags(_device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE);
+    _macros["CC_USE_HDR"]                   = static_cast<bool>(_pipelineSceneData->isHDR());
+    _macros["CC_SUPPORT_FLOAT_TEXTURE"]     = hasAnyFlags(_device->getFormatFeatures(gfx::Format::RGBA32F), gfx::FormatFeature::RENDER_TARGET | gfx::FormatFeature::SAMPLED_TEXTURE);
+    _macros["CC_SUPPORT_BINDLESS_TEXTURES"] = getGlobalDSManager()->getBindlessTextureTable() != nullptr;
 
     // step 2 create index buffer
     uint ibStride = 4;
@@ -163,6 +185,13 @@ bool ForwardPipeline::activeRenderer(gfx::Swapchain *swapchain) {
 
     _width  = swapchain->getWidth();
     _height = swapchain->getHeight();
+
+    if (_clusterEnabled) {
+        // cluster component resource
+        _clusterComp = new ClusterLightCulling(this);
+        _clusterComp->initialize(this->getDevice());
+    }
+
     return true;
 }
 
@@ -176,6 +205,8 @@ bool ForwardPipeline::destroy() {
     _queryPools.clear();
     _commandBuffers.clear();
 
+    CC_SAFE_DELETE(_clusterComp);
+
     return RenderPipeline::destroy();
 }
 
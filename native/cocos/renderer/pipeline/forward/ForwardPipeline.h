@@ -35,6 +35,7 @@ namespace pipeline {
 struct UBOGlobal;
 struct UBOCamera;
 struct UBOShadow;
+class ClusterLightCulling;
 
 class CC_DLL ForwardPipeline : public RenderPipeline {
 public:
@@ -66,6 +67,9 @@ private:
     gfx::BufferList _lightBuffers;
     UintList        _lightIndexOffsets;
     UintList        _lightIndices;
+
+    // forward+: builds the cluster light lists shaded by the single additive draw of each model
+    ClusterLightCulling *_clusterComp{nullptr};
 };
 
 } // namespace pipeline
@@ -45,6 +45,14 @@
 
 namespace cc {
 namespace pipeline {
+namespace {
+// opaque, instanced, batched, additive and one for the rest
+constexpr uint SECONDARY_COMMAND_BUFFER_COUNT = 5;
+
+framegraph::StringHandle fgStrHandleClusterLightBuffer      = framegraph::FrameGraph::stringToHandle("clusterLightBuffer");
+framegraph::StringHandle fgStrHandleClusterLightIndexBuffer = framegraph::FrameGraph::stringToHandle("lightIndexBuffer");
+framegraph::StringHandle fgStrHandleClusterLightGridBuffer  = framegraph::FrameGraph::stringToHandle("lightGridBuffer");
+} // namespace
 
 RenderStageInfo ForwardStage::initInfo = {
     "ForwardStage",
@@ -75,7 +83,7 @@ void ForwardStage::activate(RenderPipeline *pipeline, RenderFlow *flow) {
     for (const auto &descriptor : _renderQueueDescriptors) {
         uint                  phase    = convertPhase(descriptor.stages);
         RenderQueueSortFunc   sortFunc = convertQueueSortFunc(descriptor.sortMode);
-        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc};
+        RenderQueueCreateInfo info     = {descriptor.isTransparent, phase, sortFunc, true, descriptor.sortMode};
         _renderQueues.emplace_back(CC_NEW(RenderQueue(_pipeline, std::move(info), true)));
     }
 
@@ -142,6 +150,10 @@ void ForwardStage::render(scene::Camera *camera) {
     struct RenderData {
         framegraph::TextureHandle outputTex;
         framegraph::TextureHandle depth;
+        // forward+ light lists
+        framegraph::BufferHandle lightBuffer;
+        framegraph::BufferHandle lightIndexBuffer;
+        framegraph::BufferHandle lightGridBuffer;
     };
     auto *      pipeline  = static_cast<ForwardPipeline *>(_pipeline);
     auto *const sceneData = _pipeline->getPipelineSceneData();
@@ -153,11 +165,15 @@ void ForwardStage::render(scene::Camera *camera) {
     auto *cmdBuff{pipeline->getCommandBuffers()[0]};
     pipeline->getPipelineUBO()->updateShadowUBO(camera);
 
-    _instancedQueue->uploadBuffers(cmdBuff);
+    _instancedQueue->uploadBuffers(cmdBuff, camera);
     _batchedQueue->uploadBuffers(cmdBuff);
     _additiveLightQueue->gatherLightPasses(camera, cmdBuff);
     _planarShadowQueue->gatherShadowPasses(camera, cmdBuff);
-    auto forwardSetup = [&](framegraph::PassNodeBuilder &builder, RenderData &data) {
+    // opaque, instanced, batched and additive queues are recorded as jobs, the others on the calling thread
+    const bool parallelRecording = pipeline->useParallelRecording() && !sceneData->getRenderObjects().empty();
+    // stereo cameras render both views in one pass where multiview is supported
+    const uint32_t viewCount    = _device->hasFeature(gfx::Feature::MULTIVIEW) ? camera->getViewCount() : 1U;
+    auto           forwardSetup = [&](framegraph::PassNodeBuilder &builder, RenderData &data) {
         if (hasFlag(static_cast<gfx::ClearFlags>(camera->getClearFlag()), gfx::ClearFlagBit::COLOR)) {
             _clearColors[0].x = camera->getClearColor().x;
             _clearColors[0].y = camera->getClearColor().y;
@@ -173,6 +189,10 @@ void ForwardStage::render(scene::Camera *camera) {
         if (shadingScale != 1.F) {
             colorTexInfo.usage |= gfx::TextureUsageBit::TRANSFER_SRC;
         }
+        if (viewCount > 1) {
+            colorTexInfo.type       = gfx::TextureType::TEX2D_ARRAY;
+            colorTexInfo.layerCount = viewCount;
+        }
         data.outputTex = builder.create(RenderPipeline::fgStrHandleOutColorTexture, colorTexInfo);
         framegraph::RenderTargetAttachment::Descriptor colorAttachmentInfo;
         colorAttachmentInfo.usage      = framegraph::RenderTargetAttachment::Usage::COLOR;
@@ -198,6 +218,10 @@ void ForwardStage::render(scene::Camera *camera) {
             static_cast<uint>(static_cast<float>(camera->getWindow()->getWidth()) * shadingScale),
             static_cast<uint>(static_cast<float>(camera->getWindow()->getHeight()) * shadingScale),
         };
+        if (viewCount > 1) {
+            depthTexInfo.type       = gfx::TextureType::TEX2D_ARRAY;
+            depthTexInfo.layerCount = viewCount;
+        }
 
         framegraph::RenderTargetAttachment::Descriptor depthAttachmentInfo;
         depthAttachmentInfo.usage         = framegraph::RenderTargetAttachment::Usage::DEPTH_STENCIL;
@@ -212,12 +236,53 @@ void ForwardStage::render(scene::Camera *camera) {
         data.depth = builder.create(RenderPipeline::fgStrHandleOutDepthTexture, depthTexInfo);
         data.depth = builder.write(data.depth, depthAttachmentInfo);
         builder.writeToBlackboard(RenderPipeline::fgStrHandleOutDepthTexture, data.depth);
+        if (_pipeline->isClusterEnabled()) {
+            // read cluster and light info
+            data.lightBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightBuffer));
+            if (data.lightBuffer.isValid()) {
+                builder.read(data.lightBuffer);
+            }
+            data.lightIndexBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightIndexBuffer));
+            if (data.lightIndexBuffer.isValid()) {
+                builder.read(data.lightIndexBuffer);
+            }
+            data.lightGridBuffer = framegraph::BufferHandle(builder.readFromBlackboard(fgStrHandleClusterLightGridBuffer));
+            if (data.lightGridBuffer.isValid()) {
+                builder.read(data.lightGridBuffer);
+            }
+        }
         builder.setViewport(pipeline->getViewport(camera), pipeline->getScissor(camera));
+        builder.setViewCount(viewCount);
+        if (parallelRecording) {
+            builder.setSecondaryCommandBuffers(getSecondaryCommandBuffers(SECONDARY_COMMAND_BUFFER_COUNT));
+        }
     };
 
     auto offset      = _pipeline->getPipelineUBO()->getCurrentCameraUBOOffset();
-    auto forwardExec = [this, camera, offset, pipeline](const RenderData & /*data*/, const framegraph::DevicePassResourceTable &table) {
+    auto forwardExec = [this, camera, offset, pipeline](const RenderData &data, const framegraph::DevicePassResourceTable &table) {
         auto *renderPass = table.getRenderPass();
+        if (_pipeline->isClusterEnabled()) {
+            _additiveLightQueue->bindClusterBuffers(data.lightBuffer.isValid() ? table.getRead(data.lightBuffer) : nullptr,
+                                                    data.lightIndexBuffer.isValid() ? table.getRead(data.lightIndexBuffer) : nullptr,
+                                                    data.lightGridBuffer.isValid() ? table.getRead(data.lightGridBuffer) : nullptr);
+        }
+        if (!table.getSecondaryCommandBuffers().empty()) {
+            recordSecondaryCommandBuffers(table, camera, offset,
+                                          {[&](gfx::CommandBuffer *cmdBuff) { _renderQueues[0]->recordCommandBuffer(_device, camera, renderPass, cmdBuff); },
+                                           [&](gfx::CommandBuffer *cmdBuff) { _instancedQueue->recordCommandBuffer(_device, renderPass, cmdBuff); },
+                                           [&](gfx::CommandBuffer *cmdBuff) { _batchedQueue->recordCommandBuffer(_device, renderPass, cmdBuff); },
+                                           [&](gfx::CommandBuffer *cmdBuff) { _additiveLightQueue->recordCommandBuffer(_device, camera, renderPass, cmdBuff); },
+                                           [&](gfx::CommandBuffer *cmdBuff) {
+                                               _planarShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuff);
+                                               _renderQueues[1]->recordCommandBuffer(_device, camera, renderPass, cmdBuff);
+                                               camera->getGeometryRenderer()->render(renderPass, cmdBuff, pipeline->getPipelineSceneData());
+                                               _uiPhase->render(camera, renderPass, cmdBuff);
+                                               renderProfiler(renderPass, cmdBuff, _pipeline->getProfiler(), camera);
+                                               renderDebugRenderer(renderPass, cmdBuff, _pipeline->getPipelineSceneData(), camera);
+                                           }});
+            return;
+        }
+
         auto *cmdBuff    = _pipeline->getCommandBuffers()[0];
         cmdBuff->bindDescriptorSet(globalSet, _pipeline->getDescriptorSet(), 1, &offset);
         if (!_pipeline->getPipelineSceneData()->getRenderObjects().empty()) {
@@ -65,7 +65,7 @@ void renderProfiler(gfx::RenderPass *renderPass, gfx::CommandBuffer *cmdBuff, sc
 
         cmdBuff->bindPipelineState(pso);
         cmdBuff->bindDescriptorSet(materialSet, pass->getDescriptorSet());
-        cmdBuff->bindDescriptorSet(localSet, submodel->getDescriptorSet());
+        cmdBuff->bindDescriptorSet(localSet, submodel->getDrawDescriptorSet());
         cmdBuff->bindInputAssembler(ia);
         cmdBuff->draw(ia);
     }
@@ -0,0 +1,409 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ShadowAtlas.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "boost/container_hash/hash.hpp"
+#include "core/scene-graph/Node.h"
+#include "gfx-base/GFXDevice.h"
+#include "gfx-base/GFXFramebuffer.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+#include "scene/SpotLight.h"
+
+namespace cc {
+namespace pipeline {
+
+ShadowAtlas::~ShadowAtlas() {
+    destroy();
+}
+
+void ShadowAtlas::setSize(uint32_t size) {
+    size = std::max(size, MIN_TILE_SIZE * 4);
+    if (_size != size) {
+        _size = size;
+        // recreated by the shadow flow on its next render
+        destroy();
+    }
+}
+
+void ShadowAtlas::initialize(gfx::RenderPass *renderPass, gfx::Format format) {
+    destroy();
+
+    auto *device = gfx::Device::getInstance();
+    auto *color  = device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        format,
+        _size,
+        _size,
+    });
+    auto *depth = device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT,
+        gfx::Format::DEPTH,
+        _size,
+        _size,
+    });
+    _textures.emplace_back(color);
+    _textures.emplace_back(depth);
+    _framebuffer = device->createFramebuffer({
+        renderPass,
+        {color},
+        depth,
+    });
+
+    _nodes.assign(levelBase(getMaxLevel() + 1), NodeState::FREE);
+    _emptyTile        = getNodeRect(allocateNode(getMaxLevel()));
+    _emptyTileCleared = false;
+}
+
+void ShadowAtlas::destroy() {
+    CC_SAFE_DESTROY_AND_DELETE(_framebuffer);
+    for (auto *texture : _textures) {
+        CC_SAFE_DESTROY_AND_DELETE(texture);
+    }
+    _textures.clear();
+    _nodes.clear();
+    _tiles.clear();
+    _scheduled.clear();
+    _emptyTileCleared = false;
+    updateStats();
+}
+
+gfx::Texture *ShadowAtlas::getTexture() const {
+    return _framebuffer ? _framebuffer->getColorTextures()[0] : nullptr;
+}
+
+uint32_t ShadowAtlas::getMaxLevel() const {
+    uint32_t level = 0;
+    while ((_size >> (level + 1)) >= MIN_TILE_SIZE) {
+        ++level;
+    }
+    return level;
+}
+
+uint32_t ShadowAtlas::getLevel(uint32_t node) const {
+    uint32_t level = 0;
+    while (levelBase(level + 1) <= node) {
+        ++level;
+    }
+    return level;
+}
+
+gfx::Rect ShadowAtlas::getNodeRect(uint32_t node) const {
+    const uint32_t level    = getLevel(node);
+    const uint32_t local    = node - levelBase(level);
+    const uint32_t side     = 1U << level;
+    const uint32_t tileSize = _size >> level;
+    return {static_cast<int32_t>(local % side * tileSize), static_cast<int32_t>(local / side * tileSize), tileSize, tileSize};
+}
+
+uint32_t ShadowAtlas::desiredLevel(float importance) const {
+    // the largest tile is a quarter of the atlas, the tile shrinks with the screen coverage of its light
+    const float    tileSize = importance * static_cast<float>(_size >> 1);
+    const uint32_t maxLevel = getMaxLevel();
+    uint32_t       level    = 1;
+    while (level < maxLevel && static_cast<float>(_size >> (level + 1)) >= tileSize) {
+        ++level;
+    }
+    return level;
+}
+
+uint32_t ShadowAtlas::allocateNode(uint32_t level) {
+    // a node is reachable when its parent is split, take the free ones of the requested level first
+    const auto parentOf = [](uint32_t level, uint32_t local) {
+        const uint32_t side = 1U << level;
+        return levelBase(level - 1) + (local / side / 2) * (side / 2) + (local % side / 2);
+    };
+    const uint32_t count = 1U << (2 * level);
+    for (uint32_t local = 0; local < count; ++local) {
+        const uint32_t node = levelBase(level) + local;
+        if (_nodes[node] == NodeState::FREE && (level == 0 || _nodes[parentOf(level, local)] == NodeState::SPLIT)) {
+            _nodes[node] = NodeState::USED;
+            return node;
+        }
+    }
+
+    // then split the smallest reachable free block above it
+    for (int32_t l = static_cast<int32_t>(level) - 1; l >= 0; --l) {
+        const auto     ul         = static_cast<uint32_t>(l);
+        const uint32_t levelCount = 1U << (2 * ul);
+        for (uint32_t local = 0; local < levelCount; ++local) {
+            const uint32_t node = levelBase(ul) + local;
+            if (_nodes[node] != NodeState::FREE || (ul > 0 && _nodes[parentOf(ul, local)] != NodeState::SPLIT)) {
+                continue;
+            }
+            uint32_t side = 1U << ul;
+            uint32_t x    = local % side;
+            uint32_t y    = local / side;
+            uint32_t curr = node;
+            for (uint32_t k = ul; k < level; ++k) {
+                _nodes[curr] = NodeState::SPLIT;
+                side <<= 1;
+                x <<= 1;
+                y <<= 1;
+                curr = levelBase(k + 1) + y * side + x;
+            }
+            _nodes[curr] = NodeState::USED;
+            return curr;
+        }
+    }
+    return 0;
+}
+
+void ShadowAtlas::freeNode(uint32_t node) {
+    _nodes[node] = NodeState::FREE;
+    uint32_t level = getLevel(node);
+    uint32_t local = node - levelBase(level);
+    // merge the siblings back into their parent once they are all free
+    while (level > 0) {
+        const uint32_t side   = 1U << level;
+        const uint32_t x      = (local % side) & ~1U;
+        const uint32_t y      = (local / side) & ~1U;
+        const uint32_t first  = levelBase(level) + y * side + x;
+        const bool     merged = _nodes[first] == NodeState::FREE && _nodes[first + 1] == NodeState::FREE &&
+                            _nodes[first + side] == NodeState::FREE && _nodes[first + side + 1] == NodeState::FREE;
+        if (!merged) {
+            break;
+        }
+        local = (y / 2) * (side / 2) + x / 2;
+        --level;
+        _nodes[levelBase(level) + local] = NodeState::FREE;
+    }
+}
+
+bool ShadowAtlas::allocateTile(Tile &tile, uint32_t level, float importance) {
+    const uint32_t maxLevel = getMaxLevel();
+    while (true) {
+        // fall back to smaller tiles before taking space from other lights
+        for (uint32_t l = level; l <= maxLevel; ++l) {
+            const uint32_t node = allocateNode(l);
+            if (node) {
+                tile.node     = node;
+                tile.rect     = getNodeRect(node);
+                tile.rendered = false;
+                tile.dirty    = true;
+                ++_stats.allocations;
+                return true;
+            }
+        }
+
+        Tile *victim = nullptr;
+        for (auto &pair : _tiles) {
+            Tile &other = pair.second;
+            if (&other != &tile && other.node && other.importance < importance && (!victim || other.importance < victim->importance)) {
+                victim = &other;
+            }
+        }
+        if (!victim) {
+            return false;
+        }
+        releaseTile(*victim);
+        ++_stats.evictions;
+    }
+}
+
+void ShadowAtlas::releaseTile(Tile &tile) {
+    if (tile.node) {
+        freeNode(tile.node);
+    }
+    tile.node     = 0;
+    tile.rendered = false;
+    tile.dirty    = true;
+}
+
+void ShadowAtlas::update(const scene::Camera *camera, const ccstd::vector<const scene::Light *> &lights, uint32_t frame) {
+    if (!_framebuffer) {
+        return;
+    }
+
+    if (frame != _frame) {
+        _frame                = frame;
+        _frameUpdates         = 0;
+        _stats.updatedTiles   = 0;
+        _stats.failedRequests = 0;
+        for (auto iter = _tiles.begin(); iter != _tiles.end();) {
+            if (iter->second.lastSeen + 1 < frame) {
+                releaseTile(iter->second);
+                ++_stats.releases;
+                iter = _tiles.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
+    // estimate the fraction of the screen covered by the range of each light
+    const float tanHalfFov = camera->getProjectionType() == scene::CameraProjection::PERSPECTIVE ? std::tan(camera->getFov() * 0.5F) : 1.F;
+    _candidates.clear();
+    for (const auto *light : lights) {
+        if (light->getType() != scene::LightType::SPOT) {
+            continue;
+        }
+        const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+        const float distance  = spotLight->getPosition().distance(camera->getPosition());
+        const float range     = spotLight->getRange();
+        const float coverage  = distance > range ? range / (distance * tanHalfFov) : 1.F;
+        _candidates.emplace_back(std::min(coverage, 1.F), light);
+    }
+    std::sort(_candidates.begin(), _candidates.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    for (const auto &candidate : _candidates) {
+        Tile &tile = _tiles[candidate.second];
+        if (tile.lastSeen == frame && tile.node) {
+            // already placed for another camera of this frame
+            tile.importance = std::max(tile.importance, candidate.first);
+            continue;
+        }
+        tile.light      = candidate.second;
+        tile.lastSeen   = frame;
+        tile.importance = candidate.first;
+
+        const uint32_t level = desiredLevel(candidate.first);
+        if (tile.node) {
+            // keep a tile one step larger than needed, so lights near a size threshold do not move back and forth
+            const uint32_t current = getLevel(tile.node);
+            if (current == level || current + 1 == level) {
+                continue;
+            }
+            releaseTile(tile);
+        }
+        if (!allocateTile(tile, level, candidate.first)) {
+            ++_stats.failedRequests;
+        }
+    }
+
+    updateStats();
+}
+
+Mat4 ShadowAtlas::computeLightViewProj(const scene::Light *light) {
+    const auto *spotLight = static_cast<const scene::SpotLight *>(light);
+    Mat4        viewProj;
+    Mat4::createPerspective(spotLight->getSpotAngle(), spotLight->getAspect(), 0.001F, spotLight->getRange(), &viewProj);
+    viewProj.multiply(spotLight->getNode()->getWorldMatrix().getInversed());
+    return viewProj;
+}
+
+void ShadowAtlas::checkCasters(const scene::Light *light, const RenderObjectList &casters) {
+    auto iter = _tiles.find(light);
+    if (iter == _tiles.end() || !iter->second.node) {
+        return;
+    }
+
+    Tile & tile    = iter->second;
+    size_t hash    = casters.size();
+    bool   changed = false;
+    for (const auto &ro : casters) {
+        const auto *model = ro.model;
+        boost::hash_combine(hash, model);
+        // skinned casters deform without moving their node
+        const auto type = model->getType();
+        if (type == scene::Model::Type::SKINNING || type == scene::Model::Type::BAKED_SKINNING) {
+            changed = true;
+        } else if (model->getTransform() && model->getTransform()->getChangedFlags() != 0) {
+            changed = true;
+        }
+    }
+
+    const Mat4 viewProj = computeLightViewProj(light);
+    if (changed || hash != tile.casterHash || memcmp(viewProj.m, tile.viewProj.m, sizeof(viewProj.m)) != 0) {
+        tile.dirty = true;
+    }
+    tile.casterHash = hash;
+    tile.viewProj   = viewProj;
+}
+
+void ShadowAtlas::schedule(ccstd::vector<const Tile *> &out) {
+    out.clear();
+    _scheduled.clear();
+    for (auto &pair : _tiles) {
+        Tile &tile = pair.second;
+        if (tile.node && tile.lastSeen == _frame && (tile.dirty || !tile.rendered)) {
+            _scheduled.emplace_back(&tile);
+        }
+    }
+
+    // tiles without content first, then the important ones which waited longest
+    const uint32_t frame = _frame;
+    std::sort(_scheduled.begin(), _scheduled.end(), [frame](const Tile *a, const Tile *b) {
+        if (a->rendered != b->rendered) {
+            return !a->rendered;
+        }
+        return a->importance * static_cast<float>(frame - a->lastUpdate + 1) > b->importance * static_cast<float>(frame - b->lastUpdate + 1);
+    });
+
+    const uint32_t budget = _updateBudget > _frameUpdates ? _updateBudget - _frameUpdates : 0;
+    const auto     count  = std::min(static_cast<uint32_t>(_scheduled.size()), budget);
+    for (uint32_t i = 0; i < count; ++i) {
+        out.emplace_back(_scheduled[i]);
+    }
+    _stats.pendingTiles = static_cast<uint32_t>(_scheduled.size()) - count;
+}
+
+void ShadowAtlas::markRendered(const scene::Light *light) {
+    auto iter = _tiles.find(light);
+    if (iter == _tiles.end()) {
+        return;
+    }
+    Tile &tile      = iter->second;
+    tile.rendered   = true;
+    tile.dirty      = false;
+    tile.lastUpdate = _frame;
+    ++_frameUpdates;
+    ++_stats.updatedTiles;
+}
+
+const ShadowAtlas::Tile *ShadowAtlas::getTile(const scene::Light *light) const {
+    auto iter = _tiles.find(light);
+    return iter != _tiles.end() && iter->second.node ? &iter->second : nullptr;
+}
+
+Vec4 ShadowAtlas::getTileInfo(const scene::Light *light) const {
+    const Tile *     tile = getTile(light);
+    const gfx::Rect &rect = tile && tile->rendered ? tile->rect : _emptyTile;
+    const auto       size = static_cast<float>(_size);
+    return {static_cast<float>(rect.x) / size, static_cast<float>(rect.y) / size,
+            static_cast<float>(rect.width) / size, static_cast<float>(rect.height) / size};
+}
+
+void ShadowAtlas::updateStats() {
+    uint32_t tileCount = 0;
+    uint64_t area      = 0;
+    for (const auto &pair : _tiles) {
+        if (pair.second.node) {
+            ++tileCount;
+            area += static_cast<uint64_t>(pair.second.rect.width) * pair.second.rect.height;
+        }
+    }
+    _stats.tileCount = tileCount;
+    _stats.occupancy = static_cast<float>(static_cast<double>(area) / (static_cast<double>(_size) * _size));
+}
+
+} // namespace pipeline
+} // namespace cc
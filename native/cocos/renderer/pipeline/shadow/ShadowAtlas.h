@@ -0,0 +1,159 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include "../Define.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "math/Mat4.h"
+#include "math/Vec4.h"
+
+namespace cc {
+namespace scene {
+class Camera;
+class Light;
+} // namespace scene
+namespace gfx {
+class Framebuffer;
+class RenderPass;
+class Texture;
+} // namespace gfx
+namespace pipeline {
+
+struct CC_DLL ShadowAtlasStats {
+    uint32_t tileCount{0};      // lights holding a tile
+    float    occupancy{0.F};    // fraction of the atlas covered by tiles
+    uint32_t updatedTiles{0};   // tiles re-rendered in the last frame
+    uint32_t pendingTiles{0};   // dirty tiles left to later frames by the update budget
+    uint32_t allocations{0};    // tiles allocated since the atlas was created
+    uint32_t evictions{0};      // tiles taken from less important lights
+    uint32_t releases{0};       // tiles freed because their light was no longer rendered
+    uint32_t failedRequests{0}; // lights left without a tile in the last frame because the atlas was full
+};
+
+/**
+ * @en Shared shadow map of the spot lights. Each shadowed light owns a square tile whose size follows its estimated screen
+ * coverage, tiles are allocated from a quadtree and taken from the least important lights when the atlas is full.
+ * A tile is only re-rendered when it is new, or when its light or the casters inside the light frustum changed,
+ * and at most getUpdateBudget() tiles are re-rendered per frame, the most important and stalest first.
+ * @zh 聚光灯共享的阴影贴图。每个投射阴影的光源拥有一个正方形的图块，其尺寸随光源的估计屏幕覆盖率变化，图块从四叉树中分配，图集满时从最不重要的光源处回收。
+ * 图块只在新分配、光源或光源视锥内的投射者变化时重新绘制，每帧最多重新绘制 getUpdateBudget() 个图块，最重要且最久未更新的优先。
+ */
+class CC_DLL ShadowAtlas final {
+public:
+    static constexpr uint32_t MIN_TILE_SIZE = 128;
+
+    struct Tile {
+        const scene::Light *light{nullptr};
+        gfx::Rect           rect;
+        uint32_t            node{0};
+        float               importance{0.F};
+        bool                rendered{false}; // holds the depth of its light since allocated
+        bool                dirty{true};
+        Mat4                viewProj;        // the light matrix the tile was rendered with
+        size_t              casterHash{0};
+        uint32_t            lastSeen{0};
+        uint32_t            lastUpdate{0};
+    };
+
+    ShadowAtlas() = default;
+    ~ShadowAtlas();
+
+    // size in texels of the atlas side, a power of two, the atlas is recreated on the next render when it changes
+    inline uint32_t getSize() const { return _size; }
+    void            setSize(uint32_t size);
+    // tiles re-rendered per frame at most
+    inline uint32_t getUpdateBudget() const { return _updateBudget; }
+    inline void     setUpdateBudget(uint32_t tiles) { _updateBudget = std::max(tiles, 1U); }
+    inline const ShadowAtlasStats &getStats() const { return _stats; }
+
+    void initialize(gfx::RenderPass *renderPass, gfx::Format format);
+    void destroy();
+
+    inline gfx::Framebuffer *getFramebuffer() const { return _framebuffer; }
+    gfx::Texture *           getTexture() const;
+    // the empty tile is cleared to the far depth once, lights without a rendered tile sample it
+    inline const gfx::Rect &getEmptyTile() const { return _emptyTile; }
+    inline bool             isEmptyTileCleared() const { return _emptyTileCleared; }
+    inline void             setEmptyTileCleared() { _emptyTileCleared = true; }
+
+    /**
+     * @en Allocate the tiles of the shadowed spot lights seen by a camera, may be called for every camera of a frame.
+     * @zh 为相机可见的投射阴影的聚光灯分配图块，一帧内可对每个相机调用。
+     */
+    void update(const scene::Camera *camera, const ccstd::vector<const scene::Light *> &lights, uint32_t frame);
+
+    // mark the tile of light dirty if its light matrix or its casters changed since it was rendered
+    void checkCasters(const scene::Light *light, const RenderObjectList &casters);
+
+    // the tiles to render for this camera in priority order, within what is left of the budget of the frame
+    void schedule(ccstd::vector<const Tile *> &out);
+    void markRendered(const scene::Light *light);
+
+    const Tile *getTile(const scene::Light *light) const;
+    // xy the offset and zw the scale mapping the light uv into its tile, the empty tile if the light has no rendered tile
+    Vec4 getTileInfo(const scene::Light *light) const;
+
+    static Mat4 computeLightViewProj(const scene::Light *light);
+
+private:
+    enum class NodeState : uint8_t {
+        FREE,
+        SPLIT,
+        USED,
+    };
+
+    static inline uint32_t levelBase(uint32_t level) { return ((1U << (2 * level)) - 1) / 3; }
+    uint32_t               getMaxLevel() const;
+    uint32_t               getLevel(uint32_t node) const;
+    gfx::Rect              getNodeRect(uint32_t node) const;
+    uint32_t               desiredLevel(float importance) const;
+
+    // the node of a free block at level, 0 if none is left
+    uint32_t allocateNode(uint32_t level);
+    void     freeNode(uint32_t node);
+    bool     allocateTile(Tile &tile, uint32_t level, float importance);
+    void     releaseTile(Tile &tile);
+    void     updateStats();
+
+    gfx::Framebuffer *                                    _framebuffer{nullptr};
+    ccstd::vector<gfx::Texture *>                         _textures;
+    ccstd::vector<NodeState>                              _nodes;
+    ccstd::unordered_map<const scene::Light *, Tile>      _tiles;
+    ccstd::vector<Tile *>                                 _scheduled;
+    ccstd::vector<std::pair<float, const scene::Light *>> _candidates; // importance and light
+    gfx::Rect                                             _emptyTile;
+    bool                                                  _emptyTileCleared{false};
+    uint32_t                                              _size{4096};
+    uint32_t                                              _updateBudget{2};
+    uint32_t                                              _frame{0};
+    uint32_t                                              _frameUpdates{0};
+    ShadowAtlasStats                                      _stats;
+};
+
+} // namespace pipeline
+} // namespace cc
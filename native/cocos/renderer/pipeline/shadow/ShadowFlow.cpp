@@ -32,12 +32,14 @@
 #include "../SceneCulling.h"
 #include "../forward/ForwardPipeline.h"
 #include "ShadowStage.h"
+#include "core/Root.h"
 #include "gfx-base/GFXDevice.h"
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/RenderScene.h"
 #include "scene/Shadow.h"
+#include "scene/SpotLight.h"
 
 namespace cc {
 namespace pipeline {
@@ -96,6 +98,10 @@ void ShadowFlow::render(scene::Camera *camera) {
             initShadowFrameBuffer(_pipeline, mainLight);
         }
 
+        if (_staticCasterCacheEnabled && !_staticLayerFramebuffer) {
+            initStaticShadowLayer();
+        }
+
         auto *shadowFrameBuffer = shadowFramebufferMap.at(mainLight);
         for (auto *stage : _stages) {
             auto *shadowStage = static_cast<ShadowStage *>(stage);
@@ -104,6 +110,11 @@ void ShadowFlow::render(scene::Camera *camera) {
         }
     }
 
+    if (_shadowAtlasEnabled) {
+        renderAtlas(camera);
+        return;
+    }
+
     for (uint l = 0; l < _validLights.size(); ++l) {
         const scene::Light *light    = _validLights[l];
         gfx::DescriptorSet *globalDS = _pipeline->getGlobalDSManager()->getOrCreateDescriptorSet(l);
@@ -144,6 +155,10 @@ void ShadowFlow::clearShadowMap(scene::Camera *camera) {
             initShadowFrameBuffer(_pipeline, mainLight);
         }
 
+        if (_staticCasterCacheEnabled && !_staticLayerFramebuffer) {
+            initStaticShadowLayer();
+        }
+
         auto *shadowFrameBuffer = shadowFramebufferMap.at(mainLight);
         for (auto *stage : _stages) {
             auto *shadowStage = static_cast<ShadowStage *>(stage);
@@ -152,6 +167,11 @@ void ShadowFlow::clearShadowMap(scene::Camera *camera) {
         }
     }
 
+    if (_shadowAtlasEnabled) {
+        renderAtlas(camera);
+        return;
+    }
+
     for (uint l = 0; l < _validLights.size(); ++l) {
         const scene::Light *light    = _validLights[l];
         gfx::DescriptorSet *globalDS = _pipeline->getGlobalDSManager()->getOrCreateDescriptorSet(l);
@@ -176,6 +196,8 @@ void ShadowFlow::resizeShadowMap() {
     const auto  width      = static_cast<uint>(shadowInfo->getSize().x);
     const auto  height     = static_cast<uint>(shadowInfo->getSize().y);
     const auto  format     = supportsR32FloatTexture(device) ? gfx::Format::R32F : gfx::Format::RGBA8;
+    // the cached static layer is copied into the shadow maps
+    const auto transferUsage = _staticCasterCacheEnabled ? gfx::TextureUsageBit::TRANSFER_DST : gfx::TextureUsageBit::NONE;
 
     for (const auto &pair : sceneData->getShadowFramebufferMap()) {
         gfx::Framebuffer *framebuffer = pair.second;
@@ -191,7 +213,7 @@ void ShadowFlow::resizeShadowMap() {
         renderTargets.clear();
         renderTargets.emplace_back(gfx::Device::getInstance()->createTexture({
             gfx::TextureType::TEX2D,
-            gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+            gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | transferUsage,
             format,
             width,
             height,
@@ -204,7 +226,7 @@ void ShadowFlow::resizeShadowMap() {
         CC_DELETE(depth);
         depth = device->createTexture({
             gfx::TextureType::TEX2D,
-            gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT,
+            gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | transferUsage,
             gfx::Format::DEPTH,
             width,
             height,
@@ -219,6 +241,9 @@ void ShadowFlow::resizeShadowMap() {
         });
     }
 
+    // recreated with the new size on the next render
+    destroyStaticShadowLayer();
+
     shadowInfo->setShadowMapDirty(false);
 }
 
@@ -230,6 +255,42 @@ void ShadowFlow::initShadowFrameBuffer(RenderPipeline *pipeline, const scene::Li
     const auto  width         = static_cast<uint>(shadowMapSize.x);
     const auto  height        = static_cast<uint>(shadowMapSize.y);
     const auto  format        = supportsR32FloatTexture(device) ? gfx::Format::R32F : gfx::Format::RGBA8;
+    const auto  transferUsage = _staticCasterCacheEnabled ? gfx::TextureUsageBit::TRANSFER_DST : gfx::TextureUsageBit::NONE;
+
+    _renderPass = getOrCreateShadowRenderPass(format);
+
+    ccstd::vector<gfx::Texture *> renderTargets;
+    renderTargets.emplace_back(device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | transferUsage,
+        format,
+        width,
+        height,
+    }));
+    for (auto *renderTarget : renderTargets) {
+        _usedTextures.emplace_back(renderTarget);
+    }
+
+    gfx::Texture *depth = device->createTexture({
+        gfx::TextureType::TEX2D,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | transferUsage,
+        gfx::Format::DEPTH,
+        width,
+        height,
+    });
+    _usedTextures.emplace_back(depth);
+
+    gfx::Framebuffer *framebuffer = device->createFramebuffer({
+        _renderPass,
+        renderTargets,
+        depth,
+    });
+
+    pipeline->getPipelineSceneData()->setShadowFramebuffer(light, framebuffer);
+}
+
+gfx::RenderPass *ShadowFlow::getOrCreateShadowRenderPass(gfx::Format format) {
+    auto *device = gfx::Device::getInstance();
 
     const gfx::ColorAttachment colorAttachment = {
         format,
@@ -259,46 +320,217 @@ void ShadowFlow::initShadowFrameBuffer(RenderPipeline *pipeline, const scene::Li
     rpInfo.colorAttachments.emplace_back(colorAttachment);
     rpInfo.depthStencilAttachment = depthStencilAttachment;
 
-    size_t rpHash = cc::gfx::RenderPass::computeHash(rpInfo);
+    return getOrCreateRenderPass(rpInfo);
+}
+
+gfx::RenderPass *ShadowFlow::getOrCreateRenderPass(const gfx::RenderPassInfo &info) {
+    size_t rpHash = cc::gfx::RenderPass::computeHash(info);
     auto   iter   = renderPassHashMap.find(rpHash);
     if (iter != renderPassHashMap.end()) {
-        _renderPass = iter->second;
-    } else {
-        _renderPass = device->createRenderPass(rpInfo);
-        renderPassHashMap.insert({rpHash, _renderPass});
+        return iter->second;
     }
 
-    ccstd::vector<gfx::Texture *> renderTargets;
-    renderTargets.emplace_back(device->createTexture({
+    auto *renderPass = gfx::Device::getInstance()->createRenderPass(info);
+    renderPassHashMap.insert({rpHash, renderPass});
+    return renderPass;
+}
+
+void ShadowFlow::setStaticCasterCacheEnabled(bool enabled) {
+    if (_staticCasterCacheEnabled == enabled) {
+        return;
+    }
+
+    _staticCasterCacheEnabled = enabled;
+    destroyStaticShadowLayer();
+
+    // the shadow maps are recreated as copy destinations of the static layer
+    auto *shadowInfo = _pipeline ? _pipeline->getPipelineSceneData()->getShadows() : nullptr;
+    if (shadowInfo) {
+        shadowInfo->setShadowMapDirty(true);
+    }
+}
+
+void ShadowFlow::invalidateStaticCasterCache() {
+    for (auto *stage : _stages) {
+        static_cast<ShadowStage *>(stage)->invalidateStaticLayer();
+    }
+}
+
+void ShadowFlow::initStaticShadowLayer() {
+    auto *      device        = gfx::Device::getInstance();
+    const auto *shadowInfo    = _pipeline->getPipelineSceneData()->getShadows();
+    const auto &shadowMapSize = shadowInfo->getSize();
+    const auto  width         = static_cast<uint>(shadowMapSize.x);
+    const auto  height        = static_cast<uint>(shadowMapSize.y);
+    const auto  format        = supportsR32FloatTexture(device) ? gfx::Format::R32F : gfx::Format::RGBA8;
+
+    // the static layer keeps both depth and color, it is only read as a copy source
+    gfx::RenderPassInfo layerInfo;
+    layerInfo.colorAttachments.push_back({
+        format,
+        gfx::SampleCount::ONE,
+        gfx::LoadOp::CLEAR,
+        gfx::StoreOp::STORE,
+        device->getGeneralBarrier({
+            gfx::AccessFlagBit::TRANSFER_READ,
+            gfx::AccessFlagBit::TRANSFER_READ,
+        }),
+    });
+    layerInfo.depthStencilAttachment = {
+        gfx::Format::DEPTH,
+        gfx::SampleCount::ONE,
+        gfx::LoadOp::CLEAR,
+        gfx::StoreOp::STORE,
+        gfx::LoadOp::CLEAR,
+        gfx::StoreOp::DISCARD,
+        device->getGeneralBarrier({
+            gfx::AccessFlagBit::TRANSFER_READ,
+            gfx::AccessFlagBit::TRANSFER_READ,
+        }),
+    };
+    auto *layerRenderPass = getOrCreateRenderPass(layerInfo);
+
+    // the dynamic casters are drawn over the copied static layer
+    gfx::RenderPassInfo compositeInfo;
+    compositeInfo.colorAttachments.push_back({
+        format,
+        gfx::SampleCount::ONE,
+        gfx::LoadOp::LOAD,
+        gfx::StoreOp::STORE,
+        device->getGeneralBarrier({
+            gfx::AccessFlagBit::TRANSFER_WRITE,
+            gfx::AccessFlagBit::FRAGMENT_SHADER_READ_TEXTURE,
+        }),
+    });
+    compositeInfo.depthStencilAttachment = {
+        gfx::Format::DEPTH,
+        gfx::SampleCount::ONE,
+        gfx::LoadOp::LOAD,
+        gfx::StoreOp::DISCARD,
+        gfx::LoadOp::LOAD,
+        gfx::StoreOp::DISCARD,
+        device->getGeneralBarrier({
+            gfx::AccessFlagBit::TRANSFER_WRITE,
+            gfx::AccessFlagBit::DEPTH_STENCIL_ATTACHMENT_WRITE,
+        }),
+    };
+    _compositeRenderPass = getOrCreateRenderPass(compositeInfo);
+
+    auto *color = device->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::TRANSFER_SRC,
         format,
         width,
         height,
-    }));
-    for (auto *renderTarget : renderTargets) {
-        _usedTextures.emplace_back(renderTarget);
-    }
-
-    gfx::Texture *depth = device->createTexture({
+    });
+    auto *depth = device->createTexture({
         gfx::TextureType::TEX2D,
-        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
+        gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::TRANSFER_SRC,
         gfx::Format::DEPTH,
         width,
         height,
     });
-    _usedTextures.emplace_back(depth);
+    _staticLayerTextures.emplace_back(color);
+    _staticLayerTextures.emplace_back(depth);
 
-    gfx::Framebuffer *framebuffer = device->createFramebuffer({
-        _renderPass,
-        renderTargets,
+    _staticLayerFramebuffer = device->createFramebuffer({
+        layerRenderPass,
+        {color},
         depth,
     });
 
-    pipeline->getPipelineSceneData()->setShadowFramebuffer(light, framebuffer);
+    setStagesStaticLayer();
+}
+
+void ShadowFlow::destroyStaticShadowLayer() {
+    CC_SAFE_DESTROY_AND_DELETE(_staticLayerFramebuffer);
+    for (auto *texture : _staticLayerTextures) {
+        CC_SAFE_DESTROY_AND_DELETE(texture);
+    }
+    _staticLayerTextures.clear();
+    _compositeRenderPass = nullptr;
+
+    setStagesStaticLayer();
+}
+
+void ShadowFlow::setStagesStaticLayer() {
+    for (auto *stage : _stages) {
+        static_cast<ShadowStage *>(stage)->setStaticLayer(_staticLayerFramebuffer, _compositeRenderPass);
+    }
+}
+
+void ShadowFlow::setShadowAtlasEnabled(bool enabled) {
+    if (_shadowAtlasEnabled == enabled) {
+        return;
+    }
+
+    _shadowAtlasEnabled = enabled;
+    if (!enabled) {
+        _shadowAtlas.destroy();
+    }
+    if (_pipeline) {
+        _pipeline->getPipelineSceneData()->setShadowAtlas(enabled ? &_shadowAtlas : nullptr);
+    }
+}
+
+void ShadowFlow::renderAtlas(scene::Camera *camera) {
+    CC_PROFILE(ShadowFlowRenderAtlas);
+    auto *sceneData = _pipeline->getPipelineSceneData();
+    if (!_shadowAtlas.getFramebuffer()) {
+        const auto format = supportsR32FloatTexture(gfx::Device::getInstance()) ? gfx::Format::R32F : gfx::Format::RGBA8;
+        _shadowAtlas.initialize(getOrCreateShadowRenderPass(format), format);
+    }
+    sceneData->setShadowAtlas(&_shadowAtlas);
+
+    _shadowAtlas.update(camera, _validLights, Root::getInstance()->getFrameCount());
+
+    for (const auto *light : _validLights) {
+        const RenderObjectList *casters = sceneData->getSpotShadowObjects(light);
+        if (!casters) {
+            // kept in the scene data so the shadow stage does not cull the light again
+            _atlasCasters.clear();
+            spotLightShadowCulling(static_cast<const scene::SpotLight *>(light), camera->getScene()->getModelBounds(),
+                                   sceneData->isCastShadowObjects(), _casterVisibility, _atlasCasters);
+            sceneData->addSpotShadowObjects(light, std::move(_atlasCasters));
+            casters = sceneData->getSpotShadowObjects(light);
+        }
+        _shadowAtlas.checkCasters(light, *casters);
+    }
+
+    auto *atlasFramebuffer = _shadowAtlas.getFramebuffer();
+    if (!_shadowAtlas.isEmptyTileCleared()) {
+        auto *cmdBuffer = _pipeline->getCommandBuffers()[0];
+
+        const gfx::Color clearColor = {1.0F, 1.0F, 1.0F, 1.0F};
+        cmdBuffer->beginRenderPass(atlasFramebuffer->getRenderPass(), atlasFramebuffer, _shadowAtlas.getEmptyTile(), &clearColor, 1.0F, 0);
+        cmdBuffer->endRenderPass();
+        _shadowAtlas.setEmptyTileCleared();
+    }
+
+    _shadowAtlas.schedule(_atlasUpdates);
+    for (uint l = 0; l < _atlasUpdates.size(); ++l) {
+        const ShadowAtlas::Tile *tile     = _atlasUpdates[l];
+        gfx::DescriptorSet *     globalDS = _pipeline->getGlobalDSManager()->getOrCreateDescriptorSet(l);
+        for (auto *stage : _stages) {
+            auto *shadowStage = static_cast<ShadowStage *>(stage);
+            shadowStage->setUsage(globalDS, tile->light, atlasFramebuffer);
+            shadowStage->setAtlasTile(&tile->rect);
+            shadowStage->render(camera);
+            shadowStage->setAtlasTile(nullptr);
+        }
+        _shadowAtlas.markRendered(tile->light);
+    }
 }
 
 void ShadowFlow::destroy() {
+    destroyStaticShadowLayer();
+
+    _shadowAtlas.destroy();
+    _atlasUpdates.clear();
+    if (_pipeline) {
+        _pipeline->getPipelineSceneData()->setShadowAtlas(nullptr);
+    }
+
     _renderPass = nullptr;
     for (const auto &rpPair : renderPassHashMap) {
         CC_DELETE(rpPair.second);
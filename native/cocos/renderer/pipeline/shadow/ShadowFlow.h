@@ -26,6 +26,8 @@
 #pragma once
 
 #include "../RenderFlow.h"
+#include "ShadowAtlas.h"
+#include "base/std/container/vector.h"
 #include "scene/Define.h"
 
 namespace cc {
@@ -47,7 +49,34 @@ public:
 
     void destroy() override;
 
+    /**
+     * @en Render the static shadow casters of the main light once into a persistent layer, and only draw the dynamic casters each frame.
+     * The layer is re-rendered when the shadow camera moves or a static caster is added, removed or transformed.
+     * @zh 将主光源的静态阴影投射者绘制到持久层中，每帧只绘制动态投射者。
+     * 阴影相机移动或静态投射者增删、变换时会重新绘制该层。
+     */
+    void        setStaticCasterCacheEnabled(bool enabled);
+    inline bool isStaticCasterCacheEnabled() const { return _staticCasterCacheEnabled; }
+    // Force the static layer to be re-rendered, e.g. after changing the shadow bias of static casters
+    void invalidateStaticCasterCache();
+
+    /**
+     * @en Render the shadows of the spot lights into tiles of one shared atlas instead of a shadow map per light.
+     * Tiles are sized by the screen coverage of their lights, and only the tiles whose light or casters changed are re-rendered,
+     * up to the update budget of the atlas per frame.
+     * @zh 将聚光灯的阴影绘制到一张共享图集的图块中，而不是为每个光源使用一张阴影贴图。
+     * 图块尺寸由光源的屏幕覆盖率决定，只有光源或投射者变化的图块会重新绘制，每帧不超过图集的更新预算。
+     */
+    void                      setShadowAtlasEnabled(bool enabled);
+    inline bool               isShadowAtlasEnabled() const { return _shadowAtlasEnabled; }
+    inline ShadowAtlas &      getShadowAtlas() { return _shadowAtlas; }
+    inline const ShadowAtlas &getShadowAtlas() const { return _shadowAtlas; }
+
 private:
+    static gfx::RenderPass *getOrCreateRenderPass(const gfx::RenderPassInfo &info);
+
+    gfx::RenderPass *getOrCreateShadowRenderPass(gfx::Format format);
+
     void lightCollecting();
 
     void clearShadowMap(scene::Camera *camera);
@@ -56,6 +85,14 @@ private:
 
     void initShadowFrameBuffer(RenderPipeline *pipeline, const scene::Light *light);
 
+    void initStaticShadowLayer();
+
+    void destroyStaticShadowLayer();
+
+    void setStagesStaticLayer();
+
+    void renderAtlas(scene::Camera *camera);
+
     static RenderFlowInfo initInfo;
 
     gfx::RenderPass *_renderPass = nullptr;
@@ -63,6 +100,17 @@ private:
     ccstd::vector<const scene::Light *> _validLights;
     ccstd::vector<gfx::Texture *>       _usedTextures;
 
+    bool                          _staticCasterCacheEnabled = false;
+    gfx::Framebuffer *            _staticLayerFramebuffer   = nullptr;
+    gfx::RenderPass *             _compositeRenderPass      = nullptr;
+    ccstd::vector<gfx::Texture *> _staticLayerTextures;
+
+    bool                                     _shadowAtlasEnabled = false;
+    ShadowAtlas                              _shadowAtlas;
+    ccstd::vector<const ShadowAtlas::Tile *> _atlasUpdates;
+    ccstd::pmr::vector<uint8_t>              _casterVisibility;
+    RenderObjectList                         _atlasCasters;
+
     static ccstd::unordered_map<size_t, cc::gfx::RenderPass *> renderPassHashMap;
 };
 } // namespace pipeline
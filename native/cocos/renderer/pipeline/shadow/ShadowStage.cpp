@@ -34,8 +34,13 @@
 #include "math/Vec2.h"
 #include "profiler/Profiler.h"
 #include "scene/Camera.h"
+#include "scene/Light.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
 #include "scene/Shadow.h"
 
+#include <cstring>
+
 namespace cc {
 namespace pipeline {
 
@@ -74,7 +79,6 @@ void ShadowStage::render(scene::Camera *camera) {
 
     auto *cmdBuffer = _pipeline->getCommandBuffers()[0];
     _pipeline->getPipelineUBO()->updateShadowUBOLight(_globalDS, _light);
-    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer);
 
     const auto &shadowMapSize = shadowInfo->getSize();
     const auto &viewport      = camera->getViewport();
@@ -82,6 +86,20 @@ void ShadowStage::render(scene::Camera *camera) {
     _renderArea.y             = static_cast<int>(viewport.y * shadowMapSize.y);
     _renderArea.width         = static_cast<uint>(viewport.z * shadowMapSize.x * sceneData->getShadingScale());
     _renderArea.height        = static_cast<uint>(viewport.w * shadowMapSize.y * sceneData->getShadingScale());
+    if (_useAtlasTile) {
+        _renderArea = _atlasTile;
+    }
+
+    auto &gpuTimer = _pipeline->getGPUTimer();
+    gpuTimer.beginScope("ShadowStage");
+
+    if (_staticLayer && _compositeRenderPass && _light->getType() == scene::LightType::DIRECTIONAL) {
+        renderCached(camera, cmdBuffer);
+        gpuTimer.endScope();
+        return;
+    }
+
+    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer);
 
     _clearColors[0]  = {1.0F, 1.0F, 1.0F, 1.0F};
     auto *renderPass = _framebuffer->getRenderPass();
@@ -93,6 +111,75 @@ void ShadowStage::render(scene::Camera *camera) {
     cmdBuffer->bindDescriptorSet(globalSet, _globalDS, utils::toUint(globalOffsets.size()), globalOffsets.data());
     _additiveShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuffer);
 
+    cmdBuffer->endRenderPass();
+    gpuTimer.endScope();
+}
+
+bool ShadowStage::isStaticLayerValid(const scene::Camera *camera, uint32_t staticCasterCount) const {
+    if (!_staticLayerValid) {
+        return false;
+    }
+
+    const auto &matShadowViewProj = _pipeline->getPipelineSceneData()->getShadows()->getMatShadowViewProj();
+    return _staticLayerArea == _renderArea &&
+           _staticLayerVersion == camera->getScene()->getStaticShadowCastersVersion() &&
+           _staticLayerCasterCount == staticCasterCount &&
+           memcmp(_staticLayerViewProj.m, matShadowViewProj.m, sizeof(matShadowViewProj.m)) == 0;
+}
+
+void ShadowStage::renderStaticLayer(scene::Camera *camera, gfx::CommandBuffer *cmdBuffer) {
+    CC_PROFILE(ShadowStageRenderStaticLayer);
+    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer, ShadowCasterFilter::STATIC);
+
+    _clearColors[0]  = {1.0F, 1.0F, 1.0F, 1.0F};
+    auto *renderPass = _staticLayer->getRenderPass();
+
+    cmdBuffer->beginRenderPass(renderPass, _staticLayer, _renderArea,
+                               _clearColors, camera->getClearDepth(), camera->getClearStencil());
+
+    const ccstd::array<uint, 1> globalOffsets = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
+    cmdBuffer->bindDescriptorSet(globalSet, _globalDS, utils::toUint(globalOffsets.size()), globalOffsets.data());
+    _additiveShadowQueue->recordCommandBuffer(_device, renderPass, cmdBuffer);
+
+    cmdBuffer->endRenderPass();
+}
+
+void ShadowStage::renderCached(scene::Camera *camera, gfx::CommandBuffer *cmdBuffer) {
+    uint32_t staticCasterCount = 0;
+    for (const auto &ro : _pipeline->getPipelineSceneData()->getDirShadowObjects()) {
+        if (ro.model->isStaticShadowCaster()) {
+            ++staticCasterCount;
+        }
+    }
+
+    if (!isStaticLayerValid(camera, staticCasterCount)) {
+        renderStaticLayer(camera, cmdBuffer);
+
+        _staticLayerValid       = true;
+        _staticLayerViewProj    = _pipeline->getPipelineSceneData()->getShadows()->getMatShadowViewProj();
+        _staticLayerArea        = _renderArea;
+        _staticLayerVersion     = camera->getScene()->getStaticShadowCastersVersion();
+        _staticLayerCasterCount = staticCasterCount;
+    }
+
+    // restore the static casters, then draw the dynamic casters on top with depth testing against them
+    gfx::TextureBlit region;
+    region.srcOffset = {_renderArea.x, _renderArea.y, 0};
+    region.srcExtent = {_renderArea.width, _renderArea.height, 1};
+    region.dstOffset = region.srcOffset;
+    region.dstExtent = region.srcExtent;
+    cmdBuffer->blitTexture(_staticLayer->getColorTextures()[0], _framebuffer->getColorTextures()[0], &region, 1, gfx::Filter::POINT);
+    cmdBuffer->blitTexture(_staticLayer->getDepthStencilTexture(), _framebuffer->getDepthStencilTexture(), &region, 1, gfx::Filter::POINT);
+
+    _additiveShadowQueue->gatherLightPasses(camera, _light, cmdBuffer, ShadowCasterFilter::DYNAMIC);
+
+    cmdBuffer->beginRenderPass(_compositeRenderPass, _framebuffer, _renderArea,
+                               _clearColors, camera->getClearDepth(), camera->getClearStencil());
+
+    const ccstd::array<uint, 1> globalOffsets = {_pipeline->getPipelineUBO()->getCurrentCameraUBOOffset()};
+    cmdBuffer->bindDescriptorSet(globalSet, _globalDS, utils::toUint(globalOffsets.size()), globalOffsets.data());
+    _additiveShadowQueue->recordCommandBuffer(_device, _compositeRenderPass, cmdBuffer);
+
     cmdBuffer->endRenderPass();
 }
 
@@ -101,6 +188,10 @@ void ShadowStage::destroy() {
     _globalDS    = nullptr;
     _light       = nullptr;
 
+    _staticLayer         = nullptr;
+    _compositeRenderPass = nullptr;
+    _staticLayerValid    = false;
+
     CC_SAFE_DESTROY_AND_DELETE(_additiveShadowQueue);
 
     RenderStage::destroy();
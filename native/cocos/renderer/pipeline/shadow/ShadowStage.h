@@ -25,6 +25,7 @@
 
 #pragma once
 #include "../RenderStage.h"
+#include "math/Mat4.h"
 
 namespace cc {
 namespace pipeline {
@@ -50,17 +51,55 @@ public:
         _framebuffer = framebuffer;
     }
 
+    /**
+     * @en Set the persistent layer holding the static casters of the directional light, pass nullptr to render all casters every frame.
+     * The static layer is copied into the shadow map before the dynamic casters are drawn on top with the composite render pass.
+     * @zh 设置保存平行光静态投射者的持久层，传入 nullptr 则每帧绘制所有投射者。
+     * 静态层会先拷贝到阴影贴图中，再使用合成渲染流程在其上绘制动态投射者。
+     */
+    inline void setStaticLayer(gfx::Framebuffer *framebuffer, gfx::RenderPass *compositeRenderPass) {
+        _staticLayer         = framebuffer;
+        _compositeRenderPass = compositeRenderPass;
+        if (!framebuffer) {
+            _staticLayerValid = false;
+        }
+    }
+    inline void invalidateStaticLayer() { _staticLayerValid = false; }
+
+    // render into a tile of the shadow atlas instead of the area given by the camera viewport, pass nullptr to reset
+    inline void setAtlasTile(const gfx::Rect *tile) {
+        _useAtlasTile = tile != nullptr;
+        if (tile) {
+            _atlasTile = *tile;
+        }
+    }
+
     void clearFramebuffer(scene::Camera *camera);
 
 private:
+    bool isStaticLayerValid(const scene::Camera *camera, uint32_t staticCasterCount) const;
+    void renderStaticLayer(scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
+    void renderCached(scene::Camera *camera, gfx::CommandBuffer *cmdBuffer);
+
     static RenderStageInfo initInfo;
 
     gfx::Rect           _renderArea;
     gfx::DescriptorSet *_globalDS    = nullptr;
     const scene::Light *_light       = nullptr;
     gfx::Framebuffer *  _framebuffer = nullptr;
+    gfx::Rect           _atlasTile;
+    bool                _useAtlasTile = false;
 
     ShadowMapBatchedQueue *_additiveShadowQueue = nullptr;
+
+    gfx::Framebuffer *_staticLayer         = nullptr;
+    gfx::RenderPass * _compositeRenderPass = nullptr;
+    bool              _staticLayerValid    = false;
+    // the state the static layer was rendered with, any change invalidates the layer
+    Mat4      _staticLayerViewProj;
+    gfx::Rect _staticLayerArea;
+    uint32_t  _staticLayerVersion     = 0;
+    uint32_t  _staticLayerCasterCount = 0;
 };
 
 } // namespace pipeline
@@ -151,6 +151,7 @@ void Ambient::initialize(AmbientInfo *info) {
     _skyColorLDR       = info->getSkyColorLDR();
     _groundAlbedoLDR.set(info->getGroundAlbedoLDR());
     _skyIllumLDR       = info->getSkyIllumLDR();
+    ++_version;
 }
 
 Vec4 &Ambient::getSkyColor() {
@@ -165,6 +166,7 @@ void Ambient::setSkyColor(const Vec4 &color) {
     } else {
         _skyColorLDR.set(color);
     }
+    ++_version;
 }
 
 /**
@@ -182,6 +184,7 @@ void Ambient::setSkyIllum(float illum) {
     } else {
         _skyIllumLDR = illum;
     }
+    ++_version;
 }
 
 /**
@@ -200,6 +203,7 @@ void Ambient::setGroundAlbedo(const Vec4 &color) {
     } else {
         _groundAlbedoLDR.set(color);
     }
+    ++_version;
 }
 
 } // namespace scene
@@ -47,11 +47,20 @@ public:
 
     void initialize(AmbientInfo *info);
 
+    /**
+     * @en Version of the ambient parameters, increased whenever one of them changes.
+     * @zh 环境光参数的版本号，任一参数变化时递增。
+     */
+    inline uint32_t getVersion() const { return _version; }
+
     /**
      * @en Enable ambient
      * @zh 是否开启环境光
      */
-    inline void setEnabled(bool val) { _enabled = val; }
+    inline void setEnabled(bool val) {
+        _enabled = val;
+        ++_version;
+    }
     inline bool isEnabled() const { return _enabled; }
 
     /**
@@ -77,7 +86,10 @@ public:
     void        setGroundAlbedo(const Vec4 &color);
 
     inline uint8_t getMipmapCount() const { return _mipmapCount; }
-    inline void    setMipmapCount(uint8_t count) { _mipmapCount = count; }
+    inline void    setMipmapCount(uint8_t count) {
+        _mipmapCount = count;
+        ++_version;
+    }
 
 protected:
     Vec4  _groundAlbedoHDR{0.2F, 0.2F, 0.2F, 1.F};
@@ -89,7 +101,8 @@ protected:
     float   _skyIllumLDR{0.F};
     uint8_t _mipmapCount{1};
 
-    bool _enabled{false};
+    bool     _enabled{false};
+    uint32_t _version{0};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Ambient);
 };
@@ -0,0 +1,270 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "scene/Batcher2D.h"
+#include <algorithm>
+#include <cstring>
+#include "base/Utils.h"
+#include "core/assets/Material.h"
+#include "renderer/gfx-base/GFXBuffer.h"
+#include "renderer/gfx-base/GFXDescriptorSet.h"
+#include "renderer/gfx-base/GFXDevice.h"
+#include "renderer/gfx-base/GFXInputAssembler.h"
+#include "renderer/pipeline/Define.h"
+#include "scene/Pass.h"
+#include "scene/RenderScene.h"
+
+namespace cc {
+namespace scene {
+namespace {
+constexpr uint32_t INITIAL_VERTEX_COUNT = 4096;
+constexpr uint32_t INITIAL_INDEX_COUNT  = 6144;
+} // namespace
+
+void RenderEntity2D::setGeometry(const float *vertices, uint32_t vertexCount, const uint16_t *indices, uint32_t indexCount) {
+    _vertices.assign(vertices, vertices + vertexCount * FLOATS_PER_VERTEX);
+    _indices.assign(indices, indices + indexCount);
+    _dirty = true;
+}
+
+const gfx::AttributeList &Batcher2D::getAttributes() {
+    static const gfx::AttributeList ATTRIBUTES{
+        {gfx::ATTR_NAME_POSITION, gfx::Format::RGB32F},
+        {gfx::ATTR_NAME_TEX_COORD, gfx::Format::RG32F},
+        {gfx::ATTR_NAME_COLOR, gfx::Format::RGBA32F},
+    };
+    return ATTRIBUTES;
+}
+
+Batcher2D::Batcher2D(gfx::Device *device) : _device(device) {
+    _vertexBuffer = _device->createBuffer({
+        gfx::BufferUsageBit::VERTEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE | gfx::MemoryUsageBit::HOST,
+        INITIAL_VERTEX_COUNT * RenderEntity2D::FLOATS_PER_VERTEX * sizeof(float),
+        RenderEntity2D::FLOATS_PER_VERTEX * sizeof(float),
+    });
+    _indexBuffer  = _device->createBuffer({
+        gfx::BufferUsageBit::INDEX | gfx::BufferUsageBit::TRANSFER_DST,
+        gfx::MemoryUsageBit::DEVICE | gfx::MemoryUsageBit::HOST,
+        INITIAL_INDEX_COUNT * sizeof(uint32_t),
+        sizeof(uint32_t),
+    });
+    _vertexData.resize(INITIAL_VERTEX_COUNT * RenderEntity2D::FLOATS_PER_VERTEX);
+    _indexData.resize(INITIAL_INDEX_COUNT);
+}
+
+Batcher2D::~Batcher2D() {
+    destroy();
+}
+
+void Batcher2D::destroy() {
+    for (auto *batch : _batches) {
+        CC_SAFE_DESTROY_AND_DELETE(batch->inputAssembler);
+        CC_SAFE_DELETE(batch);
+    }
+    _batches.clear();
+    _batchCount = 0;
+
+    for (auto &cached : _descriptorSets) {
+        CC_SAFE_DESTROY_AND_DELETE(cached.descriptorSet);
+    }
+    _descriptorSets.clear();
+
+    for (auto *entity : _entities) {
+        CC_SAFE_DELETE(entity);
+    }
+    _entities.clear();
+    _committed.clear();
+
+    CC_SAFE_DESTROY_AND_DELETE(_vertexBuffer);
+    CC_SAFE_DESTROY_AND_DELETE(_indexBuffer);
+}
+
+RenderEntity2D *Batcher2D::createEntity() {
+    auto *entity = CC_NEW(RenderEntity2D);
+    _entities.emplace_back(entity);
+    return entity;
+}
+
+void Batcher2D::destroyEntity(RenderEntity2D *entity) {
+    auto iter = std::find(_entities.begin(), _entities.end(), entity);
+    if (iter == _entities.end()) return;
+    _entities.erase(iter);
+    CC_SAFE_DELETE(entity);
+}
+
+void Batcher2D::commit(RenderEntity2D *entity) {
+    if (!entity->_material || !entity->_scene || entity->_indices.empty()) return;
+    _committed.emplace_back(entity);
+}
+
+void Batcher2D::update() {
+    ++_frame;
+    _batchCount = 0;
+
+    uint32_t vertexCount = 0;
+    uint32_t indexCount  = 0;
+    for (const auto *entity : _committed) {
+        vertexCount += entity->getVertexCount();
+        indexCount += entity->getIndexCount();
+    }
+    reserve(vertexCount, indexCount);
+
+    Batch *  batch        = nullptr;
+    uint32_t vertexOffset = 0;
+    uint32_t indexOffset  = 0;
+    for (auto *entity : _committed) {
+        const auto entityVertexCount = entity->getVertexCount();
+        const auto entityIndexCount  = entity->getIndexCount();
+        // unchanged entities at the same place as last frame are already in the shared buffers
+        const bool placed = !entity->_dirty && entity->_placedFrame + 1 == _frame &&
+                            entity->_vertexOffset == vertexOffset && entity->_indexOffset == indexOffset;
+        if (!placed) {
+            memcpy(_vertexData.data() + vertexOffset * RenderEntity2D::FLOATS_PER_VERTEX, entity->_vertices.data(), entity->_vertices.size() * sizeof(float));
+            for (uint32_t i = 0; i < entityIndexCount; ++i) {
+                _indexData[indexOffset + i] = vertexOffset + entity->_indices[i];
+            }
+            _vertexDirtyEnd = std::max(_vertexDirtyEnd, (vertexOffset + entityVertexCount) * RenderEntity2D::FLOATS_PER_VERTEX);
+            _indexDirtyEnd  = std::max(_indexDirtyEnd, indexOffset + entityIndexCount);
+        }
+        entity->_vertexOffset = vertexOffset;
+        entity->_indexOffset  = indexOffset;
+        entity->_placedFrame  = _frame;
+        entity->_dirty        = false;
+
+        if (!batch || batch->texture != entity->_texture || batch->sampler != entity->_sampler || batch->material != entity->_material ||
+            batch->scene != entity->_scene || batch->drawBatch.visFlags != entity->_visFlags) {
+            batch = nextBatch(entity, indexOffset);
+        }
+        batch->inputAssembler->setIndexCount(batch->inputAssembler->getIndexCount() + entityIndexCount);
+
+        vertexOffset += entityVertexCount;
+        indexOffset += entityIndexCount;
+    }
+
+    for (uint32_t i = 0; i < _batchCount; ++i) {
+        auto *current = _batches[i];
+        if (!current->drawBatch.passes.empty()) {
+            current->scene->addBatch(&current->drawBatch);
+        }
+    }
+}
+
+void Batcher2D::uploadBuffers() {
+    if (_vertexDirtyEnd) {
+        _vertexBuffer->update(_vertexData.data(), utils::toUint(_vertexDirtyEnd * sizeof(float)));
+        _vertexDirtyEnd = 0;
+    }
+    if (_indexDirtyEnd) {
+        _indexBuffer->update(_indexData.data(), utils::toUint(_indexDirtyEnd * sizeof(uint32_t)));
+        _indexDirtyEnd = 0;
+    }
+}
+
+void Batcher2D::reset() {
+    _committed.clear();
+
+    // release the descriptor sets of textures no longer drawn
+    for (auto iter = _descriptorSets.begin(); iter != _descriptorSets.end();) {
+        if (iter->usedFrame != _frame) {
+            CC_SAFE_DESTROY_AND_DELETE(iter->descriptorSet);
+            iter = _descriptorSets.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void Batcher2D::reserve(uint32_t vertexCount, uint32_t indexCount) {
+    const auto floatCount = vertexCount * RenderEntity2D::FLOATS_PER_VERTEX;
+    if (floatCount > _vertexData.size()) {
+        const auto size = utils::nextPOT(floatCount);
+        _vertexData.resize(size);
+        _vertexBuffer->resize(utils::toUint(size * sizeof(float)));
+        // the content of the resized buffer is lost
+        _vertexDirtyEnd = std::max(_vertexDirtyEnd, utils::toUint(_vertexData.size()));
+    }
+    if (indexCount > _indexData.size()) {
+        const auto size = utils::nextPOT(indexCount);
+        _indexData.resize(size);
+        _indexBuffer->resize(utils::toUint(size * sizeof(uint32_t)));
+        _indexDirtyEnd = std::max(_indexDirtyEnd, utils::toUint(_indexData.size()));
+    }
+}
+
+Batcher2D::Batch *Batcher2D::nextBatch(const RenderEntity2D *entity, uint32_t firstIndex) {
+    if (_batchCount == _batches.size()) {
+        auto *batch           = CC_NEW(Batch);
+        batch->inputAssembler = _device->createInputAssembler({getAttributes(), {_vertexBuffer}, _indexBuffer});
+        _batches.emplace_back(batch);
+    }
+    auto *batch     = _batches[_batchCount++];
+    batch->texture  = entity->_texture;
+    batch->sampler  = entity->_sampler;
+    batch->material = entity->_material;
+    batch->scene    = entity->_scene;
+    batch->inputAssembler->setFirstIndex(firstIndex);
+    batch->inputAssembler->setIndexCount(0);
+
+    auto &drawBatch          = batch->drawBatch;
+    drawBatch.visFlags       = entity->_visFlags;
+    drawBatch.inputAssembler = batch->inputAssembler;
+    drawBatch.passes.clear();
+    drawBatch.shaders.clear();
+    drawBatch.descriptorSet = nullptr;
+    for (const auto &pass : *entity->_material->getPasses()) {
+        auto *shader = pass->getShaderVariant();
+        if (!shader) continue; // not compiled yet
+        drawBatch.passes.emplace_back(pass.get());
+        drawBatch.shaders.emplace_back(shader);
+    }
+    if (!drawBatch.passes.empty()) {
+        drawBatch.descriptorSet = getDescriptorSet(drawBatch.passes[0]->getLocalSetLayout(), entity->_texture, entity->_sampler);
+    }
+    return batch;
+}
+
+gfx::DescriptorSet *Batcher2D::getDescriptorSet(gfx::DescriptorSetLayout *layout, gfx::Texture *texture, gfx::Sampler *sampler) {
+    for (auto &cached : _descriptorSets) {
+        if (cached.layout == layout && cached.texture == texture && cached.sampler == sampler) {
+            cached.usedFrame = _frame;
+            return cached.descriptorSet;
+        }
+    }
+
+    auto *descriptorSet = _device->createDescriptorSet({layout});
+    if (texture) {
+        descriptorSet->bindTexture(pipeline::SPRITETEXTURE::BINDING, texture);
+    }
+    if (sampler) {
+        descriptorSet->bindSampler(pipeline::SPRITETEXTURE::BINDING, sampler);
+    }
+    descriptorSet->update();
+    _descriptorSets.push_back({descriptorSet, layout, texture, sampler, _frame});
+    return descriptorSet;
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,158 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/vector.h"
+#include "renderer/gfx-base/GFXDef-common.h"
+#include "scene/DrawBatch2D.h"
+
+namespace cc {
+
+class Material;
+
+namespace scene {
+
+class RenderScene;
+class Batcher2D;
+
+/**
+ * @en Geometry and render states of a 2D renderable such as a sprite or a label, drawn by Batcher2D.
+ * Vertices follow the layout of Batcher2D::getAttributes, indices are relative to the first vertex of the entity.
+ * @zh 2D 渲染对象（如精灵、文本）的几何数据与渲染状态，由 Batcher2D 绘制。
+ * 顶点格式为 Batcher2D::getAttributes，索引相对于该对象的第一个顶点。
+ */
+class CC_DLL RenderEntity2D final {
+public:
+    void setGeometry(const float *vertices, uint32_t vertexCount, const uint16_t *indices, uint32_t indexCount);
+    // vertices can be updated in place, call markDirty afterwards
+    inline float *getVertices() { return _vertices.data(); }
+    inline void   markDirty() { _dirty = true; }
+
+    inline uint32_t getVertexCount() const { return static_cast<uint32_t>(_vertices.size() / FLOATS_PER_VERTEX); }
+    inline uint32_t getIndexCount() const { return static_cast<uint32_t>(_indices.size()); }
+
+    inline void           setTexture(gfx::Texture *texture) { _texture = texture; }
+    inline gfx::Texture * getTexture() const { return _texture; }
+    inline void           setSampler(gfx::Sampler *sampler) { _sampler = sampler; }
+    inline gfx::Sampler * getSampler() const { return _sampler; }
+    inline void           setMaterial(Material *material) { _material = material; }
+    inline Material *     getMaterial() const { return _material; }
+    inline void           setRenderScene(RenderScene *scene) { _scene = scene; }
+    inline RenderScene *  getRenderScene() const { return _scene; }
+    inline void           setVisFlags(uint32_t flags) { _visFlags = flags; }
+    inline uint32_t       getVisFlags() const { return _visFlags; }
+
+    // position xyz, uv, color rgba
+    static constexpr uint32_t FLOATS_PER_VERTEX = 9;
+
+private:
+    friend class Batcher2D;
+
+    ccstd::vector<float>    _vertices;
+    ccstd::vector<uint16_t> _indices;
+    gfx::Texture *          _texture{nullptr};
+    gfx::Sampler *          _sampler{nullptr};
+    Material *              _material{nullptr};
+    RenderScene *           _scene{nullptr};
+    uint32_t                _visFlags{0};
+    // where the entity was placed in the shared buffers, its data is only copied again when it changes or moves
+    uint32_t _vertexOffset{0};
+    uint32_t _indexOffset{0};
+    uint32_t _placedFrame{0};
+    bool     _dirty{true};
+};
+
+/**
+ * @en Native 2D batcher, merges the committed entities sharing texture, sampler, material and visibility into batches drawn
+ * from shared vertex and index buffers, and adds them to the render scenes of the entities. Only the beginning of the buffers
+ * up to the last changed entity is uploaded, nothing is uploaded while the UI is static.
+ * @zh 原生 2D 合批器，将提交的纹理、采样器、材质与可见性相同的对象合并为批次，从共享的顶点与索引缓冲绘制，并加入对象所属的渲染场景。
+ * 只上传缓冲中截止到最后一个变化对象的部分，UI 静止时不会上传。
+ */
+class CC_DLL Batcher2D final {
+public:
+    explicit Batcher2D(gfx::Device *device);
+    ~Batcher2D();
+
+    void destroy();
+
+    RenderEntity2D *createEntity();
+    void            destroyEntity(RenderEntity2D *entity);
+
+    // entities are drawn in the order they are committed, at most once per frame and alive until reset
+    void commit(RenderEntity2D *entity);
+    // build the batches of the committed entities and add them to their render scenes
+    void update();
+    void uploadBuffers();
+    // drop the committed entities, called at the end of the frame
+    void reset();
+
+    inline uint32_t getBatchCount() const { return _batchCount; }
+
+    static const gfx::AttributeList &getAttributes();
+
+private:
+    struct Batch {
+        DrawBatch2D          drawBatch;
+        gfx::InputAssembler *inputAssembler{nullptr};
+        gfx::Texture *       texture{nullptr};
+        gfx::Sampler *       sampler{nullptr};
+        Material *           material{nullptr};
+        RenderScene *        scene{nullptr};
+    };
+
+    struct CachedDescriptorSet {
+        gfx::DescriptorSet *      descriptorSet{nullptr};
+        gfx::DescriptorSetLayout *layout{nullptr};
+        gfx::Texture *            texture{nullptr};
+        gfx::Sampler *            sampler{nullptr};
+        uint32_t                  usedFrame{0};
+    };
+
+    void                reserve(uint32_t vertexCount, uint32_t indexCount);
+    Batch *             nextBatch(const RenderEntity2D *entity, uint32_t firstIndex);
+    gfx::DescriptorSet *getDescriptorSet(gfx::DescriptorSetLayout *layout, gfx::Texture *texture, gfx::Sampler *sampler);
+
+    gfx::Device *                      _device{nullptr};
+    gfx::Buffer *                      _vertexBuffer{nullptr};
+    gfx::Buffer *                      _indexBuffer{nullptr};
+    ccstd::vector<float>               _vertexData;
+    ccstd::vector<uint32_t>            _indexData;
+    uint32_t                           _vertexDirtyEnd{0}; // in floats
+    uint32_t                           _indexDirtyEnd{0};
+    ccstd::vector<RenderEntity2D *>    _entities;
+    ccstd::vector<RenderEntity2D *>    _committed;
+    ccstd::vector<Batch *>             _batches;
+    uint32_t                           _batchCount{0};
+    ccstd::vector<CachedDescriptorSet> _descriptorSets;
+    uint32_t                           _frame{1};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(Batcher2D);
+};
+
+} // namespace scene
+} // namespace cc
@@ -24,6 +24,7 @@
  ****************************************************************************/
 
 #include "scene/Camera.h"
+#include <cstring>
 #include "core/Root.h"
 #include "core/platform/Debug.h"
 #include "core/scene-graph/Node.h"
@@ -31,6 +32,7 @@
 #include "renderer/gfx-base/GFXDevice.h"
 #include "renderer/pipeline/Define.h"
 #include "renderer/pipeline/GeometryRenderer.h"
+#include "renderer/pipeline/SceneCulling.h"
 
 namespace cc {
 namespace scene {
@@ -71,6 +73,9 @@ Camera::Camera(gfx::Device *device)
     _frustum               = new geometry::Frustum();
     _frustum->addRef();
     _frustum->setAccurate(true);
+    _viewFrustum = new geometry::Frustum();
+    _viewFrustum->addRef();
+    _viewFrustum->setAccurate(true);
 
     _geometryRenderer = new pipeline::GeometryRenderer();
     _geometryRenderer->activate(device);
@@ -86,18 +91,22 @@ Camera::Camera(gfx::Device *device)
 
 Camera::~Camera() {
     _frustum->release();
+    _viewFrustum->release();
+    CC_SAFE_DELETE(_cullingCache);
 }
 
 bool Camera::initialize(const ICameraInfo &info) {
-    _node       = info.node;
-    _width      = 1.F;
-    _height     = 1.F;
-    _clearFlag  = gfx::ClearFlagBit::NONE;
-    _clearDepth = 1.0F;
-    _visibility = pipeline::CAMERA_DEFAULT_MASK;
-    _name       = info.name;
-    _proj       = info.projection;
-    _priority   = info.priority;
+    _node          = info.node;
+    _isViewDirty   = true;
+    _isProjInvalid = true;
+    _width         = 1.F;
+    _height        = 1.F;
+    _clearFlag     = gfx::ClearFlagBit::NONE;
+    _clearDepth    = 1.0F;
+    _visibility    = pipeline::CAMERA_DEFAULT_MASK;
+    _name          = info.name;
+    _proj          = info.projection;
+    _priority      = info.priority;
     _aspect = _screenScale = 1.F;
     updateExposure();
     changeTargetWindow(info.window);
@@ -113,6 +122,13 @@ void Camera::destroy() {
     _geometryRenderer->destroy();
 }
 
+pipeline::SceneCullingCache *Camera::getCullingCache() {
+    if (!_cullingCache) {
+        _cullingCache = new pipeline::SceneCullingCache();
+    }
+    return _cullingCache;
+}
+
 void Camera::attachToScene(RenderScene *scene) {
     _enabled = true;
     _scene   = scene;
@@ -149,6 +165,7 @@ void Camera::syncCameraEditor(const Camera &camera) {
     this->_matProj     = camera._matProj;
     this->_matProjInv  = camera._matProjInv;
     this->_matViewProj = camera._matViewProj;
+    ++_version;
 #endif
 }
 
@@ -158,13 +175,18 @@ void Camera::update(bool forceUpdate /*false*/) {
     }
 
     bool viewProjDirty = false;
-    // view matrix
-    if (_node->getChangedFlags() || forceUpdate) {
-        _matView = _node->getWorldMatrix().getInversed();
-        _forward.set(-_matView.m[2], -_matView.m[6], -_matView.m[10]);
-
-        _position.set(_node->getWorldPosition());
-        viewProjDirty = true;
+    // view matrix, the changed flags are also raised by transforms set to their current values
+    if (_node->getChangedFlags() || forceUpdate || _isViewDirty) {
+        const Mat4 &matWorld = _node->getWorldMatrix();
+        if (forceUpdate || _isViewDirty || memcmp(matWorld.m, _matWorld.m, sizeof(_matWorld.m)) != 0) {
+            _matWorld = matWorld;
+            _matView  = matWorld.getInversed();
+            _forward.set(-_matView.m[2], -_matView.m[6], -_matView.m[10]);
+
+            _position.set(_node->getWorldPosition());
+            viewProjDirty = true;
+            _isViewDirty  = false;
+        }
     }
 
     // projection matrix
@@ -174,27 +196,76 @@ void Camera::update(bool forceUpdate /*false*/) {
     if (_isProjDirty || _curTransform != orientation) {
         _curTransform               = orientation;
         const float projectionSignY = _device->getCapabilities().clipSpaceSignY;
+        Mat4        matProj;
         // Only for rendertexture processing
         if (_proj == CameraProjection::PERSPECTIVE) {
             Mat4::createPerspective(_fov, _aspect, _nearClip, _farClip,
-                                    _fovAxis == CameraFOVAxis::VERTICAL, _device->getCapabilities().clipSpaceMinZ, projectionSignY, static_cast<int>(orientation), &_matProj);
+                                    _fovAxis == CameraFOVAxis::VERTICAL, _device->getCapabilities().clipSpaceMinZ, projectionSignY, static_cast<int>(orientation), &matProj);
         } else {
             const float x = _orthoHeight * _aspect;
             const float y = _orthoHeight;
             Mat4::createOrthographicOffCenter(-x, x, -y, y, _nearClip, _farClip,
                                               _device->getCapabilities().clipSpaceMinZ, projectionSignY,
-                                              static_cast<int>(orientation), &_matProj);
+                                              static_cast<int>(orientation), &matProj);
         }
-        _matProjInv   = _matProj.getInversed();
-        viewProjDirty = true;
-        _isProjDirty  = false;
+        // resizing to the same size or setting a parameter to its current value leaves the projection as is
+        if (_isProjInvalid || memcmp(matProj.m, _matProj.m, sizeof(_matProj.m)) != 0) {
+            _matProj       = matProj;
+            _matProjInv    = _matProj.getInversed();
+            viewProjDirty  = true;
+            _isProjInvalid = false;
+        }
+        _isProjDirty = false;
     }
 
     // view-projection
-    if (viewProjDirty) {
+    if (viewProjDirty || _isViewsDirty) {
         Mat4::multiply(_matProj, _matView, &_matViewProj);
         _matViewProjInv = _matViewProj.getInversed();
         _frustum->update(_matViewProj, _matViewProjInv);
+        if (_viewCount > 1) {
+            updateViews();
+        }
+        _isViewsDirty = false;
+        // the culling cache and the camera uniforms are keyed on the version
+        ++_version;
+    }
+}
+
+void Camera::setViewCount(uint32_t count) {
+    CC_ASSERT(count > 0 && count <= gfx::MAX_VIEW_COUNT);
+    for (uint32_t i = _viewCount; i < count; ++i) {
+        _views[i].offset  = Mat4::IDENTITY;
+        _views[i].matProj = _matProj;
+    }
+    _viewCount    = count;
+    _isViewsDirty = true;
+}
+
+void Camera::setViewPose(uint32_t view, const Mat4 &offset, const Mat4 &proj) {
+    CC_ASSERT(view < _viewCount);
+    _views[view].offset  = offset;
+    _views[view].matProj = proj;
+    _isViewsDirty        = true;
+}
+
+void Camera::updateViews() {
+    const Mat4 &matWorld = _node->getWorldMatrix();
+    Mat4        matViewWorld;
+    for (uint32_t i = 0; i < _viewCount; ++i) {
+        View &view = _views[i];
+        Mat4::multiply(matWorld, view.offset, &matViewWorld);
+        view.position.set(matViewWorld.m[12], matViewWorld.m[13], matViewWorld.m[14]);
+        view.matView = matViewWorld.getInversed();
+        Mat4::multiply(view.matProj, view.matView, &view.matViewProj);
+
+        // push the planes of the camera frustum out until every corner of the view frustum is inside
+        _viewFrustum->update(view.matViewProj, view.matViewProj.getInversed());
+        for (geometry::Plane *plane : _frustum->planes) {
+            for (const Vec3 &vertex : _viewFrustum->vertices) {
+                plane->d = std::min(plane->d, plane->n.dot(vertex));
+            }
+        }
     }
 }
 void Camera::changeTargetWindow(RenderWindow *window) {
@@ -338,10 +409,14 @@ Mat4 Camera::worldMatrixToScreen(const Mat4 &worldMatrix, uint32_t width, uint32
     return out;
 }
 
-void Camera::setNode(Node *val) { _node = val; }
+void Camera::setNode(Node *val) {
+    _node        = val;
+    _isViewDirty = true;
+}
 
 void Camera::setExposure(float ev100) {
     _exposure = 0.833333F / std::pow(2.0F, ev100);
+    ++_version;
 }
 
 void Camera::updateExposure() {
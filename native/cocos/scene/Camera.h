@@ -29,6 +29,7 @@
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
+#include "base/std/container/array.h"
 #include "base/std/container/string.h"
 #include "cocos/base/Optional.h"
 #include "cocos/math/Utils.h"
@@ -45,7 +46,8 @@ class Node;
 
 namespace pipeline {
 class GeometryRenderer;
-}
+struct SceneCullingCache;
+} // namespace pipeline
 
 namespace scene {
 
@@ -180,6 +182,29 @@ public:
      */
     Mat4 worldMatrixToScreen(const Mat4 &worldMatrix, uint32_t width, uint32_t height);
 
+    /**
+     * @en Sets the number of views rendered in a single pass with multiview, 1 for regular cameras.
+     * The views share one culling pass against the union of their frustums.
+     * @zh 设置以多视图方式单通道渲染的视图数量，普通相机为 1。各视图共用一次基于其视锥并集的剔除。
+     */
+    void            setViewCount(uint32_t count);
+    inline uint32_t getViewCount() const { return _viewCount; }
+
+    /**
+     * @en Sets the pose of a view relative to the camera node and its projection, such as an eye of a stereo pair.
+     * @zh 设置某个视图相对相机节点的位姿及其投影矩阵，例如立体相机中的一只眼睛。
+     * @param view - The index of the view, less than the view count.
+     * @param offset - The transform from the view space to the space of the camera node.
+     * @param proj - The projection matrix of the view.
+     */
+    void setViewPose(uint32_t view, const Mat4 &offset, const Mat4 &proj);
+
+    // per-view results of the last update, the camera matrices if multiview is off
+    inline const Mat4 &getViewMatView(uint32_t view) const { return _viewCount > 1 ? _views[view].matView : _matView; }
+    inline const Mat4 &getViewMatProj(uint32_t view) const { return _viewCount > 1 ? _views[view].matProj : _matProj; }
+    inline const Mat4 &getViewMatViewProj(uint32_t view) const { return _viewCount > 1 ? _views[view].matViewProj : _matViewProj; }
+    inline const Vec3 &getViewPosition(uint32_t view) const { return _viewCount > 1 ? _views[view].position : _position; }
+
     void         setNode(Node *val);
     inline Node *getNode() const { return _node.get(); }
 
@@ -245,6 +270,7 @@ public:
 
     inline void setFrustum(const geometry::Frustum &val) {
         *_frustum = val;
+        ++_version;
     }
     inline const geometry::Frustum &getFrustum() const { return *_frustum; }
 
@@ -295,6 +321,12 @@ public:
 
     inline float getExposure() const { return _exposure; }
 
+    /**
+     * @en Version of the matrices, the frustum and the exposure of the camera, increased only when they actually change.
+     * @zh 相机矩阵、视锥体和曝光的版本号，仅在其实际变化时递增。
+     */
+    inline uint32_t getVersion() const { return _version; }
+
     inline gfx::ClearFlagBit getClearFlag() const { return _clearFlag; }
     inline void              setClearFlag(gfx::ClearFlagBit flag) { _clearFlag = flag; }
 
@@ -313,6 +345,8 @@ public:
     inline gfx::SurfaceTransform getSurfaceTransform() const { return _curTransform; }
 
     inline pipeline::GeometryRenderer *getGeometryRenderer() const { return _geometryRenderer.get(); }
+    // Culling result of the last frame reused while this camera and its scene do not change, created on first use.
+    pipeline::SceneCullingCache *getCullingCache();
 
     void detachCamera();
 
@@ -322,6 +356,15 @@ protected:
 private:
     void updateExposure();
     void updateAspect(bool oriented = true);
+    void updateViews();
+
+    struct View {
+        Mat4 offset;
+        Mat4 matProj;
+        Mat4 matView;
+        Mat4 matViewProj;
+        Vec3 position;
+    };
 
     bool                  _isWindowSize{true};
     float                 _screenScale{0.F};
@@ -342,6 +385,9 @@ private:
     Vec4                  _orientedViewport{0, 0, 1, 1};
     gfx::SurfaceTransform _curTransform{gfx::SurfaceTransform::IDENTITY};
     bool                  _isProjDirty{true};
+    bool                  _isProjInvalid{true}; // _matProj was never computed
+    bool                  _isViewDirty{true};   // the view must be derived again from the node, even if it did not move
+    Mat4                  _matWorld;            // node transform _matView was derived from
     Mat4                  _matView;
     Mat4                  _matProj;
     Mat4                  _matProjInv;
@@ -365,6 +411,12 @@ private:
     float                 _clearDepth{1.0F};
 
     IntrusivePtr<pipeline::GeometryRenderer> _geometryRenderer;
+    pipeline::SceneCullingCache *            _cullingCache{nullptr};
+
+    ccstd::array<View, gfx::MAX_VIEW_COUNT> _views;
+    geometry::Frustum *                     _viewFrustum{nullptr};
+    uint32_t                                _viewCount{1U};
+    bool                                    _isViewsDirty{false};
 
     static const ccstd::vector<float> FSTOPS;
     static const ccstd::vector<float> SHUTTERS;
@@ -373,6 +425,7 @@ private:
     uint32_t _visibility = pipeline::CAMERA_DEFAULT_MASK;
     float    _exposure{0.F};
     uint32_t _clearStencil{0};
+    uint32_t _version{0};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Camera);
 };
@@ -49,6 +49,7 @@ void DirectionalLight::update() {
         _dir = _forward;
         _node->updateWorldTransform();
         _dir.transformQuat(_node->getWorldRotation());
+        ++_version;
     }
 }
 
@@ -67,6 +68,7 @@ void DirectionalLight::setIlluminance(float value) {
     } else {
         _illuminanceLDR = value;
     }
+    ++_version;
 }
 
 } // namespace scene
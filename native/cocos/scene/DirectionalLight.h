@@ -40,17 +40,53 @@ public:
     void initialize() override;
     void update() override;
 
-    inline void setShadowEnabled(bool enabled) { _shadowEnabled = enabled; }
-    inline void setShadowPcf(float pcf) { _shadowPcf = pcf; }
-    inline void setShadowBias(float bias) { _shadowBias = bias; }
-    inline void setShadowNormalBias(float normalBias) { _shadowNormalBias = normalBias; }
-    inline void setShadowSaturation(float saturation) { _shadowSaturation = saturation; }
-    inline void setShadowDistance(float distance) { _shadowDistance = distance; }
-    inline void setShadowInvisibleOcclusionRange(float invisibleOcclusionRange) { _shadowInvisibleOcclusionRange = invisibleOcclusionRange; }
-    inline void setShadowFixedArea(bool fixedArea) { _shadowFixedArea = fixedArea; }
-    inline void setShadowNear(float nearValue) { _shadowNear = nearValue; }
-    inline void setShadowFar(float farValue) { _shadowFar = farValue; }
-    inline void setShadowOrthoSize(float orthoSize) { _shadowOrthoSize = orthoSize; }
+    inline void setShadowEnabled(bool enabled) {
+
+        _shadowEnabled = enabled;
+
+        ++_version;
+
+    }
+    inline void setShadowPcf(float pcf) {
+        _shadowPcf = pcf;
+        ++_version;
+    }
+    inline void setShadowBias(float bias) {
+        _shadowBias = bias;
+        ++_version;
+    }
+    inline void setShadowNormalBias(float normalBias) {
+        _shadowNormalBias = normalBias;
+        ++_version;
+    }
+    inline void setShadowSaturation(float saturation) {
+        _shadowSaturation = saturation;
+        ++_version;
+    }
+    inline void setShadowDistance(float distance) {
+        _shadowDistance = distance;
+        ++_version;
+    }
+    inline void setShadowInvisibleOcclusionRange(float invisibleOcclusionRange) {
+        _shadowInvisibleOcclusionRange = invisibleOcclusionRange;
+        ++_version;
+    }
+    inline void setShadowFixedArea(bool fixedArea) {
+        _shadowFixedArea = fixedArea;
+        ++_version;
+    }
+    inline void setShadowNear(float nearValue) {
+        _shadowNear = nearValue;
+        ++_version;
+    }
+    inline void setShadowFar(float farValue) {
+        _shadowFar = farValue;
+        ++_version;
+    }
+    inline void setShadowOrthoSize(float orthoSize) {
+        _shadowOrthoSize = orthoSize;
+        ++_version;
+    }
 
     inline bool  isShadowEnabled() const { return _shadowEnabled; }
     inline float getShadowPcf() const { return _shadowPcf; }
@@ -65,9 +101,18 @@ public:
     inline float getShadowOrthoSize() const { return _shadowOrthoSize; }
 
     inline const Vec3 &getDirection() const { return _dir; }
-    inline void        setDirection(const Vec3 &dir) { _dir = dir; }
-    inline void        setIlluminanceHDR(float value) { _illuminanceHDR = value; }
-    inline void        setIlluminanceLDR(float value) { _illuminanceLDR = value; }
+    inline void        setDirection(const Vec3 &dir) {
+        _dir = dir;
+        ++_version;
+    }
+    inline void        setIlluminanceHDR(float value) {
+        _illuminanceHDR = value;
+        ++_version;
+    }
+    inline void        setIlluminanceLDR(float value) {
+        _illuminanceLDR = value;
+        ++_version;
+    }
     inline float       getIlluminanceHDR() const { return _illuminanceHDR; }
     inline float       getIlluminanceLDR() const { return _illuminanceLDR; }
     float              getIlluminance() const;
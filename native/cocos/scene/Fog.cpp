@@ -118,6 +118,7 @@ void Fog::initialize(const FogInfo &fogInfo) {
     _fogAtten   = fogInfo.getFogAtten();
     _fogTop     = fogInfo.getFogTop();
     _fogRange   = fogInfo.getFogRange();
+    ++_version;
 }
 
 void Fog::updatePipeline() {
@@ -144,6 +145,7 @@ void Fog::setFogColor(const Color &val) {
     _fogColor.set(val);
     Vec4 v4(static_cast<float>(val.r) / 255.F, static_cast<float>(val.g) / 255.F, static_cast<float>(val.b) / 255.F, static_cast<float>(val.a) / 255.F);
     pipeline::srgbToLinear(&_colorArray, v4);
+    ++_version;
 }
 
 } // namespace scene
@@ -80,12 +80,19 @@ public:
 
     inline void activate() { updatePipeline(); }
 
+    /**
+     * @en Version of the fog parameters, increased whenever one of them changes.
+     * @zh 雾效参数的版本号，任一参数变化时递增。
+     */
+    inline uint32_t getVersion() const { return _version; }
+
     /**
      * @zh 是否启用全局雾效
      * @en Enable global fog
      */
     inline void setEnabled(bool val) {
         _enabled = val;
+        ++_version;
         if (!val) {
             _type = FogType::NONE;
             updatePipeline();
@@ -101,6 +108,7 @@ public:
      */
     inline void setAccurate(bool val) {
         _accurate = val;
+        ++_version;
         updatePipeline();
     }
     inline bool isAccurate() const { return _accurate; }
@@ -126,6 +134,7 @@ public:
     inline FogType getType() const { return _type; }
     inline void    setType(FogType val) {
         _type = _enabled ? val : FogType::NONE;
+        ++_version;
         if (_enabled) {
             updatePipeline();
         }
@@ -136,28 +145,40 @@ public:
      * @en Global fog density
      */
     inline float getFogDensity() const { return _fogDensity; }
-    inline void  setFogDensity(float val) { _fogDensity = val; }
+    inline void  setFogDensity(float val) {
+        _fogDensity = val;
+        ++_version;
+    }
 
     /**
      * @zh 雾效起始位置，只适用于线性雾
      * @en Global fog start position, only for linear fog
      */
     inline float getFogStart() const { return _fogStart; }
-    inline void  setFogStart(float val) { _fogStart = val; }
+    inline void  setFogStart(float val) {
+        _fogStart = val;
+        ++_version;
+    }
 
     /**
      * @zh 雾效结束位置，只适用于线性雾
      * @en Global fog end position, only for linear fog
      */
     float getFogEnd() const { return _fogEnd; }
-    void  setFogEnd(float val) { _fogEnd = val; }
+    void  setFogEnd(float val) {
+        _fogEnd = val;
+        ++_version;
+    }
 
     /**
      * @zh 雾效衰减
      * @en Global fog attenuation
      */
     inline float getFogAtten() const { return _fogAtten; }
-    inline void  setFogAtten(float val) { _fogAtten = val; }
+    inline void  setFogAtten(float val) {
+        _fogAtten = val;
+        ++_version;
+    }
 
     /**
      * @zh 雾效顶部范围，只适用于层级雾
@@ -165,31 +186,38 @@ public:
      */
     inline float getFogTop() const { return _fogTop; }
 
-    inline void setFogTop(float val) { _fogTop = val; }
+    inline void setFogTop(float val) {
+        _fogTop = val;
+        ++_version;
+    }
 
     /**
      * @zh 雾效范围，只适用于层级雾
      * @en Global fog range, only for layered fog
      */
     inline float getFogRange() const { return _fogRange; }
-    inline void  setfogRange(float val) { _fogRange = val; }
+    inline void  setfogRange(float val) {
+        _fogRange = val;
+        ++_version;
+    }
 
     const Vec4 &getColorArray() const { return _colorArray; }
 
 private:
     void updatePipeline();
 
-    Color   _fogColor{200, 200, 200, 255};
-    Vec4    _colorArray{0.2F, 0.2F, 0.2F, 1.0F};
-    bool    _enabled{false};
-    bool    _accurate{false};
-    FogType _type{FogType::LINEAR};
-    float   _fogDensity{0.3F};
-    float   _fogStart{0.5F};
-    float   _fogEnd{300.F};
-    float   _fogAtten{5.F};
-    float   _fogTop{1.5F};
-    float   _fogRange{1.2F};
+    Color    _fogColor{200, 200, 200, 255};
+    Vec4     _colorArray{0.2F, 0.2F, 0.2F, 1.0F};
+    bool     _enabled{false};
+    bool     _accurate{false};
+    FogType  _type{FogType::LINEAR};
+    float    _fogDensity{0.3F};
+    float    _fogStart{0.5F};
+    float    _fogEnd{300.F};
+    float    _fogAtten{5.F};
+    float    _fogTop{1.5F};
+    float    _fogRange{1.2F};
+    uint32_t _version{0};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(Fog);
 };
@@ -0,0 +1,136 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "scene/LODGroup.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "core/geometry/AABB.h"
+#include "scene/Camera.h"
+#include "scene/Model.h"
+
+namespace cc {
+namespace scene {
+
+float computeScreenUsagePercentage(const Vec3 &center, float diameter, const Camera *camera) {
+    // matProj.m[5] is 1 / tan(fov / 2) or 2 / orthoHeight
+    const float scale = camera->getMatProj().m[5] * 0.5F;
+    if (camera->getProjectionType() == CameraProjection::ORTHO) {
+        return diameter * scale;
+    }
+
+    const float distance = std::max(center.distance(camera->getPosition()), FLT_EPSILON);
+    return diameter * scale / distance;
+}
+
+void LODData::addModel(Model *model) {
+    _models.emplace_back(model);
+}
+
+void LODData::removeModel(Model *model) {
+    auto iter = std::find(_models.begin(), _models.end(), model);
+    if (iter != _models.end()) {
+        _models.erase(iter);
+    }
+}
+
+void LODData::clearModels() {
+    _models.clear();
+}
+
+void LODGroup::insertLOD(uint32_t index, LODData *lod) {
+    index = std::min(index, getLODCount());
+    _lods.insert(_lods.begin() + index, lod);
+}
+
+void LODGroup::eraseLOD(uint32_t index) {
+    if (index < getLODCount()) {
+        _lods.erase(_lods.begin() + index);
+    }
+}
+
+void LODGroup::clearLODs() {
+    _lods.clear();
+}
+
+float LODGroup::getScreenUsagePercentage(const Camera *camera) const {
+    Vec3 minPos{FLT_MAX, FLT_MAX, FLT_MAX};
+    Vec3 maxPos{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    bool hasBounds = false;
+    for (const auto &lod : _lods) {
+        for (const auto &model : lod->getModels()) {
+            const auto *bounds = model->getWorldBounds();
+            if (!bounds) {
+                continue;
+            }
+            Vec3 boundsMin;
+            Vec3 boundsMax;
+            bounds->getBoundary(&boundsMin, &boundsMax);
+            minPos.set(std::min(minPos.x, boundsMin.x), std::min(minPos.y, boundsMin.y), std::min(minPos.z, boundsMin.z));
+            maxPos.set(std::max(maxPos.x, boundsMax.x), std::max(maxPos.y, boundsMax.y), std::max(maxPos.z, boundsMax.z));
+            hasBounds = true;
+        }
+        if (hasBounds) {
+            break;
+        }
+    }
+    if (!hasBounds) {
+        // nothing to measure, always use the finest level
+        return FLT_MAX;
+    }
+
+    return computeScreenUsagePercentage((minPos + maxPos) * 0.5F, maxPos.distance(minPos), camera);
+}
+
+LODSelection LODGroup::selectLOD(const Camera *camera, float bias) const {
+    LODSelection selection;
+    if (_lods.empty()) {
+        return selection;
+    }
+
+    const float screenUsage = getScreenUsagePercentage(camera) * bias;
+    for (uint32_t i = 0; i < getLODCount(); ++i) {
+        if (screenUsage >= _lods[i]->getScreenUsagePercentage()) {
+            selection.level = static_cast<int32_t>(i);
+            break;
+        }
+    }
+
+    // fade in the finer level just below its threshold
+    const int32_t finer = selection.level < 0 ? static_cast<int32_t>(getLODCount()) - 1 : selection.level - 1;
+    if (_crossFadeWidth > 0.F && finer >= 0) {
+        const float threshold = _lods[finer]->getScreenUsagePercentage();
+        const float bandStart = threshold * (1.F - _crossFadeWidth);
+        if (screenUsage >= bandStart) {
+            selection.fadeLevel = finer;
+            selection.fade      = (screenUsage - bandStart) / (threshold - bandStart);
+        }
+    }
+    return selection;
+}
+
+} // namespace scene
+} // namespace cc
@@ -0,0 +1,126 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/Ptr.h"
+#include "base/RefCounted.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+class Vec3;
+
+namespace scene {
+
+class Camera;
+class Model;
+
+/**
+ * @en Projected height of a bounding sphere on the screen of the camera as a fraction of the screen height.
+ * @zh 包围球在相机屏幕上的投影高度占屏幕高度的比例。
+ */
+CC_DLL float computeScreenUsagePercentage(const Vec3 &center, float diameter, const Camera *camera);
+
+/**
+ * @en One level of a LOD group, its models are rendered while the group covers at least screenUsagePercentage of the screen height.
+ * @zh LOD 组中的一个层级，当 LOD 组在屏幕高度上的占比不小于 screenUsagePercentage 时渲染该层级的模型。
+ */
+class CC_DLL LODData final : public RefCounted {
+public:
+    LODData()           = default;
+    ~LODData() override = default;
+
+    inline float getScreenUsagePercentage() const { return _screenUsagePercentage; }
+    inline void  setScreenUsagePercentage(float val) { _screenUsagePercentage = val; }
+
+    inline const ccstd::vector<IntrusivePtr<Model>> &getModels() const { return _models; }
+    void                                             addModel(Model *model);
+    void                                             removeModel(Model *model);
+    void                                             clearModels();
+
+private:
+    float                              _screenUsagePercentage{1.F};
+    ccstd::vector<IntrusivePtr<Model>> _models;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(LODData);
+};
+
+/**
+ * @en The levels picked by a LOD group for a camera, fadeLevel is also rendered while cross-fading into it.
+ * @zh LOD 组针对某个相机选出的层级，交叉淡入期间 fadeLevel 层级也会被渲染。
+ */
+struct LODSelection {
+    int32_t level{-1};     // -1 if the group is too small to be rendered
+    int32_t fadeLevel{-1}; // -1 if not cross-fading
+    float   fade{0.F};     // weight of fadeLevel in [0, 1)
+};
+
+/**
+ * @en A group of models of the same object in decreasing detail, the level to render is picked natively during scene culling.
+ * Levels must be sorted by decreasing screen usage percentage.
+ * @zh 同一物体不同精细程度的一组模型，场景剔除时在原生层选择要渲染的层级。层级需按屏幕占比从大到小排列。
+ */
+class CC_DLL LODGroup final : public RefCounted {
+public:
+    LODGroup()           = default;
+    ~LODGroup() override = default;
+
+    inline bool isEnabled() const { return _enabled; }
+    inline void setEnabled(bool val) { _enabled = val; }
+
+    /**
+     * @en Width of the cross-fade band as a fraction of the threshold of the finer level, 0 to switch levels instantly.
+     * @zh 交叉淡入区间的宽度，为较精细层级阈值的比例，为 0 时立即切换层级。
+     */
+    inline float getCrossFadeWidth() const { return _crossFadeWidth; }
+    inline void  setCrossFadeWidth(float val) { _crossFadeWidth = val; }
+
+    inline const ccstd::vector<IntrusivePtr<LODData>> &getLODs() const { return _lods; }
+    inline uint32_t                                    getLODCount() const { return static_cast<uint32_t>(_lods.size()); }
+    void                                               insertLOD(uint32_t index, LODData *lod);
+    void                                               eraseLOD(uint32_t index);
+    void                                               clearLODs();
+
+    /**
+     * @en Projected height of the group on the screen of the camera as a fraction of the screen height,
+     * computed from the world bounds of the models in the finest level.
+     * @zh 根据最精细层级模型的世界包围盒计算 LOD 组在相机屏幕上的投影高度占屏幕高度的比例。
+     */
+    float getScreenUsagePercentage(const Camera *camera) const;
+
+    // Thread safe, used by the culling jobs. bias scales the screen usage, values below 1 prefer coarser levels.
+    LODSelection selectLOD(const Camera *camera, float bias) const;
+
+private:
+    bool                                 _enabled{true};
+    float                                _crossFadeWidth{0.F};
+    ccstd::vector<IntrusivePtr<LODData>> _lods;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(LODGroup);
+};
+
+} // namespace scene
+} // namespace cc
@@ -39,7 +39,10 @@ void Light::destroy() {
     _node = nullptr;
 }
 
-void Light::setNode(Node *node) { _node = node; }
+void Light::setNode(Node *node) {
+    _node = node;
+    ++_version;
+}
 
 float Light::nt2lm(float size) {
     return 4 * math::PI * math::PI * size * size;
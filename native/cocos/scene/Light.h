@@ -60,14 +60,26 @@ public:
 
     virtual void update(){};
 
+    /**
+     * @en Version of the light parameters read by the pipeline uniforms, increased whenever one of them changes.
+     * @zh 管线 uniform 所读取的光源参数的版本号，任一参数变化时递增。
+     */
+    inline uint32_t getVersion() const { return _version; }
+
     inline bool isBaked() const { return _baked; }
     inline void setBaked(bool val) { _baked = val; }
 
     inline const Vec3 &getColor() const { return _color; }
-    inline void        setColor(const Vec3 &color) { _color = color; }
+    inline void        setColor(const Vec3 &color) {
+        _color = color;
+        ++_version;
+    }
 
     inline bool isUseColorTemperature() const { return _useColorTemperature; }
-    inline void setUseColorTemperature(bool value) { _useColorTemperature = value; }
+    inline void setUseColorTemperature(bool value) {
+        _useColorTemperature = value;
+        ++_version;
+    }
 
     inline float getColorTemperature() const { return _colorTemp; }
     inline void  setColorTemperature(float val) { _colorTemp = val; }
@@ -84,7 +96,10 @@ public:
     inline RenderScene *getScene() const { return _scene; }
 
     inline const Vec3 &getColorTemperatureRGB() const { return _colorTemperatureRGB; }
-    inline void        setColorTemperatureRGB(const Vec3 &value) { _colorTemperatureRGB = value; }
+    inline void        setColorTemperatureRGB(const Vec3 &value) {
+        _colorTemperatureRGB = value;
+        ++_version;
+    }
 
     static float nt2lm(float size);
 
@@ -99,6 +114,7 @@ protected:
     Vec3               _color{1, 1, 1};
     Vec3               _colorTemperatureRGB;
     Vec3               _forward{0, 0, -1};
+    uint32_t           _version{0};
 
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(Light);
@@ -0,0 +1,232 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "scene/LightGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "base/Log.h"
+#include "core/geometry/AABB.h"
+#include "scene/SphereLight.h"
+#include "scene/SpotLight.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+// cell coordinates are packed as 21 bits signed integers
+constexpr int32_t CELL_COORD_BIAS = 1 << 20;
+constexpr int32_t CELL_COORD_MAX  = CELL_COORD_BIAS - 1;
+
+int32_t toCell(float value, float invCellSize) {
+    const float cell = std::floor(value * invCellSize);
+    return static_cast<int32_t>(std::max(std::min(cell, static_cast<float>(CELL_COORD_MAX)), static_cast<float>(-CELL_COORD_MAX)));
+}
+} // namespace
+
+const geometry::AABB *LightGrid::getLightBounds(const Light *light) {
+    switch (light->getType()) {
+        case LightType::SPHERE:
+            return &static_cast<const SphereLight *>(light)->getAABB();
+        case LightType::SPOT:
+            return &static_cast<const SpotLight *>(light)->getAABB();
+        default:
+            return nullptr;
+    }
+}
+
+uint64_t LightGrid::cellKey(int32_t x, int32_t y, int32_t z) {
+    return (static_cast<uint64_t>(x + CELL_COORD_BIAS) << 42) | (static_cast<uint64_t>(y + CELL_COORD_BIAS) << 21) | static_cast<uint64_t>(z + CELL_COORD_BIAS);
+}
+
+LightGrid::CellRange LightGrid::computeRange(const geometry::AABB &bounds) const {
+    const float invCellSize = 1.F / _cellSize;
+    CellRange   range;
+    range.minX = toCell(bounds.center.x - bounds.halfExtents.x, invCellSize);
+    range.minY = toCell(bounds.center.y - bounds.halfExtents.y, invCellSize);
+    range.minZ = toCell(bounds.center.z - bounds.halfExtents.z, invCellSize);
+    range.maxX = toCell(bounds.center.x + bounds.halfExtents.x, invCellSize);
+    range.maxY = toCell(bounds.center.y + bounds.halfExtents.y, invCellSize);
+    range.maxZ = toCell(bounds.center.z + bounds.halfExtents.z, invCellSize);
+    return range;
+}
+
+void LightGrid::add(const Light *light) {
+    if (!getLightBounds(light)) {
+        CC_LOG_WARNING("Only sphere and spot lights can be added to the light grid.");
+        return;
+    }
+    if (getSlot(light) >= 0) {
+        return;
+    }
+    const auto slot = static_cast<uint32_t>(_entries.size());
+    _entries.emplace_back();
+    _entries.back().light = light;
+    _slots[light]         = slot;
+    insertCells(slot);
+}
+
+void LightGrid::remove(const Light *light) {
+    const int32_t slot = getSlot(light);
+    if (slot < 0) {
+        return;
+    }
+
+    const auto last = static_cast<uint32_t>(_entries.size() - 1);
+    eraseCells(static_cast<uint32_t>(slot));
+    if (static_cast<uint32_t>(slot) != last) {
+        // move the last light into the free slot
+        eraseCells(last);
+        _entries[slot]               = _entries[last];
+        _slots[_entries[slot].light] = static_cast<uint32_t>(slot);
+        insertCells(static_cast<uint32_t>(slot));
+    }
+    _entries.pop_back();
+    _slots.erase(light);
+}
+
+void LightGrid::clear() {
+    _entries.clear();
+    _slots.clear();
+    _oversized.clear();
+    _cells.clear();
+}
+
+int32_t LightGrid::getSlot(const Light *light) const {
+    const auto iter = _slots.find(light);
+    return iter != _slots.end() ? static_cast<int32_t>(iter->second) : -1;
+}
+
+void LightGrid::setCellSize(float size) {
+    if (size <= 0.F || size == _cellSize) {
+        return;
+    }
+    _cellSize = size;
+    rebuild();
+}
+
+void LightGrid::rebuild() {
+    _oversized.clear();
+    _cells.clear();
+    for (uint32_t i = 0; i < _entries.size(); ++i) {
+        insertCells(i);
+    }
+}
+
+void LightGrid::update() {
+    for (uint32_t i = 0; i < _entries.size(); ++i) {
+        const auto &entry  = _entries[i];
+        const auto *bounds = getLightBounds(entry.light);
+        if (bounds->center != entry.center || bounds->halfExtents != entry.halfExtents) {
+            eraseCells(i);
+            insertCells(i);
+        }
+    }
+}
+
+void LightGrid::insertCells(uint32_t slot) {
+    auto &      entry  = _entries[slot];
+    const auto &bounds = *getLightBounds(entry.light);
+    entry.center       = bounds.center;
+    entry.halfExtents  = bounds.halfExtents;
+    entry.range        = computeRange(bounds);
+
+    const auto &r         = entry.range;
+    const auto  cellCount = static_cast<uint64_t>(r.maxX - r.minX + 1) * (r.maxY - r.minY + 1) * (r.maxZ - r.minZ + 1);
+    entry.oversized       = cellCount > MAX_CELLS_PER_LIGHT;
+    if (entry.oversized) {
+        _oversized.emplace_back(slot);
+        return;
+    }
+
+    for (int32_t x = r.minX; x <= r.maxX; ++x) {
+        for (int32_t y = r.minY; y <= r.maxY; ++y) {
+            for (int32_t z = r.minZ; z <= r.maxZ; ++z) {
+                _cells[cellKey(x, y, z)].emplace_back(slot);
+            }
+        }
+    }
+}
+
+void LightGrid::eraseCells(uint32_t slot) {
+    const auto &entry = _entries[slot];
+    if (entry.oversized) {
+        _oversized.erase(std::remove(_oversized.begin(), _oversized.end(), slot), _oversized.end());
+        return;
+    }
+
+    const auto &r = entry.range;
+    for (int32_t x = r.minX; x <= r.maxX; ++x) {
+        for (int32_t y = r.minY; y <= r.maxY; ++y) {
+            for (int32_t z = r.minZ; z <= r.maxZ; ++z) {
+                auto iter = _cells.find(cellKey(x, y, z));
+                if (iter == _cells.end()) {
+                    continue;
+                }
+                auto &slots = iter->second;
+                slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+                if (slots.empty()) {
+                    _cells.erase(iter);
+                }
+            }
+        }
+    }
+}
+
+void LightGrid::query(const geometry::AABB &bounds, ccstd::vector<uint32_t> &slots) const {
+    const auto begin = slots.size();
+    slots.insert(slots.end(), _oversized.begin(), _oversized.end());
+
+    const CellRange r         = computeRange(bounds);
+    const auto      cellCount = static_cast<uint64_t>(r.maxX - r.minX + 1) * (r.maxY - r.minY + 1) * (r.maxZ - r.minZ + 1);
+    if (cellCount > _cells.size()) {
+        // the box covers more cells than there are occupied ones, walk the occupied cells instead
+        for (const auto &cell : _cells) {
+            const auto x = static_cast<int32_t>((cell.first >> 42) & 0x1FFFFF) - CELL_COORD_BIAS;
+            const auto y = static_cast<int32_t>((cell.first >> 21) & 0x1FFFFF) - CELL_COORD_BIAS;
+            const auto z = static_cast<int32_t>(cell.first & 0x1FFFFF) - CELL_COORD_BIAS;
+            if (x >= r.minX && x <= r.maxX && y >= r.minY && y <= r.maxY && z >= r.minZ && z <= r.maxZ) {
+                slots.insert(slots.end(), cell.second.begin(), cell.second.end());
+            }
+        }
+    } else {
+        for (int32_t x = r.minX; x <= r.maxX; ++x) {
+            for (int32_t y = r.minY; y <= r.maxY; ++y) {
+                for (int32_t z = r.minZ; z <= r.maxZ; ++z) {
+                    auto iter = _cells.find(cellKey(x, y, z));
+                    if (iter != _cells.end()) {
+                        slots.insert(slots.end(), iter->second.begin(), iter->second.end());
+                    }
+                }
+            }
+        }
+    }
+
+    // lights spanning several cells are found once per cell
+    std::sort(slots.begin() + static_cast<std::ptrdiff_t>(begin), slots.end());
+    slots.erase(std::unique(slots.begin() + static_cast<std::ptrdiff_t>(begin), slots.end()), slots.end());
+}
+
+} // namespace scene
+} // namespace cc
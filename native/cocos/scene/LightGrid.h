@@ -0,0 +1,114 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/unordered_map.h"
+#include "base/std/container/vector.h"
+#include "math/Vec3.h"
+
+namespace cc {
+namespace geometry {
+class AABB;
+} // namespace geometry
+
+namespace scene {
+
+class Light;
+
+/**
+ * @en Uniform grid of the world bounds of the sphere and spot lights in a render scene, used to find the lights that may affect a box
+ * without testing every light. Lights covering too many cells are kept in a separate list returned by every query.
+ * @zh 场景中球面光与聚光灯世界包围盒的均匀网格，用于无需逐个测试即可找出可能影响某个包围盒的光源。覆盖过多网格的光源单独存放，每次查询都会返回。
+ */
+class CC_DLL LightGrid final {
+public:
+    static constexpr float    DEFAULT_CELL_SIZE{8.F};
+    static constexpr uint32_t MAX_CELLS_PER_LIGHT{64};
+
+    LightGrid()  = default;
+    ~LightGrid() = default;
+
+    void add(const Light *light);
+    void remove(const Light *light);
+    void clear();
+    // re-insert the lights whose bounds changed since the last update, must be called after the lights are updated
+    void update();
+
+    /**
+     * @en Append the slots of the lights whose bounds may overlap the box, each slot appears once, in ascending order.
+     * @zh 追加包围盒可能与该盒相交的光源槽位，每个槽位只出现一次，按升序排列。
+     */
+    void query(const geometry::AABB &bounds, ccstd::vector<uint32_t> &slots) const;
+
+    // slots are dense in [0, getLightCount()), removing a light moves the last light into its slot
+    inline uint32_t     getLightCount() const { return static_cast<uint32_t>(_entries.size()); }
+    inline const Light *getLight(uint32_t slot) const { return _entries[slot].light; }
+    int32_t             getSlot(const Light *light) const;
+    inline uint32_t     getCellCount() const { return static_cast<uint32_t>(_cells.size()); }
+
+    // changing the cell size rebuilds the grid
+    void         setCellSize(float size);
+    inline float getCellSize() const { return _cellSize; }
+
+private:
+    struct CellRange {
+        int32_t minX{0};
+        int32_t minY{0};
+        int32_t minZ{0};
+        int32_t maxX{-1};
+        int32_t maxY{-1};
+        int32_t maxZ{-1};
+    };
+
+    struct Entry {
+        const Light *light{nullptr};
+        // bounds the cells were computed from
+        Vec3      center;
+        Vec3      halfExtents;
+        CellRange range;
+        bool      oversized{false};
+    };
+
+    static const geometry::AABB *getLightBounds(const Light *light);
+    static uint64_t              cellKey(int32_t x, int32_t y, int32_t z);
+
+    CellRange computeRange(const geometry::AABB &bounds) const;
+    void      insertCells(uint32_t slot);
+    void      eraseCells(uint32_t slot);
+    void      rebuild();
+
+    float                                                   _cellSize{DEFAULT_CELL_SIZE};
+    ccstd::vector<Entry>                                    _entries;
+    ccstd::unordered_map<const Light *, uint32_t>          _slots;
+    ccstd::vector<uint32_t>                                 _oversized;
+    ccstd::unordered_map<uint64_t, ccstd::vector<uint32_t>> _cells;
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(LightGrid);
+};
+
+} // namespace scene
+} // namespace cc
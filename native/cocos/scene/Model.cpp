@@ -112,6 +112,8 @@ const ccstd::string                         INST_MAT_WORLD = "a_matWorld0";
 namespace cc {
 namespace scene {
 
+CC_SLAB_ALLOCATED_IMPL(Model)
+
 Model::Model() {
     _device = Root::getInstance()->getDevice();
 }
@@ -173,17 +175,69 @@ void Model::updateTransform(uint32_t stamp) {
         }
     }
 
+    if (resolveTransform()) {
+        transformWorldBounds();
+        if (_scene) {
+            _scene->updateOctree(this);
+        }
+    }
+}
+
+bool Model::resolveTransform() {
     Node *node = _transform;
     if (node->getChangedFlags() || node->getDirtyFlag()) {
         node->updateWorldTransform();
         _localDataUpdated = true;
-        if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
-            _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
+        return true;
+    }
+    return false;
+}
+
+void Model::transformWorldBounds() {
+    if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
+        _modelBounds->transform(_transform->getWorldMatrix(), _worldBounds);
+        syncSceneBounds();
+    }
+}
+
+void Model::syncSceneBounds() {
+    if (_scene && _sceneBoundsIndex >= 0) {
+        _scene->getModelBounds().set(static_cast<uint32_t>(_sceneBoundsIndex), _worldBounds);
+        if (_staticShadowCaster && _castShadow) {
+            _scene->markStaticShadowCastersDirty();
         }
-        if (_scene) {
-            _scene->updateOctree(this);
+    }
+}
+
+void Model::setCastShadow(bool value) {
+    if (_castShadow != value && _scene) {
+        if (_staticShadowCaster) {
+            _scene->markStaticShadowCastersDirty();
         }
+        _scene->markModelsDirty();
+    }
+    _castShadow = value;
+}
+
+void Model::setEnabled(bool value) {
+    if (_enabled != value && _scene) {
+        _scene->markModelsDirty();
+    }
+    _enabled = value;
+}
+
+void Model::setVisFlags(Layers::Enum flags) {
+    if (_visFlags != flags && _scene) {
+        _scene->markModelsDirty();
+    }
+    _visFlags = flags;
+}
+
+void Model::setStaticShadowCaster(bool value) {
+    if (_staticShadowCaster != value && _castShadow && _scene) {
+        _scene->markStaticShadowCastersDirty();
     }
+    _staticShadowCaster = value;
 }
 
 void Model::updateWorldBound() {
@@ -193,6 +247,7 @@ void Model::updateWorldBound() {
         _localDataUpdated = true;
         if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
             _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
+            syncSceneBounds();
         }
     }
 }
@@ -203,6 +258,7 @@ void Model::updateWorldBoundsForJSSkinningModel(const Vec3 &min, const Vec3 &max
         if (_modelBounds != nullptr && _modelBounds->isValid() && _worldBounds != nullptr) {
             geometry::AABB::fromPoints(min, max, _modelBounds);
             _modelBounds->transform(node->getWorldMatrix(), _worldBounds);
+            syncSceneBounds();
         }
     }
 }
@@ -210,6 +266,7 @@ void Model::updateWorldBoundsForJSSkinningModel(const Vec3 &min, const Vec3 &max
 void Model::updateWorldBoundsForJSBakedSkinningModel(geometry::AABB *aabb) {
     _worldBounds->center      = aabb->center;
     _worldBounds->halfExtents = aabb->halfExtents;
+    syncSceneBounds();
 }
 
 void Model::updateUBOs(uint32_t stamp) {
@@ -231,22 +288,55 @@ void Model::updateUBOs(uint32_t stamp) {
     }
     _localDataUpdated = false;
     getTransform()->updateWorldTransform();
+    if (fillLocalData()) {
+        uploadLocalData();
+    }
+}
+
+bool Model::fillLocalData() {
     const auto &worldMatrix = getTransform()->getWorldMatrix();
-    Mat4        mat4;
-    int         idx = _instMatWorldIdx;
+    int         idx         = _instMatWorldIdx;
     if (idx >= 0) {
         ccstd::vector<TypedArray> &attrs = getInstancedAttributeBlock()->views;
         uploadMat4AsVec4x3(worldMatrix, cc::get<Float32Array>(attrs[idx]), cc::get<Float32Array>(attrs[idx + 1]), cc::get<Float32Array>(attrs[idx + 2]));
-    } else if (_localBuffer) {
+        return false;
+    }
+    if (_localBuffer) {
+        Mat4 mat4;
         mat4ToFloat32Array(worldMatrix, _localData, pipeline::UBOLocal::MAT_WORLD_OFFSET);
         Mat4::inverseTranspose(worldMatrix, &mat4);
-
         mat4ToFloat32Array(mat4, _localData, pipeline::UBOLocal::MAT_WORLD_IT_OFFSET);
-        _localBuffer->update(_localData.buffer()->getData());
-        const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
-        if (enableOcclusionQuery) {
-            updateWorldBoundUBOs();
-        }
+        return true;
+    }
+    return false;
+}
+
+void Model::uploadLocalData() {
+    _localBuffer->update(_localData.buffer()->getData());
+    const bool enableOcclusionQuery = Root::getInstance()->getPipeline()->isOcclusionQueryEnabled();
+    if (enableOcclusionQuery) {
+        updateWorldBoundUBOs();
+    }
+}
+
+bool Model::updateLocalData(bool transformChanged) {
+    if (transformChanged) {
+        transformWorldBounds();
+    }
+    if (!_localDataUpdated) {
+        return false;
+    }
+    _localDataUpdated = false;
+    return fillLocalData();
+}
+
+void Model::commitUBOs(uint32_t stamp, bool uploadLocal) {
+    for (SubModel *subModel : _subModels) {
+        subModel->update();
+    }
+    _updateStamp = stamp;
+    if (uploadLocal) {
+        uploadLocalData();
     }
 }
 
@@ -277,6 +367,7 @@ void Model::createBoundingShape(const cc::optional<Vec3> &minPos, const cc::opti
         _worldBounds = new geometry::AABB();
     }
     geometry::AABB::fromPoints(minPos.value(), maxPos.value(), _worldBounds);
+    syncSceneBounds();
 }
 
 SubModel *Model::createSubModel() {
@@ -400,6 +491,19 @@ index_t Model::getInstancedAttributeIndex(const ccstd::string &name) const {
     return CC_INVALID_INDEX;
 }
 
+bool Model::setInstancedAttribute(const ccstd::string &name, const float *values, uint32_t count) {
+    const index_t index = getInstancedAttributeIndex(name);
+    if (index == CC_INVALID_INDEX) {
+        return false;
+    }
+    auto &         view   = _instanceAttributeBlock.views[index];
+    const uint32_t length = std::min(count, getTypedArrayLength(view));
+    for (uint32_t i = 0; i < length; ++i) {
+        setTypedArrayValue(view, i, values[i]);
+    }
+    return true;
+}
+
 void Model::updateInstancedAttributes(const ccstd::vector<gfx::Attribute> &attributes, Pass *pass) {
     if (isModelImplementedInJS()) {
         if (!_isCalledFromJS) {
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <tuple>
+#include "base/HandleTable.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
 #include "core/TypedArray.h"
@@ -34,6 +35,7 @@
 #include "core/builtin/BuiltinResMgr.h"
 #include "core/event/CallbacksInvoker.h"
 #include "core/geometry/AABB.h"
+#include "core/memop/SlabAllocator.h"
 #include "core/scene-graph/Layers.h"
 #include "core/scene-graph/Node.h"
 #include "renderer/gfx-base/GFXBuffer.h"
@@ -96,15 +98,33 @@ public:
     virtual void updateTransform(uint32_t stamp);
     virtual void updateUBOs(uint32_t stamp);
     void         updateWorldBoundUBOs();
+
+    // Split update steps used by RenderScene's parallel update mode.
+    // resolveTransform() and commitUBOs() must be called on the main thread,
+    // updateLocalData() only writes to data owned by this model and may run on any job thread.
+    inline bool isParallelUpdateSupported() const { return _type == Type::DEFAULT; }
+    bool        resolveTransform();
+    bool        updateLocalData(bool transformChanged);
+    void        commitUBOs(uint32_t stamp, bool uploadLocal);
     void         updateLocalShadowBias();
 
     inline void attachToScene(RenderScene *scene) {
         _scene            = scene;
         _localDataUpdated = true;
     };
-    inline void detachFromScene() { _scene = nullptr; };
-    inline void setCastShadow(bool value) { _castShadow = value; }
-    inline void setEnabled(bool value) { _enabled = value; }
+    inline void detachFromScene() {
+        _scene            = nullptr;
+        _sceneBoundsIndex = -1;
+    };
+    void        setCastShadow(bool value);
+    /**
+     * @en Static shadow casters are cached in a persistent shadow map layer, which is re-rendered only when the light or a static caster changes.
+     * @zh 静态阴影投射者会缓存到持久的阴影贴图层中，仅在光源或静态投射者变化时才重新绘制。
+     */
+    void        setStaticShadowCaster(bool value);
+    // occluders are rasterized as their oriented model bounds by the Hi-Z occlusion culling, only solid boxes should be occluders
+    inline void setOccluder(bool value) { _occluder = value; }
+    void        setEnabled(bool value);
     inline void setInstMatWorldIdx(int32_t idx) { _instMatWorldIdx = idx; }
     inline void setLocalBuffer(gfx::Buffer *buffer) { _localBuffer = buffer; }
     inline void setWorldBoundBuffer(gfx::Buffer *buffer) { _worldBoundBuffer = buffer; }
@@ -117,16 +137,19 @@ public:
     inline void setShadowBias(float bias) { _shadowBias = bias; }
     inline void setShadowNormalBias(float normalBias) { _shadowNormalBias = normalBias; }
     inline void setTransform(Node *node) { _transform = node; }
-    inline void setVisFlags(Layers::Enum flags) { _visFlags = flags; }
+    void        setVisFlags(Layers::Enum flags);
     inline void setBounds(geometry::AABB *world) {
         _worldBounds = world;
         _modelBounds->set(_worldBounds->getCenter(), _worldBounds->getHalfExtents());
+        syncSceneBounds();
     }
     inline void setInstancedAttributeBlock(const InstancedAttributeBlock &val) {
         _instanceAttributeBlock = val;
         _localDataUpdated       = true;
     }
     inline void setOctreeNode(OctreeNode *node) { _octreeNode = node; }
+    inline void setSceneBoundsIndex(int32_t index) { _sceneBoundsIndex = index; }
+    inline void setSceneHandle(const GenerationalHandle<Model> &handle) { _sceneHandle = handle; }
     inline void setScene(RenderScene *scene) {
         _scene = scene;
         if (scene) _localDataUpdated = true;
@@ -134,6 +157,8 @@ public:
 
     inline bool                                         isInited() const { return _inited; };
     inline bool                                         isCastShadow() const { return _castShadow; }
+    inline bool                                         isOccluder() const { return _occluder; }
+    inline bool                                         isStaticShadowCaster() const { return _staticShadowCaster; }
     inline bool                                         isEnabled() const { return _enabled; }
     inline bool                                         isInstancingEnabled() const { return _instMatWorldIdx >= 0; };
     inline int32_t                                      getInstMatWorldIdx() const { return _instMatWorldIdx; }
@@ -156,6 +181,9 @@ public:
     inline Type                                         getType() const { return _type; };
     inline void                                         setType(Type type) { _type = type; }
     inline OctreeNode *                                 getOctreeNode() const { return _octreeNode; }
+    inline int32_t                                      getSceneBoundsIndex() const { return _sceneBoundsIndex; }
+    // resolves to this model through RenderScene::getModel as long as it is in the scene
+    inline const GenerationalHandle<Model> &            getSceneHandle() const { return _sceneHandle; }
     inline RenderScene *                                getScene() const { return _scene; }
     inline void                                         setDynamicBatching(bool val) { _isDynamicBatching = val; }
     inline bool                                         isDynamicBatching() const { return _isDynamicBatching; }
@@ -170,12 +198,23 @@ public:
 
     int32_t getInstancedAttributeIndex(const ccstd::string &name) const;
 
+    /**
+     * @en Set the value of an instanced attribute of the model. Per object values like a tint set this way keep the material
+     * shared, so models using it are still instanced together. Returns false if the shader has no such instanced attribute.
+     * @zh 设置模型的实例化属性值。通过此方式设置的逐对象数据（如染色）不会使材质实例化，使用该材质的模型仍可一起实例化绘制。
+     * 着色器中没有该实例化属性时返回 false。
+     */
+    bool setInstancedAttribute(const ccstd::string &name, const float *values, uint32_t count);
+
     // For JS
     inline void              setCalledFromJS(bool v) { _isCalledFromJS = v; }
     inline CallbacksInvoker &getEventProcessor() { return _eventProcessor; }
     void                     setInstancedAttributesViewData(index_t viewIdx, index_t arrIdx, float value);
     inline void              setLocalDataUpdated(bool v) { _localDataUpdated = v; }
-    inline void              setWorldBounds(geometry::AABB *bounds) { _worldBounds = bounds; }
+    inline void              setWorldBounds(geometry::AABB *bounds) {
+        _worldBounds = bounds;
+        syncSceneBounds();
+    }
     inline void              setModelBounds(geometry::AABB *bounds) { _modelBounds = bounds; }
     inline bool              isModelImplementedInJS() const { return (_type != Type::DEFAULT && _type != Type::SKINNING && _type != Type::BAKED_SKINNING); };
 
@@ -183,6 +222,11 @@ protected:
     static void uploadMat4AsVec4x3(const Mat4 &mat, Float32Array &v1, Float32Array &v2, Float32Array &v3);
 
     void updateAttributesAndBinding(index_t subModelIndex);
+    void transformWorldBounds();
+    // copy the world bounds into the SoA bounds array of the owner scene, must follow every change of _worldBounds
+    void syncSceneBounds();
+    bool fillLocalData();
+    void uploadLocalData();
 
     static SubModel *createSubModel();
 
@@ -191,6 +235,8 @@ protected:
     IntrusivePtr<geometry::AABB> _worldBounds;
     IntrusivePtr<geometry::AABB> _modelBounds;
     OctreeNode *                 _octreeNode{nullptr};
+    int32_t                      _sceneBoundsIndex{-1};
+    GenerationalHandle<Model>    _sceneHandle;
     RenderScene *                _scene{nullptr};
     gfx::Device *                _device{nullptr};
     bool                         _inited{false};
@@ -200,6 +246,8 @@ protected:
 
     bool _enabled{false};
     bool _castShadow{false};
+    bool _occluder{false};
+    bool _staticShadowCaster{false};
     bool _receiveShadow{false};
     bool _isDynamicBatching{false};
 
@@ -227,6 +275,7 @@ protected:
 
 private:
     CC_DISALLOW_COPY_MOVE_ASSIGN(Model);
+    CC_SLAB_ALLOCATED(Model);
 };
 
 } // namespace scene
@@ -0,0 +1,210 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "scene/ModelBoundsArray.h"
+#include <cfloat>
+#include <cstring>
+#include "base/threading/FrameArena.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Frustum.h"
+#include "math/Mat4.h"
+#include "math/MathUtil.h"
+
+namespace cc {
+namespace scene {
+
+namespace {
+// the batched kernel reads 4 floats at a time
+constexpr uint32_t SIMD_WIDTH = 4;
+
+uint32_t gatherPlanes(const geometry::Frustum &frustum, ccstd::array<float, 4 * 6> &planes) {
+    uint32_t planeCount = 0;
+    for (const auto *plane : frustum.planes) {
+        planes[planeCount * 4 + 0] = plane->n.x;
+        planes[planeCount * 4 + 1] = plane->n.y;
+        planes[planeCount * 4 + 2] = plane->n.z;
+        planes[planeCount * 4 + 3] = plane->d;
+        ++planeCount;
+    }
+    return planeCount;
+}
+} // namespace
+
+uint32_t ModelBoundsArray::add(const geometry::AABB *bounds) {
+    const uint32_t index = _size;
+    resize(_size + 1);
+    set(index, bounds);
+    return index;
+}
+
+void ModelBoundsArray::set(uint32_t index, const geometry::AABB *bounds) {
+    CC_ASSERT(index < _size);
+    _stamps[index] = ++_version;
+    if (bounds) {
+        _streams[CENTER_X][index] = bounds->center.x;
+        _streams[CENTER_Y][index] = bounds->center.y;
+        _streams[CENTER_Z][index] = bounds->center.z;
+        _streams[EXTENT_X][index] = bounds->halfExtents.x;
+        _streams[EXTENT_Y][index] = bounds->halfExtents.y;
+        _streams[EXTENT_Z][index] = bounds->halfExtents.z;
+    } else {
+        for (uint32_t i = CENTER_X; i <= CENTER_Z; ++i) {
+            _streams[i][index] = 0.0F;
+        }
+        for (uint32_t i = EXTENT_X; i <= EXTENT_Z; ++i) {
+            _streams[i][index] = FLT_MAX;
+        }
+    }
+}
+
+void ModelBoundsArray::transform(const uint32_t *indices, const geometry::AABB *const *localBounds, const Mat4 *const *matrices,
+                                 geometry::AABB *const *worldBounds, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // centers first, then extents
+    _transformMatrices.resize(count);
+    _transformInput.resize(count * 6);
+    _transformOutput.resize(count * 6);
+    float *centers = _transformInput.data();
+    float *extents = centers + count * 3;
+    for (uint32_t i = 0; i < count; ++i) {
+        _transformMatrices[i] = matrices[i]->m;
+        const auto &local     = *localBounds[i];
+        memcpy(centers + i * 3, &local.center.x, sizeof(float) * 3);
+        memcpy(extents + i * 3, &local.halfExtents.x, sizeof(float) * 3);
+    }
+
+    float *outCenters = _transformOutput.data();
+    float *outExtents = outCenters + count * 3;
+    MathUtil::transformAABBBatch(_transformMatrices.data(), centers, extents, count, outCenters, outExtents);
+
+    const uint32_t version = ++_version;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t index = indices[i];
+        CC_ASSERT(index < _size);
+        const float *c            = outCenters + i * 3;
+        const float *e            = outExtents + i * 3;
+        _streams[CENTER_X][index] = c[0];
+        _streams[CENTER_Y][index] = c[1];
+        _streams[CENTER_Z][index] = c[2];
+        _streams[EXTENT_X][index] = e[0];
+        _streams[EXTENT_Y][index] = e[1];
+        _streams[EXTENT_Z][index] = e[2];
+        _stamps[index]            = version;
+        if (worldBounds && worldBounds[i]) {
+            worldBounds[i]->center.set(c[0], c[1], c[2]);
+            worldBounds[i]->halfExtents.set(e[0], e[1], e[2]);
+        }
+    }
+}
+
+void ModelBoundsArray::erase(uint32_t index) {
+    CC_ASSERT(index < _size);
+    for (auto &stream : _streams) {
+        stream.erase(stream.begin() + index);
+    }
+    _stamps.erase(_stamps.begin() + index);
+    resize(_size - 1);
+}
+
+void ModelBoundsArray::clear() {
+    for (auto &stream : _streams) {
+        stream.clear();
+    }
+    _stamps.clear();
+    _size = 0;
+    ++_version;
+    ++_layoutVersion;
+}
+
+void ModelBoundsArray::resize(uint32_t size) {
+    const uint32_t padded = (size + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    for (auto &stream : _streams) {
+        stream.resize(padded, 0.0F);
+    }
+    _size = size;
+    _stamps.resize(size, ++_version);
+    ++_layoutVersion;
+}
+
+void ModelBoundsArray::cull(const geometry::Frustum &frustum, ccstd::pmr::vector<uint8_t> &results) const {
+    ccstd::array<float, 4 * 6> planes;
+    const uint32_t             planeCount = gatherPlanes(frustum, planes);
+
+    results.resize(_size);
+    if (_size == 0) {
+        return;
+    }
+
+    MathUtil::aabbPlanesBatch(_streams[CENTER_X].data(), _streams[CENTER_Y].data(), _streams[CENTER_Z].data(),
+                              _streams[EXTENT_X].data(), _streams[EXTENT_Y].data(), _streams[EXTENT_Z].data(),
+                              _size, planes.data(), planeCount, results.data());
+}
+
+void ModelBoundsArray::getChangedSince(uint32_t version, ccstd::pmr::vector<uint32_t> &indices) const {
+    for (uint32_t i = 0; i < _size; ++i) {
+        // wrap around safe comparison
+        if (static_cast<int32_t>(_stamps[i] - version) > 0) {
+            indices.emplace_back(i);
+        }
+    }
+}
+
+void ModelBoundsArray::cull(const geometry::Frustum &frustum, const ccstd::pmr::vector<uint32_t> &indices, ccstd::pmr::vector<uint8_t> &results) const {
+    CC_ASSERT(results.size() == _size);
+    if (indices.empty()) {
+        return;
+    }
+
+    // gather the listed slots into packed streams to run the same batched kernel
+    auto *         arena  = FrameArena::getInstance();
+    const auto     count  = static_cast<uint32_t>(indices.size());
+    const uint32_t padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+    ccstd::pmr::vector<float> packed(static_cast<size_t>(padded) * Stream::COUNT, 0.0F, arena);
+    for (uint32_t s = 0; s < Stream::COUNT; ++s) {
+        float *stream = packed.data() + static_cast<size_t>(s) * padded;
+        for (uint32_t i = 0; i < count; ++i) {
+            stream[i] = _streams[s][indices[i]];
+        }
+    }
+
+    ccstd::array<float, 4 * 6> planes;
+    const uint32_t             planeCount = gatherPlanes(frustum, planes);
+
+    ccstd::pmr::vector<uint8_t> packedResults(count, 0, arena);
+    const float *               streams = packed.data();
+    MathUtil::aabbPlanesBatch(streams, streams + padded, streams + padded * 2,
+                              streams + padded * 3, streams + padded * 4, streams + padded * 5,
+                              count, planes.data(), planeCount, packedResults.data());
+    for (uint32_t i = 0; i < count; ++i) {
+        results[indices[i]] = packedResults[i];
+    }
+}
+
+} // namespace scene
+} // namespace cc
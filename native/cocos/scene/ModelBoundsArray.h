@@ -0,0 +1,108 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include "base/Macros.h"
+#include "base/std/container/array.h"
+#include "base/std/container/vector.h"
+
+namespace cc {
+class Mat4;
+namespace geometry {
+class AABB;
+class Frustum;
+} // namespace geometry
+
+namespace scene {
+
+/**
+ * @en World bounds of the models in a render scene packed in SoA layout for batched culling,
+ * slots follow the order of RenderScene::getModels and are kept in sync by the models.
+ * @zh 以 SoA 布局存储的场景模型世界包围盒，用于批量剔除，顺序与 RenderScene::getModels 一致，由模型负责同步。
+ */
+class CC_DLL ModelBoundsArray final {
+public:
+    ModelBoundsArray()  = default;
+    ~ModelBoundsArray() = default;
+
+    // append bounds and return the slot index, models without bounds are never culled
+    uint32_t add(const geometry::AABB *bounds);
+    void     set(uint32_t index, const geometry::AABB *bounds);
+    /**
+     * @en Transform local bounds by their world matrices in batch and write them into the given slots, as well as into worldBounds
+     * if it is not null. The version is increased once for the whole batch.
+     * @zh 批量使用世界矩阵变换局部包围盒，并写入指定的槽位，worldBounds 不为空时同时写入 worldBounds。整批只增加一次版本号。
+     */
+    void transform(const uint32_t *indices, const geometry::AABB *const *localBounds, const Mat4 *const *matrices,
+                   geometry::AABB *const *worldBounds, uint32_t count);
+    void     erase(uint32_t index);
+    void     clear();
+
+    inline uint32_t size() const { return _size; }
+    // changes whenever any bounds changes
+    inline uint32_t getVersion() const { return _version; }
+    // changes only when slots are added or removed
+    inline uint32_t getLayoutVersion() const { return _layoutVersion; }
+    // append the slots set after the given version, only meaningful while the layout version is unchanged
+    void getChangedSince(uint32_t version, ccstd::pmr::vector<uint32_t> &indices) const;
+
+    /**
+     * @en Test all bounds against the frustum, results[i] is 1 if the i-th bounds is not culled
+     * @zh 批量测试所有包围盒与视锥体，第 i 个包围盒未被剔除时 results[i] 为 1
+     */
+    void cull(const geometry::Frustum &frustum, ccstd::pmr::vector<uint8_t> &results) const;
+    // test only the listed slots, results must already hold size() entries and the others are left untouched
+    void cull(const geometry::Frustum &frustum, const ccstd::pmr::vector<uint32_t> &indices, ccstd::pmr::vector<uint8_t> &results) const;
+
+private:
+    enum Stream {
+        CENTER_X,
+        CENTER_Y,
+        CENTER_Z,
+        EXTENT_X,
+        EXTENT_Y,
+        EXTENT_Z,
+        COUNT,
+    };
+
+    void resize(uint32_t size);
+
+    ccstd::array<ccstd::vector<float>, Stream::COUNT> _streams;
+    // version of the last change of each slot
+    ccstd::vector<uint32_t>                           _stamps;
+    // staging of transform, [x, y, z] for each box
+    ccstd::vector<const float *>                      _transformMatrices;
+    ccstd::vector<float>                              _transformInput;
+    ccstd::vector<float>                              _transformOutput;
+    uint32_t                                          _size{0};
+    uint32_t                                          _version{0};
+    uint32_t                                          _layoutVersion{0};
+
+    CC_DISALLOW_COPY_MOVE_ASSIGN(ModelBoundsArray);
+};
+
+} // namespace scene
+} // namespace cc
@@ -63,6 +63,13 @@ void OctreeInfo::setDepth(uint32_t val) {
     }
 }
 
+void OctreeInfo::setLooseness(float val) {
+    _looseness = val;
+    if (_resource) {
+        _resource->setLooseness(val);
+    }
+}
+
 void OctreeInfo::activate(Octree *resource) {
     _resource = resource;
     _resource->initialize(*this);
@@ -87,14 +94,18 @@ void OctreeInfo::activate(Octree *resource) {
 /**
  * OctreeNode class
  */
-OctreeNode::OctreeNode(Octree *owner, OctreeNode *parent)
-: _owner(owner), _parent(parent) {
+namespace {
+BBox scaleBox(const BBox &box, float scale) {
+    const cc::Vec3 center      = box.getCenter();
+    const cc::Vec3 halfExtents = (box.max - box.min) * (0.5F * scale);
+    return {center - halfExtents, center + halfExtents};
 }
+} // namespace
 
-OctreeNode::~OctreeNode() {
-    for (auto i = 0; i < OCTREE_CHILDREN_NUM; i++) {
-        deleteChild(i);
-    }
+void OctreeNode::setBox(const BBox &aabb) {
+    _aabb     = aabb;
+    _looseBox = scaleBox(aabb, _owner->getLooseness());
+    geometry::AABB::fromPoints(_looseBox.min, _looseBox.max, &_looseAABB);
 }
 
 BBox OctreeNode::getChildBox(uint32_t index) const {
@@ -123,11 +134,19 @@ BBox OctreeNode::getChildBox(uint32_t index) const {
     return {min, max};
 }
 
+uint32_t OctreeNode::getChildIndex(const cc::Vec3 &point) const {
+    const cc::Vec3 center = _aabb.getCenter();
+
+    uint32_t index = point.x < center.x ? 0 : 1;
+    index += point.y < center.y ? 0 : 2;
+    index += point.z < center.z ? 0 : 4;
+    return index;
+}
+
 OctreeNode *OctreeNode::getOrCreateChild(uint32_t index) {
     if (!_children[index]) {
-        BBox  childBox = getChildBox(index);
-        auto *child = _children[index] = new OctreeNode(_owner, this);
-        child->setBox(childBox);
+        auto *child = _children[index] = _owner->allocNode(this);
+        child->setBox(getChildBox(index));
         child->setDepth(_depth + 1);
         child->setIndex(index);
     }
@@ -137,7 +156,7 @@ OctreeNode *OctreeNode::getOrCreateChild(uint32_t index) {
 
 void OctreeNode::deleteChild(uint32_t index) {
     if (_children[index]) {
-        delete _children[index];
+        _owner->freeNode(_children[index]);
         _children[index] = nullptr;
     }
 }
@@ -145,15 +164,11 @@ void OctreeNode::deleteChild(uint32_t index) {
 void OctreeNode::insert(Model *model) { // NOLINT(misc-no-recursion)
     bool split = false;
     if (_depth < _owner->getMaxDepth() - 1) {
-        BBox            modelBox(*model->getWorldBounds());
-        const cc::Vec3 &modelCenter = modelBox.getCenter();
-        const cc::Vec3 &nodeCenter  = _aabb.getCenter();
-
-        uint32_t index = modelCenter.x < nodeCenter.x ? 0 : 1;
-        index += modelCenter.y < nodeCenter.y ? 0 : 2;
-        index += modelCenter.z < nodeCenter.z ? 0 : 4;
+        BBox     modelBox(*model->getWorldBounds());
+        uint32_t index = getChildIndex(modelBox.getCenter());
 
-        BBox childBox = getChildBox(index);
+        // test against the loose bounds, so that small models crossing the split planes can still sink deeper
+        BBox childBox = scaleBox(getChildBox(index), _owner->getLooseness());
         if (childBox.contain(modelBox)) {
             split = true;
 
@@ -251,9 +266,7 @@ void OctreeNode::doQueryVisibility(const Camera *camera, const geometry::Frustum
 }
 
 void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
+    if (!_looseAABB.aabbFrustum(frustum)) {
         return;
     }
 
@@ -279,9 +292,7 @@ void OctreeNode::queryVisibilityParallelly(const Camera *camera, const geometry:
 }
 
 void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const { // NOLINT(misc-no-recursion)
-    geometry::AABB box;
-    geometry::AABB::fromPoints(_aabb.min, _aabb.max, &box);
-    if (!box.aabbFrustum(frustum)) {
+    if (!_looseAABB.aabbFrustum(frustum)) {
         return;
     }
 
@@ -299,18 +310,21 @@ void OctreeNode::queryVisibilitySequentially(const Camera *camera, const geometr
  * Octree class
  */
 Octree::Octree() {
-    _root = new OctreeNode(this, nullptr);
+    _root = allocNode(nullptr);
 }
 
 Octree::~Octree() {
-    delete _root;
+    for (auto *block : _nodeBlocks) {
+        delete[] block;
+    }
 }
 
 void Octree::initialize(const OctreeInfo &info) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
     _minPos   = info.getMinPos();
     _maxPos   = info.getMaxPos();
-    _maxDepth = std::max(info.getDepth(), 1U);
+    _maxDepth  = std::max(info.getDepth(), 1U);
+    _looseness = std::max(info.getLooseness(), 1.0F);
     setEnabled(info.isEnabled());
     _root->setBox(BBox{_minPos - expand, _maxPos});
     _root->setDepth(0);
@@ -336,6 +350,16 @@ void Octree::setMaxDepth(uint32_t val) {
     _maxDepth = val;
 }
 
+void Octree::setLooseness(float val) {
+    val = std::max(val, 1.0F);
+    if (_looseness == val) {
+        return;
+    }
+
+    _looseness = val;
+    rebuild(_root->getBox());
+}
+
 void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
     const Vec3 expand{OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE, OCTREE_BOX_EXPAND_SIZE};
     BBox       rootBox = _root->getBox();
@@ -343,17 +367,21 @@ void Octree::resize(const Vec3 &minPos, const Vec3 &maxPos, uint32_t maxDepth) {
         return;
     }
 
+    _maxDepth = std::max(maxDepth, 1U);
+    rebuild(BBox{minPos - expand, maxPos});
+}
+
+void Octree::rebuild(const BBox &rootBox) {
     ccstd::vector<Model *> models;
     _root->gatherModels(models);
 
-    delete _root;
-    _root = new OctreeNode(this, nullptr);
-    _root->setBox(BBox{minPos - expand, maxPos});
+    freeNode(_root);
+    _root = allocNode(nullptr);
+    _root->setBox(rootBox);
     _root->setDepth(0);
     _root->setIndex(0);
 
-    _maxDepth = std::max(maxDepth, 1U);
-
+    _totalCount = 0;
     for (auto *model : models) {
         model->setOctreeNode(nullptr);
         insert(model);
@@ -392,7 +420,24 @@ void Octree::remove(Model *model) {
 }
 
 void Octree::update(Model *model) {
-    insert(model);
+    OctreeNode *node = model->getOctreeNode();
+    if (!node || !model->getWorldBounds()) {
+        insert(model);
+        return;
+    }
+
+    // refit in place: restart the insertion from the closest node that still holds the model,
+    // which usually is the current node itself, instead of descending from the root again.
+    BBox modelBox(*model->getWorldBounds());
+    while (node && !node->getLooseBox().contain(modelBox)) {
+        node = node->_parent;
+    }
+
+    if (node) {
+        node->insert(model);
+    } else {
+        insert(model);
+    }
 }
 
 void Octree::queryVisibility(Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const {
@@ -403,6 +448,37 @@ void Octree::queryVisibility(Camera *camera, const geometry::Frustum &frustum, b
     }
 }
 
+OctreeNode *Octree::allocNode(OctreeNode *parent) {
+    if (!_freeNodes) {
+        auto *block = new OctreeNode[OCTREE_NODE_BLOCK_SIZE];
+        for (auto i = 0; i < OCTREE_NODE_BLOCK_SIZE; i++) {
+            block[i]._parent = _freeNodes;
+            _freeNodes       = &block[i];
+        }
+        _nodeBlocks.push_back(block);
+    }
+
+    OctreeNode *node = _freeNodes;
+    _freeNodes       = node->_parent;
+    node->_owner     = this;
+    node->_parent    = parent;
+    return node;
+}
+
+void Octree::freeNode(OctreeNode *node) { // NOLINT(misc-no-recursion)
+    for (auto *&child : node->_children) {
+        if (child) {
+            freeNode(child);
+            child = nullptr;
+        }
+    }
+
+    // keep the capacity of the model list for reuse
+    node->_models.clear();
+    node->_parent = _freeNodes;
+    _freeNodes    = node;
+}
+
 bool Octree::isInside(Model *model) const {
     const BBox &rootBox  = _root->getBox();
     BBox        modelBox = BBox(*model->getWorldBounds());
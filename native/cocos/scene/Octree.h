@@ -28,6 +28,7 @@
 #include "base/Macros.h"
 #include "base/RefCounted.h"
 #include "base/std/container/array.h"
+#include "base/std/container/vector.h"
 #include "core/geometry/AABB.h"
 #include "math/Vec3.h"
 
@@ -44,6 +45,8 @@ const Vec3    DEFAULT_WORLD_MIN_POS  = {-1024.0F, -1024.0F, -1024.0F};
 const Vec3    DEFAULT_WORLD_MAX_POS  = {1024.0F, 1024.0F, 1024.0F};
 const float   OCTREE_BOX_EXPAND_SIZE = 10.0F;
 constexpr int USE_MULTI_THRESHOLD    = 1024; // use parallel culling if greater than this value
+const float   DEFAULT_OCTREE_LOOSENESS = 1.0F;
+constexpr int OCTREE_NODE_BLOCK_SIZE   = 64; // number of nodes allocated at once by the node pool
 
 class CC_DLL OctreeInfo final : public RefCounted {
 public:
@@ -77,6 +80,13 @@ public:
     void            setDepth(uint32_t val);
     inline uint32_t getDepth() const { return _depth; }
 
+    /**
+     * @en Looseness of octree nodes, node bounds used for containment are scaled by this factor, should be in range [1, 2]
+     * @zh 八叉树节点松散系数，节点包围盒会按该系数放大，取值范围 [1, 2]
+     */
+    void         setLooseness(float val);
+    inline float getLooseness() const { return _looseness; }
+
     void activate(Octree *resource);
 
     // JS deserialization require the properties to be public
@@ -85,6 +95,7 @@ public:
     Vec3     _minPos{DEFAULT_WORLD_MIN_POS};
     Vec3     _maxPos{DEFAULT_WORLD_MAX_POS};
     uint32_t _depth{DEFAULT_OCTREE_DEPTH};
+    float    _looseness{DEFAULT_OCTREE_LOOSENESS};
 
     Octree *_resource{nullptr};
 };
@@ -128,16 +139,19 @@ struct CC_DLL BBox final {
  */
 class CC_DLL OctreeNode final {
 private:
-    OctreeNode(Octree *owner, OctreeNode *parent);
-    ~OctreeNode();
+    // Nodes are allocated in blocks by the owner octree, see Octree::allocNode.
+    OctreeNode()  = default;
+    ~OctreeNode() = default;
 
-    inline void setBox(const BBox &aabb) { _aabb = aabb; }
+    void        setBox(const BBox &aabb);
     inline void setDepth(uint32_t depth) { _depth = depth; }
     inline void setIndex(uint32_t index) { _index = index; }
 
     inline Octree *    getOwner() const { return _owner; }
     inline const BBox &getBox() const { return _aabb; }
+    inline const BBox &getLooseBox() const { return _looseBox; }
     BBox               getChildBox(uint32_t index) const;
+    uint32_t           getChildIndex(const cc::Vec3 &point) const;
     OctreeNode *       getOrCreateChild(uint32_t index);
     void               deleteChild(uint32_t index);
     void               insert(Model *model);
@@ -154,6 +168,8 @@ private:
     ccstd::array<OctreeNode *, OCTREE_CHILDREN_NUM> _children{};
     ccstd::vector<Model *>                          _models;
     BBox                                            _aabb{};
+    BBox                                            _looseBox{};   // _aabb scaled by octree looseness around its center
+    geometry::AABB                                  _looseAABB{}; // _looseBox used by frustum culling
     uint32_t                                        _depth{0};
     uint32_t                                        _index{0};
 
@@ -200,7 +216,7 @@ public:
     // remove a model from tree.
     void remove(Model *model);
 
-    // update model's location in the tree.
+    // update model's location in the tree, refit in place if the model still fits in its node.
     void update(Model *model);
 
     /**
@@ -211,15 +227,32 @@ public:
     // return octree depth
     inline uint32_t getMaxDepth() const { return _maxDepth; }
 
+    /**
+     * @en Looseness of octree nodes, all models are reinserted when it changes
+     * @zh 八叉树节点松散系数，修改后会重新插入所有模型
+     */
+    void         setLooseness(float val);
+    inline float getLooseness() const { return _looseness; }
+
     // view frustum culling
     void queryVisibility(Camera *camera, const geometry::Frustum &frustum, bool isShadow, ccstd::vector<Model *> &results) const;
 
 private:
-    bool isInside(Model *model) const;
+    bool        isInside(Model *model) const;
+    void        rebuild(const BBox &rootBox);
+    OctreeNode *allocNode(OctreeNode *parent);
+    void        freeNode(OctreeNode *node);
 
     OctreeNode *_root{nullptr};
     uint32_t    _maxDepth{DEFAULT_OCTREE_DEPTH};
     uint32_t    _totalCount{0};
+    float       _looseness{DEFAULT_OCTREE_LOOSENESS};
+
+    // node pool, free nodes are linked through OctreeNode::_parent
+    ccstd::vector<OctreeNode *> _nodeBlocks;
+    OctreeNode *                _freeNodes{nullptr};
+
+    friend class OctreeNode;
 
     bool _enabled{false};
     Vec3 _minPos;
@@ -25,8 +25,7 @@
 
 #include "scene/Pass.h"
 
-#include <sstream>
-
+#include <algorithm>
 #include "boost/container_hash/hash.hpp"
 #include "core/Root.h"
 #include "core/assets/TextureBase.h"
@@ -46,30 +45,46 @@ namespace scene {
 
 namespace {
 
-ccstd::string serializeBlendState(const gfx::BlendState &bs) {
-    std::stringstream res;
-    res << ",bs," << bs.isA2C;
+void hashBlendState(std::size_t &seed, const gfx::BlendState &bs) {
+    boost::hash_combine(seed, bs.isA2C);
     for (const auto &t : bs.targets) {
-        res << ",bt," << t.blend << "," << static_cast<uint32_t>(t.blendEq) << "," << static_cast<uint32_t>(t.blendAlphaEq) << "," << static_cast<uint32_t>(t.blendColorMask);
-        res << "," << static_cast<uint32_t>(t.blendSrc) << "," << static_cast<uint32_t>(t.blendDst) << "," << static_cast<uint32_t>(t.blendSrcAlpha) << "," << static_cast<uint32_t>(t.blendDstAlpha);
-    }
-    return res.str();
-}
-
-ccstd::string serializeRasterizerState(const gfx::RasterizerState &rs) {
-    std::stringstream res;
-    res << ",rs," << static_cast<uint32_t>(rs.cullMode) << "," << static_cast<uint32_t>(rs.depthBias) << "," << static_cast<uint32_t>(rs.isFrontFaceCCW);
-    return res.str();
-}
-
-ccstd::string serializeDepthStencilState(const gfx::DepthStencilState &dss) {
-    std::stringstream res;
-    res << ",dss," << static_cast<uint32_t>(dss.depthTest) << "," << static_cast<uint32_t>(dss.depthWrite) << "," << static_cast<uint32_t>(dss.depthFunc);
-    res << "," << static_cast<uint32_t>(dss.stencilTestFront) << "," << static_cast<uint32_t>(dss.stencilFuncFront) << "," << static_cast<uint32_t>(dss.stencilRefFront) << "," << static_cast<uint32_t>(dss.stencilReadMaskFront);
-    res << "," << static_cast<uint32_t>(dss.stencilFailOpFront) << "," << static_cast<uint32_t>(dss.stencilZFailOpFront) << "," << static_cast<uint32_t>(dss.stencilPassOpFront) << "," << static_cast<uint32_t>(dss.stencilWriteMaskFront);
-    res << "," << static_cast<uint32_t>(dss.stencilTestBack) << "," << static_cast<uint32_t>(dss.stencilFuncBack) << "," << static_cast<uint32_t>(dss.stencilRefBack) << "," << static_cast<uint32_t>(dss.stencilReadMaskBack);
-    res << "," << static_cast<uint32_t>(dss.stencilFailOpBack) << "," << static_cast<uint32_t>(dss.stencilZFailOpBack) << "," << static_cast<uint32_t>(dss.stencilPassOpBack) << "," << dss.stencilWriteMaskBack;
-    return res.str();
+        boost::hash_combine(seed, t.blend);
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendEq));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendAlphaEq));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendColorMask));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendSrc));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendDst));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendSrcAlpha));
+        boost::hash_combine(seed, static_cast<uint32_t>(t.blendDstAlpha));
+    }
+}
+
+void hashRasterizerState(std::size_t &seed, const gfx::RasterizerState &rs) {
+    boost::hash_combine(seed, static_cast<uint32_t>(rs.cullMode));
+    boost::hash_combine(seed, static_cast<uint32_t>(rs.depthBias));
+    boost::hash_combine(seed, static_cast<uint32_t>(rs.isFrontFaceCCW));
+}
+
+void hashDepthStencilState(std::size_t &seed, const gfx::DepthStencilState &dss) {
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.depthTest));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.depthWrite));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.depthFunc));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilTestFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilFuncFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilRefFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilReadMaskFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilFailOpFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilZFailOpFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilPassOpFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilWriteMaskFront));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilTestBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilFuncBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilRefBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilReadMaskBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilFailOpBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilZFailOpBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilPassOpBack));
+    boost::hash_combine(seed, static_cast<uint32_t>(dss.stencilWriteMaskBack));
 }
 
 } // namespace
@@ -108,16 +123,20 @@ void Pass::fillPipelineInfo(Pass *pass, const IPassInfoFull &info) {
 
 /* static */
 uint64_t Pass::getPassHash(Pass *pass) {
-    const ccstd::string &shaderKey = ProgramLib::getInstance()->getKey(pass->getProgram(), pass->getDefines());
-    std::stringstream    res;
-    res << shaderKey << "," << static_cast<uint32_t>(pass->_primitive) << "," << static_cast<uint32_t>(pass->_dynamicStates);
-    res << serializeBlendState(pass->_blendState);
-    res << serializeDepthStencilState(pass->_depthStencilState);
-    res << serializeRasterizerState(pass->_rs);
-
-    ccstd::string str{res.str()};
-    std::size_t   seed = 666;
-    boost::hash_range(seed, str.begin(), str.end());
+    uint64_t defineHash = pass->_defineSet.getHash();
+    if (pass->_defineSet.empty()) {
+        DefineSet defines;
+        ProgramLib::getInstance()->initDefineSet(pass->getProgram(), pass->getDefines(), defines);
+        defineHash = defines.getHash();
+    }
+    // combine the states directly instead of hashing a serialized string of them
+    std::size_t seed = 666;
+    boost::hash_combine(seed, defineHash);
+    boost::hash_combine(seed, static_cast<uint32_t>(pass->_primitive));
+    boost::hash_combine(seed, static_cast<uint32_t>(pass->_dynamicStates));
+    hashBlendState(seed, pass->_blendState);
+    hashDepthStencilState(seed, pass->_depthStencilState);
+    hashRasterizerState(seed, pass->_rs);
     return static_cast<uint32_t>(seed);
 }
 
@@ -163,6 +182,7 @@ uint32_t Pass::getBinding(const ccstd::string &name) const {
 }
 
 void Pass::setUniform(uint32_t handle, const MaterialProperty &value) {
+    ensureOwnResources();
     const uint32_t  binding = Pass::getBindingFromHandle(handle);
     const gfx::Type type    = Pass::getTypeFromHandle(handle);
     const uint32_t  ofs     = Pass::getOffsetFromHandle(handle);
@@ -188,6 +208,7 @@ MaterialProperty &Pass::getUniform(uint32_t handle, MaterialProperty &out) const
 }
 
 void Pass::setUniformArray(uint32_t handle, const MaterialPropertyList &value) {
+    ensureOwnResources();
     const uint32_t  binding = Pass::getBindingFromHandle(handle);
     const gfx::Type type    = Pass::getTypeFromHandle(handle);
     const uint32_t  stride  = gfx::getTypeSize(type) >> 2;
@@ -206,10 +227,12 @@ void Pass::setUniformArray(uint32_t handle, const MaterialPropertyList &value) {
 }
 
 void Pass::bindTexture(uint32_t binding, gfx::Texture *value, index_t index /* = CC_INVALID_INDEX */) {
+    ensureOwnResources();
     _descriptorSet->bindTexture(binding, value, index != CC_INVALID_INDEX ? index : 0);
 }
 
 void Pass::bindSampler(uint32_t binding, gfx::Sampler *value, index_t index /* = CC_INVALID_INDEX */) {
+    ensureOwnResources();
     _descriptorSet->bindSampler(binding, value, index != CC_INVALID_INDEX ? index : 0);
 }
 
@@ -241,6 +264,10 @@ void Pass::update() {
 }
 
 pipeline::InstancedBuffer *Pass::getInstancedBuffer(int32_t extraKey) {
+    Pass *batchingPass = getBatchingPass();
+    if (batchingPass != this) {
+        return batchingPass->getInstancedBuffer(extraKey);
+    }
     auto iter = _instancedBuffers.find(extraKey);
     if (iter != _instancedBuffers.end()) {
         return iter->second.get();
@@ -251,6 +278,10 @@ pipeline::InstancedBuffer *Pass::getInstancedBuffer(int32_t extraKey) {
 }
 
 pipeline::BatchedBuffer *Pass::getBatchedBuffer(int32_t extraKey) {
+    Pass *batchingPass = getBatchingPass();
+    if (batchingPass != this) {
+        return batchingPass->getBatchedBuffer(extraKey);
+    }
     auto iter = _batchedBuffers.find(extraKey);
     if (iter != _batchedBuffers.end()) {
         return iter->second.get();
@@ -261,15 +292,9 @@ pipeline::BatchedBuffer *Pass::getBatchedBuffer(int32_t extraKey) {
 }
 
 void Pass::destroy() {
-    for (const auto &u : _shaderInfo->blocks) {
-        _buffers[u.binding]->destroy();
-    }
-
-    _buffers.clear();
-
-    if (_rootBuffer) {
-        _rootBuffer->destroy();
-        _rootBuffer = nullptr;
+    // the instances sharing the resources take their own copies before they are destroyed
+    while (!_sharingPasses.empty()) {
+        _sharingPasses.back()->detach();
     }
 
     for (auto &ib : _instancedBuffers) {
@@ -282,6 +307,23 @@ void Pass::destroy() {
     }
     _batchedBuffers.clear();
 
+    // the shared resources are destroyed by their owner
+    if (_sharedParent) {
+        stopSharingResources();
+        return;
+    }
+
+    for (const auto &u : _shaderInfo->blocks) {
+        _buffers[u.binding]->destroy();
+    }
+
+    _buffers.clear();
+
+    if (_rootBuffer) {
+        _rootBuffer->destroy();
+        _rootBuffer = nullptr;
+    }
+
     _descriptorSet->destroy();
 }
 
@@ -290,6 +332,7 @@ void Pass::resetUniform(const ccstd::string &name) {
     if (0 == handle) {
         return;
     }
+    ensureOwnResources();
     const gfx::Type type    = Pass::getTypeFromHandle(handle);
     const uint32_t  binding = Pass::getBindingFromHandle(handle);
     const uint32_t  ofs     = Pass::getOffsetFromHandle(handle);
@@ -320,6 +363,7 @@ void Pass::resetTexture(const ccstd::string &name, index_t index /* = CC_INVALID
     if (0 == handle) {
         return;
     }
+    ensureOwnResources();
     const gfx::Type type    = Pass::getTypeFromHandle(handle);
     const uint32_t  binding = Pass::getBindingFromHandle(handle);
     ccstd::string   texName;
@@ -358,6 +402,7 @@ void Pass::resetTexture(const ccstd::string &name, index_t index /* = CC_INVALID
 }
 
 void Pass::resetUBOs() {
+    ensureOwnResources();
     for (auto &u : _shaderInfo->blocks) {
         uint32_t ofs = 0;
         for (auto &cur : u.members) {
@@ -376,6 +421,7 @@ void Pass::resetUBOs() {
 }
 
 void Pass::resetTextures() {
+    ensureOwnResources();
     for (auto &u : _shaderInfo->samplerTextures) {
         for (int32_t j = 0; j < u.count; j++) {
             resetTexture(u.name, j);
@@ -389,9 +435,19 @@ bool Pass::tryCompile() {
     }
 
     syncBatchingScheme();
-    auto *shader = ProgramLib::getInstance()->getGFXShader(_device, _programName, _defines, _root->getPipeline());
+    auto *programLib = ProgramLib::getInstance();
+    auto *shader     = programLib->getGFXShader(_device, _programName, _defines, _root->getPipeline(), nullptr, &_shaderPending);
+    _shaderVersion   = programLib->getCompiledVersion();
+    programLib->initDefineSet(_programName, _defines, _defineSet);
+    if (shader && !_shaderPending) {
+        programLib->addVariant(_defineSet.getHash(), shader);
+    }
     if (!shader) {
-        CC_LOG_WARNING("create shader %s failed", _programName.c_str());
+        if (_shaderPending) {
+            _shader = nullptr; // skipped until compiled
+        } else {
+            CC_LOG_WARNING("create shader %s failed", _programName.c_str());
+        }
         return false;
     }
     _shader         = shader;
@@ -404,13 +460,22 @@ gfx::Shader *Pass::getShaderVariant() {
     return getShaderVariant({});
 }
 
-gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
-    if (!_shader && !tryCompile()) {
-        CC_LOG_WARNING("pass resources incomplete");
+gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches, bool *pending) {
+    const bool outdated = _shaderPending && _shaderVersion != ProgramLib::getInstance()->getCompiledVersion();
+    if ((!_shader || outdated) && !tryCompile()) {
+        if (!_shaderPending) {
+            CC_LOG_WARNING("pass resources incomplete");
+        }
+        if (pending) {
+            *pending = _shaderPending;
+        }
         return nullptr;
     }
 
     if (patches.empty()) {
+        if (pending) {
+            *pending = _shaderPending;
+        }
         return _shader;
     }
 
@@ -424,12 +489,29 @@ gfx::Shader *Pass::getShaderVariant(const ccstd::vector<IMacroPatch> &patches) {
     }
 #endif
 
+    // variants resolved before are found by hash, without touching _defines
+    auto *         programLib  = ProgramLib::getInstance();
+    const uint64_t variantHash = _defineSet.getPatchedHash(patches);
+    if (auto *shader = programLib->getVariant(variantHash)) {
+        if (pending) {
+            *pending = false;
+        }
+        return shader;
+    }
+
     auto *pipeline = _root->getPipeline();
     for (const auto &patch : patches) {
         _defines[patch.name] = patch.value;
     }
 
-    auto *shader = ProgramLib::getInstance()->getGFXShader(_device, _programName, _defines, pipeline);
+    bool  variantPending = false;
+    auto *shader         = programLib->getGFXShader(_device, _programName, _defines, pipeline, nullptr, &variantPending);
+    if (shader && !variantPending) {
+        programLib->addVariant(variantHash, shader);
+    }
+    if (pending) {
+        *pending = variantPending;
+    }
 
     for (const auto &patch : patches) {
         auto iter = _defines.find(patch.name);
@@ -496,24 +578,46 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         _properties = info.properties.value();
     }
     //
-    gfx::Device *device = _device;
     Pass::fillPipelineInfo(this, info);
     if (info.stateOverrides.has_value()) {
         Pass::fillPipelineInfo(this, IPassInfoFull(info.stateOverrides.value()));
     }
 
+    // pass instances render with the resources of their parent until a property is written
+    if (!_sharedParent) {
+        createResources();
+    }
+
+    // store handles
+    _propertyHandleMap                              = programLib->getTemplateInfo(_programName)->handleMap;
+    auto &                          directHandleMap = _propertyHandleMap;
+    Record<ccstd::string, uint32_t> indirectHandleMap;
+    for (const auto &properties : _properties) {
+        if (!properties.second.handleInfo.has_value()) {
+            continue;
+        }
+
+        const auto &propVal                 = properties.second.handleInfo.value();
+        indirectHandleMap[properties.first] = getHandle(std::get<0>(propVal), std::get<1>(propVal), std::get<2>(propVal));
+    }
+
+    utils::mergeToMap(directHandleMap, indirectHandleMap);
+}
+
+void Pass::createResources() {
+    auto *programLib = ProgramLib::getInstance();
+
     // init descriptor set
     gfx::DescriptorSetInfo dsInfo;
-    dsInfo.layout  = programLib->getDescriptorSetLayout(_device, info.program);
+    dsInfo.layout  = programLib->getDescriptorSetLayout(_device, _programName);
     _descriptorSet = _device->createDescriptorSet(dsInfo);
 
     // calculate total size required
     const auto &                  blocks     = _shaderInfo->blocks;
-    const auto *                  tmplInfo   = programLib->getTemplateInfo(info.program);
+    const auto *                  tmplInfo   = programLib->getTemplateInfo(_programName);
     const ccstd::vector<int32_t> &blockSizes = tmplInfo->blockSizes;
-    const auto &                  handleMap  = tmplInfo->handleMap;
 
-    const auto              alignment = device->getCapabilities().uboOffsetAlignment;
+    const auto              alignment = _device->getCapabilities().uboOffsetAlignment;
     ccstd::vector<uint32_t> startOffsets;
     startOffsets.reserve(blocks.size());
     uint32_t lastSize   = 0;
@@ -533,7 +637,7 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         bufferInfo.memUsage = gfx::MemoryUsageBit::DEVICE;
         // https://bugs.chromium.org/p/chromium/issues/detail?id=988988
         bufferInfo.size = static_cast<int32_t>(std::ceil(static_cast<float>(totalSize) / 16.F)) * 16;
-        _rootBuffer     = device->createBuffer(bufferInfo);
+        _rootBuffer     = _device->createBuffer(bufferInfo);
         _rootBlock      = new ArrayBuffer(totalSize);
     }
 
@@ -549,7 +653,7 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         if (binding >= _buffers.size()) {
             _buffers.resize(binding + 1);
         }
-        auto *bufferView  = device->createBuffer(bufferViewInfo);
+        auto *bufferView  = _device->createBuffer(bufferViewInfo);
         _buffers[binding] = bufferView;
         // non-builtin UBO data pools, note that the effect compiler
         // guarantees these bindings to be consecutive, starting from 0 and non-array-typed
@@ -561,20 +665,42 @@ void Pass::doInit(const IPassInfoFull &info, bool /*copyDefines*/ /* = false */)
         _blocks[binding].offset = bufferViewInfo.offset / 4;
         _descriptorSet->bindBuffer(binding, bufferView);
     }
-    // store handles
-    _propertyHandleMap                              = handleMap;
-    auto &                          directHandleMap = _propertyHandleMap;
-    Record<ccstd::string, uint32_t> indirectHandleMap;
-    for (const auto &properties : _properties) {
-        if (!properties.second.handleInfo.has_value()) {
-            continue;
-        }
+}
 
-        const auto &propVal                 = properties.second.handleInfo.value();
-        indirectHandleMap[properties.first] = getHandle(std::get<0>(propVal), std::get<1>(propVal), std::get<2>(propVal));
+void Pass::shareResources(Pass *parent) {
+    // share with the owner of the resources, so destroying it detaches all the instances
+    while (parent->_sharedParent) {
+        parent = parent->_sharedParent;
     }
+    _sharedParent  = parent;
+    _descriptorSet = parent->_descriptorSet;
+    _rootBuffer    = parent->_rootBuffer;
+    _rootBlock     = parent->_rootBlock;
+    _buffers       = parent->_buffers;
+    _blocks        = parent->_blocks;
+    parent->_sharingPasses.emplace_back(this);
+}
 
-    utils::mergeToMap(directHandleMap, indirectHandleMap);
+void Pass::stopSharingResources() {
+    if (!_sharedParent) {
+        return;
+    }
+    auto &sharing = _sharedParent->_sharingPasses;
+    sharing.erase(std::remove(sharing.begin(), sharing.end(), this), sharing.end());
+    _sharedParent  = nullptr;
+    _descriptorSet = nullptr;
+    _rootBuffer    = nullptr;
+    _rootBlock     = nullptr;
+    _buffers.clear();
+    _blocks.clear();
+}
+
+Pass *Pass::getBatchingPass() {
+    // the instance is drawn with the descriptor set and the pipeline states of the buffer owner
+    if (_sharedParent && _sharedParent->_hash == _hash) {
+        return _sharedParent;
+    }
+    return this;
 }
 
 void Pass::syncBatchingScheme() {
@@ -611,6 +737,7 @@ void Pass::initPassFromTarget(Pass *target, const gfx::DepthStencilState &dss, c
     _propertyIndex     = target->_propertyIndex;
     _programName       = target->getProgram();
     _defines           = target->_defines;
+    _defineSet         = target->_defineSet;
     _shaderInfo        = target->_shaderInfo; // cjh how to release?
     _properties        = target->_properties;
 
@@ -33,6 +33,7 @@
 #include "core/ArrayBuffer.h"
 #include "core/TypedArray.h"
 #include "core/assets/EffectAsset.h"
+#include "renderer/core/DefineSet.h"
 #include "renderer/core/PassUtils.h"
 #include "renderer/gfx-base/GFXBuffer.h"
 #include "renderer/gfx-base/GFXDef-common.h"
@@ -254,9 +255,10 @@ public:
      * @en Gets the shader variant of the current pass and given macro patches
      * @zh 结合指定的编译宏组合获取当前 Pass 的 Shader Variant
      * @param patches The macro patches
+     * @param pending Set to true if the variant is still waiting to be compiled, see ProgramLib::setAsyncCompileEnabled
      */
     gfx::Shader *getShaderVariant();
-    gfx::Shader *getShaderVariant(const ccstd::vector<IMacroPatch> &patches);
+    gfx::Shader *getShaderVariant(const ccstd::vector<IMacroPatch> &patches, bool *pending = nullptr);
 
     IPassInfoFull getPassInfoFull() const;
 
@@ -296,6 +298,30 @@ public:
     inline double                        getHashForJS() const { return static_cast<double>(getHash()); }
     inline gfx::PipelineLayout *         getPipelineLayout() const { return _pipelineLayout; }
 
+    /**
+     * @en Whether the pass renders with the uniform buffers and descriptor set of another pass.
+     * Pass instances share the resources of their parent until one of their properties is written.
+     * @zh 当前 Pass 是否使用其它 Pass 的 uniform 缓冲与描述符集渲染。Pass 实例在写入属性之前共享其父 Pass 的资源。
+     */
+    inline bool isSharingResources() const { return _sharedParent != nullptr; }
+
+    /**
+     * @en Take own copies of the shared resources before they are written from outside of the pass, e.g. through the blocks in JS.
+     * @zh 在从 Pass 外部（例如 JS 中的 blocks）写入共享资源之前，创建自己的资源副本。
+     */
+    inline void ensureOwnResources() {
+        if (_sharedParent) {
+            detach();
+        }
+    }
+
+    /**
+     * @en The pass whose instanced and batched buffers this pass is merged into.
+     * A pass instance which still shares the resources, states and defines of its parent is drawn together with it.
+     * @zh 当前 Pass 合批时所使用的实例化与合批缓冲所属的 Pass。仍与父 Pass 共享资源、状态与宏定义的 Pass 实例会与父 Pass 一起绘制。
+     */
+    Pass *getBatchingPass();
+
     // Only for UI
     void initPassFromTarget(Pass *target, const gfx::DepthStencilState &dss, const gfx::BlendState &bs, uint64_t hashFactor);
 
@@ -311,6 +337,14 @@ protected:
     void         doInit(const IPassInfoFull &info, bool copyDefines = false);
     virtual void syncBatchingScheme();
 
+    // allocate the descriptor set and uniform buffers of the program
+    void createResources();
+    // render with the resources of the parent until detach is called
+    void shareResources(Pass *parent);
+    void stopSharingResources();
+    // copy the shared resources, called before the first write of a property
+    virtual void detach() { stopSharingResources(); }
+
     // internal resources
     IntrusivePtr<gfx::Buffer>                _rootBuffer;
     ccstd::vector<IntrusivePtr<gfx::Buffer>> _buffers;
@@ -327,6 +361,7 @@ protected:
 
     IProgramInfo *                                           _shaderInfo; // weakref to template of ProgramLib
     MacroRecord                                              _defines;
+    DefineSet                                                _defineSet; // _defines as of the last compile
     Record<ccstd::string, IPropertyInfo>                     _properties;
     IntrusivePtr<gfx::Shader>                                _shader;
     gfx::BlendState                                          _blendState{};
@@ -341,8 +376,13 @@ protected:
     gfx::DynamicStateFlagBit                                 _dynamicStates{gfx::DynamicStateFlagBit::NONE};
     Record<int32_t, IntrusivePtr<pipeline::InstancedBuffer>> _instancedBuffers;
     Record<int32_t, IntrusivePtr<pipeline::BatchedBuffer>>   _batchedBuffers;
+    Pass *                                                   _sharedParent{nullptr}; // weak, the pass owning the shared resources
+    ccstd::vector<Pass *>                                    _sharingPasses;         // weak, the passes sharing the resources of this pass
 
     uint64_t _hash{0};
+    // the shader is a fallback until ProgramLib compiled version changes
+    bool     _shaderPending{false};
+    uint32_t _shaderVersion{0};
     // external references
     Root *       _root{nullptr};
     gfx::Device *_device{nullptr};
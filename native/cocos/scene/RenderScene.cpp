@@ -30,7 +30,10 @@
 #include "3d/models/BakedSkinningModel.h"
 #include "3d/models/SkinningModel.h"
 #include "base/Log.h"
+#include "base/job-system/JobSystem.h"
 #include "core/Root.h"
+#include "core/geometry/AABB.h"
+#include "core/geometry/Intersect.h"
 #include "core/scene-graph/Node.h"
 #include "profiler/Profiler.h"
 #include "renderer/pipeline/PipelineSceneData.h"
@@ -38,6 +41,7 @@
 #include "scene/Camera.h"
 #include "scene/DirectionalLight.h"
 #include "scene/DrawBatch2D.h"
+#include "scene/LODGroup.h"
 #include "scene/Model.h"
 #include "scene/Octree.h"
 #include "scene/SphereLight.h"
@@ -45,6 +49,12 @@
 
 namespace cc {
 namespace scene {
+
+namespace {
+constexpr uint32_t PARALLEL_UPDATE_MIN_CHUNK_SIZE   = 128; // models per job, smaller chunks cost more to dispatch than they save
+constexpr uint32_t PARALLEL_SKINNING_MIN_CHUNK_SIZE = 4;   // skinning models per job, each one computes all its joints
+} // namespace
+
 RenderScene::RenderScene() = default;
 
 RenderScene::~RenderScene() = default;
@@ -66,6 +76,10 @@ void RenderScene::setMainLight(DirectionalLight *dl) {
 void RenderScene::update(uint32_t stamp) {
     CC_PROFILE(RenderSceneUpdate);
 
+    if (_transformStore) {
+        _transformStore->update();
+    }
+
     if (_mainLight) {
         _mainLight->update();
     }
@@ -75,23 +89,178 @@ void RenderScene::update(uint32_t stamp) {
     for (const auto &spotLight : _spotLights) {
         spotLight->update();
     }
+    _lightGrid.update();
+    if (_parallelUpdateEnabled && JobSystem::getInstance()->threadCount() > 1) {
+        updateModelsParallel(stamp);
+    } else {
+        updateModels(stamp);
+    }
+
+    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
+    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
+    CC_PROFILE_OBJECT_UPDATE(PunctualLights, _lightGrid.getLightCount());
+    CC_PROFILE_OBJECT_UPDATE(LightGridCells, _lightGrid.getCellCount());
+    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+}
+
+void RenderScene::updateModels(uint32_t stamp) {
+    _transformedModels.clear();
     for (const auto &model : _models) {
-        if (model->isEnabled()) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (!model->isParallelUpdateSupported()) {
             model->updateTransform(stamp);
+        } else if (model->resolveTransform()) {
+            _transformedModels.emplace_back(model.get());
+        }
+    }
+
+    transformModelBounds();
+    updateSkinningJoints(false);
+
+    for (const auto &model : _models) {
+        if (model->isEnabled()) {
             model->updateUBOs(stamp);
         }
     }
+}
 
-    CC_PROFILE_OBJECT_UPDATE(Models, _models.size());
-    CC_PROFILE_OBJECT_UPDATE(Cameras, _cameras.size());
-    CC_PROFILE_OBJECT_UPDATE(DrawBatch2D, _batches.size());
+void RenderScene::updateModelsParallel(uint32_t stamp) {
+    CC_PROFILE(RenderSceneUpdateModelsParallel);
+
+    // Node hierarchy, JS callbacks and skinning joints are not thread safe, so resolve them here first.
+    _parallelUpdateItems.clear();
+    _transformedModels.clear();
+    _serialUpdateModels.clear();
+    for (const auto &model : _models) {
+        if (!model->isEnabled()) {
+            continue;
+        }
+        if (!model->isParallelUpdateSupported()) {
+            model->updateTransform(stamp);
+            _serialUpdateModels.emplace_back(model.get());
+            continue;
+        }
+        const bool transformChanged = model->resolveTransform();
+        if (transformChanged) {
+            _transformedModels.emplace_back(model.get());
+        }
+        _parallelUpdateItems.push_back({model.get(), transformChanged, false});
+    }
+
+    // the bounds land in the shared bounds array, they are transformed in batch before filling the local data
+    transformModelBounds();
+
+    // joint matrices of the skinning models are computed across the job threads, their uploads stay on this thread
+    updateSkinningJoints(true);
+    for (Model *model : _serialUpdateModels) {
+        model->updateUBOs(stamp);
+    }
+
+    const auto itemCount  = static_cast<uint32_t>(_parallelUpdateItems.size());
+    const auto chunkCount = std::max(1U, std::min(JobSystem::getInstance()->threadCount(), itemCount / PARALLEL_UPDATE_MIN_CHUNK_SIZE));
+    const auto chunkSize  = (itemCount + chunkCount - 1) / chunkCount;
+
+    if (chunkCount > 1) {
+        auto job = [this, itemCount, chunkSize](uint32_t chunk) {
+            updateModelChunk(chunk * chunkSize, std::min(itemCount, (chunk + 1) * chunkSize));
+        };
+        JobGraph g(JobSystem::getInstance());
+        g.createForEachIndexJob(1U, chunkCount, 1U, job);
+        g.run();
+        job(0);
+        g.waitForAll();
+    } else {
+        updateModelChunk(0, itemCount);
+    }
+
+    // sync point: uploads touch shared state and must be done before culling
+    for (const auto &item : _parallelUpdateItems) {
+        item.model->commitUBOs(stamp, item.uploadLocal);
+    }
+}
+
+void RenderScene::updateModelChunk(uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+        auto &item = _parallelUpdateItems[i];
+        // world bounds were already transformed by transformModelBounds
+        item.uploadLocal = item.model->updateLocalData(false);
+    }
+}
+
+void RenderScene::updateSkinningJoints(bool parallel) {
+    _pendingSkinningModels.clear();
+    for (const auto &model : _models) {
+        if (model->isEnabled() && model->getType() == Model::Type::SKINNING) {
+            auto *skinningModel = static_cast<SkinningModel *>(model.get());
+            if (skinningModel->hasPendingJointPalette()) {
+                _pendingSkinningModels.emplace_back(skinningModel);
+            }
+        }
+    }
+
+    // serial updates compute the joints in updateUBOs
+    const auto modelCount = static_cast<uint32_t>(_pendingSkinningModels.size());
+    const auto chunkCount = parallel ? std::min(JobSystem::getInstance()->threadCount(), modelCount / PARALLEL_SKINNING_MIN_CHUNK_SIZE) : 0U;
+    if (chunkCount <= 1) {
+        return;
+    }
+
+    CC_PROFILE(RenderSceneUpdateSkinningJoints);
+    const auto chunkSize = (modelCount + chunkCount - 1) / chunkCount;
+    auto       job       = [this, modelCount, chunkSize](uint32_t chunk) {
+        for (uint32_t i = chunk * chunkSize; i < std::min(modelCount, (chunk + 1) * chunkSize); ++i) {
+            _pendingSkinningModels[i]->updateJointPalette();
+        }
+    };
+    JobGraph g(JobSystem::getInstance());
+    g.createForEachIndexJob(1U, chunkCount, 1U, job);
+    g.run();
+    job(0);
+    g.waitForAll();
+}
+
+void RenderScene::transformModelBounds() {
+    CC_PROFILE(RenderSceneTransformModelBounds);
+    auto &staging = _boundsTransformStaging;
+    staging.indices.clear();
+    staging.localBounds.clear();
+    staging.matrices.clear();
+    staging.worldBounds.clear();
+
+    bool staticCasterMoved = false;
+    for (Model *model : _transformedModels) {
+        const geometry::AABB *localBounds = model->getModelBounds();
+        geometry::AABB *      worldBounds = model->getWorldBounds();
+        const int32_t         index       = model->getSceneBoundsIndex();
+        if (localBounds == nullptr || !localBounds->isValid() || worldBounds == nullptr || index < 0) {
+            continue;
+        }
+        staging.indices.emplace_back(static_cast<uint32_t>(index));
+        staging.localBounds.emplace_back(localBounds);
+        staging.matrices.emplace_back(&model->getTransform()->getWorldMatrix());
+        staging.worldBounds.emplace_back(worldBounds);
+        staticCasterMoved |= model->isStaticShadowCaster() && model->isCastShadow();
+    }
+
+    _modelBounds.transform(staging.indices.data(), staging.localBounds.data(), staging.matrices.data(), staging.worldBounds.data(),
+                           static_cast<uint32_t>(staging.indices.size()));
+    if (staticCasterMoved) {
+        markStaticShadowCastersDirty();
+    }
+    for (Model *model : _transformedModels) {
+        updateOctree(model);
+    }
 }
 
 void RenderScene::destroy() {
     removeCameras();
     removeSphereLights();
     removeSpotLights();
+    removeLODGroups();
     removeModels();
+    _modelHandles.flush();
 }
 
 void RenderScene::addCamera(Camera *camera) {
@@ -144,11 +313,13 @@ void RenderScene::removeDirectionalLight(DirectionalLight *dl) {
 
 void RenderScene::addSphereLight(SphereLight *light) {
     _sphereLights.emplace_back(light);
+    _lightGrid.add(light);
 }
 
 void RenderScene::removeSphereLight(SphereLight *sphereLight) {
     auto iter = std::find(_sphereLights.begin(), _sphereLights.end(), sphereLight);
     if (iter != _sphereLights.end()) {
+        _lightGrid.remove(sphereLight);
         _sphereLights.erase(iter);
     } else {
         CC_LOG_WARNING("Try to remove invalid sphere light.");
@@ -157,11 +328,13 @@ void RenderScene::removeSphereLight(SphereLight *sphereLight) {
 
 void RenderScene::addSpotLight(SpotLight *spotLight) {
     _spotLights.emplace_back(spotLight);
+    _lightGrid.add(spotLight);
 }
 
 void RenderScene::removeSpotLight(SpotLight *spotLight) {
     auto iter = std::find(_spotLights.begin(), _spotLights.end(), spotLight);
     if (iter != _spotLights.end()) {
+        _lightGrid.remove(spotLight);
         _spotLights.erase(iter);
     } else {
         CC_LOG_WARNING("Try to remove invalid spot light.");
@@ -170,6 +343,7 @@ void RenderScene::removeSpotLight(SpotLight *spotLight) {
 
 void RenderScene::removeSphereLights() {
     for (const auto &sphereLight : _sphereLights) {
+        _lightGrid.remove(sphereLight);
         sphereLight->detachFromScene();
     }
     _sphereLights.clear();
@@ -177,6 +351,7 @@ void RenderScene::removeSphereLights() {
 
 void RenderScene::removeSpotLights() {
     for (const auto &spotLight : _spotLights) {
+        _lightGrid.remove(spotLight);
         spotLight->detachFromScene();
     }
     _spotLights.clear();
@@ -184,10 +359,15 @@ void RenderScene::removeSpotLights() {
 
 void RenderScene::addModel(Model *model) {
     model->attachToScene(this);
+    model->setSceneBoundsIndex(static_cast<int32_t>(_modelBounds.add(model->getWorldBounds())));
     _models.emplace_back(model);
+    model->setSceneHandle(_modelHandles.add(model));
     if (_octree && _octree->isEnabled()) {
         _octree->insert(model);
     }
+    if (model->isStaticShadowCaster()) {
+        markStaticShadowCastersDirty();
+    }
 }
 
 void RenderScene::removeModel(index_t idx) {
@@ -195,6 +375,12 @@ void RenderScene::removeModel(index_t idx) {
         CC_LOG_WARNING("Try to remove invalid model.");
         return;
     }
+    if (_models[idx]->isStaticShadowCaster()) {
+        markStaticShadowCastersDirty();
+    }
+    eraseModelBounds(idx);
+    _modelHandles.remove(_models[idx]->getSceneHandle());
+    _models[idx]->setSceneHandle({});
     _models.erase(_models.begin() + idx);
 }
 
@@ -204,7 +390,13 @@ void RenderScene::removeModel(Model *model) {
         if (_octree && _octree->isEnabled()) {
             _octree->remove(*iter);
         }
+        if (model->isStaticShadowCaster()) {
+            markStaticShadowCastersDirty();
+        }
+        eraseModelBounds(static_cast<index_t>(iter - _models.begin()));
         model->detachFromScene();
+        _modelHandles.remove(model->getSceneHandle());
+        model->setSceneHandle({});
         _models.erase(iter);
     } else {
         CC_LOG_WARNING("Try to remove invalid model.");
@@ -217,10 +409,115 @@ void RenderScene::removeModels() {
             _octree->remove(model);
         }
         model->detachFromScene();
+        _modelHandles.remove(model->getSceneHandle());
+        model->setSceneHandle({});
         CC_SAFE_DESTROY(model);
     }
     _models.clear();
+    _modelBounds.clear();
+    markStaticShadowCastersDirty();
+}
+void RenderScene::flushRemovedModels() {
+    _modelHandles.flush();
+}
+
+void RenderScene::updateModelBVH() {
+    const bool rebuild = !_modelBVHBuilt || _modelBVHLayoutVersion != _modelBounds.getLayoutVersion();
+    if (!rebuild && _modelBVHVersion == _modelBounds.getVersion()) {
+        return;
+    }
+
+    CC_PROFILE(RenderSceneUpdateModelBVH);
+    const auto count = static_cast<uint32_t>(_models.size());
+    _modelBVHMins.resize(count);
+    _modelBVHMaxs.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto *bounds = _models[i]->getWorldBounds();
+        if (bounds) {
+            bounds->getBoundary(&_modelBVHMins[i], &_modelBVHMaxs[i]);
+        } else {
+            // inverted bounds are never hit
+            _modelBVHMins[i].set(FLT_MAX, FLT_MAX, FLT_MAX);
+            _modelBVHMaxs[i].set(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        }
+    }
+
+    if (rebuild) {
+        _modelBVH.build(_modelBVHMins.data(), _modelBVHMaxs.data(), count);
+    } else {
+        _modelBVH.refit(_modelBVHMins.data(), _modelBVHMaxs.data());
+    }
+    _modelBVHBuilt         = true;
+    _modelBVHVersion       = _modelBounds.getVersion();
+    _modelBVHLayoutVersion = _modelBounds.getLayoutVersion();
+}
+
+bool RenderScene::raycast(const geometry::Ray &ray, IRaycastResult *result, float maxDistance, uint32_t mask, bool meshPrecision) {
+    raycastBatch(&ray, 1, result, maxDistance, mask, meshPrecision);
+    return result->model != nullptr;
+}
+
+void RenderScene::raycastBatch(const geometry::Ray *rays, uint32_t count, IRaycastResult *results, float maxDistance, uint32_t mask, bool meshPrecision) {
+    CC_PROFILE(RenderSceneRaycastBatch);
+    updateModelBVH();
+
+    geometry::IRayModelOptions options;
+    options.mode        = geometry::ERaycastMode::CLOSEST;
+    options.doubleSided = false;
+    for (uint32_t r = 0; r < count; ++r) {
+        const geometry::Ray &ray     = rays[r];
+        IRaycastResult &     result  = results[r];
+        Model *              closest = nullptr;
+        result                       = {};
+
+        const float distance = _modelBVH.raycast(ray, maxDistance, geometry::ERaycastMode::CLOSEST, [&](uint32_t index, float searchDistance) {
+            Model *model = _models[index];
+            Node * node  = model->getNode();
+            if (!model->isEnabled() || !model->getWorldBounds() || (node && !(node->getLayer() & mask))) {
+                return 0.F;
+            }
+
+            float dist = 0.F;
+            if (meshPrecision) {
+                options.distance = searchDistance;
+                dist             = geometry::rayModel(ray, *model, &options);
+            } else {
+                dist = geometry::rayAABB(ray, *model->getWorldBounds());
+            }
+            if (dist != 0.F && dist <= searchDistance) {
+                closest = model;
+            }
+            return dist;
+        });
+
+        if (closest) {
+            result.node     = closest->getNode();
+            result.model    = closest;
+            result.distance = distance;
+        }
+    }
 }
+
+void RenderScene::addLODGroup(LODGroup *group) {
+    _lodGroups.emplace_back(group);
+    markModelsDirty();
+}
+
+void RenderScene::removeLODGroup(LODGroup *group) {
+    auto iter = std::find(_lodGroups.begin(), _lodGroups.end(), group);
+    if (iter != _lodGroups.end()) {
+        _lodGroups.erase(iter);
+        markModelsDirty();
+    } else {
+        CC_LOG_WARNING("Try to remove invalid LODGroup.");
+    }
+}
+
+void RenderScene::removeLODGroups() {
+    _lodGroups.clear();
+    markModelsDirty();
+}
+
 void RenderScene::addBatch(DrawBatch2D *drawBatch2D) {
     _batches.emplace_back(drawBatch2D);
 }
@@ -238,6 +535,15 @@ void RenderScene::removeBatches() {
     _batches.clear();
 }
 
+void RenderScene::eraseModelBounds(index_t idx) {
+    _models[idx]->setSceneBoundsIndex(-1);
+    _modelBounds.erase(static_cast<uint32_t>(idx));
+    // slots of the following models shift down by one
+    for (auto i = static_cast<size_t>(idx) + 1; i < _models.size(); ++i) {
+        _models[i]->setSceneBoundsIndex(static_cast<int32_t>(i - 1));
+    }
+}
+
 void RenderScene::updateOctree(Model *model) {
     if (_octree && _octree->isEnabled()) {
         _octree->update(model);
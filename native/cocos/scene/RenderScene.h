@@ -25,16 +25,21 @@
 
 #pragma once
 
+#include "base/HandleTable.h"
 #include "base/Macros.h"
 #include "base/Ptr.h"
 #include "base/RefCounted.h"
 #include "base/TypeDef.h"
 #include "base/std/container/string.h"
 #include "base/std/container/vector.h"
+#include "core/geometry/BVH.h"
+#include "scene/LightGrid.h"
+#include "scene/ModelBoundsArray.h"
 
 namespace cc {
 
 class Node;
+class TransformStore;
 class SkinningModel;
 class BakedSkinningModel;
 
@@ -42,6 +47,7 @@ namespace scene {
 
 class Model;
 class Camera;
+class LODGroup;
 class Octree;
 struct DrawBatch2D;
 class DirectionalLight;
@@ -49,8 +55,9 @@ class SphereLight;
 class SpotLight;
 
 struct IRaycastResult {
-    Node *node{nullptr};
-    float distance{0.F};
+    Node * node{nullptr};
+    Model *model{nullptr};
+    float  distance{0.F};
 };
 
 struct IRenderSceneInfo {
@@ -89,12 +96,79 @@ public:
     void removeModel(Model *model);
     void removeModels();
 
+    /**
+     * @en The model of a handle from Model::getSceneHandle, nullptr once the model is removed from the scene.
+     * Hot loops and caches can keep handles instead of model references.
+     * @zh Model::getSceneHandle 返回的句柄所对应的模型，模型从场景中移除后返回 nullptr。
+     * 热点循环和缓存可以持有句柄而不是模型的引用。
+     */
+    inline Model *getModel(GenerationalHandle<Model> handle) const { return _modelHandles.get(handle); }
+
+    /**
+     * @en Releases the models removed since the last call in one batch, called by Root at the end of each frame.
+     * @zh 一次性释放自上次调用以来被移除的模型，由 Root 在每帧结束时调用。
+     */
+    void flushRemovedModels();
+
+    /**
+     * @en Closest model hit by the ray, the models are searched through a BVH over their world bounds,
+     * which is refitted or rebuilt on demand when models move, are added or removed.
+     * Models are tested by their world bounds, or by their triangles if meshPrecision is true.
+     * Only models whose node layer is in mask are tested. Must be called from the main thread.
+     * @zh 查找射线击中的最近模型，通过模型世界包围盒的 BVH 搜索，模型移动或增删后会按需重新拟合或重建该 BVH。
+     * meshPrecision 为 true 时测试模型的三角形，否则测试世界包围盒。只测试节点层级在 mask 中的模型。必须在主线程调用。
+     */
+    bool raycast(const geometry::Ray &ray, IRaycastResult *result, float maxDistance = FLT_MAX, uint32_t mask = 0xFFFFFFFF, bool meshPrecision = false);
+    // results[i] receives the closest hit of rays[i], its model is nullptr on miss
+    void raycastBatch(const geometry::Ray *rays, uint32_t count, IRaycastResult *results, float maxDistance = FLT_MAX,
+                      uint32_t mask = 0xFFFFFFFF, bool meshPrecision = false);
+
+    void addLODGroup(LODGroup *group);
+    void removeLODGroup(LODGroup *group);
+    void removeLODGroups();
+
+    /**
+     * @en Global scale of the screen usage of all LOD groups, values below 1 pick coarser levels earlier to save performance.
+     * @zh 所有 LOD 组屏幕占比的全局缩放，小于 1 时会更早切换到较粗糙的层级以节省性能。
+     */
+    inline float getLODBias() const { return _lodBias; }
+    inline void  setLODBias(float bias) {
+        _lodBias = bias;
+        markModelsDirty();
+    }
+
     void addBatch(DrawBatch2D *);
     void removeBatch(DrawBatch2D *);
     void removeBatches();
 
     void onGlobalPipelineStateChanged();
 
+    // Transform store of the owner scene, resolved at the beginning of each update.
+    inline void setTransformStore(TransformStore *store) { _transformStore = store; }
+
+    /**
+     * @en Update models in chunks across the job system, falls back to serial update with a single job thread.
+     * @zh 使用 JobSystem 分块并行更新模型，只有一个工作线程时退化为串行更新。
+     */
+    inline void setParallelUpdateEnabled(bool val) { _parallelUpdateEnabled = val; }
+    inline bool isParallelUpdateEnabled() const { return _parallelUpdateEnabled; }
+
+    /**
+     * @en Version of the static shadow casters, increased whenever a static caster is added, removed or moved.
+     * @zh 静态阴影投射者的版本号，静态投射者增删或移动时递增。
+     */
+    inline uint32_t getStaticShadowCastersVersion() const { return _staticShadowCastersVersion; }
+    inline void     markStaticShadowCastersDirty() { ++_staticShadowCastersVersion; }
+
+    /**
+     * @en Version of the model states read by culling, increased when a model is enabled or disabled, changes its shadow casting
+     * or visibility flags, or when LOD groups change. Adding, removing or moving models is tracked by the version of getModelBounds().
+     * @zh 剔除所依赖的模型状态的版本号，模型启用或禁用、阴影投射或可见性标记变化、以及 LOD 组变化时递增。
+     * 模型的增删和移动由 getModelBounds() 的版本号记录。
+     */
+    inline uint32_t getModelsVersion() const { return _modelsVersion; }
+    inline void     markModelsDirty() { ++_modelsVersion; }
+
     inline DirectionalLight *getMainLight() const { return _mainLight.get(); }
     void                     setMainLight(DirectionalLight *dl);
 
@@ -103,24 +177,74 @@ public:
     inline const ccstd::vector<IntrusivePtr<Camera>> &     getCameras() const { return _cameras; }
     inline const ccstd::vector<IntrusivePtr<SphereLight>> &getSphereLights() const { return _sphereLights; }
     inline const ccstd::vector<IntrusivePtr<SpotLight>> &  getSpotLights() const { return _spotLights; }
+    // Grid of the world bounds of all sphere and spot lights, refreshed in update after the lights are updated.
+    inline const LightGrid &getLightGrid() const { return _lightGrid; }
+    inline LightGrid &      getLightGrid() { return _lightGrid; }
     inline const ccstd::vector<IntrusivePtr<Model>> &      getModels() const { return _models; }
+    inline const ccstd::vector<IntrusivePtr<LODGroup>> &   getLODGroups() const { return _lodGroups; }
     inline Octree *                                        getOctree() const { return _octree; }
     void                                                   updateOctree(Model *model);
+    // World bounds of all models in the order of getModels(), used by batched culling.
+    inline const ModelBoundsArray &getModelBounds() const { return _modelBounds; }
+    inline ModelBoundsArray &      getModelBounds() { return _modelBounds; }
     // FIXME: remove getDrawBatch2Ds
     inline const ccstd::vector<DrawBatch2D *> &getBatches() const { return _batches; }
     inline const ccstd::vector<DrawBatch2D *> &getDrawBatch2Ds() const { return _batches; }
 
 private:
+    struct ParallelUpdateItem {
+        Model *model{nullptr};
+        bool   transformChanged{false};
+        bool   uploadLocal{false};
+    };
+
+    // Moved models whose world bounds are transformed in batch, see ModelBoundsArray::transform.
+    struct BoundsTransformStaging {
+        ccstd::vector<uint32_t>               indices;
+        ccstd::vector<const geometry::AABB *> localBounds;
+        ccstd::vector<const Mat4 *>           matrices;
+        ccstd::vector<geometry::AABB *>       worldBounds;
+    };
+
+    void updateModels(uint32_t stamp);
+    void updateModelsParallel(uint32_t stamp);
+    void updateModelChunk(uint32_t begin, uint32_t end);
+    void updateSkinningJoints(bool parallel);
+    void transformModelBounds();
+    void eraseModelBounds(index_t idx);
+    void updateModelBVH();
+
     ccstd::string                                 _name;
     uint64_t                                      _modelId{0};
     IntrusivePtr<DirectionalLight>                _mainLight;
     ccstd::vector<IntrusivePtr<Model>>            _models;
+    // keeps removed models alive until the end of the frame
+    HandleTable<Model>                            _modelHandles;
     ccstd::vector<IntrusivePtr<Camera>>           _cameras;
     ccstd::vector<IntrusivePtr<DirectionalLight>> _directionalLights;
     ccstd::vector<IntrusivePtr<SphereLight>>      _sphereLights;
     ccstd::vector<IntrusivePtr<SpotLight>>        _spotLights;
+    LightGrid                                     _lightGrid;
     ccstd::vector<DrawBatch2D *>                  _batches;
+    ccstd::vector<IntrusivePtr<LODGroup>>         _lodGroups;
+    float                                         _lodBias{1.F};
     Octree *                                      _octree{nullptr};
+    ModelBoundsArray                              _modelBounds;
+    TransformStore *                              _transformStore{nullptr};
+    bool                                          _parallelUpdateEnabled{false};
+    uint32_t                                      _staticShadowCastersVersion{0};
+    uint32_t                                      _modelsVersion{0};
+    geometry::BVH                                 _modelBVH;
+    ccstd::vector<Vec3>                           _modelBVHMins;
+    ccstd::vector<Vec3>                           _modelBVHMaxs;
+    uint32_t                                      _modelBVHVersion{0};
+    uint32_t                                      _modelBVHLayoutVersion{0};
+    bool                                          _modelBVHBuilt{false};
+    ccstd::vector<ParallelUpdateItem>             _parallelUpdateItems;
+    ccstd::vector<Model *>                        _transformedModels;
+    ccstd::vector<Model *>                        _serialUpdateModels;
+    ccstd::vector<SkinningModel *>                _pendingSkinningModels;
+    BoundsTransformStaging                        _boundsTransformStaging;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(RenderScene);
 };
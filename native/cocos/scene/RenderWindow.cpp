@@ -62,6 +62,10 @@ bool RenderWindow::initialize(gfx::Device *device, IRenderWindowInfo &info) {
 
     _renderPass = device->createRenderPass(info.renderPassInfo);
 
+    // multiview passes render each view to a layer of the attachments
+    const uint32_t         viewCount   = info.renderPassInfo.viewCount;
+    const gfx::TextureType textureType = viewCount > 1 ? gfx::TextureType::TEX2D_ARRAY : gfx::TextureType::TEX2D;
+
     if (info.swapchain != nullptr) {
         _swapchain = info.swapchain;
         _colorTextures.pushBack(info.swapchain->getColorTexture());
@@ -69,21 +73,25 @@ bool RenderWindow::initialize(gfx::Device *device, IRenderWindowInfo &info) {
     } else {
         for (auto &colorAttachment : info.renderPassInfo.colorAttachments) {
             _colorTextures.pushBack(
-                device->createTexture({gfx::TextureType::TEX2D,
+                device->createTexture({textureType,
                                        gfx::TextureUsageBit::COLOR_ATTACHMENT | gfx::TextureUsageBit::SAMPLED | gfx::TextureUsageBit::TRANSFER_SRC,
                                        colorAttachment.format,
                                        _width,
-                                       _height}));
+                                       _height,
+                                       gfx::TextureFlagBit::NONE,
+                                       viewCount}));
         }
     }
 
     // Use the sign bit to indicate depth attachment
     if (info.renderPassInfo.depthStencilAttachment.format != gfx::Format::UNKNOWN) {
-        _depthStencilTexture = device->createTexture({gfx::TextureType::TEX2D,
+        _depthStencilTexture = device->createTexture({textureType,
                                                       gfx::TextureUsageBit::DEPTH_STENCIL_ATTACHMENT | gfx::TextureUsageBit::SAMPLED,
                                                       info.renderPassInfo.depthStencilAttachment.format,
                                                       _width,
-                                                      _height});
+                                                      _height,
+                                                      gfx::TextureFlagBit::NONE,
+                                                      viewCount});
     }
 
     _frameBuffer = device->createFramebuffer(gfx::FramebufferInfo{
@@ -25,6 +25,7 @@
 
 #include "scene/Shadow.h"
 #include <cmath>
+#include <cstring>
 #include "core/Root.h"
 #include "core/scene-graph/Node.h"
 #include "scene/Pass.h"
@@ -118,6 +119,28 @@ void Shadows::initialize(const ShadowsInfo &shadowsInfo) {
     _shadowMapDirty = false;
 }
 
+// set every frame by the shadow flows, only a moving shadow camera changes the version
+void Shadows::setMatShadowView(const Mat4 &matShadowView) {
+    if (memcmp(_matShadowView.m, matShadowView.m, sizeof(matShadowView.m)) != 0) {
+        _matShadowView = matShadowView;
+        ++_version;
+    }
+}
+
+void Shadows::setMatShadowProj(const Mat4 &matShadowProj) {
+    if (memcmp(_matShadowProj.m, matShadowProj.m, sizeof(matShadowProj.m)) != 0) {
+        _matShadowProj = matShadowProj;
+        ++_version;
+    }
+}
+
+void Shadows::setMatShadowViewProj(const Mat4 &matShadowViewProj) {
+    if (memcmp(_matShadowViewProj.m, matShadowViewProj.m, sizeof(matShadowViewProj.m)) != 0) {
+        _matShadowViewProj = matShadowViewProj;
+        ++_version;
+    }
+}
+
 void Shadows::destroy() {
     if (_material) {
         _material->destroy();
@@ -242,6 +242,12 @@ public:
     gfx::Shader *getPlanarInstanceShader(const ccstd::vector<IMacroPatch> &patches);
     void         activate();
 
+    /**
+     * @en Version of the shadow parameters, increased whenever one of them changes.
+     * @zh 阴影参数的版本号，任一参数变化时递增。
+     */
+    inline uint32_t getVersion() const { return _version; }
+
     /**
      * @en Whether activate shadow.
      * @zh 是否启用阴影？
@@ -249,6 +255,7 @@ public:
     inline bool isEnabled() const { return _enabled; }
     inline void setEnabled(bool val) {
         _enabled = val;
+        ++_version;
         activate();
     }
 
@@ -257,14 +264,20 @@ public:
      * @zh 阴影接收平面的法线。
      */
     inline const Vec3 &getNormal() const { return _normal; }
-    inline void        setNormal(const Vec3 &val) { _normal.set(val); }
+    inline void        setNormal(const Vec3 &val) {
+        _normal.set(val);
+        ++_version;
+    }
 
     /**
      * @en The distance from coordinate origin to the receiving plane.
      * @zh 阴影接收平面与原点的距离。
      */
     inline float getDistance() const { return _distance; }
-    inline void  setDistance(float val) { _distance = val; }
+    inline void  setDistance(float val) {
+        _distance = val;
+        ++_version;
+    }
 
     /**
      * @en Shadow color.
@@ -277,6 +290,7 @@ public:
         _shadowColor4f[1] = static_cast<float>(color.g) / 255.F;
         _shadowColor4f[2] = static_cast<float>(color.b) / 255.F;
         _shadowColor4f[3] = static_cast<float>(color.a) / 255.F;
+        ++_version;
     }
     inline const ccstd::array<float, 4> &getShadowColor4f() const { return _shadowColor4f; }
 
@@ -287,6 +301,7 @@ public:
     inline ShadowType getType() const { return _type; }
     inline void       setType(ShadowType val) {
         _type = _enabled ? val : ShadowType::NONE;
+        ++_version;
         activate();
     }
 
@@ -298,10 +313,12 @@ public:
     inline void        setSize(const Vec2 &val) {
         _size.set(val);
         _shadowMapDirty = true;
+        ++_version;
     }
     inline void setShadowMapSize(float value) {
         _size.set(value, value);
         _shadowMapDirty = true;
+        ++_version;
     }
     inline float getShadowMapSize() const {
         return _size.x;
@@ -328,16 +345,19 @@ public:
     inline uint32_t getMaxReceived() const { return _maxReceived; }
 
     inline float getShadowCameraFar() const { return _shadowCameraFar; }
-    inline void  setShadowCameraFar(float shadowDistance) { _shadowCameraFar = shadowDistance; }
+    inline void  setShadowCameraFar(float shadowDistance) {
+        _shadowCameraFar = shadowDistance;
+        ++_version;
+    }
 
     inline Mat4 getMatShadowView() const { return _matShadowView; }
-    inline void setMatShadowView(const Mat4 &matShadowView) { _matShadowView = matShadowView; }
+    void        setMatShadowView(const Mat4 &matShadowView);
 
     inline Mat4 getMatShadowProj() const { return _matShadowProj; }
-    inline void setMatShadowProj(const Mat4 &matShadowProj) { _matShadowProj = matShadowProj; }
+    void        setMatShadowProj(const Mat4 &matShadowProj);
 
     inline Mat4 getMatShadowViewProj() const { return _matShadowViewProj; }
-    inline void setMatShadowViewProj(const Mat4 &matShadowViewProj) { _matShadowViewProj = matShadowViewProj; }
+    void        setMatShadowViewProj(const Mat4 &matShadowViewProj);
 
 private:
     void updatePlanarInfo();
@@ -374,6 +394,7 @@ private:
     float                  _distance{0.F};
     ShadowType             _type{ShadowType::NONE};
     bool                   _shadowMapDirty{false};
+    uint32_t               _version{0};
 };
 
 } // namespace scene
@@ -25,14 +25,15 @@
 
 #include "scene/Skybox.h"
 #include "3d/assets/Mesh.h"
-#include "3d/misc/CreateMesh.h"
 #include "cocos/bindings/event/CustomEventTypes.h"
 #include "cocos/bindings/event/EventDispatcher.h"
 #include "core/Root.h"
 #include "core/builtin/BuiltinResMgr.h"
 #include "core/scene-graph/SceneGlobals.h"
 #include "pipeline/GlobalDescriptorSetManager.h"
+#include "pipeline/RenderPipeline.h"
 #include "primitive/Primitive.h"
+#include "primitive/PrimitiveMeshCache.h"
 #include "renderer/core/MaterialInstance.h"
 #include "renderer/core/PassUtils.h"
 #include "renderer/gfx-base/GFXDevice.h"
@@ -42,8 +43,12 @@
 #include "scene/Model.h"
 
 namespace {
-cc::Mesh *    skyboxMesh{nullptr}; // TODO(cjh): How to release ?
 cc::Material *skyboxMaterial{nullptr};
+
+cc::pipeline::EnvironmentPrefilter *getEnvironmentPrefilter() {
+    auto *pipeline = cc::pipeline::RenderPipeline::getInstance();
+    return pipeline ? &pipeline->getEnvironmentPrefilter() : nullptr;
+}
 } // namespace
 namespace cc {
 namespace scene {
@@ -162,6 +167,10 @@ void SkyboxInfo::activate(Skybox *resource) {
     }
 }
 
+Skybox::~Skybox() {
+    destroyPrefilterTarget();
+}
+
 TextureCube *Skybox::getEnvmap() const {
     const bool isHDR = Root::getInstance()->getPipeline()->getPipelineSceneData()->isHDR();
     return isHDR ? _envmapHDR : _envmapLDR;
@@ -213,10 +222,58 @@ void Skybox::setEnvMaps(TextureCube *envmapHDR, TextureCube *envmapLDR) {
         Root::getInstance()->getPipeline()->getPipelineSceneData()->getAmbient()->setMipmapCount(envmapLDR->mipmapLevel());
     }
 
+    updatePrefilterTarget();
     updateGlobalBinding();
     updatePipeline();
 }
 
+void Skybox::setRuntimePrefilterEnabled(bool val) {
+    if (_runtimePrefilter == val) {
+        return;
+    }
+    _runtimePrefilter = val;
+    setEnvMaps(_envmapHDR, _envmapLDR);
+}
+
+void Skybox::prefilterEnvmap() {
+    auto *prefilter = getEnvironmentPrefilter();
+    if (_prefilterTarget != nullptr && prefilter != nullptr) {
+        // the maps generated last time stay bound until the new ones complete
+        prefilter->enqueue(_prefilterTarget);
+    }
+}
+
+void Skybox::updatePrefilterTarget() {
+    destroyPrefilterTarget();
+    auto *envmap    = getEnvmap();
+    auto *prefilter = getEnvironmentPrefilter();
+    if (!_runtimePrefilter || envmap == nullptr || envmap->getGFXTexture() == nullptr || prefilter == nullptr || !prefilter->isAvailable()) {
+        return;
+    }
+
+    _prefilterTarget = prefilter->createTarget(envmap->getGFXTexture(), envmap->isRGBE);
+    if (_prefilterTarget != nullptr) {
+        _prefilterTarget->setCompleteCallback([this]() {
+            _prefilterReady = true;
+            Root::getInstance()->getPipeline()->getPipelineSceneData()->getAmbient()->setMipmapCount(static_cast<uint8_t>(_prefilterTarget->getMipmapCount()));
+            updateGlobalBinding();
+            updatePipeline();
+        });
+        prefilter->enqueue(_prefilterTarget);
+    }
+}
+
+void Skybox::destroyPrefilterTarget() {
+    if (_prefilterTarget != nullptr) {
+        auto *prefilter = getEnvironmentPrefilter();
+        if (prefilter != nullptr) {
+            prefilter->cancel(_prefilterTarget);
+        }
+        CC_SAFE_DELETE(_prefilterTarget);
+    }
+    _prefilterReady = false;
+}
+
 void Skybox::setDiffuseMaps(TextureCube *diffuseMapHDR, TextureCube *diffuseMapLDR) {
     _diffuseMapHDR = diffuseMapHDR;
     _diffuseMapLDR = diffuseMapLDR;
@@ -255,16 +312,12 @@ void Skybox::activate() {
     }
 
     if (_enabled) {
-        if (!skyboxMesh) {
-            IBoxOptions options;
-            options.width  = 2;
-            options.height = 2;
-            options.length = 2;
-            skyboxMesh     = MeshUtils::createMesh(
-                createGeometry(
-                    PrimitiveType::BOX,
-                    PrimitiveOptions{options}));
-        }
+        IBoxOptions options;
+        options.width  = 2;
+        options.height = 2;
+        options.length = 2;
+        // the box is shared with every other user of the same primitive
+        Mesh *skyboxMesh = PrimitiveMeshCache::getInstance()->getMesh(PrimitiveType::BOX, PrimitiveOptions{options});
         _model->initSubModel(0, skyboxMesh->getRenderingSubMeshes()[0], skyboxMaterial);
     }
 
@@ -294,7 +347,7 @@ void Skybox::updatePipeline() const {
 
     const bool    useRGBE            = isRGBE();
     const int32_t useIBLValue        = isUseIBL() ? (useRGBE ? 2 : 1) : 0;
-    const int32_t useDiffuseMapValue = (isUseIBL() && isUseDiffuseMap() && getDiffuseMap() != nullptr) ? (useRGBE ? 2 : 1) : 0;
+    const int32_t useDiffuseMapValue = (isUseIBL() && isUseDiffuseMap() && (getDiffuseMap() != nullptr || _prefilterReady)) ? (useRGBE ? 2 : 1) : 0;
     const bool    useHDRValue        = isUseHDR();
 
     bool valueChanged = false;
@@ -340,6 +393,18 @@ void Skybox::updateGlobalBinding() {
         if (!envmap) {
             envmap = _default.get();
         }
+        if (_prefilterReady) {
+            // the generated maps have the encoding of the envmap, so the shading macros stay the same
+            auto samplerInfo      = envmap->getSamplerInfo();
+            samplerInfo.mipFilter = gfx::Filter::LINEAR;
+            auto *sampler         = device->getSampler(samplerInfo);
+            _globalDSManager->bindSampler(pipeline::ENVIRONMENT::BINDING, sampler);
+            _globalDSManager->bindTexture(pipeline::ENVIRONMENT::BINDING, _prefilterTarget->getSpecularTexture());
+            _globalDSManager->bindSampler(pipeline::DIFFUSEMAP::BINDING, sampler);
+            _globalDSManager->bindTexture(pipeline::DIFFUSEMAP::BINDING, _prefilterTarget->getDiffuseTexture());
+            _globalDSManager->update();
+            return;
+        }
         if (envmap != nullptr) {
             auto *texture = envmap->getGFXTexture();
             auto *sampler = device->getSampler(envmap->getSamplerInfo());
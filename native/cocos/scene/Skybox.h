@@ -32,8 +32,9 @@
 #include "core/assets/TextureCube.h"
 namespace cc {
 namespace pipeline {
+class EnvironmentPrefilterTarget;
 class GlobalDSManager;
-}
+} // namespace pipeline
 namespace scene {
 
 enum class EnvironmentLightingType {
@@ -187,8 +188,8 @@ public:
 
 class Skybox final {
 public:
-    Skybox()  = default;
-    ~Skybox() = default;
+    Skybox() = default;
+    ~Skybox();
 
     void initialize(const SkyboxInfo &skyboxInfo);
 
@@ -264,9 +265,25 @@ public:
     TextureCube *getDiffuseMap() const;
     void         setDiffuseMap(TextureCube *val);
 
+    /**
+     * @en Whether to prefilter the environment map on the GPU at runtime. Once done, the generated reflection mips and diffuse
+     * irradiance map replace the baked ones, so cube maps created or changed at runtime can be used for lighting.
+     * @zh 是否在运行时使用 GPU 预过滤环境贴图。完成后生成的反射 mip 与漫反射辐照度图会替换离线烘焙的贴图，使运行时创建或修改的立方体贴图可用于光照。
+     */
+    inline bool isRuntimePrefilterEnabled() const { return _runtimePrefilter; }
+    void        setRuntimePrefilterEnabled(bool val);
+
+    /**
+     * @en Prefilter the environment map again, should be called after its contents changed when runtime prefiltering is enabled.
+     * @zh 重新预过滤环境贴图，开启运行时预过滤后，环境贴图内容变化时应调用。
+     */
+    void prefilterEnvmap();
+
 private:
     void updatePipeline() const;
     void updateGlobalBinding();
+    void updatePrefilterTarget();
+    void destroyPrefilterTarget();
 
     IntrusivePtr<TextureCube>  _envmapLDR;
     IntrusivePtr<TextureCube>  _envmapHDR;
@@ -280,6 +297,11 @@ private:
     bool                       _useHDR{true};
     bool                       _useDiffuseMap{false};
 
+    // generated maps of the current environment map, bound once the first prefiltering completes
+    pipeline::EnvironmentPrefilterTarget *_prefilterTarget{nullptr};
+    bool                                  _prefilterReady{false};
+    bool                                  _runtimePrefilter{false};
+
     CC_DISALLOW_COPY_MOVE_ASSIGN(Skybox);
 };
 
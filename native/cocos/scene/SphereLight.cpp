@@ -30,6 +30,8 @@
 #include "renderer/pipeline/PipelineSceneData.h"
 namespace cc {
 namespace scene {
+CC_SLAB_ALLOCATED_IMPL(SphereLight)
+
 SphereLight::SphereLight() {
     _type = LightType::SPHERE;
 }
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "core/geometry/AABB.h"
+#include "core/memop/SlabAllocator.h"
 #include "math/Vec3.h"
 #include "scene/Light.h"
 
@@ -73,6 +74,7 @@ private:
     geometry::AABB _aabb;
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(SphereLight);
+    CC_SLAB_ALLOCATED(SphereLight);
 };
 
 } // namespace scene
@@ -34,6 +34,8 @@
 
 namespace cc {
 namespace scene {
+CC_SLAB_ALLOCATED_IMPL(SpotLight)
+
 SpotLight::SpotLight() {
     _type = LightType::SPOT;
     _aabb = new geometry::AABB();
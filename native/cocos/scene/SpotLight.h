@@ -27,6 +27,7 @@
 
 #include "core/geometry/AABB.h"
 #include "core/geometry/Frustum.h"
+#include "core/memop/SlabAllocator.h"
 #include "scene/Light.h"
 
 namespace cc {
@@ -116,6 +117,7 @@ private:
     float _shadowNormalBias{0.0F};
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(SpotLight);
+    CC_SLAB_ALLOCATED(SpotLight);
 };
 
 } // namespace scene
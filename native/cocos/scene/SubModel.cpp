@@ -27,6 +27,9 @@
 #include "core/Root.h"
 #include "core/platform/Debug.h"
 #include "pipeline/Define.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/gfx-base/GFXDescriptorSetCache.h"
+#include "renderer/pipeline/GlobalDescriptorSetManager.h"
 #include "renderer/pipeline/PipelineSceneData.h"
 #include "renderer/pipeline/custom/RenderInterfaceTypes.h"
 #include "renderer/pipeline/forward/ForwardPipeline.h"
@@ -37,10 +40,20 @@
 namespace cc {
 namespace scene {
 
+CC_SLAB_ALLOCATED_IMPL(SubModel)
+
 SubModel::SubModel() {
     _id = generateId();
 }
 
+namespace {
+gfx::DescriptorSetCache *getDescriptorSetCache() {
+    const auto *pipeline        = Root::getInstance()->getPipeline();
+    const auto *globalDSManager = pipeline ? pipeline->getGlobalDSManager() : nullptr;
+    return globalDSManager ? globalDSManager->getDescriptorSetCache() : nullptr;
+}
+} // namespace
+
 const static uint32_t  MAX_PASS_COUNT = 8;
 gfx::DescriptorSetInfo dsInfo         = gfx::DescriptorSetInfo();
 
@@ -49,8 +62,46 @@ void SubModel::update() {
     for (Pass *pass : passes) {
         pass->update();
     }
-    _descriptorSet->update();
+    updateDescriptorSet();
     _worldBoundDescriptorSet->update();
+
+    // swap in the shader variants compiled in the async compile mode
+    if (_shadersPending && _shadersVersion != ProgramLib::getInstance()->getCompiledVersion()) {
+        flushPassInfo();
+    }
+}
+
+void SubModel::updateDescriptorSet() {
+    auto *cache = getDescriptorSetCache();
+    if (!cache || !cache->isEnabled()) {
+        releaseSharedDescriptorSet();
+        _descriptorSet->update();
+        return;
+    }
+
+    const auto version = _descriptorSet->getBindingVersion();
+    if (_sharedDescriptorSet && _sharedDescriptorSetVersion == version) {
+        return;
+    }
+    // acquire before releasing, the old set is kept if the bindings changed back
+    auto *shared = cache->acquire(_descriptorSet);
+    releaseSharedDescriptorSet();
+    if (!shared) {
+        _descriptorSet->update();
+        return;
+    }
+    _sharedDescriptorSet        = shared;
+    _sharedDescriptorSetVersion = version;
+}
+
+void SubModel::releaseSharedDescriptorSet() {
+    if (!_sharedDescriptorSet) {
+        return;
+    }
+    if (auto *cache = getDescriptorSetCache()) {
+        cache->release(_sharedDescriptorSet);
+    }
+    _sharedDescriptorSet = nullptr;
 }
 
 void SubModel::setPasses(const std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> &pPasses) {
@@ -68,6 +119,7 @@ void SubModel::setPasses(const std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>
     }
     // DS layout might change too
     if (_descriptorSet) {
+        releaseSharedDescriptorSet();
         _descriptorSet->destroy();
         dsInfo.layout  = passes[0]->getLocalSetLayout();
         _descriptorSet = _device->createDescriptorSet(dsInfo);
@@ -178,6 +230,7 @@ void SubModel::initPlanarShadowInstanceShader() {
 }
 
 void SubModel::destroy() {
+    releaseSharedDescriptorSet();
     CC_SAFE_DESTROY_NULL(_descriptorSet);
     CC_SAFE_DESTROY_NULL(_inputAssembler);
     CC_SAFE_DESTROY_NULL(_worldBoundDescriptorSet);
@@ -236,9 +289,13 @@ void SubModel::flushPassInfo() {
         _shaders.clear();
     }
     _shaders.resize(passes.size());
+    _shadersPending = false;
     for (uint i = 0; i < passes.size(); ++i) {
-        _shaders[i] = passes[i]->getShaderVariant(_patches);
+        bool pending = false;
+        _shaders[i]  = passes[i]->getShaderVariant(_patches, &pending);
+        _shadersPending |= pending;
     }
+    _shadersVersion = ProgramLib::getInstance()->getCompiledVersion();
 }
 
 void SubModel::setSubMesh(RenderingSubMesh *subMesh) {
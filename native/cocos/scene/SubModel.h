@@ -28,6 +28,7 @@
 #include <cstdint>
 #include "base/RefCounted.h"
 #include "core/assets/RenderingSubMesh.h"
+#include "core/memop/SlabAllocator.h"
 #include "renderer/gfx-base/GFXDescriptorSet.h"
 #include "renderer/gfx-base/GFXInputAssembler.h"
 #include "renderer/gfx-base/GFXShader.h"
@@ -48,7 +49,10 @@ public:
     Pass *       getPass(uint) const;
 
     inline void setWorldBoundDescriptorSet(gfx::DescriptorSet *descriptorSet) { _worldBoundDescriptorSet = descriptorSet; }
-    inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) { _descriptorSet = descriptorSet; }
+    inline void setDescriptorSet(gfx::DescriptorSet *descriptorSet) {
+        releaseSharedDescriptorSet();
+        _descriptorSet = descriptorSet;
+    }
     inline void setInputAssembler(gfx::InputAssembler *ia) { _inputAssembler = ia; }
     inline void setShaders(const ccstd::vector<IntrusivePtr<gfx::Shader>> &shaders) { _shaders = shaders; }
     void        setPasses(const std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> &passes);
@@ -60,6 +64,16 @@ public:
 
     inline gfx::DescriptorSet *                            getDescriptorSet() const { return _descriptorSet; }
     inline gfx::DescriptorSet *                            getWorldBoundDescriptorSet() const { return _worldBoundDescriptorSet; }
+    /**
+     * @en The local descriptor set to draw with. It is the set shared with other submodels holding the same bindings when
+     * descriptor set sharing is enabled, see gfx::DescriptorSetCache, or getDescriptorSet() if the bindings changed since
+     * the last update. Bindings should always be made to getDescriptorSet().
+     * @zh 绘制时使用的局部描述符集。启用描述符集共享时为与持有相同绑定的其他子模型共享的描述符集，参见 gfx::DescriptorSetCache，
+     * 若绑定在上次更新之后发生了变化则为 getDescriptorSet()。绑定操作应始终作用于 getDescriptorSet()。
+     */
+    inline gfx::DescriptorSet *getDrawDescriptorSet() const {
+        return _sharedDescriptorSet && _sharedDescriptorSetVersion == _descriptorSet->getBindingVersion() ? _sharedDescriptorSet : _descriptorSet.get();
+    }
     inline gfx::InputAssembler *                           getInputAssembler() const { return _inputAssembler; }
     inline const ccstd::vector<IntrusivePtr<gfx::Shader>> &getShaders() const { return _shaders; }
     inline const ccstd::vector<IntrusivePtr<Pass>> &       getPasses() const { return *_passes; }
@@ -81,12 +95,16 @@ public:
 
 protected:
     void flushPassInfo();
+    void updateDescriptorSet();
+    void releaseSharedDescriptorSet();
 
     gfx::Device *                     _device{nullptr};
     ccstd::vector<IMacroPatch>        _patches;
     IntrusivePtr<gfx::InputAssembler> _inputAssembler;
     IntrusivePtr<gfx::DescriptorSet>  _descriptorSet;
     IntrusivePtr<gfx::DescriptorSet>  _worldBoundDescriptorSet;
+    gfx::DescriptorSet *              _sharedDescriptorSet{nullptr}; // owned by the descriptor set cache
+    uint32_t                          _sharedDescriptorSetVersion{0};
 
     IntrusivePtr<gfx::Texture>                         _reflectionTex;
     gfx::Sampler *                                     _reflectionSampler{nullptr};
@@ -96,6 +114,9 @@ protected:
     IntrusivePtr<RenderingSubMesh>                     _subMesh;
     std::shared_ptr<ccstd::vector<IntrusivePtr<Pass>>> _passes;
     ccstd::vector<IntrusivePtr<gfx::Shader>>           _shaders;
+    // some shaders are fallbacks until ProgramLib compiled version changes
+    bool                                               _shadersPending{false};
+    uint32_t                                           _shadersVersion{0};
     Model *                                            _owner{nullptr};
     int32_t                                            _id{-1};
 
@@ -106,6 +127,7 @@ private:
     }
 
     CC_DISALLOW_COPY_MOVE_ASSIGN(SubModel);
+    CC_SLAB_ALLOCATED(SubModel);
 };
 
 } // namespace scene
@@ -58,7 +58,8 @@ static void splitFilename(ccstd::string &str) {
     }
 }
 
-void localStorageInit(const ccstd::string &fullpath) {
+// SharedPreferences already applies changes asynchronously, write-back options are ignored.
+void localStorageInit(const ccstd::string &fullpath, bool /*writeBack*/, uint32_t /*flushIntervalMs*/) {
     if (fullpath.empty()) {
         return;
     }
@@ -79,6 +80,9 @@ void localStorageFree() {
     }
 }
 
+void localStorageFlush() {
+}
+
 /** sets an item in the LS */
 void localStorageSetItem(const ccstd::string &key, const ccstd::string &value) {
     assert(gInitialized);
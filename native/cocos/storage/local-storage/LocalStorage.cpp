@@ -60,8 +60,14 @@
 #if (CC_PLATFORM != CC_PLATFORM_ANDROID)
 
     #include <cassert>
+    #include <chrono>
+    #include <condition_variable>
     #include <cstdio>
     #include <cstdlib>
+    #include <mutex>
+    #include <thread>
+    #include "base/std/container/list.h"
+    #include "base/std/container/unordered_map.h"
 
     #if (CC_PLATFORM == CC_PLATFORM_WINDOWS)
         #include <sqlite3/sqlite3.h>
@@ -78,6 +84,30 @@ static sqlite3_stmt *_stmt_clear;
 static sqlite3_stmt *_stmt_key;
 static sqlite3_stmt *_stmt_count;
 
+// Write-back mode, items are cached in memory and only the background thread writes the DB.
+// The cache is accessed by the calling (JS) thread only, pending writes are shared with the flush thread.
+using CacheItems = ccstd::list<std::pair<ccstd::string, ccstd::string>>;
+
+struct PendingWrite {
+    ccstd::string key;
+    ccstd::string value;
+    bool          removed{false};
+};
+using PendingWrites = ccstd::list<PendingWrite>;
+
+static bool                                                         _writeBack = false;
+static CacheItems                                                   _cacheItems; // in ROWID order, like the DB
+static ccstd::unordered_map<ccstd::string, CacheItems::iterator>    _cacheIndex;
+static PendingWrites                                                _pendingWrites; // in ROWID order of the final state
+static ccstd::unordered_map<ccstd::string, PendingWrites::iterator> _pendingIndex;
+static bool                                                         _pendingClear = false;
+static std::mutex                                                   _pendingMutex;
+static std::mutex                                                   _flushMutex; // keeps batches in order
+static std::condition_variable                                      _flushCondition;
+static std::thread                                                  _flushThread;
+static bool                                                         _flushThreadQuit = false;
+static uint32_t                                                     _flushInterval   = 1000;
+
 static void localStorageCreateTable() {
     const char *  sql_createtable = "CREATE TABLE IF NOT EXISTS data(key TEXT PRIMARY KEY,value TEXT);";
     sqlite3_stmt *stmt;
@@ -89,7 +119,84 @@ static void localStorageCreateTable() {
         printf("Error in CREATE TABLE\n");
 }
 
-void localStorageInit(const ccstd::string &fullpath /* = "" */) {
+static void localStorageLoadCache() {
+    sqlite3_stmt *stmt = nullptr;
+    int           ok   = sqlite3_prepare_v2(_db, "SELECT key, value FROM data ORDER BY ROWID ASC;", -1, &stmt, nullptr);
+    while (ok == SQLITE_OK && (ok = sqlite3_step(stmt)) == SQLITE_ROW) {
+        const auto *key   = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
+        const auto *value = reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        if (key) {
+            _cacheItems.emplace_back(key, value ? value : "");
+            _cacheIndex[_cacheItems.back().first] = std::prev(_cacheItems.end());
+        }
+        ok = SQLITE_OK;
+    }
+    sqlite3_finalize(stmt);
+
+    if (ok != SQLITE_DONE)
+        printf("Error in loading localStorage\n");
+}
+
+static void localStorageWritePending() {
+    std::lock_guard<std::mutex> flushLock(_flushMutex);
+
+    PendingWrites writes;
+    bool          clear = false;
+    {
+        std::lock_guard<std::mutex> lk(_pendingMutex);
+        writes.swap(_pendingWrites);
+        _pendingIndex.clear();
+        clear         = _pendingClear;
+        _pendingClear = false;
+    }
+
+    if (writes.empty() && !clear)
+        return;
+
+    bool ok = sqlite3_exec(_db, "BEGIN TRANSACTION;", nullptr, nullptr, nullptr) == SQLITE_OK;
+    if (clear) {
+        ok &= sqlite3_step(_stmt_clear) == SQLITE_DONE;
+        sqlite3_reset(_stmt_clear);
+    }
+    for (const auto &write : writes) {
+        sqlite3_stmt *stmt = write.removed ? _stmt_remove : _stmt_update;
+        sqlite3_bind_text(stmt, 1, write.key.c_str(), -1, SQLITE_STATIC);
+        if (!write.removed)
+            sqlite3_bind_text(stmt, 2, write.value.c_str(), -1, SQLITE_STATIC);
+        ok &= sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+
+    if (ok && sqlite3_exec(_db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK)
+        return;
+
+    sqlite3_exec(_db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    printf("Error in writing localStorage, %d changes are lost\n", static_cast<int>(writes.size()));
+}
+
+static void localStorageFlushThread() {
+    std::unique_lock<std::mutex> lk(_pendingMutex);
+    while (!_flushThreadQuit) {
+        _flushCondition.wait_for(lk, std::chrono::milliseconds(_flushInterval));
+        lk.unlock();
+        localStorageWritePending();
+        lk.lock();
+    }
+}
+
+static void localStorageAddPendingWrite(const ccstd::string &key, const ccstd::string &value, bool removed) {
+    std::lock_guard<std::mutex> lk(_pendingMutex);
+    // Only the last change of a key is written, it's moved to the end to keep the ROWID order
+    auto iter = _pendingIndex.find(key);
+    if (iter != _pendingIndex.end()) {
+        _pendingWrites.erase(iter->second);
+    }
+    _pendingWrites.push_back({key, removed ? ccstd::string() : value, removed});
+    _pendingIndex[key] = std::prev(_pendingWrites.end());
+}
+
+void localStorageInit(const ccstd::string &fullpath /* = "" */, bool writeBack /* = false */, uint32_t flushIntervalMs /* = 1000 */) {
     if (!_initialized) {
         int ret = 0;
 
@@ -128,15 +235,44 @@ void localStorageInit(const ccstd::string &fullpath /* = "" */) {
             printf("Error initializing DB(%s)\n", fullpath.c_str());
             // report error
         }
+
+        _writeBack = writeBack;
+        if (_writeBack) {
+            // WAL avoids a fsync of the whole journal for every transaction, syncing happens at checkpoints
+            sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+            sqlite3_exec(_db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr);
+            localStorageLoadCache();
+
+            _flushInterval   = flushIntervalMs > 0 ? flushIntervalMs : 1;
+            _flushThreadQuit = false;
+            _flushThread     = std::thread(localStorageFlushThread);
+        }
         _initialized = 1;
     }
 }
 
 void localStorageFree() {
     if (_initialized) {
+        if (_writeBack) {
+            {
+                std::lock_guard<std::mutex> lk(_pendingMutex);
+                _flushThreadQuit = true;
+            }
+            _flushCondition.notify_one();
+            _flushThread.join();
+            localStorageWritePending();
+
+            _cacheIndex.clear();
+            _cacheItems.clear();
+            _writeBack = false;
+        }
+
         sqlite3_finalize(_stmt_select);
         sqlite3_finalize(_stmt_remove);
         sqlite3_finalize(_stmt_update);
+        sqlite3_finalize(_stmt_clear);
+        sqlite3_finalize(_stmt_key);
+        sqlite3_finalize(_stmt_count);
 
         sqlite3_close(_db);
 
@@ -144,9 +280,30 @@ void localStorageFree() {
     }
 }
 
+void localStorageFlush() {
+    if (_initialized && _writeBack) {
+        localStorageWritePending();
+        // Checkpointing syncs the WAL, so the changes survive a power loss once we return
+        std::lock_guard<std::mutex> flushLock(_flushMutex);
+        sqlite3_wal_checkpoint_v2(_db, nullptr, SQLITE_CHECKPOINT_FULL, nullptr, nullptr);
+    }
+}
+
 /** sets an item in the LS */
 void localStorageSetItem(const ccstd::string &key, const ccstd::string &value) {
     assert(_initialized);
+    if (_writeBack) {
+        // REPLACE gives the row a new ROWID, so the item goes to the end as well
+        auto iter = _cacheIndex.find(key);
+        if (iter != _cacheIndex.end()) {
+            _cacheItems.erase(iter->second);
+        }
+        _cacheItems.emplace_back(key, value);
+        _cacheIndex[key] = std::prev(_cacheItems.end());
+        localStorageAddPendingWrite(key, value, false);
+        return;
+    }
+
     int ok = sqlite3_bind_text(_stmt_update, 1, key.c_str(), -1, SQLITE_TRANSIENT);
     ok |= sqlite3_bind_text(_stmt_update, 2, value.c_str(), -1, SQLITE_TRANSIENT);
 
@@ -161,6 +318,15 @@ void localStorageSetItem(const ccstd::string &key, const ccstd::string &value) {
 /** gets an item from the LS */
 bool localStorageGetItem(const ccstd::string &key, ccstd::string *outItem) {
     assert(_initialized);
+    if (_writeBack) {
+        auto iter = _cacheIndex.find(key);
+        if (iter == _cacheIndex.end()) {
+            return false;
+        }
+        outItem->assign(iter->second->second);
+        return true;
+    }
+
     int ok = sqlite3_reset(_stmt_select);
 
     ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
@@ -181,6 +347,16 @@ bool localStorageGetItem(const ccstd::string &key, ccstd::string *outItem) {
 /** removes an item from the LS */
 void localStorageRemoveItem(const ccstd::string &key) {
     assert(_initialized);
+    if (_writeBack) {
+        auto iter = _cacheIndex.find(key);
+        if (iter != _cacheIndex.end()) {
+            _cacheItems.erase(iter->second);
+            _cacheIndex.erase(iter);
+            localStorageAddPendingWrite(key, "", true);
+        }
+        return;
+    }
+
     int ok = sqlite3_bind_text(_stmt_remove, 1, key.c_str(), -1, SQLITE_TRANSIENT);
 
     ok |= sqlite3_step(_stmt_remove);
@@ -194,6 +370,17 @@ void localStorageRemoveItem(const ccstd::string &key) {
 /** removes all items from the LS */
 void localStorageClear() {
     assert(_initialized);
+    if (_writeBack) {
+        _cacheIndex.clear();
+        _cacheItems.clear();
+
+        std::lock_guard<std::mutex> lk(_pendingMutex);
+        _pendingWrites.clear();
+        _pendingIndex.clear();
+        _pendingClear = true;
+        return;
+    }
+
     int ok = sqlite3_step(_stmt_clear);
 
     ok |= sqlite3_reset(_stmt_clear);
@@ -209,6 +396,13 @@ void localStorageGetKey(const int nIndex, ccstd::string *outKey) {
         printf("Error in input localStorage index Less than zero\n");
         return;
     }
+    if (_writeBack) {
+        if (nIndex < static_cast<int>(_cacheItems.size())) {
+            outKey->assign(std::next(_cacheItems.begin(), nIndex)->first);
+        }
+        return;
+    }
+
     int ok = sqlite3_reset(_stmt_key);
 
     ok |= sqlite3_step(_stmt_key);
@@ -237,6 +431,11 @@ void localStorageGetKey(const int nIndex, ccstd::string *outKey) {
 /** gets all items count in the JS. */
 void localStorageGetLength(int &outLength) {
     assert(_initialized);
+    if (_writeBack) {
+        outLength = static_cast<int>(_cacheItems.size());
+        return;
+    }
+
     int ok = sqlite3_reset(_stmt_count);
 
     ok |= sqlite3_step(_stmt_count);
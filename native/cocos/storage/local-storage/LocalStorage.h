@@ -29,6 +29,7 @@
 #define __JSB_LOCALSTORAGE_H
 
 #include "base/Macros.h"
+#include <cstdint>
 #include "base/std/container/string.h"
 
 /**
@@ -38,12 +39,18 @@
 
 /** Local Storage support for the JS Bindings.*/
 
-/** Initializes the database. If path is null, it will create an in-memory DB. */
-void CC_DLL localStorageInit(const ccstd::string &fullpath = "");
+/** Initializes the database. If path is null, it will create an in-memory DB.
+ *  If writeBack is true, the DB uses WAL journaling and all items are cached in memory: reads never touch the DB,
+ *  and changes are written in one transaction by a background thread every flushIntervalMs or by localStorageFlush.
+ */
+void CC_DLL localStorageInit(const ccstd::string &fullpath = "", bool writeBack = false, uint32_t flushIntervalMs = 1000);
 
-/** Frees the allocated resources. */
+/** Frees the allocated resources, pending changes are written before. */
 void CC_DLL localStorageFree();
 
+/** Writes pending changes of write-back mode to disk and waits until they are durable. */
+void CC_DLL localStorageFlush();
+
 /** Sets an item in the JS. */
 void CC_DLL localStorageSetItem(const ccstd::string &key, const ccstd::string &value);
 
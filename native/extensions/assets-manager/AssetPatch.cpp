@@ -0,0 +1,173 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "AssetPatch.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "base/Data.h"
+#include "base/Log.h"
+#include "base/ZipUtils.h"
+#include "platform/FileUtils.h"
+
+NS_CC_EXT_BEGIN
+
+namespace {
+
+constexpr char   PATCH_MAGIC[]     = "CCPATCH1";
+constexpr size_t PATCH_MAGIC_SIZE  = 8;
+constexpr size_t PATCH_HEADER_SIZE = PATCH_MAGIC_SIZE + 8 + 4 + 8 + 4;
+constexpr size_t CONTROL_SIZE      = 8 * 3;
+
+uint64_t readU64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+uint32_t readU32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t checksum(const uint8_t *data, size_t size) {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    // crc32 takes an unsigned int length
+    while (size > 0) {
+        auto chunk = static_cast<uInt>(std::min<size_t>(size, 1U << 30));
+        crc        = crc32(crc, data, chunk);
+        data += chunk;
+        size -= chunk;
+    }
+    return static_cast<uint32_t>(crc);
+}
+
+} // namespace
+
+bool AssetPatch::apply(const uint8_t *oldData, size_t oldSize, const uint8_t *patch, size_t patchSize, uint8_t **out, size_t *outSize) {
+    *out     = nullptr;
+    *outSize = 0;
+    if (patchSize < PATCH_HEADER_SIZE || memcmp(patch, PATCH_MAGIC, PATCH_MAGIC_SIZE) != 0) {
+        CC_LOG_DEBUG("AssetPatch: invalid patch header");
+        return false;
+    }
+
+    const uint8_t *header   = patch + PATCH_MAGIC_SIZE;
+    uint64_t       expected = readU64(header);
+    uint32_t       oldCrc   = readU32(header + 8);
+    uint64_t       newSize  = readU64(header + 12);
+    uint32_t       newCrc   = readU32(header + 20);
+    if (expected != oldSize || checksum(oldData, oldSize) != oldCrc) {
+        CC_LOG_DEBUG("AssetPatch: the patch doesn't apply to this version of the file");
+        return false;
+    }
+
+    unsigned char *payload     = nullptr;
+    ssize_t        payloadSize = ZipUtils::inflateMemoryWithHint(const_cast<uint8_t *>(patch + PATCH_HEADER_SIZE), static_cast<ssize_t>(patchSize - PATCH_HEADER_SIZE), &payload,
+                                                                 static_cast<ssize_t>(newSize + CONTROL_SIZE) + 1);
+    if (payloadSize < 0 || payload == nullptr) {
+        free(payload);
+        return false;
+    }
+
+    auto *   result = static_cast<uint8_t *>(malloc(newSize > 0 ? newSize : 1));
+    bool     ok     = result != nullptr;
+    size_t   cursor = 0;
+    uint64_t newPos = 0;
+    int64_t  oldPos = 0;
+    auto     size   = static_cast<size_t>(payloadSize);
+    while (ok && newPos < newSize) {
+        if (size - cursor < CONTROL_SIZE) {
+            ok = false;
+            break;
+        }
+        uint64_t diffLength  = readU64(payload + cursor);
+        uint64_t extraLength = readU64(payload + cursor + 8);
+        auto     seek        = static_cast<int64_t>(readU64(payload + cursor + 16));
+        cursor += CONTROL_SIZE;
+
+        // Every length is checked against what remains, a malformed patch must not read or write out of bounds
+        if (diffLength > newSize - newPos || diffLength > size - cursor ||
+            oldPos < 0 || static_cast<uint64_t>(oldPos) > oldSize || diffLength > oldSize - static_cast<uint64_t>(oldPos)) {
+            ok = false;
+            break;
+        }
+        const uint8_t *diff = payload + cursor;
+        const uint8_t *base = oldData + oldPos;
+        for (uint64_t i = 0; i < diffLength; ++i) {
+            result[newPos + i] = static_cast<uint8_t>(base[i] + diff[i]);
+        }
+        cursor += diffLength;
+        newPos += diffLength;
+        oldPos += static_cast<int64_t>(diffLength);
+
+        if (extraLength > newSize - newPos || extraLength > size - cursor) {
+            ok = false;
+            break;
+        }
+        memcpy(result + newPos, payload + cursor, extraLength);
+        cursor += extraLength;
+        newPos += extraLength;
+        oldPos += seek;
+    }
+    free(payload);
+
+    if (ok && checksum(result, newSize) != newCrc) {
+        CC_LOG_DEBUG("AssetPatch: checksum mismatch of the patched file");
+        ok = false;
+    }
+    if (!ok) {
+        free(result);
+        return false;
+    }
+    *out     = result;
+    *outSize = newSize;
+    return true;
+}
+
+bool AssetPatch::apply(const std::string &oldPath, const std::string &patchPath, const std::string &newPath) {
+    auto *fileUtils = FileUtils::getInstance();
+    Data  oldData   = fileUtils->getDataFromFile(oldPath);
+    Data  patch     = fileUtils->getDataFromFile(patchPath);
+    if (patch.isNull()) {
+        return false;
+    }
+
+    uint8_t *out     = nullptr;
+    size_t   outSize = 0;
+    if (!apply(oldData.getBytes(), static_cast<size_t>(oldData.getSize()), patch.getBytes(), static_cast<size_t>(patch.getSize()), &out, &outSize)) {
+        return false;
+    }
+
+    Data result;
+    result.fastSet(out, static_cast<ssize_t>(outSize));
+    return fileUtils->writeDataToFile(result, newPath);
+}
+
+NS_CC_EXT_END
@@ -0,0 +1,60 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "extensions/ExtensionMacros.h"
+
+NS_CC_EXT_BEGIN
+
+/**
+ * Binary delta patch of an asset, in the bsdiff layout with a zlib payload:
+ *
+ *   "CCPATCH1" | uint64 oldSize | uint32 oldCrc | uint64 newSize | uint32 newCrc | zlib(control blocks)
+ *
+ * All integers are little endian. Every control block of the payload is
+ *
+ *   uint64 diffLength | uint64 extraLength | int64 seek | diffLength bytes | extraLength bytes
+ *
+ * diffLength bytes of the old file are added bytewise to the diff bytes, the extra bytes are copied as is,
+ * then the position in the old file moves by seek. The crc32 of both files are checked so a patch is never
+ * applied on another base and a corrupted result is never produced.
+ */
+class AssetPatch {
+public:
+    /**
+     * @brief Apply the patch in patchPath on the file in oldPath and write the result to newPath.
+     * Thread safe, it's called on worker threads.
+     * @return Whether the patch was applied and the result matches its checksum.
+     */
+    static bool apply(const std::string &oldPath, const std::string &patchPath, const std::string &newPath);
+
+    static bool apply(const uint8_t *oldData, size_t oldSize, const uint8_t *patch, size_t patchSize, uint8_t **out, size_t *outSize);
+};
+
+NS_CC_EXT_END
@@ -25,9 +25,12 @@
  ****************************************************************************/
 #include "AssetsManagerEx.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
+#include <cstring>
 
+#include "AssetPatch.h"
 #include "AsyncTaskPool.h"
 #include "base/DeferredReleasePool.h"
 #include "base/Log.h"
@@ -45,6 +48,7 @@ NS_CC_EXT_BEGIN
 #define VERSION_FILENAME       "version.manifest"
 #define TEMP_MANIFEST_FILENAME "project.manifest.temp"
 #define TEMP_PACKAGE_SUFFIX    "_temp"
+#define PATCH_SUFFIX           ".patch"
 #define MANIFEST_FILENAME      "project.manifest"
 
 #define BUFFER_SIZE  8192
@@ -514,7 +518,7 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
         }
         delete dataInner;
     };
-    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_OTHER, decompressFinished, static_cast<void *>(asyncData), [this, asyncData]() {
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_DECOMPRESS, decompressFinished, static_cast<void *>(asyncData), [this, asyncData]() {
         // Decompress all compressed files
         if (decompress(asyncData->zipFile)) {
             asyncData->succeed = true;
@@ -523,6 +527,117 @@ void AssetsManagerEx::decompressDownloadedZip(const std::string &customId, const
     });
 }
 
+void AssetsManagerEx::checkDownloadedAsset(const std::string &customId, const std::string &storagePath) {
+    const auto &assets  = _remoteManifest->getAssets();
+    auto        assetIt = assets.find(customId);
+    if (assetIt == assets.end()) {
+        fileSuccess(customId, storagePath);
+    } else if (_asyncVerifyCallback != nullptr) {
+        verifyDownloadedAsset(customId, storagePath, assetIt->second);
+    } else {
+        bool ok = _verifyCallback == nullptr || _verifyCallback(storagePath, assetIt->second);
+        onAssetVerified(customId, storagePath, assetIt->second.compressed, ok);
+    }
+}
+
+void AssetsManagerEx::verifyDownloadedAsset(const std::string &customId, const std::string &storagePath, const Manifest::Asset &asset) {
+    struct AsyncData {
+        std::string     customId;
+        std::string     storagePath;
+        Manifest::Asset asset;
+        bool            succeed;
+    };
+
+    auto *asyncData        = new AsyncData;
+    asyncData->customId    = customId;
+    asyncData->storagePath = storagePath;
+    asyncData->asset       = asset;
+    asyncData->succeed     = false;
+
+    std::function<void(void *)> verifyFinished = [this](void *param) {
+        auto *dataInner = reinterpret_cast<AsyncData *>(param);
+        onAssetVerified(dataInner->customId, dataInner->storagePath, dataInner->asset.compressed, dataInner->succeed);
+        delete dataInner;
+    };
+    VerifyCallback verify = _asyncVerifyCallback;
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_VERIFY, verifyFinished, static_cast<void *>(asyncData), [verify, asyncData]() {
+        asyncData->succeed = verify(asyncData->storagePath, asyncData->asset);
+    });
+}
+
+void AssetsManagerEx::applyDownloadedPatch(const std::string &customId, const std::string &patchPath) {
+    struct AsyncData {
+        std::string customId;
+        std::string patchPath;
+        std::string basePath;
+        std::string storagePath;
+        bool        succeed;
+    };
+
+    auto *asyncData        = new AsyncData;
+    asyncData->customId    = customId;
+    asyncData->patchPath   = patchPath;
+    asyncData->basePath    = _downloadUnits[customId].patchBase;
+    asyncData->storagePath = patchPath.substr(0, patchPath.length() - strlen(PATCH_SUFFIX));
+    asyncData->succeed     = false;
+
+    std::function<void(void *)> patchFinished = [this](void *param) {
+        auto *dataInner = reinterpret_cast<AsyncData *>(param);
+        if (!dataInner->succeed) {
+            downloadFullAsset(dataInner->customId);
+        } else {
+            checkDownloadedAsset(dataInner->customId, dataInner->storagePath);
+        }
+        delete dataInner;
+    };
+    AsyncTaskPool::getInstance()->enqueue(AsyncTaskPool::TaskType::TASK_DECOMPRESS, patchFinished, static_cast<void *>(asyncData), [asyncData]() {
+        // The patch checks the crc of its base and of the result
+        asyncData->succeed = AssetPatch::apply(asyncData->basePath, asyncData->patchPath, asyncData->storagePath);
+        FileUtils::getInstance()->removeFile(asyncData->patchPath);
+        if (!asyncData->succeed) {
+            FileUtils::getInstance()->removeFile(asyncData->storagePath);
+        }
+    });
+}
+
+void AssetsManagerEx::downloadFullAsset(const std::string &customId) {
+    auto unitIt = _downloadUnits.find(customId);
+    if (unitIt == _downloadUnits.end()) {
+        return;
+    }
+    DownloadUnit &unit = unitIt->second;
+    CC_LOG_DEBUG("AssetsManagerEx : Fail to patch %s, downloading the whole file\n", customId.c_str());
+    const auto &assets  = _remoteManifest->getAssets();
+    auto        assetIt = assets.find(customId);
+    if (assetIt != assets.end()) {
+        unit.srcUrl = _remoteManifest->getPackageUrl() + assetIt->second.path + "?md5=" + assetIt->second.md5;
+        unit.size   = assetIt->second.size;
+    }
+    if (!unit.patchBase.empty()) {
+        unit.storagePath = unit.storagePath.substr(0, unit.storagePath.length() - strlen(PATCH_SUFFIX));
+    }
+    unit.patchBase.clear();
+
+    _tempManifest->setAssetDownloadState(customId, Manifest::DownloadState::UNSTARTED);
+    _queue.push_back(customId);
+    queueDowload();
+}
+
+void AssetsManagerEx::onAssetVerified(const std::string &customId, const std::string &storagePath, bool compressed, bool verified) {
+    auto unitIt = _downloadUnits.find(customId);
+    if (!verified && unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty()) {
+        // The patched file is unexpected, the whole file is downloaded instead
+        _fileUtils->removeFile(storagePath);
+        downloadFullAsset(customId);
+    } else if (!verified) {
+        fileError(customId, "Asset file verification failed after downloaded");
+    } else if (compressed) {
+        decompressDownloadedZip(customId, storagePath);
+    } else {
+        fileSuccess(customId, storagePath);
+    }
+}
+
 void AssetsManagerEx::dispatchUpdateEvent(EventAssetsManagerEx::EventCode code, const std::string &assetId /* = ""*/, const std::string &message /* = ""*/, int curleCode /* = CURLE_OK*/, int curlmCode /* = CURLM_OK*/) {
     switch (code) {
         case EventAssetsManagerEx::EventCode::ERROR_UPDATING:
@@ -715,6 +830,22 @@ void AssetsManagerEx::prepareUpdate() {
                 unit.srcUrl      = packageUrl + path + "?md5=" + diff.asset.md5;
                 unit.storagePath = _tempStoragePath + path;
                 unit.size        = diff.asset.size;
+                // Download only the binary patch when the version it was made from is present locally
+                if (diff.type == Manifest::DiffType::MODIFIED && !diff.asset.patchPath.empty() && !diff.asset.compressed) {
+                    const auto &localAssets = _localManifest->getAssets();
+                    auto        localIt     = localAssets.find(it.first);
+                    if (localIt != localAssets.end() && localIt->second.md5 == diff.asset.patchFrom) {
+                        std::string patchBase = _localManifest->getManifestRoot() + localIt->second.path;
+                        if (_fileUtils->isFileExist(patchBase)) {
+                            unit.patchBase = patchBase;
+                            unit.srcUrl    = packageUrl + diff.asset.patchPath + "?md5=" + diff.asset.md5;
+                            unit.storagePath += PATCH_SUFFIX;
+                            if (diff.asset.patchSize > 0) {
+                                unit.size = diff.asset.patchSize;
+                            }
+                        }
+                    }
+                }
                 _downloadUnits.emplace(unit.customId, unit);
                 _tempManifest->setAssetDownloadState(it.first, Manifest::DownloadState::UNSTARTED);
                 _totalSize += unit.size;
@@ -768,29 +899,42 @@ void AssetsManagerEx::updateSucceed() {
         // Merging all files in temp storage path to storage path
         std::vector<std::string> files;
         _fileUtils->listFilesRecursively(_tempStoragePath, &files);
+        // Parent directories come before their content
+        std::sort(files.begin(), files.end());
         int         baseOffset = static_cast<int>(_tempStoragePath.length());
         std::string relativePath;
         std::string dstPath;
+        // A directory which doesn't exist in storage path yet is moved at once with all its content
+        std::string movedDirectory;
         for (auto &file : files) {
             relativePath.assign(file.substr(baseOffset));
-            dstPath.assign(_storagePath + relativePath);
-            // Create directory
-            if (relativePath.back() == '/') {
-                _fileUtils->createDirectory(dstPath);
-            }
-            // Copy file
-            else {
-                if (_fileUtils->isFileExist(dstPath)) {
-                    _fileUtils->removeFile(dstPath);
-                }
-                _fileUtils->renameFile(file, dstPath);
-            }
-
             // Remove from delete list for safe, although this is not the case in general.
             auto diffIter = diffMap.find(relativePath);
             if (diffIter != diffMap.end()) {
                 diffMap.erase(diffIter);
             }
+
+            if (relativePath.empty() || (!movedDirectory.empty() && relativePath.compare(0, movedDirectory.length(), movedDirectory) == 0)) {
+                continue;
+            }
+
+            dstPath.assign(_storagePath + relativePath);
+            if (relativePath.back() == '/') {
+                if (!_fileUtils->isDirectoryExist(dstPath)) {
+                    std::string srcDir = file.substr(0, file.length() - 1);
+                    std::string dstDir = dstPath.substr(0, dstPath.length() - 1);
+                    if (_fileUtils->renameFile(srcDir, dstDir)) {
+                        movedDirectory = relativePath;
+                    } else {
+                        _fileUtils->createDirectory(dstPath);
+                    }
+                }
+            }
+            // Move file, rename replaces an existing file except on Windows
+            else if (!_fileUtils->renameFile(file, dstPath)) {
+                _fileUtils->removeFile(dstPath);
+                _fileUtils->renameFile(file, dstPath);
+            }
         }
 
         // Preprocessing local files in previous version and creating download folders
@@ -962,7 +1106,6 @@ void AssetsManagerEx::fileError(const std::string &identifier, const std::string
     dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_UPDATING, identifier, errorStr, errorCode, errorCodeInternal);
     _tempManifest->setAssetDownloadState(identifier, Manifest::DownloadState::UNSTARTED);
 
-    _currConcurrentTask = std::max(0, _currConcurrentTask - 1);
     queueDowload();
 }
 
@@ -989,7 +1132,6 @@ void AssetsManagerEx::fileSuccess(const std::string &customId, const std::string
     // Notify asset updated event
     dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ASSET_UPDATED, customId);
 
-    _currConcurrentTask = std::max(0, _currConcurrentTask - 1);
     queueDowload();
 }
 
@@ -1006,7 +1148,13 @@ void AssetsManagerEx::onError(const network::DownloadTask &task,
         dispatchUpdateEvent(EventAssetsManagerEx::EventCode::ERROR_DOWNLOAD_MANIFEST, task.identifier, errorStr, errorCode, errorCodeInternal);
         _updateState = State::FAIL_TO_UPDATE;
     } else {
-        fileError(task.identifier, errorStr, errorCode, errorCodeInternal);
+        _currConcurrentTask = std::max(0, _currConcurrentTask - 1);
+        auto unitIt = _downloadUnits.find(task.identifier);
+        if (unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty()) {
+            downloadFullAsset(task.identifier);
+        } else {
+            fileError(task.identifier, errorStr, errorCode, errorCodeInternal);
+        }
     }
 }
 
@@ -1062,25 +1210,16 @@ void AssetsManagerEx::onSuccess(const std::string & /*srcUrl*/, const std::strin
         _updateState = State::MANIFEST_LOADED;
         parseManifest();
     } else {
-        bool        ok      = true;
-        const auto &assets  = _remoteManifest->getAssets();
-        auto        assetIt = assets.find(customId);
-        if (assetIt != assets.end()) {
-            Manifest::Asset asset = assetIt->second;
-            if (_verifyCallback != nullptr) {
-                ok = _verifyCallback(storagePath, asset);
-            }
-        }
-
-        if (ok) {
-            bool compressed = assetIt != assets.end() ? assetIt->second.compressed : false;
-            if (compressed) {
-                decompressDownloadedZip(customId, storagePath);
-            } else {
-                fileSuccess(customId, storagePath);
-            }
+        // The download slot is released as soon as the file is on disk, so that the next files are downloading
+        // while this one is verified and decompressed. The unit is finished by fileSuccess or fileError.
+        _currConcurrentTask = std::max(0, _currConcurrentTask - 1);
+        queueDowload();
+
+        auto unitIt = _downloadUnits.find(customId);
+        if (unitIt != _downloadUnits.end() && !unitIt->second.patchBase.empty()) {
+            applyDownloadedPatch(customId, storagePath);
         } else {
-            fileError(customId, "Asset file verification failed after downloaded");
+            checkDownloadedAsset(customId, storagePath);
         }
     }
 }
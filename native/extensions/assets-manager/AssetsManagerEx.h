@@ -206,6 +206,15 @@ public:
         _verifyCallback = callback;
     };
 
+    /** @brief Set a verification function which is thread safe, it runs on worker threads while the next assets are downloading.
+     It takes precedence over the callback set by setVerifyCallback, which always runs on the main thread.
+     * @param callback  The verify callback function
+     * @js NA
+     */
+    void setAsyncVerifyCallback(const VerifyCallback &callback) {
+        _asyncVerifyCallback = callback;
+    };
+
     /** @brief Set the event callback for receiving update process events
      * @param callback  The event callback function
      */
@@ -238,6 +247,11 @@ protected:
     void updateSucceed();
     bool decompress(const std::string &filename);
     void decompressDownloadedZip(const std::string &customId, const std::string &storagePath);
+    void checkDownloadedAsset(const std::string &customId, const std::string &storagePath);
+    void verifyDownloadedAsset(const std::string &customId, const std::string &storagePath, const Manifest::Asset &asset);
+    void onAssetVerified(const std::string &customId, const std::string &storagePath, bool compressed, bool verified);
+    void applyDownloadedPatch(const std::string &customId, const std::string &patchPath);
+    void downloadFullAsset(const std::string &customId);
 
     /** @brief Update a list of assets under the current AssetsManagerEx context
      */
@@ -403,6 +417,9 @@ private:
     //! Callback function to verify the downloaded assets
     VerifyCallback _verifyCallback = nullptr;
 
+    //! Thread safe callback function to verify the downloaded assets on worker threads
+    VerifyCallback _asyncVerifyCallback = nullptr;
+
     //! Callback function to dispatch events
     EventCallback _eventCallback = nullptr;
 
@@ -26,6 +26,8 @@ THE SOFTWARE.
 
 #include "AsyncTaskPool.h"
 
+#include <algorithm>
+
 namespace cc {
 
 AsyncTaskPool *AsyncTaskPool::sAsyncTaskPool = nullptr;
@@ -42,7 +44,15 @@ void AsyncTaskPool::destroyInstance() {
     sAsyncTaskPool = nullptr;
 }
 
-AsyncTaskPool::AsyncTaskPool() = default;
+AsyncTaskPool::AsyncTaskPool() {
+    // hashing and unzipping are CPU bound, let them use a few cores
+    const uint32_t workerCount = std::max(1U, std::min(4U, std::thread::hardware_concurrency() / 2));
+    for (int i = 0; i < static_cast<int>(TaskType::TASK_MAX_TYPE); ++i) {
+        const auto type          = static_cast<TaskType>(i);
+        const bool multiThreaded = type == TaskType::TASK_VERIFY || type == TaskType::TASK_DECOMPRESS;
+        _threadTasks[i]          = std::make_unique<ThreadTasks>(multiThreaded ? workerCount : 1);
+    }
+}
 
 AsyncTaskPool::~AsyncTaskPool() = default;
 
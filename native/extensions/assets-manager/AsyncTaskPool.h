@@ -57,6 +57,8 @@ public:
         TASK_IO,
         TASK_NETWORK,
         TASK_OTHER,
+        TASK_VERIFY,     // served by several threads, tasks may finish out of order
+        TASK_DECOMPRESS, // served by several threads, tasks may finish out of order
         TASK_MAX_TYPE,
     };
 
@@ -83,7 +85,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others, each type of task has its own threads to deal with it.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task thread.
      * @param callbackParam parameter used by the callback.
      * @param f task can be lambda function.
@@ -101,29 +103,31 @@ protected:
         };
 
     public:
-        ThreadTasks() {
-            _thread = std::thread(
-                [this] {
-                    for (;;) {
-                        std::function<void()> task;
-                        AsyncTaskCallBack     callback;
-                        {
-                            std::unique_lock<std::mutex> lock(this->_queueMutex);
-                            this->_condition.wait(lock,
-                                                  [this] { return this->_stop || !this->_tasks.empty(); });
-                            if (this->_stop && this->_tasks.empty()) {
-                                return;
+        explicit ThreadTasks(uint32_t threadCount = 1) {
+            for (uint32_t i = 0; i < threadCount; ++i) {
+                _threads.emplace_back(
+                    [this] {
+                        for (;;) {
+                            std::function<void()> task;
+                            AsyncTaskCallBack     callback;
+                            {
+                                std::unique_lock<std::mutex> lock(this->_queueMutex);
+                                this->_condition.wait(lock,
+                                                      [this] { return this->_stop || !this->_tasks.empty(); });
+                                if (this->_stop && this->_tasks.empty()) {
+                                    return;
+                                }
+                                task     = std::move(this->_tasks.front());
+                                callback = std::move(this->_taskCallBacks.front());
+                                this->_tasks.pop();
+                                this->_taskCallBacks.pop();
                             }
-                            task     = std::move(this->_tasks.front());
-                            callback = std::move(this->_taskCallBacks.front());
-                            this->_tasks.pop();
-                            this->_taskCallBacks.pop();
-                        }
 
-                        task();
-                        CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread([&, callback] { callback.callback(callback.callbackParam); });
-                    }
-                });
+                            task();
+                            CC_CURRENT_ENGINE()->getScheduler()->performFunctionInCocosThread([&, callback] { callback.callback(callback.callbackParam); });
+                        }
+                    });
+            }
         }
         ~ThreadTasks() {
             {
@@ -138,7 +142,9 @@ protected:
                 }
             }
             _condition.notify_all();
-            _thread.join();
+            for (auto &thread : _threads) {
+                thread.join();
+            }
         }
         void clear() {
             std::unique_lock<std::mutex> lock(_queueMutex);
@@ -172,8 +178,8 @@ protected:
         }
 
     private:
-        // need to keep track of thread so we can join them
-        std::thread _thread;
+        // need to keep track of threads so we can join them
+        std::vector<std::thread> _threads;
         // the task queue
         std::queue<std::function<void()>> _tasks;
         std::queue<AsyncTaskCallBack>     _taskCallBacks;
@@ -185,19 +191,19 @@ protected:
     };
 
     //tasks
-    ThreadTasks _threadTasks[static_cast<int>(TaskType::TASK_MAX_TYPE)];
+    std::unique_ptr<ThreadTasks> _threadTasks[static_cast<int>(TaskType::TASK_MAX_TYPE)];
 
     static AsyncTaskPool *sAsyncTaskPool;
 };
 
 inline void AsyncTaskPool::stopTasks(TaskType type) {
-    auto &threadTask = _threadTasks[static_cast<int>(type)];
+    auto &threadTask = *_threadTasks[static_cast<int>(type)];
     threadTask.clear();
 }
 
 template <class F>
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, const TaskCallBack &callback, void *callbackParam, F &&f) {
-    auto &threadTask = _threadTasks[static_cast<int>(type)];
+    auto &threadTask = *_threadTasks[static_cast<int>(type)];
 
     threadTask.enqueue(callback, callbackParam, f);
 }
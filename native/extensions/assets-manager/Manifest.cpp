@@ -26,8 +26,8 @@
 
 #include "Manifest.h"
 #include "base/Log.h"
-#include "json/prettywriter.h"
 #include "json/stringbuffer.h"
+#include "json/writer.h"
 
 #include <cstdio>
 #include <algorithm>
@@ -51,6 +51,8 @@
 #define KEY_SIZE            "size"
 #define KEY_COMPRESSED_FILE "compressedFile"
 #define KEY_DOWNLOAD_STATE  "downloadState"
+#define KEY_PATCH           "patch"
+#define KEY_PATCH_FROM      "from"
 
 NS_CC_EXT_BEGIN
 
@@ -99,15 +101,14 @@ Manifest::Manifest(const std::string &content, const std::string &manifestRoot)
 
 void Manifest::loadJson(const std::string &url) {
     clear();
-    std::string content;
     if (_fileUtils->isFileExist(url)) {
         // Load file content
-        content = _fileUtils->getStringFromFile(url);
+        _jsonContent = _fileUtils->getStringFromFile(url);
 
-        if (content.empty()) {
+        if (_jsonContent.empty()) {
             CC_LOG_DEBUG("Fail to retrieve local file content: %s\n", url.c_str());
         } else {
-            loadJsonFromString(content);
+            parseJsonContent();
         }
     }
 }
@@ -116,17 +117,24 @@ void Manifest::loadJsonFromString(const std::string &content) {
     if (content.empty()) {
         CC_LOG_DEBUG("Fail to parse empty json content.");
     } else {
-        // Parse file with rapid json
-        _json.Parse<0>(content.c_str());
-        // Print error
-        if (_json.HasParseError()) {
-            size_t offset = _json.GetErrorOffset();
-            if (offset > 0) {
-                offset--;
-            }
-            std::string errorSnippet = content.substr(offset, 10);
-            CC_LOG_DEBUG("File parse error %d at <%s>\n", _json.GetParseError(), errorSnippet.c_str());
+        _jsonContent = content;
+        parseJsonContent();
+    }
+}
+
+void Manifest::parseJsonContent() {
+    // Parse in place, strings of the document point into _jsonContent instead of being copied,
+    // the error offset is still valid as the buffer is only modified behind the parsing position
+    _assetEntries.clear();
+    _json.ParseInsitu<0>(&_jsonContent[0]);
+    // Print error
+    if (_json.HasParseError()) {
+        size_t offset = _json.GetErrorOffset();
+        if (offset > 0) {
+            offset--;
         }
+        std::string errorSnippet = _jsonContent.substr(offset, 10);
+        CC_LOG_DEBUG("File parse error %d at <%s>\n", _json.GetParseError(), errorSnippet.c_str());
     }
 }
 
@@ -373,25 +381,40 @@ void Manifest::setAssetDownloadState(const std::string &key, const Manifest::Dow
     if (valueIt != _assets.end()) {
         valueIt->second.downloadState = state;
 
-        // Update json object
-        if (_json.IsObject()) {
-            if (_json.HasMember(KEY_ASSETS)) {
-                rapidjson::Value &assets = _json[KEY_ASSETS];
-                if (assets.IsObject()) {
-                    if (assets.HasMember(key.c_str())) {
-                        rapidjson::Value &entry = assets[key.c_str()];
-                        if (entry.HasMember(KEY_DOWNLOAD_STATE) && entry[KEY_DOWNLOAD_STATE].IsInt()) {
-                            entry[KEY_DOWNLOAD_STATE].SetInt(static_cast<int>(state));
-                        } else {
-                            entry.AddMember<int>(KEY_DOWNLOAD_STATE, static_cast<int>(state), _json.GetAllocator());
-                        }
-                    }
-                }
+        // Update json object, entries are indexed once instead of searching the assets object on every state change
+        if (_assetEntries.empty()) {
+            indexAssetEntries();
+        }
+        auto entryIt = _assetEntries.find(key);
+        if (entryIt != _assetEntries.end()) {
+            rapidjson::Value &entry   = *entryIt->second;
+            auto              stateIt = entry.FindMember(KEY_DOWNLOAD_STATE);
+            if (stateIt != entry.MemberEnd() && stateIt->value.IsInt()) {
+                stateIt->value.SetInt(static_cast<int>(state));
+            } else {
+                entry.AddMember<int>(KEY_DOWNLOAD_STATE, static_cast<int>(state), _json.GetAllocator());
             }
         }
     }
 }
 
+void Manifest::indexAssetEntries() {
+    if (!_json.IsObject()) {
+        return;
+    }
+    auto assetsIt = _json.FindMember(KEY_ASSETS);
+    if (assetsIt == _json.MemberEnd() || !assetsIt->value.IsObject()) {
+        return;
+    }
+    rapidjson::Value &assets = assetsIt->value;
+    _assetEntries.reserve(assets.MemberCount());
+    for (auto itr = assets.MemberBegin(); itr != assets.MemberEnd(); ++itr) {
+        if (itr->value.IsObject()) {
+            _assetEntries.emplace(std::string(itr->name.GetString(), itr->name.GetStringLength()), &itr->value);
+        }
+    }
+}
+
 void Manifest::clear() {
     if (_versionLoaded || _loaded) {
         _groups.clear();
@@ -407,6 +430,7 @@ void Manifest::clear() {
 
     if (_loaded) {
         _assets.clear();
+        _assetEntries.clear();
         _searchPaths.clear();
         _loaded = false;
     }
@@ -416,34 +440,55 @@ Manifest::Asset Manifest::parseAsset(const std::string &path, const rapidjson::V
     Asset asset;
     asset.path = path;
 
-    if (json.HasMember(KEY_MD5) && json[KEY_MD5].IsString()) {
-        asset.md5 = json[KEY_MD5].GetString();
+    auto itr = json.FindMember(KEY_MD5);
+    if (itr != json.MemberEnd() && itr->value.IsString()) {
+        asset.md5 = itr->value.GetString();
     } else {
         asset.md5 = "";
     }
 
-    if (json.HasMember(KEY_PATH) && json[KEY_PATH].IsString()) {
-        asset.path = json[KEY_PATH].GetString();
+    itr = json.FindMember(KEY_PATH);
+    if (itr != json.MemberEnd() && itr->value.IsString()) {
+        asset.path = itr->value.GetString();
     }
 
-    if (json.HasMember(KEY_COMPRESSED) && json[KEY_COMPRESSED].IsBool()) {
-        asset.compressed = json[KEY_COMPRESSED].GetBool();
+    itr = json.FindMember(KEY_COMPRESSED);
+    if (itr != json.MemberEnd() && itr->value.IsBool()) {
+        asset.compressed = itr->value.GetBool();
     } else {
         asset.compressed = false;
     }
 
-    if (json.HasMember(KEY_SIZE) && json[KEY_SIZE].IsInt()) {
-        asset.size = static_cast<float>(json[KEY_SIZE].GetInt());
+    itr = json.FindMember(KEY_SIZE);
+    if (itr != json.MemberEnd() && itr->value.IsInt()) {
+        asset.size = static_cast<float>(itr->value.GetInt());
     } else {
         asset.size = 0;
     }
 
-    if (json.HasMember(KEY_DOWNLOAD_STATE) && json[KEY_DOWNLOAD_STATE].IsInt()) {
-        asset.downloadState = (json[KEY_DOWNLOAD_STATE].GetInt());
+    itr = json.FindMember(KEY_DOWNLOAD_STATE);
+    if (itr != json.MemberEnd() && itr->value.IsInt()) {
+        asset.downloadState = (itr->value.GetInt());
     } else {
         asset.downloadState = DownloadState::UNMARKED;
     }
 
+    asset.patchSize = 0;
+    itr             = json.FindMember(KEY_PATCH);
+    if (itr != json.MemberEnd() && itr->value.IsObject()) {
+        const rapidjson::Value &patch = itr->value;
+        auto                    pathIt = patch.FindMember(KEY_PATH);
+        auto                    fromIt = patch.FindMember(KEY_PATCH_FROM);
+        auto                    sizeIt = patch.FindMember(KEY_SIZE);
+        if (pathIt != patch.MemberEnd() && pathIt->value.IsString() && fromIt != patch.MemberEnd() && fromIt->value.IsString()) {
+            asset.patchPath = pathIt->value.GetString();
+            asset.patchFrom = fromIt->value.GetString();
+            if (sizeIt != patch.MemberEnd() && sizeIt->value.IsInt()) {
+                asset.patchSize = static_cast<float>(sizeIt->value.GetInt());
+            }
+        }
+    }
+
     return asset;
 }
 
@@ -508,10 +553,11 @@ void Manifest::loadManifest(const rapidjson::Document &json) {
     if (json.HasMember(KEY_ASSETS)) {
         const rapidjson::Value &assets = json[KEY_ASSETS];
         if (assets.IsObject()) {
+            _assets.reserve(assets.MemberCount());
             for (rapidjson::Value::ConstMemberIterator itr = assets.MemberBegin(); itr != assets.MemberEnd(); ++itr) {
-                std::string key   = itr->name.GetString();
+                std::string key(itr->name.GetString(), itr->name.GetStringLength());
                 Asset       asset = parseAsset(key, itr->value);
-                _assets.emplace(key, asset);
+                _assets.emplace(std::move(key), std::move(asset));
             }
         }
     }
@@ -532,8 +578,9 @@ void Manifest::loadManifest(const rapidjson::Document &json) {
 }
 
 void Manifest::saveToFile(const std::string &filepath) {
-    rapidjson::StringBuffer                          buffer;
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    // Compact output, the temporary manifest is rewritten at every save point during the update
+    rapidjson::StringBuffer                    buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     _json.Accept(writer);
 
     std::ofstream output(FileUtils::getInstance()->getSuitableFOpen(filepath), std::ofstream::out);
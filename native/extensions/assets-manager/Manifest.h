@@ -45,6 +45,8 @@ struct DownloadUnit {
     std::string storagePath;
     std::string customId;
     float       size;
+    //! The local file which the downloaded binary patch applies to, empty for a full download
+    std::string patchBase;
 };
 
 struct ManifestAsset {
@@ -53,6 +55,10 @@ struct ManifestAsset {
     bool        compressed;
     float       size;
     int         downloadState;
+    //! Binary patch from the previous version whose md5 is patchFrom [Optional]
+    std::string patchPath;
+    std::string patchFrom;
+    float       patchSize;
 };
 
 using DownloadUnits = std::unordered_map<std::string, DownloadUnit>;
@@ -163,6 +169,14 @@ protected:
      */
     void loadJsonFromString(const std::string &content);
 
+    /** @brief Parse _jsonContent in place into local json object
+     */
+    void parseJsonContent();
+
+    /** @brief Index the json entries of all assets for download state updates
+     */
+    void indexAssetEntries();
+
     /** @brief Parse the version file information into this manifest
      * @param versionUrl Url of the local version file
      */
@@ -284,7 +298,13 @@ private:
     //! All search paths
     std::vector<std::string> _searchPaths;
 
+    //! Buffer of the json content, the document is parsed in place and refers to it
+    std::string _jsonContent;
+
     rapidjson::Document _json;
+
+    //! Json entries of all assets by key, built on first download state update
+    std::unordered_map<std::string, rapidjson::Value *> _assetEntries;
 };
 
 NS_CC_EXT_END
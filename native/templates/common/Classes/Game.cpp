@@ -47,6 +47,9 @@ int Game::init() {
 
     _xxteaKey = "";
 
+    // run a benchmark described by a JSON file instead of playing, see cc::BenchmarkInfo
+    // cc::Benchmark::loadInfo("benchmark.json", &_benchmarkInfo);
+
     BaseGame::init();
     return 0;
 }
@@ -0,0 +1,459 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+// CPU side rendering benchmark: runs Root, the forward pipeline and the scene update
+// against gfx-empty, so the timings contain no GPU or driver cost.
+//
+// usage: test-render-benchmark [--models N] [--lights N] [--materials N] [--dynamic RATIO]
+//                              [--effect standard|unlit] [--frames N] [--warmup N]
+//                              [--width N] [--height N] [--output FILE]
+//
+// The report is a single JSON object written to stdout or to the output file.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "3d/assets/Mesh.h"
+#include "3d/misc/CreateMesh.h"
+#include "base/std/container/string.h"
+#include "base/std/container/vector.h"
+#include "base/threading/FrameArena.h"
+#include "core/Root.h"
+#include "core/assets/Material.h"
+#include "core/assets/RenderingSubMesh.h"
+#include "core/builtin/BuiltinResMgr.h"
+#include "core/scene-graph/Node.h"
+#include "core/scene-graph/Scene.h"
+#include "primitive/Box.h"
+#include "renderer/GFXDeviceManager.h"
+#include "renderer/core/ProgramLib.h"
+#include "renderer/gfx-base/GFXDescriptorSetCache.h"
+#include "renderer/gfx-base/GFXSwapchain.h"
+#include "renderer/pipeline/Define.h"
+#include "renderer/pipeline/GlobalDescriptorSetManager.h"
+#include "renderer/pipeline/custom/RenderInterfaceTypes.h"
+#include "scene/Camera.h"
+#include "scene/DirectionalLight.h"
+#include "scene/Model.h"
+#include "scene/RenderScene.h"
+#include "scene/RenderWindow.h"
+#include "scene/SphereLight.h"
+
+namespace {
+
+// allocation counters, the thread local ones only see the main thread so they can be attributed to stages
+struct AllocationCounter {
+    uint64_t count{0};
+    uint64_t bytes{0};
+};
+
+thread_local AllocationCounter threadAllocations;
+std::atomic<uint64_t>          totalAllocationCount{0};
+std::atomic<uint64_t>          totalAllocationBytes{0};
+
+inline void *countedAlloc(std::size_t size) {
+    ++threadAllocations.count;
+    threadAllocations.bytes += size;
+    totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    totalAllocationBytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    void *ptr = countedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+void *operator new[](std::size_t size) {
+    void *ptr = countedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept { return countedAlloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept { return countedAlloc(size); }
+void  operator delete(void *ptr) noexcept { std::free(ptr); }
+void  operator delete[](void *ptr) noexcept { std::free(ptr); }
+void  operator delete(void *ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void  operator delete[](void *ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
+void  operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept { std::free(ptr); }
+void  operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept { std::free(ptr); }
+
+namespace {
+
+using namespace cc;
+
+struct BenchmarkOptions {
+    uint32_t      models{1000};
+    uint32_t      lights{16};
+    uint32_t      materials{8};
+    float         dynamicRatio{0.1F};
+    ccstd::string effect{"standard"};
+    uint32_t      frames{300};
+    uint32_t      warmup{30};
+    uint32_t      width{1280};
+    uint32_t      height{720};
+    ccstd::string output;
+};
+
+enum class Stage : uint32_t {
+    PROGRAM_UPDATE,
+    SCENE_GRAPH,
+    EXTRACT_CAMERAS,
+    SCENE_UPDATE,
+    PIPELINE_RENDER,
+    PRESENT,
+    FRAME,
+    COUNT,
+};
+
+constexpr const char *STAGE_NAMES[] = {
+    "programUpdate",
+    "sceneGraph",
+    "extractCameras",
+    "sceneUpdate",
+    "pipelineRender",
+    "present",
+    "frame",
+};
+static_assert(sizeof(STAGE_NAMES) / sizeof(STAGE_NAMES[0]) == static_cast<size_t>(Stage::COUNT), "stage names mismatch");
+
+struct StageSamples {
+    ccstd::vector<double> micros;
+    uint64_t              allocationCount{0};
+    uint64_t              allocationBytes{0};
+};
+
+class StageScope {
+public:
+    explicit StageScope(StageSamples *samples)
+    : _samples(samples),
+      _allocations(threadAllocations),
+      _begin(std::chrono::steady_clock::now()) {}
+
+    ~StageScope() {
+        if (!_samples) return;
+        const auto end = std::chrono::steady_clock::now();
+        _samples->micros.push_back(std::chrono::duration<double, std::micro>(end - _begin).count());
+        _samples->allocationCount += threadAllocations.count - _allocations.count;
+        _samples->allocationBytes += threadAllocations.bytes - _allocations.bytes;
+    }
+
+private:
+    StageSamples *                        _samples{nullptr};
+    AllocationCounter                     _allocations;
+    std::chrono::steady_clock::time_point _begin;
+};
+
+bool parseOptions(int argc, char **argv, BenchmarkOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        const char *arg   = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return false;
+        }
+        if (!strcmp(arg, "--models")) {
+            options.models = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (!strcmp(arg, "--lights")) {
+            options.lights = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (!strcmp(arg, "--materials")) {
+            options.materials = std::max(1U, static_cast<uint32_t>(strtoul(value, nullptr, 10)));
+        } else if (!strcmp(arg, "--dynamic")) {
+            options.dynamicRatio = std::min(1.F, std::max(0.F, strtof(value, nullptr)));
+        } else if (!strcmp(arg, "--effect")) {
+            options.effect = value;
+        } else if (!strcmp(arg, "--frames")) {
+            options.frames = std::max(1U, static_cast<uint32_t>(strtoul(value, nullptr, 10)));
+        } else if (!strcmp(arg, "--warmup")) {
+            options.warmup = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (!strcmp(arg, "--width")) {
+            options.width = std::max(1U, static_cast<uint32_t>(strtoul(value, nullptr, 10)));
+        } else if (!strcmp(arg, "--height")) {
+            options.height = std::max(1U, static_cast<uint32_t>(strtoul(value, nullptr, 10)));
+        } else if (!strcmp(arg, "--output")) {
+            options.output = value;
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return false;
+        }
+        ++i;
+    }
+    return true;
+}
+
+const char *getHostArch() {
+#if defined(__aarch64__) || defined(_M_ARM64)
+    return "arm64";
+#elif defined(__x86_64__) || defined(_M_X64)
+    return "x86_64";
+#elif defined(__arm__) || defined(_M_ARM)
+    return "arm";
+#elif defined(__i386__) || defined(_M_IX86)
+    return "x86";
+#else
+    return "unknown";
+#endif
+}
+
+double getPercentile(ccstd::vector<double> sorted, double percentile) {
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end());
+    const auto index = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sorted.size()))) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void writeReport(FILE *out, const BenchmarkOptions &options, const StageSamples *stages, uint32_t drawCalls, uint32_t instances, uint64_t totalCount, uint64_t totalBytes) {
+    const auto frames = static_cast<double>(options.frames);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"host\": {\"arch\": \"%s\", \"gfx\": \"empty\", \"multiThread\": %s},\n",
+            getHostArch(), gfx::DeviceManager::isDetachDeviceThread() ? "true" : "false");
+    fprintf(out, "  \"config\": {\"models\": %u, \"lights\": %u, \"materials\": %u, \"dynamic\": %.3f, \"effect\": \"%s\", \"frames\": %u, \"warmup\": %u, \"width\": %u, \"height\": %u},\n",
+            options.models, options.lights, options.materials, options.dynamicRatio, options.effect.c_str(),
+            options.frames, options.warmup, options.width, options.height);
+    fprintf(out, "  \"stages\": {\n");
+    for (uint32_t i = 0; i < static_cast<uint32_t>(Stage::COUNT); ++i) {
+        const auto &samples = stages[i];
+        double      sum     = 0.0;
+        for (double micros : samples.micros) sum += micros;
+        const auto minmax = std::minmax_element(samples.micros.begin(), samples.micros.end());
+
+        fprintf(out, "    \"%s\": {\"meanUs\": %.3f, \"minUs\": %.3f, \"maxUs\": %.3f, \"p50Us\": %.3f, \"p95Us\": %.3f, \"allocsPerFrame\": %.2f, \"allocBytesPerFrame\": %.2f}%s\n",
+                STAGE_NAMES[i], sum / frames, *minmax.first, *minmax.second,
+                getPercentile(samples.micros, 0.5), getPercentile(samples.micros, 0.95),
+                static_cast<double>(samples.allocationCount) / frames, static_cast<double>(samples.allocationBytes) / frames,
+                i + 1 < static_cast<uint32_t>(Stage::COUNT) ? "," : "");
+    }
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"device\": {\"drawCalls\": %u, \"instances\": %u},\n", drawCalls, instances);
+    fprintf(out, "  \"allAllocationsPerFrame\": {\"count\": %.2f, \"bytes\": %.2f}\n",
+            static_cast<double>(totalCount) / frames, static_cast<double>(totalBytes) / frames);
+    fprintf(out, "}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    gfx::DeviceInfo deviceInfo;
+    deviceInfo.bindingMappingInfo = pipeline::bindingMappingInfo;
+    gfx::Device *device           = gfx::DeviceManager::createEmpty(deviceInfo);
+    if (!device) {
+        fprintf(stderr, "failed to create the empty device\n");
+        return 1;
+    }
+
+    gfx::SwapchainInfo swapchainInfo;
+    swapchainInfo.width       = options.width;
+    swapchainInfo.height      = options.height;
+    swapchainInfo.vsyncMode   = gfx::VsyncMode::OFF;
+    gfx::Swapchain *swapchain = device->createSwapchain(swapchainInfo);
+
+    auto *root = new Root(device);
+    root->initialize(swapchain);
+    if (!root->setRenderPipeline(nullptr) || !BuiltinResMgr::getInstance()->initBuiltinRes(device)) {
+        fprintf(stderr, "failed to initialize the render pipeline\n");
+        return 1;
+    }
+
+    auto *scene = new Scene("benchmark");
+    scene->addRef();
+    scene->activate();
+    scene::RenderScene *renderScene = scene->getRenderScene();
+
+    // camera looking down the model grid
+    const auto gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(std::max(options.models, 1U)))));
+    const auto extent   = static_cast<float>(gridSize) * 2.F;
+
+    auto *cameraNode = new Node("camera");
+    scene->addChild(cameraNode);
+    cameraNode->setPosition(extent * 0.5F, extent * 0.5F, extent);
+    cameraNode->lookAt(Vec3(extent * 0.5F, 0.F, -extent * 0.5F));
+
+    scene::ICameraInfo cameraInfo;
+    cameraInfo.name       = "benchmark";
+    cameraInfo.node       = cameraNode;
+    cameraInfo.projection = scene::CameraProjection::PERSPECTIVE;
+    cameraInfo.window     = root->getMainWindow();
+
+    IntrusivePtr<scene::Camera> camera = root->createCamera();
+    camera->initialize(cameraInfo);
+    camera->setFarClip(extent * 4.F);
+    camera->setClearFlag(gfx::ClearFlagBit::ALL);
+    camera->attachToScene(renderScene);
+    camera->setEnabled(true);
+
+    // main light plus a grid of sphere lights spread over the models
+    auto *sunNode = new Node("sun");
+    scene->addChild(sunNode);
+    sunNode->setRotationFromEuler(-45.F, 30.F, 0.F);
+    auto *sun = root->createLight<scene::DirectionalLight>();
+    sun->setNode(sunNode);
+    renderScene->addDirectionalLight(sun);
+    renderScene->setMainLight(sun);
+
+    for (uint32_t i = 0; i < options.lights; ++i) {
+        auto *lightNode = new Node("light");
+        scene->addChild(lightNode);
+        const float x = static_cast<float>(i % gridSize) * extent / static_cast<float>(gridSize);
+        const float z = -static_cast<float>(i / gridSize % gridSize) * extent / static_cast<float>(gridSize);
+        lightNode->setPosition(x, 2.F, z);
+
+        auto *light = root->createLight<scene::SphereLight>();
+        light->setNode(lightNode);
+        light->setRange(extent / static_cast<float>(std::max(1U, gridSize / 4U)));
+        light->setLuminance(1700.F);
+        renderScene->addSphereLight(light);
+    }
+
+    // materials only differ in their uniforms, so each one is a separate descriptor set
+    ccstd::vector<IntrusivePtr<Material>> materials;
+    for (uint32_t i = 0; i < options.materials; ++i) {
+        auto *        material = new Material();
+        IMaterialInfo materialInfo;
+        materialInfo.effectName = options.effect;
+        material->initialize(materialInfo);
+        const auto shade = static_cast<uint8_t>(64U + 191U * i / options.materials);
+        material->setPropertyColor("mainColor", Color{shade, static_cast<uint8_t>(255U - shade), 128, 255});
+        materials.emplace_back(material);
+    }
+
+    IntrusivePtr<Mesh>    mesh    = MeshUtils::createMesh(box());
+    RenderingSubMesh *    subMesh = mesh->getRenderingSubMeshes()[0];
+    ccstd::vector<Node *> dynamicNodes;
+    const auto            dynamicStep = options.dynamicRatio > 0.F ? static_cast<uint32_t>(std::round(1.F / options.dynamicRatio)) : 0U;
+    for (uint32_t i = 0; i < options.models; ++i) {
+        auto *node = new Node("model");
+        scene->addChild(node);
+        node->setPosition(static_cast<float>(i % gridSize) * 2.F, 0.F, -static_cast<float>(i / gridSize) * 2.F);
+        if (dynamicStep && i % dynamicStep == 0) dynamicNodes.push_back(node);
+
+        auto *model = root->createModel<scene::Model>();
+        model->setNode(node);
+        model->setTransform(node);
+        model->setVisFlags(Layers::Enum::DEFAULT);
+        model->createBoundingShape(mesh->getStruct().minPosition, mesh->getStruct().maxPosition);
+        model->initSubModel(0, subMesh, materials[i % materials.size()]);
+        renderScene->addModel(model);
+    }
+
+    StageSamples                    stages[static_cast<size_t>(Stage::COUNT)];
+    ccstd::vector<scene::Camera *>  cameras;
+    ccstd::vector<gfx::Swapchain *> swapchains{swapchain};
+    auto *                          pipelineRuntime = root->getPipeline();
+    uint64_t                        allocationCount = 0;
+    uint64_t                        allocationBytes = 0;
+
+    // mirrors the 3d part of Root::frameMove, the 2d batcher and the JS events are left out
+    const uint32_t totalFrames = options.warmup + options.frames;
+    for (uint32_t frame = 0; frame < totalFrames; ++frame) {
+        const bool measured = frame >= options.warmup;
+        if (frame == options.warmup) {
+            allocationCount = totalAllocationCount.load();
+            allocationBytes = totalAllocationBytes.load();
+        }
+        auto samples = [&](Stage stage) { return measured ? &stages[static_cast<uint32_t>(stage)] : nullptr; };
+
+        StageScope frameScope(samples(Stage::FRAME));
+        {
+            StageScope scope(samples(Stage::PROGRAM_UPDATE));
+            ProgramLib::getInstance()->update();
+        }
+        {
+            StageScope  scope(samples(Stage::SCENE_GRAPH));
+            const float offset = std::sin(static_cast<float>(frame) * 0.1F);
+            for (auto *node : dynamicNodes) {
+                const auto &pos = node->getPosition();
+                node->setPosition(pos.x, offset, pos.z);
+            }
+        }
+        {
+            StageScope scope(samples(Stage::EXTRACT_CAMERAS));
+            cameras.clear();
+            root->getMainWindow()->extractRenderCameras(cameras);
+        }
+        device->acquire(swapchains);
+        {
+            StageScope scope(samples(Stage::SCENE_UPDATE));
+            renderScene->update(frame);
+        }
+        {
+            StageScope scope(samples(Stage::PIPELINE_RENDER));
+            pipelineRuntime->render(cameras);
+        }
+        {
+            StageScope scope(samples(Stage::PRESENT));
+            device->present();
+            const auto *globalDSManager = pipelineRuntime->getGlobalDSManager();
+            if (globalDSManager && globalDSManager->getDescriptorSetCache()) {
+                globalDSManager->getDescriptorSetCache()->nextFrame();
+            }
+        }
+        Node::resetChangedFlags();
+        renderScene->flushRemovedModels();
+        FrameArena::nextFrame();
+    }
+
+    // render thread allocations are included too, the agent lags the main thread by at most one frame
+    allocationCount = totalAllocationCount.load() - allocationCount;
+    allocationBytes = totalAllocationBytes.load() - allocationBytes;
+
+    const uint32_t drawCalls = device->getNumDrawCalls();
+    const uint32_t instances = device->getNumInstances();
+
+    renderScene->removeModels();
+    renderScene->removeSphereLights();
+    renderScene->unsetMainLight(sun);
+    materials.clear();
+    mesh = nullptr;
+    camera->destroy();
+    camera = nullptr;
+    scene->release();
+    root->destroy();
+    delete root;
+    BuiltinResMgr::destroyInstance();
+    CC_SAFE_DESTROY_AND_DELETE(swapchain);
+    gfx::DeviceManager::destroy();
+
+    FILE *out = options.output.empty() ? stdout : fopen(options.output.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "failed to open %s\n", options.output.c_str());
+        return 1;
+    }
+    writeReport(out, options, stages, drawCalls, instances, allocationCount, allocationBytes);
+    if (out != stdout) fclose(out);
+
+    return 0;
+}
@@ -0,0 +1,242 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cfloat>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "cocos/core/geometry/AABB.h"
+#include "cocos/core/geometry/BVH.h"
+#include "cocos/core/geometry/Frustum.h"
+#include "cocos/core/geometry/Intersect.h"
+#include "cocos/core/geometry/Ray.h"
+#include "cocos/core/geometry/Sphere.h"
+#include "cocos/core/geometry/Triangle.h"
+#include "cocos/math/Mat4.h"
+#include "utils.h"
+
+using namespace cc;
+using benchmark_utils::randomFloat;
+
+namespace {
+
+// camera at the origin looking down -z, the scene extends 100 units around it
+void makeFrustum(geometry::Frustum *frustum) {
+    Mat4 view;
+    Mat4 proj;
+    Mat4::createLookAt(Vec3::ZERO, Vec3{0.F, 0.F, -1.F}, Vec3::UNIT_Y, &view);
+    Mat4::createPerspective(1.F, 1.5F, 0.1F, 100.F, &proj);
+    const Mat4 viewProj = proj * view;
+    frustum->update(viewProj, viewProj.getInversed());
+}
+
+geometry::Ray makeRay() {
+    const Vec3 d = Vec3{randomFloat(-1.F, 1.F), randomFloat(-1.F, 1.F), randomFloat(-1.F, 1.F)}.getNormalized();
+    return geometry::Ray{0.F, 0.F, 0.F, d.x, d.y, d.z};
+}
+
+void makeBoxes(size_t count, ccstd::vector<Vec3> &mins, ccstd::vector<Vec3> &maxs) {
+    mins.resize(count);
+    maxs.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vec3 center{randomFloat(-100.F, 100.F), randomFloat(-100.F, 100.F), randomFloat(-100.F, 100.F)};
+        const Vec3 extent{randomFloat(0.5F, 5.F), randomFloat(0.5F, 5.F), randomFloat(0.5F, 5.F)};
+        mins[i] = center - extent;
+        maxs[i] = center + extent;
+    }
+}
+
+void makeTriangles(size_t count, ccstd::vector<Vec3> &vertices) {
+    vertices.resize(count * 3);
+    for (size_t i = 0; i < count; ++i) {
+        const Vec3 center{randomFloat(-50.F, 50.F), randomFloat(-50.F, 50.F), randomFloat(-50.F, 50.F)};
+        for (size_t j = 0; j < 3; ++j) {
+            vertices[i * 3 + j] = center + Vec3{randomFloat(-3.F, 3.F), randomFloat(-3.F, 3.F), randomFloat(-3.F, 3.F)};
+        }
+    }
+}
+
+void setItems(benchmark::State &state) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_RayAABB(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> mins;
+    ccstd::vector<Vec3> maxs;
+    makeBoxes(count, mins, maxs);
+    ccstd::vector<geometry::AABB> boxes(count);
+    for (size_t i = 0; i < count; ++i) {
+        geometry::AABB::fromPoints(mins[i], maxs[i], &boxes[i]);
+    }
+    const geometry::Ray  ray = makeRay();
+    ccstd::vector<float> distances(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            distances[i] = geometry::rayAABB(ray, boxes[i]);
+        }
+        benchmark::DoNotOptimize(distances.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RayAABB)->Arg(1024);
+
+void BM_RayAABBs(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> mins;
+    ccstd::vector<Vec3> maxs;
+    makeBoxes(count, mins, maxs);
+    const geometry::Ray  ray = makeRay();
+    ccstd::vector<float> distances(count);
+    for (auto _ : state) {
+        geometry::rayAABBs(ray, mins.data(), maxs.data(), static_cast<uint32_t>(count), distances.data());
+        benchmark::DoNotOptimize(distances.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RayAABBs)->Arg(1024);
+
+void BM_RayTriangle(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> vertices;
+    makeTriangles(count, vertices);
+    ccstd::vector<geometry::Triangle> triangles;
+    triangles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vec3 *v = &vertices[i * 3];
+        triangles.emplace_back(v[0].x, v[0].y, v[0].z, v[1].x, v[1].y, v[1].z, v[2].x, v[2].y, v[2].z);
+    }
+    const geometry::Ray  ray = makeRay();
+    ccstd::vector<float> distances(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            distances[i] = geometry::rayTriangle(ray, triangles[i], true);
+        }
+        benchmark::DoNotOptimize(distances.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RayTriangle)->Arg(1024);
+
+void BM_RayTriangles(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> vertices;
+    makeTriangles(count, vertices);
+    const geometry::Ray  ray = makeRay();
+    ccstd::vector<float> distances(count);
+    for (auto _ : state) {
+        geometry::rayTriangles(ray, vertices.data(), static_cast<uint32_t>(count), true, distances.data());
+        benchmark::DoNotOptimize(distances.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_RayTriangles)->Arg(1024);
+
+void BM_AABBFrustum(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> mins;
+    ccstd::vector<Vec3> maxs;
+    makeBoxes(count, mins, maxs);
+    ccstd::vector<geometry::AABB> boxes(count);
+    for (size_t i = 0; i < count; ++i) {
+        geometry::AABB::fromPoints(mins[i], maxs[i], &boxes[i]);
+    }
+    geometry::Frustum frustum;
+    makeFrustum(&frustum);
+    for (auto _ : state) {
+        int visible = 0;
+        for (const auto &box : boxes) {
+            visible += geometry::aabbFrustum(box, frustum);
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_AABBFrustum)->Arg(1024)->Arg(16384);
+
+void BM_SphereFrustum(benchmark::State &state) {
+    const auto                          count = static_cast<size_t>(state.range(0));
+    std::unique_ptr<geometry::Sphere[]> spheres{new geometry::Sphere[count]};
+    for (size_t i = 0; i < count; ++i) {
+        spheres[i].setCenter({randomFloat(-100.F, 100.F), randomFloat(-100.F, 100.F), randomFloat(-100.F, 100.F)});
+        spheres[i].setRadius(randomFloat(0.5F, 5.F));
+    }
+    geometry::Frustum frustum;
+    makeFrustum(&frustum);
+    for (auto _ : state) {
+        int visible = 0;
+        for (size_t i = 0; i < count; ++i) {
+            visible += geometry::sphereFrustum(spheres[i], frustum);
+        }
+        benchmark::DoNotOptimize(visible);
+    }
+    setItems(state);
+}
+BENCHMARK(BM_SphereFrustum)->Arg(1024)->Arg(16384);
+
+void BM_BVHBuild(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> mins;
+    ccstd::vector<Vec3> maxs;
+    makeBoxes(count, mins, maxs);
+    geometry::BVH bvh;
+    for (auto _ : state) {
+        bvh.build(mins.data(), maxs.data(), static_cast<uint32_t>(count));
+        benchmark::DoNotOptimize(bvh.getNodeCount());
+    }
+    setItems(state);
+}
+BENCHMARK(BM_BVHBuild)->Arg(1024)->Arg(16384);
+
+// closest hit of rays from the center, the range is the number of boxes in the tree
+void BM_BVHRaycast(benchmark::State &state) {
+    const auto          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<Vec3> mins;
+    ccstd::vector<Vec3> maxs;
+    makeBoxes(count, mins, maxs);
+    geometry::BVH bvh;
+    bvh.build(mins.data(), maxs.data(), static_cast<uint32_t>(count));
+    ccstd::vector<geometry::Ray> rays;
+    for (size_t i = 0; i < 256; ++i) {
+        rays.emplace_back(makeRay());
+    }
+    for (auto _ : state) {
+        float hits = 0.F;
+        for (const auto &ray : rays) {
+            hits += bvh.raycast(ray, FLT_MAX, geometry::ERaycastMode::CLOSEST, [&](uint32_t p, float /*maxDistance*/) {
+                return geometry::rayAABB2(ray, mins[p], maxs[p]);
+            });
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(rays.size()));
+}
+BENCHMARK(BM_BVHRaycast)->Arg(1024)->Arg(16384);
+
+} // namespace
@@ -0,0 +1,66 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+// Micro benchmarks of the native engine, run on gfx-empty so scene objects can be created without a GPU.
+// See the README of unit-test for the command line.
+
+#include "benchmark/benchmark.h"
+
+#include "cocos/core/Root.h"
+#include "cocos/renderer/GFXDeviceManager.h"
+#include "cocos/renderer/gfx-base/GFXSwapchain.h"
+#include "cocos/renderer/pipeline/Define.h"
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    cc::gfx::DeviceInfo deviceInfo;
+    deviceInfo.bindingMappingInfo = cc::pipeline::bindingMappingInfo;
+    cc::gfx::Device *device       = cc::gfx::DeviceManager::createEmpty(deviceInfo);
+    if (!device) {
+        fprintf(stderr, "failed to create the empty device\n");
+        return 1;
+    }
+
+    cc::gfx::SwapchainInfo swapchainInfo;
+    swapchainInfo.width           = 1280;
+    swapchainInfo.height          = 720;
+    swapchainInfo.vsyncMode       = cc::gfx::VsyncMode::OFF;
+    cc::gfx::Swapchain *swapchain = device->createSwapchain(swapchainInfo);
+
+    // models and cameras take their device from the root
+    auto *root = new cc::Root(device);
+    root->initialize(swapchain);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    root->destroy();
+    delete root;
+    CC_SAFE_DESTROY_AND_DELETE(swapchain);
+    cc::gfx::DeviceManager::destroy();
+    return 0;
+}
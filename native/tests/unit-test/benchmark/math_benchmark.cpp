@@ -0,0 +1,230 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "benchmark/benchmark.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/MathUtil.h"
+#include "cocos/math/Quaternion.h"
+#include "utils.h"
+
+using namespace cc;
+using benchmark_utils::fillRandom;
+using benchmark_utils::fillRandomQuaternions;
+
+namespace {
+
+// affine matrices composed from random transforms, 16 floats for each
+void makeMatrices(ccstd::vector<float> &matrices, size_t count) {
+    ccstd::vector<float> rotations;
+    ccstd::vector<float> translations;
+    ccstd::vector<float> scales;
+    fillRandomQuaternions(rotations, count);
+    fillRandom(translations, count * 3, -100.F, 100.F);
+    fillRandom(scales, count * 3, 0.5F, 2.F);
+    matrices.resize(count * 16);
+    MathUtil::fromRTSBatch(rotations.data(), translations.data(), scales.data(), static_cast<uint32_t>(count), matrices.data());
+}
+
+ccstd::vector<Mat4> toMat4(const ccstd::vector<float> &matrices) {
+    ccstd::vector<Mat4> result;
+    result.reserve(matrices.size() / 16);
+    for (size_t i = 0; i < matrices.size(); i += 16) {
+        result.emplace_back(&matrices[i]);
+    }
+    return result;
+}
+
+void setItems(benchmark::State &state) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+void BM_Mat4Multiply(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> matrices;
+    makeMatrices(matrices, count);
+    Mat4 m;
+    Mat4::createPerspective(1.F, 1.5F, 0.1F, 1000.F, &m);
+    const ccstd::vector<Mat4> src = toMat4(matrices);
+    ccstd::vector<Mat4>       dst(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            Mat4::multiply(m, src[i], &dst[i]);
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4Multiply)->Arg(64)->Arg(4096);
+
+void BM_Mat4MultiplyBatch(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> matrices;
+    makeMatrices(matrices, count);
+    Mat4 m;
+    Mat4::createPerspective(1.F, 1.5F, 0.1F, 1000.F, &m);
+    ccstd::vector<float> dst(count * 16);
+    for (auto _ : state) {
+        MathUtil::multiplyMatrixBatch(m.m, matrices.data(), static_cast<uint32_t>(count), dst.data());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4MultiplyBatch)->Arg(64)->Arg(4096);
+
+void BM_Mat4Inverse(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> matrices;
+    makeMatrices(matrices, count);
+    const ccstd::vector<Mat4> src = toMat4(matrices);
+    ccstd::vector<Mat4>       dst(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = src[i].getInversed();
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4Inverse)->Arg(64)->Arg(4096);
+
+void BM_Mat4InvertAffineBatch(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> matrices;
+    makeMatrices(matrices, count);
+    ccstd::vector<float> dst(count * 16);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MathUtil::invertAffineBatch(matrices.data(), static_cast<uint32_t>(count), dst.data()));
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4InvertAffineBatch)->Arg(64)->Arg(4096);
+
+void BM_Mat4FromRTS(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> rotations;
+    ccstd::vector<float> translations;
+    ccstd::vector<float> scales;
+    fillRandomQuaternions(rotations, count);
+    fillRandom(translations, count * 3, -100.F, 100.F);
+    fillRandom(scales, count * 3, 0.5F, 2.F);
+    ccstd::vector<Mat4> dst(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const float *r = &rotations[i * 4];
+            const float *t = &translations[i * 3];
+            const float *s = &scales[i * 3];
+            Mat4::fromRTS(Quaternion{r[0], r[1], r[2], r[3]}, Vec3{t[0], t[1], t[2]}, Vec3{s[0], s[1], s[2]}, &dst[i]);
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4FromRTS)->Arg(64)->Arg(4096);
+
+void BM_Mat4FromRTSBatch(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> rotations;
+    ccstd::vector<float> translations;
+    ccstd::vector<float> scales;
+    fillRandomQuaternions(rotations, count);
+    fillRandom(translations, count * 3, -100.F, 100.F);
+    fillRandom(scales, count * 3, 0.5F, 2.F);
+    ccstd::vector<float> dst(count * 16);
+    for (auto _ : state) {
+        MathUtil::fromRTSBatch(rotations.data(), translations.data(), scales.data(), static_cast<uint32_t>(count), dst.data());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_Mat4FromRTSBatch)->Arg(64)->Arg(4096);
+
+void BM_QuaternionSlerp(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> from;
+    ccstd::vector<float> to;
+    fillRandomQuaternions(from, count);
+    fillRandomQuaternions(to, count);
+    ccstd::vector<Quaternion> dst(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const float *a = &from[i * 4];
+            const float *b = &to[i * 4];
+            Quaternion::slerp(Quaternion{a[0], a[1], a[2], a[3]}, Quaternion{b[0], b[1], b[2], b[3]}, 0.3F, &dst[i]);
+        }
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_QuaternionSlerp)->Arg(64)->Arg(4096);
+
+void BM_QuaternionSlerpBatch(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> from;
+    ccstd::vector<float> to;
+    fillRandomQuaternions(from, count);
+    fillRandomQuaternions(to, count);
+    ccstd::vector<float> dst(count * 4);
+    for (auto _ : state) {
+        MathUtil::slerpQuaternionBatch(from.data(), to.data(), 0.3F, static_cast<uint32_t>(count), dst.data());
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_QuaternionSlerpBatch)->Arg(64)->Arg(4096);
+
+void BM_TransformAABBBatch(benchmark::State &state) {
+    const auto           count = static_cast<size_t>(state.range(0));
+    ccstd::vector<float> matrices;
+    ccstd::vector<float> centers;
+    ccstd::vector<float> extents;
+    makeMatrices(matrices, count);
+    fillRandom(centers, count * 3, -10.F, 10.F);
+    fillRandom(extents, count * 3, 0.1F, 5.F);
+    ccstd::vector<const float *> matrixPtrs(count);
+    for (size_t i = 0; i < count; ++i) {
+        matrixPtrs[i] = &matrices[i * 16];
+    }
+    ccstd::vector<float> outCenters(count * 3);
+    ccstd::vector<float> outExtents(count * 3);
+    for (auto _ : state) {
+        MathUtil::transformAABBBatch(matrixPtrs.data(), centers.data(), extents.data(), static_cast<uint32_t>(count),
+                                     outCenters.data(), outExtents.data());
+        benchmark::DoNotOptimize(outCenters.data());
+        benchmark::DoNotOptimize(outExtents.data());
+        benchmark::ClobberMemory();
+    }
+    setItems(state);
+}
+BENCHMARK(BM_TransformAABBBatch)->Arg(64)->Arg(4096);
+
+} // namespace
@@ -0,0 +1,231 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <atomic>
+
+#include "benchmark/benchmark.h"
+#include "cocos/base/threading/MessageQueue.h"
+#include "cocos/core/Root.h"
+#include "cocos/core/geometry/Frustum.h"
+#include "cocos/core/scene-graph/Node.h"
+#include "cocos/renderer/pipeline/Define.h"
+#include "cocos/renderer/pipeline/RenderQueue.h"
+#include "cocos/scene/Camera.h"
+#include "cocos/scene/Model.h"
+#include "cocos/scene/Octree.h"
+#include "utils.h"
+
+using namespace cc;
+using benchmark_utils::randomFloat;
+
+namespace {
+
+void setItems(benchmark::State &state) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+// models with random world bounds in the default octree range, no node or mesh is attached
+ccstd::vector<IntrusivePtr<scene::Model>> makeModels(size_t count) {
+    ccstd::vector<IntrusivePtr<scene::Model>> models;
+    models.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Vec3 center{randomFloat(-500.F, 500.F), randomFloat(-50.F, 50.F), randomFloat(-500.F, 500.F)};
+        const Vec3 extent{randomFloat(0.5F, 5.F), randomFloat(0.5F, 5.F), randomFloat(0.5F, 5.F)};
+        IntrusivePtr<scene::Model> model = new scene::Model();
+        model->initialize();
+        model->setVisFlags(Layers::Enum::DEFAULT);
+        model->createBoundingShape(center - extent, center + extent);
+        models.emplace_back(model);
+    }
+    return models;
+}
+
+void destroyModels(ccstd::vector<IntrusivePtr<scene::Model>> &models) {
+    for (auto &model : models) {
+        model->destroy();
+    }
+    models.clear();
+}
+
+void BM_OctreeInsert(benchmark::State &state) {
+    const auto count  = static_cast<size_t>(state.range(0));
+    auto       models = makeModels(count);
+    for (auto _ : state) {
+        scene::Octree octree;
+        octree.initialize(scene::OctreeInfo{});
+        for (auto &model : models) {
+            octree.insert(model);
+        }
+        state.PauseTiming();
+        for (auto &model : models) {
+            octree.remove(model);
+        }
+        state.ResumeTiming();
+    }
+    setItems(state);
+    destroyModels(models);
+}
+BENCHMARK(BM_OctreeInsert)->Arg(1024)->Arg(16384);
+
+void BM_OctreeQuery(benchmark::State &state) {
+    const auto    count  = static_cast<size_t>(state.range(0));
+    auto          models = makeModels(count);
+    scene::Octree octree;
+    octree.initialize(scene::OctreeInfo{});
+    for (auto &model : models) {
+        octree.insert(model);
+    }
+
+    IntrusivePtr<scene::Camera> camera = new scene::Camera(Root::getInstance()->getDevice());
+    camera->setVisibility(static_cast<uint32_t>(Layers::Enum::DEFAULT));
+    Mat4 view;
+    Mat4 proj;
+    Mat4::createLookAt(Vec3{0.F, 10.F, 0.F}, Vec3{0.F, 10.F, -1.F}, Vec3::UNIT_Y, &view);
+    Mat4::createPerspective(1.F, 1.5F, 0.1F, 1000.F, &proj);
+    const Mat4        viewProj = proj * view;
+    geometry::Frustum frustum;
+    frustum.update(viewProj, viewProj.getInversed());
+
+    ccstd::vector<scene::Model *> results;
+    for (auto _ : state) {
+        results.clear();
+        octree.queryVisibility(camera, frustum, false, results);
+        benchmark::DoNotOptimize(results.data());
+    }
+    setItems(state);
+    state.counters["visible"] = static_cast<double>(results.size());
+
+    for (auto &model : models) {
+        octree.remove(model);
+    }
+    destroyModels(models);
+    camera->destroy();
+}
+BENCHMARK(BM_OctreeQuery)->Arg(1024)->Arg(16384);
+
+// full tree of the given depth with fanout children under each inner node
+void makeHierarchy(Node *parent, uint32_t fanout, uint32_t depth, ccstd::vector<Node *> &leaves) {
+    for (uint32_t i = 0; i < fanout; ++i) {
+        auto *child = new Node();
+        child->setPosition(randomFloat(-1.F, 1.F), randomFloat(-1.F, 1.F), randomFloat(-1.F, 1.F));
+        child->setRotationFromEuler(randomFloat(0.F, 90.F), randomFloat(0.F, 90.F), 0.F);
+        parent->addChild(child);
+        if (depth > 1) {
+            makeHierarchy(child, fanout, depth - 1, leaves);
+        } else {
+            leaves.emplace_back(child);
+        }
+    }
+}
+
+// moves the root and pulls the world matrices of all leaves, like the scene update of a frame,
+// the range is the fanout of a tree 4 levels deep
+void BM_NodeTransformPropagation(benchmark::State &state) {
+    const auto            fanout = static_cast<uint32_t>(state.range(0));
+    IntrusivePtr<Node>    root   = new Node("root");
+    ccstd::vector<Node *> leaves;
+    makeHierarchy(root, fanout, 4, leaves);
+
+    float x = 0.F;
+    for (auto _ : state) {
+        x += 0.01F;
+        root->setPosition(x, 0.F, 0.F);
+        for (auto *leaf : leaves) {
+            benchmark::DoNotOptimize(leaf->getWorldMatrix().m[12]);
+        }
+        Node::resetChangedFlags();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(leaves.size()));
+}
+BENCHMARK(BM_NodeTransformPropagation)->Arg(4)->Arg(8);
+
+pipeline::RenderQueueCreateInfo makeQueueInfo(bool sortByKey) {
+    pipeline::RenderQueueCreateInfo info;
+    info.sortFunc  = pipeline::opaqueCompareFn;
+    info.sortByKey = sortByKey;
+    return info;
+}
+
+// the range is the number of render passes, with 16 priorities and 64 shaders
+void sortRenderQueue(benchmark::State &state, bool sortByKey) {
+    const auto                          count = static_cast<size_t>(state.range(0));
+    ccstd::vector<pipeline::RenderPass> passes(count);
+    for (auto &pass : passes) {
+        pass.hash     = static_cast<uint>(benchmark_utils::randomEngine()() % 16) << 16;
+        pass.depth    = randomFloat(0.1F, 1000.F);
+        pass.shaderID = static_cast<uint>(benchmark_utils::randomEngine()() % 64);
+    }
+    pipeline::RenderQueue queue{nullptr, makeQueueInfo(sortByKey)};
+    for (auto _ : state) {
+        state.PauseTiming();
+        queue.clear();
+        for (const auto &pass : passes) {
+            queue.insertRenderPass(pass);
+        }
+        state.ResumeTiming();
+        queue.sort();
+    }
+    setItems(state);
+}
+
+void BM_RenderQueueSort(benchmark::State &state) {
+    sortRenderQueue(state, false);
+}
+BENCHMARK(BM_RenderQueueSort)->Arg(256)->Arg(4096);
+
+void BM_RenderQueueSortByKey(benchmark::State &state) {
+    sortRenderQueue(state, true);
+}
+BENCHMARK(BM_RenderQueueSortByKey)->Arg(256)->Arg(4096);
+
+// messages per second through a queue with a consumer thread, the range is the number of messages per kick
+void BM_MessageQueueThroughput(benchmark::State &state) {
+    const auto            count = static_cast<uint32_t>(state.range(0));
+    auto *                queue = new MessageQueue();
+    std::atomic<uint32_t> sum{0};
+    queue->setImmediateMode(false);
+    queue->runConsumerThread();
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < count; ++i) {
+            ENQUEUE_MESSAGE_2(
+                queue, BenchmarkMessage,
+                sum, &sum,
+                value, i,
+                {
+                    sum->fetch_add(value, std::memory_order_relaxed);
+                });
+        }
+        queue->kickAndWait();
+    }
+    setItems(state);
+    benchmark::DoNotOptimize(sum.load());
+
+    queue->terminateConsumerThread();
+    MessageQueue::freeChunksInFreeQueue(queue);
+    delete queue;
+}
+BENCHMARK(BM_MessageQueueThroughput)->Arg(1024)->Arg(16384)->UseRealTime();
+
+} // namespace
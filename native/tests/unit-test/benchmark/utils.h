@@ -0,0 +1,65 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <random>
+
+#include "cocos/base/std/container/vector.h"
+
+namespace benchmark_utils {
+
+// fixed seed so every run works on the same data
+inline std::mt19937 &randomEngine() {
+    static std::mt19937 engine{0x5eed};
+    return engine;
+}
+
+inline float randomFloat(float min, float max) {
+    return std::uniform_real_distribution<float>{min, max}(randomEngine());
+}
+
+inline void fillRandom(ccstd::vector<float> &values, size_t count, float min, float max) {
+    values.resize(count);
+    for (auto &value : values) {
+        value = randomFloat(min, max);
+    }
+}
+
+// normalized quaternions laid out as [x, y, z, w]
+inline void fillRandomQuaternions(ccstd::vector<float> &values, size_t count) {
+    fillRandom(values, count * 4, -1.F, 1.F);
+    for (size_t i = 0; i < count; ++i) {
+        float *q   = &values[i * 4];
+        float  len = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        len        = len > 0.F ? 1.F / len : 0.F;
+        for (int j = 0; j < 4; ++j) {
+            q[j] *= len;
+        }
+    }
+}
+
+} // namespace benchmark_utils
@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <thread>
+#include "core/memop/ConcurrentPool.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+using namespace memop;
+
+namespace {
+struct ConcurrentPoolTest {
+    int32_t tag{0};
+};
+
+std::atomic<int32_t> createdCount{0};
+
+ConcurrentPoolTest *createConcurrentTest() {
+    auto *obj = new ConcurrentPoolTest();
+    obj->tag  = createdCount++;
+    return obj;
+}
+
+const uint32_t BATCH_SIZE = 8;
+
+} // namespace
+
+TEST(ConcurrentPoolTest, allocFree) {
+    ConcurrentPool<ConcurrentPoolTest> pool(createConcurrentTest, BATCH_SIZE);
+    auto *                             obj = pool.alloc();
+    EXPECT_NE(obj, nullptr);
+    pool.free(obj);
+    EXPECT_EQ(pool.alloc(), obj);
+    pool.free(obj);
+    pool.destroy([](ConcurrentPoolTest *obj) { delete obj; });
+}
+
+TEST(ConcurrentPoolTest, allocArray) {
+    ConcurrentPool<ConcurrentPoolTest>  pool(createConcurrentTest, BATCH_SIZE);
+    ccstd::vector<ConcurrentPoolTest *> objs;
+    pool.allocArray(BATCH_SIZE * 5, objs);
+    EXPECT_EQ(objs.size(), BATCH_SIZE * 5);
+    ccstd::vector<ConcurrentPoolTest *> sorted = objs;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // freed objects are reused before new ones are created
+    pool.freeArray(objs);
+    const int32_t                       created = createdCount;
+    ccstd::vector<ConcurrentPoolTest *> again;
+    pool.allocArray(BATCH_SIZE * 5, again);
+    EXPECT_EQ(createdCount, created);
+
+    pool.freeArray(again);
+    pool.destroy([](ConcurrentPoolTest *obj) { delete obj; });
+}
+
+TEST(ConcurrentPoolTest, parallel) {
+    ConcurrentPool<ConcurrentPoolTest> pool(createConcurrentTest, BATCH_SIZE);
+    const int32_t                      created = createdCount;
+
+    constexpr uint32_t         THREAD_COUNT = 4;
+    constexpr uint32_t         HELD_COUNT   = 100;
+    std::atomic<bool>          failed{false};
+    ccstd::vector<std::thread> threads;
+    for (uint32_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&pool, &failed, t]() {
+            ccstd::vector<ConcurrentPoolTest *> objs;
+            for (uint32_t round = 0; round < 50; ++round) {
+                for (uint32_t i = 0; i < HELD_COUNT; ++i) {
+                    auto *obj = pool.alloc();
+                    obj->tag  = static_cast<int32_t>(t);
+                    objs.push_back(obj);
+                }
+                // an object handed to two threads at once would be overwritten by the other one
+                for (auto *obj : objs) {
+                    if (obj->tag != static_cast<int32_t>(t)) {
+                        failed = true;
+                    }
+                }
+                pool.freeArray(objs);
+                objs.clear();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(failed);
+    // every thread holds at most HELD_COUNT objects plus what its magazine caches
+    EXPECT_LE(createdCount - created, static_cast<int32_t>(THREAD_COUNT * (HELD_COUNT + BATCH_SIZE * 2)));
+    pool.destroy([](ConcurrentPoolTest *obj) { delete obj; });
+}
@@ -0,0 +1,228 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+#include "core/assets/EffectAsset.h"
+#include "core/data/deserializer/EffectAssetBinaryDeserializer.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+IntrusivePtr<EffectAsset> makeEffect() {
+    IPassInfoFull pass;
+    pass.program        = "builtin-standard|standard-vs|standard-fs";
+    pass.priority       = 128;
+    pass.primitive      = gfx::PrimitiveMode::TRIANGLE_LIST;
+    pass.phase          = "forward-add";
+    pass.propertyIndex  = 0;
+    pass.dynamicStates  = gfx::DynamicStateFlagBit::LINE_WIDTH;
+    pass.embeddedMacros = MacroRecord{{"CC_FORWARD_ADD", true}, {"CC_PIPELINE_TYPE", 1}, {"USE_MODE", ccstd::string("fast")}};
+
+    RasterizerStateInfo rs;
+    rs.cullMode          = gfx::CullMode::FRONT;
+    rs.depthBias         = 0.5F;
+    pass.rasterizerState = rs;
+
+    BlendTargetInfo target;
+    target.blend    = true;
+    target.blendSrc = gfx::BlendFactor::SRC_ALPHA;
+    target.blendDst = gfx::BlendFactor::ONE_MINUS_SRC_ALPHA;
+    BlendStateInfo bs;
+    bs.blendColor   = gfx::Color{0.F, 0.25F, 0.5F, 1.F};
+    bs.targets      = BlendTargetInfoList{target};
+    pass.blendState = bs;
+
+    IPropertyInfo color;
+    color.type       = static_cast<int32_t>(gfx::Type::FLOAT4);
+    color.value      = ccstd::vector<float>{1.F, 0.5F, 0.25F, 1.F};
+    color.handleInfo = IPropertyHandleInfo{"albedo", 0, gfx::Type::FLOAT4};
+    IPropertyInfo texture;
+    texture.type        = static_cast<int32_t>(gfx::Type::SAMPLER2D);
+    texture.value       = ccstd::string("grey");
+    texture.samplerHash = 0x1234567890ULL;
+    pass.properties     = PassPropertyInfoMap{{"mainColor", color}, {"mainTexture", texture}};
+
+    ITechniqueInfo technique;
+    technique.name   = "opaque";
+    technique.passes = {pass, IPassInfoFull{}};
+
+    IShaderInfo shader;
+    shader.name       = "builtin-standard|standard-vs|standard-fs";
+    shader.hash       = 3226379789ULL;
+    shader.glsl3.vert = "void main() {}";
+
+    IDefineInfo define;
+    define.name    = "USE_MODE";
+    define.type    = "string";
+    define.options = ccstd::vector<ccstd::string>{"fast", "precise"};
+    IDefineInfo range;
+    range.name       = "CC_PIPELINE_TYPE";
+    range.type       = "number";
+    range.range      = ccstd::vector<int32_t>{0, 3};
+    range.defaultVal = "0";
+
+    shader.defines    = {define, range};
+    shader.blocks     = {IBlockInfo{0, "Constants", {{"mainColor", gfx::Type::FLOAT4, 1}}, gfx::ShaderStageFlagBit::FRAGMENT}};
+    shader.attributes = {IAttributeInfo{"a_position", gfx::Format::RGB32F, false, 0, false, 0, {"USE_MODE"}}};
+    shader.builtins.globals.blocks.push_back({"CCGlobal", {}});
+    shader.builtins.statistics["CC_EFFECT_USED_VERTEX_UNIFORM_VECTORS"] = 37;
+
+    IPreCompileInfo combination;
+    combination.emplace("USE_INSTANCING", ccstd::vector<bool>{true, false});
+    combination.emplace("CC_PIPELINE_TYPE", ccstd::vector<int32_t>{0, 1});
+    combination.emplace("USE_MODE", ccstd::vector<ccstd::string>{"fast"});
+
+    IntrusivePtr<EffectAsset> effect = new EffectAsset();
+    effect->setName("builtin-standard");
+    effect->setTechniques({technique});
+    effect->setShaders({shader});
+    effect->setCombinations({combination});
+    return effect;
+}
+
+ccstd::vector<uint8_t> serialize(const ccstd::vector<IntrusivePtr<EffectAsset>> &effects) {
+    ccstd::vector<const EffectAsset *> ptrs;
+    for (const auto &effect : effects) {
+        ptrs.push_back(effect.get());
+    }
+    return EffectAssetBinaryDeserializer::serialize(ptrs);
+}
+
+} // namespace
+
+TEST(EffectAssetBinaryDeserializerTest, roundTrip) {
+    IntrusivePtr<EffectAsset> other = new EffectAsset();
+    other->setName("empty");
+    const auto data = serialize({makeEffect(), other});
+    EXPECT_TRUE(EffectAssetBinaryDeserializer::isBinaryEffect(data.data(), data.size()));
+
+    ccstd::vector<IntrusivePtr<EffectAsset>> effects;
+    ASSERT_TRUE(EffectAssetBinaryDeserializer::deserialize(data.data(), data.size(), &effects));
+    ASSERT_EQ(effects.size(), 2);
+    EXPECT_EQ(effects[1]->getName(), "empty");
+    EXPECT_TRUE(effects[1]->getTechniques().empty());
+
+    const auto &effect = effects[0];
+    EXPECT_EQ(effect->getName(), "builtin-standard");
+    ASSERT_EQ(effect->getTechniques().size(), 1);
+    const auto &technique = effect->getTechniques()[0];
+    EXPECT_EQ(technique.name.value(), "opaque");
+    ASSERT_EQ(technique.passes.size(), 2);
+    EXPECT_FALSE(technique.passes[1].priority.has_value());
+    EXPECT_FALSE(technique.passes[1].embeddedMacros.has_value());
+
+    const auto &pass = technique.passes[0];
+    EXPECT_EQ(pass.program, "builtin-standard|standard-vs|standard-fs");
+    EXPECT_EQ(pass.priority.value(), 128);
+    EXPECT_EQ(pass.primitive.value(), gfx::PrimitiveMode::TRIANGLE_LIST);
+    EXPECT_EQ(pass.phase.value(), "forward-add");
+    EXPECT_EQ(pass.propertyIndex, 0);
+    EXPECT_EQ(pass.dynamicStates.value(), gfx::DynamicStateFlagBit::LINE_WIDTH);
+    EXPECT_FALSE(pass.switch_.has_value());
+    EXPECT_FALSE(pass.depthStencilState.has_value());
+
+    const auto &macros = pass.embeddedMacros.value();
+    ASSERT_EQ(macros.size(), 3);
+    EXPECT_TRUE(cc::get<bool>(macros.at("CC_FORWARD_ADD")));
+    EXPECT_EQ(cc::get<int32_t>(macros.at("CC_PIPELINE_TYPE")), 1);
+    EXPECT_EQ(cc::get<ccstd::string>(macros.at("USE_MODE")), "fast");
+
+    EXPECT_EQ(pass.rasterizerState->cullMode.value(), gfx::CullMode::FRONT);
+    EXPECT_FLOAT_EQ(pass.rasterizerState->depthBias.value(), 0.5F);
+    EXPECT_FALSE(pass.rasterizerState->lineWidth.has_value());
+    EXPECT_FLOAT_EQ(pass.blendState->blendColor->y, 0.25F);
+    ASSERT_EQ(pass.blendState->targets->size(), 1);
+    EXPECT_EQ(pass.blendState->targets.value()[0].blendDst.value(), gfx::BlendFactor::ONE_MINUS_SRC_ALPHA);
+    EXPECT_FALSE(pass.blendState->targets.value()[0].blendEq.has_value());
+
+    const auto &properties = pass.properties.value();
+    const auto &color      = properties.at("mainColor");
+    EXPECT_EQ(cc::get<ccstd::vector<float>>(color.value.value()), (ccstd::vector<float>{1.F, 0.5F, 0.25F, 1.F}));
+    EXPECT_EQ(std::get<0>(color.handleInfo.value()), "albedo");
+    EXPECT_EQ(std::get<2>(color.handleInfo.value()), gfx::Type::FLOAT4);
+    const auto &texture = properties.at("mainTexture");
+    EXPECT_EQ(cc::get<ccstd::string>(texture.value.value()), "grey");
+    EXPECT_EQ(texture.samplerHash.value(), 0x1234567890ULL);
+    EXPECT_FALSE(texture.handleInfo.has_value());
+
+    ASSERT_EQ(effect->getShaders().size(), 1);
+    const auto &shader = effect->getShaders()[0];
+    EXPECT_EQ(shader.hash, 3226379789ULL);
+    EXPECT_EQ(shader.glsl3.vert, "void main() {}");
+    EXPECT_TRUE(shader.glsl1.vert.empty());
+    ASSERT_EQ(shader.defines.size(), 2);
+    EXPECT_EQ(shader.defines[0].options.value(), (ccstd::vector<ccstd::string>{"fast", "precise"}));
+    EXPECT_FALSE(shader.defines[0].range.has_value());
+    EXPECT_EQ(shader.defines[1].range.value(), (ccstd::vector<int32_t>{0, 3}));
+    EXPECT_EQ(shader.defines[1].defaultVal.value(), "0");
+    ASSERT_EQ(shader.blocks.size(), 1);
+    EXPECT_EQ(shader.blocks[0].members[0].name, "mainColor");
+    EXPECT_EQ(shader.blocks[0].stageFlags, gfx::ShaderStageFlagBit::FRAGMENT);
+    EXPECT_EQ(shader.attributes[0].format, gfx::Format::RGB32F);
+    EXPECT_EQ(shader.attributes[0].defines, ccstd::vector<ccstd::string>{"USE_MODE"});
+    EXPECT_EQ(shader.builtins.globals.blocks[0].name, "CCGlobal");
+    EXPECT_EQ(shader.builtins.statistics.at("CC_EFFECT_USED_VERTEX_UNIFORM_VECTORS"), 37);
+
+    const auto &combination = effect->getCombinations()[0];
+    EXPECT_EQ(cc::get<ccstd::vector<bool>>(combination.at("USE_INSTANCING")), (ccstd::vector<bool>{true, false}));
+    EXPECT_EQ(cc::get<ccstd::vector<int32_t>>(combination.at("CC_PIPELINE_TYPE")), (ccstd::vector<int32_t>{0, 1}));
+    EXPECT_EQ(cc::get<ccstd::vector<ccstd::string>>(combination.at("USE_MODE")), ccstd::vector<ccstd::string>{"fast"});
+}
+
+TEST(EffectAssetBinaryDeserializerTest, sharesStrings) {
+    const auto one = serialize({makeEffect()});
+    const auto two = serialize({makeEffect(), makeEffect()});
+    // the second copy only adds string indices, not the characters
+    const auto *header = reinterpret_cast<const uint32_t *>(one.data());
+    EXPECT_LT(two.size() - one.size(), one.size() - header[3]);
+}
+
+TEST(EffectAssetBinaryDeserializerTest, rejectsInvalidData) {
+    auto data = serialize({makeEffect()});
+
+    ccstd::vector<IntrusivePtr<EffectAsset>> effects;
+    EXPECT_FALSE(EffectAssetBinaryDeserializer::deserialize(data.data(), 8, &effects));
+    for (size_t size = data.size() / 2; size < data.size(); size += 7) {
+        EXPECT_FALSE(EffectAssetBinaryDeserializer::deserialize(data.data(), size, &effects));
+    }
+    EXPECT_TRUE(effects.empty());
+
+    auto badVersion = data;
+    badVersion[4]   = 0xFF;
+    EXPECT_FALSE(EffectAssetBinaryDeserializer::isBinaryEffect(data.data(), 3));
+    EXPECT_FALSE(EffectAssetBinaryDeserializer::deserialize(badVersion.data(), badVersion.size(), &effects));
+
+    // an out of range string index in the payload
+    auto   badString   = data;
+    auto   stringCount = reinterpret_cast<const uint32_t *>(data.data())[2];
+    auto   stringBytes = reinterpret_cast<const uint32_t *>(data.data())[3];
+    size_t payload     = 5 * sizeof(uint32_t) + (stringCount + 1) * sizeof(uint32_t) + stringBytes;
+    memset(badString.data() + payload, 0xFF, sizeof(uint32_t));
+    EXPECT_FALSE(EffectAssetBinaryDeserializer::deserialize(badString.data(), badString.size(), &effects));
+    EXPECT_TRUE(effects.empty());
+}
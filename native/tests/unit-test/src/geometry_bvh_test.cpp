@@ -0,0 +1,148 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+ 
+ http://www.cocos.com
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+ 
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "cocos/core/geometry/BVH.h"
+#include "cocos/core/geometry/Intersect.h"
+#include "cocos/core/geometry/Triangle.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+namespace {
+// a grid of unit boxes along x, box i spans [2i, 2i + 1]
+void makeBoxes(uint32_t count, ccstd::vector<cc::Vec3> &mins, ccstd::vector<cc::Vec3> &maxs) {
+    for (uint32_t i = 0; i < count; ++i) {
+        mins.emplace_back(static_cast<float>(i) * 2.F, 0.F, 0.F);
+        maxs.emplace_back(static_cast<float>(i) * 2.F + 1.F, 1.F, 1.F);
+    }
+}
+} // namespace
+
+TEST(geometryBVHTest, raycastBoxes) {
+    ccstd::vector<cc::Vec3> mins;
+    ccstd::vector<cc::Vec3> maxs;
+    makeBoxes(100, mins, maxs);
+
+    cc::geometry::BVH bvh;
+    bvh.build(mins.data(), maxs.data(), static_cast<uint32_t>(mins.size()));
+    EXPECT_EQ(bvh.getPrimitiveCount(), 100);
+
+    const auto hitBox = [&](const cc::geometry::Ray &ray, uint32_t *hit) {
+        return bvh.raycast(ray, FLT_MAX, cc::geometry::ERaycastMode::CLOSEST, [&](uint32_t index, float maxDistance) {
+            const float dist = cc::geometry::rayAABB2(ray, mins[index], maxs[index]);
+            if (dist != 0.F && dist <= maxDistance) {
+                *hit = index;
+            }
+            return dist;
+        });
+    };
+
+    // along +x from the far left, the first box is the closest
+    uint32_t hit  = UINT32_MAX;
+    float    dist = hitBox(cc::geometry::Ray{-10.F, 0.5F, 0.5F, 1.F, 0.F, 0.F}, &hit);
+    EXPECT_FLOAT_EQ(dist, 10.F);
+    EXPECT_EQ(hit, 0);
+
+    // along -x from the far right, the last box is the closest
+    dist = hitBox(cc::geometry::Ray{300.F, 0.5F, 0.5F, -1.F, 0.F, 0.F}, &hit);
+    EXPECT_FLOAT_EQ(dist, 300.F - 199.F);
+    EXPECT_EQ(hit, 99);
+
+    // straight down into box 42
+    dist = hitBox(cc::geometry::Ray{84.5F, 10.F, 0.5F, 0.F, -1.F, 0.F}, &hit);
+    EXPECT_FLOAT_EQ(dist, 9.F);
+    EXPECT_EQ(hit, 42);
+
+    // a ray passing between the boxes misses
+    dist = hitBox(cc::geometry::Ray{85.5F, 10.F, 0.5F, 0.F, -1.F, 0.F}, &hit);
+    EXPECT_FLOAT_EQ(dist, 0.F);
+
+    // moving box 42 up is picked up by refit
+    mins[42].y += 5.F;
+    maxs[42].y += 5.F;
+    bvh.refit(mins.data(), maxs.data());
+    dist = hitBox(cc::geometry::Ray{84.5F, 10.F, 0.5F, 0.F, -1.F, 0.F}, &hit);
+    EXPECT_FLOAT_EQ(dist, 4.F);
+    EXPECT_EQ(hit, 42);
+}
+
+TEST(geometryBVHTest, raycastTriangles) {
+    // a 16 x 16 grid of quads on the y = 0 plane, facing up
+    constexpr uint32_t size = 16;
+    cc::Float32Array   positions((size + 1) * (size + 1) * 3);
+    for (uint32_t z = 0; z <= size; ++z) {
+        for (uint32_t x = 0; x <= size; ++x) {
+            const uint32_t v     = (z * (size + 1) + x) * 3;
+            positions[v]         = static_cast<float>(x);
+            positions[v + 1]     = 0.F;
+            positions[v + 2]     = static_cast<float>(z);
+        }
+    }
+    cc::Uint16Array indices(size * size * 6);
+    uint32_t        i = 0;
+    for (uint32_t z = 0; z < size; ++z) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const auto v0  = static_cast<uint16_t>(z * (size + 1) + x);
+            const auto v1  = static_cast<uint16_t>(v0 + 1);
+            const auto v2  = static_cast<uint16_t>(v0 + size + 1);
+            const auto v3  = static_cast<uint16_t>(v2 + 1);
+            indices[i++]   = v0;
+            indices[i++]   = v2;
+            indices[i++]   = v1;
+            indices[i++]   = v1;
+            indices[i++]   = v2;
+            indices[i++]   = v3;
+        }
+    }
+    cc::IBArray ib{std::move(indices)};
+
+    cc::geometry::TriangleBVH bvh;
+    bvh.build(positions, &ib, cc::gfx::PrimitiveMode::TRIANGLE_LIST);
+    EXPECT_EQ(bvh.getTriangleCount(), size * size * 2);
+
+    ccstd::vector<cc::geometry::Ray> rays;
+    rays.emplace_back(3.25F, 5.F, 7.75F, 0.F, -1.F, 0.F);
+    rays.emplace_back(15.9F, 2.F, 0.1F, 0.F, -1.F, 0.F);
+    rays.emplace_back(20.F, 2.F, 5.F, 0.F, -1.F, 0.F);   // outside the grid
+    rays.emplace_back(8.F, -2.F, 8.F, 0.F, -1.F, 0.F);   // pointing away
+    ccstd::vector<float> distances(rays.size());
+    bvh.raycastBatch(rays.data(), static_cast<uint32_t>(rays.size()), FLT_MAX, false, distances.data());
+    EXPECT_FLOAT_EQ(distances[0], 5.F);
+    EXPECT_FLOAT_EQ(distances[1], 2.F);
+    EXPECT_FLOAT_EQ(distances[2], 0.F);
+    EXPECT_FLOAT_EQ(distances[3], 0.F);
+
+    // the closest hit reports the vertices of the hit triangle
+    cc::geometry::IRaySubMeshOptions options;
+    options.mode        = cc::geometry::ERaycastMode::CLOSEST;
+    options.distance    = FLT_MAX;
+    options.doubleSided = false;
+    options.result      = ccstd::vector<cc::geometry::IRaySubMeshResult>{};
+    EXPECT_FLOAT_EQ(bvh.raycast(rays[0], &options), 5.F);
+    ASSERT_EQ(options.result->size(), 1);
+    const auto &hit = (*options.result)[0];
+    for (const uint32_t v : {hit.vertexIndex0, hit.vertexIndex1, hit.vertexIndex2}) {
+        EXPECT_LE(std::abs(positions[v * 3] - 3.25F), 1.F);
+        EXPECT_LE(std::abs(positions[v * 3 + 2] - 7.75F), 1.F);
+    }
+}
@@ -0,0 +1,96 @@
+/****************************************************************************
+Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+http://www.cocos2d-x.org
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include <cmath>
+#include <cmath>
+#include "cocos/core/geometry/Curve.h"
+#include "gtest/gtest.h"
+
+namespace {
+cc::geometry::AnimationCurve makeEaseCurve() {
+    return cc::geometry::AnimationCurve({
+        {0.F, 0.F, 0.F, 0.F},
+        {0.5F, 1.F, 2.F, 2.F},
+        {1.F, 0.25F, -1.F, -1.F},
+    });
+}
+} // namespace
+
+TEST(geometryCurveTest, testEvaluate) {
+    cc::geometry::AnimationCurve constant;
+    EXPECT_FLOAT_EQ(constant.evaluate(0.3F), 1.F);
+
+    auto curve = makeEaseCurve();
+    EXPECT_FLOAT_EQ(curve.evaluate(0.F), 0.F);
+    EXPECT_FLOAT_EQ(curve.evaluate(0.5F), 1.F);
+    EXPECT_FLOAT_EQ(curve.evaluate(1.F), 0.25F);
+    // clamped after the last key, looped before the first one
+    EXPECT_FLOAT_EQ(curve.evaluate(2.F), 0.25F);
+    EXPECT_NEAR(curve.evaluate(-0.75F), curve.evaluate(0.25F), 1e-5F);
+
+    curve.setPostWrapMode(cc::geometry::ExtrapolationMode::PING_PONG);
+    EXPECT_NEAR(curve.evaluate(1.25F), curve.evaluate(0.75F), 1e-5F);
+}
+
+TEST(geometryCurveTest, testBakeLut) {
+    auto curve = makeEaseCurve();
+    EXPECT_TRUE(curve.bakeLut(1024, 1e-4F));
+    EXPECT_TRUE(curve.isLutBaked());
+    for (int i = 0; i <= 100; ++i) {
+        float t = static_cast<float>(i) / 100.F;
+        EXPECT_NEAR(curve.evaluate(t), curve.evaluateCurve(t), 2e-4F);
+    }
+
+    // not reachable with so few samples
+    EXPECT_FALSE(curve.bakeLut(8, 1e-6F));
+    EXPECT_FALSE(curve.isLutBaked());
+
+    EXPECT_TRUE(curve.bakeLut());
+    curve.addKey({2.F, 1.F, 0.F, 0.F});
+    EXPECT_FALSE(curve.isLutBaked());
+}
+
+TEST(geometryCurveTest, testBatchEvaluate) {
+    auto curve = makeEaseCurve();
+    curve.setPreWrapMode(cc::geometry::ExtrapolationMode::PING_PONG);
+    curve.setPostWrapMode(cc::geometry::ExtrapolationMode::LOOP);
+
+    constexpr uint32_t count = 37;
+    float              times[count];
+    float              results[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        times[i] = -2.F + static_cast<float>(i) * 0.13F;
+    }
+
+    curve.evaluate(times, results, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        EXPECT_NEAR(results[i], curve.evaluate(times[i]), 1e-5F);
+    }
+
+    ASSERT_TRUE(curve.bakeLut());
+    curve.evaluate(times, results, count);
+    for (uint32_t i = 0; i < count; ++i) {
+        EXPECT_NEAR(results[i], curve.evaluate(times[i]), 1e-4F);
+        EXPECT_NEAR(results[i], curve.evaluateCurve(times[i]), 2e-3F);
+    }
+}
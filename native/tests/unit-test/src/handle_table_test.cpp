@@ -0,0 +1,85 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/HandleTable.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+int32_t destroyedCount = 0;
+
+class HandleTableTest : public RefCounted {
+public:
+    ~HandleTableTest() override { ++destroyedCount; }
+};
+
+} // namespace
+
+TEST(HandleTableTest, addGet) {
+    HandleTable<HandleTableTest> table;
+    auto *                       obj    = new HandleTableTest();
+    auto                         handle = table.add(obj);
+    EXPECT_TRUE(handle.isValid());
+    EXPECT_EQ(table.get(handle), obj);
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_FALSE(table.contains({}));
+}
+
+TEST(HandleTableTest, deferredRelease) {
+    HandleTable<HandleTableTest> table;
+    destroyedCount = 0;
+
+    // the table holds the only reference
+    auto handle = table.add(new HandleTableTest());
+
+    table.remove(handle);
+    EXPECT_EQ(table.get(handle), nullptr);
+    EXPECT_EQ(destroyedCount, 0);
+    table.flush();
+    EXPECT_EQ(destroyedCount, 1);
+}
+
+TEST(HandleTableTest, staleHandle) {
+    HandleTable<HandleTableTest> table;
+    auto *                       first  = new HandleTableTest();
+    auto                         handle = table.add(first);
+    table.remove(handle);
+
+    // slots are not reused before the flush
+    auto *second      = new HandleTableTest();
+    auto  beforeFlush = table.add(second);
+    EXPECT_NE(beforeFlush.getIndex(), handle.getIndex());
+    table.flush();
+
+    // the reused slot does not resolve the old handle
+    auto *third      = new HandleTableTest();
+    auto  afterFlush = table.add(third);
+    EXPECT_EQ(afterFlush.getIndex(), handle.getIndex());
+    EXPECT_EQ(table.get(handle), nullptr);
+    EXPECT_EQ(table.get(afterFlush), third);
+    EXPECT_EQ(table.size(), 2);
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <random>
+#include "core/utils/ImageUtils.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+ccstd::vector<uint8_t> randomBytes(uint32_t count) {
+    std::mt19937           rng(7);
+    ccstd::vector<uint8_t> bytes(count);
+    for (auto &b : bytes) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+// pixel counts that cover the vector bodies and the scalar tails
+const uint32_t PIXEL_COUNTS[] = {0, 1, 3, 5, 7, 8, 15, 16, 17, 33, 257};
+
+} // namespace
+
+TEST(imageUtilsTest, premultiplyAlpha) {
+    for (uint32_t count : PIXEL_COUNTS) {
+        auto pixels   = randomBytes(count * 4);
+        auto expected = pixels;
+        for (uint32_t i = 0; i < count; ++i) {
+            for (uint32_t c = 0; c < 3; ++c) {
+                expected[i * 4 + c] = static_cast<uint8_t>((expected[i * 4 + c] * expected[i * 4 + 3] + 127) / 255);
+            }
+        }
+        ImageUtils::premultiplyAlpha(pixels.data(), count);
+        EXPECT_EQ(pixels, expected) << count;
+    }
+}
+
+TEST(imageUtilsTest, unpremultiplyAlpha) {
+    auto pixels = randomBytes(257 * 4);
+    auto source = pixels;
+    ImageUtils::premultiplyAlpha(pixels.data(), 257);
+    ImageUtils::unpremultiplyAlpha(pixels.data(), 257);
+    for (uint32_t i = 0; i < 257; ++i) {
+        const uint32_t alpha = source[i * 4 + 3];
+        EXPECT_EQ(pixels[i * 4 + 3], alpha);
+        if (alpha == 0) {
+            continue;
+        }
+        // the round trip loses at most the precision of the premultiplied value
+        for (uint32_t c = 0; c < 3; ++c) {
+            EXPECT_LE(std::abs(pixels[i * 4 + c] - source[i * 4 + c]), static_cast<int>(128 / alpha + 1));
+        }
+    }
+}
+
+TEST(imageUtilsTest, expandToRGBA) {
+    for (uint32_t count : PIXEL_COUNTS) {
+        auto                   rgb = randomBytes(count * 3);
+        auto                   la  = randomBytes(count * 2);
+        auto                   l   = randomBytes(count);
+        ccstd::vector<uint8_t> rgba(count * 4);
+
+        ImageUtils::expandRGBToRGBA(rgb.data(), rgba.data(), count);
+        for (uint32_t i = 0; i < count; ++i) {
+            EXPECT_EQ(rgba[i * 4], rgb[i * 3]);
+            EXPECT_EQ(rgba[i * 4 + 1], rgb[i * 3 + 1]);
+            EXPECT_EQ(rgba[i * 4 + 2], rgb[i * 3 + 2]);
+            EXPECT_EQ(rgba[i * 4 + 3], 255);
+        }
+
+        ImageUtils::expandLAToRGBA(la.data(), rgba.data(), count);
+        for (uint32_t i = 0; i < count; ++i) {
+            EXPECT_EQ(rgba[i * 4], la[i * 2]);
+            EXPECT_EQ(rgba[i * 4 + 1], la[i * 2]);
+            EXPECT_EQ(rgba[i * 4 + 2], la[i * 2]);
+            EXPECT_EQ(rgba[i * 4 + 3], la[i * 2 + 1]);
+        }
+
+        ImageUtils::expandLToRGBA(l.data(), rgba.data(), count);
+        for (uint32_t i = 0; i < count; ++i) {
+            EXPECT_EQ(rgba[i * 4], l[i]);
+            EXPECT_EQ(rgba[i * 4 + 1], l[i]);
+            EXPECT_EQ(rgba[i * 4 + 2], l[i]);
+            EXPECT_EQ(rgba[i * 4 + 3], 255);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <atomic>
+#include <thread>
+#include "base/job-system/JobScheduler.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+TEST(JobSchedulerTest, runsEveryJob) {
+    JobScheduler      scheduler(4);
+    JobCounter        counter;
+    std::atomic<uint> sum{0};
+    for (uint i = 1; i <= 1000; ++i) {
+        const auto priority = static_cast<JobPriority>(i % static_cast<uint>(JobPriority::COUNT));
+        scheduler.schedule([&sum, i]() { sum += i; }, priority, &counter);
+    }
+    // waiting only helps with frame-critical jobs, the workers finish the rest
+    scheduler.wait(counter);
+    EXPECT_TRUE(counter.isDone());
+    EXPECT_EQ(sum.load(), 500500U);
+}
+
+TEST(JobSchedulerTest, runsInlineWithoutWorkers) {
+    JobScheduler scheduler(0);
+    JobCounter   counter;
+    bool         ran = false;
+    scheduler.schedule([&ran]() { ran = true; }, JobPriority::STREAMING, &counter);
+    EXPECT_TRUE(ran);
+    EXPECT_TRUE(counter.isDone());
+    EXPECT_EQ(scheduler.threadCount(), 0U);
+}
+
+TEST(JobSchedulerTest, waitingThreadRunsFrameCriticalJobs) {
+    JobScheduler          scheduler(1);
+    JobCounter            blockerCounter;
+    std::atomic<bool>     started{false};
+    std::atomic<bool>     release{false};
+    const std::thread::id mainThread = std::this_thread::get_id();
+    // keeps the only worker busy, so the frame-critical job can only run on the waiting thread
+    scheduler.schedule([&]() {
+        started = true;
+        while (!release.load()) std::this_thread::yield();
+    },
+                       JobPriority::BACKGROUND, &blockerCounter);
+    while (!started.load()) std::this_thread::yield();
+
+    JobCounter      counter;
+    std::thread::id ranOn;
+    scheduler.schedule([&ranOn]() { ranOn = std::this_thread::get_id(); }, JobPriority::FRAME_CRITICAL, &counter);
+    scheduler.wait(counter);
+    EXPECT_EQ(ranOn, mainThread);
+
+    release = true;
+    scheduler.wait(blockerCounter);
+}
+
+TEST(JobSchedulerTest, runPendingJobHonorsPriority) {
+    JobScheduler      scheduler(1);
+    JobCounter        blockerCounter;
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    scheduler.schedule([&]() {
+        started = true;
+        while (!release.load()) std::this_thread::yield();
+    },
+                       JobPriority::FRAME_CRITICAL, &blockerCounter);
+    while (!started.load()) std::this_thread::yield();
+
+    ccstd::vector<JobPriority> order;
+    scheduler.schedule([&order]() { order.push_back(JobPriority::STREAMING); }, JobPriority::STREAMING);
+    scheduler.schedule([&order]() { order.push_back(JobPriority::BACKGROUND); }, JobPriority::BACKGROUND);
+    scheduler.schedule([&order]() { order.push_back(JobPriority::FRAME_CRITICAL); }, JobPriority::FRAME_CRITICAL);
+
+    while (scheduler.runPendingJob(JobPriority::STREAMING)) {
+    }
+    ASSERT_EQ(order.size(), 3U);
+    EXPECT_EQ(order[0], JobPriority::FRAME_CRITICAL);
+    EXPECT_EQ(order[1], JobPriority::BACKGROUND);
+    EXPECT_EQ(order[2], JobPriority::STREAMING);
+
+    release = true;
+    scheduler.wait(blockerCounter);
+}
@@ -25,6 +25,9 @@ THE SOFTWARE.
 #include "cocos/math/Vec2.h"
 #include "cocos/math/Math.h"
 #include "cocos/math/MathUtil.h"
+#include "cocos/math/Mat4.h"
+#include "cocos/math/Quaternion.h"
+#include "cocos/core/geometry/AABB.h"
 #include "utils.h"
 #include <math.h>
 #include <vector>
@@ -41,4 +44,334 @@ TEST(mathUtilsTest, test9) {
     logLabel = "test the MathUtil lerp function";
     float res = cc::MathUtil::lerp(2, 15, 0.8);
     ExpectEq(IsEqualF(res, 12.3999996), true);
-}
\ No newline at end of file
+}
+TEST(mathUtilsTest, aabbPlanesBatch) {
+    logLabel = "test the MathUtil aabbPlanesBatch function";
+    // unit box around the origin, planes point to the inside
+    const float planes[] = {
+        1, 0, 0, -1,
+        -1, 0, 0, -1,
+        0, 1, 0, -1,
+        0, -1, 0, -1,
+        0, 0, 1, -1,
+        0, 0, -1, -1,
+    };
+    // 5 boxes, streams padded to 8
+    const float centerX[] = {0, 1.5F, 3, -2.5F, 0, 0, 0, 0};
+    const float centerY[] = {0, 0, 0, 0, 1.4F, 0, 0, 0};
+    const float centerZ[] = {0, 0, 0, 0, 0, 0, 0, 0};
+    const float extentX[] = {0.5F, 1, 1, 1, 0.5F, 0, 0, 0};
+    const float extentY[] = {0.5F, 1, 1, 1, 0.5F, 0, 0, 0};
+    const float extentZ[] = {0.5F, 1, 1, 1, 0.5F, 0, 0, 0};
+    uint8_t     results[5] = {};
+    cc::MathUtil::aabbPlanesBatch(centerX, centerY, centerZ, extentX, extentY, extentZ, 5, planes, 6, results);
+    ExpectEq(results[0], 1);
+    ExpectEq(results[1], 1);
+    ExpectEq(results[2], 0);
+    ExpectEq(results[3], 0);
+    ExpectEq(results[4], 1);
+}
+TEST(mathUtilsTest, transformAABBBatch) {
+    logLabel = "test the MathUtil transformAABBBatch function";
+    cc::Mat4 matrices[3];
+    cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(1, 2, 3), cc::Vec3(2, 2, 2), &matrices[0]);
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(30, 45, 60, &rotation);
+    cc::Mat4::fromRTS(rotation, cc::Vec3(-4, 0, 1), cc::Vec3(1, 3, 0.5F), &matrices[1]);
+    cc::Quaternion::fromEuler(0, 90, 0, &rotation);
+    cc::Mat4::fromRTS(rotation, cc::Vec3(0, 0, 0), cc::Vec3(1, 1, 1), &matrices[2]);
+
+    const float   centers[] = {0, 0, 0, 1, -1, 2, 0.5F, 0, -0.5F};
+    const float   extents[] = {1, 1, 1, 0.5F, 2, 1, 3, 1, 0.25F};
+    const float * mats[]    = {matrices[0].m, matrices[1].m, matrices[2].m};
+    float         outCenters[9];
+    float         outExtents[9];
+    cc::MathUtil::transformAABBBatch(mats, centers, extents, 3, outCenters, outExtents);
+    for (uint32_t i = 0; i < 3; ++i) {
+        // the reference is the scalar transform of the same box
+        cc::geometry::AABB local(centers[i * 3], centers[i * 3 + 1], centers[i * 3 + 2], extents[i * 3], extents[i * 3 + 1], extents[i * 3 + 2]);
+        cc::geometry::AABB world;
+        local.transform(matrices[i], &world);
+        const cc::Vec3 &center = world.getCenter();
+        const cc::Vec3 &extent = world.getHalfExtents();
+        ExpectEq(IsEqualF(outCenters[i * 3], center.x), true);
+        ExpectEq(IsEqualF(outCenters[i * 3 + 1], center.y), true);
+        ExpectEq(IsEqualF(outCenters[i * 3 + 2], center.z), true);
+        ExpectEq(IsEqualF(outExtents[i * 3], extent.x), true);
+        ExpectEq(IsEqualF(outExtents[i * 3 + 1], extent.y), true);
+        ExpectEq(IsEqualF(outExtents[i * 3 + 2], extent.z), true);
+    }
+}
+TEST(mathUtilsTest, transformVec3Batch) {
+    logLabel = "test the MathUtil transformVec3Batch function";
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(30, 45, 60, &rotation);
+    cc::Mat4 matrix;
+    cc::Mat4::fromRTS(rotation, cc::Vec3(-4, 2, 1), cc::Vec3(1, 3, 0.5F), &matrix);
+
+    // interleaved with a 4 byte attribute, transformed in place
+    const float source[] = {1, 2, 3, 7, -1, 0.5F, 4, 7, 0, 0, -2, 7};
+    float       vertices[12];
+    for (float w : {1.F, 0.F}) {
+        memcpy(vertices, source, sizeof(source));
+        auto *bytes = reinterpret_cast<uint8_t *>(vertices);
+        cc::MathUtil::transformVec3Batch(matrix.m, bytes, 16, bytes, 16, 3, w);
+        for (uint32_t i = 0; i < 3; ++i) {
+            cc::Vec4 expected(source[i * 4], source[i * 4 + 1], source[i * 4 + 2], w);
+            matrix.transformVector(&expected);
+            ExpectEq(IsEqualF(vertices[i * 4], expected.x), true);
+            ExpectEq(IsEqualF(vertices[i * 4 + 1], expected.y), true);
+            ExpectEq(IsEqualF(vertices[i * 4 + 2], expected.z), true);
+            ExpectEq(IsEqualF(vertices[i * 4 + 3], 7.F), true);
+        }
+    }
+}
+TEST(mathUtilsTest, multiplyJointMatrices) {
+    logLabel = "test the MathUtil multiplyJointMatrices function";
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(30, 45, 60, &rotation);
+    cc::Mat4 worlds[2];
+    cc::Mat4::fromRTS(rotation, cc::Vec3(-4, 2, 1), cc::Vec3(1, 3, 0.5F), &worlds[0]);
+    cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(5, 6, 7), cc::Vec3(2, 2, 2), &worlds[1]);
+    cc::Mat4 bindposes[2];
+    cc::Quaternion::fromEuler(-20, 10, 90, &rotation);
+    cc::Mat4::fromRTS(rotation, cc::Vec3(0.5F, -1, 3), cc::Vec3(1, 1, 1), &bindposes[0]);
+    cc::Mat4::fromRTS(cc::Quaternion::identity(), cc::Vec3(-1, -2, -3), cc::Vec3(0.5F, 1, 2), &bindposes[1]);
+
+    const float *worldPtrs[] = {worlds[0].m, worlds[1].m};
+    float        bindposeData[32];
+    memcpy(bindposeData, bindposes[0].m, sizeof(float) * 16);
+    memcpy(bindposeData + 16, bindposes[1].m, sizeof(float) * 16);
+    float joints[24];
+    cc::MathUtil::multiplyJointMatrices(worldPtrs, bindposeData, 2, joints);
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::multiply(worlds[i], bindposes[i], &expected);
+        const float *joint = joints + i * 12;
+        for (uint32_t c = 0; c < 3; ++c) {
+            ExpectEq(IsEqualF(joint[c * 4], expected.m[c * 4]), true);
+            ExpectEq(IsEqualF(joint[c * 4 + 1], expected.m[c * 4 + 1]), true);
+            ExpectEq(IsEqualF(joint[c * 4 + 2], expected.m[c * 4 + 2]), true);
+            ExpectEq(IsEqualF(joint[c * 4 + 3], expected.m[12 + c]), true);
+        }
+    }
+}
+TEST(mathUtilsTest, fromRTSBatch) {
+    logLabel = "test the MathUtil fromRTSBatch function";
+    // 11 transforms cover the 8 and 4 wide kernels and the remainders
+    const uint32_t count = 11;
+    float          rotations[count * 4];
+    float          translations[count * 3];
+    float          scales[count * 3];
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion rotation;
+        cc::Quaternion::fromEuler(10.F * i, 45 - 7.F * i, 3.F * i, &rotation);
+        rotations[i * 4]     = rotation.x;
+        rotations[i * 4 + 1] = rotation.y;
+        rotations[i * 4 + 2] = rotation.z;
+        rotations[i * 4 + 3] = rotation.w;
+        for (uint32_t k = 0; k < 3; ++k) {
+            translations[i * 3 + k] = static_cast<float>(i) - 2.F * k;
+            scales[i * 3 + k]       = 0.5F + 0.1F * (i + k);
+        }
+    }
+    float matrices[count * 16];
+    cc::MathUtil::fromRTSBatch(rotations, translations, scales, count, matrices);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::fromRTS(cc::Quaternion(rotations[i * 4], rotations[i * 4 + 1], rotations[i * 4 + 2], rotations[i * 4 + 3]),
+                          cc::Vec3(translations[i * 3], translations[i * 3 + 1], translations[i * 3 + 2]),
+                          cc::Vec3(scales[i * 3], scales[i * 3 + 1], scales[i * 3 + 2]), &expected);
+        for (uint32_t k = 0; k < 16; ++k) {
+            ExpectEq(IsEqualF(matrices[i * 16 + k], expected.m[k]), true);
+        }
+    }
+}
+TEST(mathUtilsTest, multiplyMatrixBatch) {
+    logLabel = "test the MathUtil multiplyMatrixBatch function";
+    const uint32_t count = 11;
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(30, 45, 60, &rotation);
+    cc::Mat4 parent;
+    cc::Mat4::fromRTS(rotation, cc::Vec3(-4, 2, 1), cc::Vec3(1, 3, 0.5F), &parent);
+    cc::Mat4 children[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion::fromEuler(-20.F * i, 10, 5.F * i, &rotation);
+        cc::Mat4::fromRTS(rotation, cc::Vec3(0.5F * i, -1, 3), cc::Vec3(1, 2, 1), &children[i]);
+    }
+    // in place, the products overwrite the children
+    float matrices[count * 16];
+    memcpy(matrices, children, sizeof(matrices));
+    cc::MathUtil::multiplyMatrixBatch(parent.m, matrices, count, matrices);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected;
+        cc::Mat4::multiply(parent, children[i], &expected);
+        for (uint32_t k = 0; k < 16; ++k) {
+            ExpectEq(IsEqualF(matrices[i * 16 + k], expected.m[k]), true);
+        }
+    }
+}
+TEST(mathUtilsTest, invertAffineBatch) {
+    logLabel = "test the MathUtil invertAffineBatch function";
+    const uint32_t count = 11;
+    cc::Mat4       sources[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion rotation;
+        cc::Quaternion::fromEuler(15.F * i, -30, 7.F * i, &rotation);
+        cc::Mat4::fromRTS(rotation, cc::Vec3(1, -0.2F * i, 0.5F), cc::Vec3(0.5F + 0.1F * i, 2, 1), &sources[i]);
+    }
+    float inverses[count * 16];
+    ExpectEq(cc::MathUtil::invertAffineBatch(sources[0].m, count, inverses), true);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Mat4 expected = sources[i].getInversed();
+        for (uint32_t k = 0; k < 16; ++k) {
+            ExpectEq(IsEqualF(inverses[i * 16 + k], expected.m[k]), true);
+        }
+    }
+
+    // a singular matrix is copied unchanged, the others are still inverted
+    sources[9].m[0] = sources[9].m[1] = sources[9].m[2] = 0;
+    ExpectEq(cc::MathUtil::invertAffineBatch(sources[0].m, count, inverses), false);
+    for (uint32_t k = 0; k < 16; ++k) {
+        ExpectEq(IsEqualF(inverses[9 * 16 + k], sources[9].m[k]), true);
+    }
+    cc::Mat4 expected = sources[10].getInversed();
+    for (uint32_t k = 0; k < 16; ++k) {
+        ExpectEq(IsEqualF(inverses[10 * 16 + k], expected.m[k]), true);
+    }
+}
+static bool isEqualQuat(const cc::Quaternion &a, const cc::Quaternion &b) {
+    return IsEqualF(a.x, b.x) && IsEqualF(a.y, b.y) && IsEqualF(a.z, b.z) && IsEqualF(a.w, b.w);
+}
+TEST(mathUtilsTest, quaternionBatch) {
+    logLabel = "test the MathUtil quaternion batch functions";
+    // 11 pairs cover the 4 wide kernels and the remainders
+    const uint32_t count = 11;
+    cc::Quaternion from[count];
+    cc::Quaternion to[count];
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion::fromEuler(10.F * i, 45 - 7.F * i, 3.F * i, &from[i]);
+        cc::Quaternion::fromEuler(-20.F * i, 30, 170 - 11.F * i, &to[i]);
+        // pairs in opposite hemispheres take the shortest path
+        if (i % 3 == 0) {
+            to[i].set(-to[i].x, -to[i].y, -to[i].z, -to[i].w);
+        }
+    }
+    // equal pairs are returned unchanged by slerp
+    to[7] = from[7];
+
+    cc::Quaternion results[count];
+    cc::MathUtil::multiplyQuaternionBatch(&from[0].x, &to[0].x, count, &results[0].x);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Quaternion expected;
+        cc::Quaternion::multiply(from[i], to[i], &expected);
+        ExpectEq(isEqualQuat(results[i], expected), true);
+    }
+
+    for (float t : {0.F, 0.25F, 0.5F, 0.8F, 1.F}) {
+        cc::MathUtil::slerpQuaternionBatch(&from[0].x, &to[0].x, t, count, &results[0].x);
+        for (uint32_t i = 0; i < count; ++i) {
+            cc::Quaternion expected;
+            cc::Quaternion::slerp(from[i], to[i], t, &expected);
+            ExpectEq(isEqualQuat(results[i], expected), true);
+        }
+
+        // nlerp meets slerp halfway, up to the sign of the result
+        cc::MathUtil::nlerpQuaternionBatch(&from[0].x, &to[0].x, t, count, &results[0].x);
+        for (uint32_t i = 0; i < count; ++i) {
+            const cc::Quaternion &q = results[i];
+            ExpectEq(IsEqualF(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, 1.F), true);
+            if (t == 0.5F) {
+                cc::Quaternion expected;
+                cc::Quaternion::slerp(from[i], to[i], t, &expected);
+                ExpectEq(IsEqualF(std::abs(q.x * expected.x + q.y * expected.y + q.z * expected.z + q.w * expected.w), 1.F), true);
+            }
+        }
+    }
+
+    // in place, a zero quaternion is left as is
+    for (uint32_t i = 0; i < count; ++i) {
+        const float scale = 0.5F + static_cast<float>(i);
+        results[i].set(from[i].x * scale, from[i].y * scale, from[i].z * scale, from[i].w * scale);
+    }
+    results[5].set(0, 0, 0, 0);
+    cc::MathUtil::normalizeQuaternionBatch(&results[0].x, count, &results[0].x);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(isEqualQuat(results[i], i == 5 ? cc::Quaternion(0, 0, 0, 0) : from[i]), true);
+    }
+}
+TEST(mathUtilsTest, transformVec3QuatBatch) {
+    logLabel = "test the MathUtil transformVec3QuatBatch function";
+    const uint32_t count = 11;
+    cc::Quaternion rotation;
+    cc::Quaternion::fromEuler(30, -45, 60, &rotation);
+    float vectors[count * 3];
+    for (uint32_t i = 0; i < count * 3; ++i) {
+        vectors[i] = static_cast<float>(i % 5) - 0.3F * i;
+    }
+    float results[count * 3];
+    cc::MathUtil::transformVec3QuatBatch(&rotation.x, vectors, count, results);
+    for (uint32_t i = 0; i < count; ++i) {
+        cc::Vec3 expected(vectors[i * 3], vectors[i * 3 + 1], vectors[i * 3 + 2]);
+        expected.transformQuat(rotation);
+        ExpectEq(IsEqualF(results[i * 3], expected.x), true);
+        ExpectEq(IsEqualF(results[i * 3 + 1], expected.y), true);
+        ExpectEq(IsEqualF(results[i * 3 + 2], expected.z), true);
+    }
+}
+TEST(mathUtilsTest, rayBatch) {
+    logLabel = "test the MathUtil ray batch functions";
+    // 11 triangles and boxes in front of the ray along -z at distances 1 to 11, every third one is missed
+    // and the odd triangles are seen from their back
+    const uint32_t count = 11;
+    const float    origin[3]{0, 0, 10};
+    const float    direction[3]{0, 0, -1};
+    float          vertices[count * 9];
+    float          mins[count * 3];
+    float          maxs[count * 3];
+    for (uint32_t i = 0; i < count; ++i) {
+        const float z      = 9.F - static_cast<float>(i);
+        const float offset = i % 3 == 2 ? 5.F : 0.F;
+        const float back   = i % 2 == 1 ? -1.F : 1.F;
+        const float corners[9]{-back + offset, -1, z, back + offset, -1, z, offset, 1, z};
+        memcpy(vertices + i * 9, corners, sizeof(corners));
+        const float lo[3]{-0.5F + offset, -0.5F, z - 0.5F};
+        const float hi[3]{0.5F + offset, 0.5F, z + 0.5F};
+        memcpy(mins + i * 3, lo, sizeof(lo));
+        memcpy(maxs + i * 3, hi, sizeof(hi));
+    }
+
+    float distances[count];
+    cc::MathUtil::rayTriangleBatch(origin, direction, vertices, count, false, distances);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(IsEqualF(distances[i], i % 3 == 2 || i % 2 == 1 ? 0.F : 1.F + static_cast<float>(i)), true);
+    }
+    cc::MathUtil::rayTriangleBatch(origin, direction, vertices, count, true, distances);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(IsEqualF(distances[i], i % 3 == 2 ? 0.F : 1.F + static_cast<float>(i)), true);
+    }
+    cc::MathUtil::rayAABBBatch(origin, direction, mins, maxs, count, distances);
+    for (uint32_t i = 0; i < count; ++i) {
+        ExpectEq(IsEqualF(distances[i], i % 3 == 2 ? 0.F : 0.5F + static_cast<float>(i)), true);
+    }
+
+    // rays spread along x against the first triangle and box
+    float origins[count * 3];
+    float directions[count * 3];
+    for (uint32_t i = 0; i < count; ++i) {
+        const float ro[3]{-1.5F + 0.3F * static_cast<float>(i), -0.25F, 10};
+        memcpy(origins + i * 3, ro, sizeof(ro));
+        memcpy(directions + i * 3, direction, sizeof(direction));
+    }
+    cc::MathUtil::raysTriangleBatch(origins, directions, count, vertices, true, distances);
+    for (uint32_t i = 0; i < count; ++i) {
+        const float x = origins[i * 3];
+        ExpectEq(IsEqualF(distances[i], std::abs(x) <= 0.625F ? 1.F : 0.F), true);
+    }
+    cc::MathUtil::raysAABBBatch(origins, directions, count, mins, maxs, distances);
+    for (uint32_t i = 0; i < count; ++i) {
+        const float x = origins[i * 3];
+        ExpectEq(IsEqualF(distances[i], std::abs(x) <= 0.5F ? 0.5F : 0.F), true);
+    }
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/memory/MemoryAccounting.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+TEST(MemoryAccountingTest, usage) {
+    auto &accounting = MemoryAccounting::getInstance();
+
+    accounting.allocate(MemoryTag::TEXTURE, 1024);
+    accounting.allocate(MemoryTag::TEXTURE, 512);
+    accounting.deallocate(MemoryTag::TEXTURE, 1024);
+    accounting.allocate(MemoryTag::FRAME_GRAPH, 256);
+    accounting.setUsage(MemoryTag::SCRIPT, 2048);
+
+    MemoryUsage usage = accounting.getUsage(MemoryTag::TEXTURE);
+    EXPECT_EQ(usage.current, 512);
+    EXPECT_EQ(usage.peak, 1536);
+    EXPECT_EQ(usage.budget, 0);
+    // FRAME_GRAPH is already part of TEXTURE and BUFFER
+    EXPECT_EQ(accounting.getUsage(MemoryTag::TOTAL).current, 2560);
+    EXPECT_STREQ(MemoryAccounting::getTagName(MemoryTag::FRAME_GRAPH), "FrameGraph");
+
+    accounting.deallocate(MemoryTag::TEXTURE, 512);
+    accounting.deallocate(MemoryTag::FRAME_GRAPH, 256);
+    accounting.setUsage(MemoryTag::SCRIPT, 0);
+}
+
+TEST(MemoryAccountingTest, budget) {
+    auto &accounting = MemoryAccounting::getInstance();
+
+    uint32_t  notified = 0;
+    MemoryTag lastTag  = MemoryTag::COUNT;
+    uint32_t  id       = accounting.addBudgetListener([&](MemoryTag tag, uint64_t current, uint64_t budget) {
+        EXPECT_GT(current, budget);
+        lastTag = tag;
+        ++notified;
+        // evict in the callback
+        accounting.deallocate(MemoryTag::AUDIO, 4096);
+    });
+
+    uint64_t polled = 0;
+    uint32_t probe  = accounting.addProbe(MemoryTag::SPINE, [&polled]() { return polled; });
+
+    accounting.setBudget(MemoryTag::AUDIO, 8192);
+    accounting.allocate(MemoryTag::AUDIO, 8192);
+    accounting.update();
+    EXPECT_EQ(notified, 0);
+
+    accounting.allocate(MemoryTag::AUDIO, 4096);
+    accounting.update();
+    EXPECT_EQ(notified, 1);
+    EXPECT_EQ(lastTag, MemoryTag::AUDIO);
+    EXPECT_EQ(accounting.getUsage(MemoryTag::AUDIO).current, 8192);
+
+    // the listener evicted below the budget, so rising above it again notifies again
+    accounting.allocate(MemoryTag::AUDIO, 4096);
+    accounting.update();
+    EXPECT_EQ(notified, 2);
+
+    // no eviction this time, stays quiet while over the budget
+    accounting.allocate(MemoryTag::AUDIO, 8192);
+    accounting.update();
+    accounting.update();
+    EXPECT_EQ(notified, 3);
+    accounting.deallocate(MemoryTag::AUDIO, 4096);
+
+    polled = 100;
+    accounting.update();
+    EXPECT_EQ(accounting.getUsage(MemoryTag::SPINE).current, 100);
+
+    accounting.removeBudgetListener(id);
+    accounting.removeProbe(probe);
+    accounting.setBudget(MemoryTag::AUDIO, 0);
+    accounting.deallocate(MemoryTag::AUDIO, 8192);
+    accounting.setUsage(MemoryTag::SPINE, 0);
+}
@@ -0,0 +1,129 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+#include <random>
+#include "3d/misc/MeshCodec.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+ccstd::vector<uint8_t> makeVertices(uint32_t count, uint32_t stride) {
+    // a smooth strip of positions followed by noise, close to what exported meshes look like
+    std::mt19937           rng(42);
+    ccstd::vector<uint8_t> bytes(count * stride);
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t lane = 0; lane < stride; ++lane) {
+            bytes[i * stride + lane] = lane < stride / 2 ? static_cast<uint8_t>(i / 3 + lane) : static_cast<uint8_t>(rng());
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+TEST(MeshCodecTest, vertexRoundTrip) {
+    for (uint32_t count : {0U, 1U, 15U, 16U, 17U, 256U, 1000U}) {
+        for (uint32_t stride : {4U, 12U, 32U}) {
+            const auto vertices = makeVertices(count, stride);
+            const auto encoded  = meshcodec::encodeVertexBuffer(vertices.data(), count, stride);
+
+            ccstd::vector<uint8_t> decoded(count * stride, 0xcd);
+            EXPECT_TRUE(meshcodec::decodeVertexBuffer(decoded.data(), count, stride, encoded.data(), encoded.size()));
+            EXPECT_EQ(vertices, decoded);
+        }
+    }
+}
+
+TEST(MeshCodecTest, vertexCompressesSmoothData) {
+    const uint32_t         count  = 1024;
+    const uint32_t         stride = 16;
+    ccstd::vector<uint8_t> vertices(count * stride);
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t lane = 0; lane < stride; ++lane) {
+            vertices[i * stride + lane] = static_cast<uint8_t>(i / 4);
+        }
+    }
+    const auto encoded = meshcodec::encodeVertexBuffer(vertices.data(), count, stride);
+    EXPECT_LT(encoded.size(), vertices.size() / 3);
+}
+
+TEST(MeshCodecTest, vertexRejectsMalformedStream) {
+    const auto vertices = makeVertices(100, 8);
+    auto       encoded  = meshcodec::encodeVertexBuffer(vertices.data(), 100, 8);
+
+    ccstd::vector<uint8_t> decoded(vertices.size() * 2);
+    EXPECT_FALSE(meshcodec::decodeVertexBuffer(decoded.data(), 100, 8, encoded.data(), encoded.size() - 1));
+    EXPECT_FALSE(meshcodec::decodeVertexBuffer(decoded.data(), 200, 8, encoded.data(), encoded.size()));
+    encoded[0] = 0;
+    EXPECT_FALSE(meshcodec::decodeVertexBuffer(decoded.data(), 100, 8, encoded.data(), encoded.size()));
+}
+
+TEST(MeshCodecTest, indexRoundTrip) {
+    const ccstd::vector<uint32_t> indices{0, 1, 2, 2, 1, 3, 65535, 4, 5, 70000, 0, 0xffffffffU};
+    for (uint32_t stride : {1U, 2U, 4U}) {
+        const uint32_t         mask = stride == 4 ? 0xffffffffU : (1U << (stride * 8)) - 1U;
+        ccstd::vector<uint8_t> bytes(indices.size() * stride);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const uint32_t value = indices[i] & mask;
+            memcpy(bytes.data() + i * stride, &value, stride);
+        }
+        const auto count   = static_cast<uint32_t>(indices.size());
+        const auto encoded = meshcodec::encodeIndexBuffer(bytes.data(), count, stride);
+
+        ccstd::vector<uint8_t> decoded(bytes.size());
+        EXPECT_TRUE(meshcodec::decodeIndexBuffer(decoded.data(), count, stride, encoded.data(), encoded.size()));
+        EXPECT_EQ(bytes, decoded);
+    }
+}
+
+TEST(MeshCodecTest, indexRejectsOutOfRange) {
+    const uint16_t indices[]{10, 300};
+    const auto     encoded = meshcodec::encodeIndexBuffer(reinterpret_cast<const uint8_t *>(indices), 2, 2);
+
+    uint8_t narrow[2];
+    EXPECT_FALSE(meshcodec::decodeIndexBuffer(narrow, 2, 1, encoded.data(), encoded.size()));
+    uint16_t wide[3];
+    EXPECT_FALSE(meshcodec::decodeIndexBuffer(reinterpret_cast<uint8_t *>(wide), 3, 2, encoded.data(), encoded.size()));
+}
+
+TEST(MeshCodecTest, halfConversion) {
+    EXPECT_EQ(meshcodec::floatToHalf(0.F), 0x0000);
+    EXPECT_EQ(meshcodec::floatToHalf(-0.F), 0x8000);
+    EXPECT_EQ(meshcodec::floatToHalf(1.F), 0x3c00);
+    EXPECT_EQ(meshcodec::floatToHalf(-2.F), 0xc000);
+    EXPECT_EQ(meshcodec::floatToHalf(65504.F), 0x7bff);
+    EXPECT_EQ(meshcodec::floatToHalf(1e6F), 0x7c00);
+    EXPECT_EQ(meshcodec::floatToHalf(5.9604645e-8F), 0x0001);
+
+    for (uint32_t bits = 0; bits < 0x7c00U; ++bits) {
+        const auto half = static_cast<uint16_t>(bits);
+        EXPECT_EQ(meshcodec::floatToHalf(meshcodec::halfToFloat(half)), half);
+    }
+    EXPECT_NEAR(meshcodec::halfToFloat(meshcodec::floatToHalf(0.7071F)), 0.7071F, 1e-3F);
+}
@@ -0,0 +1,162 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include "base/Scheduler.h"
+#include "base/TimerWheel.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+int targetA = 0;
+int targetB = 0;
+} // namespace
+
+TEST(TimerWheelTest, expiresInOrderAcrossLevels) {
+    TimerWheel     wheel;
+    TimerWheelNode nodes[4];
+    const uint64_t ticks[4] = {3, 300, 20000, 5000000};
+    for (uint32_t i = 0; i < 4; ++i) {
+        wheel.add(&nodes[i], ticks[i]);
+    }
+
+    TimerWheelNode expired;
+    TimerWheel::initList(expired);
+    for (uint32_t i = 0; i < 4; ++i) {
+        wheel.advance(ticks[i] - 1, expired);
+        EXPECT_TRUE(TimerWheel::isEmpty(expired));
+        wheel.advance(ticks[i], expired);
+        ASSERT_FALSE(TimerWheel::isEmpty(expired));
+        EXPECT_EQ(expired.next, &nodes[i]);
+        TimerWheel::unlink(&nodes[i]);
+        EXPECT_TRUE(TimerWheel::isEmpty(expired));
+    }
+}
+
+TEST(TimerWheelTest, removedNodeNeverExpires) {
+    TimerWheel     wheel;
+    TimerWheelNode node;
+    wheel.add(&node, 1000);
+    TimerWheel::unlink(&node);
+    EXPECT_FALSE(node.isLinked());
+
+    TimerWheelNode expired;
+    TimerWheel::initList(expired);
+    wheel.advance(2000, expired);
+    EXPECT_TRUE(TimerWheel::isEmpty(expired));
+}
+
+TEST(SchedulerTest, intervalTimerCatchesUp) {
+    Scheduler scheduler;
+    int       calls = 0;
+    scheduler.schedule([&calls](float dt) {
+        EXPECT_FLOAT_EQ(dt, 0.5F);
+        ++calls;
+    },
+                       &targetA, 0.5F, false, "interval");
+    // the first update only starts the timer
+    scheduler.update(1.F);
+    EXPECT_EQ(calls, 0);
+    scheduler.update(0.25F);
+    EXPECT_EQ(calls, 0);
+    scheduler.update(0.25F);
+    EXPECT_EQ(calls, 1);
+    scheduler.update(1.F);
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(SchedulerTest, repeatAndDelay) {
+    Scheduler scheduler;
+    int       calls = 0;
+    scheduler.schedule([&calls](float /*dt*/) { ++calls; }, &targetA, 1.F, 2, 3.F, false, "repeat");
+    scheduler.update(0.1F);
+    scheduler.update(2.9F);
+    EXPECT_EQ(calls, 0);
+    scheduler.update(0.1F);
+    EXPECT_EQ(calls, 1);
+    scheduler.update(5.F);
+    // repeat 2 triggers three times in total, then the timer unschedules itself
+    EXPECT_EQ(calls, 3);
+    EXPECT_FALSE(scheduler.isScheduled("repeat", &targetA));
+}
+
+TEST(SchedulerTest, frameTimerRunsEveryUpdate) {
+    Scheduler scheduler;
+    int       calls = 0;
+    scheduler.schedule([&calls](float /*dt*/) { ++calls; }, &targetA, 0.F, false, "frame");
+    scheduler.update(0.016F);
+    for (int i = 0; i < 5; ++i) {
+        scheduler.update(0.016F);
+    }
+    EXPECT_EQ(calls, 5);
+}
+
+TEST(SchedulerTest, pauseStopsTheClock) {
+    Scheduler scheduler;
+    int       calls = 0;
+    scheduler.schedule([&calls](float /*dt*/) { ++calls; }, &targetA, 1.F, false, "pause");
+    scheduler.update(0.F);
+    scheduler.update(0.5F);
+    scheduler.pauseTarget(&targetA);
+    EXPECT_TRUE(scheduler.isTargetPaused(&targetA));
+    scheduler.update(10.F);
+    EXPECT_EQ(calls, 0);
+    scheduler.resumeTarget(&targetA);
+    scheduler.update(0.4F);
+    EXPECT_EQ(calls, 0);
+    scheduler.update(0.1F);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(SchedulerTest, callbackUnschedulesOtherTimers) {
+    Scheduler scheduler;
+    int       callsB = 0;
+    scheduler.schedule([&](float /*dt*/) {
+        scheduler.unscheduleAllForTarget(&targetB);
+        scheduler.unschedule("self", &targetA);
+    },
+                       &targetA, 1.F, false, "self");
+    scheduler.schedule([&callsB](float /*dt*/) { ++callsB; }, &targetB, 1.F, false, "other");
+    scheduler.update(0.F);
+    scheduler.update(1.F);
+    // both were due in the same update, the first one ran and removed the second
+    EXPECT_FALSE(scheduler.isScheduled("self", &targetA));
+    EXPECT_FALSE(scheduler.isScheduled("other", &targetB));
+    EXPECT_EQ(callsB, 0);
+}
+
+TEST(SchedulerTest, rescheduleUpdatesInterval) {
+    Scheduler scheduler;
+    int       calls = 0;
+    auto      callback = [&calls](float /*dt*/) { ++calls; };
+    scheduler.schedule(callback, &targetA, 10.F, false, "interval");
+    scheduler.update(0.F);
+    scheduler.update(1.F);
+    scheduler.schedule(callback, &targetA, 2.F, false, "interval");
+    scheduler.update(1.F);
+    EXPECT_EQ(calls, 1);
+    scheduler.unscheduleAll();
+    scheduler.update(10.F);
+    EXPECT_EQ(calls, 1);
+}
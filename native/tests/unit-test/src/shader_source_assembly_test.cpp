@@ -0,0 +1,58 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "core/builtin/ShaderSourceAssembly.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+TEST(ShaderSourceAssemblyTest, assemblesEveryVersion) {
+    const auto &assembly = ShaderSourceAssembly::get();
+    ASSERT_EQ(assembly.size(), 3);
+
+    auto *reference = assembly.at("glsl3");
+    ASSERT_GT(reference->getEffectCount(), 0);
+    for (const auto &iter : assembly) {
+        auto *source = iter.second;
+        ASSERT_EQ(source->getEffectCount(), reference->getEffectCount()) << iter.first;
+        for (index_t e = 0; e < static_cast<index_t>(source->getEffectCount()); ++e) {
+            ASSERT_EQ(source->getShaderCount(e), reference->getShaderCount(e));
+            for (index_t s = 0; s < static_cast<index_t>(source->getShaderCount(e)); ++s) {
+                auto stages = source->get(e, s);
+                ASSERT_EQ(stages.size(), 2);
+                EXPECT_NE(stages["vert"].find("main"), ccstd::string::npos);
+                EXPECT_NE(stages["frag"].find("main"), ccstd::string::npos);
+                EXPECT_NE(stages["vert"].back(), '\0');
+            }
+        }
+        EXPECT_TRUE(source->get(static_cast<index_t>(source->getEffectCount()), 0).empty());
+    }
+
+    const auto before = reference->get(0, 0);
+    ShaderSourceAssembly::purge();
+    EXPECT_EQ(reference->get(0, 0), before);
+    ShaderSourceAssembly::purge();
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <thread>
+#include "base/StringPool.h"
+#include "base/std/container/string.h"
+#include "gtest/gtest.h"
+
+#include "utils.h"
+
+using namespace cc;
+
+TEST(StringPoolTest, intern) {
+    ThreadSafeStringPool pool;
+    StringHandle         a = pool.stringToHandle("CC_USE_SKINNING");
+    StringHandle         b = pool.stringToHandle("USE_INSTANCING");
+    ccstd::string        copy{"CC_USE_SKINNING"};
+
+    EXPECT_TRUE(a.isValid());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, pool.stringToHandle(copy.c_str()));
+    EXPECT_EQ(a, pool.find("CC_USE_SKINNING"));
+    EXPECT_FALSE(pool.find("CC_USE_MORPH").isValid());
+    EXPECT_STREQ(pool.handleToString(b), "USE_INSTANCING");
+    EXPECT_STREQ(a.str(), "CC_USE_SKINNING");
+    EXPECT_EQ(a.hash(), StringHandle::Hasher{}(pool.stringToHandle(copy.c_str())));
+    EXPECT_NE(a.hash(), b.hash());
+}
+
+TEST(StringPoolTest, global) {
+    StringHandle a = internString("forward-add");
+    EXPECT_EQ(a, getGlobalStringPool().find("forward-add"));
+    EXPECT_EQ(a, internString("forward-add"));
+}
+
+TEST(StringPoolTest, concurrentIntern) {
+    constexpr int32_t THREAD_COUNT = 4;
+    constexpr int32_t NAME_COUNT   = 256;
+
+    ThreadSafeStringPool        pool;
+    ccstd::vector<StringHandle> handles[THREAD_COUNT];
+    ccstd::vector<std::thread>  threads;
+    for (int32_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.emplace_back([&pool, &handles, t]() {
+            for (int32_t i = 0; i < NAME_COUNT; ++i) {
+                handles[t].push_back(pool.stringToHandle(std::to_string(i).c_str()));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int32_t i = 0; i < NAME_COUNT; ++i) {
+        for (int32_t t = 1; t < THREAD_COUNT; ++t) {
+            EXPECT_EQ(handles[0][i], handles[t][i]);
+        }
+        EXPECT_STREQ(handles[0][i].str(), std::to_string(i).c_str());
+    }
+}
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gtest/gtest.h"
+#include "core/assets/Font.h"
+#include "core/assets/TextLayoutCache.h"
+
+namespace {
+
+// monospaced face: every glyph is 8x10 at (code, 0) on page 0, advancing 10 pixels
+class FakeFontFace : public cc::FontFace {
+public:
+    FakeFontFace()
+    : FontFace(nullptr) {
+        _lineHeight    = 12U;
+        _textureWidth  = 256U;
+        _textureHeight = 256U;
+    }
+
+    const cc::FontGlyph *getGlyph(uint32_t code) override {
+        ++glyphRequests;
+        auto &glyph    = _glyphs[code];
+        glyph.x        = static_cast<int16_t>(code);
+        glyph.width    = code == ' ' ? 0U : 8U;
+        glyph.height   = code == ' ' ? 0U : 10U;
+        glyph.bearingY = 10;
+        glyph.advance  = 10;
+        return &glyph;
+    }
+
+    float getKerning(uint32_t /*prevCode*/, uint32_t /*nextCode*/) override { return -2.0F; }
+
+    uint32_t glyphRequests{0U};
+
+private:
+    void doInit(const cc::FontFaceInfo & /*info*/) override {}
+};
+
+} // namespace
+
+TEST(TextLayoutCacheTest, layout) {
+    FakeFontFace face;
+    auto         layout = cc::TextLayoutCache::layout(&face, "ab c\nd", {2.0F, false});
+
+    ASSERT_EQ(layout->quads.size(), 4U);
+    EXPECT_FLOAT_EQ(layout->quads[0].rect.x, 0.0F);
+    EXPECT_FLOAT_EQ(layout->quads[0].rect.y, -20.0F);
+    EXPECT_FLOAT_EQ(layout->quads[0].rect.z, 16.0F);
+    EXPECT_FLOAT_EQ(layout->quads[1].rect.x, 20.0F);
+    EXPECT_FLOAT_EQ(layout->quads[2].rect.x, 60.0F);
+    EXPECT_FLOAT_EQ(layout->quads[1].uv.x, 'b' / 256.0F);
+    EXPECT_FLOAT_EQ(layout->quads[3].rect.x, 0.0F);
+    EXPECT_FLOAT_EQ(layout->quads[3].rect.y, 4.0F);
+    EXPECT_FLOAT_EQ(layout->width, 80.0F);
+    EXPECT_FLOAT_EQ(layout->height, 48.0F);
+
+    auto kerned = cc::TextLayoutCache::layout(&face, "ab", {1.0F, true});
+    ASSERT_EQ(kerned->quads.size(), 2U);
+    EXPECT_FLOAT_EQ(kerned->quads[1].rect.x, 8.0F);
+}
+
+TEST(TextLayoutCacheTest, share) {
+    FakeFontFace        face;
+    cc::TextLayoutCache cache;
+    const auto          first    = cache.getLayout(&face, "score: 100");
+    const uint32_t      requests = face.glyphRequests;
+
+    EXPECT_EQ(cache.getLayout(&face, "score: 100"), first);
+    EXPECT_EQ(face.glyphRequests, requests);
+    EXPECT_NE(cache.getLayout(&face, "score: 100", {2.0F, false}), first);
+    EXPECT_NE(cache.getLayout(&face, "score: 101"), first);
+    EXPECT_EQ(cache.getCount(), 3U);
+
+    cache.purge(&face);
+    EXPECT_EQ(cache.getCount(), 0U);
+    EXPECT_EQ(cache.getMemoryUsage(), 0U);
+}
+
+TEST(TextLayoutCacheTest, evict) {
+    FakeFontFace        face;
+    cc::TextLayoutCache cache;
+
+    const auto a = cache.getLayout(&face, "aaaa");
+    cache.setMemoryLimit(cache.getMemoryUsage() * 2);
+    const auto b = cache.getLayout(&face, "bbbb");
+    EXPECT_EQ(cache.getCount(), 2U);
+
+    // touching a makes b the least recently used
+    EXPECT_EQ(cache.getLayout(&face, "aaaa"), a);
+    cache.getLayout(&face, "cccc");
+    EXPECT_EQ(cache.getCount(), 2U);
+    EXPECT_EQ(cache.getLayout(&face, "aaaa"), a);
+    EXPECT_NE(cache.getLayout(&face, "bbbb"), b);
+    EXPECT_LE(cache.getMemoryUsage(), cache.getMemoryLimit());
+
+    // layouts handed out survive eviction
+    cache.clear();
+    EXPECT_EQ(a->quads.size(), 4U);
+}
@@ -0,0 +1,88 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "base/threading/ThreadAffinity.h"
+#include "gtest/gtest.h"
+
+using namespace cc;
+
+namespace {
+
+bool isRegistered(const char *name) {
+    const auto times = ThreadAffinity::getThreadCpuTimes();
+    return std::any_of(times.begin(), times.end(), [name](const ThreadCpuTime &time) { return time.name == name; });
+}
+
+} // namespace
+
+TEST(ThreadAffinityTest, topologyCoversAllCores) {
+    const CpuTopology &topology = ThreadAffinity::getTopology();
+    EXPECT_GT(topology.coreCount, 0U);
+    EXPECT_EQ(topology.performanceCoreCount + topology.efficiencyCoreCount, topology.coreCount);
+    EXPECT_GT(topology.performanceCoreCount, 0U);
+}
+
+TEST(ThreadAffinityTest, cpuTimeGrowsWithWork) {
+    const uint64_t start = ThreadAffinity::getCurrentThreadCpuTimeNS();
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 20000000; ++i) {
+        sum = sum + i;
+    }
+    EXPECT_GT(ThreadAffinity::getCurrentThreadCpuTimeNS(), start);
+}
+
+TEST(ThreadAffinityTest, threadsUnregisterOnExit) {
+    std::atomic<bool> registered{false};
+    std::atomic<bool> finish{false};
+    std::thread       worker([&]() {
+        ThreadAffinity::setCurrentThread("TestWorker", ThreadQoS::BACKGROUND);
+        registered = true;
+        while (!finish) {
+            std::this_thread::yield();
+        }
+    });
+    while (!registered) {
+        std::this_thread::yield();
+    }
+    EXPECT_TRUE(isRegistered("TestWorker"));
+
+    finish = true;
+    worker.join();
+    EXPECT_FALSE(isRegistered("TestWorker"));
+}
+
+TEST(ThreadAffinityTest, registeringAgainUpdatesTheThread) {
+    ThreadAffinity::setCurrentThread("TestMain", ThreadQoS::CRITICAL);
+    ThreadAffinity::setCurrentThread("TestMainRenamed", ThreadQoS::DEFAULT);
+    EXPECT_FALSE(isRegistered("TestMain"));
+
+    const auto times = ThreadAffinity::getThreadCpuTimes();
+    const auto it    = std::find_if(times.begin(), times.end(), [](const ThreadCpuTime &time) { return time.name == "TestMainRenamed"; });
+    ASSERT_NE(it, times.end());
+    EXPECT_EQ(it->qos, ThreadQoS::DEFAULT);
+    EXPECT_GT(it->cpuTimeNS, 0U);
+}
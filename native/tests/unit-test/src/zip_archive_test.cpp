@@ -0,0 +1,199 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <zlib.h>
+#include <cstring>
+#include "base/ZipUtils.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+using namespace cc;
+
+namespace {
+
+struct TestEntry {
+    ccstd::string name;
+    ccstd::string content;
+    bool          deflate{false};
+};
+
+void putU16(ccstd::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+}
+
+void putU32(ccstd::vector<uint8_t> &out, uint32_t v) {
+    putU16(out, v & 0xFFFF);
+    putU16(out, v >> 16);
+}
+
+ccstd::string rawDeflate(const ccstd::string &src) {
+    z_stream stream{};
+    deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    ccstd::string dst(deflateBound(&stream, static_cast<uLong>(src.size())), '\0');
+    stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(src.data()));
+    stream.avail_in  = static_cast<uInt>(src.size());
+    stream.next_out  = reinterpret_cast<Bytef *>(&dst[0]);
+    stream.avail_out = static_cast<uInt>(dst.size());
+    deflate(&stream, Z_FINISH);
+    dst.resize(stream.total_out);
+    deflateEnd(&stream);
+    return dst;
+}
+
+ccstd::vector<uint8_t> makeZip(const ccstd::vector<TestEntry> &entries) {
+    ccstd::vector<uint8_t> out;
+    ccstd::vector<uint8_t> directory;
+    for (const auto &entry : entries) {
+        const ccstd::string data   = entry.deflate ? rawDeflate(entry.content) : entry.content;
+        const auto          offset = static_cast<uint32_t>(out.size());
+        const auto          crc    = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef *>(entry.content.data()), static_cast<uInt>(entry.content.size())));
+        const uint32_t      method = entry.deflate ? 8 : 0;
+
+        putU32(out, 0x04034b50);
+        putU16(out, 20);
+        putU16(out, 0);
+        putU16(out, method);
+        putU32(out, 0);
+        putU32(out, crc);
+        putU32(out, static_cast<uint32_t>(data.size()));
+        putU32(out, static_cast<uint32_t>(entry.content.size()));
+        putU16(out, static_cast<uint32_t>(entry.name.size()));
+        putU16(out, 0);
+        out.insert(out.end(), entry.name.begin(), entry.name.end());
+        out.insert(out.end(), data.begin(), data.end());
+
+        putU32(directory, 0x02014b50);
+        putU16(directory, 20);
+        putU16(directory, 20);
+        putU16(directory, 0);
+        putU16(directory, method);
+        putU32(directory, 0);
+        putU32(directory, crc);
+        putU32(directory, static_cast<uint32_t>(data.size()));
+        putU32(directory, static_cast<uint32_t>(entry.content.size()));
+        putU16(directory, static_cast<uint32_t>(entry.name.size()));
+        putU16(directory, 0);
+        putU16(directory, 0);
+        putU16(directory, 0);
+        putU16(directory, 0);
+        putU32(directory, 0);
+        putU32(directory, offset);
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+    }
+
+    const auto directoryOffset = static_cast<uint32_t>(out.size());
+    out.insert(out.end(), directory.begin(), directory.end());
+    putU32(out, 0x06054b50);
+    putU16(out, 0);
+    putU16(out, 0);
+    putU16(out, static_cast<uint32_t>(entries.size()));
+    putU16(out, static_cast<uint32_t>(entries.size()));
+    putU32(out, static_cast<uint32_t>(directory.size()));
+    putU32(out, directoryOffset);
+    putU16(out, 5);
+    const char comment[] = "cocos";
+    out.insert(out.end(), comment, comment + 5);
+    return out;
+}
+
+ccstd::string toString(const Data &data) {
+    return ccstd::string(reinterpret_cast<const char *>(data.getBytes()), static_cast<size_t>(data.getSize()));
+}
+
+} // namespace
+
+TEST(zipArchiveTest, index) {
+    auto zip     = makeZip({{"assets/", ""}, {"assets/a.txt", "hello"}, {"assets/b.json", ccstd::string(4096, 'b'), true}, {"empty", ""}});
+    auto archive = ZipArchive::createWithBuffer(zip.data(), static_cast<uint32_t>(zip.size()));
+    ASSERT_NE(archive, nullptr);
+
+    // directories aren't indexed
+    EXPECT_EQ(archive->getEntryCount(), 3);
+    EXPECT_FALSE(archive->fileExists("assets/"));
+    EXPECT_TRUE(archive->fileExists("assets/a.txt"));
+    EXPECT_FALSE(archive->fileExists("a.txt"));
+    EXPECT_EQ(archive->getFileSize("assets/b.json"), 4096);
+    EXPECT_EQ(archive->getFileSize("missing"), -1);
+}
+
+TEST(zipArchiveTest, read) {
+    const ccstd::string text(10000, 'x');
+    auto                zip     = makeZip({{"stored", "plain content"}, {"deflated", text, true}, {"empty", ""}});
+    auto                archive = ZipArchive::createWithBuffer(zip.data(), static_cast<uint32_t>(zip.size()));
+    ASSERT_NE(archive, nullptr);
+
+    Data                         data;
+    ResizableBufferAdapter<Data> buffer(&data);
+    EXPECT_TRUE(archive->getFileData("stored", &buffer));
+    EXPECT_EQ(toString(data), "plain content");
+    EXPECT_TRUE(archive->getFileData("deflated", &buffer));
+    EXPECT_EQ(toString(data), text);
+    EXPECT_TRUE(archive->getFileData("empty", &buffer));
+    EXPECT_EQ(data.getSize(), 0);
+    EXPECT_FALSE(archive->getFileData("missing", &buffer));
+}
+
+TEST(zipArchiveTest, mapFileData) {
+    auto zip     = makeZip({{"stored", "zero copy"}, {"deflated", ccstd::string(512, 'd'), true}});
+    auto archive = ZipArchive::createWithBuffer(zip.data(), static_cast<uint32_t>(zip.size()));
+    ASSERT_NE(archive, nullptr);
+
+    MappedFile stored = archive->mapFileData("stored");
+    ASSERT_FALSE(stored.isNull());
+    // stored entries point into the archive
+    EXPECT_GE(stored.getBytes(), zip.data());
+    EXPECT_LT(stored.getBytes(), zip.data() + zip.size());
+    EXPECT_EQ(ccstd::string(reinterpret_cast<const char *>(stored.getBytes()), stored.getSize()), "zero copy");
+
+    MappedFile deflated = archive->mapFileData("deflated");
+    ASSERT_FALSE(deflated.isNull());
+    EXPECT_FALSE(deflated.isMapped());
+    EXPECT_EQ(ccstd::string(reinterpret_cast<const char *>(deflated.getBytes()), deflated.getSize()), ccstd::string(512, 'd'));
+
+    // views keep the mapping alive
+    archive.reset();
+    EXPECT_EQ(ccstd::string(reinterpret_cast<const char *>(stored.getBytes()), stored.getSize()), "zero copy");
+}
+
+TEST(zipArchiveTest, malformed) {
+    auto zip = makeZip({{"deflated", ccstd::string(1024, 'm'), true}});
+    EXPECT_EQ(ZipArchive::createWithBuffer(zip.data(), 10), nullptr);
+
+    // truncated central directory
+    auto broken = zip;
+    broken[broken.size() - 22 - 5 + 12] = 0xFF;
+    EXPECT_EQ(ZipArchive::createWithBuffer(broken.data(), static_cast<uint32_t>(broken.size())), nullptr);
+
+    // corrupted deflate stream
+    broken = zip;
+    broken[30 + 8 + 2] ^= 0xFF;
+    broken[30 + 8 + 3] ^= 0xFF;
+    auto archive = ZipArchive::createWithBuffer(broken.data(), static_cast<uint32_t>(broken.size()));
+    ASSERT_NE(archive, nullptr);
+    Data                         data;
+    ResizableBufferAdapter<Data> buffer(&data);
+    EXPECT_FALSE(archive->getFileData("deflated", &buffer));
+}
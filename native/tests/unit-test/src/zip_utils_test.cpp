@@ -0,0 +1,192 @@
+/****************************************************************************
+ Copyright (c) 2022 Xiamen Yaji Software Co., Ltd.
+
+ http://www.cocos.com
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated engine source code (the "Software"), a limited,
+ worldwide, royalty-free, non-assignable, revocable and non-exclusive license
+ to use Cocos Creator solely to develop games on your target platforms. You shall
+ not use Cocos Creator software for developing other software or tools that's
+ used for developing games. You are not granted to publish, distribute,
+ sublicense, and/or sell copies of Cocos Creator.
+
+ The software or tools in this License Agreement are licensed, not sold.
+ Xiamen Yaji Software Co., Ltd. reserves all rights not expressly granted to you.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <cstring>
+#include "base/ZipUtils.h"
+#include "gtest/gtest.h"
+#include "utils.h"
+
+#if CC_USE_LZ4
+    #include "lz4/lz4.h"
+    #include "lz4/lz4frame.h"
+#endif
+
+#if CC_USE_ZSTD
+    #include "zstd/zdict.h"
+    #include "zstd/zstd.h"
+#endif
+
+using namespace cc;
+
+namespace {
+
+ccstd::string makeJson(uint32_t index) {
+    return R"({"__type__":"cc.SpriteFrame","name":"frame_)" + std::to_string(index) + R"(","rect":[0,0,)" + std::to_string(index % 64) + R"(,32],"offset":[0,0],"rotated":false})";
+}
+
+ccstd::string makeText(uint32_t count) {
+    ccstd::string text;
+    for (uint32_t i = 0; i < count; ++i) {
+        text += makeJson(i);
+    }
+    return text;
+}
+
+ccstd::vector<unsigned char> makeCCZ(uint16_t compression, const ccstd::string &content, const void *payload, size_t payloadLength) {
+    ccstd::vector<unsigned char> ccz(sizeof(CCZHeader) + payloadLength);
+    auto *                       header = reinterpret_cast<CCZHeader *>(ccz.data());
+    memcpy(header->sig, "CCZ!", 4);
+    header->compression_type = CC_SWAP_INT16_BIG_TO_HOST(compression);
+    header->version          = CC_SWAP_INT16_BIG_TO_HOST(2);
+    header->reserved         = 0;
+    header->len              = CC_SWAP_INT32_BIG_TO_HOST(static_cast<uint32_t>(content.size()));
+    memcpy(ccz.data() + sizeof(CCZHeader), payload, payloadLength);
+    return ccz;
+}
+
+ccstd::string inflateCCZ(const ccstd::vector<unsigned char> &ccz) {
+    unsigned char *out = nullptr;
+    int            len = ZipUtils::inflateCCZBuffer(ccz.data(), static_cast<ssize_t>(ccz.size()), &out);
+    if (len < 0) {
+        return "<failed>";
+    }
+    ccstd::string result(reinterpret_cast<const char *>(out), len);
+    free(out);
+    return result;
+}
+
+// feeds the input in small chunks to exercise partial frames
+StreamDecompressor::Status decodeInChunks(StreamDecompressor *decoder, const ccstd::vector<unsigned char> &in, size_t chunkSize, ccstd::string *result) {
+    ccstd::vector<unsigned char> out;
+    StreamDecompressor::Status   status = StreamDecompressor::Status::NEED_MORE_INPUT;
+    for (size_t pos = 0; pos < in.size() && status == StreamDecompressor::Status::NEED_MORE_INPUT; pos += chunkSize) {
+        status = decoder->decompress(in.data() + pos, std::min(chunkSize, in.size() - pos), &out);
+    }
+    result->assign(reinterpret_cast<const char *>(out.data()), out.size());
+    return status;
+}
+
+} // namespace
+
+TEST(zipUtilsTest, cczNone) {
+    const ccstd::string content = makeText(8);
+    EXPECT_EQ(inflateCCZ(makeCCZ(CCZ_COMPRESSION_NONE, content, content.data(), content.size())), content);
+    // a truncated payload is rejected
+    EXPECT_EQ(inflateCCZ(makeCCZ(CCZ_COMPRESSION_NONE, content, content.data(), content.size() / 2)), "<failed>");
+    EXPECT_EQ(inflateCCZ(makeCCZ(CCZ_COMPRESSION_BZIP2, content, content.data(), content.size())), "<failed>");
+}
+
+TEST(zipUtilsTest, codecAvailability) {
+    EXPECT_EQ(StreamDecompressor::isCodecAvailable(StreamDecompressor::Codec::LZ4), CC_USE_LZ4 != 0);
+    EXPECT_EQ(StreamDecompressor::isCodecAvailable(StreamDecompressor::Codec::ZSTD), CC_USE_ZSTD != 0);
+    StreamDecompressor decoder(StreamDecompressor::Codec::LZ4);
+    EXPECT_EQ(decoder.isValid(), CC_USE_LZ4 != 0);
+}
+
+#if CC_USE_LZ4
+TEST(zipUtilsTest, lz4) {
+    const ccstd::string content = makeText(2000);
+
+    ccstd::vector<char> block(LZ4_compressBound(static_cast<int>(content.size())));
+    block.resize(LZ4_compress_default(content.data(), block.data(), static_cast<int>(content.size()), static_cast<int>(block.size())));
+    EXPECT_EQ(inflateCCZ(makeCCZ(CCZ_COMPRESSION_LZ4, content, block.data(), block.size())), content);
+
+    ccstd::vector<unsigned char> frame(LZ4F_compressFrameBound(content.size(), nullptr));
+    frame.resize(LZ4F_compressFrame(frame.data(), frame.size(), content.data(), content.size(), nullptr));
+
+    StreamDecompressor decoder(StreamDecompressor::Codec::LZ4);
+    ccstd::string      result;
+    EXPECT_EQ(decodeInChunks(&decoder, frame, 1000, &result), StreamDecompressor::Status::FINISHED);
+    EXPECT_EQ(result, content);
+
+    // a truncated frame waits for more input
+    decoder.reset();
+    frame.resize(frame.size() / 2);
+    EXPECT_EQ(decodeInChunks(&decoder, frame, frame.size(), &result), StreamDecompressor::Status::NEED_MORE_INPUT);
+    EXPECT_LT(result.size(), content.size());
+
+    decoder.reset();
+    frame[0] ^= 0xFF;
+    EXPECT_EQ(decodeInChunks(&decoder, frame, frame.size(), &result), StreamDecompressor::Status::FAILED);
+}
+#endif
+
+#if CC_USE_ZSTD
+TEST(zipUtilsTest, zstd) {
+    const ccstd::string content = makeText(2000);
+
+    ccstd::vector<unsigned char> frame(ZSTD_compressBound(content.size()));
+    frame.resize(ZSTD_compress(frame.data(), frame.size(), content.data(), content.size(), 3));
+    EXPECT_EQ(inflateCCZ(makeCCZ(CCZ_COMPRESSION_ZSTD, content, frame.data(), frame.size())), content);
+
+    StreamDecompressor decoder(StreamDecompressor::Codec::ZSTD);
+    ccstd::string      result;
+    EXPECT_EQ(decodeInChunks(&decoder, frame, 100, &result), StreamDecompressor::Status::FINISHED);
+    EXPECT_EQ(result, content);
+
+    // reuse the decoder for another frame
+    decoder.reset();
+    EXPECT_EQ(decodeInChunks(&decoder, frame, frame.size(), &result), StreamDecompressor::Status::FINISHED);
+    EXPECT_EQ(result, content);
+}
+
+TEST(zipUtilsTest, zstdDictionary) {
+    ccstd::string         samples;
+    ccstd::vector<size_t> sampleSizes;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        const ccstd::string json = makeJson(i * 7);
+        samples += json;
+        sampleSizes.push_back(json.size());
+    }
+    ccstd::vector<unsigned char> dict(16 * 1024);
+    size_t                       dictSize = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples.data(), sampleSizes.data(), static_cast<unsigned>(sampleSizes.size()));
+    ASSERT_FALSE(ZDICT_isError(dictSize));
+    dict.resize(dictSize);
+
+    const ccstd::string          content = makeJson(12345);
+    ZSTD_CCtx *                  cctx    = ZSTD_createCCtx();
+    ZSTD_CDict *                 cdict   = ZSTD_createCDict(dict.data(), dict.size(), 3);
+    ccstd::vector<unsigned char> frame(ZSTD_compressBound(content.size()));
+    frame.resize(ZSTD_compress_usingCDict(cctx, frame.data(), frame.size(), content.data(), content.size(), cdict));
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeCCtx(cctx);
+    const auto ccz = makeCCZ(CCZ_COMPRESSION_ZSTD, content, frame.data(), frame.size());
+
+    // frames are matched to dictionaries by id
+    EXPECT_EQ(inflateCCZ(ccz), "<failed>");
+    const uint32_t id = ZipUtils::registerZstdDictionary(dict.data(), static_cast<ssize_t>(dict.size()));
+    ASSERT_NE(id, 0);
+    EXPECT_EQ(inflateCCZ(ccz), content);
+
+    StreamDecompressor decoder(StreamDecompressor::Codec::ZSTD);
+    ccstd::string      result;
+    EXPECT_EQ(decodeInChunks(&decoder, frame, frame.size(), &result), StreamDecompressor::Status::FINISHED);
+    EXPECT_EQ(result, content);
+
+    ZipUtils::unregisterZstdDictionary(id);
+    EXPECT_EQ(inflateCCZ(ccz), "<failed>");
+    EXPECT_EQ(ZipUtils::registerZstdDictionary(reinterpret_cast<const unsigned char *>(content.data()), static_cast<ssize_t>(content.size())), 0);
+}
+#endif
@@ -56,6 +56,18 @@ four_space = "    "
 
 INVALID_NATIVE_TYPE = "??"
 
+# c++ types which can be passed to and returned from V8 Fast API callbacks (v8::CFunction) as they are
+FAST_API_TYPES = {
+    "void": "void",
+    "bool": "bool",
+    "int": "int32_t",
+    "int32_t": "int32_t",
+    "unsigned int": "uint32_t",
+    "uint32_t": "uint32_t",
+    "float": "float",
+    "double": "double",
+}
+
 default_arg_type_arr = [
 
     # An integer literal.
@@ -885,6 +897,32 @@ class NativeFunction(object):
                     break
 
         self.min_args = index if found_default_arg else len(self.arguments)
+        self.fast_api_signature = self.get_fast_api_signature()
+        if self.fast_api_signature is not None:
+            (ret_type, arg_types) = self.fast_api_signature
+            params = ["v8::Local<v8::Object> receiver"] + ["%s arg%d" % (t, i) for (i, t) in enumerate(arg_types)]
+            self.fast_api_ret_type = ret_type
+            self.fast_api_params = ", ".join(params + ["v8::FastApiCallbackOptions &options"])
+            self.fast_api_args = ", ".join(["arg%d" % i for i in range(len(arg_types))])
+
+    def get_fast_api_signature(self):
+        """ (return type, [argument types]) of the v8::CFunction bound for this function, None if it needs the slow path """
+        if self.static or self.not_supported or self.min_args != len(self.arguments):
+            return None
+
+        def fast_type(ntype, is_arg):
+            if ntype.is_pointer or ntype.is_enum or ntype.is_rreference or (ntype.is_reference and not ntype.is_const):
+                return None
+            name = ntype.name.replace("const ", "").strip()
+            if is_arg and name == "void":
+                return None
+            return FAST_API_TYPES.get(name)
+
+        ret_type = fast_type(self.ret_type, False)
+        arg_types = [fast_type(arg, True) for arg in self.arguments]
+        if ret_type is None or None in arg_types:
+            return None
+        return (ret_type, arg_types)
 
     def toJSON(self):
         return {
@@ -96,5 +96,27 @@ SE_BIND_FUNC_AS_PROP_SET(${signature_name})
 #end if
 #if not $current_class.skip_bind_function({"name":$func_name})
 SE_BIND_FUNC(${signature_name})
+#if $fast_api_signature is not None
+\#if SE_ENABLE_FAST_API_CALLS
+static ${fast_api_ret_type} ${signature_name}Fast(${fast_api_params}) // NOLINT(readability-identifier-naming)
+{
+    auto* cobj = se::internal::fastThisObject<${namespaced_class_name}>(receiver);
+    if (cobj == nullptr) {
+        options.fallback = true; // the slow callback reports the error
+#if $fast_api_ret_type == "void"
+        return;
+#else
+        return {};
+#end if
+    }
+#if $fast_api_ret_type == "void"
+    cobj->${func_name}(${fast_api_args});
+#else
+    return static_cast<${fast_api_ret_type}>(cobj->${func_name}(${fast_api_args}));
+#end if
+}
+\#endif
+SE_BIND_FAST_FUNC(${signature_name})
+#end if
 #end if
 #end if
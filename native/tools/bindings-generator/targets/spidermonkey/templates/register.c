@@ -68,8 +68,12 @@ bool js_register_${generator.prefix}_${current_class.nested_class_name}(se::Obje
 #for m in methods
     #if not $current_class.skip_bind_function(m)
     #set fn = m['impl']
+    #if not fn.is_overloaded and fn.fast_api_signature is not None
+    cls->defineFunction("${m['export_name']}", _SE(${fn.signature_name}), _SE_FAST(${fn.signature_name}));
+    #else
     cls->defineFunction("${m['export_name']}", _SE(${fn.signature_name}));
     #end if
+    #end if
 #end for
 #if $generator.in_listed_extend_classed($current_class.class_name) and $has_constructor
     cls->defineFunction("ctor", _SE(js_${generator.prefix}_${current_class.class_name}_ctor));